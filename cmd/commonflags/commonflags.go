@@ -41,14 +41,32 @@ const (
 	IterscaleMax     = 1000000
 	IterscaleUsage   = `a scaling factor for the number of iterations per benchmark`
 
+	MemDefault = false
+	MemUsage   = `whether to report each benchmark's heap allocations and the peak resident set size`
+
 	MimicDefault = false
 	MimicUsage   = `whether to compare Wuffs' output with other libraries' output`
 
+	RfragmentDefault = 0
+	RfragmentMin     = 0
+	RfragmentMax     = 1 << 30
+	RfragmentUsage   = `if positive, the benchmarks' src fragment size: codecs read at most this many bytes at a time`
+
 	RepsDefault = 5
 	RepsMin     = 0
 	RepsMax     = 1000000
 	RepsUsage   = `the number of repetitions per benchmark`
 
+	ThreadsDefault = 0
+	ThreadsMin     = 0
+	ThreadsMax     = 1024
+	ThreadsUsage   = `the number of threads to run each benchmark on concurrently`
+
+	WfragmentDefault = 0
+	WfragmentMin     = 0
+	WfragmentMax     = 1 << 30
+	WfragmentUsage   = `if positive, the benchmarks' dst fragment size: codecs write at most this many bytes (or tokens) at a time`
+
 	VersionDefault = "0.0.0"
 	VersionUsage   = `version string, e.g. "1.2.3-beta.4"`
 )
@@ -40,10 +40,10 @@ stdout.
 
 The flags should include exactly one of -decode or -encode.
 
-By default, a RAC file's chunks are decoded in parallel, using more total CPU
-time to substantially reduce the real (wall clock) time taken. Batch (instead
-of interactive) processing of many RAC files may want to pass -singlethreaded
-to prefer minimizing total CPU time.
+By default, a RAC file's chunks are decoded (or, for a fixed -dchunksize,
+encoded) in parallel, using more total CPU time to substantially reduce the
+real (wall clock) time taken. Batch (instead of interactive) processing of many
+RAC files may want to pass -singlethreaded to prefer minimizing total CPU time.
 
 When encoding, the input is partitioned into chunks and each chunk is
 compressed independently. You can specify the target chunk size in terms of
@@ -85,13 +85,13 @@ General Flags:
         whether to encode the input
     -quiet
         whether to suppress messages
+    -singlethreaded
+        whether to decode or encode on a single execution thread
 
 Decode-Related Flags:
 
     -drange
         the "i..j" range to decompress, "..8" means the first 8 bytes
-    -singlethreaded
-        whether to decode on a single execution thread
 
 Encode-Related Flags:
 
@@ -267,11 +267,12 @@ var (
 	encodeFlag = flag.Bool("encode", false, "whether to encode the input")
 	quietFlag  = flag.Bool("quiet", false, "whether to suppress messages")
 
+	singlethreadedFlag = flag.Bool("singlethreaded", false,
+		"whether to decode or encode on a single execution thread")
+
 	// Decode-related flags.
 	drangeFlag = flag.String("drange", "..",
 		"the \"i..j\" range to decompress, \"..8\" means the first 8 bytes")
-	singlethreadedFlag = flag.Bool("singlethreaded", false,
-		"whether to decode on a single execution thread")
 
 	// Encode-related flags.
 	codecFlag         = flag.String("codec", "zstd", "the compression codec")
@@ -459,13 +460,7 @@ func decode(inFile *os.File) error {
 	defer r.CloseWithoutWaiting()
 
 	if !*singlethreadedFlag {
-		n := runtime.NumCPU()
-		// After 16 workers, we see diminishing speed returns, but still face
-		// increasing memory costs.
-		if n > 16 {
-			n = 16
-		}
-		r.Concurrency = n
+		r.Concurrency = concurrency()
 	}
 	if err := r.SeekRange(i, j); err != nil {
 		return err
@@ -474,6 +469,16 @@ func decode(inFile *os.File) error {
 	return err
 }
 
+func concurrency() int {
+	n := runtime.NumCPU()
+	// After 16 workers, we see diminishing speed returns, but still face
+	// increasing memory costs.
+	if n > 16 {
+		n = 16
+	}
+	return n
+}
+
 func encode(r io.Reader) error {
 	indexLocation, tempFile := rac.IndexLocation(0), io.ReadWriter(nil)
 	switch *indexlocationFlag {
@@ -518,6 +523,9 @@ func encode(r io.Reader) error {
 		CChunkSize:    uint64(cchunksize),
 		DChunkSize:    uint64(dchunksize),
 	}
+	if !*singlethreadedFlag {
+		rw.Concurrency = concurrency()
+	}
 	switch *codecFlag {
 	case "lz4":
 		rw.CodecWriter = &raclz4.CodecWriter{}
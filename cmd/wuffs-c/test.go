@@ -36,8 +36,12 @@ func doBenchTest(args []string, bench bool) error {
 	ccompilersFlag := flags.String("ccompilers", cf.CcompilersDefault, cf.CcompilersUsage)
 	focusFlag := flags.String("focus", cf.FocusDefault, cf.FocusUsage)
 	iterscaleFlag := flags.Int("iterscale", cf.IterscaleDefault, cf.IterscaleUsage)
+	memFlag := flags.Bool("mem", cf.MemDefault, cf.MemUsage)
 	mimicFlag := flags.Bool("mimic", cf.MimicDefault, cf.MimicUsage)
 	repsFlag := flags.Int("reps", cf.RepsDefault, cf.RepsUsage)
+	rfragmentFlag := flags.Int("rfragment", cf.RfragmentDefault, cf.RfragmentUsage)
+	threadsFlag := flags.Int("threads", cf.ThreadsDefault, cf.ThreadsUsage)
+	wfragmentFlag := flags.Int("wfragment", cf.WfragmentDefault, cf.WfragmentUsage)
 
 	if err := flags.Parse(args); err != nil {
 		return err
@@ -57,13 +61,26 @@ func doBenchTest(args []string, bench bool) error {
 		return fmt.Errorf("bad -reps flag value %d, outside the range [%d ..= %d]",
 			*repsFlag, cf.RepsMin, cf.RepsMax)
 	}
+	if *rfragmentFlag < cf.RfragmentMin || cf.RfragmentMax < *rfragmentFlag {
+		return fmt.Errorf("bad -rfragment flag value %d, outside the range [%d ..= %d]",
+			*rfragmentFlag, cf.RfragmentMin, cf.RfragmentMax)
+	}
+	if *threadsFlag < cf.ThreadsMin || cf.ThreadsMax < *threadsFlag {
+		return fmt.Errorf("bad -threads flag value %d, outside the range [%d ..= %d]",
+			*threadsFlag, cf.ThreadsMin, cf.ThreadsMax)
+	}
+	if *wfragmentFlag < cf.WfragmentMin || cf.WfragmentMax < *wfragmentFlag {
+		return fmt.Errorf("bad -wfragment flag value %d, outside the range [%d ..= %d]",
+			*wfragmentFlag, cf.WfragmentMin, cf.WfragmentMax)
+	}
 
 	args = flags.Args()
 
 	failed := false
 	for _, arg := range args {
 		f, err := doBenchTest1(arg, bench,
-			*ccompilersFlag, *focusFlag, *iterscaleFlag, *mimicFlag, *repsFlag)
+			*ccompilersFlag, *focusFlag, *iterscaleFlag, *memFlag, *mimicFlag, *repsFlag,
+			*rfragmentFlag, *threadsFlag, *wfragmentFlag)
 		if err != nil {
 			return err
 		}
@@ -80,7 +97,8 @@ func doBenchTest(args []string, bench bool) error {
 }
 
 func doBenchTest1(filename string, bench bool, ccompilers string, focus string,
-	iterscale int, mimic bool, reps int) (failed bool, err error) {
+	iterscale int, mem bool, mimic bool, reps int,
+	rfragment int, threads int, wfragment int) (failed bool, err error) {
 
 	workDir, err := os.MkdirTemp("", "wuffs-c")
 	if err != nil {
@@ -94,8 +112,12 @@ func doBenchTest1(filename string, bench bool, ccompilers string, focus string,
 	ccArgs := []string(nil)
 	if bench {
 		ccArgs = append(ccArgs, "-O3")
+		if threads > 1 {
+			// _GNU_SOURCE lets testlib.c pin each thread to its own CPU.
+			ccArgs = append(ccArgs, "-D_GNU_SOURCE")
+		}
 	}
-	ccArgs = append(ccArgs, "-Wall", "-std=c99", "-o", out, in)
+	ccArgs = append(ccArgs, "-Wall", "-std=c99", "-pthread", "-o", out, in)
 	if mimic {
 		extra, err := findWuffsMimicCflags(in)
 		if err != nil {
@@ -122,7 +144,17 @@ func doBenchTest1(filename string, bench bool, ccompilers string, focus string,
 			outArgs = append(outArgs, "-bench",
 				fmt.Sprintf("-iterscale=%d", iterscale),
 				fmt.Sprintf("-reps=%d", reps),
+				fmt.Sprintf("-threads=%d", threads),
 			)
+			if mem {
+				outArgs = append(outArgs, "-mem")
+			}
+			if rfragment > 0 {
+				outArgs = append(outArgs, fmt.Sprintf("-rfragment=%d", rfragment))
+			}
+			if wfragment > 0 {
+				outArgs = append(outArgs, fmt.Sprintf("-wfragment=%d", wfragment))
+			}
 		}
 		if focus != "" {
 			outArgs = append(outArgs, fmt.Sprintf("-focus=%s", focus))
@@ -16,12 +16,15 @@ package main
 
 import (
 	"bytes"
+	"crypto/sha256"
+	"encoding/hex"
 	"flag"
 	"fmt"
 	"os"
 	"os/exec"
 	"path"
 	"path/filepath"
+	"runtime"
 	"strings"
 
 	"github.com/google/wuffs/lang/generate"
@@ -44,7 +47,9 @@ func doGenGenlib(wuffsRoot string, args []string, genlib bool) error {
 
 	flags := flag.NewFlagSet(flagSetName, flag.ExitOnError)
 	genlinenumFlag := flags.Bool("genlinenum", cf.GenlinenumDefault, cf.GenlinenumUsage)
+	jobsFlag := flags.Int("jobs", jobsDefault, jobsUsage)
 	langsFlag := flags.String("langs", langsDefault, langsUsage)
+	skipcacheFlag := flags.Bool("skipcache", skipcacheDefault, skipcacheUsage)
 	skipgendepsFlag := flags.Bool("skipgendeps", skipgendepsDefault, skipgendepsUsage)
 
 	ccompilersFlag := (*string)(nil)
@@ -65,6 +70,9 @@ func doGenGenlib(wuffsRoot string, args []string, genlib bool) error {
 			return fmt.Errorf("bad -ccompilers flag value %q", *ccompilersFlag)
 		}
 	}
+	if *jobsFlag < 0 {
+		return fmt.Errorf("bad -jobs flag value %d", *jobsFlag)
+	}
 	langs, err := parseLangs(*langsFlag)
 	if err != nil {
 		return err
@@ -86,12 +94,18 @@ func doGenGenlib(wuffsRoot string, args []string, genlib bool) error {
 		wuffsRoot:   wuffsRoot,
 		langs:       langs,
 		genlinenum:  *genlinenumFlag,
+		jobs:        *jobsFlag,
 		skipgen:     genlib && *skipgenFlag,
 		skipgendeps: *skipgendepsFlag,
 	}
 	if genlib {
 		h.ccompilers = *ccompilersFlag
 	}
+	if !*skipcacheFlag {
+		if d, err := os.UserCacheDir(); err == nil {
+			h.cacheDir = filepath.Join(d, "wuffs", "gen")
+		}
+	}
 
 	for _, arg := range args {
 		recursive := strings.HasSuffix(arg, "/...")
@@ -106,6 +120,9 @@ func doGenGenlib(wuffsRoot string, args []string, genlib bool) error {
 			return err
 		}
 	}
+	if err := h.runPlan(); err != nil {
+		return err
+	}
 
 	if genlib {
 		return h.genlibAffected()
@@ -118,12 +135,34 @@ type genHelper struct {
 	langs       []string
 	ccompilers  string
 	genlinenum  bool
+	jobs        int
 	skipgen     bool
 	skipgendeps bool
 
+	// cacheDir, if non-empty, holds previously generated code, keyed by a
+	// hash of everything that generated it. See genCacheKey.
+	cacheDir string
+
 	affected []string
 	seen     map[string]struct{}
 	tm       t.Map
+
+	// plan lists the packages to generate, dependencies first. Generation
+	// runs after planning, in runPlan, so that independent packages can be
+	// generated concurrently.
+	plan          []*genPackage
+	planned       map[string]*genPackage
+	commandHashes map[string][]byte
+}
+
+// genPackage is a package to generate. Its done channel is closed once it
+// has been generated (or has failed to generate, in which case err is set).
+type genPackage struct {
+	dirname       string
+	qualFilenames []string
+	useDirnames   []string
+	done          chan struct{}
+	err           error
 }
 
 func (h *genHelper) gen(dirname string, recursive bool) error {
@@ -172,9 +211,6 @@ func (h *genHelper) gen(dirname string, recursive bool) error {
 }
 
 func (h *genHelper) genDir(dirname string, qualFilenames []string) error {
-	// TODO: skip the generation if the output file already exists and its
-	// mtime is newer than all inputs and the wuffs-gen-foo command.
-
 	packageName := path.Base(dirname)
 	if !validName(packageName) {
 		return fmt.Errorf(`invalid package %q, not in [a-z0-9]+`, packageName)
@@ -183,65 +219,228 @@ func (h *genHelper) genDir(dirname string, qualFilenames []string) error {
 	if h.skipgen {
 		return nil
 	}
-	if !h.skipgendeps {
-		if err := h.genDirDependencies(qualFilenames); err != nil {
-			return err
+	useDirnames, err := h.genDirDependencies(qualFilenames)
+	if err != nil {
+		return err
+	}
+
+	p := &genPackage{
+		dirname:       dirname,
+		qualFilenames: qualFilenames,
+		useDirnames:   useDirnames,
+		done:          make(chan struct{}),
+	}
+	if h.planned == nil {
+		h.planned = map[string]*genPackage{}
+	}
+	h.planned[dirname] = p
+	h.plan = append(h.plan, p)
+	return nil
+}
+
+// genDirDependencies returns the packages used by the given files. Unless
+// skipgendeps is set, it also plans to generate them (and base) first.
+func (h *genHelper) genDirDependencies(qualifiedFilenames []string) (useDirnames []string, err error) {
+	files, err := generate.ParseFiles(&h.tm, qualifiedFilenames, nil)
+	if err != nil {
+		return nil, err
+	}
+	for _, f := range files {
+		for _, n := range f.TopLevelDecls() {
+			if n.Kind() != a.KUse {
+				continue
+			}
+			useDirname := h.tm.ByID(n.AsUse().Path())
+			useDirname, _ = t.Unescape(useDirname)
+			useDirnames = append(useDirnames, useDirname)
+			if h.skipgendeps {
+				continue
+			}
+			if err := h.gen(useDirname, false); err != nil {
+				return nil, err
+			}
 		}
 	}
+	if h.skipgendeps {
+		return useDirnames, nil
+	}
+	return useDirnames, h.gen("base", false)
+}
 
+// runPlan generates the planned packages, running up to h.jobs of them at a
+// time. Each package waits for the packages that it uses, as checking a
+// package reads their generated .wuffs files.
+func (h *genHelper) runPlan() error {
+	if len(h.plan) == 0 {
+		return nil
+	}
+	if h.cacheDir != "" {
+		h.commandHashes = map[string][]byte{}
+		for _, lang := range h.langs {
+			command := "wuffs-" + lang
+			if qualCommand, err := exec.LookPath(command); err != nil {
+				return err
+			} else if b, err := os.ReadFile(qualCommand); err != nil {
+				return err
+			} else {
+				sum := sha256.Sum256(b)
+				h.commandHashes[command] = sum[:]
+			}
+		}
+	}
+
+	jobs := h.jobs
+	if jobs <= 0 {
+		jobs = runtime.NumCPU()
+	}
+	sem := make(chan struct{}, jobs)
+	for _, p := range h.plan {
+		go func(p *genPackage) {
+			defer close(p.done)
+			if p.dirname != "base" {
+				if q := h.planned["base"]; q != nil {
+					<-q.done
+					if q.err != nil {
+						p.err = q.err
+						return
+					}
+				}
+			}
+			for _, u := range p.useDirnames {
+				if q := h.planned[u]; q != nil {
+					<-q.done
+					if q.err != nil {
+						p.err = q.err
+						return
+					}
+				}
+			}
+			sem <- struct{}{}
+			p.err = h.genPackage(p)
+			<-sem
+		}(p)
+	}
+
+	// The plan lists dependencies first, so the first error found is also
+	// the earliest cause.
+	err := error(nil)
+	for _, p := range h.plan {
+		<-p.done
+		if (err == nil) && (p.err != nil) {
+			err = p.err
+		}
+	}
+	return err
+}
+
+func (h *genHelper) genPackage(p *genPackage) error {
+	packageName := path.Base(p.dirname)
 	for _, lang := range h.langs {
 		command := "wuffs-" + lang
 		cmdArgs := []string{"gen", "-package_name", packageName}
 		if h.genlinenum != cf.GenlinenumDefault {
 			cmdArgs = append(cmdArgs, fmt.Sprintf("-genlinenum=%t", h.genlinenum))
 		}
-		cmdArgs = append(cmdArgs, qualFilenames...)
-		stdout := &bytes.Buffer{}
+		cmdArgs = append(cmdArgs, p.qualFilenames...)
 
-		cmd := exec.Command(command, cmdArgs...)
-		cmd.Stdin = nil
-		cmd.Stdout = stdout
-		cmd.Stderr = os.Stderr
-		if err := cmd.Run(); err == nil {
-			// No-op.
-		} else if _, ok := err.(*exec.ExitError); ok {
-			return fmt.Errorf("%s: failed", command)
-		} else {
-			return err
+		cacheFilename := ""
+		out := []byte(nil)
+		if h.cacheDir != "" {
+			key, err := h.genCacheKey(command, cmdArgs, p.useDirnames)
+			if err != nil {
+				return err
+			}
+			cacheFilename = filepath.Join(h.cacheDir, key+"."+lang)
+			out, _ = os.ReadFile(cacheFilename)
 		}
-		out := stdout.Bytes()
 
-		flatDirname := fmt.Sprintf("wuffs-%s", strings.Replace(dirname, "/", "-", -1))
+		if out == nil {
+			stdout := &bytes.Buffer{}
+			cmd := exec.Command(command, cmdArgs...)
+			cmd.Stdin = nil
+			cmd.Stdout = stdout
+			cmd.Stderr = os.Stderr
+			if err := cmd.Run(); err == nil {
+				// No-op.
+			} else if _, ok := err.(*exec.ExitError); ok {
+				return fmt.Errorf("%s: failed", command)
+			} else {
+				return err
+			}
+			out = stdout.Bytes()
+			if cacheFilename != "" {
+				writeCacheFile(cacheFilename, out)
+			}
+		}
+
+		flatDirname := fmt.Sprintf("wuffs-%s", strings.Replace(p.dirname, "/", "-", -1))
 		if err := h.genFile(flatDirname, lang, out); err != nil {
 			return err
 		}
 	}
 	if len(h.langs) > 0 && packageName != "base" {
-		if err := h.genWuffs(dirname, qualFilenames); err != nil {
+		if err := h.genWuffs(p.dirname, p.qualFilenames); err != nil {
 			return err
 		}
 	}
 	return nil
 }
 
-func (h *genHelper) genDirDependencies(qualifiedFilenames []string) error {
-	files, err := generate.ParseFiles(&h.tm, qualifiedFilenames, nil)
-	if err != nil {
-		return err
+// genCacheKey hashes everything that a "wuffs-foo gen" command reads: its
+// executable (which embeds the base library code), its arguments, the
+// package's source files and the generated .wuffs files of used packages.
+// Unchanged packages (and their already proven bounds checks) can then skip
+// re-running the command.
+func (h *genHelper) genCacheKey(command string, cmdArgs []string, useDirnames []string) (string, error) {
+	hasher := sha256.New()
+	hashBytes := func(b []byte) {
+		fmt.Fprintf(hasher, "%d:", len(b))
+		hasher.Write(b)
 	}
-	for _, f := range files {
-		for _, n := range f.TopLevelDecls() {
-			if n.Kind() != a.KUse {
-				continue
-			}
-			useDirname := h.tm.ByID(n.AsUse().Path())
-			useDirname, _ = t.Unescape(useDirname)
-			if err := h.gen(useDirname, false); err != nil {
-				return err
+	hashBytes(h.commandHashes[command])
+	for _, arg := range cmdArgs {
+		hashBytes([]byte(arg))
+	}
+	for _, arg := range cmdArgs {
+		if strings.HasSuffix(arg, ".wuffs") {
+			b, err := os.ReadFile(arg)
+			if err != nil {
+				return "", err
 			}
+			hashBytes(b)
 		}
 	}
-	return h.gen("base", false)
+	for _, u := range useDirnames {
+		hashBytes([]byte(u))
+		// A missing file hashes the same as an empty one. Either way, the
+		// command fails and its output is not cached.
+		b, _ := os.ReadFile(filepath.Join(h.wuffsRoot, "gen", "wuffs", filepath.FromSlash(u)+".wuffs"))
+		hashBytes(b)
+	}
+	return hex.EncodeToString(hasher.Sum(nil)), nil
+}
+
+// writeCacheFile writes to a temporary file and renames it, so that
+// concurrent "wuffs gen" processes never see a partially written file.
+// Errors are ignored, as the cache is only an optimization.
+func writeCacheFile(filename string, contents []byte) {
+	if err := os.MkdirAll(filepath.Dir(filename), 0755); err != nil {
+		return
+	}
+	f, err := os.CreateTemp(filepath.Dir(filename), "tmp-")
+	if err != nil {
+		return
+	}
+	_, err = f.Write(contents)
+	if err1 := f.Close(); err == nil {
+		err = err1
+	}
+	if err == nil {
+		err = os.Rename(f.Name(), filename)
+	}
+	if err != nil {
+		os.Remove(f.Name())
+	}
 }
 
 func (h *genHelper) genFile(dirname string, lang string, out []byte) error {
@@ -252,7 +451,10 @@ func (h *genHelper) genFile(dirname string, lang string, out []byte) error {
 }
 
 func (h *genHelper) genWuffs(dirname string, qualifiedFilenames []string) error {
-	files, err := generate.ParseFiles(&h.tm, qualifiedFilenames, &parse.Options{
+	// genWuffs runs concurrently with other packages' genWuffs calls, so it
+	// uses its own t.Map instead of h.tm.
+	tm := &t.Map{}
+	files, err := generate.ParseFiles(tm, qualifiedFilenames, &parse.Options{
 		AllowDoubleUnderscoreNames: true,
 	})
 	if err != nil {
@@ -271,7 +473,7 @@ func (h *genHelper) genWuffs(dirname string, qualifiedFilenames []string) error
 					continue
 				}
 				fmt.Fprintf(out, "pub const %s : %s = %v\n",
-					n.QID().Str(&h.tm), n.XType().Str(&h.tm), n.Value().Str(&h.tm))
+					n.QID().Str(tm), n.XType().Str(tm), n.Value().Str(tm))
 
 			case a.KFunc:
 				n := n.AsFunc()
@@ -282,7 +484,7 @@ func (h *genHelper) genWuffs(dirname string, qualifiedFilenames []string) error
 					return fmt.Errorf("TODO: genWuffs for a free-standing function")
 				}
 				// TODO: look at n.Asserts().
-				fmt.Fprintf(out, "pub func %s.%s%v(", n.Receiver().Str(&h.tm), n.FuncName().Str(&h.tm), n.Effect())
+				fmt.Fprintf(out, "pub func %s.%s%v(", n.Receiver().Str(tm), n.FuncName().Str(tm), n.Effect())
 				for i, field := range n.In().Fields() {
 					field := field.AsField()
 					if i > 0 {
@@ -290,11 +492,11 @@ func (h *genHelper) genWuffs(dirname string, qualifiedFilenames []string) error
 					}
 					// TODO: what happens if the XType is from another package?
 					// Similarly for the out-param.
-					fmt.Fprintf(out, "%s: %s", field.Name().Str(&h.tm), field.XType().Str(&h.tm))
+					fmt.Fprintf(out, "%s: %s", field.Name().Str(tm), field.XType().Str(tm))
 				}
 				fmt.Fprintf(out, ") ")
 				if o := n.Out(); o != nil {
-					fmt.Fprintf(out, "%s", o.Str(&h.tm))
+					fmt.Fprintf(out, "%s", o.Str(tm))
 				}
 				fmt.Fprintf(out, " { }\n")
 
@@ -303,14 +505,14 @@ func (h *genHelper) genWuffs(dirname string, qualifiedFilenames []string) error
 				if !n.Public() {
 					continue
 				}
-				fmt.Fprintf(out, "pub status %s\n", n.QID().Str(&h.tm))
+				fmt.Fprintf(out, "pub status %s\n", n.QID().Str(tm))
 
 			case a.KStruct:
 				n := n.AsStruct()
 				if !n.Public() {
 					continue
 				}
-				fmt.Fprintf(out, "pub struct %s", n.QID().Str(&h.tm))
+				fmt.Fprintf(out, "pub struct %s", n.QID().Str(tm))
 				if n.Classy() {
 					fmt.Fprintf(out, "?")
 				}
@@ -320,7 +522,7 @@ func (h *genHelper) genWuffs(dirname string, qualifiedFilenames []string) error
 						if i > 0 {
 							fmt.Fprintf(out, ", ")
 						}
-						fmt.Fprintf(out, "%s", imp.AsTypeExpr().Str(&h.tm))
+						fmt.Fprintf(out, "%s", imp.AsTypeExpr().Str(tm))
 					}
 				}
 				fmt.Fprintf(out, "()\n")
@@ -165,12 +165,18 @@ func writeFile(filename string, contents []byte) error {
 }
 
 const (
+	jobsDefault = 0
+	jobsUsage   = `the number of packages to generate concurrently, or 0 for the number of CPUs`
+
 	langsDefault = "c"
 	langsUsage   = `comma-separated list of target languages (file extensions), e.g. "c,go,rs"`
 
 	skipgenDefault = false
 	skipgenUsage   = `whether to skip automatically generating code when testing`
 
+	skipcacheDefault = false
+	skipcacheUsage   = `whether to skip the cache of previously generated code`
+
 	skipgendepsDefault = false
 	skipgendepsUsage   = `whether to skip automatically generating packages' dependencies`
 )
@@ -43,10 +43,18 @@ func doBenchTest(wuffsRoot string, args []string, bench bool) error {
 	skipgendepsFlag := flags.Bool("skipgendeps", skipgendepsDefault, skipgendepsUsage)
 
 	iterscaleFlag := (*int)(nil)
+	memFlag := (*bool)(nil)
 	repsFlag := (*int)(nil)
+	rfragmentFlag := (*int)(nil)
+	threadsFlag := (*int)(nil)
+	wfragmentFlag := (*int)(nil)
 	if bench {
 		iterscaleFlag = flags.Int("iterscale", cf.IterscaleDefault, cf.IterscaleUsage)
+		memFlag = flags.Bool("mem", cf.MemDefault, cf.MemUsage)
 		repsFlag = flags.Int("reps", cf.RepsDefault, cf.RepsUsage)
+		rfragmentFlag = flags.Int("rfragment", cf.RfragmentDefault, cf.RfragmentUsage)
+		threadsFlag = flags.Int("threads", cf.ThreadsDefault, cf.ThreadsUsage)
+		wfragmentFlag = flags.Int("wfragment", cf.WfragmentDefault, cf.WfragmentUsage)
 	}
 
 	if err := flags.Parse(args); err != nil {
@@ -72,6 +80,18 @@ func doBenchTest(wuffsRoot string, args []string, bench bool) error {
 			return fmt.Errorf("bad -reps flag value %d, outside the range [%d ..= %d]",
 				*repsFlag, cf.RepsMin, cf.RepsMax)
 		}
+		if *rfragmentFlag < cf.RfragmentMin || cf.RfragmentMax < *rfragmentFlag {
+			return fmt.Errorf("bad -rfragment flag value %d, outside the range [%d ..= %d]",
+				*rfragmentFlag, cf.RfragmentMin, cf.RfragmentMax)
+		}
+		if *threadsFlag < cf.ThreadsMin || cf.ThreadsMax < *threadsFlag {
+			return fmt.Errorf("bad -threads flag value %d, outside the range [%d ..= %d]",
+				*threadsFlag, cf.ThreadsMin, cf.ThreadsMax)
+		}
+		if *wfragmentFlag < cf.WfragmentMin || cf.WfragmentMax < *wfragmentFlag {
+			return fmt.Errorf("bad -wfragment flag value %d, outside the range [%d ..= %d]",
+				*wfragmentFlag, cf.WfragmentMin, cf.WfragmentMax)
+		}
 	}
 
 	args = flags.Args()
@@ -84,7 +104,17 @@ func doBenchTest(wuffsRoot string, args []string, bench bool) error {
 		cmdArgs = append(cmdArgs, "bench",
 			fmt.Sprintf("-iterscale=%d", *iterscaleFlag),
 			fmt.Sprintf("-reps=%d", *repsFlag),
+			fmt.Sprintf("-threads=%d", *threadsFlag),
 		)
+		if *memFlag {
+			cmdArgs = append(cmdArgs, "-mem")
+		}
+		if *rfragmentFlag > 0 {
+			cmdArgs = append(cmdArgs, fmt.Sprintf("-rfragment=%d", *rfragmentFlag))
+		}
+		if *wfragmentFlag > 0 {
+			cmdArgs = append(cmdArgs, fmt.Sprintf("-wfragment=%d", *wfragmentFlag))
+		}
 	} else {
 		cmdArgs = append(cmdArgs, "test")
 	}
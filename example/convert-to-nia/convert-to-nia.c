@@ -63,11 +63,13 @@ https://skia-review.googlesource.com/c/skia/+/290618
 #define WUFFS_CONFIG__MODULE__CRC32
 #define WUFFS_CONFIG__MODULE__DEFLATE
 #define WUFFS_CONFIG__MODULE__GIF
+#define WUFFS_CONFIG__MODULE__JPEG
 #define WUFFS_CONFIG__MODULE__LZW
 #define WUFFS_CONFIG__MODULE__NIE
 #define WUFFS_CONFIG__MODULE__PNG
 #define WUFFS_CONFIG__MODULE__TGA
 #define WUFFS_CONFIG__MODULE__WBMP
+#define WUFFS_CONFIG__MODULE__WEBP
 #define WUFFS_CONFIG__MODULE__ZLIB
 
 // If building this program in an environment that doesn't easily accommodate
@@ -137,10 +139,12 @@ wuffs_base__image_decoder* g_image_decoder = NULL;
 union {
   wuffs_bmp__decoder bmp;
   wuffs_gif__decoder gif;
+  wuffs_jpeg__decoder jpeg;
   wuffs_nie__decoder nie;
   wuffs_png__decoder png;
   wuffs_tga__decoder tga;
   wuffs_wbmp__decoder wbmp;
+  wuffs_webp__decoder webp;
 } g_potential_decoders;
 
 // ----
@@ -282,6 +286,16 @@ initialize_image_decoder() {
               &g_potential_decoders.gif);
       return NULL;
 
+    case WUFFS_BASE__FOURCC__JPEG:
+      status = wuffs_jpeg__decoder__initialize(
+          &g_potential_decoders.jpeg, sizeof g_potential_decoders.jpeg,
+          WUFFS_VERSION, WUFFS_INITIALIZE__DEFAULT_OPTIONS);
+      TRY(wuffs_base__status__message(&status));
+      g_image_decoder =
+          wuffs_jpeg__decoder__upcast_as__wuffs_base__image_decoder(
+              &g_potential_decoders.jpeg);
+      return NULL;
+
     case WUFFS_BASE__FOURCC__NIE:
       status = wuffs_nie__decoder__initialize(
           &g_potential_decoders.nie, sizeof g_potential_decoders.nie,
@@ -321,6 +335,16 @@ initialize_image_decoder() {
           wuffs_wbmp__decoder__upcast_as__wuffs_base__image_decoder(
               &g_potential_decoders.wbmp);
       return NULL;
+
+    case WUFFS_BASE__FOURCC__WEBP:
+      status = wuffs_webp__decoder__initialize(
+          &g_potential_decoders.webp, sizeof g_potential_decoders.webp,
+          WUFFS_VERSION, WUFFS_INITIALIZE__DEFAULT_OPTIONS);
+      TRY(wuffs_base__status__message(&status));
+      g_image_decoder =
+          wuffs_webp__decoder__upcast_as__wuffs_base__image_decoder(
+              &g_potential_decoders.webp);
+      return NULL;
   }
   return "main: unsupported file format";
 }
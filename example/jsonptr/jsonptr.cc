@@ -104,6 +104,8 @@ for a C++ compiler $CXX, such as clang++ or g++.
 #include <fcntl.h>
 #include <stdio.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 // Wuffs ships as a "single file C library" or "header file library" as per
@@ -159,7 +161,7 @@ for a C++ compiler $CXX, such as clang++ or g++.
 static const char* g_eod = "main: end of data";
 
 static const char* g_usage =
-    "Usage: jsonptr -flags input.json\n"
+    "Usage: jsonptr -flags input.json [more.json...]\n"
     "\n"
     "Flags:\n"
     "    -c      -compact-output\n"
@@ -179,6 +181,10 @@ static const char* g_usage =
     "            -strict-json-pointer-syntax\n"
     "\n"
     "The input.json filename is optional. If absent, it reads from stdin.\n"
+    "If there are multiple filenames, each file is processed in turn, as if\n"
+    "running jsonptr on each one separately, and the outputs are printed in\n"
+    "the same order. An error for one file is printed (to stderr) prefixed\n"
+    "by its filename and does not stop the other files being processed.\n"
     "\n"
     "----\n"
     "\n"
@@ -252,6 +258,10 @@ static const char* g_usage =
     "did not find a value, or found an invalid one, this program returns a\n"
     "non-zero exit code, but may still print partial output to stdout.\n"
     "\n"
+    "Once the query's value has been printed, the rest of the input is not\n"
+    "read, let alone validated. For a query near the start of a large input,\n"
+    "that can be much faster than formatting the whole input.\n"
+    "\n"
     "The JSON specification (https://json.org/) permits implementations that\n"
     "allow duplicate keys, as this one does. This JSON Pointer implementation\n"
     "is also greedy, following the first match for each fragment without\n"
@@ -442,6 +452,23 @@ bool g_sandboxed = false;
 
 int g_input_file_descriptor = 0;  // A 0 default means stdin.
 
+// Input files are opened (and, if possible, mmap'ed) before we self-impose a
+// sandbox, as the sandbox does not allow the open or mmap system calls. An
+// mmap'ed file is decoded in place, without read calls or copying into
+// g_src_array.
+#ifndef MAX_INPUT_FILES
+#define MAX_INPUT_FILES 1024
+#endif
+
+struct {
+  const char* name;
+  int fd;
+  uint8_t* mmap_ptr;
+  size_t mmap_len;
+} g_input_files[MAX_INPUT_FILES];
+
+int g_num_input_files = 0;  // A 0 default means stdin.
+
 #define TWO_NEW_LINES_THEN_256_SPACES                                          \
   "\n\n                                                                      " \
   "                                                                          " \
@@ -923,24 +950,6 @@ initialize_globals(int argc, char** argv) {
       wuffs_base__make_slice_u8(g_dst_array, DST_BUFFER_ARRAY_SIZE),
       wuffs_base__empty_io_buffer_meta());
 
-  g_src = wuffs_base__make_io_buffer(
-      wuffs_base__make_slice_u8(g_src_array, SRC_BUFFER_ARRAY_SIZE),
-      wuffs_base__empty_io_buffer_meta());
-
-  g_tok = wuffs_base__make_token_buffer(
-      wuffs_base__make_slice_token(g_tok_array, TOKEN_BUFFER_ARRAY_SIZE),
-      wuffs_base__empty_token_buffer_meta());
-
-  g_cursor_index = 0;
-
-  g_depth = 0;
-
-  g_ctx = context::none;
-
-  g_num_input_blank_lines = 0;
-
-  g_is_after_comment = false;
-
   TRY(parse_flags(argc, argv));
   if (g_flags.fail_if_unsandboxed && !g_sandboxed) {
     return "main: unsandboxed";
@@ -954,9 +963,7 @@ initialize_globals(int argc, char** argv) {
     return "main: -input-allow-inf-nan-numbers requires "
            "-output-inf-nan-numbers";
   }
-  const int stdin_fd = 0;
-  if (g_flags.remaining_argc >
-      ((g_input_file_descriptor != stdin_fd) ? 1 : 0)) {
+  if (g_flags.remaining_argc != g_num_input_files) {
     return g_usage;
   }
 
@@ -964,6 +971,41 @@ initialize_globals(int argc, char** argv) {
                                               ? TWO_NEW_LINES_THEN_256_TABS
                                               : TWO_NEW_LINES_THEN_256_SPACES;
   g_bytes_per_indent_depth = g_flags.tabs ? 1 : g_flags.spaces;
+  return nullptr;
+}
+
+// initialize_input_globals resets the per-input state, before processing
+// the next input (the i'th input file, or stdin if there are none).
+const char*  //
+initialize_input_globals(int i) {
+  if (i < g_num_input_files) {
+    g_input_file_descriptor = g_input_files[i].fd;
+  }
+  if ((i < g_num_input_files) && g_input_files[i].mmap_ptr) {
+    g_src = wuffs_base__make_io_buffer(
+        wuffs_base__make_slice_u8(g_input_files[i].mmap_ptr,
+                                  g_input_files[i].mmap_len),
+        wuffs_base__make_io_buffer_meta(g_input_files[i].mmap_len, 0, 0,
+                                        true));
+  } else {
+    g_src = wuffs_base__make_io_buffer(
+        wuffs_base__make_slice_u8(g_src_array, SRC_BUFFER_ARRAY_SIZE),
+        wuffs_base__empty_io_buffer_meta());
+  }
+
+  g_tok = wuffs_base__make_token_buffer(
+      wuffs_base__make_slice_token(g_tok_array, TOKEN_BUFFER_ARRAY_SIZE),
+      wuffs_base__empty_token_buffer_meta());
+
+  g_cursor_index = 0;
+
+  g_depth = 0;
+
+  g_ctx = context::none;
+
+  g_num_input_blank_lines = 0;
+
+  g_is_after_comment = false;
 
   g_query.reset(g_flags.query_c_string);
 
@@ -1305,9 +1347,7 @@ after_value:
 }
 
 const char*  //
-main1(int argc, char** argv) {
-  TRY(initialize_globals(argc, argv));
-
+main2() {
   bool start_of_token_chain = true;
   while (true) {
     wuffs_base__status status = g_dec.decode_tokens(
@@ -1420,6 +1460,62 @@ main1(int argc, char** argv) {
   }
 }
 
+// finish_output ends the current input's output, if any, with a new line and
+// flushes it to stdout.
+const char*  //
+finish_output() {
+  if (!g_wrote_to_dst) {
+    return nullptr;
+  }
+  const char* z1 = g_is_after_comment ? nullptr : write_dst("\n", 1);
+  const char* z2 = flush_dst();
+  return z1 ? z1 : z2;
+}
+
+const char*  //
+main1(int argc, char** argv) {
+  TRY(initialize_globals(argc, argv));
+  if (g_num_input_files == 0) {
+    TRY(initialize_input_globals(0));
+    const char* z = main2();
+    const char* z1 = finish_output();
+    return z ? z : z1;
+  }
+
+  // With multiple input files, report each file's error (if any) but carry
+  // on with the next file. The overall result is the first error, or the
+  // first internal error if there was one, so that compute_exit_code still
+  // distinguishes between the two.
+  const char* result = nullptr;
+  for (int i = 0; i < g_num_input_files; i++) {
+    TRY(initialize_input_globals(i));
+    const char* z = main2();
+    const char* z1 = finish_output();
+    z = z ? z : z1;
+    if (!z) {
+      continue;
+    } else if (!result || (!strstr(result, "internal error:") &&
+                           strstr(z, "internal error:"))) {
+      result = z;
+    }
+    if (g_num_input_files > 1) {
+      const char* name = g_input_files[i].name;
+      const int stderr_fd = 2;
+      ignore_return_value(write(stderr_fd, name, strlen(name)));
+      ignore_return_value(write(stderr_fd, ": ", 2));
+      ignore_return_value(write(stderr_fd, z, strnlen(z, 2047)));
+      ignore_return_value(write(stderr_fd, "\n", 1));
+    }
+  }
+  if (result && (g_num_input_files > 1)) {
+    // The per-file messages have already been printed.
+    return strstr(result, "internal error:")
+               ? "main: internal error: some input files failed"
+               : "main: some input files failed";
+  }
+  return result;
+}
+
 int  //
 compute_exit_code(const char* status_msg) {
   if (!status_msg) {
@@ -1454,24 +1550,47 @@ compute_exit_code(const char* status_msg) {
 
 int  //
 main(int argc, char** argv) {
-  // Look for an input filename (the first non-flag argument) in argv. If there
-  // is one, open it (but do not read from it) before we self-impose a sandbox.
+  // Look for input filenames (the first non-flag argument and every argument
+  // after it) in argv. Open them (but do not read from them) before we
+  // self-impose a sandbox.
   //
   // Flags start with "-", unless it comes after a bare "--" arg.
   {
     bool dash_dash = false;
     for (int a = 1; a < argc; a++) {
       char* arg = argv[a];
-      if ((arg[0] == '-') && !dash_dash) {
+      if ((arg[0] == '-') && !dash_dash && (g_num_input_files == 0)) {
         dash_dash = (arg[1] == '-') && (arg[2] == '\x00');
         continue;
+      } else if (g_num_input_files >= MAX_INPUT_FILES) {
+        fprintf(stderr, "main: too many input files\n");
+        return 1;
       }
-      g_input_file_descriptor = open(arg, O_RDONLY);
-      if (g_input_file_descriptor < 0) {
+      int fd = open(arg, O_RDONLY);
+      if (fd < 0) {
         fprintf(stderr, "%s: %s\n", arg, strerror(errno));
         return 1;
       }
-      break;
+      g_input_files[g_num_input_files].name = arg;
+      g_input_files[g_num_input_files].fd = fd;
+      g_input_files[g_num_input_files].mmap_ptr = nullptr;
+      g_input_files[g_num_input_files].mmap_len = 0;
+
+      // If it's a non-empty regular file, mmap it and close the file
+      // descriptor (so that many input files don't run out of them).
+      struct stat st;
+      if ((fstat(fd, &st) == 0) && S_ISREG(st.st_mode) && (st.st_size > 0) &&
+          ((uint64_t)st.st_size <= SIZE_MAX)) {
+        void* ptr =
+            mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (ptr != MAP_FAILED) {
+          g_input_files[g_num_input_files].fd = -1;
+          g_input_files[g_num_input_files].mmap_ptr = (uint8_t*)ptr;
+          g_input_files[g_num_input_files].mmap_len = (size_t)st.st_size;
+          close(fd);
+        }
+      }
+      g_num_input_files++;
     }
   }
 
@@ -1481,11 +1600,6 @@ main(int argc, char** argv) {
 #endif
 
   const char* z = main1(argc, argv);
-  if (g_wrote_to_dst) {
-    const char* z1 = g_is_after_comment ? nullptr : write_dst("\n", 1);
-    const char* z2 = flush_dst();
-    z = z ? z : (z1 ? z1 : z2);
-  }
   int exit_code = compute_exit_code(z);
 
 #if defined(WUFFS_EXAMPLE_USE_SECCOMP)
@@ -0,0 +1,762 @@
+// Copyright 2022 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ----------------
+
+/*
+uring-image-info decodes many image files concurrently, on a single thread,
+printing each one's format, dimensions and a hash of its decoded pixels.
+
+It demonstrates asynchronous I/O with Wuffs' low level C API. Wuffs' decoders
+are coroutines: when they run out of input, they return a "$short read"
+suspension status instead of blocking, and they resume where they left off
+when called again with more input. Here, each short read queues a read request
+on a Linux io_uring and control returns to an event loop, which resumes
+whichever decoder's read completes next. One thread can therefore keep many
+decodes (and many outstanding reads) in flight.
+
+The wuffs_aux C++ API (e.g. wuffs_aux::DecodeImage) is simpler but it uses
+synchronous (blocking) I/O: a sync_io::Input's CopyIn call ties up its thread
+until the bytes arrive.
+
+If io_uring is unavailable (e.g. on other operating systems, older Linux
+kernels or sandboxes that forbid the io_uring syscalls), it falls back to
+performing the same reads synchronously, via pread.
+
+See the "const char* g_usage" string below for details.
+*/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define WUFFS_EXAMPLE_USE_IO_URING
+#endif
+#endif
+
+// Wuffs ships as a "single file C library" or "header file library" as per
+// https://github.com/nothings/stb/blob/master/docs/stb_howto.txt
+//
+// To use that single file as a "foo.c"-like implementation, instead of a
+// "foo.h"-like header, #define WUFFS_IMPLEMENTATION before #include'ing or
+// compiling it.
+#define WUFFS_IMPLEMENTATION
+
+// Defining the WUFFS_CONFIG__STATIC_FUNCTIONS macro is optional, but when
+// combined with WUFFS_IMPLEMENTATION, it demonstrates making all of Wuffs'
+// functions have static storage.
+//
+// This can help the compiler ignore or discard unused code, which can produce
+// faster compiles and smaller binaries. Other motivations are discussed in the
+// "ALLOW STATIC IMPLEMENTATION" section of
+// https://raw.githubusercontent.com/nothings/stb/master/docs/stb_howto.txt
+#define WUFFS_CONFIG__STATIC_FUNCTIONS
+
+// Defining the WUFFS_CONFIG__MODULE* macros are optional, but it lets users of
+// release/c/etc.c choose which parts of Wuffs to build. That file contains the
+// entire Wuffs standard library, implementing a variety of codecs and file
+// formats. Without this macro definition, an optimizing compiler or linker may
+// very well discard Wuffs code for unused codecs, but listing the Wuffs
+// modules we use makes that process explicit. Preprocessing means that such
+// code simply isn't compiled.
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__ADLER32
+#define WUFFS_CONFIG__MODULE__BASE
+#define WUFFS_CONFIG__MODULE__BMP
+#define WUFFS_CONFIG__MODULE__CRC32
+#define WUFFS_CONFIG__MODULE__DEFLATE
+#define WUFFS_CONFIG__MODULE__GIF
+#define WUFFS_CONFIG__MODULE__JPEG
+#define WUFFS_CONFIG__MODULE__LZW
+#define WUFFS_CONFIG__MODULE__NIE
+#define WUFFS_CONFIG__MODULE__PNG
+#define WUFFS_CONFIG__MODULE__TGA
+#define WUFFS_CONFIG__MODULE__WBMP
+#define WUFFS_CONFIG__MODULE__WEBP
+#define WUFFS_CONFIG__MODULE__ZLIB
+
+// If building this program in an environment that doesn't easily accommodate
+// relative includes, you can use the script/inline-c-relative-includes.go
+// program to generate a stand-alone C file.
+#include "../../release/c/wuffs-unsupported-snapshot.c"
+
+// ----
+
+#define TRY(error_msg)         \
+  do {                         \
+    const char* z = error_msg; \
+    if (z) {                   \
+      return z;                \
+    }                          \
+  } while (false)
+
+static const char* g_usage =
+    "Usage: uring-image-info -flags file0 file1 ...\n"
+    "\n"
+    "Flags:\n"
+    "    -concurrency=N\n"
+    "    -sync\n"
+    "\n"
+    "uring-image-info decodes the named image files (e.g. in the BMP, GIF,\n"
+    "JPEG or PNG format), printing each one's format, width, height and a\n"
+    "hash of its decoded (as BGRA_PREMUL) pixels, in argument order.\n"
+    "\n"
+    "The files are decoded concurrently, on a single thread, with reads\n"
+    "submitted to a Linux io_uring. The -concurrency flag (default 64, at\n"
+    "most 4096) caps how many files are open (and being decoded) at once.\n"
+    "\n"
+    "The -sync flag performs the reads synchronously (via pread) instead of\n"
+    "via io_uring. This is also the fallback if io_uring is unavailable.";
+
+// ----
+
+#ifndef MAX_DIMENSION
+#define MAX_DIMENSION 16384
+#endif
+
+#ifndef SRC_BUFFER_ARRAY_SIZE
+#define SRC_BUFFER_ARRAY_SIZE (64 * 1024)
+#endif
+
+#define BYTES_PER_PIXEL 4
+
+struct {
+  int remaining_argc;
+  char** remaining_argv;
+
+  uint32_t concurrency;
+  bool sync;
+} g_flags = {0};
+
+const char*  //
+parse_flags(int argc, char** argv) {
+  g_flags.concurrency = 64;
+
+  int c = (argc > 0) ? 1 : 0;  // Skip argv[0], the program name.
+  for (; c < argc; c++) {
+    char* arg = argv[c];
+    if (*arg++ != '-') {
+      break;
+    }
+
+    // A double-dash "--foo" is equivalent to a single-dash "-foo". As special
+    // cases, a bare "-" is not a flag (some programs may interpret it as
+    // stdin) and a bare "--" means to stop parsing flags.
+    if (*arg == '\x00') {
+      break;
+    } else if (*arg == '-') {
+      arg++;
+      if (*arg == '\x00') {
+        c++;
+        break;
+      }
+    }
+
+    if (!strncmp(arg, "concurrency=", 12)) {
+      wuffs_base__result_u64 u = wuffs_base__parse_number_u64(
+          wuffs_base__make_slice_u8((uint8_t*)arg + 12, strlen(arg + 12)),
+          WUFFS_BASE__PARSE_NUMBER_XXX__DEFAULT_OPTIONS);
+      if (!u.status.repr && (u.value > 0) && (u.value <= 4096)) {
+        g_flags.concurrency = (uint32_t)(u.value);
+        continue;
+      }
+      return g_usage;
+    }
+    if (!strcmp(arg, "sync")) {
+      g_flags.sync = true;
+      continue;
+    }
+
+    return g_usage;
+  }
+
+  g_flags.remaining_argc = argc - c;
+  g_flags.remaining_argv = argv + c;
+  return NULL;
+}
+
+// ----
+
+// A job is the decoding of one image file. Its phase says which Wuffs
+// coroutine to resume next. Each job has at most one read in flight.
+typedef enum {
+  PHASE_INACTIVE,
+  PHASE_SNIFF,
+  PHASE_IMAGE_CONFIG,
+  PHASE_FRAME_CONFIG,
+  PHASE_FRAME,
+} job_phase;
+
+typedef struct {
+  job_phase phase;
+  int arg_index;
+  int fd;
+  bool redirected;
+  int32_t fourcc;
+
+  // file_offset is the file position of the next read, which is also src's
+  // writer position (src.meta.pos + src.meta.wi).
+  uint64_t file_offset;
+  wuffs_base__io_buffer src;
+
+  wuffs_base__image_decoder* image_decoder;
+  wuffs_base__image_config image_config;
+  wuffs_base__frame_config frame_config;
+  wuffs_base__pixel_buffer pixbuf;
+  wuffs_base__slice_u8 pixbuf_slice;
+  wuffs_base__slice_u8 workbuf_slice;
+} job;
+
+job* g_jobs = NULL;
+char** g_results = NULL;
+
+// g_pending_jobs is a ring buffer (a FIFO) of the jobs whose reads are waiting
+// to be performed by pread, when not using io_uring. Every job has at most one
+// read pending, so g_flags.concurrency elements suffice.
+uint32_t* g_pending_jobs = NULL;
+uint32_t g_pending_ri = 0;
+uint32_t g_pending_count = 0;
+
+// ----
+
+#if defined(WUFFS_EXAMPLE_USE_IO_URING)
+
+struct {
+  int fd;
+  uint32_t* sq_tail;
+  uint32_t* sq_mask;
+  uint32_t* sq_array;
+  struct io_uring_sqe* sqes;
+  uint32_t* cq_head;
+  uint32_t* cq_tail;
+  uint32_t* cq_mask;
+  struct io_uring_cqe* cqes;
+  uint32_t num_unsubmitted;
+} g_ring = {0};
+
+const char*  //
+ring_setup(uint32_t entries) {
+  struct io_uring_params p;
+  memset(&p, 0, sizeof(p));
+  int fd = (int)syscall(__NR_io_uring_setup, entries, &p);
+  if (fd < 0) {
+    return "main: io_uring_setup failed";
+  }
+
+  size_t sq_len = p.sq_off.array + (p.sq_entries * sizeof(uint32_t));
+  uint8_t* sq = mmap(NULL, sq_len, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+  size_t cq_len = p.cq_off.cqes + (p.cq_entries * sizeof(struct io_uring_cqe));
+  uint8_t* cq = mmap(NULL, cq_len, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+  size_t sqes_len = p.sq_entries * sizeof(struct io_uring_sqe);
+  void* sqes = mmap(NULL, sqes_len, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+  if ((sq == MAP_FAILED) || (cq == MAP_FAILED) || (sqes == MAP_FAILED)) {
+    close(fd);
+    return "main: could not mmap the io_uring";
+  }
+
+  g_ring.fd = fd;
+  g_ring.sq_tail = (uint32_t*)(sq + p.sq_off.tail);
+  g_ring.sq_mask = (uint32_t*)(sq + p.sq_off.ring_mask);
+  g_ring.sq_array = (uint32_t*)(sq + p.sq_off.array);
+  g_ring.sqes = (struct io_uring_sqe*)sqes;
+  g_ring.cq_head = (uint32_t*)(cq + p.cq_off.head);
+  g_ring.cq_tail = (uint32_t*)(cq + p.cq_off.tail);
+  g_ring.cq_mask = (uint32_t*)(cq + p.cq_off.ring_mask);
+  g_ring.cqes = (struct io_uring_cqe*)(cq + p.cq_off.cqes);
+  return NULL;
+}
+
+// ring_queue_read adds a read to the submission queue. It is not submitted to
+// the kernel until the next ring_wait call, so that one io_uring_enter
+// syscall can submit many reads.
+void  //
+ring_queue_read(uint32_t job_index, void* ptr, size_t len, uint64_t offset) {
+  uint32_t tail = *g_ring.sq_tail;
+  uint32_t i = tail & *g_ring.sq_mask;
+  struct io_uring_sqe* sqe = &g_ring.sqes[i];
+  memset(sqe, 0, sizeof(*sqe));
+  sqe->opcode = IORING_OP_READ;
+  sqe->fd = g_jobs[job_index].fd;
+  sqe->addr = (uint64_t)(uintptr_t)ptr;
+  sqe->len = (uint32_t)len;
+  sqe->off = offset;
+  sqe->user_data = job_index;
+  g_ring.sq_array[i] = i;
+  __atomic_store_n(g_ring.sq_tail, tail + 1, __ATOMIC_RELEASE);
+  g_ring.num_unsubmitted++;
+}
+
+// ring_wait submits any queued reads and waits for at least one completion.
+const char*  //
+ring_wait() {
+  while (true) {
+    int n = (int)syscall(__NR_io_uring_enter, g_ring.fd,
+                         g_ring.num_unsubmitted, 1, IORING_ENTER_GETEVENTS,
+                         NULL, 0);
+    if (n >= 0) {
+      g_ring.num_unsubmitted -= (uint32_t)n;
+      return NULL;
+    } else if (errno != EINTR) {
+      return "main: io_uring_enter failed";
+    }
+  }
+}
+
+#endif  // defined(WUFFS_EXAMPLE_USE_IO_URING)
+
+bool g_use_ring = false;
+
+// ----
+
+wuffs_base__image_decoder*  //
+alloc_image_decoder(int32_t fourcc) {
+  switch (fourcc) {
+    case WUFFS_BASE__FOURCC__BMP:
+      return wuffs_bmp__decoder__alloc_as__wuffs_base__image_decoder();
+    case WUFFS_BASE__FOURCC__GIF:
+      return wuffs_gif__decoder__alloc_as__wuffs_base__image_decoder();
+    case WUFFS_BASE__FOURCC__JPEG:
+      return wuffs_jpeg__decoder__alloc_as__wuffs_base__image_decoder();
+    case WUFFS_BASE__FOURCC__NIE:
+      return wuffs_nie__decoder__alloc_as__wuffs_base__image_decoder();
+    case WUFFS_BASE__FOURCC__PNG:
+      return wuffs_png__decoder__alloc_as__wuffs_base__image_decoder();
+    case WUFFS_BASE__FOURCC__TGA:
+      return wuffs_tga__decoder__alloc_as__wuffs_base__image_decoder();
+    case WUFFS_BASE__FOURCC__WBMP:
+      return wuffs_wbmp__decoder__alloc_as__wuffs_base__image_decoder();
+    case WUFFS_BASE__FOURCC__WEBP:
+      return wuffs_webp__decoder__alloc_as__wuffs_base__image_decoder();
+  }
+  return NULL;
+}
+
+const char*  //
+select_image_decoder(job* j, int32_t fourcc) {
+  free(j->image_decoder);
+  j->fourcc = fourcc;
+  j->image_decoder = alloc_image_decoder(fourcc);
+  if (!j->image_decoder) {
+    return (fourcc > 0) ? "main: out of memory"
+                        : "main: unsupported file format";
+  }
+  return NULL;
+}
+
+// handle_redirect skips j's src ahead to the embedded image, e.g. a PNG image
+// within a nominal BMP file. Since reads are positioned (like pread), there is
+// no need to read the skipped bytes.
+const char*  //
+handle_redirect(job* j) {
+  if (j->redirected) {
+    return "main: unsupported file format";
+  }
+  j->redirected = true;
+
+  wuffs_base__io_buffer empty = wuffs_base__empty_io_buffer();
+  wuffs_base__more_information minfo = wuffs_base__empty_more_information();
+  wuffs_base__status status = wuffs_base__image_decoder__tell_me_more(
+      j->image_decoder, &empty, &minfo, &j->src);
+  if (status.repr != NULL) {
+    return wuffs_base__status__message(&status);
+  } else if (minfo.flavor !=
+             WUFFS_BASE__MORE_INFORMATION__FLAVOR__IO_REDIRECT) {
+    return "main: unsupported file format";
+  }
+  uint64_t pos =
+      wuffs_base__more_information__io_redirect__range(&minfo).min_incl;
+  if (pos < wuffs_base__io_buffer__reader_position(&j->src)) {
+    // Redirects must go forward.
+    return "main: unsupported file format";
+  }
+  uint64_t relative_pos = pos - wuffs_base__io_buffer__reader_position(&j->src);
+  if (relative_pos <= wuffs_base__io_buffer__reader_length(&j->src)) {
+    j->src.meta.ri += (size_t)relative_pos;
+  } else {
+    j->src.meta.wi = 0;
+    j->src.meta.ri = 0;
+    j->src.meta.pos = pos;
+    j->file_offset = pos;
+  }
+  return select_image_decoder(
+      j, (int32_t)(wuffs_base__more_information__io_redirect__fourcc(&minfo)));
+}
+
+const char*  //
+alloc_buffers(job* j) {
+  uint32_t w = wuffs_base__pixel_config__width(&j->image_config.pixcfg);
+  uint32_t h = wuffs_base__pixel_config__height(&j->image_config.pixcfg);
+  if ((w > MAX_DIMENSION) || (h > MAX_DIMENSION)) {
+    return "main: image is too large";
+  }
+  wuffs_base__pixel_config__set(&j->image_config.pixcfg,
+                                WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+                                WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, w, h);
+
+  size_t pixbuf_len = (size_t)w * (size_t)h * BYTES_PER_PIXEL;
+  if (pixbuf_len > 0) {
+    j->pixbuf_slice =
+        wuffs_base__make_slice_u8(calloc(pixbuf_len, 1), pixbuf_len);
+    if (!j->pixbuf_slice.ptr) {
+      return "main: out of memory";
+    }
+  }
+  wuffs_base__status status = wuffs_base__pixel_buffer__set_from_slice(
+      &j->pixbuf, &j->image_config.pixcfg, j->pixbuf_slice);
+  TRY(wuffs_base__status__message(&status));
+
+  uint64_t workbuf_len =
+      wuffs_base__image_decoder__workbuf_len(j->image_decoder).max_incl;
+  if (workbuf_len > SIZE_MAX) {
+    return "main: out of memory";
+  } else if (workbuf_len > 0) {
+    j->workbuf_slice =
+        wuffs_base__make_slice_u8(malloc((size_t)workbuf_len), workbuf_len);
+    if (!j->workbuf_slice.ptr) {
+      return "main: out of memory";
+    }
+  }
+  return NULL;
+}
+
+// resume runs j's Wuffs coroutines until they either finish (setting
+// *need_more to false) or need more input (setting *need_more to true).
+const char*  //
+resume(job* j, bool* need_more) {
+  wuffs_base__status status;
+  while (true) {
+    switch (j->phase) {
+      case PHASE_INACTIVE:
+        return "main: internal error: inactive job";
+
+      case PHASE_SNIFF: {
+        int32_t fourcc = wuffs_base__magic_number_guess_fourcc(
+            wuffs_base__io_buffer__reader_slice(&j->src), j->src.meta.closed);
+        if (fourcc < 0) {
+          if (j->src.meta.closed ||
+              (wuffs_base__io_buffer__reader_length(&j->src) ==
+               j->src.data.len)) {
+            return "main: unsupported file format";
+          }
+          *need_more = true;
+          return NULL;
+        }
+        TRY(select_image_decoder(j, fourcc));
+        j->phase = PHASE_IMAGE_CONFIG;
+        continue;
+      }
+
+      case PHASE_IMAGE_CONFIG:
+        status = wuffs_base__image_decoder__decode_image_config(
+            j->image_decoder, &j->image_config, &j->src);
+        if (status.repr == NULL) {
+          TRY(alloc_buffers(j));
+          j->phase = PHASE_FRAME_CONFIG;
+          continue;
+        } else if (status.repr == wuffs_base__note__i_o_redirect) {
+          TRY(handle_redirect(j));
+          continue;
+        }
+        break;
+
+      case PHASE_FRAME_CONFIG:
+        status = wuffs_base__image_decoder__decode_frame_config(
+            j->image_decoder, &j->frame_config, &j->src);
+        if (status.repr == NULL) {
+          j->phase = PHASE_FRAME;
+          continue;
+        }
+        break;
+
+      case PHASE_FRAME:
+        status = wuffs_base__image_decoder__decode_frame(
+            j->image_decoder, &j->pixbuf, &j->src, WUFFS_BASE__PIXEL_BLEND__SRC,
+            j->workbuf_slice, NULL);
+        if (status.repr == NULL) {
+          *need_more = false;
+          return NULL;
+        }
+        break;
+    }
+
+    if (status.repr != wuffs_base__suspension__short_read) {
+      return wuffs_base__status__message(&status);
+    } else if (j->src.meta.closed) {
+      return "main: unexpected end of file";
+    }
+    *need_more = true;
+    return NULL;
+  }
+}
+
+// queue_read asks for more of j's file to be read into j's src buffer.
+const char*  //
+queue_read(uint32_t job_index) {
+  job* j = &g_jobs[job_index];
+  wuffs_base__io_buffer__compact(&j->src);
+  if (j->src.meta.wi >= j->src.data.len) {
+    return "main: src buffer is too short";
+  }
+
+#if defined(WUFFS_EXAMPLE_USE_IO_URING)
+  if (g_use_ring) {
+    ring_queue_read(job_index, j->src.data.ptr + j->src.meta.wi,
+                    j->src.data.len - j->src.meta.wi, j->file_offset);
+    return NULL;
+  }
+#endif
+
+  uint32_t wi = g_pending_ri + g_pending_count;
+  if (wi >= g_flags.concurrency) {
+    wi -= g_flags.concurrency;
+  }
+  g_pending_jobs[wi] = job_index;
+  g_pending_count++;
+  return NULL;
+}
+
+// ----
+
+uint32_t  //
+hash_pixels(job* j) {
+  // 32-bit FNV-1a.
+  uint32_t h = 0x811C9DC5;
+  for (size_t i = 0; i < j->pixbuf_slice.len; i++) {
+    h ^= j->pixbuf_slice.ptr[i];
+    h *= 0x01000193;
+  }
+  return h;
+}
+
+void  //
+finish_job(uint32_t job_index, const char* error_message) {
+  job* j = &g_jobs[job_index];
+  char* result = malloc(256);
+  if (!result) {
+    fprintf(stderr, "main: out of memory\n");
+    exit(1);
+  }
+  if (error_message) {
+    snprintf(result, 256, "%s", error_message);
+  } else {
+    uint32_t f = (uint32_t)(j->fourcc);
+    char fourcc[5] = {(char)(f >> 24), (char)(f >> 16), (char)(f >> 8),
+                      (char)(f >> 0), 0};
+    snprintf(result, 256, "%s %" PRIu32 "x%" PRIu32 " pixels hash 0x%08" PRIX32,
+             fourcc, wuffs_base__pixel_config__width(&j->image_config.pixcfg),
+             wuffs_base__pixel_config__height(&j->image_config.pixcfg),
+             hash_pixels(j));
+  }
+  g_results[j->arg_index] = result;
+
+  if (j->fd >= 0) {
+    close(j->fd);
+  }
+  free(j->image_decoder);
+  free(j->pixbuf_slice.ptr);
+  free(j->workbuf_slice.ptr);
+  uint8_t* src_array = j->src.data.ptr;
+  memset(j, 0, sizeof(*j));
+  j->phase = PHASE_INACTIVE;
+  j->fd = -1;
+  j->src = wuffs_base__ptr_u8__writer(src_array, SRC_BUFFER_ARRAY_SIZE);
+}
+
+// start_job opens a file and queues its first read.
+void  //
+start_job(uint32_t job_index, int arg_index) {
+  job* j = &g_jobs[job_index];
+  j->arg_index = arg_index;
+  j->fd = open(g_flags.remaining_argv[arg_index], O_RDONLY);
+  if (j->fd < 0) {
+    finish_job(job_index, strerror(errno));
+    return;
+  }
+  j->phase = PHASE_SNIFF;
+  const char* z = queue_read(job_index);
+  if (z) {
+    finish_job(job_index, z);
+  }
+}
+
+// on_read_completion handles a read result, n being the number of bytes read
+// or a negative errno value, and resumes decoding.
+void  //
+on_read_completion(uint32_t job_index, int64_t n) {
+  job* j = &g_jobs[job_index];
+  if ((n == -EINTR) || (n == -EAGAIN)) {
+    const char* z = queue_read(job_index);
+    if (z) {
+      finish_job(job_index, z);
+    }
+    return;
+  } else if (n < 0) {
+    finish_job(job_index, strerror((int)(-n)));
+    return;
+  } else if (n == 0) {
+    j->src.meta.closed = true;
+  } else {
+    j->src.meta.wi += (size_t)n;
+    j->file_offset += (uint64_t)n;
+  }
+
+  bool need_more = false;
+  const char* z = resume(j, &need_more);
+  if (!z && need_more) {
+    z = queue_read(job_index);
+    if (!z) {
+      return;
+    }
+  }
+  finish_job(job_index, z);
+}
+
+// wait_for_completions performs, or waits for, at least one read and handles
+// every available completion.
+const char*  //
+wait_for_completions() {
+#if defined(WUFFS_EXAMPLE_USE_IO_URING)
+  if (g_use_ring) {
+    TRY(ring_wait());
+    uint32_t head = *g_ring.cq_head;
+    uint32_t tail = __atomic_load_n(g_ring.cq_tail, __ATOMIC_ACQUIRE);
+    for (; head != tail; head++) {
+      struct io_uring_cqe* cqe = &g_ring.cqes[head & *g_ring.cq_mask];
+      uint32_t job_index = (uint32_t)(cqe->user_data);
+      int64_t n = cqe->res;
+      // Release the CQE before handling it, as handling it can queue more
+      // reads (and hence more CQEs).
+      __atomic_store_n(g_ring.cq_head, head + 1, __ATOMIC_RELEASE);
+      on_read_completion(job_index, n);
+    }
+    return NULL;
+  }
+#endif
+
+  if (g_pending_count == 0) {
+    return "main: internal error: no pending reads";
+  }
+  uint32_t job_index = g_pending_jobs[g_pending_ri];
+  g_pending_ri++;
+  if (g_pending_ri >= g_flags.concurrency) {
+    g_pending_ri = 0;
+  }
+  g_pending_count--;
+  job* j = &g_jobs[job_index];
+  ssize_t n = pread(j->fd, j->src.data.ptr + j->src.meta.wi,
+                    j->src.data.len - j->src.meta.wi, (off_t)(j->file_offset));
+  on_read_completion(job_index, (n >= 0) ? (int64_t)n : -(int64_t)errno);
+  return NULL;
+}
+
+// ----
+
+const char*  //
+main1(int argc, char** argv) {
+  TRY(parse_flags(argc, argv));
+  int num_files = g_flags.remaining_argc;
+  if (num_files == 0) {
+    return g_usage;
+  }
+
+  uint32_t n = g_flags.concurrency;
+  g_jobs = calloc(n, sizeof(job));
+  g_pending_jobs = calloc(n, sizeof(uint32_t));
+  g_results = calloc((size_t)num_files, sizeof(char*));
+  if (!g_jobs || !g_pending_jobs || !g_results) {
+    return "main: out of memory";
+  }
+  for (uint32_t i = 0; i < n; i++) {
+    uint8_t* src_array = malloc(SRC_BUFFER_ARRAY_SIZE);
+    if (!src_array) {
+      return "main: out of memory";
+    }
+    g_jobs[i].fd = -1;
+    g_jobs[i].src =
+        wuffs_base__ptr_u8__writer(src_array, SRC_BUFFER_ARRAY_SIZE);
+  }
+
+#if defined(WUFFS_EXAMPLE_USE_IO_URING)
+  if (!g_flags.sync) {
+    // Every job has at most one read in flight, so n entries suffice.
+    g_use_ring = ring_setup(n) == NULL;
+  }
+#endif
+
+  int next_file = 0;
+  while (true) {
+    // Start as many new jobs as there are inactive ones.
+    uint32_t num_active = 0;
+    for (uint32_t i = 0; i < n; i++) {
+      if ((g_jobs[i].phase == PHASE_INACTIVE) && (next_file < num_files)) {
+        start_job(i, next_file++);
+      }
+      if (g_jobs[i].phase != PHASE_INACTIVE) {
+        num_active++;
+      }
+    }
+    if (num_active == 0) {
+      if (next_file >= num_files) {
+        break;
+      }
+      continue;
+    }
+    TRY(wait_for_completions());
+  }
+
+  for (int i = 0; i < num_files; i++) {
+    printf("%s: %s\n", g_flags.remaining_argv[i], g_results[i]);
+  }
+  return NULL;
+}
+
+int  //
+compute_exit_code(const char* status_msg) {
+  if (!status_msg) {
+    return 0;
+  }
+  if ((status_msg != g_usage) && (strnlen(status_msg, 2047) >= 2047)) {
+    status_msg = "main: internal error: error message is too long";
+  }
+  fprintf(stderr, "%s\n", status_msg);
+  // Return an exit code of 1 for regular (foreseen) errors, e.g. badly
+  // formatted or unsupported input.
+  //
+  // Return an exit code of 2 for internal (exceptional) errors, e.g. defensive
+  // run-time checks found that an internal invariant did not hold.
+  //
+  // Automated testing, including badly formatted inputs, can therefore
+  // discriminate between expected failure (exit code 1) and unexpected failure
+  // (other non-zero exit codes). Specifically, exit code 2 for internal
+  // invariant violation, exit code 139 (which is 128 + SIGSEGV on x86_64
+  // linux) for a segmentation fault (e.g. null pointer dereference).
+  return strstr(status_msg, "internal error:") ? 2 : 1;
+}
+
+int  //
+main(int argc, char** argv) {
+  return compute_exit_code(main1(argc, argv));
+}
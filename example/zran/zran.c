@@ -0,0 +1,468 @@
+// Copyright 2021 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ----------------
+
+/*
+zran demonstrates random access into gzip'ed data, similar to zlib's
+examples/zran.c. It reads a (single member) gzip file from stdin, decoding it
+once to build an index of checkpoints, and then writes the -length=NUM bytes
+of decoded output starting at -offset=NUM to stdout. Only the data between the
+nearest checkpoint and offset+length is decoded a second time.
+
+Without an -offset or -length flag, it instead writes a description of the
+index, one checkpoint per line. On Linux, it also self-imposes a
+SECCOMP_MODE_STRICT sandbox. To run:
+
+$CC zran.c && ./a.out -offset=1000 -length=50 < ../../test/data/pi.txt.gz; \
+rm -f a.out
+
+for a C compiler $CC, such as clang or gcc.
+
+Each checkpoint is a deflate block boundary, where the decoder's state is just
+the bit position in the source (a byte position plus 0 to 7 pending bits) and
+up to 32 KiB of history. Resuming from a checkpoint uses a raw deflate decoder,
+seeded via wuffs_deflate__decoder__add_history and set_pending_bits, even
+though the index was built by a gzip decoder. The gzip trailer's checksum is
+therefore not verified when resuming part-way through.
+
+Checkpoints are only as frequent as the block boundaries in the compressed
+data. A typical encoder, such as /bin/gzip, emits a block every few tens of
+KiB of output, but some encoders use much larger blocks.
+*/
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <unistd.h>
+
+// Wuffs ships as a "single file C library" or "header file library" as per
+// https://github.com/nothings/stb/blob/master/docs/stb_howto.txt
+//
+// To use that single file as a "foo.c"-like implementation, instead of a
+// "foo.h"-like header, #define WUFFS_IMPLEMENTATION before #include'ing or
+// compiling it.
+#define WUFFS_IMPLEMENTATION
+
+// Defining the WUFFS_CONFIG__STATIC_FUNCTIONS macro is optional, but when
+// combined with WUFFS_IMPLEMENTATION, it demonstrates making all of Wuffs'
+// functions have static storage.
+//
+// This can help the compiler ignore or discard unused code, which can produce
+// faster compiles and smaller binaries. Other motivations are discussed in the
+// "ALLOW STATIC IMPLEMENTATION" section of
+// https://raw.githubusercontent.com/nothings/stb/master/docs/stb_howto.txt
+#define WUFFS_CONFIG__STATIC_FUNCTIONS
+
+// Defining the WUFFS_CONFIG__MODULE* macros are optional, but it lets users of
+// release/c/etc.c choose which parts of Wuffs to build. That file contains the
+// entire Wuffs standard library, implementing a variety of codecs and file
+// formats. Without this macro definition, an optimizing compiler or linker may
+// very well discard Wuffs code for unused codecs, but listing the Wuffs
+// modules we use makes that process explicit. Preprocessing means that such
+// code simply isn't compiled.
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__BASE
+#define WUFFS_CONFIG__MODULE__CRC32
+#define WUFFS_CONFIG__MODULE__DEFLATE
+#define WUFFS_CONFIG__MODULE__GZIP
+
+// If building this program in an environment that doesn't easily accommodate
+// relative includes, you can use the script/inline-c-relative-includes.go
+// program to generate a stand-alone C file.
+#include "../../release/c/wuffs-unsupported-snapshot.c"
+
+#if defined(__linux__)
+#include <linux/prctl.h>
+#include <linux/seccomp.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#define WUFFS_EXAMPLE_USE_SECCOMP
+#endif
+
+#ifndef DST_BUFFER_ARRAY_SIZE
+#define DST_BUFFER_ARRAY_SIZE (128 * 1024)
+#endif
+
+// The entire compressed input is held in memory, so that decoding can restart
+// from any checkpoint's source position without seeking stdin (which the
+// SECCOMP_MODE_STRICT sandbox does not allow).
+#ifndef SRC_BUFFER_ARRAY_SIZE
+#define SRC_BUFFER_ARRAY_SIZE (64 * 1024 * 1024)
+#endif
+
+#ifndef MAX_CHECKPOINTS
+#define MAX_CHECKPOINTS 256
+#endif
+
+#define HISTORY_ARRAY_SIZE 32768
+
+#define WORK_BUFFER_ARRAY_SIZE \
+  WUFFS_GZIP__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE
+
+uint8_t g_dst_buffer_array[DST_BUFFER_ARRAY_SIZE];
+uint8_t g_src_buffer_array[SRC_BUFFER_ARRAY_SIZE];
+#if WORK_BUFFER_ARRAY_SIZE > 0
+uint8_t g_work_buffer_array[WORK_BUFFER_ARRAY_SIZE];
+#else
+// Not all C/C++ compilers support 0-length arrays.
+uint8_t g_work_buffer_array[1];
+#endif
+
+typedef struct {
+  uint64_t dst_pos;
+  uint64_t src_pos;
+  uint32_t pending_bits;
+  uint32_t pending_n_bits;
+  uint32_t history_length;
+  uint8_t history[HISTORY_ARRAY_SIZE];
+} checkpoint;
+
+checkpoint g_checkpoints[MAX_CHECKPOINTS];
+size_t g_num_checkpoints = 0;
+
+wuffs_gzip__decoder g_gzip_decoder;
+wuffs_deflate__decoder g_deflate_decoder;
+
+// ----
+
+static bool g_sandboxed = false;
+
+struct {
+  int remaining_argc;
+  char** remaining_argv;
+
+  bool fail_if_unsandboxed;
+  bool has_length;
+  bool has_offset;
+  uint64_t length;
+  uint64_t offset;
+  uint64_t spacing;
+} g_flags = {0};
+
+// parse_u64 parses a decimal number, returning false if s is empty, contains
+// anything other than the digits 0-9 or overflows.
+bool  //
+parse_u64(const char* s, uint64_t* x) {
+  if (*s == '\x00') {
+    return false;
+  }
+  uint64_t n = 0;
+  for (; *s; s++) {
+    if ((*s < '0') || ('9' < *s)) {
+      return false;
+    }
+    uint64_t digit = (uint64_t)(*s - '0');
+    if (n > ((UINT64_MAX - digit) / 10)) {
+      return false;
+    }
+    n = (10 * n) + digit;
+  }
+  *x = n;
+  return true;
+}
+
+const char*  //
+parse_flags(int argc, char** argv) {
+  g_flags.spacing = 1048576;
+
+  int c = (argc > 0) ? 1 : 0;  // Skip argv[0], the program name.
+  for (; c < argc; c++) {
+    char* arg = argv[c];
+    if (*arg++ != '-') {
+      break;
+    }
+
+    // A double-dash "--foo" is equivalent to a single-dash "-foo". As special
+    // cases, a bare "-" is not a flag (some programs may interpret it as
+    // stdin) and a bare "--" means to stop parsing flags.
+    if (*arg == '\x00') {
+      break;
+    } else if (*arg == '-') {
+      arg++;
+      if (*arg == '\x00') {
+        c++;
+        break;
+      }
+    }
+
+    if (!strcmp(arg, "fail-if-unsandboxed")) {
+      g_flags.fail_if_unsandboxed = true;
+      continue;
+    }
+    if (!strncmp(arg, "length=", 7)) {
+      if (!parse_u64(arg + 7, &g_flags.length)) {
+        return "main: bad -length flag value";
+      }
+      g_flags.has_length = true;
+      continue;
+    }
+    if (!strncmp(arg, "offset=", 7)) {
+      if (!parse_u64(arg + 7, &g_flags.offset)) {
+        return "main: bad -offset flag value";
+      }
+      g_flags.has_offset = true;
+      continue;
+    }
+    if (!strncmp(arg, "spacing=", 8)) {
+      if (!parse_u64(arg + 8, &g_flags.spacing)) {
+        return "main: bad -spacing flag value";
+      }
+      continue;
+    }
+
+    return "main: unrecognized flag argument";
+  }
+
+  g_flags.remaining_argc = argc - c;
+  g_flags.remaining_argv = argv + c;
+  return NULL;
+}
+
+// ----
+
+// ignore_return_value suppresses errors from -Wall -Werror.
+static void  //
+ignore_return_value(int ignored) {}
+
+const char*  //
+read_stdin(wuffs_base__io_buffer* src) {
+  while (!src->meta.closed) {
+    if (src->meta.wi == src->data.len) {
+      return "main: input is too long";
+    }
+    const int stdin_fd = 0;
+    ssize_t n = read(stdin_fd, src->data.ptr + src->meta.wi,
+                     src->data.len - src->meta.wi);
+    if (n < 0) {
+      if (errno != EINTR) {
+        return strerror(errno);
+      }
+      continue;
+    }
+    src->meta.wi += n;
+    if (n == 0) {
+      src->meta.closed = true;
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+build_index(wuffs_base__io_buffer* src) {
+  wuffs_base__status status = wuffs_gzip__decoder__initialize(
+      &g_gzip_decoder, sizeof g_gzip_decoder, WUFFS_VERSION, 0);
+  if (!wuffs_base__status__is_ok(&status)) {
+    return wuffs_base__status__message(&status);
+  }
+  wuffs_gzip__decoder__set_report_block_boundaries(&g_gzip_decoder, true);
+
+  wuffs_base__io_buffer dst = wuffs_base__ptr_u8__writer(g_dst_buffer_array,
+                                                        DST_BUFFER_ARRAY_SIZE);
+  uint64_t prev_checkpoint_dst_pos = 0;
+
+  while (true) {
+    status = wuffs_gzip__decoder__transform_io(
+        &g_gzip_decoder, &dst, src,
+        wuffs_base__make_slice_u8(g_work_buffer_array,
+                                  WORK_BUFFER_ARRAY_SIZE));
+    dst.meta.ri = dst.meta.wi;
+    wuffs_base__io_buffer__compact(&dst);
+    uint64_t dst_pos = dst.meta.pos;
+
+    if (status.repr == wuffs_base__suspension__short_write) {
+      continue;
+    } else if (status.repr != wuffs_deflate__note__block_boundary) {
+      return wuffs_base__status__message(&status);
+    } else if ((g_num_checkpoints == MAX_CHECKPOINTS) ||
+               ((dst_pos - prev_checkpoint_dst_pos) < g_flags.spacing)) {
+      continue;
+    }
+
+    checkpoint* c = &g_checkpoints[g_num_checkpoints++];
+    c->dst_pos = dst_pos;
+    c->src_pos = src->meta.ri;
+    c->pending_bits = wuffs_gzip__decoder__pending_bits(&g_gzip_decoder);
+    c->pending_n_bits = wuffs_gzip__decoder__pending_n_bits(&g_gzip_decoder);
+    c->history_length = (uint32_t)wuffs_gzip__decoder__copy_history(
+        &g_gzip_decoder,
+        wuffs_base__make_slice_u8(c->history, HISTORY_ARRAY_SIZE),
+        wuffs_base__make_slice_u8(g_work_buffer_array, WORK_BUFFER_ARRAY_SIZE));
+    prev_checkpoint_dst_pos = dst_pos;
+  }
+}
+
+const char*  //
+print_index() {
+  char line[256];
+  int n = snprintf(line, sizeof line, "# dst_pos src_pos pending_n_bits\n");
+  ignore_return_value(write(1, line, n));
+  for (size_t i = 0; i < g_num_checkpoints; i++) {
+    checkpoint* c = &g_checkpoints[i];
+    n = snprintf(line, sizeof line, "%" PRIu64 " %" PRIu64 " %" PRIu32 "\n",
+                 c->dst_pos, c->src_pos, c->pending_n_bits);
+    ignore_return_value(write(1, line, n));
+  }
+  return NULL;
+}
+
+const char*  //
+extract(wuffs_base__io_buffer* src) {
+  uint64_t dst_pos = 0;
+  wuffs_base__io_transformer* t = NULL;
+
+  // Find the last checkpoint at or before the offset. Without one, restart
+  // from the beginning of the gzip file.
+  size_t i = g_num_checkpoints;
+  while ((i > 0) && (g_checkpoints[i - 1].dst_pos > g_flags.offset)) {
+    i--;
+  }
+  wuffs_base__status status;
+  if (i == 0) {
+    status = wuffs_gzip__decoder__initialize(
+        &g_gzip_decoder, sizeof g_gzip_decoder, WUFFS_VERSION, 0);
+    if (!wuffs_base__status__is_ok(&status)) {
+      return wuffs_base__status__message(&status);
+    }
+    t = wuffs_gzip__decoder__upcast_as__wuffs_base__io_transformer(
+        &g_gzip_decoder);
+    src->meta.ri = 0;
+  } else {
+    checkpoint* c = &g_checkpoints[i - 1];
+    status = wuffs_deflate__decoder__initialize(
+        &g_deflate_decoder, sizeof g_deflate_decoder, WUFFS_VERSION, 0);
+    if (!wuffs_base__status__is_ok(&status)) {
+      return wuffs_base__status__message(&status);
+    }
+    wuffs_deflate__decoder__add_history(
+        &g_deflate_decoder,
+        wuffs_base__make_slice_u8(c->history, c->history_length),
+        wuffs_base__make_slice_u8(g_work_buffer_array, WORK_BUFFER_ARRAY_SIZE));
+    wuffs_deflate__decoder__set_pending_bits(
+        &g_deflate_decoder, c->pending_bits, c->pending_n_bits);
+    t = wuffs_deflate__decoder__upcast_as__wuffs_base__io_transformer(
+        &g_deflate_decoder);
+    src->meta.ri = c->src_pos;
+    dst_pos = c->dst_pos;
+  }
+
+  uint64_t remaining = g_flags.has_length ? g_flags.length : UINT64_MAX;
+  wuffs_base__io_buffer dst = wuffs_base__ptr_u8__writer(g_dst_buffer_array,
+                                                        DST_BUFFER_ARRAY_SIZE);
+  while (remaining > 0) {
+    status = wuffs_base__io_transformer__transform_io(
+        t, &dst, src,
+        wuffs_base__make_slice_u8(g_work_buffer_array,
+                                  WORK_BUFFER_ARRAY_SIZE));
+
+    // Skip any output before the offset and write the rest, up to the length.
+    uint64_t skip = 0;
+    if (dst_pos < g_flags.offset) {
+      skip = g_flags.offset - dst_pos;
+      if (skip > dst.meta.wi) {
+        skip = dst.meta.wi;
+      }
+    }
+    uint64_t n = dst.meta.wi - skip;
+    if (n > remaining) {
+      n = remaining;
+    }
+    if (n > 0) {
+      // TODO: handle EINTR and other write errors; see "man 2 write".
+      const int stdout_fd = 1;
+      ignore_return_value(write(stdout_fd, g_dst_buffer_array + skip, n));
+      remaining -= n;
+    }
+    dst_pos += dst.meta.wi;
+    dst.meta.ri = dst.meta.wi;
+    wuffs_base__io_buffer__compact(&dst);
+
+    if (status.repr != wuffs_base__suspension__short_write) {
+      return wuffs_base__status__message(&status);
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+main1(int argc, char** argv) {
+  const char* z = parse_flags(argc, argv);
+  if (z) {
+    return z;
+  }
+  if (g_flags.fail_if_unsandboxed && !g_sandboxed) {
+    return "main: unsandboxed";
+  }
+
+  wuffs_base__io_buffer src =
+      wuffs_base__ptr_u8__reader(g_src_buffer_array, 0, false);
+  src.data.len = SRC_BUFFER_ARRAY_SIZE;
+  z = read_stdin(&src);
+  if (z) {
+    return z;
+  }
+  z = build_index(&src);
+  if (z) {
+    return z;
+  }
+  if (!g_flags.has_offset && !g_flags.has_length) {
+    return print_index();
+  }
+  return extract(&src);
+}
+
+int  //
+compute_exit_code(const char* status_msg) {
+  if (!status_msg) {
+    return 0;
+  }
+  size_t n = strnlen(status_msg, 2047);
+  if (n >= 2047) {
+    status_msg = "main: internal error: error message is too long";
+    n = strnlen(status_msg, 2047);
+  }
+  const int stderr_fd = 2;
+  ignore_return_value(write(stderr_fd, status_msg, n));
+  ignore_return_value(write(stderr_fd, "\n", 1));
+  // Return an exit code of 1 for regular (foreseen) errors, e.g. badly
+  // formatted or unsupported input.
+  //
+  // Return an exit code of 2 for internal (exceptional) errors, e.g. defensive
+  // run-time checks found that an internal invariant did not hold.
+  //
+  // Automated testing, including badly formatted inputs, can therefore
+  // discriminate between expected failure (exit code 1) and unexpected failure
+  // (other non-zero exit codes). Specifically, exit code 2 for internal
+  // invariant violation, exit code 139 (which is 128 + SIGSEGV on x86_64
+  // linux) for a segmentation fault (e.g. null pointer dereference).
+  return strstr(status_msg, "internal error:") ? 2 : 1;
+}
+
+int  //
+main(int argc, char** argv) {
+#if defined(WUFFS_EXAMPLE_USE_SECCOMP)
+  prctl(PR_SET_SECCOMP, SECCOMP_MODE_STRICT);
+  g_sandboxed = true;
+#endif
+
+  int exit_code = compute_exit_code(main1(argc, argv));
+
+#if defined(WUFFS_EXAMPLE_USE_SECCOMP)
+  // Call SYS_exit explicitly, instead of calling SYS_exit_group implicitly by
+  // either calling _exit or returning from main. SECCOMP_MODE_STRICT allows
+  // only SYS_exit.
+  syscall(SYS_exit, exit_code);
+#endif
+  return exit_code;
+}
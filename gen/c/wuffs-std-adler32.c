@@ -0,0 +1,1324 @@
+#ifndef WUFFS_INCLUDE_GUARD__ADLER32
+#define WUFFS_INCLUDE_GUARD__ADLER32
+
+#if defined(WUFFS_IMPLEMENTATION) && !defined(WUFFS_CONFIG__MODULES)
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__ADLER32
+#endif
+
+#include "./wuffs-base.c"
+
+// ¡ WUFFS MONOLITHIC RELEASE DISCARDS EVERYTHING ABOVE.
+
+
+// ---------------- Status Codes
+
+// ---------------- Public Consts
+
+// ---------------- Struct Declarations
+
+typedef struct wuffs_adler32__hasher__struct wuffs_adler32__hasher;
+
+typedef struct wuffs_adler32__hasher_x4__struct wuffs_adler32__hasher_x4;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ---------------- Public Initializer Prototypes
+
+// For any given "wuffs_foo__bar* self", "wuffs_foo__bar__initialize(self,
+// etc)" should be called before any other "wuffs_foo__bar__xxx(self, etc)".
+//
+// Pass sizeof(*self) and WUFFS_VERSION for sizeof_star_self and wuffs_version.
+// Pass 0 (or some combination of WUFFS_INITIALIZE__XXX) for options.
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+wuffs_adler32__hasher__initialize(
+    wuffs_adler32__hasher* self,
+    size_t sizeof_star_self,
+    uint64_t wuffs_version,
+    uint32_t options);
+
+wuffs_base__stats
+wuffs_adler32__hasher__stats(
+    const wuffs_adler32__hasher* self);
+
+size_t
+sizeof__wuffs_adler32__hasher();
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+wuffs_adler32__hasher_x4__initialize(
+    wuffs_adler32__hasher_x4* self,
+    size_t sizeof_star_self,
+    uint64_t wuffs_version,
+    uint32_t options);
+
+wuffs_base__stats
+wuffs_adler32__hasher_x4__stats(
+    const wuffs_adler32__hasher_x4* self);
+
+size_t
+sizeof__wuffs_adler32__hasher_x4();
+
+// ---------------- Allocs
+
+// These functions allocate and initialize Wuffs structs. They return NULL if
+// memory allocation fails. If they return non-NULL, there is no need to call
+// wuffs_foo__bar__initialize, but the caller is responsible for eventually
+// calling free on the returned pointer. That pointer is effectively a C++
+// std::unique_ptr<T, decltype(&free)>.
+
+wuffs_adler32__hasher*
+wuffs_adler32__hasher__alloc();
+
+static inline wuffs_base__hasher_u32*
+wuffs_adler32__hasher__alloc_as__wuffs_base__hasher_u32() {
+  return (wuffs_base__hasher_u32*)(wuffs_adler32__hasher__alloc());
+}
+
+wuffs_adler32__hasher_x4*
+wuffs_adler32__hasher_x4__alloc();
+
+// ---------------- Upcasts
+
+static inline wuffs_base__hasher_u32*
+wuffs_adler32__hasher__upcast_as__wuffs_base__hasher_u32(
+    wuffs_adler32__hasher* p) {
+  return (wuffs_base__hasher_u32*)p;
+}
+
+// ---------------- Public Function Prototypes
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_adler32__hasher__set_quirk_enabled(
+    wuffs_adler32__hasher* self,
+    uint32_t a_quirk,
+    bool a_enabled);
+
+WUFFS_BASE__MAYBE_STATIC uint32_t
+wuffs_adler32__hasher__update_u32(
+    wuffs_adler32__hasher* self,
+    wuffs_base__slice_u8 a_x);
+
+WUFFS_BASE__MAYBE_STATIC uint32_t
+wuffs_adler32__hasher__combine_u32(
+    wuffs_adler32__hasher* self,
+    uint32_t a_checksum_b,
+    uint64_t a_length_b);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_adler32__hasher_x4__set_quirk_enabled(
+    wuffs_adler32__hasher_x4* self,
+    uint32_t a_quirk,
+    bool a_enabled);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_adler32__hasher_x4__update_x4(
+    wuffs_adler32__hasher_x4* self,
+    wuffs_base__slice_u8 a_x0,
+    wuffs_base__slice_u8 a_x1,
+    wuffs_base__slice_u8 a_x2,
+    wuffs_base__slice_u8 a_x3);
+
+WUFFS_BASE__MAYBE_STATIC uint32_t
+wuffs_adler32__hasher_x4__checksum_u32(
+    const wuffs_adler32__hasher_x4* self,
+    uint32_t a_lane);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+// ---------------- Struct Definitions
+
+// These structs' fields, and the sizeof them, are private implementation
+// details that aren't guaranteed to be stable across Wuffs versions.
+//
+// See https://en.wikipedia.org/wiki/Opaque_pointer#C
+
+#if defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
+
+struct wuffs_adler32__hasher__struct {
+  // Do not access the private_impl's or private_data's fields directly. There
+  // is no API/ABI compatibility or safety guarantee if you do so. Instead, use
+  // the wuffs_foo__bar__baz functions.
+  //
+  // It is a struct, not a struct*, so that the outermost wuffs_foo__bar struct
+  // can be stack allocated when WUFFS_IMPLEMENTATION is defined.
+
+  struct {
+    uint32_t magic;
+    uint32_t active_coroutine;
+    wuffs_base__vtable vtable_for__wuffs_base__hasher_u32;
+    wuffs_base__vtable null_vtable;
+#if defined(WUFFS_CONFIG__STATS)
+    wuffs_base__stats stats;
+#endif  // defined(WUFFS_CONFIG__STATS)
+
+    uint32_t f_state;
+    bool f_started;
+
+    wuffs_base__empty_struct (*choosy_up)(
+        wuffs_adler32__hasher* self,
+        wuffs_base__slice_u8 a_x);
+  } private_impl;
+
+#ifdef __cplusplus
+#if defined(WUFFS_BASE__HAVE_UNIQUE_PTR)
+  using unique_ptr = std::unique_ptr<wuffs_adler32__hasher, decltype(&free)>;
+
+  // On failure, the alloc_etc functions return nullptr. They don't throw.
+
+  static inline unique_ptr
+  alloc() {
+    return unique_ptr(wuffs_adler32__hasher__alloc(), &free);
+  }
+
+  static inline wuffs_base__hasher_u32::unique_ptr
+  alloc_as__wuffs_base__hasher_u32() {
+    return wuffs_base__hasher_u32::unique_ptr(
+        wuffs_adler32__hasher__alloc_as__wuffs_base__hasher_u32(), &free);
+  }
+#endif  // defined(WUFFS_BASE__HAVE_UNIQUE_PTR)
+
+#if defined(WUFFS_BASE__HAVE_EQ_DELETE) && !defined(WUFFS_IMPLEMENTATION)
+  // Disallow constructing or copying an object via standard C++ mechanisms,
+  // e.g. the "new" operator, as this struct is intentionally opaque. Its total
+  // size and field layout is not part of the public, stable, memory-safe API.
+  // Use malloc or memcpy and the sizeof__wuffs_foo__bar function instead, and
+  // call wuffs_foo__bar__baz methods (which all take a "this"-like pointer as
+  // their first argument) rather than tweaking bar.private_impl.qux fields.
+  //
+  // In C, we can just leave wuffs_foo__bar as an incomplete type (unless
+  // WUFFS_IMPLEMENTATION is #define'd). In C++, we define a complete type in
+  // order to provide convenience methods. These forward on "this", so that you
+  // can write "bar->baz(etc)" instead of "wuffs_foo__bar__baz(bar, etc)".
+  wuffs_adler32__hasher__struct() = delete;
+  wuffs_adler32__hasher__struct(const wuffs_adler32__hasher__struct&) = delete;
+  wuffs_adler32__hasher__struct& operator=(
+      const wuffs_adler32__hasher__struct&) = delete;
+#endif  // defined(WUFFS_BASE__HAVE_EQ_DELETE) && !defined(WUFFS_IMPLEMENTATION)
+
+#if !defined(WUFFS_IMPLEMENTATION)
+  // As above, the size of the struct is not part of the public API, and unless
+  // WUFFS_IMPLEMENTATION is #define'd, this struct type T should be heap
+  // allocated, not stack allocated. Its size is not intended to be known at
+  // compile time, but it is unfortunately divulged as a side effect of
+  // defining C++ convenience methods. Use "sizeof__T()", calling the function,
+  // instead of "sizeof T", invoking the operator. To make the two values
+  // different, so that passing the latter will be rejected by the initialize
+  // function, we add an arbitrary amount of dead weight.
+  uint8_t dead_weight[123000000];  // 123 MB.
+#endif  // !defined(WUFFS_IMPLEMENTATION)
+
+  inline wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+  initialize(
+      size_t sizeof_star_self,
+      uint64_t wuffs_version,
+      uint32_t options) {
+    return wuffs_adler32__hasher__initialize(
+        this, sizeof_star_self, wuffs_version, options);
+  }
+
+  inline wuffs_base__stats
+  stats() const {
+    return wuffs_adler32__hasher__stats(this);
+  }
+
+  inline wuffs_base__hasher_u32*
+  upcast_as__wuffs_base__hasher_u32() {
+    return (wuffs_base__hasher_u32*)this;
+  }
+
+  inline wuffs_base__empty_struct
+  set_quirk_enabled(
+      uint32_t a_quirk,
+      bool a_enabled) {
+    return wuffs_adler32__hasher__set_quirk_enabled(this, a_quirk, a_enabled);
+  }
+
+  inline uint32_t
+  update_u32(
+      wuffs_base__slice_u8 a_x) {
+    return wuffs_adler32__hasher__update_u32(this, a_x);
+  }
+
+  inline uint32_t
+  combine_u32(
+      uint32_t a_checksum_b,
+      uint64_t a_length_b) {
+    return wuffs_adler32__hasher__combine_u32(this, a_checksum_b, a_length_b);
+  }
+
+#endif  // __cplusplus
+};  // struct wuffs_adler32__hasher__struct
+
+struct wuffs_adler32__hasher_x4__struct {
+  // Do not access the private_impl's or private_data's fields directly. There
+  // is no API/ABI compatibility or safety guarantee if you do so. Instead, use
+  // the wuffs_foo__bar__baz functions.
+  //
+  // It is a struct, not a struct*, so that the outermost wuffs_foo__bar struct
+  // can be stack allocated when WUFFS_IMPLEMENTATION is defined.
+
+  struct {
+    uint32_t magic;
+    uint32_t active_coroutine;
+    wuffs_base__vtable null_vtable;
+#if defined(WUFFS_CONFIG__STATS)
+    wuffs_base__stats stats;
+#endif  // defined(WUFFS_CONFIG__STATS)
+
+    uint32_t f_states[4];
+    bool f_started;
+  } private_impl;
+
+  struct {
+    wuffs_adler32__hasher f_tail;
+  } private_data;
+
+#ifdef __cplusplus
+#if defined(WUFFS_BASE__HAVE_UNIQUE_PTR)
+  using unique_ptr = std::unique_ptr<wuffs_adler32__hasher_x4, decltype(&free)>;
+
+  // On failure, the alloc_etc functions return nullptr. They don't throw.
+
+  static inline unique_ptr
+  alloc() {
+    return unique_ptr(wuffs_adler32__hasher_x4__alloc(), &free);
+  }
+#endif  // defined(WUFFS_BASE__HAVE_UNIQUE_PTR)
+
+#if defined(WUFFS_BASE__HAVE_EQ_DELETE) && !defined(WUFFS_IMPLEMENTATION)
+  // Disallow constructing or copying an object via standard C++ mechanisms,
+  // e.g. the "new" operator, as this struct is intentionally opaque. Its total
+  // size and field layout is not part of the public, stable, memory-safe API.
+  // Use malloc or memcpy and the sizeof__wuffs_foo__bar function instead, and
+  // call wuffs_foo__bar__baz methods (which all take a "this"-like pointer as
+  // their first argument) rather than tweaking bar.private_impl.qux fields.
+  //
+  // In C, we can just leave wuffs_foo__bar as an incomplete type (unless
+  // WUFFS_IMPLEMENTATION is #define'd). In C++, we define a complete type in
+  // order to provide convenience methods. These forward on "this", so that you
+  // can write "bar->baz(etc)" instead of "wuffs_foo__bar__baz(bar, etc)".
+  wuffs_adler32__hasher_x4__struct() = delete;
+  wuffs_adler32__hasher_x4__struct(const wuffs_adler32__hasher_x4__struct&) = delete;
+  wuffs_adler32__hasher_x4__struct& operator=(
+      const wuffs_adler32__hasher_x4__struct&) = delete;
+#endif  // defined(WUFFS_BASE__HAVE_EQ_DELETE) && !defined(WUFFS_IMPLEMENTATION)
+
+#if !defined(WUFFS_IMPLEMENTATION)
+  // As above, the size of the struct is not part of the public API, and unless
+  // WUFFS_IMPLEMENTATION is #define'd, this struct type T should be heap
+  // allocated, not stack allocated. Its size is not intended to be known at
+  // compile time, but it is unfortunately divulged as a side effect of
+  // defining C++ convenience methods. Use "sizeof__T()", calling the function,
+  // instead of "sizeof T", invoking the operator. To make the two values
+  // different, so that passing the latter will be rejected by the initialize
+  // function, we add an arbitrary amount of dead weight.
+  uint8_t dead_weight[123000000];  // 123 MB.
+#endif  // !defined(WUFFS_IMPLEMENTATION)
+
+  inline wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+  initialize(
+      size_t sizeof_star_self,
+      uint64_t wuffs_version,
+      uint32_t options) {
+    return wuffs_adler32__hasher_x4__initialize(
+        this, sizeof_star_self, wuffs_version, options);
+  }
+
+  inline wuffs_base__stats
+  stats() const {
+    return wuffs_adler32__hasher_x4__stats(this);
+  }
+
+  inline wuffs_base__empty_struct
+  set_quirk_enabled(
+      uint32_t a_quirk,
+      bool a_enabled) {
+    return wuffs_adler32__hasher_x4__set_quirk_enabled(this, a_quirk, a_enabled);
+  }
+
+  inline wuffs_base__empty_struct
+  update_x4(
+      wuffs_base__slice_u8 a_x0,
+      wuffs_base__slice_u8 a_x1,
+      wuffs_base__slice_u8 a_x2,
+      wuffs_base__slice_u8 a_x3) {
+    return wuffs_adler32__hasher_x4__update_x4(this, a_x0, a_x1, a_x2, a_x3);
+  }
+
+  inline uint32_t
+  checksum_u32(
+      uint32_t a_lane) const {
+    return wuffs_adler32__hasher_x4__checksum_u32(this, a_lane);
+  }
+
+#endif  // __cplusplus
+};  // struct wuffs_adler32__hasher_x4__struct
+
+#endif  // defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
+
+
+// ‼ WUFFS C HEADER ENDS HERE.
+#ifdef WUFFS_IMPLEMENTATION
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__ADLER32)
+
+// ---------------- Status Codes Implementations
+
+// ---------------- Private Consts
+
+// ---------------- Private Initializer Prototypes
+
+// ---------------- Private Function Prototypes
+
+static wuffs_base__empty_struct
+wuffs_adler32__hasher__up(
+    wuffs_adler32__hasher* self,
+    wuffs_base__slice_u8 a_x);
+
+static wuffs_base__empty_struct
+wuffs_adler32__hasher__up__choosy_default(
+    wuffs_adler32__hasher* self,
+    wuffs_base__slice_u8 a_x);
+
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+static wuffs_base__empty_struct
+wuffs_adler32__hasher__up_arm_neon(
+    wuffs_adler32__hasher* self,
+    wuffs_base__slice_u8 a_x);
+#endif  // defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+static wuffs_base__empty_struct
+wuffs_adler32__hasher__up_x86_avx2(
+    wuffs_adler32__hasher* self,
+    wuffs_base__slice_u8 a_x);
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+static wuffs_base__empty_struct
+wuffs_adler32__hasher__up_x86_sse42(
+    wuffs_adler32__hasher* self,
+    wuffs_base__slice_u8 a_x);
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+
+static wuffs_base__empty_struct
+wuffs_adler32__hasher_x4__up_tail(
+    wuffs_adler32__hasher_x4* self,
+    uint32_t a_lane,
+    wuffs_base__slice_u8 a_x);
+
+static uint64_t
+wuffs_adler32__hasher_x4__up_x4(
+    wuffs_adler32__hasher_x4* self,
+    wuffs_base__slice_u8 a_x0,
+    wuffs_base__slice_u8 a_x1,
+    wuffs_base__slice_u8 a_x2,
+    wuffs_base__slice_u8 a_x3);
+
+// ---------------- VTables
+
+const wuffs_base__hasher_u32__func_ptrs
+wuffs_adler32__hasher__func_ptrs_for__wuffs_base__hasher_u32 = {
+  (wuffs_base__empty_struct(*)(void*,
+      uint32_t,
+      bool))(&wuffs_adler32__hasher__set_quirk_enabled),
+  (uint32_t(*)(void*,
+      wuffs_base__slice_u8))(&wuffs_adler32__hasher__update_u32),
+};
+
+// ---------------- Initializer Implementations
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+wuffs_adler32__hasher__initialize(
+    wuffs_adler32__hasher* self,
+    size_t sizeof_star_self,
+    uint64_t wuffs_version,
+    uint32_t options){
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  }
+
+  if ((options & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+    // The whole point of this if-check is to detect an uninitialized *self.
+    // We disable the warning on GCC. Clang-5.0 does not have this warning.
+    //
+    // The caller promises that *self is zeroed, so the empty asm tells GCC
+    // that private_impl is defined. Otherwise, once this function and a
+    // small method (e.g. one that reads a "choose" guard field) are both
+    // inlined into the caller, GCC -O3 warns about that method's read.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    __asm__ __volatile__("" : "+m"(self->private_impl));
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((options & WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      options |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    }
+  }
+
+  self->private_impl.choosy_up = &wuffs_adler32__hasher__up__choosy_default;
+
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__hasher_u32.vtable_name =
+      wuffs_base__hasher_u32__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__hasher_u32.function_pointers =
+      (const void*)(&wuffs_adler32__hasher__func_ptrs_for__wuffs_base__hasher_u32);
+  return wuffs_base__make_status(NULL);
+}
+
+wuffs_adler32__hasher*
+wuffs_adler32__hasher__alloc() {
+  wuffs_adler32__hasher* x =
+      (wuffs_adler32__hasher*)(calloc(sizeof(wuffs_adler32__hasher), 1));
+  if (!x) {
+    return NULL;
+  }
+  if (wuffs_adler32__hasher__initialize(
+      x, sizeof(wuffs_adler32__hasher), WUFFS_VERSION, WUFFS_INITIALIZE__ALREADY_ZEROED).repr) {
+    free(x);
+    return NULL;
+  }
+  return x;
+}
+
+size_t
+sizeof__wuffs_adler32__hasher() {
+  return sizeof(wuffs_adler32__hasher);
+}
+
+wuffs_base__stats
+wuffs_adler32__hasher__stats(
+    const wuffs_adler32__hasher* self) {
+  wuffs_base__stats ret = wuffs_base__make_empty_stats();
+#if defined(WUFFS_CONFIG__STATS)
+  if (!self) {
+    return ret;
+  }
+  ret = self->private_impl.stats;
+#else
+  (void)(self);
+#endif  // defined(WUFFS_CONFIG__STATS)
+  return ret;
+}
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+wuffs_adler32__hasher_x4__initialize(
+    wuffs_adler32__hasher_x4* self,
+    size_t sizeof_star_self,
+    uint64_t wuffs_version,
+    uint32_t options){
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  }
+
+  if ((options & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+    // The whole point of this if-check is to detect an uninitialized *self.
+    // We disable the warning on GCC. Clang-5.0 does not have this warning.
+    //
+    // The caller promises that *self is zeroed, so the empty asm tells GCC
+    // that private_impl is defined. Otherwise, once this function and a
+    // small method (e.g. one that reads a "choose" guard field) are both
+    // inlined into the caller, GCC -O3 warns about that method's read.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    __asm__ __volatile__("" : "+m"(self->private_impl));
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((options & WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      options |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    }
+  }
+
+  {
+    wuffs_base__status z = wuffs_adler32__hasher__initialize(
+        &self->private_data.f_tail, sizeof(self->private_data.f_tail), WUFFS_VERSION, options);
+    if (z.repr) {
+      return z;
+    }
+  }
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  return wuffs_base__make_status(NULL);
+}
+
+wuffs_adler32__hasher_x4*
+wuffs_adler32__hasher_x4__alloc() {
+  wuffs_adler32__hasher_x4* x =
+      (wuffs_adler32__hasher_x4*)(calloc(sizeof(wuffs_adler32__hasher_x4), 1));
+  if (!x) {
+    return NULL;
+  }
+  if (wuffs_adler32__hasher_x4__initialize(
+      x, sizeof(wuffs_adler32__hasher_x4), WUFFS_VERSION, WUFFS_INITIALIZE__ALREADY_ZEROED).repr) {
+    free(x);
+    return NULL;
+  }
+  return x;
+}
+
+size_t
+sizeof__wuffs_adler32__hasher_x4() {
+  return sizeof(wuffs_adler32__hasher_x4);
+}
+
+wuffs_base__stats
+wuffs_adler32__hasher_x4__stats(
+    const wuffs_adler32__hasher_x4* self) {
+  wuffs_base__stats ret = wuffs_base__make_empty_stats();
+#if defined(WUFFS_CONFIG__STATS)
+  if (!self) {
+    return ret;
+  }
+  ret = self->private_impl.stats;
+  {
+    wuffs_base__stats z = wuffs_adler32__hasher__stats(&self->private_data.f_tail);
+    wuffs_base__stats__accumulate(&ret, &z);
+  }
+#else
+  (void)(self);
+#endif  // defined(WUFFS_CONFIG__STATS)
+  return ret;
+}
+
+// ---------------- Function Implementations
+
+// -------- func adler32.hasher.set_quirk_enabled
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_adler32__hasher__set_quirk_enabled(
+    wuffs_adler32__hasher* self,
+    uint32_t a_quirk,
+    bool a_enabled) {
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func adler32.hasher.update_u32
+
+WUFFS_BASE__MAYBE_STATIC uint32_t
+wuffs_adler32__hasher__update_u32(
+    wuffs_adler32__hasher* self,
+    wuffs_base__slice_u8 a_x) {
+  if (!self) {
+    return 0;
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return 0;
+  }
+
+  if ( ! self->private_impl.f_started) {
+    self->private_impl.f_started = true;
+    self->private_impl.f_state = 1;
+    self->private_impl.choosy_up = (
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+        wuffs_base__cpu_arch__have_arm_neon() ? &wuffs_adler32__hasher__up_arm_neon :
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+        wuffs_base__cpu_arch__have_x86_avx2() ? &wuffs_adler32__hasher__up_x86_avx2 :
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+        wuffs_base__cpu_arch__have_x86_sse42() ? &wuffs_adler32__hasher__up_x86_sse42 :
+#endif
+        self->private_impl.choosy_up);
+  }
+  wuffs_adler32__hasher__up(self, a_x);
+  return self->private_impl.f_state;
+}
+
+// -------- func adler32.hasher.combine_u32
+
+WUFFS_BASE__MAYBE_STATIC uint32_t
+wuffs_adler32__hasher__combine_u32(
+    wuffs_adler32__hasher* self,
+    uint32_t a_checksum_b,
+    uint64_t a_length_b) {
+  if (!self) {
+    return 0;
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return 0;
+  }
+
+  uint32_t v_rem = 0;
+  uint32_t v_s1 = 0;
+  uint32_t v_s2 = 0;
+
+  if ( ! self->private_impl.f_started) {
+    self->private_impl.f_started = true;
+    self->private_impl.f_state = 1;
+    self->private_impl.choosy_up = (
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+        wuffs_base__cpu_arch__have_arm_neon() ? &wuffs_adler32__hasher__up_arm_neon :
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+        wuffs_base__cpu_arch__have_x86_avx2() ? &wuffs_adler32__hasher__up_x86_avx2 :
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+        wuffs_base__cpu_arch__have_x86_sse42() ? &wuffs_adler32__hasher__up_x86_sse42 :
+#endif
+        self->private_impl.choosy_up);
+  }
+  v_rem = ((uint32_t)((a_length_b % 65521)));
+  v_s1 = ((self->private_impl.f_state) & 0xFFFF);
+  v_s2 = ((v_rem * v_s1) % 65521);
+  v_s1 = (v_s1 + ((a_checksum_b) & 0xFFFF) + 65520);
+  v_s2 = ((v_s2 +
+      ((self->private_impl.f_state) >> (32 - (16))) +
+      ((a_checksum_b) >> (32 - (16))) +
+      65521) - v_rem);
+  v_s1 %= 65521;
+  v_s2 %= 65521;
+  self->private_impl.f_state = (((v_s2 & 65535) << 16) | (v_s1 & 65535));
+  return self->private_impl.f_state;
+}
+
+// -------- func adler32.hasher.up
+
+static wuffs_base__empty_struct
+wuffs_adler32__hasher__up(
+    wuffs_adler32__hasher* self,
+    wuffs_base__slice_u8 a_x) {
+  return (*self->private_impl.choosy_up)(self, a_x);
+}
+
+static wuffs_base__empty_struct
+wuffs_adler32__hasher__up__choosy_default(
+    wuffs_adler32__hasher* self,
+    wuffs_base__slice_u8 a_x) {
+  uint32_t v_s1 = 0;
+  uint32_t v_s2 = 0;
+  wuffs_base__slice_u8 v_remaining = {0};
+  wuffs_base__slice_u8 v_p = {0};
+
+  v_s1 = ((self->private_impl.f_state) & 0xFFFF);
+  v_s2 = ((self->private_impl.f_state) >> (32 - (16)));
+  while (((uint64_t)(a_x.len)) > 0) {
+    v_remaining = wuffs_base__slice_u8__subslice_j(a_x, 0);
+    if (((uint64_t)(a_x.len)) > 5552) {
+      v_remaining = wuffs_base__slice_u8__subslice_i(a_x, 5552);
+      a_x = wuffs_base__slice_u8__subslice_j(a_x, 5552);
+    }
+    {
+      wuffs_base__slice_u8 i_slice_p = a_x;
+      v_p.ptr = i_slice_p.ptr;
+      v_p.len = 1;
+      uint8_t* i_end0_p = v_p.ptr + (((i_slice_p.len - (size_t)(v_p.ptr - i_slice_p.ptr)) / 8) * 8);
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_p.ptr < i_end0_p) {
+        v_s1 += ((uint32_t)(v_p.ptr[0]));
+        v_s2 += v_s1;
+        v_p.ptr += 1;
+        v_s1 += ((uint32_t)(v_p.ptr[0]));
+        v_s2 += v_s1;
+        v_p.ptr += 1;
+        v_s1 += ((uint32_t)(v_p.ptr[0]));
+        v_s2 += v_s1;
+        v_p.ptr += 1;
+        v_s1 += ((uint32_t)(v_p.ptr[0]));
+        v_s2 += v_s1;
+        v_p.ptr += 1;
+        v_s1 += ((uint32_t)(v_p.ptr[0]));
+        v_s2 += v_s1;
+        v_p.ptr += 1;
+        v_s1 += ((uint32_t)(v_p.ptr[0]));
+        v_s2 += v_s1;
+        v_p.ptr += 1;
+        v_s1 += ((uint32_t)(v_p.ptr[0]));
+        v_s2 += v_s1;
+        v_p.ptr += 1;
+        v_s1 += ((uint32_t)(v_p.ptr[0]));
+        v_s2 += v_s1;
+        v_p.ptr += 1;
+      }
+      v_p.len = 1;
+      uint8_t* i_end1_p = i_slice_p.ptr + i_slice_p.len;
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_p.ptr < i_end1_p) {
+        v_s1 += ((uint32_t)(v_p.ptr[0]));
+        v_s2 += v_s1;
+        v_p.ptr += 1;
+      }
+      v_p.len = 0;
+    }
+    v_s1 %= 65521;
+    v_s2 %= 65521;
+    a_x = v_remaining;
+  }
+  self->private_impl.f_state = (((v_s2 & 65535) << 16) | (v_s1 & 65535));
+  return wuffs_base__make_empty_struct();
+}
+
+// ‼ WUFFS MULTI-FILE SECTION +arm_neon
+// -------- func adler32.hasher.up_arm_neon
+
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+static wuffs_base__empty_struct
+wuffs_adler32__hasher__up_arm_neon(
+    wuffs_adler32__hasher* self,
+    wuffs_base__slice_u8 a_x) {
+  uint32_t v_s1 = 0;
+  uint32_t v_s2 = 0;
+  wuffs_base__slice_u8 v_remaining = {0};
+  wuffs_base__slice_u8 v_p = {0};
+  uint8x16_t v_p__left = {0};
+  uint8x16_t v_p_right = {0};
+  uint32x4_t v_v1 = {0};
+  uint32x4_t v_v2 = {0};
+  uint16x8_t v_col0 = {0};
+  uint16x8_t v_col1 = {0};
+  uint16x8_t v_col2 = {0};
+  uint16x8_t v_col3 = {0};
+  uint32x2_t v_sum1 = {0};
+  uint32x2_t v_sum2 = {0};
+  uint32x2_t v_sum12 = {0};
+  uint32_t v_num_iterate_bytes = 0;
+  uint64_t v_tail_index = 0;
+
+  v_s1 = ((self->private_impl.f_state) & 0xFFFF);
+  v_s2 = ((self->private_impl.f_state) >> (32 - (16)));
+  while ((((uint64_t)(a_x.len)) > 0) && ((15 & ((uint32_t)(0xFFF & (uintptr_t)(a_x.ptr)))) != 0)) {
+    v_s1 += ((uint32_t)(a_x.ptr[0]));
+    v_s2 += v_s1;
+    a_x = wuffs_base__slice_u8__subslice_i(a_x, 1);
+  }
+  v_s1 %= 65521;
+  v_s2 %= 65521;
+  while (((uint64_t)(a_x.len)) > 0) {
+    v_remaining = wuffs_base__slice_u8__subslice_j(a_x, 0);
+    if (((uint64_t)(a_x.len)) > 5536) {
+      v_remaining = wuffs_base__slice_u8__subslice_i(a_x, 5536);
+      a_x = wuffs_base__slice_u8__subslice_j(a_x, 5536);
+    }
+    v_num_iterate_bytes = ((uint32_t)((((uint64_t)(a_x.len)) & 4294967264)));
+    v_s2 += ((uint32_t)(v_s1 * v_num_iterate_bytes));
+    v_v1 = vdupq_n_u32(0);
+    v_v2 = vdupq_n_u32(0);
+    v_col0 = vdupq_n_u16(0);
+    v_col1 = vdupq_n_u16(0);
+    v_col2 = vdupq_n_u16(0);
+    v_col3 = vdupq_n_u16(0);
+    {
+      wuffs_base__slice_u8 i_slice_p = a_x;
+      v_p.ptr = i_slice_p.ptr;
+      v_p.len = 32;
+      uint8_t* i_end0_p = v_p.ptr + (((i_slice_p.len - (size_t)(v_p.ptr - i_slice_p.ptr)) / 32) * 32);
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_p.ptr < i_end0_p) {
+        v_p__left = vld1q_u8(v_p.ptr);
+        v_p_right = vld1q_u8(v_p.ptr + 16);
+        v_v2 = vaddq_u32(v_v2, v_v1);
+        v_v1 = vpadalq_u16(v_v1, vpadalq_u8(vpaddlq_u8(v_p__left), v_p_right));
+        v_col0 = vaddw_u8(v_col0, vget_low_u8(v_p__left));
+        v_col1 = vaddw_u8(v_col1, vget_high_u8(v_p__left));
+        v_col2 = vaddw_u8(v_col2, vget_low_u8(v_p_right));
+        v_col3 = vaddw_u8(v_col3, vget_high_u8(v_p_right));
+        v_p.ptr += 32;
+      }
+      v_p.len = 0;
+    }
+    v_v2 = vshlq_n_u32(v_v2, 5);
+    v_v2 = vmlal_u16(v_v2, vget_low_u16(v_col0), ((uint16x4_t){32, 31, 30, 29}));
+    v_v2 = vmlal_u16(v_v2, vget_high_u16(v_col0), ((uint16x4_t){28, 27, 26, 25}));
+    v_v2 = vmlal_u16(v_v2, vget_low_u16(v_col1), ((uint16x4_t){24, 23, 22, 21}));
+    v_v2 = vmlal_u16(v_v2, vget_high_u16(v_col1), ((uint16x4_t){20, 19, 18, 17}));
+    v_v2 = vmlal_u16(v_v2, vget_low_u16(v_col2), ((uint16x4_t){16, 15, 14, 13}));
+    v_v2 = vmlal_u16(v_v2, vget_high_u16(v_col2), ((uint16x4_t){12, 11, 10, 9}));
+    v_v2 = vmlal_u16(v_v2, vget_low_u16(v_col3), ((uint16x4_t){8, 7, 6, 5}));
+    v_v2 = vmlal_u16(v_v2, vget_high_u16(v_col3), ((uint16x4_t){4, 3, 2, 1}));
+    v_sum1 = vpadd_u32(vget_low_u32(v_v1), vget_high_u32(v_v1));
+    v_sum2 = vpadd_u32(vget_low_u32(v_v2), vget_high_u32(v_v2));
+    v_sum12 = vpadd_u32(v_sum1, v_sum2);
+    v_s1 += vget_lane_u32(v_sum12, 0);
+    v_s2 += vget_lane_u32(v_sum12, 1);
+    v_tail_index = (((uint64_t)(a_x.len)) & 18446744073709551584u);
+    if (v_tail_index < ((uint64_t)(a_x.len))) {
+      {
+        wuffs_base__slice_u8 i_slice_p = wuffs_base__slice_u8__subslice_i(a_x, v_tail_index);
+        v_p.ptr = i_slice_p.ptr;
+        v_p.len = 1;
+        uint8_t* i_end0_p = i_slice_p.ptr + i_slice_p.len;
+        WUFFS_BASE__ITERATE_LOOP_HINT
+        while (v_p.ptr < i_end0_p) {
+          v_s1 += ((uint32_t)(v_p.ptr[0]));
+          v_s2 += v_s1;
+          v_p.ptr += 1;
+        }
+        v_p.len = 0;
+      }
+    }
+    v_s1 %= 65521;
+    v_s2 %= 65521;
+    a_x = v_remaining;
+  }
+  self->private_impl.f_state = (((v_s2 & 65535) << 16) | (v_s1 & 65535));
+  return wuffs_base__make_empty_struct();
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+// ‼ WUFFS MULTI-FILE SECTION -arm_neon
+
+// ‼ WUFFS MULTI-FILE SECTION +x86_avx2
+// -------- func adler32.hasher.up_x86_avx2
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static wuffs_base__empty_struct
+wuffs_adler32__hasher__up_x86_avx2(
+    wuffs_adler32__hasher* self,
+    wuffs_base__slice_u8 a_x) {
+  uint32_t v_s1 = 0;
+  uint32_t v_s2 = 0;
+  wuffs_base__slice_u8 v_remaining = {0};
+  wuffs_base__slice_u8 v_p = {0};
+  __m256i v_zeroes = {0};
+  __m256i v_ones = {0};
+  __m256i v_weights__left = {0};
+  __m256i v_weights_right = {0};
+  __m256i v_q__left = {0};
+  __m256i v_q_right = {0};
+  __m256i v_v1 = {0};
+  __m256i v_v2 = {0};
+  __m256i v_v2j = {0};
+  __m256i v_v2k = {0};
+  __m128i v_w1 = {0};
+  __m128i v_w2 = {0};
+  uint32_t v_num_iterate_bytes = 0;
+  uint64_t v_tail_index = 0;
+
+  v_zeroes = _mm256_set1_epi16((int16_t)(0));
+  v_ones = _mm256_set1_epi16((int16_t)(1));
+  v_weights__left = _mm256_set_epi8((int8_t)(33), (int8_t)(34), (int8_t)(35), (int8_t)(36), (int8_t)(37), (int8_t)(38), (int8_t)(39), (int8_t)(40), (int8_t)(41), (int8_t)(42), (int8_t)(43), (int8_t)(44), (int8_t)(45), (int8_t)(46), (int8_t)(47), (int8_t)(48), (int8_t)(49), (int8_t)(50), (int8_t)(51), (int8_t)(52), (int8_t)(53), (int8_t)(54), (int8_t)(55), (int8_t)(56), (int8_t)(57), (int8_t)(58), (int8_t)(59), (int8_t)(60), (int8_t)(61), (int8_t)(62), (int8_t)(63), (int8_t)(64));
+  v_weights_right = _mm256_set_epi8((int8_t)(1), (int8_t)(2), (int8_t)(3), (int8_t)(4), (int8_t)(5), (int8_t)(6), (int8_t)(7), (int8_t)(8), (int8_t)(9), (int8_t)(10), (int8_t)(11), (int8_t)(12), (int8_t)(13), (int8_t)(14), (int8_t)(15), (int8_t)(16), (int8_t)(17), (int8_t)(18), (int8_t)(19), (int8_t)(20), (int8_t)(21), (int8_t)(22), (int8_t)(23), (int8_t)(24), (int8_t)(25), (int8_t)(26), (int8_t)(27), (int8_t)(28), (int8_t)(29), (int8_t)(30), (int8_t)(31), (int8_t)(32));
+  v_s1 = ((self->private_impl.f_state) & 0xFFFF);
+  v_s2 = ((self->private_impl.f_state) >> (32 - (16)));
+  while (((uint64_t)(a_x.len)) > 0) {
+    v_remaining = wuffs_base__slice_u8__subslice_j(a_x, 0);
+    if (((uint64_t)(a_x.len)) > 5504) {
+      v_remaining = wuffs_base__slice_u8__subslice_i(a_x, 5504);
+      a_x = wuffs_base__slice_u8__subslice_j(a_x, 5504);
+    }
+    v_num_iterate_bytes = ((uint32_t)((((uint64_t)(a_x.len)) & 4294967232)));
+    v_s2 += ((uint32_t)(v_s1 * v_num_iterate_bytes));
+    v_v1 = _mm256_setzero_si256();
+    v_v2j = _mm256_setzero_si256();
+    v_v2k = _mm256_setzero_si256();
+    {
+      wuffs_base__slice_u8 i_slice_p = a_x;
+      v_p.ptr = i_slice_p.ptr;
+      v_p.len = 64;
+      uint8_t* i_end0_p = v_p.ptr + (((i_slice_p.len - (size_t)(v_p.ptr - i_slice_p.ptr)) / 64) * 64);
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_p.ptr < i_end0_p) {
+        v_q__left = _mm256_lddqu_si256((const __m256i*)(const void*)(v_p.ptr));
+        v_q_right = _mm256_lddqu_si256((const __m256i*)(const void*)(v_p.ptr + 32));
+        v_v2j = _mm256_add_epi32(v_v2j, v_v1);
+        v_v1 = _mm256_add_epi32(v_v1, _mm256_sad_epu8(v_q__left, v_zeroes));
+        v_v1 = _mm256_add_epi32(v_v1, _mm256_sad_epu8(v_q_right, v_zeroes));
+        v_v2k = _mm256_add_epi32(v_v2k, _mm256_madd_epi16(v_ones, _mm256_maddubs_epi16(v_q__left, v_weights__left)));
+        v_v2k = _mm256_add_epi32(v_v2k, _mm256_madd_epi16(v_ones, _mm256_maddubs_epi16(v_q_right, v_weights_right)));
+        v_p.ptr += 64;
+      }
+      v_p.len = 0;
+    }
+    v_w1 = _mm_add_epi32(_mm256_extracti128_si256(v_v1, (int32_t)(0)), _mm256_extracti128_si256(v_v1, (int32_t)(1)));
+    v_w1 = _mm_add_epi32(v_w1, _mm_shuffle_epi32(v_w1, (int32_t)(177)));
+    v_w1 = _mm_add_epi32(v_w1, _mm_shuffle_epi32(v_w1, (int32_t)(78)));
+    v_s1 += ((uint32_t)(_mm_cvtsi128_si32(v_w1)));
+    v_v2 = _mm256_add_epi32(v_v2k, _mm256_slli_epi32(v_v2j, (int32_t)(6)));
+    v_w2 = _mm_add_epi32(_mm256_extracti128_si256(v_v2, (int32_t)(0)), _mm256_extracti128_si256(v_v2, (int32_t)(1)));
+    v_w2 = _mm_add_epi32(v_w2, _mm_shuffle_epi32(v_w2, (int32_t)(177)));
+    v_w2 = _mm_add_epi32(v_w2, _mm_shuffle_epi32(v_w2, (int32_t)(78)));
+    v_s2 += ((uint32_t)(_mm_cvtsi128_si32(v_w2)));
+    v_tail_index = (((uint64_t)(a_x.len)) & 18446744073709551552u);
+    if (v_tail_index < ((uint64_t)(a_x.len))) {
+      {
+        wuffs_base__slice_u8 i_slice_p = wuffs_base__slice_u8__subslice_i(a_x, v_tail_index);
+        v_p.ptr = i_slice_p.ptr;
+        v_p.len = 1;
+        uint8_t* i_end0_p = i_slice_p.ptr + i_slice_p.len;
+        WUFFS_BASE__ITERATE_LOOP_HINT
+        while (v_p.ptr < i_end0_p) {
+          v_s1 += ((uint32_t)(v_p.ptr[0]));
+          v_s2 += v_s1;
+          v_p.ptr += 1;
+        }
+        v_p.len = 0;
+      }
+    }
+    v_s1 %= 65521;
+    v_s2 %= 65521;
+    a_x = v_remaining;
+  }
+  self->private_impl.f_state = (((v_s2 & 65535) << 16) | (v_s1 & 65535));
+  return wuffs_base__make_empty_struct();
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// ‼ WUFFS MULTI-FILE SECTION -x86_avx2
+
+// ‼ WUFFS MULTI-FILE SECTION +x86_sse42
+// -------- func adler32.hasher.up_x86_sse42
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+static wuffs_base__empty_struct
+wuffs_adler32__hasher__up_x86_sse42(
+    wuffs_adler32__hasher* self,
+    wuffs_base__slice_u8 a_x) {
+  uint32_t v_s1 = 0;
+  uint32_t v_s2 = 0;
+  wuffs_base__slice_u8 v_remaining = {0};
+  wuffs_base__slice_u8 v_p = {0};
+  __m128i v_zeroes = {0};
+  __m128i v_ones = {0};
+  __m128i v_weights__left = {0};
+  __m128i v_weights_right = {0};
+  __m128i v_q__left = {0};
+  __m128i v_q_right = {0};
+  __m128i v_v1 = {0};
+  __m128i v_v2 = {0};
+  __m128i v_v2j = {0};
+  __m128i v_v2k = {0};
+  uint32_t v_num_iterate_bytes = 0;
+  uint64_t v_tail_index = 0;
+
+  v_zeroes = _mm_set1_epi16((int16_t)(0));
+  v_ones = _mm_set1_epi16((int16_t)(1));
+  v_weights__left = _mm_set_epi8((int8_t)(17), (int8_t)(18), (int8_t)(19), (int8_t)(20), (int8_t)(21), (int8_t)(22), (int8_t)(23), (int8_t)(24), (int8_t)(25), (int8_t)(26), (int8_t)(27), (int8_t)(28), (int8_t)(29), (int8_t)(30), (int8_t)(31), (int8_t)(32));
+  v_weights_right = _mm_set_epi8((int8_t)(1), (int8_t)(2), (int8_t)(3), (int8_t)(4), (int8_t)(5), (int8_t)(6), (int8_t)(7), (int8_t)(8), (int8_t)(9), (int8_t)(10), (int8_t)(11), (int8_t)(12), (int8_t)(13), (int8_t)(14), (int8_t)(15), (int8_t)(16));
+  v_s1 = ((self->private_impl.f_state) & 0xFFFF);
+  v_s2 = ((self->private_impl.f_state) >> (32 - (16)));
+  while (((uint64_t)(a_x.len)) > 0) {
+    v_remaining = wuffs_base__slice_u8__subslice_j(a_x, 0);
+    if (((uint64_t)(a_x.len)) > 5536) {
+      v_remaining = wuffs_base__slice_u8__subslice_i(a_x, 5536);
+      a_x = wuffs_base__slice_u8__subslice_j(a_x, 5536);
+    }
+    v_num_iterate_bytes = ((uint32_t)((((uint64_t)(a_x.len)) & 4294967264)));
+    v_s2 += ((uint32_t)(v_s1 * v_num_iterate_bytes));
+    v_v1 = _mm_setzero_si128();
+    v_v2j = _mm_setzero_si128();
+    v_v2k = _mm_setzero_si128();
+    {
+      wuffs_base__slice_u8 i_slice_p = a_x;
+      v_p.ptr = i_slice_p.ptr;
+      v_p.len = 32;
+      uint8_t* i_end0_p = v_p.ptr + (((i_slice_p.len - (size_t)(v_p.ptr - i_slice_p.ptr)) / 32) * 32);
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_p.ptr < i_end0_p) {
+        v_q__left = _mm_lddqu_si128((const __m128i*)(const void*)(v_p.ptr));
+        v_q_right = _mm_lddqu_si128((const __m128i*)(const void*)(v_p.ptr + 16));
+        v_v2j = _mm_add_epi32(v_v2j, v_v1);
+        v_v1 = _mm_add_epi32(v_v1, _mm_sad_epu8(v_q__left, v_zeroes));
+        v_v1 = _mm_add_epi32(v_v1, _mm_sad_epu8(v_q_right, v_zeroes));
+        v_v2k = _mm_add_epi32(v_v2k, _mm_madd_epi16(v_ones, _mm_maddubs_epi16(v_q__left, v_weights__left)));
+        v_v2k = _mm_add_epi32(v_v2k, _mm_madd_epi16(v_ones, _mm_maddubs_epi16(v_q_right, v_weights_right)));
+        v_p.ptr += 32;
+      }
+      v_p.len = 0;
+    }
+    v_v1 = _mm_add_epi32(v_v1, _mm_shuffle_epi32(v_v1, (int32_t)(177)));
+    v_v1 = _mm_add_epi32(v_v1, _mm_shuffle_epi32(v_v1, (int32_t)(78)));
+    v_s1 += ((uint32_t)(_mm_cvtsi128_si32(v_v1)));
+    v_v2 = _mm_add_epi32(v_v2k, _mm_slli_epi32(v_v2j, (int32_t)(5)));
+    v_v2 = _mm_add_epi32(v_v2, _mm_shuffle_epi32(v_v2, (int32_t)(177)));
+    v_v2 = _mm_add_epi32(v_v2, _mm_shuffle_epi32(v_v2, (int32_t)(78)));
+    v_s2 += ((uint32_t)(_mm_cvtsi128_si32(v_v2)));
+    v_tail_index = (((uint64_t)(a_x.len)) & 18446744073709551584u);
+    if (v_tail_index < ((uint64_t)(a_x.len))) {
+      {
+        wuffs_base__slice_u8 i_slice_p = wuffs_base__slice_u8__subslice_i(a_x, v_tail_index);
+        v_p.ptr = i_slice_p.ptr;
+        v_p.len = 1;
+        uint8_t* i_end0_p = i_slice_p.ptr + i_slice_p.len;
+        WUFFS_BASE__ITERATE_LOOP_HINT
+        while (v_p.ptr < i_end0_p) {
+          v_s1 += ((uint32_t)(v_p.ptr[0]));
+          v_s2 += v_s1;
+          v_p.ptr += 1;
+        }
+        v_p.len = 0;
+      }
+    }
+    v_s1 %= 65521;
+    v_s2 %= 65521;
+    a_x = v_remaining;
+  }
+  self->private_impl.f_state = (((v_s2 & 65535) << 16) | (v_s1 & 65535));
+  return wuffs_base__make_empty_struct();
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// ‼ WUFFS MULTI-FILE SECTION -x86_sse42
+
+// -------- func adler32.hasher_x4.set_quirk_enabled
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_adler32__hasher_x4__set_quirk_enabled(
+    wuffs_adler32__hasher_x4* self,
+    uint32_t a_quirk,
+    bool a_enabled) {
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func adler32.hasher_x4.update_x4
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_adler32__hasher_x4__update_x4(
+    wuffs_adler32__hasher_x4* self,
+    wuffs_base__slice_u8 a_x0,
+    wuffs_base__slice_u8 a_x1,
+    wuffs_base__slice_u8 a_x2,
+    wuffs_base__slice_u8 a_x3) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  uint64_t v_n = 0;
+
+  if ( ! self->private_impl.f_started) {
+    self->private_impl.f_started = true;
+    self->private_impl.f_states[0] = 1;
+    self->private_impl.f_states[1] = 1;
+    self->private_impl.f_states[2] = 1;
+    self->private_impl.f_states[3] = 1;
+    wuffs_adler32__hasher__update_u32(&self->private_data.f_tail, wuffs_base__slice_u8__subslice_j(a_x0, 0));
+  }
+  v_n = 0;
+  if ((((uint64_t)(a_x0.len)) < 64) &&
+      (((uint64_t)(a_x1.len)) < 64) &&
+      (((uint64_t)(a_x2.len)) < 64) &&
+      (((uint64_t)(a_x3.len)) < 64)) {
+    v_n = wuffs_adler32__hasher_x4__up_x4(self,
+        a_x0,
+        a_x1,
+        a_x2,
+        a_x3);
+  }
+  if (v_n <= ((uint64_t)(a_x0.len))) {
+    wuffs_adler32__hasher_x4__up_tail(self, 0, wuffs_base__slice_u8__subslice_i(a_x0, v_n));
+  }
+  if (v_n <= ((uint64_t)(a_x1.len))) {
+    wuffs_adler32__hasher_x4__up_tail(self, 1, wuffs_base__slice_u8__subslice_i(a_x1, v_n));
+  }
+  if (v_n <= ((uint64_t)(a_x2.len))) {
+    wuffs_adler32__hasher_x4__up_tail(self, 2, wuffs_base__slice_u8__subslice_i(a_x2, v_n));
+  }
+  if (v_n <= ((uint64_t)(a_x3.len))) {
+    wuffs_adler32__hasher_x4__up_tail(self, 3, wuffs_base__slice_u8__subslice_i(a_x3, v_n));
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func adler32.hasher_x4.checksum_u32
+
+WUFFS_BASE__MAYBE_STATIC uint32_t
+wuffs_adler32__hasher_x4__checksum_u32(
+    const wuffs_adler32__hasher_x4* self,
+    uint32_t a_lane) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_states[(a_lane & 3)];
+}
+
+// -------- func adler32.hasher_x4.up_tail
+
+static wuffs_base__empty_struct
+wuffs_adler32__hasher_x4__up_tail(
+    wuffs_adler32__hasher_x4* self,
+    uint32_t a_lane,
+    wuffs_base__slice_u8 a_x) {
+  if (((uint64_t)(a_x.len)) > 0) {
+    self->private_data.f_tail.private_impl.f_state = self->private_impl.f_states[a_lane];
+    self->private_impl.f_states[a_lane] = wuffs_adler32__hasher__update_u32(&self->private_data.f_tail, a_x);
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func adler32.hasher_x4.up_x4
+
+static uint64_t
+wuffs_adler32__hasher_x4__up_x4(
+    wuffs_adler32__hasher_x4* self,
+    wuffs_base__slice_u8 a_x0,
+    wuffs_base__slice_u8 a_x1,
+    wuffs_base__slice_u8 a_x2,
+    wuffs_base__slice_u8 a_x3) {
+  uint32_t v_a0 = 0;
+  uint32_t v_b0 = 0;
+  uint32_t v_a1 = 0;
+  uint32_t v_b1 = 0;
+  uint32_t v_a2 = 0;
+  uint32_t v_b2 = 0;
+  uint32_t v_a3 = 0;
+  uint32_t v_b3 = 0;
+  wuffs_base__slice_u8 v_p0 = {0};
+  wuffs_base__slice_u8 v_p1 = {0};
+  wuffs_base__slice_u8 v_p2 = {0};
+  wuffs_base__slice_u8 v_p3 = {0};
+  uint64_t v_n = 0;
+
+  v_a0 = ((self->private_impl.f_states[0]) & 0xFFFF);
+  v_b0 = ((self->private_impl.f_states[0]) >> (32 - (16)));
+  v_a1 = ((self->private_impl.f_states[1]) & 0xFFFF);
+  v_b1 = ((self->private_impl.f_states[1]) >> (32 - (16)));
+  v_a2 = ((self->private_impl.f_states[2]) & 0xFFFF);
+  v_b2 = ((self->private_impl.f_states[2]) >> (32 - (16)));
+  v_a3 = ((self->private_impl.f_states[3]) & 0xFFFF);
+  v_b3 = ((self->private_impl.f_states[3]) >> (32 - (16)));
+  {
+    wuffs_base__slice_u8 i_slice_p0 = a_x0;
+    v_p0.ptr = i_slice_p0.ptr;
+    wuffs_base__slice_u8 i_slice_p1 = a_x1;
+    v_p1.ptr = i_slice_p1.ptr;
+    i_slice_p0.len = ((size_t)(wuffs_base__u64__min(i_slice_p0.len, i_slice_p1.len)));
+    wuffs_base__slice_u8 i_slice_p2 = a_x2;
+    v_p2.ptr = i_slice_p2.ptr;
+    i_slice_p0.len = ((size_t)(wuffs_base__u64__min(i_slice_p0.len, i_slice_p2.len)));
+    wuffs_base__slice_u8 i_slice_p3 = a_x3;
+    v_p3.ptr = i_slice_p3.ptr;
+    i_slice_p0.len = ((size_t)(wuffs_base__u64__min(i_slice_p0.len, i_slice_p3.len)));
+    v_p0.len = 1;
+    v_p1.len = 1;
+    v_p2.len = 1;
+    v_p3.len = 1;
+    uint8_t* i_end0_p0 = v_p0.ptr + (((i_slice_p0.len - (size_t)(v_p0.ptr - i_slice_p0.ptr)) / 4) * 4);
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_p0.ptr < i_end0_p0) {
+      v_a0 += ((uint32_t)(v_p0.ptr[0]));
+      v_b0 += v_a0;
+      v_a1 += ((uint32_t)(v_p1.ptr[0]));
+      v_b1 += v_a1;
+      v_a2 += ((uint32_t)(v_p2.ptr[0]));
+      v_b2 += v_a2;
+      v_a3 += ((uint32_t)(v_p3.ptr[0]));
+      v_b3 += v_a3;
+      v_n += 1;
+      v_p0.ptr += 1;
+      v_p1.ptr += 1;
+      v_p2.ptr += 1;
+      v_p3.ptr += 1;
+      v_a0 += ((uint32_t)(v_p0.ptr[0]));
+      v_b0 += v_a0;
+      v_a1 += ((uint32_t)(v_p1.ptr[0]));
+      v_b1 += v_a1;
+      v_a2 += ((uint32_t)(v_p2.ptr[0]));
+      v_b2 += v_a2;
+      v_a3 += ((uint32_t)(v_p3.ptr[0]));
+      v_b3 += v_a3;
+      v_n += 1;
+      v_p0.ptr += 1;
+      v_p1.ptr += 1;
+      v_p2.ptr += 1;
+      v_p3.ptr += 1;
+      v_a0 += ((uint32_t)(v_p0.ptr[0]));
+      v_b0 += v_a0;
+      v_a1 += ((uint32_t)(v_p1.ptr[0]));
+      v_b1 += v_a1;
+      v_a2 += ((uint32_t)(v_p2.ptr[0]));
+      v_b2 += v_a2;
+      v_a3 += ((uint32_t)(v_p3.ptr[0]));
+      v_b3 += v_a3;
+      v_n += 1;
+      v_p0.ptr += 1;
+      v_p1.ptr += 1;
+      v_p2.ptr += 1;
+      v_p3.ptr += 1;
+      v_a0 += ((uint32_t)(v_p0.ptr[0]));
+      v_b0 += v_a0;
+      v_a1 += ((uint32_t)(v_p1.ptr[0]));
+      v_b1 += v_a1;
+      v_a2 += ((uint32_t)(v_p2.ptr[0]));
+      v_b2 += v_a2;
+      v_a3 += ((uint32_t)(v_p3.ptr[0]));
+      v_b3 += v_a3;
+      v_n += 1;
+      v_p0.ptr += 1;
+      v_p1.ptr += 1;
+      v_p2.ptr += 1;
+      v_p3.ptr += 1;
+    }
+    v_p0.len = 1;
+    v_p1.len = 1;
+    v_p2.len = 1;
+    v_p3.len = 1;
+    uint8_t* i_end1_p0 = i_slice_p0.ptr + i_slice_p0.len;
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_p0.ptr < i_end1_p0) {
+      v_a0 += ((uint32_t)(v_p0.ptr[0]));
+      v_b0 += v_a0;
+      v_a1 += ((uint32_t)(v_p1.ptr[0]));
+      v_b1 += v_a1;
+      v_a2 += ((uint32_t)(v_p2.ptr[0]));
+      v_b2 += v_a2;
+      v_a3 += ((uint32_t)(v_p3.ptr[0]));
+      v_b3 += v_a3;
+      v_n += 1;
+      v_p0.ptr += 1;
+      v_p1.ptr += 1;
+      v_p2.ptr += 1;
+      v_p3.ptr += 1;
+    }
+    v_p0.len = 0;
+    v_p1.len = 0;
+    v_p2.len = 0;
+    v_p3.len = 0;
+  }
+  self->private_impl.f_states[0] = ((((v_b0 % 65521) & 65535) << 16) | ((v_a0 % 65521) & 65535));
+  self->private_impl.f_states[1] = ((((v_b1 % 65521) & 65535) << 16) | ((v_a1 % 65521) & 65535));
+  self->private_impl.f_states[2] = ((((v_b2 % 65521) & 65535) << 16) | ((v_a2 % 65521) & 65535));
+  self->private_impl.f_states[3] = ((((v_b3 % 65521) & 65535) << 16) | ((v_a3 % 65521) & 65535));
+  return v_n;
+}
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__ADLER32)
+
+
+#endif  // WUFFS_IMPLEMENTATION
+
+// ¡ WUFFS MONOLITHIC RELEASE DISCARDS EVERYTHING BELOW.
+
+#endif  // WUFFS_INCLUDE_GUARD__ADLER32
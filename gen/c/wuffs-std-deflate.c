@@ -0,0 +1,5013 @@
+#ifndef WUFFS_INCLUDE_GUARD__DEFLATE
+#define WUFFS_INCLUDE_GUARD__DEFLATE
+
+#if defined(WUFFS_IMPLEMENTATION) && !defined(WUFFS_CONFIG__MODULES)
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__DEFLATE
+#endif
+
+#include "./wuffs-base.c"
+
+// ¡ WUFFS MONOLITHIC RELEASE DISCARDS EVERYTHING ABOVE.
+
+
+// ---------------- Status Codes
+
+extern const char wuffs_deflate__error__bad_huffman_code_over_subscribed[];
+extern const char wuffs_deflate__error__bad_huffman_code_under_subscribed[];
+extern const char wuffs_deflate__error__bad_huffman_code_length_count[];
+extern const char wuffs_deflate__error__bad_huffman_code_length_repetition[];
+extern const char wuffs_deflate__error__bad_huffman_code[];
+extern const char wuffs_deflate__error__bad_huffman_minimum_code_length[];
+extern const char wuffs_deflate__error__bad_block[];
+extern const char wuffs_deflate__error__bad_distance[];
+extern const char wuffs_deflate__error__bad_distance_code_count[];
+extern const char wuffs_deflate__error__bad_literal_length_code_count[];
+extern const char wuffs_deflate__error__inconsistent_stored_block_length[];
+extern const char wuffs_deflate__error__missing_end_of_block_code[];
+extern const char wuffs_deflate__error__no_huffman_codes[];
+extern const char wuffs_deflate__note__block_boundary[];
+extern const char wuffs_deflate__suspension__output_slice[];
+
+// ---------------- Public Consts
+
+#define WUFFS_DEFLATE__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE 33025
+
+#define WUFFS_DEFLATE__ENCODER_WORKBUF_LEN_MAX_INCL_WORST_CASE 0
+
+#define WUFFS_DEFLATE__ENCODER_DEFAULT_LEVEL 6
+
+#define WUFFS_DEFLATE__ENCODER_FLUSH_NONE 0
+
+#define WUFFS_DEFLATE__ENCODER_FLUSH_FULL 1
+
+#define WUFFS_DEFLATE__ENCODER_FLUSH_FINISH 2
+
+// ---------------- Struct Declarations
+
+typedef struct wuffs_deflate__decoder__struct wuffs_deflate__decoder;
+
+typedef struct wuffs_deflate__encoder__struct wuffs_deflate__encoder;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ---------------- Public Initializer Prototypes
+
+// For any given "wuffs_foo__bar* self", "wuffs_foo__bar__initialize(self,
+// etc)" should be called before any other "wuffs_foo__bar__xxx(self, etc)".
+//
+// Pass sizeof(*self) and WUFFS_VERSION for sizeof_star_self and wuffs_version.
+// Pass 0 (or some combination of WUFFS_INITIALIZE__XXX) for options.
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+wuffs_deflate__decoder__initialize(
+    wuffs_deflate__decoder* self,
+    size_t sizeof_star_self,
+    uint64_t wuffs_version,
+    uint32_t options);
+
+wuffs_base__stats
+wuffs_deflate__decoder__stats(
+    const wuffs_deflate__decoder* self);
+
+size_t
+sizeof__wuffs_deflate__decoder();
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+wuffs_deflate__encoder__initialize(
+    wuffs_deflate__encoder* self,
+    size_t sizeof_star_self,
+    uint64_t wuffs_version,
+    uint32_t options);
+
+wuffs_base__stats
+wuffs_deflate__encoder__stats(
+    const wuffs_deflate__encoder* self);
+
+size_t
+sizeof__wuffs_deflate__encoder();
+
+// ---------------- Allocs
+
+// These functions allocate and initialize Wuffs structs. They return NULL if
+// memory allocation fails. If they return non-NULL, there is no need to call
+// wuffs_foo__bar__initialize, but the caller is responsible for eventually
+// calling free on the returned pointer. That pointer is effectively a C++
+// std::unique_ptr<T, decltype(&free)>.
+
+wuffs_deflate__decoder*
+wuffs_deflate__decoder__alloc();
+
+static inline wuffs_base__io_transformer*
+wuffs_deflate__decoder__alloc_as__wuffs_base__io_transformer() {
+  return (wuffs_base__io_transformer*)(wuffs_deflate__decoder__alloc());
+}
+
+wuffs_deflate__encoder*
+wuffs_deflate__encoder__alloc();
+
+static inline wuffs_base__io_transformer*
+wuffs_deflate__encoder__alloc_as__wuffs_base__io_transformer() {
+  return (wuffs_base__io_transformer*)(wuffs_deflate__encoder__alloc());
+}
+
+// ---------------- Upcasts
+
+static inline wuffs_base__io_transformer*
+wuffs_deflate__decoder__upcast_as__wuffs_base__io_transformer(
+    wuffs_deflate__decoder* p) {
+  return (wuffs_base__io_transformer*)p;
+}
+
+static inline wuffs_base__io_transformer*
+wuffs_deflate__encoder__upcast_as__wuffs_base__io_transformer(
+    wuffs_deflate__encoder* p) {
+  return (wuffs_base__io_transformer*)p;
+}
+
+// ---------------- Public Function Prototypes
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_deflate__decoder__add_history(
+    wuffs_deflate__decoder* self,
+    wuffs_base__slice_u8 a_hist,
+    wuffs_base__slice_u8 a_workbuf);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_deflate__decoder__set_report_block_boundaries(
+    wuffs_deflate__decoder* self,
+    bool a_report);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_deflate__decoder__set_report_output_slices(
+    wuffs_deflate__decoder* self,
+    bool a_report);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_deflate__decoder__set_dst_holds_history(
+    wuffs_deflate__decoder* self,
+    bool a_enabled);
+
+WUFFS_BASE__MAYBE_STATIC uint32_t
+wuffs_deflate__decoder__pending_bits(
+    const wuffs_deflate__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC uint32_t
+wuffs_deflate__decoder__pending_n_bits(
+    const wuffs_deflate__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_deflate__decoder__set_pending_bits(
+    wuffs_deflate__decoder* self,
+    uint32_t a_bits,
+    uint32_t a_n_bits);
+
+WUFFS_BASE__MAYBE_STATIC uint64_t
+wuffs_deflate__decoder__copy_history(
+    wuffs_deflate__decoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_workbuf);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_deflate__decoder__set_quirk_enabled(
+    wuffs_deflate__decoder* self,
+    uint32_t a_quirk,
+    bool a_enabled);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64
+wuffs_deflate__decoder__workbuf_len(
+    const wuffs_deflate__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_deflate__decoder__transform_io(
+    wuffs_deflate__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_deflate__encoder__set_quirk_enabled(
+    wuffs_deflate__encoder* self,
+    uint32_t a_quirk,
+    bool a_enabled);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_deflate__encoder__set_level(
+    wuffs_deflate__encoder* self,
+    uint32_t a_level);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_deflate__encoder__set_flush_mode(
+    wuffs_deflate__encoder* self,
+    uint32_t a_mode);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64
+wuffs_deflate__encoder__workbuf_len(
+    const wuffs_deflate__encoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_deflate__encoder__transform_io(
+    wuffs_deflate__encoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+// ---------------- Struct Definitions
+
+// These structs' fields, and the sizeof them, are private implementation
+// details that aren't guaranteed to be stable across Wuffs versions.
+//
+// See https://en.wikipedia.org/wiki/Opaque_pointer#C
+
+#if defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
+
+struct wuffs_deflate__decoder__struct {
+  // Do not access the private_impl's or private_data's fields directly. There
+  // is no API/ABI compatibility or safety guarantee if you do so. Instead, use
+  // the wuffs_foo__bar__baz functions.
+  //
+  // It is a struct, not a struct*, so that the outermost wuffs_foo__bar struct
+  // can be stack allocated when WUFFS_IMPLEMENTATION is defined.
+
+  struct {
+    uint32_t magic;
+    uint32_t active_coroutine;
+    wuffs_base__vtable vtable_for__wuffs_base__io_transformer;
+    wuffs_base__vtable null_vtable;
+#if defined(WUFFS_CONFIG__STATS)
+    wuffs_base__stats stats;
+#endif  // defined(WUFFS_CONFIG__STATS)
+
+    uint32_t f_bits;
+    uint32_t f_n_bits;
+    uint64_t f_transformed_history_count;
+    uint32_t f_history_index;
+    uint32_t f_n_huffs_bits[2];
+    bool f_end_of_block;
+    bool f_report_block_boundaries;
+    bool f_report_output_slices;
+    bool f_dst_holds_history;
+    uint32_t f_cached_n_lit;
+    uint32_t f_cached_n_dist;
+
+    uint32_t p_transform_io[1];
+    uint32_t p_decode_blocks[1];
+    uint32_t p_decode_uncompressed[1];
+    uint32_t p_init_dynamic_huffman[1];
+    wuffs_base__status (*choosy_decode_huffman_fast64)(
+        wuffs_deflate__decoder* self,
+        wuffs_base__io_buffer* a_dst,
+        wuffs_base__io_buffer* a_src,
+        wuffs_base__slice_u8 a_workbuf);
+    uint32_t p_decode_huffman_slow[1];
+  } private_impl;
+
+  struct {
+    uint32_t f_huffs[2][1024];
+    uint8_t f_code_lengths[320];
+    uint8_t f_cached_code_lengths[320];
+
+    struct {
+      uint64_t v_mark;
+      wuffs_base__status v_status;
+      uint64_t v_hist_pos;
+    } s_transform_io[1];
+    struct {
+      uint64_t v_pos;
+      uint64_t v_limit;
+      uint32_t v_final;
+      bool v_started;
+    } s_decode_blocks[1];
+    struct {
+      uint64_t scratch;
+      uint32_t v_length;
+    } s_decode_uncompressed[1];
+    struct {
+      uint32_t v_bits;
+      uint32_t v_n_bits;
+      uint32_t v_n_lit;
+      uint32_t v_n_dist;
+      uint32_t v_n_clen;
+      uint32_t v_i;
+      uint32_t v_mask;
+      uint32_t v_table_entry;
+      uint32_t v_n_extra_bits;
+      uint32_t v_rep_count;
+      uint32_t v_lcode_n_huffs_bits;
+      uint8_t v_rep_symbol;
+    } s_init_dynamic_huffman[1];
+    struct {
+      uint64_t scratch;
+      uint32_t v_bits;
+      uint32_t v_n_bits;
+      uint32_t v_table_entry;
+      uint32_t v_table_entry_n_bits;
+      uint32_t v_lmask;
+      uint32_t v_dmask;
+      uint32_t v_redir_top;
+      uint32_t v_redir_mask;
+      uint32_t v_length;
+      uint32_t v_dist_minus_1;
+      uint32_t v_hlen;
+    } s_decode_huffman_slow[1];
+  } private_data;
+
+#ifdef __cplusplus
+#if defined(WUFFS_BASE__HAVE_UNIQUE_PTR)
+  using unique_ptr = std::unique_ptr<wuffs_deflate__decoder, decltype(&free)>;
+
+  // On failure, the alloc_etc functions return nullptr. They don't throw.
+
+  static inline unique_ptr
+  alloc() {
+    return unique_ptr(wuffs_deflate__decoder__alloc(), &free);
+  }
+
+  static inline wuffs_base__io_transformer::unique_ptr
+  alloc_as__wuffs_base__io_transformer() {
+    return wuffs_base__io_transformer::unique_ptr(
+        wuffs_deflate__decoder__alloc_as__wuffs_base__io_transformer(), &free);
+  }
+#endif  // defined(WUFFS_BASE__HAVE_UNIQUE_PTR)
+
+#if defined(WUFFS_BASE__HAVE_EQ_DELETE) && !defined(WUFFS_IMPLEMENTATION)
+  // Disallow constructing or copying an object via standard C++ mechanisms,
+  // e.g. the "new" operator, as this struct is intentionally opaque. Its total
+  // size and field layout is not part of the public, stable, memory-safe API.
+  // Use malloc or memcpy and the sizeof__wuffs_foo__bar function instead, and
+  // call wuffs_foo__bar__baz methods (which all take a "this"-like pointer as
+  // their first argument) rather than tweaking bar.private_impl.qux fields.
+  //
+  // In C, we can just leave wuffs_foo__bar as an incomplete type (unless
+  // WUFFS_IMPLEMENTATION is #define'd). In C++, we define a complete type in
+  // order to provide convenience methods. These forward on "this", so that you
+  // can write "bar->baz(etc)" instead of "wuffs_foo__bar__baz(bar, etc)".
+  wuffs_deflate__decoder__struct() = delete;
+  wuffs_deflate__decoder__struct(const wuffs_deflate__decoder__struct&) = delete;
+  wuffs_deflate__decoder__struct& operator=(
+      const wuffs_deflate__decoder__struct&) = delete;
+#endif  // defined(WUFFS_BASE__HAVE_EQ_DELETE) && !defined(WUFFS_IMPLEMENTATION)
+
+#if !defined(WUFFS_IMPLEMENTATION)
+  // As above, the size of the struct is not part of the public API, and unless
+  // WUFFS_IMPLEMENTATION is #define'd, this struct type T should be heap
+  // allocated, not stack allocated. Its size is not intended to be known at
+  // compile time, but it is unfortunately divulged as a side effect of
+  // defining C++ convenience methods. Use "sizeof__T()", calling the function,
+  // instead of "sizeof T", invoking the operator. To make the two values
+  // different, so that passing the latter will be rejected by the initialize
+  // function, we add an arbitrary amount of dead weight.
+  uint8_t dead_weight[123000000];  // 123 MB.
+#endif  // !defined(WUFFS_IMPLEMENTATION)
+
+  inline wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+  initialize(
+      size_t sizeof_star_self,
+      uint64_t wuffs_version,
+      uint32_t options) {
+    return wuffs_deflate__decoder__initialize(
+        this, sizeof_star_self, wuffs_version, options);
+  }
+
+  inline wuffs_base__stats
+  stats() const {
+    return wuffs_deflate__decoder__stats(this);
+  }
+
+  inline wuffs_base__io_transformer*
+  upcast_as__wuffs_base__io_transformer() {
+    return (wuffs_base__io_transformer*)this;
+  }
+
+  inline wuffs_base__empty_struct
+  add_history(
+      wuffs_base__slice_u8 a_hist,
+      wuffs_base__slice_u8 a_workbuf) {
+    return wuffs_deflate__decoder__add_history(this, a_hist, a_workbuf);
+  }
+
+  inline wuffs_base__empty_struct
+  set_report_block_boundaries(
+      bool a_report) {
+    return wuffs_deflate__decoder__set_report_block_boundaries(this, a_report);
+  }
+
+  inline wuffs_base__empty_struct
+  set_report_output_slices(
+      bool a_report) {
+    return wuffs_deflate__decoder__set_report_output_slices(this, a_report);
+  }
+
+  inline wuffs_base__empty_struct
+  set_dst_holds_history(
+      bool a_enabled) {
+    return wuffs_deflate__decoder__set_dst_holds_history(this, a_enabled);
+  }
+
+  inline uint32_t
+  pending_bits() const {
+    return wuffs_deflate__decoder__pending_bits(this);
+  }
+
+  inline uint32_t
+  pending_n_bits() const {
+    return wuffs_deflate__decoder__pending_n_bits(this);
+  }
+
+  inline wuffs_base__empty_struct
+  set_pending_bits(
+      uint32_t a_bits,
+      uint32_t a_n_bits) {
+    return wuffs_deflate__decoder__set_pending_bits(this, a_bits, a_n_bits);
+  }
+
+  inline uint64_t
+  copy_history(
+      wuffs_base__slice_u8 a_dst,
+      wuffs_base__slice_u8 a_workbuf) {
+    return wuffs_deflate__decoder__copy_history(this, a_dst, a_workbuf);
+  }
+
+  inline wuffs_base__empty_struct
+  set_quirk_enabled(
+      uint32_t a_quirk,
+      bool a_enabled) {
+    return wuffs_deflate__decoder__set_quirk_enabled(this, a_quirk, a_enabled);
+  }
+
+  inline wuffs_base__range_ii_u64
+  workbuf_len() const {
+    return wuffs_deflate__decoder__workbuf_len(this);
+  }
+
+  inline wuffs_base__status
+  transform_io(
+      wuffs_base__io_buffer* a_dst,
+      wuffs_base__io_buffer* a_src,
+      wuffs_base__slice_u8 a_workbuf) {
+    return wuffs_deflate__decoder__transform_io(this, a_dst, a_src, a_workbuf);
+  }
+
+#endif  // __cplusplus
+};  // struct wuffs_deflate__decoder__struct
+
+struct wuffs_deflate__encoder__struct {
+  // Do not access the private_impl's or private_data's fields directly. There
+  // is no API/ABI compatibility or safety guarantee if you do so. Instead, use
+  // the wuffs_foo__bar__baz functions.
+  //
+  // It is a struct, not a struct*, so that the outermost wuffs_foo__bar struct
+  // can be stack allocated when WUFFS_IMPLEMENTATION is defined.
+
+  struct {
+    uint32_t magic;
+    uint32_t active_coroutine;
+    wuffs_base__vtable vtable_for__wuffs_base__io_transformer;
+    wuffs_base__vtable null_vtable;
+#if defined(WUFFS_CONFIG__STATS)
+    wuffs_base__stats stats;
+#endif  // defined(WUFFS_CONFIG__STATS)
+
+    uint32_t f_level;
+    bool f_has_level;
+    uint32_t f_flush_mode;
+    bool f_in_stream;
+    bool f_store_only;
+    uint32_t f_good_len;
+    uint32_t f_max_lazy;
+    uint32_t f_nice_len;
+    uint32_t f_max_chain;
+    uint64_t f_bits;
+    uint32_t f_n_bits;
+    uint32_t f_obuf_ri;
+    uint32_t f_obuf_wi;
+    bool f_obuf_overflow;
+    uint32_t f_block_start;
+    uint32_t f_ri;
+    uint32_t f_wi;
+    uint32_t f_n_syms;
+    bool f_lazy_pending;
+    uint32_t f_lazy_len;
+    uint32_t f_lazy_dist;
+    uint32_t f_match_dist;
+    uint32_t f_hlit;
+    uint32_t f_hdist;
+    uint32_t f_hclen;
+    uint32_t f_n_rle;
+
+    uint32_t p_transform_io[1];
+    uint32_t p_write_to[1];
+  } private_impl;
+
+  struct {
+    uint8_t f_window[65800];
+    uint16_t f_head[32768];
+    uint16_t f_prev[32768];
+    uint32_t f_syms[16384];
+    uint32_t f_lfreqs[288];
+    uint32_t f_dfreqs[32];
+    uint32_t f_clfreqs[32];
+    uint8_t f_llens[288];
+    uint8_t f_dlens[32];
+    uint8_t f_cllens[32];
+    uint16_t f_codes[3][288];
+    uint16_t f_rle[320];
+    uint32_t f_hfreqs[288];
+    uint8_t f_hlens[288];
+    uint32_t f_hsort_keys[512];
+    uint16_t f_hsort_syms[512];
+    uint8_t f_obuf[66560];
+  } private_data;
+
+#ifdef __cplusplus
+#if defined(WUFFS_BASE__HAVE_UNIQUE_PTR)
+  using unique_ptr = std::unique_ptr<wuffs_deflate__encoder, decltype(&free)>;
+
+  // On failure, the alloc_etc functions return nullptr. They don't throw.
+
+  static inline unique_ptr
+  alloc() {
+    return unique_ptr(wuffs_deflate__encoder__alloc(), &free);
+  }
+
+  static inline wuffs_base__io_transformer::unique_ptr
+  alloc_as__wuffs_base__io_transformer() {
+    return wuffs_base__io_transformer::unique_ptr(
+        wuffs_deflate__encoder__alloc_as__wuffs_base__io_transformer(), &free);
+  }
+#endif  // defined(WUFFS_BASE__HAVE_UNIQUE_PTR)
+
+#if defined(WUFFS_BASE__HAVE_EQ_DELETE) && !defined(WUFFS_IMPLEMENTATION)
+  // Disallow constructing or copying an object via standard C++ mechanisms,
+  // e.g. the "new" operator, as this struct is intentionally opaque. Its total
+  // size and field layout is not part of the public, stable, memory-safe API.
+  // Use malloc or memcpy and the sizeof__wuffs_foo__bar function instead, and
+  // call wuffs_foo__bar__baz methods (which all take a "this"-like pointer as
+  // their first argument) rather than tweaking bar.private_impl.qux fields.
+  //
+  // In C, we can just leave wuffs_foo__bar as an incomplete type (unless
+  // WUFFS_IMPLEMENTATION is #define'd). In C++, we define a complete type in
+  // order to provide convenience methods. These forward on "this", so that you
+  // can write "bar->baz(etc)" instead of "wuffs_foo__bar__baz(bar, etc)".
+  wuffs_deflate__encoder__struct() = delete;
+  wuffs_deflate__encoder__struct(const wuffs_deflate__encoder__struct&) = delete;
+  wuffs_deflate__encoder__struct& operator=(
+      const wuffs_deflate__encoder__struct&) = delete;
+#endif  // defined(WUFFS_BASE__HAVE_EQ_DELETE) && !defined(WUFFS_IMPLEMENTATION)
+
+#if !defined(WUFFS_IMPLEMENTATION)
+  // As above, the size of the struct is not part of the public API, and unless
+  // WUFFS_IMPLEMENTATION is #define'd, this struct type T should be heap
+  // allocated, not stack allocated. Its size is not intended to be known at
+  // compile time, but it is unfortunately divulged as a side effect of
+  // defining C++ convenience methods. Use "sizeof__T()", calling the function,
+  // instead of "sizeof T", invoking the operator. To make the two values
+  // different, so that passing the latter will be rejected by the initialize
+  // function, we add an arbitrary amount of dead weight.
+  uint8_t dead_weight[123000000];  // 123 MB.
+#endif  // !defined(WUFFS_IMPLEMENTATION)
+
+  inline wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+  initialize(
+      size_t sizeof_star_self,
+      uint64_t wuffs_version,
+      uint32_t options) {
+    return wuffs_deflate__encoder__initialize(
+        this, sizeof_star_self, wuffs_version, options);
+  }
+
+  inline wuffs_base__stats
+  stats() const {
+    return wuffs_deflate__encoder__stats(this);
+  }
+
+  inline wuffs_base__io_transformer*
+  upcast_as__wuffs_base__io_transformer() {
+    return (wuffs_base__io_transformer*)this;
+  }
+
+  inline wuffs_base__empty_struct
+  set_quirk_enabled(
+      uint32_t a_quirk,
+      bool a_enabled) {
+    return wuffs_deflate__encoder__set_quirk_enabled(this, a_quirk, a_enabled);
+  }
+
+  inline wuffs_base__empty_struct
+  set_level(
+      uint32_t a_level) {
+    return wuffs_deflate__encoder__set_level(this, a_level);
+  }
+
+  inline wuffs_base__empty_struct
+  set_flush_mode(
+      uint32_t a_mode) {
+    return wuffs_deflate__encoder__set_flush_mode(this, a_mode);
+  }
+
+  inline wuffs_base__range_ii_u64
+  workbuf_len() const {
+    return wuffs_deflate__encoder__workbuf_len(this);
+  }
+
+  inline wuffs_base__status
+  transform_io(
+      wuffs_base__io_buffer* a_dst,
+      wuffs_base__io_buffer* a_src,
+      wuffs_base__slice_u8 a_workbuf) {
+    return wuffs_deflate__encoder__transform_io(this, a_dst, a_src, a_workbuf);
+  }
+
+#endif  // __cplusplus
+};  // struct wuffs_deflate__encoder__struct
+
+#endif  // defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
+
+
+// ‼ WUFFS C HEADER ENDS HERE.
+#ifdef WUFFS_IMPLEMENTATION
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__DEFLATE)
+
+// ---------------- Status Codes Implementations
+
+const char wuffs_deflate__error__bad_huffman_code_over_subscribed[] = "#deflate: bad Huffman code (over-subscribed)";
+const char wuffs_deflate__error__bad_huffman_code_under_subscribed[] = "#deflate: bad Huffman code (under-subscribed)";
+const char wuffs_deflate__error__bad_huffman_code_length_count[] = "#deflate: bad Huffman code length count";
+const char wuffs_deflate__error__bad_huffman_code_length_repetition[] = "#deflate: bad Huffman code length repetition";
+const char wuffs_deflate__error__bad_huffman_code[] = "#deflate: bad Huffman code";
+const char wuffs_deflate__error__bad_huffman_minimum_code_length[] = "#deflate: bad Huffman minimum code length";
+const char wuffs_deflate__error__bad_block[] = "#deflate: bad block";
+const char wuffs_deflate__error__bad_distance[] = "#deflate: bad distance";
+const char wuffs_deflate__error__bad_distance_code_count[] = "#deflate: bad distance code count";
+const char wuffs_deflate__error__bad_literal_length_code_count[] = "#deflate: bad literal/length code count";
+const char wuffs_deflate__error__inconsistent_stored_block_length[] = "#deflate: inconsistent stored block length";
+const char wuffs_deflate__error__missing_end_of_block_code[] = "#deflate: missing end-of-block code";
+const char wuffs_deflate__error__no_huffman_codes[] = "#deflate: no Huffman codes";
+const char wuffs_deflate__note__block_boundary[] = "@deflate: block boundary";
+const char wuffs_deflate__suspension__output_slice[] = "$deflate: output slice";
+const char wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state[] = "#deflate: internal error: inconsistent Huffman decoder state";
+const char wuffs_deflate__error__internal_error_inconsistent_i_o[] = "#deflate: internal error: inconsistent I/O";
+const char wuffs_deflate__error__internal_error_inconsistent_distance[] = "#deflate: internal error: inconsistent distance";
+const char wuffs_deflate__error__internal_error_inconsistent_n_bits[] = "#deflate: internal error: inconsistent n_bits";
+const char wuffs_deflate__error__internal_error_inconsistent_encoder_state[] = "#deflate: internal error: inconsistent encoder state";
+
+// ---------------- Private Consts
+
+static const uint8_t
+WUFFS_DEFLATE__CODE_ORDER[19] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  16, 17, 18, 0, 8, 7, 9, 6,
+  10, 5, 11, 4, 12, 3, 13, 2,
+  14, 1, 15,
+};
+
+static const uint8_t
+WUFFS_DEFLATE__REVERSE8[256] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  0, 128, 64, 192, 32, 160, 96, 224,
+  16, 144, 80, 208, 48, 176, 112, 240,
+  8, 136, 72, 200, 40, 168, 104, 232,
+  24, 152, 88, 216, 56, 184, 120, 248,
+  4, 132, 68, 196, 36, 164, 100, 228,
+  20, 148, 84, 212, 52, 180, 116, 244,
+  12, 140, 76, 204, 44, 172, 108, 236,
+  28, 156, 92, 220, 60, 188, 124, 252,
+  2, 130, 66, 194, 34, 162, 98, 226,
+  18, 146, 82, 210, 50, 178, 114, 242,
+  10, 138, 74, 202, 42, 170, 106, 234,
+  26, 154, 90, 218, 58, 186, 122, 250,
+  6, 134, 70, 198, 38, 166, 102, 230,
+  22, 150, 86, 214, 54, 182, 118, 246,
+  14, 142, 78, 206, 46, 174, 110, 238,
+  30, 158, 94, 222, 62, 190, 126, 254,
+  1, 129, 65, 193, 33, 161, 97, 225,
+  17, 145, 81, 209, 49, 177, 113, 241,
+  9, 137, 73, 201, 41, 169, 105, 233,
+  25, 153, 89, 217, 57, 185, 121, 249,
+  5, 133, 69, 197, 37, 165, 101, 229,
+  21, 149, 85, 213, 53, 181, 117, 245,
+  13, 141, 77, 205, 45, 173, 109, 237,
+  29, 157, 93, 221, 61, 189, 125, 253,
+  3, 131, 67, 195, 35, 163, 99, 227,
+  19, 147, 83, 211, 51, 179, 115, 243,
+  11, 139, 75, 203, 43, 171, 107, 235,
+  27, 155, 91, 219, 59, 187, 123, 251,
+  7, 135, 71, 199, 39, 167, 103, 231,
+  23, 151, 87, 215, 55, 183, 119, 247,
+  15, 143, 79, 207, 47, 175, 111, 239,
+  31, 159, 95, 223, 63, 191, 127, 255,
+};
+
+#define WUFFS_DEFLATE__OUTPUT_SLICE_LEN 16384
+
+static const uint32_t
+WUFFS_DEFLATE__LCODE_MAGIC_NUMBERS[32] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  1073741824, 1073742080, 1073742336, 1073742592, 1073742848, 1073743104, 1073743360, 1073743616,
+  1073743888, 1073744400, 1073744912, 1073745424, 1073745952, 1073746976, 1073748000, 1073749024,
+  1073750064, 1073752112, 1073754160, 1073756208, 1073758272, 1073762368, 1073766464, 1073770560,
+  1073774672, 1073782864, 1073791056, 1073799248, 1073807104, 134217728, 134217728, 134217728,
+};
+
+static const uint32_t
+WUFFS_DEFLATE__DCODE_MAGIC_NUMBERS[32] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  1073741824, 1073742080, 1073742336, 1073742592, 1073742864, 1073743376, 1073743904, 1073744928,
+  1073745968, 1073748016, 1073750080, 1073754176, 1073758288, 1073766480, 1073774688, 1073791072,
+  1073807472, 1073840240, 1073873024, 1073938560, 1074004112, 1074135184, 1074266272, 1074528416,
+  1074790576, 1075314864, 1075839168, 1076887744, 1077936336, 1080033488, 134217728, 134217728,
+};
+
+static const uint32_t
+WUFFS_DEFLATE__FIXED_LCODE_HUFFS[512] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  536870919, 2147504136, 2147487752, 1073770568, 1073749031, 2147512328, 2147495944, 2147532809,
+  1073743623, 2147508232, 2147491848, 2147524617, 2147483656, 2147516424, 2147500040, 2147541001,
+  1073742599, 2147506184, 2147489800, 2147520521, 1073756215, 2147514376, 2147497992, 2147536905,
+  1073745431, 2147510280, 2147493896, 2147528713, 2147485704, 2147518472, 2147502088, 2147545097,
+  1073742087, 2147505160, 2147488776, 1073799256, 1073752119, 2147513352, 2147496968, 2147534857,
+  1073744407, 2147509256, 2147492872, 2147526665, 2147484680, 2147517448, 2147501064, 2147543049,
+  1073743111, 2147507208, 2147490824, 2147522569, 1073762375, 2147515400, 2147499016, 2147538953,
+  1073746983, 2147511304, 2147494920, 2147530761, 2147486728, 2147519496, 2147503112, 2147547145,
+  1073741831, 2147504648, 2147488264, 1073782872, 1073750071, 2147512840, 2147496456, 2147533833,
+  1073743895, 2147508744, 2147492360, 2147525641, 2147484168, 2147516936, 2147500552, 2147542025,
+  1073742855, 2147506696, 2147490312, 2147521545, 1073758279, 2147514888, 2147498504, 2147537929,
+  1073745959, 2147510792, 2147494408, 2147529737, 2147486216, 2147518984, 2147502600, 2147546121,
+  1073742343, 2147505672, 2147489288, 134217736, 1073754167, 2147513864, 2147497480, 2147535881,
+  1073744919, 2147509768, 2147493384, 2147527689, 2147485192, 2147517960, 2147501576, 2147544073,
+  1073743367, 2147507720, 2147491336, 2147523593, 1073766471, 2147515912, 2147499528, 2147539977,
+  1073748007, 2147511816, 2147495432, 2147531785, 2147487240, 2147520008, 2147503624, 2147548169,
+  536870919, 2147504392, 2147488008, 1073774680, 1073749031, 2147512584, 2147496200, 2147533321,
+  1073743623, 2147508488, 2147492104, 2147525129, 2147483912, 2147516680, 2147500296, 2147541513,
+  1073742599, 2147506440, 2147490056, 2147521033, 1073756215, 2147514632, 2147498248, 2147537417,
+  1073745431, 2147510536, 2147494152, 2147529225, 2147485960, 2147518728, 2147502344, 2147545609,
+  1073742087, 2147505416, 2147489032, 1073807112, 1073752119, 2147513608, 2147497224, 2147535369,
+  1073744407, 2147509512, 2147493128, 2147527177, 2147484936, 2147517704, 2147501320, 2147543561,
+  1073743111, 2147507464, 2147491080, 2147523081, 1073762375, 2147515656, 2147499272, 2147539465,
+  1073746983, 2147511560, 2147495176, 2147531273, 2147486984, 2147519752, 2147503368, 2147547657,
+  1073741831, 2147504904, 2147488520, 1073791064, 1073750071, 2147513096, 2147496712, 2147534345,
+  1073743895, 2147509000, 2147492616, 2147526153, 2147484424, 2147517192, 2147500808, 2147542537,
+  1073742855, 2147506952, 2147490568, 2147522057, 1073758279, 2147515144, 2147498760, 2147538441,
+  1073745959, 2147511048, 2147494664, 2147530249, 2147486472, 2147519240, 2147502856, 2147546633,
+  1073742343, 2147505928, 2147489544, 134217736, 1073754167, 2147514120, 2147497736, 2147536393,
+  1073744919, 2147510024, 2147493640, 2147528201, 2147485448, 2147518216, 2147501832, 2147544585,
+  1073743367, 2147507976, 2147491592, 2147524105, 1073766471, 2147516168, 2147499784, 2147540489,
+  1073748007, 2147512072, 2147495688, 2147532297, 2147487496, 2147520264, 2147503880, 2147548681,
+  536870919, 2147504136, 2147487752, 1073770568, 1073749031, 2147512328, 2147495944, 2147533065,
+  1073743623, 2147508232, 2147491848, 2147524873, 2147483656, 2147516424, 2147500040, 2147541257,
+  1073742599, 2147506184, 2147489800, 2147520777, 1073756215, 2147514376, 2147497992, 2147537161,
+  1073745431, 2147510280, 2147493896, 2147528969, 2147485704, 2147518472, 2147502088, 2147545353,
+  1073742087, 2147505160, 2147488776, 1073799256, 1073752119, 2147513352, 2147496968, 2147535113,
+  1073744407, 2147509256, 2147492872, 2147526921, 2147484680, 2147517448, 2147501064, 2147543305,
+  1073743111, 2147507208, 2147490824, 2147522825, 1073762375, 2147515400, 2147499016, 2147539209,
+  1073746983, 2147511304, 2147494920, 2147531017, 2147486728, 2147519496, 2147503112, 2147547401,
+  1073741831, 2147504648, 2147488264, 1073782872, 1073750071, 2147512840, 2147496456, 2147534089,
+  1073743895, 2147508744, 2147492360, 2147525897, 2147484168, 2147516936, 2147500552, 2147542281,
+  1073742855, 2147506696, 2147490312, 2147521801, 1073758279, 2147514888, 2147498504, 2147538185,
+  1073745959, 2147510792, 2147494408, 2147529993, 2147486216, 2147518984, 2147502600, 2147546377,
+  1073742343, 2147505672, 2147489288, 134217736, 1073754167, 2147513864, 2147497480, 2147536137,
+  1073744919, 2147509768, 2147493384, 2147527945, 2147485192, 2147517960, 2147501576, 2147544329,
+  1073743367, 2147507720, 2147491336, 2147523849, 1073766471, 2147515912, 2147499528, 2147540233,
+  1073748007, 2147511816, 2147495432, 2147532041, 2147487240, 2147520008, 2147503624, 2147548425,
+  536870919, 2147504392, 2147488008, 1073774680, 1073749031, 2147512584, 2147496200, 2147533577,
+  1073743623, 2147508488, 2147492104, 2147525385, 2147483912, 2147516680, 2147500296, 2147541769,
+  1073742599, 2147506440, 2147490056, 2147521289, 1073756215, 2147514632, 2147498248, 2147537673,
+  1073745431, 2147510536, 2147494152, 2147529481, 2147485960, 2147518728, 2147502344, 2147545865,
+  1073742087, 2147505416, 2147489032, 1073807112, 1073752119, 2147513608, 2147497224, 2147535625,
+  1073744407, 2147509512, 2147493128, 2147527433, 2147484936, 2147517704, 2147501320, 2147543817,
+  1073743111, 2147507464, 2147491080, 2147523337, 1073762375, 2147515656, 2147499272, 2147539721,
+  1073746983, 2147511560, 2147495176, 2147531529, 2147486984, 2147519752, 2147503368, 2147547913,
+  1073741831, 2147504904, 2147488520, 1073791064, 1073750071, 2147513096, 2147496712, 2147534601,
+  1073743895, 2147509000, 2147492616, 2147526409, 2147484424, 2147517192, 2147500808, 2147542793,
+  1073742855, 2147506952, 2147490568, 2147522313, 1073758279, 2147515144, 2147498760, 2147538697,
+  1073745959, 2147511048, 2147494664, 2147530505, 2147486472, 2147519240, 2147502856, 2147546889,
+  1073742343, 2147505928, 2147489544, 134217736, 1073754167, 2147514120, 2147497736, 2147536649,
+  1073744919, 2147510024, 2147493640, 2147528457, 2147485448, 2147518216, 2147501832, 2147544841,
+  1073743367, 2147507976, 2147491592, 2147524361, 1073766471, 2147516168, 2147499784, 2147540745,
+  1073748007, 2147512072, 2147495688, 2147532553, 2147487496, 2147520264, 2147503880, 2147548937,
+};
+
+static const uint32_t
+WUFFS_DEFLATE__FIXED_DCODE_HUFFS[32] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  1073741829, 1073807477, 1073745973, 1074790581, 1073742869, 1074004117, 1073758293, 1077936341,
+  1073742341, 1073873029, 1073750085, 1075839173, 1073743909, 1074266277, 1073774693, 134217733,
+  1073742085, 1073840245, 1073748021, 1075314869, 1073743381, 1074135189, 1073766485, 1080033493,
+  1073742597, 1073938565, 1073754181, 1076887749, 1073744933, 1074528421, 1073791077, 134217733,
+};
+
+#define WUFFS_DEFLATE__HUFFS_TABLE_SIZE 1024
+
+#define WUFFS_DEFLATE__HUFFS_TABLE_MASK 1023
+
+#define WUFFS_DEFLATE__CLCODE_HUFFS_TOP 896
+
+static const uint32_t
+WUFFS_DEFLATE__LEVEL_GOOD_LENGTHS[10] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  0, 4, 4, 4, 4, 8, 8, 8,
+  32, 32,
+};
+
+static const uint32_t
+WUFFS_DEFLATE__LEVEL_MAX_LAZIES[10] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  0, 0, 0, 0, 4, 16, 16, 32,
+  128, 258,
+};
+
+static const uint32_t
+WUFFS_DEFLATE__LEVEL_NICE_LENGTHS[10] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  0, 8, 16, 32, 16, 32, 128, 128,
+  258, 258,
+};
+
+static const uint32_t
+WUFFS_DEFLATE__LEVEL_MAX_CHAINS[10] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  0, 4, 8, 32, 16, 32, 128, 256,
+  1024, 4096,
+};
+
+#define WUFFS_DEFLATE__SYMS_SIZE 16384
+
+#define WUFFS_DEFLATE__OBUF_SIZE 66560
+
+static const uint8_t
+WUFFS_DEFLATE__LENGTH_CODES[256] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  0, 1, 2, 3, 4, 5, 6, 7,
+  8, 8, 9, 9, 10, 10, 11, 11,
+  12, 12, 12, 12, 13, 13, 13, 13,
+  14, 14, 14, 14, 15, 15, 15, 15,
+  16, 16, 16, 16, 16, 16, 16, 16,
+  17, 17, 17, 17, 17, 17, 17, 17,
+  18, 18, 18, 18, 18, 18, 18, 18,
+  19, 19, 19, 19, 19, 19, 19, 19,
+  20, 20, 20, 20, 20, 20, 20, 20,
+  20, 20, 20, 20, 20, 20, 20, 20,
+  21, 21, 21, 21, 21, 21, 21, 21,
+  21, 21, 21, 21, 21, 21, 21, 21,
+  22, 22, 22, 22, 22, 22, 22, 22,
+  22, 22, 22, 22, 22, 22, 22, 22,
+  23, 23, 23, 23, 23, 23, 23, 23,
+  23, 23, 23, 23, 23, 23, 23, 23,
+  24, 24, 24, 24, 24, 24, 24, 24,
+  24, 24, 24, 24, 24, 24, 24, 24,
+  24, 24, 24, 24, 24, 24, 24, 24,
+  24, 24, 24, 24, 24, 24, 24, 24,
+  25, 25, 25, 25, 25, 25, 25, 25,
+  25, 25, 25, 25, 25, 25, 25, 25,
+  25, 25, 25, 25, 25, 25, 25, 25,
+  25, 25, 25, 25, 25, 25, 25, 25,
+  26, 26, 26, 26, 26, 26, 26, 26,
+  26, 26, 26, 26, 26, 26, 26, 26,
+  26, 26, 26, 26, 26, 26, 26, 26,
+  26, 26, 26, 26, 26, 26, 26, 26,
+  27, 27, 27, 27, 27, 27, 27, 27,
+  27, 27, 27, 27, 27, 27, 27, 27,
+  27, 27, 27, 27, 27, 27, 27, 27,
+  27, 27, 27, 27, 27, 27, 27, 28,
+};
+
+static const uint32_t
+WUFFS_DEFLATE__LENGTH_BASES[29] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  0, 1, 2, 3, 4, 5, 6, 7,
+  8, 10, 12, 14, 16, 20, 24, 28,
+  32, 40, 48, 56, 64, 80, 96, 112,
+  128, 160, 192, 224, 255,
+};
+
+static const uint32_t
+WUFFS_DEFLATE__LENGTH_EXTRAS[29] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  0, 0, 0, 0, 0, 0, 0, 0,
+  1, 1, 1, 1, 2, 2, 2, 2,
+  3, 3, 3, 3, 4, 4, 4, 4,
+  5, 5, 5, 5, 0,
+};
+
+static const uint8_t
+WUFFS_DEFLATE__DISTANCE_CODES[512] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  0, 1, 2, 3, 4, 4, 5, 5,
+  6, 6, 6, 6, 7, 7, 7, 7,
+  8, 8, 8, 8, 8, 8, 8, 8,
+  9, 9, 9, 9, 9, 9, 9, 9,
+  10, 10, 10, 10, 10, 10, 10, 10,
+  10, 10, 10, 10, 10, 10, 10, 10,
+  11, 11, 11, 11, 11, 11, 11, 11,
+  11, 11, 11, 11, 11, 11, 11, 11,
+  12, 12, 12, 12, 12, 12, 12, 12,
+  12, 12, 12, 12, 12, 12, 12, 12,
+  12, 12, 12, 12, 12, 12, 12, 12,
+  12, 12, 12, 12, 12, 12, 12, 12,
+  13, 13, 13, 13, 13, 13, 13, 13,
+  13, 13, 13, 13, 13, 13, 13, 13,
+  13, 13, 13, 13, 13, 13, 13, 13,
+  13, 13, 13, 13, 13, 13, 13, 13,
+  14, 14, 14, 14, 14, 14, 14, 14,
+  14, 14, 14, 14, 14, 14, 14, 14,
+  14, 14, 14, 14, 14, 14, 14, 14,
+  14, 14, 14, 14, 14, 14, 14, 14,
+  14, 14, 14, 14, 14, 14, 14, 14,
+  14, 14, 14, 14, 14, 14, 14, 14,
+  14, 14, 14, 14, 14, 14, 14, 14,
+  14, 14, 14, 14, 14, 14, 14, 14,
+  15, 15, 15, 15, 15, 15, 15, 15,
+  15, 15, 15, 15, 15, 15, 15, 15,
+  15, 15, 15, 15, 15, 15, 15, 15,
+  15, 15, 15, 15, 15, 15, 15, 15,
+  15, 15, 15, 15, 15, 15, 15, 15,
+  15, 15, 15, 15, 15, 15, 15, 15,
+  15, 15, 15, 15, 15, 15, 15, 15,
+  15, 15, 15, 15, 15, 15, 15, 15,
+  0, 0, 16, 17, 18, 18, 19, 19,
+  20, 20, 20, 20, 21, 21, 21, 21,
+  22, 22, 22, 22, 22, 22, 22, 22,
+  23, 23, 23, 23, 23, 23, 23, 23,
+  24, 24, 24, 24, 24, 24, 24, 24,
+  24, 24, 24, 24, 24, 24, 24, 24,
+  25, 25, 25, 25, 25, 25, 25, 25,
+  25, 25, 25, 25, 25, 25, 25, 25,
+  26, 26, 26, 26, 26, 26, 26, 26,
+  26, 26, 26, 26, 26, 26, 26, 26,
+  26, 26, 26, 26, 26, 26, 26, 26,
+  26, 26, 26, 26, 26, 26, 26, 26,
+  27, 27, 27, 27, 27, 27, 27, 27,
+  27, 27, 27, 27, 27, 27, 27, 27,
+  27, 27, 27, 27, 27, 27, 27, 27,
+  27, 27, 27, 27, 27, 27, 27, 27,
+  28, 28, 28, 28, 28, 28, 28, 28,
+  28, 28, 28, 28, 28, 28, 28, 28,
+  28, 28, 28, 28, 28, 28, 28, 28,
+  28, 28, 28, 28, 28, 28, 28, 28,
+  28, 28, 28, 28, 28, 28, 28, 28,
+  28, 28, 28, 28, 28, 28, 28, 28,
+  28, 28, 28, 28, 28, 28, 28, 28,
+  28, 28, 28, 28, 28, 28, 28, 28,
+  29, 29, 29, 29, 29, 29, 29, 29,
+  29, 29, 29, 29, 29, 29, 29, 29,
+  29, 29, 29, 29, 29, 29, 29, 29,
+  29, 29, 29, 29, 29, 29, 29, 29,
+  29, 29, 29, 29, 29, 29, 29, 29,
+  29, 29, 29, 29, 29, 29, 29, 29,
+  29, 29, 29, 29, 29, 29, 29, 29,
+  29, 29, 29, 29, 29, 29, 29, 29,
+};
+
+static const uint32_t
+WUFFS_DEFLATE__DISTANCE_BASES[30] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  0, 1, 2, 3, 4, 6, 8, 12,
+  16, 24, 32, 48, 64, 96, 128, 192,
+  256, 384, 512, 768, 1024, 1536, 2048, 3072,
+  4096, 6144, 8192, 12288, 16384, 24576,
+};
+
+static const uint32_t
+WUFFS_DEFLATE__DISTANCE_EXTRAS[30] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  0, 0, 0, 0, 1, 1, 2, 2,
+  3, 3, 4, 4, 5, 5, 6, 6,
+  7, 7, 8, 8, 9, 9, 10, 10,
+  11, 11, 12, 12, 13, 13,
+};
+
+// ---------------- Private Initializer Prototypes
+
+// ---------------- Private Function Prototypes
+
+static wuffs_base__status
+wuffs_deflate__decoder__decode_blocks(
+    wuffs_deflate__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf);
+
+static wuffs_base__status
+wuffs_deflate__decoder__decode_uncompressed(
+    wuffs_deflate__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__empty_struct
+wuffs_deflate__decoder__init_fixed_huffman(
+    wuffs_deflate__decoder* self);
+
+static wuffs_base__status
+wuffs_deflate__decoder__init_dynamic_huffman(
+    wuffs_deflate__decoder* self,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status
+wuffs_deflate__decoder__init_huff(
+    wuffs_deflate__decoder* self,
+    uint32_t a_which,
+    uint32_t a_n_codes0,
+    uint32_t a_n_codes1,
+    uint32_t a_base_symbol,
+    uint32_t a_initial_top);
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+static wuffs_base__status
+wuffs_deflate__decoder__decode_huffman_bmi2(
+    wuffs_deflate__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf);
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+
+static wuffs_base__status
+wuffs_deflate__decoder__decode_huffman_fast32(
+    wuffs_deflate__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf);
+
+static wuffs_base__status
+wuffs_deflate__decoder__decode_huffman_fast64(
+    wuffs_deflate__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf);
+
+static wuffs_base__status
+wuffs_deflate__decoder__decode_huffman_fast64__choosy_default(
+    wuffs_deflate__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf);
+
+static wuffs_base__status
+wuffs_deflate__decoder__decode_huffman_slow(
+    wuffs_deflate__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf);
+
+static wuffs_base__empty_struct
+wuffs_deflate__encoder__start_stream(
+    wuffs_deflate__encoder* self);
+
+static wuffs_base__empty_struct
+wuffs_deflate__encoder__reset_block(
+    wuffs_deflate__encoder* self);
+
+static wuffs_base__empty_struct
+wuffs_deflate__encoder__fill_window(
+    wuffs_deflate__encoder* self,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__empty_struct
+wuffs_deflate__encoder__slide_window(
+    wuffs_deflate__encoder* self);
+
+static wuffs_base__status
+wuffs_deflate__encoder__write_to(
+    wuffs_deflate__encoder* self,
+    wuffs_base__io_buffer* a_dst);
+
+static uint32_t
+wuffs_deflate__encoder__hash3(
+    const wuffs_deflate__encoder* self,
+    uint32_t a_p);
+
+static wuffs_base__empty_struct
+wuffs_deflate__encoder__deflate_chunk(
+    wuffs_deflate__encoder* self,
+    bool a_final);
+
+static uint32_t
+wuffs_deflate__encoder__find_match(
+    wuffs_deflate__encoder* self,
+    uint32_t a_cur,
+    uint32_t a_max_len,
+    uint32_t a_prev_len,
+    uint32_t a_cand);
+
+static wuffs_base__empty_struct
+wuffs_deflate__encoder__insert_hashes(
+    wuffs_deflate__encoder* self,
+    uint32_t a_lo,
+    uint32_t a_hi);
+
+static wuffs_base__empty_struct
+wuffs_deflate__encoder__add_literal(
+    wuffs_deflate__encoder* self,
+    uint8_t a_c);
+
+static wuffs_base__empty_struct
+wuffs_deflate__encoder__add_match(
+    wuffs_deflate__encoder* self,
+    uint32_t a_len,
+    uint32_t a_dist);
+
+static wuffs_base__empty_struct
+wuffs_deflate__encoder__resolve_pending(
+    wuffs_deflate__encoder* self);
+
+static wuffs_base__empty_struct
+wuffs_deflate__encoder__emit_block(
+    wuffs_deflate__encoder* self,
+    bool a_final);
+
+static uint64_t
+wuffs_deflate__encoder__stored_bits(
+    const wuffs_deflate__encoder* self);
+
+static wuffs_base__empty_struct
+wuffs_deflate__encoder__emit_stored(
+    wuffs_deflate__encoder* self,
+    uint32_t a_final_bit);
+
+static wuffs_base__empty_struct
+wuffs_deflate__encoder__put_bits(
+    wuffs_deflate__encoder* self,
+    uint32_t a_b,
+    uint32_t a_n);
+
+static wuffs_base__empty_struct
+wuffs_deflate__encoder__emit_rle(
+    wuffs_deflate__encoder* self);
+
+static wuffs_base__empty_struct
+wuffs_deflate__encoder__emit_syms(
+    wuffs_deflate__encoder* self);
+
+static wuffs_base__empty_struct
+wuffs_deflate__encoder__build_fixed_codes(
+    wuffs_deflate__encoder* self);
+
+static wuffs_base__empty_struct
+wuffs_deflate__encoder__build_dynamic_codes(
+    wuffs_deflate__encoder* self);
+
+static wuffs_base__empty_struct
+wuffs_deflate__encoder__build_rle(
+    wuffs_deflate__encoder* self,
+    uint32_t a_hlit,
+    uint32_t a_hdist);
+
+static wuffs_base__empty_struct
+wuffs_deflate__encoder__add_rle(
+    wuffs_deflate__encoder* self,
+    uint32_t a_s,
+    uint32_t a_extra);
+
+static wuffs_base__empty_struct
+wuffs_deflate__encoder__build_lengths(
+    wuffs_deflate__encoder* self,
+    uint32_t a_n,
+    uint32_t a_limit);
+
+static wuffs_base__empty_struct
+wuffs_deflate__encoder__build_codes(
+    wuffs_deflate__encoder* self,
+    uint32_t a_which,
+    uint32_t a_n);
+
+// ---------------- VTables
+
+const wuffs_base__io_transformer__func_ptrs
+wuffs_deflate__decoder__func_ptrs_for__wuffs_base__io_transformer = {
+  (wuffs_base__empty_struct(*)(void*,
+      uint32_t,
+      bool))(&wuffs_deflate__decoder__set_quirk_enabled),
+  (wuffs_base__status(*)(void*,
+      wuffs_base__io_buffer*,
+      wuffs_base__io_buffer*,
+      wuffs_base__slice_u8))(&wuffs_deflate__decoder__transform_io),
+  (wuffs_base__range_ii_u64(*)(const void*))(&wuffs_deflate__decoder__workbuf_len),
+};
+
+const wuffs_base__io_transformer__func_ptrs
+wuffs_deflate__encoder__func_ptrs_for__wuffs_base__io_transformer = {
+  (wuffs_base__empty_struct(*)(void*,
+      uint32_t,
+      bool))(&wuffs_deflate__encoder__set_quirk_enabled),
+  (wuffs_base__status(*)(void*,
+      wuffs_base__io_buffer*,
+      wuffs_base__io_buffer*,
+      wuffs_base__slice_u8))(&wuffs_deflate__encoder__transform_io),
+  (wuffs_base__range_ii_u64(*)(const void*))(&wuffs_deflate__encoder__workbuf_len),
+};
+
+// ---------------- Initializer Implementations
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+wuffs_deflate__decoder__initialize(
+    wuffs_deflate__decoder* self,
+    size_t sizeof_star_self,
+    uint64_t wuffs_version,
+    uint32_t options){
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  }
+
+  if ((options & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+    // The whole point of this if-check is to detect an uninitialized *self.
+    // We disable the warning on GCC. Clang-5.0 does not have this warning.
+    //
+    // The caller promises that *self is zeroed, so the empty asm tells GCC
+    // that private_impl is defined. Otherwise, once this function and a
+    // small method (e.g. one that reads a "choose" guard field) are both
+    // inlined into the caller, GCC -O3 warns about that method's read.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    __asm__ __volatile__("" : "+m"(self->private_impl));
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((options & WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      options |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    }
+  }
+
+  self->private_impl.choosy_decode_huffman_fast64 = &wuffs_deflate__decoder__decode_huffman_fast64__choosy_default;
+
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.vtable_name =
+      wuffs_base__io_transformer__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.function_pointers =
+      (const void*)(&wuffs_deflate__decoder__func_ptrs_for__wuffs_base__io_transformer);
+  return wuffs_base__make_status(NULL);
+}
+
+wuffs_deflate__decoder*
+wuffs_deflate__decoder__alloc() {
+  wuffs_deflate__decoder* x =
+      (wuffs_deflate__decoder*)(calloc(sizeof(wuffs_deflate__decoder), 1));
+  if (!x) {
+    return NULL;
+  }
+  if (wuffs_deflate__decoder__initialize(
+      x, sizeof(wuffs_deflate__decoder), WUFFS_VERSION, WUFFS_INITIALIZE__ALREADY_ZEROED).repr) {
+    free(x);
+    return NULL;
+  }
+  return x;
+}
+
+size_t
+sizeof__wuffs_deflate__decoder() {
+  return sizeof(wuffs_deflate__decoder);
+}
+
+wuffs_base__stats
+wuffs_deflate__decoder__stats(
+    const wuffs_deflate__decoder* self) {
+  wuffs_base__stats ret = wuffs_base__make_empty_stats();
+#if defined(WUFFS_CONFIG__STATS)
+  if (!self) {
+    return ret;
+  }
+  ret = self->private_impl.stats;
+#else
+  (void)(self);
+#endif  // defined(WUFFS_CONFIG__STATS)
+  return ret;
+}
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+wuffs_deflate__encoder__initialize(
+    wuffs_deflate__encoder* self,
+    size_t sizeof_star_self,
+    uint64_t wuffs_version,
+    uint32_t options){
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  }
+
+  if ((options & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+    // The whole point of this if-check is to detect an uninitialized *self.
+    // We disable the warning on GCC. Clang-5.0 does not have this warning.
+    //
+    // The caller promises that *self is zeroed, so the empty asm tells GCC
+    // that private_impl is defined. Otherwise, once this function and a
+    // small method (e.g. one that reads a "choose" guard field) are both
+    // inlined into the caller, GCC -O3 warns about that method's read.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    __asm__ __volatile__("" : "+m"(self->private_impl));
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((options & WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      options |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    }
+  }
+
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.vtable_name =
+      wuffs_base__io_transformer__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.function_pointers =
+      (const void*)(&wuffs_deflate__encoder__func_ptrs_for__wuffs_base__io_transformer);
+  return wuffs_base__make_status(NULL);
+}
+
+wuffs_deflate__encoder*
+wuffs_deflate__encoder__alloc() {
+  wuffs_deflate__encoder* x =
+      (wuffs_deflate__encoder*)(calloc(sizeof(wuffs_deflate__encoder), 1));
+  if (!x) {
+    return NULL;
+  }
+  if (wuffs_deflate__encoder__initialize(
+      x, sizeof(wuffs_deflate__encoder), WUFFS_VERSION, WUFFS_INITIALIZE__ALREADY_ZEROED).repr) {
+    free(x);
+    return NULL;
+  }
+  return x;
+}
+
+size_t
+sizeof__wuffs_deflate__encoder() {
+  return sizeof(wuffs_deflate__encoder);
+}
+
+wuffs_base__stats
+wuffs_deflate__encoder__stats(
+    const wuffs_deflate__encoder* self) {
+  wuffs_base__stats ret = wuffs_base__make_empty_stats();
+#if defined(WUFFS_CONFIG__STATS)
+  if (!self) {
+    return ret;
+  }
+  ret = self->private_impl.stats;
+#else
+  (void)(self);
+#endif  // defined(WUFFS_CONFIG__STATS)
+  return ret;
+}
+
+// ---------------- Function Implementations
+
+// -------- func deflate.decoder.add_history
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_deflate__decoder__add_history(
+    wuffs_deflate__decoder* self,
+    wuffs_base__slice_u8 a_hist,
+    wuffs_base__slice_u8 a_workbuf) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  wuffs_base__slice_u8 v_s = {0};
+  uint64_t v_n_copied = 0;
+  uint32_t v_already_full = 0;
+
+  if (((uint64_t)(a_workbuf.len)) < 33025) {
+    return wuffs_base__make_empty_struct();
+  }
+  v_s = a_hist;
+  if (((uint64_t)(v_s.len)) >= 32768) {
+    v_s = wuffs_base__slice_u8__suffix(v_s, 32768);
+    wuffs_base__slice_u8__copy_from_slice(wuffs_base__slice_u8__subslice_j(a_workbuf, 32768), v_s);
+    self->private_impl.f_history_index = 32768;
+  } else {
+    v_n_copied = wuffs_base__slice_u8__copy_from_slice(wuffs_base__slice_u8__subslice_ij(a_workbuf, (self->private_impl.f_history_index & 32767), 32768), v_s);
+    if (v_n_copied < ((uint64_t)(v_s.len))) {
+      v_s = wuffs_base__slice_u8__subslice_i(v_s, v_n_copied);
+      v_n_copied = wuffs_base__slice_u8__copy_from_slice(wuffs_base__slice_u8__subslice_j(a_workbuf, 32768), v_s);
+      self->private_impl.f_history_index = (((uint32_t)((v_n_copied & 32767))) + 32768);
+    } else {
+      v_already_full = 0;
+      if (self->private_impl.f_history_index >= 32768) {
+        v_already_full = 32768;
+      }
+      self->private_impl.f_history_index = ((self->private_impl.f_history_index & 32767) + ((uint32_t)((v_n_copied & 32767))) + v_already_full);
+    }
+  }
+  wuffs_base__slice_u8__copy_from_slice(wuffs_base__slice_u8__subslice_ij(a_workbuf, 32768, 33025), wuffs_base__slice_u8__subslice_j(a_workbuf, 32768));
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.decoder.set_report_block_boundaries
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_deflate__decoder__set_report_block_boundaries(
+    wuffs_deflate__decoder* self,
+    bool a_report) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_report_block_boundaries = a_report;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.decoder.set_report_output_slices
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_deflate__decoder__set_report_output_slices(
+    wuffs_deflate__decoder* self,
+    bool a_report) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_report_output_slices = a_report;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.decoder.set_dst_holds_history
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_deflate__decoder__set_dst_holds_history(
+    wuffs_deflate__decoder* self,
+    bool a_enabled) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_dst_holds_history = a_enabled;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.decoder.pending_bits
+
+WUFFS_BASE__MAYBE_STATIC uint32_t
+wuffs_deflate__decoder__pending_bits(
+    const wuffs_deflate__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_bits;
+}
+
+// -------- func deflate.decoder.pending_n_bits
+
+WUFFS_BASE__MAYBE_STATIC uint32_t
+wuffs_deflate__decoder__pending_n_bits(
+    const wuffs_deflate__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_n_bits;
+}
+
+// -------- func deflate.decoder.set_pending_bits
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_deflate__decoder__set_pending_bits(
+    wuffs_deflate__decoder* self,
+    uint32_t a_bits,
+    uint32_t a_n_bits) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (a_n_bits > 7) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_bits = (a_bits & ((((uint32_t)(1)) << a_n_bits) - 1));
+  self->private_impl.f_n_bits = a_n_bits;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.decoder.copy_history
+
+WUFFS_BASE__MAYBE_STATIC uint64_t
+wuffs_deflate__decoder__copy_history(
+    wuffs_deflate__decoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_workbuf) {
+  if (!self) {
+    return 0;
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return 0;
+  }
+
+  wuffs_base__slice_u8 v_d = {0};
+  uint32_t v_i = 0;
+  uint64_t v_n = 0;
+  uint64_t v_m = 0;
+
+  if (((uint64_t)(a_workbuf.len)) < 33025) {
+    return 0;
+  }
+  v_i = (self->private_impl.f_history_index & 32767);
+  if ((self->private_impl.f_history_index < 32768) || (((uint64_t)(a_dst.len)) <= ((uint64_t)(v_i)))) {
+    v_n = wuffs_base__slice_u8__copy_from_slice(a_dst, wuffs_base__slice_u8__suffix(wuffs_base__slice_u8__subslice_j(a_workbuf, v_i), ((uint64_t)(a_dst.len))));
+    return v_n;
+  }
+  v_d = a_dst;
+  v_n = wuffs_base__slice_u8__copy_from_slice(v_d, wuffs_base__slice_u8__suffix(wuffs_base__slice_u8__subslice_ij(a_workbuf, v_i, 32768), wuffs_base__u64__sat_sub(((uint64_t)(v_d.len)), ((uint64_t)(v_i)))));
+  if (v_n <= ((uint64_t)(v_d.len))) {
+    v_d = wuffs_base__slice_u8__subslice_i(v_d, v_n);
+  }
+  v_m = wuffs_base__slice_u8__copy_from_slice(v_d, wuffs_base__slice_u8__subslice_j(a_workbuf, v_i));
+  return wuffs_base__u64__sat_add(v_n, v_m);
+}
+
+// -------- func deflate.decoder.set_quirk_enabled
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_deflate__decoder__set_quirk_enabled(
+    wuffs_deflate__decoder* self,
+    uint32_t a_quirk,
+    bool a_enabled) {
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.decoder.workbuf_len
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64
+wuffs_deflate__decoder__workbuf_len(
+    const wuffs_deflate__decoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+
+  if (self->private_impl.f_dst_holds_history) {
+    return wuffs_base__utility__make_range_ii_u64(0, 0);
+  }
+  return wuffs_base__utility__make_range_ii_u64(33025, 33025);
+}
+
+// -------- func deflate.decoder.transform_io
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_deflate__decoder__transform_io(
+    wuffs_deflate__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+        ? wuffs_base__error__disabled_by_previous_error
+        : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst || !a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 1)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint64_t v_mark = 0;
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  uint64_t v_hist_pos = 0;
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_transform_io[0];
+  if (coro_susp_point) {
+    v_mark = self->private_data.s_transform_io[0].v_mark;
+    v_status = self->private_data.s_transform_io[0].v_status;
+    v_hist_pos = self->private_data.s_transform_io[0].v_hist_pos;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    self->private_impl.choosy_decode_huffman_fast64 = (
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+        wuffs_base__cpu_arch__have_x86_bmi2() ? &wuffs_deflate__decoder__decode_huffman_bmi2 :
+#endif
+        self->private_impl.choosy_decode_huffman_fast64);
+    while (true) {
+      if ( ! self->private_impl.f_dst_holds_history) {
+        if (((uint64_t)(a_workbuf.len)) < 33025) {
+          status = wuffs_base__make_status(wuffs_base__error__bad_workbuf_length);
+          goto exit;
+        }
+      } else {
+        self->private_impl.f_history_index = 0;
+        if ((((uint64_t)(iop_a_dst - io0_a_dst)) < 32768) && (((uint64_t)(iop_a_dst - io0_a_dst)) < self->private_impl.f_transformed_history_count)) {
+          status = wuffs_base__make_status(wuffs_base__error__bad_argument);
+          goto exit;
+        }
+      }
+      v_mark = ((uint64_t)(iop_a_dst - io0_a_dst));
+      while (true) {
+        {
+          if (a_dst) {
+            a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+          }
+          wuffs_base__status t_0 = wuffs_deflate__decoder__decode_blocks(self, a_dst, a_src, a_workbuf);
+          v_status = t_0;
+          if (a_dst) {
+            iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+          }
+        }
+        if (v_status.repr != wuffs_deflate__suspension__output_slice) {
+          goto label__slices__break;
+        }
+        v_hist_pos = (a_dst ? a_dst->meta.pos : 0);
+        status = v_status;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
+        if (v_hist_pos != (a_dst ? a_dst->meta.pos : 0)) {
+          status = wuffs_base__make_status(wuffs_base__error__bad_i_o_position);
+          goto exit;
+        }
+      }
+      label__slices__break:;
+      if ( ! wuffs_base__status__is_suspension(&v_status) && (v_status.repr != wuffs_deflate__note__block_boundary)) {
+        status = v_status;
+        if (wuffs_base__status__is_error(&status)) {
+          goto exit;
+        } else if (wuffs_base__status__is_suspension(&status)) {
+          status = wuffs_base__make_status(wuffs_base__error__cannot_return_a_suspension);
+          goto exit;
+        }
+        goto ok;
+      }
+      wuffs_base__u64__sat_add_indirect(&self->private_impl.f_transformed_history_count, wuffs_base__io__count_since(v_mark, ((uint64_t)(iop_a_dst - io0_a_dst))));
+      if ( ! self->private_impl.f_dst_holds_history) {
+        wuffs_deflate__decoder__add_history(self, wuffs_base__io__since(v_mark, ((uint64_t)(iop_a_dst - io0_a_dst)), io0_a_dst), a_workbuf);
+      }
+      if ( ! wuffs_base__status__is_suspension(&v_status)) {
+        status = v_status;
+        if (wuffs_base__status__is_error(&status)) {
+          goto exit;
+        } else if (wuffs_base__status__is_suspension(&status)) {
+          status = wuffs_base__make_status(wuffs_base__error__cannot_return_a_suspension);
+          goto exit;
+        }
+        goto ok;
+      }
+      status = v_status;
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(2);
+    }
+
+    ok:
+    self->private_impl.p_transform_io[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_transform_io[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine = wuffs_base__status__is_suspension(&status) ? 1 : 0;
+  WUFFS_BASE__STATS__ADD(self->private_impl, WUFFS_BASE__STATS__SUSPENSIONS,
+      wuffs_base__status__is_suspension(&status) ? 1u : 0u);
+  self->private_data.s_transform_io[0].v_mark = v_mark;
+  self->private_data.s_transform_io[0].v_status = v_status;
+  self->private_data.s_transform_io[0].v_hist_pos = v_hist_pos;
+
+  goto exit;
+  exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func deflate.decoder.decode_blocks
+
+static wuffs_base__status
+wuffs_deflate__decoder__decode_blocks(
+    wuffs_deflate__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_final = 0;
+  uint32_t v_b0 = 0;
+  uint32_t v_type = 0;
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  bool v_started = false;
+  uint64_t v_pos = 0;
+  uint64_t v_limit = 0;
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_blocks[0];
+  if (coro_susp_point) {
+    v_pos = self->private_data.s_decode_blocks[0].v_pos;
+    v_limit = self->private_data.s_decode_blocks[0].v_limit;
+    v_final = self->private_data.s_decode_blocks[0].v_final;
+    v_started = self->private_data.s_decode_blocks[0].v_started;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    label__outer__continue:;
+    while (v_final == 0) {
+      if (v_started && self->private_impl.f_report_block_boundaries) {
+        status = wuffs_base__make_status(wuffs_deflate__note__block_boundary);
+        goto ok;
+      }
+      v_started = true;
+      while (self->private_impl.f_n_bits < 3) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint32_t t_0 = *iop_a_src++;
+          v_b0 = t_0;
+        }
+        self->private_impl.f_bits |= (v_b0 << (self->private_impl.f_n_bits & 3));
+        self->private_impl.f_n_bits = ((self->private_impl.f_n_bits & 3) + 8);
+      }
+      v_final = (self->private_impl.f_bits & 1);
+      v_type = ((self->private_impl.f_bits >> 1) & 3);
+      self->private_impl.f_bits >>= 3;
+      self->private_impl.f_n_bits -= 3;
+      if (v_type == 0) {
+        if (a_dst) {
+          a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+        }
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        status = wuffs_deflate__decoder__decode_uncompressed(self, a_dst, a_src);
+        if (a_dst) {
+          iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+        }
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+        goto label__outer__continue;
+      } else if (v_type == 1) {
+        wuffs_deflate__decoder__init_fixed_huffman(self);
+      } else if (v_type == 2) {
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+        status = wuffs_deflate__decoder__init_dynamic_huffman(self, a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+      } else {
+        status = wuffs_base__make_status(wuffs_deflate__error__bad_block);
+        goto exit;
+      }
+      v_limit = 18446744073709551615u;
+      if (self->private_impl.f_report_output_slices) {
+        v_limit = 16384;
+      }
+      self->private_impl.f_end_of_block = false;
+      label__0__continue:;
+      while (true) {
+        v_pos = wuffs_base__u64__sat_add((a_dst ? a_dst->meta.pos : 0), ((uint64_t)(iop_a_dst - io0_a_dst)));
+        {
+          uint8_t *o_0_io2_a_dst = io2_a_dst;
+          wuffs_base__io_writer__limit(&io2_a_dst, iop_a_dst,
+              v_limit);
+          if (a_dst) {
+            a_dst->data.len = ((size_t)(io2_a_dst - a_dst->data.ptr));
+          }
+          if (sizeof(void*) == 4) {
+            if (a_dst) {
+              a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+            }
+            if (a_src) {
+              a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+            }
+            v_status = wuffs_deflate__decoder__decode_huffman_fast32(self, a_dst, a_src, a_workbuf);
+            if (a_dst) {
+              iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+            }
+            if (a_src) {
+              iop_a_src = a_src->data.ptr + a_src->meta.ri;
+            }
+          } else {
+            if (a_dst) {
+              a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+            }
+            if (a_src) {
+              a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+            }
+            v_status = wuffs_deflate__decoder__decode_huffman_fast64(self, a_dst, a_src, a_workbuf);
+            if (a_dst) {
+              iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+            }
+            if (a_src) {
+              iop_a_src = a_src->data.ptr + a_src->meta.ri;
+            }
+          }
+          io2_a_dst = o_0_io2_a_dst;
+          if (a_dst) {
+            a_dst->data.len = ((size_t)(io2_a_dst - a_dst->data.ptr));
+          }
+        }
+        WUFFS_BASE__STATS__ADD(self->private_impl, 1, ((uint64_t)(wuffs_base__u64__sat_add((a_dst ? a_dst->meta.pos : 0), ((uint64_t)(iop_a_dst - io0_a_dst))) - v_pos)));
+        if (wuffs_base__status__is_error(&v_status)) {
+          status = v_status;
+          goto exit;
+        }
+        if (self->private_impl.f_end_of_block) {
+          goto label__outer__continue;
+        }
+        if (self->private_impl.f_report_output_slices && (((uint64_t)(io2_a_dst - iop_a_dst)) >= 266) && (((uint64_t)(io2_a_src - iop_a_src)) >= 12)) {
+          status = wuffs_base__make_status(wuffs_deflate__suspension__output_slice);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(4);
+          goto label__0__continue;
+        }
+        v_pos = wuffs_base__u64__sat_add((a_dst ? a_dst->meta.pos : 0), ((uint64_t)(iop_a_dst - io0_a_dst)));
+        if (a_dst) {
+          a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+        }
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+        status = wuffs_deflate__decoder__decode_huffman_slow(self, a_dst, a_src, a_workbuf);
+        if (a_dst) {
+          iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+        }
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+        WUFFS_BASE__STATS__ADD(self->private_impl, 2, ((uint64_t)(wuffs_base__u64__sat_add((a_dst ? a_dst->meta.pos : 0), ((uint64_t)(iop_a_dst - io0_a_dst))) - v_pos)));
+        if (self->private_impl.f_end_of_block) {
+          goto label__outer__continue;
+        }
+      }
+    }
+
+    ok:
+    self->private_impl.p_decode_blocks[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_blocks[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_decode_blocks[0].v_pos = v_pos;
+  self->private_data.s_decode_blocks[0].v_limit = v_limit;
+  self->private_data.s_decode_blocks[0].v_final = v_final;
+  self->private_data.s_decode_blocks[0].v_started = v_started;
+
+  goto exit;
+  exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func deflate.decoder.decode_uncompressed
+
+static wuffs_base__status
+wuffs_deflate__decoder__decode_uncompressed(
+    wuffs_deflate__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_length = 0;
+  uint32_t v_n_copied = 0;
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_uncompressed[0];
+  if (coro_susp_point) {
+    v_length = self->private_data.s_decode_uncompressed[0].v_length;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if ((self->private_impl.f_n_bits >= 8) || ((self->private_impl.f_bits >> (self->private_impl.f_n_bits & 7)) != 0)) {
+      status = wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_n_bits);
+      goto exit;
+    }
+    self->private_impl.f_n_bits = 0;
+    self->private_impl.f_bits = 0;
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      uint32_t t_0;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+        t_0 = wuffs_base__peek_u32le__no_bounds_check(iop_a_src);
+        iop_a_src += 4;
+      } else {
+        self->private_data.s_decode_uncompressed[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_uncompressed[0].scratch;
+          uint32_t num_bits_0 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_0;
+          if (num_bits_0 == 24) {
+            t_0 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_0 += 8;
+          *scratch |= ((uint64_t)(num_bits_0)) << 56;
+        }
+      }
+      v_length = t_0;
+    }
+    if ((((v_length) & 0xFFFF) + ((v_length) >> (32 - (16)))) != 65535) {
+      status = wuffs_base__make_status(wuffs_deflate__error__inconsistent_stored_block_length);
+      goto exit;
+    }
+    v_length = ((v_length) & 0xFFFF);
+    while (true) {
+      v_n_copied = wuffs_base__io_writer__limited_copy_u32_from_reader(
+          &iop_a_dst, io2_a_dst,v_length, &iop_a_src, io2_a_src);
+      if (v_length <= v_n_copied) {
+        status = wuffs_base__make_status(NULL);
+        goto ok;
+      }
+      v_length -= v_n_copied;
+      if (((uint64_t)(io2_a_dst - iop_a_dst)) == 0) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(3);
+      } else {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(4);
+      }
+    }
+
+    ok:
+    self->private_impl.p_decode_uncompressed[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_uncompressed[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_decode_uncompressed[0].v_length = v_length;
+
+  goto exit;
+  exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func deflate.decoder.init_fixed_huffman
+
+static wuffs_base__empty_struct
+wuffs_deflate__decoder__init_fixed_huffman(
+    wuffs_deflate__decoder* self) {
+  uint32_t v_i = 0;
+
+  while (v_i < 512) {
+    self->private_data.f_huffs[0][v_i] = WUFFS_DEFLATE__FIXED_LCODE_HUFFS[v_i];
+    v_i += 1;
+  }
+  v_i = 0;
+  while (v_i < 32) {
+    self->private_data.f_huffs[1][v_i] = WUFFS_DEFLATE__FIXED_DCODE_HUFFS[v_i];
+    v_i += 1;
+  }
+  self->private_impl.f_n_huffs_bits[0] = 9;
+  self->private_impl.f_n_huffs_bits[1] = 5;
+  self->private_impl.f_cached_n_lit = 0;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.decoder.init_dynamic_huffman
+
+static wuffs_base__status
+wuffs_deflate__decoder__init_dynamic_huffman(
+    wuffs_deflate__decoder* self,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_bits = 0;
+  uint32_t v_n_bits = 0;
+  uint32_t v_b0 = 0;
+  uint32_t v_n_lit = 0;
+  uint32_t v_n_dist = 0;
+  uint32_t v_n_clen = 0;
+  uint32_t v_i = 0;
+  uint32_t v_b1 = 0;
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  uint32_t v_mask = 0;
+  uint32_t v_table_entry = 0;
+  uint32_t v_table_entry_n_bits = 0;
+  uint32_t v_b2 = 0;
+  uint32_t v_n_extra_bits = 0;
+  uint8_t v_rep_symbol = 0;
+  uint32_t v_rep_count = 0;
+  uint32_t v_b3 = 0;
+  uint32_t v_lcode_n_huffs_bits = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_init_dynamic_huffman[0];
+  if (coro_susp_point) {
+    v_bits = self->private_data.s_init_dynamic_huffman[0].v_bits;
+    v_n_bits = self->private_data.s_init_dynamic_huffman[0].v_n_bits;
+    v_n_lit = self->private_data.s_init_dynamic_huffman[0].v_n_lit;
+    v_n_dist = self->private_data.s_init_dynamic_huffman[0].v_n_dist;
+    v_n_clen = self->private_data.s_init_dynamic_huffman[0].v_n_clen;
+    v_i = self->private_data.s_init_dynamic_huffman[0].v_i;
+    v_mask = self->private_data.s_init_dynamic_huffman[0].v_mask;
+    v_table_entry = self->private_data.s_init_dynamic_huffman[0].v_table_entry;
+    v_n_extra_bits = self->private_data.s_init_dynamic_huffman[0].v_n_extra_bits;
+    v_rep_count = self->private_data.s_init_dynamic_huffman[0].v_rep_count;
+    v_lcode_n_huffs_bits = self->private_data.s_init_dynamic_huffman[0].v_lcode_n_huffs_bits;
+    v_rep_symbol = self->private_data.s_init_dynamic_huffman[0].v_rep_symbol;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    v_bits = self->private_impl.f_bits;
+    v_n_bits = self->private_impl.f_n_bits;
+    while (v_n_bits < 14) {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint32_t t_0 = *iop_a_src++;
+        v_b0 = t_0;
+      }
+      v_bits |= (v_b0 << v_n_bits);
+      v_n_bits += 8;
+    }
+    v_n_lit = (((v_bits) & 0x1F) + 257);
+    if (v_n_lit > 286) {
+      status = wuffs_base__make_status(wuffs_deflate__error__bad_literal_length_code_count);
+      goto exit;
+    }
+    v_bits >>= 5;
+    v_n_dist = (((v_bits) & 0x1F) + 1);
+    if (v_n_dist > 30) {
+      status = wuffs_base__make_status(wuffs_deflate__error__bad_distance_code_count);
+      goto exit;
+    }
+    v_bits >>= 5;
+    v_n_clen = (((v_bits) & 0xF) + 4);
+    v_bits >>= 4;
+    v_n_bits -= 14;
+    v_i = 0;
+    while (v_i < v_n_clen) {
+      while (v_n_bits < 3) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint32_t t_1 = *iop_a_src++;
+          v_b1 = t_1;
+        }
+        v_bits |= (v_b1 << v_n_bits);
+        v_n_bits += 8;
+      }
+      self->private_data.f_code_lengths[WUFFS_DEFLATE__CODE_ORDER[v_i]] = ((uint8_t)((v_bits & 7)));
+      v_bits >>= 3;
+      v_n_bits -= 3;
+      v_i += 1;
+    }
+    while (v_i < 19) {
+      self->private_data.f_code_lengths[WUFFS_DEFLATE__CODE_ORDER[v_i]] = 0;
+      v_i += 1;
+    }
+    v_lcode_n_huffs_bits = self->private_impl.f_n_huffs_bits[0];
+    v_status = wuffs_deflate__decoder__init_huff(self,
+        0,
+        0,
+        19,
+        4095,
+        896);
+    if (wuffs_base__status__is_error(&v_status)) {
+      status = v_status;
+      goto exit;
+    }
+    v_mask = (((((uint32_t)(1)) << self->private_impl.f_n_huffs_bits[0]) - 1) & 127);
+    v_i = 0;
+    label__0__continue:;
+    while (v_i < (v_n_lit + v_n_dist)) {
+      while (true) {
+        v_table_entry = self->private_data.f_huffs[0][(896 + (v_bits & v_mask))];
+        v_table_entry_n_bits = (v_table_entry & 15);
+        if (v_n_bits >= v_table_entry_n_bits) {
+          v_bits >>= v_table_entry_n_bits;
+          v_n_bits -= v_table_entry_n_bits;
+          goto label__1__break;
+        }
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint32_t t_2 = *iop_a_src++;
+          v_b2 = t_2;
+        }
+        v_bits |= (v_b2 << v_n_bits);
+        v_n_bits += 8;
+      }
+      label__1__break:;
+      if ((v_table_entry >> 24) != 128) {
+        status = wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+        goto exit;
+      }
+      v_table_entry = ((v_table_entry >> 8) & 255);
+      if (v_table_entry < 16) {
+        self->private_data.f_code_lengths[v_i] = ((uint8_t)(v_table_entry));
+        v_i += 1;
+        goto label__0__continue;
+      }
+      v_n_extra_bits = 0;
+      v_rep_symbol = 0;
+      v_rep_count = 0;
+      if (v_table_entry == 16) {
+        v_n_extra_bits = 2;
+        if (v_i <= 0) {
+          status = wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code_length_repetition);
+          goto exit;
+        }
+        v_rep_symbol = (self->private_data.f_code_lengths[(v_i - 1)] & 15);
+        v_rep_count = 3;
+      } else if (v_table_entry == 17) {
+        v_n_extra_bits = 3;
+        v_rep_symbol = 0;
+        v_rep_count = 3;
+      } else if (v_table_entry == 18) {
+        v_n_extra_bits = 7;
+        v_rep_symbol = 0;
+        v_rep_count = 11;
+      } else {
+        status = wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+        goto exit;
+      }
+      while (v_n_bits < v_n_extra_bits) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint32_t t_3 = *iop_a_src++;
+          v_b3 = t_3;
+        }
+        v_bits |= (v_b3 << v_n_bits);
+        v_n_bits += 8;
+      }
+      v_rep_count += ((v_bits) & WUFFS_BASE__LOW_BITS_MASK__U32(v_n_extra_bits));
+      v_bits >>= v_n_extra_bits;
+      v_n_bits -= v_n_extra_bits;
+      while (v_rep_count > 0) {
+        if (v_i >= (v_n_lit + v_n_dist)) {
+          status = wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code_length_count);
+          goto exit;
+        }
+        self->private_data.f_code_lengths[v_i] = v_rep_symbol;
+        v_i += 1;
+        v_rep_count -= 1;
+      }
+    }
+    if (v_i != (v_n_lit + v_n_dist)) {
+      status = wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code_length_count);
+      goto exit;
+    }
+    if (self->private_data.f_code_lengths[256] == 0) {
+      status = wuffs_base__make_status(wuffs_deflate__error__missing_end_of_block_code);
+      goto exit;
+    }
+    if ((self->private_impl.f_cached_n_lit == v_n_lit) && (self->private_impl.f_cached_n_dist == v_n_dist)) {
+      v_i = 0;
+      while (v_i < (v_n_lit + v_n_dist)) {
+        if (self->private_data.f_code_lengths[v_i] != self->private_data.f_cached_code_lengths[v_i]) {
+          goto label__2__break;
+        }
+        v_i += 1;
+      }
+      label__2__break:;
+      if (v_i == (v_n_lit + v_n_dist)) {
+        self->private_impl.f_n_huffs_bits[0] = v_lcode_n_huffs_bits;
+        self->private_impl.f_bits = v_bits;
+        self->private_impl.f_n_bits = v_n_bits;
+        status = wuffs_base__make_status(NULL);
+        goto ok;
+      }
+    }
+    self->private_impl.f_cached_n_lit = 0;
+    v_status = wuffs_deflate__decoder__init_huff(self,
+        0,
+        0,
+        v_n_lit,
+        257,
+        0);
+    if (wuffs_base__status__is_error(&v_status)) {
+      status = v_status;
+      goto exit;
+    }
+    v_status = wuffs_deflate__decoder__init_huff(self,
+        1,
+        v_n_lit,
+        (v_n_lit + v_n_dist),
+        0,
+        0);
+    if (wuffs_base__status__is_error(&v_status)) {
+      status = v_status;
+      goto exit;
+    }
+    v_i = 0;
+    while (v_i < (v_n_lit + v_n_dist)) {
+      self->private_data.f_cached_code_lengths[v_i] = self->private_data.f_code_lengths[v_i];
+      v_i += 1;
+    }
+    self->private_impl.f_cached_n_lit = v_n_lit;
+    self->private_impl.f_cached_n_dist = v_n_dist;
+    self->private_impl.f_bits = v_bits;
+    self->private_impl.f_n_bits = v_n_bits;
+
+    ok:
+    self->private_impl.p_init_dynamic_huffman[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_init_dynamic_huffman[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_init_dynamic_huffman[0].v_bits = v_bits;
+  self->private_data.s_init_dynamic_huffman[0].v_n_bits = v_n_bits;
+  self->private_data.s_init_dynamic_huffman[0].v_n_lit = v_n_lit;
+  self->private_data.s_init_dynamic_huffman[0].v_n_dist = v_n_dist;
+  self->private_data.s_init_dynamic_huffman[0].v_n_clen = v_n_clen;
+  self->private_data.s_init_dynamic_huffman[0].v_i = v_i;
+  self->private_data.s_init_dynamic_huffman[0].v_mask = v_mask;
+  self->private_data.s_init_dynamic_huffman[0].v_table_entry = v_table_entry;
+  self->private_data.s_init_dynamic_huffman[0].v_n_extra_bits = v_n_extra_bits;
+  self->private_data.s_init_dynamic_huffman[0].v_rep_count = v_rep_count;
+  self->private_data.s_init_dynamic_huffman[0].v_lcode_n_huffs_bits = v_lcode_n_huffs_bits;
+  self->private_data.s_init_dynamic_huffman[0].v_rep_symbol = v_rep_symbol;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func deflate.decoder.init_huff
+
+static wuffs_base__status
+wuffs_deflate__decoder__init_huff(
+    wuffs_deflate__decoder* self,
+    uint32_t a_which,
+    uint32_t a_n_codes0,
+    uint32_t a_n_codes1,
+    uint32_t a_base_symbol,
+    uint32_t a_initial_top) {
+  uint16_t v_counts[16] = {0};
+  uint32_t v_i = 0;
+  uint32_t v_remaining = 0;
+  uint16_t v_offsets[16] = {0};
+  uint32_t v_n_symbols = 0;
+  uint32_t v_count = 0;
+  uint16_t v_symbols[320] = {0};
+  uint32_t v_min_cl = 0;
+  uint32_t v_max_cl = 0;
+  uint32_t v_initial_high_bits = 0;
+  uint32_t v_prev_cl = 0;
+  uint32_t v_prev_redirect_key = 0;
+  uint32_t v_top = 0;
+  uint32_t v_next_top = 0;
+  uint32_t v_code = 0;
+  uint32_t v_key = 0;
+  uint32_t v_value = 0;
+  uint32_t v_cl = 0;
+  uint32_t v_redirect_key = 0;
+  uint32_t v_j = 0;
+  uint32_t v_reversed_key = 0;
+  uint32_t v_symbol = 0;
+  uint32_t v_high_bits = 0;
+  uint32_t v_delta = 0;
+
+  WUFFS_BASE__STATS__ADD(self->private_impl, 3, 1);
+  v_i = a_n_codes0;
+  while (v_i < a_n_codes1) {
+    if (v_counts[(self->private_data.f_code_lengths[v_i] & 15)] >= 320) {
+      return wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+    }
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#endif
+    v_counts[(self->private_data.f_code_lengths[v_i] & 15)] += 1;
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+    v_i += 1;
+  }
+  if ((((uint32_t)(v_counts[0])) + a_n_codes0) == a_n_codes1) {
+    return wuffs_base__make_status(wuffs_deflate__error__no_huffman_codes);
+  }
+  v_remaining = 1;
+  v_i = 1;
+  while (v_i <= 15) {
+    if (v_remaining > 1073741824) {
+      return wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+    }
+    v_remaining <<= 1;
+    if (v_remaining < ((uint32_t)(v_counts[v_i]))) {
+      return wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code_over_subscribed);
+    }
+    v_remaining -= ((uint32_t)(v_counts[v_i]));
+    v_i += 1;
+  }
+  if (v_remaining != 0) {
+    if ((a_which == 1) && (v_counts[1] == 1) && ((((uint32_t)(v_counts[0])) + a_n_codes0 + 1) == a_n_codes1)) {
+      v_i = 0;
+      while (v_i <= 29) {
+        if (self->private_data.f_code_lengths[(a_n_codes0 + v_i)] == 1) {
+          self->private_impl.f_n_huffs_bits[1] = 1;
+          self->private_data.f_huffs[1][0] = (WUFFS_DEFLATE__DCODE_MAGIC_NUMBERS[v_i] | 1);
+          self->private_data.f_huffs[1][1] = (WUFFS_DEFLATE__DCODE_MAGIC_NUMBERS[31] | 1);
+          return wuffs_base__make_status(NULL);
+        }
+        v_i += 1;
+      }
+    }
+    return wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code_under_subscribed);
+  }
+  v_i = 1;
+  while (v_i <= 15) {
+    v_offsets[v_i] = ((uint16_t)(v_n_symbols));
+    v_count = ((uint32_t)(v_counts[v_i]));
+    if (v_n_symbols > (320 - v_count)) {
+      return wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+    }
+    v_n_symbols = (v_n_symbols + v_count);
+    v_i += 1;
+  }
+  if (v_n_symbols > 288) {
+    return wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+  }
+  v_i = a_n_codes0;
+  while (v_i < a_n_codes1) {
+    if (v_i < a_n_codes0) {
+      return wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+    }
+    if (self->private_data.f_code_lengths[v_i] != 0) {
+      if (v_offsets[(self->private_data.f_code_lengths[v_i] & 15)] >= 320) {
+        return wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+      }
+      v_symbols[v_offsets[(self->private_data.f_code_lengths[v_i] & 15)]] = ((uint16_t)((v_i - a_n_codes0)));
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#endif
+      v_offsets[(self->private_data.f_code_lengths[v_i] & 15)] += 1;
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+    }
+    v_i += 1;
+  }
+  v_min_cl = 1;
+  while (true) {
+    if (v_counts[v_min_cl] != 0) {
+      goto label__0__break;
+    }
+    if (v_min_cl >= 9) {
+      return wuffs_base__make_status(wuffs_deflate__error__bad_huffman_minimum_code_length);
+    }
+    v_min_cl += 1;
+  }
+  label__0__break:;
+  v_max_cl = 15;
+  while (true) {
+    if (v_counts[v_max_cl] != 0) {
+      goto label__1__break;
+    }
+    if (v_max_cl <= 1) {
+      return wuffs_base__make_status(wuffs_deflate__error__no_huffman_codes);
+    }
+    v_max_cl -= 1;
+  }
+  label__1__break:;
+  if (v_max_cl <= 9) {
+    self->private_impl.f_n_huffs_bits[a_which] = v_max_cl;
+  } else {
+    self->private_impl.f_n_huffs_bits[a_which] = 9;
+  }
+  v_i = 0;
+  if ((v_n_symbols != ((uint32_t)(v_offsets[v_max_cl]))) || (v_n_symbols != ((uint32_t)(v_offsets[15])))) {
+    return wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+  }
+  if ((a_n_codes0 + ((uint32_t)(v_symbols[0]))) >= 320) {
+    return wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+  }
+  v_initial_high_bits = 512;
+  if (v_max_cl < 9) {
+    v_initial_high_bits = (((uint32_t)(1)) << v_max_cl);
+  }
+  v_prev_cl = ((uint32_t)((self->private_data.f_code_lengths[(a_n_codes0 + ((uint32_t)(v_symbols[0])))] & 15)));
+  v_prev_redirect_key = 4294967295;
+  v_top = a_initial_top;
+  v_next_top = 512;
+  v_code = 0;
+  v_key = 0;
+  v_value = 0;
+  while (true) {
+    if ((a_n_codes0 + ((uint32_t)(v_symbols[v_i]))) >= 320) {
+      return wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+    }
+    v_cl = ((uint32_t)((self->private_data.f_code_lengths[(a_n_codes0 + ((uint32_t)(v_symbols[v_i])))] & 15)));
+    if (v_cl > v_prev_cl) {
+      v_code <<= (v_cl - v_prev_cl);
+      if (v_code >= 32768) {
+        return wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+      }
+    }
+    v_prev_cl = v_cl;
+    v_key = v_code;
+    if (v_cl > 9) {
+      v_cl -= 9;
+      v_redirect_key = ((v_key >> v_cl) & 511);
+      v_key = ((v_key) & WUFFS_BASE__LOW_BITS_MASK__U32(v_cl));
+      if (v_prev_redirect_key != v_redirect_key) {
+        v_prev_redirect_key = v_redirect_key;
+        v_remaining = (((uint32_t)(1)) << v_cl);
+        v_j = v_prev_cl;
+        while (v_j <= 15) {
+          if (v_remaining <= ((uint32_t)(v_counts[v_j]))) {
+            goto label__2__break;
+          }
+          v_remaining -= ((uint32_t)(v_counts[v_j]));
+          if (v_remaining > 1073741824) {
+            return wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+          }
+          v_remaining <<= 1;
+          v_j += 1;
+        }
+        label__2__break:;
+        if ((v_j <= 9) || (15 < v_j)) {
+          return wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+        }
+        v_j -= 9;
+        v_initial_high_bits = (((uint32_t)(1)) << v_j);
+        v_top = v_next_top;
+        if ((v_top + (((uint32_t)(1)) << v_j)) > 1024) {
+          return wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+        }
+        v_next_top = (v_top + (((uint32_t)(1)) << v_j));
+        v_redirect_key = (((uint32_t)(WUFFS_DEFLATE__REVERSE8[(v_redirect_key >> 1)])) | ((v_redirect_key & 1) << 8));
+        self->private_data.f_huffs[a_which][v_redirect_key] = (268435465 | (v_top << 8) | (v_j << 4));
+      }
+    }
+    if ((v_key >= 512) || (v_counts[v_prev_cl] <= 0)) {
+      return wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+    }
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#endif
+    v_counts[v_prev_cl] -= 1;
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+    v_reversed_key = (((uint32_t)(WUFFS_DEFLATE__REVERSE8[(v_key >> 1)])) | ((v_key & 1) << 8));
+    v_reversed_key >>= (9 - v_cl);
+    v_symbol = ((uint32_t)(v_symbols[v_i]));
+    if (v_symbol == 256) {
+      v_value = (536870912 | v_cl);
+    } else if ((v_symbol < 256) && (a_which == 0)) {
+      v_value = (2147483648 | (v_symbol << 8) | v_cl);
+    } else if (v_symbol >= a_base_symbol) {
+      v_symbol -= a_base_symbol;
+      if (a_which == 0) {
+        v_value = (WUFFS_DEFLATE__LCODE_MAGIC_NUMBERS[(v_symbol & 31)] | v_cl);
+      } else {
+        v_value = (WUFFS_DEFLATE__DCODE_MAGIC_NUMBERS[(v_symbol & 31)] | v_cl);
+      }
+    } else {
+      return wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+    }
+    v_high_bits = v_initial_high_bits;
+    v_delta = (((uint32_t)(1)) << v_cl);
+    while (v_high_bits >= v_delta) {
+      v_high_bits -= v_delta;
+      if ((v_top + ((v_high_bits | v_reversed_key) & 511)) >= 1024) {
+        return wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+      }
+      self->private_data.f_huffs[a_which][(v_top + ((v_high_bits | v_reversed_key) & 511))] = v_value;
+    }
+    v_i += 1;
+    if (v_i >= v_n_symbols) {
+      goto label__3__break;
+    }
+    v_code += 1;
+    if (v_code >= 32768) {
+      return wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+    }
+  }
+  label__3__break:;
+  return wuffs_base__make_status(NULL);
+}
+
+// ‼ WUFFS MULTI-FILE SECTION +x86_bmi2
+// -------- func deflate.decoder.decode_huffman_bmi2
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("bmi2")
+static wuffs_base__status
+wuffs_deflate__decoder__decode_huffman_bmi2(
+    wuffs_deflate__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint64_t v_bits = 0;
+  uint32_t v_n_bits = 0;
+  uint32_t v_table_entry = 0;
+  uint32_t v_table_entry_n_bits = 0;
+  uint64_t v_lmask = 0;
+  uint64_t v_dmask = 0;
+  uint32_t v_redir_top = 0;
+  uint32_t v_redir_mask = 0;
+  uint32_t v_length = 0;
+  uint32_t v_dist_minus_1 = 0;
+  uint32_t v_hlen = 0;
+  uint32_t v_hdist = 0;
+  uint32_t v_hdist_adjustment = 0;
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  if ((self->private_impl.f_n_bits >= 8) || ((self->private_impl.f_bits >> (self->private_impl.f_n_bits & 7)) != 0)) {
+    status = wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_n_bits);
+    goto exit;
+  }
+  v_bits = ((uint64_t)(self->private_impl.f_bits));
+  v_n_bits = self->private_impl.f_n_bits;
+  v_lmask = ((((uint64_t)(1)) << self->private_impl.f_n_huffs_bits[0]) - 1);
+  v_dmask = ((((uint64_t)(1)) << self->private_impl.f_n_huffs_bits[1]) - 1);
+  if (self->private_impl.f_transformed_history_count < (a_dst ? a_dst->meta.pos : 0)) {
+    status = wuffs_base__make_status(wuffs_base__error__bad_i_o_position);
+    goto exit;
+  }
+  v_hdist_adjustment = ((uint32_t)(((self->private_impl.f_transformed_history_count - (a_dst ? a_dst->meta.pos : 0)) & 4294967295)));
+  label__loop__continue:;
+  while ((((uint64_t)(io2_a_dst - iop_a_dst)) >= 266) && (((uint64_t)(io2_a_src - iop_a_src)) >= 8)) {
+    v_bits |= ((uint64_t)(wuffs_base__peek_u64le__no_bounds_check(iop_a_src) << (v_n_bits & 63)));
+    iop_a_src += ((63 - (v_n_bits & 63)) >> 3);
+    v_n_bits |= 56;
+    v_table_entry = self->private_data.f_huffs[0][(v_bits & v_lmask)];
+    v_table_entry_n_bits = (v_table_entry & 15);
+    v_bits >>= v_table_entry_n_bits;
+    v_n_bits -= v_table_entry_n_bits;
+    if ((v_table_entry >> 31) != 0) {
+      (wuffs_base__poke_u8be__no_bounds_check(iop_a_dst, ((uint8_t)(((v_table_entry >> 8) & 255)))), iop_a_dst += 1);
+      goto label__loop__continue;
+    } else if ((v_table_entry >> 30) != 0) {
+    } else if ((v_table_entry >> 29) != 0) {
+      self->private_impl.f_end_of_block = true;
+      goto label__loop__break;
+    } else if ((v_table_entry >> 28) != 0) {
+      v_redir_top = ((v_table_entry >> 8) & 65535);
+      v_redir_mask = ((((uint32_t)(1)) << ((v_table_entry >> 4) & 15)) - 1);
+      v_table_entry = self->private_data.f_huffs[0][((v_redir_top + (((uint32_t)((v_bits & 4294967295))) & v_redir_mask)) & 1023)];
+      v_table_entry_n_bits = (v_table_entry & 15);
+      v_bits >>= v_table_entry_n_bits;
+      v_n_bits -= v_table_entry_n_bits;
+      if ((v_table_entry >> 31) != 0) {
+        (wuffs_base__poke_u8be__no_bounds_check(iop_a_dst, ((uint8_t)(((v_table_entry >> 8) & 255)))), iop_a_dst += 1);
+        goto label__loop__continue;
+      } else if ((v_table_entry >> 30) != 0) {
+      } else if ((v_table_entry >> 29) != 0) {
+        self->private_impl.f_end_of_block = true;
+        goto label__loop__break;
+      } else if ((v_table_entry >> 28) != 0) {
+        status = wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+        goto exit;
+      } else if ((v_table_entry >> 27) != 0) {
+        status = wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code);
+        goto exit;
+      } else {
+        status = wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+        goto exit;
+      }
+    } else if ((v_table_entry >> 27) != 0) {
+      status = wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code);
+      goto exit;
+    } else {
+      status = wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+      goto exit;
+    }
+    v_length = (((v_table_entry >> 8) & 255) + 3);
+    v_table_entry_n_bits = ((v_table_entry >> 4) & 15);
+    if (v_table_entry_n_bits > 0) {
+      v_length = (((v_length + 253 + ((uint32_t)(((v_bits) & WUFFS_BASE__LOW_BITS_MASK__U64(v_table_entry_n_bits))))) & 255) + 3);
+      v_bits >>= v_table_entry_n_bits;
+      v_n_bits -= v_table_entry_n_bits;
+    }
+    v_table_entry = self->private_data.f_huffs[1][(v_bits & v_dmask)];
+    v_table_entry_n_bits = (v_table_entry & 15);
+    v_bits >>= v_table_entry_n_bits;
+    v_n_bits -= v_table_entry_n_bits;
+    if ((v_table_entry >> 28) == 1) {
+      v_redir_top = ((v_table_entry >> 8) & 65535);
+      v_redir_mask = ((((uint32_t)(1)) << ((v_table_entry >> 4) & 15)) - 1);
+      v_table_entry = self->private_data.f_huffs[1][((v_redir_top + (((uint32_t)((v_bits & 4294967295))) & v_redir_mask)) & 1023)];
+      v_table_entry_n_bits = (v_table_entry & 15);
+      v_bits >>= v_table_entry_n_bits;
+      v_n_bits -= v_table_entry_n_bits;
+    }
+    if ((v_table_entry >> 24) != 64) {
+      if ((v_table_entry >> 24) == 8) {
+        status = wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code);
+        goto exit;
+      }
+      status = wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+      goto exit;
+    }
+    v_dist_minus_1 = ((v_table_entry >> 8) & 32767);
+    v_table_entry_n_bits = ((v_table_entry >> 4) & 15);
+    v_dist_minus_1 = ((v_dist_minus_1 + ((uint32_t)(((v_bits) & WUFFS_BASE__LOW_BITS_MASK__U64(v_table_entry_n_bits))))) & 32767);
+    v_bits >>= v_table_entry_n_bits;
+    v_n_bits -= v_table_entry_n_bits;
+    while (true) {
+      if (((uint64_t)((v_dist_minus_1 + 1))) > ((uint64_t)(iop_a_dst - io0_a_dst))) {
+        v_hlen = 0;
+        v_hdist = ((uint32_t)((((uint64_t)((v_dist_minus_1 + 1))) - ((uint64_t)(iop_a_dst - io0_a_dst)))));
+        if (v_length > v_hdist) {
+          v_length -= v_hdist;
+          v_hlen = v_hdist;
+        } else {
+          v_hlen = v_length;
+          v_length = 0;
+        }
+        v_hdist += v_hdist_adjustment;
+        if (self->private_impl.f_history_index < v_hdist) {
+          status = wuffs_base__make_status(wuffs_deflate__error__bad_distance);
+          goto exit;
+        }
+        if (((uint64_t)(a_workbuf.len)) < 33025) {
+          status = wuffs_base__make_status(wuffs_base__error__bad_workbuf_length);
+          goto exit;
+        }
+        wuffs_base__io_writer__limited_copy_u32_from_slice(
+            &iop_a_dst, io2_a_dst,v_hlen, wuffs_base__slice_u8__subslice_ij(a_workbuf, ((self->private_impl.f_history_index - v_hdist) & 32767), 33025));
+        if (v_length == 0) {
+          goto label__loop__continue;
+        }
+        if ((((uint64_t)((v_dist_minus_1 + 1))) > ((uint64_t)(iop_a_dst - io0_a_dst))) || (((uint64_t)(v_length)) > ((uint64_t)(io2_a_dst - iop_a_dst))) || (((uint64_t)((v_length + 8))) > ((uint64_t)(io2_a_dst - iop_a_dst)))) {
+          status = wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_distance);
+          goto exit;
+        }
+      }
+      if ((v_dist_minus_1 + 1) >= 8) {
+        wuffs_base__io_writer__limited_copy_u32_from_history_8_byte_chunks_fast(
+            &iop_a_dst, io0_a_dst, io2_a_dst, v_length, (v_dist_minus_1 + 1));
+      } else if ((v_dist_minus_1 + 1) == 1) {
+        wuffs_base__io_writer__limited_copy_u32_from_history_8_byte_chunks_distance_1_fast(
+            &iop_a_dst, io0_a_dst, io2_a_dst, v_length, (v_dist_minus_1 + 1));
+      } else {
+        wuffs_base__io_writer__limited_copy_u32_from_history_fast(
+            &iop_a_dst, io0_a_dst, io2_a_dst, v_length, (v_dist_minus_1 + 1));
+      }
+      goto label__0__break;
+    }
+    label__0__break:;
+  }
+  label__loop__break:;
+  if (v_n_bits > 63) {
+    status = wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_n_bits);
+    goto exit;
+  }
+  while (v_n_bits >= 8) {
+    v_n_bits -= 8;
+    if (iop_a_src > io1_a_src) {
+      iop_a_src--;
+    } else {
+      status = wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_i_o);
+      goto exit;
+    }
+  }
+  self->private_impl.f_bits = ((uint32_t)((v_bits & ((((uint64_t)(1)) << v_n_bits) - 1))));
+  self->private_impl.f_n_bits = v_n_bits;
+  if ((self->private_impl.f_n_bits >= 8) || ((self->private_impl.f_bits >> self->private_impl.f_n_bits) != 0)) {
+    status = wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_n_bits);
+    goto exit;
+  }
+  goto exit;
+  exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// ‼ WUFFS MULTI-FILE SECTION -x86_bmi2
+
+// -------- func deflate.decoder.decode_huffman_fast32
+
+static wuffs_base__status
+wuffs_deflate__decoder__decode_huffman_fast32(
+    wuffs_deflate__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_bits = 0;
+  uint32_t v_n_bits = 0;
+  uint32_t v_table_entry = 0;
+  uint32_t v_table_entry_n_bits = 0;
+  uint32_t v_lmask = 0;
+  uint32_t v_dmask = 0;
+  uint32_t v_redir_top = 0;
+  uint32_t v_redir_mask = 0;
+  uint32_t v_length = 0;
+  uint32_t v_dist_minus_1 = 0;
+  uint32_t v_hlen = 0;
+  uint32_t v_hdist = 0;
+  uint32_t v_hdist_adjustment = 0;
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  if ((self->private_impl.f_n_bits >= 8) || ((self->private_impl.f_bits >> (self->private_impl.f_n_bits & 7)) != 0)) {
+    status = wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_n_bits);
+    goto exit;
+  }
+  v_bits = self->private_impl.f_bits;
+  v_n_bits = self->private_impl.f_n_bits;
+  v_lmask = ((((uint32_t)(1)) << self->private_impl.f_n_huffs_bits[0]) - 1);
+  v_dmask = ((((uint32_t)(1)) << self->private_impl.f_n_huffs_bits[1]) - 1);
+  if (self->private_impl.f_transformed_history_count < (a_dst ? a_dst->meta.pos : 0)) {
+    status = wuffs_base__make_status(wuffs_base__error__bad_i_o_position);
+    goto exit;
+  }
+  v_hdist_adjustment = ((uint32_t)(((self->private_impl.f_transformed_history_count - (a_dst ? a_dst->meta.pos : 0)) & 4294967295)));
+  label__loop__continue:;
+  while ((((uint64_t)(io2_a_dst - iop_a_dst)) >= 266) && (((uint64_t)(io2_a_src - iop_a_src)) >= 12)) {
+    if (v_n_bits < 15) {
+      v_bits |= (((uint32_t)(wuffs_base__peek_u8be__no_bounds_check(iop_a_src))) << v_n_bits);
+      iop_a_src += 1;
+      v_n_bits += 8;
+      v_bits |= (((uint32_t)(wuffs_base__peek_u8be__no_bounds_check(iop_a_src))) << v_n_bits);
+      iop_a_src += 1;
+      v_n_bits += 8;
+    } else {
+    }
+    v_table_entry = self->private_data.f_huffs[0][(v_bits & v_lmask)];
+    v_table_entry_n_bits = (v_table_entry & 15);
+    v_bits >>= v_table_entry_n_bits;
+    v_n_bits -= v_table_entry_n_bits;
+    if ((v_table_entry >> 31) != 0) {
+      (wuffs_base__poke_u8be__no_bounds_check(iop_a_dst, ((uint8_t)(((v_table_entry >> 8) & 255)))), iop_a_dst += 1);
+      goto label__loop__continue;
+    } else if ((v_table_entry >> 30) != 0) {
+    } else if ((v_table_entry >> 29) != 0) {
+      self->private_impl.f_end_of_block = true;
+      goto label__loop__break;
+    } else if ((v_table_entry >> 28) != 0) {
+      if (v_n_bits < 15) {
+        v_bits |= (((uint32_t)(wuffs_base__peek_u8be__no_bounds_check(iop_a_src))) << v_n_bits);
+        iop_a_src += 1;
+        v_n_bits += 8;
+        v_bits |= (((uint32_t)(wuffs_base__peek_u8be__no_bounds_check(iop_a_src))) << v_n_bits);
+        iop_a_src += 1;
+        v_n_bits += 8;
+      } else {
+      }
+      v_redir_top = ((v_table_entry >> 8) & 65535);
+      v_redir_mask = ((((uint32_t)(1)) << ((v_table_entry >> 4) & 15)) - 1);
+      v_table_entry = self->private_data.f_huffs[0][((v_redir_top + (v_bits & v_redir_mask)) & 1023)];
+      v_table_entry_n_bits = (v_table_entry & 15);
+      v_bits >>= v_table_entry_n_bits;
+      v_n_bits -= v_table_entry_n_bits;
+      if ((v_table_entry >> 31) != 0) {
+        (wuffs_base__poke_u8be__no_bounds_check(iop_a_dst, ((uint8_t)(((v_table_entry >> 8) & 255)))), iop_a_dst += 1);
+        goto label__loop__continue;
+      } else if ((v_table_entry >> 30) != 0) {
+      } else if ((v_table_entry >> 29) != 0) {
+        self->private_impl.f_end_of_block = true;
+        goto label__loop__break;
+      } else if ((v_table_entry >> 28) != 0) {
+        status = wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+        goto exit;
+      } else if ((v_table_entry >> 27) != 0) {
+        status = wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code);
+        goto exit;
+      } else {
+        status = wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+        goto exit;
+      }
+    } else if ((v_table_entry >> 27) != 0) {
+      status = wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code);
+      goto exit;
+    } else {
+      status = wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+      goto exit;
+    }
+    v_length = (((v_table_entry >> 8) & 255) + 3);
+    v_table_entry_n_bits = ((v_table_entry >> 4) & 15);
+    if (v_table_entry_n_bits > 0) {
+      if (v_n_bits < 15) {
+        v_bits |= (((uint32_t)(wuffs_base__peek_u8be__no_bounds_check(iop_a_src))) << v_n_bits);
+        iop_a_src += 1;
+        v_n_bits += 8;
+        v_bits |= (((uint32_t)(wuffs_base__peek_u8be__no_bounds_check(iop_a_src))) << v_n_bits);
+        iop_a_src += 1;
+        v_n_bits += 8;
+      } else {
+      }
+      v_length = (((v_length + 253 + ((v_bits) & WUFFS_BASE__LOW_BITS_MASK__U32(v_table_entry_n_bits))) & 255) + 3);
+      v_bits >>= v_table_entry_n_bits;
+      v_n_bits -= v_table_entry_n_bits;
+    } else {
+    }
+    if (v_n_bits < 15) {
+      v_bits |= (((uint32_t)(wuffs_base__peek_u8be__no_bounds_check(iop_a_src))) << v_n_bits);
+      iop_a_src += 1;
+      v_n_bits += 8;
+      v_bits |= (((uint32_t)(wuffs_base__peek_u8be__no_bounds_check(iop_a_src))) << v_n_bits);
+      iop_a_src += 1;
+      v_n_bits += 8;
+    } else {
+    }
+    v_table_entry = self->private_data.f_huffs[1][(v_bits & v_dmask)];
+    v_table_entry_n_bits = (v_table_entry & 15);
+    v_bits >>= v_table_entry_n_bits;
+    v_n_bits -= v_table_entry_n_bits;
+    if ((v_table_entry >> 28) == 1) {
+      if (v_n_bits < 15) {
+        v_bits |= (((uint32_t)(wuffs_base__peek_u8be__no_bounds_check(iop_a_src))) << v_n_bits);
+        iop_a_src += 1;
+        v_n_bits += 8;
+        v_bits |= (((uint32_t)(wuffs_base__peek_u8be__no_bounds_check(iop_a_src))) << v_n_bits);
+        iop_a_src += 1;
+        v_n_bits += 8;
+      } else {
+      }
+      v_redir_top = ((v_table_entry >> 8) & 65535);
+      v_redir_mask = ((((uint32_t)(1)) << ((v_table_entry >> 4) & 15)) - 1);
+      v_table_entry = self->private_data.f_huffs[1][((v_redir_top + (v_bits & v_redir_mask)) & 1023)];
+      v_table_entry_n_bits = (v_table_entry & 15);
+      v_bits >>= v_table_entry_n_bits;
+      v_n_bits -= v_table_entry_n_bits;
+    } else {
+    }
+    if ((v_table_entry >> 24) != 64) {
+      if ((v_table_entry >> 24) == 8) {
+        status = wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code);
+        goto exit;
+      }
+      status = wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+      goto exit;
+    }
+    v_dist_minus_1 = ((v_table_entry >> 8) & 32767);
+    v_table_entry_n_bits = ((v_table_entry >> 4) & 15);
+    if (v_n_bits < v_table_entry_n_bits) {
+      v_bits |= (((uint32_t)(wuffs_base__peek_u8be__no_bounds_check(iop_a_src))) << v_n_bits);
+      iop_a_src += 1;
+      v_n_bits += 8;
+      v_bits |= (((uint32_t)(wuffs_base__peek_u8be__no_bounds_check(iop_a_src))) << v_n_bits);
+      iop_a_src += 1;
+      v_n_bits += 8;
+    }
+    v_dist_minus_1 = ((v_dist_minus_1 + ((v_bits) & WUFFS_BASE__LOW_BITS_MASK__U32(v_table_entry_n_bits))) & 32767);
+    v_bits >>= v_table_entry_n_bits;
+    v_n_bits -= v_table_entry_n_bits;
+    while (true) {
+      if (((uint64_t)((v_dist_minus_1 + 1))) > ((uint64_t)(iop_a_dst - io0_a_dst))) {
+        v_hlen = 0;
+        v_hdist = ((uint32_t)((((uint64_t)((v_dist_minus_1 + 1))) - ((uint64_t)(iop_a_dst - io0_a_dst)))));
+        if (v_length > v_hdist) {
+          v_length -= v_hdist;
+          v_hlen = v_hdist;
+        } else {
+          v_hlen = v_length;
+          v_length = 0;
+        }
+        v_hdist += v_hdist_adjustment;
+        if (self->private_impl.f_history_index < v_hdist) {
+          status = wuffs_base__make_status(wuffs_deflate__error__bad_distance);
+          goto exit;
+        }
+        if (((uint64_t)(a_workbuf.len)) < 33025) {
+          status = wuffs_base__make_status(wuffs_base__error__bad_workbuf_length);
+          goto exit;
+        }
+        wuffs_base__io_writer__limited_copy_u32_from_slice(
+            &iop_a_dst, io2_a_dst,v_hlen, wuffs_base__slice_u8__subslice_ij(a_workbuf, ((self->private_impl.f_history_index - v_hdist) & 32767), 33025));
+        if (v_length == 0) {
+          goto label__loop__continue;
+        }
+        if ((((uint64_t)((v_dist_minus_1 + 1))) > ((uint64_t)(iop_a_dst - io0_a_dst))) || (((uint64_t)(v_length)) > ((uint64_t)(io2_a_dst - iop_a_dst))) || (((uint64_t)((v_length + 8))) > ((uint64_t)(io2_a_dst - iop_a_dst)))) {
+          status = wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_distance);
+          goto exit;
+        }
+      }
+      if ((v_dist_minus_1 + 1) >= 8) {
+        wuffs_base__io_writer__limited_copy_u32_from_history_8_byte_chunks_fast(
+            &iop_a_dst, io0_a_dst, io2_a_dst, v_length, (v_dist_minus_1 + 1));
+      } else {
+        wuffs_base__io_writer__limited_copy_u32_from_history_fast(
+            &iop_a_dst, io0_a_dst, io2_a_dst, v_length, (v_dist_minus_1 + 1));
+      }
+      goto label__0__break;
+    }
+    label__0__break:;
+  }
+  label__loop__break:;
+  while (v_n_bits >= 8) {
+    v_n_bits -= 8;
+    if (iop_a_src > io1_a_src) {
+      iop_a_src--;
+    } else {
+      status = wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_i_o);
+      goto exit;
+    }
+  }
+  self->private_impl.f_bits = (v_bits & ((((uint32_t)(1)) << v_n_bits) - 1));
+  self->private_impl.f_n_bits = v_n_bits;
+  if ((self->private_impl.f_n_bits >= 8) || ((self->private_impl.f_bits >> self->private_impl.f_n_bits) != 0)) {
+    status = wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_n_bits);
+    goto exit;
+  }
+  goto exit;
+  exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func deflate.decoder.decode_huffman_fast64
+
+static wuffs_base__status
+wuffs_deflate__decoder__decode_huffman_fast64(
+    wuffs_deflate__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf) {
+  return (*self->private_impl.choosy_decode_huffman_fast64)(self, a_dst, a_src, a_workbuf);
+}
+
+static wuffs_base__status
+wuffs_deflate__decoder__decode_huffman_fast64__choosy_default(
+    wuffs_deflate__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint64_t v_bits = 0;
+  uint32_t v_n_bits = 0;
+  uint32_t v_table_entry = 0;
+  uint32_t v_table_entry_n_bits = 0;
+  uint64_t v_lmask = 0;
+  uint64_t v_dmask = 0;
+  uint32_t v_redir_top = 0;
+  uint32_t v_redir_mask = 0;
+  uint32_t v_length = 0;
+  uint32_t v_dist_minus_1 = 0;
+  uint32_t v_hlen = 0;
+  uint32_t v_hdist = 0;
+  uint32_t v_hdist_adjustment = 0;
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  if ((self->private_impl.f_n_bits >= 8) || ((self->private_impl.f_bits >> (self->private_impl.f_n_bits & 7)) != 0)) {
+    status = wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_n_bits);
+    goto exit;
+  }
+  v_bits = ((uint64_t)(self->private_impl.f_bits));
+  v_n_bits = self->private_impl.f_n_bits;
+  v_lmask = ((((uint64_t)(1)) << self->private_impl.f_n_huffs_bits[0]) - 1);
+  v_dmask = ((((uint64_t)(1)) << self->private_impl.f_n_huffs_bits[1]) - 1);
+  if (self->private_impl.f_transformed_history_count < (a_dst ? a_dst->meta.pos : 0)) {
+    status = wuffs_base__make_status(wuffs_base__error__bad_i_o_position);
+    goto exit;
+  }
+  v_hdist_adjustment = ((uint32_t)(((self->private_impl.f_transformed_history_count - (a_dst ? a_dst->meta.pos : 0)) & 4294967295)));
+  label__loop__continue:;
+  while ((((uint64_t)(io2_a_dst - iop_a_dst)) >= 266) && (((uint64_t)(io2_a_src - iop_a_src)) >= 8)) {
+    v_bits |= ((uint64_t)(wuffs_base__peek_u64le__no_bounds_check(iop_a_src) << (v_n_bits & 63)));
+    iop_a_src += ((63 - (v_n_bits & 63)) >> 3);
+    v_n_bits |= 56;
+    v_table_entry = self->private_data.f_huffs[0][(v_bits & v_lmask)];
+    v_table_entry_n_bits = (v_table_entry & 15);
+    v_bits >>= v_table_entry_n_bits;
+    v_n_bits -= v_table_entry_n_bits;
+    if ((v_table_entry >> 31) != 0) {
+      (wuffs_base__poke_u8be__no_bounds_check(iop_a_dst, ((uint8_t)(((v_table_entry >> 8) & 255)))), iop_a_dst += 1);
+      goto label__loop__continue;
+    } else if ((v_table_entry >> 30) != 0) {
+    } else if ((v_table_entry >> 29) != 0) {
+      self->private_impl.f_end_of_block = true;
+      goto label__loop__break;
+    } else if ((v_table_entry >> 28) != 0) {
+      v_redir_top = ((v_table_entry >> 8) & 65535);
+      v_redir_mask = ((((uint32_t)(1)) << ((v_table_entry >> 4) & 15)) - 1);
+      v_table_entry = self->private_data.f_huffs[0][((v_redir_top + (((uint32_t)((v_bits & 4294967295))) & v_redir_mask)) & 1023)];
+      v_table_entry_n_bits = (v_table_entry & 15);
+      v_bits >>= v_table_entry_n_bits;
+      v_n_bits -= v_table_entry_n_bits;
+      if ((v_table_entry >> 31) != 0) {
+        (wuffs_base__poke_u8be__no_bounds_check(iop_a_dst, ((uint8_t)(((v_table_entry >> 8) & 255)))), iop_a_dst += 1);
+        goto label__loop__continue;
+      } else if ((v_table_entry >> 30) != 0) {
+      } else if ((v_table_entry >> 29) != 0) {
+        self->private_impl.f_end_of_block = true;
+        goto label__loop__break;
+      } else if ((v_table_entry >> 28) != 0) {
+        status = wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+        goto exit;
+      } else if ((v_table_entry >> 27) != 0) {
+        status = wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code);
+        goto exit;
+      } else {
+        status = wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+        goto exit;
+      }
+    } else if ((v_table_entry >> 27) != 0) {
+      status = wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code);
+      goto exit;
+    } else {
+      status = wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+      goto exit;
+    }
+    v_length = (((v_table_entry >> 8) & 255) + 3);
+    v_table_entry_n_bits = ((v_table_entry >> 4) & 15);
+    if (v_table_entry_n_bits > 0) {
+      v_length = (((v_length + 253 + ((uint32_t)(((v_bits) & WUFFS_BASE__LOW_BITS_MASK__U64(v_table_entry_n_bits))))) & 255) + 3);
+      v_bits >>= v_table_entry_n_bits;
+      v_n_bits -= v_table_entry_n_bits;
+    }
+    v_table_entry = self->private_data.f_huffs[1][(v_bits & v_dmask)];
+    v_table_entry_n_bits = (v_table_entry & 15);
+    v_bits >>= v_table_entry_n_bits;
+    v_n_bits -= v_table_entry_n_bits;
+    if ((v_table_entry >> 28) == 1) {
+      v_redir_top = ((v_table_entry >> 8) & 65535);
+      v_redir_mask = ((((uint32_t)(1)) << ((v_table_entry >> 4) & 15)) - 1);
+      v_table_entry = self->private_data.f_huffs[1][((v_redir_top + (((uint32_t)((v_bits & 4294967295))) & v_redir_mask)) & 1023)];
+      v_table_entry_n_bits = (v_table_entry & 15);
+      v_bits >>= v_table_entry_n_bits;
+      v_n_bits -= v_table_entry_n_bits;
+    }
+    if ((v_table_entry >> 24) != 64) {
+      if ((v_table_entry >> 24) == 8) {
+        status = wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code);
+        goto exit;
+      }
+      status = wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+      goto exit;
+    }
+    v_dist_minus_1 = ((v_table_entry >> 8) & 32767);
+    v_table_entry_n_bits = ((v_table_entry >> 4) & 15);
+    v_dist_minus_1 = ((v_dist_minus_1 + ((uint32_t)(((v_bits) & WUFFS_BASE__LOW_BITS_MASK__U64(v_table_entry_n_bits))))) & 32767);
+    v_bits >>= v_table_entry_n_bits;
+    v_n_bits -= v_table_entry_n_bits;
+    while (true) {
+      if (((uint64_t)((v_dist_minus_1 + 1))) > ((uint64_t)(iop_a_dst - io0_a_dst))) {
+        v_hlen = 0;
+        v_hdist = ((uint32_t)((((uint64_t)((v_dist_minus_1 + 1))) - ((uint64_t)(iop_a_dst - io0_a_dst)))));
+        if (v_length > v_hdist) {
+          v_length -= v_hdist;
+          v_hlen = v_hdist;
+        } else {
+          v_hlen = v_length;
+          v_length = 0;
+        }
+        v_hdist += v_hdist_adjustment;
+        if (self->private_impl.f_history_index < v_hdist) {
+          status = wuffs_base__make_status(wuffs_deflate__error__bad_distance);
+          goto exit;
+        }
+        if (((uint64_t)(a_workbuf.len)) < 33025) {
+          status = wuffs_base__make_status(wuffs_base__error__bad_workbuf_length);
+          goto exit;
+        }
+        wuffs_base__io_writer__limited_copy_u32_from_slice(
+            &iop_a_dst, io2_a_dst,v_hlen, wuffs_base__slice_u8__subslice_ij(a_workbuf, ((self->private_impl.f_history_index - v_hdist) & 32767), 33025));
+        if (v_length == 0) {
+          goto label__loop__continue;
+        }
+        if ((((uint64_t)((v_dist_minus_1 + 1))) > ((uint64_t)(iop_a_dst - io0_a_dst))) || (((uint64_t)(v_length)) > ((uint64_t)(io2_a_dst - iop_a_dst))) || (((uint64_t)((v_length + 8))) > ((uint64_t)(io2_a_dst - iop_a_dst)))) {
+          status = wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_distance);
+          goto exit;
+        }
+      }
+      if ((v_dist_minus_1 + 1) >= 8) {
+        wuffs_base__io_writer__limited_copy_u32_from_history_8_byte_chunks_fast(
+            &iop_a_dst, io0_a_dst, io2_a_dst, v_length, (v_dist_minus_1 + 1));
+      } else if ((v_dist_minus_1 + 1) == 1) {
+        wuffs_base__io_writer__limited_copy_u32_from_history_8_byte_chunks_distance_1_fast(
+            &iop_a_dst, io0_a_dst, io2_a_dst, v_length, (v_dist_minus_1 + 1));
+      } else {
+        wuffs_base__io_writer__limited_copy_u32_from_history_fast(
+            &iop_a_dst, io0_a_dst, io2_a_dst, v_length, (v_dist_minus_1 + 1));
+      }
+      goto label__0__break;
+    }
+    label__0__break:;
+  }
+  label__loop__break:;
+  if (v_n_bits > 63) {
+    status = wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_n_bits);
+    goto exit;
+  }
+  while (v_n_bits >= 8) {
+    v_n_bits -= 8;
+    if (iop_a_src > io1_a_src) {
+      iop_a_src--;
+    } else {
+      status = wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_i_o);
+      goto exit;
+    }
+  }
+  self->private_impl.f_bits = ((uint32_t)((v_bits & ((((uint64_t)(1)) << v_n_bits) - 1))));
+  self->private_impl.f_n_bits = v_n_bits;
+  if ((self->private_impl.f_n_bits >= 8) || ((self->private_impl.f_bits >> self->private_impl.f_n_bits) != 0)) {
+    status = wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_n_bits);
+    goto exit;
+  }
+  goto exit;
+  exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func deflate.decoder.decode_huffman_slow
+
+static wuffs_base__status
+wuffs_deflate__decoder__decode_huffman_slow(
+    wuffs_deflate__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_bits = 0;
+  uint32_t v_n_bits = 0;
+  uint32_t v_table_entry = 0;
+  uint32_t v_table_entry_n_bits = 0;
+  uint32_t v_lmask = 0;
+  uint32_t v_dmask = 0;
+  uint32_t v_b0 = 0;
+  uint32_t v_redir_top = 0;
+  uint32_t v_redir_mask = 0;
+  uint32_t v_b1 = 0;
+  uint32_t v_length = 0;
+  uint32_t v_b2 = 0;
+  uint32_t v_b3 = 0;
+  uint32_t v_b4 = 0;
+  uint32_t v_dist_minus_1 = 0;
+  uint32_t v_b5 = 0;
+  uint32_t v_n_copied = 0;
+  uint32_t v_hlen = 0;
+  uint32_t v_hdist = 0;
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_huffman_slow[0];
+  if (coro_susp_point) {
+    v_bits = self->private_data.s_decode_huffman_slow[0].v_bits;
+    v_n_bits = self->private_data.s_decode_huffman_slow[0].v_n_bits;
+    v_table_entry = self->private_data.s_decode_huffman_slow[0].v_table_entry;
+    v_table_entry_n_bits = self->private_data.s_decode_huffman_slow[0].v_table_entry_n_bits;
+    v_lmask = self->private_data.s_decode_huffman_slow[0].v_lmask;
+    v_dmask = self->private_data.s_decode_huffman_slow[0].v_dmask;
+    v_redir_top = self->private_data.s_decode_huffman_slow[0].v_redir_top;
+    v_redir_mask = self->private_data.s_decode_huffman_slow[0].v_redir_mask;
+    v_length = self->private_data.s_decode_huffman_slow[0].v_length;
+    v_dist_minus_1 = self->private_data.s_decode_huffman_slow[0].v_dist_minus_1;
+    v_hlen = self->private_data.s_decode_huffman_slow[0].v_hlen;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if ((self->private_impl.f_n_bits >= 8) || ((self->private_impl.f_bits >> (self->private_impl.f_n_bits & 7)) != 0)) {
+      status = wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_n_bits);
+      goto exit;
+    }
+    v_bits = self->private_impl.f_bits;
+    v_n_bits = self->private_impl.f_n_bits;
+    v_lmask = ((((uint32_t)(1)) << self->private_impl.f_n_huffs_bits[0]) - 1);
+    v_dmask = ((((uint32_t)(1)) << self->private_impl.f_n_huffs_bits[1]) - 1);
+    label__loop__continue:;
+    while ( ! (self->private_impl.p_decode_huffman_slow[0] != 0)) {
+      while (true) {
+        v_table_entry = self->private_data.f_huffs[0][(v_bits & v_lmask)];
+        v_table_entry_n_bits = (v_table_entry & 15);
+        if (v_n_bits >= v_table_entry_n_bits) {
+          v_bits >>= v_table_entry_n_bits;
+          v_n_bits -= v_table_entry_n_bits;
+          goto label__0__break;
+        }
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint32_t t_0 = *iop_a_src++;
+          v_b0 = t_0;
+        }
+        v_bits |= (v_b0 << v_n_bits);
+        v_n_bits += 8;
+      }
+      label__0__break:;
+      if ((v_table_entry >> 31) != 0) {
+        self->private_data.s_decode_huffman_slow[0].scratch = ((uint8_t)(((v_table_entry >> 8) & 255)));
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        if (iop_a_dst == io2_a_dst) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+          goto suspend;
+        }
+        *iop_a_dst++ = ((uint8_t)(self->private_data.s_decode_huffman_slow[0].scratch));
+        goto label__loop__continue;
+      } else if ((v_table_entry >> 30) != 0) {
+      } else if ((v_table_entry >> 29) != 0) {
+        self->private_impl.f_end_of_block = true;
+        goto label__loop__break;
+      } else if ((v_table_entry >> 28) != 0) {
+        v_redir_top = ((v_table_entry >> 8) & 65535);
+        v_redir_mask = ((((uint32_t)(1)) << ((v_table_entry >> 4) & 15)) - 1);
+        while (true) {
+          v_table_entry = self->private_data.f_huffs[0][((v_redir_top + (v_bits & v_redir_mask)) & 1023)];
+          v_table_entry_n_bits = (v_table_entry & 15);
+          if (v_n_bits >= v_table_entry_n_bits) {
+            v_bits >>= v_table_entry_n_bits;
+            v_n_bits -= v_table_entry_n_bits;
+            goto label__1__break;
+          }
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint32_t t_1 = *iop_a_src++;
+            v_b1 = t_1;
+          }
+          v_bits |= (v_b1 << v_n_bits);
+          v_n_bits += 8;
+        }
+        label__1__break:;
+        if ((v_table_entry >> 31) != 0) {
+          self->private_data.s_decode_huffman_slow[0].scratch = ((uint8_t)(((v_table_entry >> 8) & 255)));
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+          if (iop_a_dst == io2_a_dst) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+            goto suspend;
+          }
+          *iop_a_dst++ = ((uint8_t)(self->private_data.s_decode_huffman_slow[0].scratch));
+          goto label__loop__continue;
+        } else if ((v_table_entry >> 30) != 0) {
+        } else if ((v_table_entry >> 29) != 0) {
+          self->private_impl.f_end_of_block = true;
+          goto label__loop__break;
+        } else if ((v_table_entry >> 28) != 0) {
+          status = wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+          goto exit;
+        } else if ((v_table_entry >> 27) != 0) {
+          status = wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code);
+          goto exit;
+        } else {
+          status = wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+          goto exit;
+        }
+      } else if ((v_table_entry >> 27) != 0) {
+        status = wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code);
+        goto exit;
+      } else {
+        status = wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+        goto exit;
+      }
+      v_length = (((v_table_entry >> 8) & 255) + 3);
+      v_table_entry_n_bits = ((v_table_entry >> 4) & 15);
+      if (v_table_entry_n_bits > 0) {
+        while (v_n_bits < v_table_entry_n_bits) {
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint32_t t_2 = *iop_a_src++;
+            v_b2 = t_2;
+          }
+          v_bits |= (v_b2 << v_n_bits);
+          v_n_bits += 8;
+        }
+        v_length = (((v_length + 253 + ((v_bits) & WUFFS_BASE__LOW_BITS_MASK__U32(v_table_entry_n_bits))) & 255) + 3);
+        v_bits >>= v_table_entry_n_bits;
+        v_n_bits -= v_table_entry_n_bits;
+      }
+      while (true) {
+        v_table_entry = self->private_data.f_huffs[1][(v_bits & v_dmask)];
+        v_table_entry_n_bits = (v_table_entry & 15);
+        if (v_n_bits >= v_table_entry_n_bits) {
+          v_bits >>= v_table_entry_n_bits;
+          v_n_bits -= v_table_entry_n_bits;
+          goto label__2__break;
+        }
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint32_t t_3 = *iop_a_src++;
+          v_b3 = t_3;
+        }
+        v_bits |= (v_b3 << v_n_bits);
+        v_n_bits += 8;
+      }
+      label__2__break:;
+      if ((v_table_entry >> 28) == 1) {
+        v_redir_top = ((v_table_entry >> 8) & 65535);
+        v_redir_mask = ((((uint32_t)(1)) << ((v_table_entry >> 4) & 15)) - 1);
+        while (true) {
+          v_table_entry = self->private_data.f_huffs[1][((v_redir_top + (v_bits & v_redir_mask)) & 1023)];
+          v_table_entry_n_bits = (v_table_entry & 15);
+          if (v_n_bits >= v_table_entry_n_bits) {
+            v_bits >>= v_table_entry_n_bits;
+            v_n_bits -= v_table_entry_n_bits;
+            goto label__3__break;
+          }
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint32_t t_4 = *iop_a_src++;
+            v_b4 = t_4;
+          }
+          v_bits |= (v_b4 << v_n_bits);
+          v_n_bits += 8;
+        }
+        label__3__break:;
+      }
+      if ((v_table_entry >> 24) != 64) {
+        if ((v_table_entry >> 24) == 8) {
+          status = wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code);
+          goto exit;
+        }
+        status = wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+        goto exit;
+      }
+      v_dist_minus_1 = ((v_table_entry >> 8) & 32767);
+      v_table_entry_n_bits = ((v_table_entry >> 4) & 15);
+      if (v_table_entry_n_bits > 0) {
+        while (v_n_bits < v_table_entry_n_bits) {
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint32_t t_5 = *iop_a_src++;
+            v_b5 = t_5;
+          }
+          v_bits |= (v_b5 << v_n_bits);
+          v_n_bits += 8;
+        }
+        v_dist_minus_1 = ((v_dist_minus_1 + ((v_bits) & WUFFS_BASE__LOW_BITS_MASK__U32(v_table_entry_n_bits))) & 32767);
+        v_bits >>= v_table_entry_n_bits;
+        v_n_bits -= v_table_entry_n_bits;
+      }
+      label__inner__continue:;
+      while (true) {
+        if (((uint64_t)((v_dist_minus_1 + 1))) > ((uint64_t)(iop_a_dst - io0_a_dst))) {
+          v_hdist = ((uint32_t)((((uint64_t)((v_dist_minus_1 + 1))) - ((uint64_t)(iop_a_dst - io0_a_dst)))));
+          if (v_hdist < v_length) {
+            v_hlen = v_hdist;
+          } else {
+            v_hlen = v_length;
+          }
+          v_hdist += ((uint32_t)((((uint64_t)(self->private_impl.f_transformed_history_count - (a_dst ? a_dst->meta.pos : 0))) & 4294967295)));
+          if (self->private_impl.f_history_index < v_hdist) {
+            status = wuffs_base__make_status(wuffs_deflate__error__bad_distance);
+            goto exit;
+          }
+          if (((uint64_t)(a_workbuf.len)) < 33025) {
+            status = wuffs_base__make_status(wuffs_base__error__bad_workbuf_length);
+            goto exit;
+          }
+          v_n_copied = wuffs_base__io_writer__limited_copy_u32_from_slice(
+              &iop_a_dst, io2_a_dst,v_hlen, wuffs_base__slice_u8__subslice_ij(a_workbuf, ((self->private_impl.f_history_index - v_hdist) & 32767), 33025));
+          if (v_n_copied < v_hlen) {
+            v_length -= v_n_copied;
+            status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(9);
+            goto label__inner__continue;
+          }
+          v_length -= v_hlen;
+          if (v_length == 0) {
+            goto label__loop__continue;
+          }
+        }
+        v_n_copied = wuffs_base__io_writer__limited_copy_u32_from_history(
+            &iop_a_dst, io0_a_dst, io2_a_dst, v_length, (v_dist_minus_1 + 1));
+        if (v_length <= v_n_copied) {
+          goto label__loop__continue;
+        }
+        v_length -= v_n_copied;
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(10);
+      }
+    }
+    label__loop__break:;
+    self->private_impl.f_bits = v_bits;
+    self->private_impl.f_n_bits = v_n_bits;
+    if ((self->private_impl.f_n_bits >= 8) || ((self->private_impl.f_bits >> (self->private_impl.f_n_bits & 7)) != 0)) {
+      status = wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_n_bits);
+      goto exit;
+    }
+
+    ok:
+    self->private_impl.p_decode_huffman_slow[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_huffman_slow[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_decode_huffman_slow[0].v_bits = v_bits;
+  self->private_data.s_decode_huffman_slow[0].v_n_bits = v_n_bits;
+  self->private_data.s_decode_huffman_slow[0].v_table_entry = v_table_entry;
+  self->private_data.s_decode_huffman_slow[0].v_table_entry_n_bits = v_table_entry_n_bits;
+  self->private_data.s_decode_huffman_slow[0].v_lmask = v_lmask;
+  self->private_data.s_decode_huffman_slow[0].v_dmask = v_dmask;
+  self->private_data.s_decode_huffman_slow[0].v_redir_top = v_redir_top;
+  self->private_data.s_decode_huffman_slow[0].v_redir_mask = v_redir_mask;
+  self->private_data.s_decode_huffman_slow[0].v_length = v_length;
+  self->private_data.s_decode_huffman_slow[0].v_dist_minus_1 = v_dist_minus_1;
+  self->private_data.s_decode_huffman_slow[0].v_hlen = v_hlen;
+
+  goto exit;
+  exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func deflate.encoder.set_quirk_enabled
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_deflate__encoder__set_quirk_enabled(
+    wuffs_deflate__encoder* self,
+    uint32_t a_quirk,
+    bool a_enabled) {
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.set_level
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_deflate__encoder__set_level(
+    wuffs_deflate__encoder* self,
+    uint32_t a_level) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (a_level > 9) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_level = a_level;
+  self->private_impl.f_has_level = true;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.set_flush_mode
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_deflate__encoder__set_flush_mode(
+    wuffs_deflate__encoder* self,
+    uint32_t a_mode) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (a_mode > 2) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_flush_mode = a_mode;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.workbuf_len
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64
+wuffs_deflate__encoder__workbuf_len(
+    const wuffs_deflate__encoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+
+  return wuffs_base__utility__make_range_ii_u64(0, 0);
+}
+
+// -------- func deflate.encoder.transform_io
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_deflate__encoder__transform_io(
+    wuffs_deflate__encoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+        ? wuffs_base__error__disabled_by_previous_error
+        : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst || !a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 1)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  bool v_final = false;
+  bool v_flushing = false;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_transform_io[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if ( ! self->private_impl.f_in_stream) {
+      wuffs_deflate__encoder__start_stream(self);
+    }
+    while (true) {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      status = wuffs_deflate__encoder__write_to(self, a_dst);
+      if (status.repr) {
+        goto suspend;
+      }
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      wuffs_deflate__encoder__fill_window(self, a_src);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      v_final = ((((uint64_t)(io2_a_src - iop_a_src)) == 0) && ((a_src && a_src->meta.closed) || (self->private_impl.f_flush_mode == 2)));
+      v_flushing = ((((uint64_t)(io2_a_src - iop_a_src)) == 0) && (self->private_impl.f_flush_mode == 1));
+      wuffs_deflate__encoder__deflate_chunk(self, (v_final || v_flushing));
+      if (self->private_impl.f_n_syms >= 16382) {
+        wuffs_deflate__encoder__resolve_pending(self);
+        wuffs_deflate__encoder__emit_block(self, false);
+      } else if (v_final && (self->private_impl.f_ri >= self->private_impl.f_wi)) {
+        wuffs_deflate__encoder__resolve_pending(self);
+        wuffs_deflate__encoder__emit_block(self, true);
+        wuffs_deflate__encoder__put_bits(self, 0, ((8 - (self->private_impl.f_n_bits & 7)) & 7));
+        if (self->private_impl.f_obuf_overflow) {
+          status = wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_encoder_state);
+          goto exit;
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        status = wuffs_deflate__encoder__write_to(self, a_dst);
+        if (status.repr) {
+          goto suspend;
+        }
+        self->private_impl.f_in_stream = false;
+        status = wuffs_base__make_status(NULL);
+        goto ok;
+      } else if (v_flushing && (self->private_impl.f_ri >= self->private_impl.f_wi)) {
+        wuffs_deflate__encoder__resolve_pending(self);
+        if ((self->private_impl.f_n_syms > 0) || (self->private_impl.f_block_start < self->private_impl.f_ri)) {
+          wuffs_deflate__encoder__emit_block(self, false);
+        }
+        wuffs_deflate__encoder__emit_stored(self, 0);
+        if (self->private_impl.f_obuf_overflow) {
+          status = wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_encoder_state);
+          goto exit;
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+        status = wuffs_deflate__encoder__write_to(self, a_dst);
+        if (status.repr) {
+          goto suspend;
+        }
+        self->private_impl.f_in_stream = false;
+        status = wuffs_base__make_status(NULL);
+        goto ok;
+      } else if (self->private_impl.f_wi >= 65536) {
+        wuffs_deflate__encoder__resolve_pending(self);
+        wuffs_deflate__encoder__emit_block(self, false);
+        wuffs_deflate__encoder__slide_window(self);
+      } else {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(4);
+      }
+      if (self->private_impl.f_obuf_overflow) {
+        status = wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_encoder_state);
+        goto exit;
+      }
+    }
+
+    ok:
+    self->private_impl.p_transform_io[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_transform_io[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine = wuffs_base__status__is_suspension(&status) ? 1 : 0;
+  WUFFS_BASE__STATS__ADD(self->private_impl, WUFFS_BASE__STATS__SUSPENSIONS,
+      wuffs_base__status__is_suspension(&status) ? 1u : 0u);
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func deflate.encoder.start_stream
+
+static wuffs_base__empty_struct
+wuffs_deflate__encoder__start_stream(
+    wuffs_deflate__encoder* self) {
+  uint32_t v_level = 0;
+  uint32_t v_i = 0;
+
+  v_level = 6;
+  if (self->private_impl.f_has_level) {
+    v_level = self->private_impl.f_level;
+  }
+  self->private_impl.f_store_only = (v_level == 0);
+  self->private_impl.f_good_len = WUFFS_DEFLATE__LEVEL_GOOD_LENGTHS[v_level];
+  self->private_impl.f_max_lazy = WUFFS_DEFLATE__LEVEL_MAX_LAZIES[v_level];
+  self->private_impl.f_nice_len = WUFFS_DEFLATE__LEVEL_NICE_LENGTHS[v_level];
+  self->private_impl.f_max_chain = WUFFS_DEFLATE__LEVEL_MAX_CHAINS[v_level];
+  self->private_impl.f_bits = 0;
+  self->private_impl.f_n_bits = 0;
+  self->private_impl.f_obuf_ri = 0;
+  self->private_impl.f_obuf_wi = 0;
+  self->private_impl.f_obuf_overflow = false;
+  self->private_impl.f_block_start = 0;
+  self->private_impl.f_ri = 0;
+  self->private_impl.f_wi = 0;
+  self->private_impl.f_lazy_pending = false;
+  self->private_impl.f_lazy_len = 0;
+  self->private_impl.f_lazy_dist = 0;
+  wuffs_deflate__encoder__reset_block(self);
+  while (v_i < 32768) {
+    self->private_data.f_head[v_i] = 0;
+    v_i += 1;
+  }
+  self->private_impl.f_in_stream = true;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.reset_block
+
+static wuffs_base__empty_struct
+wuffs_deflate__encoder__reset_block(
+    wuffs_deflate__encoder* self) {
+  uint32_t v_i = 0;
+
+  self->private_impl.f_block_start = self->private_impl.f_ri;
+  self->private_impl.f_n_syms = 0;
+  while (v_i < 288) {
+    self->private_data.f_lfreqs[v_i] = 0;
+    v_i += 1;
+  }
+  v_i = 0;
+  while (v_i < 32) {
+    self->private_data.f_dfreqs[v_i] = 0;
+    v_i += 1;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.fill_window
+
+static wuffs_base__empty_struct
+wuffs_deflate__encoder__fill_window(
+    wuffs_deflate__encoder* self,
+    wuffs_base__io_buffer* a_src) {
+  uint32_t v_n = 0;
+  uint32_t v_t = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  v_n = wuffs_base__io_reader__limited_copy_u32_to_slice(
+      &iop_a_src, io2_a_src,4294967295, wuffs_base__slice_u8__subslice_i(wuffs_base__make_slice_u8(self->private_data.f_window, 65536), self->private_impl.f_wi));
+  v_t = ((uint32_t)(self->private_impl.f_wi + v_n));
+  self->private_impl.f_wi = wuffs_base__u32__min(v_t, 65536);
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.slide_window
+
+static wuffs_base__empty_struct
+wuffs_deflate__encoder__slide_window(
+    wuffs_deflate__encoder* self) {
+  uint32_t v_i = 0;
+
+  if ((self->private_impl.f_wi < 65536) || (self->private_impl.f_ri < 32768)) {
+    self->private_impl.f_obuf_overflow = true;
+    return wuffs_base__make_empty_struct();
+  }
+  wuffs_base__slice_u8__copy_from_slice(wuffs_base__make_slice_u8(self->private_data.f_window, 32768), wuffs_base__make_slice_u8((self->private_data.f_window) + 32768, 32768));
+  self->private_impl.f_wi = 32768;
+  self->private_impl.f_ri -= 32768;
+  self->private_impl.f_block_start = self->private_impl.f_ri;
+  while (v_i < 32768) {
+    self->private_data.f_head[v_i] = wuffs_base__u16__sat_sub(self->private_data.f_head[v_i], 32768);
+    self->private_data.f_prev[v_i] = wuffs_base__u16__sat_sub(self->private_data.f_prev[v_i], 32768);
+    v_i += 1;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.write_to
+
+static wuffs_base__status
+wuffs_deflate__encoder__write_to(
+    wuffs_deflate__encoder* self,
+    wuffs_base__io_buffer* a_dst) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  wuffs_base__slice_u8 v_s = {0};
+  uint64_t v_n = 0;
+  uint32_t v_t = 0;
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_write_to[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    while (self->private_impl.f_obuf_wi > 0) {
+      if (self->private_impl.f_obuf_ri > self->private_impl.f_obuf_wi) {
+        status = wuffs_base__make_status(wuffs_deflate__error__internal_error_inconsistent_i_o);
+        goto exit;
+      }
+      v_s = wuffs_base__slice_u8__subslice_ij(wuffs_base__make_slice_u8(self->private_data.f_obuf,
+          66560),
+          self->private_impl.f_obuf_ri,
+          self->private_impl.f_obuf_wi);
+      v_n = wuffs_base__io_writer__copy_from_slice(&iop_a_dst, io2_a_dst,v_s);
+      if (v_n == ((uint64_t)(v_s.len))) {
+        self->private_impl.f_obuf_ri = 0;
+        self->private_impl.f_obuf_wi = 0;
+        status = wuffs_base__make_status(NULL);
+        goto ok;
+      }
+      v_t = ((uint32_t)(self->private_impl.f_obuf_ri + ((uint32_t)((v_n & 4294967295)))));
+      self->private_impl.f_obuf_ri = wuffs_base__u32__min(v_t, 66560);
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
+    }
+
+    ok:
+    self->private_impl.p_write_to[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_write_to[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+  exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func deflate.encoder.hash3
+
+static uint32_t
+wuffs_deflate__encoder__hash3(
+    const wuffs_deflate__encoder* self,
+    uint32_t a_p) {
+  return (((uint32_t)((((uint32_t)(self->private_data.f_window[a_p])) | (((uint32_t)(self->private_data.f_window[(a_p + 1)])) << 8) | (((uint32_t)(self->private_data.f_window[(a_p + 2)])) << 16)) * 2654435761)) >> 17);
+}
+
+// -------- func deflate.encoder.deflate_chunk
+
+static wuffs_base__empty_struct
+wuffs_deflate__encoder__deflate_chunk(
+    wuffs_deflate__encoder* self,
+    bool a_final) {
+  uint32_t v_cur = 0;
+  uint32_t v_wi = 0;
+  uint32_t v_max_len = 0;
+  uint32_t v_h = 0;
+  uint32_t v_cand = 0;
+  uint32_t v_len = 0;
+  uint32_t v_lazy_len = 0;
+  uint32_t v_t = 0;
+
+  if (self->private_impl.f_store_only) {
+    self->private_impl.f_ri = self->private_impl.f_wi;
+    return wuffs_base__make_empty_struct();
+  }
+  v_cur = self->private_impl.f_ri;
+  v_wi = self->private_impl.f_wi;
+  v_lazy_len = self->private_impl.f_lazy_len;
+  while (true) {
+    if ((self->private_impl.f_n_syms >= 16382) || (v_wi <= v_cur)) {
+      goto label__loop__break;
+    }
+    v_t = (v_wi - v_cur);
+    v_max_len = wuffs_base__u32__min(v_t, 258);
+    if ((v_max_len < 258) &&  ! a_final) {
+      goto label__loop__break;
+    }
+    v_len = 0;
+    if (v_max_len >= 3) {
+      v_h = (wuffs_deflate__encoder__hash3(self, v_cur) & 32767);
+      v_cand = ((uint32_t)(self->private_data.f_head[v_h]));
+      self->private_data.f_head[v_h] = ((uint16_t)((v_cur & 65535)));
+      self->private_data.f_prev[(v_cur & 32767)] = ((uint16_t)(v_cand));
+      if ((self->private_impl.f_max_lazy == 0) || (v_lazy_len < self->private_impl.f_max_lazy)) {
+        v_len = wuffs_deflate__encoder__find_match(self,
+            v_cur,
+            v_max_len,
+            v_lazy_len,
+            v_cand);
+        if ((v_len == 3) && (self->private_impl.f_match_dist > 4096)) {
+          v_len = 0;
+        }
+      }
+    }
+    if (self->private_impl.f_max_lazy == 0) {
+      if (v_len >= 3) {
+        wuffs_deflate__encoder__add_match(self, v_len, self->private_impl.f_match_dist);
+        wuffs_deflate__encoder__insert_hashes(self, (v_cur + 1), (v_cur + v_len));
+        v_t = (v_cur + v_len);
+        v_cur = wuffs_base__u32__min(v_t, v_wi);
+      } else {
+        wuffs_deflate__encoder__add_literal(self, self->private_data.f_window[v_cur]);
+        v_t = (v_cur + 1);
+        v_cur = wuffs_base__u32__min(v_t, v_wi);
+      }
+    } else if (self->private_impl.f_lazy_pending && (v_lazy_len >= 3) && (v_len == 0)) {
+      wuffs_deflate__encoder__add_match(self, v_lazy_len, self->private_impl.f_lazy_dist);
+      wuffs_deflate__encoder__insert_hashes(self, (v_cur + 1), ((uint32_t)((v_cur + v_lazy_len) - 1)));
+      v_t = ((uint32_t)((v_cur + v_lazy_len) - 1));
+      v_cur = wuffs_base__u32__min(v_t, v_wi);
+      self->private_impl.f_lazy_pending = false;
+      v_lazy_len = 0;
+    } else {
+      if (self->private_impl.f_lazy_pending) {
+        wuffs_deflate__encoder__add_literal(self, self->private_data.f_window[(((uint32_t)(v_cur - 1)) & 65535)]);
+      }
+      self->private_impl.f_lazy_pending = true;
+      v_lazy_len = 0;
+      if (v_len >= 3) {
+        v_lazy_len = v_len;
+        self->private_impl.f_lazy_dist = self->private_impl.f_match_dist;
+      }
+      v_t = (v_cur + 1);
+      v_cur = wuffs_base__u32__min(v_t, v_wi);
+    }
+  }
+  label__loop__break:;
+  self->private_impl.f_ri = v_cur;
+  self->private_impl.f_lazy_len = v_lazy_len;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.find_match
+
+static uint32_t
+wuffs_deflate__encoder__find_match(
+    wuffs_deflate__encoder* self,
+    uint32_t a_cur,
+    uint32_t a_max_len,
+    uint32_t a_prev_len,
+    uint32_t a_cand) {
+  uint32_t v_best_len = 0;
+  uint32_t v_ret_len = 0;
+  uint32_t v_limit = 0;
+  uint32_t v_chain = 0;
+  uint32_t v_c = 0;
+  uint32_t v_next = 0;
+  uint32_t v_n = 0;
+
+  v_best_len = wuffs_base__u32__max(a_prev_len, 2);
+  if (v_best_len >= a_max_len) {
+    return 0;
+  }
+  v_chain = self->private_impl.f_max_chain;
+  if (a_prev_len >= self->private_impl.f_good_len) {
+    v_chain >>= 2;
+  }
+  if (a_cur > 32768) {
+    v_limit = (a_cur - 32768);
+  }
+  v_c = a_cand;
+  while (v_chain > 0) {
+    if ((v_c >= a_cur) || (v_c < v_limit)) {
+      goto label__chain__break;
+    }
+    if ((self->private_data.f_window[(v_c + v_best_len)] == self->private_data.f_window[(a_cur + v_best_len)]) && (self->private_data.f_window[v_c] == self->private_data.f_window[a_cur])) {
+      v_n = 1;
+      while (v_n < a_max_len) {
+        if (self->private_data.f_window[(v_c + v_n)] != self->private_data.f_window[(a_cur + v_n)]) {
+          goto label__0__break;
+        }
+        v_n += 1;
+      }
+      label__0__break:;
+      if (v_n > v_best_len) {
+        v_best_len = v_n;
+        v_ret_len = v_n;
+        self->private_impl.f_match_dist = ((uint32_t)(a_cur - v_c));
+        if ((v_n >= self->private_impl.f_nice_len) || (v_n >= a_max_len)) {
+          goto label__chain__break;
+        }
+      }
+    }
+    v_next = ((uint32_t)(self->private_data.f_prev[(v_c & 32767)]));
+    if (v_next >= v_c) {
+      goto label__chain__break;
+    }
+    v_c = v_next;
+    wuffs_base__u32__sat_sub_indirect(&v_chain, 1);
+  }
+  label__chain__break:;
+  return v_ret_len;
+}
+
+// -------- func deflate.encoder.insert_hashes
+
+static wuffs_base__empty_struct
+wuffs_deflate__encoder__insert_hashes(
+    wuffs_deflate__encoder* self,
+    uint32_t a_lo,
+    uint32_t a_hi) {
+  uint32_t v_p = 0;
+  uint32_t v_end = 0;
+  uint32_t v_q = 0;
+  uint32_t v_h = 0;
+
+  if (self->private_impl.f_wi < 3) {
+    return wuffs_base__make_empty_struct();
+  }
+  v_end = wuffs_base__u32__min(a_hi, (self->private_impl.f_wi - 2));
+  v_p = a_lo;
+  while (v_p < v_end) {
+    v_q = v_p;
+    v_h = (wuffs_deflate__encoder__hash3(self, v_q) & 32767);
+    self->private_data.f_prev[(v_q & 32767)] = self->private_data.f_head[v_h];
+    self->private_data.f_head[v_h] = ((uint16_t)(v_q));
+    v_p += 1;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.add_literal
+
+static wuffs_base__empty_struct
+wuffs_deflate__encoder__add_literal(
+    wuffs_deflate__encoder* self,
+    uint8_t a_c) {
+  if (self->private_impl.f_n_syms < 16384) {
+    self->private_data.f_syms[self->private_impl.f_n_syms] = ((uint32_t)(a_c));
+    self->private_impl.f_n_syms += 1;
+    self->private_data.f_lfreqs[a_c] += 1;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.add_match
+
+static wuffs_base__empty_struct
+wuffs_deflate__encoder__add_match(
+    wuffs_deflate__encoder* self,
+    uint32_t a_len,
+    uint32_t a_dist) {
+  uint32_t v_l = 0;
+  uint32_t v_d = 0;
+
+  v_l = (((uint32_t)(a_len - 3)) & 255);
+  v_d = (((uint32_t)(a_dist - 1)) & 32767);
+  if (self->private_impl.f_n_syms < 16384) {
+    self->private_data.f_syms[self->private_impl.f_n_syms] = (2147483648 | (v_l << 16) | v_d);
+    self->private_impl.f_n_syms += 1;
+    self->private_data.f_lfreqs[(257 + ((uint32_t)(WUFFS_DEFLATE__LENGTH_CODES[v_l])))] += 1;
+    if (v_d < 256) {
+      self->private_data.f_dfreqs[WUFFS_DEFLATE__DISTANCE_CODES[v_d]] += 1;
+    } else {
+      self->private_data.f_dfreqs[WUFFS_DEFLATE__DISTANCE_CODES[(256 + (v_d >> 7))]] += 1;
+    }
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.resolve_pending
+
+static wuffs_base__empty_struct
+wuffs_deflate__encoder__resolve_pending(
+    wuffs_deflate__encoder* self) {
+  uint32_t v_len = 0;
+  uint32_t v_t = 0;
+
+  if ( ! self->private_impl.f_lazy_pending) {
+    return wuffs_base__make_empty_struct();
+  }
+  self->private_impl.f_lazy_pending = false;
+  v_len = self->private_impl.f_lazy_len;
+  self->private_impl.f_lazy_len = 0;
+  if (self->private_impl.f_ri <= 0) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (v_len >= 3) {
+    wuffs_deflate__encoder__add_match(self, v_len, self->private_impl.f_lazy_dist);
+    wuffs_deflate__encoder__insert_hashes(self, self->private_impl.f_ri, ((uint32_t)((self->private_impl.f_ri + v_len) - 1)));
+    v_t = ((uint32_t)((self->private_impl.f_ri + v_len) - 1));
+    self->private_impl.f_ri = wuffs_base__u32__min(v_t, self->private_impl.f_wi);
+  } else {
+    wuffs_deflate__encoder__add_literal(self, self->private_data.f_window[(((uint32_t)(self->private_impl.f_ri - 1)) & 65535)]);
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.emit_block
+
+static wuffs_base__empty_struct
+wuffs_deflate__encoder__emit_block(
+    wuffs_deflate__encoder* self,
+    bool a_final) {
+  uint32_t v_final_bit = 0;
+  uint32_t v_i = 0;
+  uint64_t v_extra_bits = 0;
+  uint64_t v_fixed_bits = 0;
+  uint64_t v_dynamic_bits = 0;
+  uint64_t v_stored_bits = 0;
+
+  if (a_final) {
+    v_final_bit = 1;
+  }
+  if (self->private_impl.f_store_only) {
+    wuffs_deflate__encoder__emit_stored(self, v_final_bit);
+    wuffs_deflate__encoder__reset_block(self);
+    return wuffs_base__make_empty_struct();
+  }
+  self->private_data.f_lfreqs[256] = 1;
+  v_i = 0;
+  while (v_i < 29) {
+    v_extra_bits += (((uint64_t)(self->private_data.f_lfreqs[(257 + v_i)])) * ((uint64_t)(WUFFS_DEFLATE__LENGTH_EXTRAS[v_i])));
+    v_i += 1;
+  }
+  v_i = 0;
+  while (v_i < 30) {
+    v_extra_bits += (((uint64_t)(self->private_data.f_dfreqs[v_i])) * ((uint64_t)(WUFFS_DEFLATE__DISTANCE_EXTRAS[v_i])));
+    v_i += 1;
+  }
+  v_fixed_bits = ((uint64_t)(3 + v_extra_bits));
+  v_i = 0;
+  while (v_i < 144) {
+    v_fixed_bits += (((uint64_t)(self->private_data.f_lfreqs[v_i])) * 8);
+    v_i += 1;
+  }
+  while (v_i < 256) {
+    v_fixed_bits += (((uint64_t)(self->private_data.f_lfreqs[v_i])) * 9);
+    v_i += 1;
+  }
+  while (v_i < 280) {
+    v_fixed_bits += (((uint64_t)(self->private_data.f_lfreqs[v_i])) * 7);
+    v_i += 1;
+  }
+  while (v_i < 288) {
+    v_fixed_bits += (((uint64_t)(self->private_data.f_lfreqs[v_i])) * 8);
+    v_i += 1;
+  }
+  v_i = 0;
+  while (v_i < 30) {
+    v_fixed_bits += (((uint64_t)(self->private_data.f_dfreqs[v_i])) * 5);
+    v_i += 1;
+  }
+  wuffs_deflate__encoder__build_dynamic_codes(self);
+  v_dynamic_bits = ((uint64_t)((17 + (3 * ((uint64_t)(self->private_impl.f_hclen)))) + v_extra_bits));
+  v_i = 0;
+  while (v_i < 19) {
+    v_dynamic_bits += (((uint64_t)(self->private_data.f_clfreqs[v_i])) * ((uint64_t)((self->private_data.f_cllens[v_i] & 15))));
+    v_i += 1;
+  }
+  v_dynamic_bits += ((((uint64_t)(self->private_data.f_clfreqs[16])) * 2) + (((uint64_t)(self->private_data.f_clfreqs[17])) * 3) + (((uint64_t)(self->private_data.f_clfreqs[18])) * 7));
+  v_i = 0;
+  while (v_i < 286) {
+    v_dynamic_bits += (((uint64_t)(self->private_data.f_lfreqs[v_i])) * ((uint64_t)((self->private_data.f_llens[v_i] & 15))));
+    v_i += 1;
+  }
+  v_i = 0;
+  while (v_i < 30) {
+    v_dynamic_bits += (((uint64_t)(self->private_data.f_dfreqs[v_i])) * ((uint64_t)((self->private_data.f_dlens[v_i] & 15))));
+    v_i += 1;
+  }
+  v_stored_bits = wuffs_deflate__encoder__stored_bits(self);
+  if ((v_stored_bits <= v_fixed_bits) && (v_stored_bits <= v_dynamic_bits)) {
+    wuffs_deflate__encoder__emit_stored(self, v_final_bit);
+  } else if (v_fixed_bits <= v_dynamic_bits) {
+    wuffs_deflate__encoder__build_fixed_codes(self);
+    wuffs_deflate__encoder__put_bits(self, (v_final_bit | 2), 3);
+    wuffs_deflate__encoder__emit_syms(self);
+  } else {
+    wuffs_deflate__encoder__put_bits(self, (v_final_bit | 4), 3);
+    wuffs_deflate__encoder__put_bits(self, ((((uint32_t)(self->private_impl.f_hlit - 257)) & 31) | ((((uint32_t)(self->private_impl.f_hdist - 1)) & 31) << 5) | ((((uint32_t)(self->private_impl.f_hclen - 4)) & 15) << 10)), 14);
+    v_i = 0;
+    while (v_i < self->private_impl.f_hclen) {
+      wuffs_deflate__encoder__put_bits(self, ((uint32_t)((self->private_data.f_cllens[WUFFS_DEFLATE__CODE_ORDER[v_i]] & 7))), 3);
+      v_i += 1;
+    }
+    wuffs_deflate__encoder__emit_rle(self);
+    wuffs_deflate__encoder__emit_syms(self);
+  }
+  wuffs_deflate__encoder__reset_block(self);
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.stored_bits
+
+static uint64_t
+wuffs_deflate__encoder__stored_bits(
+    const wuffs_deflate__encoder* self) {
+  uint64_t v_span = 0;
+  uint64_t v_pieces = 0;
+
+  if (self->private_impl.f_ri < self->private_impl.f_block_start) {
+    return 18446744073709551615u;
+  }
+  v_span = ((uint64_t)((self->private_impl.f_ri - self->private_impl.f_block_start)));
+  v_pieces = ((v_span + 65534) / 65535);
+  v_pieces = wuffs_base__u64__max(v_pieces, 1);
+  return ((3 + ((uint64_t)(((8 - (((uint32_t)(self->private_impl.f_n_bits + 3)) & 7)) & 7))) + 32) + ((v_pieces - 1) * 40) + (v_span * 8));
+}
+
+// -------- func deflate.encoder.emit_stored
+
+static wuffs_base__empty_struct
+wuffs_deflate__encoder__emit_stored(
+    wuffs_deflate__encoder* self,
+    uint32_t a_final_bit) {
+  uint32_t v_pos = 0;
+  uint32_t v_end = 0;
+  uint32_t v_piece = 0;
+  bool v_is_last = false;
+  wuffs_base__slice_u8 v_s = {0};
+  uint64_t v_n = 0;
+  uint32_t v_t = 0;
+
+  v_pos = self->private_impl.f_block_start;
+  v_end = self->private_impl.f_ri;
+  while (true) {
+    if (v_end < v_pos) {
+      self->private_impl.f_obuf_overflow = true;
+      return wuffs_base__make_empty_struct();
+    }
+    v_t = (v_end - v_pos);
+    v_piece = wuffs_base__u32__min(v_t, 65535);
+    v_is_last = (v_t <= 65535);
+    if (v_is_last) {
+      wuffs_deflate__encoder__put_bits(self, a_final_bit, 3);
+    } else {
+      wuffs_deflate__encoder__put_bits(self, 0, 3);
+    }
+    wuffs_deflate__encoder__put_bits(self, 0, ((8 - (self->private_impl.f_n_bits & 7)) & 7));
+    wuffs_deflate__encoder__put_bits(self, (v_piece | ((65535 ^ v_piece) << 16)), 32);
+    if (v_pos > v_end) {
+      self->private_impl.f_obuf_overflow = true;
+      return wuffs_base__make_empty_struct();
+    }
+    v_s = wuffs_base__slice_u8__subslice_ij(wuffs_base__make_slice_u8(self->private_data.f_window, 65800), v_pos, v_end);
+    v_s = wuffs_base__slice_u8__prefix(v_s, ((uint64_t)(v_piece)));
+    v_n = wuffs_base__slice_u8__copy_from_slice(wuffs_base__slice_u8__subslice_i(wuffs_base__make_slice_u8(self->private_data.f_obuf, 66560), self->private_impl.f_obuf_wi), v_s);
+    if (v_n < ((uint64_t)(v_piece))) {
+      self->private_impl.f_obuf_overflow = true;
+    }
+    v_t = ((uint32_t)(self->private_impl.f_obuf_wi + ((uint32_t)((v_n & 4294967295)))));
+    self->private_impl.f_obuf_wi = wuffs_base__u32__min(v_t, 66560);
+    v_t = (v_pos + v_piece);
+    v_pos = wuffs_base__u32__min(v_t, v_end);
+    if (v_is_last) {
+      goto label__0__break;
+    }
+  }
+  label__0__break:;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.put_bits
+
+static wuffs_base__empty_struct
+wuffs_deflate__encoder__put_bits(
+    wuffs_deflate__encoder* self,
+    uint32_t a_b,
+    uint32_t a_n) {
+  uint32_t v_owi = 0;
+
+  self->private_impl.f_bits |= ((uint64_t)(((uint64_t)(a_b)) << (self->private_impl.f_n_bits & 63)));
+  self->private_impl.f_n_bits = ((self->private_impl.f_n_bits & 7) + a_n);
+  v_owi = self->private_impl.f_obuf_wi;
+  while (self->private_impl.f_n_bits >= 8) {
+    if (v_owi < 66560) {
+      self->private_data.f_obuf[v_owi] = ((uint8_t)((self->private_impl.f_bits & 255)));
+      v_owi += 1;
+    } else {
+      self->private_impl.f_obuf_overflow = true;
+    }
+    self->private_impl.f_bits >>= 8;
+    self->private_impl.f_n_bits -= 8;
+  }
+  self->private_impl.f_obuf_wi = v_owi;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.emit_rle
+
+static wuffs_base__empty_struct
+wuffs_deflate__encoder__emit_rle(
+    wuffs_deflate__encoder* self) {
+  uint32_t v_i = 0;
+  uint32_t v_e = 0;
+  uint32_t v_s = 0;
+
+  while (v_i < self->private_impl.f_n_rle) {
+    v_e = ((uint32_t)(self->private_data.f_rle[v_i]));
+    v_s = (v_e & 31);
+    wuffs_deflate__encoder__put_bits(self, ((uint32_t)(self->private_data.f_codes[2][v_s])), ((uint32_t)((self->private_data.f_cllens[v_s] & 15))));
+    if (v_s == 16) {
+      wuffs_deflate__encoder__put_bits(self, (v_e >> 5), 2);
+    } else if (v_s == 17) {
+      wuffs_deflate__encoder__put_bits(self, (v_e >> 5), 3);
+    } else if (v_s == 18) {
+      wuffs_deflate__encoder__put_bits(self, (v_e >> 5), 7);
+    }
+    v_i += 1;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.emit_syms
+
+static wuffs_base__empty_struct
+wuffs_deflate__encoder__emit_syms(
+    wuffs_deflate__encoder* self) {
+  uint64_t v_bits = 0;
+  uint32_t v_n_bits = 0;
+  uint32_t v_owi = 0;
+  uint32_t v_i = 0;
+  uint32_t v_s = 0;
+  uint32_t v_c = 0;
+  uint32_t v_lc = 0;
+  uint32_t v_d = 0;
+  uint32_t v_dc = 0;
+
+  v_bits = self->private_impl.f_bits;
+  v_n_bits = (self->private_impl.f_n_bits & 7);
+  v_owi = self->private_impl.f_obuf_wi;
+  while (v_i < self->private_impl.f_n_syms) {
+    v_s = self->private_data.f_syms[(v_i & 16383)];
+    if ((v_s >> 31) == 0) {
+      v_c = (v_s & 255);
+      v_bits |= ((uint64_t)(((uint64_t)(self->private_data.f_codes[0][v_c])) << (v_n_bits & 63)));
+      v_n_bits = ((v_n_bits & 63) + ((uint32_t)((self->private_data.f_llens[v_c] & 15))));
+    } else {
+      v_c = ((v_s >> 16) & 255);
+      v_lc = ((uint32_t)(WUFFS_DEFLATE__LENGTH_CODES[v_c]));
+      v_bits |= ((uint64_t)(((uint64_t)(self->private_data.f_codes[0][(257 + v_lc)])) << (v_n_bits & 63)));
+      v_n_bits = ((v_n_bits & 63) + ((uint32_t)((self->private_data.f_llens[(257 + v_lc)] & 15))));
+      v_bits |= ((uint64_t)(((uint64_t)(((uint32_t)(v_c - WUFFS_DEFLATE__LENGTH_BASES[v_lc])))) << (v_n_bits & 63)));
+      v_n_bits = ((v_n_bits & 63) + WUFFS_DEFLATE__LENGTH_EXTRAS[v_lc]);
+      v_d = (v_s & 32767);
+      if (v_d < 256) {
+        v_dc = ((uint32_t)(WUFFS_DEFLATE__DISTANCE_CODES[v_d]));
+      } else {
+        v_dc = ((uint32_t)(WUFFS_DEFLATE__DISTANCE_CODES[(256 + (v_d >> 7))]));
+      }
+      v_bits |= ((uint64_t)(((uint64_t)(self->private_data.f_codes[1][v_dc])) << (v_n_bits & 63)));
+      v_n_bits = ((v_n_bits & 63) + ((uint32_t)((self->private_data.f_dlens[v_dc] & 15))));
+      v_bits |= ((uint64_t)(((uint64_t)(((uint32_t)(v_d - WUFFS_DEFLATE__DISTANCE_BASES[v_dc])))) << (v_n_bits & 63)));
+      v_n_bits = ((v_n_bits & 63) + WUFFS_DEFLATE__DISTANCE_EXTRAS[v_dc]);
+    }
+    while (v_n_bits >= 8) {
+      if (v_owi < 66560) {
+        self->private_data.f_obuf[v_owi] = ((uint8_t)((v_bits & 255)));
+        v_owi += 1;
+      } else {
+        self->private_impl.f_obuf_overflow = true;
+      }
+      v_bits >>= 8;
+      v_n_bits -= 8;
+    }
+    v_i += 1;
+  }
+  self->private_impl.f_bits = v_bits;
+  self->private_impl.f_n_bits = v_n_bits;
+  self->private_impl.f_obuf_wi = v_owi;
+  wuffs_deflate__encoder__put_bits(self, ((uint32_t)(self->private_data.f_codes[0][256])), ((uint32_t)((self->private_data.f_llens[256] & 15))));
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.build_fixed_codes
+
+static wuffs_base__empty_struct
+wuffs_deflate__encoder__build_fixed_codes(
+    wuffs_deflate__encoder* self) {
+  uint32_t v_i = 0;
+
+  while (v_i < 144) {
+    self->private_data.f_hlens[v_i] = 8;
+    v_i += 1;
+  }
+  while (v_i < 256) {
+    self->private_data.f_hlens[v_i] = 9;
+    v_i += 1;
+  }
+  while (v_i < 280) {
+    self->private_data.f_hlens[v_i] = 7;
+    v_i += 1;
+  }
+  while (v_i < 288) {
+    self->private_data.f_hlens[v_i] = 8;
+    v_i += 1;
+  }
+  wuffs_deflate__encoder__build_codes(self, 0, 288);
+  wuffs_base__slice_u8__copy_from_slice(wuffs_base__make_slice_u8(self->private_data.f_llens, 288), wuffs_base__make_slice_u8(self->private_data.f_hlens, 288));
+  v_i = 0;
+  while (v_i < 32) {
+    self->private_data.f_hlens[v_i] = 5;
+    v_i += 1;
+  }
+  wuffs_deflate__encoder__build_codes(self, 1, 32);
+  wuffs_base__slice_u8__copy_from_slice(wuffs_base__make_slice_u8(self->private_data.f_dlens, 32), wuffs_base__make_slice_u8(self->private_data.f_hlens, 32));
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.build_dynamic_codes
+
+static wuffs_base__empty_struct
+wuffs_deflate__encoder__build_dynamic_codes(
+    wuffs_deflate__encoder* self) {
+  uint32_t v_i = 0;
+
+  v_i = 0;
+  while (v_i < 288) {
+    self->private_data.f_hfreqs[v_i] = self->private_data.f_lfreqs[v_i];
+    v_i += 1;
+  }
+  wuffs_deflate__encoder__build_lengths(self, 286, 15);
+  wuffs_deflate__encoder__build_codes(self, 0, 286);
+  wuffs_base__slice_u8__copy_from_slice(wuffs_base__make_slice_u8(self->private_data.f_llens, 288), wuffs_base__make_slice_u8(self->private_data.f_hlens, 288));
+  self->private_impl.f_hlit = 286;
+  while (self->private_impl.f_hlit > 257) {
+    if (self->private_data.f_llens[(self->private_impl.f_hlit - 1)] != 0) {
+      goto label__0__break;
+    }
+    self->private_impl.f_hlit -= 1;
+  }
+  label__0__break:;
+  v_i = 0;
+  while (v_i < 32) {
+    self->private_data.f_hfreqs[v_i] = self->private_data.f_dfreqs[v_i];
+    v_i += 1;
+  }
+  wuffs_deflate__encoder__build_lengths(self, 30, 15);
+  wuffs_deflate__encoder__build_codes(self, 1, 30);
+  wuffs_base__slice_u8__copy_from_slice(wuffs_base__make_slice_u8(self->private_data.f_dlens, 32), wuffs_base__make_slice_u8(self->private_data.f_hlens, 32));
+  self->private_impl.f_hdist = 30;
+  while (self->private_impl.f_hdist > 1) {
+    if (self->private_data.f_dlens[(self->private_impl.f_hdist - 1)] != 0) {
+      goto label__1__break;
+    }
+    self->private_impl.f_hdist -= 1;
+  }
+  label__1__break:;
+  wuffs_deflate__encoder__build_rle(self, self->private_impl.f_hlit, self->private_impl.f_hdist);
+  v_i = 0;
+  while (v_i < 19) {
+    self->private_data.f_hfreqs[v_i] = self->private_data.f_clfreqs[v_i];
+    v_i += 1;
+  }
+  wuffs_deflate__encoder__build_lengths(self, 19, 7);
+  wuffs_deflate__encoder__build_codes(self, 2, 19);
+  wuffs_base__slice_u8__copy_from_slice(wuffs_base__make_slice_u8(self->private_data.f_cllens, 19), wuffs_base__make_slice_u8(self->private_data.f_hlens, 19));
+  self->private_impl.f_hclen = 19;
+  while (self->private_impl.f_hclen > 4) {
+    if (self->private_data.f_cllens[WUFFS_DEFLATE__CODE_ORDER[(self->private_impl.f_hclen - 1)]] != 0) {
+      goto label__2__break;
+    }
+    self->private_impl.f_hclen -= 1;
+  }
+  label__2__break:;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.build_rle
+
+static wuffs_base__empty_struct
+wuffs_deflate__encoder__build_rle(
+    wuffs_deflate__encoder* self,
+    uint32_t a_hlit,
+    uint32_t a_hdist) {
+  uint8_t v_all[512] = {0};
+  uint32_t v_n = 0;
+  uint32_t v_i = 0;
+  uint32_t v_l = 0;
+  uint32_t v_run = 0;
+  uint32_t v_k = 0;
+  uint32_t v_m = 0;
+
+  wuffs_base__slice_u8__copy_from_slice(wuffs_base__slice_u8__subslice_j(wuffs_base__make_slice_u8(v_all, 512), a_hlit), wuffs_base__slice_u8__subslice_j(wuffs_base__make_slice_u8(self->private_data.f_llens, 288), a_hlit));
+  wuffs_base__slice_u8__copy_from_slice(wuffs_base__slice_u8__subslice_i(wuffs_base__make_slice_u8(v_all, 512), a_hlit), wuffs_base__slice_u8__subslice_j(wuffs_base__make_slice_u8(self->private_data.f_dlens, 32), a_hdist));
+  v_n = (a_hlit + a_hdist);
+  self->private_impl.f_n_rle = 0;
+  v_i = 0;
+  while (v_i < 32) {
+    self->private_data.f_clfreqs[v_i] = 0;
+    v_i += 1;
+  }
+  v_i = 0;
+  while (v_i < v_n) {
+    v_l = ((uint32_t)((v_all[(v_i & 511)] & 15)));
+    v_run = 1;
+    while ((((uint32_t)(v_i + v_run)) < v_n) && (((uint32_t)((v_all[(((uint32_t)(v_i + v_run)) & 511)] & 15))) == v_l)) {
+      v_run += 1;
+    }
+    v_i += v_run;
+    v_k = v_run;
+    if (v_l == 0) {
+      while (v_k >= 11) {
+        v_m = wuffs_base__u32__min(v_k, 138);
+        wuffs_deflate__encoder__add_rle(self, 18, (v_m - 11));
+        v_k -= v_m;
+      }
+      if (v_k >= 3) {
+        wuffs_deflate__encoder__add_rle(self, 17, ((v_k - 3) & 7));
+        v_k = 0;
+      }
+    } else {
+      wuffs_deflate__encoder__add_rle(self, v_l, 0);
+      v_k -= 1;
+      while (v_k >= 3) {
+        v_m = wuffs_base__u32__min(v_k, 6);
+        wuffs_deflate__encoder__add_rle(self, 16, (v_m - 3));
+        v_k -= v_m;
+      }
+    }
+    while (v_k > 0) {
+      wuffs_deflate__encoder__add_rle(self, v_l, 0);
+      v_k -= 1;
+    }
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.add_rle
+
+static wuffs_base__empty_struct
+wuffs_deflate__encoder__add_rle(
+    wuffs_deflate__encoder* self,
+    uint32_t a_s,
+    uint32_t a_extra) {
+  if (self->private_impl.f_n_rle < 320) {
+    self->private_data.f_rle[self->private_impl.f_n_rle] = ((uint16_t)(((a_s | (a_extra << 5)) & 65535)));
+    self->private_impl.f_n_rle += 1;
+    self->private_data.f_clfreqs[a_s] += 1;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.build_lengths
+
+static wuffs_base__empty_struct
+wuffs_deflate__encoder__build_lengths(
+    wuffs_deflate__encoder* self,
+    uint32_t a_n,
+    uint32_t a_limit) {
+  uint32_t v_num_codes[32] = {0};
+  uint32_t v_n_used = 0;
+  uint32_t v_i = 0;
+  uint32_t v_j = 0;
+  uint32_t v_key = 0;
+  uint32_t v_sym = 0;
+  uint32_t v_root = 0;
+  uint32_t v_leaf = 0;
+  uint32_t v_next = 0;
+  uint32_t v_avbl = 0;
+  uint32_t v_used = 0;
+  uint32_t v_dpth = 0;
+  uint32_t v_total = 0;
+  uint32_t v_k = 0;
+
+  v_i = 0;
+  while (v_i < 288) {
+    self->private_data.f_hlens[v_i] = 0;
+    v_i += 1;
+  }
+  v_i = 0;
+  while (v_i < a_n) {
+    v_key = self->private_data.f_hfreqs[v_i];
+    if ((v_key > 0) && (v_n_used < 288)) {
+      v_j = v_n_used;
+      while (v_j > 0) {
+        if (self->private_data.f_hsort_keys[(v_j - 1)] <= v_key) {
+          goto label__0__break;
+        }
+        self->private_data.f_hsort_keys[v_j] = self->private_data.f_hsort_keys[(v_j - 1)];
+        self->private_data.f_hsort_syms[v_j] = self->private_data.f_hsort_syms[(v_j - 1)];
+        v_j -= 1;
+      }
+      label__0__break:;
+      self->private_data.f_hsort_keys[v_j] = v_key;
+      self->private_data.f_hsort_syms[v_j] = ((uint16_t)((v_i & 65535)));
+      if (v_n_used < 288) {
+        v_n_used += 1;
+      }
+    }
+    v_i += 1;
+  }
+  if (v_n_used < 2) {
+    v_i = 0;
+    if (v_n_used == 1) {
+      v_i = ((uint32_t)(self->private_data.f_hsort_syms[0]));
+      if (v_i < 288) {
+        self->private_data.f_hlens[v_i] = 1;
+      }
+    }
+    if (v_i == 0) {
+      self->private_data.f_hlens[1] = 1;
+    } else {
+      self->private_data.f_hlens[0] = 1;
+    }
+    if (v_n_used == 0) {
+      self->private_data.f_hlens[0] = 1;
+    }
+    return wuffs_base__make_empty_struct();
+  }
+  self->private_data.f_hsort_keys[0] += self->private_data.f_hsort_keys[1];
+  v_root = 0;
+  v_leaf = 2;
+  v_next = 1;
+  while (v_next < (v_n_used - 1)) {
+    if ((v_leaf >= v_n_used) || (self->private_data.f_hsort_keys[(v_root & 511)] < self->private_data.f_hsort_keys[(v_leaf & 511)])) {
+      self->private_data.f_hsort_keys[(v_next & 511)] = self->private_data.f_hsort_keys[(v_root & 511)];
+      self->private_data.f_hsort_keys[(v_root & 511)] = v_next;
+      v_root += 1;
+    } else {
+      self->private_data.f_hsort_keys[(v_next & 511)] = self->private_data.f_hsort_keys[(v_leaf & 511)];
+      v_leaf += 1;
+    }
+    if ((v_leaf >= v_n_used) || ((v_root < v_next) && (self->private_data.f_hsort_keys[(v_root & 511)] < self->private_data.f_hsort_keys[(v_leaf & 511)]))) {
+      self->private_data.f_hsort_keys[(v_next & 511)] += self->private_data.f_hsort_keys[(v_root & 511)];
+      self->private_data.f_hsort_keys[(v_root & 511)] = v_next;
+      v_root += 1;
+    } else {
+      self->private_data.f_hsort_keys[(v_next & 511)] += self->private_data.f_hsort_keys[(v_leaf & 511)];
+      v_leaf += 1;
+    }
+    v_next += 1;
+  }
+  self->private_data.f_hsort_keys[(((uint32_t)(v_n_used - 2)) & 511)] = 0;
+  v_k = ((uint32_t)(v_n_used - 2));
+  while (v_k > 0) {
+    v_k -= 1;
+    self->private_data.f_hsort_keys[(v_k & 511)] = ((uint32_t)(self->private_data.f_hsort_keys[(self->private_data.f_hsort_keys[(v_k & 511)] & 511)] + 1));
+  }
+  v_avbl = 1;
+  v_used = 0;
+  v_dpth = 0;
+  v_root = ((uint32_t)(v_n_used - 1));
+  v_next = v_n_used;
+  while (v_avbl > 0) {
+    while ((v_root > 0) && (self->private_data.f_hsort_keys[(((uint32_t)(v_root - 1)) & 511)] == v_dpth)) {
+      v_used += 1;
+      v_root -= 1;
+    }
+    while ((v_avbl > v_used) && (v_next > 0)) {
+      v_next -= 1;
+      self->private_data.f_hsort_keys[(v_next & 511)] = v_dpth;
+      v_avbl -= 1;
+    }
+    v_avbl = ((uint32_t)(v_used * 2));
+    v_dpth += 1;
+    v_used = 0;
+  }
+  v_i = 0;
+  while (v_i < v_n_used) {
+    v_num_codes[wuffs_base__u32__min(self->private_data.f_hsort_keys[v_i], 31)] += 1;
+    v_i += 1;
+  }
+  if (a_limit < 1) {
+    return wuffs_base__make_empty_struct();
+  }
+  v_i = (a_limit + 1);
+  while (v_i < 32) {
+    v_num_codes[a_limit] += v_num_codes[v_i];
+    v_num_codes[v_i] = 0;
+    v_i += 1;
+  }
+  v_i = 1;
+  while (v_i <= a_limit) {
+    v_total += ((uint32_t)(v_num_codes[v_i] << (((uint32_t)(a_limit - v_i)) & 31)));
+    v_i += 1;
+  }
+  while (v_total > (((uint32_t)(1)) << a_limit)) {
+    v_num_codes[a_limit] -= 1;
+    v_i = ((uint32_t)(a_limit - 1));
+    while (v_i > 0) {
+      if (v_num_codes[(v_i & 31)] != 0) {
+        v_num_codes[(v_i & 31)] -= 1;
+        v_num_codes[(((uint32_t)(v_i + 1)) & 31)] += 2;
+        goto label__1__break;
+      }
+      v_i -= 1;
+    }
+    label__1__break:;
+    v_total -= 1;
+  }
+  v_k = v_n_used;
+  v_i = 1;
+  while (v_i <= a_limit) {
+    v_used = v_num_codes[v_i];
+    while ((v_used > 0) && (v_k > 0)) {
+      v_k -= 1;
+      v_sym = ((uint32_t)(self->private_data.f_hsort_syms[(v_k & 511)]));
+      if (v_sym < 288) {
+        self->private_data.f_hlens[v_sym] = ((uint8_t)((v_i & 255)));
+      }
+      v_used -= 1;
+    }
+    v_i += 1;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.build_codes
+
+static wuffs_base__empty_struct
+wuffs_deflate__encoder__build_codes(
+    wuffs_deflate__encoder* self,
+    uint32_t a_which,
+    uint32_t a_n) {
+  uint32_t v_counts[16] = {0};
+  uint32_t v_next_code[16] = {0};
+  uint32_t v_i = 0;
+  uint32_t v_l = 0;
+  uint32_t v_code = 0;
+
+  v_i = 0;
+  while (v_i < a_n) {
+    v_counts[(self->private_data.f_hlens[v_i] & 15)] += 1;
+    v_i += 1;
+  }
+  v_counts[0] = 0;
+  v_i = 0;
+  while (v_i < 15) {
+    v_code = ((uint32_t)(((uint32_t)(v_code + v_counts[v_i])) << 1));
+    v_next_code[(v_i + 1)] = v_code;
+    v_i += 1;
+  }
+  v_i = 0;
+  while (v_i < a_n) {
+    self->private_data.f_codes[a_which][v_i] = 0;
+    v_i += 1;
+  }
+  v_i = 0;
+  while (v_i < a_n) {
+    v_l = ((uint32_t)((self->private_data.f_hlens[v_i] & 15)));
+    if (v_l > 0) {
+      v_code = v_next_code[v_l];
+      v_next_code[v_l] = ((uint32_t)(v_code + 1));
+      v_code = ((((uint32_t)(WUFFS_DEFLATE__REVERSE8[(v_code & 255)])) << 8) | ((uint32_t)(WUFFS_DEFLATE__REVERSE8[((v_code >> 8) & 255)])));
+      self->private_data.f_codes[a_which][v_i] = ((uint16_t)(((v_code >> (16 - v_l)) & 65535)));
+    }
+    v_i += 1;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__DEFLATE)
+
+
+#endif  // WUFFS_IMPLEMENTATION
+
+// ¡ WUFFS MONOLITHIC RELEASE DISCARDS EVERYTHING BELOW.
+
+#endif  // WUFFS_INCLUDE_GUARD__DEFLATE
@@ -0,0 +1,4337 @@
+#ifndef WUFFS_INCLUDE_GUARD__GIF
+#define WUFFS_INCLUDE_GUARD__GIF
+
+#if defined(WUFFS_IMPLEMENTATION) && !defined(WUFFS_CONFIG__MODULES)
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__GIF
+#endif
+
+#include "./wuffs-base.c"
+#include "./wuffs-std-lzw.c"
+
+// ¡ WUFFS MONOLITHIC RELEASE DISCARDS EVERYTHING ABOVE.
+
+
+// ---------------- Status Codes
+
+extern const char wuffs_gif__error__bad_extension_label[];
+extern const char wuffs_gif__error__bad_frame_size[];
+extern const char wuffs_gif__error__bad_graphic_control[];
+extern const char wuffs_gif__error__bad_header[];
+extern const char wuffs_gif__error__bad_literal_width[];
+extern const char wuffs_gif__error__bad_palette[];
+
+// ---------------- Public Consts
+
+#define WUFFS_GIF__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE 0
+
+#define WUFFS_GIF__QUIRK_DELAY_NUM_DECODED_FRAMES 1041635328
+
+#define WUFFS_GIF__QUIRK_FIRST_FRAME_LOCAL_PALETTE_MEANS_BLACK_BACKGROUND 1041635329
+
+#define WUFFS_GIF__QUIRK_HONOR_BACKGROUND_COLOR 1041635330
+
+#define WUFFS_GIF__QUIRK_IGNORE_TOO_MUCH_PIXEL_DATA 1041635331
+
+#define WUFFS_GIF__QUIRK_IMAGE_BOUNDS_ARE_STRICT 1041635332
+
+#define WUFFS_GIF__QUIRK_REJECT_EMPTY_FRAME 1041635333
+
+#define WUFFS_GIF__QUIRK_REJECT_EMPTY_PALETTE 1041635334
+
+// ---------------- Struct Declarations
+
+typedef struct wuffs_gif__decoder__struct wuffs_gif__decoder;
+
+typedef struct wuffs_gif__encoder__struct wuffs_gif__encoder;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ---------------- Public Initializer Prototypes
+
+// For any given "wuffs_foo__bar* self", "wuffs_foo__bar__initialize(self,
+// etc)" should be called before any other "wuffs_foo__bar__xxx(self, etc)".
+//
+// Pass sizeof(*self) and WUFFS_VERSION for sizeof_star_self and wuffs_version.
+// Pass 0 (or some combination of WUFFS_INITIALIZE__XXX) for options.
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+wuffs_gif__decoder__initialize(
+    wuffs_gif__decoder* self,
+    size_t sizeof_star_self,
+    uint64_t wuffs_version,
+    uint32_t options);
+
+wuffs_base__stats
+wuffs_gif__decoder__stats(
+    const wuffs_gif__decoder* self);
+
+size_t
+sizeof__wuffs_gif__decoder();
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+wuffs_gif__encoder__initialize(
+    wuffs_gif__encoder* self,
+    size_t sizeof_star_self,
+    uint64_t wuffs_version,
+    uint32_t options);
+
+wuffs_base__stats
+wuffs_gif__encoder__stats(
+    const wuffs_gif__encoder* self);
+
+size_t
+sizeof__wuffs_gif__encoder();
+
+// ---------------- Allocs
+
+// These functions allocate and initialize Wuffs structs. They return NULL if
+// memory allocation fails. If they return non-NULL, there is no need to call
+// wuffs_foo__bar__initialize, but the caller is responsible for eventually
+// calling free on the returned pointer. That pointer is effectively a C++
+// std::unique_ptr<T, decltype(&free)>.
+
+wuffs_gif__decoder*
+wuffs_gif__decoder__alloc();
+
+static inline wuffs_base__image_decoder*
+wuffs_gif__decoder__alloc_as__wuffs_base__image_decoder() {
+  return (wuffs_base__image_decoder*)(wuffs_gif__decoder__alloc());
+}
+
+wuffs_gif__encoder*
+wuffs_gif__encoder__alloc();
+
+// ---------------- Upcasts
+
+static inline wuffs_base__image_decoder*
+wuffs_gif__decoder__upcast_as__wuffs_base__image_decoder(
+    wuffs_gif__decoder* p) {
+  return (wuffs_base__image_decoder*)p;
+}
+
+// ---------------- Public Function Prototypes
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_gif__decoder__set_quirk_enabled(
+    wuffs_gif__decoder* self,
+    uint32_t a_quirk,
+    bool a_enabled);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_gif__decoder__decode_image_config(
+    wuffs_gif__decoder* self,
+    wuffs_base__image_config* a_dst,
+    wuffs_base__io_buffer* a_src);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_gif__decoder__set_report_metadata(
+    wuffs_gif__decoder* self,
+    uint32_t a_fourcc,
+    bool a_report);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_gif__decoder__tell_me_more(
+    wuffs_gif__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__more_information* a_minfo,
+    wuffs_base__io_buffer* a_src);
+
+WUFFS_BASE__MAYBE_STATIC uint32_t
+wuffs_gif__decoder__num_animation_loops(
+    const wuffs_gif__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC uint64_t
+wuffs_gif__decoder__num_decoded_frame_configs(
+    const wuffs_gif__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC uint64_t
+wuffs_gif__decoder__num_decoded_frames(
+    const wuffs_gif__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC bool
+wuffs_gif__decoder__can_decode_row_bands(
+    const wuffs_gif__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__rect_ie_u32
+wuffs_gif__decoder__frame_dirty_rect(
+    const wuffs_gif__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64
+wuffs_gif__decoder__workbuf_len(
+    const wuffs_gif__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_gif__decoder__restart_frame(
+    wuffs_gif__decoder* self,
+    uint64_t a_index,
+    uint64_t a_io_position);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_gif__decoder__decode_frame_config(
+    wuffs_gif__decoder* self,
+    wuffs_base__frame_config* a_dst,
+    wuffs_base__io_buffer* a_src);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_gif__decoder__decode_frame(
+    wuffs_gif__decoder* self,
+    wuffs_base__pixel_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__pixel_blend a_blend,
+    wuffs_base__slice_u8 a_workbuf,
+    wuffs_base__decode_frame_options* a_opts);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_gif__encoder__set_canvas(
+    wuffs_gif__encoder* self,
+    uint32_t a_width,
+    uint32_t a_height);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_gif__encoder__set_loop_count(
+    wuffs_gif__encoder* self,
+    uint32_t a_n);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_gif__encoder__set_frame(
+    wuffs_gif__encoder* self,
+    uint32_t a_left,
+    uint32_t a_top,
+    uint64_t a_duration,
+    uint8_t a_disposal);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_gif__encoder__encode_frame(
+    wuffs_gif__encoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__pixel_buffer* a_src);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_gif__encoder__encode_trailer(
+    wuffs_gif__encoder* self,
+    wuffs_base__io_buffer* a_dst);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+// ---------------- Struct Definitions
+
+// These structs' fields, and the sizeof them, are private implementation
+// details that aren't guaranteed to be stable across Wuffs versions.
+//
+// See https://en.wikipedia.org/wiki/Opaque_pointer#C
+
+#if defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
+
+struct wuffs_gif__decoder__struct {
+  // Do not access the private_impl's or private_data's fields directly. There
+  // is no API/ABI compatibility or safety guarantee if you do so. Instead, use
+  // the wuffs_foo__bar__baz functions.
+  //
+  // It is a struct, not a struct*, so that the outermost wuffs_foo__bar struct
+  // can be stack allocated when WUFFS_IMPLEMENTATION is defined.
+
+  struct {
+    uint32_t magic;
+    uint32_t active_coroutine;
+    wuffs_base__vtable vtable_for__wuffs_base__image_decoder;
+    wuffs_base__vtable null_vtable;
+#if defined(WUFFS_CONFIG__STATS)
+    wuffs_base__stats stats;
+#endif  // defined(WUFFS_CONFIG__STATS)
+
+    uint32_t f_width;
+    uint32_t f_height;
+    uint8_t f_call_sequence;
+    bool f_ignore_metadata;
+    bool f_report_metadata_iccp;
+    bool f_report_metadata_xmp;
+    uint32_t f_metadata_fourcc;
+    uint64_t f_metadata_io_position;
+    bool f_quirks[7];
+    bool f_delayed_num_decoded_frames;
+    bool f_end_of_data;
+    bool f_restarted;
+    bool f_previous_lzw_decode_ended_abruptly;
+    bool f_has_global_palette;
+    uint8_t f_interlace;
+    bool f_seen_num_animation_loops_value;
+    uint32_t f_num_animation_loops_value;
+    uint32_t f_background_color_u32_argb_premul;
+    uint32_t f_black_color_u32_argb_premul;
+    bool f_gc_has_transparent_index;
+    uint8_t f_gc_transparent_index;
+    uint8_t f_gc_disposal;
+    uint64_t f_gc_duration;
+    uint64_t f_frame_config_io_position;
+    uint64_t f_num_decoded_frame_configs_value;
+    uint64_t f_num_decoded_frames_value;
+    uint32_t f_frame_rect_x0;
+    uint32_t f_frame_rect_y0;
+    uint32_t f_frame_rect_x1;
+    uint32_t f_frame_rect_y1;
+    uint32_t f_dst_x;
+    uint32_t f_dst_y;
+    uint32_t f_dirty_max_excl_y;
+    uint32_t f_roi_x0;
+    uint32_t f_roi_y0;
+    uint32_t f_roi_x1;
+    uint32_t f_roi_y1;
+    uint32_t f_downscale_shift;
+    uint64_t f_downscale_workbuf_length;
+    uint32_t f_downscale_num_rows;
+    uint64_t f_compressed_ri;
+    uint64_t f_compressed_wi;
+    wuffs_base__pixel_swizzler f_swizzler;
+
+    uint32_t p_decode_image_config[1];
+    uint32_t p_tell_me_more[1];
+    uint32_t p_decode_frame_config[1];
+    uint32_t p_skip_frame[1];
+    uint32_t p_decode_frame[1];
+    uint32_t p_decode_up_to_id_part1[1];
+    uint32_t p_decode_header[1];
+    uint32_t p_decode_lsd[1];
+    uint32_t p_decode_extension[1];
+    uint32_t p_skip_blocks[1];
+    uint32_t p_decode_ae[1];
+    uint32_t p_decode_gc[1];
+    uint32_t p_decode_id_part0[1];
+    uint32_t p_decode_id_part1[1];
+    uint32_t p_decode_id_part2[1];
+  } private_impl;
+
+  struct {
+    uint8_t f_compressed[4096];
+    uint8_t f_palettes[2][1024];
+    uint8_t f_dst_palette[1024];
+    wuffs_lzw__decoder f_lzw;
+
+    struct {
+      uint32_t v_background_color;
+    } s_decode_frame_config[1];
+    struct {
+      uint64_t scratch;
+    } s_skip_frame[1];
+    struct {
+      uint32_t v_i;
+      uint8_t v_c[6];
+    } s_decode_header[1];
+    struct {
+      uint64_t scratch;
+      uint32_t v_num_palette_entries;
+      uint32_t v_i;
+      uint8_t v_flags;
+      uint8_t v_background_color_index;
+    } s_decode_lsd[1];
+    struct {
+      uint64_t scratch;
+    } s_skip_blocks[1];
+    struct {
+      uint64_t scratch;
+      uint8_t v_block_size;
+      bool v_is_animexts;
+      bool v_is_netscape;
+      bool v_is_iccp;
+      bool v_is_xmp;
+    } s_decode_ae[1];
+    struct {
+      uint64_t scratch;
+    } s_decode_gc[1];
+    struct {
+      uint64_t scratch;
+    } s_decode_id_part0[1];
+    struct {
+      uint64_t scratch;
+      uint32_t v_num_palette_entries;
+      uint32_t v_i;
+      uint8_t v_which_palette;
+    } s_decode_id_part1[1];
+    struct {
+      uint64_t scratch;
+      uint64_t v_block_size;
+      wuffs_base__status v_lzw_status;
+      bool v_need_block_size;
+    } s_decode_id_part2[1];
+  } private_data;
+
+#ifdef __cplusplus
+#if defined(WUFFS_BASE__HAVE_UNIQUE_PTR)
+  using unique_ptr = std::unique_ptr<wuffs_gif__decoder, decltype(&free)>;
+
+  // On failure, the alloc_etc functions return nullptr. They don't throw.
+
+  static inline unique_ptr
+  alloc() {
+    return unique_ptr(wuffs_gif__decoder__alloc(), &free);
+  }
+
+  static inline wuffs_base__image_decoder::unique_ptr
+  alloc_as__wuffs_base__image_decoder() {
+    return wuffs_base__image_decoder::unique_ptr(
+        wuffs_gif__decoder__alloc_as__wuffs_base__image_decoder(), &free);
+  }
+#endif  // defined(WUFFS_BASE__HAVE_UNIQUE_PTR)
+
+#if defined(WUFFS_BASE__HAVE_EQ_DELETE) && !defined(WUFFS_IMPLEMENTATION)
+  // Disallow constructing or copying an object via standard C++ mechanisms,
+  // e.g. the "new" operator, as this struct is intentionally opaque. Its total
+  // size and field layout is not part of the public, stable, memory-safe API.
+  // Use malloc or memcpy and the sizeof__wuffs_foo__bar function instead, and
+  // call wuffs_foo__bar__baz methods (which all take a "this"-like pointer as
+  // their first argument) rather than tweaking bar.private_impl.qux fields.
+  //
+  // In C, we can just leave wuffs_foo__bar as an incomplete type (unless
+  // WUFFS_IMPLEMENTATION is #define'd). In C++, we define a complete type in
+  // order to provide convenience methods. These forward on "this", so that you
+  // can write "bar->baz(etc)" instead of "wuffs_foo__bar__baz(bar, etc)".
+  wuffs_gif__decoder__struct() = delete;
+  wuffs_gif__decoder__struct(const wuffs_gif__decoder__struct&) = delete;
+  wuffs_gif__decoder__struct& operator=(
+      const wuffs_gif__decoder__struct&) = delete;
+#endif  // defined(WUFFS_BASE__HAVE_EQ_DELETE) && !defined(WUFFS_IMPLEMENTATION)
+
+#if !defined(WUFFS_IMPLEMENTATION)
+  // As above, the size of the struct is not part of the public API, and unless
+  // WUFFS_IMPLEMENTATION is #define'd, this struct type T should be heap
+  // allocated, not stack allocated. Its size is not intended to be known at
+  // compile time, but it is unfortunately divulged as a side effect of
+  // defining C++ convenience methods. Use "sizeof__T()", calling the function,
+  // instead of "sizeof T", invoking the operator. To make the two values
+  // different, so that passing the latter will be rejected by the initialize
+  // function, we add an arbitrary amount of dead weight.
+  uint8_t dead_weight[123000000];  // 123 MB.
+#endif  // !defined(WUFFS_IMPLEMENTATION)
+
+  inline wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+  initialize(
+      size_t sizeof_star_self,
+      uint64_t wuffs_version,
+      uint32_t options) {
+    return wuffs_gif__decoder__initialize(
+        this, sizeof_star_self, wuffs_version, options);
+  }
+
+  inline wuffs_base__stats
+  stats() const {
+    return wuffs_gif__decoder__stats(this);
+  }
+
+  inline wuffs_base__image_decoder*
+  upcast_as__wuffs_base__image_decoder() {
+    return (wuffs_base__image_decoder*)this;
+  }
+
+  inline wuffs_base__empty_struct
+  set_quirk_enabled(
+      uint32_t a_quirk,
+      bool a_enabled) {
+    return wuffs_gif__decoder__set_quirk_enabled(this, a_quirk, a_enabled);
+  }
+
+  inline wuffs_base__status
+  decode_image_config(
+      wuffs_base__image_config* a_dst,
+      wuffs_base__io_buffer* a_src) {
+    return wuffs_gif__decoder__decode_image_config(this, a_dst, a_src);
+  }
+
+  inline wuffs_base__empty_struct
+  set_report_metadata(
+      uint32_t a_fourcc,
+      bool a_report) {
+    return wuffs_gif__decoder__set_report_metadata(this, a_fourcc, a_report);
+  }
+
+  inline wuffs_base__status
+  tell_me_more(
+      wuffs_base__io_buffer* a_dst,
+      wuffs_base__more_information* a_minfo,
+      wuffs_base__io_buffer* a_src) {
+    return wuffs_gif__decoder__tell_me_more(this, a_dst, a_minfo, a_src);
+  }
+
+  inline uint32_t
+  num_animation_loops() const {
+    return wuffs_gif__decoder__num_animation_loops(this);
+  }
+
+  inline uint64_t
+  num_decoded_frame_configs() const {
+    return wuffs_gif__decoder__num_decoded_frame_configs(this);
+  }
+
+  inline uint64_t
+  num_decoded_frames() const {
+    return wuffs_gif__decoder__num_decoded_frames(this);
+  }
+
+  inline bool
+  can_decode_row_bands() const {
+    return wuffs_gif__decoder__can_decode_row_bands(this);
+  }
+
+  inline wuffs_base__rect_ie_u32
+  frame_dirty_rect() const {
+    return wuffs_gif__decoder__frame_dirty_rect(this);
+  }
+
+  inline wuffs_base__range_ii_u64
+  workbuf_len() const {
+    return wuffs_gif__decoder__workbuf_len(this);
+  }
+
+  inline wuffs_base__status
+  restart_frame(
+      uint64_t a_index,
+      uint64_t a_io_position) {
+    return wuffs_gif__decoder__restart_frame(this, a_index, a_io_position);
+  }
+
+  inline wuffs_base__status
+  decode_frame_config(
+      wuffs_base__frame_config* a_dst,
+      wuffs_base__io_buffer* a_src) {
+    return wuffs_gif__decoder__decode_frame_config(this, a_dst, a_src);
+  }
+
+  inline wuffs_base__status
+  decode_frame(
+      wuffs_base__pixel_buffer* a_dst,
+      wuffs_base__io_buffer* a_src,
+      wuffs_base__pixel_blend a_blend,
+      wuffs_base__slice_u8 a_workbuf,
+      wuffs_base__decode_frame_options* a_opts) {
+    return wuffs_gif__decoder__decode_frame(this, a_dst, a_src, a_blend, a_workbuf, a_opts);
+  }
+
+#endif  // __cplusplus
+};  // struct wuffs_gif__decoder__struct
+
+struct wuffs_gif__encoder__struct {
+  // Do not access the private_impl's or private_data's fields directly. There
+  // is no API/ABI compatibility or safety guarantee if you do so. Instead, use
+  // the wuffs_foo__bar__baz functions.
+  //
+  // It is a struct, not a struct*, so that the outermost wuffs_foo__bar struct
+  // can be stack allocated when WUFFS_IMPLEMENTATION is defined.
+
+  struct {
+    uint32_t magic;
+    uint32_t active_coroutine;
+    wuffs_base__vtable null_vtable;
+#if defined(WUFFS_CONFIG__STATS)
+    wuffs_base__stats stats;
+#endif  // defined(WUFFS_CONFIG__STATS)
+
+    uint32_t f_canvas_width;
+    uint32_t f_canvas_height;
+    bool f_has_canvas;
+    uint32_t f_loop_count;
+    bool f_has_loop_count;
+    bool f_header_written;
+    uint32_t f_frame_left;
+    uint32_t f_frame_top;
+    uint32_t f_frame_delay;
+    uint8_t f_frame_disposal;
+    uint32_t f_width;
+    uint32_t f_height;
+    uint32_t f_palette_bits;
+    bool f_has_transparent;
+    uint8_t f_transparent_index;
+    uint32_t f_literal_width;
+    uint32_t f_x;
+    uint32_t f_y;
+    uint32_t f_clear_code;
+    uint32_t f_code;
+    bool f_has_code;
+    uint32_t f_hi;
+    uint32_t f_code_width;
+    uint64_t f_bits;
+    uint32_t f_n_bits;
+    uint32_t f_block_start;
+    uint32_t f_block_len;
+    uint32_t f_obuf_ri;
+    uint32_t f_obuf_wi;
+
+    uint32_t p_encode_frame[1];
+    uint32_t p_encode_trailer[1];
+    uint32_t p_write_obuf[1];
+  } private_impl;
+
+  struct {
+    uint32_t f_hashes[8192];
+    uint8_t f_obuf[4096];
+  } private_data;
+
+#ifdef __cplusplus
+#if defined(WUFFS_BASE__HAVE_UNIQUE_PTR)
+  using unique_ptr = std::unique_ptr<wuffs_gif__encoder, decltype(&free)>;
+
+  // On failure, the alloc_etc functions return nullptr. They don't throw.
+
+  static inline unique_ptr
+  alloc() {
+    return unique_ptr(wuffs_gif__encoder__alloc(), &free);
+  }
+#endif  // defined(WUFFS_BASE__HAVE_UNIQUE_PTR)
+
+#if defined(WUFFS_BASE__HAVE_EQ_DELETE) && !defined(WUFFS_IMPLEMENTATION)
+  // Disallow constructing or copying an object via standard C++ mechanisms,
+  // e.g. the "new" operator, as this struct is intentionally opaque. Its total
+  // size and field layout is not part of the public, stable, memory-safe API.
+  // Use malloc or memcpy and the sizeof__wuffs_foo__bar function instead, and
+  // call wuffs_foo__bar__baz methods (which all take a "this"-like pointer as
+  // their first argument) rather than tweaking bar.private_impl.qux fields.
+  //
+  // In C, we can just leave wuffs_foo__bar as an incomplete type (unless
+  // WUFFS_IMPLEMENTATION is #define'd). In C++, we define a complete type in
+  // order to provide convenience methods. These forward on "this", so that you
+  // can write "bar->baz(etc)" instead of "wuffs_foo__bar__baz(bar, etc)".
+  wuffs_gif__encoder__struct() = delete;
+  wuffs_gif__encoder__struct(const wuffs_gif__encoder__struct&) = delete;
+  wuffs_gif__encoder__struct& operator=(
+      const wuffs_gif__encoder__struct&) = delete;
+#endif  // defined(WUFFS_BASE__HAVE_EQ_DELETE) && !defined(WUFFS_IMPLEMENTATION)
+
+#if !defined(WUFFS_IMPLEMENTATION)
+  // As above, the size of the struct is not part of the public API, and unless
+  // WUFFS_IMPLEMENTATION is #define'd, this struct type T should be heap
+  // allocated, not stack allocated. Its size is not intended to be known at
+  // compile time, but it is unfortunately divulged as a side effect of
+  // defining C++ convenience methods. Use "sizeof__T()", calling the function,
+  // instead of "sizeof T", invoking the operator. To make the two values
+  // different, so that passing the latter will be rejected by the initialize
+  // function, we add an arbitrary amount of dead weight.
+  uint8_t dead_weight[123000000];  // 123 MB.
+#endif  // !defined(WUFFS_IMPLEMENTATION)
+
+  inline wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+  initialize(
+      size_t sizeof_star_self,
+      uint64_t wuffs_version,
+      uint32_t options) {
+    return wuffs_gif__encoder__initialize(
+        this, sizeof_star_self, wuffs_version, options);
+  }
+
+  inline wuffs_base__stats
+  stats() const {
+    return wuffs_gif__encoder__stats(this);
+  }
+
+  inline wuffs_base__empty_struct
+  set_canvas(
+      uint32_t a_width,
+      uint32_t a_height) {
+    return wuffs_gif__encoder__set_canvas(this, a_width, a_height);
+  }
+
+  inline wuffs_base__empty_struct
+  set_loop_count(
+      uint32_t a_n) {
+    return wuffs_gif__encoder__set_loop_count(this, a_n);
+  }
+
+  inline wuffs_base__empty_struct
+  set_frame(
+      uint32_t a_left,
+      uint32_t a_top,
+      uint64_t a_duration,
+      uint8_t a_disposal) {
+    return wuffs_gif__encoder__set_frame(this, a_left, a_top, a_duration, a_disposal);
+  }
+
+  inline wuffs_base__status
+  encode_frame(
+      wuffs_base__io_buffer* a_dst,
+      wuffs_base__pixel_buffer* a_src) {
+    return wuffs_gif__encoder__encode_frame(this, a_dst, a_src);
+  }
+
+  inline wuffs_base__status
+  encode_trailer(
+      wuffs_base__io_buffer* a_dst) {
+    return wuffs_gif__encoder__encode_trailer(this, a_dst);
+  }
+
+#endif  // __cplusplus
+};  // struct wuffs_gif__encoder__struct
+
+#endif  // defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
+
+
+// ‼ WUFFS C HEADER ENDS HERE.
+#ifdef WUFFS_IMPLEMENTATION
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__GIF)
+
+// ---------------- Status Codes Implementations
+
+const char wuffs_gif__error__bad_extension_label[] = "#gif: bad extension label";
+const char wuffs_gif__error__bad_frame_size[] = "#gif: bad frame size";
+const char wuffs_gif__error__bad_graphic_control[] = "#gif: bad graphic control";
+const char wuffs_gif__error__bad_header[] = "#gif: bad header";
+const char wuffs_gif__error__bad_literal_width[] = "#gif: bad literal width";
+const char wuffs_gif__error__bad_palette[] = "#gif: bad palette";
+const char wuffs_gif__error__internal_error_inconsistent_ri_wi[] = "#gif: internal error: inconsistent ri/wi";
+
+// ---------------- Private Consts
+
+static const uint32_t
+WUFFS_GIF__INTERLACE_START[5] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  4294967295, 1, 2, 4, 0,
+};
+
+static const uint8_t
+WUFFS_GIF__INTERLACE_DELTA[5] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  1, 2, 4, 8, 8,
+};
+
+static const uint8_t
+WUFFS_GIF__INTERLACE_COUNT[5] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  0, 1, 2, 4, 8,
+};
+
+static const uint8_t
+WUFFS_GIF__ANIMEXTS1DOT0[11] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  65, 78, 73, 77, 69, 88, 84, 83,
+  49, 46, 48,
+};
+
+static const uint8_t
+WUFFS_GIF__NETSCAPE2DOT0[11] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  78, 69, 84, 83, 67, 65, 80, 69,
+  50, 46, 48,
+};
+
+static const uint8_t
+WUFFS_GIF__ICCRGBG1012[11] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  73, 67, 67, 82, 71, 66, 71, 49,
+  48, 49, 50,
+};
+
+static const uint8_t
+WUFFS_GIF__XMPDATAXMP[11] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  88, 77, 80, 32, 68, 97, 116, 97,
+  88, 77, 80,
+};
+
+#define WUFFS_GIF__QUIRKS_BASE 1041635328
+
+#define WUFFS_GIF__QUIRKS_COUNT 7
+
+#define WUFFS_GIF__ENCODER_OBUF_SIZE 4096
+
+#define WUFFS_GIF__ENCODER_OBUF_FLUSH 3584
+
+#define WUFFS_GIF__ENCODER_HASH_SIZE 8192
+
+// ---------------- Private Initializer Prototypes
+
+// ---------------- Private Function Prototypes
+
+static wuffs_base__status
+wuffs_gif__decoder__skip_frame(
+    wuffs_gif__decoder* self,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__empty_struct
+wuffs_gif__decoder__reset_gc(
+    wuffs_gif__decoder* self);
+
+static wuffs_base__status
+wuffs_gif__decoder__decode_up_to_id_part1(
+    wuffs_gif__decoder* self,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status
+wuffs_gif__decoder__decode_header(
+    wuffs_gif__decoder* self,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status
+wuffs_gif__decoder__decode_lsd(
+    wuffs_gif__decoder* self,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status
+wuffs_gif__decoder__decode_extension(
+    wuffs_gif__decoder* self,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status
+wuffs_gif__decoder__skip_blocks(
+    wuffs_gif__decoder* self,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status
+wuffs_gif__decoder__decode_ae(
+    wuffs_gif__decoder* self,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status
+wuffs_gif__decoder__decode_gc(
+    wuffs_gif__decoder* self,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status
+wuffs_gif__decoder__decode_id_part0(
+    wuffs_gif__decoder* self,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status
+wuffs_gif__decoder__decode_id_part1(
+    wuffs_gif__decoder* self,
+    wuffs_base__pixel_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__pixel_blend a_blend);
+
+static wuffs_base__status
+wuffs_gif__decoder__decode_id_part2(
+    wuffs_gif__decoder* self,
+    wuffs_base__pixel_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf);
+
+static wuffs_base__status
+wuffs_gif__decoder__copy_to_image_buffer(
+    wuffs_gif__decoder* self,
+    wuffs_base__pixel_buffer* a_pb,
+    wuffs_base__slice_u8 a_src,
+    wuffs_base__slice_u8 a_workbuf);
+
+static wuffs_base__empty_struct
+wuffs_gif__decoder__downscale_row(
+    wuffs_gif__decoder* self,
+    wuffs_base__pixel_buffer* a_pb,
+    wuffs_base__slice_u8 a_workbuf,
+    uint32_t a_bytes_per_pixel);
+
+static wuffs_base__status
+wuffs_gif__encoder__prepare_frame(
+    wuffs_gif__encoder* self,
+    wuffs_base__pixel_buffer* a_src);
+
+static uint32_t
+wuffs_gif__encoder__or_of_indexes(
+    const wuffs_gif__encoder* self,
+    wuffs_base__pixel_buffer* a_src);
+
+static wuffs_base__empty_struct
+wuffs_gif__encoder__put_header(
+    wuffs_gif__encoder* self);
+
+static wuffs_base__empty_struct
+wuffs_gif__encoder__put_frame_header(
+    wuffs_gif__encoder* self,
+    wuffs_base__pixel_buffer* a_src);
+
+static wuffs_base__empty_struct
+wuffs_gif__encoder__start_lzw(
+    wuffs_gif__encoder* self);
+
+static wuffs_base__empty_struct
+wuffs_gif__encoder__finish_lzw(
+    wuffs_gif__encoder* self);
+
+static wuffs_base__empty_struct
+wuffs_gif__encoder__reset_table(
+    wuffs_gif__encoder* self);
+
+static uint64_t
+wuffs_gif__encoder__compress(
+    wuffs_gif__encoder* self,
+    wuffs_base__slice_u8 a_src);
+
+static wuffs_base__empty_struct
+wuffs_gif__encoder__inc_hi(
+    wuffs_gif__encoder* self);
+
+static wuffs_base__empty_struct
+wuffs_gif__encoder__put_code(
+    wuffs_gif__encoder* self,
+    uint32_t a_code);
+
+static wuffs_base__empty_struct
+wuffs_gif__encoder__put_lzw_byte(
+    wuffs_gif__encoder* self,
+    uint8_t a_a);
+
+static wuffs_base__empty_struct
+wuffs_gif__encoder__end_block(
+    wuffs_gif__encoder* self);
+
+static wuffs_base__status
+wuffs_gif__encoder__write_obuf(
+    wuffs_gif__encoder* self,
+    wuffs_base__io_buffer* a_dst);
+
+static wuffs_base__empty_struct
+wuffs_gif__encoder__put_u8(
+    wuffs_gif__encoder* self,
+    uint8_t a_a);
+
+static wuffs_base__empty_struct
+wuffs_gif__encoder__put_u16le(
+    wuffs_gif__encoder* self,
+    uint32_t a_a);
+
+// ---------------- VTables
+
+const wuffs_base__image_decoder__func_ptrs
+wuffs_gif__decoder__func_ptrs_for__wuffs_base__image_decoder = {
+  (bool(*)(const void*))(&wuffs_gif__decoder__can_decode_row_bands),
+  (wuffs_base__status(*)(void*,
+      wuffs_base__pixel_buffer*,
+      wuffs_base__io_buffer*,
+      wuffs_base__pixel_blend,
+      wuffs_base__slice_u8,
+      wuffs_base__decode_frame_options*))(&wuffs_gif__decoder__decode_frame),
+  (wuffs_base__status(*)(void*,
+      wuffs_base__frame_config*,
+      wuffs_base__io_buffer*))(&wuffs_gif__decoder__decode_frame_config),
+  (wuffs_base__status(*)(void*,
+      wuffs_base__image_config*,
+      wuffs_base__io_buffer*))(&wuffs_gif__decoder__decode_image_config),
+  (wuffs_base__rect_ie_u32(*)(const void*))(&wuffs_gif__decoder__frame_dirty_rect),
+  (uint32_t(*)(const void*))(&wuffs_gif__decoder__num_animation_loops),
+  (uint64_t(*)(const void*))(&wuffs_gif__decoder__num_decoded_frame_configs),
+  (uint64_t(*)(const void*))(&wuffs_gif__decoder__num_decoded_frames),
+  (wuffs_base__status(*)(void*,
+      uint64_t,
+      uint64_t))(&wuffs_gif__decoder__restart_frame),
+  (wuffs_base__empty_struct(*)(void*,
+      uint32_t,
+      bool))(&wuffs_gif__decoder__set_quirk_enabled),
+  (wuffs_base__empty_struct(*)(void*,
+      uint32_t,
+      bool))(&wuffs_gif__decoder__set_report_metadata),
+  (wuffs_base__status(*)(void*,
+      wuffs_base__io_buffer*,
+      wuffs_base__more_information*,
+      wuffs_base__io_buffer*))(&wuffs_gif__decoder__tell_me_more),
+  (wuffs_base__range_ii_u64(*)(const void*))(&wuffs_gif__decoder__workbuf_len),
+};
+
+// ---------------- Initializer Implementations
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+wuffs_gif__decoder__initialize(
+    wuffs_gif__decoder* self,
+    size_t sizeof_star_self,
+    uint64_t wuffs_version,
+    uint32_t options){
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  }
+
+  if ((options & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+    // The whole point of this if-check is to detect an uninitialized *self.
+    // We disable the warning on GCC. Clang-5.0 does not have this warning.
+    //
+    // The caller promises that *self is zeroed, so the empty asm tells GCC
+    // that private_impl is defined. Otherwise, once this function and a
+    // small method (e.g. one that reads a "choose" guard field) are both
+    // inlined into the caller, GCC -O3 warns about that method's read.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    __asm__ __volatile__("" : "+m"(self->private_impl));
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((options & WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      options |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    }
+  }
+
+  {
+    wuffs_base__status z = wuffs_lzw__decoder__initialize(
+        &self->private_data.f_lzw, sizeof(self->private_data.f_lzw), WUFFS_VERSION, options);
+    if (z.repr) {
+      return z;
+    }
+  }
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__image_decoder.vtable_name =
+      wuffs_base__image_decoder__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__image_decoder.function_pointers =
+      (const void*)(&wuffs_gif__decoder__func_ptrs_for__wuffs_base__image_decoder);
+  return wuffs_base__make_status(NULL);
+}
+
+wuffs_gif__decoder*
+wuffs_gif__decoder__alloc() {
+  wuffs_gif__decoder* x =
+      (wuffs_gif__decoder*)(calloc(sizeof(wuffs_gif__decoder), 1));
+  if (!x) {
+    return NULL;
+  }
+  if (wuffs_gif__decoder__initialize(
+      x, sizeof(wuffs_gif__decoder), WUFFS_VERSION, WUFFS_INITIALIZE__ALREADY_ZEROED).repr) {
+    free(x);
+    return NULL;
+  }
+  return x;
+}
+
+size_t
+sizeof__wuffs_gif__decoder() {
+  return sizeof(wuffs_gif__decoder);
+}
+
+wuffs_base__stats
+wuffs_gif__decoder__stats(
+    const wuffs_gif__decoder* self) {
+  wuffs_base__stats ret = wuffs_base__make_empty_stats();
+#if defined(WUFFS_CONFIG__STATS)
+  if (!self) {
+    return ret;
+  }
+  ret = self->private_impl.stats;
+  {
+    wuffs_base__stats z = wuffs_lzw__decoder__stats(&self->private_data.f_lzw);
+    wuffs_base__stats__accumulate(&ret, &z);
+  }
+#else
+  (void)(self);
+#endif  // defined(WUFFS_CONFIG__STATS)
+  return ret;
+}
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+wuffs_gif__encoder__initialize(
+    wuffs_gif__encoder* self,
+    size_t sizeof_star_self,
+    uint64_t wuffs_version,
+    uint32_t options){
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  }
+
+  if ((options & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+    // The whole point of this if-check is to detect an uninitialized *self.
+    // We disable the warning on GCC. Clang-5.0 does not have this warning.
+    //
+    // The caller promises that *self is zeroed, so the empty asm tells GCC
+    // that private_impl is defined. Otherwise, once this function and a
+    // small method (e.g. one that reads a "choose" guard field) are both
+    // inlined into the caller, GCC -O3 warns about that method's read.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    __asm__ __volatile__("" : "+m"(self->private_impl));
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((options & WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      options |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    }
+  }
+
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  return wuffs_base__make_status(NULL);
+}
+
+wuffs_gif__encoder*
+wuffs_gif__encoder__alloc() {
+  wuffs_gif__encoder* x =
+      (wuffs_gif__encoder*)(calloc(sizeof(wuffs_gif__encoder), 1));
+  if (!x) {
+    return NULL;
+  }
+  if (wuffs_gif__encoder__initialize(
+      x, sizeof(wuffs_gif__encoder), WUFFS_VERSION, WUFFS_INITIALIZE__ALREADY_ZEROED).repr) {
+    free(x);
+    return NULL;
+  }
+  return x;
+}
+
+size_t
+sizeof__wuffs_gif__encoder() {
+  return sizeof(wuffs_gif__encoder);
+}
+
+wuffs_base__stats
+wuffs_gif__encoder__stats(
+    const wuffs_gif__encoder* self) {
+  wuffs_base__stats ret = wuffs_base__make_empty_stats();
+#if defined(WUFFS_CONFIG__STATS)
+  if (!self) {
+    return ret;
+  }
+  ret = self->private_impl.stats;
+#else
+  (void)(self);
+#endif  // defined(WUFFS_CONFIG__STATS)
+  return ret;
+}
+
+// ---------------- Function Implementations
+
+// -------- func gif.decoder.set_quirk_enabled
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_gif__decoder__set_quirk_enabled(
+    wuffs_gif__decoder* self,
+    uint32_t a_quirk,
+    bool a_enabled) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  if ((self->private_impl.f_call_sequence == 0) && (a_quirk >= 1041635328)) {
+    a_quirk -= 1041635328;
+    if (a_quirk < 7) {
+      self->private_impl.f_quirks[a_quirk] = a_enabled;
+    }
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func gif.decoder.decode_image_config
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_gif__decoder__decode_image_config(
+    wuffs_gif__decoder* self,
+    wuffs_base__image_config* a_dst,
+    wuffs_base__io_buffer* a_src) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+        ? wuffs_base__error__disabled_by_previous_error
+        : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 1)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  bool v_ffio = false;
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_image_config[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_call_sequence == 0) {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      status = wuffs_gif__decoder__decode_header(self, a_src);
+      if (status.repr) {
+        goto suspend;
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      status = wuffs_gif__decoder__decode_lsd(self, a_src);
+      if (status.repr) {
+        goto suspend;
+      }
+    } else if (self->private_impl.f_call_sequence != 2) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
+      goto exit;
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+    status = wuffs_gif__decoder__decode_up_to_id_part1(self, a_src);
+    if (status.repr) {
+      goto suspend;
+    }
+    v_ffio =  ! self->private_impl.f_gc_has_transparent_index;
+    if ( ! self->private_impl.f_quirks[2]) {
+      v_ffio = (v_ffio &&
+          (self->private_impl.f_frame_rect_x0 == 0) &&
+          (self->private_impl.f_frame_rect_y0 == 0) &&
+          (self->private_impl.f_frame_rect_x1 == self->private_impl.f_width) &&
+          (self->private_impl.f_frame_rect_y1 == self->private_impl.f_height));
+    } else if (v_ffio) {
+      self->private_impl.f_black_color_u32_argb_premul = 4278190080;
+    }
+    if (self->private_impl.f_background_color_u32_argb_premul == 77) {
+      self->private_impl.f_background_color_u32_argb_premul = self->private_impl.f_black_color_u32_argb_premul;
+    }
+    if (a_dst != NULL) {
+      wuffs_base__image_config__set(
+          a_dst,
+          2198077448,
+          0,
+          self->private_impl.f_width,
+          self->private_impl.f_height,
+          self->private_impl.f_frame_config_io_position,
+          v_ffio);
+    }
+    self->private_impl.f_call_sequence = 3;
+
+    goto ok;
+    ok:
+    self->private_impl.p_decode_image_config[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_image_config[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine = wuffs_base__status__is_suspension(&status) ? 1 : 0;
+  WUFFS_BASE__STATS__ADD(self->private_impl, WUFFS_BASE__STATS__SUSPENSIONS,
+      wuffs_base__status__is_suspension(&status) ? 1u : 0u);
+
+  goto exit;
+  exit:
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func gif.decoder.set_report_metadata
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_gif__decoder__set_report_metadata(
+    wuffs_gif__decoder* self,
+    uint32_t a_fourcc,
+    bool a_report) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  if (a_fourcc == 1229144912) {
+    self->private_impl.f_report_metadata_iccp = a_report;
+  } else if (a_fourcc == 1481461792) {
+    self->private_impl.f_report_metadata_xmp = a_report;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func gif.decoder.tell_me_more
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_gif__decoder__tell_me_more(
+    wuffs_gif__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__more_information* a_minfo,
+    wuffs_base__io_buffer* a_src) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+        ? wuffs_base__error__disabled_by_previous_error
+        : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst || !a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 2)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint64_t v_chunk_length = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_tell_me_more[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_call_sequence != 1) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
+      goto exit;
+    }
+    if (self->private_impl.f_metadata_fourcc == 0) {
+      status = wuffs_base__make_status(wuffs_base__error__no_more_information);
+      goto exit;
+    }
+    while (true) {
+      label__0__continue:;
+      while (true) {
+        if (wuffs_base__u64__sat_add((a_src ? a_src->meta.pos : 0), ((uint64_t)(iop_a_src - io0_a_src))) != self->private_impl.f_metadata_io_position) {
+          if (a_minfo != NULL) {
+            wuffs_base__more_information__set(a_minfo,
+                2,
+                0,
+                self->private_impl.f_metadata_io_position,
+                0,
+                0);
+          }
+          status = wuffs_base__make_status(wuffs_base__suspension__mispositioned_read);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
+          goto label__0__continue;
+        }
+        if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+          if (a_minfo != NULL) {
+            wuffs_base__more_information__set(a_minfo,
+                0,
+                0,
+                0,
+                0,
+                0);
+          }
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(2);
+          goto label__0__continue;
+        }
+        goto label__0__break;
+      }
+      label__0__break:;
+      v_chunk_length = ((uint64_t)(wuffs_base__peek_u8be__no_bounds_check(iop_a_src)));
+      if (v_chunk_length <= 0) {
+        iop_a_src += 1;
+        goto label__1__break;
+      }
+      if (self->private_impl.f_metadata_fourcc == 1481461792) {
+        v_chunk_length += 1;
+      } else {
+        iop_a_src += 1;
+      }
+      self->private_impl.f_metadata_io_position = wuffs_base__u64__sat_add(wuffs_base__u64__sat_add((a_src ? a_src->meta.pos : 0), ((uint64_t)(iop_a_src - io0_a_src))), v_chunk_length);
+      if (a_minfo != NULL) {
+        wuffs_base__more_information__set(a_minfo,
+            3,
+            self->private_impl.f_metadata_fourcc,
+            0,
+            wuffs_base__u64__sat_add((a_src ? a_src->meta.pos : 0), ((uint64_t)(iop_a_src - io0_a_src))),
+            self->private_impl.f_metadata_io_position);
+      }
+      status = wuffs_base__make_status(wuffs_base__suspension__even_more_information);
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(3);
+    }
+    label__1__break:;
+    if (a_minfo != NULL) {
+      wuffs_base__more_information__set(a_minfo,
+          3,
+          self->private_impl.f_metadata_fourcc,
+          0,
+          self->private_impl.f_metadata_io_position,
+          self->private_impl.f_metadata_io_position);
+    }
+    self->private_impl.f_call_sequence = 2;
+    self->private_impl.f_metadata_fourcc = 0;
+    self->private_impl.f_metadata_io_position = 0;
+    status = wuffs_base__make_status(NULL);
+    goto ok;
+
+    ok:
+    self->private_impl.p_tell_me_more[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_tell_me_more[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine = wuffs_base__status__is_suspension(&status) ? 2 : 0;
+  WUFFS_BASE__STATS__ADD(self->private_impl, WUFFS_BASE__STATS__SUSPENSIONS,
+      wuffs_base__status__is_suspension(&status) ? 1u : 0u);
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func gif.decoder.num_animation_loops
+
+WUFFS_BASE__MAYBE_STATIC uint32_t
+wuffs_gif__decoder__num_animation_loops(
+    const wuffs_gif__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  if (self->private_impl.f_seen_num_animation_loops_value) {
+    return self->private_impl.f_num_animation_loops_value;
+  }
+  if (self->private_impl.f_num_decoded_frame_configs_value > 1) {
+    return 1;
+  }
+  return 0;
+}
+
+// -------- func gif.decoder.num_decoded_frame_configs
+
+WUFFS_BASE__MAYBE_STATIC uint64_t
+wuffs_gif__decoder__num_decoded_frame_configs(
+    const wuffs_gif__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_num_decoded_frame_configs_value;
+}
+
+// -------- func gif.decoder.num_decoded_frames
+
+WUFFS_BASE__MAYBE_STATIC uint64_t
+wuffs_gif__decoder__num_decoded_frames(
+    const wuffs_gif__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_num_decoded_frames_value;
+}
+
+// -------- func gif.decoder.can_decode_row_bands
+
+WUFFS_BASE__MAYBE_STATIC bool
+wuffs_gif__decoder__can_decode_row_bands(
+    const wuffs_gif__decoder* self) {
+  if (!self) {
+    return false;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return false;
+  }
+
+  return false;
+}
+
+// -------- func gif.decoder.frame_dirty_rect
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__rect_ie_u32
+wuffs_gif__decoder__frame_dirty_rect(
+    const wuffs_gif__decoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_rect_ie_u32();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_rect_ie_u32();
+  }
+
+  return wuffs_base__utility__make_rect_ie_u32(
+      wuffs_base__u32__min(self->private_impl.f_frame_rect_x0, self->private_impl.f_width),
+      wuffs_base__u32__min(self->private_impl.f_frame_rect_y0, self->private_impl.f_height),
+      wuffs_base__u32__min(self->private_impl.f_frame_rect_x1, self->private_impl.f_width),
+      wuffs_base__u32__min(self->private_impl.f_dirty_max_excl_y, self->private_impl.f_height));
+}
+
+// -------- func gif.decoder.workbuf_len
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64
+wuffs_gif__decoder__workbuf_len(
+    const wuffs_gif__decoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+
+  return wuffs_base__utility__make_range_ii_u64(0, 0);
+}
+
+// -------- func gif.decoder.restart_frame
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_gif__decoder__restart_frame(
+    wuffs_gif__decoder* self,
+    uint64_t a_index,
+    uint64_t a_io_position) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+        ? wuffs_base__error__disabled_by_previous_error
+        : wuffs_base__error__initialize_not_called);
+  }
+
+  if (self->private_impl.f_call_sequence < 3) {
+    return wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
+  }
+  self->private_impl.f_delayed_num_decoded_frames = false;
+  self->private_impl.f_end_of_data = false;
+  self->private_impl.f_restarted = true;
+  self->private_impl.f_frame_config_io_position = a_io_position;
+  self->private_impl.f_num_decoded_frame_configs_value = a_index;
+  self->private_impl.f_num_decoded_frames_value = a_index;
+  wuffs_gif__decoder__reset_gc(self);
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func gif.decoder.decode_frame_config
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_gif__decoder__decode_frame_config(
+    wuffs_gif__decoder* self,
+    wuffs_base__frame_config* a_dst,
+    wuffs_base__io_buffer* a_src) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+        ? wuffs_base__error__disabled_by_previous_error
+        : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 3)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_background_color = 0;
+  uint8_t v_flags = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_frame_config[0];
+  if (coro_susp_point) {
+    v_background_color = self->private_data.s_decode_frame_config[0].v_background_color;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    self->private_impl.f_ignore_metadata = true;
+    self->private_impl.f_dirty_max_excl_y = 0;
+    if ( ! self->private_impl.f_end_of_data) {
+      if (self->private_impl.f_call_sequence == 0) {
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        status = wuffs_gif__decoder__decode_image_config(self, NULL, a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+      } else if (self->private_impl.f_call_sequence != 3) {
+        if (self->private_impl.f_call_sequence == 4) {
+          if (a_src) {
+            a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+          }
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+          status = wuffs_gif__decoder__skip_frame(self, a_src);
+          if (a_src) {
+            iop_a_src = a_src->data.ptr + a_src->meta.ri;
+          }
+          if (status.repr) {
+            goto suspend;
+          }
+        }
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+        status = wuffs_gif__decoder__decode_up_to_id_part1(self, a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+      }
+    }
+    if (self->private_impl.f_end_of_data) {
+      status = wuffs_base__make_status(wuffs_base__note__end_of_data);
+      goto ok;
+    }
+    v_background_color = self->private_impl.f_black_color_u32_argb_premul;
+    if ( ! self->private_impl.f_gc_has_transparent_index) {
+      v_background_color = self->private_impl.f_background_color_u32_argb_premul;
+      if (self->private_impl.f_quirks[1] && (self->private_impl.f_num_decoded_frame_configs_value == 0)) {
+        while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(4);
+        }
+        v_flags = wuffs_base__peek_u8be__no_bounds_check(iop_a_src);
+        if ((v_flags & 128) != 0) {
+          v_background_color = self->private_impl.f_black_color_u32_argb_premul;
+        }
+      }
+    }
+    if (a_dst != NULL) {
+      wuffs_base__frame_config__set(
+          a_dst,
+          wuffs_base__utility__make_rect_ie_u32(
+          wuffs_base__u32__min(self->private_impl.f_frame_rect_x0, self->private_impl.f_width),
+          wuffs_base__u32__min(self->private_impl.f_frame_rect_y0, self->private_impl.f_height),
+          wuffs_base__u32__min(self->private_impl.f_frame_rect_x1, self->private_impl.f_width),
+          wuffs_base__u32__min(self->private_impl.f_frame_rect_y1, self->private_impl.f_height)),
+          ((wuffs_base__flicks)(self->private_impl.f_gc_duration)),
+          self->private_impl.f_num_decoded_frame_configs_value,
+          self->private_impl.f_frame_config_io_position,
+          self->private_impl.f_gc_disposal,
+          ! self->private_impl.f_gc_has_transparent_index,
+          false,
+          v_background_color);
+    }
+    wuffs_base__u64__sat_add_indirect(&self->private_impl.f_num_decoded_frame_configs_value, 1);
+    self->private_impl.f_call_sequence = 4;
+
+    ok:
+    self->private_impl.p_decode_frame_config[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_frame_config[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine = wuffs_base__status__is_suspension(&status) ? 3 : 0;
+  WUFFS_BASE__STATS__ADD(self->private_impl, WUFFS_BASE__STATS__SUSPENSIONS,
+      wuffs_base__status__is_suspension(&status) ? 1u : 0u);
+  self->private_data.s_decode_frame_config[0].v_background_color = v_background_color;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func gif.decoder.skip_frame
+
+static wuffs_base__status
+wuffs_gif__decoder__skip_frame(
+    wuffs_gif__decoder* self,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t v_flags = 0;
+  uint8_t v_lw = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_skip_frame[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_0 = *iop_a_src++;
+      v_flags = t_0;
+    }
+    if ((v_flags & 128) != 0) {
+      self->private_data.s_skip_frame[0].scratch = (((uint32_t)(3)) << (1 + (v_flags & 7)));
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      if (self->private_data.s_skip_frame[0].scratch > ((uint64_t)(io2_a_src - iop_a_src))) {
+        self->private_data.s_skip_frame[0].scratch -= ((uint64_t)(io2_a_src - iop_a_src));
+        iop_a_src = io2_a_src;
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      iop_a_src += self->private_data.s_skip_frame[0].scratch;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_1 = *iop_a_src++;
+      v_lw = t_1;
+    }
+    if (v_lw > 8) {
+      status = wuffs_base__make_status(wuffs_gif__error__bad_literal_width);
+      goto exit;
+    }
+    if (a_src) {
+      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+    status = wuffs_gif__decoder__skip_blocks(self, a_src);
+    if (a_src) {
+      iop_a_src = a_src->data.ptr + a_src->meta.ri;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
+    if (self->private_impl.f_quirks[0]) {
+      self->private_impl.f_delayed_num_decoded_frames = true;
+    } else {
+      wuffs_base__u64__sat_add_indirect(&self->private_impl.f_num_decoded_frames_value, 1);
+    }
+    wuffs_gif__decoder__reset_gc(self);
+
+    goto ok;
+    ok:
+    self->private_impl.p_skip_frame[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_skip_frame[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func gif.decoder.decode_frame
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_gif__decoder__decode_frame(
+    wuffs_gif__decoder* self,
+    wuffs_base__pixel_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__pixel_blend a_blend,
+    wuffs_base__slice_u8 a_workbuf,
+    wuffs_base__decode_frame_options* a_opts) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+        ? wuffs_base__error__disabled_by_previous_error
+        : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst || !a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 4)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_frame[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    self->private_impl.f_ignore_metadata = true;
+    if (self->private_impl.f_call_sequence != 4) {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      status = wuffs_gif__decoder__decode_frame_config(self, NULL, a_src);
+      if (status.repr) {
+        goto suspend;
+      }
+    }
+    if (self->private_impl.f_quirks[5] && ((self->private_impl.f_frame_rect_x0 == self->private_impl.f_frame_rect_x1) || (self->private_impl.f_frame_rect_y0 == self->private_impl.f_frame_rect_y1))) {
+      status = wuffs_base__make_status(wuffs_gif__error__bad_frame_size);
+      goto exit;
+    }
+    self->private_impl.f_roi_x0 = 0;
+    self->private_impl.f_roi_y0 = 0;
+    self->private_impl.f_roi_x1 = 4294967295;
+    self->private_impl.f_roi_y1 = 4294967295;
+    if (a_opts != NULL) {
+      if (wuffs_base__decode_frame_options__has_color_conversion(a_opts)) {
+        status = wuffs_base__make_status(wuffs_base__error__unsupported_option);
+        goto exit;
+      }
+      if (wuffs_base__decode_frame_options__row_band_height(a_opts) > 0) {
+        status = wuffs_base__make_status(wuffs_base__error__unsupported_option);
+        goto exit;
+      }
+      self->private_impl.f_roi_x0 = wuffs_base__decode_frame_options__roi_min_incl_x(a_opts);
+      self->private_impl.f_roi_y0 = wuffs_base__decode_frame_options__roi_min_incl_y(a_opts);
+      self->private_impl.f_roi_x1 = wuffs_base__decode_frame_options__roi_max_excl_x(a_opts);
+      self->private_impl.f_roi_y1 = wuffs_base__decode_frame_options__roi_max_excl_y(a_opts);
+    }
+    self->private_impl.f_roi_x1 = wuffs_base__u32__min(self->private_impl.f_roi_x1, self->private_impl.f_width);
+    self->private_impl.f_roi_y1 = wuffs_base__u32__min(self->private_impl.f_roi_y1, self->private_impl.f_height);
+    self->private_impl.f_roi_x0 = wuffs_base__u32__min(self->private_impl.f_roi_x0, self->private_impl.f_roi_x1);
+    self->private_impl.f_roi_y0 = wuffs_base__u32__min(self->private_impl.f_roi_y0, self->private_impl.f_roi_y1);
+    self->private_impl.f_downscale_shift = 0;
+    if (a_opts != NULL) {
+      self->private_impl.f_downscale_shift = wuffs_base__decode_frame_options__downscale_shift(a_opts);
+    }
+    self->private_impl.f_downscale_workbuf_length = 0;
+    self->private_impl.f_downscale_num_rows = 0;
+    if (self->private_impl.f_downscale_shift > 0) {
+      self->private_impl.f_downscale_workbuf_length = ((((uint64_t)(((uint32_t)(self->private_impl.f_roi_x1 - self->private_impl.f_roi_x0)))) * 4) + (((((uint64_t)(((uint32_t)(self->private_impl.f_roi_x1 - self->private_impl.f_roi_x0)))) + ((((uint64_t)(1)) << self->private_impl.f_downscale_shift) - 1)) >> self->private_impl.f_downscale_shift) * 8));
+      if (((uint64_t)(a_workbuf.len)) < self->private_impl.f_downscale_workbuf_length) {
+        status = wuffs_base__make_status(wuffs_base__error__bad_workbuf_length);
+        goto exit;
+      }
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+    status = wuffs_gif__decoder__decode_id_part1(self, a_dst, a_src, a_blend);
+    if (status.repr) {
+      goto suspend;
+    }
+    if ((self->private_impl.f_downscale_shift > 0) && (self->private_impl.f_interlace != 0)) {
+      status = wuffs_base__make_status(wuffs_base__error__unsupported_option);
+      goto exit;
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+    status = wuffs_gif__decoder__decode_id_part2(self, a_dst, a_src, a_workbuf);
+    if (status.repr) {
+      goto suspend;
+    }
+    wuffs_base__u64__sat_add_indirect(&self->private_impl.f_num_decoded_frames_value, 1);
+    wuffs_gif__decoder__reset_gc(self);
+
+    goto ok;
+    ok:
+    self->private_impl.p_decode_frame[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_frame[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine = wuffs_base__status__is_suspension(&status) ? 4 : 0;
+  WUFFS_BASE__STATS__ADD(self->private_impl, WUFFS_BASE__STATS__SUSPENSIONS,
+      wuffs_base__status__is_suspension(&status) ? 1u : 0u);
+
+  goto exit;
+  exit:
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func gif.decoder.reset_gc
+
+static wuffs_base__empty_struct
+wuffs_gif__decoder__reset_gc(
+    wuffs_gif__decoder* self) {
+  self->private_impl.f_call_sequence = 5;
+  self->private_impl.f_gc_has_transparent_index = false;
+  self->private_impl.f_gc_transparent_index = 0;
+  self->private_impl.f_gc_disposal = 0;
+  self->private_impl.f_gc_duration = 0;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func gif.decoder.decode_up_to_id_part1
+
+static wuffs_base__status
+wuffs_gif__decoder__decode_up_to_id_part1(
+    wuffs_gif__decoder* self,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t v_block_type = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_up_to_id_part1[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if ( ! self->private_impl.f_restarted) {
+      if (self->private_impl.f_call_sequence != 2) {
+        self->private_impl.f_frame_config_io_position = wuffs_base__u64__sat_add((a_src ? a_src->meta.pos : 0), ((uint64_t)(iop_a_src - io0_a_src)));
+      }
+    } else if (self->private_impl.f_frame_config_io_position != wuffs_base__u64__sat_add((a_src ? a_src->meta.pos : 0), ((uint64_t)(iop_a_src - io0_a_src)))) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_restart);
+      goto exit;
+    } else {
+      self->private_impl.f_restarted = false;
+    }
+    while (true) {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint8_t t_0 = *iop_a_src++;
+        v_block_type = t_0;
+      }
+      if (v_block_type == 33) {
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        status = wuffs_gif__decoder__decode_extension(self, a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+      } else if (v_block_type == 44) {
+        if (self->private_impl.f_delayed_num_decoded_frames) {
+          self->private_impl.f_delayed_num_decoded_frames = false;
+          wuffs_base__u64__sat_add_indirect(&self->private_impl.f_num_decoded_frames_value, 1);
+        }
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+        status = wuffs_gif__decoder__decode_id_part0(self, a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+        goto label__0__break;
+      } else {
+        if (self->private_impl.f_delayed_num_decoded_frames) {
+          self->private_impl.f_delayed_num_decoded_frames = false;
+          wuffs_base__u64__sat_add_indirect(&self->private_impl.f_num_decoded_frames_value, 1);
+        }
+        self->private_impl.f_end_of_data = true;
+        goto label__0__break;
+      }
+    }
+    label__0__break:;
+
+    goto ok;
+    ok:
+    self->private_impl.p_decode_up_to_id_part1[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_up_to_id_part1[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func gif.decoder.decode_header
+
+static wuffs_base__status
+wuffs_gif__decoder__decode_header(
+    wuffs_gif__decoder* self,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t v_c[6] = {0};
+  uint32_t v_i = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_header[0];
+  if (coro_susp_point) {
+    v_i = self->private_data.s_decode_header[0].v_i;
+    memcpy(v_c, self->private_data.s_decode_header[0].v_c, sizeof(v_c));
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    while (v_i < 6) {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint8_t t_0 = *iop_a_src++;
+        v_c[v_i] = t_0;
+      }
+      v_i += 1;
+    }
+    if ((v_c[0] != 71) ||
+        (v_c[1] != 73) ||
+        (v_c[2] != 70) ||
+        (v_c[3] != 56) ||
+        ((v_c[4] != 55) && (v_c[4] != 57)) ||
+        (v_c[5] != 97)) {
+      status = wuffs_base__make_status(wuffs_gif__error__bad_header);
+      goto exit;
+    }
+
+    goto ok;
+    ok:
+    self->private_impl.p_decode_header[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_header[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_decode_header[0].v_i = v_i;
+  memcpy(self->private_data.s_decode_header[0].v_c, v_c, sizeof(v_c));
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func gif.decoder.decode_lsd
+
+static wuffs_base__status
+wuffs_gif__decoder__decode_lsd(
+    wuffs_gif__decoder* self,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t v_flags = 0;
+  uint8_t v_background_color_index = 0;
+  uint32_t v_num_palette_entries = 0;
+  uint32_t v_i = 0;
+  uint32_t v_j = 0;
+  uint32_t v_argb = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_lsd[0];
+  if (coro_susp_point) {
+    v_num_palette_entries = self->private_data.s_decode_lsd[0].v_num_palette_entries;
+    v_i = self->private_data.s_decode_lsd[0].v_i;
+    v_flags = self->private_data.s_decode_lsd[0].v_flags;
+    v_background_color_index = self->private_data.s_decode_lsd[0].v_background_color_index;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      uint32_t t_0;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_0 = ((uint32_t)(wuffs_base__peek_u16le__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_lsd[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_lsd[0].scratch;
+          uint32_t num_bits_0 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_0;
+          if (num_bits_0 == 8) {
+            t_0 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_0 += 8;
+          *scratch |= ((uint64_t)(num_bits_0)) << 56;
+        }
+      }
+      self->private_impl.f_width = t_0;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      uint32_t t_1;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_1 = ((uint32_t)(wuffs_base__peek_u16le__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_lsd[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_lsd[0].scratch;
+          uint32_t num_bits_1 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_1;
+          if (num_bits_1 == 8) {
+            t_1 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_1 += 8;
+          *scratch |= ((uint64_t)(num_bits_1)) << 56;
+        }
+      }
+      self->private_impl.f_height = t_1;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_2 = *iop_a_src++;
+      v_flags = t_2;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_3 = *iop_a_src++;
+      v_background_color_index = t_3;
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+    if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+      goto suspend;
+    }
+    iop_a_src++;
+    v_i = 0;
+    self->private_impl.f_has_global_palette = ((v_flags & 128) != 0);
+    if (self->private_impl.f_has_global_palette) {
+      v_num_palette_entries = (((uint32_t)(1)) << (1 + (v_flags & 7)));
+      while (v_i < v_num_palette_entries) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+          uint32_t t_4;
+          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 3)) {
+            t_4 = ((uint32_t)(wuffs_base__peek_u24be__no_bounds_check(iop_a_src)));
+            iop_a_src += 3;
+          } else {
+            self->private_data.s_decode_lsd[0].scratch = 0;
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
+            while (true) {
+              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+                goto suspend;
+              }
+              uint64_t* scratch = &self->private_data.s_decode_lsd[0].scratch;
+              uint32_t num_bits_4 = ((uint32_t)(*scratch & 0xFF));
+              *scratch >>= 8;
+              *scratch <<= 8;
+              *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_4);
+              if (num_bits_4 == 16) {
+                t_4 = ((uint32_t)(*scratch >> 40));
+                break;
+              }
+              num_bits_4 += 8;
+              *scratch |= ((uint64_t)(num_bits_4));
+            }
+          }
+          v_argb = t_4;
+        }
+        v_argb |= 4278190080;
+        self->private_data.f_palettes[0][((4 * v_i) + 0)] = ((uint8_t)(((v_argb >> 0) & 255)));
+        self->private_data.f_palettes[0][((4 * v_i) + 1)] = ((uint8_t)(((v_argb >> 8) & 255)));
+        self->private_data.f_palettes[0][((4 * v_i) + 2)] = ((uint8_t)(((v_argb >> 16) & 255)));
+        self->private_data.f_palettes[0][((4 * v_i) + 3)] = ((uint8_t)(((v_argb >> 24) & 255)));
+        v_i += 1;
+      }
+      if (self->private_impl.f_quirks[2]) {
+        if ((v_background_color_index != 0) && (((uint32_t)(v_background_color_index)) < v_num_palette_entries)) {
+          v_j = (4 * ((uint32_t)(v_background_color_index)));
+          self->private_impl.f_background_color_u32_argb_premul = ((((uint32_t)(self->private_data.f_palettes[0][(v_j + 0)])) << 0) |
+              (((uint32_t)(self->private_data.f_palettes[0][(v_j + 1)])) << 8) |
+              (((uint32_t)(self->private_data.f_palettes[0][(v_j + 2)])) << 16) |
+              (((uint32_t)(self->private_data.f_palettes[0][(v_j + 3)])) << 24));
+        } else {
+          self->private_impl.f_background_color_u32_argb_premul = 77;
+        }
+      }
+    }
+    while (v_i < 256) {
+      self->private_data.f_palettes[0][((4 * v_i) + 0)] = 0;
+      self->private_data.f_palettes[0][((4 * v_i) + 1)] = 0;
+      self->private_data.f_palettes[0][((4 * v_i) + 2)] = 0;
+      self->private_data.f_palettes[0][((4 * v_i) + 3)] = 255;
+      v_i += 1;
+    }
+
+    goto ok;
+    ok:
+    self->private_impl.p_decode_lsd[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_lsd[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_decode_lsd[0].v_num_palette_entries = v_num_palette_entries;
+  self->private_data.s_decode_lsd[0].v_i = v_i;
+  self->private_data.s_decode_lsd[0].v_flags = v_flags;
+  self->private_data.s_decode_lsd[0].v_background_color_index = v_background_color_index;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func gif.decoder.decode_extension
+
+static wuffs_base__status
+wuffs_gif__decoder__decode_extension(
+    wuffs_gif__decoder* self,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t v_label = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_extension[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_0 = *iop_a_src++;
+      v_label = t_0;
+    }
+    if (v_label == 249) {
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      status = wuffs_gif__decoder__decode_gc(self, a_src);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+      status = wuffs_base__make_status(NULL);
+      goto ok;
+    } else if (v_label == 255) {
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      status = wuffs_gif__decoder__decode_ae(self, a_src);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+      status = wuffs_base__make_status(NULL);
+      goto ok;
+    }
+    if (a_src) {
+      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+    status = wuffs_gif__decoder__skip_blocks(self, a_src);
+    if (a_src) {
+      iop_a_src = a_src->data.ptr + a_src->meta.ri;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
+
+    ok:
+    self->private_impl.p_decode_extension[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_extension[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func gif.decoder.skip_blocks
+
+static wuffs_base__status
+wuffs_gif__decoder__skip_blocks(
+    wuffs_gif__decoder* self,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t v_block_size = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_skip_blocks[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    while (true) {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint8_t t_0 = *iop_a_src++;
+        v_block_size = t_0;
+      }
+      if (v_block_size == 0) {
+        status = wuffs_base__make_status(NULL);
+        goto ok;
+      }
+      self->private_data.s_skip_blocks[0].scratch = ((uint32_t)(v_block_size));
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      if (self->private_data.s_skip_blocks[0].scratch > ((uint64_t)(io2_a_src - iop_a_src))) {
+        self->private_data.s_skip_blocks[0].scratch -= ((uint64_t)(io2_a_src - iop_a_src));
+        iop_a_src = io2_a_src;
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      iop_a_src += self->private_data.s_skip_blocks[0].scratch;
+    }
+
+    ok:
+    self->private_impl.p_skip_blocks[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_skip_blocks[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func gif.decoder.decode_ae
+
+static wuffs_base__status
+wuffs_gif__decoder__decode_ae(
+    wuffs_gif__decoder* self,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t v_c = 0;
+  uint8_t v_block_size = 0;
+  bool v_is_animexts = false;
+  bool v_is_netscape = false;
+  bool v_is_iccp = false;
+  bool v_is_xmp = false;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_ae[0];
+  if (coro_susp_point) {
+    v_block_size = self->private_data.s_decode_ae[0].v_block_size;
+    v_is_animexts = self->private_data.s_decode_ae[0].v_is_animexts;
+    v_is_netscape = self->private_data.s_decode_ae[0].v_is_netscape;
+    v_is_iccp = self->private_data.s_decode_ae[0].v_is_iccp;
+    v_is_xmp = self->private_data.s_decode_ae[0].v_is_xmp;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    while (true) {
+      if (self->private_impl.f_metadata_fourcc != 0) {
+        status = wuffs_base__make_status(wuffs_base__note__metadata_reported);
+        goto ok;
+      }
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint8_t t_0 = *iop_a_src++;
+        v_block_size = t_0;
+      }
+      if (v_block_size == 0) {
+        status = wuffs_base__make_status(NULL);
+        goto ok;
+      }
+      if (v_block_size != 11) {
+        self->private_data.s_decode_ae[0].scratch = ((uint32_t)(v_block_size));
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        if (self->private_data.s_decode_ae[0].scratch > ((uint64_t)(io2_a_src - iop_a_src))) {
+          self->private_data.s_decode_ae[0].scratch -= ((uint64_t)(io2_a_src - iop_a_src));
+          iop_a_src = io2_a_src;
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        iop_a_src += self->private_data.s_decode_ae[0].scratch;
+        goto label__goto_done__break;
+      }
+      v_is_animexts = true;
+      v_is_netscape = true;
+      v_is_iccp = true;
+      v_is_xmp = true;
+      v_block_size = 0;
+      while (v_block_size < 11) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint8_t t_1 = *iop_a_src++;
+          v_c = t_1;
+        }
+        v_is_animexts = (v_is_animexts && (v_c == WUFFS_GIF__ANIMEXTS1DOT0[v_block_size]));
+        v_is_netscape = (v_is_netscape && (v_c == WUFFS_GIF__NETSCAPE2DOT0[v_block_size]));
+        v_is_iccp = (v_is_iccp && (v_c == WUFFS_GIF__ICCRGBG1012[v_block_size]));
+        v_is_xmp = (v_is_xmp && (v_c == WUFFS_GIF__XMPDATAXMP[v_block_size]));
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#endif
+        v_block_size += 1;
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+      }
+      if (v_is_animexts || v_is_netscape) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint8_t t_2 = *iop_a_src++;
+          v_block_size = t_2;
+        }
+        if (v_block_size != 3) {
+          self->private_data.s_decode_ae[0].scratch = ((uint32_t)(v_block_size));
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+          if (self->private_data.s_decode_ae[0].scratch > ((uint64_t)(io2_a_src - iop_a_src))) {
+            self->private_data.s_decode_ae[0].scratch -= ((uint64_t)(io2_a_src - iop_a_src));
+            iop_a_src = io2_a_src;
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          iop_a_src += self->private_data.s_decode_ae[0].scratch;
+          goto label__goto_done__break;
+        }
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint8_t t_3 = *iop_a_src++;
+          v_c = t_3;
+        }
+        if (v_c != 1) {
+          self->private_data.s_decode_ae[0].scratch = 2;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+          if (self->private_data.s_decode_ae[0].scratch > ((uint64_t)(io2_a_src - iop_a_src))) {
+            self->private_data.s_decode_ae[0].scratch -= ((uint64_t)(io2_a_src - iop_a_src));
+            iop_a_src = io2_a_src;
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          iop_a_src += self->private_data.s_decode_ae[0].scratch;
+          goto label__goto_done__break;
+        }
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+          uint32_t t_4;
+          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+            t_4 = ((uint32_t)(wuffs_base__peek_u16le__no_bounds_check(iop_a_src)));
+            iop_a_src += 2;
+          } else {
+            self->private_data.s_decode_ae[0].scratch = 0;
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
+            while (true) {
+              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+                goto suspend;
+              }
+              uint64_t* scratch = &self->private_data.s_decode_ae[0].scratch;
+              uint32_t num_bits_4 = ((uint32_t)(*scratch >> 56));
+              *scratch <<= 8;
+              *scratch >>= 8;
+              *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_4;
+              if (num_bits_4 == 8) {
+                t_4 = ((uint32_t)(*scratch));
+                break;
+              }
+              num_bits_4 += 8;
+              *scratch |= ((uint64_t)(num_bits_4)) << 56;
+            }
+          }
+          self->private_impl.f_num_animation_loops_value = t_4;
+        }
+        self->private_impl.f_seen_num_animation_loops_value = true;
+        if ((0 < self->private_impl.f_num_animation_loops_value) && (self->private_impl.f_num_animation_loops_value <= 65535)) {
+          self->private_impl.f_num_animation_loops_value += 1;
+        }
+      } else if (self->private_impl.f_ignore_metadata) {
+      } else if (v_is_iccp && self->private_impl.f_report_metadata_iccp) {
+        self->private_impl.f_metadata_fourcc = 1229144912;
+        self->private_impl.f_metadata_io_position = wuffs_base__u64__sat_add((a_src ? a_src->meta.pos : 0), ((uint64_t)(iop_a_src - io0_a_src)));
+        self->private_impl.f_call_sequence = 1;
+        status = wuffs_base__make_status(wuffs_base__note__metadata_reported);
+        goto ok;
+      } else if (v_is_xmp && self->private_impl.f_report_metadata_xmp) {
+        self->private_impl.f_metadata_fourcc = 1481461792;
+        self->private_impl.f_metadata_io_position = wuffs_base__u64__sat_add((a_src ? a_src->meta.pos : 0), ((uint64_t)(iop_a_src - io0_a_src)));
+        self->private_impl.f_call_sequence = 1;
+        status = wuffs_base__make_status(wuffs_base__note__metadata_reported);
+        goto ok;
+      }
+      goto label__goto_done__break;
+    }
+    label__goto_done__break:;
+    if (a_src) {
+      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(10);
+    status = wuffs_gif__decoder__skip_blocks(self, a_src);
+    if (a_src) {
+      iop_a_src = a_src->data.ptr + a_src->meta.ri;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
+
+    ok:
+    self->private_impl.p_decode_ae[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_ae[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_decode_ae[0].v_block_size = v_block_size;
+  self->private_data.s_decode_ae[0].v_is_animexts = v_is_animexts;
+  self->private_data.s_decode_ae[0].v_is_netscape = v_is_netscape;
+  self->private_data.s_decode_ae[0].v_is_iccp = v_is_iccp;
+  self->private_data.s_decode_ae[0].v_is_xmp = v_is_xmp;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func gif.decoder.decode_gc
+
+static wuffs_base__status
+wuffs_gif__decoder__decode_gc(
+    wuffs_gif__decoder* self,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t v_c = 0;
+  uint8_t v_flags = 0;
+  uint16_t v_gc_duration_centiseconds = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_gc[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_0 = *iop_a_src++;
+      v_c = t_0;
+    }
+    if (v_c != 4) {
+      status = wuffs_base__make_status(wuffs_gif__error__bad_graphic_control);
+      goto exit;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_1 = *iop_a_src++;
+      v_flags = t_1;
+    }
+    self->private_impl.f_gc_has_transparent_index = ((v_flags & 1) != 0);
+    v_flags = ((v_flags >> 2) & 7);
+    if (v_flags == 2) {
+      self->private_impl.f_gc_disposal = 1;
+    } else if ((v_flags == 3) || (v_flags == 4)) {
+      self->private_impl.f_gc_disposal = 2;
+    } else {
+      self->private_impl.f_gc_disposal = 0;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      uint16_t t_2;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_2 = wuffs_base__peek_u16le__no_bounds_check(iop_a_src);
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_gc[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_gc[0].scratch;
+          uint32_t num_bits_2 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_2;
+          if (num_bits_2 == 8) {
+            t_2 = ((uint16_t)(*scratch));
+            break;
+          }
+          num_bits_2 += 8;
+          *scratch |= ((uint64_t)(num_bits_2)) << 56;
+        }
+      }
+      v_gc_duration_centiseconds = t_2;
+    }
+    self->private_impl.f_gc_duration = (((uint64_t)(v_gc_duration_centiseconds)) * 7056000);
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_3 = *iop_a_src++;
+      self->private_impl.f_gc_transparent_index = t_3;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_4 = *iop_a_src++;
+      v_c = t_4;
+    }
+    if (v_c != 0) {
+      status = wuffs_base__make_status(wuffs_gif__error__bad_graphic_control);
+      goto exit;
+    }
+
+    goto ok;
+    ok:
+    self->private_impl.p_decode_gc[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_gc[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func gif.decoder.decode_id_part0
+
+static wuffs_base__status
+wuffs_gif__decoder__decode_id_part0(
+    wuffs_gif__decoder* self,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_id_part0[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      uint32_t t_0;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_0 = ((uint32_t)(wuffs_base__peek_u16le__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_id_part0[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
+          uint32_t num_bits_0 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_0;
+          if (num_bits_0 == 8) {
+            t_0 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_0 += 8;
+          *scratch |= ((uint64_t)(num_bits_0)) << 56;
+        }
+      }
+      self->private_impl.f_frame_rect_x0 = t_0;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      uint32_t t_1;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_1 = ((uint32_t)(wuffs_base__peek_u16le__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_id_part0[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
+          uint32_t num_bits_1 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_1;
+          if (num_bits_1 == 8) {
+            t_1 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_1 += 8;
+          *scratch |= ((uint64_t)(num_bits_1)) << 56;
+        }
+      }
+      self->private_impl.f_frame_rect_y0 = t_1;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+      uint32_t t_2;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_2 = ((uint32_t)(wuffs_base__peek_u16le__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_id_part0[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
+          uint32_t num_bits_2 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_2;
+          if (num_bits_2 == 8) {
+            t_2 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_2 += 8;
+          *scratch |= ((uint64_t)(num_bits_2)) << 56;
+        }
+      }
+      self->private_impl.f_frame_rect_x1 = t_2;
+    }
+    self->private_impl.f_frame_rect_x1 += self->private_impl.f_frame_rect_x0;
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+      uint32_t t_3;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_3 = ((uint32_t)(wuffs_base__peek_u16le__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_id_part0[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
+          uint32_t num_bits_3 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_3;
+          if (num_bits_3 == 8) {
+            t_3 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_3 += 8;
+          *scratch |= ((uint64_t)(num_bits_3)) << 56;
+        }
+      }
+      self->private_impl.f_frame_rect_y1 = t_3;
+    }
+    self->private_impl.f_frame_rect_y1 += self->private_impl.f_frame_rect_y0;
+    self->private_impl.f_dst_x = self->private_impl.f_frame_rect_x0;
+    self->private_impl.f_dst_y = self->private_impl.f_frame_rect_y0;
+    if ((self->private_impl.f_call_sequence == 0) &&  ! self->private_impl.f_quirks[4]) {
+      self->private_impl.f_width = wuffs_base__u32__max(self->private_impl.f_width, self->private_impl.f_frame_rect_x1);
+      self->private_impl.f_height = wuffs_base__u32__max(self->private_impl.f_height, self->private_impl.f_frame_rect_y1);
+    }
+
+    goto ok;
+    ok:
+    self->private_impl.p_decode_id_part0[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_id_part0[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func gif.decoder.decode_id_part1
+
+static wuffs_base__status
+wuffs_gif__decoder__decode_id_part1(
+    wuffs_gif__decoder* self,
+    wuffs_base__pixel_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__pixel_blend a_blend) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t v_flags = 0;
+  uint8_t v_which_palette = 0;
+  uint32_t v_num_palette_entries = 0;
+  uint32_t v_i = 0;
+  uint32_t v_argb = 0;
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  uint8_t v_lw = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_id_part1[0];
+  if (coro_susp_point) {
+    v_num_palette_entries = self->private_data.s_decode_id_part1[0].v_num_palette_entries;
+    v_i = self->private_data.s_decode_id_part1[0].v_i;
+    v_which_palette = self->private_data.s_decode_id_part1[0].v_which_palette;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_0 = *iop_a_src++;
+      v_flags = t_0;
+    }
+    if ((v_flags & 64) != 0) {
+      self->private_impl.f_interlace = 4;
+    } else {
+      self->private_impl.f_interlace = 0;
+    }
+    v_which_palette = 1;
+    if ((v_flags & 128) != 0) {
+      v_num_palette_entries = (((uint32_t)(1)) << (1 + (v_flags & 7)));
+      v_i = 0;
+      while (v_i < v_num_palette_entries) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+          uint32_t t_1;
+          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 3)) {
+            t_1 = ((uint32_t)(wuffs_base__peek_u24be__no_bounds_check(iop_a_src)));
+            iop_a_src += 3;
+          } else {
+            self->private_data.s_decode_id_part1[0].scratch = 0;
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+            while (true) {
+              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+                goto suspend;
+              }
+              uint64_t* scratch = &self->private_data.s_decode_id_part1[0].scratch;
+              uint32_t num_bits_1 = ((uint32_t)(*scratch & 0xFF));
+              *scratch >>= 8;
+              *scratch <<= 8;
+              *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_1);
+              if (num_bits_1 == 16) {
+                t_1 = ((uint32_t)(*scratch >> 40));
+                break;
+              }
+              num_bits_1 += 8;
+              *scratch |= ((uint64_t)(num_bits_1));
+            }
+          }
+          v_argb = t_1;
+        }
+        v_argb |= 4278190080;
+        self->private_data.f_palettes[1][((4 * v_i) + 0)] = ((uint8_t)(((v_argb >> 0) & 255)));
+        self->private_data.f_palettes[1][((4 * v_i) + 1)] = ((uint8_t)(((v_argb >> 8) & 255)));
+        self->private_data.f_palettes[1][((4 * v_i) + 2)] = ((uint8_t)(((v_argb >> 16) & 255)));
+        self->private_data.f_palettes[1][((4 * v_i) + 3)] = ((uint8_t)(((v_argb >> 24) & 255)));
+        v_i += 1;
+      }
+      while (v_i < 256) {
+        self->private_data.f_palettes[1][((4 * v_i) + 0)] = 0;
+        self->private_data.f_palettes[1][((4 * v_i) + 1)] = 0;
+        self->private_data.f_palettes[1][((4 * v_i) + 2)] = 0;
+        self->private_data.f_palettes[1][((4 * v_i) + 3)] = 255;
+        v_i += 1;
+      }
+    } else if (self->private_impl.f_quirks[6] &&  ! self->private_impl.f_has_global_palette) {
+      status = wuffs_base__make_status(wuffs_gif__error__bad_palette);
+      goto exit;
+    } else if (self->private_impl.f_gc_has_transparent_index) {
+      wuffs_base__slice_u8__copy_from_slice(wuffs_base__make_slice_u8(self->private_data.f_palettes[1], 1024), wuffs_base__make_slice_u8(self->private_data.f_palettes[0], 1024));
+    } else {
+      v_which_palette = 0;
+    }
+    if (self->private_impl.f_gc_has_transparent_index) {
+      self->private_data.f_palettes[1][((4 * ((uint32_t)(self->private_impl.f_gc_transparent_index))) + 0)] = 0;
+      self->private_data.f_palettes[1][((4 * ((uint32_t)(self->private_impl.f_gc_transparent_index))) + 1)] = 0;
+      self->private_data.f_palettes[1][((4 * ((uint32_t)(self->private_impl.f_gc_transparent_index))) + 2)] = 0;
+      self->private_data.f_palettes[1][((4 * ((uint32_t)(self->private_impl.f_gc_transparent_index))) + 3)] = 0;
+    }
+    v_status = wuffs_base__pixel_swizzler__prepare(&self->private_impl.f_swizzler,
+        wuffs_base__pixel_buffer__pixel_format(a_dst),
+        wuffs_base__pixel_buffer__palette_or_else(a_dst, wuffs_base__make_slice_u8(self->private_data.f_dst_palette, 1024)),
+        wuffs_base__utility__make_pixel_format(2198077448),
+        wuffs_base__make_slice_u8(self->private_data.f_palettes[v_which_palette], 1024),
+        a_blend);
+    if ( ! wuffs_base__status__is_ok(&v_status)) {
+      status = v_status;
+      if (wuffs_base__status__is_error(&status)) {
+        goto exit;
+      } else if (wuffs_base__status__is_suspension(&status)) {
+        status = wuffs_base__make_status(wuffs_base__error__cannot_return_a_suspension);
+        goto exit;
+      }
+      goto ok;
+    }
+    if (self->private_impl.f_previous_lzw_decode_ended_abruptly) {
+      wuffs_base__ignore_status(wuffs_lzw__decoder__initialize(&self->private_data.f_lzw,
+          sizeof (wuffs_lzw__decoder), WUFFS_VERSION, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_2 = *iop_a_src++;
+      v_lw = t_2;
+    }
+    if (v_lw > 8) {
+      status = wuffs_base__make_status(wuffs_gif__error__bad_literal_width);
+      goto exit;
+    }
+    wuffs_lzw__decoder__set_literal_width(&self->private_data.f_lzw, ((uint32_t)(v_lw)));
+    self->private_impl.f_previous_lzw_decode_ended_abruptly = true;
+
+    ok:
+    self->private_impl.p_decode_id_part1[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_id_part1[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_decode_id_part1[0].v_num_palette_entries = v_num_palette_entries;
+  self->private_data.s_decode_id_part1[0].v_i = v_i;
+  self->private_data.s_decode_id_part1[0].v_which_palette = v_which_palette;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func gif.decoder.decode_id_part2
+
+static wuffs_base__status
+wuffs_gif__decoder__decode_id_part2(
+    wuffs_gif__decoder* self,
+    wuffs_base__pixel_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf) {
+  wuffs_base__io_buffer empty_io_buffer = wuffs_base__empty_io_buffer();
+
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint64_t v_block_size = 0;
+  bool v_need_block_size = false;
+  uint32_t v_n_copied = 0;
+  uint64_t v_n_compressed = 0;
+  wuffs_base__io_buffer u_r = wuffs_base__empty_io_buffer();
+  wuffs_base__io_buffer* v_r = &u_r;
+  const uint8_t* iop_v_r WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io0_v_r WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_v_r WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_v_r WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint64_t v_mark = 0;
+  wuffs_base__status v_lzw_status = wuffs_base__make_status(NULL);
+  wuffs_base__status v_copy_status = wuffs_base__make_status(NULL);
+  wuffs_base__slice_u8 v_uncompressed = {0};
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_id_part2[0];
+  if (coro_susp_point) {
+    v_block_size = self->private_data.s_decode_id_part2[0].v_block_size;
+    v_lzw_status = self->private_data.s_decode_id_part2[0].v_lzw_status;
+    v_need_block_size = self->private_data.s_decode_id_part2[0].v_need_block_size;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    v_need_block_size = true;
+    label__outer__continue:;
+    while (true) {
+      if (v_need_block_size) {
+        v_need_block_size = false;
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t t_0 = *iop_a_src++;
+          v_block_size = t_0;
+        }
+      }
+      if (v_block_size == 0) {
+        goto label__outer__break;
+      }
+      while (((uint64_t)(io2_a_src - iop_a_src)) == 0) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(2);
+      }
+      if (self->private_impl.f_compressed_ri == self->private_impl.f_compressed_wi) {
+        self->private_impl.f_compressed_ri = 0;
+        self->private_impl.f_compressed_wi = 0;
+      }
+      while (self->private_impl.f_compressed_wi <= 3841) {
+        v_n_compressed = wuffs_base__u64__min(v_block_size, ((uint64_t)(io2_a_src - iop_a_src)));
+        if (v_n_compressed <= 0) {
+          goto label__0__break;
+        }
+        v_n_copied = wuffs_base__io_reader__limited_copy_u32_to_slice(
+            &iop_a_src, io2_a_src,((uint32_t)((v_n_compressed & 4294967295))), wuffs_base__slice_u8__subslice_i(wuffs_base__make_slice_u8(self->private_data.f_compressed, 4096), self->private_impl.f_compressed_wi));
+        wuffs_base__u64__sat_add_indirect(&self->private_impl.f_compressed_wi, ((uint64_t)(v_n_copied)));
+        wuffs_base__u64__sat_sub_indirect(&v_block_size, ((uint64_t)(v_n_copied)));
+        if (v_block_size > 0) {
+          goto label__0__break;
+        }
+        if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+          v_need_block_size = true;
+          goto label__0__break;
+        }
+        v_block_size = ((uint64_t)(wuffs_base__peek_u8be__no_bounds_check(iop_a_src)));
+        iop_a_src += 1;
+      }
+      label__0__break:;
+      label__inner__continue:;
+      while (true) {
+        if ((self->private_impl.f_compressed_ri > self->private_impl.f_compressed_wi) || (self->private_impl.f_compressed_wi > 4096)) {
+          status = wuffs_base__make_status(wuffs_gif__error__internal_error_inconsistent_ri_wi);
+          goto exit;
+        }
+        {
+          wuffs_base__io_buffer* o_0_v_r = v_r;
+          const uint8_t *o_0_iop_v_r = iop_v_r;
+          const uint8_t *o_0_io0_v_r = io0_v_r;
+          const uint8_t *o_0_io1_v_r = io1_v_r;
+          const uint8_t *o_0_io2_v_r = io2_v_r;
+          v_r = wuffs_base__io_reader__set(
+              &u_r,
+              &iop_v_r,
+              &io0_v_r,
+              &io1_v_r,
+              &io2_v_r,
+              wuffs_base__slice_u8__subslice_ij(wuffs_base__make_slice_u8(self->private_data.f_compressed,
+              4096),
+              self->private_impl.f_compressed_ri,
+              self->private_impl.f_compressed_wi),
+              0);
+          v_mark = ((uint64_t)(iop_v_r - io0_v_r));
+          {
+            u_r.meta.ri = ((size_t)(iop_v_r - u_r.data.ptr));
+            wuffs_base__status t_1 = wuffs_lzw__decoder__transform_io(&self->private_data.f_lzw, &empty_io_buffer, v_r, wuffs_base__utility__empty_slice_u8());
+            v_lzw_status = t_1;
+            iop_v_r = u_r.data.ptr + u_r.meta.ri;
+          }
+          wuffs_base__u64__sat_add_indirect(&self->private_impl.f_compressed_ri, wuffs_base__io__count_since(v_mark, ((uint64_t)(iop_v_r - io0_v_r))));
+          v_r = o_0_v_r;
+          iop_v_r = o_0_iop_v_r;
+          io0_v_r = o_0_io0_v_r;
+          io1_v_r = o_0_io1_v_r;
+          io2_v_r = o_0_io2_v_r;
+        }
+        v_uncompressed = wuffs_lzw__decoder__flush(&self->private_data.f_lzw);
+        if (((uint64_t)(v_uncompressed.len)) > 0) {
+          v_copy_status = wuffs_gif__decoder__copy_to_image_buffer(self, a_dst, v_uncompressed, a_workbuf);
+          if (wuffs_base__status__is_error(&v_copy_status)) {
+            status = v_copy_status;
+            goto exit;
+          }
+        }
+        if (wuffs_base__status__is_ok(&v_lzw_status)) {
+          self->private_impl.f_previous_lzw_decode_ended_abruptly = false;
+          if (v_need_block_size || (v_block_size > 0)) {
+            self->private_data.s_decode_id_part2[0].scratch = ((uint32_t)(v_block_size));
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+            if (self->private_data.s_decode_id_part2[0].scratch > ((uint64_t)(io2_a_src - iop_a_src))) {
+              self->private_data.s_decode_id_part2[0].scratch -= ((uint64_t)(io2_a_src - iop_a_src));
+              iop_a_src = io2_a_src;
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            iop_a_src += self->private_data.s_decode_id_part2[0].scratch;
+            if (a_src) {
+              a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+            }
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+            status = wuffs_gif__decoder__skip_blocks(self, a_src);
+            if (a_src) {
+              iop_a_src = a_src->data.ptr + a_src->meta.ri;
+            }
+            if (status.repr) {
+              goto suspend;
+            }
+          }
+          goto label__outer__break;
+        } else if (v_lzw_status.repr == wuffs_base__suspension__short_read) {
+          goto label__outer__continue;
+        } else if (v_lzw_status.repr == wuffs_base__suspension__short_write) {
+          goto label__inner__continue;
+        } else if (self->private_impl.f_quirks[3] && (self->private_impl.f_dst_y >= self->private_impl.f_frame_rect_y1) && (self->private_impl.f_interlace == 0)) {
+          if (v_need_block_size || (v_block_size > 0)) {
+            self->private_data.s_decode_id_part2[0].scratch = ((uint32_t)(v_block_size));
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+            if (self->private_data.s_decode_id_part2[0].scratch > ((uint64_t)(io2_a_src - iop_a_src))) {
+              self->private_data.s_decode_id_part2[0].scratch -= ((uint64_t)(io2_a_src - iop_a_src));
+              iop_a_src = io2_a_src;
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            iop_a_src += self->private_data.s_decode_id_part2[0].scratch;
+            if (a_src) {
+              a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+            }
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+            status = wuffs_gif__decoder__skip_blocks(self, a_src);
+            if (a_src) {
+              iop_a_src = a_src->data.ptr + a_src->meta.ri;
+            }
+            if (status.repr) {
+              goto suspend;
+            }
+          }
+          goto label__outer__break;
+        }
+        status = v_lzw_status;
+        if (wuffs_base__status__is_error(&status)) {
+          goto exit;
+        } else if (wuffs_base__status__is_suspension(&status)) {
+          status = wuffs_base__make_status(wuffs_base__error__cannot_return_a_suspension);
+          goto exit;
+        }
+        goto ok;
+      }
+    }
+    label__outer__break:;
+    self->private_impl.f_compressed_ri = 0;
+    self->private_impl.f_compressed_wi = 0;
+    if ((self->private_impl.f_dst_y < self->private_impl.f_frame_rect_y1) && (self->private_impl.f_frame_rect_x0 != self->private_impl.f_frame_rect_x1) && (self->private_impl.f_frame_rect_y0 != self->private_impl.f_frame_rect_y1)) {
+      status = wuffs_base__make_status(wuffs_base__error__not_enough_data);
+      goto exit;
+    }
+
+    ok:
+    self->private_impl.p_decode_id_part2[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_id_part2[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_decode_id_part2[0].v_block_size = v_block_size;
+  self->private_data.s_decode_id_part2[0].v_lzw_status = v_lzw_status;
+  self->private_data.s_decode_id_part2[0].v_need_block_size = v_need_block_size;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func gif.decoder.copy_to_image_buffer
+
+static wuffs_base__status
+wuffs_gif__decoder__copy_to_image_buffer(
+    wuffs_gif__decoder* self,
+    wuffs_base__pixel_buffer* a_pb,
+    wuffs_base__slice_u8 a_src,
+    wuffs_base__slice_u8 a_workbuf) {
+  wuffs_base__slice_u8 v_dst = {0};
+  wuffs_base__slice_u8 v_src = {0};
+  uint64_t v_width_in_bytes = 0;
+  uint64_t v_n = 0;
+  uint64_t v_src_ri = 0;
+  wuffs_base__pixel_format v_pixfmt = {0};
+  uint32_t v_bytes_per_pixel = 0;
+  uint32_t v_bits_per_pixel = 0;
+  wuffs_base__table_u8 v_tab = {0};
+  uint64_t v_i = 0;
+  uint64_t v_j = 0;
+  uint32_t v_roi_x1 = 0;
+  uint32_t v_replicate_y0 = 0;
+  uint32_t v_replicate_y1 = 0;
+  wuffs_base__slice_u8 v_replicate_dst = {0};
+  wuffs_base__slice_u8 v_replicate_src = {0};
+  wuffs_base__slice_u8 v_downscale_scratch = {0};
+
+  v_pixfmt = wuffs_base__pixel_buffer__pixel_format(a_pb);
+  v_bits_per_pixel = wuffs_base__pixel_format__bits_per_pixel(&v_pixfmt);
+  if ((v_bits_per_pixel & 7) != 0) {
+    return wuffs_base__make_status(wuffs_base__error__unsupported_option);
+  }
+  v_bytes_per_pixel = (v_bits_per_pixel >> 3);
+  if ((self->private_impl.f_downscale_shift > 0) && (wuffs_base__pixel_format__is_indexed(&v_pixfmt) || (v_bits_per_pixel == 16) || (v_bits_per_pixel > 32))) {
+    return wuffs_base__make_status(wuffs_base__error__unsupported_option);
+  }
+  v_width_in_bytes = (((uint64_t)(((uint32_t)(self->private_impl.f_roi_x1 - self->private_impl.f_roi_x0)))) * ((uint64_t)(v_bytes_per_pixel)));
+  v_roi_x1 = wuffs_base__u32__min(self->private_impl.f_frame_rect_x1, self->private_impl.f_roi_x1);
+  v_tab = wuffs_base__pixel_buffer__plane(a_pb, 0);
+  if (self->private_impl.f_downscale_shift > 0) {
+    v_downscale_scratch = wuffs_base__slice_u8__suffix(a_workbuf, self->private_impl.f_downscale_workbuf_length);
+    v_downscale_scratch = wuffs_base__slice_u8__prefix(v_downscale_scratch, v_width_in_bytes);
+  }
+  label__0__continue:;
+  while (v_src_ri < ((uint64_t)(a_src.len))) {
+    v_src = wuffs_base__slice_u8__subslice_i(a_src, v_src_ri);
+    if (self->private_impl.f_dst_y >= self->private_impl.f_frame_rect_y1) {
+      if (self->private_impl.f_quirks[3]) {
+        return wuffs_base__make_status(NULL);
+      }
+      return wuffs_base__make_status(wuffs_base__error__too_much_data);
+    }
+    v_dst = wuffs_base__utility__empty_slice_u8();
+    if ((self->private_impl.f_roi_y0 <= self->private_impl.f_dst_y) && (self->private_impl.f_dst_y < self->private_impl.f_roi_y1) && (self->private_impl.f_roi_x0 <= self->private_impl.f_dst_x)) {
+      if (self->private_impl.f_downscale_shift == 0) {
+        v_dst = wuffs_base__table_u8__row_u32(v_tab, ((uint32_t)(self->private_impl.f_dst_y - self->private_impl.f_roi_y0)));
+      } else {
+        v_dst = v_downscale_scratch;
+      }
+      if (v_width_in_bytes < ((uint64_t)(v_dst.len))) {
+        v_dst = wuffs_base__slice_u8__subslice_j(v_dst, v_width_in_bytes);
+      }
+    }
+    v_i = (((uint64_t)(((uint32_t)(self->private_impl.f_dst_x - self->private_impl.f_roi_x0)))) * ((uint64_t)(v_bytes_per_pixel)));
+    if (v_i < ((uint64_t)(v_dst.len))) {
+      v_j = (((uint64_t)(((uint32_t)(v_roi_x1 - self->private_impl.f_roi_x0)))) * ((uint64_t)(v_bytes_per_pixel)));
+      if ((v_i <= v_j) && (v_j <= ((uint64_t)(v_dst.len)))) {
+        v_dst = wuffs_base__slice_u8__subslice_ij(v_dst, v_i, v_j);
+      } else {
+        v_dst = wuffs_base__slice_u8__subslice_i(v_dst, v_i);
+      }
+      v_n = wuffs_base__pixel_swizzler__swizzle_interleaved_from_slice(&self->private_impl.f_swizzler, v_dst, wuffs_base__make_slice_u8(self->private_data.f_dst_palette, 1024), v_src);
+      wuffs_base__u64__sat_add_indirect(&v_src_ri, v_n);
+      wuffs_base__u32__sat_add_indirect(&self->private_impl.f_dst_x, ((uint32_t)((v_n & 4294967295))));
+      self->private_impl.f_dirty_max_excl_y = wuffs_base__u32__max(self->private_impl.f_dirty_max_excl_y, wuffs_base__u32__sat_add(self->private_impl.f_dst_y, 1));
+    }
+    if (self->private_impl.f_frame_rect_x1 <= self->private_impl.f_dst_x) {
+      if (self->private_impl.f_downscale_shift > 0) {
+        wuffs_gif__decoder__downscale_row(self, a_pb, a_workbuf, v_bytes_per_pixel);
+      }
+      self->private_impl.f_dst_x = self->private_impl.f_frame_rect_x0;
+      if (self->private_impl.f_interlace == 0) {
+        wuffs_base__u32__sat_add_indirect(&self->private_impl.f_dst_y, 1);
+        goto label__0__continue;
+      }
+      if ((self->private_impl.f_num_decoded_frames_value == 0) &&
+          ! self->private_impl.f_gc_has_transparent_index &&
+          (self->private_impl.f_interlace > 1) &&
+          (self->private_impl.f_roi_y0 <= self->private_impl.f_dst_y) &&
+          (self->private_impl.f_dst_y < self->private_impl.f_roi_y1)) {
+        v_replicate_src = wuffs_base__table_u8__row_u32(v_tab, ((uint32_t)(self->private_impl.f_dst_y - self->private_impl.f_roi_y0)));
+        v_replicate_y0 = wuffs_base__u32__sat_add(self->private_impl.f_dst_y, 1);
+        v_replicate_y1 = wuffs_base__u32__sat_add(self->private_impl.f_dst_y, ((uint32_t)(WUFFS_GIF__INTERLACE_COUNT[self->private_impl.f_interlace])));
+        v_replicate_y1 = wuffs_base__u32__min(v_replicate_y1, self->private_impl.f_frame_rect_y1);
+        v_replicate_y1 = wuffs_base__u32__min(v_replicate_y1, self->private_impl.f_roi_y1);
+        while (v_replicate_y0 < v_replicate_y1) {
+          v_replicate_dst = wuffs_base__table_u8__row_u32(v_tab, ((uint32_t)(v_replicate_y0 - self->private_impl.f_roi_y0)));
+          wuffs_base__slice_u8__copy_from_slice(v_replicate_dst, v_replicate_src);
+          v_replicate_y0 += 1;
+        }
+        self->private_impl.f_dirty_max_excl_y = wuffs_base__u32__max(self->private_impl.f_dirty_max_excl_y, v_replicate_y1);
+      }
+      wuffs_base__u32__sat_add_indirect(&self->private_impl.f_dst_y, ((uint32_t)(WUFFS_GIF__INTERLACE_DELTA[self->private_impl.f_interlace])));
+      while ((self->private_impl.f_interlace > 0) && (self->private_impl.f_dst_y >= self->private_impl.f_frame_rect_y1)) {
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#endif
+        self->private_impl.f_interlace -= 1;
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+        self->private_impl.f_dst_y = wuffs_base__u32__sat_add(self->private_impl.f_frame_rect_y0, WUFFS_GIF__INTERLACE_START[self->private_impl.f_interlace]);
+      }
+      goto label__0__continue;
+    }
+    if (((uint64_t)(a_src.len)) == v_src_ri) {
+      goto label__0__break;
+    } else if (((uint64_t)(a_src.len)) < v_src_ri) {
+      return wuffs_base__make_status(wuffs_gif__error__internal_error_inconsistent_ri_wi);
+    }
+    v_n = ((uint64_t)((self->private_impl.f_frame_rect_x1 - self->private_impl.f_dst_x)));
+    if ((self->private_impl.f_roi_y0 <= self->private_impl.f_dst_y) && (self->private_impl.f_dst_y < self->private_impl.f_roi_y1) && (self->private_impl.f_dst_x < self->private_impl.f_roi_x0)) {
+      v_n = wuffs_base__u64__min(v_n, ((uint64_t)(((uint32_t)(self->private_impl.f_roi_x0 - self->private_impl.f_dst_x)))));
+    }
+    v_n = wuffs_base__u64__min(v_n, (((uint64_t)(a_src.len)) - v_src_ri));
+    wuffs_base__u64__sat_add_indirect(&v_src_ri, v_n);
+    wuffs_base__u32__sat_add_indirect(&self->private_impl.f_dst_x, ((uint32_t)((v_n & 4294967295))));
+    if (self->private_impl.f_frame_rect_x1 <= self->private_impl.f_dst_x) {
+      if (self->private_impl.f_downscale_shift > 0) {
+        wuffs_gif__decoder__downscale_row(self, a_pb, a_workbuf, v_bytes_per_pixel);
+      }
+      self->private_impl.f_dst_x = self->private_impl.f_frame_rect_x0;
+      wuffs_base__u32__sat_add_indirect(&self->private_impl.f_dst_y, ((uint32_t)(WUFFS_GIF__INTERLACE_DELTA[self->private_impl.f_interlace])));
+      while ((self->private_impl.f_interlace > 0) && (self->private_impl.f_dst_y >= self->private_impl.f_frame_rect_y1)) {
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#endif
+        self->private_impl.f_interlace -= 1;
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+        self->private_impl.f_dst_y = wuffs_base__u32__sat_add(self->private_impl.f_frame_rect_y0, WUFFS_GIF__INTERLACE_START[self->private_impl.f_interlace]);
+      }
+      goto label__0__continue;
+    }
+    if (v_src_ri < ((uint64_t)(a_src.len))) {
+      goto label__0__continue;
+    } else if (v_src_ri != ((uint64_t)(a_src.len))) {
+      return wuffs_base__make_status(wuffs_gif__error__internal_error_inconsistent_ri_wi);
+    }
+    goto label__0__break;
+  }
+  label__0__break:;
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func gif.decoder.downscale_row
+
+static wuffs_base__empty_struct
+wuffs_gif__decoder__downscale_row(
+    wuffs_gif__decoder* self,
+    wuffs_base__pixel_buffer* a_pb,
+    wuffs_base__slice_u8 a_workbuf,
+    uint32_t a_bytes_per_pixel) {
+  wuffs_base__slice_u8 v_ws = {0};
+  uint64_t v_n = 0;
+  uint32_t v_x0 = 0;
+  uint32_t v_x1 = 0;
+  uint64_t v_i = 0;
+  uint64_t v_j = 0;
+  uint32_t v_dy = 0;
+  wuffs_base__table_u8 v_tab = {0};
+
+  if ((self->private_impl.f_dst_y < self->private_impl.f_roi_y0) || (self->private_impl.f_roi_y1 <= self->private_impl.f_dst_y)) {
+    return wuffs_base__make_empty_struct();
+  }
+  v_ws = wuffs_base__slice_u8__suffix(a_workbuf, self->private_impl.f_downscale_workbuf_length);
+  v_n = (((uint64_t)(((uint32_t)(self->private_impl.f_roi_x1 - self->private_impl.f_roi_x0)))) * ((uint64_t)(a_bytes_per_pixel)));
+  v_x0 = ((uint32_t)(wuffs_base__u32__max(self->private_impl.f_frame_rect_x0, self->private_impl.f_roi_x0) - self->private_impl.f_roi_x0));
+  v_x1 = ((uint32_t)(wuffs_base__u32__min(self->private_impl.f_frame_rect_x1, self->private_impl.f_roi_x1) - self->private_impl.f_roi_x0));
+  v_i = (((uint64_t)(v_x0)) * ((uint64_t)(a_bytes_per_pixel)));
+  v_j = (((uint64_t)(v_x1)) * ((uint64_t)(a_bytes_per_pixel)));
+  if ((v_x0 >= v_x1) ||
+      (v_i > v_j) ||
+      (v_j > v_n) ||
+      (v_n > ((uint64_t)(v_ws.len)))) {
+    return wuffs_base__make_empty_struct();
+  }
+  wuffs_base__utility__downscale_accumulate(
+      wuffs_base__slice_u8__subslice_i(v_ws, v_n),
+      wuffs_base__slice_u8__subslice_ij(v_ws, v_i, v_j),
+      v_x0,
+      self->private_impl.f_downscale_num_rows,
+      a_bytes_per_pixel,
+      self->private_impl.f_downscale_shift);
+  self->private_impl.f_downscale_num_rows += 1;
+  v_dy = ((uint32_t)(self->private_impl.f_dst_y - self->private_impl.f_roi_y0));
+  if (((((uint32_t)(v_dy + 1)) & ((((uint32_t)(1)) << self->private_impl.f_downscale_shift) - 1)) != 0) && (((uint32_t)(self->private_impl.f_dst_y + 1)) < wuffs_base__u32__min(self->private_impl.f_frame_rect_y1, self->private_impl.f_roi_y1))) {
+    return wuffs_base__make_empty_struct();
+  }
+  v_tab = wuffs_base__pixel_buffer__plane(a_pb, 0);
+  wuffs_base__utility__downscale_flush(
+      wuffs_base__table_u8__row_u32(v_tab, (v_dy >> self->private_impl.f_downscale_shift)),
+      wuffs_base__slice_u8__subslice_i(v_ws, v_n),
+      v_x0,
+      v_x1,
+      self->private_impl.f_downscale_num_rows,
+      a_bytes_per_pixel,
+      self->private_impl.f_downscale_shift);
+  self->private_impl.f_downscale_num_rows = 0;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func gif.encoder.set_canvas
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_gif__encoder__set_canvas(
+    wuffs_gif__encoder* self,
+    uint32_t a_width,
+    uint32_t a_height) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (a_width > 65535 || a_height > 65535) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_canvas_width = a_width;
+  self->private_impl.f_canvas_height = a_height;
+  self->private_impl.f_has_canvas = ((a_width > 0) || (a_height > 0));
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func gif.encoder.set_loop_count
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_gif__encoder__set_loop_count(
+    wuffs_gif__encoder* self,
+    uint32_t a_n) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (a_n > 65535) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_loop_count = a_n;
+  self->private_impl.f_has_loop_count = true;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func gif.encoder.set_frame
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_gif__encoder__set_frame(
+    wuffs_gif__encoder* self,
+    uint32_t a_left,
+    uint32_t a_top,
+    uint64_t a_duration,
+    uint8_t a_disposal) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (a_left > 65535 || a_top > 65535) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_empty_struct();
+  }
+
+  uint64_t v_d = 0;
+
+  self->private_impl.f_frame_left = a_left;
+  self->private_impl.f_frame_top = a_top;
+  v_d = (wuffs_base__u64__sat_add(a_duration, 3528000) / 7056000);
+  self->private_impl.f_frame_delay = ((uint32_t)((wuffs_base__u64__min(v_d, 65535) & 65535)));
+  if (a_disposal == 1) {
+    self->private_impl.f_frame_disposal = 2;
+  } else if (a_disposal == 2) {
+    self->private_impl.f_frame_disposal = 3;
+  } else {
+    self->private_impl.f_frame_disposal = 0;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func gif.encoder.encode_frame
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_gif__encoder__encode_frame(
+    wuffs_gif__encoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__pixel_buffer* a_src) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+        ? wuffs_base__error__disabled_by_previous_error
+        : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst || !a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 1)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  wuffs_base__table_u8 v_tab = {0};
+  wuffs_base__slice_u8 v_row = {0};
+  uint64_t v_n = 0;
+
+  uint32_t coro_susp_point = self->private_impl.p_encode_frame[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    v_status = wuffs_gif__encoder__prepare_frame(self, a_src);
+    if ( ! wuffs_base__status__is_ok(&v_status)) {
+      status = v_status;
+      if (wuffs_base__status__is_error(&status)) {
+        goto exit;
+      } else if (wuffs_base__status__is_suspension(&status)) {
+        status = wuffs_base__make_status(wuffs_base__error__cannot_return_a_suspension);
+        goto exit;
+      }
+      goto ok;
+    }
+    self->private_impl.f_obuf_ri = 0;
+    self->private_impl.f_obuf_wi = 0;
+    if ( ! self->private_impl.f_header_written) {
+      self->private_impl.f_header_written = true;
+      wuffs_gif__encoder__put_header(self);
+    }
+    wuffs_gif__encoder__put_frame_header(self, a_src);
+    wuffs_gif__encoder__start_lzw(self);
+    while (self->private_impl.f_y < self->private_impl.f_height) {
+      v_tab = wuffs_base__pixel_buffer__plane(a_src, 0);
+      v_row = wuffs_base__table_u8__row_u32(v_tab, self->private_impl.f_y);
+      if (((uint64_t)(self->private_impl.f_width)) < ((uint64_t)(v_row.len))) {
+        v_row = wuffs_base__slice_u8__subslice_j(v_row, ((uint64_t)(self->private_impl.f_width)));
+      }
+      if (((uint64_t)(self->private_impl.f_x)) < ((uint64_t)(v_row.len))) {
+        v_n = wuffs_gif__encoder__compress(self, wuffs_base__slice_u8__subslice_i(v_row, ((uint64_t)(self->private_impl.f_x))));
+        wuffs_base__u32__sat_add_indirect(&self->private_impl.f_x, ((uint32_t)((v_n & 65535))));
+      }
+      if (self->private_impl.f_x >= self->private_impl.f_width) {
+        self->private_impl.f_x = 0;
+        self->private_impl.f_y += 1;
+      }
+      if (self->private_impl.f_obuf_wi >= 3584) {
+        wuffs_gif__encoder__end_block(self);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        status = wuffs_gif__encoder__write_obuf(self, a_dst);
+        if (status.repr) {
+          goto suspend;
+        }
+      }
+    }
+    wuffs_gif__encoder__finish_lzw(self);
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+    status = wuffs_gif__encoder__write_obuf(self, a_dst);
+    if (status.repr) {
+      goto suspend;
+    }
+    self->private_impl.f_frame_left = 0;
+    self->private_impl.f_frame_top = 0;
+    self->private_impl.f_frame_delay = 0;
+    self->private_impl.f_frame_disposal = 0;
+
+    ok:
+    self->private_impl.p_encode_frame[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_encode_frame[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine = wuffs_base__status__is_suspension(&status) ? 1 : 0;
+  WUFFS_BASE__STATS__ADD(self->private_impl, WUFFS_BASE__STATS__SUSPENSIONS,
+      wuffs_base__status__is_suspension(&status) ? 1u : 0u);
+
+  goto exit;
+  exit:
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func gif.encoder.encode_trailer
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_gif__encoder__encode_trailer(
+    wuffs_gif__encoder* self,
+    wuffs_base__io_buffer* a_dst) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+        ? wuffs_base__error__disabled_by_previous_error
+        : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 2)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t coro_susp_point = self->private_impl.p_encode_trailer[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    self->private_impl.f_obuf_ri = 0;
+    self->private_impl.f_obuf_wi = 0;
+    if ( ! self->private_impl.f_header_written) {
+      self->private_impl.f_header_written = true;
+      wuffs_gif__encoder__put_header(self);
+    }
+    wuffs_gif__encoder__put_u8(self, 59);
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+    status = wuffs_gif__encoder__write_obuf(self, a_dst);
+    if (status.repr) {
+      goto suspend;
+    }
+    self->private_impl.f_header_written = false;
+
+    goto ok;
+    ok:
+    self->private_impl.p_encode_trailer[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_encode_trailer[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine = wuffs_base__status__is_suspension(&status) ? 2 : 0;
+  WUFFS_BASE__STATS__ADD(self->private_impl, WUFFS_BASE__STATS__SUSPENSIONS,
+      wuffs_base__status__is_suspension(&status) ? 1u : 0u);
+
+  goto exit;
+  exit:
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func gif.encoder.prepare_frame
+
+static wuffs_base__status
+wuffs_gif__encoder__prepare_frame(
+    wuffs_gif__encoder* self,
+    wuffs_base__pixel_buffer* a_src) {
+  wuffs_base__pixel_format v_pixfmt = {0};
+  wuffs_base__table_u8 v_tab = {0};
+  wuffs_base__slice_u8 v_palette = {0};
+  uint64_t v_w = 0;
+  uint64_t v_h = 0;
+  uint32_t v_m = 0;
+  uint32_t v_i = 0;
+  uint64_t v_j = 0;
+
+  v_pixfmt = wuffs_base__pixel_buffer__pixel_format(a_src);
+  v_palette = wuffs_base__pixel_buffer__palette(a_src);
+  if ( ! wuffs_base__pixel_format__is_indexed(&v_pixfmt) || (wuffs_base__pixel_format__bits_per_pixel(&v_pixfmt) != 8) || (((uint64_t)(v_palette.len)) < 1024)) {
+    return wuffs_base__make_status(wuffs_base__error__unsupported_pixel_swizzler_option);
+  }
+  v_tab = wuffs_base__pixel_buffer__plane(a_src, 0);
+  v_w = ((uint64_t)(v_tab.width));
+  v_h = ((uint64_t)(v_tab.height));
+  if (v_w > 65535) {
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  } else if (v_h > 65535) {
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  self->private_impl.f_width = ((uint32_t)(v_w));
+  self->private_impl.f_height = ((uint32_t)(v_h));
+  if (((self->private_impl.f_width + self->private_impl.f_frame_left) > 65535) || ((self->private_impl.f_height + self->private_impl.f_frame_top) > 65535)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ( ! self->private_impl.f_header_written) {
+    if (self->private_impl.f_has_canvas) {
+    } else {
+      self->private_impl.f_canvas_width = (self->private_impl.f_width + self->private_impl.f_frame_left);
+      self->private_impl.f_canvas_height = (self->private_impl.f_height + self->private_impl.f_frame_top);
+    }
+  }
+  v_m = wuffs_gif__encoder__or_of_indexes(self, a_src);
+  self->private_impl.f_palette_bits = 1;
+  while ((self->private_impl.f_palette_bits < 8) && ((v_m >> self->private_impl.f_palette_bits) != 0)) {
+    self->private_impl.f_palette_bits += 1;
+  }
+  self->private_impl.f_literal_width = wuffs_base__u32__max(self->private_impl.f_palette_bits, 2);
+  self->private_impl.f_has_transparent = false;
+  self->private_impl.f_transparent_index = 0;
+  v_i = 0;
+  while (v_i < (((uint32_t)(1)) << self->private_impl.f_palette_bits)) {
+    v_j = ((uint64_t)(((4 * v_i) + 3)));
+    if (v_j >= ((uint64_t)(v_palette.len))) {
+      goto label__0__break;
+    } else if (v_palette.ptr[v_j] < 128) {
+      self->private_impl.f_has_transparent = true;
+      self->private_impl.f_transparent_index = ((uint8_t)((v_i & 255)));
+      goto label__0__break;
+    }
+    v_i += 1;
+  }
+  label__0__break:;
+  self->private_impl.f_x = 0;
+  self->private_impl.f_y = 0;
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func gif.encoder.or_of_indexes
+
+static uint32_t
+wuffs_gif__encoder__or_of_indexes(
+    const wuffs_gif__encoder* self,
+    wuffs_base__pixel_buffer* a_src) {
+  wuffs_base__table_u8 v_tab = {0};
+  wuffs_base__slice_u8 v_row = {0};
+  uint32_t v_y = 0;
+  uint8_t v_m = 0;
+  wuffs_base__slice_u8 v_p = {0};
+
+  v_tab = wuffs_base__pixel_buffer__plane(a_src, 0);
+  while (v_y < self->private_impl.f_height) {
+    v_row = wuffs_base__table_u8__row_u32(v_tab, v_y);
+    {
+      wuffs_base__slice_u8 i_slice_p = v_row;
+      v_p.ptr = i_slice_p.ptr;
+      v_p.len = 1;
+      uint8_t* i_end0_p = v_p.ptr + (((i_slice_p.len - (size_t)(v_p.ptr - i_slice_p.ptr)) / 16) * 16);
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_p.ptr < i_end0_p) {
+        v_m |= v_p.ptr[0];
+        v_p.ptr += 1;
+        v_m |= v_p.ptr[0];
+        v_p.ptr += 1;
+        v_m |= v_p.ptr[0];
+        v_p.ptr += 1;
+        v_m |= v_p.ptr[0];
+        v_p.ptr += 1;
+        v_m |= v_p.ptr[0];
+        v_p.ptr += 1;
+        v_m |= v_p.ptr[0];
+        v_p.ptr += 1;
+        v_m |= v_p.ptr[0];
+        v_p.ptr += 1;
+        v_m |= v_p.ptr[0];
+        v_p.ptr += 1;
+        v_m |= v_p.ptr[0];
+        v_p.ptr += 1;
+        v_m |= v_p.ptr[0];
+        v_p.ptr += 1;
+        v_m |= v_p.ptr[0];
+        v_p.ptr += 1;
+        v_m |= v_p.ptr[0];
+        v_p.ptr += 1;
+        v_m |= v_p.ptr[0];
+        v_p.ptr += 1;
+        v_m |= v_p.ptr[0];
+        v_p.ptr += 1;
+        v_m |= v_p.ptr[0];
+        v_p.ptr += 1;
+        v_m |= v_p.ptr[0];
+        v_p.ptr += 1;
+      }
+      v_p.len = 1;
+      uint8_t* i_end1_p = i_slice_p.ptr + i_slice_p.len;
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_p.ptr < i_end1_p) {
+        v_m |= v_p.ptr[0];
+        v_p.ptr += 1;
+      }
+      v_p.len = 0;
+    }
+    if (v_m >= 128) {
+      goto label__0__break;
+    }
+    v_y += 1;
+  }
+  label__0__break:;
+  return ((uint32_t)(v_m));
+}
+
+// -------- func gif.encoder.put_header
+
+static wuffs_base__empty_struct
+wuffs_gif__encoder__put_header(
+    wuffs_gif__encoder* self) {
+  uint32_t v_i = 0;
+
+  wuffs_gif__encoder__put_u8(self, 71);
+  wuffs_gif__encoder__put_u8(self, 73);
+  wuffs_gif__encoder__put_u8(self, 70);
+  wuffs_gif__encoder__put_u8(self, 56);
+  wuffs_gif__encoder__put_u8(self, 57);
+  wuffs_gif__encoder__put_u8(self, 97);
+  wuffs_gif__encoder__put_u16le(self, self->private_impl.f_canvas_width);
+  wuffs_gif__encoder__put_u16le(self, self->private_impl.f_canvas_height);
+  wuffs_gif__encoder__put_u8(self, 0);
+  wuffs_gif__encoder__put_u8(self, 0);
+  wuffs_gif__encoder__put_u8(self, 0);
+  if ( ! self->private_impl.f_has_loop_count) {
+    return wuffs_base__make_empty_struct();
+  }
+  wuffs_gif__encoder__put_u8(self, 33);
+  wuffs_gif__encoder__put_u8(self, 255);
+  wuffs_gif__encoder__put_u8(self, 11);
+  while (v_i < 11) {
+    wuffs_gif__encoder__put_u8(self, WUFFS_GIF__NETSCAPE2DOT0[v_i]);
+    v_i += 1;
+  }
+  wuffs_gif__encoder__put_u8(self, 3);
+  wuffs_gif__encoder__put_u8(self, 1);
+  wuffs_gif__encoder__put_u16le(self, self->private_impl.f_loop_count);
+  wuffs_gif__encoder__put_u8(self, 0);
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func gif.encoder.put_frame_header
+
+static wuffs_base__empty_struct
+wuffs_gif__encoder__put_frame_header(
+    wuffs_gif__encoder* self,
+    wuffs_base__pixel_buffer* a_src) {
+  wuffs_base__slice_u8 v_palette = {0};
+  wuffs_base__slice_u8 v_p = {0};
+  uint8_t v_flags = 0;
+
+  v_flags = (self->private_impl.f_frame_disposal << 2);
+  if (self->private_impl.f_has_transparent) {
+    v_flags |= 1;
+  }
+  wuffs_gif__encoder__put_u8(self, 33);
+  wuffs_gif__encoder__put_u8(self, 249);
+  wuffs_gif__encoder__put_u8(self, 4);
+  wuffs_gif__encoder__put_u8(self, v_flags);
+  wuffs_gif__encoder__put_u16le(self, self->private_impl.f_frame_delay);
+  wuffs_gif__encoder__put_u8(self, self->private_impl.f_transparent_index);
+  wuffs_gif__encoder__put_u8(self, 0);
+  wuffs_gif__encoder__put_u8(self, 44);
+  wuffs_gif__encoder__put_u16le(self, self->private_impl.f_frame_left);
+  wuffs_gif__encoder__put_u16le(self, self->private_impl.f_frame_top);
+  wuffs_gif__encoder__put_u16le(self, self->private_impl.f_width);
+  wuffs_gif__encoder__put_u16le(self, self->private_impl.f_height);
+  wuffs_gif__encoder__put_u8(self, (128 | ((uint8_t)((((uint32_t)(self->private_impl.f_palette_bits - 1)) & 7)))));
+  v_palette = wuffs_base__pixel_buffer__palette(a_src);
+  if (((uint64_t)(v_palette.len)) >= 1024) {
+    v_palette = wuffs_base__slice_u8__subslice_j(v_palette, (4 * (((uint64_t)(1)) << self->private_impl.f_palette_bits)));
+    {
+      wuffs_base__slice_u8 i_slice_p = v_palette;
+      v_p.ptr = i_slice_p.ptr;
+      v_p.len = 4;
+      uint8_t* i_end0_p = v_p.ptr + (((i_slice_p.len - (size_t)(v_p.ptr - i_slice_p.ptr)) / 4) * 4);
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_p.ptr < i_end0_p) {
+        wuffs_gif__encoder__put_u8(self, v_p.ptr[2]);
+        wuffs_gif__encoder__put_u8(self, v_p.ptr[1]);
+        wuffs_gif__encoder__put_u8(self, v_p.ptr[0]);
+        v_p.ptr += 4;
+      }
+      v_p.len = 0;
+    }
+  }
+  wuffs_gif__encoder__put_u8(self, ((uint8_t)((self->private_impl.f_literal_width & 255))));
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func gif.encoder.start_lzw
+
+static wuffs_base__empty_struct
+wuffs_gif__encoder__start_lzw(
+    wuffs_gif__encoder* self) {
+  self->private_impl.f_clear_code = (((uint32_t)(1)) << self->private_impl.f_literal_width);
+  self->private_impl.f_has_code = false;
+  self->private_impl.f_bits = 0;
+  self->private_impl.f_n_bits = 0;
+  self->private_impl.f_block_len = 0;
+  wuffs_gif__encoder__reset_table(self);
+  wuffs_gif__encoder__put_code(self, self->private_impl.f_clear_code);
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func gif.encoder.finish_lzw
+
+static wuffs_base__empty_struct
+wuffs_gif__encoder__finish_lzw(
+    wuffs_gif__encoder* self) {
+  if (self->private_impl.f_has_code) {
+    wuffs_gif__encoder__put_code(self, self->private_impl.f_code);
+    wuffs_gif__encoder__inc_hi(self);
+  }
+  wuffs_gif__encoder__put_code(self, (self->private_impl.f_clear_code + 1));
+  if ((self->private_impl.f_n_bits & 7) > 0) {
+    wuffs_gif__encoder__put_lzw_byte(self, ((uint8_t)((self->private_impl.f_bits & 255))));
+  }
+  wuffs_gif__encoder__end_block(self);
+  wuffs_gif__encoder__put_u8(self, 0);
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func gif.encoder.reset_table
+
+static wuffs_base__empty_struct
+wuffs_gif__encoder__reset_table(
+    wuffs_gif__encoder* self) {
+  uint32_t v_i = 0;
+
+  self->private_impl.f_hi = (self->private_impl.f_clear_code + 1);
+  self->private_impl.f_code_width = (self->private_impl.f_literal_width + 1);
+  while (v_i < 8192) {
+    self->private_data.f_hashes[v_i] = 0;
+    v_i += 1;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func gif.encoder.compress
+
+static uint64_t
+wuffs_gif__encoder__compress(
+    wuffs_gif__encoder* self,
+    wuffs_base__slice_u8 a_src) {
+  uint64_t v_i = 0;
+  uint32_t v_c = 0;
+  uint32_t v_key = 0;
+  uint32_t v_h = 0;
+  uint32_t v_e = 0;
+
+  label__0__continue:;
+  while (v_i < ((uint64_t)(a_src.len))) {
+    if (((self->private_impl.f_obuf_wi >= 3584) && (self->private_impl.f_block_len == 0)) || (self->private_impl.f_obuf_wi >= 4080)) {
+      goto label__0__break;
+    }
+    v_c = ((uint32_t)(a_src.ptr[v_i]));
+    v_i += 1;
+    if ( ! self->private_impl.f_has_code) {
+      self->private_impl.f_has_code = true;
+      self->private_impl.f_code = v_c;
+      goto label__0__continue;
+    }
+    v_key = ((self->private_impl.f_code << 8) | v_c);
+    v_h = (((uint32_t)(v_key * 2654435761)) >> 19);
+    while (true) {
+      v_e = self->private_data.f_hashes[v_h];
+      if ((v_e == 0) || ((v_e >> 12) == v_key)) {
+        goto label__1__break;
+      }
+      v_h = ((v_h + 1) & 8191);
+    }
+    label__1__break:;
+    if (v_e != 0) {
+      self->private_impl.f_code = (v_e & 4095);
+      goto label__0__continue;
+    }
+    wuffs_gif__encoder__put_code(self, self->private_impl.f_code);
+    self->private_impl.f_code = v_c;
+    wuffs_gif__encoder__inc_hi(self);
+    if (self->private_impl.f_hi > (self->private_impl.f_clear_code + 1)) {
+      self->private_data.f_hashes[v_h] = ((v_key << 12) | self->private_impl.f_hi);
+    }
+  }
+  label__0__break:;
+  return v_i;
+}
+
+// -------- func gif.encoder.inc_hi
+
+static wuffs_base__empty_struct
+wuffs_gif__encoder__inc_hi(
+    wuffs_gif__encoder* self) {
+  if (self->private_impl.f_hi < 4095) {
+    self->private_impl.f_hi += 1;
+  }
+  if ((self->private_impl.f_hi >= (((uint32_t)(1)) << self->private_impl.f_code_width)) && (self->private_impl.f_code_width < 12)) {
+    self->private_impl.f_code_width += 1;
+  }
+  if (self->private_impl.f_hi >= 4095) {
+    wuffs_gif__encoder__put_code(self, self->private_impl.f_clear_code);
+    wuffs_gif__encoder__reset_table(self);
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func gif.encoder.put_code
+
+static wuffs_base__empty_struct
+wuffs_gif__encoder__put_code(
+    wuffs_gif__encoder* self,
+    uint32_t a_code) {
+  uint64_t v_bits = 0;
+  uint32_t v_n_bits = 0;
+
+  v_bits = (self->private_impl.f_bits | ((uint64_t)(((uint64_t)(a_code)) << (self->private_impl.f_n_bits & 7))));
+  v_n_bits = ((self->private_impl.f_n_bits & 7) + self->private_impl.f_code_width);
+  while (v_n_bits >= 8) {
+    v_n_bits -= 8;
+    wuffs_gif__encoder__put_lzw_byte(self, ((uint8_t)((v_bits & 255))));
+    v_bits >>= 8;
+  }
+  self->private_impl.f_bits = v_bits;
+  self->private_impl.f_n_bits = v_n_bits;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func gif.encoder.put_lzw_byte
+
+static wuffs_base__empty_struct
+wuffs_gif__encoder__put_lzw_byte(
+    wuffs_gif__encoder* self,
+    uint8_t a_a) {
+  if (self->private_impl.f_block_len == 0) {
+    self->private_impl.f_block_start = self->private_impl.f_obuf_wi;
+    wuffs_gif__encoder__put_u8(self, 0);
+  }
+  wuffs_gif__encoder__put_u8(self, a_a);
+  if (self->private_impl.f_block_len < 255) {
+    self->private_impl.f_block_len += 1;
+  }
+  if (self->private_impl.f_block_len >= 255) {
+    wuffs_gif__encoder__end_block(self);
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func gif.encoder.end_block
+
+static wuffs_base__empty_struct
+wuffs_gif__encoder__end_block(
+    wuffs_gif__encoder* self) {
+  if ((self->private_impl.f_block_len > 0) && (self->private_impl.f_block_start < 4096)) {
+    self->private_data.f_obuf[self->private_impl.f_block_start] = ((uint8_t)((self->private_impl.f_block_len & 255)));
+  }
+  self->private_impl.f_block_len = 0;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func gif.encoder.write_obuf
+
+static wuffs_base__status
+wuffs_gif__encoder__write_obuf(
+    wuffs_gif__encoder* self,
+    wuffs_base__io_buffer* a_dst) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint64_t v_n = 0;
+  uint32_t v_t = 0;
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_write_obuf[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    while (self->private_impl.f_obuf_ri < self->private_impl.f_obuf_wi) {
+      v_n = wuffs_base__io_writer__copy_from_slice(&iop_a_dst, io2_a_dst,wuffs_base__slice_u8__subslice_ij(wuffs_base__make_slice_u8(self->private_data.f_obuf,
+          4096),
+          self->private_impl.f_obuf_ri,
+          self->private_impl.f_obuf_wi));
+      v_t = wuffs_base__u32__sat_add(self->private_impl.f_obuf_ri, ((uint32_t)((v_n & 65535))));
+      self->private_impl.f_obuf_ri = wuffs_base__u32__min(v_t, self->private_impl.f_obuf_wi);
+      if (self->private_impl.f_obuf_ri < self->private_impl.f_obuf_wi) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
+      }
+    }
+    self->private_impl.f_obuf_ri = 0;
+    self->private_impl.f_obuf_wi = 0;
+
+    ok:
+    self->private_impl.p_write_obuf[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_write_obuf[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+  exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func gif.encoder.put_u8
+
+static wuffs_base__empty_struct
+wuffs_gif__encoder__put_u8(
+    wuffs_gif__encoder* self,
+    uint8_t a_a) {
+  if (self->private_impl.f_obuf_wi < 4096) {
+    self->private_data.f_obuf[self->private_impl.f_obuf_wi] = a_a;
+    self->private_impl.f_obuf_wi += 1;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func gif.encoder.put_u16le
+
+static wuffs_base__empty_struct
+wuffs_gif__encoder__put_u16le(
+    wuffs_gif__encoder* self,
+    uint32_t a_a) {
+  wuffs_gif__encoder__put_u8(self, ((uint8_t)((a_a & 255))));
+  wuffs_gif__encoder__put_u8(self, ((uint8_t)((a_a >> 8))));
+  return wuffs_base__make_empty_struct();
+}
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__GIF)
+
+
+#endif  // WUFFS_IMPLEMENTATION
+
+// ¡ WUFFS MONOLITHIC RELEASE DISCARDS EVERYTHING BELOW.
+
+#endif  // WUFFS_INCLUDE_GUARD__GIF
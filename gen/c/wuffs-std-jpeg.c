@@ -0,0 +1,4651 @@
+#ifndef WUFFS_INCLUDE_GUARD__JPEG
+#define WUFFS_INCLUDE_GUARD__JPEG
+
+#if defined(WUFFS_IMPLEMENTATION) && !defined(WUFFS_CONFIG__MODULES)
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__JPEG
+#endif
+
+#include "./wuffs-base.c"
+
+// ¡ WUFFS MONOLITHIC RELEASE DISCARDS EVERYTHING ABOVE.
+
+
+// ---------------- Status Codes
+
+extern const char wuffs_jpeg__error__bad_dht_marker[];
+extern const char wuffs_jpeg__error__bad_dqt_marker[];
+extern const char wuffs_jpeg__error__bad_dri_marker[];
+extern const char wuffs_jpeg__error__bad_sof_marker[];
+extern const char wuffs_jpeg__error__bad_sos_marker[];
+extern const char wuffs_jpeg__error__bad_header[];
+extern const char wuffs_jpeg__error__bad_marker[];
+extern const char wuffs_jpeg__error__bad_huffman_code[];
+extern const char wuffs_jpeg__error__missing_huffman_table[];
+extern const char wuffs_jpeg__error__missing_quantization_table[];
+extern const char wuffs_jpeg__error__truncated_input[];
+extern const char wuffs_jpeg__error__unsupported_arithmetic_coding[];
+extern const char wuffs_jpeg__error__unsupported_color_model[];
+extern const char wuffs_jpeg__error__unsupported_fractional_sampling[];
+extern const char wuffs_jpeg__error__unsupported_hierarchical_coding[];
+extern const char wuffs_jpeg__error__unsupported_lossless_coding[];
+extern const char wuffs_jpeg__error__unsupported_marker[];
+extern const char wuffs_jpeg__error__unsupported_precision[];
+
+// ---------------- Public Consts
+
+// ---------------- Struct Declarations
+
+typedef struct wuffs_jpeg__decoder__struct wuffs_jpeg__decoder;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ---------------- Public Initializer Prototypes
+
+// For any given "wuffs_foo__bar* self", "wuffs_foo__bar__initialize(self,
+// etc)" should be called before any other "wuffs_foo__bar__xxx(self, etc)".
+//
+// Pass sizeof(*self) and WUFFS_VERSION for sizeof_star_self and wuffs_version.
+// Pass 0 (or some combination of WUFFS_INITIALIZE__XXX) for options.
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+wuffs_jpeg__decoder__initialize(
+    wuffs_jpeg__decoder* self,
+    size_t sizeof_star_self,
+    uint64_t wuffs_version,
+    uint32_t options);
+
+wuffs_base__stats
+wuffs_jpeg__decoder__stats(
+    const wuffs_jpeg__decoder* self);
+
+size_t
+sizeof__wuffs_jpeg__decoder();
+
+// ---------------- Allocs
+
+// These functions allocate and initialize Wuffs structs. They return NULL if
+// memory allocation fails. If they return non-NULL, there is no need to call
+// wuffs_foo__bar__initialize, but the caller is responsible for eventually
+// calling free on the returned pointer. That pointer is effectively a C++
+// std::unique_ptr<T, decltype(&free)>.
+
+wuffs_jpeg__decoder*
+wuffs_jpeg__decoder__alloc();
+
+static inline wuffs_base__image_decoder*
+wuffs_jpeg__decoder__alloc_as__wuffs_base__image_decoder() {
+  return (wuffs_base__image_decoder*)(wuffs_jpeg__decoder__alloc());
+}
+
+// ---------------- Upcasts
+
+static inline wuffs_base__image_decoder*
+wuffs_jpeg__decoder__upcast_as__wuffs_base__image_decoder(
+    wuffs_jpeg__decoder* p) {
+  return (wuffs_base__image_decoder*)p;
+}
+
+// ---------------- Public Function Prototypes
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_jpeg__decoder__set_quirk_enabled(
+    wuffs_jpeg__decoder* self,
+    uint32_t a_quirk,
+    bool a_enabled);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_jpeg__decoder__decode_image_config(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__image_config* a_dst,
+    wuffs_base__io_buffer* a_src);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_jpeg__decoder__decode_frame_config(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__frame_config* a_dst,
+    wuffs_base__io_buffer* a_src);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_jpeg__decoder__decode_frame(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__pixel_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__pixel_blend a_blend,
+    wuffs_base__slice_u8 a_workbuf,
+    wuffs_base__decode_frame_options* a_opts);
+
+WUFFS_BASE__MAYBE_STATIC bool
+wuffs_jpeg__decoder__can_decode_row_bands(
+    const wuffs_jpeg__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__rect_ie_u32
+wuffs_jpeg__decoder__frame_dirty_rect(
+    const wuffs_jpeg__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC uint32_t
+wuffs_jpeg__decoder__num_animation_loops(
+    const wuffs_jpeg__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC uint64_t
+wuffs_jpeg__decoder__num_decoded_frame_configs(
+    const wuffs_jpeg__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC uint64_t
+wuffs_jpeg__decoder__num_decoded_frames(
+    const wuffs_jpeg__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_jpeg__decoder__restart_frame(
+    wuffs_jpeg__decoder* self,
+    uint64_t a_index,
+    uint64_t a_io_position);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_jpeg__decoder__set_report_metadata(
+    wuffs_jpeg__decoder* self,
+    uint32_t a_fourcc,
+    bool a_report);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_jpeg__decoder__tell_me_more(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__more_information* a_minfo,
+    wuffs_base__io_buffer* a_src);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64
+wuffs_jpeg__decoder__workbuf_len(
+    const wuffs_jpeg__decoder* self);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+// ---------------- Struct Definitions
+
+// These structs' fields, and the sizeof them, are private implementation
+// details that aren't guaranteed to be stable across Wuffs versions.
+//
+// See https://en.wikipedia.org/wiki/Opaque_pointer#C
+
+#if defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
+
+struct wuffs_jpeg__decoder__struct {
+  // Do not access the private_impl's or private_data's fields directly. There
+  // is no API/ABI compatibility or safety guarantee if you do so. Instead, use
+  // the wuffs_foo__bar__baz functions.
+  //
+  // It is a struct, not a struct*, so that the outermost wuffs_foo__bar struct
+  // can be stack allocated when WUFFS_IMPLEMENTATION is defined.
+
+  struct {
+    uint32_t magic;
+    uint32_t active_coroutine;
+    wuffs_base__vtable vtable_for__wuffs_base__image_decoder;
+    wuffs_base__vtable null_vtable;
+#if defined(WUFFS_CONFIG__STATS)
+    wuffs_base__stats stats;
+#endif  // defined(WUFFS_CONFIG__STATS)
+
+    uint32_t f_width;
+    uint32_t f_height;
+    uint32_t f_width_in_mcus;
+    uint32_t f_height_in_mcus;
+    uint8_t f_call_sequence;
+    bool f_is_jfif;
+    bool f_is_adobe;
+    uint8_t f_adobe_transform;
+    bool f_is_progressive;
+    uint32_t f_src_pixfmt;
+    uint32_t f_payload_length;
+    uint32_t f_num_components;
+    uint8_t f_components_c[3];
+    uint8_t f_components_h[3];
+    uint8_t f_components_v[3];
+    uint8_t f_components_tq[3];
+    uint32_t f_max_incl_components_h;
+    uint32_t f_max_incl_components_v;
+    uint64_t f_workbuf_offsets[8];
+    uint64_t f_frame_config_io_position;
+    uint8_t f_quant_tables_defined;
+    uint8_t f_huff_tables_defined;
+    uint32_t f_restart_interval;
+    uint32_t f_restarts_remaining;
+    uint32_t f_next_restart_marker;
+    uint32_t f_scan_num_components;
+    uint8_t f_scan_comps_cselector[3];
+    uint8_t f_scan_comps_td[3];
+    uint8_t f_scan_comps_ta[3];
+    uint32_t f_scan_ss;
+    uint32_t f_scan_se;
+    uint32_t f_scan_ah;
+    uint32_t f_scan_al;
+    uint32_t f_scan_width_in_mcus;
+    uint32_t f_scan_height_in_mcus;
+    uint32_t f_mcu_num_blocks;
+    uint8_t f_mcu_blocks_cselector[10];
+    uint8_t f_mcu_blocks_dc_hselector[10];
+    uint8_t f_mcu_blocks_ac_hselector[10];
+    uint8_t f_mcu_blocks_mx_mul[10];
+    uint8_t f_mcu_blocks_mx_add[10];
+    uint8_t f_mcu_blocks_my_mul[10];
+    uint8_t f_mcu_blocks_my_add[10];
+    uint16_t f_mcu_previous_dc_values[3];
+    uint32_t f_eob_run;
+    uint64_t f_bitstream_bits;
+    uint32_t f_bitstream_n_bits;
+    uint32_t f_bitstream_ri;
+    uint32_t f_bitstream_wi;
+    bool f_bitstream_is_closed;
+    uint32_t f_roi_x0;
+    uint32_t f_roi_y0;
+    uint32_t f_roi_x1;
+    uint32_t f_roi_y1;
+    uint32_t f_band_height;
+    uint32_t f_band_y0;
+    uint32_t f_band_y1;
+    wuffs_base__pixel_swizzler f_swizzler;
+
+    uint32_t p_decode_dht[1];
+    uint32_t p_decode_sos[1];
+    uint32_t p_prepare_scan[1];
+    uint32_t p_skip_past_restart_marker[1];
+    uint32_t p_decode_image_config[1];
+    uint32_t p_decode_other_marker[1];
+    uint32_t p_decode_appn[1];
+    uint32_t p_decode_dqt[1];
+    uint32_t p_decode_dri[1];
+    uint32_t p_decode_sof[1];
+    uint32_t p_decode_frame_config[1];
+    uint32_t p_decode_frame[1];
+  } private_impl;
+
+  struct {
+    uint16_t f_quant_tables[4][64];
+    uint16_t f_huff_tables_fast[8][256];
+    uint32_t f_huff_tables_limits[8][17];
+    uint32_t f_huff_tables_offsets[8][17];
+    uint8_t f_huff_tables_symbols[8][256];
+    uint8_t f_bitstream_buffer[8192];
+    uint16_t f_mcu_blocks[1][64];
+    uint8_t f_dht_temp_counts[16];
+
+    struct {
+      uint32_t v_tc4_th;
+      uint32_t v_total;
+      uint32_t v_num_symbols;
+      uint32_t v_i;
+    } s_decode_dht[1];
+    struct {
+      uint32_t v_mx;
+      uint32_t v_my;
+    } s_decode_sos[1];
+    struct {
+      uint32_t v_ss;
+      uint32_t v_se;
+      uint32_t v_i;
+      uint8_t v_c;
+      uint8_t v_cselector;
+    } s_prepare_scan[1];
+    struct {
+      uint64_t scratch;
+      uint8_t v_c;
+      uint8_t v_marker;
+    } s_decode_image_config[1];
+    struct {
+      uint64_t scratch;
+    } s_decode_other_marker[1];
+    struct {
+      uint64_t scratch;
+    } s_decode_appn[1];
+    struct {
+      uint64_t scratch;
+      uint32_t v_i;
+      uint8_t v_q;
+    } s_decode_dqt[1];
+    struct {
+      uint64_t scratch;
+    } s_decode_dri[1];
+    struct {
+      uint64_t scratch;
+      uint64_t v_offset;
+      uint32_t v_i;
+      uint32_t v_num_blocks;
+    } s_decode_sof[1];
+    struct {
+      uint64_t scratch;
+      uint8_t v_c;
+      uint8_t v_marker;
+    } s_decode_frame[1];
+  } private_data;
+
+#ifdef __cplusplus
+#if defined(WUFFS_BASE__HAVE_UNIQUE_PTR)
+  using unique_ptr = std::unique_ptr<wuffs_jpeg__decoder, decltype(&free)>;
+
+  // On failure, the alloc_etc functions return nullptr. They don't throw.
+
+  static inline unique_ptr
+  alloc() {
+    return unique_ptr(wuffs_jpeg__decoder__alloc(), &free);
+  }
+
+  static inline wuffs_base__image_decoder::unique_ptr
+  alloc_as__wuffs_base__image_decoder() {
+    return wuffs_base__image_decoder::unique_ptr(
+        wuffs_jpeg__decoder__alloc_as__wuffs_base__image_decoder(), &free);
+  }
+#endif  // defined(WUFFS_BASE__HAVE_UNIQUE_PTR)
+
+#if defined(WUFFS_BASE__HAVE_EQ_DELETE) && !defined(WUFFS_IMPLEMENTATION)
+  // Disallow constructing or copying an object via standard C++ mechanisms,
+  // e.g. the "new" operator, as this struct is intentionally opaque. Its total
+  // size and field layout is not part of the public, stable, memory-safe API.
+  // Use malloc or memcpy and the sizeof__wuffs_foo__bar function instead, and
+  // call wuffs_foo__bar__baz methods (which all take a "this"-like pointer as
+  // their first argument) rather than tweaking bar.private_impl.qux fields.
+  //
+  // In C, we can just leave wuffs_foo__bar as an incomplete type (unless
+  // WUFFS_IMPLEMENTATION is #define'd). In C++, we define a complete type in
+  // order to provide convenience methods. These forward on "this", so that you
+  // can write "bar->baz(etc)" instead of "wuffs_foo__bar__baz(bar, etc)".
+  wuffs_jpeg__decoder__struct() = delete;
+  wuffs_jpeg__decoder__struct(const wuffs_jpeg__decoder__struct&) = delete;
+  wuffs_jpeg__decoder__struct& operator=(
+      const wuffs_jpeg__decoder__struct&) = delete;
+#endif  // defined(WUFFS_BASE__HAVE_EQ_DELETE) && !defined(WUFFS_IMPLEMENTATION)
+
+#if !defined(WUFFS_IMPLEMENTATION)
+  // As above, the size of the struct is not part of the public API, and unless
+  // WUFFS_IMPLEMENTATION is #define'd, this struct type T should be heap
+  // allocated, not stack allocated. Its size is not intended to be known at
+  // compile time, but it is unfortunately divulged as a side effect of
+  // defining C++ convenience methods. Use "sizeof__T()", calling the function,
+  // instead of "sizeof T", invoking the operator. To make the two values
+  // different, so that passing the latter will be rejected by the initialize
+  // function, we add an arbitrary amount of dead weight.
+  uint8_t dead_weight[123000000];  // 123 MB.
+#endif  // !defined(WUFFS_IMPLEMENTATION)
+
+  inline wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+  initialize(
+      size_t sizeof_star_self,
+      uint64_t wuffs_version,
+      uint32_t options) {
+    return wuffs_jpeg__decoder__initialize(
+        this, sizeof_star_self, wuffs_version, options);
+  }
+
+  inline wuffs_base__stats
+  stats() const {
+    return wuffs_jpeg__decoder__stats(this);
+  }
+
+  inline wuffs_base__image_decoder*
+  upcast_as__wuffs_base__image_decoder() {
+    return (wuffs_base__image_decoder*)this;
+  }
+
+  inline wuffs_base__empty_struct
+  set_quirk_enabled(
+      uint32_t a_quirk,
+      bool a_enabled) {
+    return wuffs_jpeg__decoder__set_quirk_enabled(this, a_quirk, a_enabled);
+  }
+
+  inline wuffs_base__status
+  decode_image_config(
+      wuffs_base__image_config* a_dst,
+      wuffs_base__io_buffer* a_src) {
+    return wuffs_jpeg__decoder__decode_image_config(this, a_dst, a_src);
+  }
+
+  inline wuffs_base__status
+  decode_frame_config(
+      wuffs_base__frame_config* a_dst,
+      wuffs_base__io_buffer* a_src) {
+    return wuffs_jpeg__decoder__decode_frame_config(this, a_dst, a_src);
+  }
+
+  inline wuffs_base__status
+  decode_frame(
+      wuffs_base__pixel_buffer* a_dst,
+      wuffs_base__io_buffer* a_src,
+      wuffs_base__pixel_blend a_blend,
+      wuffs_base__slice_u8 a_workbuf,
+      wuffs_base__decode_frame_options* a_opts) {
+    return wuffs_jpeg__decoder__decode_frame(this, a_dst, a_src, a_blend, a_workbuf, a_opts);
+  }
+
+  inline bool
+  can_decode_row_bands() const {
+    return wuffs_jpeg__decoder__can_decode_row_bands(this);
+  }
+
+  inline wuffs_base__rect_ie_u32
+  frame_dirty_rect() const {
+    return wuffs_jpeg__decoder__frame_dirty_rect(this);
+  }
+
+  inline uint32_t
+  num_animation_loops() const {
+    return wuffs_jpeg__decoder__num_animation_loops(this);
+  }
+
+  inline uint64_t
+  num_decoded_frame_configs() const {
+    return wuffs_jpeg__decoder__num_decoded_frame_configs(this);
+  }
+
+  inline uint64_t
+  num_decoded_frames() const {
+    return wuffs_jpeg__decoder__num_decoded_frames(this);
+  }
+
+  inline wuffs_base__status
+  restart_frame(
+      uint64_t a_index,
+      uint64_t a_io_position) {
+    return wuffs_jpeg__decoder__restart_frame(this, a_index, a_io_position);
+  }
+
+  inline wuffs_base__empty_struct
+  set_report_metadata(
+      uint32_t a_fourcc,
+      bool a_report) {
+    return wuffs_jpeg__decoder__set_report_metadata(this, a_fourcc, a_report);
+  }
+
+  inline wuffs_base__status
+  tell_me_more(
+      wuffs_base__io_buffer* a_dst,
+      wuffs_base__more_information* a_minfo,
+      wuffs_base__io_buffer* a_src) {
+    return wuffs_jpeg__decoder__tell_me_more(this, a_dst, a_minfo, a_src);
+  }
+
+  inline wuffs_base__range_ii_u64
+  workbuf_len() const {
+    return wuffs_jpeg__decoder__workbuf_len(this);
+  }
+
+#endif  // __cplusplus
+};  // struct wuffs_jpeg__decoder__struct
+
+#endif  // defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
+
+
+// ‼ WUFFS C HEADER ENDS HERE.
+#ifdef WUFFS_IMPLEMENTATION
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__JPEG)
+
+// ---------------- Status Codes Implementations
+
+const char wuffs_jpeg__error__bad_dht_marker[] = "#jpeg: bad DHT marker";
+const char wuffs_jpeg__error__bad_dqt_marker[] = "#jpeg: bad DQT marker";
+const char wuffs_jpeg__error__bad_dri_marker[] = "#jpeg: bad DRI marker";
+const char wuffs_jpeg__error__bad_sof_marker[] = "#jpeg: bad SOF marker";
+const char wuffs_jpeg__error__bad_sos_marker[] = "#jpeg: bad SOS marker";
+const char wuffs_jpeg__error__bad_header[] = "#jpeg: bad header";
+const char wuffs_jpeg__error__bad_marker[] = "#jpeg: bad marker";
+const char wuffs_jpeg__error__bad_huffman_code[] = "#jpeg: bad Huffman code";
+const char wuffs_jpeg__error__missing_huffman_table[] = "#jpeg: missing Huffman table";
+const char wuffs_jpeg__error__missing_quantization_table[] = "#jpeg: missing Quantization table";
+const char wuffs_jpeg__error__truncated_input[] = "#jpeg: truncated input";
+const char wuffs_jpeg__error__unsupported_arithmetic_coding[] = "#jpeg: unsupported arithmetic coding";
+const char wuffs_jpeg__error__unsupported_color_model[] = "#jpeg: unsupported color model";
+const char wuffs_jpeg__error__unsupported_fractional_sampling[] = "#jpeg: unsupported fractional sampling";
+const char wuffs_jpeg__error__unsupported_hierarchical_coding[] = "#jpeg: unsupported hierarchical coding";
+const char wuffs_jpeg__error__unsupported_lossless_coding[] = "#jpeg: unsupported lossless coding";
+const char wuffs_jpeg__error__unsupported_marker[] = "#jpeg: unsupported marker";
+const char wuffs_jpeg__error__unsupported_precision[] = "#jpeg: unsupported precision";
+const char wuffs_jpeg__error__internal_error_inconsistent_workbuf_length[] = "#jpeg: internal error: inconsistent workbuf length";
+const char wuffs_jpeg__note__internal_note_short_write[] = "@jpeg: internal note: short write";
+
+// ---------------- Private Consts
+
+#define WUFFS_JPEG__BITSTREAM_BUFFER_LENGTH 8192
+
+#define WUFFS_JPEG__BITSTREAM_MCU_LENGTH_MAX_INCL_WORST_CASE 2304
+
+static const uint8_t
+WUFFS_JPEG__UNZIG[80] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  0, 1, 8, 16, 9, 2, 3, 10,
+  17, 24, 32, 25, 18, 11, 4, 5,
+  12, 19, 26, 33, 40, 48, 41, 34,
+  27, 20, 13, 6, 7, 14, 21, 28,
+  35, 42, 49, 56, 57, 50, 43, 36,
+  29, 22, 15, 23, 30, 37, 44, 51,
+  58, 59, 52, 45, 38, 31, 39, 46,
+  53, 60, 61, 54, 47, 55, 62, 63,
+  63, 63, 63, 63, 63, 63, 63, 63,
+  63, 63, 63, 63, 63, 63, 63, 63,
+};
+
+// ---------------- Private Initializer Prototypes
+
+// ---------------- Private Function Prototypes
+
+static wuffs_base__status
+wuffs_jpeg__decoder__decode_idct_progressive(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__slice_u8 a_workbuf);
+
+static wuffs_base__status
+wuffs_jpeg__decoder__swizzle(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__pixel_buffer* a_dst,
+    wuffs_base__slice_u8 a_workbuf);
+
+static wuffs_base__slice_u8
+wuffs_jpeg__decoder__color_row(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__slice_u8 a_workbuf,
+    uint32_t a_y);
+
+static wuffs_base__slice_u8
+wuffs_jpeg__decoder__scratch_rows(
+    const wuffs_jpeg__decoder* self,
+    wuffs_base__slice_u8 a_workbuf,
+    uint32_t a_i,
+    uint32_t a_n);
+
+static wuffs_base__slice_u8
+wuffs_jpeg__decoder__interleave(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_src0,
+    wuffs_base__slice_u8 a_src1,
+    wuffs_base__slice_u8 a_src2);
+
+static wuffs_base__slice_u8
+wuffs_jpeg__decoder__plane_row(
+    const wuffs_jpeg__decoder* self,
+    wuffs_base__slice_u8 a_workbuf,
+    uint32_t a_c,
+    uint32_t a_iy);
+
+static uint32_t
+wuffs_jpeg__decoder__ratio(
+    const wuffs_jpeg__decoder* self,
+    uint32_t a_n,
+    uint32_t a_d);
+
+static wuffs_base__slice_u8
+wuffs_jpeg__decoder__component_row(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__slice_u8 a_workbuf,
+    uint32_t a_c,
+    uint32_t a_y);
+
+static wuffs_base__empty_struct
+wuffs_jpeg__decoder__upsample_box(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_src,
+    uint32_t a_n,
+    uint32_t a_hr);
+
+static wuffs_base__empty_struct
+wuffs_jpeg__decoder__upsample_h2v1_fancy(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_src,
+    uint32_t a_n);
+
+static wuffs_base__empty_struct
+wuffs_jpeg__decoder__upsample_h1v2_fancy(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_src0,
+    wuffs_base__slice_u8 a_src1,
+    uint32_t a_n,
+    uint32_t a_bias);
+
+static wuffs_base__empty_struct
+wuffs_jpeg__decoder__upsample_h2v2_fancy(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_src0,
+    wuffs_base__slice_u8 a_src1,
+    uint32_t a_n);
+
+static wuffs_base__status
+wuffs_jpeg__decoder__decode_dht(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__io_buffer* a_src);
+
+static uint32_t
+wuffs_jpeg__decoder__calculate_huff_tables(
+    wuffs_jpeg__decoder* self,
+    uint32_t a_tc4_th);
+
+static wuffs_base__status
+wuffs_jpeg__decoder__decode_sos(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf);
+
+static wuffs_base__status
+wuffs_jpeg__decoder__prepare_scan(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status
+wuffs_jpeg__decoder__skip_past_restart_marker(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__empty_struct
+wuffs_jpeg__decoder__fill_bitstream(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__empty_struct
+wuffs_jpeg__decoder__bitstream_refill(
+    wuffs_jpeg__decoder* self);
+
+static uint32_t
+wuffs_jpeg__decoder__decode_huffman(
+    wuffs_jpeg__decoder* self,
+    uint32_t a_ht);
+
+static uint32_t
+wuffs_jpeg__decoder__read_bits(
+    wuffs_jpeg__decoder* self,
+    uint32_t a_n);
+
+static uint16_t
+wuffs_jpeg__decoder__extend(
+    const wuffs_jpeg__decoder* self,
+    uint32_t a_v,
+    uint32_t a_s);
+
+static wuffs_base__status
+wuffs_jpeg__decoder__decode_mcu(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__slice_u8 a_workbuf,
+    uint32_t a_mx,
+    uint32_t a_my);
+
+static wuffs_base__status
+wuffs_jpeg__decoder__decode_mcu_sequential(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__slice_u8 a_workbuf,
+    uint32_t a_mx,
+    uint32_t a_my);
+
+static uint64_t
+wuffs_jpeg__decoder__coefficients_offset(
+    const wuffs_jpeg__decoder* self,
+    uint32_t a_b,
+    uint32_t a_mx,
+    uint32_t a_my);
+
+static wuffs_base__status
+wuffs_jpeg__decoder__decode_mcu_progressive_dc_first(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__slice_u8 a_workbuf,
+    uint32_t a_mx,
+    uint32_t a_my);
+
+static wuffs_base__status
+wuffs_jpeg__decoder__decode_mcu_progressive_dc_refine(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__slice_u8 a_workbuf,
+    uint32_t a_mx,
+    uint32_t a_my);
+
+static bool
+wuffs_jpeg__decoder__load_block(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__slice_u8 a_workbuf,
+    uint64_t a_offset);
+
+static wuffs_base__empty_struct
+wuffs_jpeg__decoder__store_block(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__slice_u8 a_workbuf,
+    uint64_t a_offset);
+
+static wuffs_base__status
+wuffs_jpeg__decoder__decode_mcu_progressive_ac_first(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__slice_u8 a_workbuf,
+    uint32_t a_mx,
+    uint32_t a_my);
+
+static wuffs_base__status
+wuffs_jpeg__decoder__decode_mcu_progressive_ac_refine(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__slice_u8 a_workbuf,
+    uint32_t a_mx,
+    uint32_t a_my);
+
+static wuffs_base__empty_struct
+wuffs_jpeg__decoder__decode_idct(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__slice_u8 a_dst_buffer,
+    uint64_t a_dst_stride,
+    uint32_t a_q);
+
+static uint8_t
+wuffs_jpeg__decoder__clamp(
+    const wuffs_jpeg__decoder* self,
+    uint32_t a_a);
+
+static uint32_t
+wuffs_jpeg__decoder__dst_pixfmt(
+    const wuffs_jpeg__decoder* self);
+
+static wuffs_base__status
+wuffs_jpeg__decoder__decode_other_marker(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    uint8_t a_marker);
+
+static wuffs_base__status
+wuffs_jpeg__decoder__decode_appn(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    uint8_t a_marker);
+
+static wuffs_base__status
+wuffs_jpeg__decoder__decode_dqt(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status
+wuffs_jpeg__decoder__decode_dri(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status
+wuffs_jpeg__decoder__decode_sof(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__io_buffer* a_src);
+
+static bool
+wuffs_jpeg__decoder__is_integer_ratio(
+    const wuffs_jpeg__decoder* self,
+    uint32_t a_a,
+    uint32_t a_b);
+
+static uint32_t
+wuffs_jpeg__decoder__div_round_up_by_8n(
+    const wuffs_jpeg__decoder* self,
+    uint32_t a_a,
+    uint32_t a_n);
+
+static uint32_t
+wuffs_jpeg__decoder__div_round_up_by_ratio(
+    const wuffs_jpeg__decoder* self,
+    uint32_t a_a,
+    uint32_t a_n,
+    uint32_t a_d);
+
+static uint32_t
+wuffs_jpeg__decoder__div_by_ratio(
+    const wuffs_jpeg__decoder* self,
+    uint32_t a_a,
+    uint32_t a_n,
+    uint32_t a_d);
+
+static wuffs_base__empty_struct
+wuffs_jpeg__decoder__clear_coefficients(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__slice_u8 a_workbuf);
+
+// ---------------- VTables
+
+const wuffs_base__image_decoder__func_ptrs
+wuffs_jpeg__decoder__func_ptrs_for__wuffs_base__image_decoder = {
+  (bool(*)(const void*))(&wuffs_jpeg__decoder__can_decode_row_bands),
+  (wuffs_base__status(*)(void*,
+      wuffs_base__pixel_buffer*,
+      wuffs_base__io_buffer*,
+      wuffs_base__pixel_blend,
+      wuffs_base__slice_u8,
+      wuffs_base__decode_frame_options*))(&wuffs_jpeg__decoder__decode_frame),
+  (wuffs_base__status(*)(void*,
+      wuffs_base__frame_config*,
+      wuffs_base__io_buffer*))(&wuffs_jpeg__decoder__decode_frame_config),
+  (wuffs_base__status(*)(void*,
+      wuffs_base__image_config*,
+      wuffs_base__io_buffer*))(&wuffs_jpeg__decoder__decode_image_config),
+  (wuffs_base__rect_ie_u32(*)(const void*))(&wuffs_jpeg__decoder__frame_dirty_rect),
+  (uint32_t(*)(const void*))(&wuffs_jpeg__decoder__num_animation_loops),
+  (uint64_t(*)(const void*))(&wuffs_jpeg__decoder__num_decoded_frame_configs),
+  (uint64_t(*)(const void*))(&wuffs_jpeg__decoder__num_decoded_frames),
+  (wuffs_base__status(*)(void*,
+      uint64_t,
+      uint64_t))(&wuffs_jpeg__decoder__restart_frame),
+  (wuffs_base__empty_struct(*)(void*,
+      uint32_t,
+      bool))(&wuffs_jpeg__decoder__set_quirk_enabled),
+  (wuffs_base__empty_struct(*)(void*,
+      uint32_t,
+      bool))(&wuffs_jpeg__decoder__set_report_metadata),
+  (wuffs_base__status(*)(void*,
+      wuffs_base__io_buffer*,
+      wuffs_base__more_information*,
+      wuffs_base__io_buffer*))(&wuffs_jpeg__decoder__tell_me_more),
+  (wuffs_base__range_ii_u64(*)(const void*))(&wuffs_jpeg__decoder__workbuf_len),
+};
+
+// ---------------- Initializer Implementations
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+wuffs_jpeg__decoder__initialize(
+    wuffs_jpeg__decoder* self,
+    size_t sizeof_star_self,
+    uint64_t wuffs_version,
+    uint32_t options){
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  }
+
+  if ((options & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+    // The whole point of this if-check is to detect an uninitialized *self.
+    // We disable the warning on GCC. Clang-5.0 does not have this warning.
+    //
+    // The caller promises that *self is zeroed, so the empty asm tells GCC
+    // that private_impl is defined. Otherwise, once this function and a
+    // small method (e.g. one that reads a "choose" guard field) are both
+    // inlined into the caller, GCC -O3 warns about that method's read.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    __asm__ __volatile__("" : "+m"(self->private_impl));
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((options & WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      options |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    }
+  }
+
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__image_decoder.vtable_name =
+      wuffs_base__image_decoder__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__image_decoder.function_pointers =
+      (const void*)(&wuffs_jpeg__decoder__func_ptrs_for__wuffs_base__image_decoder);
+  return wuffs_base__make_status(NULL);
+}
+
+wuffs_jpeg__decoder*
+wuffs_jpeg__decoder__alloc() {
+  wuffs_jpeg__decoder* x =
+      (wuffs_jpeg__decoder*)(calloc(sizeof(wuffs_jpeg__decoder), 1));
+  if (!x) {
+    return NULL;
+  }
+  if (wuffs_jpeg__decoder__initialize(
+      x, sizeof(wuffs_jpeg__decoder), WUFFS_VERSION, WUFFS_INITIALIZE__ALREADY_ZEROED).repr) {
+    free(x);
+    return NULL;
+  }
+  return x;
+}
+
+size_t
+sizeof__wuffs_jpeg__decoder() {
+  return sizeof(wuffs_jpeg__decoder);
+}
+
+wuffs_base__stats
+wuffs_jpeg__decoder__stats(
+    const wuffs_jpeg__decoder* self) {
+  wuffs_base__stats ret = wuffs_base__make_empty_stats();
+#if defined(WUFFS_CONFIG__STATS)
+  if (!self) {
+    return ret;
+  }
+  ret = self->private_impl.stats;
+#else
+  (void)(self);
+#endif  // defined(WUFFS_CONFIG__STATS)
+  return ret;
+}
+
+// ---------------- Function Implementations
+
+// -------- func jpeg.decoder.decode_idct_progressive
+
+static wuffs_base__status
+wuffs_jpeg__decoder__decode_idct_progressive(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__slice_u8 a_workbuf) {
+  uint32_t v_c = 0;
+  uint64_t v_bx = 0;
+  uint64_t v_by = 0;
+  uint64_t v_bw = 0;
+  uint64_t v_bh = 0;
+  uint64_t v_stride = 0;
+  uint64_t v_offset = 0;
+  bool v_loaded = false;
+  uint64_t v_poff = 0;
+  uint64_t v_coff = 0;
+  uint32_t v_tq = 0;
+
+  v_c = 0;
+  while (v_c < self->private_impl.f_num_components) {
+    v_bw = ((uint64_t)((self->private_impl.f_width_in_mcus * ((uint32_t)(self->private_impl.f_components_h[v_c])))));
+    v_bh = ((uint64_t)((self->private_impl.f_height_in_mcus * ((uint32_t)(self->private_impl.f_components_v[v_c])))));
+    v_stride = (v_bw * 8);
+    v_poff = self->private_impl.f_workbuf_offsets[v_c];
+    v_coff = self->private_impl.f_workbuf_offsets[(3 + v_c)];
+    v_tq = ((uint32_t)(self->private_impl.f_components_tq[v_c]));
+    v_by = 0;
+    while (v_by < v_bh) {
+      v_bx = 0;
+      while (v_bx < v_bw) {
+        v_offset = ((uint64_t)(v_coff + ((uint64_t)(((uint64_t)((v_by * v_bw) + v_bx)) * 128))));
+        v_loaded = wuffs_jpeg__decoder__load_block(self, a_workbuf, v_offset);
+        if ( ! v_loaded) {
+          return wuffs_base__make_status(wuffs_jpeg__error__internal_error_inconsistent_workbuf_length);
+        }
+        v_offset = ((uint64_t)(((uint64_t)(v_poff + (v_bx * 8))) + (v_by * 8 * v_stride)));
+        if (v_offset > ((uint64_t)(a_workbuf.len))) {
+          return wuffs_base__make_status(wuffs_jpeg__error__internal_error_inconsistent_workbuf_length);
+        }
+        wuffs_jpeg__decoder__decode_idct(self, wuffs_base__slice_u8__subslice_i(a_workbuf, v_offset), v_stride, v_tq);
+        v_bx += 1;
+      }
+      v_by += 1;
+    }
+    v_c += 1;
+  }
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func jpeg.decoder.swizzle
+
+static wuffs_base__status
+wuffs_jpeg__decoder__swizzle(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__pixel_buffer* a_dst,
+    wuffs_base__slice_u8 a_workbuf) {
+  wuffs_base__pixel_format v_dst_pixfmt = {0};
+  uint32_t v_dst_bits_per_pixel = 0;
+  uint64_t v_dst_bytes_per_pixel = 0;
+  uint64_t v_dst_bytes_per_row = 0;
+  wuffs_base__table_u8 v_tab = {0};
+  wuffs_base__slice_u8 v_dst = {0};
+  wuffs_base__slice_u8 v_src = {0};
+  uint32_t v_y = 0;
+
+  v_dst_pixfmt = wuffs_base__pixel_buffer__pixel_format(a_dst);
+  v_dst_bits_per_pixel = wuffs_base__pixel_format__bits_per_pixel(&v_dst_pixfmt);
+  if ((v_dst_bits_per_pixel & 7) != 0) {
+    return wuffs_base__make_status(wuffs_base__error__unsupported_option);
+  }
+  v_dst_bytes_per_pixel = ((uint64_t)((v_dst_bits_per_pixel / 8)));
+  v_dst_bytes_per_row = (((uint64_t)(((uint32_t)(self->private_impl.f_roi_x1 - self->private_impl.f_roi_x0)))) * v_dst_bytes_per_pixel);
+  v_tab = wuffs_base__pixel_buffer__plane(a_dst, 0);
+  v_y = self->private_impl.f_band_y0;
+  while (v_y < self->private_impl.f_band_y1) {
+    v_src = wuffs_jpeg__decoder__color_row(self, a_workbuf, v_y);
+    v_dst = wuffs_base__table_u8__row_u32(v_tab, ((uint32_t)(v_y - self->private_impl.f_band_y0)));
+    if (v_dst_bytes_per_row < ((uint64_t)(v_dst.len))) {
+      v_dst = wuffs_base__slice_u8__subslice_j(v_dst, v_dst_bytes_per_row);
+    }
+    wuffs_base__pixel_swizzler__swizzle_interleaved_from_slice(&self->private_impl.f_swizzler, v_dst, wuffs_base__pixel_buffer__palette(a_dst), v_src);
+    v_y += 1;
+  }
+  if (self->private_impl.f_band_y1 < self->private_impl.f_roi_y1) {
+    return wuffs_base__make_status(wuffs_jpeg__note__internal_note_short_write);
+  }
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func jpeg.decoder.color_row
+
+static wuffs_base__slice_u8
+wuffs_jpeg__decoder__color_row(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__slice_u8 a_workbuf,
+    uint32_t a_y) {
+  wuffs_base__slice_u8 v_row0 = {0};
+  wuffs_base__slice_u8 v_row1 = {0};
+  wuffs_base__slice_u8 v_row2 = {0};
+  wuffs_base__slice_u8 v_inter = {0};
+  uint64_t v_x0 = 0;
+  uint64_t v_x1 = 0;
+
+  v_x0 = ((uint64_t)(self->private_impl.f_roi_x0));
+  v_x1 = ((uint64_t)(self->private_impl.f_roi_x1));
+  if (self->private_impl.f_num_components == 1) {
+    v_row0 = wuffs_jpeg__decoder__component_row(self, a_workbuf, 0, a_y);
+    if ((v_x0 <= v_x1) && (v_x1 <= ((uint64_t)(v_row0.len)))) {
+      return wuffs_base__slice_u8__subslice_ij(v_row0, v_x0, v_x1);
+    }
+    return wuffs_base__utility__empty_slice_u8();
+  }
+  v_row0 = wuffs_jpeg__decoder__component_row(self, a_workbuf, 0, a_y);
+  v_row1 = wuffs_jpeg__decoder__component_row(self, a_workbuf, 1, a_y);
+  v_row2 = wuffs_jpeg__decoder__component_row(self, a_workbuf, 2, a_y);
+  v_inter = wuffs_jpeg__decoder__scratch_rows(self, a_workbuf, 3, 3);
+  if ((v_x0 > v_x1) ||
+      (v_x1 > ((uint64_t)(v_row0.len))) ||
+      (v_x1 > ((uint64_t)(v_row1.len))) ||
+      (v_x1 > ((uint64_t)(v_row2.len)))) {
+    return wuffs_base__utility__empty_slice_u8();
+  }
+  v_row0 = wuffs_base__slice_u8__subslice_ij(v_row0, v_x0, v_x1);
+  v_row1 = wuffs_base__slice_u8__subslice_ij(v_row1, v_x0, v_x1);
+  v_row2 = wuffs_base__slice_u8__subslice_ij(v_row2, v_x0, v_x1);
+  v_inter = wuffs_jpeg__decoder__interleave(self,
+      v_inter,
+      v_row0,
+      v_row1,
+      v_row2);
+  return v_inter;
+}
+
+// -------- func jpeg.decoder.scratch_rows
+
+static wuffs_base__slice_u8
+wuffs_jpeg__decoder__scratch_rows(
+    const wuffs_jpeg__decoder* self,
+    wuffs_base__slice_u8 a_workbuf,
+    uint32_t a_i,
+    uint32_t a_n) {
+  wuffs_base__slice_u8 v_s = {0};
+  uint64_t v_p = 0;
+  uint64_t v_offset = 0;
+
+  v_p = (((uint64_t)((self->private_impl.f_width_in_mcus * self->private_impl.f_max_incl_components_h))) * 8);
+  v_offset = self->private_impl.f_workbuf_offsets[6];
+  if (v_offset > ((uint64_t)(a_workbuf.len))) {
+    return wuffs_base__utility__empty_slice_u8();
+  }
+  v_s = wuffs_base__slice_u8__subslice_i(a_workbuf, v_offset);
+  v_offset = (v_p * ((uint64_t)(a_i)));
+  if (v_offset > ((uint64_t)(v_s.len))) {
+    return wuffs_base__utility__empty_slice_u8();
+  }
+  v_s = wuffs_base__slice_u8__subslice_i(v_s, v_offset);
+  v_offset = (v_p * ((uint64_t)(a_n)));
+  if (v_offset > ((uint64_t)(v_s.len))) {
+    return wuffs_base__utility__empty_slice_u8();
+  }
+  return wuffs_base__slice_u8__subslice_j(v_s, v_offset);
+}
+
+// -------- func jpeg.decoder.interleave
+
+static wuffs_base__slice_u8
+wuffs_jpeg__decoder__interleave(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_src0,
+    wuffs_base__slice_u8 a_src1,
+    wuffs_base__slice_u8 a_src2) {
+  wuffs_base__slice_u8 v_d = {0};
+  wuffs_base__slice_u8 v_s0 = {0};
+  wuffs_base__slice_u8 v_s1 = {0};
+  wuffs_base__slice_u8 v_s2 = {0};
+  uint64_t v_n = 0;
+
+  v_d = a_dst;
+  v_s0 = a_src0;
+  v_s1 = a_src1;
+  v_s2 = a_src2;
+  while ((((uint64_t)(v_d.len)) >= 3) &&
+      (((uint64_t)(v_s0.len)) >= 1) &&
+      (((uint64_t)(v_s1.len)) >= 1) &&
+      (((uint64_t)(v_s2.len)) >= 1)) {
+    v_d.ptr[0] = v_s0.ptr[0];
+    v_d.ptr[1] = v_s1.ptr[0];
+    v_d.ptr[2] = v_s2.ptr[0];
+    v_d = wuffs_base__slice_u8__subslice_i(v_d, 3);
+    v_s0 = wuffs_base__slice_u8__subslice_i(v_s0, 1);
+    v_s1 = wuffs_base__slice_u8__subslice_i(v_s1, 1);
+    v_s2 = wuffs_base__slice_u8__subslice_i(v_s2, 1);
+    v_n += 3;
+  }
+  if (v_n <= ((uint64_t)(a_dst.len))) {
+    return wuffs_base__slice_u8__subslice_j(a_dst, v_n);
+  }
+  return wuffs_base__utility__empty_slice_u8();
+}
+
+// -------- func jpeg.decoder.plane_row
+
+static wuffs_base__slice_u8
+wuffs_jpeg__decoder__plane_row(
+    const wuffs_jpeg__decoder* self,
+    wuffs_base__slice_u8 a_workbuf,
+    uint32_t a_c,
+    uint32_t a_iy) {
+  wuffs_base__slice_u8 v_s = {0};
+  uint64_t v_stride = 0;
+  uint64_t v_offset = 0;
+
+  v_stride = (((uint64_t)((self->private_impl.f_width_in_mcus * ((uint32_t)(self->private_impl.f_components_h[a_c]))))) * 8);
+  v_offset = ((uint64_t)(self->private_impl.f_workbuf_offsets[a_c] + ((uint64_t)(((uint64_t)(a_iy)) * v_stride))));
+  if (v_offset > ((uint64_t)(a_workbuf.len))) {
+    return wuffs_base__utility__empty_slice_u8();
+  }
+  v_s = wuffs_base__slice_u8__subslice_i(a_workbuf, v_offset);
+  if (v_stride > ((uint64_t)(v_s.len))) {
+    return wuffs_base__utility__empty_slice_u8();
+  }
+  return wuffs_base__slice_u8__subslice_j(v_s, v_stride);
+}
+
+// -------- func jpeg.decoder.ratio
+
+static uint32_t
+wuffs_jpeg__decoder__ratio(
+    const wuffs_jpeg__decoder* self,
+    uint32_t a_n,
+    uint32_t a_d) {
+  if (a_n == a_d) {
+    return 1;
+  } else if ((a_n == 2) || ((a_n == 4) && (a_d == 2))) {
+    return 2;
+  } else if (a_n == 3) {
+    return 3;
+  } else if (a_n == 4) {
+    return 4;
+  }
+  return 1;
+}
+
+// -------- func jpeg.decoder.component_row
+
+static wuffs_base__slice_u8
+wuffs_jpeg__decoder__component_row(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__slice_u8 a_workbuf,
+    uint32_t a_c,
+    uint32_t a_y) {
+  uint32_t v_hr = 0;
+  uint32_t v_vr = 0;
+  uint32_t v_comp_w = 0;
+  uint32_t v_comp_h = 0;
+  uint32_t v_iy = 0;
+  uint32_t v_ny = 0;
+  wuffs_base__slice_u8 v_row0 = {0};
+  wuffs_base__slice_u8 v_row1 = {0};
+  wuffs_base__slice_u8 v_up = {0};
+
+  v_hr = wuffs_jpeg__decoder__ratio(self, self->private_impl.f_max_incl_components_h, ((uint32_t)(self->private_impl.f_components_h[a_c])));
+  v_vr = wuffs_jpeg__decoder__ratio(self, self->private_impl.f_max_incl_components_v, ((uint32_t)(self->private_impl.f_components_v[a_c])));
+  if ((v_hr == 1) && (v_vr == 1)) {
+    return wuffs_jpeg__decoder__plane_row(self, a_workbuf, a_c, a_y);
+  }
+  v_comp_w = wuffs_jpeg__decoder__div_round_up_by_ratio(self, self->private_impl.f_width, self->private_impl.f_max_incl_components_h, ((uint32_t)(self->private_impl.f_components_h[a_c])));
+  v_comp_h = wuffs_jpeg__decoder__div_round_up_by_ratio(self, self->private_impl.f_height, self->private_impl.f_max_incl_components_v, ((uint32_t)(self->private_impl.f_components_v[a_c])));
+  if ((v_comp_w <= 0) || (v_comp_h <= 0)) {
+    return wuffs_base__utility__empty_slice_u8();
+  }
+  v_up = wuffs_jpeg__decoder__scratch_rows(self, a_workbuf, a_c, 1);
+  if (v_vr == 2) {
+    v_iy = (a_y >> 1);
+    v_ny = v_iy;
+    if ((a_y & 1) == 0) {
+      if (v_iy > 0) {
+        v_ny = (v_iy - 1);
+      }
+    } else if ((v_iy + 1) < v_comp_h) {
+      v_ny = (v_iy + 1);
+    }
+    v_row0 = wuffs_jpeg__decoder__plane_row(self, a_workbuf, a_c, v_iy);
+    v_row1 = wuffs_jpeg__decoder__plane_row(self, a_workbuf, a_c, v_ny);
+    if (v_hr == 1) {
+      wuffs_jpeg__decoder__upsample_h1v2_fancy(self,
+          v_up,
+          v_row0,
+          v_row1,
+          v_comp_w,
+          (1 + (a_y & 1)));
+      return v_up;
+    } else if ((v_hr == 2) && (v_comp_w > 2)) {
+      wuffs_jpeg__decoder__upsample_h2v2_fancy(self,
+          v_up,
+          v_row0,
+          v_row1,
+          v_comp_w);
+      return v_up;
+    }
+  } else if ((v_vr == 1) && (v_hr == 2) && (v_comp_w > 2)) {
+    v_row0 = wuffs_jpeg__decoder__plane_row(self, a_workbuf, a_c, a_y);
+    wuffs_jpeg__decoder__upsample_h2v1_fancy(self, v_up, v_row0, v_comp_w);
+    return v_up;
+  }
+  v_iy = wuffs_jpeg__decoder__div_by_ratio(self, (a_y & 65535), v_vr, 1);
+  v_row0 = wuffs_jpeg__decoder__plane_row(self, a_workbuf, a_c, v_iy);
+  wuffs_jpeg__decoder__upsample_box(self,
+      v_up,
+      v_row0,
+      v_comp_w,
+      v_hr);
+  return v_up;
+}
+
+// -------- func jpeg.decoder.upsample_box
+
+static wuffs_base__empty_struct
+wuffs_jpeg__decoder__upsample_box(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_src,
+    uint32_t a_n,
+    uint32_t a_hr) {
+  wuffs_base__slice_u8 v_d = {0};
+  wuffs_base__slice_u8 v_s = {0};
+  uint32_t v_i = 0;
+  uint8_t v_v = 0;
+
+  v_d = a_dst;
+  v_s = a_src;
+  while ((v_i < a_n) && (((uint64_t)(v_s.len)) >= 1)) {
+    v_v = v_s.ptr[0];
+    if (a_hr == 1) {
+      if (((uint64_t)(v_d.len)) < 1) {
+        return wuffs_base__make_empty_struct();
+      }
+      v_d.ptr[0] = v_v;
+      v_d = wuffs_base__slice_u8__subslice_i(v_d, 1);
+    } else if (a_hr == 2) {
+      if (((uint64_t)(v_d.len)) < 2) {
+        return wuffs_base__make_empty_struct();
+      }
+      v_d.ptr[0] = v_v;
+      v_d.ptr[1] = v_v;
+      v_d = wuffs_base__slice_u8__subslice_i(v_d, 2);
+    } else if (a_hr == 3) {
+      if (((uint64_t)(v_d.len)) < 3) {
+        return wuffs_base__make_empty_struct();
+      }
+      v_d.ptr[0] = v_v;
+      v_d.ptr[1] = v_v;
+      v_d.ptr[2] = v_v;
+      v_d = wuffs_base__slice_u8__subslice_i(v_d, 3);
+    } else {
+      if (((uint64_t)(v_d.len)) < 4) {
+        return wuffs_base__make_empty_struct();
+      }
+      v_d.ptr[0] = v_v;
+      v_d.ptr[1] = v_v;
+      v_d.ptr[2] = v_v;
+      v_d.ptr[3] = v_v;
+      v_d = wuffs_base__slice_u8__subslice_i(v_d, 4);
+    }
+    v_s = wuffs_base__slice_u8__subslice_i(v_s, 1);
+    v_i += 1;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func jpeg.decoder.upsample_h2v1_fancy
+
+static wuffs_base__empty_struct
+wuffs_jpeg__decoder__upsample_h2v1_fancy(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_src,
+    uint32_t a_n) {
+  wuffs_base__slice_u8 v_d = {0};
+  wuffs_base__slice_u8 v_s = {0};
+  uint32_t v_i = 0;
+  uint32_t v_v = 0;
+
+  v_d = a_dst;
+  v_s = a_src;
+  if ((a_n < 3) || (((uint64_t)(v_s.len)) < 2) || (((uint64_t)(v_d.len)) < 2)) {
+    return wuffs_base__make_empty_struct();
+  }
+  v_v = ((uint32_t)(v_s.ptr[0]));
+  v_d.ptr[0] = v_s.ptr[0];
+  v_d.ptr[1] = ((uint8_t)((((v_v * 3) + ((uint32_t)(v_s.ptr[1])) + 2) >> 2)));
+  v_d = wuffs_base__slice_u8__subslice_i(v_d, 2);
+  v_i = (a_n - 2);
+  while ((v_i > 0) && (((uint64_t)(v_s.len)) >= 3) && (((uint64_t)(v_d.len)) >= 2)) {
+    v_v = (((uint32_t)(v_s.ptr[1])) * 3);
+    v_d.ptr[0] = ((uint8_t)(((v_v + ((uint32_t)(v_s.ptr[0])) + 1) >> 2)));
+    v_d.ptr[1] = ((uint8_t)(((v_v + ((uint32_t)(v_s.ptr[2])) + 2) >> 2)));
+    v_d = wuffs_base__slice_u8__subslice_i(v_d, 2);
+    v_s = wuffs_base__slice_u8__subslice_i(v_s, 1);
+    v_i -= 1;
+  }
+  if ((((uint64_t)(v_s.len)) >= 2) && (((uint64_t)(v_d.len)) >= 2)) {
+    v_v = ((uint32_t)(v_s.ptr[1]));
+    v_d.ptr[0] = ((uint8_t)((((v_v * 3) + ((uint32_t)(v_s.ptr[0])) + 1) >> 2)));
+    v_d.ptr[1] = v_s.ptr[1];
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func jpeg.decoder.upsample_h1v2_fancy
+
+static wuffs_base__empty_struct
+wuffs_jpeg__decoder__upsample_h1v2_fancy(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_src0,
+    wuffs_base__slice_u8 a_src1,
+    uint32_t a_n,
+    uint32_t a_bias) {
+  wuffs_base__slice_u8 v_d = {0};
+  wuffs_base__slice_u8 v_s0 = {0};
+  wuffs_base__slice_u8 v_s1 = {0};
+  uint32_t v_i = 0;
+
+  v_d = a_dst;
+  v_s0 = a_src0;
+  v_s1 = a_src1;
+  while ((v_i < a_n) &&
+      (((uint64_t)(v_d.len)) >= 1) &&
+      (((uint64_t)(v_s0.len)) >= 1) &&
+      (((uint64_t)(v_s1.len)) >= 1)) {
+    v_d.ptr[0] = ((uint8_t)((((((uint32_t)(v_s0.ptr[0])) * 3) + ((uint32_t)(v_s1.ptr[0])) + a_bias) >> 2)));
+    v_d = wuffs_base__slice_u8__subslice_i(v_d, 1);
+    v_s0 = wuffs_base__slice_u8__subslice_i(v_s0, 1);
+    v_s1 = wuffs_base__slice_u8__subslice_i(v_s1, 1);
+    v_i += 1;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func jpeg.decoder.upsample_h2v2_fancy
+
+static wuffs_base__empty_struct
+wuffs_jpeg__decoder__upsample_h2v2_fancy(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_src0,
+    wuffs_base__slice_u8 a_src1,
+    uint32_t a_n) {
+  wuffs_base__slice_u8 v_d = {0};
+  wuffs_base__slice_u8 v_s0 = {0};
+  wuffs_base__slice_u8 v_s1 = {0};
+  uint32_t v_i = 0;
+  uint32_t v_this_sum = 0;
+  uint32_t v_last_sum = 0;
+  uint32_t v_next_sum = 0;
+
+  v_d = a_dst;
+  v_s0 = a_src0;
+  v_s1 = a_src1;
+  if ((a_n < 3) ||
+      (((uint64_t)(v_s0.len)) < 2) ||
+      (((uint64_t)(v_s1.len)) < 2) ||
+      (((uint64_t)(v_d.len)) < 2)) {
+    return wuffs_base__make_empty_struct();
+  }
+  v_this_sum = ((((uint32_t)(v_s0.ptr[0])) * 3) + ((uint32_t)(v_s1.ptr[0])));
+  v_next_sum = ((((uint32_t)(v_s0.ptr[1])) * 3) + ((uint32_t)(v_s1.ptr[1])));
+  v_d.ptr[0] = ((uint8_t)((((v_this_sum * 4) + 8) >> 4)));
+  v_d.ptr[1] = ((uint8_t)((((v_this_sum * 3) + v_next_sum + 7) >> 4)));
+  v_d = wuffs_base__slice_u8__subslice_i(v_d, 2);
+  v_s0 = wuffs_base__slice_u8__subslice_i(v_s0, 2);
+  v_s1 = wuffs_base__slice_u8__subslice_i(v_s1, 2);
+  v_last_sum = v_this_sum;
+  v_this_sum = v_next_sum;
+  v_i = (a_n - 2);
+  while ((v_i > 0) &&
+      (((uint64_t)(v_s0.len)) >= 1) &&
+      (((uint64_t)(v_s1.len)) >= 1) &&
+      (((uint64_t)(v_d.len)) >= 2)) {
+    v_next_sum = ((((uint32_t)(v_s0.ptr[0])) * 3) + ((uint32_t)(v_s1.ptr[0])));
+    v_d.ptr[0] = ((uint8_t)((((v_this_sum * 3) + v_last_sum + 8) >> 4)));
+    v_d.ptr[1] = ((uint8_t)((((v_this_sum * 3) + v_next_sum + 7) >> 4)));
+    v_d = wuffs_base__slice_u8__subslice_i(v_d, 2);
+    v_s0 = wuffs_base__slice_u8__subslice_i(v_s0, 1);
+    v_s1 = wuffs_base__slice_u8__subslice_i(v_s1, 1);
+    v_last_sum = v_this_sum;
+    v_this_sum = v_next_sum;
+    v_i -= 1;
+  }
+  if (((uint64_t)(v_d.len)) >= 2) {
+    v_d.ptr[0] = ((uint8_t)((((v_this_sum * 3) + v_last_sum + 8) >> 4)));
+    v_d.ptr[1] = ((uint8_t)((((v_this_sum * 4) + 7) >> 4)));
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func jpeg.decoder.decode_dht
+
+static wuffs_base__status
+wuffs_jpeg__decoder__decode_dht(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t v_c = 0;
+  uint32_t v_tc4_th = 0;
+  uint32_t v_total = 0;
+  uint32_t v_num_symbols = 0;
+  uint32_t v_i = 0;
+  uint32_t v_n = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_dht[0];
+  if (coro_susp_point) {
+    v_tc4_th = self->private_data.s_decode_dht[0].v_tc4_th;
+    v_total = self->private_data.s_decode_dht[0].v_total;
+    v_num_symbols = self->private_data.s_decode_dht[0].v_num_symbols;
+    v_i = self->private_data.s_decode_dht[0].v_i;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    while (self->private_impl.f_payload_length > 0) {
+      if (self->private_impl.f_payload_length < 17) {
+        status = wuffs_base__make_status(wuffs_jpeg__error__bad_dht_marker);
+        goto exit;
+      }
+      self->private_impl.f_payload_length -= 17;
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint8_t t_0 = *iop_a_src++;
+        v_c = t_0;
+      }
+      if (((v_c >> 4) > 1) || ((v_c & 15) > 3)) {
+        status = wuffs_base__make_status(wuffs_jpeg__error__bad_dht_marker);
+        goto exit;
+      }
+      v_tc4_th = ((uint32_t)((((v_c >> 4) * 4) | (v_c & 3))));
+      v_total = 0;
+      v_i = 0;
+      while (v_i < 16) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint8_t t_1 = *iop_a_src++;
+          self->private_data.f_dht_temp_counts[v_i] = t_1;
+        }
+        v_total += ((uint32_t)(self->private_data.f_dht_temp_counts[v_i]));
+        v_i += 1;
+      }
+      if ((v_total == 0) || (v_total > 256) || (self->private_impl.f_payload_length < v_total)) {
+        status = wuffs_base__make_status(wuffs_jpeg__error__bad_dht_marker);
+        goto exit;
+      }
+      self->private_impl.f_payload_length -= v_total;
+      v_num_symbols = v_total;
+      v_i = 0;
+      while (v_i < v_num_symbols) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint8_t t_2 = *iop_a_src++;
+          v_c = t_2;
+        }
+        if ((v_tc4_th < 4) && (v_c > 15)) {
+          status = wuffs_base__make_status(wuffs_jpeg__error__bad_dht_marker);
+          goto exit;
+        }
+        self->private_data.f_huff_tables_symbols[v_tc4_th][v_i] = v_c;
+        v_i += 1;
+      }
+      while (v_i < 256) {
+        self->private_data.f_huff_tables_symbols[v_tc4_th][v_i] = 0;
+        v_i += 1;
+      }
+      v_n = wuffs_jpeg__decoder__calculate_huff_tables(self, v_tc4_th);
+      if (v_n != 0) {
+        status = wuffs_base__make_status(wuffs_jpeg__error__bad_dht_marker);
+        goto exit;
+      }
+      self->private_impl.f_huff_tables_defined |= (((uint8_t)(1)) << v_tc4_th);
+    }
+
+    goto ok;
+    ok:
+    self->private_impl.p_decode_dht[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_dht[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_decode_dht[0].v_tc4_th = v_tc4_th;
+  self->private_data.s_decode_dht[0].v_total = v_total;
+  self->private_data.s_decode_dht[0].v_num_symbols = v_num_symbols;
+  self->private_data.s_decode_dht[0].v_i = v_i;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func jpeg.decoder.calculate_huff_tables
+
+static uint32_t
+wuffs_jpeg__decoder__calculate_huff_tables(
+    wuffs_jpeg__decoder* self,
+    uint32_t a_tc4_th) {
+  uint32_t v_code = 0;
+  uint32_t v_k = 0;
+  uint32_t v_i = 0;
+  uint32_t v_len = 0;
+  uint32_t v_n = 0;
+  uint32_t v_j = 0;
+  uint32_t v_j_end = 0;
+  uint16_t v_v = 0;
+
+  v_k = 0;
+  while (v_k < 256) {
+    self->private_data.f_huff_tables_fast[a_tc4_th][v_k] = 0;
+    v_k += 1;
+  }
+  v_code = 0;
+  v_k = 0;
+  v_i = 0;
+  while (v_i < 16) {
+    v_len = (v_i + 1);
+    v_n = ((uint32_t)(self->private_data.f_dht_temp_counts[v_i]));
+    self->private_data.f_huff_tables_offsets[a_tc4_th][v_len] = ((uint32_t)(v_k - v_code));
+    while (v_n > 0) {
+      v_n -= 1;
+      if (((uint32_t)(v_code + 1)) >= (((uint32_t)(1)) << v_len)) {
+        return 1;
+      }
+      if (v_len <= 8) {
+        v_j = ((uint32_t)(v_code << (8 - v_len)));
+        v_j_end = ((uint32_t)(((uint32_t)(v_code + 1)) << (8 - v_len)));
+        v_v = (((uint16_t)((v_len << 8))) | ((uint16_t)(self->private_data.f_huff_tables_symbols[a_tc4_th][(v_k & 255)])));
+        while ((v_j < v_j_end) && (v_j < 256)) {
+          self->private_data.f_huff_tables_fast[a_tc4_th][v_j] = v_v;
+          v_j += 1;
+        }
+      }
+      v_code += 1;
+      v_k += 1;
+    }
+    self->private_data.f_huff_tables_limits[a_tc4_th][v_len] = v_code;
+    v_code = ((uint32_t)(v_code << 1));
+    v_i += 1;
+  }
+  return 0;
+}
+
+// -------- func jpeg.decoder.decode_sos
+
+static wuffs_base__status
+wuffs_jpeg__decoder__decode_sos(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  uint32_t v_mx = 0;
+  uint32_t v_my = 0;
+  uint32_t v_n = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_sos[0];
+  if (coro_susp_point) {
+    v_mx = self->private_data.s_decode_sos[0].v_mx;
+    v_my = self->private_data.s_decode_sos[0].v_my;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (a_src) {
+      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+    status = wuffs_jpeg__decoder__prepare_scan(self, a_src);
+    if (a_src) {
+      iop_a_src = a_src->data.ptr + a_src->meta.ri;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
+    self->private_impl.f_bitstream_bits = 0;
+    self->private_impl.f_bitstream_n_bits = 0;
+    self->private_impl.f_bitstream_ri = 0;
+    self->private_impl.f_bitstream_wi = 0;
+    self->private_impl.f_bitstream_is_closed = false;
+    self->private_impl.f_mcu_previous_dc_values[0] = 0;
+    self->private_impl.f_mcu_previous_dc_values[1] = 0;
+    self->private_impl.f_mcu_previous_dc_values[2] = 0;
+    self->private_impl.f_eob_run = 0;
+    self->private_impl.f_restarts_remaining = self->private_impl.f_restart_interval;
+    self->private_impl.f_next_restart_marker = 0;
+    v_my = 0;
+    while (v_my < self->private_impl.f_scan_height_in_mcus) {
+      v_mx = 0;
+      while (v_mx < self->private_impl.f_scan_width_in_mcus) {
+        while (true) {
+          if (a_src) {
+            a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+          }
+          wuffs_jpeg__decoder__fill_bitstream(self, a_src);
+          if (a_src) {
+            iop_a_src = a_src->data.ptr + a_src->meta.ri;
+          }
+          v_n = ((uint32_t)(self->private_impl.f_bitstream_wi - self->private_impl.f_bitstream_ri));
+          if (self->private_impl.f_bitstream_is_closed || (v_n >= 2304)) {
+            goto label__0__break;
+          } else if (a_src && a_src->meta.closed) {
+            status = wuffs_base__make_status(wuffs_jpeg__error__truncated_input);
+            goto exit;
+          }
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(2);
+        }
+        label__0__break:;
+        v_status = wuffs_jpeg__decoder__decode_mcu(self, a_workbuf, v_mx, v_my);
+        if ( ! wuffs_base__status__is_ok(&v_status)) {
+          status = v_status;
+          if (wuffs_base__status__is_error(&status)) {
+            goto exit;
+          } else if (wuffs_base__status__is_suspension(&status)) {
+            status = wuffs_base__make_status(wuffs_base__error__cannot_return_a_suspension);
+            goto exit;
+          }
+          goto ok;
+        }
+        if (self->private_impl.f_restart_interval > 0) {
+          if (self->private_impl.f_restarts_remaining > 0) {
+            self->private_impl.f_restarts_remaining -= 1;
+          }
+          if (self->private_impl.f_restarts_remaining == 0) {
+            if (a_src) {
+              a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+            }
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+            status = wuffs_jpeg__decoder__skip_past_restart_marker(self, a_src);
+            if (a_src) {
+              iop_a_src = a_src->data.ptr + a_src->meta.ri;
+            }
+            if (status.repr) {
+              goto suspend;
+            }
+          }
+        }
+        v_mx += 1;
+      }
+      v_my += 1;
+    }
+
+    ok:
+    self->private_impl.p_decode_sos[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_sos[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_decode_sos[0].v_mx = v_mx;
+  self->private_data.s_decode_sos[0].v_my = v_my;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func jpeg.decoder.prepare_scan
+
+static wuffs_base__status
+wuffs_jpeg__decoder__prepare_scan(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t v_c = 0;
+  uint8_t v_tdta = 0;
+  uint32_t v_ss = 0;
+  uint32_t v_se = 0;
+  uint32_t v_ah = 0;
+  uint32_t v_al = 0;
+  uint32_t v_i = 0;
+  uint32_t v_j = 0;
+  uint8_t v_cselector = 0;
+  uint8_t v_h = 0;
+  uint8_t v_v = 0;
+  uint8_t v_td = 0;
+  uint8_t v_ta = 0;
+  uint8_t v_bx = 0;
+  uint8_t v_by = 0;
+  uint32_t v_num_blocks = 0;
+  uint32_t v_w = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_prepare_scan[0];
+  if (coro_susp_point) {
+    v_ss = self->private_data.s_prepare_scan[0].v_ss;
+    v_se = self->private_data.s_prepare_scan[0].v_se;
+    v_i = self->private_data.s_prepare_scan[0].v_i;
+    v_c = self->private_data.s_prepare_scan[0].v_c;
+    v_cselector = self->private_data.s_prepare_scan[0].v_cselector;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if ((self->private_impl.f_payload_length < 6) || (self->private_impl.f_num_components == 0)) {
+      status = wuffs_base__make_status(wuffs_jpeg__error__bad_sos_marker);
+      goto exit;
+    }
+    self->private_impl.f_payload_length -= 1;
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_0 = *iop_a_src++;
+      v_c = t_0;
+    }
+    if ((v_c < 1) || (v_c > 3) || (((uint32_t)(v_c)) > self->private_impl.f_num_components)) {
+      status = wuffs_base__make_status(wuffs_jpeg__error__bad_sos_marker);
+      goto exit;
+    }
+    self->private_impl.f_scan_num_components = ((uint32_t)((v_c & 3)));
+    if (self->private_impl.f_payload_length != ((2 * self->private_impl.f_scan_num_components) + 3)) {
+      status = wuffs_base__make_status(wuffs_jpeg__error__bad_sos_marker);
+      goto exit;
+    }
+    self->private_impl.f_payload_length = 0;
+    v_i = 0;
+    while (v_i < self->private_impl.f_scan_num_components) {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint8_t t_1 = *iop_a_src++;
+        v_c = t_1;
+      }
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint8_t t_2 = *iop_a_src++;
+        v_tdta = t_2;
+      }
+      v_j = 0;
+      while (true) {
+        if (v_j >= self->private_impl.f_num_components) {
+          status = wuffs_base__make_status(wuffs_jpeg__error__bad_sos_marker);
+          goto exit;
+        }
+        if (v_c == self->private_impl.f_components_c[v_j]) {
+          v_cselector = ((uint8_t)(v_j));
+          goto label__0__break;
+        }
+        v_j += 1;
+      }
+      label__0__break:;
+      self->private_impl.f_scan_comps_cselector[v_i] = v_cselector;
+      if (((v_tdta >> 4) > 3) || ((v_tdta & 15) > 3)) {
+        status = wuffs_base__make_status(wuffs_jpeg__error__bad_sos_marker);
+        goto exit;
+      }
+      self->private_impl.f_scan_comps_td[v_i] = (v_tdta >> 4);
+      self->private_impl.f_scan_comps_ta[v_i] = (v_tdta & 3);
+      v_i += 1;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint32_t t_3 = *iop_a_src++;
+      v_ss = t_3;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint32_t t_4 = *iop_a_src++;
+      v_se = t_4;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_5 = *iop_a_src++;
+      v_c = t_5;
+    }
+    v_ah = ((uint32_t)((v_c >> 4)));
+    v_al = ((uint32_t)((v_c & 15)));
+    if ( ! self->private_impl.f_is_progressive) {
+      self->private_impl.f_scan_ss = 0;
+      self->private_impl.f_scan_se = 63;
+      self->private_impl.f_scan_ah = 0;
+      self->private_impl.f_scan_al = 0;
+    } else if ((v_ss > v_se) ||
+        (v_se > 63) ||
+        (v_ah > 13) ||
+        (v_al > 13)) {
+      status = wuffs_base__make_status(wuffs_jpeg__error__bad_sos_marker);
+      goto exit;
+    } else if ((v_ss == 0) && (v_se != 0)) {
+      status = wuffs_base__make_status(wuffs_jpeg__error__bad_sos_marker);
+      goto exit;
+    } else if ((v_ss > 0) && (self->private_impl.f_scan_num_components != 1)) {
+      status = wuffs_base__make_status(wuffs_jpeg__error__bad_sos_marker);
+      goto exit;
+    } else if ((v_ah > 0) && (v_ah != (v_al + 1))) {
+      status = wuffs_base__make_status(wuffs_jpeg__error__bad_sos_marker);
+      goto exit;
+    } else {
+      self->private_impl.f_scan_ss = v_ss;
+      self->private_impl.f_scan_se = v_se;
+      self->private_impl.f_scan_ah = v_ah;
+      self->private_impl.f_scan_al = v_al;
+    }
+    v_i = 0;
+    while (v_i < self->private_impl.f_scan_num_components) {
+      v_cselector = self->private_impl.f_scan_comps_cselector[v_i];
+      if ((self->private_impl.f_quant_tables_defined & (((uint8_t)(1)) << self->private_impl.f_components_tq[v_cselector])) == 0) {
+        status = wuffs_base__make_status(wuffs_jpeg__error__missing_quantization_table);
+        goto exit;
+      }
+      if ((self->private_impl.f_scan_ss == 0) && (self->private_impl.f_scan_ah == 0)) {
+        if ((self->private_impl.f_huff_tables_defined & (((uint8_t)(1)) << self->private_impl.f_scan_comps_td[v_i])) == 0) {
+          status = wuffs_base__make_status(wuffs_jpeg__error__missing_huffman_table);
+          goto exit;
+        }
+      }
+      if (self->private_impl.f_scan_se > 0) {
+        if ((self->private_impl.f_huff_tables_defined & (((uint8_t)(1)) << (4 + self->private_impl.f_scan_comps_ta[v_i]))) == 0) {
+          status = wuffs_base__make_status(wuffs_jpeg__error__missing_huffman_table);
+          goto exit;
+        }
+      }
+      v_i += 1;
+    }
+    if (self->private_impl.f_scan_num_components == 1) {
+      v_cselector = self->private_impl.f_scan_comps_cselector[0];
+      v_w = wuffs_jpeg__decoder__div_round_up_by_ratio(self, self->private_impl.f_width, self->private_impl.f_max_incl_components_h, ((uint32_t)(self->private_impl.f_components_h[v_cselector])));
+      self->private_impl.f_scan_width_in_mcus = ((v_w + 7) / 8);
+      v_w = wuffs_jpeg__decoder__div_round_up_by_ratio(self, self->private_impl.f_height, self->private_impl.f_max_incl_components_v, ((uint32_t)(self->private_impl.f_components_v[v_cselector])));
+      self->private_impl.f_scan_height_in_mcus = ((v_w + 7) / 8);
+      self->private_impl.f_mcu_num_blocks = 1;
+      self->private_impl.f_mcu_blocks_cselector[0] = v_cselector;
+      self->private_impl.f_mcu_blocks_dc_hselector[0] = self->private_impl.f_scan_comps_td[0];
+      self->private_impl.f_mcu_blocks_ac_hselector[0] = (4 + self->private_impl.f_scan_comps_ta[0]);
+      self->private_impl.f_mcu_blocks_mx_mul[0] = 1;
+      self->private_impl.f_mcu_blocks_mx_add[0] = 0;
+      self->private_impl.f_mcu_blocks_my_mul[0] = 1;
+      self->private_impl.f_mcu_blocks_my_add[0] = 0;
+    } else {
+      self->private_impl.f_scan_width_in_mcus = self->private_impl.f_width_in_mcus;
+      self->private_impl.f_scan_height_in_mcus = self->private_impl.f_height_in_mcus;
+      v_num_blocks = 0;
+      v_i = 0;
+      while (v_i < self->private_impl.f_scan_num_components) {
+        v_cselector = self->private_impl.f_scan_comps_cselector[v_i];
+        v_h = self->private_impl.f_components_h[v_cselector];
+        v_v = self->private_impl.f_components_v[v_cselector];
+        v_td = self->private_impl.f_scan_comps_td[v_i];
+        v_ta = self->private_impl.f_scan_comps_ta[v_i];
+        v_by = 0;
+        while (v_by < v_v) {
+          v_bx = 0;
+          while (v_bx < v_h) {
+            if (v_num_blocks >= 10) {
+              status = wuffs_base__make_status(wuffs_jpeg__error__bad_sos_marker);
+              goto exit;
+            }
+            self->private_impl.f_mcu_blocks_cselector[v_num_blocks] = v_cselector;
+            self->private_impl.f_mcu_blocks_dc_hselector[v_num_blocks] = v_td;
+            self->private_impl.f_mcu_blocks_ac_hselector[v_num_blocks] = (4 + v_ta);
+            self->private_impl.f_mcu_blocks_mx_mul[v_num_blocks] = v_h;
+            self->private_impl.f_mcu_blocks_mx_add[v_num_blocks] = v_bx;
+            self->private_impl.f_mcu_blocks_my_mul[v_num_blocks] = v_v;
+            self->private_impl.f_mcu_blocks_my_add[v_num_blocks] = v_by;
+            v_num_blocks += 1;
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#endif
+            v_bx += 1;
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+          }
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#endif
+          v_by += 1;
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+        }
+        v_i += 1;
+      }
+      self->private_impl.f_mcu_num_blocks = v_num_blocks;
+    }
+
+    goto ok;
+    ok:
+    self->private_impl.p_prepare_scan[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_prepare_scan[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_prepare_scan[0].v_ss = v_ss;
+  self->private_data.s_prepare_scan[0].v_se = v_se;
+  self->private_data.s_prepare_scan[0].v_i = v_i;
+  self->private_data.s_prepare_scan[0].v_c = v_c;
+  self->private_data.s_prepare_scan[0].v_cselector = v_cselector;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func jpeg.decoder.skip_past_restart_marker
+
+static wuffs_base__status
+wuffs_jpeg__decoder__skip_past_restart_marker(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint16_t v_c = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_skip_past_restart_marker[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    self->private_impl.f_restarts_remaining = self->private_impl.f_restart_interval;
+    self->private_impl.f_bitstream_bits = 0;
+    self->private_impl.f_bitstream_n_bits = 0;
+    self->private_impl.f_bitstream_ri = 0;
+    self->private_impl.f_bitstream_wi = 0;
+    self->private_impl.f_mcu_previous_dc_values[0] = 0;
+    self->private_impl.f_mcu_previous_dc_values[1] = 0;
+    self->private_impl.f_mcu_previous_dc_values[2] = 0;
+    self->private_impl.f_eob_run = 0;
+    if (self->private_impl.f_bitstream_is_closed) {
+    }
+    label__0__continue:;
+    while (true) {
+      if (((uint64_t)(io2_a_src - iop_a_src)) < 2) {
+        if (a_src && a_src->meta.closed) {
+          status = wuffs_base__make_status(wuffs_jpeg__error__truncated_input);
+          goto exit;
+        }
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
+        goto label__0__continue;
+      }
+      v_c = wuffs_base__peek_u16be__no_bounds_check(iop_a_src);
+      if ((v_c >> 8) != 255) {
+        iop_a_src += 1;
+        goto label__0__continue;
+      } else if ((65488 <= v_c) && (v_c <= 65495)) {
+        iop_a_src += 2;
+        self->private_impl.f_bitstream_is_closed = false;
+        goto label__0__break;
+      } else if ((v_c == 65280) || (v_c == 65535)) {
+        iop_a_src += 1;
+        goto label__0__continue;
+      }
+      self->private_impl.f_bitstream_is_closed = true;
+      goto label__0__break;
+    }
+    label__0__break:;
+    self->private_impl.f_next_restart_marker = ((self->private_impl.f_next_restart_marker + 1) & 7);
+
+    ok:
+    self->private_impl.p_skip_past_restart_marker[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_skip_past_restart_marker[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func jpeg.decoder.fill_bitstream
+
+static wuffs_base__empty_struct
+wuffs_jpeg__decoder__fill_bitstream(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__io_buffer* a_src) {
+  uint32_t v_ri = 0;
+  uint32_t v_wi = 0;
+  uint8_t v_c = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  v_ri = self->private_impl.f_bitstream_ri;
+  v_wi = self->private_impl.f_bitstream_wi;
+  if (v_wi < v_ri) {
+    self->private_impl.f_bitstream_ri = 0;
+    self->private_impl.f_bitstream_wi = 0;
+    if (a_src) {
+      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+    }
+    return wuffs_base__make_empty_struct();
+  }
+  if (v_ri >= 4096) {
+    wuffs_base__slice_u8__copy_from_slice(wuffs_base__make_slice_u8(self->private_data.f_bitstream_buffer, 8192), wuffs_base__slice_u8__subslice_ij(wuffs_base__make_slice_u8(self->private_data.f_bitstream_buffer, 8192), v_ri, v_wi));
+    v_wi -= v_ri;
+    v_ri = 0;
+    self->private_impl.f_bitstream_ri = 0;
+  }
+  label__0__continue:;
+  while ((v_wi < 8192) &&  ! self->private_impl.f_bitstream_is_closed) {
+    if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+      goto label__0__break;
+    }
+    v_c = wuffs_base__peek_u8be__no_bounds_check(iop_a_src);
+    if (v_c < 255) {
+      self->private_data.f_bitstream_buffer[v_wi] = v_c;
+      v_wi += 1;
+      iop_a_src += 1;
+      goto label__0__continue;
+    } else if (((uint64_t)(io2_a_src - iop_a_src)) <= 1) {
+      goto label__0__break;
+    }
+    v_c = ((uint8_t)((wuffs_base__peek_u16be__no_bounds_check(iop_a_src) & 255)));
+    if (v_c == 0) {
+      self->private_data.f_bitstream_buffer[v_wi] = 255;
+      v_wi += 1;
+      iop_a_src += 2;
+      goto label__0__continue;
+    } else if (v_c == 255) {
+      iop_a_src += 1;
+      goto label__0__continue;
+    }
+    self->private_impl.f_bitstream_is_closed = true;
+  }
+  label__0__break:;
+  self->private_impl.f_bitstream_wi = v_wi;
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func jpeg.decoder.bitstream_refill
+
+static wuffs_base__empty_struct
+wuffs_jpeg__decoder__bitstream_refill(
+    wuffs_jpeg__decoder* self) {
+  uint64_t v_bits = 0;
+  uint32_t v_n_bits = 0;
+  uint32_t v_ri = 0;
+  uint32_t v_wi = 0;
+  uint32_t v_n = 0;
+  wuffs_base__slice_u8 v_s = {0};
+
+  v_n_bits = self->private_impl.f_bitstream_n_bits;
+  if (v_n_bits >= 56) {
+    return wuffs_base__make_empty_struct();
+  }
+  v_bits = self->private_impl.f_bitstream_bits;
+  v_ri = self->private_impl.f_bitstream_ri;
+  v_wi = self->private_impl.f_bitstream_wi;
+  if (v_ri <= v_wi) {
+    v_s = wuffs_base__slice_u8__subslice_ij(wuffs_base__make_slice_u8(self->private_data.f_bitstream_buffer, 8192), v_ri, v_wi);
+  }
+  if (((uint64_t)(v_s.len)) >= 8) {
+    v_bits |= (wuffs_base__peek_u64be__no_bounds_check(v_s.ptr) >> v_n_bits);
+    v_n = (v_ri + ((63 - v_n_bits) >> 3));
+    v_ri = wuffs_base__u32__min(v_n, v_wi);
+    v_n_bits |= 56;
+  } else {
+    while (v_n_bits < 56) {
+      if ((v_ri < v_wi) && (v_ri < 8192)) {
+        v_bits |= (((uint64_t)(self->private_data.f_bitstream_buffer[v_ri])) << (56 - v_n_bits));
+        v_ri += 1;
+      }
+      v_n_bits += 8;
+    }
+  }
+  self->private_impl.f_bitstream_bits = v_bits;
+  self->private_impl.f_bitstream_n_bits = v_n_bits;
+  self->private_impl.f_bitstream_ri = v_ri;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func jpeg.decoder.decode_huffman
+
+static uint32_t
+wuffs_jpeg__decoder__decode_huffman(
+    wuffs_jpeg__decoder* self,
+    uint32_t a_ht) {
+  uint32_t v_v = 0;
+  uint32_t v_code = 0;
+  uint32_t v_len = 0;
+
+  v_v = ((uint32_t)(self->private_data.f_huff_tables_fast[a_ht][(self->private_impl.f_bitstream_bits >> 56)]));
+  if (v_v != 0) {
+    v_len = ((v_v >> 8) & 15);
+    self->private_impl.f_bitstream_bits <<= v_len;
+    self->private_impl.f_bitstream_n_bits = wuffs_base__u32__sat_sub(self->private_impl.f_bitstream_n_bits, v_len);
+    return (v_v & 255);
+  }
+  v_code = ((uint32_t)((self->private_impl.f_bitstream_bits >> 48)));
+  v_len = 9;
+  while (v_len <= 16) {
+    v_v = (v_code >> (16 - v_len));
+    if (v_v < self->private_data.f_huff_tables_limits[a_ht][v_len]) {
+      self->private_impl.f_bitstream_bits <<= v_len;
+      self->private_impl.f_bitstream_n_bits = wuffs_base__u32__sat_sub(self->private_impl.f_bitstream_n_bits, v_len);
+      return ((uint32_t)(self->private_data.f_huff_tables_symbols[a_ht][(((uint32_t)(v_v + self->private_data.f_huff_tables_offsets[a_ht][v_len])) & 255)]));
+    }
+    v_len += 1;
+  }
+  return 256;
+}
+
+// -------- func jpeg.decoder.read_bits
+
+static uint32_t
+wuffs_jpeg__decoder__read_bits(
+    wuffs_jpeg__decoder* self,
+    uint32_t a_n) {
+  uint32_t v_v = 0;
+
+  if (a_n == 0) {
+    return 0;
+  }
+  v_v = ((uint32_t)((self->private_impl.f_bitstream_bits >> (64 - a_n))));
+  self->private_impl.f_bitstream_bits <<= a_n;
+  self->private_impl.f_bitstream_n_bits = wuffs_base__u32__sat_sub(self->private_impl.f_bitstream_n_bits, a_n);
+  return v_v;
+}
+
+// -------- func jpeg.decoder.extend
+
+static uint16_t
+wuffs_jpeg__decoder__extend(
+    const wuffs_jpeg__decoder* self,
+    uint32_t a_v,
+    uint32_t a_s) {
+  if (a_s == 0) {
+    return 0;
+  } else if (a_v < (((uint32_t)(1)) << (a_s - 1))) {
+    return ((uint16_t)((((uint32_t)(a_v - ((((uint32_t)(1)) << a_s) - 1))) & 65535)));
+  }
+  return ((uint16_t)((a_v & 65535)));
+}
+
+// -------- func jpeg.decoder.decode_mcu
+
+static wuffs_base__status
+wuffs_jpeg__decoder__decode_mcu(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__slice_u8 a_workbuf,
+    uint32_t a_mx,
+    uint32_t a_my) {
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+
+  if ( ! self->private_impl.f_is_progressive) {
+    v_status = wuffs_jpeg__decoder__decode_mcu_sequential(self, a_workbuf, a_mx, a_my);
+  } else if (self->private_impl.f_scan_se == 0) {
+    if (self->private_impl.f_scan_ah == 0) {
+      v_status = wuffs_jpeg__decoder__decode_mcu_progressive_dc_first(self, a_workbuf, a_mx, a_my);
+    } else {
+      v_status = wuffs_jpeg__decoder__decode_mcu_progressive_dc_refine(self, a_workbuf, a_mx, a_my);
+    }
+  } else if (self->private_impl.f_scan_ah == 0) {
+    v_status = wuffs_jpeg__decoder__decode_mcu_progressive_ac_first(self, a_workbuf, a_mx, a_my);
+  } else {
+    v_status = wuffs_jpeg__decoder__decode_mcu_progressive_ac_refine(self, a_workbuf, a_mx, a_my);
+  }
+  return wuffs_base__status__ensure_not_a_suspension(v_status);
+}
+
+// -------- func jpeg.decoder.decode_mcu_sequential
+
+static wuffs_base__status
+wuffs_jpeg__decoder__decode_mcu_sequential(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__slice_u8 a_workbuf,
+    uint32_t a_mx,
+    uint32_t a_my) {
+  uint32_t v_b = 0;
+  uint8_t v_csel = 0;
+  uint32_t v_k = 0;
+  uint32_t v_sym = 0;
+  uint32_t v_r = 0;
+  uint32_t v_s = 0;
+  uint32_t v_v = 0;
+  uint16_t v_dc = 0;
+  uint64_t v_bx = 0;
+  uint64_t v_by = 0;
+  uint64_t v_stride = 0;
+  uint64_t v_offset = 0;
+
+  v_b = 0;
+  while (v_b < self->private_impl.f_mcu_num_blocks) {
+    v_csel = self->private_impl.f_mcu_blocks_cselector[v_b];
+    v_k = 0;
+    while (v_k < 64) {
+      self->private_data.f_mcu_blocks[0][v_k] = 0;
+      v_k += 1;
+    }
+    wuffs_jpeg__decoder__bitstream_refill(self);
+    v_sym = wuffs_jpeg__decoder__decode_huffman(self, ((uint32_t)(self->private_impl.f_mcu_blocks_dc_hselector[v_b])));
+    if (v_sym > 15) {
+      return wuffs_base__make_status(wuffs_jpeg__error__bad_huffman_code);
+    }
+    v_v = wuffs_jpeg__decoder__read_bits(self, v_sym);
+    v_dc = ((uint16_t)(self->private_impl.f_mcu_previous_dc_values[v_csel] + wuffs_jpeg__decoder__extend(self, v_v, v_sym)));
+    self->private_impl.f_mcu_previous_dc_values[v_csel] = v_dc;
+    self->private_data.f_mcu_blocks[0][0] = v_dc;
+    v_k = 1;
+    while (v_k < 64) {
+      wuffs_jpeg__decoder__bitstream_refill(self);
+      v_sym = wuffs_jpeg__decoder__decode_huffman(self, ((uint32_t)(self->private_impl.f_mcu_blocks_ac_hselector[v_b])));
+      if (v_sym > 255) {
+        return wuffs_base__make_status(wuffs_jpeg__error__bad_huffman_code);
+      }
+      v_r = (v_sym >> 4);
+      v_s = (v_sym & 15);
+      if (v_s > 0) {
+        v_k += v_r;
+        v_v = wuffs_jpeg__decoder__read_bits(self, v_s);
+        self->private_data.f_mcu_blocks[0][WUFFS_JPEG__UNZIG[v_k]] = wuffs_jpeg__decoder__extend(self, v_v, v_s);
+        v_k += 1;
+      } else if (v_r == 15) {
+        v_k += 16;
+      } else {
+        goto label__0__break;
+      }
+    }
+    label__0__break:;
+    v_bx = ((uint64_t)(((uint32_t)(((uint32_t)(a_mx * ((uint32_t)(self->private_impl.f_mcu_blocks_mx_mul[v_b])))) + ((uint32_t)(self->private_impl.f_mcu_blocks_mx_add[v_b]))))));
+    v_by = ((uint64_t)(((uint32_t)(((uint32_t)(a_my * ((uint32_t)(self->private_impl.f_mcu_blocks_my_mul[v_b])))) + ((uint32_t)(self->private_impl.f_mcu_blocks_my_add[v_b]))))));
+    v_stride = (((uint64_t)((self->private_impl.f_width_in_mcus * ((uint32_t)(self->private_impl.f_components_h[v_csel]))))) * 8);
+    v_offset = ((uint64_t)(((uint64_t)(self->private_impl.f_workbuf_offsets[v_csel] + (v_bx * 8))) + (v_by * 8 * v_stride)));
+    if (v_offset <= ((uint64_t)(a_workbuf.len))) {
+      wuffs_jpeg__decoder__decode_idct(self, wuffs_base__slice_u8__subslice_i(a_workbuf, v_offset), v_stride, ((uint32_t)(self->private_impl.f_components_tq[v_csel])));
+    }
+    v_b += 1;
+  }
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func jpeg.decoder.coefficients_offset
+
+static uint64_t
+wuffs_jpeg__decoder__coefficients_offset(
+    const wuffs_jpeg__decoder* self,
+    uint32_t a_b,
+    uint32_t a_mx,
+    uint32_t a_my) {
+  uint8_t v_csel = 0;
+  uint64_t v_bx = 0;
+  uint64_t v_by = 0;
+  uint64_t v_bw = 0;
+
+  v_csel = self->private_impl.f_mcu_blocks_cselector[a_b];
+  v_bx = ((uint64_t)(((uint32_t)(((uint32_t)(a_mx * ((uint32_t)(self->private_impl.f_mcu_blocks_mx_mul[a_b])))) + ((uint32_t)(self->private_impl.f_mcu_blocks_mx_add[a_b]))))));
+  v_by = ((uint64_t)(((uint32_t)(((uint32_t)(a_my * ((uint32_t)(self->private_impl.f_mcu_blocks_my_mul[a_b])))) + ((uint32_t)(self->private_impl.f_mcu_blocks_my_add[a_b]))))));
+  v_bw = ((uint64_t)((self->private_impl.f_width_in_mcus * ((uint32_t)(self->private_impl.f_components_h[v_csel])))));
+  return ((uint64_t)(self->private_impl.f_workbuf_offsets[(3 + ((uint32_t)(v_csel)))] + ((uint64_t)(((uint64_t)((v_by * v_bw) + v_bx)) * 128))));
+}
+
+// -------- func jpeg.decoder.decode_mcu_progressive_dc_first
+
+static wuffs_base__status
+wuffs_jpeg__decoder__decode_mcu_progressive_dc_first(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__slice_u8 a_workbuf,
+    uint32_t a_mx,
+    uint32_t a_my) {
+  uint32_t v_b = 0;
+  uint8_t v_csel = 0;
+  uint32_t v_sym = 0;
+  uint32_t v_v = 0;
+  uint16_t v_dc = 0;
+  uint64_t v_offset = 0;
+  wuffs_base__slice_u8 v_blk = {0};
+
+  v_b = 0;
+  while (v_b < self->private_impl.f_mcu_num_blocks) {
+    v_csel = self->private_impl.f_mcu_blocks_cselector[v_b];
+    wuffs_jpeg__decoder__bitstream_refill(self);
+    v_sym = wuffs_jpeg__decoder__decode_huffman(self, ((uint32_t)(self->private_impl.f_mcu_blocks_dc_hselector[v_b])));
+    if (v_sym > 15) {
+      return wuffs_base__make_status(wuffs_jpeg__error__bad_huffman_code);
+    }
+    v_v = wuffs_jpeg__decoder__read_bits(self, v_sym);
+    v_dc = ((uint16_t)(self->private_impl.f_mcu_previous_dc_values[v_csel] + wuffs_jpeg__decoder__extend(self, v_v, v_sym)));
+    self->private_impl.f_mcu_previous_dc_values[v_csel] = v_dc;
+    v_offset = wuffs_jpeg__decoder__coefficients_offset(self, v_b, a_mx, a_my);
+    if (v_offset <= ((uint64_t)(a_workbuf.len))) {
+      v_blk = wuffs_base__slice_u8__subslice_i(a_workbuf, v_offset);
+      if (((uint64_t)(v_blk.len)) >= 2) {
+        wuffs_base__poke_u16le__no_bounds_check(wuffs_base__slice_u8__subslice_j(v_blk, 2).ptr, ((uint16_t)(v_dc << self->private_impl.f_scan_al)));
+      }
+    }
+    v_b += 1;
+  }
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func jpeg.decoder.decode_mcu_progressive_dc_refine
+
+static wuffs_base__status
+wuffs_jpeg__decoder__decode_mcu_progressive_dc_refine(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__slice_u8 a_workbuf,
+    uint32_t a_mx,
+    uint32_t a_my) {
+  uint32_t v_b = 0;
+  uint32_t v_v = 0;
+  uint64_t v_offset = 0;
+  wuffs_base__slice_u8 v_blk = {0};
+
+  v_b = 0;
+  while (v_b < self->private_impl.f_mcu_num_blocks) {
+    wuffs_jpeg__decoder__bitstream_refill(self);
+    v_v = wuffs_jpeg__decoder__read_bits(self, 1);
+    if (v_v != 0) {
+      v_offset = wuffs_jpeg__decoder__coefficients_offset(self, v_b, a_mx, a_my);
+      if (v_offset <= ((uint64_t)(a_workbuf.len))) {
+        v_blk = wuffs_base__slice_u8__subslice_i(a_workbuf, v_offset);
+        if (((uint64_t)(v_blk.len)) >= 2) {
+          wuffs_base__poke_u16le__no_bounds_check(wuffs_base__slice_u8__subslice_j(v_blk, 2).ptr, (wuffs_base__peek_u16le__no_bounds_check(v_blk.ptr) | (((uint16_t)(1)) << self->private_impl.f_scan_al)));
+        }
+      }
+    }
+    v_b += 1;
+  }
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func jpeg.decoder.load_block
+
+static bool
+wuffs_jpeg__decoder__load_block(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__slice_u8 a_workbuf,
+    uint64_t a_offset) {
+  wuffs_base__slice_u8 v_blk = {0};
+  uint32_t v_i = 0;
+
+  if (a_offset > ((uint64_t)(a_workbuf.len))) {
+    return false;
+  }
+  v_blk = wuffs_base__slice_u8__subslice_i(a_workbuf, a_offset);
+  if (((uint64_t)(v_blk.len)) < 128) {
+    return false;
+  }
+  v_i = 0;
+  while ((v_i < 64) && (((uint64_t)(v_blk.len)) >= 2)) {
+    self->private_data.f_mcu_blocks[0][v_i] = wuffs_base__peek_u16le__no_bounds_check(v_blk.ptr);
+    v_blk = wuffs_base__slice_u8__subslice_i(v_blk, 2);
+    v_i += 1;
+  }
+  return true;
+}
+
+// -------- func jpeg.decoder.store_block
+
+static wuffs_base__empty_struct
+wuffs_jpeg__decoder__store_block(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__slice_u8 a_workbuf,
+    uint64_t a_offset) {
+  wuffs_base__slice_u8 v_blk = {0};
+  uint32_t v_i = 0;
+
+  if (a_offset > ((uint64_t)(a_workbuf.len))) {
+    return wuffs_base__make_empty_struct();
+  }
+  v_blk = wuffs_base__slice_u8__subslice_i(a_workbuf, a_offset);
+  if (((uint64_t)(v_blk.len)) < 128) {
+    return wuffs_base__make_empty_struct();
+  }
+  v_i = 0;
+  while ((v_i < 64) && (((uint64_t)(v_blk.len)) >= 2)) {
+    wuffs_base__poke_u16le__no_bounds_check(wuffs_base__slice_u8__subslice_j(v_blk, 2).ptr, self->private_data.f_mcu_blocks[0][v_i]);
+    v_blk = wuffs_base__slice_u8__subslice_i(v_blk, 2);
+    v_i += 1;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func jpeg.decoder.decode_mcu_progressive_ac_first
+
+static wuffs_base__status
+wuffs_jpeg__decoder__decode_mcu_progressive_ac_first(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__slice_u8 a_workbuf,
+    uint32_t a_mx,
+    uint32_t a_my) {
+  uint64_t v_offset = 0;
+  uint32_t v_k = 0;
+  uint32_t v_sym = 0;
+  uint32_t v_r = 0;
+  uint32_t v_s = 0;
+  uint32_t v_v = 0;
+  bool v_loaded = false;
+
+  if (self->private_impl.f_eob_run > 0) {
+    self->private_impl.f_eob_run -= 1;
+    return wuffs_base__make_status(NULL);
+  }
+  v_offset = wuffs_jpeg__decoder__coefficients_offset(self, 0, a_mx, a_my);
+  v_loaded = wuffs_jpeg__decoder__load_block(self, a_workbuf, v_offset);
+  if ( ! v_loaded) {
+    return wuffs_base__make_status(wuffs_jpeg__error__internal_error_inconsistent_workbuf_length);
+  }
+  v_k = self->private_impl.f_scan_ss;
+  while (v_k <= self->private_impl.f_scan_se) {
+    wuffs_jpeg__decoder__bitstream_refill(self);
+    v_sym = wuffs_jpeg__decoder__decode_huffman(self, ((uint32_t)(self->private_impl.f_mcu_blocks_ac_hselector[0])));
+    if (v_sym > 255) {
+      return wuffs_base__make_status(wuffs_jpeg__error__bad_huffman_code);
+    }
+    v_r = (v_sym >> 4);
+    v_s = (v_sym & 15);
+    if (v_s > 0) {
+      v_k += v_r;
+      v_v = wuffs_jpeg__decoder__read_bits(self, v_s);
+      self->private_data.f_mcu_blocks[0][WUFFS_JPEG__UNZIG[v_k]] = ((uint16_t)(wuffs_jpeg__decoder__extend(self, v_v, v_s) << self->private_impl.f_scan_al));
+      v_k += 1;
+    } else if (v_r == 15) {
+      v_k += 16;
+    } else {
+      v_v = wuffs_jpeg__decoder__read_bits(self, v_r);
+      self->private_impl.f_eob_run = (((((uint32_t)(1)) << v_r) - 1) + v_v);
+      goto label__0__break;
+    }
+  }
+  label__0__break:;
+  wuffs_jpeg__decoder__store_block(self, a_workbuf, v_offset);
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func jpeg.decoder.decode_mcu_progressive_ac_refine
+
+static wuffs_base__status
+wuffs_jpeg__decoder__decode_mcu_progressive_ac_refine(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__slice_u8 a_workbuf,
+    uint32_t a_mx,
+    uint32_t a_my) {
+  uint64_t v_offset = 0;
+  uint16_t v_p1 = 0;
+  uint16_t v_m1 = 0;
+  uint32_t v_k = 0;
+  uint32_t v_sym = 0;
+  uint32_t v_r = 0;
+  uint16_t v_s = 0;
+  uint32_t v_v = 0;
+  uint16_t v_coef = 0;
+  bool v_loaded = false;
+
+  v_offset = wuffs_jpeg__decoder__coefficients_offset(self, 0, a_mx, a_my);
+  v_loaded = wuffs_jpeg__decoder__load_block(self, a_workbuf, v_offset);
+  if ( ! v_loaded) {
+    return wuffs_base__make_status(wuffs_jpeg__error__internal_error_inconsistent_workbuf_length);
+  }
+  v_p1 = (((uint16_t)(1)) << self->private_impl.f_scan_al);
+  v_m1 = ((uint16_t)(((uint16_t)(65535)) << self->private_impl.f_scan_al));
+  v_k = self->private_impl.f_scan_ss;
+  if (self->private_impl.f_eob_run == 0) {
+    while (v_k <= self->private_impl.f_scan_se) {
+      wuffs_jpeg__decoder__bitstream_refill(self);
+      v_sym = wuffs_jpeg__decoder__decode_huffman(self, ((uint32_t)(self->private_impl.f_mcu_blocks_ac_hselector[0])));
+      if (v_sym > 255) {
+        return wuffs_base__make_status(wuffs_jpeg__error__bad_huffman_code);
+      }
+      v_r = (v_sym >> 4);
+      v_s = 0;
+      if ((v_sym & 15) != 0) {
+        v_v = wuffs_jpeg__decoder__read_bits(self, 1);
+        if (v_v != 0) {
+          v_s = v_p1;
+        } else {
+          v_s = v_m1;
+        }
+      } else if (v_r != 15) {
+        v_v = wuffs_jpeg__decoder__read_bits(self, v_r);
+        self->private_impl.f_eob_run = ((((uint32_t)(1)) << v_r) + v_v);
+        goto label__0__break;
+      }
+      while (v_k <= self->private_impl.f_scan_se) {
+        v_coef = self->private_data.f_mcu_blocks[0][WUFFS_JPEG__UNZIG[v_k]];
+        if (v_coef != 0) {
+          wuffs_jpeg__decoder__bitstream_refill(self);
+          v_v = wuffs_jpeg__decoder__read_bits(self, 1);
+          if ((v_v != 0) && ((v_coef & v_p1) == 0)) {
+            if ((v_coef >> 15) == 0) {
+              self->private_data.f_mcu_blocks[0][WUFFS_JPEG__UNZIG[v_k]] = ((uint16_t)(v_coef + v_p1));
+            } else {
+              self->private_data.f_mcu_blocks[0][WUFFS_JPEG__UNZIG[v_k]] = ((uint16_t)(v_coef + v_m1));
+            }
+          }
+        } else {
+          if (v_r == 0) {
+            goto label__1__break;
+          }
+          v_r -= 1;
+        }
+        v_k += 1;
+      }
+      label__1__break:;
+      if ((v_s != 0) && (v_k < 80)) {
+        self->private_data.f_mcu_blocks[0][WUFFS_JPEG__UNZIG[v_k]] = v_s;
+      }
+      if (v_k >= 64) {
+        goto label__0__break;
+      }
+      v_k += 1;
+    }
+    label__0__break:;
+  }
+  if (self->private_impl.f_eob_run > 0) {
+    while (v_k <= self->private_impl.f_scan_se) {
+      v_coef = self->private_data.f_mcu_blocks[0][WUFFS_JPEG__UNZIG[v_k]];
+      if (v_coef != 0) {
+        wuffs_jpeg__decoder__bitstream_refill(self);
+        v_v = wuffs_jpeg__decoder__read_bits(self, 1);
+        if ((v_v != 0) && ((v_coef & v_p1) == 0)) {
+          if ((v_coef >> 15) == 0) {
+            self->private_data.f_mcu_blocks[0][WUFFS_JPEG__UNZIG[v_k]] = ((uint16_t)(v_coef + v_p1));
+          } else {
+            self->private_data.f_mcu_blocks[0][WUFFS_JPEG__UNZIG[v_k]] = ((uint16_t)(v_coef + v_m1));
+          }
+        }
+      }
+      v_k += 1;
+    }
+    wuffs_base__u32__sat_sub_indirect(&self->private_impl.f_eob_run, 1);
+  }
+  wuffs_jpeg__decoder__store_block(self, a_workbuf, v_offset);
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func jpeg.decoder.decode_idct
+
+static wuffs_base__empty_struct
+wuffs_jpeg__decoder__decode_idct(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__slice_u8 a_dst_buffer,
+    uint64_t a_dst_stride,
+    uint32_t a_q) {
+  uint32_t v_ws[64] = {0};
+  uint32_t v_i = 0;
+  uint32_t v_in0 = 0;
+  uint32_t v_in1 = 0;
+  uint32_t v_in2 = 0;
+  uint32_t v_in3 = 0;
+  uint32_t v_in4 = 0;
+  uint32_t v_in5 = 0;
+  uint32_t v_in6 = 0;
+  uint32_t v_in7 = 0;
+  uint32_t v_z1 = 0;
+  uint32_t v_z2 = 0;
+  uint32_t v_z3 = 0;
+  uint32_t v_z4 = 0;
+  uint32_t v_z5 = 0;
+  uint32_t v_tmp0 = 0;
+  uint32_t v_tmp1 = 0;
+  uint32_t v_tmp2 = 0;
+  uint32_t v_tmp3 = 0;
+  uint32_t v_tmp10 = 0;
+  uint32_t v_tmp11 = 0;
+  uint32_t v_tmp12 = 0;
+  uint32_t v_tmp13 = 0;
+  wuffs_base__slice_u8 v_dst = {0};
+
+  v_i = 0;
+  label__0__continue:;
+  while (v_i < 8) {
+    v_in0 = ((uint32_t)(((uint32_t)(((uint32_t)((self->private_data.f_mcu_blocks[0][(0 + v_i)] ^ 32768))) - 32768)) * ((uint32_t)(self->private_data.f_quant_tables[a_q][(0 + v_i)]))));
+    v_in1 = ((uint32_t)(((uint32_t)(((uint32_t)((self->private_data.f_mcu_blocks[0][(8 + v_i)] ^ 32768))) - 32768)) * ((uint32_t)(self->private_data.f_quant_tables[a_q][(8 + v_i)]))));
+    v_in2 = ((uint32_t)(((uint32_t)(((uint32_t)((self->private_data.f_mcu_blocks[0][(16 + v_i)] ^ 32768))) - 32768)) * ((uint32_t)(self->private_data.f_quant_tables[a_q][(16 + v_i)]))));
+    v_in3 = ((uint32_t)(((uint32_t)(((uint32_t)((self->private_data.f_mcu_blocks[0][(24 + v_i)] ^ 32768))) - 32768)) * ((uint32_t)(self->private_data.f_quant_tables[a_q][(24 + v_i)]))));
+    v_in4 = ((uint32_t)(((uint32_t)(((uint32_t)((self->private_data.f_mcu_blocks[0][(32 + v_i)] ^ 32768))) - 32768)) * ((uint32_t)(self->private_data.f_quant_tables[a_q][(32 + v_i)]))));
+    v_in5 = ((uint32_t)(((uint32_t)(((uint32_t)((self->private_data.f_mcu_blocks[0][(40 + v_i)] ^ 32768))) - 32768)) * ((uint32_t)(self->private_data.f_quant_tables[a_q][(40 + v_i)]))));
+    v_in6 = ((uint32_t)(((uint32_t)(((uint32_t)((self->private_data.f_mcu_blocks[0][(48 + v_i)] ^ 32768))) - 32768)) * ((uint32_t)(self->private_data.f_quant_tables[a_q][(48 + v_i)]))));
+    v_in7 = ((uint32_t)(((uint32_t)(((uint32_t)((self->private_data.f_mcu_blocks[0][(56 + v_i)] ^ 32768))) - 32768)) * ((uint32_t)(self->private_data.f_quant_tables[a_q][(56 + v_i)]))));
+    if (0 == (v_in1 |
+        v_in2 |
+        v_in3 |
+        v_in4 |
+        v_in5 |
+        v_in6 |
+        v_in7)) {
+      v_in0 <<= 2;
+      v_ws[(0 + v_i)] = v_in0;
+      v_ws[(8 + v_i)] = v_in0;
+      v_ws[(16 + v_i)] = v_in0;
+      v_ws[(24 + v_i)] = v_in0;
+      v_ws[(32 + v_i)] = v_in0;
+      v_ws[(40 + v_i)] = v_in0;
+      v_ws[(48 + v_i)] = v_in0;
+      v_ws[(56 + v_i)] = v_in0;
+      v_i += 1;
+      goto label__0__continue;
+    }
+    v_z1 = ((uint32_t)(((uint32_t)(v_in2 + v_in6)) * 4433));
+    v_tmp2 = ((uint32_t)(v_z1 - ((uint32_t)(v_in6 * 15137))));
+    v_tmp3 = ((uint32_t)(v_z1 + ((uint32_t)(v_in2 * 6270))));
+    v_tmp0 = ((uint32_t)(((uint32_t)(v_in0 + v_in4)) << 13));
+    v_tmp1 = ((uint32_t)(((uint32_t)(v_in0 - v_in4)) << 13));
+    v_tmp10 = ((uint32_t)(v_tmp0 + v_tmp3));
+    v_tmp13 = ((uint32_t)(v_tmp0 - v_tmp3));
+    v_tmp11 = ((uint32_t)(v_tmp1 + v_tmp2));
+    v_tmp12 = ((uint32_t)(v_tmp1 - v_tmp2));
+    v_z1 = ((uint32_t)(v_in7 + v_in1));
+    v_z2 = ((uint32_t)(v_in5 + v_in3));
+    v_z3 = ((uint32_t)(v_in7 + v_in3));
+    v_z4 = ((uint32_t)(v_in5 + v_in1));
+    v_z5 = ((uint32_t)(((uint32_t)(v_z3 + v_z4)) * 9633));
+    v_tmp0 = ((uint32_t)(v_in7 * 2446));
+    v_tmp1 = ((uint32_t)(v_in5 * 16819));
+    v_tmp2 = ((uint32_t)(v_in3 * 25172));
+    v_tmp3 = ((uint32_t)(v_in1 * 12299));
+    v_z1 = ((uint32_t)(0 - ((uint32_t)(v_z1 * 7373))));
+    v_z2 = ((uint32_t)(0 - ((uint32_t)(v_z2 * 20995))));
+    v_z3 = ((uint32_t)(((uint32_t)(0 - ((uint32_t)(v_z3 * 16069)))) + v_z5));
+    v_z4 = ((uint32_t)(((uint32_t)(0 - ((uint32_t)(v_z4 * 3196)))) + v_z5));
+    v_tmp0 = ((uint32_t)(((uint32_t)(v_tmp0 + v_z1)) + v_z3));
+    v_tmp1 = ((uint32_t)(((uint32_t)(v_tmp1 + v_z2)) + v_z4));
+    v_tmp2 = ((uint32_t)(((uint32_t)(v_tmp2 + v_z2)) + v_z3));
+    v_tmp3 = ((uint32_t)(((uint32_t)(v_tmp3 + v_z1)) + v_z4));
+    v_ws[(0 + v_i)] = ((uint32_t)((((uint32_t)(((uint32_t)(v_tmp10 + v_tmp3)) + 2147484672)) >> 11) - 1048576));
+    v_ws[(56 + v_i)] = ((uint32_t)((((uint32_t)(((uint32_t)(v_tmp10 - v_tmp3)) + 2147484672)) >> 11) - 1048576));
+    v_ws[(8 + v_i)] = ((uint32_t)((((uint32_t)(((uint32_t)(v_tmp11 + v_tmp2)) + 2147484672)) >> 11) - 1048576));
+    v_ws[(48 + v_i)] = ((uint32_t)((((uint32_t)(((uint32_t)(v_tmp11 - v_tmp2)) + 2147484672)) >> 11) - 1048576));
+    v_ws[(16 + v_i)] = ((uint32_t)((((uint32_t)(((uint32_t)(v_tmp12 + v_tmp1)) + 2147484672)) >> 11) - 1048576));
+    v_ws[(40 + v_i)] = ((uint32_t)((((uint32_t)(((uint32_t)(v_tmp12 - v_tmp1)) + 2147484672)) >> 11) - 1048576));
+    v_ws[(24 + v_i)] = ((uint32_t)((((uint32_t)(((uint32_t)(v_tmp13 + v_tmp0)) + 2147484672)) >> 11) - 1048576));
+    v_ws[(32 + v_i)] = ((uint32_t)((((uint32_t)(((uint32_t)(v_tmp13 - v_tmp0)) + 2147484672)) >> 11) - 1048576));
+    v_i += 1;
+  }
+  v_dst = a_dst_buffer;
+  v_i = 0;
+  while (v_i < 8) {
+    v_in0 = v_ws[((8 * v_i) + 0)];
+    v_in1 = v_ws[((8 * v_i) + 1)];
+    v_in2 = v_ws[((8 * v_i) + 2)];
+    v_in3 = v_ws[((8 * v_i) + 3)];
+    v_in4 = v_ws[((8 * v_i) + 4)];
+    v_in5 = v_ws[((8 * v_i) + 5)];
+    v_in6 = v_ws[((8 * v_i) + 6)];
+    v_in7 = v_ws[((8 * v_i) + 7)];
+    if (((uint64_t)(v_dst.len)) < 8) {
+      return wuffs_base__make_empty_struct();
+    }
+    if (0 == (v_in1 |
+        v_in2 |
+        v_in3 |
+        v_in4 |
+        v_in5 |
+        v_in6 |
+        v_in7)) {
+      wuffs_base__poke_u64le__no_bounds_check(wuffs_base__slice_u8__subslice_j(v_dst, 8).ptr, ((uint64_t)(72340172838076673 * ((uint64_t)(wuffs_jpeg__decoder__clamp(self, (((uint32_t)(v_in0 + 16)) >> 5)))))));
+    } else {
+      v_z1 = ((uint32_t)(((uint32_t)(v_in2 + v_in6)) * 4433));
+      v_tmp2 = ((uint32_t)(v_z1 - ((uint32_t)(v_in6 * 15137))));
+      v_tmp3 = ((uint32_t)(v_z1 + ((uint32_t)(v_in2 * 6270))));
+      v_tmp0 = ((uint32_t)(((uint32_t)(v_in0 + v_in4)) << 13));
+      v_tmp1 = ((uint32_t)(((uint32_t)(v_in0 - v_in4)) << 13));
+      v_tmp10 = ((uint32_t)(v_tmp0 + v_tmp3));
+      v_tmp13 = ((uint32_t)(v_tmp0 - v_tmp3));
+      v_tmp11 = ((uint32_t)(v_tmp1 + v_tmp2));
+      v_tmp12 = ((uint32_t)(v_tmp1 - v_tmp2));
+      v_z1 = ((uint32_t)(v_in7 + v_in1));
+      v_z2 = ((uint32_t)(v_in5 + v_in3));
+      v_z3 = ((uint32_t)(v_in7 + v_in3));
+      v_z4 = ((uint32_t)(v_in5 + v_in1));
+      v_z5 = ((uint32_t)(((uint32_t)(v_z3 + v_z4)) * 9633));
+      v_tmp0 = ((uint32_t)(v_in7 * 2446));
+      v_tmp1 = ((uint32_t)(v_in5 * 16819));
+      v_tmp2 = ((uint32_t)(v_in3 * 25172));
+      v_tmp3 = ((uint32_t)(v_in1 * 12299));
+      v_z1 = ((uint32_t)(0 - ((uint32_t)(v_z1 * 7373))));
+      v_z2 = ((uint32_t)(0 - ((uint32_t)(v_z2 * 20995))));
+      v_z3 = ((uint32_t)(((uint32_t)(0 - ((uint32_t)(v_z3 * 16069)))) + v_z5));
+      v_z4 = ((uint32_t)(((uint32_t)(0 - ((uint32_t)(v_z4 * 3196)))) + v_z5));
+      v_tmp0 = ((uint32_t)(((uint32_t)(v_tmp0 + v_z1)) + v_z3));
+      v_tmp1 = ((uint32_t)(((uint32_t)(v_tmp1 + v_z2)) + v_z4));
+      v_tmp2 = ((uint32_t)(((uint32_t)(v_tmp2 + v_z2)) + v_z3));
+      v_tmp3 = ((uint32_t)(((uint32_t)(v_tmp3 + v_z1)) + v_z4));
+      wuffs_base__poke_u64le__no_bounds_check(wuffs_base__slice_u8__subslice_j(v_dst, 8).ptr, ((((uint64_t)(wuffs_jpeg__decoder__clamp(self, (((uint32_t)(((uint32_t)(v_tmp10 + v_tmp3)) + 131072)) >> 18)))) << 0) |
+          (((uint64_t)(wuffs_jpeg__decoder__clamp(self, (((uint32_t)(((uint32_t)(v_tmp11 + v_tmp2)) + 131072)) >> 18)))) << 8) |
+          (((uint64_t)(wuffs_jpeg__decoder__clamp(self, (((uint32_t)(((uint32_t)(v_tmp12 + v_tmp1)) + 131072)) >> 18)))) << 16) |
+          (((uint64_t)(wuffs_jpeg__decoder__clamp(self, (((uint32_t)(((uint32_t)(v_tmp13 + v_tmp0)) + 131072)) >> 18)))) << 24) |
+          (((uint64_t)(wuffs_jpeg__decoder__clamp(self, (((uint32_t)(((uint32_t)(v_tmp13 - v_tmp0)) + 131072)) >> 18)))) << 32) |
+          (((uint64_t)(wuffs_jpeg__decoder__clamp(self, (((uint32_t)(((uint32_t)(v_tmp12 - v_tmp1)) + 131072)) >> 18)))) << 40) |
+          (((uint64_t)(wuffs_jpeg__decoder__clamp(self, (((uint32_t)(((uint32_t)(v_tmp11 - v_tmp2)) + 131072)) >> 18)))) << 48) |
+          (((uint64_t)(wuffs_jpeg__decoder__clamp(self, (((uint32_t)(((uint32_t)(v_tmp10 - v_tmp3)) + 131072)) >> 18)))) << 56)));
+    }
+    if (a_dst_stride > ((uint64_t)(v_dst.len))) {
+      return wuffs_base__make_empty_struct();
+    }
+    v_dst = wuffs_base__slice_u8__subslice_i(v_dst, a_dst_stride);
+    v_i += 1;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func jpeg.decoder.clamp
+
+static uint8_t
+wuffs_jpeg__decoder__clamp(
+    const wuffs_jpeg__decoder* self,
+    uint32_t a_a) {
+  uint32_t v_u = 0;
+
+  v_u = (((uint32_t)(a_a + 128)) & 1023);
+  if (v_u < 256) {
+    return ((uint8_t)((v_u & 255)));
+  } else if (v_u < 640) {
+    return 255;
+  }
+  return 0;
+}
+
+// -------- func jpeg.decoder.set_quirk_enabled
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_jpeg__decoder__set_quirk_enabled(
+    wuffs_jpeg__decoder* self,
+    uint32_t a_quirk,
+    bool a_enabled) {
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func jpeg.decoder.decode_image_config
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_jpeg__decoder__decode_image_config(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__image_config* a_dst,
+    wuffs_base__io_buffer* a_src) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+        ? wuffs_base__error__disabled_by_previous_error
+        : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 1)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t v_c = 0;
+  uint8_t v_marker = 0;
+  uint32_t v_length = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_image_config[0];
+  if (coro_susp_point) {
+    v_c = self->private_data.s_decode_image_config[0].v_c;
+    v_marker = self->private_data.s_decode_image_config[0].v_marker;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_call_sequence != 0) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
+      goto exit;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_0 = *iop_a_src++;
+      v_c = t_0;
+    }
+    if (v_c != 255) {
+      status = wuffs_base__make_status(wuffs_jpeg__error__bad_header);
+      goto exit;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_1 = *iop_a_src++;
+      v_c = t_1;
+    }
+    if (v_c != 216) {
+      status = wuffs_base__make_status(wuffs_jpeg__error__bad_header);
+      goto exit;
+    }
+    label__0__continue:;
+    while (true) {
+      label__1__continue:;
+      while (true) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint8_t t_2 = *iop_a_src++;
+          v_c = t_2;
+        }
+        if (v_c != 255) {
+          goto label__1__continue;
+        }
+        while (v_c == 255) {
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint8_t t_3 = *iop_a_src++;
+            v_c = t_3;
+          }
+        }
+        if (v_c != 0) {
+          goto label__1__break;
+        }
+      }
+      label__1__break:;
+      v_marker = v_c;
+      if ((208 <= v_marker) && (v_marker <= 215)) {
+        goto label__0__continue;
+      } else if ((v_marker == 216) || (v_marker == 217) || (v_marker == 218)) {
+        status = wuffs_base__make_status(wuffs_jpeg__error__bad_marker);
+        goto exit;
+      }
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+        uint32_t t_4;
+        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+          t_4 = ((uint32_t)(wuffs_base__peek_u16be__no_bounds_check(iop_a_src)));
+          iop_a_src += 2;
+        } else {
+          self->private_data.s_decode_image_config[0].scratch = 0;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+          while (true) {
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint64_t* scratch = &self->private_data.s_decode_image_config[0].scratch;
+            uint32_t num_bits_4 = ((uint32_t)(*scratch & 0xFF));
+            *scratch >>= 8;
+            *scratch <<= 8;
+            *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_4);
+            if (num_bits_4 == 8) {
+              t_4 = ((uint32_t)(*scratch >> 48));
+              break;
+            }
+            num_bits_4 += 8;
+            *scratch |= ((uint64_t)(num_bits_4));
+          }
+        }
+        v_length = t_4;
+      }
+      if (v_length < 2) {
+        status = wuffs_base__make_status(wuffs_jpeg__error__bad_marker);
+        goto exit;
+      }
+      self->private_impl.f_payload_length = (v_length - 2);
+      if ((v_marker & 240) == 192) {
+        if ((v_marker == 192) || (v_marker == 193) || (v_marker == 194)) {
+          self->private_impl.f_is_progressive = (v_marker == 194);
+          if (a_src) {
+            a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+          }
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+          status = wuffs_jpeg__decoder__decode_sof(self, a_src);
+          if (a_src) {
+            iop_a_src = a_src->data.ptr + a_src->meta.ri;
+          }
+          if (status.repr) {
+            goto suspend;
+          }
+          goto label__0__break;
+        } else if (v_marker == 196) {
+          if (a_src) {
+            a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+          }
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+          status = wuffs_jpeg__decoder__decode_dht(self, a_src);
+          if (a_src) {
+            iop_a_src = a_src->data.ptr + a_src->meta.ri;
+          }
+          if (status.repr) {
+            goto suspend;
+          }
+          goto label__0__continue;
+        } else if ((v_marker == 195) || (v_marker == 199)) {
+          status = wuffs_base__make_status(wuffs_jpeg__error__unsupported_lossless_coding);
+          goto exit;
+        } else if ((v_marker == 197) || (v_marker == 198)) {
+          status = wuffs_base__make_status(wuffs_jpeg__error__unsupported_hierarchical_coding);
+          goto exit;
+        } else if (v_marker != 200) {
+          status = wuffs_base__make_status(wuffs_jpeg__error__unsupported_arithmetic_coding);
+          goto exit;
+        }
+      }
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
+      status = wuffs_jpeg__decoder__decode_other_marker(self, a_src, v_marker);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+    }
+    label__0__break:;
+    self->private_impl.f_frame_config_io_position = wuffs_base__u64__sat_add((a_src ? a_src->meta.pos : 0), ((uint64_t)(iop_a_src - io0_a_src)));
+    if (a_dst != NULL) {
+      wuffs_base__image_config__set(
+          a_dst,
+          wuffs_jpeg__decoder__dst_pixfmt(self),
+          0,
+          self->private_impl.f_width,
+          self->private_impl.f_height,
+          self->private_impl.f_frame_config_io_position,
+          true);
+    }
+    self->private_impl.f_call_sequence = 3;
+
+    goto ok;
+    ok:
+    self->private_impl.p_decode_image_config[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_image_config[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine = wuffs_base__status__is_suspension(&status) ? 1 : 0;
+  WUFFS_BASE__STATS__ADD(self->private_impl, WUFFS_BASE__STATS__SUSPENSIONS,
+      wuffs_base__status__is_suspension(&status) ? 1u : 0u);
+  self->private_data.s_decode_image_config[0].v_c = v_c;
+  self->private_data.s_decode_image_config[0].v_marker = v_marker;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func jpeg.decoder.dst_pixfmt
+
+static uint32_t
+wuffs_jpeg__decoder__dst_pixfmt(
+    const wuffs_jpeg__decoder* self) {
+  if (self->private_impl.f_num_components == 1) {
+    return 536870920;
+  }
+  return 2415954056;
+}
+
+// -------- func jpeg.decoder.decode_other_marker
+
+static wuffs_base__status
+wuffs_jpeg__decoder__decode_other_marker(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    uint8_t a_marker) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_other_marker[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (a_marker == 196) {
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      status = wuffs_jpeg__decoder__decode_dht(self, a_src);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+    } else if (a_marker == 219) {
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      status = wuffs_jpeg__decoder__decode_dqt(self, a_src);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+    } else if (a_marker == 221) {
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      status = wuffs_jpeg__decoder__decode_dri(self, a_src);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+    } else if (a_marker == 224) {
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+      status = wuffs_jpeg__decoder__decode_appn(self, a_src, a_marker);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+    } else if (a_marker == 238) {
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+      status = wuffs_jpeg__decoder__decode_appn(self, a_src, a_marker);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+    } else if (a_marker == 220) {
+      status = wuffs_base__make_status(wuffs_jpeg__error__unsupported_marker);
+      goto exit;
+    } else {
+      self->private_data.s_decode_other_marker[0].scratch = self->private_impl.f_payload_length;
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+      if (self->private_data.s_decode_other_marker[0].scratch > ((uint64_t)(io2_a_src - iop_a_src))) {
+        self->private_data.s_decode_other_marker[0].scratch -= ((uint64_t)(io2_a_src - iop_a_src));
+        iop_a_src = io2_a_src;
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      iop_a_src += self->private_data.s_decode_other_marker[0].scratch;
+      self->private_impl.f_payload_length = 0;
+    }
+
+    goto ok;
+    ok:
+    self->private_impl.p_decode_other_marker[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_other_marker[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func jpeg.decoder.decode_appn
+
+static wuffs_base__status
+wuffs_jpeg__decoder__decode_appn(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    uint8_t a_marker) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_c = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_appn[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (a_marker == 224) {
+      if (self->private_impl.f_payload_length >= 5) {
+        self->private_impl.f_payload_length -= 5;
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+          uint32_t t_0;
+          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+            t_0 = wuffs_base__peek_u32le__no_bounds_check(iop_a_src);
+            iop_a_src += 4;
+          } else {
+            self->private_data.s_decode_appn[0].scratch = 0;
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+            while (true) {
+              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+                goto suspend;
+              }
+              uint64_t* scratch = &self->private_data.s_decode_appn[0].scratch;
+              uint32_t num_bits_0 = ((uint32_t)(*scratch >> 56));
+              *scratch <<= 8;
+              *scratch >>= 8;
+              *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_0;
+              if (num_bits_0 == 24) {
+                t_0 = ((uint32_t)(*scratch));
+                break;
+              }
+              num_bits_0 += 8;
+              *scratch |= ((uint64_t)(num_bits_0)) << 56;
+            }
+          }
+          v_c = t_0;
+        }
+        if (v_c == 1179207242) {
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint32_t t_1 = *iop_a_src++;
+            v_c = t_1;
+          }
+          if (v_c == 0) {
+            self->private_impl.f_is_jfif = true;
+          }
+        } else {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          iop_a_src++;
+        }
+      }
+    } else if (a_marker == 238) {
+      if (self->private_impl.f_payload_length >= 12) {
+        self->private_impl.f_payload_length -= 12;
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+          uint32_t t_2;
+          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+            t_2 = wuffs_base__peek_u32le__no_bounds_check(iop_a_src);
+            iop_a_src += 4;
+          } else {
+            self->private_data.s_decode_appn[0].scratch = 0;
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+            while (true) {
+              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+                goto suspend;
+              }
+              uint64_t* scratch = &self->private_data.s_decode_appn[0].scratch;
+              uint32_t num_bits_2 = ((uint32_t)(*scratch >> 56));
+              *scratch <<= 8;
+              *scratch >>= 8;
+              *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_2;
+              if (num_bits_2 == 24) {
+                t_2 = ((uint32_t)(*scratch));
+                break;
+              }
+              num_bits_2 += 8;
+              *scratch |= ((uint64_t)(num_bits_2)) << 56;
+            }
+          }
+          v_c = t_2;
+        }
+        if (v_c == 1651467329) {
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint32_t t_3 = *iop_a_src++;
+            v_c = t_3;
+          }
+          if (v_c == 101) {
+            self->private_data.s_decode_appn[0].scratch = 6;
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+            if (self->private_data.s_decode_appn[0].scratch > ((uint64_t)(io2_a_src - iop_a_src))) {
+              self->private_data.s_decode_appn[0].scratch -= ((uint64_t)(io2_a_src - iop_a_src));
+              iop_a_src = io2_a_src;
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            iop_a_src += self->private_data.s_decode_appn[0].scratch;
+            {
+              WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
+              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+                goto suspend;
+              }
+              uint8_t t_4 = *iop_a_src++;
+              self->private_impl.f_adobe_transform = t_4;
+            }
+            self->private_impl.f_is_adobe = true;
+          } else {
+            self->private_data.s_decode_appn[0].scratch = 7;
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(10);
+            if (self->private_data.s_decode_appn[0].scratch > ((uint64_t)(io2_a_src - iop_a_src))) {
+              self->private_data.s_decode_appn[0].scratch -= ((uint64_t)(io2_a_src - iop_a_src));
+              iop_a_src = io2_a_src;
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            iop_a_src += self->private_data.s_decode_appn[0].scratch;
+          }
+        } else {
+          self->private_data.s_decode_appn[0].scratch = 8;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(11);
+          if (self->private_data.s_decode_appn[0].scratch > ((uint64_t)(io2_a_src - iop_a_src))) {
+            self->private_data.s_decode_appn[0].scratch -= ((uint64_t)(io2_a_src - iop_a_src));
+            iop_a_src = io2_a_src;
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          iop_a_src += self->private_data.s_decode_appn[0].scratch;
+        }
+      }
+    }
+    self->private_data.s_decode_appn[0].scratch = self->private_impl.f_payload_length;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(12);
+    if (self->private_data.s_decode_appn[0].scratch > ((uint64_t)(io2_a_src - iop_a_src))) {
+      self->private_data.s_decode_appn[0].scratch -= ((uint64_t)(io2_a_src - iop_a_src));
+      iop_a_src = io2_a_src;
+      status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+      goto suspend;
+    }
+    iop_a_src += self->private_data.s_decode_appn[0].scratch;
+    self->private_impl.f_payload_length = 0;
+
+    goto ok;
+    ok:
+    self->private_impl.p_decode_appn[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_appn[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func jpeg.decoder.decode_dqt
+
+static wuffs_base__status
+wuffs_jpeg__decoder__decode_dqt(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t v_c = 0;
+  uint8_t v_q = 0;
+  uint32_t v_i = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_dqt[0];
+  if (coro_susp_point) {
+    v_i = self->private_data.s_decode_dqt[0].v_i;
+    v_q = self->private_data.s_decode_dqt[0].v_q;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    while (self->private_impl.f_payload_length > 0) {
+      self->private_impl.f_payload_length -= 1;
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint8_t t_0 = *iop_a_src++;
+        v_c = t_0;
+      }
+      if ((v_c & 15) > 3) {
+        status = wuffs_base__make_status(wuffs_jpeg__error__bad_dqt_marker);
+        goto exit;
+      }
+      v_q = (v_c & 3);
+      if ((v_c >> 4) == 0) {
+        if (self->private_impl.f_payload_length < 64) {
+          status = wuffs_base__make_status(wuffs_jpeg__error__bad_dqt_marker);
+          goto exit;
+        }
+        self->private_impl.f_payload_length -= 64;
+        v_i = 0;
+        while (v_i < 64) {
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint8_t t_1 = *iop_a_src++;
+            v_c = t_1;
+          }
+          self->private_data.f_quant_tables[v_q][WUFFS_JPEG__UNZIG[v_i]] = ((uint16_t)(v_c));
+          v_i += 1;
+        }
+      } else if ((v_c >> 4) == 1) {
+        if (self->private_impl.f_payload_length < 128) {
+          status = wuffs_base__make_status(wuffs_jpeg__error__bad_dqt_marker);
+          goto exit;
+        }
+        self->private_impl.f_payload_length -= 128;
+        v_i = 0;
+        while (v_i < 64) {
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+            uint16_t t_2;
+            if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+              t_2 = wuffs_base__peek_u16be__no_bounds_check(iop_a_src);
+              iop_a_src += 2;
+            } else {
+              self->private_data.s_decode_dqt[0].scratch = 0;
+              WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+              while (true) {
+                if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                  status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+                  goto suspend;
+                }
+                uint64_t* scratch = &self->private_data.s_decode_dqt[0].scratch;
+                uint32_t num_bits_2 = ((uint32_t)(*scratch & 0xFF));
+                *scratch >>= 8;
+                *scratch <<= 8;
+                *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_2);
+                if (num_bits_2 == 8) {
+                  t_2 = ((uint16_t)(*scratch >> 48));
+                  break;
+                }
+                num_bits_2 += 8;
+                *scratch |= ((uint64_t)(num_bits_2));
+              }
+            }
+            self->private_data.f_quant_tables[v_q][WUFFS_JPEG__UNZIG[v_i]] = t_2;
+          }
+          v_i += 1;
+        }
+      } else {
+        status = wuffs_base__make_status(wuffs_jpeg__error__bad_dqt_marker);
+        goto exit;
+      }
+      self->private_impl.f_quant_tables_defined |= (((uint8_t)(1)) << v_q);
+    }
+
+    goto ok;
+    ok:
+    self->private_impl.p_decode_dqt[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_dqt[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_decode_dqt[0].v_i = v_i;
+  self->private_data.s_decode_dqt[0].v_q = v_q;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func jpeg.decoder.decode_dri
+
+static wuffs_base__status
+wuffs_jpeg__decoder__decode_dri(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_dri[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_payload_length != 2) {
+      status = wuffs_base__make_status(wuffs_jpeg__error__bad_dri_marker);
+      goto exit;
+    }
+    self->private_impl.f_payload_length = 0;
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      uint32_t t_0;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_0 = ((uint32_t)(wuffs_base__peek_u16be__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_dri[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_dri[0].scratch;
+          uint32_t num_bits_0 = ((uint32_t)(*scratch & 0xFF));
+          *scratch >>= 8;
+          *scratch <<= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_0);
+          if (num_bits_0 == 8) {
+            t_0 = ((uint32_t)(*scratch >> 48));
+            break;
+          }
+          num_bits_0 += 8;
+          *scratch |= ((uint64_t)(num_bits_0));
+        }
+      }
+      self->private_impl.f_restart_interval = t_0;
+    }
+
+    goto ok;
+    ok:
+    self->private_impl.p_decode_dri[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_dri[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func jpeg.decoder.decode_sof
+
+static wuffs_base__status
+wuffs_jpeg__decoder__decode_sof(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t v_c = 0;
+  uint32_t v_i = 0;
+  uint8_t v_h = 0;
+  uint8_t v_v = 0;
+  uint32_t v_num_blocks = 0;
+  uint64_t v_wh = 0;
+  uint64_t v_offset = 0;
+  uint32_t v_max_incl_hv = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_sof[0];
+  if (coro_susp_point) {
+    v_offset = self->private_data.s_decode_sof[0].v_offset;
+    v_i = self->private_data.s_decode_sof[0].v_i;
+    v_num_blocks = self->private_data.s_decode_sof[0].v_num_blocks;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_payload_length < 6) {
+      status = wuffs_base__make_status(wuffs_jpeg__error__bad_sof_marker);
+      goto exit;
+    }
+    self->private_impl.f_payload_length -= 6;
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_0 = *iop_a_src++;
+      v_c = t_0;
+    }
+    if (v_c == 12) {
+      status = wuffs_base__make_status(wuffs_jpeg__error__unsupported_precision);
+      goto exit;
+    } else if (v_c != 8) {
+      status = wuffs_base__make_status(wuffs_jpeg__error__bad_sof_marker);
+      goto exit;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      uint32_t t_1;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_1 = ((uint32_t)(wuffs_base__peek_u16be__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_sof[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_sof[0].scratch;
+          uint32_t num_bits_1 = ((uint32_t)(*scratch & 0xFF));
+          *scratch >>= 8;
+          *scratch <<= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_1);
+          if (num_bits_1 == 8) {
+            t_1 = ((uint32_t)(*scratch >> 48));
+            break;
+          }
+          num_bits_1 += 8;
+          *scratch |= ((uint64_t)(num_bits_1));
+        }
+      }
+      self->private_impl.f_height = t_1;
+    }
+    if (self->private_impl.f_height == 0) {
+      status = wuffs_base__make_status(wuffs_jpeg__error__unsupported_marker);
+      goto exit;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+      uint32_t t_2;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_2 = ((uint32_t)(wuffs_base__peek_u16be__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_sof[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_sof[0].scratch;
+          uint32_t num_bits_2 = ((uint32_t)(*scratch & 0xFF));
+          *scratch >>= 8;
+          *scratch <<= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_2);
+          if (num_bits_2 == 8) {
+            t_2 = ((uint32_t)(*scratch >> 48));
+            break;
+          }
+          num_bits_2 += 8;
+          *scratch |= ((uint64_t)(num_bits_2));
+        }
+      }
+      self->private_impl.f_width = t_2;
+    }
+    if (self->private_impl.f_width == 0) {
+      status = wuffs_base__make_status(wuffs_jpeg__error__bad_sof_marker);
+      goto exit;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_3 = *iop_a_src++;
+      v_c = t_3;
+    }
+    if (v_c == 4) {
+      status = wuffs_base__make_status(wuffs_jpeg__error__unsupported_color_model);
+      goto exit;
+    } else if ((v_c != 1) && (v_c != 3)) {
+      status = wuffs_base__make_status(wuffs_jpeg__error__bad_sof_marker);
+      goto exit;
+    }
+    self->private_impl.f_num_components = ((uint32_t)((v_c & 3)));
+    if (self->private_impl.f_payload_length != (3 * self->private_impl.f_num_components)) {
+      status = wuffs_base__make_status(wuffs_jpeg__error__bad_sof_marker);
+      goto exit;
+    }
+    self->private_impl.f_payload_length = 0;
+    v_i = 0;
+    while (v_i < self->private_impl.f_num_components) {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint8_t t_4 = *iop_a_src++;
+        self->private_impl.f_components_c[v_i] = t_4;
+      }
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint8_t t_5 = *iop_a_src++;
+        v_c = t_5;
+      }
+      if (((v_c >> 4) < 1) ||
+          (4 < (v_c >> 4)) ||
+          ((v_c & 15) < 1) ||
+          (4 < (v_c & 15))) {
+        status = wuffs_base__make_status(wuffs_jpeg__error__bad_sof_marker);
+        goto exit;
+      }
+      v_h = ((v_c >> 4) & 7);
+      v_v = ((v_c & 15) & 7);
+      if (v_h > 4) {
+        status = wuffs_base__make_status(wuffs_jpeg__error__bad_sof_marker);
+        goto exit;
+      } else if (v_v > 4) {
+        status = wuffs_base__make_status(wuffs_jpeg__error__bad_sof_marker);
+        goto exit;
+      }
+      if (self->private_impl.f_num_components == 1) {
+        v_h = 1;
+        v_v = 1;
+      }
+      self->private_impl.f_components_h[v_i] = v_h;
+      self->private_impl.f_components_v[v_i] = v_v;
+      self->private_impl.f_max_incl_components_h = wuffs_base__u32__max(self->private_impl.f_max_incl_components_h, ((uint32_t)(v_h)));
+      self->private_impl.f_max_incl_components_v = wuffs_base__u32__max(self->private_impl.f_max_incl_components_v, ((uint32_t)(v_v)));
+      v_num_blocks += (((uint32_t)(v_h)) * ((uint32_t)(v_v)));
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint8_t t_6 = *iop_a_src++;
+        v_c = t_6;
+      }
+      if (v_c > 3) {
+        status = wuffs_base__make_status(wuffs_jpeg__error__bad_sof_marker);
+        goto exit;
+      }
+      self->private_impl.f_components_tq[v_i] = v_c;
+      v_i += 1;
+    }
+    if (v_num_blocks > 10) {
+      status = wuffs_base__make_status(wuffs_jpeg__error__bad_sof_marker);
+      goto exit;
+    }
+    v_i = 0;
+    while (v_i < self->private_impl.f_num_components) {
+      if ( ! wuffs_jpeg__decoder__is_integer_ratio(self, self->private_impl.f_max_incl_components_h, ((uint32_t)(self->private_impl.f_components_h[v_i])))) {
+        status = wuffs_base__make_status(wuffs_jpeg__error__unsupported_fractional_sampling);
+        goto exit;
+      } else if ( ! wuffs_jpeg__decoder__is_integer_ratio(self, self->private_impl.f_max_incl_components_v, ((uint32_t)(self->private_impl.f_components_v[v_i])))) {
+        status = wuffs_base__make_status(wuffs_jpeg__error__unsupported_fractional_sampling);
+        goto exit;
+      }
+      v_i += 1;
+    }
+    self->private_impl.f_width_in_mcus = wuffs_jpeg__decoder__div_round_up_by_8n(self, self->private_impl.f_width, self->private_impl.f_max_incl_components_h);
+    self->private_impl.f_height_in_mcus = wuffs_jpeg__decoder__div_round_up_by_8n(self, self->private_impl.f_height, self->private_impl.f_max_incl_components_v);
+    v_i = 0;
+    while (v_i < self->private_impl.f_num_components) {
+      self->private_impl.f_workbuf_offsets[v_i] = v_offset;
+      v_wh = (((uint64_t)((self->private_impl.f_width_in_mcus * ((uint32_t)(self->private_impl.f_components_h[v_i]))))) * ((uint64_t)((self->private_impl.f_height_in_mcus * ((uint32_t)(self->private_impl.f_components_v[v_i]))))) * 64);
+      v_offset += v_wh;
+      v_i += 1;
+    }
+    while (v_i < 3) {
+      self->private_impl.f_workbuf_offsets[v_i] = v_offset;
+      v_i += 1;
+    }
+    v_i = 0;
+    while (v_i < 3) {
+      self->private_impl.f_workbuf_offsets[(3 + v_i)] = v_offset;
+      if (self->private_impl.f_is_progressive && (v_i < self->private_impl.f_num_components)) {
+        v_offset += ((uint64_t)(((uint64_t)(self->private_impl.f_workbuf_offsets[(v_i + 1)] - self->private_impl.f_workbuf_offsets[v_i])) * 2));
+      }
+      v_i += 1;
+    }
+    self->private_impl.f_workbuf_offsets[6] = v_offset;
+    v_max_incl_hv = self->private_impl.f_max_incl_components_h;
+    if (self->private_impl.f_num_components > 1) {
+      v_offset += (((uint64_t)((self->private_impl.f_width_in_mcus * v_max_incl_hv))) * 8 * 6);
+    }
+    self->private_impl.f_workbuf_offsets[7] = v_offset;
+    if (self->private_impl.f_num_components == 1) {
+      self->private_impl.f_src_pixfmt = 536870920;
+    } else if (self->private_impl.f_is_adobe) {
+      if (self->private_impl.f_adobe_transform == 0) {
+        self->private_impl.f_src_pixfmt = 2684356744;
+      } else {
+        self->private_impl.f_src_pixfmt = 1073875080;
+      }
+    } else if ( ! self->private_impl.f_is_jfif &&
+        (self->private_impl.f_components_c[0] == 82) &&
+        (self->private_impl.f_components_c[1] == 71) &&
+        (self->private_impl.f_components_c[2] == 66)) {
+      self->private_impl.f_src_pixfmt = 2684356744;
+    } else {
+      self->private_impl.f_src_pixfmt = 1073875080;
+    }
+
+    goto ok;
+    ok:
+    self->private_impl.p_decode_sof[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_sof[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_decode_sof[0].v_offset = v_offset;
+  self->private_data.s_decode_sof[0].v_i = v_i;
+  self->private_data.s_decode_sof[0].v_num_blocks = v_num_blocks;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func jpeg.decoder.is_integer_ratio
+
+static bool
+wuffs_jpeg__decoder__is_integer_ratio(
+    const wuffs_jpeg__decoder* self,
+    uint32_t a_a,
+    uint32_t a_b) {
+  if (a_b == 1) {
+    return true;
+  } else if (a_b == 2) {
+    return ((a_a & 1) == 0);
+  } else if (a_b == 3) {
+    return (a_a == 3);
+  } else if (a_b == 4) {
+    return (a_a == 4);
+  }
+  return false;
+}
+
+// -------- func jpeg.decoder.div_round_up_by_8n
+
+static uint32_t
+wuffs_jpeg__decoder__div_round_up_by_8n(
+    const wuffs_jpeg__decoder* self,
+    uint32_t a_a,
+    uint32_t a_n) {
+  if (a_n <= 1) {
+    return ((a_a + 7) / 8);
+  } else if (a_n == 2) {
+    return ((a_a + 15) / 16);
+  } else if (a_n == 3) {
+    return ((a_a + 23) / 24);
+  }
+  return ((a_a + 31) / 32);
+}
+
+// -------- func jpeg.decoder.div_round_up_by_ratio
+
+static uint32_t
+wuffs_jpeg__decoder__div_round_up_by_ratio(
+    const wuffs_jpeg__decoder* self,
+    uint32_t a_a,
+    uint32_t a_n,
+    uint32_t a_d) {
+  if (a_n == a_d) {
+    return a_a;
+  } else if ((a_n == 2) || ((a_n == 4) && (a_d == 2))) {
+    return ((a_a + 1) / 2);
+  } else if (a_n == 3) {
+    return ((a_a + 2) / 3);
+  }
+  return ((a_a + 3) / 4);
+}
+
+// -------- func jpeg.decoder.div_by_ratio
+
+static uint32_t
+wuffs_jpeg__decoder__div_by_ratio(
+    const wuffs_jpeg__decoder* self,
+    uint32_t a_a,
+    uint32_t a_n,
+    uint32_t a_d) {
+  if (a_n == a_d) {
+    return a_a;
+  } else if ((a_n == 2) || ((a_n == 4) && (a_d == 2))) {
+    return (a_a / 2);
+  } else if (a_n == 3) {
+    return (a_a / 3);
+  }
+  return (a_a / 4);
+}
+
+// -------- func jpeg.decoder.decode_frame_config
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_jpeg__decoder__decode_frame_config(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__frame_config* a_dst,
+    wuffs_base__io_buffer* a_src) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+        ? wuffs_base__error__disabled_by_previous_error
+        : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 2)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_frame_config[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_call_sequence < 3) {
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      status = wuffs_jpeg__decoder__decode_image_config(self, NULL, a_src);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+    } else if (self->private_impl.f_call_sequence == 3) {
+      if (self->private_impl.f_frame_config_io_position != wuffs_base__u64__sat_add((a_src ? a_src->meta.pos : 0), ((uint64_t)(iop_a_src - io0_a_src)))) {
+        status = wuffs_base__make_status(wuffs_base__error__bad_restart);
+        goto exit;
+      }
+    } else if (self->private_impl.f_call_sequence == 4) {
+      self->private_impl.f_call_sequence = 255;
+      status = wuffs_base__make_status(wuffs_base__note__end_of_data);
+      goto ok;
+    } else {
+      status = wuffs_base__make_status(wuffs_base__note__end_of_data);
+      goto ok;
+    }
+    if (a_dst != NULL) {
+      wuffs_base__frame_config__set(
+          a_dst,
+          wuffs_base__utility__make_rect_ie_u32(
+          0,
+          0,
+          self->private_impl.f_width,
+          self->private_impl.f_height),
+          ((wuffs_base__flicks)(0)),
+          0,
+          self->private_impl.f_frame_config_io_position,
+          0,
+          true,
+          false,
+          4278190080);
+    }
+    self->private_impl.f_call_sequence = 4;
+
+    ok:
+    self->private_impl.p_decode_frame_config[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_frame_config[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine = wuffs_base__status__is_suspension(&status) ? 2 : 0;
+  WUFFS_BASE__STATS__ADD(self->private_impl, WUFFS_BASE__STATS__SUSPENSIONS,
+      wuffs_base__status__is_suspension(&status) ? 1u : 0u);
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func jpeg.decoder.decode_frame
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_jpeg__decoder__decode_frame(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__pixel_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__pixel_blend a_blend,
+    wuffs_base__slice_u8 a_workbuf,
+    wuffs_base__decode_frame_options* a_opts) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+        ? wuffs_base__error__disabled_by_previous_error
+        : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst || !a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 3)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  uint8_t v_c = 0;
+  uint8_t v_marker = 0;
+  uint32_t v_length = 0;
+  uint32_t v_roi = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_frame[0];
+  if (coro_susp_point) {
+    v_c = self->private_data.s_decode_frame[0].v_c;
+    v_marker = self->private_data.s_decode_frame[0].v_marker;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_call_sequence < 4) {
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      status = wuffs_jpeg__decoder__decode_frame_config(self, NULL, a_src);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+    } else if (self->private_impl.f_call_sequence == 4) {
+    } else {
+      status = wuffs_base__make_status(wuffs_base__note__end_of_data);
+      goto ok;
+    }
+    v_roi = 4294967295;
+    self->private_impl.f_band_height = 0;
+    if (a_opts != NULL) {
+      if (wuffs_base__decode_frame_options__has_color_conversion(a_opts)) {
+        status = wuffs_base__make_status(wuffs_base__error__unsupported_option);
+        goto exit;
+      }
+      if (wuffs_base__decode_frame_options__downscale_shift(a_opts) > 0) {
+        status = wuffs_base__make_status(wuffs_base__error__unsupported_option);
+        goto exit;
+      }
+      v_roi = wuffs_base__decode_frame_options__roi_max_excl_x(a_opts);
+      self->private_impl.f_band_height = wuffs_base__decode_frame_options__row_band_height(a_opts);
+    }
+    self->private_impl.f_roi_x1 = wuffs_base__u32__min(v_roi, self->private_impl.f_width);
+    v_roi = 4294967295;
+    if (a_opts != NULL) {
+      v_roi = wuffs_base__decode_frame_options__roi_max_excl_y(a_opts);
+    }
+    self->private_impl.f_roi_y1 = wuffs_base__u32__min(v_roi, self->private_impl.f_height);
+    v_roi = 0;
+    if (a_opts != NULL) {
+      v_roi = wuffs_base__decode_frame_options__roi_min_incl_x(a_opts);
+    }
+    self->private_impl.f_roi_x0 = wuffs_base__u32__min(v_roi, self->private_impl.f_roi_x1);
+    v_roi = 0;
+    if (a_opts != NULL) {
+      v_roi = wuffs_base__decode_frame_options__roi_min_incl_y(a_opts);
+    }
+    self->private_impl.f_roi_y0 = wuffs_base__u32__min(v_roi, self->private_impl.f_roi_y1);
+    self->private_impl.f_band_y0 = self->private_impl.f_roi_y0;
+    self->private_impl.f_band_y1 = self->private_impl.f_roi_y1;
+    if (self->private_impl.f_band_height > 0) {
+      self->private_impl.f_band_y1 = wuffs_base__u32__min(self->private_impl.f_roi_y1, wuffs_base__u32__sat_add(self->private_impl.f_roi_y0, self->private_impl.f_band_height));
+    }
+    if (((uint64_t)(a_workbuf.len)) < self->private_impl.f_workbuf_offsets[7]) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_workbuf_length);
+      goto exit;
+    }
+    v_status = wuffs_base__pixel_swizzler__prepare(&self->private_impl.f_swizzler,
+        wuffs_base__pixel_buffer__pixel_format(a_dst),
+        wuffs_base__pixel_buffer__palette(a_dst),
+        wuffs_base__utility__make_pixel_format(self->private_impl.f_src_pixfmt),
+        wuffs_base__utility__empty_slice_u8(),
+        a_blend);
+    if ( ! wuffs_base__status__is_ok(&v_status)) {
+      status = v_status;
+      if (wuffs_base__status__is_error(&status)) {
+        goto exit;
+      } else if (wuffs_base__status__is_suspension(&status)) {
+        status = wuffs_base__make_status(wuffs_base__error__cannot_return_a_suspension);
+        goto exit;
+      }
+      goto ok;
+    }
+    if (self->private_impl.f_is_progressive) {
+      wuffs_jpeg__decoder__clear_coefficients(self, a_workbuf);
+    }
+    label__0__continue:;
+    while (true) {
+      label__1__continue:;
+      while (true) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint8_t t_0 = *iop_a_src++;
+          v_c = t_0;
+        }
+        if (v_c != 255) {
+          goto label__1__continue;
+        }
+        while (v_c == 255) {
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint8_t t_1 = *iop_a_src++;
+            v_c = t_1;
+          }
+        }
+        if (v_c != 0) {
+          goto label__1__break;
+        }
+      }
+      label__1__break:;
+      v_marker = v_c;
+      if (v_marker == 217) {
+        goto label__0__break;
+      } else if (((208 <= v_marker) && (v_marker <= 215)) || (v_marker == 1)) {
+        goto label__0__continue;
+      } else if (v_marker == 216) {
+        status = wuffs_base__make_status(wuffs_jpeg__error__bad_marker);
+        goto exit;
+      }
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+        uint32_t t_2;
+        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+          t_2 = ((uint32_t)(wuffs_base__peek_u16be__no_bounds_check(iop_a_src)));
+          iop_a_src += 2;
+        } else {
+          self->private_data.s_decode_frame[0].scratch = 0;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+          while (true) {
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint64_t* scratch = &self->private_data.s_decode_frame[0].scratch;
+            uint32_t num_bits_2 = ((uint32_t)(*scratch & 0xFF));
+            *scratch >>= 8;
+            *scratch <<= 8;
+            *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_2);
+            if (num_bits_2 == 8) {
+              t_2 = ((uint32_t)(*scratch >> 48));
+              break;
+            }
+            num_bits_2 += 8;
+            *scratch |= ((uint64_t)(num_bits_2));
+          }
+        }
+        v_length = t_2;
+      }
+      if (v_length < 2) {
+        status = wuffs_base__make_status(wuffs_jpeg__error__bad_marker);
+        goto exit;
+      }
+      self->private_impl.f_payload_length = (v_length - 2);
+      if (v_marker == 218) {
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+        status = wuffs_jpeg__decoder__decode_sos(self, a_src, a_workbuf);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+        goto label__0__continue;
+      } else if (((v_marker & 240) == 192) && (v_marker != 196)) {
+        status = wuffs_base__make_status(wuffs_jpeg__error__bad_marker);
+        goto exit;
+      }
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+      status = wuffs_jpeg__decoder__decode_other_marker(self, a_src, v_marker);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+    }
+    label__0__break:;
+    if (self->private_impl.f_is_progressive) {
+      v_status = wuffs_jpeg__decoder__decode_idct_progressive(self, a_workbuf);
+      if ( ! wuffs_base__status__is_ok(&v_status)) {
+        status = v_status;
+        if (wuffs_base__status__is_error(&status)) {
+          goto exit;
+        } else if (wuffs_base__status__is_suspension(&status)) {
+          status = wuffs_base__make_status(wuffs_base__error__cannot_return_a_suspension);
+          goto exit;
+        }
+        goto ok;
+      }
+    }
+    while (true) {
+      v_status = wuffs_jpeg__decoder__swizzle(self, a_dst, a_workbuf);
+      if (wuffs_base__status__is_ok(&v_status)) {
+        goto label__2__break;
+      } else if (v_status.repr != wuffs_jpeg__note__internal_note_short_write) {
+        status = v_status;
+        if (wuffs_base__status__is_error(&status)) {
+          goto exit;
+        } else if (wuffs_base__status__is_suspension(&status)) {
+          status = wuffs_base__make_status(wuffs_base__error__cannot_return_a_suspension);
+          goto exit;
+        }
+        goto ok;
+      }
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(8);
+      self->private_impl.f_band_y0 = self->private_impl.f_band_y1;
+      self->private_impl.f_band_y1 = wuffs_base__u32__min(self->private_impl.f_roi_y1, wuffs_base__u32__sat_add(self->private_impl.f_band_y0, self->private_impl.f_band_height));
+    }
+    label__2__break:;
+    self->private_impl.f_call_sequence = 255;
+
+    ok:
+    self->private_impl.p_decode_frame[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_frame[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine = wuffs_base__status__is_suspension(&status) ? 3 : 0;
+  WUFFS_BASE__STATS__ADD(self->private_impl, WUFFS_BASE__STATS__SUSPENSIONS,
+      wuffs_base__status__is_suspension(&status) ? 1u : 0u);
+  self->private_data.s_decode_frame[0].v_c = v_c;
+  self->private_data.s_decode_frame[0].v_marker = v_marker;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func jpeg.decoder.clear_coefficients
+
+static wuffs_base__empty_struct
+wuffs_jpeg__decoder__clear_coefficients(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__slice_u8 a_workbuf) {
+  wuffs_base__slice_u8 v_w = {0};
+  wuffs_base__slice_u8 v_p = {0};
+
+  if ((self->private_impl.f_workbuf_offsets[3] <= self->private_impl.f_workbuf_offsets[6]) && (self->private_impl.f_workbuf_offsets[6] <= ((uint64_t)(a_workbuf.len)))) {
+    v_w = wuffs_base__slice_u8__subslice_ij(a_workbuf,
+        self->private_impl.f_workbuf_offsets[3],
+        self->private_impl.f_workbuf_offsets[6]);
+    {
+      wuffs_base__slice_u8 i_slice_p = v_w;
+      v_p.ptr = i_slice_p.ptr;
+      v_p.len = 8;
+      uint8_t* i_end0_p = v_p.ptr + (((i_slice_p.len - (size_t)(v_p.ptr - i_slice_p.ptr)) / 8) * 8);
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_p.ptr < i_end0_p) {
+        wuffs_base__poke_u64le__no_bounds_check(v_p.ptr, 0);
+        v_p.ptr += 8;
+      }
+      v_p.len = 1;
+      uint8_t* i_end1_p = i_slice_p.ptr + i_slice_p.len;
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_p.ptr < i_end1_p) {
+        v_p.ptr[0] = 0;
+        v_p.ptr += 1;
+      }
+      v_p.len = 0;
+    }
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func jpeg.decoder.can_decode_row_bands
+
+WUFFS_BASE__MAYBE_STATIC bool
+wuffs_jpeg__decoder__can_decode_row_bands(
+    const wuffs_jpeg__decoder* self) {
+  if (!self) {
+    return false;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return false;
+  }
+
+  return true;
+}
+
+// -------- func jpeg.decoder.frame_dirty_rect
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__rect_ie_u32
+wuffs_jpeg__decoder__frame_dirty_rect(
+    const wuffs_jpeg__decoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_rect_ie_u32();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_rect_ie_u32();
+  }
+
+  if (self->private_impl.f_band_height > 0) {
+    return wuffs_base__utility__make_rect_ie_u32(
+        0,
+        self->private_impl.f_band_y0,
+        self->private_impl.f_width,
+        self->private_impl.f_band_y1);
+  }
+  return wuffs_base__utility__make_rect_ie_u32(
+      0,
+      0,
+      self->private_impl.f_width,
+      self->private_impl.f_height);
+}
+
+// -------- func jpeg.decoder.num_animation_loops
+
+WUFFS_BASE__MAYBE_STATIC uint32_t
+wuffs_jpeg__decoder__num_animation_loops(
+    const wuffs_jpeg__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return 0;
+}
+
+// -------- func jpeg.decoder.num_decoded_frame_configs
+
+WUFFS_BASE__MAYBE_STATIC uint64_t
+wuffs_jpeg__decoder__num_decoded_frame_configs(
+    const wuffs_jpeg__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  if (self->private_impl.f_call_sequence > 3) {
+    return 1;
+  }
+  return 0;
+}
+
+// -------- func jpeg.decoder.num_decoded_frames
+
+WUFFS_BASE__MAYBE_STATIC uint64_t
+wuffs_jpeg__decoder__num_decoded_frames(
+    const wuffs_jpeg__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  if (self->private_impl.f_call_sequence > 4) {
+    return 1;
+  }
+  return 0;
+}
+
+// -------- func jpeg.decoder.restart_frame
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_jpeg__decoder__restart_frame(
+    wuffs_jpeg__decoder* self,
+    uint64_t a_index,
+    uint64_t a_io_position) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+        ? wuffs_base__error__disabled_by_previous_error
+        : wuffs_base__error__initialize_not_called);
+  }
+
+  if (self->private_impl.f_call_sequence < 3) {
+    return wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
+  }
+  if ((a_index != 0) || (a_io_position != self->private_impl.f_frame_config_io_position)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  self->private_impl.f_call_sequence = 3;
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func jpeg.decoder.set_report_metadata
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_jpeg__decoder__set_report_metadata(
+    wuffs_jpeg__decoder* self,
+    uint32_t a_fourcc,
+    bool a_report) {
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func jpeg.decoder.tell_me_more
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_jpeg__decoder__tell_me_more(
+    wuffs_jpeg__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__more_information* a_minfo,
+    wuffs_base__io_buffer* a_src) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+        ? wuffs_base__error__disabled_by_previous_error
+        : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst || !a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 4)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  status = wuffs_base__make_status(wuffs_base__error__no_more_information);
+  goto exit;
+
+  goto ok;
+  ok:
+  goto exit;
+  exit:
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func jpeg.decoder.workbuf_len
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64
+wuffs_jpeg__decoder__workbuf_len(
+    const wuffs_jpeg__decoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+
+  return wuffs_base__utility__make_range_ii_u64(self->private_impl.f_workbuf_offsets[7], self->private_impl.f_workbuf_offsets[7]);
+}
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__JPEG)
+
+
+#endif  // WUFFS_IMPLEMENTATION
+
+// ¡ WUFFS MONOLITHIC RELEASE DISCARDS EVERYTHING BELOW.
+
+#endif  // WUFFS_INCLUDE_GUARD__JPEG
@@ -0,0 +1,3950 @@
+#ifndef WUFFS_INCLUDE_GUARD__JSON
+#define WUFFS_INCLUDE_GUARD__JSON
+
+#if defined(WUFFS_IMPLEMENTATION) && !defined(WUFFS_CONFIG__MODULES)
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__JSON
+#endif
+
+#include "./wuffs-base.c"
+
+// ¡ WUFFS MONOLITHIC RELEASE DISCARDS EVERYTHING ABOVE.
+
+
+// ---------------- Status Codes
+
+extern const char wuffs_json__error__bad_c0_control_code[];
+extern const char wuffs_json__error__bad_utf_8[];
+extern const char wuffs_json__error__bad_backslash_escape[];
+extern const char wuffs_json__error__bad_input[];
+extern const char wuffs_json__error__bad_new_line_in_a_string[];
+extern const char wuffs_json__error__bad_quirk_combination[];
+extern const char wuffs_json__error__unsupported_number_length[];
+extern const char wuffs_json__error__unsupported_recursion_depth[];
+
+// ---------------- Public Consts
+
+#define WUFFS_JSON__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE 0
+
+#define WUFFS_JSON__DECODER_DEPTH_MAX_INCL 1024
+
+#define WUFFS_JSON__DECODER_DST_TOKEN_BUFFER_LENGTH_MIN_INCL 1
+
+#define WUFFS_JSON__DECODER_SRC_IO_BUFFER_LENGTH_MIN_INCL 100
+
+#define WUFFS_JSON__QUIRK_ALLOW_ASCII_CONTROL_CODES 1225364480
+
+#define WUFFS_JSON__QUIRK_ALLOW_BACKSLASH_A 1225364481
+
+#define WUFFS_JSON__QUIRK_ALLOW_BACKSLASH_CAPITAL_U 1225364482
+
+#define WUFFS_JSON__QUIRK_ALLOW_BACKSLASH_E 1225364483
+
+#define WUFFS_JSON__QUIRK_ALLOW_BACKSLASH_NEW_LINE 1225364484
+
+#define WUFFS_JSON__QUIRK_ALLOW_BACKSLASH_QUESTION_MARK 1225364485
+
+#define WUFFS_JSON__QUIRK_ALLOW_BACKSLASH_SINGLE_QUOTE 1225364486
+
+#define WUFFS_JSON__QUIRK_ALLOW_BACKSLASH_V 1225364487
+
+#define WUFFS_JSON__QUIRK_ALLOW_BACKSLASH_X_AS_CODE_POINTS 1225364489
+
+#define WUFFS_JSON__QUIRK_ALLOW_BACKSLASH_ZERO 1225364490
+
+#define WUFFS_JSON__QUIRK_ALLOW_COMMENT_BLOCK 1225364491
+
+#define WUFFS_JSON__QUIRK_ALLOW_COMMENT_LINE 1225364492
+
+#define WUFFS_JSON__QUIRK_ALLOW_EXTRA_COMMA 1225364493
+
+#define WUFFS_JSON__QUIRK_ALLOW_INF_NAN_NUMBERS 1225364494
+
+#define WUFFS_JSON__QUIRK_ALLOW_LEADING_ASCII_RECORD_SEPARATOR 1225364495
+
+#define WUFFS_JSON__QUIRK_ALLOW_LEADING_UNICODE_BYTE_ORDER_MARK 1225364496
+
+#define WUFFS_JSON__QUIRK_ALLOW_TRAILING_FILLER 1225364497
+
+#define WUFFS_JSON__QUIRK_EXPECT_TRAILING_NEW_LINE_OR_EOF 1225364498
+
+#define WUFFS_JSON__QUIRK_JSON_POINTER_ALLOW_TILDE_N_TILDE_R_TILDE_T 1225364499
+
+#define WUFFS_JSON__QUIRK_REPLACE_INVALID_UNICODE 1225364500
+
+// ---------------- Struct Declarations
+
+typedef struct wuffs_json__decoder__struct wuffs_json__decoder;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ---------------- Public Initializer Prototypes
+
+// For any given "wuffs_foo__bar* self", "wuffs_foo__bar__initialize(self,
+// etc)" should be called before any other "wuffs_foo__bar__xxx(self, etc)".
+//
+// Pass sizeof(*self) and WUFFS_VERSION for sizeof_star_self and wuffs_version.
+// Pass 0 (or some combination of WUFFS_INITIALIZE__XXX) for options.
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+wuffs_json__decoder__initialize(
+    wuffs_json__decoder* self,
+    size_t sizeof_star_self,
+    uint64_t wuffs_version,
+    uint32_t options);
+
+wuffs_base__stats
+wuffs_json__decoder__stats(
+    const wuffs_json__decoder* self);
+
+size_t
+sizeof__wuffs_json__decoder();
+
+// ---------------- Allocs
+
+// These functions allocate and initialize Wuffs structs. They return NULL if
+// memory allocation fails. If they return non-NULL, there is no need to call
+// wuffs_foo__bar__initialize, but the caller is responsible for eventually
+// calling free on the returned pointer. That pointer is effectively a C++
+// std::unique_ptr<T, decltype(&free)>.
+
+wuffs_json__decoder*
+wuffs_json__decoder__alloc();
+
+static inline wuffs_base__token_decoder*
+wuffs_json__decoder__alloc_as__wuffs_base__token_decoder() {
+  return (wuffs_base__token_decoder*)(wuffs_json__decoder__alloc());
+}
+
+// ---------------- Upcasts
+
+static inline wuffs_base__token_decoder*
+wuffs_json__decoder__upcast_as__wuffs_base__token_decoder(
+    wuffs_json__decoder* p) {
+  return (wuffs_base__token_decoder*)p;
+}
+
+// ---------------- Public Function Prototypes
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_json__decoder__set_quirk_enabled(
+    wuffs_json__decoder* self,
+    uint32_t a_quirk,
+    bool a_enabled);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64
+wuffs_json__decoder__workbuf_len(
+    const wuffs_json__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_json__decoder__decode_tokens(
+    wuffs_json__decoder* self,
+    wuffs_base__token_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+// ---------------- Struct Definitions
+
+// These structs' fields, and the sizeof them, are private implementation
+// details that aren't guaranteed to be stable across Wuffs versions.
+//
+// See https://en.wikipedia.org/wiki/Opaque_pointer#C
+
+#if defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
+
+struct wuffs_json__decoder__struct {
+  // Do not access the private_impl's or private_data's fields directly. There
+  // is no API/ABI compatibility or safety guarantee if you do so. Instead, use
+  // the wuffs_foo__bar__baz functions.
+  //
+  // It is a struct, not a struct*, so that the outermost wuffs_foo__bar struct
+  // can be stack allocated when WUFFS_IMPLEMENTATION is defined.
+
+  struct {
+    uint32_t magic;
+    uint32_t active_coroutine;
+    wuffs_base__vtable vtable_for__wuffs_base__token_decoder;
+    wuffs_base__vtable null_vtable;
+#if defined(WUFFS_CONFIG__STATS)
+    wuffs_base__stats stats;
+#endif  // defined(WUFFS_CONFIG__STATS)
+
+    bool f_quirks[21];
+    bool f_allow_leading_ars;
+    bool f_allow_leading_ubom;
+    bool f_end_of_data;
+    bool f_have_chosen;
+    uint8_t f_trailer_stop;
+    uint8_t f_comment_type;
+
+    uint32_t p_decode_tokens[1];
+    uint32_t p_decode_leading[1];
+    uint32_t p_decode_comment[1];
+    uint32_t p_decode_inf_nan[1];
+    uint32_t p_decode_trailer[1];
+    uint32_t (*choosy_skip_plain_string_bytes)(
+        wuffs_json__decoder* self,
+        wuffs_base__io_buffer* a_src,
+        uint32_t a_up_to);
+    uint32_t (*choosy_skip_whitespace)(
+        wuffs_json__decoder* self,
+        wuffs_base__io_buffer* a_src,
+        uint32_t a_up_to);
+  } private_impl;
+
+  struct {
+    uint32_t f_stack[32];
+
+    struct {
+      uint32_t v_depth;
+      uint32_t v_expect;
+      uint32_t v_expect_after_value;
+    } s_decode_tokens[1];
+    struct {
+      uint32_t v_neg;
+    } s_decode_inf_nan[1];
+  } private_data;
+
+#ifdef __cplusplus
+#if defined(WUFFS_BASE__HAVE_UNIQUE_PTR)
+  using unique_ptr = std::unique_ptr<wuffs_json__decoder, decltype(&free)>;
+
+  // On failure, the alloc_etc functions return nullptr. They don't throw.
+
+  static inline unique_ptr
+  alloc() {
+    return unique_ptr(wuffs_json__decoder__alloc(), &free);
+  }
+
+  static inline wuffs_base__token_decoder::unique_ptr
+  alloc_as__wuffs_base__token_decoder() {
+    return wuffs_base__token_decoder::unique_ptr(
+        wuffs_json__decoder__alloc_as__wuffs_base__token_decoder(), &free);
+  }
+#endif  // defined(WUFFS_BASE__HAVE_UNIQUE_PTR)
+
+#if defined(WUFFS_BASE__HAVE_EQ_DELETE) && !defined(WUFFS_IMPLEMENTATION)
+  // Disallow constructing or copying an object via standard C++ mechanisms,
+  // e.g. the "new" operator, as this struct is intentionally opaque. Its total
+  // size and field layout is not part of the public, stable, memory-safe API.
+  // Use malloc or memcpy and the sizeof__wuffs_foo__bar function instead, and
+  // call wuffs_foo__bar__baz methods (which all take a "this"-like pointer as
+  // their first argument) rather than tweaking bar.private_impl.qux fields.
+  //
+  // In C, we can just leave wuffs_foo__bar as an incomplete type (unless
+  // WUFFS_IMPLEMENTATION is #define'd). In C++, we define a complete type in
+  // order to provide convenience methods. These forward on "this", so that you
+  // can write "bar->baz(etc)" instead of "wuffs_foo__bar__baz(bar, etc)".
+  wuffs_json__decoder__struct() = delete;
+  wuffs_json__decoder__struct(const wuffs_json__decoder__struct&) = delete;
+  wuffs_json__decoder__struct& operator=(
+      const wuffs_json__decoder__struct&) = delete;
+#endif  // defined(WUFFS_BASE__HAVE_EQ_DELETE) && !defined(WUFFS_IMPLEMENTATION)
+
+#if !defined(WUFFS_IMPLEMENTATION)
+  // As above, the size of the struct is not part of the public API, and unless
+  // WUFFS_IMPLEMENTATION is #define'd, this struct type T should be heap
+  // allocated, not stack allocated. Its size is not intended to be known at
+  // compile time, but it is unfortunately divulged as a side effect of
+  // defining C++ convenience methods. Use "sizeof__T()", calling the function,
+  // instead of "sizeof T", invoking the operator. To make the two values
+  // different, so that passing the latter will be rejected by the initialize
+  // function, we add an arbitrary amount of dead weight.
+  uint8_t dead_weight[123000000];  // 123 MB.
+#endif  // !defined(WUFFS_IMPLEMENTATION)
+
+  inline wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+  initialize(
+      size_t sizeof_star_self,
+      uint64_t wuffs_version,
+      uint32_t options) {
+    return wuffs_json__decoder__initialize(
+        this, sizeof_star_self, wuffs_version, options);
+  }
+
+  inline wuffs_base__stats
+  stats() const {
+    return wuffs_json__decoder__stats(this);
+  }
+
+  inline wuffs_base__token_decoder*
+  upcast_as__wuffs_base__token_decoder() {
+    return (wuffs_base__token_decoder*)this;
+  }
+
+  inline wuffs_base__empty_struct
+  set_quirk_enabled(
+      uint32_t a_quirk,
+      bool a_enabled) {
+    return wuffs_json__decoder__set_quirk_enabled(this, a_quirk, a_enabled);
+  }
+
+  inline wuffs_base__range_ii_u64
+  workbuf_len() const {
+    return wuffs_json__decoder__workbuf_len(this);
+  }
+
+  inline wuffs_base__status
+  decode_tokens(
+      wuffs_base__token_buffer* a_dst,
+      wuffs_base__io_buffer* a_src,
+      wuffs_base__slice_u8 a_workbuf) {
+    return wuffs_json__decoder__decode_tokens(this, a_dst, a_src, a_workbuf);
+  }
+
+#endif  // __cplusplus
+};  // struct wuffs_json__decoder__struct
+
+#endif  // defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
+
+
+// ‼ WUFFS C HEADER ENDS HERE.
+#ifdef WUFFS_IMPLEMENTATION
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__JSON)
+
+// ---------------- Status Codes Implementations
+
+const char wuffs_json__error__bad_c0_control_code[] = "#json: bad C0 control code";
+const char wuffs_json__error__bad_utf_8[] = "#json: bad UTF-8";
+const char wuffs_json__error__bad_backslash_escape[] = "#json: bad backslash-escape";
+const char wuffs_json__error__bad_input[] = "#json: bad input";
+const char wuffs_json__error__bad_new_line_in_a_string[] = "#json: bad new-line in a string";
+const char wuffs_json__error__bad_quirk_combination[] = "#json: bad quirk combination";
+const char wuffs_json__error__unsupported_number_length[] = "#json: unsupported number length";
+const char wuffs_json__error__unsupported_recursion_depth[] = "#json: unsupported recursion depth";
+const char wuffs_json__error__internal_error_inconsistent_i_o[] = "#json: internal error: inconsistent I/O";
+
+// ---------------- Private Consts
+
+#define WUFFS_JSON__DECODER_NUMBER_LENGTH_MAX_INCL 99
+
+static const uint8_t
+WUFFS_JSON__LUT_BACKSLASHES[256] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 3, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 162, 0, 0, 0, 0, 5,
+  0, 0, 0, 0, 0, 0, 0, 175,
+  7, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 4,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 220, 0, 0, 0,
+  0, 1, 136, 0, 0, 2, 140, 0,
+  0, 0, 0, 0, 0, 0, 138, 0,
+  0, 0, 141, 0, 137, 0, 6, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+static const uint8_t
+WUFFS_JSON__LUT_QUIRKY_BACKSLASHES_QUIRKS[8] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  0, 1, 3, 4, 5, 6, 7, 10,
+};
+
+static const uint8_t
+WUFFS_JSON__LUT_QUIRKY_BACKSLASHES_CHARS[8] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  0, 7, 27, 10, 63, 39, 11, 0,
+};
+
+static const uint8_t
+WUFFS_JSON__LUT_CHARS[256] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  128, 129, 130, 131, 132, 133, 134, 135,
+  136, 137, 138, 139, 140, 141, 142, 143,
+  144, 145, 146, 147, 148, 149, 150, 151,
+  152, 153, 154, 155, 156, 157, 158, 159,
+  0, 0, 1, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 2, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  16, 16, 16, 16, 16, 16, 16, 16,
+  16, 16, 16, 16, 16, 16, 16, 16,
+  16, 16, 16, 16, 16, 16, 16, 16,
+  16, 16, 16, 16, 16, 16, 16, 16,
+  16, 16, 16, 16, 16, 16, 16, 16,
+  16, 16, 16, 16, 16, 16, 16, 16,
+  16, 16, 16, 16, 16, 16, 16, 16,
+  16, 16, 16, 16, 16, 16, 16, 16,
+  32, 32, 3, 3, 3, 3, 3, 3,
+  3, 3, 3, 3, 3, 3, 3, 3,
+  3, 3, 3, 3, 3, 3, 3, 3,
+  3, 3, 3, 3, 3, 3, 3, 3,
+  4, 4, 4, 4, 4, 4, 4, 4,
+  4, 4, 4, 4, 4, 4, 4, 4,
+  5, 5, 5, 5, 5, 32, 32, 32,
+  32, 32, 32, 32, 32, 32, 32, 32,
+};
+
+#define WUFFS_JSON__CLASS_WHITESPACE 0
+
+#define WUFFS_JSON__CLASS_STRING 1
+
+#define WUFFS_JSON__CLASS_COMMA 2
+
+#define WUFFS_JSON__CLASS_COLON 3
+
+#define WUFFS_JSON__CLASS_NUMBER 4
+
+#define WUFFS_JSON__CLASS_OPEN_CURLY_BRACE 5
+
+#define WUFFS_JSON__CLASS_CLOSE_CURLY_BRACE 6
+
+#define WUFFS_JSON__CLASS_OPEN_SQUARE_BRACKET 7
+
+#define WUFFS_JSON__CLASS_CLOSE_SQUARE_BRACKET 8
+
+#define WUFFS_JSON__CLASS_FALSE 9
+
+#define WUFFS_JSON__CLASS_TRUE 10
+
+#define WUFFS_JSON__CLASS_NULL_NAN_INF 11
+
+#define WUFFS_JSON__CLASS_COMMENT 12
+
+#define WUFFS_JSON__EXPECT_VALUE 7858
+
+#define WUFFS_JSON__EXPECT_NON_STRING_VALUE 7856
+
+#define WUFFS_JSON__EXPECT_STRING 4098
+
+#define WUFFS_JSON__EXPECT_COMMA 4100
+
+#define WUFFS_JSON__EXPECT_COLON 4104
+
+#define WUFFS_JSON__EXPECT_NUMBER 4112
+
+#define WUFFS_JSON__EXPECT_CLOSE_CURLY_BRACE 4160
+
+#define WUFFS_JSON__EXPECT_CLOSE_SQUARE_BRACKET 4352
+
+static const uint8_t
+WUFFS_JSON__LUT_CLASSES[256] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  15, 15, 15, 15, 15, 15, 15, 15,
+  15, 0, 0, 15, 15, 0, 15, 15,
+  15, 15, 15, 15, 15, 15, 15, 15,
+  15, 15, 15, 15, 15, 15, 15, 15,
+  0, 15, 1, 15, 15, 15, 15, 15,
+  15, 15, 15, 11, 2, 4, 15, 12,
+  4, 4, 4, 4, 4, 4, 4, 4,
+  4, 4, 3, 15, 15, 15, 15, 15,
+  15, 15, 15, 15, 15, 15, 15, 15,
+  15, 11, 15, 15, 15, 15, 11, 15,
+  15, 15, 15, 15, 15, 15, 15, 15,
+  15, 15, 15, 7, 15, 8, 15, 15,
+  15, 15, 15, 15, 15, 15, 9, 15,
+  15, 11, 15, 15, 15, 15, 11, 15,
+  15, 15, 15, 15, 10, 15, 15, 15,
+  15, 15, 15, 5, 15, 6, 15, 15,
+  15, 15, 15, 15, 15, 15, 15, 15,
+  15, 15, 15, 15, 15, 15, 15, 15,
+  15, 15, 15, 15, 15, 15, 15, 15,
+  15, 15, 15, 15, 15, 15, 15, 15,
+  15, 15, 15, 15, 15, 15, 15, 15,
+  15, 15, 15, 15, 15, 15, 15, 15,
+  15, 15, 15, 15, 15, 15, 15, 15,
+  15, 15, 15, 15, 15, 15, 15, 15,
+  15, 15, 15, 15, 15, 15, 15, 15,
+  15, 15, 15, 15, 15, 15, 15, 15,
+  15, 15, 15, 15, 15, 15, 15, 15,
+  15, 15, 15, 15, 15, 15, 15, 15,
+  15, 15, 15, 15, 15, 15, 15, 15,
+  15, 15, 15, 15, 15, 15, 15, 15,
+  15, 15, 15, 15, 15, 15, 15, 15,
+  15, 15, 15, 15, 15, 15, 15, 15,
+};
+
+static const uint8_t
+WUFFS_JSON__LUT_DECIMAL_DIGITS[256] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  128, 129, 130, 131, 132, 133, 134, 135,
+  136, 137, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+static const uint8_t
+WUFFS_JSON__LUT_HEXADECIMAL_DIGITS[256] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  128, 129, 130, 131, 132, 133, 134, 135,
+  136, 137, 0, 0, 0, 0, 0, 0,
+  0, 138, 139, 140, 141, 142, 143, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 138, 139, 140, 141, 142, 143, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+#define WUFFS_JSON__QUIRKS_BASE 1225364480
+
+#define WUFFS_JSON__QUIRKS_COUNT 21
+
+// ---------------- Private Initializer Prototypes
+
+// ---------------- Private Function Prototypes
+
+static uint32_t
+wuffs_json__decoder__decode_number(
+    wuffs_json__decoder* self,
+    wuffs_base__io_buffer* a_src);
+
+static uint32_t
+wuffs_json__decoder__decode_digits(
+    wuffs_json__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    uint32_t a_n);
+
+static wuffs_base__status
+wuffs_json__decoder__decode_leading(
+    wuffs_json__decoder* self,
+    wuffs_base__token_buffer* a_dst,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status
+wuffs_json__decoder__decode_comment(
+    wuffs_json__decoder* self,
+    wuffs_base__token_buffer* a_dst,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status
+wuffs_json__decoder__decode_inf_nan(
+    wuffs_json__decoder* self,
+    wuffs_base__token_buffer* a_dst,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status
+wuffs_json__decoder__decode_trailer(
+    wuffs_json__decoder* self,
+    wuffs_base__token_buffer* a_dst,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__empty_struct
+wuffs_json__decoder__choose_skip_functions(
+    wuffs_json__decoder* self);
+
+static uint32_t
+wuffs_json__decoder__skip_plain_string_bytes(
+    wuffs_json__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    uint32_t a_up_to);
+
+static uint32_t
+wuffs_json__decoder__skip_plain_string_bytes__choosy_default(
+    wuffs_json__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    uint32_t a_up_to);
+
+static uint32_t
+wuffs_json__decoder__skip_whitespace(
+    wuffs_json__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    uint32_t a_up_to);
+
+static uint32_t
+wuffs_json__decoder__skip_whitespace__choosy_default(
+    wuffs_json__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    uint32_t a_up_to);
+
+static uint64_t
+wuffs_json__decoder__zero_bytes(
+    const wuffs_json__decoder* self,
+    uint64_t a_x);
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+static uint32_t
+wuffs_json__decoder__skip_plain_string_bytes_x86_sse42(
+    wuffs_json__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    uint32_t a_up_to);
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+static uint32_t
+wuffs_json__decoder__skip_whitespace_x86_sse42(
+    wuffs_json__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    uint32_t a_up_to);
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+
+// ---------------- VTables
+
+const wuffs_base__token_decoder__func_ptrs
+wuffs_json__decoder__func_ptrs_for__wuffs_base__token_decoder = {
+  (wuffs_base__status(*)(void*,
+      wuffs_base__token_buffer*,
+      wuffs_base__io_buffer*,
+      wuffs_base__slice_u8))(&wuffs_json__decoder__decode_tokens),
+  (wuffs_base__empty_struct(*)(void*,
+      uint32_t,
+      bool))(&wuffs_json__decoder__set_quirk_enabled),
+  (wuffs_base__range_ii_u64(*)(const void*))(&wuffs_json__decoder__workbuf_len),
+};
+
+// ---------------- Initializer Implementations
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+wuffs_json__decoder__initialize(
+    wuffs_json__decoder* self,
+    size_t sizeof_star_self,
+    uint64_t wuffs_version,
+    uint32_t options){
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  }
+
+  if ((options & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+    // The whole point of this if-check is to detect an uninitialized *self.
+    // We disable the warning on GCC. Clang-5.0 does not have this warning.
+    //
+    // The caller promises that *self is zeroed, so the empty asm tells GCC
+    // that private_impl is defined. Otherwise, once this function and a
+    // small method (e.g. one that reads a "choose" guard field) are both
+    // inlined into the caller, GCC -O3 warns about that method's read.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    __asm__ __volatile__("" : "+m"(self->private_impl));
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((options & WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      options |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    }
+  }
+
+  self->private_impl.choosy_skip_plain_string_bytes = &wuffs_json__decoder__skip_plain_string_bytes__choosy_default;
+  self->private_impl.choosy_skip_whitespace = &wuffs_json__decoder__skip_whitespace__choosy_default;
+
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__token_decoder.vtable_name =
+      wuffs_base__token_decoder__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__token_decoder.function_pointers =
+      (const void*)(&wuffs_json__decoder__func_ptrs_for__wuffs_base__token_decoder);
+  return wuffs_base__make_status(NULL);
+}
+
+wuffs_json__decoder*
+wuffs_json__decoder__alloc() {
+  wuffs_json__decoder* x =
+      (wuffs_json__decoder*)(calloc(sizeof(wuffs_json__decoder), 1));
+  if (!x) {
+    return NULL;
+  }
+  if (wuffs_json__decoder__initialize(
+      x, sizeof(wuffs_json__decoder), WUFFS_VERSION, WUFFS_INITIALIZE__ALREADY_ZEROED).repr) {
+    free(x);
+    return NULL;
+  }
+  return x;
+}
+
+size_t
+sizeof__wuffs_json__decoder() {
+  return sizeof(wuffs_json__decoder);
+}
+
+wuffs_base__stats
+wuffs_json__decoder__stats(
+    const wuffs_json__decoder* self) {
+  wuffs_base__stats ret = wuffs_base__make_empty_stats();
+#if defined(WUFFS_CONFIG__STATS)
+  if (!self) {
+    return ret;
+  }
+  ret = self->private_impl.stats;
+#else
+  (void)(self);
+#endif  // defined(WUFFS_CONFIG__STATS)
+  return ret;
+}
+
+// ---------------- Function Implementations
+
+// -------- func json.decoder.set_quirk_enabled
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_json__decoder__set_quirk_enabled(
+    wuffs_json__decoder* self,
+    uint32_t a_quirk,
+    bool a_enabled) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  if (a_quirk >= 1225364480) {
+    a_quirk -= 1225364480;
+    if (a_quirk < 21) {
+      self->private_impl.f_quirks[a_quirk] = a_enabled;
+    }
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func json.decoder.workbuf_len
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64
+wuffs_json__decoder__workbuf_len(
+    const wuffs_json__decoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+
+  return wuffs_base__utility__empty_range_ii_u64();
+}
+
+// -------- func json.decoder.decode_tokens
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_json__decoder__decode_tokens(
+    wuffs_json__decoder* self,
+    wuffs_base__token_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+        ? wuffs_base__error__disabled_by_previous_error
+        : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst || !a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 1)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_vminor = 0;
+  uint32_t v_number_length = 0;
+  uint32_t v_number_status = 0;
+  uint32_t v_string_length = 0;
+  uint32_t v_whitespace_length = 0;
+  uint32_t v_depth = 0;
+  uint32_t v_stack_byte = 0;
+  uint32_t v_stack_bit = 0;
+  uint32_t v_match = 0;
+  uint32_t v_c4 = 0;
+  uint8_t v_c = 0;
+  uint8_t v_backslash = 0;
+  uint8_t v_char = 0;
+  uint8_t v_class = 0;
+  uint32_t v_multi_byte_utf8 = 0;
+  uint64_t v_c8 = 0;
+  uint32_t v_swar_chunks = 0;
+  uint32_t v_skipped = 0;
+  uint32_t v_skip_up_to = 0;
+  uint8_t v_backslash_x_ok = 0;
+  uint8_t v_backslash_x_value = 0;
+  uint32_t v_backslash_x_string = 0;
+  uint8_t v_uni4_ok = 0;
+  uint64_t v_uni4_string = 0;
+  uint32_t v_uni4_value = 0;
+  uint32_t v_uni4_high_surrogate = 0;
+  uint8_t v_uni8_ok = 0;
+  uint64_t v_uni8_string = 0;
+  uint32_t v_uni8_value = 0;
+  uint32_t v_expect = 0;
+  uint32_t v_expect_after_value = 0;
+
+  wuffs_base__token* iop_a_dst = NULL;
+  wuffs_base__token* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  wuffs_base__token* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  wuffs_base__token* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_tokens[0];
+  if (coro_susp_point) {
+    v_depth = self->private_data.s_decode_tokens[0].v_depth;
+    v_expect = self->private_data.s_decode_tokens[0].v_expect;
+    v_expect_after_value = self->private_data.s_decode_tokens[0].v_expect_after_value;
+  }
+  if (!coro_susp_point) {
+    if (self->private_impl.f_end_of_data) {
+      status = wuffs_base__make_status(wuffs_base__note__end_of_data);
+      goto ok;
+    }
+    if (self->private_impl.f_quirks[18]) {
+      if (self->private_impl.f_quirks[11] || self->private_impl.f_quirks[12] || self->private_impl.f_quirks[17]) {
+        status = wuffs_base__make_status(wuffs_json__error__bad_quirk_combination);
+        goto exit;
+      }
+    }
+    if (self->private_impl.f_quirks[15] || self->private_impl.f_quirks[16]) {
+      if (a_dst) {
+        a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+      }
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT_FRESH(1);
+      status = wuffs_json__decoder__decode_leading(self, a_dst, a_src);
+      if (a_dst) {
+        iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+      }
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+    }
+    v_expect = 7858;
+    label__fresh_outer__continue:;
+    while (true) {
+      while (true) {
+        if (((uint64_t)(io2_a_dst - iop_a_dst)) <= 0) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND_FRESH(2);
+          goto label__fresh_outer__continue;
+        }
+        v_whitespace_length = 0;
+        v_c = 0;
+        v_class = 0;
+        label__fresh_ws__continue:;
+        while (true) {
+          if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+            if (v_whitespace_length > 0) {
+              *iop_a_dst++ = wuffs_base__make_token(
+                  (((uint64_t)(0)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                  (((uint64_t)(v_whitespace_length)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+              v_whitespace_length = 0;
+            }
+            if (a_src && a_src->meta.closed) {
+              status = wuffs_base__make_status(wuffs_json__error__bad_input);
+              goto exit;
+            }
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND_FRESH(3);
+            v_whitespace_length = 0;
+            goto label__fresh_outer__continue;
+          }
+          v_c = wuffs_base__peek_u8be__no_bounds_check(iop_a_src);
+          v_class = WUFFS_JSON__LUT_CLASSES[v_c];
+          if (v_class != 0) {
+            goto label__fresh_ws__break;
+          }
+          if ((v_c == 32) && (((uint64_t)(io2_a_src - iop_a_src)) >= 16)) {
+            if (2314885530818453536 == wuffs_base__peek_u64le__no_bounds_check(iop_a_src)) {
+              if ( ! self->private_impl.f_have_chosen) {
+                wuffs_json__decoder__choose_skip_functions(self);
+              }
+              v_skip_up_to = (65534 - v_whitespace_length);
+              if (a_src) {
+                a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+              }
+              v_skipped = wuffs_json__decoder__skip_whitespace(self, a_src, v_skip_up_to);
+              if (a_src) {
+                iop_a_src = a_src->data.ptr + a_src->meta.ri;
+              }
+              if (v_skipped > v_skip_up_to) {
+                status = wuffs_base__make_status(wuffs_json__error__internal_error_inconsistent_i_o);
+                goto exit;
+              }
+              v_whitespace_length = (v_skipped + v_whitespace_length);
+              if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+                goto label__fresh_ws__continue;
+              }
+              v_c = wuffs_base__peek_u8be__no_bounds_check(iop_a_src);
+              v_class = WUFFS_JSON__LUT_CLASSES[v_c];
+              if (v_class != 0) {
+                goto label__fresh_ws__break;
+              }
+            }
+          }
+          iop_a_src += 1;
+          if (v_whitespace_length >= 65534) {
+            *iop_a_dst++ = wuffs_base__make_token(
+                (((uint64_t)(0)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                (((uint64_t)(65535)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+            v_whitespace_length = 0;
+            goto label__fresh_outer__continue;
+          }
+          v_whitespace_length += 1;
+        }
+        label__fresh_ws__break:;
+        if (v_whitespace_length > 0) {
+          *iop_a_dst++ = wuffs_base__make_token(
+              (((uint64_t)(0)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+              (((uint64_t)(v_whitespace_length)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+          v_whitespace_length = 0;
+          if (((uint64_t)(io2_a_dst - iop_a_dst)) <= 0) {
+            goto label__fresh_outer__continue;
+          }
+        }
+        if (0 == (v_expect & (((uint32_t)(1)) << v_class))) {
+          status = wuffs_base__make_status(wuffs_json__error__bad_input);
+          goto exit;
+        }
+        if (v_class == 1) {
+          *iop_a_dst++ = wuffs_base__make_token(
+              (((uint64_t)(4194579)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+              (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+              (((uint64_t)(1)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+          iop_a_src += 1;
+          label__fresh_string_loop_outer__continue:;
+          while (true) {
+            if (((uint64_t)(io2_a_dst - iop_a_dst)) <= 0) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+              WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND_FRESH(4);
+              goto label__fresh_string_loop_outer__continue;
+            }
+            v_string_length = 0;
+            label__fresh_string_loop_inner__continue:;
+            while (true) {
+              if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+                if (v_string_length > 0) {
+                  *iop_a_dst++ = wuffs_base__make_token(
+                      (((uint64_t)(4194819)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                      (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                      (((uint64_t)(v_string_length)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                  v_string_length = 0;
+                }
+                if (a_src && a_src->meta.closed) {
+                  status = wuffs_base__make_status(wuffs_json__error__bad_input);
+                  goto exit;
+                }
+                status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+                WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND_FRESH(5);
+                v_string_length = 0;
+                goto label__fresh_string_loop_outer__continue;
+              }
+              v_swar_chunks = 0;
+              label__fresh_0__continue:;
+              while ((((uint64_t)(io2_a_src - iop_a_src)) > 8) && (v_string_length <= 65527)) {
+                v_c8 = wuffs_base__peek_u64le__no_bounds_check(iop_a_src);
+                if (0 != (9259542123273814144u & (((uint64_t)(v_c8 - 2314885530818453536)) |
+                    ((uint64_t)((v_c8 ^ 2459565876494606882) - 72340172838076673)) |
+                    ((uint64_t)((v_c8 ^ 6655295901103053916) - 72340172838076673)) |
+                    v_c8))) {
+                  goto label__fresh_0__break;
+                }
+                iop_a_src += 8;
+                if (v_string_length > 65523) {
+                  *iop_a_dst++ = wuffs_base__make_token(
+                      (((uint64_t)(4194819)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                      (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                      (((uint64_t)((v_string_length + 8))) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                  v_string_length = 0;
+                  goto label__fresh_string_loop_outer__continue;
+                }
+                v_string_length += 8;
+                if (v_swar_chunks < 2) {
+                  v_swar_chunks += 1;
+                  goto label__fresh_0__continue;
+                }
+                if ( ! self->private_impl.f_have_chosen) {
+                  wuffs_json__decoder__choose_skip_functions(self);
+                }
+                v_skip_up_to = (65531 - v_string_length);
+                if (a_src) {
+                  a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+                }
+                v_skipped = wuffs_json__decoder__skip_plain_string_bytes(self, a_src, v_skip_up_to);
+                if (a_src) {
+                  iop_a_src = a_src->data.ptr + a_src->meta.ri;
+                }
+                if (v_skipped > v_skip_up_to) {
+                  status = wuffs_base__make_status(wuffs_json__error__internal_error_inconsistent_i_o);
+                  goto exit;
+                }
+                v_string_length = (v_skipped + v_string_length);
+                if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+                  goto label__fresh_string_loop_inner__continue;
+                }
+                goto label__fresh_0__break;
+              }
+              label__fresh_0__break:;
+              while (((uint64_t)(io2_a_src - iop_a_src)) > 4) {
+                v_c4 = wuffs_base__peek_u32le__no_bounds_check(iop_a_src);
+                if (0 != (WUFFS_JSON__LUT_CHARS[(255 & (v_c4 >> 0))] |
+                    WUFFS_JSON__LUT_CHARS[(255 & (v_c4 >> 8))] |
+                    WUFFS_JSON__LUT_CHARS[(255 & (v_c4 >> 16))] |
+                    WUFFS_JSON__LUT_CHARS[(255 & (v_c4 >> 24))])) {
+                  goto label__fresh_1__break;
+                }
+                iop_a_src += 4;
+                if (v_string_length > 65527) {
+                  *iop_a_dst++ = wuffs_base__make_token(
+                      (((uint64_t)(4194819)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                      (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                      (((uint64_t)((v_string_length + 4))) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                  v_string_length = 0;
+                  goto label__fresh_string_loop_outer__continue;
+                }
+                v_string_length += 4;
+              }
+              label__fresh_1__break:;
+              v_c = wuffs_base__peek_u8be__no_bounds_check(iop_a_src);
+              v_char = WUFFS_JSON__LUT_CHARS[v_c];
+              if (v_char == 0) {
+                iop_a_src += 1;
+                if (v_string_length >= 65531) {
+                  *iop_a_dst++ = wuffs_base__make_token(
+                      (((uint64_t)(4194819)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                      (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                      (((uint64_t)(65532)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                  v_string_length = 0;
+                  goto label__fresh_string_loop_outer__continue;
+                }
+                v_string_length += 1;
+                goto label__fresh_string_loop_inner__continue;
+              } else if (v_char == 1) {
+                if (v_string_length != 0) {
+                  *iop_a_dst++ = wuffs_base__make_token(
+                      (((uint64_t)(4194819)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                      (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                      (((uint64_t)(v_string_length)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                  v_string_length = 0;
+                }
+                goto label__fresh_string_loop_outer__break;
+              } else if (v_char == 2) {
+                if (v_string_length > 0) {
+                  *iop_a_dst++ = wuffs_base__make_token(
+                      (((uint64_t)(4194819)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                      (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                      (((uint64_t)(v_string_length)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                  v_string_length = 0;
+                  if (((uint64_t)(io2_a_dst - iop_a_dst)) <= 0) {
+                    goto label__fresh_string_loop_outer__continue;
+                  }
+                }
+                if (((uint64_t)(io2_a_src - iop_a_src)) < 2) {
+                  if (a_src && a_src->meta.closed) {
+                    status = wuffs_base__make_status(wuffs_json__error__bad_backslash_escape);
+                    goto exit;
+                  }
+                  status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+                  WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND_FRESH(6);
+                  v_string_length = 0;
+                  v_char = 0;
+                  goto label__fresh_string_loop_outer__continue;
+                }
+                v_c = ((uint8_t)((wuffs_base__peek_u16le__no_bounds_check(iop_a_src) >> 8)));
+                v_backslash = WUFFS_JSON__LUT_BACKSLASHES[v_c];
+                if ((v_backslash & 128) != 0) {
+                  iop_a_src += 2;
+                  *iop_a_dst++ = wuffs_base__make_token(
+                      (((uint64_t)((6291456 | ((uint32_t)((v_backslash & 127)))))) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                      (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                      (((uint64_t)(2)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                  goto label__fresh_string_loop_outer__continue;
+                } else if (v_backslash != 0) {
+                  if (self->private_impl.f_quirks[WUFFS_JSON__LUT_QUIRKY_BACKSLASHES_QUIRKS[(v_backslash & 7)]]) {
+                    iop_a_src += 2;
+                    *iop_a_dst++ = wuffs_base__make_token(
+                        (((uint64_t)((6291456 | ((uint32_t)(WUFFS_JSON__LUT_QUIRKY_BACKSLASHES_CHARS[(v_backslash & 7)]))))) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                        (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                        (((uint64_t)(2)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                    goto label__fresh_string_loop_outer__continue;
+                  }
+                } else if (v_c == 117) {
+                  if (((uint64_t)(io2_a_src - iop_a_src)) < 6) {
+                    if (a_src && a_src->meta.closed) {
+                      status = wuffs_base__make_status(wuffs_json__error__bad_backslash_escape);
+                      goto exit;
+                    }
+                    status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+                    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND_FRESH(7);
+                    v_string_length = 0;
+                    v_char = 0;
+                    goto label__fresh_string_loop_outer__continue;
+                  }
+                  v_uni4_string = (((uint64_t)(wuffs_base__peek_u48le__no_bounds_check(iop_a_src))) >> 16);
+                  v_uni4_value = 0;
+                  v_uni4_ok = 128;
+                  v_c = WUFFS_JSON__LUT_HEXADECIMAL_DIGITS[(255 & (v_uni4_string >> 0))];
+                  v_uni4_ok &= v_c;
+                  v_uni4_value |= (((uint32_t)((v_c & 15))) << 12);
+                  v_c = WUFFS_JSON__LUT_HEXADECIMAL_DIGITS[(255 & (v_uni4_string >> 8))];
+                  v_uni4_ok &= v_c;
+                  v_uni4_value |= (((uint32_t)((v_c & 15))) << 8);
+                  v_c = WUFFS_JSON__LUT_HEXADECIMAL_DIGITS[(255 & (v_uni4_string >> 16))];
+                  v_uni4_ok &= v_c;
+                  v_uni4_value |= (((uint32_t)((v_c & 15))) << 4);
+                  v_c = WUFFS_JSON__LUT_HEXADECIMAL_DIGITS[(255 & (v_uni4_string >> 24))];
+                  v_uni4_ok &= v_c;
+                  v_uni4_value |= (((uint32_t)((v_c & 15))) << 0);
+                  if (v_uni4_ok == 0) {
+                  } else if ((v_uni4_value < 55296) || (57343 < v_uni4_value)) {
+                    iop_a_src += 6;
+                    *iop_a_dst++ = wuffs_base__make_token(
+                        (((uint64_t)((6291456 | v_uni4_value))) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                        (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                        (((uint64_t)(6)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                    goto label__fresh_string_loop_outer__continue;
+                  } else if (v_uni4_value >= 56320) {
+                  } else {
+                    if (((uint64_t)(io2_a_src - iop_a_src)) < 12) {
+                      if (a_src && a_src->meta.closed) {
+                        if (self->private_impl.f_quirks[20]) {
+                          iop_a_src += 6;
+                          *iop_a_dst++ = wuffs_base__make_token(
+                              (((uint64_t)(6356989)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                              (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                              (((uint64_t)(6)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                          goto label__fresh_string_loop_outer__continue;
+                        }
+                        status = wuffs_base__make_status(wuffs_json__error__bad_backslash_escape);
+                        goto exit;
+                      }
+                      status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+                      WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND_FRESH(8);
+                      v_string_length = 0;
+                      v_uni4_value = 0;
+                      v_char = 0;
+                      goto label__fresh_string_loop_outer__continue;
+                    }
+                    v_uni4_string = (wuffs_base__peek_u64le__no_bounds_check(iop_a_src + 4) >> 16);
+                    if (((255 & (v_uni4_string >> 0)) != 92) || ((255 & (v_uni4_string >> 8)) != 117)) {
+                      v_uni4_high_surrogate = 0;
+                      v_uni4_value = 0;
+                      v_uni4_ok = 0;
+                    } else {
+                      v_uni4_high_surrogate = (65536 + ((v_uni4_value - 55296) << 10));
+                      v_uni4_value = 0;
+                      v_uni4_ok = 128;
+                      v_uni4_string >>= 16;
+                      v_c = WUFFS_JSON__LUT_HEXADECIMAL_DIGITS[(255 & (v_uni4_string >> 0))];
+                      v_uni4_ok &= v_c;
+                      v_uni4_value |= (((uint32_t)((v_c & 15))) << 12);
+                      v_c = WUFFS_JSON__LUT_HEXADECIMAL_DIGITS[(255 & (v_uni4_string >> 8))];
+                      v_uni4_ok &= v_c;
+                      v_uni4_value |= (((uint32_t)((v_c & 15))) << 8);
+                      v_c = WUFFS_JSON__LUT_HEXADECIMAL_DIGITS[(255 & (v_uni4_string >> 16))];
+                      v_uni4_ok &= v_c;
+                      v_uni4_value |= (((uint32_t)((v_c & 15))) << 4);
+                      v_c = WUFFS_JSON__LUT_HEXADECIMAL_DIGITS[(255 & (v_uni4_string >> 24))];
+                      v_uni4_ok &= v_c;
+                      v_uni4_value |= (((uint32_t)((v_c & 15))) << 0);
+                    }
+                    if ((v_uni4_ok != 0) && (56320 <= v_uni4_value) && (v_uni4_value <= 57343)) {
+                      v_uni4_value -= 56320;
+                      iop_a_src += 12;
+                      *iop_a_dst++ = wuffs_base__make_token(
+                          (((uint64_t)((6291456 | v_uni4_high_surrogate | v_uni4_value))) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                          (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                          (((uint64_t)(12)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                      goto label__fresh_string_loop_outer__continue;
+                    }
+                  }
+                  if (self->private_impl.f_quirks[20]) {
+                    if (((uint64_t)(io2_a_src - iop_a_src)) < 6) {
+                      status = wuffs_base__make_status(wuffs_json__error__internal_error_inconsistent_i_o);
+                      goto exit;
+                    }
+                    iop_a_src += 6;
+                    *iop_a_dst++ = wuffs_base__make_token(
+                        (((uint64_t)(6356989)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                        (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                        (((uint64_t)(6)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                    goto label__fresh_string_loop_outer__continue;
+                  }
+                } else if ((v_c == 85) && self->private_impl.f_quirks[2]) {
+                  if (((uint64_t)(io2_a_src - iop_a_src)) < 10) {
+                    if (a_src && a_src->meta.closed) {
+                      status = wuffs_base__make_status(wuffs_json__error__bad_backslash_escape);
+                      goto exit;
+                    }
+                    status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+                    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND_FRESH(9);
+                    v_string_length = 0;
+                    v_char = 0;
+                    goto label__fresh_string_loop_outer__continue;
+                  }
+                  v_uni8_string = wuffs_base__peek_u64le__no_bounds_check(iop_a_src + 2);
+                  v_uni8_value = 0;
+                  v_uni8_ok = 128;
+                  v_c = WUFFS_JSON__LUT_HEXADECIMAL_DIGITS[(255 & (v_uni8_string >> 0))];
+                  v_uni8_ok &= v_c;
+                  v_uni8_value |= (((uint32_t)((v_c & 15))) << 28);
+                  v_c = WUFFS_JSON__LUT_HEXADECIMAL_DIGITS[(255 & (v_uni8_string >> 8))];
+                  v_uni8_ok &= v_c;
+                  v_uni8_value |= (((uint32_t)((v_c & 15))) << 24);
+                  v_c = WUFFS_JSON__LUT_HEXADECIMAL_DIGITS[(255 & (v_uni8_string >> 16))];
+                  v_uni8_ok &= v_c;
+                  v_uni8_value |= (((uint32_t)((v_c & 15))) << 20);
+                  v_c = WUFFS_JSON__LUT_HEXADECIMAL_DIGITS[(255 & (v_uni8_string >> 24))];
+                  v_uni8_ok &= v_c;
+                  v_uni8_value |= (((uint32_t)((v_c & 15))) << 16);
+                  v_c = WUFFS_JSON__LUT_HEXADECIMAL_DIGITS[(255 & (v_uni8_string >> 32))];
+                  v_uni8_ok &= v_c;
+                  v_uni8_value |= (((uint32_t)((v_c & 15))) << 12);
+                  v_c = WUFFS_JSON__LUT_HEXADECIMAL_DIGITS[(255 & (v_uni8_string >> 40))];
+                  v_uni8_ok &= v_c;
+                  v_uni8_value |= (((uint32_t)((v_c & 15))) << 8);
+                  v_c = WUFFS_JSON__LUT_HEXADECIMAL_DIGITS[(255 & (v_uni8_string >> 48))];
+                  v_uni8_ok &= v_c;
+                  v_uni8_value |= (((uint32_t)((v_c & 15))) << 4);
+                  v_c = WUFFS_JSON__LUT_HEXADECIMAL_DIGITS[(255 & (v_uni8_string >> 56))];
+                  v_uni8_ok &= v_c;
+                  v_uni8_value |= (((uint32_t)((v_c & 15))) << 0);
+                  if (v_uni8_ok == 0) {
+                  } else if ((v_uni8_value < 55296) || ((57343 < v_uni8_value) && (v_uni8_value <= 1114111))) {
+                    iop_a_src += 10;
+                    *iop_a_dst++ = wuffs_base__make_token(
+                        (((uint64_t)((6291456 | (v_uni8_value & 2097151)))) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                        (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                        (((uint64_t)(10)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                    goto label__fresh_string_loop_outer__continue;
+                  } else if (self->private_impl.f_quirks[20]) {
+                    iop_a_src += 10;
+                    *iop_a_dst++ = wuffs_base__make_token(
+                        (((uint64_t)(6356989)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                        (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                        (((uint64_t)(10)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                    goto label__fresh_string_loop_outer__continue;
+                  }
+                } else if ((v_c == 120) && self->private_impl.f_quirks[9]) {
+                  if (((uint64_t)(io2_a_src - iop_a_src)) < 4) {
+                    if (a_src && a_src->meta.closed) {
+                      status = wuffs_base__make_status(wuffs_json__error__bad_backslash_escape);
+                      goto exit;
+                    }
+                    status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+                    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND_FRESH(10);
+                    v_string_length = 0;
+                    v_char = 0;
+                    goto label__fresh_string_loop_outer__continue;
+                  }
+                  v_backslash_x_string = wuffs_base__peek_u32le__no_bounds_check(iop_a_src);
+                  v_backslash_x_ok = 128;
+                  v_c = WUFFS_JSON__LUT_HEXADECIMAL_DIGITS[(255 & (v_backslash_x_string >> 16))];
+                  v_backslash_x_ok &= v_c;
+                  v_backslash_x_value = ((uint8_t)(((v_c & 15) << 4)));
+                  v_c = WUFFS_JSON__LUT_HEXADECIMAL_DIGITS[(255 & (v_backslash_x_string >> 24))];
+                  v_backslash_x_ok &= v_c;
+                  v_backslash_x_value = ((uint8_t)((v_backslash_x_value | (v_c & 15))));
+                  if ((v_backslash_x_ok == 0) || ((v_backslash_x_string & 65535) != 30812)) {
+                    status = wuffs_base__make_status(wuffs_json__error__bad_backslash_escape);
+                    goto exit;
+                  }
+                  iop_a_src += 4;
+                  *iop_a_dst++ = wuffs_base__make_token(
+                      (((uint64_t)((6291456 | ((uint32_t)(v_backslash_x_value))))) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                      (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                      (((uint64_t)(4)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                  goto label__fresh_string_loop_outer__continue;
+                }
+                status = wuffs_base__make_status(wuffs_json__error__bad_backslash_escape);
+                goto exit;
+              } else if (v_char == 3) {
+                if (((uint64_t)(io2_a_src - iop_a_src)) < 2) {
+                  if (v_string_length > 0) {
+                    *iop_a_dst++ = wuffs_base__make_token(
+                        (((uint64_t)(4194819)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                        (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                        (((uint64_t)(v_string_length)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                    v_string_length = 0;
+                    if (((uint64_t)(io2_a_dst - iop_a_dst)) <= 0) {
+                      goto label__fresh_string_loop_outer__continue;
+                    }
+                  }
+                  if (a_src && a_src->meta.closed) {
+                    if (self->private_impl.f_quirks[20]) {
+                      *iop_a_dst++ = wuffs_base__make_token(
+                          (((uint64_t)(6356989)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                          (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                          (((uint64_t)(1)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                      iop_a_src += 1;
+                      goto label__fresh_string_loop_outer__continue;
+                    }
+                    status = wuffs_base__make_status(wuffs_json__error__bad_utf_8);
+                    goto exit;
+                  }
+                  status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+                  WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND_FRESH(11);
+                  v_string_length = 0;
+                  v_char = 0;
+                  goto label__fresh_string_loop_outer__continue;
+                }
+                v_multi_byte_utf8 = ((uint32_t)(wuffs_base__peek_u16le__no_bounds_check(iop_a_src)));
+                if ((v_multi_byte_utf8 & 49152) == 32768) {
+                  v_multi_byte_utf8 = ((1984 & ((uint32_t)(v_multi_byte_utf8 << 6))) | (63 & (v_multi_byte_utf8 >> 8)));
+                  iop_a_src += 2;
+                  if (v_string_length >= 65528) {
+                    *iop_a_dst++ = wuffs_base__make_token(
+                        (((uint64_t)(4194819)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                        (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                        (((uint64_t)((v_string_length + 2))) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                    v_string_length = 0;
+                    goto label__fresh_string_loop_outer__continue;
+                  }
+                  v_string_length += 2;
+                  goto label__fresh_string_loop_inner__continue;
+                }
+              } else if (v_char == 4) {
+                if (((uint64_t)(io2_a_src - iop_a_src)) < 3) {
+                  if (v_string_length > 0) {
+                    *iop_a_dst++ = wuffs_base__make_token(
+                        (((uint64_t)(4194819)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                        (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                        (((uint64_t)(v_string_length)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                    v_string_length = 0;
+                    if (((uint64_t)(io2_a_dst - iop_a_dst)) <= 0) {
+                      goto label__fresh_string_loop_outer__continue;
+                    }
+                  }
+                  if (a_src && a_src->meta.closed) {
+                    if (self->private_impl.f_quirks[20]) {
+                      *iop_a_dst++ = wuffs_base__make_token(
+                          (((uint64_t)(6356989)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                          (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                          (((uint64_t)(1)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                      iop_a_src += 1;
+                      goto label__fresh_string_loop_outer__continue;
+                    }
+                    status = wuffs_base__make_status(wuffs_json__error__bad_utf_8);
+                    goto exit;
+                  }
+                  status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+                  WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND_FRESH(12);
+                  v_string_length = 0;
+                  v_char = 0;
+                  goto label__fresh_string_loop_outer__continue;
+                }
+                v_multi_byte_utf8 = ((uint32_t)(wuffs_base__peek_u24le__no_bounds_check(iop_a_src)));
+                if ((v_multi_byte_utf8 & 12632064) == 8421376) {
+                  v_multi_byte_utf8 = ((61440 & ((uint32_t)(v_multi_byte_utf8 << 12))) | (4032 & (v_multi_byte_utf8 >> 2)) | (63 & (v_multi_byte_utf8 >> 16)));
+                  if ((2047 < v_multi_byte_utf8) && ((v_multi_byte_utf8 < 55296) || (57343 < v_multi_byte_utf8))) {
+                    iop_a_src += 3;
+                    if (v_string_length >= 65528) {
+                      *iop_a_dst++ = wuffs_base__make_token(
+                          (((uint64_t)(4194819)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                          (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                          (((uint64_t)((v_string_length + 3))) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                      v_string_length = 0;
+                      goto label__fresh_string_loop_outer__continue;
+                    }
+                    v_string_length += 3;
+                    goto label__fresh_string_loop_inner__continue;
+                  }
+                }
+              } else if (v_char == 5) {
+                if (((uint64_t)(io2_a_src - iop_a_src)) < 4) {
+                  if (v_string_length > 0) {
+                    *iop_a_dst++ = wuffs_base__make_token(
+                        (((uint64_t)(4194819)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                        (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                        (((uint64_t)(v_string_length)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                    v_string_length = 0;
+                    if (((uint64_t)(io2_a_dst - iop_a_dst)) <= 0) {
+                      goto label__fresh_string_loop_outer__continue;
+                    }
+                  }
+                  if (a_src && a_src->meta.closed) {
+                    if (self->private_impl.f_quirks[20]) {
+                      *iop_a_dst++ = wuffs_base__make_token(
+                          (((uint64_t)(6356989)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                          (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                          (((uint64_t)(1)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                      iop_a_src += 1;
+                      goto label__fresh_string_loop_outer__continue;
+                    }
+                    status = wuffs_base__make_status(wuffs_json__error__bad_utf_8);
+                    goto exit;
+                  }
+                  status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+                  WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND_FRESH(13);
+                  v_string_length = 0;
+                  v_char = 0;
+                  goto label__fresh_string_loop_outer__continue;
+                }
+                v_multi_byte_utf8 = wuffs_base__peek_u32le__no_bounds_check(iop_a_src);
+                if ((v_multi_byte_utf8 & 3233857536) == 2155905024) {
+                  v_multi_byte_utf8 = ((1835008 & ((uint32_t)(v_multi_byte_utf8 << 18))) |
+                      (258048 & ((uint32_t)(v_multi_byte_utf8 << 4))) |
+                      (4032 & (v_multi_byte_utf8 >> 10)) |
+                      (63 & (v_multi_byte_utf8 >> 24)));
+                  if ((65535 < v_multi_byte_utf8) && (v_multi_byte_utf8 <= 1114111)) {
+                    iop_a_src += 4;
+                    if (v_string_length >= 65528) {
+                      *iop_a_dst++ = wuffs_base__make_token(
+                          (((uint64_t)(4194819)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                          (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                          (((uint64_t)((v_string_length + 4))) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                      v_string_length = 0;
+                      goto label__fresh_string_loop_outer__continue;
+                    }
+                    v_string_length += 4;
+                    goto label__fresh_string_loop_inner__continue;
+                  }
+                }
+              }
+              if (v_string_length > 0) {
+                *iop_a_dst++ = wuffs_base__make_token(
+                    (((uint64_t)(4194819)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                    (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                    (((uint64_t)(v_string_length)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                v_string_length = 0;
+                if (((uint64_t)(io2_a_dst - iop_a_dst)) <= 0) {
+                  goto label__fresh_string_loop_outer__continue;
+                }
+              }
+              if ((v_char & 128) != 0) {
+                if (self->private_impl.f_quirks[0]) {
+                  *iop_a_dst++ = wuffs_base__make_token(
+                      (((uint64_t)((6291456 | ((uint32_t)((v_char & 127)))))) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                      (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                      (((uint64_t)(1)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                  iop_a_src += 1;
+                  goto label__fresh_string_loop_outer__continue;
+                }
+                if (v_char == 138) {
+                  status = wuffs_base__make_status(wuffs_json__error__bad_new_line_in_a_string);
+                  goto exit;
+                }
+                status = wuffs_base__make_status(wuffs_json__error__bad_c0_control_code);
+                goto exit;
+              }
+              if (self->private_impl.f_quirks[20]) {
+                *iop_a_dst++ = wuffs_base__make_token(
+                    (((uint64_t)(6356989)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                    (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                    (((uint64_t)(1)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                iop_a_src += 1;
+                goto label__fresh_string_loop_outer__continue;
+              }
+              status = wuffs_base__make_status(wuffs_json__error__bad_utf_8);
+              goto exit;
+            }
+          }
+          label__fresh_string_loop_outer__break:;
+          label__fresh_2__continue:;
+          while (true) {
+            if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+              if (a_src && a_src->meta.closed) {
+                status = wuffs_base__make_status(wuffs_json__error__bad_input);
+                goto exit;
+              }
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND_FRESH(14);
+              goto label__fresh_2__continue;
+            }
+            if (((uint64_t)(io2_a_dst - iop_a_dst)) <= 0) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+              WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND_FRESH(15);
+              goto label__fresh_2__continue;
+            }
+            iop_a_src += 1;
+            *iop_a_dst++ = wuffs_base__make_token(
+                (((uint64_t)(4194579)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                (((uint64_t)(1)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+            goto label__fresh_2__break;
+          }
+          label__fresh_2__break:;
+          if (0 == (v_expect & (((uint32_t)(1)) << 4))) {
+            v_expect = 4104;
+            goto label__fresh_outer__continue;
+          }
+          goto label__fresh_goto_parsed_a_leaf_value__break;
+        } else if (v_class == 2) {
+          iop_a_src += 1;
+          *iop_a_dst++ = wuffs_base__make_token(
+              (((uint64_t)(1)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+              (((uint64_t)(1)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+          if (0 == (v_expect & (((uint32_t)(1)) << 8))) {
+            if (self->private_impl.f_quirks[13]) {
+              v_expect = 4162;
+            } else {
+              v_expect = 4098;
+            }
+          } else {
+            if (self->private_impl.f_quirks[13]) {
+              v_expect = 8114;
+            } else {
+              v_expect = 7858;
+            }
+          }
+          goto label__fresh_outer__continue;
+        } else if (v_class == 3) {
+          iop_a_src += 1;
+          *iop_a_dst++ = wuffs_base__make_token(
+              (((uint64_t)(1)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+              (((uint64_t)(1)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+          v_expect = 7858;
+          goto label__fresh_outer__continue;
+        } else if (v_class == 4) {
+          while (true) {
+            if (a_src) {
+              a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+            }
+            v_number_length = wuffs_json__decoder__decode_number(self, a_src);
+            if (a_src) {
+              iop_a_src = a_src->data.ptr + a_src->meta.ri;
+            }
+            v_number_status = (v_number_length >> 8);
+            v_vminor = 10486787;
+            if ((v_number_length & 128) != 0) {
+              v_vminor = 10486785;
+            }
+            v_number_length = (v_number_length & 127);
+            if (v_number_status == 0) {
+              *iop_a_dst++ = wuffs_base__make_token(
+                  (((uint64_t)(v_vminor)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                  (((uint64_t)(v_number_length)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+              goto label__fresh_3__break;
+            }
+            while (v_number_length > 0) {
+              v_number_length -= 1;
+              if (iop_a_src > io1_a_src) {
+                iop_a_src--;
+              } else {
+                status = wuffs_base__make_status(wuffs_json__error__internal_error_inconsistent_i_o);
+                goto exit;
+              }
+            }
+            if (v_number_status == 1) {
+              if (self->private_impl.f_quirks[14]) {
+                if (a_dst) {
+                  a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+                }
+                if (a_src) {
+                  a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+                }
+                WUFFS_BASE__COROUTINE_SUSPENSION_POINT_FRESH(16);
+                status = wuffs_json__decoder__decode_inf_nan(self, a_dst, a_src);
+                if (a_dst) {
+                  iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+                }
+                if (a_src) {
+                  iop_a_src = a_src->data.ptr + a_src->meta.ri;
+                }
+                if (status.repr) {
+                  goto suspend;
+                }
+                goto label__fresh_3__break;
+              }
+              status = wuffs_base__make_status(wuffs_json__error__bad_input);
+              goto exit;
+            } else if (v_number_status == 2) {
+              status = wuffs_base__make_status(wuffs_json__error__unsupported_number_length);
+              goto exit;
+            } else {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND_FRESH(17);
+              while (((uint64_t)(io2_a_dst - iop_a_dst)) <= 0) {
+                status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+                WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND_FRESH(18);
+              }
+            }
+          }
+          label__fresh_3__break:;
+          goto label__fresh_goto_parsed_a_leaf_value__break;
+        } else if (v_class == 5) {
+          v_vminor = 2113553;
+          if (v_depth == 0) {
+          } else if (0 != (v_expect_after_value & (((uint32_t)(1)) << 6))) {
+            v_vminor = 2113601;
+          } else {
+            v_vminor = 2113569;
+          }
+          if (v_depth >= 1024) {
+            status = wuffs_base__make_status(wuffs_json__error__unsupported_recursion_depth);
+            goto exit;
+          }
+          v_stack_byte = (v_depth / 32);
+          v_stack_bit = (v_depth & 31);
+          self->private_data.f_stack[v_stack_byte] |= (((uint32_t)(1)) << v_stack_bit);
+          v_depth += 1;
+          iop_a_src += 1;
+          *iop_a_dst++ = wuffs_base__make_token(
+              (((uint64_t)(v_vminor)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+              (((uint64_t)(1)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+          v_expect = 4162;
+          v_expect_after_value = 4164;
+          goto label__fresh_outer__continue;
+        } else if (v_class == 6) {
+          iop_a_src += 1;
+          if (v_depth <= 1) {
+            *iop_a_dst++ = wuffs_base__make_token(
+                (((uint64_t)(2101314)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                (((uint64_t)(1)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+            goto label__fresh_outer__break;
+          }
+          v_depth -= 1;
+          v_stack_byte = ((v_depth - 1) / 32);
+          v_stack_bit = ((v_depth - 1) & 31);
+          if (0 == (self->private_data.f_stack[v_stack_byte] & (((uint32_t)(1)) << v_stack_bit))) {
+            *iop_a_dst++ = wuffs_base__make_token(
+                (((uint64_t)(2105410)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                (((uint64_t)(1)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+            v_expect = 4356;
+            v_expect_after_value = 4356;
+          } else {
+            *iop_a_dst++ = wuffs_base__make_token(
+                (((uint64_t)(2113602)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                (((uint64_t)(1)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+            v_expect = 4164;
+            v_expect_after_value = 4164;
+          }
+          goto label__fresh_outer__continue;
+        } else if (v_class == 7) {
+          v_vminor = 2105361;
+          if (v_depth == 0) {
+          } else if (0 != (v_expect_after_value & (((uint32_t)(1)) << 6))) {
+            v_vminor = 2105409;
+          } else {
+            v_vminor = 2105377;
+          }
+          if (v_depth >= 1024) {
+            status = wuffs_base__make_status(wuffs_json__error__unsupported_recursion_depth);
+            goto exit;
+          }
+          v_stack_byte = (v_depth / 32);
+          v_stack_bit = (v_depth & 31);
+          self->private_data.f_stack[v_stack_byte] &= (4294967295 ^ (((uint32_t)(1)) << v_stack_bit));
+          v_depth += 1;
+          iop_a_src += 1;
+          *iop_a_dst++ = wuffs_base__make_token(
+              (((uint64_t)(v_vminor)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+              (((uint64_t)(1)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+          v_expect = 8114;
+          v_expect_after_value = 4356;
+          goto label__fresh_outer__continue;
+        } else if (v_class == 8) {
+          iop_a_src += 1;
+          if (v_depth <= 1) {
+            *iop_a_dst++ = wuffs_base__make_token(
+                (((uint64_t)(2101282)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                (((uint64_t)(1)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+            goto label__fresh_outer__break;
+          }
+          v_depth -= 1;
+          v_stack_byte = ((v_depth - 1) / 32);
+          v_stack_bit = ((v_depth - 1) & 31);
+          if (0 == (self->private_data.f_stack[v_stack_byte] & (((uint32_t)(1)) << v_stack_bit))) {
+            *iop_a_dst++ = wuffs_base__make_token(
+                (((uint64_t)(2105378)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                (((uint64_t)(1)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+            v_expect = 4356;
+            v_expect_after_value = 4356;
+          } else {
+            *iop_a_dst++ = wuffs_base__make_token(
+                (((uint64_t)(2113570)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                (((uint64_t)(1)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+            v_expect = 4164;
+            v_expect_after_value = 4164;
+          }
+          goto label__fresh_outer__continue;
+        } else if (v_class == 9) {
+          v_match = wuffs_base__io_reader__match7(iop_a_src, io2_a_src, a_src,111546413966853);
+          if (v_match == 0) {
+            *iop_a_dst++ = wuffs_base__make_token(
+                (((uint64_t)(8388612)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                (((uint64_t)(5)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+            if (((uint64_t)(io2_a_src - iop_a_src)) < 5) {
+              status = wuffs_base__make_status(wuffs_json__error__internal_error_inconsistent_i_o);
+              goto exit;
+            }
+            iop_a_src += 5;
+            goto label__fresh_goto_parsed_a_leaf_value__break;
+          } else if (v_match == 1) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND_FRESH(19);
+            goto label__fresh_outer__continue;
+          }
+        } else if (v_class == 10) {
+          v_match = wuffs_base__io_reader__match7(iop_a_src, io2_a_src, a_src,435762131972);
+          if (v_match == 0) {
+            *iop_a_dst++ = wuffs_base__make_token(
+                (((uint64_t)(8388616)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                (((uint64_t)(4)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+            if (((uint64_t)(io2_a_src - iop_a_src)) < 4) {
+              status = wuffs_base__make_status(wuffs_json__error__internal_error_inconsistent_i_o);
+              goto exit;
+            }
+            iop_a_src += 4;
+            goto label__fresh_goto_parsed_a_leaf_value__break;
+          } else if (v_match == 1) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND_FRESH(20);
+            goto label__fresh_outer__continue;
+          }
+        } else if (v_class == 11) {
+          v_match = wuffs_base__io_reader__match7(iop_a_src, io2_a_src, a_src,465676103172);
+          if (v_match == 0) {
+            *iop_a_dst++ = wuffs_base__make_token(
+                (((uint64_t)(8388610)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                (((uint64_t)(4)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+            if (((uint64_t)(io2_a_src - iop_a_src)) < 4) {
+              status = wuffs_base__make_status(wuffs_json__error__internal_error_inconsistent_i_o);
+              goto exit;
+            }
+            iop_a_src += 4;
+            goto label__fresh_goto_parsed_a_leaf_value__break;
+          } else if (v_match == 1) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND_FRESH(21);
+            goto label__fresh_outer__continue;
+          }
+          if (self->private_impl.f_quirks[14]) {
+            if (a_dst) {
+              a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+            }
+            if (a_src) {
+              a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+            }
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT_FRESH(22);
+            status = wuffs_json__decoder__decode_inf_nan(self, a_dst, a_src);
+            if (a_dst) {
+              iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+            }
+            if (a_src) {
+              iop_a_src = a_src->data.ptr + a_src->meta.ri;
+            }
+            if (status.repr) {
+              goto suspend;
+            }
+            goto label__fresh_goto_parsed_a_leaf_value__break;
+          }
+        } else if (v_class == 12) {
+          if (self->private_impl.f_quirks[11] || self->private_impl.f_quirks[12]) {
+            if (a_dst) {
+              a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+            }
+            if (a_src) {
+              a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+            }
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT_FRESH(23);
+            status = wuffs_json__decoder__decode_comment(self, a_dst, a_src);
+            if (a_dst) {
+              iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+            }
+            if (a_src) {
+              iop_a_src = a_src->data.ptr + a_src->meta.ri;
+            }
+            if (status.repr) {
+              goto suspend;
+            }
+            if (self->private_impl.f_comment_type > 0) {
+              goto label__fresh_outer__continue;
+            }
+          }
+        }
+        status = wuffs_base__make_status(wuffs_json__error__bad_input);
+        goto exit;
+      }
+      label__fresh_goto_parsed_a_leaf_value__break:;
+      if (v_depth == 0) {
+        goto label__fresh_outer__break;
+      }
+      v_expect = v_expect_after_value;
+    }
+    label__fresh_outer__break:;
+    if (self->private_impl.f_quirks[17] || self->private_impl.f_quirks[18]) {
+      if (a_dst) {
+        a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+      }
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT_FRESH(24);
+      status = wuffs_json__decoder__decode_trailer(self, a_dst, a_src);
+      if (a_dst) {
+        iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+      }
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+    }
+    self->private_impl.f_end_of_data = true;
+    goto ok;
+  }
+
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_end_of_data) {
+      status = wuffs_base__make_status(wuffs_base__note__end_of_data);
+      goto ok;
+    }
+    if (self->private_impl.f_quirks[18]) {
+      if (self->private_impl.f_quirks[11] || self->private_impl.f_quirks[12] || self->private_impl.f_quirks[17]) {
+        status = wuffs_base__make_status(wuffs_json__error__bad_quirk_combination);
+        goto exit;
+      }
+    }
+    if (self->private_impl.f_quirks[15] || self->private_impl.f_quirks[16]) {
+      if (a_dst) {
+        a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+      }
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      status = wuffs_json__decoder__decode_leading(self, a_dst, a_src);
+      if (a_dst) {
+        iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+      }
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+    }
+    v_expect = 7858;
+    label__outer__continue:;
+    while (true) {
+      while (true) {
+        if (((uint64_t)(io2_a_dst - iop_a_dst)) <= 0) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(2);
+          goto label__outer__continue;
+        }
+        v_whitespace_length = 0;
+        v_c = 0;
+        v_class = 0;
+        label__ws__continue:;
+        while (true) {
+          if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+            if (v_whitespace_length > 0) {
+              *iop_a_dst++ = wuffs_base__make_token(
+                  (((uint64_t)(0)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                  (((uint64_t)(v_whitespace_length)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+              v_whitespace_length = 0;
+            }
+            if (a_src && a_src->meta.closed) {
+              status = wuffs_base__make_status(wuffs_json__error__bad_input);
+              goto exit;
+            }
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(3);
+            v_whitespace_length = 0;
+            goto label__outer__continue;
+          }
+          v_c = wuffs_base__peek_u8be__no_bounds_check(iop_a_src);
+          v_class = WUFFS_JSON__LUT_CLASSES[v_c];
+          if (v_class != 0) {
+            goto label__ws__break;
+          }
+          if ((v_c == 32) && (((uint64_t)(io2_a_src - iop_a_src)) >= 16)) {
+            if (2314885530818453536 == wuffs_base__peek_u64le__no_bounds_check(iop_a_src)) {
+              if ( ! self->private_impl.f_have_chosen) {
+                wuffs_json__decoder__choose_skip_functions(self);
+              }
+              v_skip_up_to = (65534 - v_whitespace_length);
+              if (a_src) {
+                a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+              }
+              v_skipped = wuffs_json__decoder__skip_whitespace(self, a_src, v_skip_up_to);
+              if (a_src) {
+                iop_a_src = a_src->data.ptr + a_src->meta.ri;
+              }
+              if (v_skipped > v_skip_up_to) {
+                status = wuffs_base__make_status(wuffs_json__error__internal_error_inconsistent_i_o);
+                goto exit;
+              }
+              v_whitespace_length = (v_skipped + v_whitespace_length);
+              if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+                goto label__ws__continue;
+              }
+              v_c = wuffs_base__peek_u8be__no_bounds_check(iop_a_src);
+              v_class = WUFFS_JSON__LUT_CLASSES[v_c];
+              if (v_class != 0) {
+                goto label__ws__break;
+              }
+            }
+          }
+          iop_a_src += 1;
+          if (v_whitespace_length >= 65534) {
+            *iop_a_dst++ = wuffs_base__make_token(
+                (((uint64_t)(0)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                (((uint64_t)(65535)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+            v_whitespace_length = 0;
+            goto label__outer__continue;
+          }
+          v_whitespace_length += 1;
+        }
+        label__ws__break:;
+        if (v_whitespace_length > 0) {
+          *iop_a_dst++ = wuffs_base__make_token(
+              (((uint64_t)(0)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+              (((uint64_t)(v_whitespace_length)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+          v_whitespace_length = 0;
+          if (((uint64_t)(io2_a_dst - iop_a_dst)) <= 0) {
+            goto label__outer__continue;
+          }
+        }
+        if (0 == (v_expect & (((uint32_t)(1)) << v_class))) {
+          status = wuffs_base__make_status(wuffs_json__error__bad_input);
+          goto exit;
+        }
+        if (v_class == 1) {
+          *iop_a_dst++ = wuffs_base__make_token(
+              (((uint64_t)(4194579)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+              (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+              (((uint64_t)(1)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+          iop_a_src += 1;
+          label__string_loop_outer__continue:;
+          while (true) {
+            if (((uint64_t)(io2_a_dst - iop_a_dst)) <= 0) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+              WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(4);
+              goto label__string_loop_outer__continue;
+            }
+            v_string_length = 0;
+            label__string_loop_inner__continue:;
+            while (true) {
+              if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+                if (v_string_length > 0) {
+                  *iop_a_dst++ = wuffs_base__make_token(
+                      (((uint64_t)(4194819)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                      (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                      (((uint64_t)(v_string_length)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                  v_string_length = 0;
+                }
+                if (a_src && a_src->meta.closed) {
+                  status = wuffs_base__make_status(wuffs_json__error__bad_input);
+                  goto exit;
+                }
+                status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+                WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(5);
+                v_string_length = 0;
+                goto label__string_loop_outer__continue;
+              }
+              v_swar_chunks = 0;
+              label__0__continue:;
+              while ((((uint64_t)(io2_a_src - iop_a_src)) > 8) && (v_string_length <= 65527)) {
+                v_c8 = wuffs_base__peek_u64le__no_bounds_check(iop_a_src);
+                if (0 != (9259542123273814144u & (((uint64_t)(v_c8 - 2314885530818453536)) |
+                    ((uint64_t)((v_c8 ^ 2459565876494606882) - 72340172838076673)) |
+                    ((uint64_t)((v_c8 ^ 6655295901103053916) - 72340172838076673)) |
+                    v_c8))) {
+                  goto label__0__break;
+                }
+                iop_a_src += 8;
+                if (v_string_length > 65523) {
+                  *iop_a_dst++ = wuffs_base__make_token(
+                      (((uint64_t)(4194819)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                      (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                      (((uint64_t)((v_string_length + 8))) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                  v_string_length = 0;
+                  goto label__string_loop_outer__continue;
+                }
+                v_string_length += 8;
+                if (v_swar_chunks < 2) {
+                  v_swar_chunks += 1;
+                  goto label__0__continue;
+                }
+                if ( ! self->private_impl.f_have_chosen) {
+                  wuffs_json__decoder__choose_skip_functions(self);
+                }
+                v_skip_up_to = (65531 - v_string_length);
+                if (a_src) {
+                  a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+                }
+                v_skipped = wuffs_json__decoder__skip_plain_string_bytes(self, a_src, v_skip_up_to);
+                if (a_src) {
+                  iop_a_src = a_src->data.ptr + a_src->meta.ri;
+                }
+                if (v_skipped > v_skip_up_to) {
+                  status = wuffs_base__make_status(wuffs_json__error__internal_error_inconsistent_i_o);
+                  goto exit;
+                }
+                v_string_length = (v_skipped + v_string_length);
+                if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+                  goto label__string_loop_inner__continue;
+                }
+                goto label__0__break;
+              }
+              label__0__break:;
+              while (((uint64_t)(io2_a_src - iop_a_src)) > 4) {
+                v_c4 = wuffs_base__peek_u32le__no_bounds_check(iop_a_src);
+                if (0 != (WUFFS_JSON__LUT_CHARS[(255 & (v_c4 >> 0))] |
+                    WUFFS_JSON__LUT_CHARS[(255 & (v_c4 >> 8))] |
+                    WUFFS_JSON__LUT_CHARS[(255 & (v_c4 >> 16))] |
+                    WUFFS_JSON__LUT_CHARS[(255 & (v_c4 >> 24))])) {
+                  goto label__1__break;
+                }
+                iop_a_src += 4;
+                if (v_string_length > 65527) {
+                  *iop_a_dst++ = wuffs_base__make_token(
+                      (((uint64_t)(4194819)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                      (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                      (((uint64_t)((v_string_length + 4))) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                  v_string_length = 0;
+                  goto label__string_loop_outer__continue;
+                }
+                v_string_length += 4;
+              }
+              label__1__break:;
+              v_c = wuffs_base__peek_u8be__no_bounds_check(iop_a_src);
+              v_char = WUFFS_JSON__LUT_CHARS[v_c];
+              if (v_char == 0) {
+                iop_a_src += 1;
+                if (v_string_length >= 65531) {
+                  *iop_a_dst++ = wuffs_base__make_token(
+                      (((uint64_t)(4194819)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                      (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                      (((uint64_t)(65532)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                  v_string_length = 0;
+                  goto label__string_loop_outer__continue;
+                }
+                v_string_length += 1;
+                goto label__string_loop_inner__continue;
+              } else if (v_char == 1) {
+                if (v_string_length != 0) {
+                  *iop_a_dst++ = wuffs_base__make_token(
+                      (((uint64_t)(4194819)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                      (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                      (((uint64_t)(v_string_length)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                  v_string_length = 0;
+                }
+                goto label__string_loop_outer__break;
+              } else if (v_char == 2) {
+                if (v_string_length > 0) {
+                  *iop_a_dst++ = wuffs_base__make_token(
+                      (((uint64_t)(4194819)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                      (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                      (((uint64_t)(v_string_length)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                  v_string_length = 0;
+                  if (((uint64_t)(io2_a_dst - iop_a_dst)) <= 0) {
+                    goto label__string_loop_outer__continue;
+                  }
+                }
+                if (((uint64_t)(io2_a_src - iop_a_src)) < 2) {
+                  if (a_src && a_src->meta.closed) {
+                    status = wuffs_base__make_status(wuffs_json__error__bad_backslash_escape);
+                    goto exit;
+                  }
+                  status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+                  WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(6);
+                  v_string_length = 0;
+                  v_char = 0;
+                  goto label__string_loop_outer__continue;
+                }
+                v_c = ((uint8_t)((wuffs_base__peek_u16le__no_bounds_check(iop_a_src) >> 8)));
+                v_backslash = WUFFS_JSON__LUT_BACKSLASHES[v_c];
+                if ((v_backslash & 128) != 0) {
+                  iop_a_src += 2;
+                  *iop_a_dst++ = wuffs_base__make_token(
+                      (((uint64_t)((6291456 | ((uint32_t)((v_backslash & 127)))))) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                      (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                      (((uint64_t)(2)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                  goto label__string_loop_outer__continue;
+                } else if (v_backslash != 0) {
+                  if (self->private_impl.f_quirks[WUFFS_JSON__LUT_QUIRKY_BACKSLASHES_QUIRKS[(v_backslash & 7)]]) {
+                    iop_a_src += 2;
+                    *iop_a_dst++ = wuffs_base__make_token(
+                        (((uint64_t)((6291456 | ((uint32_t)(WUFFS_JSON__LUT_QUIRKY_BACKSLASHES_CHARS[(v_backslash & 7)]))))) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                        (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                        (((uint64_t)(2)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                    goto label__string_loop_outer__continue;
+                  }
+                } else if (v_c == 117) {
+                  if (((uint64_t)(io2_a_src - iop_a_src)) < 6) {
+                    if (a_src && a_src->meta.closed) {
+                      status = wuffs_base__make_status(wuffs_json__error__bad_backslash_escape);
+                      goto exit;
+                    }
+                    status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+                    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(7);
+                    v_string_length = 0;
+                    v_char = 0;
+                    goto label__string_loop_outer__continue;
+                  }
+                  v_uni4_string = (((uint64_t)(wuffs_base__peek_u48le__no_bounds_check(iop_a_src))) >> 16);
+                  v_uni4_value = 0;
+                  v_uni4_ok = 128;
+                  v_c = WUFFS_JSON__LUT_HEXADECIMAL_DIGITS[(255 & (v_uni4_string >> 0))];
+                  v_uni4_ok &= v_c;
+                  v_uni4_value |= (((uint32_t)((v_c & 15))) << 12);
+                  v_c = WUFFS_JSON__LUT_HEXADECIMAL_DIGITS[(255 & (v_uni4_string >> 8))];
+                  v_uni4_ok &= v_c;
+                  v_uni4_value |= (((uint32_t)((v_c & 15))) << 8);
+                  v_c = WUFFS_JSON__LUT_HEXADECIMAL_DIGITS[(255 & (v_uni4_string >> 16))];
+                  v_uni4_ok &= v_c;
+                  v_uni4_value |= (((uint32_t)((v_c & 15))) << 4);
+                  v_c = WUFFS_JSON__LUT_HEXADECIMAL_DIGITS[(255 & (v_uni4_string >> 24))];
+                  v_uni4_ok &= v_c;
+                  v_uni4_value |= (((uint32_t)((v_c & 15))) << 0);
+                  if (v_uni4_ok == 0) {
+                  } else if ((v_uni4_value < 55296) || (57343 < v_uni4_value)) {
+                    iop_a_src += 6;
+                    *iop_a_dst++ = wuffs_base__make_token(
+                        (((uint64_t)((6291456 | v_uni4_value))) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                        (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                        (((uint64_t)(6)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                    goto label__string_loop_outer__continue;
+                  } else if (v_uni4_value >= 56320) {
+                  } else {
+                    if (((uint64_t)(io2_a_src - iop_a_src)) < 12) {
+                      if (a_src && a_src->meta.closed) {
+                        if (self->private_impl.f_quirks[20]) {
+                          iop_a_src += 6;
+                          *iop_a_dst++ = wuffs_base__make_token(
+                              (((uint64_t)(6356989)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                              (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                              (((uint64_t)(6)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                          goto label__string_loop_outer__continue;
+                        }
+                        status = wuffs_base__make_status(wuffs_json__error__bad_backslash_escape);
+                        goto exit;
+                      }
+                      status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+                      WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(8);
+                      v_string_length = 0;
+                      v_uni4_value = 0;
+                      v_char = 0;
+                      goto label__string_loop_outer__continue;
+                    }
+                    v_uni4_string = (wuffs_base__peek_u64le__no_bounds_check(iop_a_src + 4) >> 16);
+                    if (((255 & (v_uni4_string >> 0)) != 92) || ((255 & (v_uni4_string >> 8)) != 117)) {
+                      v_uni4_high_surrogate = 0;
+                      v_uni4_value = 0;
+                      v_uni4_ok = 0;
+                    } else {
+                      v_uni4_high_surrogate = (65536 + ((v_uni4_value - 55296) << 10));
+                      v_uni4_value = 0;
+                      v_uni4_ok = 128;
+                      v_uni4_string >>= 16;
+                      v_c = WUFFS_JSON__LUT_HEXADECIMAL_DIGITS[(255 & (v_uni4_string >> 0))];
+                      v_uni4_ok &= v_c;
+                      v_uni4_value |= (((uint32_t)((v_c & 15))) << 12);
+                      v_c = WUFFS_JSON__LUT_HEXADECIMAL_DIGITS[(255 & (v_uni4_string >> 8))];
+                      v_uni4_ok &= v_c;
+                      v_uni4_value |= (((uint32_t)((v_c & 15))) << 8);
+                      v_c = WUFFS_JSON__LUT_HEXADECIMAL_DIGITS[(255 & (v_uni4_string >> 16))];
+                      v_uni4_ok &= v_c;
+                      v_uni4_value |= (((uint32_t)((v_c & 15))) << 4);
+                      v_c = WUFFS_JSON__LUT_HEXADECIMAL_DIGITS[(255 & (v_uni4_string >> 24))];
+                      v_uni4_ok &= v_c;
+                      v_uni4_value |= (((uint32_t)((v_c & 15))) << 0);
+                    }
+                    if ((v_uni4_ok != 0) && (56320 <= v_uni4_value) && (v_uni4_value <= 57343)) {
+                      v_uni4_value -= 56320;
+                      iop_a_src += 12;
+                      *iop_a_dst++ = wuffs_base__make_token(
+                          (((uint64_t)((6291456 | v_uni4_high_surrogate | v_uni4_value))) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                          (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                          (((uint64_t)(12)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                      goto label__string_loop_outer__continue;
+                    }
+                  }
+                  if (self->private_impl.f_quirks[20]) {
+                    if (((uint64_t)(io2_a_src - iop_a_src)) < 6) {
+                      status = wuffs_base__make_status(wuffs_json__error__internal_error_inconsistent_i_o);
+                      goto exit;
+                    }
+                    iop_a_src += 6;
+                    *iop_a_dst++ = wuffs_base__make_token(
+                        (((uint64_t)(6356989)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                        (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                        (((uint64_t)(6)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                    goto label__string_loop_outer__continue;
+                  }
+                } else if ((v_c == 85) && self->private_impl.f_quirks[2]) {
+                  if (((uint64_t)(io2_a_src - iop_a_src)) < 10) {
+                    if (a_src && a_src->meta.closed) {
+                      status = wuffs_base__make_status(wuffs_json__error__bad_backslash_escape);
+                      goto exit;
+                    }
+                    status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+                    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(9);
+                    v_string_length = 0;
+                    v_char = 0;
+                    goto label__string_loop_outer__continue;
+                  }
+                  v_uni8_string = wuffs_base__peek_u64le__no_bounds_check(iop_a_src + 2);
+                  v_uni8_value = 0;
+                  v_uni8_ok = 128;
+                  v_c = WUFFS_JSON__LUT_HEXADECIMAL_DIGITS[(255 & (v_uni8_string >> 0))];
+                  v_uni8_ok &= v_c;
+                  v_uni8_value |= (((uint32_t)((v_c & 15))) << 28);
+                  v_c = WUFFS_JSON__LUT_HEXADECIMAL_DIGITS[(255 & (v_uni8_string >> 8))];
+                  v_uni8_ok &= v_c;
+                  v_uni8_value |= (((uint32_t)((v_c & 15))) << 24);
+                  v_c = WUFFS_JSON__LUT_HEXADECIMAL_DIGITS[(255 & (v_uni8_string >> 16))];
+                  v_uni8_ok &= v_c;
+                  v_uni8_value |= (((uint32_t)((v_c & 15))) << 20);
+                  v_c = WUFFS_JSON__LUT_HEXADECIMAL_DIGITS[(255 & (v_uni8_string >> 24))];
+                  v_uni8_ok &= v_c;
+                  v_uni8_value |= (((uint32_t)((v_c & 15))) << 16);
+                  v_c = WUFFS_JSON__LUT_HEXADECIMAL_DIGITS[(255 & (v_uni8_string >> 32))];
+                  v_uni8_ok &= v_c;
+                  v_uni8_value |= (((uint32_t)((v_c & 15))) << 12);
+                  v_c = WUFFS_JSON__LUT_HEXADECIMAL_DIGITS[(255 & (v_uni8_string >> 40))];
+                  v_uni8_ok &= v_c;
+                  v_uni8_value |= (((uint32_t)((v_c & 15))) << 8);
+                  v_c = WUFFS_JSON__LUT_HEXADECIMAL_DIGITS[(255 & (v_uni8_string >> 48))];
+                  v_uni8_ok &= v_c;
+                  v_uni8_value |= (((uint32_t)((v_c & 15))) << 4);
+                  v_c = WUFFS_JSON__LUT_HEXADECIMAL_DIGITS[(255 & (v_uni8_string >> 56))];
+                  v_uni8_ok &= v_c;
+                  v_uni8_value |= (((uint32_t)((v_c & 15))) << 0);
+                  if (v_uni8_ok == 0) {
+                  } else if ((v_uni8_value < 55296) || ((57343 < v_uni8_value) && (v_uni8_value <= 1114111))) {
+                    iop_a_src += 10;
+                    *iop_a_dst++ = wuffs_base__make_token(
+                        (((uint64_t)((6291456 | (v_uni8_value & 2097151)))) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                        (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                        (((uint64_t)(10)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                    goto label__string_loop_outer__continue;
+                  } else if (self->private_impl.f_quirks[20]) {
+                    iop_a_src += 10;
+                    *iop_a_dst++ = wuffs_base__make_token(
+                        (((uint64_t)(6356989)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                        (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                        (((uint64_t)(10)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                    goto label__string_loop_outer__continue;
+                  }
+                } else if ((v_c == 120) && self->private_impl.f_quirks[9]) {
+                  if (((uint64_t)(io2_a_src - iop_a_src)) < 4) {
+                    if (a_src && a_src->meta.closed) {
+                      status = wuffs_base__make_status(wuffs_json__error__bad_backslash_escape);
+                      goto exit;
+                    }
+                    status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+                    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(10);
+                    v_string_length = 0;
+                    v_char = 0;
+                    goto label__string_loop_outer__continue;
+                  }
+                  v_backslash_x_string = wuffs_base__peek_u32le__no_bounds_check(iop_a_src);
+                  v_backslash_x_ok = 128;
+                  v_c = WUFFS_JSON__LUT_HEXADECIMAL_DIGITS[(255 & (v_backslash_x_string >> 16))];
+                  v_backslash_x_ok &= v_c;
+                  v_backslash_x_value = ((uint8_t)(((v_c & 15) << 4)));
+                  v_c = WUFFS_JSON__LUT_HEXADECIMAL_DIGITS[(255 & (v_backslash_x_string >> 24))];
+                  v_backslash_x_ok &= v_c;
+                  v_backslash_x_value = ((uint8_t)((v_backslash_x_value | (v_c & 15))));
+                  if ((v_backslash_x_ok == 0) || ((v_backslash_x_string & 65535) != 30812)) {
+                    status = wuffs_base__make_status(wuffs_json__error__bad_backslash_escape);
+                    goto exit;
+                  }
+                  iop_a_src += 4;
+                  *iop_a_dst++ = wuffs_base__make_token(
+                      (((uint64_t)((6291456 | ((uint32_t)(v_backslash_x_value))))) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                      (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                      (((uint64_t)(4)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                  goto label__string_loop_outer__continue;
+                }
+                status = wuffs_base__make_status(wuffs_json__error__bad_backslash_escape);
+                goto exit;
+              } else if (v_char == 3) {
+                if (((uint64_t)(io2_a_src - iop_a_src)) < 2) {
+                  if (v_string_length > 0) {
+                    *iop_a_dst++ = wuffs_base__make_token(
+                        (((uint64_t)(4194819)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                        (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                        (((uint64_t)(v_string_length)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                    v_string_length = 0;
+                    if (((uint64_t)(io2_a_dst - iop_a_dst)) <= 0) {
+                      goto label__string_loop_outer__continue;
+                    }
+                  }
+                  if (a_src && a_src->meta.closed) {
+                    if (self->private_impl.f_quirks[20]) {
+                      *iop_a_dst++ = wuffs_base__make_token(
+                          (((uint64_t)(6356989)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                          (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                          (((uint64_t)(1)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                      iop_a_src += 1;
+                      goto label__string_loop_outer__continue;
+                    }
+                    status = wuffs_base__make_status(wuffs_json__error__bad_utf_8);
+                    goto exit;
+                  }
+                  status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+                  WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(11);
+                  v_string_length = 0;
+                  v_char = 0;
+                  goto label__string_loop_outer__continue;
+                }
+                v_multi_byte_utf8 = ((uint32_t)(wuffs_base__peek_u16le__no_bounds_check(iop_a_src)));
+                if ((v_multi_byte_utf8 & 49152) == 32768) {
+                  v_multi_byte_utf8 = ((1984 & ((uint32_t)(v_multi_byte_utf8 << 6))) | (63 & (v_multi_byte_utf8 >> 8)));
+                  iop_a_src += 2;
+                  if (v_string_length >= 65528) {
+                    *iop_a_dst++ = wuffs_base__make_token(
+                        (((uint64_t)(4194819)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                        (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                        (((uint64_t)((v_string_length + 2))) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                    v_string_length = 0;
+                    goto label__string_loop_outer__continue;
+                  }
+                  v_string_length += 2;
+                  goto label__string_loop_inner__continue;
+                }
+              } else if (v_char == 4) {
+                if (((uint64_t)(io2_a_src - iop_a_src)) < 3) {
+                  if (v_string_length > 0) {
+                    *iop_a_dst++ = wuffs_base__make_token(
+                        (((uint64_t)(4194819)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                        (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                        (((uint64_t)(v_string_length)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                    v_string_length = 0;
+                    if (((uint64_t)(io2_a_dst - iop_a_dst)) <= 0) {
+                      goto label__string_loop_outer__continue;
+                    }
+                  }
+                  if (a_src && a_src->meta.closed) {
+                    if (self->private_impl.f_quirks[20]) {
+                      *iop_a_dst++ = wuffs_base__make_token(
+                          (((uint64_t)(6356989)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                          (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                          (((uint64_t)(1)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                      iop_a_src += 1;
+                      goto label__string_loop_outer__continue;
+                    }
+                    status = wuffs_base__make_status(wuffs_json__error__bad_utf_8);
+                    goto exit;
+                  }
+                  status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+                  WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(12);
+                  v_string_length = 0;
+                  v_char = 0;
+                  goto label__string_loop_outer__continue;
+                }
+                v_multi_byte_utf8 = ((uint32_t)(wuffs_base__peek_u24le__no_bounds_check(iop_a_src)));
+                if ((v_multi_byte_utf8 & 12632064) == 8421376) {
+                  v_multi_byte_utf8 = ((61440 & ((uint32_t)(v_multi_byte_utf8 << 12))) | (4032 & (v_multi_byte_utf8 >> 2)) | (63 & (v_multi_byte_utf8 >> 16)));
+                  if ((2047 < v_multi_byte_utf8) && ((v_multi_byte_utf8 < 55296) || (57343 < v_multi_byte_utf8))) {
+                    iop_a_src += 3;
+                    if (v_string_length >= 65528) {
+                      *iop_a_dst++ = wuffs_base__make_token(
+                          (((uint64_t)(4194819)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                          (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                          (((uint64_t)((v_string_length + 3))) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                      v_string_length = 0;
+                      goto label__string_loop_outer__continue;
+                    }
+                    v_string_length += 3;
+                    goto label__string_loop_inner__continue;
+                  }
+                }
+              } else if (v_char == 5) {
+                if (((uint64_t)(io2_a_src - iop_a_src)) < 4) {
+                  if (v_string_length > 0) {
+                    *iop_a_dst++ = wuffs_base__make_token(
+                        (((uint64_t)(4194819)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                        (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                        (((uint64_t)(v_string_length)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                    v_string_length = 0;
+                    if (((uint64_t)(io2_a_dst - iop_a_dst)) <= 0) {
+                      goto label__string_loop_outer__continue;
+                    }
+                  }
+                  if (a_src && a_src->meta.closed) {
+                    if (self->private_impl.f_quirks[20]) {
+                      *iop_a_dst++ = wuffs_base__make_token(
+                          (((uint64_t)(6356989)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                          (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                          (((uint64_t)(1)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                      iop_a_src += 1;
+                      goto label__string_loop_outer__continue;
+                    }
+                    status = wuffs_base__make_status(wuffs_json__error__bad_utf_8);
+                    goto exit;
+                  }
+                  status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+                  WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(13);
+                  v_string_length = 0;
+                  v_char = 0;
+                  goto label__string_loop_outer__continue;
+                }
+                v_multi_byte_utf8 = wuffs_base__peek_u32le__no_bounds_check(iop_a_src);
+                if ((v_multi_byte_utf8 & 3233857536) == 2155905024) {
+                  v_multi_byte_utf8 = ((1835008 & ((uint32_t)(v_multi_byte_utf8 << 18))) |
+                      (258048 & ((uint32_t)(v_multi_byte_utf8 << 4))) |
+                      (4032 & (v_multi_byte_utf8 >> 10)) |
+                      (63 & (v_multi_byte_utf8 >> 24)));
+                  if ((65535 < v_multi_byte_utf8) && (v_multi_byte_utf8 <= 1114111)) {
+                    iop_a_src += 4;
+                    if (v_string_length >= 65528) {
+                      *iop_a_dst++ = wuffs_base__make_token(
+                          (((uint64_t)(4194819)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                          (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                          (((uint64_t)((v_string_length + 4))) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                      v_string_length = 0;
+                      goto label__string_loop_outer__continue;
+                    }
+                    v_string_length += 4;
+                    goto label__string_loop_inner__continue;
+                  }
+                }
+              }
+              if (v_string_length > 0) {
+                *iop_a_dst++ = wuffs_base__make_token(
+                    (((uint64_t)(4194819)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                    (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                    (((uint64_t)(v_string_length)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                v_string_length = 0;
+                if (((uint64_t)(io2_a_dst - iop_a_dst)) <= 0) {
+                  goto label__string_loop_outer__continue;
+                }
+              }
+              if ((v_char & 128) != 0) {
+                if (self->private_impl.f_quirks[0]) {
+                  *iop_a_dst++ = wuffs_base__make_token(
+                      (((uint64_t)((6291456 | ((uint32_t)((v_char & 127)))))) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                      (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                      (((uint64_t)(1)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                  iop_a_src += 1;
+                  goto label__string_loop_outer__continue;
+                }
+                if (v_char == 138) {
+                  status = wuffs_base__make_status(wuffs_json__error__bad_new_line_in_a_string);
+                  goto exit;
+                }
+                status = wuffs_base__make_status(wuffs_json__error__bad_c0_control_code);
+                goto exit;
+              }
+              if (self->private_impl.f_quirks[20]) {
+                *iop_a_dst++ = wuffs_base__make_token(
+                    (((uint64_t)(6356989)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                    (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                    (((uint64_t)(1)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                iop_a_src += 1;
+                goto label__string_loop_outer__continue;
+              }
+              status = wuffs_base__make_status(wuffs_json__error__bad_utf_8);
+              goto exit;
+            }
+          }
+          label__string_loop_outer__break:;
+          label__2__continue:;
+          while (true) {
+            if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+              if (a_src && a_src->meta.closed) {
+                status = wuffs_base__make_status(wuffs_json__error__bad_input);
+                goto exit;
+              }
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(14);
+              goto label__2__continue;
+            }
+            if (((uint64_t)(io2_a_dst - iop_a_dst)) <= 0) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+              WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(15);
+              goto label__2__continue;
+            }
+            iop_a_src += 1;
+            *iop_a_dst++ = wuffs_base__make_token(
+                (((uint64_t)(4194579)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                (((uint64_t)(1)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+            goto label__2__break;
+          }
+          label__2__break:;
+          if (0 == (v_expect & (((uint32_t)(1)) << 4))) {
+            v_expect = 4104;
+            goto label__outer__continue;
+          }
+          goto label__goto_parsed_a_leaf_value__break;
+        } else if (v_class == 2) {
+          iop_a_src += 1;
+          *iop_a_dst++ = wuffs_base__make_token(
+              (((uint64_t)(1)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+              (((uint64_t)(1)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+          if (0 == (v_expect & (((uint32_t)(1)) << 8))) {
+            if (self->private_impl.f_quirks[13]) {
+              v_expect = 4162;
+            } else {
+              v_expect = 4098;
+            }
+          } else {
+            if (self->private_impl.f_quirks[13]) {
+              v_expect = 8114;
+            } else {
+              v_expect = 7858;
+            }
+          }
+          goto label__outer__continue;
+        } else if (v_class == 3) {
+          iop_a_src += 1;
+          *iop_a_dst++ = wuffs_base__make_token(
+              (((uint64_t)(1)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+              (((uint64_t)(1)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+          v_expect = 7858;
+          goto label__outer__continue;
+        } else if (v_class == 4) {
+          while (true) {
+            if (a_src) {
+              a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+            }
+            v_number_length = wuffs_json__decoder__decode_number(self, a_src);
+            if (a_src) {
+              iop_a_src = a_src->data.ptr + a_src->meta.ri;
+            }
+            v_number_status = (v_number_length >> 8);
+            v_vminor = 10486787;
+            if ((v_number_length & 128) != 0) {
+              v_vminor = 10486785;
+            }
+            v_number_length = (v_number_length & 127);
+            if (v_number_status == 0) {
+              *iop_a_dst++ = wuffs_base__make_token(
+                  (((uint64_t)(v_vminor)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                  (((uint64_t)(v_number_length)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+              goto label__3__break;
+            }
+            while (v_number_length > 0) {
+              v_number_length -= 1;
+              if (iop_a_src > io1_a_src) {
+                iop_a_src--;
+              } else {
+                status = wuffs_base__make_status(wuffs_json__error__internal_error_inconsistent_i_o);
+                goto exit;
+              }
+            }
+            if (v_number_status == 1) {
+              if (self->private_impl.f_quirks[14]) {
+                if (a_dst) {
+                  a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+                }
+                if (a_src) {
+                  a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+                }
+                WUFFS_BASE__COROUTINE_SUSPENSION_POINT(16);
+                status = wuffs_json__decoder__decode_inf_nan(self, a_dst, a_src);
+                if (a_dst) {
+                  iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+                }
+                if (a_src) {
+                  iop_a_src = a_src->data.ptr + a_src->meta.ri;
+                }
+                if (status.repr) {
+                  goto suspend;
+                }
+                goto label__3__break;
+              }
+              status = wuffs_base__make_status(wuffs_json__error__bad_input);
+              goto exit;
+            } else if (v_number_status == 2) {
+              status = wuffs_base__make_status(wuffs_json__error__unsupported_number_length);
+              goto exit;
+            } else {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(17);
+              while (((uint64_t)(io2_a_dst - iop_a_dst)) <= 0) {
+                status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+                WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(18);
+              }
+            }
+          }
+          label__3__break:;
+          goto label__goto_parsed_a_leaf_value__break;
+        } else if (v_class == 5) {
+          v_vminor = 2113553;
+          if (v_depth == 0) {
+          } else if (0 != (v_expect_after_value & (((uint32_t)(1)) << 6))) {
+            v_vminor = 2113601;
+          } else {
+            v_vminor = 2113569;
+          }
+          if (v_depth >= 1024) {
+            status = wuffs_base__make_status(wuffs_json__error__unsupported_recursion_depth);
+            goto exit;
+          }
+          v_stack_byte = (v_depth / 32);
+          v_stack_bit = (v_depth & 31);
+          self->private_data.f_stack[v_stack_byte] |= (((uint32_t)(1)) << v_stack_bit);
+          v_depth += 1;
+          iop_a_src += 1;
+          *iop_a_dst++ = wuffs_base__make_token(
+              (((uint64_t)(v_vminor)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+              (((uint64_t)(1)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+          v_expect = 4162;
+          v_expect_after_value = 4164;
+          goto label__outer__continue;
+        } else if (v_class == 6) {
+          iop_a_src += 1;
+          if (v_depth <= 1) {
+            *iop_a_dst++ = wuffs_base__make_token(
+                (((uint64_t)(2101314)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                (((uint64_t)(1)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+            goto label__outer__break;
+          }
+          v_depth -= 1;
+          v_stack_byte = ((v_depth - 1) / 32);
+          v_stack_bit = ((v_depth - 1) & 31);
+          if (0 == (self->private_data.f_stack[v_stack_byte] & (((uint32_t)(1)) << v_stack_bit))) {
+            *iop_a_dst++ = wuffs_base__make_token(
+                (((uint64_t)(2105410)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                (((uint64_t)(1)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+            v_expect = 4356;
+            v_expect_after_value = 4356;
+          } else {
+            *iop_a_dst++ = wuffs_base__make_token(
+                (((uint64_t)(2113602)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                (((uint64_t)(1)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+            v_expect = 4164;
+            v_expect_after_value = 4164;
+          }
+          goto label__outer__continue;
+        } else if (v_class == 7) {
+          v_vminor = 2105361;
+          if (v_depth == 0) {
+          } else if (0 != (v_expect_after_value & (((uint32_t)(1)) << 6))) {
+            v_vminor = 2105409;
+          } else {
+            v_vminor = 2105377;
+          }
+          if (v_depth >= 1024) {
+            status = wuffs_base__make_status(wuffs_json__error__unsupported_recursion_depth);
+            goto exit;
+          }
+          v_stack_byte = (v_depth / 32);
+          v_stack_bit = (v_depth & 31);
+          self->private_data.f_stack[v_stack_byte] &= (4294967295 ^ (((uint32_t)(1)) << v_stack_bit));
+          v_depth += 1;
+          iop_a_src += 1;
+          *iop_a_dst++ = wuffs_base__make_token(
+              (((uint64_t)(v_vminor)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+              (((uint64_t)(1)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+          v_expect = 8114;
+          v_expect_after_value = 4356;
+          goto label__outer__continue;
+        } else if (v_class == 8) {
+          iop_a_src += 1;
+          if (v_depth <= 1) {
+            *iop_a_dst++ = wuffs_base__make_token(
+                (((uint64_t)(2101282)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                (((uint64_t)(1)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+            goto label__outer__break;
+          }
+          v_depth -= 1;
+          v_stack_byte = ((v_depth - 1) / 32);
+          v_stack_bit = ((v_depth - 1) & 31);
+          if (0 == (self->private_data.f_stack[v_stack_byte] & (((uint32_t)(1)) << v_stack_bit))) {
+            *iop_a_dst++ = wuffs_base__make_token(
+                (((uint64_t)(2105378)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                (((uint64_t)(1)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+            v_expect = 4356;
+            v_expect_after_value = 4356;
+          } else {
+            *iop_a_dst++ = wuffs_base__make_token(
+                (((uint64_t)(2113570)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                (((uint64_t)(1)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+            v_expect = 4164;
+            v_expect_after_value = 4164;
+          }
+          goto label__outer__continue;
+        } else if (v_class == 9) {
+          v_match = wuffs_base__io_reader__match7(iop_a_src, io2_a_src, a_src,111546413966853);
+          if (v_match == 0) {
+            *iop_a_dst++ = wuffs_base__make_token(
+                (((uint64_t)(8388612)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                (((uint64_t)(5)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+            if (((uint64_t)(io2_a_src - iop_a_src)) < 5) {
+              status = wuffs_base__make_status(wuffs_json__error__internal_error_inconsistent_i_o);
+              goto exit;
+            }
+            iop_a_src += 5;
+            goto label__goto_parsed_a_leaf_value__break;
+          } else if (v_match == 1) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(19);
+            goto label__outer__continue;
+          }
+        } else if (v_class == 10) {
+          v_match = wuffs_base__io_reader__match7(iop_a_src, io2_a_src, a_src,435762131972);
+          if (v_match == 0) {
+            *iop_a_dst++ = wuffs_base__make_token(
+                (((uint64_t)(8388616)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                (((uint64_t)(4)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+            if (((uint64_t)(io2_a_src - iop_a_src)) < 4) {
+              status = wuffs_base__make_status(wuffs_json__error__internal_error_inconsistent_i_o);
+              goto exit;
+            }
+            iop_a_src += 4;
+            goto label__goto_parsed_a_leaf_value__break;
+          } else if (v_match == 1) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(20);
+            goto label__outer__continue;
+          }
+        } else if (v_class == 11) {
+          v_match = wuffs_base__io_reader__match7(iop_a_src, io2_a_src, a_src,465676103172);
+          if (v_match == 0) {
+            *iop_a_dst++ = wuffs_base__make_token(
+                (((uint64_t)(8388610)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                (((uint64_t)(4)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+            if (((uint64_t)(io2_a_src - iop_a_src)) < 4) {
+              status = wuffs_base__make_status(wuffs_json__error__internal_error_inconsistent_i_o);
+              goto exit;
+            }
+            iop_a_src += 4;
+            goto label__goto_parsed_a_leaf_value__break;
+          } else if (v_match == 1) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(21);
+            goto label__outer__continue;
+          }
+          if (self->private_impl.f_quirks[14]) {
+            if (a_dst) {
+              a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+            }
+            if (a_src) {
+              a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+            }
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(22);
+            status = wuffs_json__decoder__decode_inf_nan(self, a_dst, a_src);
+            if (a_dst) {
+              iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+            }
+            if (a_src) {
+              iop_a_src = a_src->data.ptr + a_src->meta.ri;
+            }
+            if (status.repr) {
+              goto suspend;
+            }
+            goto label__goto_parsed_a_leaf_value__break;
+          }
+        } else if (v_class == 12) {
+          if (self->private_impl.f_quirks[11] || self->private_impl.f_quirks[12]) {
+            if (a_dst) {
+              a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+            }
+            if (a_src) {
+              a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+            }
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(23);
+            status = wuffs_json__decoder__decode_comment(self, a_dst, a_src);
+            if (a_dst) {
+              iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+            }
+            if (a_src) {
+              iop_a_src = a_src->data.ptr + a_src->meta.ri;
+            }
+            if (status.repr) {
+              goto suspend;
+            }
+            if (self->private_impl.f_comment_type > 0) {
+              goto label__outer__continue;
+            }
+          }
+        }
+        status = wuffs_base__make_status(wuffs_json__error__bad_input);
+        goto exit;
+      }
+      label__goto_parsed_a_leaf_value__break:;
+      if (v_depth == 0) {
+        goto label__outer__break;
+      }
+      v_expect = v_expect_after_value;
+    }
+    label__outer__break:;
+    if (self->private_impl.f_quirks[17] || self->private_impl.f_quirks[18]) {
+      if (a_dst) {
+        a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+      }
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(24);
+      status = wuffs_json__decoder__decode_trailer(self, a_dst, a_src);
+      if (a_dst) {
+        iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+      }
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+    }
+    self->private_impl.f_end_of_data = true;
+
+    ok:
+    self->private_impl.p_decode_tokens[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_tokens[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine = wuffs_base__status__is_suspension(&status) ? 1 : 0;
+  WUFFS_BASE__STATS__ADD(self->private_impl, WUFFS_BASE__STATS__SUSPENSIONS,
+      wuffs_base__status__is_suspension(&status) ? 1u : 0u);
+  self->private_data.s_decode_tokens[0].v_depth = v_depth;
+  self->private_data.s_decode_tokens[0].v_expect = v_expect;
+  self->private_data.s_decode_tokens[0].v_expect_after_value = v_expect_after_value;
+
+  goto exit;
+  exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func json.decoder.decode_number
+
+static uint32_t
+wuffs_json__decoder__decode_number(
+    wuffs_json__decoder* self,
+    wuffs_base__io_buffer* a_src) {
+  uint8_t v_c = 0;
+  uint32_t v_n = 0;
+  uint32_t v_floating_point = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  while (true) {
+    v_n = 0;
+    if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+      if ( ! (a_src && a_src->meta.closed)) {
+        v_n |= 768;
+      }
+      goto label__goto_done__break;
+    }
+    v_c = wuffs_base__peek_u8be__no_bounds_check(iop_a_src);
+    if (v_c != 45) {
+    } else {
+      v_n += 1;
+      iop_a_src += 1;
+      if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+        if ( ! (a_src && a_src->meta.closed)) {
+          v_n |= 768;
+        }
+        v_n |= 256;
+        goto label__goto_done__break;
+      }
+      v_c = wuffs_base__peek_u8be__no_bounds_check(iop_a_src);
+    }
+    if (v_c == 48) {
+      v_n += 1;
+      iop_a_src += 1;
+    } else {
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      v_n = wuffs_json__decoder__decode_digits(self, a_src, v_n);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if (v_n > 99) {
+        goto label__goto_done__break;
+      }
+    }
+    if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+      if ( ! (a_src && a_src->meta.closed)) {
+        v_n |= 768;
+      }
+      goto label__goto_done__break;
+    }
+    v_c = wuffs_base__peek_u8be__no_bounds_check(iop_a_src);
+    if (v_c != 46) {
+    } else {
+      if (v_n >= 99) {
+        v_n |= 512;
+        goto label__goto_done__break;
+      }
+      v_n += 1;
+      iop_a_src += 1;
+      v_floating_point = 128;
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      v_n = wuffs_json__decoder__decode_digits(self, a_src, v_n);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if (v_n > 99) {
+        goto label__goto_done__break;
+      }
+      if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+        if ( ! (a_src && a_src->meta.closed)) {
+          v_n |= 768;
+        }
+        goto label__goto_done__break;
+      }
+      v_c = wuffs_base__peek_u8be__no_bounds_check(iop_a_src);
+    }
+    if ((v_c != 69) && (v_c != 101)) {
+      goto label__goto_done__break;
+    }
+    if (v_n >= 99) {
+      v_n |= 512;
+      goto label__goto_done__break;
+    }
+    v_n += 1;
+    iop_a_src += 1;
+    v_floating_point = 128;
+    if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+      if ( ! (a_src && a_src->meta.closed)) {
+        v_n |= 768;
+      }
+      v_n |= 256;
+      goto label__goto_done__break;
+    }
+    v_c = wuffs_base__peek_u8be__no_bounds_check(iop_a_src);
+    if ((v_c != 43) && (v_c != 45)) {
+    } else {
+      if (v_n >= 99) {
+        v_n |= 512;
+        goto label__goto_done__break;
+      }
+      v_n += 1;
+      iop_a_src += 1;
+    }
+    if (a_src) {
+      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+    }
+    v_n = wuffs_json__decoder__decode_digits(self, a_src, v_n);
+    if (a_src) {
+      iop_a_src = a_src->data.ptr + a_src->meta.ri;
+    }
+    goto label__goto_done__break;
+  }
+  label__goto_done__break:;
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+  return (v_n | v_floating_point);
+}
+
+// -------- func json.decoder.decode_digits
+
+static uint32_t
+wuffs_json__decoder__decode_digits(
+    wuffs_json__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    uint32_t a_n) {
+  uint8_t v_c = 0;
+  uint32_t v_n = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  v_n = a_n;
+  while (true) {
+    if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+      if ( ! (a_src && a_src->meta.closed)) {
+        v_n |= 768;
+      }
+      goto label__0__break;
+    }
+    v_c = wuffs_base__peek_u8be__no_bounds_check(iop_a_src);
+    if (0 == WUFFS_JSON__LUT_DECIMAL_DIGITS[v_c]) {
+      goto label__0__break;
+    }
+    if (v_n >= 99) {
+      v_n |= 512;
+      goto label__0__break;
+    }
+    v_n += 1;
+    iop_a_src += 1;
+  }
+  label__0__break:;
+  if (v_n == a_n) {
+    v_n |= 256;
+  }
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+  return v_n;
+}
+
+// -------- func json.decoder.decode_leading
+
+static wuffs_base__status
+wuffs_json__decoder__decode_leading(
+    wuffs_json__decoder* self,
+    wuffs_base__token_buffer* a_dst,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t v_c = 0;
+  uint32_t v_u = 0;
+
+  wuffs_base__token* iop_a_dst = NULL;
+  wuffs_base__token* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  wuffs_base__token* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  wuffs_base__token* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_leading[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    self->private_impl.f_allow_leading_ars = self->private_impl.f_quirks[15];
+    self->private_impl.f_allow_leading_ubom = self->private_impl.f_quirks[16];
+    label__0__continue:;
+    while (self->private_impl.f_allow_leading_ars || self->private_impl.f_allow_leading_ubom) {
+      if (((uint64_t)(io2_a_dst - iop_a_dst)) <= 0) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
+        goto label__0__continue;
+      }
+      if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+        if (a_src && a_src->meta.closed) {
+          goto label__0__break;
+        }
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(2);
+        goto label__0__continue;
+      }
+      v_c = wuffs_base__peek_u8be__no_bounds_check(iop_a_src);
+      if ((v_c == 30) && self->private_impl.f_allow_leading_ars) {
+        self->private_impl.f_allow_leading_ars = false;
+        iop_a_src += 1;
+        *iop_a_dst++ = wuffs_base__make_token(
+            (((uint64_t)(0)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+            (((uint64_t)(1)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+        goto label__0__continue;
+      } else if ((v_c == 239) && self->private_impl.f_allow_leading_ubom) {
+        if (((uint64_t)(io2_a_src - iop_a_src)) < 3) {
+          if (a_src && a_src->meta.closed) {
+            goto label__0__break;
+          }
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(3);
+          goto label__0__continue;
+        }
+        v_u = ((uint32_t)(wuffs_base__peek_u24le__no_bounds_check(iop_a_src)));
+        if (v_u == 12565487) {
+          self->private_impl.f_allow_leading_ubom = false;
+          iop_a_src += 3;
+          *iop_a_dst++ = wuffs_base__make_token(
+              (((uint64_t)(0)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+              (((uint64_t)(3)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+          goto label__0__continue;
+        }
+      }
+      goto label__0__break;
+    }
+    label__0__break:;
+
+    ok:
+    self->private_impl.p_decode_leading[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_leading[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+  exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func json.decoder.decode_comment
+
+static wuffs_base__status
+wuffs_json__decoder__decode_comment(
+    wuffs_json__decoder* self,
+    wuffs_base__token_buffer* a_dst,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t v_c = 0;
+  uint16_t v_c2 = 0;
+  uint32_t v_length = 0;
+
+  wuffs_base__token* iop_a_dst = NULL;
+  wuffs_base__token* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  wuffs_base__token* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  wuffs_base__token* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_comment[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    self->private_impl.f_comment_type = 0;
+    label__0__continue:;
+    while ((((uint64_t)(io2_a_dst - iop_a_dst)) <= 0) || (((uint64_t)(io2_a_src - iop_a_src)) <= 1)) {
+      if (((uint64_t)(io2_a_dst - iop_a_dst)) <= 0) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
+        goto label__0__continue;
+      }
+      if (a_src && a_src->meta.closed) {
+        status = wuffs_base__make_status(NULL);
+        goto ok;
+      }
+      status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(2);
+    }
+    v_c2 = wuffs_base__peek_u16le__no_bounds_check(iop_a_src);
+    if ((v_c2 == 10799) && self->private_impl.f_quirks[11]) {
+      iop_a_src += 2;
+      v_length = 2;
+      label__comment_block__continue:;
+      while (true) {
+        if (((uint64_t)(io2_a_dst - iop_a_dst)) <= 0) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(3);
+          v_length = 0;
+          goto label__comment_block__continue;
+        }
+        while (true) {
+          if (((uint64_t)(io2_a_src - iop_a_src)) <= 1) {
+            if (v_length > 0) {
+              *iop_a_dst++ = wuffs_base__make_token(
+                  (((uint64_t)(2)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                  (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                  (((uint64_t)(v_length)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+            }
+            if (a_src && a_src->meta.closed) {
+              status = wuffs_base__make_status(wuffs_json__error__bad_input);
+              goto exit;
+            }
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(4);
+            v_length = 0;
+            goto label__comment_block__continue;
+          }
+          v_c2 = wuffs_base__peek_u16le__no_bounds_check(iop_a_src);
+          if (v_c2 == 12074) {
+            iop_a_src += 2;
+            *iop_a_dst++ = wuffs_base__make_token(
+                (((uint64_t)(2)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                (((uint64_t)((v_length + 2))) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+            self->private_impl.f_comment_type = 1;
+            status = wuffs_base__make_status(NULL);
+            goto ok;
+          }
+          iop_a_src += 1;
+          if (v_length >= 65533) {
+            *iop_a_dst++ = wuffs_base__make_token(
+                (((uint64_t)(2)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                (((uint64_t)((v_length + 1))) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+            v_length = 0;
+            goto label__comment_block__continue;
+          }
+          v_length += 1;
+        }
+      }
+    } else if ((v_c2 == 12079) && self->private_impl.f_quirks[12]) {
+      iop_a_src += 2;
+      v_length = 2;
+      label__comment_line__continue:;
+      while (true) {
+        if (((uint64_t)(io2_a_dst - iop_a_dst)) <= 0) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(5);
+          v_length = 0;
+          goto label__comment_line__continue;
+        }
+        while (true) {
+          if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+            if (a_src && a_src->meta.closed) {
+              *iop_a_dst++ = wuffs_base__make_token(
+                  (((uint64_t)(4)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                  (((uint64_t)(v_length)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+              self->private_impl.f_comment_type = 2;
+              status = wuffs_base__make_status(NULL);
+              goto ok;
+            } else if (v_length > 0) {
+              *iop_a_dst++ = wuffs_base__make_token(
+                  (((uint64_t)(4)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                  (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                  (((uint64_t)(v_length)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+            }
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(6);
+            v_length = 0;
+            goto label__comment_line__continue;
+          }
+          v_c = wuffs_base__peek_u8be__no_bounds_check(iop_a_src);
+          if (v_c == 10) {
+            *iop_a_dst++ = wuffs_base__make_token(
+                (((uint64_t)(4)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                (((uint64_t)(v_length)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+            self->private_impl.f_comment_type = 2;
+            status = wuffs_base__make_status(NULL);
+            goto ok;
+          }
+          iop_a_src += 1;
+          if (v_length >= 65533) {
+            *iop_a_dst++ = wuffs_base__make_token(
+                (((uint64_t)(4)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                (((uint64_t)((v_length + 1))) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+            v_length = 0;
+            goto label__comment_line__continue;
+          }
+          v_length += 1;
+        }
+      }
+    }
+
+    ok:
+    self->private_impl.p_decode_comment[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_comment[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+  exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func json.decoder.decode_inf_nan
+
+static wuffs_base__status
+wuffs_json__decoder__decode_inf_nan(
+    wuffs_json__decoder* self,
+    wuffs_base__token_buffer* a_dst,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_c4 = 0;
+  uint32_t v_neg = 0;
+
+  wuffs_base__token* iop_a_dst = NULL;
+  wuffs_base__token* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  wuffs_base__token* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  wuffs_base__token* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_inf_nan[0];
+  if (coro_susp_point) {
+    v_neg = self->private_data.s_decode_inf_nan[0].v_neg;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    label__0__continue:;
+    while (true) {
+      if (((uint64_t)(io2_a_dst - iop_a_dst)) <= 0) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
+        goto label__0__continue;
+      }
+      if (((uint64_t)(io2_a_src - iop_a_src)) <= 2) {
+        if (a_src && a_src->meta.closed) {
+          status = wuffs_base__make_status(wuffs_json__error__bad_input);
+          goto exit;
+        }
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(2);
+        goto label__0__continue;
+      }
+      v_c4 = ((uint32_t)(wuffs_base__peek_u24le__no_bounds_check(iop_a_src)));
+      if ((v_c4 | 2105376) == 6712937) {
+        if (((uint64_t)(io2_a_src - iop_a_src)) > 7) {
+          if ((wuffs_base__peek_u64le__no_bounds_check(iop_a_src) | 2314885530818453536) == 8751735898823356009) {
+            *iop_a_dst++ = wuffs_base__make_token(
+                (((uint64_t)(10485792)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                (((uint64_t)(8)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+            iop_a_src += 8;
+            status = wuffs_base__make_status(NULL);
+            goto ok;
+          }
+        } else if ( ! (a_src && a_src->meta.closed)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(3);
+          goto label__0__continue;
+        }
+        *iop_a_dst++ = wuffs_base__make_token(
+            (((uint64_t)(10485792)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+            (((uint64_t)(3)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+        iop_a_src += 3;
+        status = wuffs_base__make_status(NULL);
+        goto ok;
+      } else if ((v_c4 | 2105376) == 7233902) {
+        *iop_a_dst++ = wuffs_base__make_token(
+            (((uint64_t)(10485888)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+            (((uint64_t)(3)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+        iop_a_src += 3;
+        status = wuffs_base__make_status(NULL);
+        goto ok;
+      } else if ((v_c4 & 255) == 43) {
+        v_neg = 0;
+      } else if ((v_c4 & 255) == 45) {
+        v_neg = 1;
+      } else {
+        status = wuffs_base__make_status(wuffs_json__error__bad_input);
+        goto exit;
+      }
+      if (((uint64_t)(io2_a_src - iop_a_src)) <= 3) {
+        if (a_src && a_src->meta.closed) {
+          status = wuffs_base__make_status(wuffs_json__error__bad_input);
+          goto exit;
+        }
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(4);
+        goto label__0__continue;
+      }
+      v_c4 = (wuffs_base__peek_u32le__no_bounds_check(iop_a_src) >> 8);
+      if ((v_c4 | 2105376) == 6712937) {
+        if (((uint64_t)(io2_a_src - iop_a_src)) > 8) {
+          if ((wuffs_base__peek_u64le__no_bounds_check(iop_a_src + 1) | 2314885530818453536) == 8751735898823356009) {
+            *iop_a_dst++ = wuffs_base__make_token(
+                (((uint64_t)((10485760 | (((uint32_t)(32)) >> v_neg)))) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                (((uint64_t)(9)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+            iop_a_src += 9;
+            status = wuffs_base__make_status(NULL);
+            goto ok;
+          }
+        } else if ( ! (a_src && a_src->meta.closed)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(5);
+          goto label__0__continue;
+        }
+        *iop_a_dst++ = wuffs_base__make_token(
+            (((uint64_t)((10485760 | (((uint32_t)(32)) >> v_neg)))) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+            (((uint64_t)(4)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+        iop_a_src += 4;
+        status = wuffs_base__make_status(NULL);
+        goto ok;
+      } else if ((v_c4 | 2105376) == 7233902) {
+        *iop_a_dst++ = wuffs_base__make_token(
+            (((uint64_t)((10485760 | (((uint32_t)(128)) >> v_neg)))) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+            (((uint64_t)(4)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+        iop_a_src += 4;
+        status = wuffs_base__make_status(NULL);
+        goto ok;
+      }
+      status = wuffs_base__make_status(wuffs_json__error__bad_input);
+      goto exit;
+    }
+
+    ok:
+    self->private_impl.p_decode_inf_nan[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_inf_nan[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_decode_inf_nan[0].v_neg = v_neg;
+
+  goto exit;
+  exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func json.decoder.decode_trailer
+
+static wuffs_base__status
+wuffs_json__decoder__decode_trailer(
+    wuffs_json__decoder* self,
+    wuffs_base__token_buffer* a_dst,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t v_c = 0;
+  uint32_t v_whitespace_length = 0;
+
+  wuffs_base__token* iop_a_dst = NULL;
+  wuffs_base__token* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  wuffs_base__token* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  wuffs_base__token* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_trailer[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_quirks[18]) {
+      self->private_impl.f_trailer_stop = 10;
+    } else {
+      self->private_impl.f_trailer_stop = 0;
+    }
+    label__outer__continue:;
+    while (true) {
+      if (((uint64_t)(io2_a_dst - iop_a_dst)) <= 0) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
+        v_whitespace_length = 0;
+        goto label__outer__continue;
+      }
+      while (true) {
+        if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+          if (v_whitespace_length > 0) {
+            *iop_a_dst++ = wuffs_base__make_token(
+                (((uint64_t)(0)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                (((uint64_t)(v_whitespace_length)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+            v_whitespace_length = 0;
+          }
+          if (a_src && a_src->meta.closed) {
+            goto label__outer__break;
+          }
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(2);
+          v_whitespace_length = 0;
+          goto label__outer__continue;
+        }
+        v_c = wuffs_base__peek_u8be__no_bounds_check(iop_a_src);
+        if (WUFFS_JSON__LUT_CLASSES[v_c] != 0) {
+          if (v_whitespace_length > 0) {
+            *iop_a_dst++ = wuffs_base__make_token(
+                (((uint64_t)(0)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                (((uint64_t)(v_whitespace_length)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+            v_whitespace_length = 0;
+          }
+          if (self->private_impl.f_trailer_stop > 0) {
+            status = wuffs_base__make_status(wuffs_json__error__bad_input);
+            goto exit;
+          }
+          if (a_dst) {
+            a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+          }
+          if (a_src) {
+            a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+          }
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+          status = wuffs_json__decoder__decode_comment(self, a_dst, a_src);
+          if (a_dst) {
+            iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+          }
+          if (a_src) {
+            iop_a_src = a_src->data.ptr + a_src->meta.ri;
+          }
+          if (status.repr) {
+            goto suspend;
+          }
+          v_c = 0;
+          v_whitespace_length = 0;
+          if (self->private_impl.f_comment_type > 0) {
+            goto label__outer__continue;
+          }
+          status = wuffs_base__make_status(NULL);
+          goto ok;
+        }
+        iop_a_src += 1;
+        if ((v_whitespace_length >= 65534) || (v_c == self->private_impl.f_trailer_stop)) {
+          *iop_a_dst++ = wuffs_base__make_token(
+              (((uint64_t)(0)) << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+              (((uint64_t)((v_whitespace_length + 1))) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+          v_whitespace_length = 0;
+          if (v_c == self->private_impl.f_trailer_stop) {
+            status = wuffs_base__make_status(NULL);
+            goto ok;
+          }
+          goto label__outer__continue;
+        }
+        v_whitespace_length += 1;
+      }
+    }
+    label__outer__break:;
+
+    ok:
+    self->private_impl.p_decode_trailer[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_trailer[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+  exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func json.decoder.choose_skip_functions
+
+static wuffs_base__empty_struct
+wuffs_json__decoder__choose_skip_functions(
+    wuffs_json__decoder* self) {
+  self->private_impl.f_have_chosen = true;
+  self->private_impl.choosy_skip_plain_string_bytes = (
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+      wuffs_base__cpu_arch__have_x86_sse42() ? &wuffs_json__decoder__skip_plain_string_bytes_x86_sse42 :
+#endif
+      self->private_impl.choosy_skip_plain_string_bytes);
+  self->private_impl.choosy_skip_whitespace = (
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+      wuffs_base__cpu_arch__have_x86_sse42() ? &wuffs_json__decoder__skip_whitespace_x86_sse42 :
+#endif
+      self->private_impl.choosy_skip_whitespace);
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func json.decoder.skip_plain_string_bytes
+
+static uint32_t
+wuffs_json__decoder__skip_plain_string_bytes(
+    wuffs_json__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    uint32_t a_up_to) {
+  return (*self->private_impl.choosy_skip_plain_string_bytes)(self, a_src, a_up_to);
+}
+
+static uint32_t
+wuffs_json__decoder__skip_plain_string_bytes__choosy_default(
+    wuffs_json__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    uint32_t a_up_to) {
+  uint32_t v_n = 0;
+  uint64_t v_x = 0;
+  uint64_t v_y = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  while ((a_up_to >= 8) && (((uint64_t)(io2_a_src - iop_a_src)) >= 8)) {
+    v_x = wuffs_base__peek_u64le__no_bounds_check(iop_a_src);
+    v_y = (((uint64_t)(v_x - 2314885530818453536)) |
+        ((uint64_t)((v_x ^ 2459565876494606882) - 72340172838076673)) |
+        ((uint64_t)((v_x ^ 6655295901103053916) - 72340172838076673)) |
+        v_x);
+    if ((v_y & 9259542123273814144u) != 0) {
+      goto label__0__break;
+    }
+    iop_a_src += 8;
+    a_up_to -= 8;
+    v_n += 8;
+  }
+  label__0__break:;
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+  return v_n;
+}
+
+// -------- func json.decoder.skip_whitespace
+
+static uint32_t
+wuffs_json__decoder__skip_whitespace(
+    wuffs_json__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    uint32_t a_up_to) {
+  return (*self->private_impl.choosy_skip_whitespace)(self, a_src, a_up_to);
+}
+
+static uint32_t
+wuffs_json__decoder__skip_whitespace__choosy_default(
+    wuffs_json__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    uint32_t a_up_to) {
+  uint32_t v_n = 0;
+  uint64_t v_x = 0;
+  uint64_t v_y = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  while ((a_up_to >= 8) && (((uint64_t)(io2_a_src - iop_a_src)) >= 8)) {
+    v_x = wuffs_base__peek_u64le__no_bounds_check(iop_a_src);
+    v_y = (wuffs_json__decoder__zero_bytes(self, (v_x ^ 2314885530818453536)) |
+        wuffs_json__decoder__zero_bytes(self, (v_x ^ 651061555542690057)) |
+        wuffs_json__decoder__zero_bytes(self, (v_x ^ 723401728380766730)) |
+        wuffs_json__decoder__zero_bytes(self, (v_x ^ 940422246894996749)));
+    if (v_y != 9259542123273814144u) {
+      goto label__0__break;
+    }
+    iop_a_src += 8;
+    a_up_to -= 8;
+    v_n += 8;
+  }
+  label__0__break:;
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+  return v_n;
+}
+
+// -------- func json.decoder.zero_bytes
+
+static uint64_t
+wuffs_json__decoder__zero_bytes(
+    const wuffs_json__decoder* self,
+    uint64_t a_x) {
+  uint64_t v_y = 0;
+
+  v_y = ((a_x & 9187201950435737471) + 9187201950435737471);
+  return (9259542123273814144u & (18446744073709551615u ^ (v_y | a_x)));
+}
+
+// ‼ WUFFS MULTI-FILE SECTION +x86_sse42
+// -------- func json.decoder.skip_plain_string_bytes_x86_sse42
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+static uint32_t
+wuffs_json__decoder__skip_plain_string_bytes_x86_sse42(
+    wuffs_json__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    uint32_t a_up_to) {
+  uint32_t v_n = 0;
+  __m128i v_x = {0};
+  __m128i v_k_20 = {0};
+  __m128i v_k_22 = {0};
+  __m128i v_k_5c = {0};
+  __m128i v_ignore = {0};
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  v_k_20 = _mm_set1_epi8((int8_t)(32));
+  v_k_22 = _mm_set1_epi8((int8_t)(34));
+  v_k_5c = _mm_set1_epi8((int8_t)(92));
+  while ((a_up_to >= 16) && (((uint64_t)(io2_a_src - iop_a_src)) >= 16)) {
+    v_x = _mm_set_epi64x((int64_t)(wuffs_base__peek_u64le__no_bounds_check(iop_a_src + 8)), (int64_t)(wuffs_base__peek_u64le__no_bounds_check(iop_a_src)));
+    v_ignore = _mm_or_si128(_mm_cmplt_epi8(v_x, v_k_20), _mm_or_si128(_mm_cmpeq_epi8(v_x, v_k_22), _mm_cmpeq_epi8(v_x, v_k_5c)));
+    if (((uint32_t)(_mm_movemask_epi8(v_ignore))) != 0) {
+      goto label__0__break;
+    }
+    iop_a_src += 16;
+    a_up_to -= 16;
+    v_n += 16;
+  }
+  label__0__break:;
+  if ((a_up_to >= 8) && (((uint64_t)(io2_a_src - iop_a_src)) >= 8)) {
+    v_x = _mm_cvtsi64x_si128((int64_t)(wuffs_base__peek_u64le__no_bounds_check(iop_a_src)));
+    v_ignore = _mm_or_si128(_mm_cmplt_epi8(v_x, v_k_20), _mm_or_si128(_mm_cmpeq_epi8(v_x, v_k_22), _mm_cmpeq_epi8(v_x, v_k_5c)));
+    if ((((uint32_t)(_mm_movemask_epi8(v_ignore))) & 255) == 0) {
+      iop_a_src += 8;
+      v_n += 8;
+    }
+  }
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+  return v_n;
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// ‼ WUFFS MULTI-FILE SECTION -x86_sse42
+
+// ‼ WUFFS MULTI-FILE SECTION +x86_sse42
+// -------- func json.decoder.skip_whitespace_x86_sse42
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+static uint32_t
+wuffs_json__decoder__skip_whitespace_x86_sse42(
+    wuffs_json__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    uint32_t a_up_to) {
+  uint32_t v_n = 0;
+  __m128i v_x = {0};
+  __m128i v_k_09 = {0};
+  __m128i v_k_0a = {0};
+  __m128i v_k_0d = {0};
+  __m128i v_k_20 = {0};
+  __m128i v_ws = {0};
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  v_k_09 = _mm_set1_epi8((int8_t)(9));
+  v_k_0a = _mm_set1_epi8((int8_t)(10));
+  v_k_0d = _mm_set1_epi8((int8_t)(13));
+  v_k_20 = _mm_set1_epi8((int8_t)(32));
+  while ((a_up_to >= 16) && (((uint64_t)(io2_a_src - iop_a_src)) >= 16)) {
+    v_x = _mm_set_epi64x((int64_t)(wuffs_base__peek_u64le__no_bounds_check(iop_a_src + 8)), (int64_t)(wuffs_base__peek_u64le__no_bounds_check(iop_a_src)));
+    v_ws = _mm_or_si128(_mm_cmpeq_epi8(v_x, v_k_20), _mm_or_si128(_mm_cmpeq_epi8(v_x, v_k_0a), _mm_or_si128(_mm_cmpeq_epi8(v_x, v_k_09), _mm_cmpeq_epi8(v_x, v_k_0d))));
+    if (((uint32_t)(_mm_movemask_epi8(v_ws))) != 65535) {
+      goto label__0__break;
+    }
+    iop_a_src += 16;
+    a_up_to -= 16;
+    v_n += 16;
+  }
+  label__0__break:;
+  if ((a_up_to >= 8) && (((uint64_t)(io2_a_src - iop_a_src)) >= 8)) {
+    v_x = _mm_cvtsi64x_si128((int64_t)(wuffs_base__peek_u64le__no_bounds_check(iop_a_src)));
+    v_ws = _mm_or_si128(_mm_cmpeq_epi8(v_x, v_k_20), _mm_or_si128(_mm_cmpeq_epi8(v_x, v_k_0a), _mm_or_si128(_mm_cmpeq_epi8(v_x, v_k_09), _mm_cmpeq_epi8(v_x, v_k_0d))));
+    if ((((uint32_t)(_mm_movemask_epi8(v_ws))) & 255) == 255) {
+      iop_a_src += 8;
+      v_n += 8;
+    }
+  }
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+  return v_n;
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// ‼ WUFFS MULTI-FILE SECTION -x86_sse42
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__JSON)
+
+
+#endif  // WUFFS_IMPLEMENTATION
+
+// ¡ WUFFS MONOLITHIC RELEASE DISCARDS EVERYTHING BELOW.
+
+#endif  // WUFFS_INCLUDE_GUARD__JSON
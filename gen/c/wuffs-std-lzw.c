@@ -0,0 +1,862 @@
+#ifndef WUFFS_INCLUDE_GUARD__LZW
+#define WUFFS_INCLUDE_GUARD__LZW
+
+#if defined(WUFFS_IMPLEMENTATION) && !defined(WUFFS_CONFIG__MODULES)
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__LZW
+#endif
+
+#include "./wuffs-base.c"
+
+// ¡ WUFFS MONOLITHIC RELEASE DISCARDS EVERYTHING ABOVE.
+
+
+// ---------------- Status Codes
+
+extern const char wuffs_lzw__error__bad_code[];
+
+// ---------------- Public Consts
+
+#define WUFFS_LZW__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE 0
+
+#define WUFFS_LZW__QUIRK_MSB_FIRST 1348378624
+
+#define WUFFS_LZW__QUIRK_EARLY_CHANGE 1348378625
+
+// ---------------- Struct Declarations
+
+typedef struct wuffs_lzw__decoder__struct wuffs_lzw__decoder;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ---------------- Public Initializer Prototypes
+
+// For any given "wuffs_foo__bar* self", "wuffs_foo__bar__initialize(self,
+// etc)" should be called before any other "wuffs_foo__bar__xxx(self, etc)".
+//
+// Pass sizeof(*self) and WUFFS_VERSION for sizeof_star_self and wuffs_version.
+// Pass 0 (or some combination of WUFFS_INITIALIZE__XXX) for options.
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+wuffs_lzw__decoder__initialize(
+    wuffs_lzw__decoder* self,
+    size_t sizeof_star_self,
+    uint64_t wuffs_version,
+    uint32_t options);
+
+wuffs_base__stats
+wuffs_lzw__decoder__stats(
+    const wuffs_lzw__decoder* self);
+
+size_t
+sizeof__wuffs_lzw__decoder();
+
+// ---------------- Allocs
+
+// These functions allocate and initialize Wuffs structs. They return NULL if
+// memory allocation fails. If they return non-NULL, there is no need to call
+// wuffs_foo__bar__initialize, but the caller is responsible for eventually
+// calling free on the returned pointer. That pointer is effectively a C++
+// std::unique_ptr<T, decltype(&free)>.
+
+wuffs_lzw__decoder*
+wuffs_lzw__decoder__alloc();
+
+static inline wuffs_base__io_transformer*
+wuffs_lzw__decoder__alloc_as__wuffs_base__io_transformer() {
+  return (wuffs_base__io_transformer*)(wuffs_lzw__decoder__alloc());
+}
+
+// ---------------- Upcasts
+
+static inline wuffs_base__io_transformer*
+wuffs_lzw__decoder__upcast_as__wuffs_base__io_transformer(
+    wuffs_lzw__decoder* p) {
+  return (wuffs_base__io_transformer*)p;
+}
+
+// ---------------- Public Function Prototypes
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_lzw__decoder__set_quirk_enabled(
+    wuffs_lzw__decoder* self,
+    uint32_t a_quirk,
+    bool a_enabled);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_lzw__decoder__set_literal_width(
+    wuffs_lzw__decoder* self,
+    uint32_t a_lw);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64
+wuffs_lzw__decoder__workbuf_len(
+    const wuffs_lzw__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_lzw__decoder__transform_io(
+    wuffs_lzw__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__slice_u8
+wuffs_lzw__decoder__flush(
+    wuffs_lzw__decoder* self);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+// ---------------- Struct Definitions
+
+// These structs' fields, and the sizeof them, are private implementation
+// details that aren't guaranteed to be stable across Wuffs versions.
+//
+// See https://en.wikipedia.org/wiki/Opaque_pointer#C
+
+#if defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
+
+struct wuffs_lzw__decoder__struct {
+  // Do not access the private_impl's or private_data's fields directly. There
+  // is no API/ABI compatibility or safety guarantee if you do so. Instead, use
+  // the wuffs_foo__bar__baz functions.
+  //
+  // It is a struct, not a struct*, so that the outermost wuffs_foo__bar struct
+  // can be stack allocated when WUFFS_IMPLEMENTATION is defined.
+
+  struct {
+    uint32_t magic;
+    uint32_t active_coroutine;
+    wuffs_base__vtable vtable_for__wuffs_base__io_transformer;
+    wuffs_base__vtable null_vtable;
+#if defined(WUFFS_CONFIG__STATS)
+    wuffs_base__stats stats;
+#endif  // defined(WUFFS_CONFIG__STATS)
+
+    uint32_t f_set_literal_width_arg;
+    uint32_t f_literal_width;
+    uint32_t f_clear_code;
+    uint32_t f_end_code;
+    bool f_msb_first;
+    uint32_t f_early_change;
+    uint32_t f_save_code;
+    uint32_t f_prev_code;
+    uint32_t f_width;
+    uint64_t f_bits;
+    uint32_t f_n_bits;
+    uint32_t f_output_ri;
+    uint32_t f_output_wi;
+    uint32_t f_read_from_return_value;
+    uint16_t f_prefixes[4096];
+
+    uint32_t p_transform_io[1];
+    uint32_t p_write_to[1];
+  } private_impl;
+
+  struct {
+    uint8_t f_suffixes[4096][8];
+    uint16_t f_lm1s[4096];
+    uint8_t f_output[8199];
+  } private_data;
+
+#ifdef __cplusplus
+#if defined(WUFFS_BASE__HAVE_UNIQUE_PTR)
+  using unique_ptr = std::unique_ptr<wuffs_lzw__decoder, decltype(&free)>;
+
+  // On failure, the alloc_etc functions return nullptr. They don't throw.
+
+  static inline unique_ptr
+  alloc() {
+    return unique_ptr(wuffs_lzw__decoder__alloc(), &free);
+  }
+
+  static inline wuffs_base__io_transformer::unique_ptr
+  alloc_as__wuffs_base__io_transformer() {
+    return wuffs_base__io_transformer::unique_ptr(
+        wuffs_lzw__decoder__alloc_as__wuffs_base__io_transformer(), &free);
+  }
+#endif  // defined(WUFFS_BASE__HAVE_UNIQUE_PTR)
+
+#if defined(WUFFS_BASE__HAVE_EQ_DELETE) && !defined(WUFFS_IMPLEMENTATION)
+  // Disallow constructing or copying an object via standard C++ mechanisms,
+  // e.g. the "new" operator, as this struct is intentionally opaque. Its total
+  // size and field layout is not part of the public, stable, memory-safe API.
+  // Use malloc or memcpy and the sizeof__wuffs_foo__bar function instead, and
+  // call wuffs_foo__bar__baz methods (which all take a "this"-like pointer as
+  // their first argument) rather than tweaking bar.private_impl.qux fields.
+  //
+  // In C, we can just leave wuffs_foo__bar as an incomplete type (unless
+  // WUFFS_IMPLEMENTATION is #define'd). In C++, we define a complete type in
+  // order to provide convenience methods. These forward on "this", so that you
+  // can write "bar->baz(etc)" instead of "wuffs_foo__bar__baz(bar, etc)".
+  wuffs_lzw__decoder__struct() = delete;
+  wuffs_lzw__decoder__struct(const wuffs_lzw__decoder__struct&) = delete;
+  wuffs_lzw__decoder__struct& operator=(
+      const wuffs_lzw__decoder__struct&) = delete;
+#endif  // defined(WUFFS_BASE__HAVE_EQ_DELETE) && !defined(WUFFS_IMPLEMENTATION)
+
+#if !defined(WUFFS_IMPLEMENTATION)
+  // As above, the size of the struct is not part of the public API, and unless
+  // WUFFS_IMPLEMENTATION is #define'd, this struct type T should be heap
+  // allocated, not stack allocated. Its size is not intended to be known at
+  // compile time, but it is unfortunately divulged as a side effect of
+  // defining C++ convenience methods. Use "sizeof__T()", calling the function,
+  // instead of "sizeof T", invoking the operator. To make the two values
+  // different, so that passing the latter will be rejected by the initialize
+  // function, we add an arbitrary amount of dead weight.
+  uint8_t dead_weight[123000000];  // 123 MB.
+#endif  // !defined(WUFFS_IMPLEMENTATION)
+
+  inline wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+  initialize(
+      size_t sizeof_star_self,
+      uint64_t wuffs_version,
+      uint32_t options) {
+    return wuffs_lzw__decoder__initialize(
+        this, sizeof_star_self, wuffs_version, options);
+  }
+
+  inline wuffs_base__stats
+  stats() const {
+    return wuffs_lzw__decoder__stats(this);
+  }
+
+  inline wuffs_base__io_transformer*
+  upcast_as__wuffs_base__io_transformer() {
+    return (wuffs_base__io_transformer*)this;
+  }
+
+  inline wuffs_base__empty_struct
+  set_quirk_enabled(
+      uint32_t a_quirk,
+      bool a_enabled) {
+    return wuffs_lzw__decoder__set_quirk_enabled(this, a_quirk, a_enabled);
+  }
+
+  inline wuffs_base__empty_struct
+  set_literal_width(
+      uint32_t a_lw) {
+    return wuffs_lzw__decoder__set_literal_width(this, a_lw);
+  }
+
+  inline wuffs_base__range_ii_u64
+  workbuf_len() const {
+    return wuffs_lzw__decoder__workbuf_len(this);
+  }
+
+  inline wuffs_base__status
+  transform_io(
+      wuffs_base__io_buffer* a_dst,
+      wuffs_base__io_buffer* a_src,
+      wuffs_base__slice_u8 a_workbuf) {
+    return wuffs_lzw__decoder__transform_io(this, a_dst, a_src, a_workbuf);
+  }
+
+  inline wuffs_base__slice_u8
+  flush() {
+    return wuffs_lzw__decoder__flush(this);
+  }
+
+#endif  // __cplusplus
+};  // struct wuffs_lzw__decoder__struct
+
+#endif  // defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
+
+
+// ‼ WUFFS C HEADER ENDS HERE.
+#ifdef WUFFS_IMPLEMENTATION
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__LZW)
+
+// ---------------- Status Codes Implementations
+
+const char wuffs_lzw__error__bad_code[] = "#lzw: bad code";
+const char wuffs_lzw__error__internal_error_inconsistent_i_o[] = "#lzw: internal error: inconsistent I/O";
+
+// ---------------- Private Consts
+
+#define WUFFS_LZW__QUIRKS_BASE 1348378624
+
+// ---------------- Private Initializer Prototypes
+
+// ---------------- Private Function Prototypes
+
+static wuffs_base__empty_struct
+wuffs_lzw__decoder__read_from(
+    wuffs_lzw__decoder* self,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status
+wuffs_lzw__decoder__write_to(
+    wuffs_lzw__decoder* self,
+    wuffs_base__io_buffer* a_dst);
+
+// ---------------- VTables
+
+const wuffs_base__io_transformer__func_ptrs
+wuffs_lzw__decoder__func_ptrs_for__wuffs_base__io_transformer = {
+  (wuffs_base__empty_struct(*)(void*,
+      uint32_t,
+      bool))(&wuffs_lzw__decoder__set_quirk_enabled),
+  (wuffs_base__status(*)(void*,
+      wuffs_base__io_buffer*,
+      wuffs_base__io_buffer*,
+      wuffs_base__slice_u8))(&wuffs_lzw__decoder__transform_io),
+  (wuffs_base__range_ii_u64(*)(const void*))(&wuffs_lzw__decoder__workbuf_len),
+};
+
+// ---------------- Initializer Implementations
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+wuffs_lzw__decoder__initialize(
+    wuffs_lzw__decoder* self,
+    size_t sizeof_star_self,
+    uint64_t wuffs_version,
+    uint32_t options){
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  }
+
+  if ((options & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+    // The whole point of this if-check is to detect an uninitialized *self.
+    // We disable the warning on GCC. Clang-5.0 does not have this warning.
+    //
+    // The caller promises that *self is zeroed, so the empty asm tells GCC
+    // that private_impl is defined. Otherwise, once this function and a
+    // small method (e.g. one that reads a "choose" guard field) are both
+    // inlined into the caller, GCC -O3 warns about that method's read.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    __asm__ __volatile__("" : "+m"(self->private_impl));
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((options & WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      options |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    }
+  }
+
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.vtable_name =
+      wuffs_base__io_transformer__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.function_pointers =
+      (const void*)(&wuffs_lzw__decoder__func_ptrs_for__wuffs_base__io_transformer);
+  return wuffs_base__make_status(NULL);
+}
+
+wuffs_lzw__decoder*
+wuffs_lzw__decoder__alloc() {
+  wuffs_lzw__decoder* x =
+      (wuffs_lzw__decoder*)(calloc(sizeof(wuffs_lzw__decoder), 1));
+  if (!x) {
+    return NULL;
+  }
+  if (wuffs_lzw__decoder__initialize(
+      x, sizeof(wuffs_lzw__decoder), WUFFS_VERSION, WUFFS_INITIALIZE__ALREADY_ZEROED).repr) {
+    free(x);
+    return NULL;
+  }
+  return x;
+}
+
+size_t
+sizeof__wuffs_lzw__decoder() {
+  return sizeof(wuffs_lzw__decoder);
+}
+
+wuffs_base__stats
+wuffs_lzw__decoder__stats(
+    const wuffs_lzw__decoder* self) {
+  wuffs_base__stats ret = wuffs_base__make_empty_stats();
+#if defined(WUFFS_CONFIG__STATS)
+  if (!self) {
+    return ret;
+  }
+  ret = self->private_impl.stats;
+#else
+  (void)(self);
+#endif  // defined(WUFFS_CONFIG__STATS)
+  return ret;
+}
+
+// ---------------- Function Implementations
+
+// -------- func lzw.decoder.set_quirk_enabled
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_lzw__decoder__set_quirk_enabled(
+    wuffs_lzw__decoder* self,
+    uint32_t a_quirk,
+    bool a_enabled) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  if (a_quirk == 1348378624) {
+    self->private_impl.f_msb_first = a_enabled;
+  } else if (a_quirk == 1348378625) {
+    if (a_enabled) {
+      self->private_impl.f_early_change = 1;
+    } else {
+      self->private_impl.f_early_change = 0;
+    }
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func lzw.decoder.set_literal_width
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_lzw__decoder__set_literal_width(
+    wuffs_lzw__decoder* self,
+    uint32_t a_lw) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (a_lw > 8) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_set_literal_width_arg = (a_lw + 1);
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func lzw.decoder.workbuf_len
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64
+wuffs_lzw__decoder__workbuf_len(
+    const wuffs_lzw__decoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+
+  return wuffs_base__utility__make_range_ii_u64(0, 0);
+}
+
+// -------- func lzw.decoder.transform_io
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_lzw__decoder__transform_io(
+    wuffs_lzw__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+        ? wuffs_base__error__disabled_by_previous_error
+        : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst || !a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 1)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_i = 0;
+
+  uint32_t coro_susp_point = self->private_impl.p_transform_io[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    self->private_impl.f_literal_width = 8;
+    if (self->private_impl.f_set_literal_width_arg > 0) {
+      self->private_impl.f_literal_width = (self->private_impl.f_set_literal_width_arg - 1);
+    }
+    self->private_impl.f_clear_code = (((uint32_t)(1)) << self->private_impl.f_literal_width);
+    self->private_impl.f_end_code = (self->private_impl.f_clear_code + 1);
+    self->private_impl.f_save_code = self->private_impl.f_end_code;
+    self->private_impl.f_prev_code = self->private_impl.f_end_code;
+    self->private_impl.f_width = (self->private_impl.f_literal_width + 1);
+    self->private_impl.f_bits = 0;
+    self->private_impl.f_n_bits = 0;
+    self->private_impl.f_output_ri = 0;
+    self->private_impl.f_output_wi = 0;
+    v_i = 0;
+    while (v_i < self->private_impl.f_clear_code) {
+      self->private_data.f_lm1s[v_i] = 0;
+      self->private_data.f_suffixes[v_i][0] = ((uint8_t)(v_i));
+      v_i += 1;
+    }
+    label__0__continue:;
+    while (true) {
+      wuffs_lzw__decoder__read_from(self, a_src);
+      if (self->private_impl.f_output_wi > 0) {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        status = wuffs_lzw__decoder__write_to(self, a_dst);
+        if (status.repr) {
+          goto suspend;
+        }
+      }
+      if (self->private_impl.f_read_from_return_value == 0) {
+        goto label__0__break;
+      } else if (self->private_impl.f_read_from_return_value == 1) {
+        goto label__0__continue;
+      } else if (self->private_impl.f_read_from_return_value == 2) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(2);
+      } else if (self->private_impl.f_read_from_return_value == 3) {
+        status = wuffs_base__make_status(wuffs_lzw__error__bad_code);
+        goto exit;
+      } else {
+        status = wuffs_base__make_status(wuffs_lzw__error__internal_error_inconsistent_i_o);
+        goto exit;
+      }
+    }
+    label__0__break:;
+
+    ok:
+    self->private_impl.p_transform_io[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_transform_io[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine = wuffs_base__status__is_suspension(&status) ? 1 : 0;
+  WUFFS_BASE__STATS__ADD(self->private_impl, WUFFS_BASE__STATS__SUSPENSIONS,
+      wuffs_base__status__is_suspension(&status) ? 1u : 0u);
+
+  goto exit;
+  exit:
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func lzw.decoder.read_from
+
+static wuffs_base__empty_struct
+wuffs_lzw__decoder__read_from(
+    wuffs_lzw__decoder* self,
+    wuffs_base__io_buffer* a_src) {
+  uint32_t v_clear_code = 0;
+  uint32_t v_end_code = 0;
+  bool v_msb_first = false;
+  uint32_t v_early_change = 0;
+  uint32_t v_save_code = 0;
+  uint32_t v_prev_code = 0;
+  uint32_t v_width = 0;
+  uint64_t v_bits = 0;
+  uint32_t v_n_bits = 0;
+  uint32_t v_output_wi = 0;
+  uint32_t v_code = 0;
+  uint32_t v_c = 0;
+  uint32_t v_o = 0;
+  uint32_t v_steps = 0;
+  uint8_t v_first_byte = 0;
+  uint16_t v_lm1_b = 0;
+  uint16_t v_lm1_a = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  v_clear_code = self->private_impl.f_clear_code;
+  v_end_code = self->private_impl.f_end_code;
+  v_msb_first = self->private_impl.f_msb_first;
+  v_early_change = self->private_impl.f_early_change;
+  v_save_code = self->private_impl.f_save_code;
+  v_prev_code = self->private_impl.f_prev_code;
+  v_width = self->private_impl.f_width;
+  v_bits = self->private_impl.f_bits;
+  v_n_bits = self->private_impl.f_n_bits;
+  v_output_wi = self->private_impl.f_output_wi;
+  while (true) {
+    if (v_n_bits < v_width) {
+      if (((uint64_t)(io2_a_src - iop_a_src)) >= 8) {
+        if (v_msb_first) {
+          v_bits |= (wuffs_base__peek_u64be__no_bounds_check(iop_a_src) >> v_n_bits);
+        } else {
+          v_bits |= ((uint64_t)(wuffs_base__peek_u64le__no_bounds_check(iop_a_src) << v_n_bits));
+        }
+        iop_a_src += ((63 - v_n_bits) >> 3);
+        v_n_bits |= 56;
+      } else if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+        self->private_impl.f_read_from_return_value = 2;
+        goto label__0__break;
+      } else {
+        if (v_msb_first) {
+          v_bits |= ((uint64_t)(((uint64_t)(wuffs_base__peek_u8be__no_bounds_check(iop_a_src))) << (56 - v_n_bits)));
+        } else {
+          v_bits |= (((uint64_t)(wuffs_base__peek_u8be__no_bounds_check(iop_a_src))) << v_n_bits);
+        }
+        iop_a_src += 1;
+        v_n_bits += 8;
+        if (v_n_bits >= v_width) {
+        } else if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+          self->private_impl.f_read_from_return_value = 2;
+          goto label__0__break;
+        } else {
+          if (v_msb_first) {
+            v_bits |= ((uint64_t)(((uint64_t)(wuffs_base__peek_u8be__no_bounds_check(iop_a_src))) << (56 - v_n_bits)));
+          } else {
+            v_bits |= (((uint64_t)(wuffs_base__peek_u8be__no_bounds_check(iop_a_src))) << v_n_bits);
+          }
+          iop_a_src += 1;
+          v_n_bits += 8;
+          if (v_n_bits < v_width) {
+            self->private_impl.f_read_from_return_value = 4;
+            goto label__0__break;
+          }
+        }
+      }
+    }
+    if (v_msb_first) {
+      v_code = ((uint32_t)(((v_bits) >> (64 - (v_width)))));
+      v_bits <<= v_width;
+    } else {
+      v_code = ((uint32_t)(((v_bits) & WUFFS_BASE__LOW_BITS_MASK__U64(v_width))));
+      v_bits >>= v_width;
+    }
+    v_n_bits -= v_width;
+    if (v_code < v_clear_code) {
+      self->private_data.f_output[v_output_wi] = ((uint8_t)(v_code));
+      v_output_wi = ((v_output_wi + 1) & 8191);
+      if (v_save_code <= 4095) {
+        v_lm1_a = (((uint16_t)(self->private_data.f_lm1s[v_prev_code] + 1)) & 4095);
+        self->private_data.f_lm1s[v_save_code] = v_lm1_a;
+        if ((v_lm1_a % 8) != 0) {
+          self->private_impl.f_prefixes[v_save_code] = self->private_impl.f_prefixes[v_prev_code];
+          memcpy(self->private_data.f_suffixes[v_save_code],self->private_data.f_suffixes[v_prev_code], sizeof(self->private_data.f_suffixes[v_save_code]));
+          self->private_data.f_suffixes[v_save_code][(v_lm1_a % 8)] = ((uint8_t)(v_code));
+        } else {
+          self->private_impl.f_prefixes[v_save_code] = ((uint16_t)(v_prev_code));
+          self->private_data.f_suffixes[v_save_code][0] = ((uint8_t)(v_code));
+        }
+        v_save_code += 1;
+        if (v_width < 12) {
+          v_width += (1 & ((v_save_code + v_early_change) >> v_width));
+        }
+        v_prev_code = v_code;
+      }
+    } else if (v_code <= v_end_code) {
+      if (v_code == v_end_code) {
+        self->private_impl.f_read_from_return_value = 0;
+        goto label__0__break;
+      }
+      v_save_code = v_end_code;
+      v_prev_code = v_end_code;
+      v_width = (self->private_impl.f_literal_width + 1);
+    } else if (v_code <= v_save_code) {
+      v_c = v_code;
+      if (v_code == v_save_code) {
+        v_c = v_prev_code;
+      }
+      v_o = ((v_output_wi + (((uint32_t)(self->private_data.f_lm1s[v_c])) & 4294967288)) & 8191);
+      v_output_wi = ((v_output_wi + 1 + ((uint32_t)(self->private_data.f_lm1s[v_c]))) & 8191);
+      v_steps = (((uint32_t)(self->private_data.f_lm1s[v_c])) >> 3);
+      while (true) {
+        memcpy((self->private_data.f_output)+(v_o), (self->private_data.f_suffixes[v_c]), 8);
+        if (v_steps <= 0) {
+          goto label__1__break;
+        }
+        v_steps -= 1;
+        v_o = (((uint32_t)(v_o - 8)) & 8191);
+        v_c = ((uint32_t)(self->private_impl.f_prefixes[v_c]));
+      }
+      label__1__break:;
+      v_first_byte = self->private_data.f_suffixes[v_c][0];
+      if (v_code == v_save_code) {
+        self->private_data.f_output[v_output_wi] = v_first_byte;
+        v_output_wi = ((v_output_wi + 1) & 8191);
+      }
+      if (v_save_code <= 4095) {
+        v_lm1_b = (((uint16_t)(self->private_data.f_lm1s[v_prev_code] + 1)) & 4095);
+        self->private_data.f_lm1s[v_save_code] = v_lm1_b;
+        if ((v_lm1_b % 8) != 0) {
+          self->private_impl.f_prefixes[v_save_code] = self->private_impl.f_prefixes[v_prev_code];
+          memcpy(self->private_data.f_suffixes[v_save_code],self->private_data.f_suffixes[v_prev_code], sizeof(self->private_data.f_suffixes[v_save_code]));
+          self->private_data.f_suffixes[v_save_code][(v_lm1_b % 8)] = v_first_byte;
+        } else {
+          self->private_impl.f_prefixes[v_save_code] = ((uint16_t)(v_prev_code));
+          self->private_data.f_suffixes[v_save_code][0] = ((uint8_t)(v_first_byte));
+        }
+        v_save_code += 1;
+        if (v_width < 12) {
+          v_width += (1 & ((v_save_code + v_early_change) >> v_width));
+        }
+        v_prev_code = v_code;
+      }
+    } else {
+      self->private_impl.f_read_from_return_value = 3;
+      goto label__0__break;
+    }
+    if (v_output_wi > 4095) {
+      self->private_impl.f_read_from_return_value = 1;
+      goto label__0__break;
+    }
+  }
+  label__0__break:;
+  if (self->private_impl.f_read_from_return_value != 2) {
+    while (v_n_bits >= 8) {
+      v_n_bits -= 8;
+      if (iop_a_src > io1_a_src) {
+        iop_a_src--;
+      } else {
+        self->private_impl.f_read_from_return_value = 4;
+        goto label__2__break;
+      }
+    }
+    label__2__break:;
+  }
+  self->private_impl.f_save_code = v_save_code;
+  self->private_impl.f_prev_code = v_prev_code;
+  self->private_impl.f_width = v_width;
+  self->private_impl.f_bits = v_bits;
+  self->private_impl.f_n_bits = v_n_bits;
+  self->private_impl.f_output_wi = v_output_wi;
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func lzw.decoder.write_to
+
+static wuffs_base__status
+wuffs_lzw__decoder__write_to(
+    wuffs_lzw__decoder* self,
+    wuffs_base__io_buffer* a_dst) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  wuffs_base__slice_u8 v_s = {0};
+  uint64_t v_n = 0;
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_write_to[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    while (self->private_impl.f_output_wi > 0) {
+      if (self->private_impl.f_output_ri > self->private_impl.f_output_wi) {
+        status = wuffs_base__make_status(wuffs_lzw__error__internal_error_inconsistent_i_o);
+        goto exit;
+      }
+      v_s = wuffs_base__slice_u8__subslice_ij(wuffs_base__make_slice_u8(self->private_data.f_output,
+          8199),
+          self->private_impl.f_output_ri,
+          self->private_impl.f_output_wi);
+      v_n = wuffs_base__io_writer__copy_from_slice(&iop_a_dst, io2_a_dst,v_s);
+      if (v_n == ((uint64_t)(v_s.len))) {
+        self->private_impl.f_output_ri = 0;
+        self->private_impl.f_output_wi = 0;
+        status = wuffs_base__make_status(NULL);
+        goto ok;
+      }
+      self->private_impl.f_output_ri = (((uint32_t)(self->private_impl.f_output_ri + ((uint32_t)((v_n & 4294967295))))) & 8191);
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
+    }
+
+    ok:
+    self->private_impl.p_write_to[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_write_to[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+  exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func lzw.decoder.flush
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__slice_u8
+wuffs_lzw__decoder__flush(
+    wuffs_lzw__decoder* self) {
+  if (!self) {
+    return wuffs_base__make_slice_u8(NULL, 0);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_slice_u8(NULL, 0);
+  }
+
+  wuffs_base__slice_u8 v_s = {0};
+
+  if (self->private_impl.f_output_ri <= self->private_impl.f_output_wi) {
+    v_s = wuffs_base__slice_u8__subslice_ij(wuffs_base__make_slice_u8(self->private_data.f_output,
+        8199),
+        self->private_impl.f_output_ri,
+        self->private_impl.f_output_wi);
+  }
+  self->private_impl.f_output_ri = 0;
+  self->private_impl.f_output_wi = 0;
+  return v_s;
+}
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__LZW)
+
+
+#endif  // WUFFS_IMPLEMENTATION
+
+// ¡ WUFFS MONOLITHIC RELEASE DISCARDS EVERYTHING BELOW.
+
+#endif  // WUFFS_INCLUDE_GUARD__LZW
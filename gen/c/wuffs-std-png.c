@@ -0,0 +1,10544 @@
+#ifndef WUFFS_INCLUDE_GUARD__PNG
+#define WUFFS_INCLUDE_GUARD__PNG
+
+#if defined(WUFFS_IMPLEMENTATION) && !defined(WUFFS_CONFIG__MODULES)
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__PNG
+#endif
+
+#include "./wuffs-base.c"
+#include "./wuffs-std-adler32.c"
+#include "./wuffs-std-crc32.c"
+#include "./wuffs-std-deflate.c"
+#include "./wuffs-std-zlib.c"
+
+// ¡ WUFFS MONOLITHIC RELEASE DISCARDS EVERYTHING ABOVE.
+
+
+// ---------------- Status Codes
+
+extern const char wuffs_png__error__bad_animation_sequence_number[];
+extern const char wuffs_png__error__bad_checksum[];
+extern const char wuffs_png__error__bad_chunk[];
+extern const char wuffs_png__error__bad_filter[];
+extern const char wuffs_png__error__bad_header[];
+extern const char wuffs_png__error__bad_text_chunk_not_latin_1[];
+extern const char wuffs_png__error__missing_palette[];
+extern const char wuffs_png__error__unsupported_png_compression_method[];
+extern const char wuffs_png__error__unsupported_png_file[];
+extern const char wuffs_png__suspension__interlace_pass_complete[];
+
+// ---------------- Public Consts
+
+#define WUFFS_PNG__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE 0
+
+#define WUFFS_PNG__DECODER_SRC_IO_BUFFER_LENGTH_MIN_INCL 8
+
+#define WUFFS_PNG__DECODER_STATS_FILTER_NONE 8
+
+#define WUFFS_PNG__DECODER_STATS_FILTER_SUB 9
+
+#define WUFFS_PNG__DECODER_STATS_FILTER_UP 10
+
+#define WUFFS_PNG__DECODER_STATS_FILTER_AVERAGE 11
+
+#define WUFFS_PNG__DECODER_STATS_FILTER_PAETH 12
+
+#define WUFFS_PNG__QUIRK_REPORT_INTERLACE_PASSES 1554767872
+
+#define WUFFS_PNG__QUIRK_REPLICATE_INTERLACE_PASSES 1554767873
+
+#define WUFFS_PNG__ENCODER_FILTER_NONE 0
+
+#define WUFFS_PNG__ENCODER_FILTER_SUB 1
+
+#define WUFFS_PNG__ENCODER_FILTER_UP 2
+
+#define WUFFS_PNG__ENCODER_FILTER_AVERAGE 3
+
+#define WUFFS_PNG__ENCODER_FILTER_PAETH 4
+
+#define WUFFS_PNG__ENCODER_FILTER_ADAPTIVE 5
+
+// ---------------- Struct Declarations
+
+typedef struct wuffs_png__decoder__struct wuffs_png__decoder;
+
+typedef struct wuffs_png__encoder__struct wuffs_png__encoder;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ---------------- Public Initializer Prototypes
+
+// For any given "wuffs_foo__bar* self", "wuffs_foo__bar__initialize(self,
+// etc)" should be called before any other "wuffs_foo__bar__xxx(self, etc)".
+//
+// Pass sizeof(*self) and WUFFS_VERSION for sizeof_star_self and wuffs_version.
+// Pass 0 (or some combination of WUFFS_INITIALIZE__XXX) for options.
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+wuffs_png__decoder__initialize(
+    wuffs_png__decoder* self,
+    size_t sizeof_star_self,
+    uint64_t wuffs_version,
+    uint32_t options);
+
+wuffs_base__stats
+wuffs_png__decoder__stats(
+    const wuffs_png__decoder* self);
+
+size_t
+sizeof__wuffs_png__decoder();
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+wuffs_png__encoder__initialize(
+    wuffs_png__encoder* self,
+    size_t sizeof_star_self,
+    uint64_t wuffs_version,
+    uint32_t options);
+
+wuffs_base__stats
+wuffs_png__encoder__stats(
+    const wuffs_png__encoder* self);
+
+size_t
+sizeof__wuffs_png__encoder();
+
+// ---------------- Allocs
+
+// These functions allocate and initialize Wuffs structs. They return NULL if
+// memory allocation fails. If they return non-NULL, there is no need to call
+// wuffs_foo__bar__initialize, but the caller is responsible for eventually
+// calling free on the returned pointer. That pointer is effectively a C++
+// std::unique_ptr<T, decltype(&free)>.
+
+wuffs_png__decoder*
+wuffs_png__decoder__alloc();
+
+static inline wuffs_base__image_decoder*
+wuffs_png__decoder__alloc_as__wuffs_base__image_decoder() {
+  return (wuffs_base__image_decoder*)(wuffs_png__decoder__alloc());
+}
+
+wuffs_png__encoder*
+wuffs_png__encoder__alloc();
+
+// ---------------- Upcasts
+
+static inline wuffs_base__image_decoder*
+wuffs_png__decoder__upcast_as__wuffs_base__image_decoder(
+    wuffs_png__decoder* p) {
+  return (wuffs_base__image_decoder*)p;
+}
+
+// ---------------- Public Function Prototypes
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_png__decoder__set_quirk_enabled(
+    wuffs_png__decoder* self,
+    uint32_t a_quirk,
+    bool a_enabled);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_png__decoder__set_workbuf_prefilled(
+    wuffs_png__decoder* self,
+    bool a_prefilled);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_png__decoder__decode_image_config(
+    wuffs_png__decoder* self,
+    wuffs_base__image_config* a_dst,
+    wuffs_base__io_buffer* a_src);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_png__decoder__decode_frame_config(
+    wuffs_png__decoder* self,
+    wuffs_base__frame_config* a_dst,
+    wuffs_base__io_buffer* a_src);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_png__decoder__decode_frame(
+    wuffs_png__decoder* self,
+    wuffs_base__pixel_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__pixel_blend a_blend,
+    wuffs_base__slice_u8 a_workbuf,
+    wuffs_base__decode_frame_options* a_opts);
+
+WUFFS_BASE__MAYBE_STATIC bool
+wuffs_png__decoder__can_decode_row_bands(
+    const wuffs_png__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__rect_ie_u32
+wuffs_png__decoder__frame_dirty_rect(
+    const wuffs_png__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC uint32_t
+wuffs_png__decoder__interlace_preview_height(
+    const wuffs_png__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC uint32_t
+wuffs_png__decoder__interlace_preview_width(
+    const wuffs_png__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC uint32_t
+wuffs_png__decoder__num_animation_loops(
+    const wuffs_png__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC uint64_t
+wuffs_png__decoder__num_decoded_frame_configs(
+    const wuffs_png__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC uint32_t
+wuffs_png__decoder__num_completed_interlace_passes(
+    const wuffs_png__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC uint64_t
+wuffs_png__decoder__num_decoded_frames(
+    const wuffs_png__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_png__decoder__restart_frame(
+    wuffs_png__decoder* self,
+    uint64_t a_index,
+    uint64_t a_io_position);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_png__decoder__set_report_metadata(
+    wuffs_png__decoder* self,
+    uint32_t a_fourcc,
+    bool a_report);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_png__decoder__tell_me_more(
+    wuffs_png__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__more_information* a_minfo,
+    wuffs_base__io_buffer* a_src);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64
+wuffs_png__decoder__workbuf_len(
+    const wuffs_png__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_png__encoder__set_level(
+    wuffs_png__encoder* self,
+    uint32_t a_level);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_png__encoder__set_filter(
+    wuffs_png__encoder* self,
+    uint32_t a_filter);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_png__encoder__set_row_band(
+    wuffs_png__encoder* self,
+    uint32_t a_min_incl_y,
+    uint32_t a_max_excl_y);
+
+WUFFS_BASE__MAYBE_STATIC uint32_t
+wuffs_png__encoder__row_band_checksum(
+    const wuffs_png__encoder* self);
+
+WUFFS_BASE__MAYBE_STATIC uint64_t
+wuffs_png__encoder__row_band_length(
+    const wuffs_png__encoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_png__encoder__set_workbuf_prefilled(
+    wuffs_png__encoder* self,
+    bool a_prefilled);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64
+wuffs_png__encoder__workbuf_len(
+    const wuffs_png__encoder* self,
+    wuffs_base__pixel_format a_src_pixfmt,
+    uint32_t a_width);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_png__encoder__encode_image(
+    wuffs_png__encoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__pixel_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+// ---------------- Struct Definitions
+
+// These structs' fields, and the sizeof them, are private implementation
+// details that aren't guaranteed to be stable across Wuffs versions.
+//
+// See https://en.wikipedia.org/wiki/Opaque_pointer#C
+
+#if defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
+
+struct wuffs_png__decoder__struct {
+  // Do not access the private_impl's or private_data's fields directly. There
+  // is no API/ABI compatibility or safety guarantee if you do so. Instead, use
+  // the wuffs_foo__bar__baz functions.
+  //
+  // It is a struct, not a struct*, so that the outermost wuffs_foo__bar struct
+  // can be stack allocated when WUFFS_IMPLEMENTATION is defined.
+
+  struct {
+    uint32_t magic;
+    uint32_t active_coroutine;
+    wuffs_base__vtable vtable_for__wuffs_base__image_decoder;
+    wuffs_base__vtable null_vtable;
+#if defined(WUFFS_CONFIG__STATS)
+    wuffs_base__stats stats;
+#endif  // defined(WUFFS_CONFIG__STATS)
+
+    uint32_t f_width;
+    uint32_t f_height;
+    uint64_t f_pass_bytes_per_row;
+    uint64_t f_workbuf_wi;
+    uint64_t f_workbuf_hist_pos_base;
+    uint64_t f_overall_workbuf_length;
+    uint64_t f_pass_workbuf_length;
+    uint64_t f_streaming_workbuf_length;
+    uint8_t f_call_sequence;
+    bool f_report_metadata_chrm;
+    bool f_report_metadata_exif;
+    bool f_report_metadata_gama;
+    bool f_report_metadata_iccp;
+    bool f_report_metadata_kvp;
+    bool f_report_metadata_srgb;
+    bool f_ignore_checksum;
+    bool f_workbuf_prefilled;
+    bool f_report_interlace_passes;
+    bool f_replicate_interlace_passes;
+    uint8_t f_depth;
+    uint8_t f_color_type;
+    uint8_t f_filter_distance;
+    uint8_t f_interlace_pass;
+    uint8_t f_num_completed_interlace_passes_value;
+    bool f_seen_actl;
+    bool f_seen_chrm;
+    bool f_seen_fctl;
+    bool f_seen_exif;
+    bool f_seen_gama;
+    bool f_seen_iccp;
+    bool f_seen_idat;
+    bool f_seen_plte;
+    bool f_seen_srgb;
+    bool f_seen_trns;
+    bool f_metadata_is_zlib_compressed;
+    bool f_zlib_is_dirty;
+    uint32_t f_chunk_type;
+    uint8_t f_chunk_type_array[4];
+    uint32_t f_chunk_length;
+    uint64_t f_remap_transparency;
+    uint32_t f_dst_pixfmt;
+    uint32_t f_src_pixfmt;
+    uint32_t f_num_animation_frames_value;
+    uint32_t f_num_animation_loops_value;
+    uint32_t f_num_decoded_frame_configs_value;
+    uint32_t f_num_decoded_frames_value;
+    uint32_t f_frame_rect_x0;
+    uint32_t f_frame_rect_y0;
+    uint32_t f_frame_rect_x1;
+    uint32_t f_frame_rect_y1;
+    uint32_t f_first_rect_x0;
+    uint32_t f_first_rect_y0;
+    uint32_t f_first_rect_x1;
+    uint32_t f_first_rect_y1;
+    uint64_t f_frame_config_io_position;
+    uint64_t f_first_config_io_position;
+    uint64_t f_frame_duration;
+    uint64_t f_first_duration;
+    uint8_t f_frame_disposal;
+    uint8_t f_first_disposal;
+    bool f_frame_overwrite_instead_of_blend;
+    bool f_first_overwrite_instead_of_blend;
+    uint32_t f_next_animation_seq_num;
+    uint32_t f_first_animation_seq_num;
+    bool f_resync_animation_seq_num;
+    uint32_t f_roi_x0;
+    uint32_t f_roi_y0;
+    uint32_t f_roi_x1;
+    uint32_t f_roi_y1;
+    uint32_t f_downscale_shift;
+    uint64_t f_downscale_workbuf_length;
+    uint32_t f_band_height;
+    uint32_t f_band_y0;
+    uint32_t f_band_y1;
+    uint32_t f_pass_resume_y;
+    bool f_pass_streaming;
+    uint32_t f_pass_workbuf_y0;
+    uint32_t f_pass_stop_y;
+    uint32_t f_downscale_num_rows;
+    uint32_t f_metadata_flavor;
+    uint32_t f_metadata_fourcc;
+    uint64_t f_metadata_x;
+    uint64_t f_metadata_y;
+    uint64_t f_metadata_z;
+    uint32_t f_ztxt_ri;
+    uint32_t f_ztxt_wi;
+    uint64_t f_ztxt_hist_pos;
+    wuffs_base__pixel_swizzler f_swizzler;
+
+    wuffs_base__empty_struct (*choosy_filter_1)(
+        wuffs_png__decoder* self,
+        wuffs_base__slice_u8 a_curr);
+    wuffs_base__empty_struct (*choosy_filter_3)(
+        wuffs_png__decoder* self,
+        wuffs_base__slice_u8 a_curr,
+        wuffs_base__slice_u8 a_prev);
+    wuffs_base__empty_struct (*choosy_filter_4)(
+        wuffs_png__decoder* self,
+        wuffs_base__slice_u8 a_curr,
+        wuffs_base__slice_u8 a_prev);
+    uint32_t p_decode_image_config[1];
+    uint32_t p_decode_ihdr[1];
+    uint32_t p_decode_other_chunk[1];
+    uint32_t p_decode_actl[1];
+    uint32_t p_decode_chrm[1];
+    uint32_t p_decode_fctl[1];
+    uint32_t p_decode_gama[1];
+    uint32_t p_decode_iccp[1];
+    uint32_t p_decode_plte[1];
+    uint32_t p_decode_srgb[1];
+    uint32_t p_decode_trns[1];
+    uint32_t p_decode_frame_config[1];
+    uint32_t p_skip_frame[1];
+    uint32_t p_decode_frame[1];
+    uint32_t p_decode_pass[1];
+    uint32_t p_decode_pass_streaming[1];
+    uint32_t p_decode_pass_next_chunk[1];
+    uint32_t p_skip_pass[1];
+    uint32_t p_tell_me_more[1];
+    wuffs_base__status (*choosy_filter_and_swizzle)(
+        wuffs_png__decoder* self,
+        wuffs_base__pixel_buffer* a_dst,
+        wuffs_base__slice_u8 a_workbuf);
+  } private_impl;
+
+  struct {
+    wuffs_crc32__ieee_hasher f_crc32;
+    wuffs_zlib__decoder f_zlib;
+    uint8_t f_dst_palette[1024];
+    uint8_t f_src_palette[1024];
+    uint8_t f_zlib_workbuf[33025];
+
+    struct {
+      uint64_t scratch;
+      uint32_t v_checksum_have;
+    } s_decode_image_config[1];
+    struct {
+      uint64_t scratch;
+    } s_decode_ihdr[1];
+    struct {
+      uint64_t scratch;
+    } s_decode_other_chunk[1];
+    struct {
+      uint64_t scratch;
+    } s_decode_actl[1];
+    struct {
+      uint64_t scratch;
+    } s_decode_chrm[1];
+    struct {
+      uint64_t scratch;
+      uint32_t v_x0;
+      uint32_t v_x1;
+      uint32_t v_y1;
+    } s_decode_fctl[1];
+    struct {
+      uint64_t scratch;
+    } s_decode_gama[1];
+    struct {
+      uint64_t scratch;
+      uint32_t v_num_entries;
+      uint32_t v_i;
+    } s_decode_plte[1];
+    struct {
+      uint64_t scratch;
+      uint32_t v_i;
+      uint32_t v_n;
+    } s_decode_trns[1];
+    struct {
+      uint64_t scratch;
+    } s_decode_frame_config[1];
+    struct {
+      uint64_t scratch;
+    } s_skip_frame[1];
+    struct {
+      uint64_t scratch;
+    } s_decode_frame[1];
+    struct {
+      uint64_t scratch;
+    } s_decode_pass[1];
+    struct {
+      uint64_t scratch;
+      wuffs_base__status v_zlib_status;
+      wuffs_base__status v_status;
+      uint64_t v_row_length;
+      uint64_t v_row_wi;
+      uint32_t v_y;
+    } s_decode_pass_streaming[1];
+    struct {
+      uint64_t scratch;
+    } s_decode_pass_next_chunk[1];
+    struct {
+      uint64_t scratch;
+    } s_skip_pass[1];
+    struct {
+      uint64_t scratch;
+      wuffs_base__status v_zlib_status;
+    } s_tell_me_more[1];
+  } private_data;
+
+#ifdef __cplusplus
+#if defined(WUFFS_BASE__HAVE_UNIQUE_PTR)
+  using unique_ptr = std::unique_ptr<wuffs_png__decoder, decltype(&free)>;
+
+  // On failure, the alloc_etc functions return nullptr. They don't throw.
+
+  static inline unique_ptr
+  alloc() {
+    return unique_ptr(wuffs_png__decoder__alloc(), &free);
+  }
+
+  static inline wuffs_base__image_decoder::unique_ptr
+  alloc_as__wuffs_base__image_decoder() {
+    return wuffs_base__image_decoder::unique_ptr(
+        wuffs_png__decoder__alloc_as__wuffs_base__image_decoder(), &free);
+  }
+#endif  // defined(WUFFS_BASE__HAVE_UNIQUE_PTR)
+
+#if defined(WUFFS_BASE__HAVE_EQ_DELETE) && !defined(WUFFS_IMPLEMENTATION)
+  // Disallow constructing or copying an object via standard C++ mechanisms,
+  // e.g. the "new" operator, as this struct is intentionally opaque. Its total
+  // size and field layout is not part of the public, stable, memory-safe API.
+  // Use malloc or memcpy and the sizeof__wuffs_foo__bar function instead, and
+  // call wuffs_foo__bar__baz methods (which all take a "this"-like pointer as
+  // their first argument) rather than tweaking bar.private_impl.qux fields.
+  //
+  // In C, we can just leave wuffs_foo__bar as an incomplete type (unless
+  // WUFFS_IMPLEMENTATION is #define'd). In C++, we define a complete type in
+  // order to provide convenience methods. These forward on "this", so that you
+  // can write "bar->baz(etc)" instead of "wuffs_foo__bar__baz(bar, etc)".
+  wuffs_png__decoder__struct() = delete;
+  wuffs_png__decoder__struct(const wuffs_png__decoder__struct&) = delete;
+  wuffs_png__decoder__struct& operator=(
+      const wuffs_png__decoder__struct&) = delete;
+#endif  // defined(WUFFS_BASE__HAVE_EQ_DELETE) && !defined(WUFFS_IMPLEMENTATION)
+
+#if !defined(WUFFS_IMPLEMENTATION)
+  // As above, the size of the struct is not part of the public API, and unless
+  // WUFFS_IMPLEMENTATION is #define'd, this struct type T should be heap
+  // allocated, not stack allocated. Its size is not intended to be known at
+  // compile time, but it is unfortunately divulged as a side effect of
+  // defining C++ convenience methods. Use "sizeof__T()", calling the function,
+  // instead of "sizeof T", invoking the operator. To make the two values
+  // different, so that passing the latter will be rejected by the initialize
+  // function, we add an arbitrary amount of dead weight.
+  uint8_t dead_weight[123000000];  // 123 MB.
+#endif  // !defined(WUFFS_IMPLEMENTATION)
+
+  inline wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+  initialize(
+      size_t sizeof_star_self,
+      uint64_t wuffs_version,
+      uint32_t options) {
+    return wuffs_png__decoder__initialize(
+        this, sizeof_star_self, wuffs_version, options);
+  }
+
+  inline wuffs_base__stats
+  stats() const {
+    return wuffs_png__decoder__stats(this);
+  }
+
+  inline wuffs_base__image_decoder*
+  upcast_as__wuffs_base__image_decoder() {
+    return (wuffs_base__image_decoder*)this;
+  }
+
+  inline wuffs_base__empty_struct
+  set_quirk_enabled(
+      uint32_t a_quirk,
+      bool a_enabled) {
+    return wuffs_png__decoder__set_quirk_enabled(this, a_quirk, a_enabled);
+  }
+
+  inline wuffs_base__empty_struct
+  set_workbuf_prefilled(
+      bool a_prefilled) {
+    return wuffs_png__decoder__set_workbuf_prefilled(this, a_prefilled);
+  }
+
+  inline wuffs_base__status
+  decode_image_config(
+      wuffs_base__image_config* a_dst,
+      wuffs_base__io_buffer* a_src) {
+    return wuffs_png__decoder__decode_image_config(this, a_dst, a_src);
+  }
+
+  inline wuffs_base__status
+  decode_frame_config(
+      wuffs_base__frame_config* a_dst,
+      wuffs_base__io_buffer* a_src) {
+    return wuffs_png__decoder__decode_frame_config(this, a_dst, a_src);
+  }
+
+  inline wuffs_base__status
+  decode_frame(
+      wuffs_base__pixel_buffer* a_dst,
+      wuffs_base__io_buffer* a_src,
+      wuffs_base__pixel_blend a_blend,
+      wuffs_base__slice_u8 a_workbuf,
+      wuffs_base__decode_frame_options* a_opts) {
+    return wuffs_png__decoder__decode_frame(this, a_dst, a_src, a_blend, a_workbuf, a_opts);
+  }
+
+  inline bool
+  can_decode_row_bands() const {
+    return wuffs_png__decoder__can_decode_row_bands(this);
+  }
+
+  inline wuffs_base__rect_ie_u32
+  frame_dirty_rect() const {
+    return wuffs_png__decoder__frame_dirty_rect(this);
+  }
+
+  inline uint32_t
+  interlace_preview_height() const {
+    return wuffs_png__decoder__interlace_preview_height(this);
+  }
+
+  inline uint32_t
+  interlace_preview_width() const {
+    return wuffs_png__decoder__interlace_preview_width(this);
+  }
+
+  inline uint32_t
+  num_animation_loops() const {
+    return wuffs_png__decoder__num_animation_loops(this);
+  }
+
+  inline uint64_t
+  num_decoded_frame_configs() const {
+    return wuffs_png__decoder__num_decoded_frame_configs(this);
+  }
+
+  inline uint32_t
+  num_completed_interlace_passes() const {
+    return wuffs_png__decoder__num_completed_interlace_passes(this);
+  }
+
+  inline uint64_t
+  num_decoded_frames() const {
+    return wuffs_png__decoder__num_decoded_frames(this);
+  }
+
+  inline wuffs_base__status
+  restart_frame(
+      uint64_t a_index,
+      uint64_t a_io_position) {
+    return wuffs_png__decoder__restart_frame(this, a_index, a_io_position);
+  }
+
+  inline wuffs_base__empty_struct
+  set_report_metadata(
+      uint32_t a_fourcc,
+      bool a_report) {
+    return wuffs_png__decoder__set_report_metadata(this, a_fourcc, a_report);
+  }
+
+  inline wuffs_base__status
+  tell_me_more(
+      wuffs_base__io_buffer* a_dst,
+      wuffs_base__more_information* a_minfo,
+      wuffs_base__io_buffer* a_src) {
+    return wuffs_png__decoder__tell_me_more(this, a_dst, a_minfo, a_src);
+  }
+
+  inline wuffs_base__range_ii_u64
+  workbuf_len() const {
+    return wuffs_png__decoder__workbuf_len(this);
+  }
+
+#endif  // __cplusplus
+};  // struct wuffs_png__decoder__struct
+
+struct wuffs_png__encoder__struct {
+  // Do not access the private_impl's or private_data's fields directly. There
+  // is no API/ABI compatibility or safety guarantee if you do so. Instead, use
+  // the wuffs_foo__bar__baz functions.
+  //
+  // It is a struct, not a struct*, so that the outermost wuffs_foo__bar struct
+  // can be stack allocated when WUFFS_IMPLEMENTATION is defined.
+
+  struct {
+    uint32_t magic;
+    uint32_t active_coroutine;
+    wuffs_base__vtable null_vtable;
+#if defined(WUFFS_CONFIG__STATS)
+    wuffs_base__stats stats;
+#endif  // defined(WUFFS_CONFIG__STATS)
+
+    uint32_t f_level;
+    bool f_has_level;
+    uint32_t f_filter;
+    bool f_has_filter;
+    bool f_workbuf_prefilled;
+    uint32_t f_band_min_incl_y;
+    uint32_t f_band_max_excl_y;
+    uint32_t f_band_checksum;
+    uint64_t f_band_length;
+    uint32_t f_width;
+    uint32_t f_height;
+    uint8_t f_color_type;
+    uint32_t f_filter_distance;
+    uint64_t f_row_length;
+    uint64_t f_n_filter_slots;
+    uint32_t f_y;
+    uint64_t f_filtered_ri;
+    uint64_t f_filtered_wi;
+    uint64_t f_filter_cost;
+    uint32_t f_obuf_ri;
+    uint32_t f_obuf_wi;
+    uint32_t f_chunk_start;
+    bool f_deflate_is_dirty;
+    wuffs_base__pixel_swizzler f_swizzler;
+
+    wuffs_base__empty_struct (*choosy_encode_filter_0)(
+        wuffs_png__encoder* self,
+        wuffs_base__slice_u8 a_dst,
+        wuffs_base__slice_u8 a_curr);
+    wuffs_base__empty_struct (*choosy_encode_filter_1)(
+        wuffs_png__encoder* self,
+        wuffs_base__slice_u8 a_dst,
+        wuffs_base__slice_u8 a_curr);
+    wuffs_base__empty_struct (*choosy_encode_filter_2)(
+        wuffs_png__encoder* self,
+        wuffs_base__slice_u8 a_dst,
+        wuffs_base__slice_u8 a_curr,
+        wuffs_base__slice_u8 a_prev);
+    wuffs_base__empty_struct (*choosy_encode_filter_3)(
+        wuffs_png__encoder* self,
+        wuffs_base__slice_u8 a_dst,
+        wuffs_base__slice_u8 a_curr,
+        wuffs_base__slice_u8 a_prev);
+    wuffs_base__empty_struct (*choosy_encode_filter_4)(
+        wuffs_png__encoder* self,
+        wuffs_base__slice_u8 a_dst,
+        wuffs_base__slice_u8 a_curr,
+        wuffs_base__slice_u8 a_prev);
+    uint32_t p_encode_image[1];
+    uint32_t p_encode_idat[1];
+    uint32_t p_emit_idat[1];
+    uint32_t p_write_obuf[1];
+  } private_impl;
+
+  struct {
+    wuffs_adler32__hasher f_adler32;
+    wuffs_crc32__ieee_hasher f_crc32;
+    wuffs_deflate__encoder f_deflate;
+    uint8_t f_obuf[32780];
+
+    struct {
+      wuffs_base__status v_deflate_status;
+      uint32_t v_y_end;
+    } s_encode_idat[1];
+  } private_data;
+
+#ifdef __cplusplus
+#if defined(WUFFS_BASE__HAVE_UNIQUE_PTR)
+  using unique_ptr = std::unique_ptr<wuffs_png__encoder, decltype(&free)>;
+
+  // On failure, the alloc_etc functions return nullptr. They don't throw.
+
+  static inline unique_ptr
+  alloc() {
+    return unique_ptr(wuffs_png__encoder__alloc(), &free);
+  }
+#endif  // defined(WUFFS_BASE__HAVE_UNIQUE_PTR)
+
+#if defined(WUFFS_BASE__HAVE_EQ_DELETE) && !defined(WUFFS_IMPLEMENTATION)
+  // Disallow constructing or copying an object via standard C++ mechanisms,
+  // e.g. the "new" operator, as this struct is intentionally opaque. Its total
+  // size and field layout is not part of the public, stable, memory-safe API.
+  // Use malloc or memcpy and the sizeof__wuffs_foo__bar function instead, and
+  // call wuffs_foo__bar__baz methods (which all take a "this"-like pointer as
+  // their first argument) rather than tweaking bar.private_impl.qux fields.
+  //
+  // In C, we can just leave wuffs_foo__bar as an incomplete type (unless
+  // WUFFS_IMPLEMENTATION is #define'd). In C++, we define a complete type in
+  // order to provide convenience methods. These forward on "this", so that you
+  // can write "bar->baz(etc)" instead of "wuffs_foo__bar__baz(bar, etc)".
+  wuffs_png__encoder__struct() = delete;
+  wuffs_png__encoder__struct(const wuffs_png__encoder__struct&) = delete;
+  wuffs_png__encoder__struct& operator=(
+      const wuffs_png__encoder__struct&) = delete;
+#endif  // defined(WUFFS_BASE__HAVE_EQ_DELETE) && !defined(WUFFS_IMPLEMENTATION)
+
+#if !defined(WUFFS_IMPLEMENTATION)
+  // As above, the size of the struct is not part of the public API, and unless
+  // WUFFS_IMPLEMENTATION is #define'd, this struct type T should be heap
+  // allocated, not stack allocated. Its size is not intended to be known at
+  // compile time, but it is unfortunately divulged as a side effect of
+  // defining C++ convenience methods. Use "sizeof__T()", calling the function,
+  // instead of "sizeof T", invoking the operator. To make the two values
+  // different, so that passing the latter will be rejected by the initialize
+  // function, we add an arbitrary amount of dead weight.
+  uint8_t dead_weight[123000000];  // 123 MB.
+#endif  // !defined(WUFFS_IMPLEMENTATION)
+
+  inline wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+  initialize(
+      size_t sizeof_star_self,
+      uint64_t wuffs_version,
+      uint32_t options) {
+    return wuffs_png__encoder__initialize(
+        this, sizeof_star_self, wuffs_version, options);
+  }
+
+  inline wuffs_base__stats
+  stats() const {
+    return wuffs_png__encoder__stats(this);
+  }
+
+  inline wuffs_base__empty_struct
+  set_level(
+      uint32_t a_level) {
+    return wuffs_png__encoder__set_level(this, a_level);
+  }
+
+  inline wuffs_base__empty_struct
+  set_filter(
+      uint32_t a_filter) {
+    return wuffs_png__encoder__set_filter(this, a_filter);
+  }
+
+  inline wuffs_base__empty_struct
+  set_row_band(
+      uint32_t a_min_incl_y,
+      uint32_t a_max_excl_y) {
+    return wuffs_png__encoder__set_row_band(this, a_min_incl_y, a_max_excl_y);
+  }
+
+  inline uint32_t
+  row_band_checksum() const {
+    return wuffs_png__encoder__row_band_checksum(this);
+  }
+
+  inline uint64_t
+  row_band_length() const {
+    return wuffs_png__encoder__row_band_length(this);
+  }
+
+  inline wuffs_base__empty_struct
+  set_workbuf_prefilled(
+      bool a_prefilled) {
+    return wuffs_png__encoder__set_workbuf_prefilled(this, a_prefilled);
+  }
+
+  inline wuffs_base__range_ii_u64
+  workbuf_len(
+      wuffs_base__pixel_format a_src_pixfmt,
+      uint32_t a_width) const {
+    return wuffs_png__encoder__workbuf_len(this, a_src_pixfmt, a_width);
+  }
+
+  inline wuffs_base__status
+  encode_image(
+      wuffs_base__io_buffer* a_dst,
+      wuffs_base__pixel_buffer* a_src,
+      wuffs_base__slice_u8 a_workbuf) {
+    return wuffs_png__encoder__encode_image(this, a_dst, a_src, a_workbuf);
+  }
+
+#endif  // __cplusplus
+};  // struct wuffs_png__encoder__struct
+
+#endif  // defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
+
+
+// ‼ WUFFS C HEADER ENDS HERE.
+#ifdef WUFFS_IMPLEMENTATION
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__PNG)
+
+// ---------------- Status Codes Implementations
+
+const char wuffs_png__error__bad_animation_sequence_number[] = "#png: bad animation sequence number";
+const char wuffs_png__error__bad_checksum[] = "#png: bad checksum";
+const char wuffs_png__error__bad_chunk[] = "#png: bad chunk";
+const char wuffs_png__error__bad_filter[] = "#png: bad filter";
+const char wuffs_png__error__bad_header[] = "#png: bad header";
+const char wuffs_png__error__bad_text_chunk_not_latin_1[] = "#png: bad text chunk (not Latin-1)";
+const char wuffs_png__error__missing_palette[] = "#png: missing palette";
+const char wuffs_png__error__unsupported_png_compression_method[] = "#png: unsupported PNG compression method";
+const char wuffs_png__error__unsupported_png_file[] = "#png: unsupported PNG file";
+const char wuffs_png__suspension__interlace_pass_complete[] = "$png: interlace pass complete";
+const char wuffs_png__error__internal_error_inconsistent_i_o[] = "#png: internal error: inconsistent I/O";
+const char wuffs_png__error__internal_error_inconsistent_chunk_type[] = "#png: internal error: inconsistent chunk type";
+const char wuffs_png__error__internal_error_inconsistent_frame_bounds[] = "#png: internal error: inconsistent frame bounds";
+const char wuffs_png__error__internal_error_inconsistent_workbuf_length[] = "#png: internal error: inconsistent workbuf length";
+const char wuffs_png__error__internal_error_zlib_decoder_did_not_exhaust_its_input[] = "#png: internal error: zlib decoder did not exhaust its input";
+const char wuffs_png__note__internal_note_short_write[] = "@png: internal note: short write";
+
+// ---------------- Private Consts
+
+#define WUFFS_PNG__ANCILLARY_BIT 32
+
+static const uint8_t
+WUFFS_PNG__INTERLACING[8][6] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  {
+    0, 0, 0, 0, 0, 0,
+  }, {
+    3, 7, 0, 3, 7, 0,
+  }, {
+    3, 3, 4, 3, 7, 0,
+  }, {
+    2, 3, 0, 3, 3, 4,
+  }, {
+    2, 1, 2, 2, 3, 0,
+  }, {
+    1, 1, 0, 2, 1, 2,
+  }, {
+    1, 0, 1, 1, 1, 0,
+  }, {
+    0, 0, 0, 1, 0, 1,
+  },
+};
+
+static const uint8_t
+WUFFS_PNG__INTERLACING_PREVIEW_SHIFTS[8][2] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  {
+    3, 3,
+  }, {
+    3, 3,
+  }, {
+    2, 3,
+  }, {
+    2, 2,
+  }, {
+    1, 2,
+  }, {
+    1, 1,
+  }, {
+    0, 1,
+  }, {
+    0, 0,
+  },
+};
+
+static const uint8_t
+WUFFS_PNG__LOW_BIT_DEPTH_MULTIPLIERS[8] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  0, 255, 85, 0, 17, 0, 0, 0,
+};
+
+static const uint8_t
+WUFFS_PNG__LOW_BIT_DEPTH_NUM_PACKS[8] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  0, 8, 4, 0, 2, 0, 0, 0,
+};
+
+static const uint8_t
+WUFFS_PNG__NUM_CHANNELS[8] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  1, 0, 3, 1, 2, 0, 4, 0,
+};
+
+static const uint16_t
+WUFFS_PNG__LATIN_1[256] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  32, 33, 34, 35, 36, 37, 38, 39,
+  40, 41, 42, 43, 44, 45, 46, 47,
+  48, 49, 50, 51, 52, 53, 54, 55,
+  56, 57, 58, 59, 60, 61, 62, 63,
+  64, 65, 66, 67, 68, 69, 70, 71,
+  72, 73, 74, 75, 76, 77, 78, 79,
+  80, 81, 82, 83, 84, 85, 86, 87,
+  88, 89, 90, 91, 92, 93, 94, 95,
+  96, 97, 98, 99, 100, 101, 102, 103,
+  104, 105, 106, 107, 108, 109, 110, 111,
+  112, 113, 114, 115, 116, 117, 118, 119,
+  120, 121, 122, 123, 124, 125, 126, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 41410, 41666, 41922, 42178, 42434, 42690, 42946,
+  43202, 43458, 43714, 43970, 44226, 44482, 44738, 44994,
+  45250, 45506, 45762, 46018, 46274, 46530, 46786, 47042,
+  47298, 47554, 47810, 48066, 48322, 48578, 48834, 49090,
+  32963, 33219, 33475, 33731, 33987, 34243, 34499, 34755,
+  35011, 35267, 35523, 35779, 36035, 36291, 36547, 36803,
+  37059, 37315, 37571, 37827, 38083, 38339, 38595, 38851,
+  39107, 39363, 39619, 39875, 40131, 40387, 40643, 40899,
+  41155, 41411, 41667, 41923, 42179, 42435, 42691, 42947,
+  43203, 43459, 43715, 43971, 44227, 44483, 44739, 44995,
+  45251, 45507, 45763, 46019, 46275, 46531, 46787, 47043,
+  47299, 47555, 47811, 48067, 48323, 48579, 48835, 49091,
+};
+
+#define WUFFS_PNG__QUIRKS_BASE 1554767872
+
+#define WUFFS_PNG__ENCODER_OBUF_SIZE 32780
+
+#define WUFFS_PNG__ENCODER_IDAT_END 32776
+
+static const uint8_t
+WUFFS_PNG__ZLIB_FLGS[10] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  1, 1, 94, 94, 94, 94, 156, 218,
+  218, 218,
+};
+
+// ---------------- Private Initializer Prototypes
+
+// ---------------- Private Function Prototypes
+
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+static wuffs_base__empty_struct
+wuffs_png__decoder__filter_1_distance_4_arm_neon(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_curr);
+#endif  // defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+static wuffs_base__empty_struct
+wuffs_png__decoder__filter_3_distance_4_arm_neon(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev);
+#endif  // defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+static wuffs_base__empty_struct
+wuffs_png__decoder__filter_4_distance_3_arm_neon(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev);
+#endif  // defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+static wuffs_base__empty_struct
+wuffs_png__decoder__filter_4_distance_4_arm_neon(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev);
+#endif  // defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+
+static wuffs_base__empty_struct
+wuffs_png__decoder__filter_1(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_curr);
+
+static wuffs_base__empty_struct
+wuffs_png__decoder__filter_1__choosy_default(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_curr);
+
+static wuffs_base__empty_struct
+wuffs_png__decoder__filter_1_distance_3_fallback(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_curr);
+
+static wuffs_base__empty_struct
+wuffs_png__decoder__filter_1_distance_4_fallback(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_curr);
+
+static wuffs_base__empty_struct
+wuffs_png__decoder__filter_2(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev);
+
+static wuffs_base__empty_struct
+wuffs_png__decoder__filter_3(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev);
+
+static wuffs_base__empty_struct
+wuffs_png__decoder__filter_3__choosy_default(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev);
+
+static wuffs_base__empty_struct
+wuffs_png__decoder__filter_3_distance_3_fallback(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev);
+
+static wuffs_base__empty_struct
+wuffs_png__decoder__filter_3_distance_4_fallback(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev);
+
+static wuffs_base__empty_struct
+wuffs_png__decoder__filter_4(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev);
+
+static wuffs_base__empty_struct
+wuffs_png__decoder__filter_4__choosy_default(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev);
+
+static wuffs_base__empty_struct
+wuffs_png__decoder__filter_4_distance_3_fallback(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev);
+
+static wuffs_base__empty_struct
+wuffs_png__decoder__filter_4_distance_4_fallback(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev);
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+static wuffs_base__empty_struct
+wuffs_png__decoder__filter_1_distance_4_x86_sse42(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_curr);
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+static wuffs_base__empty_struct
+wuffs_png__decoder__filter_3_distance_4_x86_sse42(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev);
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+static wuffs_base__empty_struct
+wuffs_png__decoder__filter_4_distance_3_x86_sse42(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev);
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+static wuffs_base__empty_struct
+wuffs_png__decoder__filter_4_distance_4_x86_sse42(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev);
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+
+static wuffs_base__status
+wuffs_png__decoder__decode_ihdr(
+    wuffs_png__decoder* self,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__empty_struct
+wuffs_png__decoder__assign_filter_distance(
+    wuffs_png__decoder* self);
+
+static uint64_t
+wuffs_png__decoder__calculate_bytes_per_row(
+    const wuffs_png__decoder* self,
+    uint32_t a_width);
+
+static wuffs_base__empty_struct
+wuffs_png__decoder__choose_filter_implementations(
+    wuffs_png__decoder* self);
+
+static wuffs_base__status
+wuffs_png__decoder__decode_other_chunk(
+    wuffs_png__decoder* self,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status
+wuffs_png__decoder__decode_actl(
+    wuffs_png__decoder* self,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status
+wuffs_png__decoder__decode_chrm(
+    wuffs_png__decoder* self,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status
+wuffs_png__decoder__decode_exif(
+    wuffs_png__decoder* self,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status
+wuffs_png__decoder__decode_fctl(
+    wuffs_png__decoder* self,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status
+wuffs_png__decoder__decode_gama(
+    wuffs_png__decoder* self,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status
+wuffs_png__decoder__decode_iccp(
+    wuffs_png__decoder* self,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status
+wuffs_png__decoder__decode_plte(
+    wuffs_png__decoder* self,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status
+wuffs_png__decoder__decode_srgb(
+    wuffs_png__decoder* self,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status
+wuffs_png__decoder__decode_trns(
+    wuffs_png__decoder* self,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status
+wuffs_png__decoder__skip_frame(
+    wuffs_png__decoder* self,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__slice_u8
+wuffs_png__decoder__downscale_scratch(
+    const wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_workbuf,
+    uint64_t a_bytes_per_pixel);
+
+static uint32_t
+wuffs_png__decoder__downscale_row(
+    wuffs_png__decoder* self,
+    wuffs_base__pixel_buffer* a_dst,
+    wuffs_base__slice_u8 a_workbuf,
+    uint32_t a_y,
+    uint32_t a_num_rows,
+    uint64_t a_bytes_per_pixel);
+
+static wuffs_base__empty_struct
+wuffs_png__decoder__replicate_interlace_pass(
+    wuffs_png__decoder* self,
+    wuffs_base__pixel_buffer* a_dst);
+
+static wuffs_base__status
+wuffs_png__decoder__decode_pass(
+    wuffs_png__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf);
+
+static wuffs_base__status
+wuffs_png__decoder__decode_pass_streaming(
+    wuffs_png__decoder* self,
+    wuffs_base__pixel_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf);
+
+static wuffs_base__status
+wuffs_png__decoder__decode_pass_next_chunk(
+    wuffs_png__decoder* self,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status
+wuffs_png__decoder__skip_pass(
+    wuffs_png__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf);
+
+static wuffs_base__status
+wuffs_png__decoder__filter_and_swizzle(
+    wuffs_png__decoder* self,
+    wuffs_base__pixel_buffer* a_dst,
+    wuffs_base__slice_u8 a_workbuf);
+
+static wuffs_base__status
+wuffs_png__decoder__filter_and_swizzle__choosy_default(
+    wuffs_png__decoder* self,
+    wuffs_base__pixel_buffer* a_dst,
+    wuffs_base__slice_u8 a_workbuf);
+
+static wuffs_base__status
+wuffs_png__decoder__filter_and_swizzle_rgba_bgra_premul(
+    wuffs_png__decoder* self,
+    wuffs_base__pixel_buffer* a_dst,
+    wuffs_base__slice_u8 a_workbuf);
+
+static wuffs_base__empty_struct
+wuffs_png__decoder__swizzle_rgba_bgra_premul(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_src);
+
+static wuffs_base__status
+wuffs_png__decoder__filter_and_swizzle_tricky(
+    wuffs_png__decoder* self,
+    wuffs_base__pixel_buffer* a_dst,
+    wuffs_base__slice_u8 a_workbuf);
+
+static uint64_t
+wuffs_png__encoder__byte_cost(
+    const wuffs_png__encoder* self,
+    uint8_t a_x);
+
+static uint64_t
+wuffs_png__encoder__encode_filter_head(
+    wuffs_png__encoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev,
+    uint32_t a_shift);
+
+static wuffs_base__empty_struct
+wuffs_png__encoder__encode_filter_0(
+    wuffs_png__encoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_curr);
+
+static wuffs_base__empty_struct
+wuffs_png__encoder__encode_filter_0__choosy_default(
+    wuffs_png__encoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_curr);
+
+static wuffs_base__empty_struct
+wuffs_png__encoder__encode_filter_1(
+    wuffs_png__encoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_curr);
+
+static wuffs_base__empty_struct
+wuffs_png__encoder__encode_filter_1__choosy_default(
+    wuffs_png__encoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_curr);
+
+static wuffs_base__empty_struct
+wuffs_png__encoder__encode_filter_2(
+    wuffs_png__encoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev);
+
+static wuffs_base__empty_struct
+wuffs_png__encoder__encode_filter_2__choosy_default(
+    wuffs_png__encoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev);
+
+static wuffs_base__empty_struct
+wuffs_png__encoder__encode_filter_3(
+    wuffs_png__encoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev);
+
+static wuffs_base__empty_struct
+wuffs_png__encoder__encode_filter_3__choosy_default(
+    wuffs_png__encoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev);
+
+static wuffs_base__empty_struct
+wuffs_png__encoder__encode_filter_4(
+    wuffs_png__encoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev);
+
+static wuffs_base__empty_struct
+wuffs_png__encoder__encode_filter_4__choosy_default(
+    wuffs_png__encoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev);
+
+static uint8_t
+wuffs_png__encoder__paeth(
+    const wuffs_png__encoder* self,
+    uint8_t a_a,
+    uint8_t a_b,
+    uint8_t a_c);
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+static wuffs_base__empty_struct
+wuffs_png__encoder__encode_filter_0_x86_sse42(
+    wuffs_png__encoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_curr);
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+static wuffs_base__empty_struct
+wuffs_png__encoder__encode_filter_1_x86_sse42(
+    wuffs_png__encoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_curr);
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+static wuffs_base__empty_struct
+wuffs_png__encoder__encode_filter_2_x86_sse42(
+    wuffs_png__encoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev);
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+static wuffs_base__empty_struct
+wuffs_png__encoder__encode_filter_3_x86_sse42(
+    wuffs_png__encoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev);
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+static wuffs_base__empty_struct
+wuffs_png__encoder__encode_filter_4_x86_sse42(
+    wuffs_png__encoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev);
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+
+static uint32_t
+wuffs_png__encoder__bytes_per_pixel(
+    const wuffs_png__encoder* self,
+    wuffs_base__pixel_format a_pixfmt);
+
+static wuffs_base__status
+wuffs_png__encoder__prepare(
+    wuffs_png__encoder* self,
+    wuffs_base__pixel_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf);
+
+static wuffs_base__empty_struct
+wuffs_png__encoder__put_header(
+    wuffs_png__encoder* self,
+    wuffs_base__pixel_buffer* a_src);
+
+static wuffs_base__status
+wuffs_png__encoder__encode_idat(
+    wuffs_png__encoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__pixel_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf);
+
+static wuffs_base__empty_struct
+wuffs_png__encoder__filter_row(
+    wuffs_png__encoder* self,
+    wuffs_base__pixel_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf);
+
+static wuffs_base__empty_struct
+wuffs_png__encoder__apply_filter(
+    wuffs_png__encoder* self,
+    uint32_t a_k,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev);
+
+static wuffs_base__empty_struct
+wuffs_png__encoder__convert_row(
+    wuffs_png__encoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_src);
+
+static wuffs_base__empty_struct
+wuffs_png__encoder__zero_fill(
+    wuffs_png__encoder* self,
+    wuffs_base__slice_u8 a_s);
+
+static wuffs_base__empty_struct
+wuffs_png__encoder__fill_idat_from_workbuf(
+    wuffs_png__encoder* self,
+    wuffs_base__slice_u8 a_workbuf);
+
+static wuffs_base__status
+wuffs_png__encoder__emit_idat(
+    wuffs_png__encoder* self,
+    wuffs_base__io_buffer* a_dst);
+
+static wuffs_base__status
+wuffs_png__encoder__write_obuf(
+    wuffs_png__encoder* self,
+    wuffs_base__io_buffer* a_dst);
+
+static wuffs_base__empty_struct
+wuffs_png__encoder__put_u8(
+    wuffs_png__encoder* self,
+    uint8_t a_a);
+
+static wuffs_base__empty_struct
+wuffs_png__encoder__put_u32be(
+    wuffs_png__encoder* self,
+    uint32_t a_a);
+
+static wuffs_base__empty_struct
+wuffs_png__encoder__begin_chunk(
+    wuffs_png__encoder* self,
+    uint32_t a_chunk_type);
+
+static wuffs_base__empty_struct
+wuffs_png__encoder__end_chunk(
+    wuffs_png__encoder* self);
+
+// ---------------- VTables
+
+const wuffs_base__image_decoder__func_ptrs
+wuffs_png__decoder__func_ptrs_for__wuffs_base__image_decoder = {
+  (bool(*)(const void*))(&wuffs_png__decoder__can_decode_row_bands),
+  (wuffs_base__status(*)(void*,
+      wuffs_base__pixel_buffer*,
+      wuffs_base__io_buffer*,
+      wuffs_base__pixel_blend,
+      wuffs_base__slice_u8,
+      wuffs_base__decode_frame_options*))(&wuffs_png__decoder__decode_frame),
+  (wuffs_base__status(*)(void*,
+      wuffs_base__frame_config*,
+      wuffs_base__io_buffer*))(&wuffs_png__decoder__decode_frame_config),
+  (wuffs_base__status(*)(void*,
+      wuffs_base__image_config*,
+      wuffs_base__io_buffer*))(&wuffs_png__decoder__decode_image_config),
+  (wuffs_base__rect_ie_u32(*)(const void*))(&wuffs_png__decoder__frame_dirty_rect),
+  (uint32_t(*)(const void*))(&wuffs_png__decoder__num_animation_loops),
+  (uint64_t(*)(const void*))(&wuffs_png__decoder__num_decoded_frame_configs),
+  (uint64_t(*)(const void*))(&wuffs_png__decoder__num_decoded_frames),
+  (wuffs_base__status(*)(void*,
+      uint64_t,
+      uint64_t))(&wuffs_png__decoder__restart_frame),
+  (wuffs_base__empty_struct(*)(void*,
+      uint32_t,
+      bool))(&wuffs_png__decoder__set_quirk_enabled),
+  (wuffs_base__empty_struct(*)(void*,
+      uint32_t,
+      bool))(&wuffs_png__decoder__set_report_metadata),
+  (wuffs_base__status(*)(void*,
+      wuffs_base__io_buffer*,
+      wuffs_base__more_information*,
+      wuffs_base__io_buffer*))(&wuffs_png__decoder__tell_me_more),
+  (wuffs_base__range_ii_u64(*)(const void*))(&wuffs_png__decoder__workbuf_len),
+};
+
+// ---------------- Initializer Implementations
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+wuffs_png__decoder__initialize(
+    wuffs_png__decoder* self,
+    size_t sizeof_star_self,
+    uint64_t wuffs_version,
+    uint32_t options){
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  }
+
+  if ((options & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+    // The whole point of this if-check is to detect an uninitialized *self.
+    // We disable the warning on GCC. Clang-5.0 does not have this warning.
+    //
+    // The caller promises that *self is zeroed, so the empty asm tells GCC
+    // that private_impl is defined. Otherwise, once this function and a
+    // small method (e.g. one that reads a "choose" guard field) are both
+    // inlined into the caller, GCC -O3 warns about that method's read.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    __asm__ __volatile__("" : "+m"(self->private_impl));
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((options & WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      options |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    }
+  }
+
+  self->private_impl.choosy_filter_1 = &wuffs_png__decoder__filter_1__choosy_default;
+  self->private_impl.choosy_filter_3 = &wuffs_png__decoder__filter_3__choosy_default;
+  self->private_impl.choosy_filter_4 = &wuffs_png__decoder__filter_4__choosy_default;
+  self->private_impl.choosy_filter_and_swizzle = &wuffs_png__decoder__filter_and_swizzle__choosy_default;
+
+  {
+    wuffs_base__status z = wuffs_crc32__ieee_hasher__initialize(
+        &self->private_data.f_crc32, sizeof(self->private_data.f_crc32), WUFFS_VERSION, options);
+    if (z.repr) {
+      return z;
+    }
+  }
+  {
+    wuffs_base__status z = wuffs_zlib__decoder__initialize(
+        &self->private_data.f_zlib, sizeof(self->private_data.f_zlib), WUFFS_VERSION, options);
+    if (z.repr) {
+      return z;
+    }
+  }
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__image_decoder.vtable_name =
+      wuffs_base__image_decoder__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__image_decoder.function_pointers =
+      (const void*)(&wuffs_png__decoder__func_ptrs_for__wuffs_base__image_decoder);
+  return wuffs_base__make_status(NULL);
+}
+
+wuffs_png__decoder*
+wuffs_png__decoder__alloc() {
+  wuffs_png__decoder* x =
+      (wuffs_png__decoder*)(calloc(sizeof(wuffs_png__decoder), 1));
+  if (!x) {
+    return NULL;
+  }
+  if (wuffs_png__decoder__initialize(
+      x, sizeof(wuffs_png__decoder), WUFFS_VERSION, WUFFS_INITIALIZE__ALREADY_ZEROED).repr) {
+    free(x);
+    return NULL;
+  }
+  return x;
+}
+
+size_t
+sizeof__wuffs_png__decoder() {
+  return sizeof(wuffs_png__decoder);
+}
+
+wuffs_base__stats
+wuffs_png__decoder__stats(
+    const wuffs_png__decoder* self) {
+  wuffs_base__stats ret = wuffs_base__make_empty_stats();
+#if defined(WUFFS_CONFIG__STATS)
+  if (!self) {
+    return ret;
+  }
+  ret = self->private_impl.stats;
+  {
+    wuffs_base__stats z = wuffs_crc32__ieee_hasher__stats(&self->private_data.f_crc32);
+    wuffs_base__stats__accumulate(&ret, &z);
+  }
+  {
+    wuffs_base__stats z = wuffs_zlib__decoder__stats(&self->private_data.f_zlib);
+    wuffs_base__stats__accumulate(&ret, &z);
+  }
+#else
+  (void)(self);
+#endif  // defined(WUFFS_CONFIG__STATS)
+  return ret;
+}
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+wuffs_png__encoder__initialize(
+    wuffs_png__encoder* self,
+    size_t sizeof_star_self,
+    uint64_t wuffs_version,
+    uint32_t options){
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  }
+
+  if ((options & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+    // The whole point of this if-check is to detect an uninitialized *self.
+    // We disable the warning on GCC. Clang-5.0 does not have this warning.
+    //
+    // The caller promises that *self is zeroed, so the empty asm tells GCC
+    // that private_impl is defined. Otherwise, once this function and a
+    // small method (e.g. one that reads a "choose" guard field) are both
+    // inlined into the caller, GCC -O3 warns about that method's read.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    __asm__ __volatile__("" : "+m"(self->private_impl));
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((options & WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      options |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    }
+  }
+
+  self->private_impl.choosy_encode_filter_0 = &wuffs_png__encoder__encode_filter_0__choosy_default;
+  self->private_impl.choosy_encode_filter_1 = &wuffs_png__encoder__encode_filter_1__choosy_default;
+  self->private_impl.choosy_encode_filter_2 = &wuffs_png__encoder__encode_filter_2__choosy_default;
+  self->private_impl.choosy_encode_filter_3 = &wuffs_png__encoder__encode_filter_3__choosy_default;
+  self->private_impl.choosy_encode_filter_4 = &wuffs_png__encoder__encode_filter_4__choosy_default;
+
+  {
+    wuffs_base__status z = wuffs_adler32__hasher__initialize(
+        &self->private_data.f_adler32, sizeof(self->private_data.f_adler32), WUFFS_VERSION, options);
+    if (z.repr) {
+      return z;
+    }
+  }
+  {
+    wuffs_base__status z = wuffs_crc32__ieee_hasher__initialize(
+        &self->private_data.f_crc32, sizeof(self->private_data.f_crc32), WUFFS_VERSION, options);
+    if (z.repr) {
+      return z;
+    }
+  }
+  {
+    wuffs_base__status z = wuffs_deflate__encoder__initialize(
+        &self->private_data.f_deflate, sizeof(self->private_data.f_deflate), WUFFS_VERSION, options);
+    if (z.repr) {
+      return z;
+    }
+  }
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  return wuffs_base__make_status(NULL);
+}
+
+wuffs_png__encoder*
+wuffs_png__encoder__alloc() {
+  wuffs_png__encoder* x =
+      (wuffs_png__encoder*)(calloc(sizeof(wuffs_png__encoder), 1));
+  if (!x) {
+    return NULL;
+  }
+  if (wuffs_png__encoder__initialize(
+      x, sizeof(wuffs_png__encoder), WUFFS_VERSION, WUFFS_INITIALIZE__ALREADY_ZEROED).repr) {
+    free(x);
+    return NULL;
+  }
+  return x;
+}
+
+size_t
+sizeof__wuffs_png__encoder() {
+  return sizeof(wuffs_png__encoder);
+}
+
+wuffs_base__stats
+wuffs_png__encoder__stats(
+    const wuffs_png__encoder* self) {
+  wuffs_base__stats ret = wuffs_base__make_empty_stats();
+#if defined(WUFFS_CONFIG__STATS)
+  if (!self) {
+    return ret;
+  }
+  ret = self->private_impl.stats;
+  {
+    wuffs_base__stats z = wuffs_adler32__hasher__stats(&self->private_data.f_adler32);
+    wuffs_base__stats__accumulate(&ret, &z);
+  }
+  {
+    wuffs_base__stats z = wuffs_crc32__ieee_hasher__stats(&self->private_data.f_crc32);
+    wuffs_base__stats__accumulate(&ret, &z);
+  }
+  {
+    wuffs_base__stats z = wuffs_deflate__encoder__stats(&self->private_data.f_deflate);
+    wuffs_base__stats__accumulate(&ret, &z);
+  }
+#else
+  (void)(self);
+#endif  // defined(WUFFS_CONFIG__STATS)
+  return ret;
+}
+
+// ---------------- Function Implementations
+
+// ‼ WUFFS MULTI-FILE SECTION +arm_neon
+// -------- func png.decoder.filter_1_distance_4_arm_neon
+
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+static wuffs_base__empty_struct
+wuffs_png__decoder__filter_1_distance_4_arm_neon(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_curr) {
+  wuffs_base__slice_u8 v_curr = {0};
+  uint8x8_t v_fa = {0};
+  uint8x8_t v_fx = {0};
+
+  {
+    wuffs_base__slice_u8 i_slice_curr = a_curr;
+    v_curr.ptr = i_slice_curr.ptr;
+    v_curr.len = 4;
+    uint8_t* i_end0_curr = v_curr.ptr + (((i_slice_curr.len - (size_t)(v_curr.ptr - i_slice_curr.ptr)) / 8) * 8);
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_curr.ptr < i_end0_curr) {
+      v_fx = vreinterpret_u8_u32(vdup_n_u32(wuffs_base__peek_u32le__no_bounds_check(v_curr.ptr)));
+      v_fx = vadd_u8(v_fx, v_fa);
+      wuffs_base__poke_u32le__no_bounds_check(v_curr.ptr, vget_lane_u32(vreinterpret_u32_u8(v_fx), 0));
+      v_fa = v_fx;
+      v_curr.ptr += 4;
+      v_fx = vreinterpret_u8_u32(vdup_n_u32(wuffs_base__peek_u32le__no_bounds_check(v_curr.ptr)));
+      v_fx = vadd_u8(v_fx, v_fa);
+      wuffs_base__poke_u32le__no_bounds_check(v_curr.ptr, vget_lane_u32(vreinterpret_u32_u8(v_fx), 0));
+      v_fa = v_fx;
+      v_curr.ptr += 4;
+    }
+    v_curr.len = 4;
+    uint8_t* i_end1_curr = v_curr.ptr + (((i_slice_curr.len - (size_t)(v_curr.ptr - i_slice_curr.ptr)) / 4) * 4);
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_curr.ptr < i_end1_curr) {
+      v_fx = vreinterpret_u8_u32(vdup_n_u32(wuffs_base__peek_u32le__no_bounds_check(v_curr.ptr)));
+      v_fx = vadd_u8(v_fx, v_fa);
+      wuffs_base__poke_u32le__no_bounds_check(v_curr.ptr, vget_lane_u32(vreinterpret_u32_u8(v_fx), 0));
+      v_fa = v_fx;
+      v_curr.ptr += 4;
+    }
+    v_curr.len = 0;
+  }
+  return wuffs_base__make_empty_struct();
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+// ‼ WUFFS MULTI-FILE SECTION -arm_neon
+
+// ‼ WUFFS MULTI-FILE SECTION +arm_neon
+// -------- func png.decoder.filter_3_distance_4_arm_neon
+
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+static wuffs_base__empty_struct
+wuffs_png__decoder__filter_3_distance_4_arm_neon(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev) {
+  wuffs_base__slice_u8 v_curr = {0};
+  wuffs_base__slice_u8 v_prev = {0};
+  uint8x8_t v_fa = {0};
+  uint8x8_t v_fb = {0};
+  uint8x8_t v_fx = {0};
+
+  if (((uint64_t)(a_prev.len)) == 0) {
+    {
+      wuffs_base__slice_u8 i_slice_curr = a_curr;
+      v_curr.ptr = i_slice_curr.ptr;
+      v_curr.len = 4;
+      uint8_t* i_end0_curr = v_curr.ptr + (((i_slice_curr.len - (size_t)(v_curr.ptr - i_slice_curr.ptr)) / 8) * 8);
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_curr.ptr < i_end0_curr) {
+        v_fx = vreinterpret_u8_u32(vdup_n_u32(wuffs_base__peek_u32le__no_bounds_check(v_curr.ptr)));
+        v_fx = vadd_u8(v_fx, vhadd_u8(v_fa, v_fb));
+        wuffs_base__poke_u32le__no_bounds_check(v_curr.ptr, vget_lane_u32(vreinterpret_u32_u8(v_fx), 0));
+        v_fa = v_fx;
+        v_curr.ptr += 4;
+        v_fx = vreinterpret_u8_u32(vdup_n_u32(wuffs_base__peek_u32le__no_bounds_check(v_curr.ptr)));
+        v_fx = vadd_u8(v_fx, vhadd_u8(v_fa, v_fb));
+        wuffs_base__poke_u32le__no_bounds_check(v_curr.ptr, vget_lane_u32(vreinterpret_u32_u8(v_fx), 0));
+        v_fa = v_fx;
+        v_curr.ptr += 4;
+      }
+      v_curr.len = 4;
+      uint8_t* i_end1_curr = v_curr.ptr + (((i_slice_curr.len - (size_t)(v_curr.ptr - i_slice_curr.ptr)) / 4) * 4);
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_curr.ptr < i_end1_curr) {
+        v_fx = vreinterpret_u8_u32(vdup_n_u32(wuffs_base__peek_u32le__no_bounds_check(v_curr.ptr)));
+        v_fx = vadd_u8(v_fx, vhadd_u8(v_fa, v_fb));
+        wuffs_base__poke_u32le__no_bounds_check(v_curr.ptr, vget_lane_u32(vreinterpret_u32_u8(v_fx), 0));
+        v_fa = v_fx;
+        v_curr.ptr += 4;
+      }
+      v_curr.len = 0;
+    }
+  } else {
+    {
+      wuffs_base__slice_u8 i_slice_curr = a_curr;
+      v_curr.ptr = i_slice_curr.ptr;
+      wuffs_base__slice_u8 i_slice_prev = a_prev;
+      v_prev.ptr = i_slice_prev.ptr;
+      i_slice_curr.len = ((size_t)(wuffs_base__u64__min(i_slice_curr.len, i_slice_prev.len)));
+      v_curr.len = 4;
+      v_prev.len = 4;
+      uint8_t* i_end0_curr = v_curr.ptr + (((i_slice_curr.len - (size_t)(v_curr.ptr - i_slice_curr.ptr)) / 8) * 8);
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_curr.ptr < i_end0_curr) {
+        v_fb = vreinterpret_u8_u32(vdup_n_u32(wuffs_base__peek_u32le__no_bounds_check(v_prev.ptr)));
+        v_fx = vreinterpret_u8_u32(vdup_n_u32(wuffs_base__peek_u32le__no_bounds_check(v_curr.ptr)));
+        v_fx = vadd_u8(v_fx, vhadd_u8(v_fa, v_fb));
+        wuffs_base__poke_u32le__no_bounds_check(v_curr.ptr, vget_lane_u32(vreinterpret_u32_u8(v_fx), 0));
+        v_fa = v_fx;
+        v_curr.ptr += 4;
+        v_prev.ptr += 4;
+        v_fb = vreinterpret_u8_u32(vdup_n_u32(wuffs_base__peek_u32le__no_bounds_check(v_prev.ptr)));
+        v_fx = vreinterpret_u8_u32(vdup_n_u32(wuffs_base__peek_u32le__no_bounds_check(v_curr.ptr)));
+        v_fx = vadd_u8(v_fx, vhadd_u8(v_fa, v_fb));
+        wuffs_base__poke_u32le__no_bounds_check(v_curr.ptr, vget_lane_u32(vreinterpret_u32_u8(v_fx), 0));
+        v_fa = v_fx;
+        v_curr.ptr += 4;
+        v_prev.ptr += 4;
+      }
+      v_curr.len = 4;
+      v_prev.len = 4;
+      uint8_t* i_end1_curr = v_curr.ptr + (((i_slice_curr.len - (size_t)(v_curr.ptr - i_slice_curr.ptr)) / 4) * 4);
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_curr.ptr < i_end1_curr) {
+        v_fb = vreinterpret_u8_u32(vdup_n_u32(wuffs_base__peek_u32le__no_bounds_check(v_prev.ptr)));
+        v_fx = vreinterpret_u8_u32(vdup_n_u32(wuffs_base__peek_u32le__no_bounds_check(v_curr.ptr)));
+        v_fx = vadd_u8(v_fx, vhadd_u8(v_fa, v_fb));
+        wuffs_base__poke_u32le__no_bounds_check(v_curr.ptr, vget_lane_u32(vreinterpret_u32_u8(v_fx), 0));
+        v_fa = v_fx;
+        v_curr.ptr += 4;
+        v_prev.ptr += 4;
+      }
+      v_curr.len = 0;
+      v_prev.len = 0;
+    }
+  }
+  return wuffs_base__make_empty_struct();
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+// ‼ WUFFS MULTI-FILE SECTION -arm_neon
+
+// ‼ WUFFS MULTI-FILE SECTION +arm_neon
+// -------- func png.decoder.filter_4_distance_3_arm_neon
+
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+static wuffs_base__empty_struct
+wuffs_png__decoder__filter_4_distance_3_arm_neon(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev) {
+  wuffs_base__slice_u8 v_curr = {0};
+  wuffs_base__slice_u8 v_prev = {0};
+  uint8x8_t v_fa = {0};
+  uint8x8_t v_fb = {0};
+  uint8x8_t v_fc = {0};
+  uint8x8_t v_fx = {0};
+  uint16x8_t v_fafb = {0};
+  uint16x8_t v_fcfc = {0};
+  uint16x8_t v_pa = {0};
+  uint16x8_t v_pb = {0};
+  uint16x8_t v_pc = {0};
+  uint16x8_t v_cmpab = {0};
+  uint16x8_t v_cmpac = {0};
+  uint8x8_t v_picka = {0};
+  uint8x8_t v_pickb = {0};
+
+  {
+    wuffs_base__slice_u8 i_slice_curr = a_curr;
+    v_curr.ptr = i_slice_curr.ptr;
+    wuffs_base__slice_u8 i_slice_prev = a_prev;
+    v_prev.ptr = i_slice_prev.ptr;
+    i_slice_curr.len = ((size_t)(wuffs_base__u64__min(i_slice_curr.len, i_slice_prev.len)));
+    v_curr.len = 4;
+    v_prev.len = 4;
+    uint8_t* i_end0_curr = v_curr.ptr + wuffs_base__iterate_total_advance((i_slice_curr.len - (size_t)(v_curr.ptr - i_slice_curr.ptr)), 7, 6);
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_curr.ptr < i_end0_curr) {
+      v_fb = vreinterpret_u8_u32(vdup_n_u32(wuffs_base__peek_u32le__no_bounds_check(v_prev.ptr)));
+      v_fx = vreinterpret_u8_u32(vdup_n_u32(wuffs_base__peek_u32le__no_bounds_check(v_curr.ptr)));
+      v_fafb = vaddl_u8(v_fa, v_fb);
+      v_fcfc = vaddl_u8(v_fc, v_fc);
+      v_pa = vabdl_u8(v_fb, v_fc);
+      v_pb = vabdl_u8(v_fa, v_fc);
+      v_pc = vabdq_u16(v_fafb, v_fcfc);
+      v_cmpab = vcleq_u16(v_pa, v_pb);
+      v_cmpac = vcleq_u16(v_pa, v_pc);
+      v_picka = vmovn_u16(vandq_u16(v_cmpab, v_cmpac));
+      v_pickb = vmovn_u16(vcleq_u16(v_pb, v_pc));
+      v_fx = vadd_u8(v_fx, vbsl_u8(v_picka, v_fa, vbsl_u8(v_pickb, v_fb, v_fc)));
+      wuffs_base__poke_u24le__no_bounds_check(v_curr.ptr, vget_lane_u32(vreinterpret_u32_u8(v_fx), 0));
+      v_fc = v_fb;
+      v_fa = v_fx;
+      v_curr.ptr += 3;
+      v_prev.ptr += 3;
+      v_fb = vreinterpret_u8_u32(vdup_n_u32(wuffs_base__peek_u32le__no_bounds_check(v_prev.ptr)));
+      v_fx = vreinterpret_u8_u32(vdup_n_u32(wuffs_base__peek_u32le__no_bounds_check(v_curr.ptr)));
+      v_fafb = vaddl_u8(v_fa, v_fb);
+      v_fcfc = vaddl_u8(v_fc, v_fc);
+      v_pa = vabdl_u8(v_fb, v_fc);
+      v_pb = vabdl_u8(v_fa, v_fc);
+      v_pc = vabdq_u16(v_fafb, v_fcfc);
+      v_cmpab = vcleq_u16(v_pa, v_pb);
+      v_cmpac = vcleq_u16(v_pa, v_pc);
+      v_picka = vmovn_u16(vandq_u16(v_cmpab, v_cmpac));
+      v_pickb = vmovn_u16(vcleq_u16(v_pb, v_pc));
+      v_fx = vadd_u8(v_fx, vbsl_u8(v_picka, v_fa, vbsl_u8(v_pickb, v_fb, v_fc)));
+      wuffs_base__poke_u24le__no_bounds_check(v_curr.ptr, vget_lane_u32(vreinterpret_u32_u8(v_fx), 0));
+      v_fc = v_fb;
+      v_fa = v_fx;
+      v_curr.ptr += 3;
+      v_prev.ptr += 3;
+    }
+    v_curr.len = 4;
+    v_prev.len = 4;
+    uint8_t* i_end1_curr = v_curr.ptr + wuffs_base__iterate_total_advance((i_slice_curr.len - (size_t)(v_curr.ptr - i_slice_curr.ptr)), 4, 3);
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_curr.ptr < i_end1_curr) {
+      v_fb = vreinterpret_u8_u32(vdup_n_u32(wuffs_base__peek_u32le__no_bounds_check(v_prev.ptr)));
+      v_fx = vreinterpret_u8_u32(vdup_n_u32(wuffs_base__peek_u32le__no_bounds_check(v_curr.ptr)));
+      v_fafb = vaddl_u8(v_fa, v_fb);
+      v_fcfc = vaddl_u8(v_fc, v_fc);
+      v_pa = vabdl_u8(v_fb, v_fc);
+      v_pb = vabdl_u8(v_fa, v_fc);
+      v_pc = vabdq_u16(v_fafb, v_fcfc);
+      v_cmpab = vcleq_u16(v_pa, v_pb);
+      v_cmpac = vcleq_u16(v_pa, v_pc);
+      v_picka = vmovn_u16(vandq_u16(v_cmpab, v_cmpac));
+      v_pickb = vmovn_u16(vcleq_u16(v_pb, v_pc));
+      v_fx = vadd_u8(v_fx, vbsl_u8(v_picka, v_fa, vbsl_u8(v_pickb, v_fb, v_fc)));
+      wuffs_base__poke_u24le__no_bounds_check(v_curr.ptr, vget_lane_u32(vreinterpret_u32_u8(v_fx), 0));
+      v_fc = v_fb;
+      v_fa = v_fx;
+      v_curr.ptr += 3;
+      v_prev.ptr += 3;
+    }
+    v_curr.len = 3;
+    v_prev.len = 3;
+    uint8_t* i_end2_curr = v_curr.ptr + (((i_slice_curr.len - (size_t)(v_curr.ptr - i_slice_curr.ptr)) / 3) * 3);
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_curr.ptr < i_end2_curr) {
+      v_fb = vreinterpret_u8_u32(vdup_n_u32(wuffs_base__peek_u24le__no_bounds_check(v_prev.ptr)));
+      v_fx = vreinterpret_u8_u32(vdup_n_u32(wuffs_base__peek_u24le__no_bounds_check(v_curr.ptr)));
+      v_fafb = vaddl_u8(v_fa, v_fb);
+      v_fcfc = vaddl_u8(v_fc, v_fc);
+      v_pa = vabdl_u8(v_fb, v_fc);
+      v_pb = vabdl_u8(v_fa, v_fc);
+      v_pc = vabdq_u16(v_fafb, v_fcfc);
+      v_cmpab = vcleq_u16(v_pa, v_pb);
+      v_cmpac = vcleq_u16(v_pa, v_pc);
+      v_picka = vmovn_u16(vandq_u16(v_cmpab, v_cmpac));
+      v_pickb = vmovn_u16(vcleq_u16(v_pb, v_pc));
+      v_fx = vadd_u8(v_fx, vbsl_u8(v_picka, v_fa, vbsl_u8(v_pickb, v_fb, v_fc)));
+      wuffs_base__poke_u24le__no_bounds_check(v_curr.ptr, vget_lane_u32(vreinterpret_u32_u8(v_fx), 0));
+      v_curr.ptr += 3;
+      v_prev.ptr += 3;
+    }
+    v_curr.len = 0;
+    v_prev.len = 0;
+  }
+  return wuffs_base__make_empty_struct();
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+// ‼ WUFFS MULTI-FILE SECTION -arm_neon
+
+// ‼ WUFFS MULTI-FILE SECTION +arm_neon
+// -------- func png.decoder.filter_4_distance_4_arm_neon
+
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+static wuffs_base__empty_struct
+wuffs_png__decoder__filter_4_distance_4_arm_neon(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev) {
+  wuffs_base__slice_u8 v_curr = {0};
+  wuffs_base__slice_u8 v_prev = {0};
+  uint8x8_t v_fa = {0};
+  uint8x8_t v_fb = {0};
+  uint8x8_t v_fc = {0};
+  uint8x8_t v_fx = {0};
+  uint16x8_t v_fafb = {0};
+  uint16x8_t v_fcfc = {0};
+  uint16x8_t v_pa = {0};
+  uint16x8_t v_pb = {0};
+  uint16x8_t v_pc = {0};
+  uint16x8_t v_cmpab = {0};
+  uint16x8_t v_cmpac = {0};
+  uint8x8_t v_picka = {0};
+  uint8x8_t v_pickb = {0};
+
+  {
+    wuffs_base__slice_u8 i_slice_curr = a_curr;
+    v_curr.ptr = i_slice_curr.ptr;
+    wuffs_base__slice_u8 i_slice_prev = a_prev;
+    v_prev.ptr = i_slice_prev.ptr;
+    i_slice_curr.len = ((size_t)(wuffs_base__u64__min(i_slice_curr.len, i_slice_prev.len)));
+    v_curr.len = 4;
+    v_prev.len = 4;
+    uint8_t* i_end0_curr = v_curr.ptr + (((i_slice_curr.len - (size_t)(v_curr.ptr - i_slice_curr.ptr)) / 8) * 8);
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_curr.ptr < i_end0_curr) {
+      v_fb = vreinterpret_u8_u32(vdup_n_u32(wuffs_base__peek_u32le__no_bounds_check(v_prev.ptr)));
+      v_fx = vreinterpret_u8_u32(vdup_n_u32(wuffs_base__peek_u32le__no_bounds_check(v_curr.ptr)));
+      v_fafb = vaddl_u8(v_fa, v_fb);
+      v_fcfc = vaddl_u8(v_fc, v_fc);
+      v_pa = vabdl_u8(v_fb, v_fc);
+      v_pb = vabdl_u8(v_fa, v_fc);
+      v_pc = vabdq_u16(v_fafb, v_fcfc);
+      v_cmpab = vcleq_u16(v_pa, v_pb);
+      v_cmpac = vcleq_u16(v_pa, v_pc);
+      v_picka = vmovn_u16(vandq_u16(v_cmpab, v_cmpac));
+      v_pickb = vmovn_u16(vcleq_u16(v_pb, v_pc));
+      v_fx = vadd_u8(v_fx, vbsl_u8(v_picka, v_fa, vbsl_u8(v_pickb, v_fb, v_fc)));
+      wuffs_base__poke_u32le__no_bounds_check(v_curr.ptr, vget_lane_u32(vreinterpret_u32_u8(v_fx), 0));
+      v_fc = v_fb;
+      v_fa = v_fx;
+      v_curr.ptr += 4;
+      v_prev.ptr += 4;
+      v_fb = vreinterpret_u8_u32(vdup_n_u32(wuffs_base__peek_u32le__no_bounds_check(v_prev.ptr)));
+      v_fx = vreinterpret_u8_u32(vdup_n_u32(wuffs_base__peek_u32le__no_bounds_check(v_curr.ptr)));
+      v_fafb = vaddl_u8(v_fa, v_fb);
+      v_fcfc = vaddl_u8(v_fc, v_fc);
+      v_pa = vabdl_u8(v_fb, v_fc);
+      v_pb = vabdl_u8(v_fa, v_fc);
+      v_pc = vabdq_u16(v_fafb, v_fcfc);
+      v_cmpab = vcleq_u16(v_pa, v_pb);
+      v_cmpac = vcleq_u16(v_pa, v_pc);
+      v_picka = vmovn_u16(vandq_u16(v_cmpab, v_cmpac));
+      v_pickb = vmovn_u16(vcleq_u16(v_pb, v_pc));
+      v_fx = vadd_u8(v_fx, vbsl_u8(v_picka, v_fa, vbsl_u8(v_pickb, v_fb, v_fc)));
+      wuffs_base__poke_u32le__no_bounds_check(v_curr.ptr, vget_lane_u32(vreinterpret_u32_u8(v_fx), 0));
+      v_fc = v_fb;
+      v_fa = v_fx;
+      v_curr.ptr += 4;
+      v_prev.ptr += 4;
+    }
+    v_curr.len = 4;
+    v_prev.len = 4;
+    uint8_t* i_end1_curr = v_curr.ptr + (((i_slice_curr.len - (size_t)(v_curr.ptr - i_slice_curr.ptr)) / 4) * 4);
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_curr.ptr < i_end1_curr) {
+      v_fb = vreinterpret_u8_u32(vdup_n_u32(wuffs_base__peek_u32le__no_bounds_check(v_prev.ptr)));
+      v_fx = vreinterpret_u8_u32(vdup_n_u32(wuffs_base__peek_u32le__no_bounds_check(v_curr.ptr)));
+      v_fafb = vaddl_u8(v_fa, v_fb);
+      v_fcfc = vaddl_u8(v_fc, v_fc);
+      v_pa = vabdl_u8(v_fb, v_fc);
+      v_pb = vabdl_u8(v_fa, v_fc);
+      v_pc = vabdq_u16(v_fafb, v_fcfc);
+      v_cmpab = vcleq_u16(v_pa, v_pb);
+      v_cmpac = vcleq_u16(v_pa, v_pc);
+      v_picka = vmovn_u16(vandq_u16(v_cmpab, v_cmpac));
+      v_pickb = vmovn_u16(vcleq_u16(v_pb, v_pc));
+      v_fx = vadd_u8(v_fx, vbsl_u8(v_picka, v_fa, vbsl_u8(v_pickb, v_fb, v_fc)));
+      wuffs_base__poke_u32le__no_bounds_check(v_curr.ptr, vget_lane_u32(vreinterpret_u32_u8(v_fx), 0));
+      v_fc = v_fb;
+      v_fa = v_fx;
+      v_curr.ptr += 4;
+      v_prev.ptr += 4;
+    }
+    v_curr.len = 0;
+    v_prev.len = 0;
+  }
+  return wuffs_base__make_empty_struct();
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+// ‼ WUFFS MULTI-FILE SECTION -arm_neon
+
+// -------- func png.decoder.filter_1
+
+static wuffs_base__empty_struct
+wuffs_png__decoder__filter_1(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_curr) {
+  return (*self->private_impl.choosy_filter_1)(self, a_curr);
+}
+
+static wuffs_base__empty_struct
+wuffs_png__decoder__filter_1__choosy_default(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_curr) {
+  uint64_t v_filter_distance = 0;
+  uint8_t v_fa = 0;
+  uint64_t v_i_start = 0;
+  uint64_t v_i = 0;
+
+  v_filter_distance = ((uint64_t)(self->private_impl.f_filter_distance));
+  v_i_start = 0;
+  while (v_i_start < v_filter_distance) {
+    v_fa = 0;
+    v_i = v_i_start;
+    while (v_i < ((uint64_t)(a_curr.len))) {
+      a_curr.ptr[v_i] = ((uint8_t)(a_curr.ptr[v_i] + v_fa));
+      v_fa = a_curr.ptr[v_i];
+      v_i += v_filter_distance;
+    }
+    v_i_start += 1;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func png.decoder.filter_1_distance_3_fallback
+
+static wuffs_base__empty_struct
+wuffs_png__decoder__filter_1_distance_3_fallback(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_curr) {
+  wuffs_base__slice_u8 v_curr = {0};
+  uint8_t v_fa0 = 0;
+  uint8_t v_fa1 = 0;
+  uint8_t v_fa2 = 0;
+
+  {
+    wuffs_base__slice_u8 i_slice_curr = a_curr;
+    v_curr.ptr = i_slice_curr.ptr;
+    v_curr.len = 3;
+    uint8_t* i_end0_curr = v_curr.ptr + (((i_slice_curr.len - (size_t)(v_curr.ptr - i_slice_curr.ptr)) / 6) * 6);
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_curr.ptr < i_end0_curr) {
+      v_fa0 = ((uint8_t)(v_fa0 + v_curr.ptr[0]));
+      v_curr.ptr[0] = v_fa0;
+      v_fa1 = ((uint8_t)(v_fa1 + v_curr.ptr[1]));
+      v_curr.ptr[1] = v_fa1;
+      v_fa2 = ((uint8_t)(v_fa2 + v_curr.ptr[2]));
+      v_curr.ptr[2] = v_fa2;
+      v_curr.ptr += 3;
+      v_fa0 = ((uint8_t)(v_fa0 + v_curr.ptr[0]));
+      v_curr.ptr[0] = v_fa0;
+      v_fa1 = ((uint8_t)(v_fa1 + v_curr.ptr[1]));
+      v_curr.ptr[1] = v_fa1;
+      v_fa2 = ((uint8_t)(v_fa2 + v_curr.ptr[2]));
+      v_curr.ptr[2] = v_fa2;
+      v_curr.ptr += 3;
+    }
+    v_curr.len = 3;
+    uint8_t* i_end1_curr = v_curr.ptr + (((i_slice_curr.len - (size_t)(v_curr.ptr - i_slice_curr.ptr)) / 3) * 3);
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_curr.ptr < i_end1_curr) {
+      v_fa0 = ((uint8_t)(v_fa0 + v_curr.ptr[0]));
+      v_curr.ptr[0] = v_fa0;
+      v_fa1 = ((uint8_t)(v_fa1 + v_curr.ptr[1]));
+      v_curr.ptr[1] = v_fa1;
+      v_fa2 = ((uint8_t)(v_fa2 + v_curr.ptr[2]));
+      v_curr.ptr[2] = v_fa2;
+      v_curr.ptr += 3;
+    }
+    v_curr.len = 0;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func png.decoder.filter_1_distance_4_fallback
+
+static wuffs_base__empty_struct
+wuffs_png__decoder__filter_1_distance_4_fallback(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_curr) {
+  wuffs_base__slice_u8 v_curr = {0};
+  uint8_t v_fa0 = 0;
+  uint8_t v_fa1 = 0;
+  uint8_t v_fa2 = 0;
+  uint8_t v_fa3 = 0;
+
+  {
+    wuffs_base__slice_u8 i_slice_curr = a_curr;
+    v_curr.ptr = i_slice_curr.ptr;
+    v_curr.len = 4;
+    uint8_t* i_end0_curr = v_curr.ptr + (((i_slice_curr.len - (size_t)(v_curr.ptr - i_slice_curr.ptr)) / 4) * 4);
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_curr.ptr < i_end0_curr) {
+      v_fa0 = ((uint8_t)(v_fa0 + v_curr.ptr[0]));
+      v_curr.ptr[0] = v_fa0;
+      v_fa1 = ((uint8_t)(v_fa1 + v_curr.ptr[1]));
+      v_curr.ptr[1] = v_fa1;
+      v_fa2 = ((uint8_t)(v_fa2 + v_curr.ptr[2]));
+      v_curr.ptr[2] = v_fa2;
+      v_fa3 = ((uint8_t)(v_fa3 + v_curr.ptr[3]));
+      v_curr.ptr[3] = v_fa3;
+      v_curr.ptr += 4;
+    }
+    v_curr.len = 0;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func png.decoder.filter_2
+
+static wuffs_base__empty_struct
+wuffs_png__decoder__filter_2(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev) {
+  uint64_t v_n = 0;
+  uint64_t v_i = 0;
+
+  v_n = wuffs_base__u64__min(((uint64_t)(a_curr.len)), ((uint64_t)(a_prev.len)));
+  v_i = 0;
+  while (v_i < v_n) {
+    a_curr.ptr[v_i] = ((uint8_t)(a_curr.ptr[v_i] + a_prev.ptr[v_i]));
+    v_i += 1;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func png.decoder.filter_3
+
+static wuffs_base__empty_struct
+wuffs_png__decoder__filter_3(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev) {
+  return (*self->private_impl.choosy_filter_3)(self, a_curr, a_prev);
+}
+
+static wuffs_base__empty_struct
+wuffs_png__decoder__filter_3__choosy_default(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev) {
+  uint64_t v_filter_distance = 0;
+  uint64_t v_n = 0;
+  uint64_t v_i = 0;
+
+  v_filter_distance = ((uint64_t)(self->private_impl.f_filter_distance));
+  if (((uint64_t)(a_prev.len)) == 0) {
+    v_i = v_filter_distance;
+    while (v_i < ((uint64_t)(a_curr.len))) {
+      a_curr.ptr[v_i] = ((uint8_t)(a_curr.ptr[v_i] + (a_curr.ptr[(v_i - v_filter_distance)] / 2)));
+      v_i += 1;
+    }
+  } else {
+    v_n = wuffs_base__u64__min(((uint64_t)(a_curr.len)), ((uint64_t)(a_prev.len)));
+    v_i = 0;
+    while ((v_i < v_n) && (v_i < v_filter_distance)) {
+      a_curr.ptr[v_i] = ((uint8_t)(a_curr.ptr[v_i] + (a_prev.ptr[v_i] / 2)));
+      v_i += 1;
+    }
+    v_i = v_filter_distance;
+    while (v_i < v_n) {
+      a_curr.ptr[v_i] = ((uint8_t)(a_curr.ptr[v_i] + ((uint8_t)(((((uint32_t)(a_curr.ptr[(v_i - v_filter_distance)])) + ((uint32_t)(a_prev.ptr[v_i]))) / 2)))));
+      v_i += 1;
+    }
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func png.decoder.filter_3_distance_3_fallback
+
+static wuffs_base__empty_struct
+wuffs_png__decoder__filter_3_distance_3_fallback(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev) {
+  wuffs_base__slice_u8 v_curr = {0};
+  wuffs_base__slice_u8 v_prev = {0};
+  uint8_t v_fa0 = 0;
+  uint8_t v_fa1 = 0;
+  uint8_t v_fa2 = 0;
+
+  if (((uint64_t)(a_prev.len)) == 0) {
+    {
+      wuffs_base__slice_u8 i_slice_curr = a_curr;
+      v_curr.ptr = i_slice_curr.ptr;
+      v_curr.len = 3;
+      uint8_t* i_end0_curr = v_curr.ptr + (((i_slice_curr.len - (size_t)(v_curr.ptr - i_slice_curr.ptr)) / 6) * 6);
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_curr.ptr < i_end0_curr) {
+        v_fa0 = ((uint8_t)((v_fa0 / 2) + v_curr.ptr[0]));
+        v_curr.ptr[0] = v_fa0;
+        v_fa1 = ((uint8_t)((v_fa1 / 2) + v_curr.ptr[1]));
+        v_curr.ptr[1] = v_fa1;
+        v_fa2 = ((uint8_t)((v_fa2 / 2) + v_curr.ptr[2]));
+        v_curr.ptr[2] = v_fa2;
+        v_curr.ptr += 3;
+        v_fa0 = ((uint8_t)((v_fa0 / 2) + v_curr.ptr[0]));
+        v_curr.ptr[0] = v_fa0;
+        v_fa1 = ((uint8_t)((v_fa1 / 2) + v_curr.ptr[1]));
+        v_curr.ptr[1] = v_fa1;
+        v_fa2 = ((uint8_t)((v_fa2 / 2) + v_curr.ptr[2]));
+        v_curr.ptr[2] = v_fa2;
+        v_curr.ptr += 3;
+      }
+      v_curr.len = 3;
+      uint8_t* i_end1_curr = v_curr.ptr + (((i_slice_curr.len - (size_t)(v_curr.ptr - i_slice_curr.ptr)) / 3) * 3);
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_curr.ptr < i_end1_curr) {
+        v_fa0 = ((uint8_t)((v_fa0 / 2) + v_curr.ptr[0]));
+        v_curr.ptr[0] = v_fa0;
+        v_fa1 = ((uint8_t)((v_fa1 / 2) + v_curr.ptr[1]));
+        v_curr.ptr[1] = v_fa1;
+        v_fa2 = ((uint8_t)((v_fa2 / 2) + v_curr.ptr[2]));
+        v_curr.ptr[2] = v_fa2;
+        v_curr.ptr += 3;
+      }
+      v_curr.len = 0;
+    }
+  } else {
+    {
+      wuffs_base__slice_u8 i_slice_curr = a_curr;
+      v_curr.ptr = i_slice_curr.ptr;
+      wuffs_base__slice_u8 i_slice_prev = a_prev;
+      v_prev.ptr = i_slice_prev.ptr;
+      i_slice_curr.len = ((size_t)(wuffs_base__u64__min(i_slice_curr.len, i_slice_prev.len)));
+      v_curr.len = 3;
+      v_prev.len = 3;
+      uint8_t* i_end0_curr = v_curr.ptr + (((i_slice_curr.len - (size_t)(v_curr.ptr - i_slice_curr.ptr)) / 6) * 6);
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_curr.ptr < i_end0_curr) {
+        v_fa0 = ((uint8_t)(((uint8_t)(((((uint32_t)(v_fa0)) + ((uint32_t)(v_prev.ptr[0]))) / 2))) + v_curr.ptr[0]));
+        v_curr.ptr[0] = v_fa0;
+        v_fa1 = ((uint8_t)(((uint8_t)(((((uint32_t)(v_fa1)) + ((uint32_t)(v_prev.ptr[1]))) / 2))) + v_curr.ptr[1]));
+        v_curr.ptr[1] = v_fa1;
+        v_fa2 = ((uint8_t)(((uint8_t)(((((uint32_t)(v_fa2)) + ((uint32_t)(v_prev.ptr[2]))) / 2))) + v_curr.ptr[2]));
+        v_curr.ptr[2] = v_fa2;
+        v_curr.ptr += 3;
+        v_prev.ptr += 3;
+        v_fa0 = ((uint8_t)(((uint8_t)(((((uint32_t)(v_fa0)) + ((uint32_t)(v_prev.ptr[0]))) / 2))) + v_curr.ptr[0]));
+        v_curr.ptr[0] = v_fa0;
+        v_fa1 = ((uint8_t)(((uint8_t)(((((uint32_t)(v_fa1)) + ((uint32_t)(v_prev.ptr[1]))) / 2))) + v_curr.ptr[1]));
+        v_curr.ptr[1] = v_fa1;
+        v_fa2 = ((uint8_t)(((uint8_t)(((((uint32_t)(v_fa2)) + ((uint32_t)(v_prev.ptr[2]))) / 2))) + v_curr.ptr[2]));
+        v_curr.ptr[2] = v_fa2;
+        v_curr.ptr += 3;
+        v_prev.ptr += 3;
+      }
+      v_curr.len = 3;
+      v_prev.len = 3;
+      uint8_t* i_end1_curr = v_curr.ptr + (((i_slice_curr.len - (size_t)(v_curr.ptr - i_slice_curr.ptr)) / 3) * 3);
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_curr.ptr < i_end1_curr) {
+        v_fa0 = ((uint8_t)(((uint8_t)(((((uint32_t)(v_fa0)) + ((uint32_t)(v_prev.ptr[0]))) / 2))) + v_curr.ptr[0]));
+        v_curr.ptr[0] = v_fa0;
+        v_fa1 = ((uint8_t)(((uint8_t)(((((uint32_t)(v_fa1)) + ((uint32_t)(v_prev.ptr[1]))) / 2))) + v_curr.ptr[1]));
+        v_curr.ptr[1] = v_fa1;
+        v_fa2 = ((uint8_t)(((uint8_t)(((((uint32_t)(v_fa2)) + ((uint32_t)(v_prev.ptr[2]))) / 2))) + v_curr.ptr[2]));
+        v_curr.ptr[2] = v_fa2;
+        v_curr.ptr += 3;
+        v_prev.ptr += 3;
+      }
+      v_curr.len = 0;
+      v_prev.len = 0;
+    }
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func png.decoder.filter_3_distance_4_fallback
+
+static wuffs_base__empty_struct
+wuffs_png__decoder__filter_3_distance_4_fallback(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev) {
+  wuffs_base__slice_u8 v_curr = {0};
+  wuffs_base__slice_u8 v_prev = {0};
+  uint8_t v_fa0 = 0;
+  uint8_t v_fa1 = 0;
+  uint8_t v_fa2 = 0;
+  uint8_t v_fa3 = 0;
+
+  if (((uint64_t)(a_prev.len)) == 0) {
+    {
+      wuffs_base__slice_u8 i_slice_curr = a_curr;
+      v_curr.ptr = i_slice_curr.ptr;
+      v_curr.len = 4;
+      uint8_t* i_end0_curr = v_curr.ptr + (((i_slice_curr.len - (size_t)(v_curr.ptr - i_slice_curr.ptr)) / 4) * 4);
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_curr.ptr < i_end0_curr) {
+        v_fa0 = ((uint8_t)((v_fa0 / 2) + v_curr.ptr[0]));
+        v_curr.ptr[0] = v_fa0;
+        v_fa1 = ((uint8_t)((v_fa1 / 2) + v_curr.ptr[1]));
+        v_curr.ptr[1] = v_fa1;
+        v_fa2 = ((uint8_t)((v_fa2 / 2) + v_curr.ptr[2]));
+        v_curr.ptr[2] = v_fa2;
+        v_fa3 = ((uint8_t)((v_fa3 / 2) + v_curr.ptr[3]));
+        v_curr.ptr[3] = v_fa3;
+        v_curr.ptr += 4;
+      }
+      v_curr.len = 0;
+    }
+  } else {
+    {
+      wuffs_base__slice_u8 i_slice_curr = a_curr;
+      v_curr.ptr = i_slice_curr.ptr;
+      wuffs_base__slice_u8 i_slice_prev = a_prev;
+      v_prev.ptr = i_slice_prev.ptr;
+      i_slice_curr.len = ((size_t)(wuffs_base__u64__min(i_slice_curr.len, i_slice_prev.len)));
+      v_curr.len = 4;
+      v_prev.len = 4;
+      uint8_t* i_end0_curr = v_curr.ptr + (((i_slice_curr.len - (size_t)(v_curr.ptr - i_slice_curr.ptr)) / 4) * 4);
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_curr.ptr < i_end0_curr) {
+        v_fa0 = ((uint8_t)(((uint8_t)(((((uint32_t)(v_fa0)) + ((uint32_t)(v_prev.ptr[0]))) / 2))) + v_curr.ptr[0]));
+        v_curr.ptr[0] = v_fa0;
+        v_fa1 = ((uint8_t)(((uint8_t)(((((uint32_t)(v_fa1)) + ((uint32_t)(v_prev.ptr[1]))) / 2))) + v_curr.ptr[1]));
+        v_curr.ptr[1] = v_fa1;
+        v_fa2 = ((uint8_t)(((uint8_t)(((((uint32_t)(v_fa2)) + ((uint32_t)(v_prev.ptr[2]))) / 2))) + v_curr.ptr[2]));
+        v_curr.ptr[2] = v_fa2;
+        v_fa3 = ((uint8_t)(((uint8_t)(((((uint32_t)(v_fa3)) + ((uint32_t)(v_prev.ptr[3]))) / 2))) + v_curr.ptr[3]));
+        v_curr.ptr[3] = v_fa3;
+        v_curr.ptr += 4;
+        v_prev.ptr += 4;
+      }
+      v_curr.len = 0;
+      v_prev.len = 0;
+    }
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func png.decoder.filter_4
+
+static wuffs_base__empty_struct
+wuffs_png__decoder__filter_4(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev) {
+  return (*self->private_impl.choosy_filter_4)(self, a_curr, a_prev);
+}
+
+static wuffs_base__empty_struct
+wuffs_png__decoder__filter_4__choosy_default(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev) {
+  uint64_t v_filter_distance = 0;
+  uint64_t v_n = 0;
+  uint64_t v_i = 0;
+  uint32_t v_fa = 0;
+  uint32_t v_fb = 0;
+  uint32_t v_fc = 0;
+  uint32_t v_pp = 0;
+  uint32_t v_pa = 0;
+  uint32_t v_pb = 0;
+  uint32_t v_pc = 0;
+
+  v_filter_distance = ((uint64_t)(self->private_impl.f_filter_distance));
+  v_n = wuffs_base__u64__min(((uint64_t)(a_curr.len)), ((uint64_t)(a_prev.len)));
+  v_i = 0;
+  while ((v_i < v_n) && (v_i < v_filter_distance)) {
+    a_curr.ptr[v_i] = ((uint8_t)(a_curr.ptr[v_i] + a_prev.ptr[v_i]));
+    v_i += 1;
+  }
+  v_i = v_filter_distance;
+  while (v_i < v_n) {
+    v_fa = ((uint32_t)(a_curr.ptr[(v_i - v_filter_distance)]));
+    v_fb = ((uint32_t)(a_prev.ptr[v_i]));
+    v_fc = ((uint32_t)(a_prev.ptr[(v_i - v_filter_distance)]));
+    v_pp = ((uint32_t)(((uint32_t)(v_fa + v_fb)) - v_fc));
+    v_pa = ((uint32_t)(v_pp - v_fa));
+    if (v_pa >= 2147483648) {
+      v_pa = ((uint32_t)(0 - v_pa));
+    }
+    v_pb = ((uint32_t)(v_pp - v_fb));
+    if (v_pb >= 2147483648) {
+      v_pb = ((uint32_t)(0 - v_pb));
+    }
+    v_pc = ((uint32_t)(v_pp - v_fc));
+    if (v_pc >= 2147483648) {
+      v_pc = ((uint32_t)(0 - v_pc));
+    }
+    if ((v_pa <= v_pb) && (v_pa <= v_pc)) {
+    } else if (v_pb <= v_pc) {
+      v_fa = v_fb;
+    } else {
+      v_fa = v_fc;
+    }
+    a_curr.ptr[v_i] = ((uint8_t)(a_curr.ptr[v_i] + ((uint8_t)((v_fa & 255)))));
+    v_i += 1;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func png.decoder.filter_4_distance_3_fallback
+
+static wuffs_base__empty_struct
+wuffs_png__decoder__filter_4_distance_3_fallback(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev) {
+  wuffs_base__slice_u8 v_curr = {0};
+  wuffs_base__slice_u8 v_prev = {0};
+  uint32_t v_fa0 = 0;
+  uint32_t v_fa1 = 0;
+  uint32_t v_fa2 = 0;
+  uint32_t v_fb0 = 0;
+  uint32_t v_fb1 = 0;
+  uint32_t v_fb2 = 0;
+  uint32_t v_fc0 = 0;
+  uint32_t v_fc1 = 0;
+  uint32_t v_fc2 = 0;
+  uint32_t v_pp0 = 0;
+  uint32_t v_pp1 = 0;
+  uint32_t v_pp2 = 0;
+  uint32_t v_pa0 = 0;
+  uint32_t v_pa1 = 0;
+  uint32_t v_pa2 = 0;
+  uint32_t v_pb0 = 0;
+  uint32_t v_pb1 = 0;
+  uint32_t v_pb2 = 0;
+  uint32_t v_pc0 = 0;
+  uint32_t v_pc1 = 0;
+  uint32_t v_pc2 = 0;
+
+  {
+    wuffs_base__slice_u8 i_slice_curr = a_curr;
+    v_curr.ptr = i_slice_curr.ptr;
+    wuffs_base__slice_u8 i_slice_prev = a_prev;
+    v_prev.ptr = i_slice_prev.ptr;
+    i_slice_curr.len = ((size_t)(wuffs_base__u64__min(i_slice_curr.len, i_slice_prev.len)));
+    v_curr.len = 3;
+    v_prev.len = 3;
+    uint8_t* i_end0_curr = v_curr.ptr + (((i_slice_curr.len - (size_t)(v_curr.ptr - i_slice_curr.ptr)) / 3) * 3);
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_curr.ptr < i_end0_curr) {
+      v_fb0 = ((uint32_t)(v_prev.ptr[0]));
+      v_pp0 = ((uint32_t)(((uint32_t)(v_fa0 + v_fb0)) - v_fc0));
+      v_pa0 = ((uint32_t)(v_pp0 - v_fa0));
+      if (v_pa0 >= 2147483648) {
+        v_pa0 = ((uint32_t)(0 - v_pa0));
+      }
+      v_pb0 = ((uint32_t)(v_pp0 - v_fb0));
+      if (v_pb0 >= 2147483648) {
+        v_pb0 = ((uint32_t)(0 - v_pb0));
+      }
+      v_pc0 = ((uint32_t)(v_pp0 - v_fc0));
+      if (v_pc0 >= 2147483648) {
+        v_pc0 = ((uint32_t)(0 - v_pc0));
+      }
+      if ((v_pa0 <= v_pb0) && (v_pa0 <= v_pc0)) {
+      } else if (v_pb0 <= v_pc0) {
+        v_fa0 = v_fb0;
+      } else {
+        v_fa0 = v_fc0;
+      }
+      v_curr.ptr[0] = ((uint8_t)(v_curr.ptr[0] + ((uint8_t)((v_fa0 & 255)))));
+      v_fa0 = ((uint32_t)(v_curr.ptr[0]));
+      v_fc0 = v_fb0;
+      v_fb1 = ((uint32_t)(v_prev.ptr[1]));
+      v_pp1 = ((uint32_t)(((uint32_t)(v_fa1 + v_fb1)) - v_fc1));
+      v_pa1 = ((uint32_t)(v_pp1 - v_fa1));
+      if (v_pa1 >= 2147483648) {
+        v_pa1 = ((uint32_t)(0 - v_pa1));
+      }
+      v_pb1 = ((uint32_t)(v_pp1 - v_fb1));
+      if (v_pb1 >= 2147483648) {
+        v_pb1 = ((uint32_t)(0 - v_pb1));
+      }
+      v_pc1 = ((uint32_t)(v_pp1 - v_fc1));
+      if (v_pc1 >= 2147483648) {
+        v_pc1 = ((uint32_t)(0 - v_pc1));
+      }
+      if ((v_pa1 <= v_pb1) && (v_pa1 <= v_pc1)) {
+      } else if (v_pb1 <= v_pc1) {
+        v_fa1 = v_fb1;
+      } else {
+        v_fa1 = v_fc1;
+      }
+      v_curr.ptr[1] = ((uint8_t)(v_curr.ptr[1] + ((uint8_t)((v_fa1 & 255)))));
+      v_fa1 = ((uint32_t)(v_curr.ptr[1]));
+      v_fc1 = v_fb1;
+      v_fb2 = ((uint32_t)(v_prev.ptr[2]));
+      v_pp2 = ((uint32_t)(((uint32_t)(v_fa2 + v_fb2)) - v_fc2));
+      v_pa2 = ((uint32_t)(v_pp2 - v_fa2));
+      if (v_pa2 >= 2147483648) {
+        v_pa2 = ((uint32_t)(0 - v_pa2));
+      }
+      v_pb2 = ((uint32_t)(v_pp2 - v_fb2));
+      if (v_pb2 >= 2147483648) {
+        v_pb2 = ((uint32_t)(0 - v_pb2));
+      }
+      v_pc2 = ((uint32_t)(v_pp2 - v_fc2));
+      if (v_pc2 >= 2147483648) {
+        v_pc2 = ((uint32_t)(0 - v_pc2));
+      }
+      if ((v_pa2 <= v_pb2) && (v_pa2 <= v_pc2)) {
+      } else if (v_pb2 <= v_pc2) {
+        v_fa2 = v_fb2;
+      } else {
+        v_fa2 = v_fc2;
+      }
+      v_curr.ptr[2] = ((uint8_t)(v_curr.ptr[2] + ((uint8_t)((v_fa2 & 255)))));
+      v_fa2 = ((uint32_t)(v_curr.ptr[2]));
+      v_fc2 = v_fb2;
+      v_curr.ptr += 3;
+      v_prev.ptr += 3;
+    }
+    v_curr.len = 0;
+    v_prev.len = 0;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func png.decoder.filter_4_distance_4_fallback
+
+static wuffs_base__empty_struct
+wuffs_png__decoder__filter_4_distance_4_fallback(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev) {
+  wuffs_base__slice_u8 v_curr = {0};
+  wuffs_base__slice_u8 v_prev = {0};
+  uint32_t v_fa0 = 0;
+  uint32_t v_fa1 = 0;
+  uint32_t v_fa2 = 0;
+  uint32_t v_fa3 = 0;
+  uint32_t v_fb0 = 0;
+  uint32_t v_fb1 = 0;
+  uint32_t v_fb2 = 0;
+  uint32_t v_fb3 = 0;
+  uint32_t v_fc0 = 0;
+  uint32_t v_fc1 = 0;
+  uint32_t v_fc2 = 0;
+  uint32_t v_fc3 = 0;
+  uint32_t v_pp0 = 0;
+  uint32_t v_pp1 = 0;
+  uint32_t v_pp2 = 0;
+  uint32_t v_pp3 = 0;
+  uint32_t v_pa0 = 0;
+  uint32_t v_pa1 = 0;
+  uint32_t v_pa2 = 0;
+  uint32_t v_pa3 = 0;
+  uint32_t v_pb0 = 0;
+  uint32_t v_pb1 = 0;
+  uint32_t v_pb2 = 0;
+  uint32_t v_pb3 = 0;
+  uint32_t v_pc0 = 0;
+  uint32_t v_pc1 = 0;
+  uint32_t v_pc2 = 0;
+  uint32_t v_pc3 = 0;
+
+  {
+    wuffs_base__slice_u8 i_slice_curr = a_curr;
+    v_curr.ptr = i_slice_curr.ptr;
+    wuffs_base__slice_u8 i_slice_prev = a_prev;
+    v_prev.ptr = i_slice_prev.ptr;
+    i_slice_curr.len = ((size_t)(wuffs_base__u64__min(i_slice_curr.len, i_slice_prev.len)));
+    v_curr.len = 4;
+    v_prev.len = 4;
+    uint8_t* i_end0_curr = v_curr.ptr + (((i_slice_curr.len - (size_t)(v_curr.ptr - i_slice_curr.ptr)) / 4) * 4);
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_curr.ptr < i_end0_curr) {
+      v_fb0 = ((uint32_t)(v_prev.ptr[0]));
+      v_pp0 = ((uint32_t)(((uint32_t)(v_fa0 + v_fb0)) - v_fc0));
+      v_pa0 = ((uint32_t)(v_pp0 - v_fa0));
+      if (v_pa0 >= 2147483648) {
+        v_pa0 = ((uint32_t)(0 - v_pa0));
+      }
+      v_pb0 = ((uint32_t)(v_pp0 - v_fb0));
+      if (v_pb0 >= 2147483648) {
+        v_pb0 = ((uint32_t)(0 - v_pb0));
+      }
+      v_pc0 = ((uint32_t)(v_pp0 - v_fc0));
+      if (v_pc0 >= 2147483648) {
+        v_pc0 = ((uint32_t)(0 - v_pc0));
+      }
+      if ((v_pa0 <= v_pb0) && (v_pa0 <= v_pc0)) {
+      } else if (v_pb0 <= v_pc0) {
+        v_fa0 = v_fb0;
+      } else {
+        v_fa0 = v_fc0;
+      }
+      v_curr.ptr[0] = ((uint8_t)(v_curr.ptr[0] + ((uint8_t)((v_fa0 & 255)))));
+      v_fa0 = ((uint32_t)(v_curr.ptr[0]));
+      v_fc0 = v_fb0;
+      v_fb1 = ((uint32_t)(v_prev.ptr[1]));
+      v_pp1 = ((uint32_t)(((uint32_t)(v_fa1 + v_fb1)) - v_fc1));
+      v_pa1 = ((uint32_t)(v_pp1 - v_fa1));
+      if (v_pa1 >= 2147483648) {
+        v_pa1 = ((uint32_t)(0 - v_pa1));
+      }
+      v_pb1 = ((uint32_t)(v_pp1 - v_fb1));
+      if (v_pb1 >= 2147483648) {
+        v_pb1 = ((uint32_t)(0 - v_pb1));
+      }
+      v_pc1 = ((uint32_t)(v_pp1 - v_fc1));
+      if (v_pc1 >= 2147483648) {
+        v_pc1 = ((uint32_t)(0 - v_pc1));
+      }
+      if ((v_pa1 <= v_pb1) && (v_pa1 <= v_pc1)) {
+      } else if (v_pb1 <= v_pc1) {
+        v_fa1 = v_fb1;
+      } else {
+        v_fa1 = v_fc1;
+      }
+      v_curr.ptr[1] = ((uint8_t)(v_curr.ptr[1] + ((uint8_t)((v_fa1 & 255)))));
+      v_fa1 = ((uint32_t)(v_curr.ptr[1]));
+      v_fc1 = v_fb1;
+      v_fb2 = ((uint32_t)(v_prev.ptr[2]));
+      v_pp2 = ((uint32_t)(((uint32_t)(v_fa2 + v_fb2)) - v_fc2));
+      v_pa2 = ((uint32_t)(v_pp2 - v_fa2));
+      if (v_pa2 >= 2147483648) {
+        v_pa2 = ((uint32_t)(0 - v_pa2));
+      }
+      v_pb2 = ((uint32_t)(v_pp2 - v_fb2));
+      if (v_pb2 >= 2147483648) {
+        v_pb2 = ((uint32_t)(0 - v_pb2));
+      }
+      v_pc2 = ((uint32_t)(v_pp2 - v_fc2));
+      if (v_pc2 >= 2147483648) {
+        v_pc2 = ((uint32_t)(0 - v_pc2));
+      }
+      if ((v_pa2 <= v_pb2) && (v_pa2 <= v_pc2)) {
+      } else if (v_pb2 <= v_pc2) {
+        v_fa2 = v_fb2;
+      } else {
+        v_fa2 = v_fc2;
+      }
+      v_curr.ptr[2] = ((uint8_t)(v_curr.ptr[2] + ((uint8_t)((v_fa2 & 255)))));
+      v_fa2 = ((uint32_t)(v_curr.ptr[2]));
+      v_fc2 = v_fb2;
+      v_fb3 = ((uint32_t)(v_prev.ptr[3]));
+      v_pp3 = ((uint32_t)(((uint32_t)(v_fa3 + v_fb3)) - v_fc3));
+      v_pa3 = ((uint32_t)(v_pp3 - v_fa3));
+      if (v_pa3 >= 2147483648) {
+        v_pa3 = ((uint32_t)(0 - v_pa3));
+      }
+      v_pb3 = ((uint32_t)(v_pp3 - v_fb3));
+      if (v_pb3 >= 2147483648) {
+        v_pb3 = ((uint32_t)(0 - v_pb3));
+      }
+      v_pc3 = ((uint32_t)(v_pp3 - v_fc3));
+      if (v_pc3 >= 2147483648) {
+        v_pc3 = ((uint32_t)(0 - v_pc3));
+      }
+      if ((v_pa3 <= v_pb3) && (v_pa3 <= v_pc3)) {
+      } else if (v_pb3 <= v_pc3) {
+        v_fa3 = v_fb3;
+      } else {
+        v_fa3 = v_fc3;
+      }
+      v_curr.ptr[3] = ((uint8_t)(v_curr.ptr[3] + ((uint8_t)((v_fa3 & 255)))));
+      v_fa3 = ((uint32_t)(v_curr.ptr[3]));
+      v_fc3 = v_fb3;
+      v_curr.ptr += 4;
+      v_prev.ptr += 4;
+    }
+    v_curr.len = 0;
+    v_prev.len = 0;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// ‼ WUFFS MULTI-FILE SECTION +x86_sse42
+// -------- func png.decoder.filter_1_distance_4_x86_sse42
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+static wuffs_base__empty_struct
+wuffs_png__decoder__filter_1_distance_4_x86_sse42(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_curr) {
+  wuffs_base__slice_u8 v_curr = {0};
+  __m128i v_x128 = {0};
+  __m128i v_a128 = {0};
+
+  {
+    wuffs_base__slice_u8 i_slice_curr = a_curr;
+    v_curr.ptr = i_slice_curr.ptr;
+    v_curr.len = 4;
+    uint8_t* i_end0_curr = v_curr.ptr + (((i_slice_curr.len - (size_t)(v_curr.ptr - i_slice_curr.ptr)) / 8) * 8);
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_curr.ptr < i_end0_curr) {
+      v_x128 = _mm_cvtsi32_si128((int32_t)(wuffs_base__peek_u32le__no_bounds_check(v_curr.ptr)));
+      v_x128 = _mm_add_epi8(v_x128, v_a128);
+      v_a128 = v_x128;
+      wuffs_base__poke_u32le__no_bounds_check(v_curr.ptr, ((uint32_t)(_mm_cvtsi128_si32(v_x128))));
+      v_curr.ptr += 4;
+      v_x128 = _mm_cvtsi32_si128((int32_t)(wuffs_base__peek_u32le__no_bounds_check(v_curr.ptr)));
+      v_x128 = _mm_add_epi8(v_x128, v_a128);
+      v_a128 = v_x128;
+      wuffs_base__poke_u32le__no_bounds_check(v_curr.ptr, ((uint32_t)(_mm_cvtsi128_si32(v_x128))));
+      v_curr.ptr += 4;
+    }
+    v_curr.len = 4;
+    uint8_t* i_end1_curr = v_curr.ptr + (((i_slice_curr.len - (size_t)(v_curr.ptr - i_slice_curr.ptr)) / 4) * 4);
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_curr.ptr < i_end1_curr) {
+      v_x128 = _mm_cvtsi32_si128((int32_t)(wuffs_base__peek_u32le__no_bounds_check(v_curr.ptr)));
+      v_x128 = _mm_add_epi8(v_x128, v_a128);
+      v_a128 = v_x128;
+      wuffs_base__poke_u32le__no_bounds_check(v_curr.ptr, ((uint32_t)(_mm_cvtsi128_si32(v_x128))));
+      v_curr.ptr += 4;
+    }
+    v_curr.len = 0;
+  }
+  return wuffs_base__make_empty_struct();
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// ‼ WUFFS MULTI-FILE SECTION -x86_sse42
+
+// ‼ WUFFS MULTI-FILE SECTION +x86_sse42
+// -------- func png.decoder.filter_3_distance_4_x86_sse42
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+static wuffs_base__empty_struct
+wuffs_png__decoder__filter_3_distance_4_x86_sse42(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev) {
+  wuffs_base__slice_u8 v_curr = {0};
+  wuffs_base__slice_u8 v_prev = {0};
+  __m128i v_x128 = {0};
+  __m128i v_a128 = {0};
+  __m128i v_b128 = {0};
+  __m128i v_p128 = {0};
+  __m128i v_k128 = {0};
+
+  if (((uint64_t)(a_prev.len)) == 0) {
+    v_k128 = _mm_set1_epi8((int8_t)(254));
+    {
+      wuffs_base__slice_u8 i_slice_curr = a_curr;
+      v_curr.ptr = i_slice_curr.ptr;
+      v_curr.len = 4;
+      uint8_t* i_end0_curr = v_curr.ptr + (((i_slice_curr.len - (size_t)(v_curr.ptr - i_slice_curr.ptr)) / 8) * 8);
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_curr.ptr < i_end0_curr) {
+        v_p128 = _mm_avg_epu8(_mm_and_si128(v_a128, v_k128), v_b128);
+        v_x128 = _mm_cvtsi32_si128((int32_t)(wuffs_base__peek_u32le__no_bounds_check(v_curr.ptr)));
+        v_x128 = _mm_add_epi8(v_x128, v_p128);
+        v_a128 = v_x128;
+        wuffs_base__poke_u32le__no_bounds_check(v_curr.ptr, ((uint32_t)(_mm_cvtsi128_si32(v_x128))));
+        v_curr.ptr += 4;
+        v_p128 = _mm_avg_epu8(_mm_and_si128(v_a128, v_k128), v_b128);
+        v_x128 = _mm_cvtsi32_si128((int32_t)(wuffs_base__peek_u32le__no_bounds_check(v_curr.ptr)));
+        v_x128 = _mm_add_epi8(v_x128, v_p128);
+        v_a128 = v_x128;
+        wuffs_base__poke_u32le__no_bounds_check(v_curr.ptr, ((uint32_t)(_mm_cvtsi128_si32(v_x128))));
+        v_curr.ptr += 4;
+      }
+      v_curr.len = 4;
+      uint8_t* i_end1_curr = v_curr.ptr + (((i_slice_curr.len - (size_t)(v_curr.ptr - i_slice_curr.ptr)) / 4) * 4);
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_curr.ptr < i_end1_curr) {
+        v_p128 = _mm_avg_epu8(_mm_and_si128(v_a128, v_k128), v_b128);
+        v_x128 = _mm_cvtsi32_si128((int32_t)(wuffs_base__peek_u32le__no_bounds_check(v_curr.ptr)));
+        v_x128 = _mm_add_epi8(v_x128, v_p128);
+        v_a128 = v_x128;
+        wuffs_base__poke_u32le__no_bounds_check(v_curr.ptr, ((uint32_t)(_mm_cvtsi128_si32(v_x128))));
+        v_curr.ptr += 4;
+      }
+      v_curr.len = 0;
+    }
+  } else {
+    v_k128 = _mm_set1_epi8((int8_t)(1));
+    {
+      wuffs_base__slice_u8 i_slice_curr = a_curr;
+      v_curr.ptr = i_slice_curr.ptr;
+      wuffs_base__slice_u8 i_slice_prev = a_prev;
+      v_prev.ptr = i_slice_prev.ptr;
+      i_slice_curr.len = ((size_t)(wuffs_base__u64__min(i_slice_curr.len, i_slice_prev.len)));
+      v_curr.len = 4;
+      v_prev.len = 4;
+      uint8_t* i_end0_curr = v_curr.ptr + (((i_slice_curr.len - (size_t)(v_curr.ptr - i_slice_curr.ptr)) / 8) * 8);
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_curr.ptr < i_end0_curr) {
+        v_b128 = _mm_cvtsi32_si128((int32_t)(wuffs_base__peek_u32le__no_bounds_check(v_prev.ptr)));
+        v_p128 = _mm_avg_epu8(v_a128, v_b128);
+        v_p128 = _mm_sub_epi8(v_p128, _mm_and_si128(v_k128, _mm_xor_si128(v_a128, v_b128)));
+        v_x128 = _mm_cvtsi32_si128((int32_t)(wuffs_base__peek_u32le__no_bounds_check(v_curr.ptr)));
+        v_x128 = _mm_add_epi8(v_x128, v_p128);
+        v_a128 = v_x128;
+        wuffs_base__poke_u32le__no_bounds_check(v_curr.ptr, ((uint32_t)(_mm_cvtsi128_si32(v_x128))));
+        v_curr.ptr += 4;
+        v_prev.ptr += 4;
+        v_b128 = _mm_cvtsi32_si128((int32_t)(wuffs_base__peek_u32le__no_bounds_check(v_prev.ptr)));
+        v_p128 = _mm_avg_epu8(v_a128, v_b128);
+        v_p128 = _mm_sub_epi8(v_p128, _mm_and_si128(v_k128, _mm_xor_si128(v_a128, v_b128)));
+        v_x128 = _mm_cvtsi32_si128((int32_t)(wuffs_base__peek_u32le__no_bounds_check(v_curr.ptr)));
+        v_x128 = _mm_add_epi8(v_x128, v_p128);
+        v_a128 = v_x128;
+        wuffs_base__poke_u32le__no_bounds_check(v_curr.ptr, ((uint32_t)(_mm_cvtsi128_si32(v_x128))));
+        v_curr.ptr += 4;
+        v_prev.ptr += 4;
+      }
+      v_curr.len = 4;
+      v_prev.len = 4;
+      uint8_t* i_end1_curr = v_curr.ptr + (((i_slice_curr.len - (size_t)(v_curr.ptr - i_slice_curr.ptr)) / 4) * 4);
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_curr.ptr < i_end1_curr) {
+        v_b128 = _mm_cvtsi32_si128((int32_t)(wuffs_base__peek_u32le__no_bounds_check(v_prev.ptr)));
+        v_p128 = _mm_avg_epu8(v_a128, v_b128);
+        v_p128 = _mm_sub_epi8(v_p128, _mm_and_si128(v_k128, _mm_xor_si128(v_a128, v_b128)));
+        v_x128 = _mm_cvtsi32_si128((int32_t)(wuffs_base__peek_u32le__no_bounds_check(v_curr.ptr)));
+        v_x128 = _mm_add_epi8(v_x128, v_p128);
+        v_a128 = v_x128;
+        wuffs_base__poke_u32le__no_bounds_check(v_curr.ptr, ((uint32_t)(_mm_cvtsi128_si32(v_x128))));
+        v_curr.ptr += 4;
+        v_prev.ptr += 4;
+      }
+      v_curr.len = 0;
+      v_prev.len = 0;
+    }
+  }
+  return wuffs_base__make_empty_struct();
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// ‼ WUFFS MULTI-FILE SECTION -x86_sse42
+
+// ‼ WUFFS MULTI-FILE SECTION +x86_sse42
+// -------- func png.decoder.filter_4_distance_3_x86_sse42
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+static wuffs_base__empty_struct
+wuffs_png__decoder__filter_4_distance_3_x86_sse42(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev) {
+  wuffs_base__slice_u8 v_curr = {0};
+  wuffs_base__slice_u8 v_prev = {0};
+  __m128i v_x128 = {0};
+  __m128i v_a128 = {0};
+  __m128i v_b128 = {0};
+  __m128i v_c128 = {0};
+  __m128i v_p128 = {0};
+  __m128i v_pa128 = {0};
+  __m128i v_pb128 = {0};
+  __m128i v_pc128 = {0};
+  __m128i v_smallest128 = {0};
+  __m128i v_z128 = {0};
+
+  {
+    wuffs_base__slice_u8 i_slice_curr = a_curr;
+    v_curr.ptr = i_slice_curr.ptr;
+    wuffs_base__slice_u8 i_slice_prev = a_prev;
+    v_prev.ptr = i_slice_prev.ptr;
+    i_slice_curr.len = ((size_t)(wuffs_base__u64__min(i_slice_curr.len, i_slice_prev.len)));
+    v_curr.len = 4;
+    v_prev.len = 4;
+    uint8_t* i_end0_curr = v_curr.ptr + wuffs_base__iterate_total_advance((i_slice_curr.len - (size_t)(v_curr.ptr - i_slice_curr.ptr)), 7, 6);
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_curr.ptr < i_end0_curr) {
+      v_b128 = _mm_cvtsi32_si128((int32_t)(wuffs_base__peek_u32le__no_bounds_check(v_prev.ptr)));
+      v_b128 = _mm_unpacklo_epi8(v_b128, v_z128);
+      v_pa128 = _mm_sub_epi16(v_b128, v_c128);
+      v_pb128 = _mm_sub_epi16(v_a128, v_c128);
+      v_pc128 = _mm_add_epi16(v_pa128, v_pb128);
+      v_pa128 = _mm_abs_epi16(v_pa128);
+      v_pb128 = _mm_abs_epi16(v_pb128);
+      v_pc128 = _mm_abs_epi16(v_pc128);
+      v_smallest128 = _mm_min_epi16(v_pc128, _mm_min_epi16(v_pb128, v_pa128));
+      v_p128 = _mm_blendv_epi8(_mm_blendv_epi8(v_c128, v_b128, _mm_cmpeq_epi16(v_smallest128, v_pb128)), v_a128, _mm_cmpeq_epi16(v_smallest128, v_pa128));
+      v_x128 = _mm_cvtsi32_si128((int32_t)(wuffs_base__peek_u32le__no_bounds_check(v_curr.ptr)));
+      v_x128 = _mm_unpacklo_epi8(v_x128, v_z128);
+      v_x128 = _mm_add_epi8(v_x128, v_p128);
+      v_a128 = v_x128;
+      v_c128 = v_b128;
+      v_x128 = _mm_packus_epi16(v_x128, v_x128);
+      wuffs_base__poke_u24le__no_bounds_check(v_curr.ptr, ((uint32_t)(_mm_cvtsi128_si32(v_x128))));
+      v_curr.ptr += 3;
+      v_prev.ptr += 3;
+      v_b128 = _mm_cvtsi32_si128((int32_t)(wuffs_base__peek_u32le__no_bounds_check(v_prev.ptr)));
+      v_b128 = _mm_unpacklo_epi8(v_b128, v_z128);
+      v_pa128 = _mm_sub_epi16(v_b128, v_c128);
+      v_pb128 = _mm_sub_epi16(v_a128, v_c128);
+      v_pc128 = _mm_add_epi16(v_pa128, v_pb128);
+      v_pa128 = _mm_abs_epi16(v_pa128);
+      v_pb128 = _mm_abs_epi16(v_pb128);
+      v_pc128 = _mm_abs_epi16(v_pc128);
+      v_smallest128 = _mm_min_epi16(v_pc128, _mm_min_epi16(v_pb128, v_pa128));
+      v_p128 = _mm_blendv_epi8(_mm_blendv_epi8(v_c128, v_b128, _mm_cmpeq_epi16(v_smallest128, v_pb128)), v_a128, _mm_cmpeq_epi16(v_smallest128, v_pa128));
+      v_x128 = _mm_cvtsi32_si128((int32_t)(wuffs_base__peek_u32le__no_bounds_check(v_curr.ptr)));
+      v_x128 = _mm_unpacklo_epi8(v_x128, v_z128);
+      v_x128 = _mm_add_epi8(v_x128, v_p128);
+      v_a128 = v_x128;
+      v_c128 = v_b128;
+      v_x128 = _mm_packus_epi16(v_x128, v_x128);
+      wuffs_base__poke_u24le__no_bounds_check(v_curr.ptr, ((uint32_t)(_mm_cvtsi128_si32(v_x128))));
+      v_curr.ptr += 3;
+      v_prev.ptr += 3;
+    }
+    v_curr.len = 4;
+    v_prev.len = 4;
+    uint8_t* i_end1_curr = v_curr.ptr + wuffs_base__iterate_total_advance((i_slice_curr.len - (size_t)(v_curr.ptr - i_slice_curr.ptr)), 4, 3);
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_curr.ptr < i_end1_curr) {
+      v_b128 = _mm_cvtsi32_si128((int32_t)(wuffs_base__peek_u32le__no_bounds_check(v_prev.ptr)));
+      v_b128 = _mm_unpacklo_epi8(v_b128, v_z128);
+      v_pa128 = _mm_sub_epi16(v_b128, v_c128);
+      v_pb128 = _mm_sub_epi16(v_a128, v_c128);
+      v_pc128 = _mm_add_epi16(v_pa128, v_pb128);
+      v_pa128 = _mm_abs_epi16(v_pa128);
+      v_pb128 = _mm_abs_epi16(v_pb128);
+      v_pc128 = _mm_abs_epi16(v_pc128);
+      v_smallest128 = _mm_min_epi16(v_pc128, _mm_min_epi16(v_pb128, v_pa128));
+      v_p128 = _mm_blendv_epi8(_mm_blendv_epi8(v_c128, v_b128, _mm_cmpeq_epi16(v_smallest128, v_pb128)), v_a128, _mm_cmpeq_epi16(v_smallest128, v_pa128));
+      v_x128 = _mm_cvtsi32_si128((int32_t)(wuffs_base__peek_u32le__no_bounds_check(v_curr.ptr)));
+      v_x128 = _mm_unpacklo_epi8(v_x128, v_z128);
+      v_x128 = _mm_add_epi8(v_x128, v_p128);
+      v_a128 = v_x128;
+      v_c128 = v_b128;
+      v_x128 = _mm_packus_epi16(v_x128, v_x128);
+      wuffs_base__poke_u24le__no_bounds_check(v_curr.ptr, ((uint32_t)(_mm_cvtsi128_si32(v_x128))));
+      v_curr.ptr += 3;
+      v_prev.ptr += 3;
+    }
+    v_curr.len = 3;
+    v_prev.len = 3;
+    uint8_t* i_end2_curr = v_curr.ptr + (((i_slice_curr.len - (size_t)(v_curr.ptr - i_slice_curr.ptr)) / 3) * 3);
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_curr.ptr < i_end2_curr) {
+      v_b128 = _mm_cvtsi32_si128((int32_t)(wuffs_base__peek_u24le__no_bounds_check(v_prev.ptr)));
+      v_b128 = _mm_unpacklo_epi8(v_b128, v_z128);
+      v_pa128 = _mm_sub_epi16(v_b128, v_c128);
+      v_pb128 = _mm_sub_epi16(v_a128, v_c128);
+      v_pc128 = _mm_add_epi16(v_pa128, v_pb128);
+      v_pa128 = _mm_abs_epi16(v_pa128);
+      v_pb128 = _mm_abs_epi16(v_pb128);
+      v_pc128 = _mm_abs_epi16(v_pc128);
+      v_smallest128 = _mm_min_epi16(v_pc128, _mm_min_epi16(v_pb128, v_pa128));
+      v_p128 = _mm_blendv_epi8(_mm_blendv_epi8(v_c128, v_b128, _mm_cmpeq_epi16(v_smallest128, v_pb128)), v_a128, _mm_cmpeq_epi16(v_smallest128, v_pa128));
+      v_x128 = _mm_cvtsi32_si128((int32_t)(wuffs_base__peek_u24le__no_bounds_check(v_curr.ptr)));
+      v_x128 = _mm_unpacklo_epi8(v_x128, v_z128);
+      v_x128 = _mm_add_epi8(v_x128, v_p128);
+      v_x128 = _mm_packus_epi16(v_x128, v_x128);
+      wuffs_base__poke_u24le__no_bounds_check(v_curr.ptr, ((uint32_t)(_mm_cvtsi128_si32(v_x128))));
+      v_curr.ptr += 3;
+      v_prev.ptr += 3;
+    }
+    v_curr.len = 0;
+    v_prev.len = 0;
+  }
+  return wuffs_base__make_empty_struct();
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// ‼ WUFFS MULTI-FILE SECTION -x86_sse42
+
+// ‼ WUFFS MULTI-FILE SECTION +x86_sse42
+// -------- func png.decoder.filter_4_distance_4_x86_sse42
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+static wuffs_base__empty_struct
+wuffs_png__decoder__filter_4_distance_4_x86_sse42(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev) {
+  wuffs_base__slice_u8 v_curr = {0};
+  wuffs_base__slice_u8 v_prev = {0};
+  __m128i v_x128 = {0};
+  __m128i v_a128 = {0};
+  __m128i v_b128 = {0};
+  __m128i v_c128 = {0};
+  __m128i v_p128 = {0};
+  __m128i v_pa128 = {0};
+  __m128i v_pb128 = {0};
+  __m128i v_pc128 = {0};
+  __m128i v_smallest128 = {0};
+  __m128i v_z128 = {0};
+
+  {
+    wuffs_base__slice_u8 i_slice_curr = a_curr;
+    v_curr.ptr = i_slice_curr.ptr;
+    wuffs_base__slice_u8 i_slice_prev = a_prev;
+    v_prev.ptr = i_slice_prev.ptr;
+    i_slice_curr.len = ((size_t)(wuffs_base__u64__min(i_slice_curr.len, i_slice_prev.len)));
+    v_curr.len = 4;
+    v_prev.len = 4;
+    uint8_t* i_end0_curr = v_curr.ptr + (((i_slice_curr.len - (size_t)(v_curr.ptr - i_slice_curr.ptr)) / 8) * 8);
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_curr.ptr < i_end0_curr) {
+      v_b128 = _mm_cvtsi32_si128((int32_t)(wuffs_base__peek_u32le__no_bounds_check(v_prev.ptr)));
+      v_b128 = _mm_unpacklo_epi8(v_b128, v_z128);
+      v_pa128 = _mm_sub_epi16(v_b128, v_c128);
+      v_pb128 = _mm_sub_epi16(v_a128, v_c128);
+      v_pc128 = _mm_add_epi16(v_pa128, v_pb128);
+      v_pa128 = _mm_abs_epi16(v_pa128);
+      v_pb128 = _mm_abs_epi16(v_pb128);
+      v_pc128 = _mm_abs_epi16(v_pc128);
+      v_smallest128 = _mm_min_epi16(v_pc128, _mm_min_epi16(v_pb128, v_pa128));
+      v_p128 = _mm_blendv_epi8(_mm_blendv_epi8(v_c128, v_b128, _mm_cmpeq_epi16(v_smallest128, v_pb128)), v_a128, _mm_cmpeq_epi16(v_smallest128, v_pa128));
+      v_x128 = _mm_cvtsi32_si128((int32_t)(wuffs_base__peek_u32le__no_bounds_check(v_curr.ptr)));
+      v_x128 = _mm_unpacklo_epi8(v_x128, v_z128);
+      v_x128 = _mm_add_epi8(v_x128, v_p128);
+      v_a128 = v_x128;
+      v_c128 = v_b128;
+      v_x128 = _mm_packus_epi16(v_x128, v_x128);
+      wuffs_base__poke_u32le__no_bounds_check(v_curr.ptr, ((uint32_t)(_mm_cvtsi128_si32(v_x128))));
+      v_curr.ptr += 4;
+      v_prev.ptr += 4;
+      v_b128 = _mm_cvtsi32_si128((int32_t)(wuffs_base__peek_u32le__no_bounds_check(v_prev.ptr)));
+      v_b128 = _mm_unpacklo_epi8(v_b128, v_z128);
+      v_pa128 = _mm_sub_epi16(v_b128, v_c128);
+      v_pb128 = _mm_sub_epi16(v_a128, v_c128);
+      v_pc128 = _mm_add_epi16(v_pa128, v_pb128);
+      v_pa128 = _mm_abs_epi16(v_pa128);
+      v_pb128 = _mm_abs_epi16(v_pb128);
+      v_pc128 = _mm_abs_epi16(v_pc128);
+      v_smallest128 = _mm_min_epi16(v_pc128, _mm_min_epi16(v_pb128, v_pa128));
+      v_p128 = _mm_blendv_epi8(_mm_blendv_epi8(v_c128, v_b128, _mm_cmpeq_epi16(v_smallest128, v_pb128)), v_a128, _mm_cmpeq_epi16(v_smallest128, v_pa128));
+      v_x128 = _mm_cvtsi32_si128((int32_t)(wuffs_base__peek_u32le__no_bounds_check(v_curr.ptr)));
+      v_x128 = _mm_unpacklo_epi8(v_x128, v_z128);
+      v_x128 = _mm_add_epi8(v_x128, v_p128);
+      v_a128 = v_x128;
+      v_c128 = v_b128;
+      v_x128 = _mm_packus_epi16(v_x128, v_x128);
+      wuffs_base__poke_u32le__no_bounds_check(v_curr.ptr, ((uint32_t)(_mm_cvtsi128_si32(v_x128))));
+      v_curr.ptr += 4;
+      v_prev.ptr += 4;
+    }
+    v_curr.len = 4;
+    v_prev.len = 4;
+    uint8_t* i_end1_curr = v_curr.ptr + (((i_slice_curr.len - (size_t)(v_curr.ptr - i_slice_curr.ptr)) / 4) * 4);
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_curr.ptr < i_end1_curr) {
+      v_b128 = _mm_cvtsi32_si128((int32_t)(wuffs_base__peek_u32le__no_bounds_check(v_prev.ptr)));
+      v_b128 = _mm_unpacklo_epi8(v_b128, v_z128);
+      v_pa128 = _mm_sub_epi16(v_b128, v_c128);
+      v_pb128 = _mm_sub_epi16(v_a128, v_c128);
+      v_pc128 = _mm_add_epi16(v_pa128, v_pb128);
+      v_pa128 = _mm_abs_epi16(v_pa128);
+      v_pb128 = _mm_abs_epi16(v_pb128);
+      v_pc128 = _mm_abs_epi16(v_pc128);
+      v_smallest128 = _mm_min_epi16(v_pc128, _mm_min_epi16(v_pb128, v_pa128));
+      v_p128 = _mm_blendv_epi8(_mm_blendv_epi8(v_c128, v_b128, _mm_cmpeq_epi16(v_smallest128, v_pb128)), v_a128, _mm_cmpeq_epi16(v_smallest128, v_pa128));
+      v_x128 = _mm_cvtsi32_si128((int32_t)(wuffs_base__peek_u32le__no_bounds_check(v_curr.ptr)));
+      v_x128 = _mm_unpacklo_epi8(v_x128, v_z128);
+      v_x128 = _mm_add_epi8(v_x128, v_p128);
+      v_a128 = v_x128;
+      v_c128 = v_b128;
+      v_x128 = _mm_packus_epi16(v_x128, v_x128);
+      wuffs_base__poke_u32le__no_bounds_check(v_curr.ptr, ((uint32_t)(_mm_cvtsi128_si32(v_x128))));
+      v_curr.ptr += 4;
+      v_prev.ptr += 4;
+    }
+    v_curr.len = 0;
+    v_prev.len = 0;
+  }
+  return wuffs_base__make_empty_struct();
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// ‼ WUFFS MULTI-FILE SECTION -x86_sse42
+
+// -------- func png.decoder.set_quirk_enabled
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_png__decoder__set_quirk_enabled(
+    wuffs_png__decoder* self,
+    uint32_t a_quirk,
+    bool a_enabled) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  if (a_quirk == 1) {
+    self->private_impl.f_ignore_checksum = a_enabled;
+    wuffs_zlib__decoder__set_quirk_enabled(&self->private_data.f_zlib, a_quirk, a_enabled);
+  } else if (a_quirk == 1554767872) {
+    self->private_impl.f_report_interlace_passes = a_enabled;
+  } else if (a_quirk == 1554767873) {
+    self->private_impl.f_replicate_interlace_passes = a_enabled;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func png.decoder.set_workbuf_prefilled
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_png__decoder__set_workbuf_prefilled(
+    wuffs_png__decoder* self,
+    bool a_prefilled) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_workbuf_prefilled = a_prefilled;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func png.decoder.decode_image_config
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_png__decoder__decode_image_config(
+    wuffs_png__decoder* self,
+    wuffs_base__image_config* a_dst,
+    wuffs_base__io_buffer* a_src) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+        ? wuffs_base__error__disabled_by_previous_error
+        : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 1)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint64_t v_magic = 0;
+  uint64_t v_mark = 0;
+  uint32_t v_checksum_have = 0;
+  uint32_t v_checksum_want = 0;
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_image_config[0];
+  if (coro_susp_point) {
+    v_checksum_have = self->private_data.s_decode_image_config[0].v_checksum_have;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_call_sequence == 2) {
+      if (self->private_impl.f_metadata_fourcc != 0) {
+        self->private_impl.f_call_sequence = 1;
+        status = wuffs_base__make_status(wuffs_base__note__metadata_reported);
+        goto ok;
+      }
+    } else if (self->private_impl.f_call_sequence != 0) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
+      goto exit;
+    } else {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        uint64_t t_0;
+        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 8)) {
+          t_0 = wuffs_base__peek_u64le__no_bounds_check(iop_a_src);
+          iop_a_src += 8;
+        } else {
+          self->private_data.s_decode_image_config[0].scratch = 0;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+          while (true) {
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint64_t* scratch = &self->private_data.s_decode_image_config[0].scratch;
+            uint32_t num_bits_0 = ((uint32_t)(*scratch >> 56));
+            *scratch <<= 8;
+            *scratch >>= 8;
+            *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_0;
+            if (num_bits_0 == 56) {
+              t_0 = ((uint64_t)(*scratch));
+              break;
+            }
+            num_bits_0 += 8;
+            *scratch |= ((uint64_t)(num_bits_0)) << 56;
+          }
+        }
+        v_magic = t_0;
+      }
+      if (v_magic != 727905341920923785) {
+        status = wuffs_base__make_status(wuffs_png__error__bad_header);
+        goto exit;
+      }
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+        uint64_t t_1;
+        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 8)) {
+          t_1 = wuffs_base__peek_u64le__no_bounds_check(iop_a_src);
+          iop_a_src += 8;
+        } else {
+          self->private_data.s_decode_image_config[0].scratch = 0;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+          while (true) {
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint64_t* scratch = &self->private_data.s_decode_image_config[0].scratch;
+            uint32_t num_bits_1 = ((uint32_t)(*scratch >> 56));
+            *scratch <<= 8;
+            *scratch >>= 8;
+            *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_1;
+            if (num_bits_1 == 56) {
+              t_1 = ((uint64_t)(*scratch));
+              break;
+            }
+            num_bits_1 += 8;
+            *scratch |= ((uint64_t)(num_bits_1)) << 56;
+          }
+        }
+        v_magic = t_1;
+      }
+      if (v_magic != 5927942488114331648) {
+        status = wuffs_base__make_status(wuffs_png__error__bad_header);
+        goto exit;
+      }
+      self->private_impl.f_chunk_type_array[0] = 73;
+      self->private_impl.f_chunk_type_array[1] = 72;
+      self->private_impl.f_chunk_type_array[2] = 68;
+      self->private_impl.f_chunk_type_array[3] = 82;
+      wuffs_base__ignore_status(wuffs_crc32__ieee_hasher__initialize(&self->private_data.f_crc32,
+          sizeof (wuffs_crc32__ieee_hasher), WUFFS_VERSION, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+      wuffs_crc32__ieee_hasher__update_u32(&self->private_data.f_crc32, wuffs_base__make_slice_u8(self->private_impl.f_chunk_type_array, 4));
+      while (true) {
+        v_mark = ((uint64_t)(iop_a_src - io0_a_src));
+        {
+          if (a_src) {
+            a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+          }
+          wuffs_base__status t_2 = wuffs_png__decoder__decode_ihdr(self, a_src);
+          v_status = t_2;
+          if (a_src) {
+            iop_a_src = a_src->data.ptr + a_src->meta.ri;
+          }
+        }
+        if ( ! self->private_impl.f_ignore_checksum) {
+          v_checksum_have = wuffs_crc32__ieee_hasher__update_u32(&self->private_data.f_crc32, wuffs_base__io__since(v_mark, ((uint64_t)(iop_a_src - io0_a_src)), io0_a_src));
+        }
+        if (wuffs_base__status__is_ok(&v_status)) {
+          goto label__0__break;
+        }
+        status = v_status;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(5);
+      }
+      label__0__break:;
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+        uint32_t t_3;
+        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+          t_3 = wuffs_base__peek_u32be__no_bounds_check(iop_a_src);
+          iop_a_src += 4;
+        } else {
+          self->private_data.s_decode_image_config[0].scratch = 0;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+          while (true) {
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint64_t* scratch = &self->private_data.s_decode_image_config[0].scratch;
+            uint32_t num_bits_3 = ((uint32_t)(*scratch & 0xFF));
+            *scratch >>= 8;
+            *scratch <<= 8;
+            *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_3);
+            if (num_bits_3 == 24) {
+              t_3 = ((uint32_t)(*scratch >> 32));
+              break;
+            }
+            num_bits_3 += 8;
+            *scratch |= ((uint64_t)(num_bits_3));
+          }
+        }
+        v_checksum_want = t_3;
+      }
+      if ( ! self->private_impl.f_ignore_checksum && (v_checksum_have != v_checksum_want)) {
+        status = wuffs_base__make_status(wuffs_png__error__bad_checksum);
+        goto exit;
+      }
+    }
+    while (true) {
+      while (((uint64_t)(io2_a_src - iop_a_src)) < 8) {
+        if (a_src && a_src->meta.closed) {
+          status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+          goto exit;
+        }
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(8);
+      }
+      self->private_impl.f_chunk_length = wuffs_base__peek_u32be__no_bounds_check(iop_a_src);
+      self->private_impl.f_chunk_type = ((uint32_t)((wuffs_base__peek_u64le__no_bounds_check(iop_a_src) >> 32)));
+      if (self->private_impl.f_chunk_type == 1413563465) {
+        if ( ! self->private_impl.f_seen_actl || self->private_impl.f_seen_fctl) {
+          goto label__1__break;
+        }
+        self->private_impl.f_seen_idat = true;
+      } else if (self->private_impl.f_chunk_type == 1413571686) {
+        if (self->private_impl.f_seen_idat && self->private_impl.f_seen_fctl) {
+          goto label__1__break;
+        }
+        status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+        goto exit;
+      }
+      iop_a_src += 8;
+      if ( ! self->private_impl.f_ignore_checksum && ((self->private_impl.f_chunk_type & 32) == 0)) {
+        self->private_impl.f_chunk_type_array[0] = ((uint8_t)(((self->private_impl.f_chunk_type >> 0) & 255)));
+        self->private_impl.f_chunk_type_array[1] = ((uint8_t)(((self->private_impl.f_chunk_type >> 8) & 255)));
+        self->private_impl.f_chunk_type_array[2] = ((uint8_t)(((self->private_impl.f_chunk_type >> 16) & 255)));
+        self->private_impl.f_chunk_type_array[3] = ((uint8_t)(((self->private_impl.f_chunk_type >> 24) & 255)));
+        wuffs_base__ignore_status(wuffs_crc32__ieee_hasher__initialize(&self->private_data.f_crc32,
+            sizeof (wuffs_crc32__ieee_hasher), WUFFS_VERSION, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+        wuffs_crc32__ieee_hasher__update_u32(&self->private_data.f_crc32, wuffs_base__make_slice_u8(self->private_impl.f_chunk_type_array, 4));
+      }
+      while (true) {
+        v_mark = ((uint64_t)(iop_a_src - io0_a_src));
+        {
+          if (a_src) {
+            a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+          }
+          wuffs_base__status t_4 = wuffs_png__decoder__decode_other_chunk(self, a_src);
+          v_status = t_4;
+          if (a_src) {
+            iop_a_src = a_src->data.ptr + a_src->meta.ri;
+          }
+        }
+        if ( ! self->private_impl.f_ignore_checksum && ((self->private_impl.f_chunk_type & 32) == 0)) {
+          v_checksum_have = wuffs_crc32__ieee_hasher__update_u32(&self->private_data.f_crc32, wuffs_base__io__since(v_mark, ((uint64_t)(iop_a_src - io0_a_src)), io0_a_src));
+        }
+        if (wuffs_base__status__is_ok(&v_status)) {
+          goto label__2__break;
+        }
+        status = v_status;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(9);
+      }
+      label__2__break:;
+      if (self->private_impl.f_metadata_fourcc != 0) {
+        self->private_impl.f_call_sequence = 1;
+        status = wuffs_base__make_status(wuffs_base__note__metadata_reported);
+        goto ok;
+      }
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(10);
+        uint32_t t_5;
+        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+          t_5 = wuffs_base__peek_u32be__no_bounds_check(iop_a_src);
+          iop_a_src += 4;
+        } else {
+          self->private_data.s_decode_image_config[0].scratch = 0;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(11);
+          while (true) {
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint64_t* scratch = &self->private_data.s_decode_image_config[0].scratch;
+            uint32_t num_bits_5 = ((uint32_t)(*scratch & 0xFF));
+            *scratch >>= 8;
+            *scratch <<= 8;
+            *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_5);
+            if (num_bits_5 == 24) {
+              t_5 = ((uint32_t)(*scratch >> 32));
+              break;
+            }
+            num_bits_5 += 8;
+            *scratch |= ((uint64_t)(num_bits_5));
+          }
+        }
+        v_checksum_want = t_5;
+      }
+      if ( ! self->private_impl.f_ignore_checksum && ((self->private_impl.f_chunk_type & 32) == 0) && (v_checksum_have != v_checksum_want)) {
+        status = wuffs_base__make_status(wuffs_png__error__bad_checksum);
+        goto exit;
+      }
+    }
+    label__1__break:;
+    if ((self->private_impl.f_color_type == 3) &&  ! self->private_impl.f_seen_plte) {
+      status = wuffs_base__make_status(wuffs_png__error__missing_palette);
+      goto exit;
+    }
+    self->private_impl.f_frame_config_io_position = wuffs_base__u64__sat_add((a_src ? a_src->meta.pos : 0), ((uint64_t)(iop_a_src - io0_a_src)));
+    self->private_impl.f_first_config_io_position = self->private_impl.f_frame_config_io_position;
+    self->private_impl.f_first_animation_seq_num = self->private_impl.f_next_animation_seq_num;
+    if (a_dst != NULL) {
+      wuffs_base__image_config__set(
+          a_dst,
+          self->private_impl.f_dst_pixfmt,
+          0,
+          self->private_impl.f_width,
+          self->private_impl.f_height,
+          self->private_impl.f_first_config_io_position,
+          ((self->private_impl.f_color_type <= 3) &&  ! self->private_impl.f_seen_trns));
+    }
+    if ( ! self->private_impl.f_seen_actl) {
+      self->private_impl.f_num_animation_frames_value = 1;
+      self->private_impl.f_first_rect_x0 = 0;
+      self->private_impl.f_first_rect_y0 = 0;
+      self->private_impl.f_first_rect_x1 = self->private_impl.f_width;
+      self->private_impl.f_first_rect_y1 = self->private_impl.f_height;
+      self->private_impl.f_first_duration = 0;
+      self->private_impl.f_first_disposal = 0;
+      self->private_impl.f_first_overwrite_instead_of_blend = false;
+    }
+    self->private_impl.f_call_sequence = 3;
+
+    ok:
+    self->private_impl.p_decode_image_config[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_image_config[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine = wuffs_base__status__is_suspension(&status) ? 1 : 0;
+  WUFFS_BASE__STATS__ADD(self->private_impl, WUFFS_BASE__STATS__SUSPENSIONS,
+      wuffs_base__status__is_suspension(&status) ? 1u : 0u);
+  self->private_data.s_decode_image_config[0].v_checksum_have = v_checksum_have;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func png.decoder.decode_ihdr
+
+static wuffs_base__status
+wuffs_png__decoder__decode_ihdr(
+    wuffs_png__decoder* self,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_a32 = 0;
+  uint8_t v_a8 = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_ihdr[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      uint32_t t_0;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+        t_0 = wuffs_base__peek_u32be__no_bounds_check(iop_a_src);
+        iop_a_src += 4;
+      } else {
+        self->private_data.s_decode_ihdr[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_ihdr[0].scratch;
+          uint32_t num_bits_0 = ((uint32_t)(*scratch & 0xFF));
+          *scratch >>= 8;
+          *scratch <<= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_0);
+          if (num_bits_0 == 24) {
+            t_0 = ((uint32_t)(*scratch >> 32));
+            break;
+          }
+          num_bits_0 += 8;
+          *scratch |= ((uint64_t)(num_bits_0));
+        }
+      }
+      v_a32 = t_0;
+    }
+    if ((v_a32 == 0) || (v_a32 >= 2147483648)) {
+      status = wuffs_base__make_status(wuffs_png__error__bad_header);
+      goto exit;
+    } else if (v_a32 >= 16777216) {
+      status = wuffs_base__make_status(wuffs_png__error__unsupported_png_file);
+      goto exit;
+    }
+    self->private_impl.f_width = v_a32;
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      uint32_t t_1;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+        t_1 = wuffs_base__peek_u32be__no_bounds_check(iop_a_src);
+        iop_a_src += 4;
+      } else {
+        self->private_data.s_decode_ihdr[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_ihdr[0].scratch;
+          uint32_t num_bits_1 = ((uint32_t)(*scratch & 0xFF));
+          *scratch >>= 8;
+          *scratch <<= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_1);
+          if (num_bits_1 == 24) {
+            t_1 = ((uint32_t)(*scratch >> 32));
+            break;
+          }
+          num_bits_1 += 8;
+          *scratch |= ((uint64_t)(num_bits_1));
+        }
+      }
+      v_a32 = t_1;
+    }
+    if ((v_a32 == 0) || (v_a32 >= 2147483648)) {
+      status = wuffs_base__make_status(wuffs_png__error__bad_header);
+      goto exit;
+    } else if (v_a32 >= 16777216) {
+      status = wuffs_base__make_status(wuffs_png__error__unsupported_png_file);
+      goto exit;
+    }
+    self->private_impl.f_height = v_a32;
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_2 = *iop_a_src++;
+      v_a8 = t_2;
+    }
+    if (v_a8 > 16) {
+      status = wuffs_base__make_status(wuffs_png__error__bad_header);
+      goto exit;
+    }
+    self->private_impl.f_depth = v_a8;
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_3 = *iop_a_src++;
+      v_a8 = t_3;
+    }
+    if ((v_a8 == 1) || (v_a8 == 5) || (v_a8 > 6)) {
+      status = wuffs_base__make_status(wuffs_png__error__bad_header);
+      goto exit;
+    }
+    self->private_impl.f_color_type = v_a8;
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_4 = *iop_a_src++;
+      v_a8 = t_4;
+    }
+    if (v_a8 != 0) {
+      status = wuffs_base__make_status(wuffs_png__error__unsupported_png_compression_method);
+      goto exit;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_5 = *iop_a_src++;
+      v_a8 = t_5;
+    }
+    if (v_a8 != 0) {
+      status = wuffs_base__make_status(wuffs_png__error__bad_header);
+      goto exit;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_6 = *iop_a_src++;
+      v_a8 = t_6;
+    }
+    if (v_a8 == 0) {
+      self->private_impl.f_interlace_pass = 0;
+    } else if (v_a8 == 1) {
+      self->private_impl.f_interlace_pass = 1;
+      self->private_impl.choosy_filter_and_swizzle = (
+          &wuffs_png__decoder__filter_and_swizzle_tricky);
+    } else {
+      status = wuffs_base__make_status(wuffs_png__error__bad_header);
+      goto exit;
+    }
+    self->private_impl.f_filter_distance = 0;
+    wuffs_png__decoder__assign_filter_distance(self);
+    if (self->private_impl.f_filter_distance == 0) {
+      status = wuffs_base__make_status(wuffs_png__error__bad_header);
+      goto exit;
+    }
+    self->private_impl.f_overall_workbuf_length = (((uint64_t)(self->private_impl.f_height)) * (1 + wuffs_png__decoder__calculate_bytes_per_row(self, self->private_impl.f_width)));
+    self->private_impl.f_streaming_workbuf_length = self->private_impl.f_overall_workbuf_length;
+    if (self->private_impl.f_interlace_pass == 0) {
+      self->private_impl.f_streaming_workbuf_length = wuffs_base__u64__min(self->private_impl.f_overall_workbuf_length, (2 * (1 + wuffs_png__decoder__calculate_bytes_per_row(self, self->private_impl.f_width))));
+    }
+    wuffs_png__decoder__choose_filter_implementations(self);
+
+    goto ok;
+    ok:
+    self->private_impl.p_decode_ihdr[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_ihdr[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func png.decoder.assign_filter_distance
+
+static wuffs_base__empty_struct
+wuffs_png__decoder__assign_filter_distance(
+    wuffs_png__decoder* self) {
+  if (self->private_impl.f_depth < 8) {
+    if ((self->private_impl.f_depth != 1) && (self->private_impl.f_depth != 2) && (self->private_impl.f_depth != 4)) {
+      return wuffs_base__make_empty_struct();
+    } else if (self->private_impl.f_color_type == 0) {
+      self->private_impl.f_dst_pixfmt = 536870920;
+      self->private_impl.f_src_pixfmt = 536870920;
+    } else if (self->private_impl.f_color_type == 3) {
+      self->private_impl.f_dst_pixfmt = 2198077448;
+      self->private_impl.f_src_pixfmt = 2198077448;
+    } else {
+      return wuffs_base__make_empty_struct();
+    }
+    self->private_impl.f_filter_distance = 1;
+    self->private_impl.choosy_filter_and_swizzle = (
+        &wuffs_png__decoder__filter_and_swizzle_tricky);
+  } else if (self->private_impl.f_color_type == 0) {
+    if (self->private_impl.f_depth == 8) {
+      self->private_impl.f_dst_pixfmt = 536870920;
+      self->private_impl.f_src_pixfmt = 536870920;
+      self->private_impl.f_filter_distance = 1;
+    } else if (self->private_impl.f_depth == 16) {
+      if (self->private_impl.f_interlace_pass == 0) {
+        self->private_impl.f_dst_pixfmt = 536870923;
+        self->private_impl.f_src_pixfmt = 537919499;
+      } else {
+        self->private_impl.f_dst_pixfmt = 2164308923;
+        self->private_impl.f_src_pixfmt = 2164308923;
+      }
+      self->private_impl.f_filter_distance = 2;
+    }
+  } else if (self->private_impl.f_color_type == 2) {
+    if (self->private_impl.f_depth == 8) {
+      self->private_impl.f_dst_pixfmt = 2147485832;
+      self->private_impl.f_src_pixfmt = 2684356744;
+      self->private_impl.f_filter_distance = 3;
+    } else if (self->private_impl.f_depth == 16) {
+      self->private_impl.f_dst_pixfmt = 2164308923;
+      self->private_impl.f_src_pixfmt = 2164308923;
+      self->private_impl.f_filter_distance = 6;
+      self->private_impl.choosy_filter_and_swizzle = (
+          &wuffs_png__decoder__filter_and_swizzle_tricky);
+    }
+  } else if (self->private_impl.f_color_type == 3) {
+    if (self->private_impl.f_depth == 8) {
+      self->private_impl.f_dst_pixfmt = 2198077448;
+      self->private_impl.f_src_pixfmt = 2198077448;
+      self->private_impl.f_filter_distance = 1;
+    }
+  } else if (self->private_impl.f_color_type == 4) {
+    if (self->private_impl.f_depth == 8) {
+      self->private_impl.f_dst_pixfmt = 2164295816;
+      self->private_impl.f_src_pixfmt = 2164295816;
+      self->private_impl.f_filter_distance = 2;
+      self->private_impl.choosy_filter_and_swizzle = (
+          &wuffs_png__decoder__filter_and_swizzle_tricky);
+    } else if (self->private_impl.f_depth == 16) {
+      self->private_impl.f_dst_pixfmt = 2164308923;
+      self->private_impl.f_src_pixfmt = 2164308923;
+      self->private_impl.f_filter_distance = 4;
+      self->private_impl.choosy_filter_and_swizzle = (
+          &wuffs_png__decoder__filter_and_swizzle_tricky);
+    }
+  } else if (self->private_impl.f_color_type == 6) {
+    if (self->private_impl.f_depth == 8) {
+      self->private_impl.f_dst_pixfmt = 2164295816;
+      self->private_impl.f_src_pixfmt = 2701166728;
+      self->private_impl.f_filter_distance = 4;
+    } else if (self->private_impl.f_depth == 16) {
+      self->private_impl.f_dst_pixfmt = 2164308923;
+      self->private_impl.f_src_pixfmt = 2164308923;
+      self->private_impl.f_filter_distance = 8;
+      self->private_impl.choosy_filter_and_swizzle = (
+          &wuffs_png__decoder__filter_and_swizzle_tricky);
+    }
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func png.decoder.calculate_bytes_per_row
+
+static uint64_t
+wuffs_png__decoder__calculate_bytes_per_row(
+    const wuffs_png__decoder* self,
+    uint32_t a_width) {
+  uint64_t v_bytes_per_channel = 0;
+
+  if (self->private_impl.f_depth == 1) {
+    return ((uint64_t)(((a_width + 7) / 8)));
+  } else if (self->private_impl.f_depth == 2) {
+    return ((uint64_t)(((a_width + 3) / 4)));
+  } else if (self->private_impl.f_depth == 4) {
+    return ((uint64_t)(((a_width + 1) / 2)));
+  }
+  v_bytes_per_channel = ((uint64_t)((self->private_impl.f_depth >> 3)));
+  return (((uint64_t)(a_width)) * v_bytes_per_channel * ((uint64_t)(WUFFS_PNG__NUM_CHANNELS[self->private_impl.f_color_type])));
+}
+
+// -------- func png.decoder.choose_filter_implementations
+
+static wuffs_base__empty_struct
+wuffs_png__decoder__choose_filter_implementations(
+    wuffs_png__decoder* self) {
+  if (self->private_impl.f_filter_distance == 3) {
+    self->private_impl.choosy_filter_1 = (
+        &wuffs_png__decoder__filter_1_distance_3_fallback);
+    self->private_impl.choosy_filter_3 = (
+        &wuffs_png__decoder__filter_3_distance_3_fallback);
+    self->private_impl.choosy_filter_4 = (
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+        wuffs_base__cpu_arch__have_arm_neon() ? &wuffs_png__decoder__filter_4_distance_3_arm_neon :
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+        wuffs_base__cpu_arch__have_x86_sse42() ? &wuffs_png__decoder__filter_4_distance_3_x86_sse42 :
+#endif
+        &wuffs_png__decoder__filter_4_distance_3_fallback);
+  } else if (self->private_impl.f_filter_distance == 4) {
+    self->private_impl.choosy_filter_1 = (
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+        wuffs_base__cpu_arch__have_arm_neon() ? &wuffs_png__decoder__filter_1_distance_4_arm_neon :
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+        wuffs_base__cpu_arch__have_x86_sse42() ? &wuffs_png__decoder__filter_1_distance_4_x86_sse42 :
+#endif
+        &wuffs_png__decoder__filter_1_distance_4_fallback);
+    self->private_impl.choosy_filter_3 = (
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+        wuffs_base__cpu_arch__have_arm_neon() ? &wuffs_png__decoder__filter_3_distance_4_arm_neon :
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+        wuffs_base__cpu_arch__have_x86_sse42() ? &wuffs_png__decoder__filter_3_distance_4_x86_sse42 :
+#endif
+        &wuffs_png__decoder__filter_3_distance_4_fallback);
+    self->private_impl.choosy_filter_4 = (
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+        wuffs_base__cpu_arch__have_arm_neon() ? &wuffs_png__decoder__filter_4_distance_4_arm_neon :
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+        wuffs_base__cpu_arch__have_x86_sse42() ? &wuffs_png__decoder__filter_4_distance_4_x86_sse42 :
+#endif
+        &wuffs_png__decoder__filter_4_distance_4_fallback);
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func png.decoder.decode_other_chunk
+
+static wuffs_base__status
+wuffs_png__decoder__decode_other_chunk(
+    wuffs_png__decoder* self,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_other_chunk[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_chunk_type == 1163152464) {
+      if (self->private_impl.f_seen_plte) {
+        status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+        goto exit;
+      } else if (self->private_impl.f_color_type == 3) {
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        status = wuffs_png__decoder__decode_plte(self, a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+      } else if ((self->private_impl.f_color_type == 2) || (self->private_impl.f_color_type == 6)) {
+      } else {
+        status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+        goto exit;
+      }
+      self->private_impl.f_seen_plte = true;
+    } else if ((self->private_impl.f_chunk_type & 32) == 0) {
+      if (self->private_impl.f_chunk_type != 1413563465) {
+        status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+        goto exit;
+      }
+    } else if (self->private_impl.f_chunk_type == 1280598881) {
+      if (self->private_impl.f_seen_actl) {
+        status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+        goto exit;
+      }
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      status = wuffs_png__decoder__decode_actl(self, a_src);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+      self->private_impl.f_seen_actl = true;
+    } else if (self->private_impl.f_chunk_type == 1297238115) {
+      if (self->private_impl.f_report_metadata_chrm) {
+        if (self->private_impl.f_seen_chrm) {
+          status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+          goto exit;
+        }
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+        status = wuffs_png__decoder__decode_chrm(self, a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+        self->private_impl.f_seen_chrm = true;
+      }
+    } else if (self->private_impl.f_chunk_type == 1716082789) {
+      if (self->private_impl.f_report_metadata_exif) {
+        if (self->private_impl.f_seen_exif) {
+          status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+          goto exit;
+        }
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+        status = wuffs_png__decoder__decode_exif(self, a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+        self->private_impl.f_seen_exif = true;
+      }
+    } else if (self->private_impl.f_chunk_type == 1280598886) {
+      if (self->private_impl.f_seen_fctl) {
+        status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+        goto exit;
+      }
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+      status = wuffs_png__decoder__decode_fctl(self, a_src);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+      self->private_impl.f_seen_fctl = true;
+    } else if (self->private_impl.f_chunk_type == 1095582055) {
+      if (self->private_impl.f_report_metadata_gama) {
+        if (self->private_impl.f_seen_gama) {
+          status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+          goto exit;
+        }
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+        status = wuffs_png__decoder__decode_gama(self, a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+        self->private_impl.f_seen_gama = true;
+      }
+    } else if (self->private_impl.f_chunk_type == 1346585449) {
+      if (self->private_impl.f_report_metadata_iccp) {
+        if (self->private_impl.f_seen_iccp) {
+          status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+          goto exit;
+        }
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+        status = wuffs_png__decoder__decode_iccp(self, a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+        self->private_impl.f_seen_iccp = true;
+      }
+    } else if (self->private_impl.f_chunk_type == 1111970419) {
+      if (self->private_impl.f_report_metadata_srgb) {
+        if (self->private_impl.f_seen_srgb) {
+          status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+          goto exit;
+        }
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+        status = wuffs_png__decoder__decode_srgb(self, a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+        self->private_impl.f_seen_srgb = true;
+      }
+    } else if (self->private_impl.f_chunk_type == 1397641844) {
+      if (self->private_impl.f_seen_trns || (self->private_impl.f_color_type > 3) || ((self->private_impl.f_color_type == 3) &&  ! self->private_impl.f_seen_plte)) {
+        status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+        goto exit;
+      }
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
+      status = wuffs_png__decoder__decode_trns(self, a_src);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+      self->private_impl.f_seen_trns = true;
+    } else if ((self->private_impl.f_chunk_type == 1951945833) || (self->private_impl.f_chunk_type == 1951942004) || (self->private_impl.f_chunk_type == 1951945850)) {
+      if (self->private_impl.f_report_metadata_kvp) {
+        self->private_impl.f_metadata_flavor = 4;
+        self->private_impl.f_metadata_fourcc = 1263947851;
+        self->private_impl.f_metadata_x = 0;
+        self->private_impl.f_metadata_y = 0;
+        self->private_impl.f_metadata_z = 0;
+      }
+    }
+    if (self->private_impl.f_metadata_fourcc == 0) {
+      self->private_data.s_decode_other_chunk[0].scratch = self->private_impl.f_chunk_length;
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(10);
+      if (self->private_data.s_decode_other_chunk[0].scratch > ((uint64_t)(io2_a_src - iop_a_src))) {
+        self->private_data.s_decode_other_chunk[0].scratch -= ((uint64_t)(io2_a_src - iop_a_src));
+        iop_a_src = io2_a_src;
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      iop_a_src += self->private_data.s_decode_other_chunk[0].scratch;
+    }
+
+    goto ok;
+    ok:
+    self->private_impl.p_decode_other_chunk[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_other_chunk[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func png.decoder.decode_actl
+
+static wuffs_base__status
+wuffs_png__decoder__decode_actl(
+    wuffs_png__decoder* self,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_actl[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_chunk_length != 8) {
+      status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+      goto exit;
+    } else if (self->private_impl.f_interlace_pass > 0) {
+      status = wuffs_base__make_status(wuffs_png__error__unsupported_png_file);
+      goto exit;
+    }
+    self->private_impl.f_chunk_length = 0;
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      uint32_t t_0;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+        t_0 = wuffs_base__peek_u32be__no_bounds_check(iop_a_src);
+        iop_a_src += 4;
+      } else {
+        self->private_data.s_decode_actl[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_actl[0].scratch;
+          uint32_t num_bits_0 = ((uint32_t)(*scratch & 0xFF));
+          *scratch >>= 8;
+          *scratch <<= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_0);
+          if (num_bits_0 == 24) {
+            t_0 = ((uint32_t)(*scratch >> 32));
+            break;
+          }
+          num_bits_0 += 8;
+          *scratch |= ((uint64_t)(num_bits_0));
+        }
+      }
+      self->private_impl.f_num_animation_frames_value = t_0;
+    }
+    if (self->private_impl.f_num_animation_frames_value == 0) {
+      status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+      goto exit;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      uint32_t t_1;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+        t_1 = wuffs_base__peek_u32be__no_bounds_check(iop_a_src);
+        iop_a_src += 4;
+      } else {
+        self->private_data.s_decode_actl[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_actl[0].scratch;
+          uint32_t num_bits_1 = ((uint32_t)(*scratch & 0xFF));
+          *scratch >>= 8;
+          *scratch <<= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_1);
+          if (num_bits_1 == 24) {
+            t_1 = ((uint32_t)(*scratch >> 32));
+            break;
+          }
+          num_bits_1 += 8;
+          *scratch |= ((uint64_t)(num_bits_1));
+        }
+      }
+      self->private_impl.f_num_animation_loops_value = t_1;
+    }
+
+    goto ok;
+    ok:
+    self->private_impl.p_decode_actl[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_actl[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func png.decoder.decode_chrm
+
+static wuffs_base__status
+wuffs_png__decoder__decode_chrm(
+    wuffs_png__decoder* self,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint64_t v_u = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_chrm[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_chunk_length != 32) {
+      status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+      goto exit;
+    }
+    self->private_impl.f_chunk_length = 0;
+    self->private_impl.f_metadata_flavor = 5;
+    self->private_impl.f_metadata_fourcc = 1128813133;
+    self->private_impl.f_metadata_x = 0;
+    self->private_impl.f_metadata_y = 0;
+    self->private_impl.f_metadata_z = 0;
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      uint64_t t_0;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+        t_0 = ((uint64_t)(wuffs_base__peek_u32be__no_bounds_check(iop_a_src)));
+        iop_a_src += 4;
+      } else {
+        self->private_data.s_decode_chrm[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_chrm[0].scratch;
+          uint32_t num_bits_0 = ((uint32_t)(*scratch & 0xFF));
+          *scratch >>= 8;
+          *scratch <<= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_0);
+          if (num_bits_0 == 24) {
+            t_0 = ((uint64_t)(*scratch >> 32));
+            break;
+          }
+          num_bits_0 += 8;
+          *scratch |= ((uint64_t)(num_bits_0));
+        }
+      }
+      v_u = t_0;
+    }
+    self->private_impl.f_metadata_x |= ((16777215 & v_u) << 0);
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      uint64_t t_1;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+        t_1 = ((uint64_t)(wuffs_base__peek_u32be__no_bounds_check(iop_a_src)));
+        iop_a_src += 4;
+      } else {
+        self->private_data.s_decode_chrm[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_chrm[0].scratch;
+          uint32_t num_bits_1 = ((uint32_t)(*scratch & 0xFF));
+          *scratch >>= 8;
+          *scratch <<= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_1);
+          if (num_bits_1 == 24) {
+            t_1 = ((uint64_t)(*scratch >> 32));
+            break;
+          }
+          num_bits_1 += 8;
+          *scratch |= ((uint64_t)(num_bits_1));
+        }
+      }
+      v_u = t_1;
+    }
+    self->private_impl.f_metadata_x |= ((16777215 & v_u) << 24);
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+      uint64_t t_2;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+        t_2 = ((uint64_t)(wuffs_base__peek_u32be__no_bounds_check(iop_a_src)));
+        iop_a_src += 4;
+      } else {
+        self->private_data.s_decode_chrm[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_chrm[0].scratch;
+          uint32_t num_bits_2 = ((uint32_t)(*scratch & 0xFF));
+          *scratch >>= 8;
+          *scratch <<= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_2);
+          if (num_bits_2 == 24) {
+            t_2 = ((uint64_t)(*scratch >> 32));
+            break;
+          }
+          num_bits_2 += 8;
+          *scratch |= ((uint64_t)(num_bits_2));
+        }
+      }
+      v_u = t_2;
+    }
+    self->private_impl.f_metadata_x |= ((uint64_t)((16777215 & v_u) << 48));
+    self->private_impl.f_metadata_y |= ((16777215 & v_u) >> 16);
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+      uint64_t t_3;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+        t_3 = ((uint64_t)(wuffs_base__peek_u32be__no_bounds_check(iop_a_src)));
+        iop_a_src += 4;
+      } else {
+        self->private_data.s_decode_chrm[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_chrm[0].scratch;
+          uint32_t num_bits_3 = ((uint32_t)(*scratch & 0xFF));
+          *scratch >>= 8;
+          *scratch <<= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_3);
+          if (num_bits_3 == 24) {
+            t_3 = ((uint64_t)(*scratch >> 32));
+            break;
+          }
+          num_bits_3 += 8;
+          *scratch |= ((uint64_t)(num_bits_3));
+        }
+      }
+      v_u = t_3;
+    }
+    self->private_impl.f_metadata_y |= ((16777215 & v_u) << 8);
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
+      uint64_t t_4;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+        t_4 = ((uint64_t)(wuffs_base__peek_u32be__no_bounds_check(iop_a_src)));
+        iop_a_src += 4;
+      } else {
+        self->private_data.s_decode_chrm[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(10);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_chrm[0].scratch;
+          uint32_t num_bits_4 = ((uint32_t)(*scratch & 0xFF));
+          *scratch >>= 8;
+          *scratch <<= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_4);
+          if (num_bits_4 == 24) {
+            t_4 = ((uint64_t)(*scratch >> 32));
+            break;
+          }
+          num_bits_4 += 8;
+          *scratch |= ((uint64_t)(num_bits_4));
+        }
+      }
+      v_u = t_4;
+    }
+    self->private_impl.f_metadata_y |= ((16777215 & v_u) << 32);
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(11);
+      uint64_t t_5;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+        t_5 = ((uint64_t)(wuffs_base__peek_u32be__no_bounds_check(iop_a_src)));
+        iop_a_src += 4;
+      } else {
+        self->private_data.s_decode_chrm[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(12);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_chrm[0].scratch;
+          uint32_t num_bits_5 = ((uint32_t)(*scratch & 0xFF));
+          *scratch >>= 8;
+          *scratch <<= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_5);
+          if (num_bits_5 == 24) {
+            t_5 = ((uint64_t)(*scratch >> 32));
+            break;
+          }
+          num_bits_5 += 8;
+          *scratch |= ((uint64_t)(num_bits_5));
+        }
+      }
+      v_u = t_5;
+    }
+    self->private_impl.f_metadata_y |= ((uint64_t)((16777215 & v_u) << 56));
+    self->private_impl.f_metadata_z |= ((16777215 & v_u) >> 8);
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(13);
+      uint64_t t_6;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+        t_6 = ((uint64_t)(wuffs_base__peek_u32be__no_bounds_check(iop_a_src)));
+        iop_a_src += 4;
+      } else {
+        self->private_data.s_decode_chrm[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(14);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_chrm[0].scratch;
+          uint32_t num_bits_6 = ((uint32_t)(*scratch & 0xFF));
+          *scratch >>= 8;
+          *scratch <<= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_6);
+          if (num_bits_6 == 24) {
+            t_6 = ((uint64_t)(*scratch >> 32));
+            break;
+          }
+          num_bits_6 += 8;
+          *scratch |= ((uint64_t)(num_bits_6));
+        }
+      }
+      v_u = t_6;
+    }
+    self->private_impl.f_metadata_z |= ((16777215 & v_u) << 16);
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(15);
+      uint64_t t_7;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+        t_7 = ((uint64_t)(wuffs_base__peek_u32be__no_bounds_check(iop_a_src)));
+        iop_a_src += 4;
+      } else {
+        self->private_data.s_decode_chrm[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(16);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_chrm[0].scratch;
+          uint32_t num_bits_7 = ((uint32_t)(*scratch & 0xFF));
+          *scratch >>= 8;
+          *scratch <<= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_7);
+          if (num_bits_7 == 24) {
+            t_7 = ((uint64_t)(*scratch >> 32));
+            break;
+          }
+          num_bits_7 += 8;
+          *scratch |= ((uint64_t)(num_bits_7));
+        }
+      }
+      v_u = t_7;
+    }
+    self->private_impl.f_metadata_z |= ((16777215 & v_u) << 40);
+
+    goto ok;
+    ok:
+    self->private_impl.p_decode_chrm[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_chrm[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func png.decoder.decode_exif
+
+static wuffs_base__status
+wuffs_png__decoder__decode_exif(
+    wuffs_png__decoder* self,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  if (self->private_impl.f_chunk_length < 4) {
+    status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+    goto exit;
+  }
+  self->private_impl.f_metadata_flavor = 3;
+  self->private_impl.f_metadata_fourcc = 1163413830;
+  self->private_impl.f_metadata_x = 0;
+  self->private_impl.f_metadata_y = wuffs_base__u64__sat_add((a_src ? a_src->meta.pos : 0), ((uint64_t)(iop_a_src - io0_a_src)));
+  self->private_impl.f_metadata_z = wuffs_base__u64__sat_add(self->private_impl.f_metadata_y, ((uint64_t)(self->private_impl.f_chunk_length)));
+  self->private_impl.f_chunk_length = 0;
+
+  goto ok;
+  ok:
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func png.decoder.decode_fctl
+
+static wuffs_base__status
+wuffs_png__decoder__decode_fctl(
+    wuffs_png__decoder* self,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_x0 = 0;
+  uint32_t v_y0 = 0;
+  uint32_t v_x1 = 0;
+  uint32_t v_y1 = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_fctl[0];
+  if (coro_susp_point) {
+    v_x0 = self->private_data.s_decode_fctl[0].v_x0;
+    v_x1 = self->private_data.s_decode_fctl[0].v_x1;
+    v_y1 = self->private_data.s_decode_fctl[0].v_y1;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_chunk_length != 26) {
+      status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+      goto exit;
+    }
+    self->private_impl.f_chunk_length = 0;
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      uint32_t t_0;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+        t_0 = wuffs_base__peek_u32be__no_bounds_check(iop_a_src);
+        iop_a_src += 4;
+      } else {
+        self->private_data.s_decode_fctl[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_fctl[0].scratch;
+          uint32_t num_bits_0 = ((uint32_t)(*scratch & 0xFF));
+          *scratch >>= 8;
+          *scratch <<= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_0);
+          if (num_bits_0 == 24) {
+            t_0 = ((uint32_t)(*scratch >> 32));
+            break;
+          }
+          num_bits_0 += 8;
+          *scratch |= ((uint64_t)(num_bits_0));
+        }
+      }
+      v_x0 = t_0;
+    }
+    if (self->private_impl.f_resync_animation_seq_num) {
+      self->private_impl.f_resync_animation_seq_num = false;
+    } else if (v_x0 != self->private_impl.f_next_animation_seq_num) {
+      status = wuffs_base__make_status(wuffs_png__error__bad_animation_sequence_number);
+      goto exit;
+    }
+    if (v_x0 >= 4294967295) {
+      status = wuffs_base__make_status(wuffs_png__error__unsupported_png_file);
+      goto exit;
+    }
+    self->private_impl.f_next_animation_seq_num = (v_x0 + 1);
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      uint32_t t_1;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+        t_1 = wuffs_base__peek_u32be__no_bounds_check(iop_a_src);
+        iop_a_src += 4;
+      } else {
+        self->private_data.s_decode_fctl[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_fctl[0].scratch;
+          uint32_t num_bits_1 = ((uint32_t)(*scratch & 0xFF));
+          *scratch >>= 8;
+          *scratch <<= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_1);
+          if (num_bits_1 == 24) {
+            t_1 = ((uint32_t)(*scratch >> 32));
+            break;
+          }
+          num_bits_1 += 8;
+          *scratch |= ((uint64_t)(num_bits_1));
+        }
+      }
+      v_x1 = t_1;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+      uint32_t t_2;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+        t_2 = wuffs_base__peek_u32be__no_bounds_check(iop_a_src);
+        iop_a_src += 4;
+      } else {
+        self->private_data.s_decode_fctl[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_fctl[0].scratch;
+          uint32_t num_bits_2 = ((uint32_t)(*scratch & 0xFF));
+          *scratch >>= 8;
+          *scratch <<= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_2);
+          if (num_bits_2 == 24) {
+            t_2 = ((uint32_t)(*scratch >> 32));
+            break;
+          }
+          num_bits_2 += 8;
+          *scratch |= ((uint64_t)(num_bits_2));
+        }
+      }
+      v_y1 = t_2;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+      uint32_t t_3;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+        t_3 = wuffs_base__peek_u32be__no_bounds_check(iop_a_src);
+        iop_a_src += 4;
+      } else {
+        self->private_data.s_decode_fctl[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_fctl[0].scratch;
+          uint32_t num_bits_3 = ((uint32_t)(*scratch & 0xFF));
+          *scratch >>= 8;
+          *scratch <<= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_3);
+          if (num_bits_3 == 24) {
+            t_3 = ((uint32_t)(*scratch >> 32));
+            break;
+          }
+          num_bits_3 += 8;
+          *scratch |= ((uint64_t)(num_bits_3));
+        }
+      }
+      v_x0 = t_3;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
+      uint32_t t_4;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+        t_4 = wuffs_base__peek_u32be__no_bounds_check(iop_a_src);
+        iop_a_src += 4;
+      } else {
+        self->private_data.s_decode_fctl[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(10);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_fctl[0].scratch;
+          uint32_t num_bits_4 = ((uint32_t)(*scratch & 0xFF));
+          *scratch >>= 8;
+          *scratch <<= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_4);
+          if (num_bits_4 == 24) {
+            t_4 = ((uint32_t)(*scratch >> 32));
+            break;
+          }
+          num_bits_4 += 8;
+          *scratch |= ((uint64_t)(num_bits_4));
+        }
+      }
+      v_y0 = t_4;
+    }
+    v_x1 += v_x0;
+    v_y1 += v_y0;
+    if ((v_x0 >= v_x1) ||
+        (v_x0 > self->private_impl.f_width) ||
+        (v_x1 > self->private_impl.f_width) ||
+        (v_y0 >= v_y1) ||
+        (v_y0 > self->private_impl.f_height) ||
+        (v_y1 > self->private_impl.f_height)) {
+      status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+      goto exit;
+    }
+    self->private_impl.f_frame_rect_x0 = v_x0;
+    self->private_impl.f_frame_rect_y0 = v_y0;
+    self->private_impl.f_frame_rect_x1 = v_x1;
+    self->private_impl.f_frame_rect_y1 = v_y1;
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(11);
+      uint32_t t_5;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_5 = ((uint32_t)(wuffs_base__peek_u16be__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_fctl[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(12);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_fctl[0].scratch;
+          uint32_t num_bits_5 = ((uint32_t)(*scratch & 0xFF));
+          *scratch >>= 8;
+          *scratch <<= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_5);
+          if (num_bits_5 == 8) {
+            t_5 = ((uint32_t)(*scratch >> 48));
+            break;
+          }
+          num_bits_5 += 8;
+          *scratch |= ((uint64_t)(num_bits_5));
+        }
+      }
+      v_x0 = t_5;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(13);
+      uint32_t t_6;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_6 = ((uint32_t)(wuffs_base__peek_u16be__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_fctl[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(14);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_fctl[0].scratch;
+          uint32_t num_bits_6 = ((uint32_t)(*scratch & 0xFF));
+          *scratch >>= 8;
+          *scratch <<= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_6);
+          if (num_bits_6 == 8) {
+            t_6 = ((uint32_t)(*scratch >> 48));
+            break;
+          }
+          num_bits_6 += 8;
+          *scratch |= ((uint64_t)(num_bits_6));
+        }
+      }
+      v_x1 = t_6;
+    }
+    if (v_x1 <= 0) {
+      self->private_impl.f_frame_duration = (((uint64_t)(v_x0)) * 7056000);
+    } else {
+      self->private_impl.f_frame_duration = ((((uint64_t)(v_x0)) * 705600000) / ((uint64_t)(v_x1)));
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(15);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint32_t t_7 = *iop_a_src++;
+      v_x0 = t_7;
+    }
+    if (v_x0 == 0) {
+      self->private_impl.f_frame_disposal = 0;
+    } else if (v_x0 == 1) {
+      self->private_impl.f_frame_disposal = 1;
+    } else if (v_x0 == 2) {
+      if (self->private_impl.f_num_decoded_frame_configs_value == 0) {
+        self->private_impl.f_frame_disposal = 1;
+      } else {
+        self->private_impl.f_frame_disposal = 2;
+      }
+    } else {
+      status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+      goto exit;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(16);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint32_t t_8 = *iop_a_src++;
+      v_x0 = t_8;
+    }
+    if (v_x0 == 0) {
+      self->private_impl.f_frame_overwrite_instead_of_blend = true;
+    } else if (v_x0 == 1) {
+      self->private_impl.f_frame_overwrite_instead_of_blend = false;
+    } else {
+      status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+      goto exit;
+    }
+    if (self->private_impl.f_num_decoded_frame_configs_value == 0) {
+      self->private_impl.f_first_rect_x0 = self->private_impl.f_frame_rect_x0;
+      self->private_impl.f_first_rect_y0 = self->private_impl.f_frame_rect_y0;
+      self->private_impl.f_first_rect_x1 = self->private_impl.f_frame_rect_x1;
+      self->private_impl.f_first_rect_y1 = self->private_impl.f_frame_rect_y1;
+      self->private_impl.f_first_duration = self->private_impl.f_frame_duration;
+      self->private_impl.f_first_disposal = self->private_impl.f_frame_disposal;
+      self->private_impl.f_first_overwrite_instead_of_blend = self->private_impl.f_frame_overwrite_instead_of_blend;
+    }
+
+    goto ok;
+    ok:
+    self->private_impl.p_decode_fctl[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_fctl[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_decode_fctl[0].v_x0 = v_x0;
+  self->private_data.s_decode_fctl[0].v_x1 = v_x1;
+  self->private_data.s_decode_fctl[0].v_y1 = v_y1;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func png.decoder.decode_gama
+
+static wuffs_base__status
+wuffs_png__decoder__decode_gama(
+    wuffs_png__decoder* self,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_gama[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_chunk_length != 4) {
+      status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+      goto exit;
+    }
+    self->private_impl.f_chunk_length = 0;
+    self->private_impl.f_metadata_flavor = 5;
+    self->private_impl.f_metadata_fourcc = 1195461953;
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      uint64_t t_0;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+        t_0 = ((uint64_t)(wuffs_base__peek_u32be__no_bounds_check(iop_a_src)));
+        iop_a_src += 4;
+      } else {
+        self->private_data.s_decode_gama[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_gama[0].scratch;
+          uint32_t num_bits_0 = ((uint32_t)(*scratch & 0xFF));
+          *scratch >>= 8;
+          *scratch <<= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_0);
+          if (num_bits_0 == 24) {
+            t_0 = ((uint64_t)(*scratch >> 32));
+            break;
+          }
+          num_bits_0 += 8;
+          *scratch |= ((uint64_t)(num_bits_0));
+        }
+      }
+      self->private_impl.f_metadata_x = t_0;
+    }
+    self->private_impl.f_metadata_y = 0;
+    self->private_impl.f_metadata_z = 0;
+
+    goto ok;
+    ok:
+    self->private_impl.p_decode_gama[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_gama[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func png.decoder.decode_iccp
+
+static wuffs_base__status
+wuffs_png__decoder__decode_iccp(
+    wuffs_png__decoder* self,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t v_c = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_iccp[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    while (true) {
+      if (self->private_impl.f_chunk_length <= 0) {
+        status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+        goto exit;
+      }
+      self->private_impl.f_chunk_length -= 1;
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint8_t t_0 = *iop_a_src++;
+        v_c = t_0;
+      }
+      if (v_c == 0) {
+        goto label__0__break;
+      }
+    }
+    label__0__break:;
+    if (self->private_impl.f_chunk_length <= 0) {
+      status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+      goto exit;
+    }
+    self->private_impl.f_chunk_length -= 1;
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_1 = *iop_a_src++;
+      v_c = t_1;
+    }
+    if (v_c != 0) {
+      status = wuffs_base__make_status(wuffs_png__error__unsupported_png_compression_method);
+      goto exit;
+    }
+    self->private_impl.f_metadata_is_zlib_compressed = true;
+    self->private_impl.f_metadata_flavor = 4;
+    self->private_impl.f_metadata_fourcc = 1229144912;
+    self->private_impl.f_metadata_x = 0;
+    self->private_impl.f_metadata_y = 0;
+    self->private_impl.f_metadata_z = 0;
+
+    goto ok;
+    ok:
+    self->private_impl.p_decode_iccp[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_iccp[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func png.decoder.decode_plte
+
+static wuffs_base__status
+wuffs_png__decoder__decode_plte(
+    wuffs_png__decoder* self,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_num_entries = 0;
+  uint32_t v_i = 0;
+  uint32_t v_argb = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_plte[0];
+  if (coro_susp_point) {
+    v_num_entries = self->private_data.s_decode_plte[0].v_num_entries;
+    v_i = self->private_data.s_decode_plte[0].v_i;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if ((self->private_impl.f_chunk_length > 768) || ((self->private_impl.f_chunk_length % 3) != 0)) {
+      status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+      goto exit;
+    }
+    v_num_entries = (((uint32_t)(self->private_impl.f_chunk_length)) / 3);
+    self->private_impl.f_chunk_length = 0;
+    while (v_i < v_num_entries) {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        uint32_t t_0;
+        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 3)) {
+          t_0 = ((uint32_t)(wuffs_base__peek_u24be__no_bounds_check(iop_a_src)));
+          iop_a_src += 3;
+        } else {
+          self->private_data.s_decode_plte[0].scratch = 0;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+          while (true) {
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint64_t* scratch = &self->private_data.s_decode_plte[0].scratch;
+            uint32_t num_bits_0 = ((uint32_t)(*scratch & 0xFF));
+            *scratch >>= 8;
+            *scratch <<= 8;
+            *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_0);
+            if (num_bits_0 == 16) {
+              t_0 = ((uint32_t)(*scratch >> 40));
+              break;
+            }
+            num_bits_0 += 8;
+            *scratch |= ((uint64_t)(num_bits_0));
+          }
+        }
+        v_argb = t_0;
+      }
+      v_argb |= 4278190080;
+      self->private_data.f_src_palette[((4 * v_i) + 0)] = ((uint8_t)(((v_argb >> 0) & 255)));
+      self->private_data.f_src_palette[((4 * v_i) + 1)] = ((uint8_t)(((v_argb >> 8) & 255)));
+      self->private_data.f_src_palette[((4 * v_i) + 2)] = ((uint8_t)(((v_argb >> 16) & 255)));
+      self->private_data.f_src_palette[((4 * v_i) + 3)] = ((uint8_t)(((v_argb >> 24) & 255)));
+      v_i += 1;
+    }
+    while (v_i < 256) {
+      self->private_data.f_src_palette[((4 * v_i) + 0)] = 0;
+      self->private_data.f_src_palette[((4 * v_i) + 1)] = 0;
+      self->private_data.f_src_palette[((4 * v_i) + 2)] = 0;
+      self->private_data.f_src_palette[((4 * v_i) + 3)] = 255;
+      v_i += 1;
+    }
+
+    goto ok;
+    ok:
+    self->private_impl.p_decode_plte[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_plte[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_decode_plte[0].v_num_entries = v_num_entries;
+  self->private_data.s_decode_plte[0].v_i = v_i;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func png.decoder.decode_srgb
+
+static wuffs_base__status
+wuffs_png__decoder__decode_srgb(
+    wuffs_png__decoder* self,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_srgb[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_chunk_length != 1) {
+      status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+      goto exit;
+    }
+    self->private_impl.f_chunk_length = 0;
+    self->private_impl.f_metadata_flavor = 5;
+    self->private_impl.f_metadata_fourcc = 1397901122;
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint64_t t_0 = *iop_a_src++;
+      self->private_impl.f_metadata_x = t_0;
+    }
+    self->private_impl.f_metadata_y = 0;
+    self->private_impl.f_metadata_z = 0;
+
+    goto ok;
+    ok:
+    self->private_impl.p_decode_srgb[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_srgb[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func png.decoder.decode_trns
+
+static wuffs_base__status
+wuffs_png__decoder__decode_trns(
+    wuffs_png__decoder* self,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_i = 0;
+  uint32_t v_n = 0;
+  uint64_t v_u = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_trns[0];
+  if (coro_susp_point) {
+    v_i = self->private_data.s_decode_trns[0].v_i;
+    v_n = self->private_data.s_decode_trns[0].v_n;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_color_type == 0) {
+      self->private_impl.choosy_filter_and_swizzle = (
+          &wuffs_png__decoder__filter_and_swizzle_tricky);
+      if (self->private_impl.f_depth <= 8) {
+        self->private_impl.f_dst_pixfmt = 2164295816;
+        self->private_impl.f_src_pixfmt = 2164295816;
+      } else {
+        self->private_impl.f_dst_pixfmt = 2164308923;
+        self->private_impl.f_src_pixfmt = 2164308923;
+      }
+      if (self->private_impl.f_chunk_length != 2) {
+        status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+        goto exit;
+      }
+      self->private_impl.f_chunk_length = 0;
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        uint64_t t_0;
+        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+          t_0 = ((uint64_t)(wuffs_base__peek_u16be__no_bounds_check(iop_a_src)));
+          iop_a_src += 2;
+        } else {
+          self->private_data.s_decode_trns[0].scratch = 0;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+          while (true) {
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint64_t* scratch = &self->private_data.s_decode_trns[0].scratch;
+            uint32_t num_bits_0 = ((uint32_t)(*scratch & 0xFF));
+            *scratch >>= 8;
+            *scratch <<= 8;
+            *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_0);
+            if (num_bits_0 == 8) {
+              t_0 = ((uint64_t)(*scratch >> 48));
+              break;
+            }
+            num_bits_0 += 8;
+            *scratch |= ((uint64_t)(num_bits_0));
+          }
+        }
+        v_u = t_0;
+      }
+      if (self->private_impl.f_depth <= 1) {
+        self->private_impl.f_remap_transparency = (((v_u & 1) * 16777215) | 4278190080);
+      } else if (self->private_impl.f_depth <= 2) {
+        self->private_impl.f_remap_transparency = (((v_u & 3) * 5592405) | 4278190080);
+      } else if (self->private_impl.f_depth <= 4) {
+        self->private_impl.f_remap_transparency = (((v_u & 15) * 1118481) | 4278190080);
+      } else if (self->private_impl.f_depth <= 8) {
+        self->private_impl.f_remap_transparency = (((v_u & 255) * 65793) | 4278190080);
+      } else {
+        self->private_impl.f_remap_transparency = ((v_u * 4295032833) | 18446462598732840960u);
+      }
+    } else if (self->private_impl.f_color_type == 2) {
+      self->private_impl.choosy_filter_and_swizzle = (
+          &wuffs_png__decoder__filter_and_swizzle_tricky);
+      if (self->private_impl.f_depth <= 8) {
+        self->private_impl.f_dst_pixfmt = 2164295816;
+        self->private_impl.f_src_pixfmt = 2164295816;
+      } else {
+        self->private_impl.f_dst_pixfmt = 2164308923;
+        self->private_impl.f_src_pixfmt = 2164308923;
+      }
+      if (self->private_impl.f_chunk_length != 6) {
+        status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+        goto exit;
+      }
+      self->private_impl.f_chunk_length = 0;
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+        uint64_t t_1;
+        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 6)) {
+          t_1 = ((uint64_t)(wuffs_base__peek_u48be__no_bounds_check(iop_a_src)));
+          iop_a_src += 6;
+        } else {
+          self->private_data.s_decode_trns[0].scratch = 0;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+          while (true) {
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint64_t* scratch = &self->private_data.s_decode_trns[0].scratch;
+            uint32_t num_bits_1 = ((uint32_t)(*scratch & 0xFF));
+            *scratch >>= 8;
+            *scratch <<= 8;
+            *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_1);
+            if (num_bits_1 == 40) {
+              t_1 = ((uint64_t)(*scratch >> 16));
+              break;
+            }
+            num_bits_1 += 8;
+            *scratch |= ((uint64_t)(num_bits_1));
+          }
+        }
+        v_u = t_1;
+      }
+      if (self->private_impl.f_depth <= 8) {
+        self->private_impl.f_remap_transparency = ((255 & (v_u >> 0)) |
+            (65280 & (v_u >> 8)) |
+            (16711680 & (v_u >> 16)) |
+            4278190080);
+      } else {
+        self->private_impl.f_remap_transparency = (v_u | 18446462598732840960u);
+      }
+    } else if (self->private_impl.f_color_type == 3) {
+      self->private_impl.f_dst_pixfmt = 2164523016;
+      self->private_impl.f_src_pixfmt = 2164523016;
+      if (self->private_impl.f_chunk_length > 256) {
+        status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+        goto exit;
+      }
+      v_n = ((uint32_t)(self->private_impl.f_chunk_length));
+      self->private_impl.f_chunk_length = 0;
+      while (v_i < v_n) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint8_t t_2 = *iop_a_src++;
+          self->private_data.f_src_palette[((4 * v_i) + 3)] = t_2;
+        }
+        v_i += 1;
+      }
+    } else {
+      status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+      goto exit;
+    }
+
+    goto ok;
+    ok:
+    self->private_impl.p_decode_trns[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_trns[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_decode_trns[0].v_i = v_i;
+  self->private_data.s_decode_trns[0].v_n = v_n;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func png.decoder.decode_frame_config
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_png__decoder__decode_frame_config(
+    wuffs_png__decoder* self,
+    wuffs_base__frame_config* a_dst,
+    wuffs_base__io_buffer* a_src) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+        ? wuffs_base__error__disabled_by_previous_error
+        : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 2)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_frame_config[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_call_sequence == 255) {
+      status = wuffs_base__make_status(wuffs_base__note__end_of_data);
+      goto ok;
+    } else if (self->private_impl.f_call_sequence < 3) {
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      status = wuffs_png__decoder__decode_image_config(self, NULL, a_src);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+    } else if (self->private_impl.f_call_sequence == 3) {
+      if (self->private_impl.f_frame_config_io_position != wuffs_base__u64__sat_add((a_src ? a_src->meta.pos : 0), ((uint64_t)(iop_a_src - io0_a_src)))) {
+        status = wuffs_base__make_status(wuffs_base__error__bad_restart);
+        goto exit;
+      }
+    } else if (self->private_impl.f_call_sequence == 4) {
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      status = wuffs_png__decoder__skip_frame(self, a_src);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+      if (self->private_impl.f_call_sequence == 255) {
+        status = wuffs_base__make_status(wuffs_base__note__end_of_data);
+        goto ok;
+      }
+    }
+    if (self->private_impl.f_num_decoded_frame_configs_value == 0) {
+      self->private_impl.f_frame_rect_x0 = self->private_impl.f_first_rect_x0;
+      self->private_impl.f_frame_rect_y0 = self->private_impl.f_first_rect_y0;
+      self->private_impl.f_frame_rect_x1 = self->private_impl.f_first_rect_x1;
+      self->private_impl.f_frame_rect_y1 = self->private_impl.f_first_rect_y1;
+      self->private_impl.f_frame_config_io_position = self->private_impl.f_first_config_io_position;
+      self->private_impl.f_frame_duration = self->private_impl.f_first_duration;
+      self->private_impl.f_frame_disposal = self->private_impl.f_first_disposal;
+      self->private_impl.f_frame_overwrite_instead_of_blend = self->private_impl.f_first_overwrite_instead_of_blend;
+    } else {
+      while (true) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+          uint32_t t_0;
+          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+            t_0 = wuffs_base__peek_u32be__no_bounds_check(iop_a_src);
+            iop_a_src += 4;
+          } else {
+            self->private_data.s_decode_frame_config[0].scratch = 0;
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+            while (true) {
+              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+                goto suspend;
+              }
+              uint64_t* scratch = &self->private_data.s_decode_frame_config[0].scratch;
+              uint32_t num_bits_0 = ((uint32_t)(*scratch & 0xFF));
+              *scratch >>= 8;
+              *scratch <<= 8;
+              *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_0);
+              if (num_bits_0 == 24) {
+                t_0 = ((uint32_t)(*scratch >> 32));
+                break;
+              }
+              num_bits_0 += 8;
+              *scratch |= ((uint64_t)(num_bits_0));
+            }
+          }
+          self->private_impl.f_chunk_length = t_0;
+        }
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+          uint32_t t_1;
+          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+            t_1 = wuffs_base__peek_u32le__no_bounds_check(iop_a_src);
+            iop_a_src += 4;
+          } else {
+            self->private_data.s_decode_frame_config[0].scratch = 0;
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+            while (true) {
+              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+                goto suspend;
+              }
+              uint64_t* scratch = &self->private_data.s_decode_frame_config[0].scratch;
+              uint32_t num_bits_1 = ((uint32_t)(*scratch >> 56));
+              *scratch <<= 8;
+              *scratch >>= 8;
+              *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_1;
+              if (num_bits_1 == 24) {
+                t_1 = ((uint32_t)(*scratch));
+                break;
+              }
+              num_bits_1 += 8;
+              *scratch |= ((uint64_t)(num_bits_1)) << 56;
+            }
+          }
+          self->private_impl.f_chunk_type = t_1;
+        }
+        if (self->private_impl.f_chunk_type == 1413571686) {
+          status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+          goto exit;
+        } else if (self->private_impl.f_chunk_type == 1280598886) {
+          self->private_impl.f_frame_config_io_position = ((uint64_t)(wuffs_base__u64__sat_add((a_src ? a_src->meta.pos : 0), ((uint64_t)(iop_a_src - io0_a_src))) - 8));
+          if (a_src) {
+            a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+          }
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+          status = wuffs_png__decoder__decode_fctl(self, a_src);
+          if (a_src) {
+            iop_a_src = a_src->data.ptr + a_src->meta.ri;
+          }
+          if (status.repr) {
+            goto suspend;
+          }
+          self->private_data.s_decode_frame_config[0].scratch = 4;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+          if (self->private_data.s_decode_frame_config[0].scratch > ((uint64_t)(io2_a_src - iop_a_src))) {
+            self->private_data.s_decode_frame_config[0].scratch -= ((uint64_t)(io2_a_src - iop_a_src));
+            iop_a_src = io2_a_src;
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          iop_a_src += self->private_data.s_decode_frame_config[0].scratch;
+          goto label__0__break;
+        }
+        self->private_data.s_decode_frame_config[0].scratch = (((uint64_t)(self->private_impl.f_chunk_length)) + 4);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
+        if (self->private_data.s_decode_frame_config[0].scratch > ((uint64_t)(io2_a_src - iop_a_src))) {
+          self->private_data.s_decode_frame_config[0].scratch -= ((uint64_t)(io2_a_src - iop_a_src));
+          iop_a_src = io2_a_src;
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        iop_a_src += self->private_data.s_decode_frame_config[0].scratch;
+        self->private_impl.f_chunk_length = 0;
+      }
+      label__0__break:;
+    }
+    if (a_dst != NULL) {
+      wuffs_base__frame_config__set(
+          a_dst,
+          wuffs_base__utility__make_rect_ie_u32(
+          self->private_impl.f_frame_rect_x0,
+          self->private_impl.f_frame_rect_y0,
+          self->private_impl.f_frame_rect_x1,
+          self->private_impl.f_frame_rect_y1),
+          ((wuffs_base__flicks)(self->private_impl.f_frame_duration)),
+          ((uint64_t)(self->private_impl.f_num_decoded_frame_configs_value)),
+          self->private_impl.f_frame_config_io_position,
+          self->private_impl.f_frame_disposal,
+          ((self->private_impl.f_color_type <= 3) &&  ! self->private_impl.f_seen_trns),
+          self->private_impl.f_frame_overwrite_instead_of_blend,
+          0);
+    }
+    wuffs_base__u32__sat_add_indirect(&self->private_impl.f_num_decoded_frame_configs_value, 1);
+    self->private_impl.f_call_sequence = 4;
+
+    ok:
+    self->private_impl.p_decode_frame_config[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_frame_config[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine = wuffs_base__status__is_suspension(&status) ? 2 : 0;
+  WUFFS_BASE__STATS__ADD(self->private_impl, WUFFS_BASE__STATS__SUSPENSIONS,
+      wuffs_base__status__is_suspension(&status) ? 1u : 0u);
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func png.decoder.skip_frame
+
+static wuffs_base__status
+wuffs_png__decoder__skip_frame(
+    wuffs_png__decoder* self,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_seq_num = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_skip_frame[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    self->private_impl.f_chunk_type_array[0] = 0;
+    self->private_impl.f_chunk_type_array[1] = 0;
+    self->private_impl.f_chunk_type_array[2] = 0;
+    self->private_impl.f_chunk_type_array[3] = 0;
+    label__0__continue:;
+    while (true) {
+      while (((uint64_t)(io2_a_src - iop_a_src)) < 8) {
+        if (a_src && a_src->meta.closed) {
+          status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+          goto exit;
+        }
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
+      }
+      self->private_impl.f_chunk_length = wuffs_base__peek_u32be__no_bounds_check(iop_a_src);
+      self->private_impl.f_chunk_type = ((uint32_t)((wuffs_base__peek_u64le__no_bounds_check(iop_a_src) >> 32)));
+      if (self->private_impl.f_chunk_type == 1413563465) {
+        if (self->private_impl.f_chunk_type_array[0] == 102) {
+          status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+          goto exit;
+        }
+        self->private_impl.f_chunk_type_array[0] = 73;
+        self->private_impl.f_chunk_type_array[1] = 68;
+        self->private_impl.f_chunk_type_array[2] = 65;
+        self->private_impl.f_chunk_type_array[3] = 84;
+      } else if (self->private_impl.f_chunk_type == 1413571686) {
+        if (self->private_impl.f_chunk_type_array[0] == 73) {
+          status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+          goto exit;
+        }
+        self->private_impl.f_chunk_type_array[0] = 102;
+        self->private_impl.f_chunk_type_array[1] = 100;
+        self->private_impl.f_chunk_type_array[2] = 65;
+        self->private_impl.f_chunk_type_array[3] = 84;
+        if (self->private_impl.f_chunk_length < 4) {
+          status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+          goto exit;
+        }
+        self->private_impl.f_chunk_length -= 4;
+        iop_a_src += 8;
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+          uint32_t t_0;
+          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+            t_0 = wuffs_base__peek_u32be__no_bounds_check(iop_a_src);
+            iop_a_src += 4;
+          } else {
+            self->private_data.s_skip_frame[0].scratch = 0;
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+            while (true) {
+              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+                goto suspend;
+              }
+              uint64_t* scratch = &self->private_data.s_skip_frame[0].scratch;
+              uint32_t num_bits_0 = ((uint32_t)(*scratch & 0xFF));
+              *scratch >>= 8;
+              *scratch <<= 8;
+              *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_0);
+              if (num_bits_0 == 24) {
+                t_0 = ((uint32_t)(*scratch >> 32));
+                break;
+              }
+              num_bits_0 += 8;
+              *scratch |= ((uint64_t)(num_bits_0));
+            }
+          }
+          v_seq_num = t_0;
+        }
+        if (v_seq_num != self->private_impl.f_next_animation_seq_num) {
+          status = wuffs_base__make_status(wuffs_png__error__bad_animation_sequence_number);
+          goto exit;
+        } else if (self->private_impl.f_next_animation_seq_num >= 4294967295) {
+          status = wuffs_base__make_status(wuffs_png__error__unsupported_png_file);
+          goto exit;
+        }
+        self->private_impl.f_next_animation_seq_num += 1;
+        self->private_data.s_skip_frame[0].scratch = (((uint64_t)(self->private_impl.f_chunk_length)) + 4);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+        if (self->private_data.s_skip_frame[0].scratch > ((uint64_t)(io2_a_src - iop_a_src))) {
+          self->private_data.s_skip_frame[0].scratch -= ((uint64_t)(io2_a_src - iop_a_src));
+          iop_a_src = io2_a_src;
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        iop_a_src += self->private_data.s_skip_frame[0].scratch;
+        self->private_impl.f_chunk_length = 0;
+        goto label__0__continue;
+      } else if (self->private_impl.f_chunk_type_array[0] != 0) {
+        goto label__0__break;
+      } else if (self->private_impl.f_chunk_type == 1280598886) {
+        status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+        goto exit;
+      }
+      self->private_data.s_skip_frame[0].scratch = (((uint64_t)(self->private_impl.f_chunk_length)) + 12);
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+      if (self->private_data.s_skip_frame[0].scratch > ((uint64_t)(io2_a_src - iop_a_src))) {
+        self->private_data.s_skip_frame[0].scratch -= ((uint64_t)(io2_a_src - iop_a_src));
+        iop_a_src = io2_a_src;
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      iop_a_src += self->private_data.s_skip_frame[0].scratch;
+      self->private_impl.f_chunk_length = 0;
+    }
+    label__0__break:;
+    wuffs_base__u32__sat_add_indirect(&self->private_impl.f_num_decoded_frames_value, 1);
+    if (self->private_impl.f_num_decoded_frames_value < self->private_impl.f_num_animation_frames_value) {
+      self->private_impl.f_call_sequence = 5;
+    } else {
+      self->private_impl.f_call_sequence = 255;
+    }
+
+    ok:
+    self->private_impl.p_skip_frame[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_skip_frame[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func png.decoder.decode_frame
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_png__decoder__decode_frame(
+    wuffs_png__decoder* self,
+    wuffs_base__pixel_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__pixel_blend a_blend,
+    wuffs_base__slice_u8 a_workbuf,
+    wuffs_base__decode_frame_options* a_opts) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+        ? wuffs_base__error__disabled_by_previous_error
+        : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst || !a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 3)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_seq_num = 0;
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  uint32_t v_pass_width = 0;
+  uint32_t v_pass_height = 0;
+  uint32_t v_roi = 0;
+  uint32_t v_roi_width = 0;
+  wuffs_base__pixel_format v_dst_pixfmt = {0};
+  bool v_has_color_conversion = false;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_frame[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_call_sequence == 255) {
+      status = wuffs_base__make_status(wuffs_base__note__end_of_data);
+      goto ok;
+    } else if (self->private_impl.f_call_sequence != 4) {
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      status = wuffs_png__decoder__decode_frame_config(self, NULL, a_src);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+    }
+    v_roi = 4294967295;
+    if (a_opts != NULL) {
+      v_roi = wuffs_base__decode_frame_options__roi_max_excl_x(a_opts);
+    }
+    self->private_impl.f_roi_x1 = wuffs_base__u32__min(v_roi, self->private_impl.f_width);
+    v_roi = 4294967295;
+    if (a_opts != NULL) {
+      v_roi = wuffs_base__decode_frame_options__roi_max_excl_y(a_opts);
+    }
+    self->private_impl.f_roi_y1 = wuffs_base__u32__min(v_roi, self->private_impl.f_height);
+    v_roi = 0;
+    if (a_opts != NULL) {
+      v_roi = wuffs_base__decode_frame_options__roi_min_incl_x(a_opts);
+    }
+    self->private_impl.f_roi_x0 = wuffs_base__u32__min(v_roi, self->private_impl.f_roi_x1);
+    v_roi = 0;
+    if (a_opts != NULL) {
+      v_roi = wuffs_base__decode_frame_options__roi_min_incl_y(a_opts);
+    }
+    self->private_impl.f_roi_y0 = wuffs_base__u32__min(v_roi, self->private_impl.f_roi_y1);
+    self->private_impl.f_downscale_shift = 0;
+    if (a_opts != NULL) {
+      self->private_impl.f_downscale_shift = wuffs_base__decode_frame_options__downscale_shift(a_opts);
+    }
+    self->private_impl.f_downscale_workbuf_length = 0;
+    if (self->private_impl.f_downscale_shift > 0) {
+      if (self->private_impl.f_interlace_pass > 0) {
+        status = wuffs_base__make_status(wuffs_base__error__unsupported_option);
+        goto exit;
+      }
+      v_roi_width = (((uint32_t)(self->private_impl.f_roi_x1 - self->private_impl.f_roi_x0)) & 16777215);
+      self->private_impl.f_downscale_workbuf_length = ((((uint64_t)(v_roi_width)) * 4) + (((((uint64_t)(v_roi_width)) + ((((uint64_t)(1)) << self->private_impl.f_downscale_shift) - 1)) >> self->private_impl.f_downscale_shift) * 8));
+      if (((uint64_t)(a_workbuf.len)) < (self->private_impl.f_streaming_workbuf_length + self->private_impl.f_downscale_workbuf_length)) {
+        status = wuffs_base__make_status(wuffs_base__error__bad_workbuf_length);
+        goto exit;
+      }
+    }
+    self->private_impl.f_band_height = 0;
+    if (a_opts != NULL) {
+      self->private_impl.f_band_height = wuffs_base__decode_frame_options__row_band_height(a_opts);
+    }
+    self->private_impl.f_band_y0 = self->private_impl.f_roi_y0;
+    self->private_impl.f_band_y1 = self->private_impl.f_roi_y1;
+    if (self->private_impl.f_band_height > 0) {
+      if ((self->private_impl.f_interlace_pass > 0) || (self->private_impl.f_downscale_shift > 0)) {
+        status = wuffs_base__make_status(wuffs_base__error__unsupported_option);
+        goto exit;
+      }
+      self->private_impl.f_band_y1 = wuffs_base__u32__min(self->private_impl.f_roi_y1, wuffs_base__u32__sat_add(self->private_impl.f_roi_y0, self->private_impl.f_band_height));
+    }
+    while (true) {
+      while (((uint64_t)(io2_a_src - iop_a_src)) < 8) {
+        if (a_src && a_src->meta.closed) {
+          status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+          goto exit;
+        }
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(2);
+      }
+      self->private_impl.f_chunk_length = wuffs_base__peek_u32be__no_bounds_check(iop_a_src);
+      self->private_impl.f_chunk_type = ((uint32_t)((wuffs_base__peek_u64le__no_bounds_check(iop_a_src) >> 32)));
+      if (self->private_impl.f_chunk_type == 1413563465) {
+        self->private_impl.f_chunk_type_array[0] = 73;
+        self->private_impl.f_chunk_type_array[1] = 68;
+        self->private_impl.f_chunk_type_array[2] = 65;
+        self->private_impl.f_chunk_type_array[3] = 84;
+        iop_a_src += 8;
+        if ( ! self->private_impl.f_ignore_checksum) {
+          wuffs_base__ignore_status(wuffs_crc32__ieee_hasher__initialize(&self->private_data.f_crc32,
+              sizeof (wuffs_crc32__ieee_hasher), WUFFS_VERSION, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+          wuffs_crc32__ieee_hasher__update_u32(&self->private_data.f_crc32, wuffs_base__make_slice_u8(self->private_impl.f_chunk_type_array, 4));
+        }
+        goto label__0__break;
+      } else if (self->private_impl.f_chunk_type == 1413571686) {
+        self->private_impl.f_chunk_type_array[0] = 102;
+        self->private_impl.f_chunk_type_array[1] = 100;
+        self->private_impl.f_chunk_type_array[2] = 65;
+        self->private_impl.f_chunk_type_array[3] = 84;
+        if (self->private_impl.f_chunk_length < 4) {
+          status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+          goto exit;
+        }
+        self->private_impl.f_chunk_length -= 4;
+        iop_a_src += 8;
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+          uint32_t t_0;
+          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+            t_0 = wuffs_base__peek_u32be__no_bounds_check(iop_a_src);
+            iop_a_src += 4;
+          } else {
+            self->private_data.s_decode_frame[0].scratch = 0;
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+            while (true) {
+              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+                goto suspend;
+              }
+              uint64_t* scratch = &self->private_data.s_decode_frame[0].scratch;
+              uint32_t num_bits_0 = ((uint32_t)(*scratch & 0xFF));
+              *scratch >>= 8;
+              *scratch <<= 8;
+              *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_0);
+              if (num_bits_0 == 24) {
+                t_0 = ((uint32_t)(*scratch >> 32));
+                break;
+              }
+              num_bits_0 += 8;
+              *scratch |= ((uint64_t)(num_bits_0));
+            }
+          }
+          v_seq_num = t_0;
+        }
+        if (v_seq_num != self->private_impl.f_next_animation_seq_num) {
+          status = wuffs_base__make_status(wuffs_png__error__bad_animation_sequence_number);
+          goto exit;
+        } else if (self->private_impl.f_next_animation_seq_num >= 4294967295) {
+          status = wuffs_base__make_status(wuffs_png__error__unsupported_png_file);
+          goto exit;
+        }
+        self->private_impl.f_next_animation_seq_num += 1;
+        goto label__0__break;
+      } else if (self->private_impl.f_chunk_type == 1280598886) {
+        status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+        goto exit;
+      }
+      self->private_data.s_decode_frame[0].scratch = (((uint64_t)(self->private_impl.f_chunk_length)) + 12);
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+      if (self->private_data.s_decode_frame[0].scratch > ((uint64_t)(io2_a_src - iop_a_src))) {
+        self->private_data.s_decode_frame[0].scratch -= ((uint64_t)(io2_a_src - iop_a_src));
+        iop_a_src = io2_a_src;
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      iop_a_src += self->private_data.s_decode_frame[0].scratch;
+      self->private_impl.f_chunk_length = 0;
+    }
+    label__0__break:;
+    if (self->private_impl.f_zlib_is_dirty) {
+      wuffs_base__ignore_status(wuffs_zlib__decoder__initialize(&self->private_data.f_zlib,
+          sizeof (wuffs_zlib__decoder), WUFFS_VERSION, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+      if (self->private_impl.f_ignore_checksum) {
+        wuffs_zlib__decoder__set_quirk_enabled(&self->private_data.f_zlib, 1, true);
+      }
+    }
+    self->private_impl.f_zlib_is_dirty = true;
+    v_status = wuffs_base__pixel_swizzler__prepare(&self->private_impl.f_swizzler,
+        wuffs_base__pixel_buffer__pixel_format(a_dst),
+        wuffs_base__pixel_buffer__palette_or_else(a_dst, wuffs_base__make_slice_u8(self->private_data.f_dst_palette, 1024)),
+        wuffs_base__utility__make_pixel_format(self->private_impl.f_src_pixfmt),
+        wuffs_base__make_slice_u8(self->private_data.f_src_palette, 1024),
+        a_blend);
+    if ( ! wuffs_base__status__is_ok(&v_status)) {
+      status = v_status;
+      if (wuffs_base__status__is_error(&status)) {
+        goto exit;
+      } else if (wuffs_base__status__is_suspension(&status)) {
+        status = wuffs_base__make_status(wuffs_base__error__cannot_return_a_suspension);
+        goto exit;
+      }
+      goto ok;
+    }
+    v_has_color_conversion = false;
+    if (a_opts != NULL) {
+      v_has_color_conversion = wuffs_base__decode_frame_options__has_color_conversion(a_opts);
+    }
+    if (v_has_color_conversion) {
+      v_status = wuffs_base__pixel_swizzler__set_color_conversion_from_options(&self->private_impl.f_swizzler, a_opts);
+      if ( ! wuffs_base__status__is_ok(&v_status)) {
+        status = v_status;
+        if (wuffs_base__status__is_error(&status)) {
+          goto exit;
+        } else if (wuffs_base__status__is_suspension(&status)) {
+          status = wuffs_base__make_status(wuffs_base__error__cannot_return_a_suspension);
+          goto exit;
+        }
+        goto ok;
+      }
+    }
+    if ((self->private_impl.f_src_pixfmt == 2701166728) && (self->private_impl.f_interlace_pass == 0)) {
+      v_dst_pixfmt = wuffs_base__pixel_buffer__pixel_format(a_dst);
+      if ((wuffs_base__pixel_format__repr(&v_dst_pixfmt) == 2181073032) &&
+          (wuffs_base__pixel_blend__repr(&a_blend) == 0) &&
+          (self->private_impl.f_downscale_shift == 0) &&
+          ! v_has_color_conversion) {
+        self->private_impl.choosy_filter_and_swizzle = (
+            &wuffs_png__decoder__filter_and_swizzle_rgba_bgra_premul);
+      } else {
+        self->private_impl.choosy_filter_and_swizzle = (
+            &wuffs_png__decoder__filter_and_swizzle__choosy_default);
+      }
+    }
+    self->private_impl.f_workbuf_hist_pos_base = 0;
+    self->private_impl.f_num_completed_interlace_passes_value = 0;
+    while (true) {
+      if (self->private_impl.f_chunk_type_array[0] == 73) {
+        v_pass_width = (16777215 & ((((uint32_t)(WUFFS_PNG__INTERLACING[self->private_impl.f_interlace_pass][1])) + self->private_impl.f_width) >> WUFFS_PNG__INTERLACING[self->private_impl.f_interlace_pass][0]));
+        v_pass_height = (16777215 & ((((uint32_t)(WUFFS_PNG__INTERLACING[self->private_impl.f_interlace_pass][4])) + self->private_impl.f_height) >> WUFFS_PNG__INTERLACING[self->private_impl.f_interlace_pass][3]));
+      } else {
+        v_pass_width = (16777215 & ((uint32_t)(self->private_impl.f_frame_rect_x1 - self->private_impl.f_frame_rect_x0)));
+        v_pass_height = (16777215 & ((uint32_t)(self->private_impl.f_frame_rect_y1 - self->private_impl.f_frame_rect_y0)));
+      }
+      if ((v_pass_width > 0) && (v_pass_height > 0)) {
+        self->private_impl.f_pass_bytes_per_row = wuffs_png__decoder__calculate_bytes_per_row(self, v_pass_width);
+        self->private_impl.f_pass_workbuf_length = (((uint64_t)(v_pass_height)) * (1 + self->private_impl.f_pass_bytes_per_row));
+        self->private_impl.f_pass_streaming = false;
+        self->private_impl.f_pass_workbuf_y0 = self->private_impl.f_frame_rect_y0;
+        self->private_impl.f_pass_stop_y = self->private_impl.f_frame_rect_y1;
+        self->private_impl.f_pass_resume_y = 0;
+        self->private_impl.f_downscale_num_rows = 0;
+        if (self->private_impl.f_workbuf_prefilled && (self->private_impl.f_interlace_pass == 0) && (self->private_impl.f_chunk_type_array[0] == 73)) {
+          if (a_src) {
+            a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+          }
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+          status = wuffs_png__decoder__skip_pass(self, a_src, a_workbuf);
+          if (a_src) {
+            iop_a_src = a_src->data.ptr + a_src->meta.ri;
+          }
+          if (status.repr) {
+            goto suspend;
+          }
+        } else if ((self->private_impl.f_interlace_pass == 0) && (((uint64_t)(a_workbuf.len)) < (self->private_impl.f_pass_workbuf_length + self->private_impl.f_downscale_workbuf_length))) {
+          self->private_impl.f_pass_streaming = true;
+          if (a_src) {
+            a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+          }
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+          status = wuffs_png__decoder__decode_pass_streaming(self, a_dst, a_src, a_workbuf);
+          if (a_src) {
+            iop_a_src = a_src->data.ptr + a_src->meta.ri;
+          }
+          if (status.repr) {
+            goto suspend;
+          }
+        } else {
+          if (a_src) {
+            a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+          }
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+          status = wuffs_png__decoder__decode_pass(self, a_src, a_workbuf);
+          if (a_src) {
+            iop_a_src = a_src->data.ptr + a_src->meta.ri;
+          }
+          if (status.repr) {
+            goto suspend;
+          }
+        }
+        if ( ! self->private_impl.f_pass_streaming) {
+          while (true) {
+            v_status = wuffs_png__decoder__filter_and_swizzle(self, a_dst, a_workbuf);
+            if (wuffs_base__status__is_ok(&v_status)) {
+              goto label__1__break;
+            } else if (v_status.repr != wuffs_png__note__internal_note_short_write) {
+              status = v_status;
+              if (wuffs_base__status__is_error(&status)) {
+                goto exit;
+              } else if (wuffs_base__status__is_suspension(&status)) {
+                status = wuffs_base__make_status(wuffs_base__error__cannot_return_a_suspension);
+                goto exit;
+              }
+              goto ok;
+            }
+            status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(9);
+            self->private_impl.f_band_y0 = self->private_impl.f_band_y1;
+            self->private_impl.f_band_y1 = wuffs_base__u32__min(self->private_impl.f_roi_y1, wuffs_base__u32__sat_add(self->private_impl.f_band_y0, self->private_impl.f_band_height));
+          }
+          label__1__break:;
+        }
+        self->private_impl.f_workbuf_hist_pos_base += self->private_impl.f_pass_workbuf_length;
+      }
+      if ((self->private_impl.f_chunk_type_array[0] == 73) && (1 <= self->private_impl.f_interlace_pass) && (self->private_impl.f_interlace_pass <= 6)) {
+        self->private_impl.f_num_completed_interlace_passes_value = self->private_impl.f_interlace_pass;
+        if (self->private_impl.f_replicate_interlace_passes) {
+          wuffs_png__decoder__replicate_interlace_pass(self, a_dst);
+          status = wuffs_base__make_status(wuffs_png__suspension__interlace_pass_complete);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(10);
+        } else if (self->private_impl.f_report_interlace_passes) {
+          status = wuffs_base__make_status(wuffs_png__suspension__interlace_pass_complete);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(11);
+        }
+      }
+      if ((self->private_impl.f_interlace_pass == 0) || (self->private_impl.f_interlace_pass >= 7)) {
+        goto label__2__break;
+      }
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#endif
+      self->private_impl.f_interlace_pass += 1;
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+    }
+    label__2__break:;
+    if ((self->private_impl.f_interlace_pass > 0) && (self->private_impl.f_chunk_type_array[0] == 73)) {
+      self->private_impl.f_num_completed_interlace_passes_value = 7;
+    }
+    wuffs_base__u32__sat_add_indirect(&self->private_impl.f_num_decoded_frames_value, 1);
+    if (self->private_impl.f_num_decoded_frames_value < self->private_impl.f_num_animation_frames_value) {
+      self->private_impl.f_call_sequence = 5;
+    } else {
+      self->private_impl.f_call_sequence = 255;
+    }
+
+    ok:
+    self->private_impl.p_decode_frame[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_frame[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine = wuffs_base__status__is_suspension(&status) ? 3 : 0;
+  WUFFS_BASE__STATS__ADD(self->private_impl, WUFFS_BASE__STATS__SUSPENSIONS,
+      wuffs_base__status__is_suspension(&status) ? 1u : 0u);
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func png.decoder.downscale_scratch
+
+static wuffs_base__slice_u8
+wuffs_png__decoder__downscale_scratch(
+    const wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_workbuf,
+    uint64_t a_bytes_per_pixel) {
+  wuffs_base__slice_u8 v_ws = {0};
+
+  v_ws = wuffs_base__slice_u8__suffix(a_workbuf, self->private_impl.f_downscale_workbuf_length);
+  return wuffs_base__slice_u8__prefix(v_ws, (((uint64_t)(((uint32_t)(self->private_impl.f_roi_x1 - self->private_impl.f_roi_x0)))) * a_bytes_per_pixel));
+}
+
+// -------- func png.decoder.downscale_row
+
+static uint32_t
+wuffs_png__decoder__downscale_row(
+    wuffs_png__decoder* self,
+    wuffs_base__pixel_buffer* a_dst,
+    wuffs_base__slice_u8 a_workbuf,
+    uint32_t a_y,
+    uint32_t a_num_rows,
+    uint64_t a_bytes_per_pixel) {
+  wuffs_base__slice_u8 v_ws = {0};
+  uint64_t v_n = 0;
+  uint32_t v_x0 = 0;
+  uint32_t v_x1 = 0;
+  uint64_t v_i = 0;
+  uint64_t v_j = 0;
+  uint32_t v_dy = 0;
+  wuffs_base__table_u8 v_tab = {0};
+
+  v_ws = wuffs_base__slice_u8__suffix(a_workbuf, self->private_impl.f_downscale_workbuf_length);
+  v_n = (((uint64_t)(((uint32_t)(self->private_impl.f_roi_x1 - self->private_impl.f_roi_x0)))) * a_bytes_per_pixel);
+  if (v_n > ((uint64_t)(v_ws.len))) {
+    return 0;
+  }
+  v_x0 = ((uint32_t)(wuffs_base__u32__max(self->private_impl.f_frame_rect_x0, self->private_impl.f_roi_x0) - self->private_impl.f_roi_x0));
+  v_x1 = ((uint32_t)(wuffs_base__u32__min(self->private_impl.f_frame_rect_x1, self->private_impl.f_roi_x1) - self->private_impl.f_roi_x0));
+  v_i = (((uint64_t)(v_x0)) * a_bytes_per_pixel);
+  v_j = (((uint64_t)(v_x1)) * a_bytes_per_pixel);
+  if ((v_x0 >= v_x1) || (v_i > v_j) || (v_j > v_n)) {
+    return 0;
+  }
+  wuffs_base__utility__downscale_accumulate(
+      wuffs_base__slice_u8__subslice_i(v_ws, v_n),
+      wuffs_base__slice_u8__subslice_ij(v_ws, v_i, v_j),
+      v_x0,
+      a_num_rows,
+      ((uint32_t)(a_bytes_per_pixel)),
+      self->private_impl.f_downscale_shift);
+  v_dy = ((uint32_t)(a_y - self->private_impl.f_roi_y0));
+  if (((((uint32_t)(v_dy + 1)) & ((((uint32_t)(1)) << self->private_impl.f_downscale_shift) - 1)) != 0) && (((uint32_t)(a_y + 1)) < wuffs_base__u32__min(self->private_impl.f_frame_rect_y1, self->private_impl.f_roi_y1))) {
+    return ((uint32_t)(a_num_rows + 1));
+  }
+  v_tab = wuffs_base__pixel_buffer__plane(a_dst, 0);
+  wuffs_base__utility__downscale_flush(
+      wuffs_base__table_u8__row_u32(v_tab, (v_dy >> self->private_impl.f_downscale_shift)),
+      wuffs_base__slice_u8__subslice_i(v_ws, v_n),
+      v_x0,
+      v_x1,
+      ((uint32_t)(a_num_rows + 1)),
+      ((uint32_t)(a_bytes_per_pixel)),
+      self->private_impl.f_downscale_shift);
+  return 0;
+}
+
+// -------- func png.decoder.replicate_interlace_pass
+
+static wuffs_base__empty_struct
+wuffs_png__decoder__replicate_interlace_pass(
+    wuffs_png__decoder* self,
+    wuffs_base__pixel_buffer* a_dst) {
+  wuffs_base__pixel_format v_dst_pixfmt = {0};
+  uint32_t v_dst_bits_per_pixel = 0;
+  uint64_t v_dst_bytes_per_pixel = 0;
+  uint64_t v_dst_bytes_per_row = 0;
+  wuffs_base__table_u8 v_tab = {0};
+  uint32_t v_x_mask = 0;
+  uint32_t v_y_mask = 0;
+  uint32_t v_x = 0;
+  uint32_t v_y = 0;
+  uint32_t v_anchor = 0;
+  uint64_t v_i = 0;
+  uint64_t v_j = 0;
+  wuffs_base__slice_u8 v_dst = {0};
+  wuffs_base__slice_u8 v_src = {0};
+  wuffs_base__slice_u8 v_d = {0};
+  wuffs_base__slice_u8 v_s = {0};
+
+  v_dst_pixfmt = wuffs_base__pixel_buffer__pixel_format(a_dst);
+  v_dst_bits_per_pixel = wuffs_base__pixel_format__bits_per_pixel(&v_dst_pixfmt);
+  if ((v_dst_bits_per_pixel & 7) != 0) {
+    return wuffs_base__make_empty_struct();
+  }
+  v_dst_bytes_per_pixel = ((uint64_t)((v_dst_bits_per_pixel / 8)));
+  v_dst_bytes_per_row = (((uint64_t)(((uint32_t)(self->private_impl.f_roi_x1 - self->private_impl.f_roi_x0)))) * v_dst_bytes_per_pixel);
+  v_tab = wuffs_base__pixel_buffer__plane(a_dst, 0);
+  v_x_mask = ((uint32_t)(((uint32_t)(4294967295)) << WUFFS_PNG__INTERLACING_PREVIEW_SHIFTS[self->private_impl.f_num_completed_interlace_passes_value][0]));
+  v_y_mask = ((uint32_t)(((uint32_t)(4294967295)) << WUFFS_PNG__INTERLACING_PREVIEW_SHIFTS[self->private_impl.f_num_completed_interlace_passes_value][1]));
+  v_y = self->private_impl.f_roi_y0;
+  while ((v_y < self->private_impl.f_frame_rect_y1) && (v_y < self->private_impl.f_roi_y1)) {
+    v_dst = wuffs_base__table_u8__row_u32(v_tab, ((uint32_t)(v_y - self->private_impl.f_roi_y0)));
+    if (v_dst_bytes_per_row < ((uint64_t)(v_dst.len))) {
+      v_dst = wuffs_base__slice_u8__subslice_j(v_dst, v_dst_bytes_per_row);
+    }
+    v_anchor = (v_y & v_y_mask);
+    if (v_anchor == v_y) {
+      v_x = self->private_impl.f_roi_x0;
+      while (v_x < self->private_impl.f_roi_x1) {
+        v_anchor = (v_x & v_x_mask);
+        if ((v_anchor != v_x) && (v_anchor >= self->private_impl.f_roi_x0)) {
+          v_i = (((uint64_t)(((uint32_t)(v_x - self->private_impl.f_roi_x0)))) * v_dst_bytes_per_pixel);
+          v_j = (((uint64_t)(((uint32_t)(v_anchor - self->private_impl.f_roi_x0)))) * v_dst_bytes_per_pixel);
+          if ((v_i <= ((uint64_t)(v_dst.len))) && (v_j <= ((uint64_t)(v_dst.len)))) {
+            v_d = wuffs_base__slice_u8__subslice_i(v_dst, v_i);
+            v_s = wuffs_base__slice_u8__subslice_i(v_dst, v_j);
+            wuffs_base__slice_u8__copy_from_slice(wuffs_base__slice_u8__prefix(v_d, v_dst_bytes_per_pixel), wuffs_base__slice_u8__prefix(v_s, v_dst_bytes_per_pixel));
+          }
+        }
+        v_x += 1;
+      }
+    } else if (v_anchor >= self->private_impl.f_roi_y0) {
+      v_src = wuffs_base__table_u8__row_u32(v_tab, ((uint32_t)(v_anchor - self->private_impl.f_roi_y0)));
+      wuffs_base__slice_u8__copy_from_slice(v_dst, v_src);
+    }
+    v_y += 1;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func png.decoder.decode_pass
+
+static wuffs_base__status
+wuffs_png__decoder__decode_pass(
+    wuffs_png__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  wuffs_base__io_buffer u_w = wuffs_base__empty_io_buffer();
+  wuffs_base__io_buffer* v_w = &u_w;
+  uint8_t* iop_v_w WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io0_v_w WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_v_w WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_v_w WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint64_t v_w_mark = 0;
+  uint64_t v_r_mark = 0;
+  wuffs_base__status v_zlib_status = wuffs_base__make_status(NULL);
+  uint32_t v_checksum_have = 0;
+  uint32_t v_checksum_want = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_pass[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    self->private_impl.f_workbuf_wi = 0;
+    label__0__continue:;
+    while (true) {
+      if ((self->private_impl.f_workbuf_wi > self->private_impl.f_pass_workbuf_length) || (self->private_impl.f_pass_workbuf_length > ((uint64_t)(a_workbuf.len)))) {
+        status = wuffs_base__make_status(wuffs_base__error__bad_workbuf_length);
+        goto exit;
+      }
+      {
+        wuffs_base__io_buffer* o_0_v_w = v_w;
+        uint8_t *o_0_iop_v_w = iop_v_w;
+        uint8_t *o_0_io0_v_w = io0_v_w;
+        uint8_t *o_0_io1_v_w = io1_v_w;
+        uint8_t *o_0_io2_v_w = io2_v_w;
+        v_w = wuffs_base__io_writer__set(
+            &u_w,
+            &iop_v_w,
+            &io0_v_w,
+            &io1_v_w,
+            &io2_v_w,
+            wuffs_base__slice_u8__subslice_ij(a_workbuf,
+            self->private_impl.f_workbuf_wi,
+            self->private_impl.f_pass_workbuf_length),
+            ((uint64_t)(self->private_impl.f_workbuf_hist_pos_base + self->private_impl.f_workbuf_wi)));
+        {
+          const uint8_t *o_1_io2_a_src = io2_a_src;
+          wuffs_base__io_reader__limit(&io2_a_src, iop_a_src,
+              ((uint64_t)(self->private_impl.f_chunk_length)));
+          if (a_src) {
+            a_src->meta.wi = ((size_t)(io2_a_src - a_src->data.ptr));
+          }
+          v_w_mark = ((uint64_t)(iop_v_w - io0_v_w));
+          v_r_mark = ((uint64_t)(iop_a_src - io0_a_src));
+          {
+            u_w.meta.wi = ((size_t)(iop_v_w - u_w.data.ptr));
+            if (a_src) {
+              a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+            }
+            wuffs_base__status t_0 = wuffs_zlib__decoder__transform_io(&self->private_data.f_zlib, v_w, a_src, wuffs_base__make_slice_u8(self->private_data.f_zlib_workbuf, 33025));
+            v_zlib_status = t_0;
+            iop_v_w = u_w.data.ptr + u_w.meta.wi;
+            if (a_src) {
+              iop_a_src = a_src->data.ptr + a_src->meta.ri;
+            }
+          }
+          if ( ! self->private_impl.f_ignore_checksum) {
+            wuffs_crc32__ieee_hasher__update_u32(&self->private_data.f_crc32, wuffs_base__io__since(v_r_mark, ((uint64_t)(iop_a_src - io0_a_src)), io0_a_src));
+          }
+          wuffs_base__u32__sat_sub_indirect(&self->private_impl.f_chunk_length, ((uint32_t)((wuffs_base__io__count_since(v_r_mark, ((uint64_t)(iop_a_src - io0_a_src))) & 4294967295))));
+          wuffs_base__u64__sat_add_indirect(&self->private_impl.f_workbuf_wi, wuffs_base__io__count_since(v_w_mark, ((uint64_t)(iop_v_w - io0_v_w))));
+          io2_a_src = o_1_io2_a_src;
+          if (a_src) {
+            a_src->meta.wi = ((size_t)(io2_a_src - a_src->data.ptr));
+          }
+        }
+        v_w = o_0_v_w;
+        iop_v_w = o_0_iop_v_w;
+        io0_v_w = o_0_io0_v_w;
+        io1_v_w = o_0_io1_v_w;
+        io2_v_w = o_0_io2_v_w;
+      }
+      if (wuffs_base__status__is_ok(&v_zlib_status)) {
+        if (self->private_impl.f_chunk_length > 0) {
+          status = wuffs_base__make_status(wuffs_base__error__too_much_data);
+          goto exit;
+        }
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+          uint32_t t_1;
+          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+            t_1 = wuffs_base__peek_u32be__no_bounds_check(iop_a_src);
+            iop_a_src += 4;
+          } else {
+            self->private_data.s_decode_pass[0].scratch = 0;
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+            while (true) {
+              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+                goto suspend;
+              }
+              uint64_t* scratch = &self->private_data.s_decode_pass[0].scratch;
+              uint32_t num_bits_1 = ((uint32_t)(*scratch & 0xFF));
+              *scratch >>= 8;
+              *scratch <<= 8;
+              *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_1);
+              if (num_bits_1 == 24) {
+                t_1 = ((uint32_t)(*scratch >> 32));
+                break;
+              }
+              num_bits_1 += 8;
+              *scratch |= ((uint64_t)(num_bits_1));
+            }
+          }
+          v_checksum_want = t_1;
+        }
+        if ( ! self->private_impl.f_ignore_checksum && (self->private_impl.f_chunk_type_array[0] == 73)) {
+          v_checksum_have = wuffs_crc32__ieee_hasher__update_u32(&self->private_data.f_crc32, wuffs_base__utility__empty_slice_u8());
+          if (v_checksum_have != v_checksum_want) {
+            status = wuffs_base__make_status(wuffs_png__error__bad_checksum);
+            goto exit;
+          }
+        }
+        goto label__0__break;
+      } else if (v_zlib_status.repr == wuffs_base__suspension__short_write) {
+        if ((1 <= self->private_impl.f_interlace_pass) && (self->private_impl.f_interlace_pass <= 6)) {
+          goto label__0__break;
+        }
+        status = wuffs_base__make_status(wuffs_base__error__too_much_data);
+        goto exit;
+      } else if (v_zlib_status.repr != wuffs_base__suspension__short_read) {
+        status = v_zlib_status;
+        if (wuffs_base__status__is_error(&status)) {
+          goto exit;
+        } else if (wuffs_base__status__is_suspension(&status)) {
+          status = wuffs_base__make_status(wuffs_base__error__cannot_return_a_suspension);
+          goto exit;
+        }
+        goto ok;
+      } else if (self->private_impl.f_chunk_length == 0) {
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+        status = wuffs_png__decoder__decode_pass_next_chunk(self, a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+        goto label__0__continue;
+      } else if (((uint64_t)(io2_a_src - iop_a_src)) > 0) {
+        status = wuffs_base__make_status(wuffs_png__error__internal_error_zlib_decoder_did_not_exhaust_its_input);
+        goto exit;
+      }
+      status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(4);
+    }
+    label__0__break:;
+    if (self->private_impl.f_workbuf_wi != self->private_impl.f_pass_workbuf_length) {
+      status = wuffs_base__make_status(wuffs_base__error__not_enough_data);
+      goto exit;
+    } else if (0 < ((uint64_t)(a_workbuf.len))) {
+      if (a_workbuf.ptr[0] == 4) {
+        a_workbuf.ptr[0] = 1;
+      }
+    }
+
+    ok:
+    self->private_impl.p_decode_pass[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_pass[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func png.decoder.decode_pass_streaming
+
+static wuffs_base__status
+wuffs_png__decoder__decode_pass_streaming(
+    wuffs_png__decoder* self,
+    wuffs_base__pixel_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  wuffs_base__io_buffer u_w = wuffs_base__empty_io_buffer();
+  wuffs_base__io_buffer* v_w = &u_w;
+  uint8_t* iop_v_w WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io0_v_w WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_v_w WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_v_w WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint64_t v_w_mark = 0;
+  uint64_t v_r_mark = 0;
+  wuffs_base__status v_zlib_status = wuffs_base__make_status(NULL);
+  uint32_t v_checksum_have = 0;
+  uint32_t v_checksum_want = 0;
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  uint64_t v_row_length = 0;
+  uint64_t v_row_wi = 0;
+  uint64_t v_lo = 0;
+  uint64_t v_hi = 0;
+  uint32_t v_y = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_pass_streaming[0];
+  if (coro_susp_point) {
+    v_zlib_status = self->private_data.s_decode_pass_streaming[0].v_zlib_status;
+    v_status = self->private_data.s_decode_pass_streaming[0].v_status;
+    v_row_length = self->private_data.s_decode_pass_streaming[0].v_row_length;
+    v_row_wi = self->private_data.s_decode_pass_streaming[0].v_row_wi;
+    v_y = self->private_data.s_decode_pass_streaming[0].v_y;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    v_row_length = (1 + self->private_impl.f_pass_bytes_per_row);
+    if (((2 * v_row_length) + self->private_impl.f_downscale_workbuf_length) > ((uint64_t)(a_workbuf.len))) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_workbuf_length);
+      goto exit;
+    }
+    v_y = self->private_impl.f_frame_rect_y0;
+    self->private_impl.f_workbuf_wi = 0;
+    label__0__continue:;
+    while (true) {
+      v_hi = (2 * v_row_length);
+      v_lo = v_hi;
+      if (v_y < self->private_impl.f_frame_rect_y1) {
+        v_lo = wuffs_base__u64__sat_add(v_row_length, v_row_wi);
+      }
+      if ((v_lo > v_hi) || (v_hi > ((uint64_t)(a_workbuf.len)))) {
+        status = wuffs_base__make_status(wuffs_base__error__bad_workbuf_length);
+        goto exit;
+      }
+      {
+        wuffs_base__io_buffer* o_0_v_w = v_w;
+        uint8_t *o_0_iop_v_w = iop_v_w;
+        uint8_t *o_0_io0_v_w = io0_v_w;
+        uint8_t *o_0_io1_v_w = io1_v_w;
+        uint8_t *o_0_io2_v_w = io2_v_w;
+        v_w = wuffs_base__io_writer__set(
+            &u_w,
+            &iop_v_w,
+            &io0_v_w,
+            &io1_v_w,
+            &io2_v_w,
+            wuffs_base__slice_u8__subslice_ij(a_workbuf, v_lo, v_hi),
+            ((uint64_t)(self->private_impl.f_workbuf_hist_pos_base + self->private_impl.f_workbuf_wi)));
+        {
+          const uint8_t *o_1_io2_a_src = io2_a_src;
+          wuffs_base__io_reader__limit(&io2_a_src, iop_a_src,
+              ((uint64_t)(self->private_impl.f_chunk_length)));
+          if (a_src) {
+            a_src->meta.wi = ((size_t)(io2_a_src - a_src->data.ptr));
+          }
+          v_w_mark = ((uint64_t)(iop_v_w - io0_v_w));
+          v_r_mark = ((uint64_t)(iop_a_src - io0_a_src));
+          {
+            u_w.meta.wi = ((size_t)(iop_v_w - u_w.data.ptr));
+            if (a_src) {
+              a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+            }
+            wuffs_base__status t_0 = wuffs_zlib__decoder__transform_io(&self->private_data.f_zlib, v_w, a_src, wuffs_base__make_slice_u8(self->private_data.f_zlib_workbuf, 33025));
+            v_zlib_status = t_0;
+            iop_v_w = u_w.data.ptr + u_w.meta.wi;
+            if (a_src) {
+              iop_a_src = a_src->data.ptr + a_src->meta.ri;
+            }
+          }
+          if ( ! self->private_impl.f_ignore_checksum) {
+            wuffs_crc32__ieee_hasher__update_u32(&self->private_data.f_crc32, wuffs_base__io__since(v_r_mark, ((uint64_t)(iop_a_src - io0_a_src)), io0_a_src));
+          }
+          wuffs_base__u32__sat_sub_indirect(&self->private_impl.f_chunk_length, ((uint32_t)((wuffs_base__io__count_since(v_r_mark, ((uint64_t)(iop_a_src - io0_a_src))) & 4294967295))));
+          wuffs_base__u64__sat_add_indirect(&self->private_impl.f_workbuf_wi, wuffs_base__io__count_since(v_w_mark, ((uint64_t)(iop_v_w - io0_v_w))));
+          wuffs_base__u64__sat_add_indirect(&v_row_wi, wuffs_base__io__count_since(v_w_mark, ((uint64_t)(iop_v_w - io0_v_w))));
+          io2_a_src = o_1_io2_a_src;
+          if (a_src) {
+            a_src->meta.wi = ((size_t)(io2_a_src - a_src->data.ptr));
+          }
+        }
+        v_w = o_0_v_w;
+        iop_v_w = o_0_iop_v_w;
+        io0_v_w = o_0_io0_v_w;
+        io1_v_w = o_0_io1_v_w;
+        io2_v_w = o_0_io2_v_w;
+      }
+      if ((v_y < self->private_impl.f_frame_rect_y1) && (v_row_wi >= v_row_length)) {
+        if (v_row_length >= ((uint64_t)(a_workbuf.len))) {
+          status = wuffs_base__make_status(wuffs_base__error__bad_workbuf_length);
+          goto exit;
+        }
+        if (v_y <= self->private_impl.f_frame_rect_y0) {
+          if (a_workbuf.ptr[v_row_length] == 4) {
+            a_workbuf.ptr[v_row_length] = 1;
+          }
+          self->private_impl.f_pass_workbuf_y0 = v_y;
+        } else {
+          self->private_impl.f_pass_workbuf_y0 = ((uint32_t)(v_y - 1));
+        }
+        self->private_impl.f_pass_resume_y = v_y;
+        self->private_impl.f_pass_stop_y = ((uint32_t)(v_y + 1));
+        while (true) {
+          if (v_row_length > ((uint64_t)(a_workbuf.len))) {
+            status = wuffs_base__make_status(wuffs_base__error__bad_workbuf_length);
+            goto exit;
+          } else if (v_y <= self->private_impl.f_frame_rect_y0) {
+            v_status = wuffs_png__decoder__filter_and_swizzle(self, a_dst, wuffs_base__slice_u8__subslice_i(a_workbuf, v_row_length));
+          } else {
+            v_status = wuffs_png__decoder__filter_and_swizzle(self, a_dst, a_workbuf);
+          }
+          if (wuffs_base__status__is_ok(&v_status)) {
+            goto label__1__break;
+          } else if (v_status.repr != wuffs_png__note__internal_note_short_write) {
+            status = v_status;
+            if (wuffs_base__status__is_error(&status)) {
+              goto exit;
+            } else if (wuffs_base__status__is_suspension(&status)) {
+              status = wuffs_base__make_status(wuffs_base__error__cannot_return_a_suspension);
+              goto exit;
+            }
+            goto ok;
+          }
+          status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
+          self->private_impl.f_band_y0 = self->private_impl.f_band_y1;
+          self->private_impl.f_band_y1 = wuffs_base__u32__min(self->private_impl.f_roi_y1, wuffs_base__u32__sat_add(self->private_impl.f_band_y0, self->private_impl.f_band_height));
+        }
+        label__1__break:;
+        if (v_row_length > ((uint64_t)(a_workbuf.len))) {
+          status = wuffs_base__make_status(wuffs_base__error__bad_workbuf_length);
+          goto exit;
+        }
+        wuffs_base__slice_u8__copy_from_slice(wuffs_base__slice_u8__subslice_j(a_workbuf, v_row_length), wuffs_base__slice_u8__subslice_i(a_workbuf, v_row_length));
+        v_row_wi = 0;
+        v_y += 1;
+      }
+      if (wuffs_base__status__is_ok(&v_zlib_status)) {
+        if (self->private_impl.f_chunk_length > 0) {
+          status = wuffs_base__make_status(wuffs_base__error__too_much_data);
+          goto exit;
+        }
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+          uint32_t t_1;
+          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+            t_1 = wuffs_base__peek_u32be__no_bounds_check(iop_a_src);
+            iop_a_src += 4;
+          } else {
+            self->private_data.s_decode_pass_streaming[0].scratch = 0;
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+            while (true) {
+              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+                goto suspend;
+              }
+              uint64_t* scratch = &self->private_data.s_decode_pass_streaming[0].scratch;
+              uint32_t num_bits_1 = ((uint32_t)(*scratch & 0xFF));
+              *scratch >>= 8;
+              *scratch <<= 8;
+              *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_1);
+              if (num_bits_1 == 24) {
+                t_1 = ((uint32_t)(*scratch >> 32));
+                break;
+              }
+              num_bits_1 += 8;
+              *scratch |= ((uint64_t)(num_bits_1));
+            }
+          }
+          v_checksum_want = t_1;
+        }
+        if ( ! self->private_impl.f_ignore_checksum && (self->private_impl.f_chunk_type_array[0] == 73)) {
+          v_checksum_have = wuffs_crc32__ieee_hasher__update_u32(&self->private_data.f_crc32, wuffs_base__utility__empty_slice_u8());
+          if (v_checksum_have != v_checksum_want) {
+            status = wuffs_base__make_status(wuffs_png__error__bad_checksum);
+            goto exit;
+          }
+        }
+        goto label__0__break;
+      } else if (v_zlib_status.repr == wuffs_base__suspension__short_write) {
+        if (v_y < self->private_impl.f_frame_rect_y1) {
+          goto label__0__continue;
+        }
+        status = wuffs_base__make_status(wuffs_base__error__too_much_data);
+        goto exit;
+      } else if (v_zlib_status.repr != wuffs_base__suspension__short_read) {
+        status = v_zlib_status;
+        if (wuffs_base__status__is_error(&status)) {
+          goto exit;
+        } else if (wuffs_base__status__is_suspension(&status)) {
+          status = wuffs_base__make_status(wuffs_base__error__cannot_return_a_suspension);
+          goto exit;
+        }
+        goto ok;
+      } else if (self->private_impl.f_chunk_length == 0) {
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+        status = wuffs_png__decoder__decode_pass_next_chunk(self, a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+        goto label__0__continue;
+      } else if (((uint64_t)(io2_a_src - iop_a_src)) > 0) {
+        status = wuffs_base__make_status(wuffs_png__error__internal_error_zlib_decoder_did_not_exhaust_its_input);
+        goto exit;
+      }
+      status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(5);
+    }
+    label__0__break:;
+    if (v_y < self->private_impl.f_frame_rect_y1) {
+      status = wuffs_base__make_status(wuffs_base__error__not_enough_data);
+      goto exit;
+    }
+
+    ok:
+    self->private_impl.p_decode_pass_streaming[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_pass_streaming[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_decode_pass_streaming[0].v_zlib_status = v_zlib_status;
+  self->private_data.s_decode_pass_streaming[0].v_status = v_status;
+  self->private_data.s_decode_pass_streaming[0].v_row_length = v_row_length;
+  self->private_data.s_decode_pass_streaming[0].v_row_wi = v_row_wi;
+  self->private_data.s_decode_pass_streaming[0].v_y = v_y;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func png.decoder.decode_pass_next_chunk
+
+static wuffs_base__status
+wuffs_png__decoder__decode_pass_next_chunk(
+    wuffs_png__decoder* self,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_checksum_have = 0;
+  uint32_t v_checksum_want = 0;
+  uint32_t v_seq_num = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_pass_next_chunk[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      uint32_t t_0;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+        t_0 = wuffs_base__peek_u32be__no_bounds_check(iop_a_src);
+        iop_a_src += 4;
+      } else {
+        self->private_data.s_decode_pass_next_chunk[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_pass_next_chunk[0].scratch;
+          uint32_t num_bits_0 = ((uint32_t)(*scratch & 0xFF));
+          *scratch >>= 8;
+          *scratch <<= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_0);
+          if (num_bits_0 == 24) {
+            t_0 = ((uint32_t)(*scratch >> 32));
+            break;
+          }
+          num_bits_0 += 8;
+          *scratch |= ((uint64_t)(num_bits_0));
+        }
+      }
+      v_checksum_want = t_0;
+    }
+    if ( ! self->private_impl.f_ignore_checksum && (self->private_impl.f_chunk_type_array[0] == 73)) {
+      v_checksum_have = wuffs_crc32__ieee_hasher__update_u32(&self->private_data.f_crc32, wuffs_base__utility__empty_slice_u8());
+      if (v_checksum_have != v_checksum_want) {
+        status = wuffs_base__make_status(wuffs_png__error__bad_checksum);
+        goto exit;
+      }
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      uint32_t t_1;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+        t_1 = wuffs_base__peek_u32be__no_bounds_check(iop_a_src);
+        iop_a_src += 4;
+      } else {
+        self->private_data.s_decode_pass_next_chunk[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_pass_next_chunk[0].scratch;
+          uint32_t num_bits_1 = ((uint32_t)(*scratch & 0xFF));
+          *scratch >>= 8;
+          *scratch <<= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_1);
+          if (num_bits_1 == 24) {
+            t_1 = ((uint32_t)(*scratch >> 32));
+            break;
+          }
+          num_bits_1 += 8;
+          *scratch |= ((uint64_t)(num_bits_1));
+        }
+      }
+      self->private_impl.f_chunk_length = t_1;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+      uint32_t t_2;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+        t_2 = wuffs_base__peek_u32le__no_bounds_check(iop_a_src);
+        iop_a_src += 4;
+      } else {
+        self->private_data.s_decode_pass_next_chunk[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_pass_next_chunk[0].scratch;
+          uint32_t num_bits_2 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_2;
+          if (num_bits_2 == 24) {
+            t_2 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_2 += 8;
+          *scratch |= ((uint64_t)(num_bits_2)) << 56;
+        }
+      }
+      self->private_impl.f_chunk_type = t_2;
+    }
+    if (self->private_impl.f_chunk_type_array[0] == 73) {
+      if (self->private_impl.f_chunk_type != 1413563465) {
+        status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+        goto exit;
+      }
+      if ( ! self->private_impl.f_ignore_checksum) {
+        wuffs_base__ignore_status(wuffs_crc32__ieee_hasher__initialize(&self->private_data.f_crc32,
+            sizeof (wuffs_crc32__ieee_hasher), WUFFS_VERSION, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+        wuffs_crc32__ieee_hasher__update_u32(&self->private_data.f_crc32, wuffs_base__make_slice_u8(self->private_impl.f_chunk_type_array, 4));
+      }
+    } else {
+      if ((self->private_impl.f_chunk_type != 1413571686) || (self->private_impl.f_chunk_length < 4)) {
+        status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+        goto exit;
+      }
+      self->private_impl.f_chunk_length -= 4;
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+        uint32_t t_3;
+        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+          t_3 = wuffs_base__peek_u32be__no_bounds_check(iop_a_src);
+          iop_a_src += 4;
+        } else {
+          self->private_data.s_decode_pass_next_chunk[0].scratch = 0;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+          while (true) {
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint64_t* scratch = &self->private_data.s_decode_pass_next_chunk[0].scratch;
+            uint32_t num_bits_3 = ((uint32_t)(*scratch & 0xFF));
+            *scratch >>= 8;
+            *scratch <<= 8;
+            *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_3);
+            if (num_bits_3 == 24) {
+              t_3 = ((uint32_t)(*scratch >> 32));
+              break;
+            }
+            num_bits_3 += 8;
+            *scratch |= ((uint64_t)(num_bits_3));
+          }
+        }
+        v_seq_num = t_3;
+      }
+      if (v_seq_num != self->private_impl.f_next_animation_seq_num) {
+        status = wuffs_base__make_status(wuffs_png__error__bad_animation_sequence_number);
+        goto exit;
+      } else if (self->private_impl.f_next_animation_seq_num >= 4294967295) {
+        status = wuffs_base__make_status(wuffs_png__error__unsupported_png_file);
+        goto exit;
+      }
+      self->private_impl.f_next_animation_seq_num += 1;
+    }
+
+    goto ok;
+    ok:
+    self->private_impl.p_decode_pass_next_chunk[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_pass_next_chunk[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func png.decoder.skip_pass
+
+static wuffs_base__status
+wuffs_png__decoder__skip_pass(
+    wuffs_png__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_skip_pass[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_pass_workbuf_length > ((uint64_t)(a_workbuf.len))) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_workbuf_length);
+      goto exit;
+    }
+    while (true) {
+      self->private_data.s_skip_pass[0].scratch = (((uint64_t)(self->private_impl.f_chunk_length)) + 4);
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      if (self->private_data.s_skip_pass[0].scratch > ((uint64_t)(io2_a_src - iop_a_src))) {
+        self->private_data.s_skip_pass[0].scratch -= ((uint64_t)(io2_a_src - iop_a_src));
+        iop_a_src = io2_a_src;
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      iop_a_src += self->private_data.s_skip_pass[0].scratch;
+      self->private_impl.f_chunk_length = 0;
+      while (((uint64_t)(io2_a_src - iop_a_src)) < 8) {
+        if (a_src && a_src->meta.closed) {
+          status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+          goto exit;
+        }
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(2);
+      }
+      if (((uint32_t)((wuffs_base__peek_u64le__no_bounds_check(iop_a_src) >> 32))) != 1413563465) {
+        goto label__0__break;
+      }
+      self->private_impl.f_chunk_length = wuffs_base__peek_u32be__no_bounds_check(iop_a_src);
+      iop_a_src += 8;
+    }
+    label__0__break:;
+    if (0 < ((uint64_t)(a_workbuf.len))) {
+      if (a_workbuf.ptr[0] == 4) {
+        a_workbuf.ptr[0] = 1;
+      }
+    }
+
+    ok:
+    self->private_impl.p_skip_pass[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_skip_pass[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func png.decoder.can_decode_row_bands
+
+WUFFS_BASE__MAYBE_STATIC bool
+wuffs_png__decoder__can_decode_row_bands(
+    const wuffs_png__decoder* self) {
+  if (!self) {
+    return false;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return false;
+  }
+
+  return (self->private_impl.f_interlace_pass == 0);
+}
+
+// -------- func png.decoder.frame_dirty_rect
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__rect_ie_u32
+wuffs_png__decoder__frame_dirty_rect(
+    const wuffs_png__decoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_rect_ie_u32();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_rect_ie_u32();
+  }
+
+  if (self->private_impl.f_band_height > 0) {
+    return wuffs_base__utility__make_rect_ie_u32(
+        self->private_impl.f_frame_rect_x0,
+        self->private_impl.f_band_y0,
+        self->private_impl.f_frame_rect_x1,
+        self->private_impl.f_band_y1);
+  }
+  return wuffs_base__utility__make_rect_ie_u32(
+      self->private_impl.f_frame_rect_x0,
+      self->private_impl.f_frame_rect_y0,
+      self->private_impl.f_frame_rect_x1,
+      self->private_impl.f_frame_rect_y1);
+}
+
+// -------- func png.decoder.interlace_preview_height
+
+WUFFS_BASE__MAYBE_STATIC uint32_t
+wuffs_png__decoder__interlace_preview_height(
+    const wuffs_png__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  uint32_t v_shift = 0;
+
+  if (self->private_impl.f_num_completed_interlace_passes_value == 0) {
+    return 0;
+  }
+  v_shift = ((uint32_t)(WUFFS_PNG__INTERLACING_PREVIEW_SHIFTS[self->private_impl.f_num_completed_interlace_passes_value][1]));
+  return ((self->private_impl.f_height + ((((uint32_t)(1)) << v_shift) - 1)) >> v_shift);
+}
+
+// -------- func png.decoder.interlace_preview_width
+
+WUFFS_BASE__MAYBE_STATIC uint32_t
+wuffs_png__decoder__interlace_preview_width(
+    const wuffs_png__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  uint32_t v_shift = 0;
+
+  if (self->private_impl.f_num_completed_interlace_passes_value == 0) {
+    return 0;
+  }
+  v_shift = ((uint32_t)(WUFFS_PNG__INTERLACING_PREVIEW_SHIFTS[self->private_impl.f_num_completed_interlace_passes_value][0]));
+  return ((self->private_impl.f_width + ((((uint32_t)(1)) << v_shift) - 1)) >> v_shift);
+}
+
+// -------- func png.decoder.num_animation_loops
+
+WUFFS_BASE__MAYBE_STATIC uint32_t
+wuffs_png__decoder__num_animation_loops(
+    const wuffs_png__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_num_animation_loops_value;
+}
+
+// -------- func png.decoder.num_decoded_frame_configs
+
+WUFFS_BASE__MAYBE_STATIC uint64_t
+wuffs_png__decoder__num_decoded_frame_configs(
+    const wuffs_png__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return ((uint64_t)(self->private_impl.f_num_decoded_frame_configs_value));
+}
+
+// -------- func png.decoder.num_completed_interlace_passes
+
+WUFFS_BASE__MAYBE_STATIC uint32_t
+wuffs_png__decoder__num_completed_interlace_passes(
+    const wuffs_png__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return ((uint32_t)(self->private_impl.f_num_completed_interlace_passes_value));
+}
+
+// -------- func png.decoder.num_decoded_frames
+
+WUFFS_BASE__MAYBE_STATIC uint64_t
+wuffs_png__decoder__num_decoded_frames(
+    const wuffs_png__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return ((uint64_t)(self->private_impl.f_num_decoded_frames_value));
+}
+
+// -------- func png.decoder.restart_frame
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_png__decoder__restart_frame(
+    wuffs_png__decoder* self,
+    uint64_t a_index,
+    uint64_t a_io_position) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+        ? wuffs_base__error__disabled_by_previous_error
+        : wuffs_base__error__initialize_not_called);
+  }
+
+  if (self->private_impl.f_call_sequence < 3) {
+    return wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
+  } else if ((a_index >= ((uint64_t)(self->private_impl.f_num_animation_frames_value))) || ((a_index == 0) && (a_io_position != self->private_impl.f_first_config_io_position))) {
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  self->private_impl.f_call_sequence = 3;
+  if (self->private_impl.f_interlace_pass >= 1) {
+    self->private_impl.f_interlace_pass = 1;
+  }
+  self->private_impl.f_num_completed_interlace_passes_value = 0;
+  self->private_impl.f_frame_config_io_position = a_io_position;
+  if (a_index == 0) {
+    self->private_impl.f_next_animation_seq_num = self->private_impl.f_first_animation_seq_num;
+    self->private_impl.f_resync_animation_seq_num = false;
+  } else {
+    self->private_impl.f_resync_animation_seq_num = true;
+  }
+  self->private_impl.f_num_decoded_frame_configs_value = ((uint32_t)((a_index & 4294967295)));
+  self->private_impl.f_num_decoded_frames_value = self->private_impl.f_num_decoded_frame_configs_value;
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func png.decoder.set_report_metadata
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_png__decoder__set_report_metadata(
+    wuffs_png__decoder* self,
+    uint32_t a_fourcc,
+    bool a_report) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  if (a_fourcc == 1128813133) {
+    self->private_impl.f_report_metadata_chrm = a_report;
+  } else if (a_fourcc == 1163413830) {
+    self->private_impl.f_report_metadata_exif = a_report;
+  } else if (a_fourcc == 1195461953) {
+    self->private_impl.f_report_metadata_gama = a_report;
+  } else if (a_fourcc == 1229144912) {
+    self->private_impl.f_report_metadata_iccp = a_report;
+  } else if (a_fourcc == 1263947808) {
+    self->private_impl.f_report_metadata_kvp = a_report;
+  } else if (a_fourcc == 1397901122) {
+    self->private_impl.f_report_metadata_srgb = a_report;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func png.decoder.tell_me_more
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_png__decoder__tell_me_more(
+    wuffs_png__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__more_information* a_minfo,
+    wuffs_base__io_buffer* a_src) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+        ? wuffs_base__error__disabled_by_previous_error
+        : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst || !a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 4)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t v_c = 0;
+  uint16_t v_c2 = 0;
+  wuffs_base__io_buffer u_w = wuffs_base__empty_io_buffer();
+  wuffs_base__io_buffer* v_w = &u_w;
+  uint8_t* iop_v_w WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io0_v_w WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_v_w WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_v_w WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint64_t v_num_written = 0;
+  uint64_t v_w_mark = 0;
+  uint64_t v_r_mark = 0;
+  wuffs_base__status v_zlib_status = wuffs_base__make_status(NULL);
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_tell_me_more[0];
+  if (coro_susp_point) {
+    v_zlib_status = self->private_data.s_tell_me_more[0].v_zlib_status;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_call_sequence != 1) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
+      goto exit;
+    }
+    if (self->private_impl.f_metadata_fourcc == 0) {
+      status = wuffs_base__make_status(wuffs_base__error__no_more_information);
+      goto exit;
+    }
+    while (true) {
+      if (self->private_impl.f_metadata_flavor == 3) {
+        while (true) {
+          if (wuffs_base__u64__sat_add((a_src ? a_src->meta.pos : 0), ((uint64_t)(iop_a_src - io0_a_src))) != self->private_impl.f_metadata_y) {
+            status = wuffs_base__make_status(wuffs_base__error__bad_i_o_position);
+            goto exit;
+          } else if (a_minfo != NULL) {
+            wuffs_base__more_information__set(a_minfo,
+                self->private_impl.f_metadata_flavor,
+                self->private_impl.f_metadata_fourcc,
+                self->private_impl.f_metadata_x,
+                self->private_impl.f_metadata_y,
+                self->private_impl.f_metadata_z);
+          }
+          if (self->private_impl.f_metadata_y >= self->private_impl.f_metadata_z) {
+            goto label__goto_done__break;
+          }
+          self->private_impl.f_metadata_y = self->private_impl.f_metadata_z;
+          status = wuffs_base__make_status(wuffs_base__suspension__even_more_information);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
+        }
+      }
+      if (self->private_impl.f_metadata_is_zlib_compressed) {
+        if (self->private_impl.f_zlib_is_dirty) {
+          wuffs_base__ignore_status(wuffs_zlib__decoder__initialize(&self->private_data.f_zlib,
+              sizeof (wuffs_zlib__decoder), WUFFS_VERSION, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+          if (self->private_impl.f_ignore_checksum) {
+            wuffs_zlib__decoder__set_quirk_enabled(&self->private_data.f_zlib, 1, true);
+          }
+        }
+        self->private_impl.f_zlib_is_dirty = true;
+        self->private_impl.f_ztxt_hist_pos = 0;
+      }
+      label__loop__continue:;
+      while (true) {
+        if (a_minfo != NULL) {
+          wuffs_base__more_information__set(a_minfo,
+              self->private_impl.f_metadata_flavor,
+              self->private_impl.f_metadata_fourcc,
+              self->private_impl.f_metadata_x,
+              self->private_impl.f_metadata_y,
+              self->private_impl.f_metadata_z);
+        }
+        if (self->private_impl.f_metadata_flavor != 4) {
+          goto label__loop__break;
+        }
+        if (self->private_impl.f_metadata_is_zlib_compressed) {
+          if (self->private_impl.f_chunk_type == 1346585449) {
+            {
+              const uint8_t *o_0_io2_a_src = io2_a_src;
+              wuffs_base__io_reader__limit(&io2_a_src, iop_a_src,
+                  ((uint64_t)(self->private_impl.f_chunk_length)));
+              if (a_src) {
+                a_src->meta.wi = ((size_t)(io2_a_src - a_src->data.ptr));
+              }
+              v_r_mark = ((uint64_t)(iop_a_src - io0_a_src));
+              {
+                if (a_dst) {
+                  a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+                }
+                if (a_src) {
+                  a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+                }
+                wuffs_base__status t_0 = wuffs_zlib__decoder__transform_io(&self->private_data.f_zlib, a_dst, a_src, wuffs_base__make_slice_u8(self->private_data.f_zlib_workbuf, 33025));
+                v_zlib_status = t_0;
+                if (a_dst) {
+                  iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+                }
+                if (a_src) {
+                  iop_a_src = a_src->data.ptr + a_src->meta.ri;
+                }
+              }
+              wuffs_base__u32__sat_sub_indirect(&self->private_impl.f_chunk_length, ((uint32_t)((wuffs_base__io__count_since(v_r_mark, ((uint64_t)(iop_a_src - io0_a_src))) & 4294967295))));
+              io2_a_src = o_0_io2_a_src;
+              if (a_src) {
+                a_src->meta.wi = ((size_t)(io2_a_src - a_src->data.ptr));
+              }
+            }
+            if (wuffs_base__status__is_ok(&v_zlib_status)) {
+              self->private_impl.f_metadata_is_zlib_compressed = false;
+              goto label__loop__break;
+            } else if ( ! wuffs_base__status__is_suspension(&v_zlib_status)) {
+              status = v_zlib_status;
+              if (wuffs_base__status__is_error(&status)) {
+                goto exit;
+              } else if (wuffs_base__status__is_suspension(&status)) {
+                status = wuffs_base__make_status(wuffs_base__error__cannot_return_a_suspension);
+                goto exit;
+              }
+              goto ok;
+            }
+            status = v_zlib_status;
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(2);
+          } else if (self->private_impl.f_chunk_type == 1951945833) {
+            {
+              const uint8_t *o_1_io2_a_src = io2_a_src;
+              wuffs_base__io_reader__limit(&io2_a_src, iop_a_src,
+                  ((uint64_t)(self->private_impl.f_chunk_length)));
+              if (a_src) {
+                a_src->meta.wi = ((size_t)(io2_a_src - a_src->data.ptr));
+              }
+              v_r_mark = ((uint64_t)(iop_a_src - io0_a_src));
+              {
+                if (a_dst) {
+                  a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+                }
+                if (a_src) {
+                  a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+                }
+                wuffs_base__status t_1 = wuffs_zlib__decoder__transform_io(&self->private_data.f_zlib, a_dst, a_src, wuffs_base__make_slice_u8(self->private_data.f_zlib_workbuf, 33025));
+                v_zlib_status = t_1;
+                if (a_dst) {
+                  iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+                }
+                if (a_src) {
+                  iop_a_src = a_src->data.ptr + a_src->meta.ri;
+                }
+              }
+              wuffs_base__u32__sat_sub_indirect(&self->private_impl.f_chunk_length, ((uint32_t)((wuffs_base__io__count_since(v_r_mark, ((uint64_t)(iop_a_src - io0_a_src))) & 4294967295))));
+              io2_a_src = o_1_io2_a_src;
+              if (a_src) {
+                a_src->meta.wi = ((size_t)(io2_a_src - a_src->data.ptr));
+              }
+            }
+            if (wuffs_base__status__is_ok(&v_zlib_status)) {
+              self->private_impl.f_metadata_is_zlib_compressed = false;
+              goto label__loop__break;
+            } else if ( ! wuffs_base__status__is_suspension(&v_zlib_status)) {
+              status = v_zlib_status;
+              if (wuffs_base__status__is_error(&status)) {
+                goto exit;
+              } else if (wuffs_base__status__is_suspension(&status)) {
+                status = wuffs_base__make_status(wuffs_base__error__cannot_return_a_suspension);
+                goto exit;
+              }
+              goto ok;
+            }
+            status = v_zlib_status;
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(3);
+          } else if (self->private_impl.f_chunk_type == 1951945850) {
+            if (self->private_impl.f_ztxt_ri == self->private_impl.f_ztxt_wi) {
+              {
+                wuffs_base__io_buffer* o_2_v_w = v_w;
+                uint8_t *o_2_iop_v_w = iop_v_w;
+                uint8_t *o_2_io0_v_w = io0_v_w;
+                uint8_t *o_2_io1_v_w = io1_v_w;
+                uint8_t *o_2_io2_v_w = io2_v_w;
+                v_w = wuffs_base__io_writer__set(
+                    &u_w,
+                    &iop_v_w,
+                    &io0_v_w,
+                    &io1_v_w,
+                    &io2_v_w,
+                    wuffs_base__make_slice_u8(self->private_data.f_dst_palette, 1024),
+                    self->private_impl.f_ztxt_hist_pos);
+                {
+                  const uint8_t *o_3_io2_a_src = io2_a_src;
+                  wuffs_base__io_reader__limit(&io2_a_src, iop_a_src,
+                      ((uint64_t)(self->private_impl.f_chunk_length)));
+                  if (a_src) {
+                    a_src->meta.wi = ((size_t)(io2_a_src - a_src->data.ptr));
+                  }
+                  v_w_mark = ((uint64_t)(iop_v_w - io0_v_w));
+                  v_r_mark = ((uint64_t)(iop_a_src - io0_a_src));
+                  {
+                    u_w.meta.wi = ((size_t)(iop_v_w - u_w.data.ptr));
+                    if (a_src) {
+                      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+                    }
+                    wuffs_base__status t_2 = wuffs_zlib__decoder__transform_io(&self->private_data.f_zlib, v_w, a_src, wuffs_base__make_slice_u8(self->private_data.f_zlib_workbuf, 33025));
+                    v_zlib_status = t_2;
+                    iop_v_w = u_w.data.ptr + u_w.meta.wi;
+                    if (a_src) {
+                      iop_a_src = a_src->data.ptr + a_src->meta.ri;
+                    }
+                  }
+                  wuffs_base__u32__sat_sub_indirect(&self->private_impl.f_chunk_length, ((uint32_t)((wuffs_base__io__count_since(v_r_mark, ((uint64_t)(iop_a_src - io0_a_src))) & 4294967295))));
+                  v_num_written = wuffs_base__io__count_since(v_w_mark, ((uint64_t)(iop_v_w - io0_v_w)));
+                  io2_a_src = o_3_io2_a_src;
+                  if (a_src) {
+                    a_src->meta.wi = ((size_t)(io2_a_src - a_src->data.ptr));
+                  }
+                }
+                v_w = o_2_v_w;
+                iop_v_w = o_2_iop_v_w;
+                io0_v_w = o_2_io0_v_w;
+                io1_v_w = o_2_io1_v_w;
+                io2_v_w = o_2_io2_v_w;
+              }
+              if (v_num_written > 1024) {
+                status = wuffs_base__make_status(wuffs_png__error__internal_error_inconsistent_i_o);
+                goto exit;
+              }
+              self->private_impl.f_ztxt_ri = 0;
+              self->private_impl.f_ztxt_wi = ((uint32_t)(v_num_written));
+              wuffs_base__u64__sat_add_indirect(&self->private_impl.f_ztxt_hist_pos, v_num_written);
+            }
+            while (self->private_impl.f_ztxt_ri < self->private_impl.f_ztxt_wi) {
+              v_c2 = WUFFS_PNG__LATIN_1[self->private_data.f_dst_palette[self->private_impl.f_ztxt_ri]];
+              if (v_c2 == 0) {
+                status = wuffs_base__make_status(wuffs_png__error__bad_text_chunk_not_latin_1);
+                goto exit;
+              } else if (v_c2 <= 127) {
+                if (((uint64_t)(io2_a_dst - iop_a_dst)) <= 0) {
+                  status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+                  WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(4);
+                  v_c2 = 0;
+                  goto label__loop__continue;
+                }
+                self->private_impl.f_ztxt_ri += 1;
+                (wuffs_base__poke_u8be__no_bounds_check(iop_a_dst, ((uint8_t)(v_c2))), iop_a_dst += 1);
+              } else {
+                if (((uint64_t)(io2_a_dst - iop_a_dst)) <= 1) {
+                  status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+                  WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(5);
+                  v_c2 = 0;
+                  goto label__loop__continue;
+                }
+                self->private_impl.f_ztxt_ri += 1;
+                (wuffs_base__poke_u16le__no_bounds_check(iop_a_dst, v_c2), iop_a_dst += 2);
+              }
+            }
+            if (wuffs_base__status__is_ok(&v_zlib_status)) {
+              self->private_impl.f_metadata_is_zlib_compressed = false;
+              goto label__loop__break;
+            } else if ( ! wuffs_base__status__is_suspension(&v_zlib_status)) {
+              status = v_zlib_status;
+              if (wuffs_base__status__is_error(&status)) {
+                goto exit;
+              } else if (wuffs_base__status__is_suspension(&status)) {
+                status = wuffs_base__make_status(wuffs_base__error__cannot_return_a_suspension);
+                goto exit;
+              }
+              goto ok;
+            } else if (v_zlib_status.repr != wuffs_base__suspension__short_write) {
+              status = v_zlib_status;
+              WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(6);
+            }
+          } else {
+            status = wuffs_base__make_status(wuffs_png__error__internal_error_inconsistent_chunk_type);
+            goto exit;
+          }
+        } else if ((self->private_impl.f_chunk_type == 1951945833) && (self->private_impl.f_metadata_fourcc == 1263947862)) {
+          while (true) {
+            if (self->private_impl.f_chunk_length <= 0) {
+              goto label__loop__break;
+            } else if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(7);
+              goto label__loop__continue;
+            } else if (((uint64_t)(io2_a_dst - iop_a_dst)) <= 0) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+              WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(8);
+              goto label__loop__continue;
+            }
+            self->private_impl.f_chunk_length -= 1;
+            v_c = wuffs_base__peek_u8be__no_bounds_check(iop_a_src);
+            iop_a_src += 1;
+            (wuffs_base__poke_u8be__no_bounds_check(iop_a_dst, v_c), iop_a_dst += 1);
+          }
+        } else {
+          while (true) {
+            if (self->private_impl.f_chunk_length <= 0) {
+              if (self->private_impl.f_metadata_fourcc == 1263947851) {
+                status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+                goto exit;
+              }
+              goto label__loop__break;
+            } else if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(9);
+              goto label__loop__continue;
+            }
+            v_c = wuffs_base__peek_u8be__no_bounds_check(iop_a_src);
+            if (v_c == 0) {
+              self->private_impl.f_chunk_length -= 1;
+              iop_a_src += 1;
+              goto label__loop__break;
+            }
+            v_c2 = WUFFS_PNG__LATIN_1[v_c];
+            if (v_c2 == 0) {
+              status = wuffs_base__make_status(wuffs_png__error__bad_text_chunk_not_latin_1);
+              goto exit;
+            } else if (v_c2 <= 127) {
+              if (((uint64_t)(io2_a_dst - iop_a_dst)) <= 0) {
+                status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+                WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(10);
+                v_c2 = 0;
+                goto label__loop__continue;
+              }
+              self->private_impl.f_chunk_length -= 1;
+              iop_a_src += 1;
+              (wuffs_base__poke_u8be__no_bounds_check(iop_a_dst, ((uint8_t)(v_c2))), iop_a_dst += 1);
+            } else {
+              if (((uint64_t)(io2_a_dst - iop_a_dst)) <= 1) {
+                status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+                WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(11);
+                v_c2 = 0;
+                goto label__loop__continue;
+              }
+              self->private_impl.f_chunk_length -= 1;
+              iop_a_src += 1;
+              (wuffs_base__poke_u16le__no_bounds_check(iop_a_dst, v_c2), iop_a_dst += 2);
+            }
+          }
+        }
+      }
+      label__loop__break:;
+      if (self->private_impl.f_metadata_fourcc == 1263947851) {
+        self->private_impl.f_metadata_fourcc = 1263947862;
+        if (self->private_impl.f_chunk_type == 1951945833) {
+          if (self->private_impl.f_chunk_length <= 1) {
+            status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+            goto exit;
+          }
+          self->private_impl.f_chunk_length -= 2;
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(12);
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint8_t t_3 = *iop_a_src++;
+            v_c = t_3;
+          }
+          if (v_c == 0) {
+            self->private_impl.f_metadata_is_zlib_compressed = false;
+          } else if (v_c == 1) {
+            self->private_impl.f_metadata_is_zlib_compressed = true;
+          } else {
+            status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+            goto exit;
+          }
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(13);
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint8_t t_4 = *iop_a_src++;
+            v_c = t_4;
+          }
+          if ((v_c != 0) && self->private_impl.f_metadata_is_zlib_compressed) {
+            status = wuffs_base__make_status(wuffs_png__error__unsupported_png_compression_method);
+            goto exit;
+          }
+          self->private_impl.f_metadata_fourcc -= 2;
+          while (self->private_impl.f_metadata_fourcc != 1263947862) {
+            self->private_impl.f_metadata_fourcc += 1;
+            while (true) {
+              if (self->private_impl.f_chunk_length <= 0) {
+                status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+                goto exit;
+              }
+              self->private_impl.f_chunk_length -= 1;
+              {
+                WUFFS_BASE__COROUTINE_SUSPENSION_POINT(14);
+                if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                  status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+                  goto suspend;
+                }
+                uint8_t t_5 = *iop_a_src++;
+                v_c = t_5;
+              }
+              if (v_c == 0) {
+                goto label__0__break;
+              }
+            }
+            label__0__break:;
+          }
+        } else if (self->private_impl.f_chunk_type == 1951945850) {
+          if (self->private_impl.f_chunk_length <= 0) {
+            status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+            goto exit;
+          }
+          self->private_impl.f_chunk_length -= 1;
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(15);
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint8_t t_6 = *iop_a_src++;
+            v_c = t_6;
+          }
+          if (v_c != 0) {
+            status = wuffs_base__make_status(wuffs_png__error__unsupported_png_compression_method);
+            goto exit;
+          }
+          self->private_impl.f_metadata_is_zlib_compressed = true;
+        }
+        self->private_impl.f_call_sequence = 2;
+        status = wuffs_base__make_status(NULL);
+        goto ok;
+      }
+      goto label__goto_done__break;
+    }
+    label__goto_done__break:;
+    if (self->private_impl.f_chunk_length != 0) {
+      status = wuffs_base__make_status(wuffs_png__error__bad_chunk);
+      goto exit;
+    }
+    self->private_data.s_tell_me_more[0].scratch = 4;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(16);
+    if (self->private_data.s_tell_me_more[0].scratch > ((uint64_t)(io2_a_src - iop_a_src))) {
+      self->private_data.s_tell_me_more[0].scratch -= ((uint64_t)(io2_a_src - iop_a_src));
+      iop_a_src = io2_a_src;
+      status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+      goto suspend;
+    }
+    iop_a_src += self->private_data.s_tell_me_more[0].scratch;
+    self->private_impl.f_metadata_flavor = 0;
+    self->private_impl.f_metadata_fourcc = 0;
+    self->private_impl.f_metadata_x = 0;
+    self->private_impl.f_metadata_y = 0;
+    self->private_impl.f_metadata_z = 0;
+    self->private_impl.f_call_sequence = 2;
+    status = wuffs_base__make_status(NULL);
+    goto ok;
+
+    ok:
+    self->private_impl.p_tell_me_more[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_tell_me_more[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine = wuffs_base__status__is_suspension(&status) ? 4 : 0;
+  WUFFS_BASE__STATS__ADD(self->private_impl, WUFFS_BASE__STATS__SUSPENSIONS,
+      wuffs_base__status__is_suspension(&status) ? 1u : 0u);
+  self->private_data.s_tell_me_more[0].v_zlib_status = v_zlib_status;
+
+  goto exit;
+  exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func png.decoder.workbuf_len
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64
+wuffs_png__decoder__workbuf_len(
+    const wuffs_png__decoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+
+  return wuffs_base__utility__make_range_ii_u64(self->private_impl.f_streaming_workbuf_length, self->private_impl.f_overall_workbuf_length);
+}
+
+// -------- func png.decoder.filter_and_swizzle
+
+static wuffs_base__status
+wuffs_png__decoder__filter_and_swizzle(
+    wuffs_png__decoder* self,
+    wuffs_base__pixel_buffer* a_dst,
+    wuffs_base__slice_u8 a_workbuf) {
+  return (*self->private_impl.choosy_filter_and_swizzle)(self, a_dst, a_workbuf);
+}
+
+static wuffs_base__status
+wuffs_png__decoder__filter_and_swizzle__choosy_default(
+    wuffs_png__decoder* self,
+    wuffs_base__pixel_buffer* a_dst,
+    wuffs_base__slice_u8 a_workbuf) {
+  wuffs_base__pixel_format v_dst_pixfmt = {0};
+  uint32_t v_dst_bits_per_pixel = 0;
+  uint64_t v_dst_bytes_per_pixel = 0;
+  uint64_t v_dst_bytes_per_row0 = 0;
+  uint64_t v_dst_bytes_per_row1 = 0;
+  wuffs_base__slice_u8 v_dst_palette = {0};
+  wuffs_base__table_u8 v_tab = {0};
+  uint64_t v_src_skip = 0;
+  uint64_t v_i = 0;
+  wuffs_base__slice_u8 v_downscale_scratch = {0};
+  uint32_t v_y = 0;
+  wuffs_base__slice_u8 v_dst = {0};
+  uint8_t v_filter = 0;
+  wuffs_base__slice_u8 v_curr_row = {0};
+  wuffs_base__slice_u8 v_prev_row = {0};
+
+  v_dst_pixfmt = wuffs_base__pixel_buffer__pixel_format(a_dst);
+  v_dst_bits_per_pixel = wuffs_base__pixel_format__bits_per_pixel(&v_dst_pixfmt);
+  if ((v_dst_bits_per_pixel & 7) != 0) {
+    return wuffs_base__make_status(wuffs_base__error__unsupported_option);
+  }
+  v_dst_bytes_per_pixel = ((uint64_t)((v_dst_bits_per_pixel / 8)));
+  if ((self->private_impl.f_downscale_shift > 0) && (wuffs_base__pixel_format__is_indexed(&v_dst_pixfmt) || (v_dst_bits_per_pixel == 16) || (v_dst_bits_per_pixel > 32))) {
+    return wuffs_base__make_status(wuffs_base__error__unsupported_option);
+  }
+  v_src_skip = 0;
+  if (self->private_impl.f_frame_rect_x0 < self->private_impl.f_roi_x0) {
+    v_src_skip = (((uint64_t)(((uint32_t)(self->private_impl.f_roi_x0 - self->private_impl.f_frame_rect_x0)))) * ((uint64_t)(self->private_impl.f_filter_distance)));
+    v_dst_bytes_per_row0 = 0;
+  } else {
+    v_dst_bytes_per_row0 = (((uint64_t)(((uint32_t)(self->private_impl.f_frame_rect_x0 - self->private_impl.f_roi_x0)))) * v_dst_bytes_per_pixel);
+  }
+  v_dst_bytes_per_row1 = (((uint64_t)(((uint32_t)(wuffs_base__u32__min(self->private_impl.f_frame_rect_x1, self->private_impl.f_roi_x1) - self->private_impl.f_roi_x0)))) * v_dst_bytes_per_pixel);
+  v_dst_palette = wuffs_base__pixel_buffer__palette_or_else(a_dst, wuffs_base__make_slice_u8(self->private_data.f_dst_palette, 1024));
+  v_tab = wuffs_base__pixel_buffer__plane(a_dst, 0);
+  if (v_dst_bytes_per_row1 < ((uint64_t)(v_tab.width))) {
+    v_tab = wuffs_base__table_u8__subtable_ij(v_tab,
+        0,
+        0,
+        v_dst_bytes_per_row1,
+        ((uint64_t)(v_tab.height)));
+  }
+  if (v_dst_bytes_per_row0 < ((uint64_t)(v_tab.width))) {
+    v_tab = wuffs_base__table_u8__subtable_ij(v_tab,
+        v_dst_bytes_per_row0,
+        0,
+        ((uint64_t)(v_tab.width)),
+        ((uint64_t)(v_tab.height)));
+  } else {
+    v_tab = wuffs_base__table_u8__subtable_ij(v_tab,
+        0,
+        0,
+        0,
+        0);
+  }
+  if (self->private_impl.f_downscale_shift > 0) {
+    v_downscale_scratch = wuffs_png__decoder__downscale_scratch(self, a_workbuf, v_dst_bytes_per_pixel);
+  }
+  v_y = self->private_impl.f_frame_rect_y0;
+  if (v_y < self->private_impl.f_pass_resume_y) {
+    v_y = self->private_impl.f_pass_resume_y;
+    v_i = (((uint64_t)(((uint32_t)(v_y - self->private_impl.f_pass_workbuf_y0)))) * (1 + self->private_impl.f_pass_bytes_per_row));
+    if (v_i > ((uint64_t)(a_workbuf.len))) {
+      return wuffs_base__make_status(wuffs_png__error__internal_error_inconsistent_workbuf_length);
+    }
+    v_prev_row = wuffs_base__slice_u8__subslice_j(a_workbuf, v_i);
+    v_prev_row = wuffs_base__slice_u8__suffix(v_prev_row, self->private_impl.f_pass_bytes_per_row);
+    a_workbuf = wuffs_base__slice_u8__subslice_i(a_workbuf, v_i);
+  }
+  while (v_y < self->private_impl.f_frame_rect_y1) {
+    if (self->private_impl.f_pass_stop_y <= v_y) {
+      goto label__0__break;
+    }
+    if ((self->private_impl.f_band_y1 <= v_y) && (v_y < self->private_impl.f_roi_y1)) {
+      self->private_impl.f_pass_resume_y = v_y;
+      return wuffs_base__make_status(wuffs_png__note__internal_note_short_write);
+    }
+    if (1 > ((uint64_t)(a_workbuf.len))) {
+      return wuffs_base__make_status(wuffs_png__error__internal_error_inconsistent_workbuf_length);
+    }
+    v_filter = a_workbuf.ptr[0];
+    a_workbuf = wuffs_base__slice_u8__subslice_i(a_workbuf, 1);
+    if (self->private_impl.f_pass_bytes_per_row > ((uint64_t)(a_workbuf.len))) {
+      return wuffs_base__make_status(wuffs_png__error__internal_error_inconsistent_workbuf_length);
+    }
+    v_curr_row = wuffs_base__slice_u8__subslice_j(a_workbuf, self->private_impl.f_pass_bytes_per_row);
+    a_workbuf = wuffs_base__slice_u8__subslice_i(a_workbuf, self->private_impl.f_pass_bytes_per_row);
+    if (v_filter == 0) {
+      WUFFS_BASE__STATS__ADD(self->private_impl, 8, 1);
+    } else if (v_filter == 1) {
+      WUFFS_BASE__STATS__ADD(self->private_impl, 9, 1);
+      wuffs_png__decoder__filter_1(self, v_curr_row);
+    } else if (v_filter == 2) {
+      WUFFS_BASE__STATS__ADD(self->private_impl, 10, 1);
+      wuffs_png__decoder__filter_2(self, v_curr_row, v_prev_row);
+    } else if (v_filter == 3) {
+      WUFFS_BASE__STATS__ADD(self->private_impl, 11, 1);
+      wuffs_png__decoder__filter_3(self, v_curr_row, v_prev_row);
+    } else if (v_filter == 4) {
+      WUFFS_BASE__STATS__ADD(self->private_impl, 12, 1);
+      wuffs_png__decoder__filter_4(self, v_curr_row, v_prev_row);
+    } else {
+      return wuffs_base__make_status(wuffs_png__error__bad_filter);
+    }
+    if ((self->private_impl.f_band_y0 <= v_y) && (v_y < self->private_impl.f_band_y1) && (v_src_skip <= ((uint64_t)(v_curr_row.len)))) {
+      if (self->private_impl.f_downscale_shift == 0) {
+        v_dst = wuffs_base__table_u8__row_u32(v_tab, ((uint32_t)(v_y - self->private_impl.f_band_y0)));
+        wuffs_base__pixel_swizzler__swizzle_interleaved_from_slice(&self->private_impl.f_swizzler, v_dst, v_dst_palette, wuffs_base__slice_u8__subslice_i(v_curr_row, v_src_skip));
+      } else {
+        v_dst = v_downscale_scratch;
+        if (v_dst_bytes_per_row1 < ((uint64_t)(v_dst.len))) {
+          v_dst = wuffs_base__slice_u8__subslice_j(v_dst, v_dst_bytes_per_row1);
+        }
+        if (v_dst_bytes_per_row0 < ((uint64_t)(v_dst.len))) {
+          v_dst = wuffs_base__slice_u8__subslice_i(v_dst, v_dst_bytes_per_row0);
+        } else {
+          v_dst = wuffs_base__slice_u8__subslice_j(v_dst, 0);
+        }
+        wuffs_base__pixel_swizzler__swizzle_interleaved_from_slice(&self->private_impl.f_swizzler, v_dst, v_dst_palette, wuffs_base__slice_u8__subslice_i(v_curr_row, v_src_skip));
+        self->private_impl.f_downscale_num_rows = wuffs_png__decoder__downscale_row(self,
+            a_dst,
+            a_workbuf,
+            v_y,
+            self->private_impl.f_downscale_num_rows,
+            v_dst_bytes_per_pixel);
+      }
+    }
+    v_prev_row = v_curr_row;
+    v_y += 1;
+  }
+  label__0__break:;
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func png.decoder.filter_and_swizzle_rgba_bgra_premul
+
+static wuffs_base__status
+wuffs_png__decoder__filter_and_swizzle_rgba_bgra_premul(
+    wuffs_png__decoder* self,
+    wuffs_base__pixel_buffer* a_dst,
+    wuffs_base__slice_u8 a_workbuf) {
+  uint64_t v_dst_bytes_per_row0 = 0;
+  uint64_t v_dst_bytes_per_row1 = 0;
+  wuffs_base__table_u8 v_tab = {0};
+  uint64_t v_src_skip = 0;
+  uint64_t v_i = 0;
+  uint32_t v_y = 0;
+  wuffs_base__slice_u8 v_dst = {0};
+  uint8_t v_filter = 0;
+  wuffs_base__slice_u8 v_curr_row = {0};
+  wuffs_base__slice_u8 v_prev_row = {0};
+
+  v_src_skip = 0;
+  if (self->private_impl.f_frame_rect_x0 < self->private_impl.f_roi_x0) {
+    v_src_skip = (((uint64_t)(((uint32_t)(self->private_impl.f_roi_x0 - self->private_impl.f_frame_rect_x0)))) * 4);
+    v_dst_bytes_per_row0 = 0;
+  } else {
+    v_dst_bytes_per_row0 = (((uint64_t)(((uint32_t)(self->private_impl.f_frame_rect_x0 - self->private_impl.f_roi_x0)))) * 4);
+  }
+  v_dst_bytes_per_row1 = (((uint64_t)(((uint32_t)(wuffs_base__u32__min(self->private_impl.f_frame_rect_x1, self->private_impl.f_roi_x1) - self->private_impl.f_roi_x0)))) * 4);
+  v_tab = wuffs_base__pixel_buffer__plane(a_dst, 0);
+  if (v_dst_bytes_per_row1 < ((uint64_t)(v_tab.width))) {
+    v_tab = wuffs_base__table_u8__subtable_ij(v_tab,
+        0,
+        0,
+        v_dst_bytes_per_row1,
+        ((uint64_t)(v_tab.height)));
+  }
+  if (v_dst_bytes_per_row0 < ((uint64_t)(v_tab.width))) {
+    v_tab = wuffs_base__table_u8__subtable_ij(v_tab,
+        v_dst_bytes_per_row0,
+        0,
+        ((uint64_t)(v_tab.width)),
+        ((uint64_t)(v_tab.height)));
+  } else {
+    v_tab = wuffs_base__table_u8__subtable_ij(v_tab,
+        0,
+        0,
+        0,
+        0);
+  }
+  v_y = self->private_impl.f_frame_rect_y0;
+  if (v_y < self->private_impl.f_pass_resume_y) {
+    v_y = self->private_impl.f_pass_resume_y;
+    v_i = (((uint64_t)(((uint32_t)(v_y - self->private_impl.f_pass_workbuf_y0)))) * (1 + self->private_impl.f_pass_bytes_per_row));
+    if (v_i > ((uint64_t)(a_workbuf.len))) {
+      return wuffs_base__make_status(wuffs_png__error__internal_error_inconsistent_workbuf_length);
+    }
+    v_prev_row = wuffs_base__slice_u8__subslice_j(a_workbuf, v_i);
+    v_prev_row = wuffs_base__slice_u8__suffix(v_prev_row, self->private_impl.f_pass_bytes_per_row);
+    a_workbuf = wuffs_base__slice_u8__subslice_i(a_workbuf, v_i);
+  }
+  while (v_y < self->private_impl.f_frame_rect_y1) {
+    if (self->private_impl.f_pass_stop_y <= v_y) {
+      goto label__0__break;
+    }
+    if ((self->private_impl.f_band_y1 <= v_y) && (v_y < self->private_impl.f_roi_y1)) {
+      self->private_impl.f_pass_resume_y = v_y;
+      return wuffs_base__make_status(wuffs_png__note__internal_note_short_write);
+    }
+    if (1 > ((uint64_t)(a_workbuf.len))) {
+      return wuffs_base__make_status(wuffs_png__error__internal_error_inconsistent_workbuf_length);
+    }
+    v_filter = a_workbuf.ptr[0];
+    a_workbuf = wuffs_base__slice_u8__subslice_i(a_workbuf, 1);
+    if (self->private_impl.f_pass_bytes_per_row > ((uint64_t)(a_workbuf.len))) {
+      return wuffs_base__make_status(wuffs_png__error__internal_error_inconsistent_workbuf_length);
+    }
+    v_curr_row = wuffs_base__slice_u8__subslice_j(a_workbuf, self->private_impl.f_pass_bytes_per_row);
+    a_workbuf = wuffs_base__slice_u8__subslice_i(a_workbuf, self->private_impl.f_pass_bytes_per_row);
+    if (v_filter == 0) {
+      WUFFS_BASE__STATS__ADD(self->private_impl, 8, 1);
+    } else if (v_filter == 1) {
+      WUFFS_BASE__STATS__ADD(self->private_impl, 9, 1);
+      wuffs_png__decoder__filter_1(self, v_curr_row);
+    } else if (v_filter == 2) {
+      WUFFS_BASE__STATS__ADD(self->private_impl, 10, 1);
+      wuffs_png__decoder__filter_2(self, v_curr_row, v_prev_row);
+    } else if (v_filter == 3) {
+      WUFFS_BASE__STATS__ADD(self->private_impl, 11, 1);
+      wuffs_png__decoder__filter_3(self, v_curr_row, v_prev_row);
+    } else if (v_filter == 4) {
+      WUFFS_BASE__STATS__ADD(self->private_impl, 12, 1);
+      wuffs_png__decoder__filter_4(self, v_curr_row, v_prev_row);
+    } else {
+      return wuffs_base__make_status(wuffs_png__error__bad_filter);
+    }
+    if ((self->private_impl.f_band_y0 <= v_y) && (v_y < self->private_impl.f_band_y1) && (v_src_skip <= ((uint64_t)(v_curr_row.len)))) {
+      v_dst = wuffs_base__table_u8__row_u32(v_tab, ((uint32_t)(v_y - self->private_impl.f_band_y0)));
+      wuffs_png__decoder__swizzle_rgba_bgra_premul(self, v_dst, wuffs_base__slice_u8__subslice_i(v_curr_row, v_src_skip));
+    }
+    v_prev_row = v_curr_row;
+    v_y += 1;
+  }
+  label__0__break:;
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func png.decoder.swizzle_rgba_bgra_premul
+
+static wuffs_base__empty_struct
+wuffs_png__decoder__swizzle_rgba_bgra_premul(
+    wuffs_png__decoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_src) {
+  wuffs_base__slice_u8 v_d = {0};
+  wuffs_base__slice_u8 v_s = {0};
+  uint32_t v_c = 0;
+  uint32_t v_a16 = 0;
+  uint32_t v_r = 0;
+  uint32_t v_g = 0;
+  uint32_t v_b = 0;
+
+  {
+    wuffs_base__slice_u8 i_slice_d = a_dst;
+    v_d.ptr = i_slice_d.ptr;
+    wuffs_base__slice_u8 i_slice_s = a_src;
+    v_s.ptr = i_slice_s.ptr;
+    i_slice_d.len = ((size_t)(wuffs_base__u64__min(i_slice_d.len, i_slice_s.len)));
+    v_d.len = 4;
+    v_s.len = 4;
+    uint8_t* i_end0_d = v_d.ptr + (((i_slice_d.len - (size_t)(v_d.ptr - i_slice_d.ptr)) / 4) * 4);
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_d.ptr < i_end0_d) {
+      v_c = wuffs_base__peek_u32le__no_bounds_check(v_s.ptr);
+      v_a16 = ((v_c >> 24) * 66049);
+      v_r = (((((v_c >> 0) & 255) * v_a16) / 65535) >> 8);
+      v_g = (((((v_c >> 8) & 255) * v_a16) / 65535) >> 8);
+      v_b = (((((v_c >> 16) & 255) * v_a16) / 65535) >> 8);
+      wuffs_base__poke_u32le__no_bounds_check(v_d.ptr, ((v_c & 4278190080) |
+          (v_r << 16) |
+          (v_g << 8) |
+          v_b));
+      v_d.ptr += 4;
+      v_s.ptr += 4;
+    }
+    v_d.len = 0;
+    v_s.len = 0;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func png.decoder.filter_and_swizzle_tricky
+
+static wuffs_base__status
+wuffs_png__decoder__filter_and_swizzle_tricky(
+    wuffs_png__decoder* self,
+    wuffs_base__pixel_buffer* a_dst,
+    wuffs_base__slice_u8 a_workbuf) {
+  wuffs_base__pixel_format v_dst_pixfmt = {0};
+  uint32_t v_dst_bits_per_pixel = 0;
+  uint64_t v_dst_bytes_per_pixel = 0;
+  uint64_t v_dst_bytes_per_row1 = 0;
+  wuffs_base__slice_u8 v_dst_palette = {0};
+  wuffs_base__table_u8 v_tab = {0};
+  uint64_t v_src_bytes_per_pixel = 0;
+  wuffs_base__slice_u8 v_downscale_scratch = {0};
+  uint32_t v_x = 0;
+  uint32_t v_y = 0;
+  uint64_t v_i = 0;
+  uint32_t v_num_skip = 0;
+  wuffs_base__slice_u8 v_dst = {0};
+  uint8_t v_filter = 0;
+  wuffs_base__slice_u8 v_s = {0};
+  wuffs_base__slice_u8 v_curr_row = {0};
+  wuffs_base__slice_u8 v_prev_row = {0};
+  uint8_t v_bits_unpacked[8] = {0};
+  uint8_t v_bits_packed = 0;
+  uint8_t v_packs_remaining = 0;
+  uint8_t v_multiplier = 0;
+  uint8_t v_shift = 0;
+
+  v_dst_pixfmt = wuffs_base__pixel_buffer__pixel_format(a_dst);
+  v_dst_bits_per_pixel = wuffs_base__pixel_format__bits_per_pixel(&v_dst_pixfmt);
+  if ((v_dst_bits_per_pixel & 7) != 0) {
+    return wuffs_base__make_status(wuffs_base__error__unsupported_option);
+  }
+  v_dst_bytes_per_pixel = ((uint64_t)((v_dst_bits_per_pixel / 8)));
+  if ((self->private_impl.f_downscale_shift > 0) && (wuffs_base__pixel_format__is_indexed(&v_dst_pixfmt) || (v_dst_bits_per_pixel == 16) || (v_dst_bits_per_pixel > 32))) {
+    return wuffs_base__make_status(wuffs_base__error__unsupported_option);
+  }
+  v_dst_bytes_per_row1 = (((uint64_t)(((uint32_t)(self->private_impl.f_roi_x1 - self->private_impl.f_roi_x0)))) * v_dst_bytes_per_pixel);
+  v_dst_palette = wuffs_base__pixel_buffer__palette_or_else(a_dst, wuffs_base__make_slice_u8(self->private_data.f_dst_palette, 1024));
+  v_tab = wuffs_base__pixel_buffer__plane(a_dst, 0);
+  v_src_bytes_per_pixel = 1;
+  if (self->private_impl.f_depth >= 8) {
+    v_src_bytes_per_pixel = (((uint64_t)(WUFFS_PNG__NUM_CHANNELS[self->private_impl.f_color_type])) * ((uint64_t)((self->private_impl.f_depth >> 3))));
+  }
+  if (self->private_impl.f_downscale_shift > 0) {
+    v_downscale_scratch = wuffs_png__decoder__downscale_scratch(self, a_workbuf, v_dst_bytes_per_pixel);
+  }
+  if (self->private_impl.f_chunk_type_array[0] == 73) {
+    v_y = ((uint32_t)(WUFFS_PNG__INTERLACING[self->private_impl.f_interlace_pass][5]));
+  } else {
+    v_y = self->private_impl.f_frame_rect_y0;
+  }
+  if (v_y < self->private_impl.f_pass_resume_y) {
+    v_y = self->private_impl.f_pass_resume_y;
+    v_i = (((uint64_t)(((uint32_t)(v_y - self->private_impl.f_pass_workbuf_y0)))) * (1 + self->private_impl.f_pass_bytes_per_row));
+    if (v_i > ((uint64_t)(a_workbuf.len))) {
+      return wuffs_base__make_status(wuffs_png__error__internal_error_inconsistent_workbuf_length);
+    }
+    v_prev_row = wuffs_base__slice_u8__subslice_j(a_workbuf, v_i);
+    v_prev_row = wuffs_base__slice_u8__suffix(v_prev_row, self->private_impl.f_pass_bytes_per_row);
+    a_workbuf = wuffs_base__slice_u8__subslice_i(a_workbuf, v_i);
+  }
+  while (v_y < self->private_impl.f_frame_rect_y1) {
+    if (self->private_impl.f_pass_stop_y <= v_y) {
+      goto label__0__break;
+    }
+    if ((self->private_impl.f_band_y1 <= v_y) && (v_y < self->private_impl.f_roi_y1)) {
+      self->private_impl.f_pass_resume_y = v_y;
+      return wuffs_base__make_status(wuffs_png__note__internal_note_short_write);
+    }
+    if (self->private_impl.f_downscale_shift == 0) {
+      v_dst = wuffs_base__table_u8__row_u32(v_tab, ((uint32_t)(v_y - self->private_impl.f_band_y0)));
+    } else {
+      v_dst = v_downscale_scratch;
+    }
+    if (v_dst_bytes_per_row1 < ((uint64_t)(v_dst.len))) {
+      v_dst = wuffs_base__slice_u8__subslice_j(v_dst, v_dst_bytes_per_row1);
+    }
+    if (1 > ((uint64_t)(a_workbuf.len))) {
+      return wuffs_base__make_status(wuffs_png__error__internal_error_inconsistent_workbuf_length);
+    }
+    v_filter = a_workbuf.ptr[0];
+    a_workbuf = wuffs_base__slice_u8__subslice_i(a_workbuf, 1);
+    if (self->private_impl.f_pass_bytes_per_row > ((uint64_t)(a_workbuf.len))) {
+      return wuffs_base__make_status(wuffs_png__error__internal_error_inconsistent_workbuf_length);
+    }
+    v_curr_row = wuffs_base__slice_u8__subslice_j(a_workbuf, self->private_impl.f_pass_bytes_per_row);
+    a_workbuf = wuffs_base__slice_u8__subslice_i(a_workbuf, self->private_impl.f_pass_bytes_per_row);
+    if (v_filter == 0) {
+      WUFFS_BASE__STATS__ADD(self->private_impl, 8, 1);
+    } else if (v_filter == 1) {
+      WUFFS_BASE__STATS__ADD(self->private_impl, 9, 1);
+      wuffs_png__decoder__filter_1(self, v_curr_row);
+    } else if (v_filter == 2) {
+      WUFFS_BASE__STATS__ADD(self->private_impl, 10, 1);
+      wuffs_png__decoder__filter_2(self, v_curr_row, v_prev_row);
+    } else if (v_filter == 3) {
+      WUFFS_BASE__STATS__ADD(self->private_impl, 11, 1);
+      wuffs_png__decoder__filter_3(self, v_curr_row, v_prev_row);
+    } else if (v_filter == 4) {
+      WUFFS_BASE__STATS__ADD(self->private_impl, 12, 1);
+      wuffs_png__decoder__filter_4(self, v_curr_row, v_prev_row);
+    } else {
+      return wuffs_base__make_status(wuffs_png__error__bad_filter);
+    }
+    v_s = v_curr_row;
+    if (self->private_impl.f_chunk_type_array[0] == 73) {
+      v_x = ((uint32_t)(WUFFS_PNG__INTERLACING[self->private_impl.f_interlace_pass][2]));
+    } else {
+      v_x = self->private_impl.f_frame_rect_x0;
+    }
+    v_num_skip = 0;
+    if ((v_y < self->private_impl.f_band_y0) || (self->private_impl.f_band_y1 <= v_y)) {
+      v_x = self->private_impl.f_frame_rect_x1;
+    } else if (v_x < self->private_impl.f_roi_x0) {
+      v_num_skip = (((uint32_t)(((uint32_t)(self->private_impl.f_roi_x0 - v_x)) + ((uint32_t)((((uint32_t)(1)) << WUFFS_PNG__INTERLACING[self->private_impl.f_interlace_pass][0]) - 1)))) >> WUFFS_PNG__INTERLACING[self->private_impl.f_interlace_pass][0]);
+      v_x += ((uint32_t)(v_num_skip << WUFFS_PNG__INTERLACING[self->private_impl.f_interlace_pass][0]));
+      if (self->private_impl.f_depth >= 8) {
+        v_i = (((uint64_t)(v_num_skip)) * v_src_bytes_per_pixel);
+        if (v_i <= ((uint64_t)(v_s.len))) {
+          v_s = wuffs_base__slice_u8__subslice_i(v_s, v_i);
+        } else {
+          v_s = wuffs_base__slice_u8__subslice_j(v_s, 0);
+        }
+      }
+    }
+    if (self->private_impl.f_depth == 8) {
+      while (v_x < self->private_impl.f_frame_rect_x1) {
+        v_i = (((uint64_t)(((uint32_t)(v_x - self->private_impl.f_roi_x0)))) * v_dst_bytes_per_pixel);
+        if (v_i <= ((uint64_t)(v_dst.len))) {
+          if (self->private_impl.f_color_type == 4) {
+            if (2 <= ((uint64_t)(v_s.len))) {
+              v_bits_unpacked[0] = v_s.ptr[0];
+              v_bits_unpacked[1] = v_s.ptr[0];
+              v_bits_unpacked[2] = v_s.ptr[0];
+              v_bits_unpacked[3] = v_s.ptr[1];
+              v_s = wuffs_base__slice_u8__subslice_i(v_s, 2);
+              wuffs_base__pixel_swizzler__swizzle_interleaved_from_slice(&self->private_impl.f_swizzler, wuffs_base__slice_u8__subslice_i(v_dst, v_i), v_dst_palette, wuffs_base__make_slice_u8(v_bits_unpacked, 4));
+            }
+          } else if (((uint32_t)((self->private_impl.f_remap_transparency & 4294967295))) != 0) {
+            if (self->private_impl.f_color_type == 0) {
+              if (1 <= ((uint64_t)(v_s.len))) {
+                v_bits_unpacked[0] = v_s.ptr[0];
+                v_bits_unpacked[1] = v_s.ptr[0];
+                v_bits_unpacked[2] = v_s.ptr[0];
+                v_bits_unpacked[3] = 255;
+                v_s = wuffs_base__slice_u8__subslice_i(v_s, 1);
+                if (((uint32_t)((self->private_impl.f_remap_transparency & 4294967295))) == ((((uint32_t)(v_bits_unpacked[0])) << 0) |
+                    (((uint32_t)(v_bits_unpacked[1])) << 8) |
+                    (((uint32_t)(v_bits_unpacked[2])) << 16) |
+                    (((uint32_t)(v_bits_unpacked[3])) << 24))) {
+                  v_bits_unpacked[0] = 0;
+                  v_bits_unpacked[1] = 0;
+                  v_bits_unpacked[2] = 0;
+                  v_bits_unpacked[3] = 0;
+                }
+                wuffs_base__pixel_swizzler__swizzle_interleaved_from_slice(&self->private_impl.f_swizzler, wuffs_base__slice_u8__subslice_i(v_dst, v_i), v_dst_palette, wuffs_base__make_slice_u8(v_bits_unpacked, 4));
+              }
+            } else {
+              if (3 <= ((uint64_t)(v_s.len))) {
+                v_bits_unpacked[0] = v_s.ptr[2];
+                v_bits_unpacked[1] = v_s.ptr[1];
+                v_bits_unpacked[2] = v_s.ptr[0];
+                v_bits_unpacked[3] = 255;
+                v_s = wuffs_base__slice_u8__subslice_i(v_s, 3);
+                if (((uint32_t)((self->private_impl.f_remap_transparency & 4294967295))) == ((((uint32_t)(v_bits_unpacked[0])) << 0) |
+                    (((uint32_t)(v_bits_unpacked[1])) << 8) |
+                    (((uint32_t)(v_bits_unpacked[2])) << 16) |
+                    (((uint32_t)(v_bits_unpacked[3])) << 24))) {
+                  v_bits_unpacked[0] = 0;
+                  v_bits_unpacked[1] = 0;
+                  v_bits_unpacked[2] = 0;
+                  v_bits_unpacked[3] = 0;
+                }
+                wuffs_base__pixel_swizzler__swizzle_interleaved_from_slice(&self->private_impl.f_swizzler, wuffs_base__slice_u8__subslice_i(v_dst, v_i), v_dst_palette, wuffs_base__make_slice_u8(v_bits_unpacked, 4));
+              }
+            }
+          } else if (v_src_bytes_per_pixel <= ((uint64_t)(v_s.len))) {
+            wuffs_base__pixel_swizzler__swizzle_interleaved_from_slice(&self->private_impl.f_swizzler, wuffs_base__slice_u8__subslice_i(v_dst, v_i), v_dst_palette, wuffs_base__slice_u8__subslice_j(v_s, v_src_bytes_per_pixel));
+            v_s = wuffs_base__slice_u8__subslice_i(v_s, v_src_bytes_per_pixel);
+          }
+        }
+        v_x += (((uint32_t)(1)) << WUFFS_PNG__INTERLACING[self->private_impl.f_interlace_pass][0]);
+      }
+    } else if ((self->private_impl.f_depth < 8) && (self->private_impl.f_interlace_pass == 0) && (((uint32_t)((self->private_impl.f_remap_transparency & 4294967295))) == 0)) {
+      if (v_x < self->private_impl.f_frame_rect_x1) {
+        v_i = (((uint64_t)(((uint32_t)(v_x - self->private_impl.f_roi_x0)))) * v_dst_bytes_per_pixel);
+        if (v_i <= ((uint64_t)(v_dst.len))) {
+          wuffs_base__pixel_swizzler__swizzle_interleaved_from_packed_slice(&self->private_impl.f_swizzler,
+              wuffs_base__slice_u8__subslice_i(v_dst, v_i),
+              v_dst_palette,
+              v_s,
+              ((uint32_t)(self->private_impl.f_depth)),
+              v_num_skip,
+              ((uint64_t)(((uint32_t)(self->private_impl.f_frame_rect_x1 - v_x)))),
+              (self->private_impl.f_color_type == 0));
+        }
+      }
+    } else if (self->private_impl.f_depth < 8) {
+      v_multiplier = 1;
+      if (self->private_impl.f_color_type == 0) {
+        v_multiplier = WUFFS_PNG__LOW_BIT_DEPTH_MULTIPLIERS[self->private_impl.f_depth];
+      }
+      v_shift = ((8 - self->private_impl.f_depth) & 7);
+      v_packs_remaining = 0;
+      if (v_num_skip > 0) {
+        if (self->private_impl.f_depth == 1) {
+          v_i = ((uint64_t)((v_num_skip >> 3)));
+          v_num_skip &= 7;
+        } else if (self->private_impl.f_depth == 2) {
+          v_i = ((uint64_t)((v_num_skip >> 2)));
+          v_num_skip &= 3;
+        } else {
+          v_i = ((uint64_t)((v_num_skip >> 1)));
+          v_num_skip &= 1;
+        }
+        if (v_i <= ((uint64_t)(v_s.len))) {
+          v_s = wuffs_base__slice_u8__subslice_i(v_s, v_i);
+        } else {
+          v_s = wuffs_base__slice_u8__subslice_j(v_s, 0);
+        }
+        if ((v_num_skip > 0) && (1 <= ((uint64_t)(v_s.len)))) {
+          v_packs_remaining = WUFFS_PNG__LOW_BIT_DEPTH_NUM_PACKS[self->private_impl.f_depth];
+          v_bits_packed = v_s.ptr[0];
+          v_s = wuffs_base__slice_u8__subslice_i(v_s, 1);
+          while (v_num_skip > 0) {
+            v_bits_packed = ((uint8_t)(v_bits_packed << self->private_impl.f_depth));
+            v_packs_remaining = ((uint8_t)(v_packs_remaining - 1));
+            v_num_skip -= 1;
+          }
+        }
+      }
+      while (v_x < self->private_impl.f_frame_rect_x1) {
+        v_i = (((uint64_t)(((uint32_t)(v_x - self->private_impl.f_roi_x0)))) * v_dst_bytes_per_pixel);
+        if (v_i <= ((uint64_t)(v_dst.len))) {
+          if ((v_packs_remaining == 0) && (1 <= ((uint64_t)(v_s.len)))) {
+            v_packs_remaining = WUFFS_PNG__LOW_BIT_DEPTH_NUM_PACKS[self->private_impl.f_depth];
+            v_bits_packed = v_s.ptr[0];
+            v_s = wuffs_base__slice_u8__subslice_i(v_s, 1);
+          }
+          v_bits_unpacked[0] = ((uint8_t)((v_bits_packed >> v_shift) * v_multiplier));
+          v_bits_packed = ((uint8_t)(v_bits_packed << self->private_impl.f_depth));
+          v_packs_remaining = ((uint8_t)(v_packs_remaining - 1));
+          if (((uint32_t)((self->private_impl.f_remap_transparency & 4294967295))) != 0) {
+            v_bits_unpacked[1] = v_bits_unpacked[0];
+            v_bits_unpacked[2] = v_bits_unpacked[0];
+            v_bits_unpacked[3] = 255;
+            if (((uint32_t)((self->private_impl.f_remap_transparency & 4294967295))) == ((((uint32_t)(v_bits_unpacked[0])) << 0) |
+                (((uint32_t)(v_bits_unpacked[1])) << 8) |
+                (((uint32_t)(v_bits_unpacked[2])) << 16) |
+                (((uint32_t)(v_bits_unpacked[3])) << 24))) {
+              v_bits_unpacked[0] = 0;
+              v_bits_unpacked[1] = 0;
+              v_bits_unpacked[2] = 0;
+              v_bits_unpacked[3] = 0;
+            }
+            wuffs_base__pixel_swizzler__swizzle_interleaved_from_slice(&self->private_impl.f_swizzler, wuffs_base__slice_u8__subslice_i(v_dst, v_i), v_dst_palette, wuffs_base__make_slice_u8(v_bits_unpacked, 4));
+          } else {
+            wuffs_base__pixel_swizzler__swizzle_interleaved_from_slice(&self->private_impl.f_swizzler, wuffs_base__slice_u8__subslice_i(v_dst, v_i), v_dst_palette, wuffs_base__make_slice_u8(v_bits_unpacked, 1));
+          }
+        }
+        v_x += (((uint32_t)(1)) << WUFFS_PNG__INTERLACING[self->private_impl.f_interlace_pass][0]);
+      }
+    } else if ((self->private_impl.f_interlace_pass == 0) && (self->private_impl.f_remap_transparency == 0)) {
+      if (v_x < self->private_impl.f_frame_rect_x1) {
+        v_i = (((uint64_t)(((uint32_t)(v_x - self->private_impl.f_roi_x0)))) * v_dst_bytes_per_pixel);
+        if (v_i <= ((uint64_t)(v_dst.len))) {
+          wuffs_base__pixel_swizzler__swizzle_interleaved_from_u16be_slice(&self->private_impl.f_swizzler,
+              wuffs_base__slice_u8__subslice_i(v_dst, v_i),
+              v_dst_palette,
+              v_s,
+              ((uint32_t)(WUFFS_PNG__NUM_CHANNELS[self->private_impl.f_color_type])),
+              ((uint64_t)(((uint32_t)(self->private_impl.f_frame_rect_x1 - v_x)))));
+        }
+      }
+    } else {
+      while (v_x < self->private_impl.f_frame_rect_x1) {
+        v_i = (((uint64_t)(((uint32_t)(v_x - self->private_impl.f_roi_x0)))) * v_dst_bytes_per_pixel);
+        if (v_i <= ((uint64_t)(v_dst.len))) {
+          if (self->private_impl.f_color_type == 0) {
+            if (2 <= ((uint64_t)(v_s.len))) {
+              v_bits_unpacked[0] = v_s.ptr[1];
+              v_bits_unpacked[1] = v_s.ptr[0];
+              v_bits_unpacked[2] = v_s.ptr[1];
+              v_bits_unpacked[3] = v_s.ptr[0];
+              v_bits_unpacked[4] = v_s.ptr[1];
+              v_bits_unpacked[5] = v_s.ptr[0];
+              v_bits_unpacked[6] = 255;
+              v_bits_unpacked[7] = 255;
+              v_s = wuffs_base__slice_u8__subslice_i(v_s, 2);
+              if (self->private_impl.f_remap_transparency == ((((uint64_t)(v_bits_unpacked[0])) << 0) |
+                  (((uint64_t)(v_bits_unpacked[1])) << 8) |
+                  (((uint64_t)(v_bits_unpacked[2])) << 16) |
+                  (((uint64_t)(v_bits_unpacked[3])) << 24) |
+                  (((uint64_t)(v_bits_unpacked[4])) << 32) |
+                  (((uint64_t)(v_bits_unpacked[5])) << 40) |
+                  (((uint64_t)(v_bits_unpacked[6])) << 48) |
+                  (((uint64_t)(v_bits_unpacked[7])) << 56))) {
+                v_bits_unpacked[0] = 0;
+                v_bits_unpacked[1] = 0;
+                v_bits_unpacked[2] = 0;
+                v_bits_unpacked[3] = 0;
+                v_bits_unpacked[4] = 0;
+                v_bits_unpacked[5] = 0;
+                v_bits_unpacked[6] = 0;
+                v_bits_unpacked[7] = 0;
+              }
+            }
+          } else if (self->private_impl.f_color_type == 2) {
+            if (6 <= ((uint64_t)(v_s.len))) {
+              v_bits_unpacked[0] = v_s.ptr[5];
+              v_bits_unpacked[1] = v_s.ptr[4];
+              v_bits_unpacked[2] = v_s.ptr[3];
+              v_bits_unpacked[3] = v_s.ptr[2];
+              v_bits_unpacked[4] = v_s.ptr[1];
+              v_bits_unpacked[5] = v_s.ptr[0];
+              v_bits_unpacked[6] = 255;
+              v_bits_unpacked[7] = 255;
+              v_s = wuffs_base__slice_u8__subslice_i(v_s, 6);
+              if (self->private_impl.f_remap_transparency == ((((uint64_t)(v_bits_unpacked[0])) << 0) |
+                  (((uint64_t)(v_bits_unpacked[1])) << 8) |
+                  (((uint64_t)(v_bits_unpacked[2])) << 16) |
+                  (((uint64_t)(v_bits_unpacked[3])) << 24) |
+                  (((uint64_t)(v_bits_unpacked[4])) << 32) |
+                  (((uint64_t)(v_bits_unpacked[5])) << 40) |
+                  (((uint64_t)(v_bits_unpacked[6])) << 48) |
+                  (((uint64_t)(v_bits_unpacked[7])) << 56))) {
+                v_bits_unpacked[0] = 0;
+                v_bits_unpacked[1] = 0;
+                v_bits_unpacked[2] = 0;
+                v_bits_unpacked[3] = 0;
+                v_bits_unpacked[4] = 0;
+                v_bits_unpacked[5] = 0;
+                v_bits_unpacked[6] = 0;
+                v_bits_unpacked[7] = 0;
+              }
+            }
+          } else if (self->private_impl.f_color_type == 4) {
+            if (4 <= ((uint64_t)(v_s.len))) {
+              v_bits_unpacked[0] = v_s.ptr[1];
+              v_bits_unpacked[1] = v_s.ptr[0];
+              v_bits_unpacked[2] = v_s.ptr[1];
+              v_bits_unpacked[3] = v_s.ptr[0];
+              v_bits_unpacked[4] = v_s.ptr[1];
+              v_bits_unpacked[5] = v_s.ptr[0];
+              v_bits_unpacked[6] = v_s.ptr[3];
+              v_bits_unpacked[7] = v_s.ptr[2];
+              v_s = wuffs_base__slice_u8__subslice_i(v_s, 4);
+            }
+          } else {
+            if (8 <= ((uint64_t)(v_s.len))) {
+              v_bits_unpacked[0] = v_s.ptr[5];
+              v_bits_unpacked[1] = v_s.ptr[4];
+              v_bits_unpacked[2] = v_s.ptr[3];
+              v_bits_unpacked[3] = v_s.ptr[2];
+              v_bits_unpacked[4] = v_s.ptr[1];
+              v_bits_unpacked[5] = v_s.ptr[0];
+              v_bits_unpacked[6] = v_s.ptr[7];
+              v_bits_unpacked[7] = v_s.ptr[6];
+              v_s = wuffs_base__slice_u8__subslice_i(v_s, 8);
+            }
+          }
+          wuffs_base__pixel_swizzler__swizzle_interleaved_from_slice(&self->private_impl.f_swizzler, wuffs_base__slice_u8__subslice_i(v_dst, v_i), v_dst_palette, wuffs_base__make_slice_u8(v_bits_unpacked, 8));
+        }
+        v_x += (((uint32_t)(1)) << WUFFS_PNG__INTERLACING[self->private_impl.f_interlace_pass][0]);
+      }
+    }
+    if ((self->private_impl.f_downscale_shift > 0) && (self->private_impl.f_roi_y0 <= v_y) && (v_y < self->private_impl.f_roi_y1)) {
+      self->private_impl.f_downscale_num_rows = wuffs_png__decoder__downscale_row(self,
+          a_dst,
+          a_workbuf,
+          v_y,
+          self->private_impl.f_downscale_num_rows,
+          v_dst_bytes_per_pixel);
+    }
+    v_prev_row = v_curr_row;
+    v_y += (((uint32_t)(1)) << WUFFS_PNG__INTERLACING[self->private_impl.f_interlace_pass][3]);
+  }
+  label__0__break:;
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func png.encoder.byte_cost
+
+static uint64_t
+wuffs_png__encoder__byte_cost(
+    const wuffs_png__encoder* self,
+    uint8_t a_x) {
+  if (a_x >= 128) {
+    return (256 - ((uint64_t)(a_x)));
+  }
+  return ((uint64_t)(a_x));
+}
+
+// -------- func png.encoder.encode_filter_head
+
+static uint64_t
+wuffs_png__encoder__encode_filter_head(
+    wuffs_png__encoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev,
+    uint32_t a_shift) {
+  uint64_t v_n = 0;
+  uint64_t v_i = 0;
+  uint8_t v_p = 0;
+  uint8_t v_x = 0;
+  uint64_t v_cost = 0;
+
+  v_n = ((uint64_t)(self->private_impl.f_filter_distance));
+  while ((v_i < v_n) && (v_i < ((uint64_t)(a_dst.len))) && (v_i < ((uint64_t)(a_curr.len)))) {
+    v_p = 0;
+    if (v_i < ((uint64_t)(a_prev.len))) {
+      v_p = (a_prev.ptr[v_i] >> a_shift);
+    }
+    v_x = ((uint8_t)(a_curr.ptr[v_i] - v_p));
+    a_dst.ptr[v_i] = v_x;
+    v_cost += wuffs_png__encoder__byte_cost(self, v_x);
+    v_i += 1;
+  }
+  return v_cost;
+}
+
+// -------- func png.encoder.encode_filter_0
+
+static wuffs_base__empty_struct
+wuffs_png__encoder__encode_filter_0(
+    wuffs_png__encoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_curr) {
+  return (*self->private_impl.choosy_encode_filter_0)(self, a_dst, a_curr);
+}
+
+static wuffs_base__empty_struct
+wuffs_png__encoder__encode_filter_0__choosy_default(
+    wuffs_png__encoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_curr) {
+  wuffs_base__slice_u8 v_dst = {0};
+  wuffs_base__slice_u8 v_curr = {0};
+  uint64_t v_cost = 0;
+
+  {
+    wuffs_base__slice_u8 i_slice_dst = a_dst;
+    v_dst.ptr = i_slice_dst.ptr;
+    wuffs_base__slice_u8 i_slice_curr = a_curr;
+    v_curr.ptr = i_slice_curr.ptr;
+    i_slice_dst.len = ((size_t)(wuffs_base__u64__min(i_slice_dst.len, i_slice_curr.len)));
+    v_dst.len = 1;
+    v_curr.len = 1;
+    uint8_t* i_end0_dst = v_dst.ptr + (((i_slice_dst.len - (size_t)(v_dst.ptr - i_slice_dst.ptr)) / 4) * 4);
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_dst.ptr < i_end0_dst) {
+      v_dst.ptr[0] = v_curr.ptr[0];
+      v_cost += wuffs_png__encoder__byte_cost(self, v_curr.ptr[0]);
+      v_dst.ptr += 1;
+      v_curr.ptr += 1;
+      v_dst.ptr[0] = v_curr.ptr[0];
+      v_cost += wuffs_png__encoder__byte_cost(self, v_curr.ptr[0]);
+      v_dst.ptr += 1;
+      v_curr.ptr += 1;
+      v_dst.ptr[0] = v_curr.ptr[0];
+      v_cost += wuffs_png__encoder__byte_cost(self, v_curr.ptr[0]);
+      v_dst.ptr += 1;
+      v_curr.ptr += 1;
+      v_dst.ptr[0] = v_curr.ptr[0];
+      v_cost += wuffs_png__encoder__byte_cost(self, v_curr.ptr[0]);
+      v_dst.ptr += 1;
+      v_curr.ptr += 1;
+    }
+    v_dst.len = 1;
+    v_curr.len = 1;
+    uint8_t* i_end1_dst = i_slice_dst.ptr + i_slice_dst.len;
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_dst.ptr < i_end1_dst) {
+      v_dst.ptr[0] = v_curr.ptr[0];
+      v_cost += wuffs_png__encoder__byte_cost(self, v_curr.ptr[0]);
+      v_dst.ptr += 1;
+      v_curr.ptr += 1;
+    }
+    v_dst.len = 0;
+    v_curr.len = 0;
+  }
+  self->private_impl.f_filter_cost = v_cost;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func png.encoder.encode_filter_1
+
+static wuffs_base__empty_struct
+wuffs_png__encoder__encode_filter_1(
+    wuffs_png__encoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_curr) {
+  return (*self->private_impl.choosy_encode_filter_1)(self, a_dst, a_curr);
+}
+
+static wuffs_base__empty_struct
+wuffs_png__encoder__encode_filter_1__choosy_default(
+    wuffs_png__encoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_curr) {
+  wuffs_base__slice_u8 v_dst = {0};
+  wuffs_base__slice_u8 v_curr = {0};
+  wuffs_base__slice_u8 v_left = {0};
+  uint64_t v_d = 0;
+  uint8_t v_x = 0;
+  uint64_t v_cost = 0;
+
+  v_cost = wuffs_png__encoder__encode_filter_head(self,
+      a_dst,
+      a_curr,
+      wuffs_base__utility__empty_slice_u8(),
+      0);
+  v_d = ((uint64_t)(self->private_impl.f_filter_distance));
+  if ((v_d <= ((uint64_t)(a_dst.len))) && (v_d <= ((uint64_t)(a_curr.len)))) {
+    {
+      wuffs_base__slice_u8 i_slice_dst = wuffs_base__slice_u8__subslice_i(a_dst, v_d);
+      v_dst.ptr = i_slice_dst.ptr;
+      wuffs_base__slice_u8 i_slice_curr = wuffs_base__slice_u8__subslice_i(a_curr, v_d);
+      v_curr.ptr = i_slice_curr.ptr;
+      i_slice_dst.len = ((size_t)(wuffs_base__u64__min(i_slice_dst.len, i_slice_curr.len)));
+      wuffs_base__slice_u8 i_slice_left = a_curr;
+      v_left.ptr = i_slice_left.ptr;
+      i_slice_dst.len = ((size_t)(wuffs_base__u64__min(i_slice_dst.len, i_slice_left.len)));
+      v_dst.len = 1;
+      v_curr.len = 1;
+      v_left.len = 1;
+      uint8_t* i_end0_dst = v_dst.ptr + (((i_slice_dst.len - (size_t)(v_dst.ptr - i_slice_dst.ptr)) / 4) * 4);
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_dst.ptr < i_end0_dst) {
+        v_x = ((uint8_t)(v_curr.ptr[0] - v_left.ptr[0]));
+        v_dst.ptr[0] = v_x;
+        v_cost += wuffs_png__encoder__byte_cost(self, v_x);
+        v_dst.ptr += 1;
+        v_curr.ptr += 1;
+        v_left.ptr += 1;
+        v_x = ((uint8_t)(v_curr.ptr[0] - v_left.ptr[0]));
+        v_dst.ptr[0] = v_x;
+        v_cost += wuffs_png__encoder__byte_cost(self, v_x);
+        v_dst.ptr += 1;
+        v_curr.ptr += 1;
+        v_left.ptr += 1;
+        v_x = ((uint8_t)(v_curr.ptr[0] - v_left.ptr[0]));
+        v_dst.ptr[0] = v_x;
+        v_cost += wuffs_png__encoder__byte_cost(self, v_x);
+        v_dst.ptr += 1;
+        v_curr.ptr += 1;
+        v_left.ptr += 1;
+        v_x = ((uint8_t)(v_curr.ptr[0] - v_left.ptr[0]));
+        v_dst.ptr[0] = v_x;
+        v_cost += wuffs_png__encoder__byte_cost(self, v_x);
+        v_dst.ptr += 1;
+        v_curr.ptr += 1;
+        v_left.ptr += 1;
+      }
+      v_dst.len = 1;
+      v_curr.len = 1;
+      v_left.len = 1;
+      uint8_t* i_end1_dst = i_slice_dst.ptr + i_slice_dst.len;
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_dst.ptr < i_end1_dst) {
+        v_x = ((uint8_t)(v_curr.ptr[0] - v_left.ptr[0]));
+        v_dst.ptr[0] = v_x;
+        v_cost += wuffs_png__encoder__byte_cost(self, v_x);
+        v_dst.ptr += 1;
+        v_curr.ptr += 1;
+        v_left.ptr += 1;
+      }
+      v_dst.len = 0;
+      v_curr.len = 0;
+      v_left.len = 0;
+    }
+  }
+  self->private_impl.f_filter_cost = v_cost;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func png.encoder.encode_filter_2
+
+static wuffs_base__empty_struct
+wuffs_png__encoder__encode_filter_2(
+    wuffs_png__encoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev) {
+  return (*self->private_impl.choosy_encode_filter_2)(self, a_dst, a_curr, a_prev);
+}
+
+static wuffs_base__empty_struct
+wuffs_png__encoder__encode_filter_2__choosy_default(
+    wuffs_png__encoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev) {
+  wuffs_base__slice_u8 v_dst = {0};
+  wuffs_base__slice_u8 v_curr = {0};
+  wuffs_base__slice_u8 v_prev = {0};
+  uint8_t v_x = 0;
+  uint64_t v_cost = 0;
+
+  {
+    wuffs_base__slice_u8 i_slice_dst = a_dst;
+    v_dst.ptr = i_slice_dst.ptr;
+    wuffs_base__slice_u8 i_slice_curr = a_curr;
+    v_curr.ptr = i_slice_curr.ptr;
+    i_slice_dst.len = ((size_t)(wuffs_base__u64__min(i_slice_dst.len, i_slice_curr.len)));
+    wuffs_base__slice_u8 i_slice_prev = a_prev;
+    v_prev.ptr = i_slice_prev.ptr;
+    i_slice_dst.len = ((size_t)(wuffs_base__u64__min(i_slice_dst.len, i_slice_prev.len)));
+    v_dst.len = 1;
+    v_curr.len = 1;
+    v_prev.len = 1;
+    uint8_t* i_end0_dst = v_dst.ptr + (((i_slice_dst.len - (size_t)(v_dst.ptr - i_slice_dst.ptr)) / 4) * 4);
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_dst.ptr < i_end0_dst) {
+      v_x = ((uint8_t)(v_curr.ptr[0] - v_prev.ptr[0]));
+      v_dst.ptr[0] = v_x;
+      v_cost += wuffs_png__encoder__byte_cost(self, v_x);
+      v_dst.ptr += 1;
+      v_curr.ptr += 1;
+      v_prev.ptr += 1;
+      v_x = ((uint8_t)(v_curr.ptr[0] - v_prev.ptr[0]));
+      v_dst.ptr[0] = v_x;
+      v_cost += wuffs_png__encoder__byte_cost(self, v_x);
+      v_dst.ptr += 1;
+      v_curr.ptr += 1;
+      v_prev.ptr += 1;
+      v_x = ((uint8_t)(v_curr.ptr[0] - v_prev.ptr[0]));
+      v_dst.ptr[0] = v_x;
+      v_cost += wuffs_png__encoder__byte_cost(self, v_x);
+      v_dst.ptr += 1;
+      v_curr.ptr += 1;
+      v_prev.ptr += 1;
+      v_x = ((uint8_t)(v_curr.ptr[0] - v_prev.ptr[0]));
+      v_dst.ptr[0] = v_x;
+      v_cost += wuffs_png__encoder__byte_cost(self, v_x);
+      v_dst.ptr += 1;
+      v_curr.ptr += 1;
+      v_prev.ptr += 1;
+    }
+    v_dst.len = 1;
+    v_curr.len = 1;
+    v_prev.len = 1;
+    uint8_t* i_end1_dst = i_slice_dst.ptr + i_slice_dst.len;
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_dst.ptr < i_end1_dst) {
+      v_x = ((uint8_t)(v_curr.ptr[0] - v_prev.ptr[0]));
+      v_dst.ptr[0] = v_x;
+      v_cost += wuffs_png__encoder__byte_cost(self, v_x);
+      v_dst.ptr += 1;
+      v_curr.ptr += 1;
+      v_prev.ptr += 1;
+    }
+    v_dst.len = 0;
+    v_curr.len = 0;
+    v_prev.len = 0;
+  }
+  self->private_impl.f_filter_cost = v_cost;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func png.encoder.encode_filter_3
+
+static wuffs_base__empty_struct
+wuffs_png__encoder__encode_filter_3(
+    wuffs_png__encoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev) {
+  return (*self->private_impl.choosy_encode_filter_3)(self, a_dst, a_curr, a_prev);
+}
+
+static wuffs_base__empty_struct
+wuffs_png__encoder__encode_filter_3__choosy_default(
+    wuffs_png__encoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev) {
+  wuffs_base__slice_u8 v_dst = {0};
+  wuffs_base__slice_u8 v_curr = {0};
+  wuffs_base__slice_u8 v_left = {0};
+  wuffs_base__slice_u8 v_up = {0};
+  uint64_t v_d = 0;
+  uint8_t v_x = 0;
+  uint64_t v_cost = 0;
+
+  v_cost = wuffs_png__encoder__encode_filter_head(self,
+      a_dst,
+      a_curr,
+      a_prev,
+      1);
+  v_d = ((uint64_t)(self->private_impl.f_filter_distance));
+  if ((v_d <= ((uint64_t)(a_dst.len))) && (v_d <= ((uint64_t)(a_curr.len))) && (v_d <= ((uint64_t)(a_prev.len)))) {
+    {
+      wuffs_base__slice_u8 i_slice_dst = wuffs_base__slice_u8__subslice_i(a_dst, v_d);
+      v_dst.ptr = i_slice_dst.ptr;
+      wuffs_base__slice_u8 i_slice_curr = wuffs_base__slice_u8__subslice_i(a_curr, v_d);
+      v_curr.ptr = i_slice_curr.ptr;
+      i_slice_dst.len = ((size_t)(wuffs_base__u64__min(i_slice_dst.len, i_slice_curr.len)));
+      wuffs_base__slice_u8 i_slice_left = a_curr;
+      v_left.ptr = i_slice_left.ptr;
+      i_slice_dst.len = ((size_t)(wuffs_base__u64__min(i_slice_dst.len, i_slice_left.len)));
+      wuffs_base__slice_u8 i_slice_up = wuffs_base__slice_u8__subslice_i(a_prev, v_d);
+      v_up.ptr = i_slice_up.ptr;
+      i_slice_dst.len = ((size_t)(wuffs_base__u64__min(i_slice_dst.len, i_slice_up.len)));
+      v_dst.len = 1;
+      v_curr.len = 1;
+      v_left.len = 1;
+      v_up.len = 1;
+      uint8_t* i_end0_dst = v_dst.ptr + (((i_slice_dst.len - (size_t)(v_dst.ptr - i_slice_dst.ptr)) / 4) * 4);
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_dst.ptr < i_end0_dst) {
+        v_x = ((uint8_t)(v_curr.ptr[0] - ((uint8_t)(((((uint32_t)(v_left.ptr[0])) + ((uint32_t)(v_up.ptr[0]))) / 2)))));
+        v_dst.ptr[0] = v_x;
+        v_cost += wuffs_png__encoder__byte_cost(self, v_x);
+        v_dst.ptr += 1;
+        v_curr.ptr += 1;
+        v_left.ptr += 1;
+        v_up.ptr += 1;
+        v_x = ((uint8_t)(v_curr.ptr[0] - ((uint8_t)(((((uint32_t)(v_left.ptr[0])) + ((uint32_t)(v_up.ptr[0]))) / 2)))));
+        v_dst.ptr[0] = v_x;
+        v_cost += wuffs_png__encoder__byte_cost(self, v_x);
+        v_dst.ptr += 1;
+        v_curr.ptr += 1;
+        v_left.ptr += 1;
+        v_up.ptr += 1;
+        v_x = ((uint8_t)(v_curr.ptr[0] - ((uint8_t)(((((uint32_t)(v_left.ptr[0])) + ((uint32_t)(v_up.ptr[0]))) / 2)))));
+        v_dst.ptr[0] = v_x;
+        v_cost += wuffs_png__encoder__byte_cost(self, v_x);
+        v_dst.ptr += 1;
+        v_curr.ptr += 1;
+        v_left.ptr += 1;
+        v_up.ptr += 1;
+        v_x = ((uint8_t)(v_curr.ptr[0] - ((uint8_t)(((((uint32_t)(v_left.ptr[0])) + ((uint32_t)(v_up.ptr[0]))) / 2)))));
+        v_dst.ptr[0] = v_x;
+        v_cost += wuffs_png__encoder__byte_cost(self, v_x);
+        v_dst.ptr += 1;
+        v_curr.ptr += 1;
+        v_left.ptr += 1;
+        v_up.ptr += 1;
+      }
+      v_dst.len = 1;
+      v_curr.len = 1;
+      v_left.len = 1;
+      v_up.len = 1;
+      uint8_t* i_end1_dst = i_slice_dst.ptr + i_slice_dst.len;
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_dst.ptr < i_end1_dst) {
+        v_x = ((uint8_t)(v_curr.ptr[0] - ((uint8_t)(((((uint32_t)(v_left.ptr[0])) + ((uint32_t)(v_up.ptr[0]))) / 2)))));
+        v_dst.ptr[0] = v_x;
+        v_cost += wuffs_png__encoder__byte_cost(self, v_x);
+        v_dst.ptr += 1;
+        v_curr.ptr += 1;
+        v_left.ptr += 1;
+        v_up.ptr += 1;
+      }
+      v_dst.len = 0;
+      v_curr.len = 0;
+      v_left.len = 0;
+      v_up.len = 0;
+    }
+  }
+  self->private_impl.f_filter_cost = v_cost;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func png.encoder.encode_filter_4
+
+static wuffs_base__empty_struct
+wuffs_png__encoder__encode_filter_4(
+    wuffs_png__encoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev) {
+  return (*self->private_impl.choosy_encode_filter_4)(self, a_dst, a_curr, a_prev);
+}
+
+static wuffs_base__empty_struct
+wuffs_png__encoder__encode_filter_4__choosy_default(
+    wuffs_png__encoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev) {
+  wuffs_base__slice_u8 v_dst = {0};
+  wuffs_base__slice_u8 v_curr = {0};
+  wuffs_base__slice_u8 v_left = {0};
+  wuffs_base__slice_u8 v_up = {0};
+  wuffs_base__slice_u8 v_upleft = {0};
+  uint64_t v_d = 0;
+  uint8_t v_x = 0;
+  uint64_t v_cost = 0;
+
+  v_cost = wuffs_png__encoder__encode_filter_head(self,
+      a_dst,
+      a_curr,
+      a_prev,
+      0);
+  v_d = ((uint64_t)(self->private_impl.f_filter_distance));
+  if ((v_d <= ((uint64_t)(a_dst.len))) && (v_d <= ((uint64_t)(a_curr.len))) && (v_d <= ((uint64_t)(a_prev.len)))) {
+    {
+      wuffs_base__slice_u8 i_slice_dst = wuffs_base__slice_u8__subslice_i(a_dst, v_d);
+      v_dst.ptr = i_slice_dst.ptr;
+      wuffs_base__slice_u8 i_slice_curr = wuffs_base__slice_u8__subslice_i(a_curr, v_d);
+      v_curr.ptr = i_slice_curr.ptr;
+      i_slice_dst.len = ((size_t)(wuffs_base__u64__min(i_slice_dst.len, i_slice_curr.len)));
+      wuffs_base__slice_u8 i_slice_left = a_curr;
+      v_left.ptr = i_slice_left.ptr;
+      i_slice_dst.len = ((size_t)(wuffs_base__u64__min(i_slice_dst.len, i_slice_left.len)));
+      wuffs_base__slice_u8 i_slice_up = wuffs_base__slice_u8__subslice_i(a_prev, v_d);
+      v_up.ptr = i_slice_up.ptr;
+      i_slice_dst.len = ((size_t)(wuffs_base__u64__min(i_slice_dst.len, i_slice_up.len)));
+      wuffs_base__slice_u8 i_slice_upleft = a_prev;
+      v_upleft.ptr = i_slice_upleft.ptr;
+      i_slice_dst.len = ((size_t)(wuffs_base__u64__min(i_slice_dst.len, i_slice_upleft.len)));
+      v_dst.len = 1;
+      v_curr.len = 1;
+      v_left.len = 1;
+      v_up.len = 1;
+      v_upleft.len = 1;
+      uint8_t* i_end0_dst = v_dst.ptr + (((i_slice_dst.len - (size_t)(v_dst.ptr - i_slice_dst.ptr)) / 2) * 2);
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_dst.ptr < i_end0_dst) {
+        v_x = ((uint8_t)(v_curr.ptr[0] - wuffs_png__encoder__paeth(self, v_left.ptr[0], v_up.ptr[0], v_upleft.ptr[0])));
+        v_dst.ptr[0] = v_x;
+        v_cost += wuffs_png__encoder__byte_cost(self, v_x);
+        v_dst.ptr += 1;
+        v_curr.ptr += 1;
+        v_left.ptr += 1;
+        v_up.ptr += 1;
+        v_upleft.ptr += 1;
+        v_x = ((uint8_t)(v_curr.ptr[0] - wuffs_png__encoder__paeth(self, v_left.ptr[0], v_up.ptr[0], v_upleft.ptr[0])));
+        v_dst.ptr[0] = v_x;
+        v_cost += wuffs_png__encoder__byte_cost(self, v_x);
+        v_dst.ptr += 1;
+        v_curr.ptr += 1;
+        v_left.ptr += 1;
+        v_up.ptr += 1;
+        v_upleft.ptr += 1;
+      }
+      v_dst.len = 1;
+      v_curr.len = 1;
+      v_left.len = 1;
+      v_up.len = 1;
+      v_upleft.len = 1;
+      uint8_t* i_end1_dst = i_slice_dst.ptr + i_slice_dst.len;
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_dst.ptr < i_end1_dst) {
+        v_x = ((uint8_t)(v_curr.ptr[0] - wuffs_png__encoder__paeth(self, v_left.ptr[0], v_up.ptr[0], v_upleft.ptr[0])));
+        v_dst.ptr[0] = v_x;
+        v_cost += wuffs_png__encoder__byte_cost(self, v_x);
+        v_dst.ptr += 1;
+        v_curr.ptr += 1;
+        v_left.ptr += 1;
+        v_up.ptr += 1;
+        v_upleft.ptr += 1;
+      }
+      v_dst.len = 0;
+      v_curr.len = 0;
+      v_left.len = 0;
+      v_up.len = 0;
+      v_upleft.len = 0;
+    }
+  }
+  self->private_impl.f_filter_cost = v_cost;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func png.encoder.paeth
+
+static uint8_t
+wuffs_png__encoder__paeth(
+    const wuffs_png__encoder* self,
+    uint8_t a_a,
+    uint8_t a_b,
+    uint8_t a_c) {
+  uint32_t v_fa = 0;
+  uint32_t v_fb = 0;
+  uint32_t v_fc = 0;
+  uint32_t v_pp = 0;
+  uint32_t v_pa = 0;
+  uint32_t v_pb = 0;
+  uint32_t v_pc = 0;
+
+  v_fa = ((uint32_t)(a_a));
+  v_fb = ((uint32_t)(a_b));
+  v_fc = ((uint32_t)(a_c));
+  v_pp = ((uint32_t)(((uint32_t)(v_fa + v_fb)) - v_fc));
+  v_pa = ((uint32_t)(v_pp - v_fa));
+  if (v_pa >= 2147483648) {
+    v_pa = ((uint32_t)(0 - v_pa));
+  }
+  v_pb = ((uint32_t)(v_pp - v_fb));
+  if (v_pb >= 2147483648) {
+    v_pb = ((uint32_t)(0 - v_pb));
+  }
+  v_pc = ((uint32_t)(v_pp - v_fc));
+  if (v_pc >= 2147483648) {
+    v_pc = ((uint32_t)(0 - v_pc));
+  }
+  if ((v_pa <= v_pb) && (v_pa <= v_pc)) {
+    return a_a;
+  } else if (v_pb <= v_pc) {
+    return a_b;
+  }
+  return a_c;
+}
+
+// ‼ WUFFS MULTI-FILE SECTION +x86_sse42
+// -------- func png.encoder.encode_filter_0_x86_sse42
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+static wuffs_base__empty_struct
+wuffs_png__encoder__encode_filter_0_x86_sse42(
+    wuffs_png__encoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_curr) {
+  wuffs_base__slice_u8 v_dst = {0};
+  wuffs_base__slice_u8 v_curr = {0};
+  uint64_t v_cost = 0;
+  __m128i v_x128 = {0};
+  __m128i v_c128 = {0};
+  __m128i v_z128 = {0};
+
+  {
+    wuffs_base__slice_u8 i_slice_dst = a_dst;
+    v_dst.ptr = i_slice_dst.ptr;
+    wuffs_base__slice_u8 i_slice_curr = a_curr;
+    v_curr.ptr = i_slice_curr.ptr;
+    i_slice_dst.len = ((size_t)(wuffs_base__u64__min(i_slice_dst.len, i_slice_curr.len)));
+    v_dst.len = 16;
+    v_curr.len = 16;
+    uint8_t* i_end0_dst = v_dst.ptr + (((i_slice_dst.len - (size_t)(v_dst.ptr - i_slice_dst.ptr)) / 16) * 16);
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_dst.ptr < i_end0_dst) {
+      v_x128 = _mm_lddqu_si128((const __m128i*)(const void*)(v_curr.ptr));
+      _mm_storeu_si128((__m128i*)(void*)(v_dst.ptr), v_x128);
+      v_c128 = _mm_add_epi64(v_c128, _mm_sad_epu8(_mm_min_epu8(v_x128, _mm_sub_epi8(v_z128, v_x128)), v_z128));
+      v_dst.ptr += 16;
+      v_curr.ptr += 16;
+    }
+    v_dst.len = 1;
+    v_curr.len = 1;
+    uint8_t* i_end1_dst = i_slice_dst.ptr + i_slice_dst.len;
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_dst.ptr < i_end1_dst) {
+      v_dst.ptr[0] = v_curr.ptr[0];
+      v_cost += wuffs_png__encoder__byte_cost(self, v_curr.ptr[0]);
+      v_dst.ptr += 1;
+      v_curr.ptr += 1;
+    }
+    v_dst.len = 0;
+    v_curr.len = 0;
+  }
+  self->private_impl.f_filter_cost = ((uint64_t)(((uint64_t)(v_cost + ((uint64_t)(_mm_extract_epi64(v_c128, (int32_t)(0)))))) + ((uint64_t)(_mm_extract_epi64(v_c128, (int32_t)(1))))));
+  return wuffs_base__make_empty_struct();
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// ‼ WUFFS MULTI-FILE SECTION -x86_sse42
+
+// ‼ WUFFS MULTI-FILE SECTION +x86_sse42
+// -------- func png.encoder.encode_filter_1_x86_sse42
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+static wuffs_base__empty_struct
+wuffs_png__encoder__encode_filter_1_x86_sse42(
+    wuffs_png__encoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_curr) {
+  wuffs_base__slice_u8 v_dst = {0};
+  wuffs_base__slice_u8 v_curr = {0};
+  wuffs_base__slice_u8 v_left = {0};
+  uint64_t v_d = 0;
+  uint8_t v_x = 0;
+  uint64_t v_cost = 0;
+  __m128i v_x128 = {0};
+  __m128i v_a128 = {0};
+  __m128i v_c128 = {0};
+  __m128i v_z128 = {0};
+
+  v_cost = wuffs_png__encoder__encode_filter_head(self,
+      a_dst,
+      a_curr,
+      wuffs_base__utility__empty_slice_u8(),
+      0);
+  v_d = ((uint64_t)(self->private_impl.f_filter_distance));
+  if ((v_d <= ((uint64_t)(a_dst.len))) && (v_d <= ((uint64_t)(a_curr.len)))) {
+    {
+      wuffs_base__slice_u8 i_slice_dst = wuffs_base__slice_u8__subslice_i(a_dst, v_d);
+      v_dst.ptr = i_slice_dst.ptr;
+      wuffs_base__slice_u8 i_slice_curr = wuffs_base__slice_u8__subslice_i(a_curr, v_d);
+      v_curr.ptr = i_slice_curr.ptr;
+      i_slice_dst.len = ((size_t)(wuffs_base__u64__min(i_slice_dst.len, i_slice_curr.len)));
+      wuffs_base__slice_u8 i_slice_left = a_curr;
+      v_left.ptr = i_slice_left.ptr;
+      i_slice_dst.len = ((size_t)(wuffs_base__u64__min(i_slice_dst.len, i_slice_left.len)));
+      v_dst.len = 16;
+      v_curr.len = 16;
+      v_left.len = 16;
+      uint8_t* i_end0_dst = v_dst.ptr + (((i_slice_dst.len - (size_t)(v_dst.ptr - i_slice_dst.ptr)) / 16) * 16);
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_dst.ptr < i_end0_dst) {
+        v_x128 = _mm_lddqu_si128((const __m128i*)(const void*)(v_curr.ptr));
+        v_a128 = _mm_lddqu_si128((const __m128i*)(const void*)(v_left.ptr));
+        v_x128 = _mm_sub_epi8(v_x128, v_a128);
+        _mm_storeu_si128((__m128i*)(void*)(v_dst.ptr), v_x128);
+        v_c128 = _mm_add_epi64(v_c128, _mm_sad_epu8(_mm_min_epu8(v_x128, _mm_sub_epi8(v_z128, v_x128)), v_z128));
+        v_dst.ptr += 16;
+        v_curr.ptr += 16;
+        v_left.ptr += 16;
+      }
+      v_dst.len = 1;
+      v_curr.len = 1;
+      v_left.len = 1;
+      uint8_t* i_end1_dst = i_slice_dst.ptr + i_slice_dst.len;
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_dst.ptr < i_end1_dst) {
+        v_x = ((uint8_t)(v_curr.ptr[0] - v_left.ptr[0]));
+        v_dst.ptr[0] = v_x;
+        v_cost += wuffs_png__encoder__byte_cost(self, v_x);
+        v_dst.ptr += 1;
+        v_curr.ptr += 1;
+        v_left.ptr += 1;
+      }
+      v_dst.len = 0;
+      v_curr.len = 0;
+      v_left.len = 0;
+    }
+  }
+  self->private_impl.f_filter_cost = ((uint64_t)(((uint64_t)(v_cost + ((uint64_t)(_mm_extract_epi64(v_c128, (int32_t)(0)))))) + ((uint64_t)(_mm_extract_epi64(v_c128, (int32_t)(1))))));
+  return wuffs_base__make_empty_struct();
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// ‼ WUFFS MULTI-FILE SECTION -x86_sse42
+
+// ‼ WUFFS MULTI-FILE SECTION +x86_sse42
+// -------- func png.encoder.encode_filter_2_x86_sse42
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+static wuffs_base__empty_struct
+wuffs_png__encoder__encode_filter_2_x86_sse42(
+    wuffs_png__encoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev) {
+  wuffs_base__slice_u8 v_dst = {0};
+  wuffs_base__slice_u8 v_curr = {0};
+  wuffs_base__slice_u8 v_prev = {0};
+  uint8_t v_x = 0;
+  uint64_t v_cost = 0;
+  __m128i v_x128 = {0};
+  __m128i v_b128 = {0};
+  __m128i v_c128 = {0};
+  __m128i v_z128 = {0};
+
+  {
+    wuffs_base__slice_u8 i_slice_dst = a_dst;
+    v_dst.ptr = i_slice_dst.ptr;
+    wuffs_base__slice_u8 i_slice_curr = a_curr;
+    v_curr.ptr = i_slice_curr.ptr;
+    i_slice_dst.len = ((size_t)(wuffs_base__u64__min(i_slice_dst.len, i_slice_curr.len)));
+    wuffs_base__slice_u8 i_slice_prev = a_prev;
+    v_prev.ptr = i_slice_prev.ptr;
+    i_slice_dst.len = ((size_t)(wuffs_base__u64__min(i_slice_dst.len, i_slice_prev.len)));
+    v_dst.len = 16;
+    v_curr.len = 16;
+    v_prev.len = 16;
+    uint8_t* i_end0_dst = v_dst.ptr + (((i_slice_dst.len - (size_t)(v_dst.ptr - i_slice_dst.ptr)) / 16) * 16);
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_dst.ptr < i_end0_dst) {
+      v_x128 = _mm_lddqu_si128((const __m128i*)(const void*)(v_curr.ptr));
+      v_b128 = _mm_lddqu_si128((const __m128i*)(const void*)(v_prev.ptr));
+      v_x128 = _mm_sub_epi8(v_x128, v_b128);
+      _mm_storeu_si128((__m128i*)(void*)(v_dst.ptr), v_x128);
+      v_c128 = _mm_add_epi64(v_c128, _mm_sad_epu8(_mm_min_epu8(v_x128, _mm_sub_epi8(v_z128, v_x128)), v_z128));
+      v_dst.ptr += 16;
+      v_curr.ptr += 16;
+      v_prev.ptr += 16;
+    }
+    v_dst.len = 1;
+    v_curr.len = 1;
+    v_prev.len = 1;
+    uint8_t* i_end1_dst = i_slice_dst.ptr + i_slice_dst.len;
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_dst.ptr < i_end1_dst) {
+      v_x = ((uint8_t)(v_curr.ptr[0] - v_prev.ptr[0]));
+      v_dst.ptr[0] = v_x;
+      v_cost += wuffs_png__encoder__byte_cost(self, v_x);
+      v_dst.ptr += 1;
+      v_curr.ptr += 1;
+      v_prev.ptr += 1;
+    }
+    v_dst.len = 0;
+    v_curr.len = 0;
+    v_prev.len = 0;
+  }
+  self->private_impl.f_filter_cost = ((uint64_t)(((uint64_t)(v_cost + ((uint64_t)(_mm_extract_epi64(v_c128, (int32_t)(0)))))) + ((uint64_t)(_mm_extract_epi64(v_c128, (int32_t)(1))))));
+  return wuffs_base__make_empty_struct();
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// ‼ WUFFS MULTI-FILE SECTION -x86_sse42
+
+// ‼ WUFFS MULTI-FILE SECTION +x86_sse42
+// -------- func png.encoder.encode_filter_3_x86_sse42
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+static wuffs_base__empty_struct
+wuffs_png__encoder__encode_filter_3_x86_sse42(
+    wuffs_png__encoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev) {
+  wuffs_base__slice_u8 v_dst = {0};
+  wuffs_base__slice_u8 v_curr = {0};
+  wuffs_base__slice_u8 v_left = {0};
+  wuffs_base__slice_u8 v_up = {0};
+  uint64_t v_d = 0;
+  uint8_t v_x = 0;
+  uint64_t v_cost = 0;
+  __m128i v_x128 = {0};
+  __m128i v_a128 = {0};
+  __m128i v_b128 = {0};
+  __m128i v_p128 = {0};
+  __m128i v_k128 = {0};
+  __m128i v_c128 = {0};
+  __m128i v_z128 = {0};
+
+  v_cost = wuffs_png__encoder__encode_filter_head(self,
+      a_dst,
+      a_curr,
+      a_prev,
+      1);
+  v_d = ((uint64_t)(self->private_impl.f_filter_distance));
+  v_k128 = _mm_set1_epi8((int8_t)(1));
+  if ((v_d <= ((uint64_t)(a_dst.len))) && (v_d <= ((uint64_t)(a_curr.len))) && (v_d <= ((uint64_t)(a_prev.len)))) {
+    {
+      wuffs_base__slice_u8 i_slice_dst = wuffs_base__slice_u8__subslice_i(a_dst, v_d);
+      v_dst.ptr = i_slice_dst.ptr;
+      wuffs_base__slice_u8 i_slice_curr = wuffs_base__slice_u8__subslice_i(a_curr, v_d);
+      v_curr.ptr = i_slice_curr.ptr;
+      i_slice_dst.len = ((size_t)(wuffs_base__u64__min(i_slice_dst.len, i_slice_curr.len)));
+      wuffs_base__slice_u8 i_slice_left = a_curr;
+      v_left.ptr = i_slice_left.ptr;
+      i_slice_dst.len = ((size_t)(wuffs_base__u64__min(i_slice_dst.len, i_slice_left.len)));
+      wuffs_base__slice_u8 i_slice_up = wuffs_base__slice_u8__subslice_i(a_prev, v_d);
+      v_up.ptr = i_slice_up.ptr;
+      i_slice_dst.len = ((size_t)(wuffs_base__u64__min(i_slice_dst.len, i_slice_up.len)));
+      v_dst.len = 16;
+      v_curr.len = 16;
+      v_left.len = 16;
+      v_up.len = 16;
+      uint8_t* i_end0_dst = v_dst.ptr + (((i_slice_dst.len - (size_t)(v_dst.ptr - i_slice_dst.ptr)) / 16) * 16);
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_dst.ptr < i_end0_dst) {
+        v_a128 = _mm_lddqu_si128((const __m128i*)(const void*)(v_left.ptr));
+        v_b128 = _mm_lddqu_si128((const __m128i*)(const void*)(v_up.ptr));
+        v_p128 = _mm_avg_epu8(v_a128, v_b128);
+        v_p128 = _mm_sub_epi8(v_p128, _mm_and_si128(v_k128, _mm_xor_si128(v_a128, v_b128)));
+        v_x128 = _mm_lddqu_si128((const __m128i*)(const void*)(v_curr.ptr));
+        v_x128 = _mm_sub_epi8(v_x128, v_p128);
+        _mm_storeu_si128((__m128i*)(void*)(v_dst.ptr), v_x128);
+        v_c128 = _mm_add_epi64(v_c128, _mm_sad_epu8(_mm_min_epu8(v_x128, _mm_sub_epi8(v_z128, v_x128)), v_z128));
+        v_dst.ptr += 16;
+        v_curr.ptr += 16;
+        v_left.ptr += 16;
+        v_up.ptr += 16;
+      }
+      v_dst.len = 1;
+      v_curr.len = 1;
+      v_left.len = 1;
+      v_up.len = 1;
+      uint8_t* i_end1_dst = i_slice_dst.ptr + i_slice_dst.len;
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_dst.ptr < i_end1_dst) {
+        v_x = ((uint8_t)(v_curr.ptr[0] - ((uint8_t)(((((uint32_t)(v_left.ptr[0])) + ((uint32_t)(v_up.ptr[0]))) / 2)))));
+        v_dst.ptr[0] = v_x;
+        v_cost += wuffs_png__encoder__byte_cost(self, v_x);
+        v_dst.ptr += 1;
+        v_curr.ptr += 1;
+        v_left.ptr += 1;
+        v_up.ptr += 1;
+      }
+      v_dst.len = 0;
+      v_curr.len = 0;
+      v_left.len = 0;
+      v_up.len = 0;
+    }
+  }
+  self->private_impl.f_filter_cost = ((uint64_t)(((uint64_t)(v_cost + ((uint64_t)(_mm_extract_epi64(v_c128, (int32_t)(0)))))) + ((uint64_t)(_mm_extract_epi64(v_c128, (int32_t)(1))))));
+  return wuffs_base__make_empty_struct();
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// ‼ WUFFS MULTI-FILE SECTION -x86_sse42
+
+// ‼ WUFFS MULTI-FILE SECTION +x86_sse42
+// -------- func png.encoder.encode_filter_4_x86_sse42
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+static wuffs_base__empty_struct
+wuffs_png__encoder__encode_filter_4_x86_sse42(
+    wuffs_png__encoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev) {
+  wuffs_base__slice_u8 v_dst = {0};
+  wuffs_base__slice_u8 v_curr = {0};
+  wuffs_base__slice_u8 v_left = {0};
+  wuffs_base__slice_u8 v_up = {0};
+  wuffs_base__slice_u8 v_upleft = {0};
+  uint64_t v_d = 0;
+  uint8_t v_x = 0;
+  uint64_t v_cost = 0;
+  __m128i v_x128 = {0};
+  __m128i v_a128 = {0};
+  __m128i v_b128 = {0};
+  __m128i v_c128 = {0};
+  __m128i v_p128 = {0};
+  __m128i v_pa128 = {0};
+  __m128i v_pb128 = {0};
+  __m128i v_pc128 = {0};
+  __m128i v_smallest128 = {0};
+  __m128i v_cost128 = {0};
+  __m128i v_z128 = {0};
+
+  v_cost = wuffs_png__encoder__encode_filter_head(self,
+      a_dst,
+      a_curr,
+      a_prev,
+      0);
+  v_d = ((uint64_t)(self->private_impl.f_filter_distance));
+  if ((v_d <= ((uint64_t)(a_dst.len))) && (v_d <= ((uint64_t)(a_curr.len))) && (v_d <= ((uint64_t)(a_prev.len)))) {
+    {
+      wuffs_base__slice_u8 i_slice_dst = wuffs_base__slice_u8__subslice_i(a_dst, v_d);
+      v_dst.ptr = i_slice_dst.ptr;
+      wuffs_base__slice_u8 i_slice_curr = wuffs_base__slice_u8__subslice_i(a_curr, v_d);
+      v_curr.ptr = i_slice_curr.ptr;
+      i_slice_dst.len = ((size_t)(wuffs_base__u64__min(i_slice_dst.len, i_slice_curr.len)));
+      wuffs_base__slice_u8 i_slice_left = a_curr;
+      v_left.ptr = i_slice_left.ptr;
+      i_slice_dst.len = ((size_t)(wuffs_base__u64__min(i_slice_dst.len, i_slice_left.len)));
+      wuffs_base__slice_u8 i_slice_up = wuffs_base__slice_u8__subslice_i(a_prev, v_d);
+      v_up.ptr = i_slice_up.ptr;
+      i_slice_dst.len = ((size_t)(wuffs_base__u64__min(i_slice_dst.len, i_slice_up.len)));
+      wuffs_base__slice_u8 i_slice_upleft = a_prev;
+      v_upleft.ptr = i_slice_upleft.ptr;
+      i_slice_dst.len = ((size_t)(wuffs_base__u64__min(i_slice_dst.len, i_slice_upleft.len)));
+      v_dst.len = 8;
+      v_curr.len = 8;
+      v_left.len = 8;
+      v_up.len = 8;
+      v_upleft.len = 8;
+      uint8_t* i_end0_dst = v_dst.ptr + (((i_slice_dst.len - (size_t)(v_dst.ptr - i_slice_dst.ptr)) / 8) * 8);
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_dst.ptr < i_end0_dst) {
+        v_a128 = _mm_unpacklo_epi8(_mm_cvtsi64x_si128((int64_t)(wuffs_base__peek_u64le__no_bounds_check(v_left.ptr))), v_z128);
+        v_b128 = _mm_unpacklo_epi8(_mm_cvtsi64x_si128((int64_t)(wuffs_base__peek_u64le__no_bounds_check(v_up.ptr))), v_z128);
+        v_c128 = _mm_unpacklo_epi8(_mm_cvtsi64x_si128((int64_t)(wuffs_base__peek_u64le__no_bounds_check(v_upleft.ptr))), v_z128);
+        v_pa128 = _mm_sub_epi16(v_b128, v_c128);
+        v_pb128 = _mm_sub_epi16(v_a128, v_c128);
+        v_pc128 = _mm_add_epi16(v_pa128, v_pb128);
+        v_pa128 = _mm_abs_epi16(v_pa128);
+        v_pb128 = _mm_abs_epi16(v_pb128);
+        v_pc128 = _mm_abs_epi16(v_pc128);
+        v_smallest128 = _mm_min_epi16(v_pc128, _mm_min_epi16(v_pb128, v_pa128));
+        v_p128 = _mm_blendv_epi8(_mm_blendv_epi8(v_c128, v_b128, _mm_cmpeq_epi16(v_smallest128, v_pb128)), v_a128, _mm_cmpeq_epi16(v_smallest128, v_pa128));
+        v_p128 = _mm_packus_epi16(v_p128, v_z128);
+        v_x128 = _mm_cvtsi64x_si128((int64_t)(wuffs_base__peek_u64le__no_bounds_check(v_curr.ptr)));
+        v_x128 = _mm_sub_epi8(v_x128, v_p128);
+        _mm_storeu_si64((void*)(v_dst.ptr), v_x128);
+        v_cost128 = _mm_add_epi64(v_cost128, _mm_sad_epu8(_mm_min_epu8(v_x128, _mm_sub_epi8(v_z128, v_x128)), v_z128));
+        v_dst.ptr += 8;
+        v_curr.ptr += 8;
+        v_left.ptr += 8;
+        v_up.ptr += 8;
+        v_upleft.ptr += 8;
+      }
+      v_dst.len = 1;
+      v_curr.len = 1;
+      v_left.len = 1;
+      v_up.len = 1;
+      v_upleft.len = 1;
+      uint8_t* i_end1_dst = i_slice_dst.ptr + i_slice_dst.len;
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_dst.ptr < i_end1_dst) {
+        v_x = ((uint8_t)(v_curr.ptr[0] - wuffs_png__encoder__paeth(self, v_left.ptr[0], v_up.ptr[0], v_upleft.ptr[0])));
+        v_dst.ptr[0] = v_x;
+        v_cost += wuffs_png__encoder__byte_cost(self, v_x);
+        v_dst.ptr += 1;
+        v_curr.ptr += 1;
+        v_left.ptr += 1;
+        v_up.ptr += 1;
+        v_upleft.ptr += 1;
+      }
+      v_dst.len = 0;
+      v_curr.len = 0;
+      v_left.len = 0;
+      v_up.len = 0;
+      v_upleft.len = 0;
+    }
+  }
+  self->private_impl.f_filter_cost = ((uint64_t)(((uint64_t)(v_cost + ((uint64_t)(_mm_extract_epi64(v_cost128, (int32_t)(0)))))) + ((uint64_t)(_mm_extract_epi64(v_cost128, (int32_t)(1))))));
+  return wuffs_base__make_empty_struct();
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// ‼ WUFFS MULTI-FILE SECTION -x86_sse42
+
+// -------- func png.encoder.set_level
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_png__encoder__set_level(
+    wuffs_png__encoder* self,
+    uint32_t a_level) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (a_level > 9) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_level = a_level;
+  self->private_impl.f_has_level = true;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func png.encoder.set_filter
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_png__encoder__set_filter(
+    wuffs_png__encoder* self,
+    uint32_t a_filter) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (a_filter > 5) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_filter = a_filter;
+  self->private_impl.f_has_filter = true;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func png.encoder.set_row_band
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_png__encoder__set_row_band(
+    wuffs_png__encoder* self,
+    uint32_t a_min_incl_y,
+    uint32_t a_max_excl_y) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  if (a_min_incl_y < a_max_excl_y) {
+    self->private_impl.f_band_min_incl_y = a_min_incl_y;
+    self->private_impl.f_band_max_excl_y = a_max_excl_y;
+  } else {
+    self->private_impl.f_band_min_incl_y = 0;
+    self->private_impl.f_band_max_excl_y = 0;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func png.encoder.row_band_checksum
+
+WUFFS_BASE__MAYBE_STATIC uint32_t
+wuffs_png__encoder__row_band_checksum(
+    const wuffs_png__encoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_band_checksum;
+}
+
+// -------- func png.encoder.row_band_length
+
+WUFFS_BASE__MAYBE_STATIC uint64_t
+wuffs_png__encoder__row_band_length(
+    const wuffs_png__encoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_band_length;
+}
+
+// -------- func png.encoder.set_workbuf_prefilled
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_png__encoder__set_workbuf_prefilled(
+    wuffs_png__encoder* self,
+    bool a_prefilled) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_workbuf_prefilled = a_prefilled;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func png.encoder.workbuf_len
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64
+wuffs_png__encoder__workbuf_len(
+    const wuffs_png__encoder* self,
+    wuffs_base__pixel_format a_src_pixfmt,
+    uint32_t a_width) {
+  if (!self) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+
+  uint64_t v_n = 0;
+  uint64_t v_n_slots = 0;
+
+  if ( ! self->private_impl.f_workbuf_prefilled && (a_width > 0) && (a_width <= 2147483647)) {
+    v_n = (((uint64_t)(a_width)) * ((uint64_t)(wuffs_png__encoder__bytes_per_pixel(self, a_src_pixfmt))));
+    v_n_slots = 1;
+    if (( ! self->private_impl.f_has_filter || (self->private_impl.f_filter == 5)) &&  ! wuffs_base__pixel_format__is_indexed(&a_src_pixfmt)) {
+      v_n_slots = 5;
+    }
+    return wuffs_base__utility__make_range_ii_u64(((2 * v_n) + (v_n_slots * (v_n + 1))), ((2 * v_n) + (v_n_slots * (v_n + 1))));
+  }
+  return wuffs_base__utility__make_range_ii_u64(0, 0);
+}
+
+// -------- func png.encoder.bytes_per_pixel
+
+static uint32_t
+wuffs_png__encoder__bytes_per_pixel(
+    const wuffs_png__encoder* self,
+    wuffs_base__pixel_format a_pixfmt) {
+  if (wuffs_base__pixel_format__is_indexed(&a_pixfmt) || (wuffs_base__pixel_format__bits_per_pixel(&a_pixfmt) == 8)) {
+    return 1;
+  } else if (wuffs_base__pixel_format__transparency(&a_pixfmt) == 0) {
+    return 3;
+  }
+  return 4;
+}
+
+// -------- func png.encoder.encode_image
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_png__encoder__encode_image(
+    wuffs_png__encoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__pixel_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+        ? wuffs_base__error__disabled_by_previous_error
+        : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst || !a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 1)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+
+  uint32_t coro_susp_point = self->private_impl.p_encode_image[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    v_status = wuffs_png__encoder__prepare(self, a_src, a_workbuf);
+    if ( ! wuffs_base__status__is_ok(&v_status)) {
+      status = v_status;
+      if (wuffs_base__status__is_error(&status)) {
+        goto exit;
+      } else if (wuffs_base__status__is_suspension(&status)) {
+        status = wuffs_base__make_status(wuffs_base__error__cannot_return_a_suspension);
+        goto exit;
+      }
+      goto ok;
+    }
+    if (self->private_impl.f_band_max_excl_y > 0) {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      status = wuffs_png__encoder__encode_idat(self, a_dst, a_src, a_workbuf);
+      if (status.repr) {
+        goto suspend;
+      }
+      status = wuffs_base__make_status(NULL);
+      goto ok;
+    }
+    self->private_impl.f_obuf_ri = 0;
+    self->private_impl.f_obuf_wi = 0;
+    wuffs_png__encoder__put_header(self, a_src);
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+    status = wuffs_png__encoder__write_obuf(self, a_dst);
+    if (status.repr) {
+      goto suspend;
+    }
+    if (self->private_impl.f_workbuf_prefilled) {
+      self->private_impl.f_filtered_ri = 0;
+      self->private_impl.f_obuf_wi = 8;
+      while (self->private_impl.f_filtered_ri < ((uint64_t)(a_workbuf.len))) {
+        wuffs_png__encoder__fill_idat_from_workbuf(self, a_workbuf);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+        status = wuffs_png__encoder__emit_idat(self, a_dst);
+        if (status.repr) {
+          goto suspend;
+        }
+      }
+    } else {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+      status = wuffs_png__encoder__encode_idat(self, a_dst, a_src, a_workbuf);
+      if (status.repr) {
+        goto suspend;
+      }
+    }
+    self->private_impl.f_obuf_ri = 0;
+    self->private_impl.f_obuf_wi = 0;
+    wuffs_png__encoder__begin_chunk(self, 1229278788);
+    wuffs_png__encoder__end_chunk(self);
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+    status = wuffs_png__encoder__write_obuf(self, a_dst);
+    if (status.repr) {
+      goto suspend;
+    }
+
+    ok:
+    self->private_impl.p_encode_image[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_encode_image[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine = wuffs_base__status__is_suspension(&status) ? 1 : 0;
+  WUFFS_BASE__STATS__ADD(self->private_impl, WUFFS_BASE__STATS__SUSPENSIONS,
+      wuffs_base__status__is_suspension(&status) ? 1u : 0u);
+
+  goto exit;
+  exit:
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func png.encoder.prepare
+
+static wuffs_base__status
+wuffs_png__encoder__prepare(
+    wuffs_png__encoder* self,
+    wuffs_base__pixel_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf) {
+  wuffs_base__pixel_format v_pixfmt = {0};
+  uint32_t v_bpp = 0;
+  uint64_t v_bytes = 0;
+  wuffs_base__table_u8 v_tab = {0};
+  uint64_t v_width = 0;
+  uint64_t v_height = 0;
+  uint32_t v_dst_pixfmt = 0;
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  wuffs_base__range_ii_u64 v_wb_len = {0};
+
+  v_pixfmt = wuffs_base__pixel_buffer__pixel_format(a_src);
+  v_bpp = wuffs_base__pixel_format__bits_per_pixel(&v_pixfmt);
+  v_bytes = ((uint64_t)((v_bpp >> 3)));
+  if ((v_bytes <= 0) || ((v_bpp & 7) != 0)) {
+    return wuffs_base__make_status(wuffs_base__error__unsupported_pixel_swizzler_option);
+  }
+  v_tab = wuffs_base__pixel_buffer__plane(a_src, 0);
+  v_width = (((uint64_t)(v_tab.width)) / v_bytes);
+  v_height = ((uint64_t)(v_tab.height));
+  if ((v_width <= 0) ||
+      (v_width > 2147483647) ||
+      (v_height <= 0) ||
+      (v_height > 2147483647)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  self->private_impl.f_width = ((uint32_t)(v_width));
+  self->private_impl.f_height = ((uint32_t)(v_height));
+  if (self->private_impl.f_band_max_excl_y > self->private_impl.f_height) {
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  self->private_impl.f_filter_distance = wuffs_png__encoder__bytes_per_pixel(self, v_pixfmt);
+  self->private_impl.f_row_length = (v_width * ((uint64_t)(self->private_impl.f_filter_distance)));
+  if (wuffs_base__pixel_format__is_indexed(&v_pixfmt)) {
+    if ((v_bpp != 8) || (((uint64_t)(wuffs_base__pixel_buffer__palette(a_src).len)) < 1024)) {
+      return wuffs_base__make_status(wuffs_base__error__unsupported_pixel_swizzler_option);
+    }
+    self->private_impl.f_color_type = 3;
+  } else {
+    if (self->private_impl.f_filter_distance == 1) {
+      self->private_impl.f_color_type = 0;
+      v_dst_pixfmt = 536870920;
+    } else if (self->private_impl.f_filter_distance == 3) {
+      self->private_impl.f_color_type = 2;
+      v_dst_pixfmt = 2684356744;
+    } else {
+      self->private_impl.f_color_type = 6;
+      v_dst_pixfmt = 2701166728;
+    }
+    v_status = wuffs_base__pixel_swizzler__prepare(&self->private_impl.f_swizzler,
+        wuffs_base__utility__make_pixel_format(v_dst_pixfmt),
+        wuffs_base__utility__empty_slice_u8(),
+        v_pixfmt,
+        wuffs_base__pixel_buffer__palette(a_src),
+        wuffs_base__utility__make_pixel_blend(0));
+    if ( ! wuffs_base__status__is_ok(&v_status)) {
+      return wuffs_base__status__ensure_not_a_suspension(v_status);
+    }
+  }
+  self->private_impl.f_n_filter_slots = 1;
+  if (( ! self->private_impl.f_has_filter || (self->private_impl.f_filter == 5)) && (self->private_impl.f_color_type != 3)) {
+    self->private_impl.f_n_filter_slots = 5;
+  }
+  if ( ! self->private_impl.f_workbuf_prefilled) {
+    v_wb_len = wuffs_png__encoder__workbuf_len(self, v_pixfmt, self->private_impl.f_width);
+    if (((uint64_t)(a_workbuf.len)) < wuffs_base__range_ii_u64__get_min_incl(&v_wb_len)) {
+      return wuffs_base__make_status(wuffs_base__error__bad_workbuf_length);
+    }
+  }
+  self->private_impl.choosy_encode_filter_0 = (
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+      wuffs_base__cpu_arch__have_x86_sse42() ? &wuffs_png__encoder__encode_filter_0_x86_sse42 :
+#endif
+      self->private_impl.choosy_encode_filter_0);
+  self->private_impl.choosy_encode_filter_1 = (
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+      wuffs_base__cpu_arch__have_x86_sse42() ? &wuffs_png__encoder__encode_filter_1_x86_sse42 :
+#endif
+      self->private_impl.choosy_encode_filter_1);
+  self->private_impl.choosy_encode_filter_2 = (
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+      wuffs_base__cpu_arch__have_x86_sse42() ? &wuffs_png__encoder__encode_filter_2_x86_sse42 :
+#endif
+      self->private_impl.choosy_encode_filter_2);
+  self->private_impl.choosy_encode_filter_3 = (
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+      wuffs_base__cpu_arch__have_x86_sse42() ? &wuffs_png__encoder__encode_filter_3_x86_sse42 :
+#endif
+      self->private_impl.choosy_encode_filter_3);
+  self->private_impl.choosy_encode_filter_4 = (
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+      wuffs_base__cpu_arch__have_x86_sse42() ? &wuffs_png__encoder__encode_filter_4_x86_sse42 :
+#endif
+      self->private_impl.choosy_encode_filter_4);
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func png.encoder.put_header
+
+static wuffs_base__empty_struct
+wuffs_png__encoder__put_header(
+    wuffs_png__encoder* self,
+    wuffs_base__pixel_buffer* a_src) {
+  wuffs_base__slice_u8 v_palette = {0};
+  wuffs_base__slice_u8 v_p = {0};
+  uint32_t v_i = 0;
+  uint32_t v_n = 0;
+
+  wuffs_png__encoder__put_u32be(self, 2303741511);
+  wuffs_png__encoder__put_u32be(self, 218765834);
+  wuffs_png__encoder__begin_chunk(self, 1229472850);
+  wuffs_png__encoder__put_u32be(self, self->private_impl.f_width);
+  wuffs_png__encoder__put_u32be(self, self->private_impl.f_height);
+  wuffs_png__encoder__put_u8(self, 8);
+  wuffs_png__encoder__put_u8(self, self->private_impl.f_color_type);
+  wuffs_png__encoder__put_u8(self, 0);
+  wuffs_png__encoder__put_u8(self, 0);
+  wuffs_png__encoder__put_u8(self, 0);
+  wuffs_png__encoder__end_chunk(self);
+  if (self->private_impl.f_color_type != 3) {
+    return wuffs_base__make_empty_struct();
+  }
+  v_palette = wuffs_base__pixel_buffer__palette(a_src);
+  if (((uint64_t)(v_palette.len)) < 1024) {
+    return wuffs_base__make_empty_struct();
+  }
+  v_palette = wuffs_base__slice_u8__subslice_j(v_palette, 1024);
+  wuffs_png__encoder__begin_chunk(self, 1347179589);
+  {
+    wuffs_base__slice_u8 i_slice_p = v_palette;
+    v_p.ptr = i_slice_p.ptr;
+    v_p.len = 4;
+    uint8_t* i_end0_p = v_p.ptr + (((i_slice_p.len - (size_t)(v_p.ptr - i_slice_p.ptr)) / 4) * 4);
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_p.ptr < i_end0_p) {
+      wuffs_png__encoder__put_u8(self, v_p.ptr[2]);
+      wuffs_png__encoder__put_u8(self, v_p.ptr[1]);
+      wuffs_png__encoder__put_u8(self, v_p.ptr[0]);
+      v_i += 1;
+      if (v_p.ptr[3] != 255) {
+        v_n = v_i;
+      }
+      v_p.ptr += 4;
+    }
+    v_p.len = 0;
+  }
+  wuffs_png__encoder__end_chunk(self);
+  if ((v_n > 0) && ((((uint64_t)(v_n)) * 4) <= ((uint64_t)(v_palette.len)))) {
+    wuffs_png__encoder__begin_chunk(self, 1951551059);
+    {
+      wuffs_base__slice_u8 i_slice_p = wuffs_base__slice_u8__subslice_j(v_palette, (((uint64_t)(v_n)) * 4));
+      v_p.ptr = i_slice_p.ptr;
+      v_p.len = 4;
+      uint8_t* i_end0_p = v_p.ptr + (((i_slice_p.len - (size_t)(v_p.ptr - i_slice_p.ptr)) / 4) * 4);
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_p.ptr < i_end0_p) {
+        wuffs_png__encoder__put_u8(self, v_p.ptr[3]);
+        v_p.ptr += 4;
+      }
+      v_p.len = 0;
+    }
+    wuffs_png__encoder__end_chunk(self);
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func png.encoder.encode_idat
+
+static wuffs_base__status
+wuffs_png__encoder__encode_idat(
+    wuffs_png__encoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__pixel_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  wuffs_base__io_buffer u_r = wuffs_base__empty_io_buffer();
+  wuffs_base__io_buffer* v_r = &u_r;
+  const uint8_t* iop_v_r WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io0_v_r WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_v_r WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_v_r WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  wuffs_base__io_buffer u_w = wuffs_base__empty_io_buffer();
+  wuffs_base__io_buffer* v_w = &u_w;
+  uint8_t* iop_v_w WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io0_v_w WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_v_w WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_v_w WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint64_t v_r_mark = 0;
+  uint64_t v_w_mark = 0;
+  wuffs_base__status v_deflate_status = wuffs_base__make_status(NULL);
+  uint32_t v_y_end = 0;
+  uint32_t v_t = 0;
+
+  uint32_t coro_susp_point = self->private_impl.p_encode_idat[0];
+  if (coro_susp_point) {
+    v_deflate_status = self->private_data.s_encode_idat[0].v_deflate_status;
+    v_y_end = self->private_data.s_encode_idat[0].v_y_end;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_deflate_is_dirty) {
+      wuffs_base__ignore_status(wuffs_deflate__encoder__initialize(&self->private_data.f_deflate,
+          sizeof (wuffs_deflate__encoder), WUFFS_VERSION, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    }
+    self->private_impl.f_deflate_is_dirty = true;
+    if (self->private_impl.f_has_level) {
+      wuffs_deflate__encoder__set_level(&self->private_data.f_deflate, self->private_impl.f_level);
+    }
+    wuffs_base__ignore_status(wuffs_adler32__hasher__initialize(&self->private_data.f_adler32,
+        sizeof (wuffs_adler32__hasher), WUFFS_VERSION, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    self->private_impl.f_band_checksum = 1;
+    self->private_impl.f_band_length = 0;
+    self->private_impl.f_y = 0;
+    v_y_end = self->private_impl.f_height;
+    self->private_impl.f_obuf_ri = 0;
+    self->private_impl.f_obuf_wi = 8;
+    if (self->private_impl.f_band_max_excl_y > 0) {
+      self->private_impl.f_y = self->private_impl.f_band_min_incl_y;
+      v_y_end = self->private_impl.f_band_max_excl_y;
+    } else {
+      wuffs_png__encoder__put_u8(self, 120);
+      if (self->private_impl.f_has_level) {
+        wuffs_png__encoder__put_u8(self, WUFFS_PNG__ZLIB_FLGS[self->private_impl.f_level]);
+      } else {
+        wuffs_png__encoder__put_u8(self, WUFFS_PNG__ZLIB_FLGS[6]);
+      }
+    }
+    while (self->private_impl.f_y < v_y_end) {
+      wuffs_png__encoder__filter_row(self, a_src, a_workbuf);
+      if (((uint32_t)(self->private_impl.f_y + 1)) < v_y_end) {
+        wuffs_deflate__encoder__set_flush_mode(&self->private_data.f_deflate, 0);
+      } else if (v_y_end < self->private_impl.f_height) {
+        wuffs_deflate__encoder__set_flush_mode(&self->private_data.f_deflate, 1);
+      } else {
+        wuffs_deflate__encoder__set_flush_mode(&self->private_data.f_deflate, 2);
+      }
+      label__0__continue:;
+      while (true) {
+        if ((self->private_impl.f_filtered_ri > self->private_impl.f_filtered_wi) || (self->private_impl.f_filtered_wi > ((uint64_t)(a_workbuf.len))) || (self->private_impl.f_obuf_wi > 32776)) {
+          status = wuffs_base__make_status(wuffs_png__error__internal_error_inconsistent_workbuf_length);
+          goto exit;
+        }
+        {
+          wuffs_base__io_buffer* o_0_v_r = v_r;
+          const uint8_t *o_0_iop_v_r = iop_v_r;
+          const uint8_t *o_0_io0_v_r = io0_v_r;
+          const uint8_t *o_0_io1_v_r = io1_v_r;
+          const uint8_t *o_0_io2_v_r = io2_v_r;
+          v_r = wuffs_base__io_reader__set(
+              &u_r,
+              &iop_v_r,
+              &io0_v_r,
+              &io1_v_r,
+              &io2_v_r,
+              wuffs_base__slice_u8__subslice_ij(a_workbuf,
+              self->private_impl.f_filtered_ri,
+              self->private_impl.f_filtered_wi),
+              0);
+          {
+            wuffs_base__io_buffer* o_1_v_w = v_w;
+            uint8_t *o_1_iop_v_w = iop_v_w;
+            uint8_t *o_1_io0_v_w = io0_v_w;
+            uint8_t *o_1_io1_v_w = io1_v_w;
+            uint8_t *o_1_io2_v_w = io2_v_w;
+            v_w = wuffs_base__io_writer__set(
+                &u_w,
+                &iop_v_w,
+                &io0_v_w,
+                &io1_v_w,
+                &io2_v_w,
+                wuffs_base__slice_u8__subslice_i(wuffs_base__make_slice_u8(self->private_data.f_obuf, 32776), self->private_impl.f_obuf_wi),
+                0);
+            v_r_mark = ((uint64_t)(iop_v_r - io0_v_r));
+            v_w_mark = ((uint64_t)(iop_v_w - io0_v_w));
+            {
+              u_w.meta.wi = ((size_t)(iop_v_w - u_w.data.ptr));
+              u_r.meta.ri = ((size_t)(iop_v_r - u_r.data.ptr));
+              wuffs_base__status t_0 = wuffs_deflate__encoder__transform_io(&self->private_data.f_deflate, v_w, v_r, wuffs_base__utility__empty_slice_u8());
+              v_deflate_status = t_0;
+              iop_v_w = u_w.data.ptr + u_w.meta.wi;
+              iop_v_r = u_r.data.ptr + u_r.meta.ri;
+            }
+            wuffs_base__u64__sat_add_indirect(&self->private_impl.f_filtered_ri, wuffs_base__io__count_since(v_r_mark, ((uint64_t)(iop_v_r - io0_v_r))));
+            v_t = wuffs_base__u32__sat_add(self->private_impl.f_obuf_wi, ((uint32_t)((wuffs_base__io__count_since(v_w_mark, ((uint64_t)(iop_v_w - io0_v_w))) & 65535))));
+            self->private_impl.f_obuf_wi = wuffs_base__u32__min(v_t, 32776);
+            v_w = o_1_v_w;
+            iop_v_w = o_1_iop_v_w;
+            io0_v_w = o_1_io0_v_w;
+            io1_v_w = o_1_io1_v_w;
+            io2_v_w = o_1_io2_v_w;
+          }
+          v_r = o_0_v_r;
+          iop_v_r = o_0_iop_v_r;
+          io0_v_r = o_0_io0_v_r;
+          io1_v_r = o_0_io1_v_r;
+          io2_v_r = o_0_io2_v_r;
+        }
+        if (wuffs_base__status__is_ok(&v_deflate_status) || (v_deflate_status.repr == wuffs_base__suspension__short_read)) {
+          goto label__0__break;
+        } else if (v_deflate_status.repr == wuffs_base__suspension__short_write) {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+          status = wuffs_png__encoder__emit_idat(self, a_dst);
+          if (status.repr) {
+            goto suspend;
+          }
+          goto label__0__continue;
+        }
+        status = v_deflate_status;
+        if (wuffs_base__status__is_error(&status)) {
+          goto exit;
+        } else if (wuffs_base__status__is_suspension(&status)) {
+          status = wuffs_base__make_status(wuffs_base__error__cannot_return_a_suspension);
+          goto exit;
+        }
+        goto ok;
+      }
+      label__0__break:;
+      self->private_impl.f_y += 1;
+    }
+    self->private_impl.f_deflate_is_dirty = false;
+    if (self->private_impl.f_band_max_excl_y <= 0) {
+      if (self->private_impl.f_obuf_wi > 32772) {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        status = wuffs_png__encoder__emit_idat(self, a_dst);
+        if (status.repr) {
+          goto suspend;
+        }
+      }
+      wuffs_png__encoder__put_u32be(self, self->private_impl.f_band_checksum);
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+    status = wuffs_png__encoder__emit_idat(self, a_dst);
+    if (status.repr) {
+      goto suspend;
+    }
+
+    ok:
+    self->private_impl.p_encode_idat[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_encode_idat[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_encode_idat[0].v_deflate_status = v_deflate_status;
+  self->private_data.s_encode_idat[0].v_y_end = v_y_end;
+
+  goto exit;
+  exit:
+  return status;
+}
+
+// -------- func png.encoder.filter_row
+
+static wuffs_base__empty_struct
+wuffs_png__encoder__filter_row(
+    wuffs_png__encoder* self,
+    wuffs_base__pixel_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf) {
+  uint64_t v_n = 0;
+  uint64_t v_slot_len = 0;
+  wuffs_base__slice_u8 v_row0 = {0};
+  wuffs_base__slice_u8 v_row1 = {0};
+  wuffs_base__slice_u8 v_curr = {0};
+  wuffs_base__slice_u8 v_prev = {0};
+  wuffs_base__slice_u8 v_slots = {0};
+  wuffs_base__slice_u8 v_dst = {0};
+  wuffs_base__table_u8 v_tab = {0};
+  uint32_t v_k = 0;
+  uint32_t v_best_k = 0;
+  uint64_t v_best = 0;
+  uint64_t v_offset = 0;
+
+  self->private_impl.f_filtered_ri = 0;
+  self->private_impl.f_filtered_wi = 0;
+  v_n = self->private_impl.f_row_length;
+  v_slot_len = (v_n + 1);
+  if (v_n > ((uint64_t)(a_workbuf.len))) {
+    return wuffs_base__make_empty_struct();
+  }
+  v_row0 = wuffs_base__slice_u8__subslice_j(a_workbuf, v_n);
+  v_slots = wuffs_base__slice_u8__subslice_i(a_workbuf, v_n);
+  if (v_n > ((uint64_t)(v_slots.len))) {
+    return wuffs_base__make_empty_struct();
+  }
+  v_row1 = wuffs_base__slice_u8__subslice_j(v_slots, v_n);
+  v_slots = wuffs_base__slice_u8__subslice_i(v_slots, v_n);
+  if ((self->private_impl.f_y & 1) == 0) {
+    v_curr = v_row0;
+    v_prev = v_row1;
+  } else {
+    v_curr = v_row1;
+    v_prev = v_row0;
+  }
+  v_tab = wuffs_base__pixel_buffer__plane(a_src, 0);
+  if (self->private_impl.f_y == 0) {
+    wuffs_png__encoder__zero_fill(self, v_prev);
+  } else if (self->private_impl.f_y == self->private_impl.f_band_min_incl_y) {
+    wuffs_png__encoder__convert_row(self, v_prev, wuffs_base__table_u8__row_u32(v_tab, (self->private_impl.f_y - 1)));
+  }
+  wuffs_png__encoder__convert_row(self, v_curr, wuffs_base__table_u8__row_u32(v_tab, self->private_impl.f_y));
+  if (self->private_impl.f_n_filter_slots == 1) {
+    v_best_k = 0;
+    if (self->private_impl.f_has_filter && (self->private_impl.f_color_type != 3)) {
+      v_best_k = wuffs_base__u32__min(self->private_impl.f_filter, 4);
+    }
+    if (v_slot_len <= ((uint64_t)(v_slots.len))) {
+      wuffs_png__encoder__apply_filter(self,
+          v_best_k,
+          wuffs_base__slice_u8__subslice_j(v_slots, v_slot_len),
+          v_curr,
+          v_prev);
+    }
+    v_offset = 0;
+  } else {
+    v_best = 18446744073709551615u;
+    v_k = 0;
+    while (v_k < 5) {
+      v_offset = (((uint64_t)(v_k)) * v_slot_len);
+      if (v_offset > ((uint64_t)(v_slots.len))) {
+        goto label__0__break;
+      }
+      v_dst = wuffs_base__slice_u8__subslice_i(v_slots, v_offset);
+      if (v_slot_len > ((uint64_t)(v_dst.len))) {
+        goto label__0__break;
+      }
+      wuffs_png__encoder__apply_filter(self,
+          v_k,
+          wuffs_base__slice_u8__subslice_j(v_dst, v_slot_len),
+          v_curr,
+          v_prev);
+      if (v_best > self->private_impl.f_filter_cost) {
+        v_best = self->private_impl.f_filter_cost;
+        v_best_k = v_k;
+      }
+      v_k += 1;
+    }
+    label__0__break:;
+    v_offset = (((uint64_t)(wuffs_base__u32__min(v_best_k, 4))) * v_slot_len);
+  }
+  self->private_impl.f_filtered_ri = ((2 * v_n) + v_offset);
+  self->private_impl.f_filtered_wi = (self->private_impl.f_filtered_ri + v_slot_len);
+  if (self->private_impl.f_filtered_wi <= ((uint64_t)(a_workbuf.len))) {
+    if (self->private_impl.f_filtered_ri <= self->private_impl.f_filtered_wi) {
+      self->private_impl.f_band_checksum = wuffs_adler32__hasher__update_u32(&self->private_data.f_adler32, wuffs_base__slice_u8__subslice_ij(a_workbuf,
+          self->private_impl.f_filtered_ri,
+          self->private_impl.f_filtered_wi));
+    }
+  }
+  self->private_impl.f_band_length += v_slot_len;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func png.encoder.apply_filter
+
+static wuffs_base__empty_struct
+wuffs_png__encoder__apply_filter(
+    wuffs_png__encoder* self,
+    uint32_t a_k,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_curr,
+    wuffs_base__slice_u8 a_prev) {
+  if (((uint64_t)(a_dst.len)) <= 0) {
+    self->private_impl.f_filter_cost = 18446744073709551615u;
+    return wuffs_base__make_empty_struct();
+  }
+  a_dst.ptr[0] = ((uint8_t)((a_k & 255)));
+  if (a_k == 0) {
+    wuffs_png__encoder__encode_filter_0(self, wuffs_base__slice_u8__subslice_i(a_dst, 1), a_curr);
+  } else if (a_k == 1) {
+    wuffs_png__encoder__encode_filter_1(self, wuffs_base__slice_u8__subslice_i(a_dst, 1), a_curr);
+  } else if (a_k == 2) {
+    wuffs_png__encoder__encode_filter_2(self, wuffs_base__slice_u8__subslice_i(a_dst, 1), a_curr, a_prev);
+  } else if (a_k == 3) {
+    wuffs_png__encoder__encode_filter_3(self, wuffs_base__slice_u8__subslice_i(a_dst, 1), a_curr, a_prev);
+  } else {
+    wuffs_png__encoder__encode_filter_4(self, wuffs_base__slice_u8__subslice_i(a_dst, 1), a_curr, a_prev);
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func png.encoder.convert_row
+
+static wuffs_base__empty_struct
+wuffs_png__encoder__convert_row(
+    wuffs_png__encoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_src) {
+  if (self->private_impl.f_color_type == 3) {
+    wuffs_base__slice_u8__copy_from_slice(a_dst, a_src);
+  } else {
+    wuffs_base__pixel_swizzler__swizzle_interleaved_from_slice(&self->private_impl.f_swizzler, a_dst, wuffs_base__utility__empty_slice_u8(), a_src);
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func png.encoder.zero_fill
+
+static wuffs_base__empty_struct
+wuffs_png__encoder__zero_fill(
+    wuffs_png__encoder* self,
+    wuffs_base__slice_u8 a_s) {
+  wuffs_base__slice_u8 v_s = {0};
+
+  {
+    wuffs_base__slice_u8 i_slice_s = a_s;
+    v_s.ptr = i_slice_s.ptr;
+    v_s.len = 8;
+    uint8_t* i_end0_s = v_s.ptr + (((i_slice_s.len - (size_t)(v_s.ptr - i_slice_s.ptr)) / 8) * 8);
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_s.ptr < i_end0_s) {
+      wuffs_base__poke_u64le__no_bounds_check(v_s.ptr, 0);
+      v_s.ptr += 8;
+    }
+    v_s.len = 1;
+    uint8_t* i_end1_s = i_slice_s.ptr + i_slice_s.len;
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_s.ptr < i_end1_s) {
+      v_s.ptr[0] = 0;
+      v_s.ptr += 1;
+    }
+    v_s.len = 0;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func png.encoder.fill_idat_from_workbuf
+
+static wuffs_base__empty_struct
+wuffs_png__encoder__fill_idat_from_workbuf(
+    wuffs_png__encoder* self,
+    wuffs_base__slice_u8 a_workbuf) {
+  wuffs_base__slice_u8 v_s = {0};
+  uint64_t v_n = 0;
+  uint32_t v_t = 0;
+
+  if ((self->private_impl.f_filtered_ri > ((uint64_t)(a_workbuf.len))) || (self->private_impl.f_obuf_wi > 32776)) {
+    self->private_impl.f_filtered_ri = ((uint64_t)(a_workbuf.len));
+    return wuffs_base__make_empty_struct();
+  }
+  v_s = wuffs_base__slice_u8__subslice_i(a_workbuf, self->private_impl.f_filtered_ri);
+  v_n = wuffs_base__slice_u8__copy_from_slice(wuffs_base__slice_u8__subslice_i(wuffs_base__make_slice_u8(self->private_data.f_obuf, 32776), self->private_impl.f_obuf_wi), v_s);
+  wuffs_base__u64__sat_add_indirect(&self->private_impl.f_filtered_ri, v_n);
+  v_t = wuffs_base__u32__sat_add(self->private_impl.f_obuf_wi, ((uint32_t)((v_n & 65535))));
+  self->private_impl.f_obuf_wi = wuffs_base__u32__min(v_t, 32776);
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func png.encoder.emit_idat
+
+static wuffs_base__status
+wuffs_png__encoder__emit_idat(
+    wuffs_png__encoder* self,
+    wuffs_base__io_buffer* a_dst) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t coro_susp_point = self->private_impl.p_emit_idat[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_obuf_wi > 8) {
+      if (self->private_impl.f_band_max_excl_y > 0) {
+        self->private_impl.f_obuf_ri = 8;
+      } else {
+        self->private_impl.f_chunk_start = 0;
+        wuffs_base__poke_u32be__no_bounds_check(wuffs_base__make_slice_u8((self->private_data.f_obuf) + 4, 4).ptr, 1229209940);
+        wuffs_png__encoder__end_chunk(self);
+        self->private_impl.f_obuf_ri = 0;
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      status = wuffs_png__encoder__write_obuf(self, a_dst);
+      if (status.repr) {
+        goto suspend;
+      }
+    }
+    self->private_impl.f_obuf_ri = 0;
+    self->private_impl.f_obuf_wi = 8;
+
+    goto ok;
+    ok:
+    self->private_impl.p_emit_idat[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_emit_idat[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+  exit:
+  return status;
+}
+
+// -------- func png.encoder.write_obuf
+
+static wuffs_base__status
+wuffs_png__encoder__write_obuf(
+    wuffs_png__encoder* self,
+    wuffs_base__io_buffer* a_dst) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint64_t v_n = 0;
+  uint32_t v_t = 0;
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_write_obuf[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    while (self->private_impl.f_obuf_ri < self->private_impl.f_obuf_wi) {
+      v_n = wuffs_base__io_writer__copy_from_slice(&iop_a_dst, io2_a_dst,wuffs_base__slice_u8__subslice_ij(wuffs_base__make_slice_u8(self->private_data.f_obuf,
+          32780),
+          self->private_impl.f_obuf_ri,
+          self->private_impl.f_obuf_wi));
+      v_t = wuffs_base__u32__sat_add(self->private_impl.f_obuf_ri, ((uint32_t)((v_n & 65535))));
+      self->private_impl.f_obuf_ri = wuffs_base__u32__min(v_t, self->private_impl.f_obuf_wi);
+      if (self->private_impl.f_obuf_ri < self->private_impl.f_obuf_wi) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
+      }
+    }
+    self->private_impl.f_obuf_ri = 0;
+    self->private_impl.f_obuf_wi = 0;
+
+    ok:
+    self->private_impl.p_write_obuf[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_write_obuf[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+  exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func png.encoder.put_u8
+
+static wuffs_base__empty_struct
+wuffs_png__encoder__put_u8(
+    wuffs_png__encoder* self,
+    uint8_t a_a) {
+  if (self->private_impl.f_obuf_wi < 32780) {
+    self->private_data.f_obuf[self->private_impl.f_obuf_wi] = a_a;
+    self->private_impl.f_obuf_wi += 1;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func png.encoder.put_u32be
+
+static wuffs_base__empty_struct
+wuffs_png__encoder__put_u32be(
+    wuffs_png__encoder* self,
+    uint32_t a_a) {
+  wuffs_png__encoder__put_u8(self, ((uint8_t)(((a_a >> 24) & 255))));
+  wuffs_png__encoder__put_u8(self, ((uint8_t)(((a_a >> 16) & 255))));
+  wuffs_png__encoder__put_u8(self, ((uint8_t)(((a_a >> 8) & 255))));
+  wuffs_png__encoder__put_u8(self, ((uint8_t)(((a_a >> 0) & 255))));
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func png.encoder.begin_chunk
+
+static wuffs_base__empty_struct
+wuffs_png__encoder__begin_chunk(
+    wuffs_png__encoder* self,
+    uint32_t a_chunk_type) {
+  self->private_impl.f_chunk_start = self->private_impl.f_obuf_wi;
+  wuffs_png__encoder__put_u32be(self, 0);
+  wuffs_png__encoder__put_u32be(self, a_chunk_type);
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func png.encoder.end_chunk
+
+static wuffs_base__empty_struct
+wuffs_png__encoder__end_chunk(
+    wuffs_png__encoder* self) {
+  uint64_t v_start = 0;
+  wuffs_base__slice_u8 v_s = {0};
+  uint32_t v_crc = 0;
+
+  v_start = ((uint64_t)(self->private_impl.f_chunk_start));
+  v_s = wuffs_base__slice_u8__subslice_j(wuffs_base__make_slice_u8(self->private_data.f_obuf, 32780), self->private_impl.f_obuf_wi);
+  if (v_start > ((uint64_t)(v_s.len))) {
+    return wuffs_base__make_empty_struct();
+  }
+  v_s = wuffs_base__slice_u8__subslice_i(v_s, v_start);
+  if (((uint64_t)(v_s.len)) < 8) {
+    return wuffs_base__make_empty_struct();
+  }
+  wuffs_base__poke_u32be__no_bounds_check(wuffs_base__slice_u8__subslice_j(v_s, 4).ptr, ((uint32_t)((((uint64_t)(((uint64_t)(v_s.len)) - 8)) & 65535))));
+  wuffs_base__ignore_status(wuffs_crc32__ieee_hasher__initialize(&self->private_data.f_crc32,
+      sizeof (wuffs_crc32__ieee_hasher), WUFFS_VERSION, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  v_crc = wuffs_crc32__ieee_hasher__update_u32(&self->private_data.f_crc32, wuffs_base__slice_u8__subslice_i(v_s, 4));
+  wuffs_png__encoder__put_u32be(self, v_crc);
+  return wuffs_base__make_empty_struct();
+}
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__PNG)
+
+
+#endif  // WUFFS_IMPLEMENTATION
+
+// ¡ WUFFS MONOLITHIC RELEASE DISCARDS EVERYTHING BELOW.
+
+#endif  // WUFFS_INCLUDE_GUARD__PNG
@@ -0,0 +1,1957 @@
+#ifndef WUFFS_INCLUDE_GUARD__RAC
+#define WUFFS_INCLUDE_GUARD__RAC
+
+#if defined(WUFFS_IMPLEMENTATION) && !defined(WUFFS_CONFIG__MODULES)
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__RAC
+#endif
+
+#include "./wuffs-base.c"
+#include "./wuffs-std-crc32.c"
+#include "./wuffs-std-zlib.c"
+
+// ¡ WUFFS MONOLITHIC RELEASE DISCARDS EVERYTHING ABOVE.
+
+
+// ---------------- Status Codes
+
+extern const char wuffs_rac__error__bad_chunk[];
+extern const char wuffs_rac__error__bad_compressed_size[];
+extern const char wuffs_rac__error__bad_dictionary[];
+extern const char wuffs_rac__error__bad_header[];
+extern const char wuffs_rac__error__bad_index_node[];
+extern const char wuffs_rac__error__missing_root_node[];
+extern const char wuffs_rac__error__unsupported_rac_codec[];
+extern const char wuffs_rac__error__unsupported_rac_dictionary_length[];
+extern const char wuffs_rac__error__unsupported_rac_version[];
+
+// ---------------- Public Consts
+
+#define WUFFS_RAC__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE 65793
+
+// ---------------- Struct Declarations
+
+typedef struct wuffs_rac__decoder__struct wuffs_rac__decoder;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ---------------- Public Initializer Prototypes
+
+// For any given "wuffs_foo__bar* self", "wuffs_foo__bar__initialize(self,
+// etc)" should be called before any other "wuffs_foo__bar__xxx(self, etc)".
+//
+// Pass sizeof(*self) and WUFFS_VERSION for sizeof_star_self and wuffs_version.
+// Pass 0 (or some combination of WUFFS_INITIALIZE__XXX) for options.
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+wuffs_rac__decoder__initialize(
+    wuffs_rac__decoder* self,
+    size_t sizeof_star_self,
+    uint64_t wuffs_version,
+    uint32_t options);
+
+wuffs_base__stats
+wuffs_rac__decoder__stats(
+    const wuffs_rac__decoder* self);
+
+size_t
+sizeof__wuffs_rac__decoder();
+
+// ---------------- Allocs
+
+// These functions allocate and initialize Wuffs structs. They return NULL if
+// memory allocation fails. If they return non-NULL, there is no need to call
+// wuffs_foo__bar__initialize, but the caller is responsible for eventually
+// calling free on the returned pointer. That pointer is effectively a C++
+// std::unique_ptr<T, decltype(&free)>.
+
+wuffs_rac__decoder*
+wuffs_rac__decoder__alloc();
+
+static inline wuffs_base__io_transformer*
+wuffs_rac__decoder__alloc_as__wuffs_base__io_transformer() {
+  return (wuffs_base__io_transformer*)(wuffs_rac__decoder__alloc());
+}
+
+// ---------------- Upcasts
+
+static inline wuffs_base__io_transformer*
+wuffs_rac__decoder__upcast_as__wuffs_base__io_transformer(
+    wuffs_rac__decoder* p) {
+  return (wuffs_base__io_transformer*)p;
+}
+
+// ---------------- Public Function Prototypes
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_rac__decoder__set_quirk_enabled(
+    wuffs_rac__decoder* self,
+    uint32_t a_quirk,
+    bool a_enabled);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64
+wuffs_rac__decoder__workbuf_len(
+    const wuffs_rac__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_rac__decoder__set_compressed_size(
+    wuffs_rac__decoder* self,
+    uint64_t a_size);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_rac__decoder__set_drange(
+    wuffs_rac__decoder* self,
+    uint64_t a_min_incl,
+    uint64_t a_max_excl);
+
+WUFFS_BASE__MAYBE_STATIC uint64_t
+wuffs_rac__decoder__decompressed_size(
+    const wuffs_rac__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC uint64_t
+wuffs_rac__decoder__io_seek_position(
+    const wuffs_rac__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_rac__decoder__transform_io(
+    wuffs_rac__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+// ---------------- Struct Definitions
+
+// These structs' fields, and the sizeof them, are private implementation
+// details that aren't guaranteed to be stable across Wuffs versions.
+//
+// See https://en.wikipedia.org/wiki/Opaque_pointer#C
+
+#if defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
+
+struct wuffs_rac__decoder__struct {
+  // Do not access the private_impl's or private_data's fields directly. There
+  // is no API/ABI compatibility or safety guarantee if you do so. Instead, use
+  // the wuffs_foo__bar__baz functions.
+  //
+  // It is a struct, not a struct*, so that the outermost wuffs_foo__bar struct
+  // can be stack allocated when WUFFS_IMPLEMENTATION is defined.
+
+  struct {
+    uint32_t magic;
+    uint32_t active_coroutine;
+    wuffs_base__vtable vtable_for__wuffs_base__io_transformer;
+    wuffs_base__vtable null_vtable;
+#if defined(WUFFS_CONFIG__STATS)
+    wuffs_base__stats stats;
+#endif  // defined(WUFFS_CONFIG__STATS)
+
+    uint64_t f_cfile_size;
+    uint64_t f_dfile_size;
+    uint64_t f_drange_min_incl;
+    uint64_t f_drange_max_excl;
+    uint64_t f_dpos;
+    uint64_t f_io_seek_position_value;
+    uint64_t f_root_coffset;
+    uint32_t f_root_arity;
+    uint32_t f_curr_arity;
+    uint64_t f_curr_cbias;
+    uint64_t f_curr_dbias;
+    uint32_t f_next_element;
+    bool f_need_to_resolve;
+    uint64_t f_chunk_dmin_incl;
+    uint64_t f_chunk_dmax_excl;
+    uint64_t f_chunk_cprimary_min;
+    uint64_t f_chunk_cprimary_max;
+    uint64_t f_chunk_csecondary_min;
+    uint64_t f_chunk_csecondary_max;
+    uint32_t f_chunk_ttag;
+    uint32_t f_chunk_codec;
+    uint64_t f_chunk_written;
+    bool f_dict_loaded;
+    uint64_t f_dict_coffset;
+    uint32_t f_dict_length;
+
+    uint32_t p_transform_io[1];
+    uint32_t p_seek[1];
+    uint32_t p_load_node[1];
+    uint32_t p_find_root_node[1];
+    uint32_t p_try_root_node[1];
+    uint32_t p_next_chunk[1];
+    uint32_t p_resolve_dpos[1];
+    uint32_t p_decode_chunk[1];
+    uint32_t p_load_dictionary[1];
+  } private_impl;
+
+  struct {
+    wuffs_crc32__ieee_hasher f_crc32;
+    wuffs_zlib__decoder f_zlib;
+    uint8_t f_node[4096];
+    uint8_t f_dictionary[32768];
+
+    struct {
+      uint64_t v_dmax;
+    } s_transform_io[1];
+    struct {
+      uint64_t scratch;
+    } s_seek[1];
+    struct {
+      uint32_t v_size;
+      uint32_t v_i;
+    } s_load_node[1];
+    struct {
+      uint64_t scratch;
+      uint8_t v_c;
+    } s_find_root_node[1];
+    struct {
+      uint64_t v_coffset;
+    } s_try_root_node[1];
+    struct {
+      uint64_t v_cbias;
+      uint64_t v_dbias;
+      uint64_t v_coffset;
+      uint64_t v_parent_coffmax;
+      uint64_t v_parent_dptrmax;
+      uint64_t v_child_coffset;
+      uint64_t v_child_cbias;
+      uint64_t v_child_dbias;
+      uint64_t v_child_dsize;
+      uint32_t v_arity;
+      uint8_t v_parent_codec;
+      uint8_t v_parent_version;
+    } s_resolve_dpos[1];
+    struct {
+      uint64_t scratch;
+      uint64_t v_dend;
+      wuffs_base__status v_status;
+      uint64_t v_n_decoded;
+      uint64_t v_wb_ri;
+      uint64_t v_wb_wi;
+      uint64_t v_resume_cpos;
+    } s_decode_chunk[1];
+    struct {
+      uint64_t scratch;
+      uint32_t v_length;
+      uint32_t v_i;
+    } s_load_dictionary[1];
+  } private_data;
+
+#ifdef __cplusplus
+#if defined(WUFFS_BASE__HAVE_UNIQUE_PTR)
+  using unique_ptr = std::unique_ptr<wuffs_rac__decoder, decltype(&free)>;
+
+  // On failure, the alloc_etc functions return nullptr. They don't throw.
+
+  static inline unique_ptr
+  alloc() {
+    return unique_ptr(wuffs_rac__decoder__alloc(), &free);
+  }
+
+  static inline wuffs_base__io_transformer::unique_ptr
+  alloc_as__wuffs_base__io_transformer() {
+    return wuffs_base__io_transformer::unique_ptr(
+        wuffs_rac__decoder__alloc_as__wuffs_base__io_transformer(), &free);
+  }
+#endif  // defined(WUFFS_BASE__HAVE_UNIQUE_PTR)
+
+#if defined(WUFFS_BASE__HAVE_EQ_DELETE) && !defined(WUFFS_IMPLEMENTATION)
+  // Disallow constructing or copying an object via standard C++ mechanisms,
+  // e.g. the "new" operator, as this struct is intentionally opaque. Its total
+  // size and field layout is not part of the public, stable, memory-safe API.
+  // Use malloc or memcpy and the sizeof__wuffs_foo__bar function instead, and
+  // call wuffs_foo__bar__baz methods (which all take a "this"-like pointer as
+  // their first argument) rather than tweaking bar.private_impl.qux fields.
+  //
+  // In C, we can just leave wuffs_foo__bar as an incomplete type (unless
+  // WUFFS_IMPLEMENTATION is #define'd). In C++, we define a complete type in
+  // order to provide convenience methods. These forward on "this", so that you
+  // can write "bar->baz(etc)" instead of "wuffs_foo__bar__baz(bar, etc)".
+  wuffs_rac__decoder__struct() = delete;
+  wuffs_rac__decoder__struct(const wuffs_rac__decoder__struct&) = delete;
+  wuffs_rac__decoder__struct& operator=(
+      const wuffs_rac__decoder__struct&) = delete;
+#endif  // defined(WUFFS_BASE__HAVE_EQ_DELETE) && !defined(WUFFS_IMPLEMENTATION)
+
+#if !defined(WUFFS_IMPLEMENTATION)
+  // As above, the size of the struct is not part of the public API, and unless
+  // WUFFS_IMPLEMENTATION is #define'd, this struct type T should be heap
+  // allocated, not stack allocated. Its size is not intended to be known at
+  // compile time, but it is unfortunately divulged as a side effect of
+  // defining C++ convenience methods. Use "sizeof__T()", calling the function,
+  // instead of "sizeof T", invoking the operator. To make the two values
+  // different, so that passing the latter will be rejected by the initialize
+  // function, we add an arbitrary amount of dead weight.
+  uint8_t dead_weight[123000000];  // 123 MB.
+#endif  // !defined(WUFFS_IMPLEMENTATION)
+
+  inline wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+  initialize(
+      size_t sizeof_star_self,
+      uint64_t wuffs_version,
+      uint32_t options) {
+    return wuffs_rac__decoder__initialize(
+        this, sizeof_star_self, wuffs_version, options);
+  }
+
+  inline wuffs_base__stats
+  stats() const {
+    return wuffs_rac__decoder__stats(this);
+  }
+
+  inline wuffs_base__io_transformer*
+  upcast_as__wuffs_base__io_transformer() {
+    return (wuffs_base__io_transformer*)this;
+  }
+
+  inline wuffs_base__empty_struct
+  set_quirk_enabled(
+      uint32_t a_quirk,
+      bool a_enabled) {
+    return wuffs_rac__decoder__set_quirk_enabled(this, a_quirk, a_enabled);
+  }
+
+  inline wuffs_base__range_ii_u64
+  workbuf_len() const {
+    return wuffs_rac__decoder__workbuf_len(this);
+  }
+
+  inline wuffs_base__empty_struct
+  set_compressed_size(
+      uint64_t a_size) {
+    return wuffs_rac__decoder__set_compressed_size(this, a_size);
+  }
+
+  inline wuffs_base__empty_struct
+  set_drange(
+      uint64_t a_min_incl,
+      uint64_t a_max_excl) {
+    return wuffs_rac__decoder__set_drange(this, a_min_incl, a_max_excl);
+  }
+
+  inline uint64_t
+  decompressed_size() const {
+    return wuffs_rac__decoder__decompressed_size(this);
+  }
+
+  inline uint64_t
+  io_seek_position() const {
+    return wuffs_rac__decoder__io_seek_position(this);
+  }
+
+  inline wuffs_base__status
+  transform_io(
+      wuffs_base__io_buffer* a_dst,
+      wuffs_base__io_buffer* a_src,
+      wuffs_base__slice_u8 a_workbuf) {
+    return wuffs_rac__decoder__transform_io(this, a_dst, a_src, a_workbuf);
+  }
+
+#endif  // __cplusplus
+};  // struct wuffs_rac__decoder__struct
+
+#endif  // defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
+
+
+// ‼ WUFFS C HEADER ENDS HERE.
+#ifdef WUFFS_IMPLEMENTATION
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__RAC)
+
+// ---------------- Status Codes Implementations
+
+const char wuffs_rac__error__bad_chunk[] = "#rac: bad chunk";
+const char wuffs_rac__error__bad_compressed_size[] = "#rac: bad compressed size";
+const char wuffs_rac__error__bad_dictionary[] = "#rac: bad dictionary";
+const char wuffs_rac__error__bad_header[] = "#rac: bad header";
+const char wuffs_rac__error__bad_index_node[] = "#rac: bad index node";
+const char wuffs_rac__error__missing_root_node[] = "#rac: missing root node";
+const char wuffs_rac__error__unsupported_rac_codec[] = "#rac: unsupported RAC codec";
+const char wuffs_rac__error__unsupported_rac_dictionary_length[] = "#rac: unsupported RAC dictionary length";
+const char wuffs_rac__error__unsupported_rac_version[] = "#rac: unsupported RAC version";
+
+// ---------------- Private Consts
+
+#define WUFFS_RAC__WORKBUF_CHUNK_LENGTH 32768
+
+// ---------------- Private Initializer Prototypes
+
+// ---------------- Private Function Prototypes
+
+static wuffs_base__status
+wuffs_rac__decoder__seek(
+    wuffs_rac__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    uint64_t a_pos);
+
+static wuffs_base__status
+wuffs_rac__decoder__load_node(
+    wuffs_rac__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    uint64_t a_coffset,
+    uint32_t a_arity);
+
+static wuffs_base__status
+wuffs_rac__decoder__find_root_node(
+    wuffs_rac__decoder* self,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status
+wuffs_rac__decoder__try_root_node(
+    wuffs_rac__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    uint32_t a_arity,
+    bool a_from_end);
+
+static wuffs_base__status
+wuffs_rac__decoder__next_chunk(
+    wuffs_rac__decoder* self,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status
+wuffs_rac__decoder__resolve_dpos(
+    wuffs_rac__decoder* self,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status
+wuffs_rac__decoder__decode_chunk(
+    wuffs_rac__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf,
+    uint64_t a_dmax);
+
+static wuffs_base__status
+wuffs_rac__decoder__load_dictionary(
+    wuffs_rac__decoder* self,
+    wuffs_base__io_buffer* a_src);
+
+static bool
+wuffs_rac__decoder__node_is_valid(
+    wuffs_rac__decoder* self);
+
+static uint64_t
+wuffs_rac__decoder__dptr(
+    const wuffs_rac__decoder* self,
+    uint32_t a_i);
+
+static uint64_t
+wuffs_rac__decoder__cptr(
+    const wuffs_rac__decoder* self,
+    uint32_t a_i);
+
+static uint64_t
+wuffs_rac__decoder__crange_max(
+    const wuffs_rac__decoder* self,
+    uint32_t a_i);
+
+static uint64_t
+wuffs_rac__decoder__peek_u48le(
+    const wuffs_rac__decoder* self,
+    uint32_t a_offset);
+
+// ---------------- VTables
+
+const wuffs_base__io_transformer__func_ptrs
+wuffs_rac__decoder__func_ptrs_for__wuffs_base__io_transformer = {
+  (wuffs_base__empty_struct(*)(void*,
+      uint32_t,
+      bool))(&wuffs_rac__decoder__set_quirk_enabled),
+  (wuffs_base__status(*)(void*,
+      wuffs_base__io_buffer*,
+      wuffs_base__io_buffer*,
+      wuffs_base__slice_u8))(&wuffs_rac__decoder__transform_io),
+  (wuffs_base__range_ii_u64(*)(const void*))(&wuffs_rac__decoder__workbuf_len),
+};
+
+// ---------------- Initializer Implementations
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+wuffs_rac__decoder__initialize(
+    wuffs_rac__decoder* self,
+    size_t sizeof_star_self,
+    uint64_t wuffs_version,
+    uint32_t options){
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  }
+
+  if ((options & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+    // The whole point of this if-check is to detect an uninitialized *self.
+    // We disable the warning on GCC. Clang-5.0 does not have this warning.
+    //
+    // The caller promises that *self is zeroed, so the empty asm tells GCC
+    // that private_impl is defined. Otherwise, once this function and a
+    // small method (e.g. one that reads a "choose" guard field) are both
+    // inlined into the caller, GCC -O3 warns about that method's read.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    __asm__ __volatile__("" : "+m"(self->private_impl));
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((options & WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      options |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    }
+  }
+
+  {
+    wuffs_base__status z = wuffs_crc32__ieee_hasher__initialize(
+        &self->private_data.f_crc32, sizeof(self->private_data.f_crc32), WUFFS_VERSION, options);
+    if (z.repr) {
+      return z;
+    }
+  }
+  {
+    wuffs_base__status z = wuffs_zlib__decoder__initialize(
+        &self->private_data.f_zlib, sizeof(self->private_data.f_zlib), WUFFS_VERSION, options);
+    if (z.repr) {
+      return z;
+    }
+  }
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.vtable_name =
+      wuffs_base__io_transformer__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.function_pointers =
+      (const void*)(&wuffs_rac__decoder__func_ptrs_for__wuffs_base__io_transformer);
+  return wuffs_base__make_status(NULL);
+}
+
+wuffs_rac__decoder*
+wuffs_rac__decoder__alloc() {
+  wuffs_rac__decoder* x =
+      (wuffs_rac__decoder*)(calloc(sizeof(wuffs_rac__decoder), 1));
+  if (!x) {
+    return NULL;
+  }
+  if (wuffs_rac__decoder__initialize(
+      x, sizeof(wuffs_rac__decoder), WUFFS_VERSION, WUFFS_INITIALIZE__ALREADY_ZEROED).repr) {
+    free(x);
+    return NULL;
+  }
+  return x;
+}
+
+size_t
+sizeof__wuffs_rac__decoder() {
+  return sizeof(wuffs_rac__decoder);
+}
+
+wuffs_base__stats
+wuffs_rac__decoder__stats(
+    const wuffs_rac__decoder* self) {
+  wuffs_base__stats ret = wuffs_base__make_empty_stats();
+#if defined(WUFFS_CONFIG__STATS)
+  if (!self) {
+    return ret;
+  }
+  ret = self->private_impl.stats;
+  {
+    wuffs_base__stats z = wuffs_crc32__ieee_hasher__stats(&self->private_data.f_crc32);
+    wuffs_base__stats__accumulate(&ret, &z);
+  }
+  {
+    wuffs_base__stats z = wuffs_zlib__decoder__stats(&self->private_data.f_zlib);
+    wuffs_base__stats__accumulate(&ret, &z);
+  }
+#else
+  (void)(self);
+#endif  // defined(WUFFS_CONFIG__STATS)
+  return ret;
+}
+
+// ---------------- Function Implementations
+
+// -------- func rac.decoder.set_quirk_enabled
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_rac__decoder__set_quirk_enabled(
+    wuffs_rac__decoder* self,
+    uint32_t a_quirk,
+    bool a_enabled) {
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func rac.decoder.workbuf_len
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64
+wuffs_rac__decoder__workbuf_len(
+    const wuffs_rac__decoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+
+  return wuffs_base__utility__make_range_ii_u64(65793, 65793);
+}
+
+// -------- func rac.decoder.set_compressed_size
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_rac__decoder__set_compressed_size(
+    wuffs_rac__decoder* self,
+    uint64_t a_size) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_cfile_size = a_size;
+  self->private_impl.f_root_arity = 0;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func rac.decoder.set_drange
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_rac__decoder__set_drange(
+    wuffs_rac__decoder* self,
+    uint64_t a_min_incl,
+    uint64_t a_max_excl) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_drange_min_incl = a_min_incl;
+  self->private_impl.f_drange_max_excl = a_max_excl;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func rac.decoder.decompressed_size
+
+WUFFS_BASE__MAYBE_STATIC uint64_t
+wuffs_rac__decoder__decompressed_size(
+    const wuffs_rac__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_dfile_size;
+}
+
+// -------- func rac.decoder.io_seek_position
+
+WUFFS_BASE__MAYBE_STATIC uint64_t
+wuffs_rac__decoder__io_seek_position(
+    const wuffs_rac__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_io_seek_position_value;
+}
+
+// -------- func rac.decoder.transform_io
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_rac__decoder__transform_io(
+    wuffs_rac__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+        ? wuffs_base__error__disabled_by_previous_error
+        : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst || !a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 1)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint64_t v_dmax = 0;
+
+  uint32_t coro_susp_point = self->private_impl.p_transform_io[0];
+  if (coro_susp_point) {
+    v_dmax = self->private_data.s_transform_io[0].v_dmax;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (((uint64_t)(a_workbuf.len)) < 65793) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_workbuf_length);
+      goto exit;
+    }
+    if (self->private_impl.f_root_arity == 0) {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      status = wuffs_rac__decoder__find_root_node(self, a_src);
+      if (status.repr) {
+        goto suspend;
+      }
+    }
+    v_dmax = wuffs_base__u64__min(self->private_impl.f_drange_max_excl, self->private_impl.f_dfile_size);
+    self->private_impl.f_dpos = self->private_impl.f_drange_min_incl;
+    self->private_impl.f_need_to_resolve = true;
+    while (self->private_impl.f_dpos < v_dmax) {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      status = wuffs_rac__decoder__next_chunk(self, a_src);
+      if (status.repr) {
+        goto suspend;
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      status = wuffs_rac__decoder__decode_chunk(self,
+          a_dst,
+          a_src,
+          a_workbuf,
+          v_dmax);
+      if (status.repr) {
+        goto suspend;
+      }
+    }
+
+    goto ok;
+    ok:
+    self->private_impl.p_transform_io[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_transform_io[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine = wuffs_base__status__is_suspension(&status) ? 1 : 0;
+  WUFFS_BASE__STATS__ADD(self->private_impl, WUFFS_BASE__STATS__SUSPENSIONS,
+      wuffs_base__status__is_suspension(&status) ? 1u : 0u);
+  self->private_data.s_transform_io[0].v_dmax = v_dmax;
+
+  goto exit;
+  exit:
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func rac.decoder.seek
+
+static wuffs_base__status
+wuffs_rac__decoder__seek(
+    wuffs_rac__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    uint64_t a_pos) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint64_t v_p = 0;
+  uint64_t v_n = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_seek[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    self->private_impl.f_io_seek_position_value = a_pos;
+    label__0__continue:;
+    while (true) {
+      v_p = wuffs_base__u64__sat_add((a_src ? a_src->meta.pos : 0), ((uint64_t)(iop_a_src - io0_a_src)));
+      if (v_p == a_pos) {
+        goto label__0__break;
+      } else if (v_p < a_pos) {
+        v_n = wuffs_base__u64__sat_sub(a_pos, v_p);
+        if (v_n <= ((uint64_t)(io2_a_src - iop_a_src))) {
+          self->private_data.s_seek[0].scratch = v_n;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+          if (self->private_data.s_seek[0].scratch > ((uint64_t)(io2_a_src - iop_a_src))) {
+            self->private_data.s_seek[0].scratch -= ((uint64_t)(io2_a_src - iop_a_src));
+            iop_a_src = io2_a_src;
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          iop_a_src += self->private_data.s_seek[0].scratch;
+          goto label__0__continue;
+        }
+      }
+      status = wuffs_base__make_status(wuffs_base__suspension__mispositioned_read);
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(2);
+    }
+    label__0__break:;
+
+    ok:
+    self->private_impl.p_seek[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_seek[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func rac.decoder.load_node
+
+static wuffs_base__status
+wuffs_rac__decoder__load_node(
+    wuffs_rac__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    uint64_t a_coffset,
+    uint32_t a_arity) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_size = 0;
+  uint32_t v_i = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_load_node[0];
+  if (coro_susp_point) {
+    v_size = self->private_data.s_load_node[0].v_size;
+    v_i = self->private_data.s_load_node[0].v_i;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (a_src) {
+      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+    status = wuffs_rac__decoder__seek(self, a_src, a_coffset);
+    if (a_src) {
+      iop_a_src = a_src->data.ptr + a_src->meta.ri;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
+    v_size = ((16 * a_arity) + 16);
+    while (v_i < v_size) {
+      v_i += wuffs_base__io_reader__limited_copy_u32_to_slice(
+          &iop_a_src, io2_a_src,wuffs_base__u32__sat_sub(v_size, v_i), wuffs_base__slice_u8__subslice_ij(wuffs_base__make_slice_u8(self->private_data.f_node, 4096), v_i, v_size));
+      if (v_i < v_size) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(2);
+      }
+    }
+    self->private_impl.f_curr_arity = a_arity;
+
+    ok:
+    self->private_impl.p_load_node[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_load_node[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_load_node[0].v_size = v_size;
+  self->private_data.s_load_node[0].v_i = v_i;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func rac.decoder.find_root_node
+
+static wuffs_base__status
+wuffs_rac__decoder__find_root_node(
+    wuffs_rac__decoder* self,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_magic = 0;
+  uint8_t v_c = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_find_root_node[0];
+  if (coro_susp_point) {
+    v_c = self->private_data.s_find_root_node[0].v_c;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_cfile_size < 32) {
+      status = wuffs_base__make_status(wuffs_rac__error__bad_compressed_size);
+      goto exit;
+    }
+    if (a_src) {
+      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+    status = wuffs_rac__decoder__seek(self, a_src, 0);
+    if (a_src) {
+      iop_a_src = a_src->data.ptr + a_src->meta.ri;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      uint32_t t_0;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 3)) {
+        t_0 = ((uint32_t)(wuffs_base__peek_u24le__no_bounds_check(iop_a_src)));
+        iop_a_src += 3;
+      } else {
+        self->private_data.s_find_root_node[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_find_root_node[0].scratch;
+          uint32_t num_bits_0 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_0;
+          if (num_bits_0 == 16) {
+            t_0 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_0 += 8;
+          *scratch |= ((uint64_t)(num_bits_0)) << 56;
+        }
+      }
+      v_magic = t_0;
+    }
+    if (v_magic != 6538098) {
+      status = wuffs_base__make_status(wuffs_rac__error__bad_header);
+      goto exit;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_1 = *iop_a_src++;
+      v_c = t_1;
+    }
+    if (a_src) {
+      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+    status = wuffs_rac__decoder__try_root_node(self, a_src, ((uint32_t)(v_c)), false);
+    if (a_src) {
+      iop_a_src = a_src->data.ptr + a_src->meta.ri;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
+    if (self->private_impl.f_root_arity != 0) {
+      status = wuffs_base__make_status(NULL);
+      goto ok;
+    }
+    if (a_src) {
+      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+    status = wuffs_rac__decoder__seek(self, a_src, wuffs_base__u64__sat_sub(self->private_impl.f_cfile_size, 1));
+    if (a_src) {
+      iop_a_src = a_src->data.ptr + a_src->meta.ri;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_2 = *iop_a_src++;
+      v_c = t_2;
+    }
+    if (a_src) {
+      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+    status = wuffs_rac__decoder__try_root_node(self, a_src, ((uint32_t)(v_c)), true);
+    if (a_src) {
+      iop_a_src = a_src->data.ptr + a_src->meta.ri;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
+    if (self->private_impl.f_root_arity == 0) {
+      status = wuffs_base__make_status(wuffs_rac__error__missing_root_node);
+      goto exit;
+    }
+
+    ok:
+    self->private_impl.p_find_root_node[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_find_root_node[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_find_root_node[0].v_c = v_c;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func rac.decoder.try_root_node
+
+static wuffs_base__status
+wuffs_rac__decoder__try_root_node(
+    wuffs_rac__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    uint32_t a_arity,
+    bool a_from_end) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint64_t v_size = 0;
+  uint64_t v_coffset = 0;
+  bool v_valid = false;
+
+  uint32_t coro_susp_point = self->private_impl.p_try_root_node[0];
+  if (coro_susp_point) {
+    v_coffset = self->private_data.s_try_root_node[0].v_coffset;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (a_arity == 0) {
+      status = wuffs_base__make_status(NULL);
+      goto ok;
+    }
+    v_size = ((uint64_t)(((16 * a_arity) + 16)));
+    if (self->private_impl.f_cfile_size < v_size) {
+      status = wuffs_base__make_status(NULL);
+      goto ok;
+    }
+    if (a_from_end) {
+      v_coffset = wuffs_base__u64__sat_sub(self->private_impl.f_cfile_size, v_size);
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+    status = wuffs_rac__decoder__load_node(self, a_src, v_coffset, a_arity);
+    if (status.repr) {
+      goto suspend;
+    }
+    v_valid = wuffs_rac__decoder__node_is_valid(self);
+    if ( ! v_valid || (wuffs_rac__decoder__cptr(self, self->private_impl.f_curr_arity) != self->private_impl.f_cfile_size)) {
+      status = wuffs_base__make_status(NULL);
+      goto ok;
+    }
+    if ((self->private_data.f_node[((8 * self->private_impl.f_curr_arity) + 7)] & 128) != 0) {
+      status = wuffs_base__make_status(wuffs_rac__error__unsupported_rac_codec);
+      goto exit;
+    }
+    if (self->private_data.f_node[((16 * self->private_impl.f_curr_arity) + 14)] != 1) {
+      status = wuffs_base__make_status(wuffs_rac__error__unsupported_rac_version);
+      goto exit;
+    }
+    self->private_impl.f_root_coffset = v_coffset;
+    self->private_impl.f_root_arity = a_arity;
+    self->private_impl.f_dfile_size = wuffs_rac__decoder__dptr(self, self->private_impl.f_curr_arity);
+
+    ok:
+    self->private_impl.p_try_root_node[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_try_root_node[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_try_root_node[0].v_coffset = v_coffset;
+
+  goto exit;
+  exit:
+  return status;
+}
+
+// -------- func rac.decoder.next_chunk
+
+static wuffs_base__status
+wuffs_rac__decoder__next_chunk(
+    wuffs_rac__decoder* self,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_i = 0;
+  uint32_t v_ttag = 0;
+  uint32_t v_stag = 0;
+
+  uint32_t coro_susp_point = self->private_impl.p_next_chunk[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    while (true) {
+      if (self->private_impl.f_need_to_resolve) {
+        self->private_impl.f_need_to_resolve = false;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        status = wuffs_rac__decoder__resolve_dpos(self, a_src);
+        if (status.repr) {
+          goto suspend;
+        }
+      }
+      label__0__continue:;
+      while (true) {
+        v_i = self->private_impl.f_next_element;
+        if ((v_i >= self->private_impl.f_curr_arity) || (v_i >= 255)) {
+          goto label__0__break;
+        }
+        self->private_impl.f_next_element = (v_i + 1);
+        if (wuffs_rac__decoder__dptr(self, v_i) >= wuffs_rac__decoder__dptr(self, (v_i + 1))) {
+          goto label__0__continue;
+        }
+        v_ttag = ((uint32_t)(self->private_data.f_node[((8 * v_i) + 7)]));
+        if (v_ttag == 254) {
+          goto label__0__break;
+        }
+        v_stag = ((uint32_t)(self->private_data.f_node[((8 * self->private_impl.f_curr_arity) + 15 + (8 * v_i))]));
+        self->private_impl.f_chunk_dmin_incl = wuffs_base__u64__sat_add(self->private_impl.f_curr_dbias, wuffs_rac__decoder__dptr(self, v_i));
+        self->private_impl.f_chunk_dmax_excl = wuffs_base__u64__sat_add(self->private_impl.f_curr_dbias, wuffs_rac__decoder__dptr(self, (v_i + 1)));
+        self->private_impl.f_chunk_cprimary_min = wuffs_base__u64__sat_add(self->private_impl.f_curr_cbias, wuffs_rac__decoder__cptr(self, v_i));
+        self->private_impl.f_chunk_cprimary_max = wuffs_rac__decoder__crange_max(self, v_i);
+        if (v_stag < self->private_impl.f_curr_arity) {
+          self->private_impl.f_chunk_csecondary_min = wuffs_base__u64__sat_add(self->private_impl.f_curr_cbias, wuffs_rac__decoder__cptr(self, v_stag));
+          self->private_impl.f_chunk_csecondary_max = wuffs_rac__decoder__crange_max(self, v_stag);
+        } else {
+          self->private_impl.f_chunk_csecondary_min = 0;
+          self->private_impl.f_chunk_csecondary_max = 0;
+        }
+        self->private_impl.f_chunk_ttag = v_ttag;
+        self->private_impl.f_chunk_codec = ((uint32_t)((self->private_data.f_node[((8 * self->private_impl.f_curr_arity) + 7)] & 63)));
+        status = wuffs_base__make_status(NULL);
+        goto ok;
+      }
+      label__0__break:;
+      self->private_impl.f_need_to_resolve = true;
+    }
+
+    ok:
+    self->private_impl.p_next_chunk[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_next_chunk[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+  exit:
+  return status;
+}
+
+// -------- func rac.decoder.resolve_dpos
+
+static wuffs_base__status
+wuffs_rac__decoder__resolve_dpos(
+    wuffs_rac__decoder* self,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint64_t v_cbias = 0;
+  uint64_t v_dbias = 0;
+  uint64_t v_coffset = 0;
+  uint32_t v_i = 0;
+  uint32_t v_stag = 0;
+  uint8_t v_parent_codec = 0;
+  uint8_t v_parent_version = 0;
+  uint64_t v_parent_coffmax = 0;
+  uint64_t v_parent_dptrmax = 0;
+  uint64_t v_child_coffset = 0;
+  uint64_t v_child_cbias = 0;
+  uint64_t v_child_dbias = 0;
+  uint64_t v_child_dsize = 0;
+  uint8_t v_c = 0;
+  uint32_t v_arity = 0;
+  uint64_t v_size = 0;
+  bool v_valid = false;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_resolve_dpos[0];
+  if (coro_susp_point) {
+    v_cbias = self->private_data.s_resolve_dpos[0].v_cbias;
+    v_dbias = self->private_data.s_resolve_dpos[0].v_dbias;
+    v_coffset = self->private_data.s_resolve_dpos[0].v_coffset;
+    v_parent_coffmax = self->private_data.s_resolve_dpos[0].v_parent_coffmax;
+    v_parent_dptrmax = self->private_data.s_resolve_dpos[0].v_parent_dptrmax;
+    v_child_coffset = self->private_data.s_resolve_dpos[0].v_child_coffset;
+    v_child_cbias = self->private_data.s_resolve_dpos[0].v_child_cbias;
+    v_child_dbias = self->private_data.s_resolve_dpos[0].v_child_dbias;
+    v_child_dsize = self->private_data.s_resolve_dpos[0].v_child_dsize;
+    v_arity = self->private_data.s_resolve_dpos[0].v_arity;
+    v_parent_codec = self->private_data.s_resolve_dpos[0].v_parent_codec;
+    v_parent_version = self->private_data.s_resolve_dpos[0].v_parent_version;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    v_coffset = self->private_impl.f_root_coffset;
+    if (a_src) {
+      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+    status = wuffs_rac__decoder__load_node(self, a_src, v_coffset, self->private_impl.f_root_arity);
+    if (a_src) {
+      iop_a_src = a_src->data.ptr + a_src->meta.ri;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
+    while (true) {
+      v_i = 0;
+      while ((v_i < self->private_impl.f_curr_arity) && (v_i < 255)) {
+        if (wuffs_base__u64__sat_add(v_dbias, wuffs_rac__decoder__dptr(self, (v_i + 1))) > self->private_impl.f_dpos) {
+          goto label__0__break;
+        }
+        v_i += 1;
+      }
+      label__0__break:;
+      if ((v_i >= self->private_impl.f_curr_arity) || (v_i >= 255)) {
+        status = wuffs_base__make_status(wuffs_rac__error__bad_index_node);
+        goto exit;
+      }
+      if (self->private_data.f_node[((8 * v_i) + 7)] != 254) {
+        self->private_impl.f_next_element = v_i;
+        self->private_impl.f_curr_cbias = v_cbias;
+        self->private_impl.f_curr_dbias = v_dbias;
+        status = wuffs_base__make_status(NULL);
+        goto ok;
+      }
+      v_parent_codec = self->private_data.f_node[((8 * self->private_impl.f_curr_arity) + 7)];
+      v_parent_version = self->private_data.f_node[((16 * self->private_impl.f_curr_arity) + 14)];
+      v_parent_coffmax = wuffs_base__u64__sat_add(v_cbias, wuffs_rac__decoder__cptr(self, self->private_impl.f_curr_arity));
+      v_parent_dptrmax = wuffs_rac__decoder__dptr(self, self->private_impl.f_curr_arity);
+      v_child_coffset = wuffs_base__u64__sat_add(v_cbias, wuffs_rac__decoder__cptr(self, v_i));
+      v_child_cbias = v_cbias;
+      v_stag = ((uint32_t)(self->private_data.f_node[((8 * self->private_impl.f_curr_arity) + 15 + (8 * v_i))]));
+      if (v_stag < self->private_impl.f_curr_arity) {
+        v_child_cbias = wuffs_base__u64__sat_add(v_cbias, wuffs_rac__decoder__cptr(self, v_stag));
+      }
+      v_child_dbias = wuffs_base__u64__sat_add(v_dbias, wuffs_rac__decoder__dptr(self, v_i));
+      v_child_dsize = wuffs_base__u64__sat_sub(wuffs_rac__decoder__dptr(self, (v_i + 1)), wuffs_rac__decoder__dptr(self, v_i));
+      if ((v_child_coffset > v_parent_coffmax) || (wuffs_base__u64__sat_sub(v_parent_coffmax, v_child_coffset) < 4)) {
+        status = wuffs_base__make_status(wuffs_rac__error__bad_index_node);
+        goto exit;
+      }
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      status = wuffs_rac__decoder__seek(self, a_src, wuffs_base__u64__sat_add(v_child_coffset, 3));
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint8_t t_0 = *iop_a_src++;
+        v_c = t_0;
+      }
+      v_arity = ((uint32_t)(v_c));
+      v_size = ((uint64_t)(((16 * v_arity) + 16)));
+      if ((v_arity == 0) || (wuffs_base__u64__sat_sub(v_parent_coffmax, v_child_coffset) < v_size)) {
+        status = wuffs_base__make_status(wuffs_rac__error__bad_index_node);
+        goto exit;
+      }
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+      status = wuffs_rac__decoder__load_node(self, a_src, v_child_coffset, v_arity);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+      v_valid = wuffs_rac__decoder__node_is_valid(self);
+      if ( ! v_valid) {
+        status = wuffs_base__make_status(wuffs_rac__error__bad_index_node);
+        goto exit;
+      }
+      v_c = self->private_data.f_node[((8 * self->private_impl.f_curr_arity) + 7)];
+      if ((v_c & 128) != 0) {
+        status = wuffs_base__make_status(wuffs_rac__error__unsupported_rac_codec);
+        goto exit;
+      } else if ((((v_parent_codec & 64) == 0) && ((v_parent_codec & 191) != (v_c & 191))) ||
+          (v_parent_version < self->private_data.f_node[((16 * self->private_impl.f_curr_arity) + 14)]) ||
+          (v_parent_coffmax < wuffs_base__u64__sat_add(v_child_cbias, wuffs_rac__decoder__cptr(self, self->private_impl.f_curr_arity))) ||
+          (v_child_dsize != wuffs_rac__decoder__dptr(self, self->private_impl.f_curr_arity)) ||
+          ((v_child_coffset >= v_coffset) && (v_child_dsize >= v_parent_dptrmax))) {
+        status = wuffs_base__make_status(wuffs_rac__error__bad_index_node);
+        goto exit;
+      }
+      v_cbias = v_child_cbias;
+      v_dbias = v_child_dbias;
+      v_coffset = v_child_coffset;
+    }
+
+    ok:
+    self->private_impl.p_resolve_dpos[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_resolve_dpos[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_resolve_dpos[0].v_cbias = v_cbias;
+  self->private_data.s_resolve_dpos[0].v_dbias = v_dbias;
+  self->private_data.s_resolve_dpos[0].v_coffset = v_coffset;
+  self->private_data.s_resolve_dpos[0].v_parent_coffmax = v_parent_coffmax;
+  self->private_data.s_resolve_dpos[0].v_parent_dptrmax = v_parent_dptrmax;
+  self->private_data.s_resolve_dpos[0].v_child_coffset = v_child_coffset;
+  self->private_data.s_resolve_dpos[0].v_child_cbias = v_child_cbias;
+  self->private_data.s_resolve_dpos[0].v_child_dbias = v_child_dbias;
+  self->private_data.s_resolve_dpos[0].v_child_dsize = v_child_dsize;
+  self->private_data.s_resolve_dpos[0].v_arity = v_arity;
+  self->private_data.s_resolve_dpos[0].v_parent_codec = v_parent_codec;
+  self->private_data.s_resolve_dpos[0].v_parent_version = v_parent_version;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func rac.decoder.decode_chunk
+
+static wuffs_base__status
+wuffs_rac__decoder__decode_chunk(
+    wuffs_rac__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf,
+    uint64_t a_dmax) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint64_t v_dend = 0;
+  uint64_t v_dstart = 0;
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  wuffs_base__io_buffer u_w = wuffs_base__empty_io_buffer();
+  wuffs_base__io_buffer* v_w = &u_w;
+  uint8_t* iop_v_w WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io0_v_w WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_v_w WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_v_w WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint64_t v_w_mark = 0;
+  uint64_t v_n_decoded = 0;
+  uint64_t v_wb_ri = 0;
+  uint64_t v_wb_wi = 0;
+  uint64_t v_n = 0;
+  uint64_t v_resume_cpos = 0;
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_chunk[0];
+  if (coro_susp_point) {
+    v_dend = self->private_data.s_decode_chunk[0].v_dend;
+    v_status = self->private_data.s_decode_chunk[0].v_status;
+    v_n_decoded = self->private_data.s_decode_chunk[0].v_n_decoded;
+    v_wb_ri = self->private_data.s_decode_chunk[0].v_wb_ri;
+    v_wb_wi = self->private_data.s_decode_chunk[0].v_wb_wi;
+    v_resume_cpos = self->private_data.s_decode_chunk[0].v_resume_cpos;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    v_dend = wuffs_base__u64__min(self->private_impl.f_chunk_dmax_excl, a_dmax);
+    if (self->private_impl.f_chunk_codec == 0) {
+      while (self->private_impl.f_dpos < v_dend) {
+        self->private_data.s_decode_chunk[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        if (iop_a_dst == io2_a_dst) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+          goto suspend;
+        }
+        *iop_a_dst++ = ((uint8_t)(self->private_data.s_decode_chunk[0].scratch));
+        wuffs_base__u64__sat_add_indirect(&self->private_impl.f_dpos, 1);
+      }
+      status = wuffs_base__make_status(NULL);
+      goto ok;
+    } else if (self->private_impl.f_chunk_codec != 1) {
+      status = wuffs_base__make_status(wuffs_rac__error__unsupported_rac_codec);
+      goto exit;
+    }
+    wuffs_base__ignore_status(wuffs_zlib__decoder__initialize(&self->private_data.f_zlib,
+        sizeof (wuffs_zlib__decoder), WUFFS_VERSION, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    self->private_impl.f_chunk_written = 0;
+    if (a_src) {
+      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+    status = wuffs_rac__decoder__seek(self, a_src, self->private_impl.f_chunk_cprimary_min);
+    if (a_src) {
+      iop_a_src = a_src->data.ptr + a_src->meta.ri;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
+    label__0__continue:;
+    while (true) {
+      if (((uint64_t)(a_workbuf.len)) < 65793) {
+        status = wuffs_base__make_status(wuffs_base__error__bad_workbuf_length);
+        goto exit;
+      }
+      {
+        wuffs_base__io_buffer* o_0_v_w = v_w;
+        uint8_t *o_0_iop_v_w = iop_v_w;
+        uint8_t *o_0_io0_v_w = io0_v_w;
+        uint8_t *o_0_io1_v_w = io1_v_w;
+        uint8_t *o_0_io2_v_w = io2_v_w;
+        v_w = wuffs_base__io_writer__set(
+            &u_w,
+            &iop_v_w,
+            &io0_v_w,
+            &io1_v_w,
+            &io2_v_w,
+            wuffs_base__slice_u8__subslice_j(a_workbuf, 32768),
+            self->private_impl.f_chunk_written);
+        {
+          const uint8_t *o_1_io2_a_src = io2_a_src;
+          wuffs_base__io_reader__limit(&io2_a_src, iop_a_src,
+              wuffs_base__u64__sat_sub(self->private_impl.f_chunk_cprimary_max, wuffs_base__u64__sat_add((a_src ? a_src->meta.pos : 0), ((uint64_t)(iop_a_src - io0_a_src)))));
+          if (a_src) {
+            a_src->meta.wi = ((size_t)(io2_a_src - a_src->data.ptr));
+          }
+          v_w_mark = ((uint64_t)(iop_v_w - io0_v_w));
+          {
+            u_w.meta.wi = ((size_t)(iop_v_w - u_w.data.ptr));
+            if (a_src) {
+              a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+            }
+            wuffs_base__status t_0 = wuffs_zlib__decoder__transform_io(&self->private_data.f_zlib, v_w, a_src, wuffs_base__slice_u8__subslice_ij(a_workbuf, 32768, 65793));
+            v_status = t_0;
+            iop_v_w = u_w.data.ptr + u_w.meta.wi;
+            if (a_src) {
+              iop_a_src = a_src->data.ptr + a_src->meta.ri;
+            }
+          }
+          v_n_decoded = wuffs_base__io__count_since(v_w_mark, ((uint64_t)(iop_v_w - io0_v_w)));
+          io2_a_src = o_1_io2_a_src;
+          if (a_src) {
+            a_src->meta.wi = ((size_t)(io2_a_src - a_src->data.ptr));
+          }
+        }
+        v_w = o_0_v_w;
+        iop_v_w = o_0_iop_v_w;
+        io0_v_w = o_0_io0_v_w;
+        io1_v_w = o_0_io1_v_w;
+        io2_v_w = o_0_io2_v_w;
+      }
+      if (v_n_decoded > wuffs_base__u64__sat_sub(wuffs_base__u64__sat_sub(self->private_impl.f_chunk_dmax_excl, self->private_impl.f_chunk_dmin_incl), self->private_impl.f_chunk_written)) {
+        status = wuffs_base__make_status(wuffs_rac__error__bad_chunk);
+        goto exit;
+      } else if (wuffs_base__status__is_error(&v_status)) {
+        status = v_status;
+        goto exit;
+      }
+      v_dstart = wuffs_base__u64__sat_add(self->private_impl.f_chunk_dmin_incl, self->private_impl.f_chunk_written);
+      v_wb_ri = 0;
+      if (v_dstart < self->private_impl.f_dpos) {
+        v_wb_ri = wuffs_base__u64__min(v_n_decoded, wuffs_base__u64__sat_sub(self->private_impl.f_dpos, v_dstart));
+      }
+      v_wb_wi = 0;
+      if (v_dstart < v_dend) {
+        v_wb_wi = wuffs_base__u64__min(v_n_decoded, wuffs_base__u64__sat_sub(v_dend, v_dstart));
+      }
+      while ((v_wb_ri < v_wb_wi) && (v_wb_wi <= ((uint64_t)(a_workbuf.len)))) {
+        v_n = wuffs_base__io_writer__copy_from_slice(&iop_a_dst, io2_a_dst,wuffs_base__slice_u8__subslice_ij(a_workbuf, v_wb_ri, v_wb_wi));
+        wuffs_base__u64__sat_add_indirect(&v_wb_ri, v_n);
+        wuffs_base__u64__sat_add_indirect(&self->private_impl.f_dpos, v_n);
+        if (v_wb_ri < v_wb_wi) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(3);
+        }
+      }
+      wuffs_base__u64__sat_add_indirect(&self->private_impl.f_chunk_written, v_n_decoded);
+      if (self->private_impl.f_dpos >= v_dend) {
+        status = wuffs_base__make_status(NULL);
+        goto ok;
+      }
+      if (wuffs_base__status__is_ok(&v_status)) {
+        while (self->private_impl.f_dpos < v_dend) {
+          self->private_data.s_decode_chunk[0].scratch = 0;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+          if (iop_a_dst == io2_a_dst) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+            goto suspend;
+          }
+          *iop_a_dst++ = ((uint8_t)(self->private_data.s_decode_chunk[0].scratch));
+          wuffs_base__u64__sat_add_indirect(&self->private_impl.f_dpos, 1);
+        }
+        status = wuffs_base__make_status(NULL);
+        goto ok;
+      } else if (v_status.repr == wuffs_base__suspension__short_write) {
+        goto label__0__continue;
+      } else if (v_status.repr == wuffs_zlib__note__dictionary_required) {
+        v_resume_cpos = wuffs_base__u64__sat_add((a_src ? a_src->meta.pos : 0), ((uint64_t)(iop_a_src - io0_a_src)));
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+        status = wuffs_rac__decoder__load_dictionary(self, a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+        if (((uint64_t)(a_workbuf.len)) < 65793) {
+          status = wuffs_base__make_status(wuffs_base__error__bad_workbuf_length);
+          goto exit;
+        }
+        wuffs_zlib__decoder__add_dictionary(&self->private_data.f_zlib, wuffs_base__slice_u8__subslice_j(wuffs_base__make_slice_u8(self->private_data.f_dictionary, 32768), self->private_impl.f_dict_length), wuffs_base__slice_u8__subslice_ij(a_workbuf, 32768, 65793));
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+        status = wuffs_rac__decoder__seek(self, a_src, v_resume_cpos);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+        goto label__0__continue;
+      } else if (v_status.repr == wuffs_base__suspension__short_read) {
+        if (wuffs_base__u64__sat_add((a_src ? a_src->meta.pos : 0), ((uint64_t)(iop_a_src - io0_a_src))) >= self->private_impl.f_chunk_cprimary_max) {
+          status = wuffs_base__make_status(wuffs_rac__error__bad_chunk);
+          goto exit;
+        }
+      }
+      status = v_status;
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(7);
+    }
+
+    ok:
+    self->private_impl.p_decode_chunk[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_chunk[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_decode_chunk[0].v_dend = v_dend;
+  self->private_data.s_decode_chunk[0].v_status = v_status;
+  self->private_data.s_decode_chunk[0].v_n_decoded = v_n_decoded;
+  self->private_data.s_decode_chunk[0].v_wb_ri = v_wb_ri;
+  self->private_data.s_decode_chunk[0].v_wb_wi = v_wb_wi;
+  self->private_data.s_decode_chunk[0].v_resume_cpos = v_resume_cpos;
+
+  goto exit;
+  exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func rac.decoder.load_dictionary
+
+static wuffs_base__status
+wuffs_rac__decoder__load_dictionary(
+    wuffs_rac__decoder* self,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_x = 0;
+  uint32_t v_length = 0;
+  uint32_t v_i = 0;
+  uint32_t v_checksum_want = 0;
+  uint32_t v_checksum_got = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_load_dictionary[0];
+  if (coro_susp_point) {
+    v_length = self->private_data.s_load_dictionary[0].v_length;
+    v_i = self->private_data.s_load_dictionary[0].v_i;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if ((self->private_impl.f_chunk_csecondary_min >= self->private_impl.f_chunk_csecondary_max) || (self->private_impl.f_chunk_ttag != 255)) {
+      status = wuffs_base__make_status(wuffs_rac__error__bad_dictionary);
+      goto exit;
+    } else if (self->private_impl.f_dict_loaded && (self->private_impl.f_dict_coffset == self->private_impl.f_chunk_csecondary_min)) {
+      status = wuffs_base__make_status(NULL);
+      goto ok;
+    }
+    self->private_impl.f_dict_loaded = false;
+    if (wuffs_base__u64__sat_sub(self->private_impl.f_chunk_csecondary_max, self->private_impl.f_chunk_csecondary_min) < 8) {
+      status = wuffs_base__make_status(wuffs_rac__error__bad_dictionary);
+      goto exit;
+    }
+    if (a_src) {
+      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+    status = wuffs_rac__decoder__seek(self, a_src, self->private_impl.f_chunk_csecondary_min);
+    if (a_src) {
+      iop_a_src = a_src->data.ptr + a_src->meta.ri;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      uint32_t t_0;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+        t_0 = wuffs_base__peek_u32le__no_bounds_check(iop_a_src);
+        iop_a_src += 4;
+      } else {
+        self->private_data.s_load_dictionary[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_load_dictionary[0].scratch;
+          uint32_t num_bits_0 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_0;
+          if (num_bits_0 == 24) {
+            t_0 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_0 += 8;
+          *scratch |= ((uint64_t)(num_bits_0)) << 56;
+        }
+      }
+      v_x = t_0;
+    }
+    if ((v_x >> 30) != 0) {
+      status = wuffs_base__make_status(wuffs_rac__error__bad_dictionary);
+      goto exit;
+    } else if (v_x > 32768) {
+      status = wuffs_base__make_status(wuffs_rac__error__unsupported_rac_dictionary_length);
+      goto exit;
+    } else if ((((uint64_t)(v_x)) + 8) > wuffs_base__u64__sat_sub(self->private_impl.f_chunk_csecondary_max, self->private_impl.f_chunk_csecondary_min)) {
+      status = wuffs_base__make_status(wuffs_rac__error__bad_dictionary);
+      goto exit;
+    }
+    v_length = v_x;
+    while (v_i < v_length) {
+      v_i += wuffs_base__io_reader__limited_copy_u32_to_slice(
+          &iop_a_src, io2_a_src,wuffs_base__u32__sat_sub(v_length, v_i), wuffs_base__slice_u8__subslice_ij(wuffs_base__make_slice_u8(self->private_data.f_dictionary, 32768), v_i, v_length));
+      if (v_i < v_length) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(4);
+      }
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+      uint32_t t_1;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+        t_1 = wuffs_base__peek_u32le__no_bounds_check(iop_a_src);
+        iop_a_src += 4;
+      } else {
+        self->private_data.s_load_dictionary[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_load_dictionary[0].scratch;
+          uint32_t num_bits_1 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_1;
+          if (num_bits_1 == 24) {
+            t_1 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_1 += 8;
+          *scratch |= ((uint64_t)(num_bits_1)) << 56;
+        }
+      }
+      v_checksum_want = t_1;
+    }
+    wuffs_base__ignore_status(wuffs_crc32__ieee_hasher__initialize(&self->private_data.f_crc32,
+        sizeof (wuffs_crc32__ieee_hasher), WUFFS_VERSION, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    v_checksum_got = wuffs_crc32__ieee_hasher__update_u32(&self->private_data.f_crc32, wuffs_base__slice_u8__subslice_j(wuffs_base__make_slice_u8(self->private_data.f_dictionary, 32768), v_length));
+    if (v_checksum_got != v_checksum_want) {
+      status = wuffs_base__make_status(wuffs_rac__error__bad_dictionary);
+      goto exit;
+    }
+    self->private_impl.f_dict_loaded = true;
+    self->private_impl.f_dict_coffset = self->private_impl.f_chunk_csecondary_min;
+    self->private_impl.f_dict_length = v_length;
+
+    ok:
+    self->private_impl.p_load_dictionary[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_load_dictionary[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_load_dictionary[0].v_length = v_length;
+  self->private_data.s_load_dictionary[0].v_i = v_i;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func rac.decoder.node_is_valid
+
+static bool
+wuffs_rac__decoder__node_is_valid(
+    wuffs_rac__decoder* self) {
+  uint32_t v_arity = 0;
+  uint32_t v_i = 0;
+  uint8_t v_ttag = 0;
+  bool v_has_children = false;
+  uint64_t v_prev = 0;
+  uint64_t v_curr = 0;
+  uint64_t v_cptr_max = 0;
+  uint32_t v_checksum = 0;
+
+  v_arity = self->private_impl.f_curr_arity;
+  if ((self->private_data.f_node[0] != 114) ||
+      (self->private_data.f_node[1] != 195) ||
+      (self->private_data.f_node[2] != 99) ||
+      (v_arity == 0) ||
+      (((uint32_t)(self->private_data.f_node[3])) != v_arity) ||
+      (((uint32_t)(self->private_data.f_node[((16 * v_arity) + 15)])) != v_arity)) {
+    return false;
+  }
+  while ((v_i < v_arity) && (v_i < 255)) {
+    if (self->private_data.f_node[((8 * v_i) + 6)] != 0) {
+      return false;
+    }
+    v_ttag = self->private_data.f_node[((8 * v_i) + 7)];
+    if ((192 <= v_ttag) && (v_ttag < 253)) {
+      return false;
+    } else if (v_ttag != 253) {
+      v_has_children = true;
+    }
+    v_i += 1;
+  }
+  if ( ! v_has_children || (self->private_data.f_node[((8 * v_arity) + 6)] != 0)) {
+    return false;
+  }
+  v_i = 0;
+  while ((v_i < v_arity) && (v_i < 255)) {
+    v_curr = wuffs_rac__decoder__dptr(self, (v_i + 1));
+    if (v_curr < v_prev) {
+      return false;
+    } else if ((v_curr != v_prev) && (self->private_data.f_node[((8 * v_i) + 7)] == 253)) {
+      return false;
+    }
+    v_prev = v_curr;
+    v_i += 1;
+  }
+  v_cptr_max = wuffs_rac__decoder__cptr(self, v_arity);
+  v_i = 0;
+  while ((v_i < v_arity) && (v_i < 255)) {
+    if ((wuffs_rac__decoder__cptr(self, v_i) > v_cptr_max) && (self->private_data.f_node[((8 * v_i) + 7)] != 253)) {
+      return false;
+    }
+    v_i += 1;
+  }
+  if (self->private_data.f_node[((16 * v_arity) + 14)] == 0) {
+    return false;
+  }
+  wuffs_base__ignore_status(wuffs_crc32__ieee_hasher__initialize(&self->private_data.f_crc32,
+      sizeof (wuffs_crc32__ieee_hasher), WUFFS_VERSION, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  v_checksum = wuffs_crc32__ieee_hasher__update_u32(&self->private_data.f_crc32, wuffs_base__slice_u8__subslice_j(wuffs_base__make_slice_u8((self->private_data.f_node) + 6, 4090), (((16 * v_arity) + 16)) - 6));
+  v_checksum ^= (v_checksum >> 16);
+  return ((self->private_data.f_node[4] == ((uint8_t)((v_checksum & 255)))) && (self->private_data.f_node[5] == ((uint8_t)(((v_checksum >> 8) & 255)))));
+}
+
+// -------- func rac.decoder.dptr
+
+static uint64_t
+wuffs_rac__decoder__dptr(
+    const wuffs_rac__decoder* self,
+    uint32_t a_i) {
+  if (a_i == 0) {
+    return 0;
+  }
+  return wuffs_rac__decoder__peek_u48le(self, (8 * a_i));
+}
+
+// -------- func rac.decoder.cptr
+
+static uint64_t
+wuffs_rac__decoder__cptr(
+    const wuffs_rac__decoder* self,
+    uint32_t a_i) {
+  return wuffs_rac__decoder__peek_u48le(self, ((8 * self->private_impl.f_curr_arity) + 8 + (8 * a_i)));
+}
+
+// -------- func rac.decoder.crange_max
+
+static uint64_t
+wuffs_rac__decoder__crange_max(
+    const wuffs_rac__decoder* self,
+    uint32_t a_i) {
+  uint64_t v_m = 0;
+  uint64_t v_clen = 0;
+
+  v_m = wuffs_base__u64__sat_add(self->private_impl.f_curr_cbias, wuffs_rac__decoder__cptr(self, self->private_impl.f_curr_arity));
+  v_clen = ((uint64_t)(self->private_data.f_node[((8 * self->private_impl.f_curr_arity) + 14 + (8 * a_i))]));
+  if (v_clen != 0) {
+    v_m = wuffs_base__u64__min(v_m, wuffs_base__u64__sat_add(wuffs_base__u64__sat_add(self->private_impl.f_curr_cbias, wuffs_rac__decoder__cptr(self, a_i)), (v_clen * 1024)));
+  }
+  return v_m;
+}
+
+// -------- func rac.decoder.peek_u48le
+
+static uint64_t
+wuffs_rac__decoder__peek_u48le(
+    const wuffs_rac__decoder* self,
+    uint32_t a_offset) {
+  return ((((uint64_t)(self->private_data.f_node[(a_offset + 0)])) << 0) |
+      (((uint64_t)(self->private_data.f_node[(a_offset + 1)])) << 8) |
+      (((uint64_t)(self->private_data.f_node[(a_offset + 2)])) << 16) |
+      (((uint64_t)(self->private_data.f_node[(a_offset + 3)])) << 24) |
+      (((uint64_t)(self->private_data.f_node[(a_offset + 4)])) << 32) |
+      (((uint64_t)(self->private_data.f_node[(a_offset + 5)])) << 40));
+}
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__RAC)
+
+
+#endif  // WUFFS_IMPLEMENTATION
+
+// ¡ WUFFS MONOLITHIC RELEASE DISCARDS EVERYTHING BELOW.
+
+#endif  // WUFFS_INCLUDE_GUARD__RAC
@@ -0,0 +1,3275 @@
+#ifndef WUFFS_INCLUDE_GUARD__TIFF
+#define WUFFS_INCLUDE_GUARD__TIFF
+
+#if defined(WUFFS_IMPLEMENTATION) && !defined(WUFFS_CONFIG__MODULES)
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__TIFF
+#endif
+
+#include "./wuffs-base.c"
+#include "./wuffs-std-lzw.c"
+#include "./wuffs-std-zlib.c"
+
+// ¡ WUFFS MONOLITHIC RELEASE DISCARDS EVERYTHING ABOVE.
+
+
+// ---------------- Status Codes
+
+extern const char wuffs_tiff__error__bad_header[];
+extern const char wuffs_tiff__error__truncated_input[];
+extern const char wuffs_tiff__error__unsupported_tiff_file[];
+
+// ---------------- Public Consts
+
+// ---------------- Struct Declarations
+
+typedef struct wuffs_tiff__decoder__struct wuffs_tiff__decoder;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ---------------- Public Initializer Prototypes
+
+// For any given "wuffs_foo__bar* self", "wuffs_foo__bar__initialize(self,
+// etc)" should be called before any other "wuffs_foo__bar__xxx(self, etc)".
+//
+// Pass sizeof(*self) and WUFFS_VERSION for sizeof_star_self and wuffs_version.
+// Pass 0 (or some combination of WUFFS_INITIALIZE__XXX) for options.
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+wuffs_tiff__decoder__initialize(
+    wuffs_tiff__decoder* self,
+    size_t sizeof_star_self,
+    uint64_t wuffs_version,
+    uint32_t options);
+
+wuffs_base__stats
+wuffs_tiff__decoder__stats(
+    const wuffs_tiff__decoder* self);
+
+size_t
+sizeof__wuffs_tiff__decoder();
+
+// ---------------- Allocs
+
+// These functions allocate and initialize Wuffs structs. They return NULL if
+// memory allocation fails. If they return non-NULL, there is no need to call
+// wuffs_foo__bar__initialize, but the caller is responsible for eventually
+// calling free on the returned pointer. That pointer is effectively a C++
+// std::unique_ptr<T, decltype(&free)>.
+
+wuffs_tiff__decoder*
+wuffs_tiff__decoder__alloc();
+
+static inline wuffs_base__image_decoder*
+wuffs_tiff__decoder__alloc_as__wuffs_base__image_decoder() {
+  return (wuffs_base__image_decoder*)(wuffs_tiff__decoder__alloc());
+}
+
+// ---------------- Upcasts
+
+static inline wuffs_base__image_decoder*
+wuffs_tiff__decoder__upcast_as__wuffs_base__image_decoder(
+    wuffs_tiff__decoder* p) {
+  return (wuffs_base__image_decoder*)p;
+}
+
+// ---------------- Public Function Prototypes
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_tiff__decoder__set_quirk_enabled(
+    wuffs_tiff__decoder* self,
+    uint32_t a_quirk,
+    bool a_enabled);
+
+WUFFS_BASE__MAYBE_STATIC uint64_t
+wuffs_tiff__decoder__io_seek_position(
+    const wuffs_tiff__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC uint32_t
+wuffs_tiff__decoder__num_strips_or_tiles(
+    const wuffs_tiff__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__rect_ie_u32
+wuffs_tiff__decoder__strip_or_tile_rect(
+    const wuffs_tiff__decoder* self,
+    uint32_t a_i);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_tiff__decoder__decode_image_config(
+    wuffs_tiff__decoder* self,
+    wuffs_base__image_config* a_dst,
+    wuffs_base__io_buffer* a_src);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_tiff__decoder__decode_frame_config(
+    wuffs_tiff__decoder* self,
+    wuffs_base__frame_config* a_dst,
+    wuffs_base__io_buffer* a_src);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_tiff__decoder__decode_frame(
+    wuffs_tiff__decoder* self,
+    wuffs_base__pixel_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__pixel_blend a_blend,
+    wuffs_base__slice_u8 a_workbuf,
+    wuffs_base__decode_frame_options* a_opts);
+
+WUFFS_BASE__MAYBE_STATIC bool
+wuffs_tiff__decoder__can_decode_row_bands(
+    const wuffs_tiff__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__rect_ie_u32
+wuffs_tiff__decoder__frame_dirty_rect(
+    const wuffs_tiff__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC uint32_t
+wuffs_tiff__decoder__num_animation_loops(
+    const wuffs_tiff__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC uint64_t
+wuffs_tiff__decoder__num_decoded_frame_configs(
+    const wuffs_tiff__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC uint64_t
+wuffs_tiff__decoder__num_decoded_frames(
+    const wuffs_tiff__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_tiff__decoder__restart_frame(
+    wuffs_tiff__decoder* self,
+    uint64_t a_index,
+    uint64_t a_io_position);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_tiff__decoder__set_report_metadata(
+    wuffs_tiff__decoder* self,
+    uint32_t a_fourcc,
+    bool a_report);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_tiff__decoder__tell_me_more(
+    wuffs_tiff__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__more_information* a_minfo,
+    wuffs_base__io_buffer* a_src);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64
+wuffs_tiff__decoder__workbuf_len(
+    const wuffs_tiff__decoder* self);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+// ---------------- Struct Definitions
+
+// These structs' fields, and the sizeof them, are private implementation
+// details that aren't guaranteed to be stable across Wuffs versions.
+//
+// See https://en.wikipedia.org/wiki/Opaque_pointer#C
+
+#if defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
+
+struct wuffs_tiff__decoder__struct {
+  // Do not access the private_impl's or private_data's fields directly. There
+  // is no API/ABI compatibility or safety guarantee if you do so. Instead, use
+  // the wuffs_foo__bar__baz functions.
+  //
+  // It is a struct, not a struct*, so that the outermost wuffs_foo__bar struct
+  // can be stack allocated when WUFFS_IMPLEMENTATION is defined.
+
+  struct {
+    uint32_t magic;
+    uint32_t active_coroutine;
+    wuffs_base__vtable vtable_for__wuffs_base__image_decoder;
+    wuffs_base__vtable null_vtable;
+#if defined(WUFFS_CONFIG__STATS)
+    wuffs_base__stats stats;
+#endif  // defined(WUFFS_CONFIG__STATS)
+
+    uint32_t f_width;
+    uint32_t f_height;
+    uint8_t f_call_sequence;
+    bool f_big_endian;
+    bool f_is_tiled;
+    bool f_is_opaque;
+    bool f_ignore_checksum;
+    uint64_t f_ifd_io_position;
+    uint64_t f_io_seek_position_value;
+    uint32_t f_compression;
+    uint32_t f_photometric;
+    uint32_t f_predictor;
+    uint32_t f_planar_configuration;
+    uint32_t f_samples_per_pixel;
+    uint32_t f_fill_order;
+    uint32_t f_extra_samples;
+    uint32_t f_rows_per_strip;
+    uint32_t f_tile_width;
+    uint32_t f_tile_length;
+    uint32_t f_array_types[5];
+    uint32_t f_array_counts[5];
+    uint32_t f_array_values[5];
+    uint32_t f_bits_per_sample;
+    uint32_t f_bits_per_pixel;
+    uint32_t f_chunk_width;
+    uint32_t f_chunk_height;
+    uint32_t f_chunks_across;
+    uint32_t f_chunks_down;
+    uint32_t f_num_chunks;
+    uint64_t f_chunk_bytes_per_row;
+    uint64_t f_chunk_wi;
+    uint64_t f_chunk_wend;
+    uint64_t f_chunk_io_position_end;
+    uint64_t f_workbuf_offsets[4];
+    uint32_t f_src_pixfmt;
+    uint32_t f_dst_pixfmt;
+    uint32_t f_roi_x0;
+    uint32_t f_roi_y0;
+    uint32_t f_roi_x1;
+    uint32_t f_roi_y1;
+    wuffs_base__pixel_swizzler f_swizzler;
+
+    uint32_t p_decode_chunk[1];
+    uint32_t p_decode_image_config[1];
+    uint32_t p_decode_ifd[1];
+    uint32_t p_read_array[1];
+    uint32_t p_seek[1];
+    uint32_t p_decode_frame_config[1];
+    uint32_t p_decode_frame[1];
+  } private_impl;
+
+  struct {
+    wuffs_lzw__decoder f_lzw;
+    wuffs_zlib__decoder f_zlib;
+    uint8_t f_src_palette[1024];
+    uint8_t f_dst_palette[1024];
+
+    struct {
+      uint64_t v_pos;
+    } s_decode_chunk[1];
+    struct {
+      uint64_t scratch;
+    } s_decode_image_config[1];
+    struct {
+      uint64_t scratch;
+      uint32_t v_num_entries;
+      uint32_t v_tag;
+      uint32_t v_type;
+      uint32_t v_count;
+    } s_decode_ifd[1];
+    struct {
+      uint64_t scratch;
+      uint64_t v_pos;
+      uint32_t v_type;
+      uint32_t v_i;
+    } s_read_array[1];
+    struct {
+      uint64_t scratch;
+    } s_seek[1];
+    struct {
+      uint32_t v_cx0;
+      uint32_t v_cx1;
+      uint32_t v_cy0;
+      uint32_t v_cy1;
+      uint32_t v_cx;
+      uint32_t v_cy;
+    } s_decode_frame[1];
+  } private_data;
+
+#ifdef __cplusplus
+#if defined(WUFFS_BASE__HAVE_UNIQUE_PTR)
+  using unique_ptr = std::unique_ptr<wuffs_tiff__decoder, decltype(&free)>;
+
+  // On failure, the alloc_etc functions return nullptr. They don't throw.
+
+  static inline unique_ptr
+  alloc() {
+    return unique_ptr(wuffs_tiff__decoder__alloc(), &free);
+  }
+
+  static inline wuffs_base__image_decoder::unique_ptr
+  alloc_as__wuffs_base__image_decoder() {
+    return wuffs_base__image_decoder::unique_ptr(
+        wuffs_tiff__decoder__alloc_as__wuffs_base__image_decoder(), &free);
+  }
+#endif  // defined(WUFFS_BASE__HAVE_UNIQUE_PTR)
+
+#if defined(WUFFS_BASE__HAVE_EQ_DELETE) && !defined(WUFFS_IMPLEMENTATION)
+  // Disallow constructing or copying an object via standard C++ mechanisms,
+  // e.g. the "new" operator, as this struct is intentionally opaque. Its total
+  // size and field layout is not part of the public, stable, memory-safe API.
+  // Use malloc or memcpy and the sizeof__wuffs_foo__bar function instead, and
+  // call wuffs_foo__bar__baz methods (which all take a "this"-like pointer as
+  // their first argument) rather than tweaking bar.private_impl.qux fields.
+  //
+  // In C, we can just leave wuffs_foo__bar as an incomplete type (unless
+  // WUFFS_IMPLEMENTATION is #define'd). In C++, we define a complete type in
+  // order to provide convenience methods. These forward on "this", so that you
+  // can write "bar->baz(etc)" instead of "wuffs_foo__bar__baz(bar, etc)".
+  wuffs_tiff__decoder__struct() = delete;
+  wuffs_tiff__decoder__struct(const wuffs_tiff__decoder__struct&) = delete;
+  wuffs_tiff__decoder__struct& operator=(
+      const wuffs_tiff__decoder__struct&) = delete;
+#endif  // defined(WUFFS_BASE__HAVE_EQ_DELETE) && !defined(WUFFS_IMPLEMENTATION)
+
+#if !defined(WUFFS_IMPLEMENTATION)
+  // As above, the size of the struct is not part of the public API, and unless
+  // WUFFS_IMPLEMENTATION is #define'd, this struct type T should be heap
+  // allocated, not stack allocated. Its size is not intended to be known at
+  // compile time, but it is unfortunately divulged as a side effect of
+  // defining C++ convenience methods. Use "sizeof__T()", calling the function,
+  // instead of "sizeof T", invoking the operator. To make the two values
+  // different, so that passing the latter will be rejected by the initialize
+  // function, we add an arbitrary amount of dead weight.
+  uint8_t dead_weight[123000000];  // 123 MB.
+#endif  // !defined(WUFFS_IMPLEMENTATION)
+
+  inline wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+  initialize(
+      size_t sizeof_star_self,
+      uint64_t wuffs_version,
+      uint32_t options) {
+    return wuffs_tiff__decoder__initialize(
+        this, sizeof_star_self, wuffs_version, options);
+  }
+
+  inline wuffs_base__stats
+  stats() const {
+    return wuffs_tiff__decoder__stats(this);
+  }
+
+  inline wuffs_base__image_decoder*
+  upcast_as__wuffs_base__image_decoder() {
+    return (wuffs_base__image_decoder*)this;
+  }
+
+  inline wuffs_base__empty_struct
+  set_quirk_enabled(
+      uint32_t a_quirk,
+      bool a_enabled) {
+    return wuffs_tiff__decoder__set_quirk_enabled(this, a_quirk, a_enabled);
+  }
+
+  inline uint64_t
+  io_seek_position() const {
+    return wuffs_tiff__decoder__io_seek_position(this);
+  }
+
+  inline uint32_t
+  num_strips_or_tiles() const {
+    return wuffs_tiff__decoder__num_strips_or_tiles(this);
+  }
+
+  inline wuffs_base__rect_ie_u32
+  strip_or_tile_rect(
+      uint32_t a_i) const {
+    return wuffs_tiff__decoder__strip_or_tile_rect(this, a_i);
+  }
+
+  inline wuffs_base__status
+  decode_image_config(
+      wuffs_base__image_config* a_dst,
+      wuffs_base__io_buffer* a_src) {
+    return wuffs_tiff__decoder__decode_image_config(this, a_dst, a_src);
+  }
+
+  inline wuffs_base__status
+  decode_frame_config(
+      wuffs_base__frame_config* a_dst,
+      wuffs_base__io_buffer* a_src) {
+    return wuffs_tiff__decoder__decode_frame_config(this, a_dst, a_src);
+  }
+
+  inline wuffs_base__status
+  decode_frame(
+      wuffs_base__pixel_buffer* a_dst,
+      wuffs_base__io_buffer* a_src,
+      wuffs_base__pixel_blend a_blend,
+      wuffs_base__slice_u8 a_workbuf,
+      wuffs_base__decode_frame_options* a_opts) {
+    return wuffs_tiff__decoder__decode_frame(this, a_dst, a_src, a_blend, a_workbuf, a_opts);
+  }
+
+  inline bool
+  can_decode_row_bands() const {
+    return wuffs_tiff__decoder__can_decode_row_bands(this);
+  }
+
+  inline wuffs_base__rect_ie_u32
+  frame_dirty_rect() const {
+    return wuffs_tiff__decoder__frame_dirty_rect(this);
+  }
+
+  inline uint32_t
+  num_animation_loops() const {
+    return wuffs_tiff__decoder__num_animation_loops(this);
+  }
+
+  inline uint64_t
+  num_decoded_frame_configs() const {
+    return wuffs_tiff__decoder__num_decoded_frame_configs(this);
+  }
+
+  inline uint64_t
+  num_decoded_frames() const {
+    return wuffs_tiff__decoder__num_decoded_frames(this);
+  }
+
+  inline wuffs_base__status
+  restart_frame(
+      uint64_t a_index,
+      uint64_t a_io_position) {
+    return wuffs_tiff__decoder__restart_frame(this, a_index, a_io_position);
+  }
+
+  inline wuffs_base__empty_struct
+  set_report_metadata(
+      uint32_t a_fourcc,
+      bool a_report) {
+    return wuffs_tiff__decoder__set_report_metadata(this, a_fourcc, a_report);
+  }
+
+  inline wuffs_base__status
+  tell_me_more(
+      wuffs_base__io_buffer* a_dst,
+      wuffs_base__more_information* a_minfo,
+      wuffs_base__io_buffer* a_src) {
+    return wuffs_tiff__decoder__tell_me_more(this, a_dst, a_minfo, a_src);
+  }
+
+  inline wuffs_base__range_ii_u64
+  workbuf_len() const {
+    return wuffs_tiff__decoder__workbuf_len(this);
+  }
+
+#endif  // __cplusplus
+};  // struct wuffs_tiff__decoder__struct
+
+#endif  // defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
+
+
+// ‼ WUFFS C HEADER ENDS HERE.
+#ifdef WUFFS_IMPLEMENTATION
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__TIFF)
+
+// ---------------- Status Codes Implementations
+
+const char wuffs_tiff__error__bad_header[] = "#tiff: bad header";
+const char wuffs_tiff__error__truncated_input[] = "#tiff: truncated input";
+const char wuffs_tiff__error__unsupported_tiff_file[] = "#tiff: unsupported TIFF file";
+const char wuffs_tiff__error__internal_error_inconsistent_workbuf_length[] = "#tiff: internal error: inconsistent workbuf length";
+
+// ---------------- Private Consts
+
+#define WUFFS_TIFF__ARRAY_BITS_PER_SAMPLE 0
+
+#define WUFFS_TIFF__ARRAY_SAMPLE_FORMAT 1
+
+#define WUFFS_TIFF__ARRAY_COLOR_MAP 2
+
+#define WUFFS_TIFF__ARRAY_OFFSETS 3
+
+#define WUFFS_TIFF__ARRAY_BYTE_COUNTS 4
+
+#define WUFFS_TIFF__TYPE_SHORT 3
+
+#define WUFFS_TIFF__TYPE_LONG 4
+
+#define WUFFS_TIFF__COMPRESSION_NONE 1
+
+#define WUFFS_TIFF__COMPRESSION_LZW 5
+
+#define WUFFS_TIFF__COMPRESSION_DEFLATE 8
+
+#define WUFFS_TIFF__COMPRESSION_DEFLATE_OLD 32946
+
+#define WUFFS_TIFF__COMPRESSION_PACKBITS 32773
+
+#define WUFFS_TIFF__ZLIB_WORKBUF_LENGTH 33025
+
+#define WUFFS_TIFF__MAX_INCL_NUM_CHUNKS 16777215
+
+// ---------------- Private Initializer Prototypes
+
+// ---------------- Private Function Prototypes
+
+static wuffs_base__status
+wuffs_tiff__decoder__decode_chunk(
+    wuffs_tiff__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf,
+    uint32_t a_i);
+
+static wuffs_base__status
+wuffs_tiff__decoder__load_chunk_table_entry(
+    wuffs_tiff__decoder* self,
+    wuffs_base__slice_u8 a_workbuf,
+    uint32_t a_i);
+
+static wuffs_base__empty_struct
+wuffs_tiff__decoder__decode_uncompressed(
+    wuffs_tiff__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf);
+
+static wuffs_base__empty_struct
+wuffs_tiff__decoder__decode_packbits(
+    wuffs_tiff__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf);
+
+static wuffs_base__empty_struct
+wuffs_tiff__decoder__post_process_chunk(
+    wuffs_tiff__decoder* self,
+    wuffs_base__slice_u8 a_workbuf);
+
+static wuffs_base__empty_struct
+wuffs_tiff__decoder__zero_fill(
+    wuffs_tiff__decoder* self,
+    wuffs_base__slice_u8 a_s);
+
+static wuffs_base__empty_struct
+wuffs_tiff__decoder__invert(
+    wuffs_tiff__decoder* self,
+    wuffs_base__slice_u8 a_s);
+
+static wuffs_base__empty_struct
+wuffs_tiff__decoder__undo_predictor_8(
+    wuffs_tiff__decoder* self,
+    wuffs_base__slice_u8 a_row);
+
+static wuffs_base__empty_struct
+wuffs_tiff__decoder__post_process_row_16(
+    wuffs_tiff__decoder* self,
+    wuffs_base__slice_u8 a_row);
+
+static wuffs_base__status
+wuffs_tiff__decoder__swizzle_chunk(
+    wuffs_tiff__decoder* self,
+    wuffs_base__pixel_buffer* a_dst,
+    wuffs_base__slice_u8 a_workbuf,
+    uint32_t a_cx,
+    uint32_t a_cy);
+
+static wuffs_base__status
+wuffs_tiff__decoder__decode_ifd(
+    wuffs_tiff__decoder* self,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status
+wuffs_tiff__decoder__decode_ifd_entry(
+    wuffs_tiff__decoder* self,
+    uint32_t a_tag,
+    uint32_t a_type,
+    uint32_t a_count,
+    uint32_t a_value);
+
+static wuffs_base__status
+wuffs_tiff__decoder__validate_ifd(
+    wuffs_tiff__decoder* self);
+
+static wuffs_base__empty_struct
+wuffs_tiff__decoder__clear_src_palette(
+    wuffs_tiff__decoder* self);
+
+static wuffs_base__status
+wuffs_tiff__decoder__read_array(
+    wuffs_tiff__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf,
+    uint32_t a_a,
+    uint32_t a_first,
+    uint32_t a_n);
+
+static wuffs_base__status
+wuffs_tiff__decoder__store_array_element(
+    wuffs_tiff__decoder* self,
+    wuffs_base__slice_u8 a_workbuf,
+    uint32_t a_a,
+    uint32_t a_index,
+    uint32_t a_x);
+
+static uint32_t
+wuffs_tiff__decoder__u16(
+    const wuffs_tiff__decoder* self,
+    uint32_t a_x);
+
+static uint32_t
+wuffs_tiff__decoder__u32(
+    const wuffs_tiff__decoder* self,
+    uint32_t a_x);
+
+static wuffs_base__status
+wuffs_tiff__decoder__seek(
+    wuffs_tiff__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    uint64_t a_pos);
+
+// ---------------- VTables
+
+const wuffs_base__image_decoder__func_ptrs
+wuffs_tiff__decoder__func_ptrs_for__wuffs_base__image_decoder = {
+  (bool(*)(const void*))(&wuffs_tiff__decoder__can_decode_row_bands),
+  (wuffs_base__status(*)(void*,
+      wuffs_base__pixel_buffer*,
+      wuffs_base__io_buffer*,
+      wuffs_base__pixel_blend,
+      wuffs_base__slice_u8,
+      wuffs_base__decode_frame_options*))(&wuffs_tiff__decoder__decode_frame),
+  (wuffs_base__status(*)(void*,
+      wuffs_base__frame_config*,
+      wuffs_base__io_buffer*))(&wuffs_tiff__decoder__decode_frame_config),
+  (wuffs_base__status(*)(void*,
+      wuffs_base__image_config*,
+      wuffs_base__io_buffer*))(&wuffs_tiff__decoder__decode_image_config),
+  (wuffs_base__rect_ie_u32(*)(const void*))(&wuffs_tiff__decoder__frame_dirty_rect),
+  (uint32_t(*)(const void*))(&wuffs_tiff__decoder__num_animation_loops),
+  (uint64_t(*)(const void*))(&wuffs_tiff__decoder__num_decoded_frame_configs),
+  (uint64_t(*)(const void*))(&wuffs_tiff__decoder__num_decoded_frames),
+  (wuffs_base__status(*)(void*,
+      uint64_t,
+      uint64_t))(&wuffs_tiff__decoder__restart_frame),
+  (wuffs_base__empty_struct(*)(void*,
+      uint32_t,
+      bool))(&wuffs_tiff__decoder__set_quirk_enabled),
+  (wuffs_base__empty_struct(*)(void*,
+      uint32_t,
+      bool))(&wuffs_tiff__decoder__set_report_metadata),
+  (wuffs_base__status(*)(void*,
+      wuffs_base__io_buffer*,
+      wuffs_base__more_information*,
+      wuffs_base__io_buffer*))(&wuffs_tiff__decoder__tell_me_more),
+  (wuffs_base__range_ii_u64(*)(const void*))(&wuffs_tiff__decoder__workbuf_len),
+};
+
+// ---------------- Initializer Implementations
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+wuffs_tiff__decoder__initialize(
+    wuffs_tiff__decoder* self,
+    size_t sizeof_star_self,
+    uint64_t wuffs_version,
+    uint32_t options){
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  }
+
+  if ((options & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+    // The whole point of this if-check is to detect an uninitialized *self.
+    // We disable the warning on GCC. Clang-5.0 does not have this warning.
+    //
+    // The caller promises that *self is zeroed, so the empty asm tells GCC
+    // that private_impl is defined. Otherwise, once this function and a
+    // small method (e.g. one that reads a "choose" guard field) are both
+    // inlined into the caller, GCC -O3 warns about that method's read.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    __asm__ __volatile__("" : "+m"(self->private_impl));
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((options & WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      options |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    }
+  }
+
+  {
+    wuffs_base__status z = wuffs_lzw__decoder__initialize(
+        &self->private_data.f_lzw, sizeof(self->private_data.f_lzw), WUFFS_VERSION, options);
+    if (z.repr) {
+      return z;
+    }
+  }
+  {
+    wuffs_base__status z = wuffs_zlib__decoder__initialize(
+        &self->private_data.f_zlib, sizeof(self->private_data.f_zlib), WUFFS_VERSION, options);
+    if (z.repr) {
+      return z;
+    }
+  }
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__image_decoder.vtable_name =
+      wuffs_base__image_decoder__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__image_decoder.function_pointers =
+      (const void*)(&wuffs_tiff__decoder__func_ptrs_for__wuffs_base__image_decoder);
+  return wuffs_base__make_status(NULL);
+}
+
+wuffs_tiff__decoder*
+wuffs_tiff__decoder__alloc() {
+  wuffs_tiff__decoder* x =
+      (wuffs_tiff__decoder*)(calloc(sizeof(wuffs_tiff__decoder), 1));
+  if (!x) {
+    return NULL;
+  }
+  if (wuffs_tiff__decoder__initialize(
+      x, sizeof(wuffs_tiff__decoder), WUFFS_VERSION, WUFFS_INITIALIZE__ALREADY_ZEROED).repr) {
+    free(x);
+    return NULL;
+  }
+  return x;
+}
+
+size_t
+sizeof__wuffs_tiff__decoder() {
+  return sizeof(wuffs_tiff__decoder);
+}
+
+wuffs_base__stats
+wuffs_tiff__decoder__stats(
+    const wuffs_tiff__decoder* self) {
+  wuffs_base__stats ret = wuffs_base__make_empty_stats();
+#if defined(WUFFS_CONFIG__STATS)
+  if (!self) {
+    return ret;
+  }
+  ret = self->private_impl.stats;
+  {
+    wuffs_base__stats z = wuffs_lzw__decoder__stats(&self->private_data.f_lzw);
+    wuffs_base__stats__accumulate(&ret, &z);
+  }
+  {
+    wuffs_base__stats z = wuffs_zlib__decoder__stats(&self->private_data.f_zlib);
+    wuffs_base__stats__accumulate(&ret, &z);
+  }
+#else
+  (void)(self);
+#endif  // defined(WUFFS_CONFIG__STATS)
+  return ret;
+}
+
+// ---------------- Function Implementations
+
+// -------- func tiff.decoder.decode_chunk
+
+static wuffs_base__status
+wuffs_tiff__decoder__decode_chunk(
+    wuffs_tiff__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf,
+    uint32_t a_i) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  uint64_t v_pos = 0;
+  wuffs_base__io_buffer u_w = wuffs_base__empty_io_buffer();
+  wuffs_base__io_buffer* v_w = &u_w;
+  uint8_t* iop_v_w WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io0_v_w WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_v_w WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_v_w WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint64_t v_w_mark = 0;
+  wuffs_base__status v_codec_status = wuffs_base__make_status(NULL);
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_chunk[0];
+  if (coro_susp_point) {
+    v_pos = self->private_data.s_decode_chunk[0].v_pos;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    v_status = wuffs_tiff__decoder__load_chunk_table_entry(self, a_workbuf, a_i);
+    if ( ! wuffs_base__status__is_ok(&v_status)) {
+      status = v_status;
+      if (wuffs_base__status__is_error(&status)) {
+        goto exit;
+      } else if (wuffs_base__status__is_suspension(&status)) {
+        status = wuffs_base__make_status(wuffs_base__error__cannot_return_a_suspension);
+        goto exit;
+      }
+      goto ok;
+    }
+    v_pos = self->private_impl.f_io_seek_position_value;
+    if (a_src) {
+      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+    status = wuffs_tiff__decoder__seek(self, a_src, v_pos);
+    if (a_src) {
+      iop_a_src = a_src->data.ptr + a_src->meta.ri;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
+    if ((self->private_impl.f_compression == 1) || (self->private_impl.f_compression == 32773)) {
+      while (true) {
+        {
+          const uint8_t *o_0_io2_a_src = io2_a_src;
+          wuffs_base__io_reader__limit(&io2_a_src, iop_a_src,
+              wuffs_base__u64__sat_sub(self->private_impl.f_chunk_io_position_end, wuffs_base__u64__sat_add((a_src ? a_src->meta.pos : 0), ((uint64_t)(iop_a_src - io0_a_src)))));
+          if (a_src) {
+            a_src->meta.wi = ((size_t)(io2_a_src - a_src->data.ptr));
+          }
+          if (self->private_impl.f_compression == 1) {
+            if (a_src) {
+              a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+            }
+            wuffs_tiff__decoder__decode_uncompressed(self, a_src, a_workbuf);
+            if (a_src) {
+              iop_a_src = a_src->data.ptr + a_src->meta.ri;
+            }
+          } else {
+            if (a_src) {
+              a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+            }
+            wuffs_tiff__decoder__decode_packbits(self, a_src, a_workbuf);
+            if (a_src) {
+              iop_a_src = a_src->data.ptr + a_src->meta.ri;
+            }
+          }
+          io2_a_src = o_0_io2_a_src;
+          if (a_src) {
+            a_src->meta.wi = ((size_t)(io2_a_src - a_src->data.ptr));
+          }
+        }
+        if ((self->private_impl.f_chunk_wi >= self->private_impl.f_chunk_wend) || (wuffs_base__u64__sat_add((a_src ? a_src->meta.pos : 0), ((uint64_t)(iop_a_src - io0_a_src))) >= self->private_impl.f_chunk_io_position_end) || (((uint64_t)(io2_a_src - iop_a_src)) >= wuffs_base__u64__sat_sub(self->private_impl.f_chunk_io_position_end, wuffs_base__u64__sat_add((a_src ? a_src->meta.pos : 0), ((uint64_t)(iop_a_src - io0_a_src)))))) {
+          goto label__0__break;
+        } else if (a_src && a_src->meta.closed) {
+          status = wuffs_base__make_status(wuffs_tiff__error__truncated_input);
+          goto exit;
+        }
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(2);
+      }
+      label__0__break:;
+      status = wuffs_base__make_status(NULL);
+      goto ok;
+    }
+    if (self->private_impl.f_compression == 5) {
+      wuffs_base__ignore_status(wuffs_lzw__decoder__initialize(&self->private_data.f_lzw,
+          sizeof (wuffs_lzw__decoder), WUFFS_VERSION, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+      wuffs_lzw__decoder__set_quirk_enabled(&self->private_data.f_lzw, 1348378624, true);
+      wuffs_lzw__decoder__set_quirk_enabled(&self->private_data.f_lzw, 1348378625, true);
+      wuffs_lzw__decoder__set_literal_width(&self->private_data.f_lzw, 8);
+    } else {
+      wuffs_base__ignore_status(wuffs_zlib__decoder__initialize(&self->private_data.f_zlib,
+          sizeof (wuffs_zlib__decoder), WUFFS_VERSION, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+      if (self->private_impl.f_ignore_checksum) {
+        wuffs_zlib__decoder__set_quirk_enabled(&self->private_data.f_zlib, 1, true);
+      }
+    }
+    while (true) {
+      if ((self->private_impl.f_workbuf_offsets[0] > self->private_impl.f_workbuf_offsets[1]) ||
+          (self->private_impl.f_workbuf_offsets[1] > ((uint64_t)(a_workbuf.len))) ||
+          (self->private_impl.f_chunk_wi > self->private_impl.f_chunk_wend) ||
+          (self->private_impl.f_chunk_wend > ((uint64_t)(a_workbuf.len)))) {
+        status = wuffs_base__make_status(wuffs_tiff__error__internal_error_inconsistent_workbuf_length);
+        goto exit;
+      }
+      {
+        wuffs_base__io_buffer* o_1_v_w = v_w;
+        uint8_t *o_1_iop_v_w = iop_v_w;
+        uint8_t *o_1_io0_v_w = io0_v_w;
+        uint8_t *o_1_io1_v_w = io1_v_w;
+        uint8_t *o_1_io2_v_w = io2_v_w;
+        v_w = wuffs_base__io_writer__set(
+            &u_w,
+            &iop_v_w,
+            &io0_v_w,
+            &io1_v_w,
+            &io2_v_w,
+            wuffs_base__slice_u8__subslice_ij(a_workbuf,
+            self->private_impl.f_chunk_wi,
+            self->private_impl.f_chunk_wend),
+            ((uint64_t)(self->private_impl.f_chunk_wi - self->private_impl.f_workbuf_offsets[2])));
+        {
+          const uint8_t *o_2_io2_a_src = io2_a_src;
+          wuffs_base__io_reader__limit(&io2_a_src, iop_a_src,
+              wuffs_base__u64__sat_sub(self->private_impl.f_chunk_io_position_end, wuffs_base__u64__sat_add((a_src ? a_src->meta.pos : 0), ((uint64_t)(iop_a_src - io0_a_src)))));
+          if (a_src) {
+            a_src->meta.wi = ((size_t)(io2_a_src - a_src->data.ptr));
+          }
+          v_w_mark = ((uint64_t)(iop_v_w - io0_v_w));
+          if (self->private_impl.f_compression == 5) {
+            {
+              u_w.meta.wi = ((size_t)(iop_v_w - u_w.data.ptr));
+              if (a_src) {
+                a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+              }
+              wuffs_base__status t_0 = wuffs_lzw__decoder__transform_io(&self->private_data.f_lzw, v_w, a_src, wuffs_base__utility__empty_slice_u8());
+              v_codec_status = t_0;
+              iop_v_w = u_w.data.ptr + u_w.meta.wi;
+              if (a_src) {
+                iop_a_src = a_src->data.ptr + a_src->meta.ri;
+              }
+            }
+          } else {
+            {
+              u_w.meta.wi = ((size_t)(iop_v_w - u_w.data.ptr));
+              if (a_src) {
+                a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+              }
+              wuffs_base__status t_1 = wuffs_zlib__decoder__transform_io(&self->private_data.f_zlib, v_w, a_src, wuffs_base__slice_u8__subslice_ij(a_workbuf,
+                  self->private_impl.f_workbuf_offsets[0],
+                  self->private_impl.f_workbuf_offsets[1]));
+              v_codec_status = t_1;
+              iop_v_w = u_w.data.ptr + u_w.meta.wi;
+              if (a_src) {
+                iop_a_src = a_src->data.ptr + a_src->meta.ri;
+              }
+            }
+          }
+          wuffs_base__u64__sat_add_indirect(&self->private_impl.f_chunk_wi, wuffs_base__io__count_since(v_w_mark, ((uint64_t)(iop_v_w - io0_v_w))));
+          io2_a_src = o_2_io2_a_src;
+          if (a_src) {
+            a_src->meta.wi = ((size_t)(io2_a_src - a_src->data.ptr));
+          }
+        }
+        v_w = o_1_v_w;
+        iop_v_w = o_1_iop_v_w;
+        io0_v_w = o_1_io0_v_w;
+        io1_v_w = o_1_io1_v_w;
+        io2_v_w = o_1_io2_v_w;
+      }
+      if (wuffs_base__status__is_ok(&v_codec_status) || (v_codec_status.repr == wuffs_base__suspension__short_write)) {
+        goto label__1__break;
+      } else if (v_codec_status.repr != wuffs_base__suspension__short_read) {
+        status = v_codec_status;
+        if (wuffs_base__status__is_error(&status)) {
+          goto exit;
+        } else if (wuffs_base__status__is_suspension(&status)) {
+          status = wuffs_base__make_status(wuffs_base__error__cannot_return_a_suspension);
+          goto exit;
+        }
+        goto ok;
+      } else if (wuffs_base__u64__sat_add((a_src ? a_src->meta.pos : 0), ((uint64_t)(iop_a_src - io0_a_src))) >= self->private_impl.f_chunk_io_position_end) {
+        goto label__1__break;
+      } else if (a_src && a_src->meta.closed) {
+        status = wuffs_base__make_status(wuffs_tiff__error__truncated_input);
+        goto exit;
+      }
+      status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(3);
+    }
+    label__1__break:;
+
+    ok:
+    self->private_impl.p_decode_chunk[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_chunk[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_decode_chunk[0].v_pos = v_pos;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func tiff.decoder.load_chunk_table_entry
+
+static wuffs_base__status
+wuffs_tiff__decoder__load_chunk_table_entry(
+    wuffs_tiff__decoder* self,
+    wuffs_base__slice_u8 a_workbuf,
+    uint32_t a_i) {
+  wuffs_base__slice_u8 v_entry = {0};
+  uint64_t v_j = 0;
+  uint64_t v_offset = 0;
+  uint64_t v_byte_count = 0;
+  uint32_t v_rows = 0;
+
+  v_j = (((uint64_t)(a_i)) * 4);
+  if (v_j > ((uint64_t)(a_workbuf.len))) {
+    return wuffs_base__make_status(wuffs_tiff__error__internal_error_inconsistent_workbuf_length);
+  }
+  v_entry = wuffs_base__slice_u8__subslice_i(a_workbuf, v_j);
+  if (((uint64_t)(v_entry.len)) < 4) {
+    return wuffs_base__make_status(wuffs_tiff__error__internal_error_inconsistent_workbuf_length);
+  }
+  v_offset = ((uint64_t)(wuffs_base__peek_u32le__no_bounds_check(v_entry.ptr)));
+  v_j = ((((uint64_t)(a_i)) + ((uint64_t)(self->private_impl.f_num_chunks))) * 4);
+  if (v_j > ((uint64_t)(a_workbuf.len))) {
+    return wuffs_base__make_status(wuffs_tiff__error__internal_error_inconsistent_workbuf_length);
+  }
+  v_entry = wuffs_base__slice_u8__subslice_i(a_workbuf, v_j);
+  if (((uint64_t)(v_entry.len)) < 4) {
+    return wuffs_base__make_status(wuffs_tiff__error__internal_error_inconsistent_workbuf_length);
+  }
+  v_byte_count = ((uint64_t)(wuffs_base__peek_u32le__no_bounds_check(v_entry.ptr)));
+  v_rows = self->private_impl.f_chunk_height;
+  if ( ! self->private_impl.f_is_tiled && (self->private_impl.f_chunks_across > 0)) {
+    v_rows = wuffs_base__u32__min(v_rows, wuffs_base__u32__sat_sub(self->private_impl.f_height, ((uint32_t)((a_i / self->private_impl.f_chunks_across) * self->private_impl.f_chunk_height))));
+  }
+  self->private_impl.f_io_seek_position_value = v_offset;
+  self->private_impl.f_chunk_io_position_end = (v_offset + v_byte_count);
+  self->private_impl.f_chunk_wi = self->private_impl.f_workbuf_offsets[2];
+  self->private_impl.f_chunk_wend = wuffs_base__u64__sat_add(self->private_impl.f_workbuf_offsets[2], (self->private_impl.f_chunk_bytes_per_row * ((uint64_t)(v_rows))));
+  if (self->private_impl.f_chunk_wend > self->private_impl.f_workbuf_offsets[3]) {
+    return wuffs_base__make_status(wuffs_tiff__error__internal_error_inconsistent_workbuf_length);
+  }
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func tiff.decoder.decode_uncompressed
+
+static wuffs_base__empty_struct
+wuffs_tiff__decoder__decode_uncompressed(
+    wuffs_tiff__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf) {
+  uint32_t v_n = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  if ((self->private_impl.f_chunk_wi > self->private_impl.f_chunk_wend) || (self->private_impl.f_chunk_wend > ((uint64_t)(a_workbuf.len)))) {
+    if (a_src) {
+      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+    }
+    return wuffs_base__make_empty_struct();
+  }
+  v_n = wuffs_base__io_reader__limited_copy_u32_to_slice(
+      &iop_a_src, io2_a_src,4294967295, wuffs_base__slice_u8__subslice_ij(a_workbuf,
+      self->private_impl.f_chunk_wi,
+      self->private_impl.f_chunk_wend));
+  wuffs_base__u64__sat_add_indirect(&self->private_impl.f_chunk_wi, ((uint64_t)(v_n)));
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func tiff.decoder.decode_packbits
+
+static wuffs_base__empty_struct
+wuffs_tiff__decoder__decode_packbits(
+    wuffs_tiff__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf) {
+  wuffs_base__slice_u8 v_dst = {0};
+  uint64_t v_i = 0;
+  uint32_t v_n = 0;
+  uint32_t v_m = 0;
+  uint8_t v_c = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  if ((self->private_impl.f_chunk_wi > self->private_impl.f_chunk_wend) || (self->private_impl.f_chunk_wend > ((uint64_t)(a_workbuf.len)))) {
+    if (a_src) {
+      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+    }
+    return wuffs_base__make_empty_struct();
+  }
+  v_dst = wuffs_base__slice_u8__subslice_ij(a_workbuf,
+      self->private_impl.f_chunk_wi,
+      self->private_impl.f_chunk_wend);
+  while (v_i < ((uint64_t)(v_dst.len))) {
+    if (((uint64_t)(io2_a_src - iop_a_src)) < 1) {
+      goto label__0__break;
+    }
+    v_n = ((uint32_t)(wuffs_base__peek_u8be__no_bounds_check(iop_a_src)));
+    if (v_n < 128) {
+      if (((uint64_t)(io2_a_src - iop_a_src)) <= (((uint64_t)(v_n)) + 1)) {
+        goto label__0__break;
+      }
+      iop_a_src += 1;
+      v_m = wuffs_base__io_reader__limited_copy_u32_to_slice(
+          &iop_a_src, io2_a_src,(v_n + 1), wuffs_base__slice_u8__subslice_i(v_dst, v_i));
+      wuffs_base__u64__sat_add_indirect(&v_i, ((uint64_t)(v_m)));
+    } else if (v_n > 128) {
+      if (((uint64_t)(io2_a_src - iop_a_src)) < 2) {
+        goto label__0__break;
+      }
+      v_c = ((uint8_t)((((uint32_t)(wuffs_base__peek_u16le__no_bounds_check(iop_a_src))) >> 8)));
+      iop_a_src += 2;
+      v_m = (257 - v_n);
+      while ((v_m > 0) && (v_i < ((uint64_t)(v_dst.len)))) {
+        v_dst.ptr[v_i] = v_c;
+        wuffs_base__u64__sat_add_indirect(&v_i, 1);
+        v_m -= 1;
+      }
+    } else {
+      iop_a_src += 1;
+    }
+  }
+  label__0__break:;
+  wuffs_base__u64__sat_add_indirect(&self->private_impl.f_chunk_wi, v_i);
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func tiff.decoder.post_process_chunk
+
+static wuffs_base__empty_struct
+wuffs_tiff__decoder__post_process_chunk(
+    wuffs_tiff__decoder* self,
+    wuffs_base__slice_u8 a_workbuf) {
+  wuffs_base__slice_u8 v_chunk = {0};
+  wuffs_base__slice_u8 v_row = {0};
+  uint64_t v_bpr = 0;
+
+  if ((self->private_impl.f_workbuf_offsets[2] > self->private_impl.f_chunk_wend) || (self->private_impl.f_chunk_wi > self->private_impl.f_chunk_wend) || (self->private_impl.f_chunk_wend > ((uint64_t)(a_workbuf.len)))) {
+    return wuffs_base__make_empty_struct();
+  }
+  v_chunk = wuffs_base__slice_u8__subslice_ij(a_workbuf,
+      self->private_impl.f_workbuf_offsets[2],
+      self->private_impl.f_chunk_wend);
+  wuffs_tiff__decoder__zero_fill(self, wuffs_base__slice_u8__subslice_ij(a_workbuf,
+      self->private_impl.f_chunk_wi,
+      self->private_impl.f_chunk_wend));
+  if ((self->private_impl.f_predictor != 2) && (self->private_impl.f_photometric != 0) && ((self->private_impl.f_bits_per_sample != 16) || self->private_impl.f_big_endian)) {
+    return wuffs_base__make_empty_struct();
+  }
+  v_bpr = self->private_impl.f_chunk_bytes_per_row;
+  while ((0 < v_bpr) && (v_bpr <= ((uint64_t)(v_chunk.len)))) {
+    v_row = wuffs_base__slice_u8__subslice_j(v_chunk, v_bpr);
+    v_chunk = wuffs_base__slice_u8__subslice_i(v_chunk, v_bpr);
+    if (self->private_impl.f_bits_per_sample == 16) {
+      wuffs_tiff__decoder__post_process_row_16(self, v_row);
+    } else if (self->private_impl.f_predictor == 2) {
+      wuffs_tiff__decoder__undo_predictor_8(self, v_row);
+    }
+    if (self->private_impl.f_photometric == 0) {
+      wuffs_tiff__decoder__invert(self, v_row);
+    }
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func tiff.decoder.zero_fill
+
+static wuffs_base__empty_struct
+wuffs_tiff__decoder__zero_fill(
+    wuffs_tiff__decoder* self,
+    wuffs_base__slice_u8 a_s) {
+  wuffs_base__slice_u8 v_p = {0};
+
+  {
+    wuffs_base__slice_u8 i_slice_p = a_s;
+    v_p.ptr = i_slice_p.ptr;
+    v_p.len = 8;
+    uint8_t* i_end0_p = v_p.ptr + (((i_slice_p.len - (size_t)(v_p.ptr - i_slice_p.ptr)) / 8) * 8);
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_p.ptr < i_end0_p) {
+      wuffs_base__poke_u64le__no_bounds_check(v_p.ptr, 0);
+      v_p.ptr += 8;
+    }
+    v_p.len = 1;
+    uint8_t* i_end1_p = i_slice_p.ptr + i_slice_p.len;
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_p.ptr < i_end1_p) {
+      v_p.ptr[0] = 0;
+      v_p.ptr += 1;
+    }
+    v_p.len = 0;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func tiff.decoder.invert
+
+static wuffs_base__empty_struct
+wuffs_tiff__decoder__invert(
+    wuffs_tiff__decoder* self,
+    wuffs_base__slice_u8 a_s) {
+  wuffs_base__slice_u8 v_p = {0};
+
+  {
+    wuffs_base__slice_u8 i_slice_p = a_s;
+    v_p.ptr = i_slice_p.ptr;
+    v_p.len = 8;
+    uint8_t* i_end0_p = v_p.ptr + (((i_slice_p.len - (size_t)(v_p.ptr - i_slice_p.ptr)) / 8) * 8);
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_p.ptr < i_end0_p) {
+      wuffs_base__poke_u64le__no_bounds_check(v_p.ptr, (18446744073709551615u ^ wuffs_base__peek_u64le__no_bounds_check(v_p.ptr)));
+      v_p.ptr += 8;
+    }
+    v_p.len = 1;
+    uint8_t* i_end1_p = i_slice_p.ptr + i_slice_p.len;
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_p.ptr < i_end1_p) {
+      v_p.ptr[0] = (255 ^ v_p.ptr[0]);
+      v_p.ptr += 1;
+    }
+    v_p.len = 0;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func tiff.decoder.undo_predictor_8
+
+static wuffs_base__empty_struct
+wuffs_tiff__decoder__undo_predictor_8(
+    wuffs_tiff__decoder* self,
+    wuffs_base__slice_u8 a_row) {
+  wuffs_base__slice_u8 v_p = {0};
+  uint8_t v_a0 = 0;
+  uint8_t v_a1 = 0;
+  uint8_t v_a2 = 0;
+  uint8_t v_a3 = 0;
+
+  if (self->private_impl.f_samples_per_pixel == 1) {
+    {
+      wuffs_base__slice_u8 i_slice_p = a_row;
+      v_p.ptr = i_slice_p.ptr;
+      v_p.len = 1;
+      uint8_t* i_end0_p = v_p.ptr + (((i_slice_p.len - (size_t)(v_p.ptr - i_slice_p.ptr)) / 4) * 4);
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_p.ptr < i_end0_p) {
+        v_a0 += v_p.ptr[0];
+        v_p.ptr[0] = v_a0;
+        v_p.ptr += 1;
+        v_a0 += v_p.ptr[0];
+        v_p.ptr[0] = v_a0;
+        v_p.ptr += 1;
+        v_a0 += v_p.ptr[0];
+        v_p.ptr[0] = v_a0;
+        v_p.ptr += 1;
+        v_a0 += v_p.ptr[0];
+        v_p.ptr[0] = v_a0;
+        v_p.ptr += 1;
+      }
+      v_p.len = 1;
+      uint8_t* i_end1_p = i_slice_p.ptr + i_slice_p.len;
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_p.ptr < i_end1_p) {
+        v_a0 += v_p.ptr[0];
+        v_p.ptr[0] = v_a0;
+        v_p.ptr += 1;
+      }
+      v_p.len = 0;
+    }
+  } else if (self->private_impl.f_samples_per_pixel == 3) {
+    {
+      wuffs_base__slice_u8 i_slice_p = a_row;
+      v_p.ptr = i_slice_p.ptr;
+      v_p.len = 3;
+      uint8_t* i_end0_p = v_p.ptr + (((i_slice_p.len - (size_t)(v_p.ptr - i_slice_p.ptr)) / 6) * 6);
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_p.ptr < i_end0_p) {
+        v_a0 += v_p.ptr[0];
+        v_p.ptr[0] = v_a0;
+        v_a1 += v_p.ptr[1];
+        v_p.ptr[1] = v_a1;
+        v_a2 += v_p.ptr[2];
+        v_p.ptr[2] = v_a2;
+        v_p.ptr += 3;
+        v_a0 += v_p.ptr[0];
+        v_p.ptr[0] = v_a0;
+        v_a1 += v_p.ptr[1];
+        v_p.ptr[1] = v_a1;
+        v_a2 += v_p.ptr[2];
+        v_p.ptr[2] = v_a2;
+        v_p.ptr += 3;
+      }
+      v_p.len = 3;
+      uint8_t* i_end1_p = v_p.ptr + (((i_slice_p.len - (size_t)(v_p.ptr - i_slice_p.ptr)) / 3) * 3);
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_p.ptr < i_end1_p) {
+        v_a0 += v_p.ptr[0];
+        v_p.ptr[0] = v_a0;
+        v_a1 += v_p.ptr[1];
+        v_p.ptr[1] = v_a1;
+        v_a2 += v_p.ptr[2];
+        v_p.ptr[2] = v_a2;
+        v_p.ptr += 3;
+      }
+      v_p.len = 0;
+    }
+  } else if (self->private_impl.f_samples_per_pixel == 4) {
+    {
+      wuffs_base__slice_u8 i_slice_p = a_row;
+      v_p.ptr = i_slice_p.ptr;
+      v_p.len = 4;
+      uint8_t* i_end0_p = v_p.ptr + (((i_slice_p.len - (size_t)(v_p.ptr - i_slice_p.ptr)) / 8) * 8);
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_p.ptr < i_end0_p) {
+        v_a0 += v_p.ptr[0];
+        v_p.ptr[0] = v_a0;
+        v_a1 += v_p.ptr[1];
+        v_p.ptr[1] = v_a1;
+        v_a2 += v_p.ptr[2];
+        v_p.ptr[2] = v_a2;
+        v_a3 += v_p.ptr[3];
+        v_p.ptr[3] = v_a3;
+        v_p.ptr += 4;
+        v_a0 += v_p.ptr[0];
+        v_p.ptr[0] = v_a0;
+        v_a1 += v_p.ptr[1];
+        v_p.ptr[1] = v_a1;
+        v_a2 += v_p.ptr[2];
+        v_p.ptr[2] = v_a2;
+        v_a3 += v_p.ptr[3];
+        v_p.ptr[3] = v_a3;
+        v_p.ptr += 4;
+      }
+      v_p.len = 4;
+      uint8_t* i_end1_p = v_p.ptr + (((i_slice_p.len - (size_t)(v_p.ptr - i_slice_p.ptr)) / 4) * 4);
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_p.ptr < i_end1_p) {
+        v_a0 += v_p.ptr[0];
+        v_p.ptr[0] = v_a0;
+        v_a1 += v_p.ptr[1];
+        v_p.ptr[1] = v_a1;
+        v_a2 += v_p.ptr[2];
+        v_p.ptr[2] = v_a2;
+        v_a3 += v_p.ptr[3];
+        v_p.ptr[3] = v_a3;
+        v_p.ptr += 4;
+      }
+      v_p.len = 0;
+    }
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func tiff.decoder.post_process_row_16
+
+static wuffs_base__empty_struct
+wuffs_tiff__decoder__post_process_row_16(
+    wuffs_tiff__decoder* self,
+    wuffs_base__slice_u8 a_row) {
+  wuffs_base__slice_u8 v_p = {0};
+  uint16_t v_a = 0;
+
+  if (self->private_impl.f_predictor == 2) {
+    if (self->private_impl.f_big_endian) {
+      {
+        wuffs_base__slice_u8 i_slice_p = a_row;
+        v_p.ptr = i_slice_p.ptr;
+        v_p.len = 2;
+        uint8_t* i_end0_p = v_p.ptr + (((i_slice_p.len - (size_t)(v_p.ptr - i_slice_p.ptr)) / 4) * 4);
+        WUFFS_BASE__ITERATE_LOOP_HINT
+        while (v_p.ptr < i_end0_p) {
+          v_a += wuffs_base__peek_u16be__no_bounds_check(v_p.ptr);
+          wuffs_base__poke_u16be__no_bounds_check(v_p.ptr, v_a);
+          v_p.ptr += 2;
+          v_a += wuffs_base__peek_u16be__no_bounds_check(v_p.ptr);
+          wuffs_base__poke_u16be__no_bounds_check(v_p.ptr, v_a);
+          v_p.ptr += 2;
+        }
+        v_p.len = 2;
+        uint8_t* i_end1_p = v_p.ptr + (((i_slice_p.len - (size_t)(v_p.ptr - i_slice_p.ptr)) / 2) * 2);
+        WUFFS_BASE__ITERATE_LOOP_HINT
+        while (v_p.ptr < i_end1_p) {
+          v_a += wuffs_base__peek_u16be__no_bounds_check(v_p.ptr);
+          wuffs_base__poke_u16be__no_bounds_check(v_p.ptr, v_a);
+          v_p.ptr += 2;
+        }
+        v_p.len = 0;
+      }
+    } else {
+      {
+        wuffs_base__slice_u8 i_slice_p = a_row;
+        v_p.ptr = i_slice_p.ptr;
+        v_p.len = 2;
+        uint8_t* i_end0_p = v_p.ptr + (((i_slice_p.len - (size_t)(v_p.ptr - i_slice_p.ptr)) / 4) * 4);
+        WUFFS_BASE__ITERATE_LOOP_HINT
+        while (v_p.ptr < i_end0_p) {
+          v_a += wuffs_base__peek_u16le__no_bounds_check(v_p.ptr);
+          wuffs_base__poke_u16be__no_bounds_check(v_p.ptr, v_a);
+          v_p.ptr += 2;
+          v_a += wuffs_base__peek_u16le__no_bounds_check(v_p.ptr);
+          wuffs_base__poke_u16be__no_bounds_check(v_p.ptr, v_a);
+          v_p.ptr += 2;
+        }
+        v_p.len = 2;
+        uint8_t* i_end1_p = v_p.ptr + (((i_slice_p.len - (size_t)(v_p.ptr - i_slice_p.ptr)) / 2) * 2);
+        WUFFS_BASE__ITERATE_LOOP_HINT
+        while (v_p.ptr < i_end1_p) {
+          v_a += wuffs_base__peek_u16le__no_bounds_check(v_p.ptr);
+          wuffs_base__poke_u16be__no_bounds_check(v_p.ptr, v_a);
+          v_p.ptr += 2;
+        }
+        v_p.len = 0;
+      }
+    }
+  } else if ( ! self->private_impl.f_big_endian) {
+    {
+      wuffs_base__slice_u8 i_slice_p = a_row;
+      v_p.ptr = i_slice_p.ptr;
+      v_p.len = 2;
+      uint8_t* i_end0_p = v_p.ptr + (((i_slice_p.len - (size_t)(v_p.ptr - i_slice_p.ptr)) / 4) * 4);
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_p.ptr < i_end0_p) {
+        wuffs_base__poke_u16be__no_bounds_check(v_p.ptr, wuffs_base__peek_u16le__no_bounds_check(v_p.ptr));
+        v_p.ptr += 2;
+        wuffs_base__poke_u16be__no_bounds_check(v_p.ptr, wuffs_base__peek_u16le__no_bounds_check(v_p.ptr));
+        v_p.ptr += 2;
+      }
+      v_p.len = 2;
+      uint8_t* i_end1_p = v_p.ptr + (((i_slice_p.len - (size_t)(v_p.ptr - i_slice_p.ptr)) / 2) * 2);
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_p.ptr < i_end1_p) {
+        wuffs_base__poke_u16be__no_bounds_check(v_p.ptr, wuffs_base__peek_u16le__no_bounds_check(v_p.ptr));
+        v_p.ptr += 2;
+      }
+      v_p.len = 0;
+    }
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func tiff.decoder.swizzle_chunk
+
+static wuffs_base__status
+wuffs_tiff__decoder__swizzle_chunk(
+    wuffs_tiff__decoder* self,
+    wuffs_base__pixel_buffer* a_dst,
+    wuffs_base__slice_u8 a_workbuf,
+    uint32_t a_cx,
+    uint32_t a_cy) {
+  wuffs_base__pixel_format v_dst_pixfmt = {0};
+  uint32_t v_dst_bits_per_pixel = 0;
+  uint64_t v_dst_bytes_per_pixel = 0;
+  wuffs_base__slice_u8 v_dst_palette = {0};
+  wuffs_base__table_u8 v_tab = {0};
+  wuffs_base__slice_u8 v_dst = {0};
+  wuffs_base__slice_u8 v_src = {0};
+  wuffs_base__slice_u8 v_chunk = {0};
+  uint32_t v_x0 = 0;
+  uint32_t v_x1 = 0;
+  uint32_t v_y0 = 0;
+  uint32_t v_y1 = 0;
+  uint32_t v_skip = 0;
+  uint32_t v_y = 0;
+  uint64_t v_i = 0;
+
+  v_dst_pixfmt = wuffs_base__pixel_buffer__pixel_format(a_dst);
+  v_dst_bits_per_pixel = wuffs_base__pixel_format__bits_per_pixel(&v_dst_pixfmt);
+  if ((v_dst_bits_per_pixel & 7) != 0) {
+    return wuffs_base__make_status(wuffs_base__error__unsupported_option);
+  }
+  v_dst_bytes_per_pixel = ((uint64_t)((v_dst_bits_per_pixel / 8)));
+  v_dst_palette = wuffs_base__pixel_buffer__palette_or_else(a_dst, wuffs_base__make_slice_u8(self->private_data.f_dst_palette, 1024));
+  v_tab = wuffs_base__pixel_buffer__plane(a_dst, 0);
+  if ((self->private_impl.f_workbuf_offsets[2] > self->private_impl.f_chunk_wend) || (self->private_impl.f_chunk_wend > ((uint64_t)(a_workbuf.len)))) {
+    return wuffs_base__make_status(wuffs_tiff__error__internal_error_inconsistent_workbuf_length);
+  }
+  v_chunk = wuffs_base__slice_u8__subslice_ij(a_workbuf,
+      self->private_impl.f_workbuf_offsets[2],
+      self->private_impl.f_chunk_wend);
+  v_x0 = ((uint32_t)(a_cx * self->private_impl.f_chunk_width));
+  v_x1 = ((uint32_t)(v_x0 + self->private_impl.f_chunk_width));
+  v_x1 = wuffs_base__u32__min(v_x1, self->private_impl.f_roi_x1);
+  v_y0 = ((uint32_t)(a_cy * self->private_impl.f_chunk_height));
+  v_y1 = ((uint32_t)(v_y0 + self->private_impl.f_chunk_height));
+  v_y1 = wuffs_base__u32__min(v_y1, self->private_impl.f_roi_y1);
+  v_skip = 0;
+  if (v_x0 < self->private_impl.f_roi_x0) {
+    v_skip = ((uint32_t)(self->private_impl.f_roi_x0 - v_x0));
+    v_x0 = self->private_impl.f_roi_x0;
+  }
+  if (v_x0 >= v_x1) {
+    return wuffs_base__make_status(NULL);
+  }
+  v_y = wuffs_base__u32__max(v_y0, self->private_impl.f_roi_y0);
+  while (v_y < v_y1) {
+    v_i = (((uint64_t)(((uint32_t)(v_y - v_y0)))) * self->private_impl.f_chunk_bytes_per_row);
+    if (v_i > ((uint64_t)(v_chunk.len))) {
+      goto label__0__break;
+    }
+    v_src = wuffs_base__slice_u8__subslice_i(v_chunk, v_i);
+    v_src = wuffs_base__slice_u8__prefix(v_src, self->private_impl.f_chunk_bytes_per_row);
+    v_dst = wuffs_base__table_u8__row_u32(v_tab, ((uint32_t)(v_y - self->private_impl.f_roi_y0)));
+    v_i = (((uint64_t)(((uint32_t)(v_x0 - self->private_impl.f_roi_x0)))) * v_dst_bytes_per_pixel);
+    if (v_i > ((uint64_t)(v_dst.len))) {
+      goto label__0__break;
+    }
+    v_dst = wuffs_base__slice_u8__subslice_i(v_dst, v_i);
+    if (self->private_impl.f_bits_per_pixel < 8) {
+      wuffs_base__pixel_swizzler__swizzle_interleaved_from_packed_slice(&self->private_impl.f_swizzler,
+          v_dst,
+          v_dst_palette,
+          v_src,
+          self->private_impl.f_bits_per_pixel,
+          v_skip,
+          ((uint64_t)(((uint32_t)(v_x1 - v_x0)))),
+          (self->private_impl.f_photometric <= 1));
+    } else {
+      v_i = ((((uint64_t)(v_skip)) * ((uint64_t)(self->private_impl.f_bits_per_pixel))) / 8);
+      if (v_i > ((uint64_t)(v_src.len))) {
+        goto label__0__break;
+      }
+      v_src = wuffs_base__slice_u8__subslice_i(v_src, v_i);
+      v_src = wuffs_base__slice_u8__prefix(v_src, ((((uint64_t)(((uint32_t)(v_x1 - v_x0)))) * ((uint64_t)(self->private_impl.f_bits_per_pixel))) / 8));
+      wuffs_base__pixel_swizzler__swizzle_interleaved_from_slice(&self->private_impl.f_swizzler, v_dst, v_dst_palette, v_src);
+    }
+    v_y += 1;
+  }
+  label__0__break:;
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func tiff.decoder.set_quirk_enabled
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_tiff__decoder__set_quirk_enabled(
+    wuffs_tiff__decoder* self,
+    uint32_t a_quirk,
+    bool a_enabled) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  if (a_quirk == 1) {
+    self->private_impl.f_ignore_checksum = a_enabled;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func tiff.decoder.io_seek_position
+
+WUFFS_BASE__MAYBE_STATIC uint64_t
+wuffs_tiff__decoder__io_seek_position(
+    const wuffs_tiff__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_io_seek_position_value;
+}
+
+// -------- func tiff.decoder.num_strips_or_tiles
+
+WUFFS_BASE__MAYBE_STATIC uint32_t
+wuffs_tiff__decoder__num_strips_or_tiles(
+    const wuffs_tiff__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  if (self->private_impl.f_call_sequence < 3) {
+    return 0;
+  }
+  return self->private_impl.f_num_chunks;
+}
+
+// -------- func tiff.decoder.strip_or_tile_rect
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__rect_ie_u32
+wuffs_tiff__decoder__strip_or_tile_rect(
+    const wuffs_tiff__decoder* self,
+    uint32_t a_i) {
+  if (!self) {
+    return wuffs_base__utility__empty_rect_ie_u32();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_rect_ie_u32();
+  }
+
+  uint32_t v_cx = 0;
+  uint32_t v_cy = 0;
+  uint32_t v_x0 = 0;
+  uint32_t v_y0 = 0;
+
+  if ((self->private_impl.f_call_sequence < 3) || (a_i >= self->private_impl.f_num_chunks) || (self->private_impl.f_chunks_across <= 0)) {
+    return wuffs_base__utility__empty_rect_ie_u32();
+  }
+  v_cx = (a_i % self->private_impl.f_chunks_across);
+  v_cy = (a_i / self->private_impl.f_chunks_across);
+  v_x0 = ((uint32_t)(v_cx * self->private_impl.f_chunk_width));
+  v_y0 = ((uint32_t)(v_cy * self->private_impl.f_chunk_height));
+  return wuffs_base__utility__make_rect_ie_u32(
+      v_x0,
+      v_y0,
+      wuffs_base__u32__min(self->private_impl.f_width, ((uint32_t)(v_x0 + self->private_impl.f_chunk_width))),
+      wuffs_base__u32__min(self->private_impl.f_height, ((uint32_t)(v_y0 + self->private_impl.f_chunk_height))));
+}
+
+// -------- func tiff.decoder.decode_image_config
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_tiff__decoder__decode_image_config(
+    wuffs_tiff__decoder* self,
+    wuffs_base__image_config* a_dst,
+    wuffs_base__io_buffer* a_src) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+        ? wuffs_base__error__disabled_by_previous_error
+        : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 1)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_c = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_image_config[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_call_sequence != 0) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
+      goto exit;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      uint32_t t_0;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+        t_0 = wuffs_base__peek_u32le__no_bounds_check(iop_a_src);
+        iop_a_src += 4;
+      } else {
+        self->private_data.s_decode_image_config[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_image_config[0].scratch;
+          uint32_t num_bits_0 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_0;
+          if (num_bits_0 == 24) {
+            t_0 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_0 += 8;
+          *scratch |= ((uint64_t)(num_bits_0)) << 56;
+        }
+      }
+      v_c = t_0;
+    }
+    if (v_c == 2771273) {
+      self->private_impl.f_big_endian = false;
+    } else if (v_c == 704662861) {
+      self->private_impl.f_big_endian = true;
+    } else if ((v_c == 2836809) || (v_c == 721440077)) {
+      status = wuffs_base__make_status(wuffs_tiff__error__unsupported_tiff_file);
+      goto exit;
+    } else {
+      status = wuffs_base__make_status(wuffs_tiff__error__bad_header);
+      goto exit;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      uint32_t t_1;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+        t_1 = wuffs_base__peek_u32le__no_bounds_check(iop_a_src);
+        iop_a_src += 4;
+      } else {
+        self->private_data.s_decode_image_config[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_image_config[0].scratch;
+          uint32_t num_bits_1 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_1;
+          if (num_bits_1 == 24) {
+            t_1 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_1 += 8;
+          *scratch |= ((uint64_t)(num_bits_1)) << 56;
+        }
+      }
+      v_c = t_1;
+    }
+    self->private_impl.f_ifd_io_position = ((uint64_t)(wuffs_tiff__decoder__u32(self, v_c)));
+    if (a_src) {
+      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+    status = wuffs_tiff__decoder__decode_ifd(self, a_src);
+    if (a_src) {
+      iop_a_src = a_src->data.ptr + a_src->meta.ri;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
+    if (self->private_impl.f_array_counts[0] > 0) {
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+      status = wuffs_tiff__decoder__read_array(self,
+          a_src,
+          wuffs_base__utility__empty_slice_u8(),
+          0,
+          0,
+          self->private_impl.f_array_counts[0]);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+    }
+    if (self->private_impl.f_array_counts[1] > 0) {
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+      status = wuffs_tiff__decoder__read_array(self,
+          a_src,
+          wuffs_base__utility__empty_slice_u8(),
+          1,
+          0,
+          self->private_impl.f_array_counts[1]);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+    status = wuffs_tiff__decoder__validate_ifd(self);
+    if (status.repr) {
+      goto suspend;
+    }
+    if (self->private_impl.f_photometric == 3) {
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
+      status = wuffs_tiff__decoder__read_array(self,
+          a_src,
+          wuffs_base__utility__empty_slice_u8(),
+          2,
+          0,
+          self->private_impl.f_array_counts[2]);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+    }
+    if (a_dst != NULL) {
+      wuffs_base__image_config__set(
+          a_dst,
+          self->private_impl.f_dst_pixfmt,
+          0,
+          self->private_impl.f_width,
+          self->private_impl.f_height,
+          self->private_impl.f_ifd_io_position,
+          self->private_impl.f_is_opaque);
+    }
+    self->private_impl.f_call_sequence = 3;
+
+    goto ok;
+    ok:
+    self->private_impl.p_decode_image_config[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_image_config[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine = wuffs_base__status__is_suspension(&status) ? 1 : 0;
+  WUFFS_BASE__STATS__ADD(self->private_impl, WUFFS_BASE__STATS__SUSPENSIONS,
+      wuffs_base__status__is_suspension(&status) ? 1u : 0u);
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func tiff.decoder.decode_ifd
+
+static wuffs_base__status
+wuffs_tiff__decoder__decode_ifd(
+    wuffs_tiff__decoder* self,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_num_entries = 0;
+  uint32_t v_tag = 0;
+  uint32_t v_type = 0;
+  uint32_t v_count = 0;
+  uint32_t v_value = 0;
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_ifd[0];
+  if (coro_susp_point) {
+    v_num_entries = self->private_data.s_decode_ifd[0].v_num_entries;
+    v_tag = self->private_data.s_decode_ifd[0].v_tag;
+    v_type = self->private_data.s_decode_ifd[0].v_type;
+    v_count = self->private_data.s_decode_ifd[0].v_count;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    self->private_impl.f_width = 0;
+    self->private_impl.f_height = 0;
+    self->private_impl.f_is_tiled = false;
+    self->private_impl.f_compression = 1;
+    self->private_impl.f_photometric = 4294967295;
+    self->private_impl.f_predictor = 1;
+    self->private_impl.f_planar_configuration = 1;
+    self->private_impl.f_samples_per_pixel = 1;
+    self->private_impl.f_fill_order = 1;
+    self->private_impl.f_extra_samples = 4294967295;
+    self->private_impl.f_rows_per_strip = 4294967295;
+    self->private_impl.f_tile_width = 0;
+    self->private_impl.f_tile_length = 0;
+    self->private_impl.f_bits_per_sample = 1;
+    self->private_impl.f_array_counts[0] = 0;
+    self->private_impl.f_array_counts[1] = 0;
+    self->private_impl.f_array_counts[2] = 0;
+    self->private_impl.f_array_counts[3] = 0;
+    self->private_impl.f_array_counts[4] = 0;
+    if (a_src) {
+      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+    status = wuffs_tiff__decoder__seek(self, a_src, self->private_impl.f_ifd_io_position);
+    if (a_src) {
+      iop_a_src = a_src->data.ptr + a_src->meta.ri;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      uint32_t t_0;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_0 = ((uint32_t)(wuffs_base__peek_u16le__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_ifd[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_ifd[0].scratch;
+          uint32_t num_bits_0 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_0;
+          if (num_bits_0 == 8) {
+            t_0 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_0 += 8;
+          *scratch |= ((uint64_t)(num_bits_0)) << 56;
+        }
+      }
+      v_num_entries = t_0;
+    }
+    v_num_entries = wuffs_tiff__decoder__u16(self, v_num_entries);
+    while (v_num_entries > 0) {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+        uint32_t t_1;
+        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+          t_1 = ((uint32_t)(wuffs_base__peek_u16le__no_bounds_check(iop_a_src)));
+          iop_a_src += 2;
+        } else {
+          self->private_data.s_decode_ifd[0].scratch = 0;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+          while (true) {
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint64_t* scratch = &self->private_data.s_decode_ifd[0].scratch;
+            uint32_t num_bits_1 = ((uint32_t)(*scratch >> 56));
+            *scratch <<= 8;
+            *scratch >>= 8;
+            *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_1;
+            if (num_bits_1 == 8) {
+              t_1 = ((uint32_t)(*scratch));
+              break;
+            }
+            num_bits_1 += 8;
+            *scratch |= ((uint64_t)(num_bits_1)) << 56;
+          }
+        }
+        v_tag = t_1;
+      }
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+        uint32_t t_2;
+        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+          t_2 = ((uint32_t)(wuffs_base__peek_u16le__no_bounds_check(iop_a_src)));
+          iop_a_src += 2;
+        } else {
+          self->private_data.s_decode_ifd[0].scratch = 0;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+          while (true) {
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint64_t* scratch = &self->private_data.s_decode_ifd[0].scratch;
+            uint32_t num_bits_2 = ((uint32_t)(*scratch >> 56));
+            *scratch <<= 8;
+            *scratch >>= 8;
+            *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_2;
+            if (num_bits_2 == 8) {
+              t_2 = ((uint32_t)(*scratch));
+              break;
+            }
+            num_bits_2 += 8;
+            *scratch |= ((uint64_t)(num_bits_2)) << 56;
+          }
+        }
+        v_type = t_2;
+      }
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+        uint32_t t_3;
+        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+          t_3 = wuffs_base__peek_u32le__no_bounds_check(iop_a_src);
+          iop_a_src += 4;
+        } else {
+          self->private_data.s_decode_ifd[0].scratch = 0;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
+          while (true) {
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint64_t* scratch = &self->private_data.s_decode_ifd[0].scratch;
+            uint32_t num_bits_3 = ((uint32_t)(*scratch >> 56));
+            *scratch <<= 8;
+            *scratch >>= 8;
+            *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_3;
+            if (num_bits_3 == 24) {
+              t_3 = ((uint32_t)(*scratch));
+              break;
+            }
+            num_bits_3 += 8;
+            *scratch |= ((uint64_t)(num_bits_3)) << 56;
+          }
+        }
+        v_count = t_3;
+      }
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(10);
+        uint32_t t_4;
+        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+          t_4 = wuffs_base__peek_u32le__no_bounds_check(iop_a_src);
+          iop_a_src += 4;
+        } else {
+          self->private_data.s_decode_ifd[0].scratch = 0;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(11);
+          while (true) {
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint64_t* scratch = &self->private_data.s_decode_ifd[0].scratch;
+            uint32_t num_bits_4 = ((uint32_t)(*scratch >> 56));
+            *scratch <<= 8;
+            *scratch >>= 8;
+            *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_4;
+            if (num_bits_4 == 24) {
+              t_4 = ((uint32_t)(*scratch));
+              break;
+            }
+            num_bits_4 += 8;
+            *scratch |= ((uint64_t)(num_bits_4)) << 56;
+          }
+        }
+        v_value = t_4;
+      }
+      v_status = wuffs_tiff__decoder__decode_ifd_entry(self,
+          wuffs_tiff__decoder__u16(self, v_tag),
+          wuffs_tiff__decoder__u16(self, v_type),
+          wuffs_tiff__decoder__u32(self, v_count),
+          v_value);
+      if ( ! wuffs_base__status__is_ok(&v_status)) {
+        status = v_status;
+        if (wuffs_base__status__is_error(&status)) {
+          goto exit;
+        } else if (wuffs_base__status__is_suspension(&status)) {
+          status = wuffs_base__make_status(wuffs_base__error__cannot_return_a_suspension);
+          goto exit;
+        }
+        goto ok;
+      }
+      v_num_entries -= 1;
+    }
+
+    ok:
+    self->private_impl.p_decode_ifd[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_ifd[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_decode_ifd[0].v_num_entries = v_num_entries;
+  self->private_data.s_decode_ifd[0].v_tag = v_tag;
+  self->private_data.s_decode_ifd[0].v_type = v_type;
+  self->private_data.s_decode_ifd[0].v_count = v_count;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func tiff.decoder.decode_ifd_entry
+
+static wuffs_base__status
+wuffs_tiff__decoder__decode_ifd_entry(
+    wuffs_tiff__decoder* self,
+    uint32_t a_tag,
+    uint32_t a_type,
+    uint32_t a_count,
+    uint32_t a_value) {
+  uint32_t v_a = 0;
+  uint32_t v_x = 0;
+
+  if ((a_tag == 273) || (a_tag == 324)) {
+    v_a = 3;
+    self->private_impl.f_is_tiled = (a_tag == 324);
+  } else if ((a_tag == 279) || (a_tag == 325)) {
+    v_a = 4;
+  } else if (a_tag == 258) {
+    v_a = 0;
+  } else if (a_tag == 339) {
+    v_a = 1;
+  } else if (a_tag == 320) {
+    v_a = 2;
+  } else {
+    if ((a_tag < 256) || (338 < a_tag)) {
+      return wuffs_base__make_status(NULL);
+    } else if (a_count <= 0) {
+      return wuffs_base__make_status(wuffs_tiff__error__bad_header);
+    } else if (a_type == 3) {
+      v_x = wuffs_tiff__decoder__u16(self, (a_value & 65535));
+    } else if (a_type == 4) {
+      v_x = wuffs_tiff__decoder__u32(self, a_value);
+    } else if ((a_tag == 256) ||
+        (a_tag == 257) ||
+        (a_tag == 259) ||
+        (a_tag == 262) ||
+        (a_tag == 266) ||
+        (a_tag == 277) ||
+        (a_tag == 278) ||
+        (a_tag == 284) ||
+        (a_tag == 317) ||
+        (a_tag == 322) ||
+        (a_tag == 323) ||
+        (a_tag == 338)) {
+      return wuffs_base__make_status(wuffs_tiff__error__bad_header);
+    } else {
+      return wuffs_base__make_status(NULL);
+    }
+    if (a_tag == 256) {
+      if ((v_x <= 0) || (16777215 < v_x)) {
+        return wuffs_base__make_status(wuffs_tiff__error__unsupported_tiff_file);
+      }
+      self->private_impl.f_width = v_x;
+    } else if (a_tag == 257) {
+      if ((v_x <= 0) || (16777215 < v_x)) {
+        return wuffs_base__make_status(wuffs_tiff__error__unsupported_tiff_file);
+      }
+      self->private_impl.f_height = v_x;
+    } else if (a_tag == 259) {
+      self->private_impl.f_compression = v_x;
+    } else if (a_tag == 262) {
+      self->private_impl.f_photometric = v_x;
+    } else if (a_tag == 266) {
+      self->private_impl.f_fill_order = v_x;
+    } else if (a_tag == 277) {
+      self->private_impl.f_samples_per_pixel = v_x;
+    } else if (a_tag == 278) {
+      self->private_impl.f_rows_per_strip = v_x;
+    } else if (a_tag == 284) {
+      self->private_impl.f_planar_configuration = v_x;
+    } else if (a_tag == 317) {
+      self->private_impl.f_predictor = v_x;
+    } else if (a_tag == 322) {
+      self->private_impl.f_tile_width = v_x;
+    } else if (a_tag == 323) {
+      self->private_impl.f_tile_length = v_x;
+    } else if (a_tag == 338) {
+      self->private_impl.f_extra_samples = v_x;
+    }
+    return wuffs_base__make_status(NULL);
+  }
+  if ((a_type != 3) && ((a_type != 4) || (v_a < 3))) {
+    return wuffs_base__make_status(wuffs_tiff__error__bad_header);
+  }
+  self->private_impl.f_array_types[v_a] = a_type;
+  self->private_impl.f_array_counts[v_a] = a_count;
+  self->private_impl.f_array_values[v_a] = a_value;
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func tiff.decoder.validate_ifd
+
+static wuffs_base__status
+wuffs_tiff__decoder__validate_ifd(
+    wuffs_tiff__decoder* self) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_spp = 0;
+  uint32_t v_bps = 0;
+  uint32_t v_bits_per_pixel = 0;
+  uint32_t v_chunk_width = 0;
+  uint32_t v_chunk_height = 0;
+  uint64_t v_n = 0;
+  uint64_t v_offset = 0;
+
+  if ((self->private_impl.f_width <= 0) ||
+      (self->private_impl.f_height <= 0) ||
+      (self->private_impl.f_photometric == 4294967295) ||
+      (self->private_impl.f_array_counts[3] <= 0) ||
+      (self->private_impl.f_array_counts[4] <= 0)) {
+    status = wuffs_base__make_status(wuffs_tiff__error__bad_header);
+    goto exit;
+  }
+  v_spp = self->private_impl.f_samples_per_pixel;
+  v_bps = self->private_impl.f_bits_per_sample;
+  if ((self->private_impl.f_compression != 1) &&
+      (self->private_impl.f_compression != 5) &&
+      (self->private_impl.f_compression != 8) &&
+      (self->private_impl.f_compression != 32946) &&
+      (self->private_impl.f_compression != 32773)) {
+    status = wuffs_base__make_status(wuffs_tiff__error__unsupported_tiff_file);
+    goto exit;
+  } else if ((v_bps <= 0) ||
+      (16 < v_bps) ||
+      (self->private_impl.f_fill_order != 1) ||
+      (v_spp <= 0) ||
+      ((self->private_impl.f_planar_configuration != 1) && (v_spp != 1))) {
+    status = wuffs_base__make_status(wuffs_tiff__error__unsupported_tiff_file);
+    goto exit;
+  } else if ((self->private_impl.f_predictor != 1) && ((self->private_impl.f_predictor != 2) || ((v_bps != 8) && (v_bps != 16)))) {
+    status = wuffs_base__make_status(wuffs_tiff__error__unsupported_tiff_file);
+    goto exit;
+  }
+  self->private_impl.f_is_opaque = true;
+  if (self->private_impl.f_photometric <= 1) {
+    if (v_spp != 1) {
+      status = wuffs_base__make_status(wuffs_tiff__error__unsupported_tiff_file);
+      goto exit;
+    } else if ((v_bps == 1) ||
+        (v_bps == 2) ||
+        (v_bps == 4) ||
+        (v_bps == 8)) {
+      self->private_impl.f_src_pixfmt = 536870920;
+      self->private_impl.f_dst_pixfmt = 536870920;
+    } else if (v_bps == 16) {
+      self->private_impl.f_src_pixfmt = 537919499;
+      self->private_impl.f_dst_pixfmt = 536870923;
+    } else {
+      status = wuffs_base__make_status(wuffs_tiff__error__unsupported_tiff_file);
+      goto exit;
+    }
+    v_bits_per_pixel = v_bps;
+  } else if (self->private_impl.f_photometric == 2) {
+    if (v_bps != 8) {
+      status = wuffs_base__make_status(wuffs_tiff__error__unsupported_tiff_file);
+      goto exit;
+    } else if (v_spp == 3) {
+      self->private_impl.f_src_pixfmt = 2684356744;
+      self->private_impl.f_dst_pixfmt = 2147485832;
+      v_bits_per_pixel = 24;
+    } else if (v_spp == 4) {
+      self->private_impl.f_is_opaque = false;
+      if (self->private_impl.f_extra_samples == 2) {
+        self->private_impl.f_src_pixfmt = 2701166728;
+        self->private_impl.f_dst_pixfmt = 2164295816;
+      } else {
+        self->private_impl.f_src_pixfmt = 2717943944;
+        self->private_impl.f_dst_pixfmt = 2181073032;
+      }
+      v_bits_per_pixel = 32;
+    } else {
+      status = wuffs_base__make_status(wuffs_tiff__error__unsupported_tiff_file);
+      goto exit;
+    }
+  } else if (self->private_impl.f_photometric == 3) {
+    if ((v_spp != 1) || (self->private_impl.f_predictor != 1) || ((v_bps != 1) &&
+        (v_bps != 2) &&
+        (v_bps != 4) &&
+        (v_bps != 8))) {
+      status = wuffs_base__make_status(wuffs_tiff__error__unsupported_tiff_file);
+      goto exit;
+    } else if (self->private_impl.f_array_counts[2] != (((uint32_t)(3)) << v_bps)) {
+      status = wuffs_base__make_status(wuffs_tiff__error__bad_header);
+      goto exit;
+    }
+    self->private_impl.f_src_pixfmt = 2198077448;
+    self->private_impl.f_dst_pixfmt = 2198077448;
+    v_bits_per_pixel = v_bps;
+    wuffs_tiff__decoder__clear_src_palette(self);
+  } else {
+    status = wuffs_base__make_status(wuffs_tiff__error__unsupported_tiff_file);
+    goto exit;
+  }
+  self->private_impl.f_bits_per_pixel = v_bits_per_pixel;
+  if (self->private_impl.f_is_tiled) {
+    if ((self->private_impl.f_tile_width <= 0) ||
+        (16777215 < self->private_impl.f_tile_width) ||
+        (self->private_impl.f_tile_length <= 0) ||
+        (16777215 < self->private_impl.f_tile_length)) {
+      status = wuffs_base__make_status(wuffs_tiff__error__bad_header);
+      goto exit;
+    }
+    v_chunk_width = self->private_impl.f_tile_width;
+    v_chunk_height = self->private_impl.f_tile_length;
+  } else {
+    if (self->private_impl.f_rows_per_strip <= 0) {
+      status = wuffs_base__make_status(wuffs_tiff__error__bad_header);
+      goto exit;
+    }
+    v_chunk_width = self->private_impl.f_width;
+    v_chunk_height = wuffs_base__u32__min(self->private_impl.f_height, self->private_impl.f_rows_per_strip);
+  }
+  self->private_impl.f_chunk_width = v_chunk_width;
+  self->private_impl.f_chunk_height = v_chunk_height;
+  if ((self->private_impl.f_width <= 0) ||
+      (self->private_impl.f_height <= 0) ||
+      (v_chunk_width <= 0) ||
+      (v_chunk_height <= 0)) {
+    status = wuffs_base__make_status(wuffs_tiff__error__bad_header);
+    goto exit;
+  }
+  self->private_impl.f_chunks_across = (((self->private_impl.f_width - 1) / v_chunk_width) + 1);
+  self->private_impl.f_chunks_down = (((self->private_impl.f_height - 1) / v_chunk_height) + 1);
+  v_n = (((uint64_t)(self->private_impl.f_chunks_across)) * ((uint64_t)(self->private_impl.f_chunks_down)));
+  if (v_n > ((uint64_t)(16777215))) {
+    status = wuffs_base__make_status(wuffs_tiff__error__unsupported_tiff_file);
+    goto exit;
+  } else if ((v_n > ((uint64_t)(self->private_impl.f_array_counts[3]))) || (v_n > ((uint64_t)(self->private_impl.f_array_counts[4])))) {
+    status = wuffs_base__make_status(wuffs_tiff__error__bad_header);
+    goto exit;
+  }
+  self->private_impl.f_num_chunks = ((uint32_t)((v_n & 16777215)));
+  self->private_impl.f_chunk_bytes_per_row = (((((uint64_t)(v_chunk_width)) * ((uint64_t)(v_bits_per_pixel))) + 7) / 8);
+  v_offset = (v_n * 8);
+  self->private_impl.f_workbuf_offsets[0] = v_offset;
+  if ((self->private_impl.f_compression == 8) || (self->private_impl.f_compression == 32946)) {
+    v_offset += 33025;
+  }
+  self->private_impl.f_workbuf_offsets[1] = v_offset;
+  self->private_impl.f_workbuf_offsets[2] = v_offset;
+  v_offset += (self->private_impl.f_chunk_bytes_per_row * ((uint64_t)(v_chunk_height)));
+  self->private_impl.f_workbuf_offsets[3] = v_offset;
+
+  goto ok;
+  ok:
+  goto exit;
+  exit:
+  return status;
+}
+
+// -------- func tiff.decoder.clear_src_palette
+
+static wuffs_base__empty_struct
+wuffs_tiff__decoder__clear_src_palette(
+    wuffs_tiff__decoder* self) {
+  uint32_t v_i = 0;
+
+  v_i = 0;
+  while (v_i < 256) {
+    self->private_data.f_src_palette[((4 * v_i) + 0)] = 0;
+    self->private_data.f_src_palette[((4 * v_i) + 1)] = 0;
+    self->private_data.f_src_palette[((4 * v_i) + 2)] = 0;
+    self->private_data.f_src_palette[((4 * v_i) + 3)] = 255;
+    v_i += 1;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func tiff.decoder.read_array
+
+static wuffs_base__status
+wuffs_tiff__decoder__read_array(
+    wuffs_tiff__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf,
+    uint32_t a_a,
+    uint32_t a_first,
+    uint32_t a_n) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_type = 0;
+  uint32_t v_count = 0;
+  uint32_t v_value = 0;
+  uint32_t v_i = 0;
+  uint32_t v_x = 0;
+  uint64_t v_pos = 0;
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_read_array[0];
+  if (coro_susp_point) {
+    v_pos = self->private_data.s_read_array[0].v_pos;
+    v_type = self->private_data.s_read_array[0].v_type;
+    v_i = self->private_data.s_read_array[0].v_i;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    v_type = self->private_impl.f_array_types[a_a];
+    v_count = self->private_impl.f_array_counts[a_a];
+    v_value = self->private_impl.f_array_values[a_a];
+    if (a_first > v_count) {
+      status = wuffs_base__make_status(wuffs_tiff__error__bad_header);
+      goto exit;
+    } else if (a_n > ((uint32_t)(v_count - a_first))) {
+      status = wuffs_base__make_status(wuffs_tiff__error__bad_header);
+      goto exit;
+    }
+    if (((v_type == 3) && (v_count <= 2)) || ((v_type == 4) && (v_count <= 1))) {
+      v_i = 0;
+      while (v_i < a_n) {
+        if (v_type == 4) {
+          v_x = wuffs_tiff__decoder__u32(self, v_value);
+        } else if (((uint32_t)(a_first + v_i)) == 0) {
+          v_x = wuffs_tiff__decoder__u16(self, (v_value & 65535));
+        } else {
+          v_x = wuffs_tiff__decoder__u16(self, (v_value >> 16));
+        }
+        v_status = wuffs_tiff__decoder__store_array_element(self,
+            a_workbuf,
+            a_a,
+            ((uint32_t)(a_first + v_i)),
+            v_x);
+        if ( ! wuffs_base__status__is_ok(&v_status)) {
+          status = v_status;
+          if (wuffs_base__status__is_error(&status)) {
+            goto exit;
+          } else if (wuffs_base__status__is_suspension(&status)) {
+            status = wuffs_base__make_status(wuffs_base__error__cannot_return_a_suspension);
+            goto exit;
+          }
+          goto ok;
+        }
+        v_i += 1;
+      }
+      status = wuffs_base__make_status(NULL);
+      goto ok;
+    }
+    if (v_type == 3) {
+      v_pos = (((uint64_t)(wuffs_tiff__decoder__u32(self, v_value))) + (((uint64_t)(a_first)) * 2));
+    } else {
+      v_pos = (((uint64_t)(wuffs_tiff__decoder__u32(self, v_value))) + (((uint64_t)(a_first)) * 4));
+    }
+    if (a_src) {
+      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+    status = wuffs_tiff__decoder__seek(self, a_src, v_pos);
+    if (a_src) {
+      iop_a_src = a_src->data.ptr + a_src->meta.ri;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
+    v_i = 0;
+    while (v_i < a_n) {
+      if (v_type == 3) {
+        if (self->private_impl.f_big_endian) {
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+            uint32_t t_0;
+            if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+              t_0 = ((uint32_t)(wuffs_base__peek_u16be__no_bounds_check(iop_a_src)));
+              iop_a_src += 2;
+            } else {
+              self->private_data.s_read_array[0].scratch = 0;
+              WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+              while (true) {
+                if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                  status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+                  goto suspend;
+                }
+                uint64_t* scratch = &self->private_data.s_read_array[0].scratch;
+                uint32_t num_bits_0 = ((uint32_t)(*scratch & 0xFF));
+                *scratch >>= 8;
+                *scratch <<= 8;
+                *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_0);
+                if (num_bits_0 == 8) {
+                  t_0 = ((uint32_t)(*scratch >> 48));
+                  break;
+                }
+                num_bits_0 += 8;
+                *scratch |= ((uint64_t)(num_bits_0));
+              }
+            }
+            v_x = t_0;
+          }
+        } else {
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+            uint32_t t_1;
+            if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+              t_1 = ((uint32_t)(wuffs_base__peek_u16le__no_bounds_check(iop_a_src)));
+              iop_a_src += 2;
+            } else {
+              self->private_data.s_read_array[0].scratch = 0;
+              WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+              while (true) {
+                if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                  status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+                  goto suspend;
+                }
+                uint64_t* scratch = &self->private_data.s_read_array[0].scratch;
+                uint32_t num_bits_1 = ((uint32_t)(*scratch >> 56));
+                *scratch <<= 8;
+                *scratch >>= 8;
+                *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_1;
+                if (num_bits_1 == 8) {
+                  t_1 = ((uint32_t)(*scratch));
+                  break;
+                }
+                num_bits_1 += 8;
+                *scratch |= ((uint64_t)(num_bits_1)) << 56;
+              }
+            }
+            v_x = t_1;
+          }
+        }
+      } else {
+        if (self->private_impl.f_big_endian) {
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+            uint32_t t_2;
+            if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+              t_2 = wuffs_base__peek_u32be__no_bounds_check(iop_a_src);
+              iop_a_src += 4;
+            } else {
+              self->private_data.s_read_array[0].scratch = 0;
+              WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+              while (true) {
+                if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                  status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+                  goto suspend;
+                }
+                uint64_t* scratch = &self->private_data.s_read_array[0].scratch;
+                uint32_t num_bits_2 = ((uint32_t)(*scratch & 0xFF));
+                *scratch >>= 8;
+                *scratch <<= 8;
+                *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_2);
+                if (num_bits_2 == 24) {
+                  t_2 = ((uint32_t)(*scratch >> 32));
+                  break;
+                }
+                num_bits_2 += 8;
+                *scratch |= ((uint64_t)(num_bits_2));
+              }
+            }
+            v_x = t_2;
+          }
+        } else {
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+            uint32_t t_3;
+            if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+              t_3 = wuffs_base__peek_u32le__no_bounds_check(iop_a_src);
+              iop_a_src += 4;
+            } else {
+              self->private_data.s_read_array[0].scratch = 0;
+              WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
+              while (true) {
+                if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                  status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+                  goto suspend;
+                }
+                uint64_t* scratch = &self->private_data.s_read_array[0].scratch;
+                uint32_t num_bits_3 = ((uint32_t)(*scratch >> 56));
+                *scratch <<= 8;
+                *scratch >>= 8;
+                *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_3;
+                if (num_bits_3 == 24) {
+                  t_3 = ((uint32_t)(*scratch));
+                  break;
+                }
+                num_bits_3 += 8;
+                *scratch |= ((uint64_t)(num_bits_3)) << 56;
+              }
+            }
+            v_x = t_3;
+          }
+        }
+      }
+      v_status = wuffs_tiff__decoder__store_array_element(self,
+          a_workbuf,
+          a_a,
+          ((uint32_t)(a_first + v_i)),
+          v_x);
+      if ( ! wuffs_base__status__is_ok(&v_status)) {
+        status = v_status;
+        if (wuffs_base__status__is_error(&status)) {
+          goto exit;
+        } else if (wuffs_base__status__is_suspension(&status)) {
+          status = wuffs_base__make_status(wuffs_base__error__cannot_return_a_suspension);
+          goto exit;
+        }
+        goto ok;
+      }
+      v_i += 1;
+    }
+
+    ok:
+    self->private_impl.p_read_array[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_read_array[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_read_array[0].v_pos = v_pos;
+  self->private_data.s_read_array[0].v_type = v_type;
+  self->private_data.s_read_array[0].v_i = v_i;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func tiff.decoder.store_array_element
+
+static wuffs_base__status
+wuffs_tiff__decoder__store_array_element(
+    wuffs_tiff__decoder* self,
+    wuffs_base__slice_u8 a_workbuf,
+    uint32_t a_a,
+    uint32_t a_index,
+    uint32_t a_x) {
+  uint32_t v_n = 0;
+  uint32_t v_c = 0;
+  uint64_t v_j = 0;
+  wuffs_base__slice_u8 v_entry = {0};
+
+  if (a_a == 0) {
+    if (a_index == 0) {
+      self->private_impl.f_bits_per_sample = a_x;
+    } else if (self->private_impl.f_bits_per_sample != a_x) {
+      return wuffs_base__make_status(wuffs_tiff__error__unsupported_tiff_file);
+    }
+  } else if (a_a == 1) {
+    if (a_x != 1) {
+      return wuffs_base__make_status(wuffs_tiff__error__unsupported_tiff_file);
+    }
+  } else if (a_a == 2) {
+    if ((self->private_impl.f_bits_per_sample < 1) || (8 < self->private_impl.f_bits_per_sample)) {
+      return wuffs_base__make_status(wuffs_tiff__error__bad_header);
+    }
+    v_n = (((uint32_t)(1)) << self->private_impl.f_bits_per_sample);
+    v_c = (a_index / v_n);
+    v_j = ((uint64_t)((a_index % v_n)));
+    if (v_c < 3) {
+      self->private_data.f_src_palette[((4 * v_j) + (2 - ((uint64_t)(v_c))))] = ((uint8_t)(((a_x >> 8) & 255)));
+    }
+  } else {
+    v_j = (((uint64_t)(a_index)) * 4);
+    if (a_a == 4) {
+      v_j += (((uint64_t)(self->private_impl.f_num_chunks)) * 4);
+    }
+    if (v_j <= ((uint64_t)(a_workbuf.len))) {
+      v_entry = wuffs_base__slice_u8__subslice_i(a_workbuf, v_j);
+      if (((uint64_t)(v_entry.len)) >= 4) {
+        wuffs_base__poke_u32le__no_bounds_check(wuffs_base__slice_u8__subslice_j(v_entry, 4).ptr, a_x);
+        return wuffs_base__make_status(NULL);
+      }
+    }
+    return wuffs_base__make_status(wuffs_tiff__error__internal_error_inconsistent_workbuf_length);
+  }
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func tiff.decoder.u16
+
+static uint32_t
+wuffs_tiff__decoder__u16(
+    const wuffs_tiff__decoder* self,
+    uint32_t a_x) {
+  if (self->private_impl.f_big_endian) {
+    return (((a_x >> 8) | (a_x << 8)) & 65535);
+  }
+  return a_x;
+}
+
+// -------- func tiff.decoder.u32
+
+static uint32_t
+wuffs_tiff__decoder__u32(
+    const wuffs_tiff__decoder* self,
+    uint32_t a_x) {
+  if (self->private_impl.f_big_endian) {
+    return ((a_x >> 24) |
+        ((a_x >> 8) & 65280) |
+        ((a_x & 65280) << 8) |
+        ((uint32_t)(a_x << 24)));
+  }
+  return a_x;
+}
+
+// -------- func tiff.decoder.seek
+
+static wuffs_base__status
+wuffs_tiff__decoder__seek(
+    wuffs_tiff__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    uint64_t a_pos) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint64_t v_p = 0;
+  uint64_t v_n = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_seek[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    self->private_impl.f_io_seek_position_value = a_pos;
+    label__0__continue:;
+    while (true) {
+      v_p = wuffs_base__u64__sat_add((a_src ? a_src->meta.pos : 0), ((uint64_t)(iop_a_src - io0_a_src)));
+      if (v_p == a_pos) {
+        goto label__0__break;
+      } else if (v_p < a_pos) {
+        v_n = wuffs_base__u64__sat_sub(a_pos, v_p);
+        if (v_n <= ((uint64_t)(io2_a_src - iop_a_src))) {
+          self->private_data.s_seek[0].scratch = v_n;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+          if (self->private_data.s_seek[0].scratch > ((uint64_t)(io2_a_src - iop_a_src))) {
+            self->private_data.s_seek[0].scratch -= ((uint64_t)(io2_a_src - iop_a_src));
+            iop_a_src = io2_a_src;
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          iop_a_src += self->private_data.s_seek[0].scratch;
+          goto label__0__continue;
+        }
+      }
+      status = wuffs_base__make_status(wuffs_base__suspension__mispositioned_read);
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(2);
+    }
+    label__0__break:;
+
+    ok:
+    self->private_impl.p_seek[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_seek[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func tiff.decoder.decode_frame_config
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_tiff__decoder__decode_frame_config(
+    wuffs_tiff__decoder* self,
+    wuffs_base__frame_config* a_dst,
+    wuffs_base__io_buffer* a_src) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+        ? wuffs_base__error__disabled_by_previous_error
+        : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 2)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_frame_config[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_call_sequence < 3) {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      status = wuffs_tiff__decoder__decode_image_config(self, NULL, a_src);
+      if (status.repr) {
+        goto suspend;
+      }
+    } else if (self->private_impl.f_call_sequence == 3) {
+    } else if (self->private_impl.f_call_sequence == 4) {
+      self->private_impl.f_call_sequence = 255;
+      status = wuffs_base__make_status(wuffs_base__note__end_of_data);
+      goto ok;
+    } else {
+      status = wuffs_base__make_status(wuffs_base__note__end_of_data);
+      goto ok;
+    }
+    if (a_dst != NULL) {
+      wuffs_base__frame_config__set(
+          a_dst,
+          wuffs_base__utility__make_rect_ie_u32(
+          0,
+          0,
+          self->private_impl.f_width,
+          self->private_impl.f_height),
+          ((wuffs_base__flicks)(0)),
+          0,
+          self->private_impl.f_ifd_io_position,
+          0,
+          self->private_impl.f_is_opaque,
+          false,
+          0);
+    }
+    self->private_impl.f_call_sequence = 4;
+
+    ok:
+    self->private_impl.p_decode_frame_config[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_frame_config[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine = wuffs_base__status__is_suspension(&status) ? 2 : 0;
+  WUFFS_BASE__STATS__ADD(self->private_impl, WUFFS_BASE__STATS__SUSPENSIONS,
+      wuffs_base__status__is_suspension(&status) ? 1u : 0u);
+
+  goto exit;
+  exit:
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func tiff.decoder.decode_frame
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_tiff__decoder__decode_frame(
+    wuffs_tiff__decoder* self,
+    wuffs_base__pixel_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__pixel_blend a_blend,
+    wuffs_base__slice_u8 a_workbuf,
+    wuffs_base__decode_frame_options* a_opts) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+        ? wuffs_base__error__disabled_by_previous_error
+        : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst || !a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 3)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  uint32_t v_roi = 0;
+  uint32_t v_cx0 = 0;
+  uint32_t v_cx1 = 0;
+  uint32_t v_cy0 = 0;
+  uint32_t v_cy1 = 0;
+  uint32_t v_cx = 0;
+  uint32_t v_cy = 0;
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_frame[0];
+  if (coro_susp_point) {
+    v_cx0 = self->private_data.s_decode_frame[0].v_cx0;
+    v_cx1 = self->private_data.s_decode_frame[0].v_cx1;
+    v_cy0 = self->private_data.s_decode_frame[0].v_cy0;
+    v_cy1 = self->private_data.s_decode_frame[0].v_cy1;
+    v_cx = self->private_data.s_decode_frame[0].v_cx;
+    v_cy = self->private_data.s_decode_frame[0].v_cy;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_call_sequence < 4) {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      status = wuffs_tiff__decoder__decode_frame_config(self, NULL, a_src);
+      if (status.repr) {
+        goto suspend;
+      }
+    } else if (self->private_impl.f_call_sequence == 4) {
+    } else {
+      status = wuffs_base__make_status(wuffs_base__note__end_of_data);
+      goto ok;
+    }
+    v_roi = 4294967295;
+    if (a_opts != NULL) {
+      if (wuffs_base__decode_frame_options__has_color_conversion(a_opts)) {
+        status = wuffs_base__make_status(wuffs_base__error__unsupported_option);
+        goto exit;
+      }
+      if ((wuffs_base__decode_frame_options__row_band_height(a_opts) > 0) || (wuffs_base__decode_frame_options__downscale_shift(a_opts) > 0)) {
+        status = wuffs_base__make_status(wuffs_base__error__unsupported_option);
+        goto exit;
+      }
+      v_roi = wuffs_base__decode_frame_options__roi_max_excl_x(a_opts);
+    }
+    self->private_impl.f_roi_x1 = wuffs_base__u32__min(v_roi, self->private_impl.f_width);
+    v_roi = 4294967295;
+    if (a_opts != NULL) {
+      v_roi = wuffs_base__decode_frame_options__roi_max_excl_y(a_opts);
+    }
+    self->private_impl.f_roi_y1 = wuffs_base__u32__min(v_roi, self->private_impl.f_height);
+    v_roi = 0;
+    if (a_opts != NULL) {
+      v_roi = wuffs_base__decode_frame_options__roi_min_incl_x(a_opts);
+    }
+    self->private_impl.f_roi_x0 = wuffs_base__u32__min(v_roi, self->private_impl.f_roi_x1);
+    v_roi = 0;
+    if (a_opts != NULL) {
+      v_roi = wuffs_base__decode_frame_options__roi_min_incl_y(a_opts);
+    }
+    self->private_impl.f_roi_y0 = wuffs_base__u32__min(v_roi, self->private_impl.f_roi_y1);
+    if (((uint64_t)(a_workbuf.len)) < self->private_impl.f_workbuf_offsets[3]) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_workbuf_length);
+      goto exit;
+    }
+    v_status = wuffs_base__pixel_swizzler__prepare(&self->private_impl.f_swizzler,
+        wuffs_base__pixel_buffer__pixel_format(a_dst),
+        wuffs_base__pixel_buffer__palette_or_else(a_dst, wuffs_base__make_slice_u8(self->private_data.f_dst_palette, 1024)),
+        wuffs_base__utility__make_pixel_format(self->private_impl.f_src_pixfmt),
+        wuffs_base__make_slice_u8(self->private_data.f_src_palette, 1024),
+        a_blend);
+    if ( ! wuffs_base__status__is_ok(&v_status)) {
+      status = v_status;
+      if (wuffs_base__status__is_error(&status)) {
+        goto exit;
+      } else if (wuffs_base__status__is_suspension(&status)) {
+        status = wuffs_base__make_status(wuffs_base__error__cannot_return_a_suspension);
+        goto exit;
+      }
+      goto ok;
+    }
+    if ((self->private_impl.f_roi_x0 < self->private_impl.f_roi_x1) &&
+        (self->private_impl.f_roi_y0 < self->private_impl.f_roi_y1) &&
+        (self->private_impl.f_roi_x1 > 0) &&
+        (self->private_impl.f_roi_y1 > 0) &&
+        (self->private_impl.f_chunk_width > 0) &&
+        (self->private_impl.f_chunk_height > 0)) {
+      v_cx0 = (self->private_impl.f_roi_x0 / self->private_impl.f_chunk_width);
+      v_cx1 = (((self->private_impl.f_roi_x1 - 1) / self->private_impl.f_chunk_width) + 1);
+      v_cy0 = (self->private_impl.f_roi_y0 / self->private_impl.f_chunk_height);
+      v_cy1 = (((self->private_impl.f_roi_y1 - 1) / self->private_impl.f_chunk_height) + 1);
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      status = wuffs_tiff__decoder__read_array(self,
+          a_src,
+          a_workbuf,
+          3,
+          ((uint32_t)(v_cy0 * self->private_impl.f_chunks_across)),
+          ((uint32_t)(((uint32_t)(v_cy1 - v_cy0)) * self->private_impl.f_chunks_across)));
+      if (status.repr) {
+        goto suspend;
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      status = wuffs_tiff__decoder__read_array(self,
+          a_src,
+          a_workbuf,
+          4,
+          ((uint32_t)(v_cy0 * self->private_impl.f_chunks_across)),
+          ((uint32_t)(((uint32_t)(v_cy1 - v_cy0)) * self->private_impl.f_chunks_across)));
+      if (status.repr) {
+        goto suspend;
+      }
+      v_cy = v_cy0;
+      while (v_cy < v_cy1) {
+        v_cx = v_cx0;
+        while (v_cx < v_cx1) {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+          status = wuffs_tiff__decoder__decode_chunk(self, a_src, a_workbuf, ((uint32_t)(((uint32_t)(v_cy * self->private_impl.f_chunks_across)) + v_cx)));
+          if (status.repr) {
+            goto suspend;
+          }
+          wuffs_tiff__decoder__post_process_chunk(self, a_workbuf);
+          v_status = wuffs_tiff__decoder__swizzle_chunk(self,
+              a_dst,
+              a_workbuf,
+              v_cx,
+              v_cy);
+          if ( ! wuffs_base__status__is_ok(&v_status)) {
+            status = v_status;
+            if (wuffs_base__status__is_error(&status)) {
+              goto exit;
+            } else if (wuffs_base__status__is_suspension(&status)) {
+              status = wuffs_base__make_status(wuffs_base__error__cannot_return_a_suspension);
+              goto exit;
+            }
+            goto ok;
+          }
+          v_cx += 1;
+        }
+        v_cy += 1;
+      }
+    }
+    self->private_impl.f_call_sequence = 255;
+
+    ok:
+    self->private_impl.p_decode_frame[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_frame[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine = wuffs_base__status__is_suspension(&status) ? 3 : 0;
+  WUFFS_BASE__STATS__ADD(self->private_impl, WUFFS_BASE__STATS__SUSPENSIONS,
+      wuffs_base__status__is_suspension(&status) ? 1u : 0u);
+  self->private_data.s_decode_frame[0].v_cx0 = v_cx0;
+  self->private_data.s_decode_frame[0].v_cx1 = v_cx1;
+  self->private_data.s_decode_frame[0].v_cy0 = v_cy0;
+  self->private_data.s_decode_frame[0].v_cy1 = v_cy1;
+  self->private_data.s_decode_frame[0].v_cx = v_cx;
+  self->private_data.s_decode_frame[0].v_cy = v_cy;
+
+  goto exit;
+  exit:
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func tiff.decoder.can_decode_row_bands
+
+WUFFS_BASE__MAYBE_STATIC bool
+wuffs_tiff__decoder__can_decode_row_bands(
+    const wuffs_tiff__decoder* self) {
+  if (!self) {
+    return false;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return false;
+  }
+
+  return false;
+}
+
+// -------- func tiff.decoder.frame_dirty_rect
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__rect_ie_u32
+wuffs_tiff__decoder__frame_dirty_rect(
+    const wuffs_tiff__decoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_rect_ie_u32();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_rect_ie_u32();
+  }
+
+  return wuffs_base__utility__make_rect_ie_u32(
+      0,
+      0,
+      self->private_impl.f_width,
+      self->private_impl.f_height);
+}
+
+// -------- func tiff.decoder.num_animation_loops
+
+WUFFS_BASE__MAYBE_STATIC uint32_t
+wuffs_tiff__decoder__num_animation_loops(
+    const wuffs_tiff__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return 0;
+}
+
+// -------- func tiff.decoder.num_decoded_frame_configs
+
+WUFFS_BASE__MAYBE_STATIC uint64_t
+wuffs_tiff__decoder__num_decoded_frame_configs(
+    const wuffs_tiff__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  if (self->private_impl.f_call_sequence > 3) {
+    return 1;
+  }
+  return 0;
+}
+
+// -------- func tiff.decoder.num_decoded_frames
+
+WUFFS_BASE__MAYBE_STATIC uint64_t
+wuffs_tiff__decoder__num_decoded_frames(
+    const wuffs_tiff__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  if (self->private_impl.f_call_sequence > 4) {
+    return 1;
+  }
+  return 0;
+}
+
+// -------- func tiff.decoder.restart_frame
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_tiff__decoder__restart_frame(
+    wuffs_tiff__decoder* self,
+    uint64_t a_index,
+    uint64_t a_io_position) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+        ? wuffs_base__error__disabled_by_previous_error
+        : wuffs_base__error__initialize_not_called);
+  }
+
+  if (self->private_impl.f_call_sequence < 3) {
+    return wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
+  }
+  if ((a_index != 0) || (a_io_position != self->private_impl.f_ifd_io_position)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  self->private_impl.f_call_sequence = 3;
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func tiff.decoder.set_report_metadata
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_tiff__decoder__set_report_metadata(
+    wuffs_tiff__decoder* self,
+    uint32_t a_fourcc,
+    bool a_report) {
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func tiff.decoder.tell_me_more
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_tiff__decoder__tell_me_more(
+    wuffs_tiff__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__more_information* a_minfo,
+    wuffs_base__io_buffer* a_src) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+        ? wuffs_base__error__disabled_by_previous_error
+        : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst || !a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 4)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  status = wuffs_base__make_status(wuffs_base__error__no_more_information);
+  goto exit;
+
+  goto ok;
+  ok:
+  goto exit;
+  exit:
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func tiff.decoder.workbuf_len
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64
+wuffs_tiff__decoder__workbuf_len(
+    const wuffs_tiff__decoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+
+  return wuffs_base__utility__make_range_ii_u64(self->private_impl.f_workbuf_offsets[3], self->private_impl.f_workbuf_offsets[3]);
+}
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__TIFF)
+
+
+#endif  // WUFFS_IMPLEMENTATION
+
+// ¡ WUFFS MONOLITHIC RELEASE DISCARDS EVERYTHING BELOW.
+
+#endif  // WUFFS_INCLUDE_GUARD__TIFF
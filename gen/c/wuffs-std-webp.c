@@ -0,0 +1,3905 @@
+#ifndef WUFFS_INCLUDE_GUARD__WEBP
+#define WUFFS_INCLUDE_GUARD__WEBP
+
+#if defined(WUFFS_IMPLEMENTATION) && !defined(WUFFS_CONFIG__MODULES)
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__WEBP
+#endif
+
+#include "./wuffs-base.c"
+
+// ¡ WUFFS MONOLITHIC RELEASE DISCARDS EVERYTHING ABOVE.
+
+
+// ---------------- Status Codes
+
+extern const char wuffs_webp__error__bad_huffman_code_over_subscribed[];
+extern const char wuffs_webp__error__bad_huffman_code_under_subscribed[];
+extern const char wuffs_webp__error__bad_huffman_code[];
+extern const char wuffs_webp__error__bad_back_reference[];
+extern const char wuffs_webp__error__bad_color_cache[];
+extern const char wuffs_webp__error__bad_header[];
+extern const char wuffs_webp__error__bad_transform[];
+extern const char wuffs_webp__error__short_chunk[];
+extern const char wuffs_webp__error__truncated_input[];
+extern const char wuffs_webp__error__unsupported_number_of_huffman_groups[];
+extern const char wuffs_webp__error__unsupported_webp_file[];
+
+// ---------------- Public Consts
+
+// ---------------- Struct Declarations
+
+typedef struct wuffs_webp__decoder__struct wuffs_webp__decoder;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ---------------- Public Initializer Prototypes
+
+// For any given "wuffs_foo__bar* self", "wuffs_foo__bar__initialize(self,
+// etc)" should be called before any other "wuffs_foo__bar__xxx(self, etc)".
+//
+// Pass sizeof(*self) and WUFFS_VERSION for sizeof_star_self and wuffs_version.
+// Pass 0 (or some combination of WUFFS_INITIALIZE__XXX) for options.
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+wuffs_webp__decoder__initialize(
+    wuffs_webp__decoder* self,
+    size_t sizeof_star_self,
+    uint64_t wuffs_version,
+    uint32_t options);
+
+wuffs_base__stats
+wuffs_webp__decoder__stats(
+    const wuffs_webp__decoder* self);
+
+size_t
+sizeof__wuffs_webp__decoder();
+
+// ---------------- Allocs
+
+// These functions allocate and initialize Wuffs structs. They return NULL if
+// memory allocation fails. If they return non-NULL, there is no need to call
+// wuffs_foo__bar__initialize, but the caller is responsible for eventually
+// calling free on the returned pointer. That pointer is effectively a C++
+// std::unique_ptr<T, decltype(&free)>.
+
+wuffs_webp__decoder*
+wuffs_webp__decoder__alloc();
+
+static inline wuffs_base__image_decoder*
+wuffs_webp__decoder__alloc_as__wuffs_base__image_decoder() {
+  return (wuffs_base__image_decoder*)(wuffs_webp__decoder__alloc());
+}
+
+// ---------------- Upcasts
+
+static inline wuffs_base__image_decoder*
+wuffs_webp__decoder__upcast_as__wuffs_base__image_decoder(
+    wuffs_webp__decoder* p) {
+  return (wuffs_base__image_decoder*)p;
+}
+
+// ---------------- Public Function Prototypes
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_webp__decoder__set_quirk_enabled(
+    wuffs_webp__decoder* self,
+    uint32_t a_quirk,
+    bool a_enabled);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_webp__decoder__decode_image_config(
+    wuffs_webp__decoder* self,
+    wuffs_base__image_config* a_dst,
+    wuffs_base__io_buffer* a_src);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_webp__decoder__decode_frame_config(
+    wuffs_webp__decoder* self,
+    wuffs_base__frame_config* a_dst,
+    wuffs_base__io_buffer* a_src);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_webp__decoder__decode_frame(
+    wuffs_webp__decoder* self,
+    wuffs_base__pixel_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__pixel_blend a_blend,
+    wuffs_base__slice_u8 a_workbuf,
+    wuffs_base__decode_frame_options* a_opts);
+
+WUFFS_BASE__MAYBE_STATIC bool
+wuffs_webp__decoder__can_decode_row_bands(
+    const wuffs_webp__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__rect_ie_u32
+wuffs_webp__decoder__frame_dirty_rect(
+    const wuffs_webp__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC uint32_t
+wuffs_webp__decoder__num_animation_loops(
+    const wuffs_webp__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC uint64_t
+wuffs_webp__decoder__num_decoded_frame_configs(
+    const wuffs_webp__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC uint64_t
+wuffs_webp__decoder__num_decoded_frames(
+    const wuffs_webp__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_webp__decoder__restart_frame(
+    wuffs_webp__decoder* self,
+    uint64_t a_index,
+    uint64_t a_io_position);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_webp__decoder__set_report_metadata(
+    wuffs_webp__decoder* self,
+    uint32_t a_fourcc,
+    bool a_report);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_webp__decoder__tell_me_more(
+    wuffs_webp__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__more_information* a_minfo,
+    wuffs_base__io_buffer* a_src);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64
+wuffs_webp__decoder__workbuf_len(
+    const wuffs_webp__decoder* self);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+// ---------------- Struct Definitions
+
+// These structs' fields, and the sizeof them, are private implementation
+// details that aren't guaranteed to be stable across Wuffs versions.
+//
+// See https://en.wikipedia.org/wiki/Opaque_pointer#C
+
+#if defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
+
+struct wuffs_webp__decoder__struct {
+  // Do not access the private_impl's or private_data's fields directly. There
+  // is no API/ABI compatibility or safety guarantee if you do so. Instead, use
+  // the wuffs_foo__bar__baz functions.
+  //
+  // It is a struct, not a struct*, so that the outermost wuffs_foo__bar struct
+  // can be stack allocated when WUFFS_IMPLEMENTATION is defined.
+
+  struct {
+    uint32_t magic;
+    uint32_t active_coroutine;
+    wuffs_base__vtable vtable_for__wuffs_base__image_decoder;
+    wuffs_base__vtable null_vtable;
+#if defined(WUFFS_CONFIG__STATS)
+    wuffs_base__stats stats;
+#endif  // defined(WUFFS_CONFIG__STATS)
+
+    uint32_t f_width;
+    uint32_t f_height;
+    uint8_t f_call_sequence;
+    bool f_is_opaque;
+    uint64_t f_frame_config_io_position;
+    uint64_t f_workbuf_offsets[7];
+    uint32_t f_bitstream_remaining;
+    uint64_t f_bitstream_bits;
+    uint32_t f_bitstream_n_bits;
+    uint32_t f_bitstream_n_padding_bits;
+    uint32_t f_bitstream_ri;
+    uint32_t f_bitstream_wi;
+    uint32_t f_n_transforms;
+    uint8_t f_transform_types[4];
+    uint32_t f_transform_widths[4];
+    uint32_t f_transform_bits[4];
+    uint32_t f_transforms_seen;
+    uint32_t f_color_cache_bits;
+    uint32_t f_entropy_bits;
+    uint32_t f_entropy_width;
+    uint32_t f_n_huffman_groups;
+    uint32_t f_pixels_pos;
+    uint32_t f_roi_x0;
+    uint32_t f_roi_y0;
+    uint32_t f_roi_x1;
+    uint32_t f_roi_y1;
+    uint32_t f_band_height;
+    uint32_t f_band_y0;
+    uint32_t f_band_y1;
+    wuffs_base__pixel_swizzler f_swizzler;
+
+    uint32_t p_ensure_bits[1];
+    uint32_t p_decode_huffman_groups[1];
+    uint32_t p_decode_huffman_code[1];
+    uint32_t p_decode_code_lengths[1];
+    uint32_t p_decode_image_config[1];
+    uint32_t p_decode_frame_config[1];
+    uint32_t p_decode_frame[1];
+    uint32_t p_decode_transforms[1];
+    uint32_t p_decode_main_image[1];
+    uint32_t p_decode_sub_image[1];
+    uint32_t p_decode_all_pixels[1];
+  } private_impl;
+
+  struct {
+    uint8_t f_bitstream_buffer[8192];
+    uint32_t f_color_cache[2048];
+    uint8_t f_code_lengths[2328];
+    uint16_t f_sorted_symbols[2328];
+    uint8_t f_code_length_code_table[256];
+
+    struct {
+      uint32_t v_g;
+      uint32_t v_k;
+    } s_decode_huffman_groups[1];
+    struct {
+      uint32_t v_n_symbols;
+    } s_decode_huffman_code[1];
+    struct {
+      uint32_t v_n;
+      uint32_t v_i;
+      uint32_t v_max_symbol;
+      uint32_t v_repeat;
+      uint8_t v_prev;
+      uint8_t v_v;
+    } s_decode_code_lengths[1];
+    struct {
+      uint64_t scratch;
+      uint32_t v_c;
+      uint32_t v_chunk_length;
+      uint32_t v_canvas_width;
+      uint32_t v_canvas_height;
+      bool v_has_canvas;
+    } s_decode_image_config[1];
+    struct {
+      uint32_t v_width;
+      uint32_t v_t;
+      uint32_t v_bits;
+      uint32_t v_n;
+      uint32_t v_i;
+      uint32_t v_sub_width;
+      uint32_t v_sub_height;
+    } s_decode_transforms[1];
+    struct {
+      uint32_t v_width;
+      uint32_t v_color_cache_bits;
+      uint32_t v_bits;
+      uint32_t v_sub_height;
+    } s_decode_main_image[1];
+  } private_data;
+
+#ifdef __cplusplus
+#if defined(WUFFS_BASE__HAVE_UNIQUE_PTR)
+  using unique_ptr = std::unique_ptr<wuffs_webp__decoder, decltype(&free)>;
+
+  // On failure, the alloc_etc functions return nullptr. They don't throw.
+
+  static inline unique_ptr
+  alloc() {
+    return unique_ptr(wuffs_webp__decoder__alloc(), &free);
+  }
+
+  static inline wuffs_base__image_decoder::unique_ptr
+  alloc_as__wuffs_base__image_decoder() {
+    return wuffs_base__image_decoder::unique_ptr(
+        wuffs_webp__decoder__alloc_as__wuffs_base__image_decoder(), &free);
+  }
+#endif  // defined(WUFFS_BASE__HAVE_UNIQUE_PTR)
+
+#if defined(WUFFS_BASE__HAVE_EQ_DELETE) && !defined(WUFFS_IMPLEMENTATION)
+  // Disallow constructing or copying an object via standard C++ mechanisms,
+  // e.g. the "new" operator, as this struct is intentionally opaque. Its total
+  // size and field layout is not part of the public, stable, memory-safe API.
+  // Use malloc or memcpy and the sizeof__wuffs_foo__bar function instead, and
+  // call wuffs_foo__bar__baz methods (which all take a "this"-like pointer as
+  // their first argument) rather than tweaking bar.private_impl.qux fields.
+  //
+  // In C, we can just leave wuffs_foo__bar as an incomplete type (unless
+  // WUFFS_IMPLEMENTATION is #define'd). In C++, we define a complete type in
+  // order to provide convenience methods. These forward on "this", so that you
+  // can write "bar->baz(etc)" instead of "wuffs_foo__bar__baz(bar, etc)".
+  wuffs_webp__decoder__struct() = delete;
+  wuffs_webp__decoder__struct(const wuffs_webp__decoder__struct&) = delete;
+  wuffs_webp__decoder__struct& operator=(
+      const wuffs_webp__decoder__struct&) = delete;
+#endif  // defined(WUFFS_BASE__HAVE_EQ_DELETE) && !defined(WUFFS_IMPLEMENTATION)
+
+#if !defined(WUFFS_IMPLEMENTATION)
+  // As above, the size of the struct is not part of the public API, and unless
+  // WUFFS_IMPLEMENTATION is #define'd, this struct type T should be heap
+  // allocated, not stack allocated. Its size is not intended to be known at
+  // compile time, but it is unfortunately divulged as a side effect of
+  // defining C++ convenience methods. Use "sizeof__T()", calling the function,
+  // instead of "sizeof T", invoking the operator. To make the two values
+  // different, so that passing the latter will be rejected by the initialize
+  // function, we add an arbitrary amount of dead weight.
+  uint8_t dead_weight[123000000];  // 123 MB.
+#endif  // !defined(WUFFS_IMPLEMENTATION)
+
+  inline wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+  initialize(
+      size_t sizeof_star_self,
+      uint64_t wuffs_version,
+      uint32_t options) {
+    return wuffs_webp__decoder__initialize(
+        this, sizeof_star_self, wuffs_version, options);
+  }
+
+  inline wuffs_base__stats
+  stats() const {
+    return wuffs_webp__decoder__stats(this);
+  }
+
+  inline wuffs_base__image_decoder*
+  upcast_as__wuffs_base__image_decoder() {
+    return (wuffs_base__image_decoder*)this;
+  }
+
+  inline wuffs_base__empty_struct
+  set_quirk_enabled(
+      uint32_t a_quirk,
+      bool a_enabled) {
+    return wuffs_webp__decoder__set_quirk_enabled(this, a_quirk, a_enabled);
+  }
+
+  inline wuffs_base__status
+  decode_image_config(
+      wuffs_base__image_config* a_dst,
+      wuffs_base__io_buffer* a_src) {
+    return wuffs_webp__decoder__decode_image_config(this, a_dst, a_src);
+  }
+
+  inline wuffs_base__status
+  decode_frame_config(
+      wuffs_base__frame_config* a_dst,
+      wuffs_base__io_buffer* a_src) {
+    return wuffs_webp__decoder__decode_frame_config(this, a_dst, a_src);
+  }
+
+  inline wuffs_base__status
+  decode_frame(
+      wuffs_base__pixel_buffer* a_dst,
+      wuffs_base__io_buffer* a_src,
+      wuffs_base__pixel_blend a_blend,
+      wuffs_base__slice_u8 a_workbuf,
+      wuffs_base__decode_frame_options* a_opts) {
+    return wuffs_webp__decoder__decode_frame(this, a_dst, a_src, a_blend, a_workbuf, a_opts);
+  }
+
+  inline bool
+  can_decode_row_bands() const {
+    return wuffs_webp__decoder__can_decode_row_bands(this);
+  }
+
+  inline wuffs_base__rect_ie_u32
+  frame_dirty_rect() const {
+    return wuffs_webp__decoder__frame_dirty_rect(this);
+  }
+
+  inline uint32_t
+  num_animation_loops() const {
+    return wuffs_webp__decoder__num_animation_loops(this);
+  }
+
+  inline uint64_t
+  num_decoded_frame_configs() const {
+    return wuffs_webp__decoder__num_decoded_frame_configs(this);
+  }
+
+  inline uint64_t
+  num_decoded_frames() const {
+    return wuffs_webp__decoder__num_decoded_frames(this);
+  }
+
+  inline wuffs_base__status
+  restart_frame(
+      uint64_t a_index,
+      uint64_t a_io_position) {
+    return wuffs_webp__decoder__restart_frame(this, a_index, a_io_position);
+  }
+
+  inline wuffs_base__empty_struct
+  set_report_metadata(
+      uint32_t a_fourcc,
+      bool a_report) {
+    return wuffs_webp__decoder__set_report_metadata(this, a_fourcc, a_report);
+  }
+
+  inline wuffs_base__status
+  tell_me_more(
+      wuffs_base__io_buffer* a_dst,
+      wuffs_base__more_information* a_minfo,
+      wuffs_base__io_buffer* a_src) {
+    return wuffs_webp__decoder__tell_me_more(this, a_dst, a_minfo, a_src);
+  }
+
+  inline wuffs_base__range_ii_u64
+  workbuf_len() const {
+    return wuffs_webp__decoder__workbuf_len(this);
+  }
+
+#endif  // __cplusplus
+};  // struct wuffs_webp__decoder__struct
+
+#endif  // defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
+
+
+// ‼ WUFFS C HEADER ENDS HERE.
+#ifdef WUFFS_IMPLEMENTATION
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__WEBP)
+
+// ---------------- Status Codes Implementations
+
+const char wuffs_webp__error__bad_huffman_code_over_subscribed[] = "#webp: bad Huffman code (over-subscribed)";
+const char wuffs_webp__error__bad_huffman_code_under_subscribed[] = "#webp: bad Huffman code (under-subscribed)";
+const char wuffs_webp__error__bad_huffman_code[] = "#webp: bad Huffman code";
+const char wuffs_webp__error__bad_back_reference[] = "#webp: bad back-reference";
+const char wuffs_webp__error__bad_color_cache[] = "#webp: bad color cache";
+const char wuffs_webp__error__bad_header[] = "#webp: bad header";
+const char wuffs_webp__error__bad_transform[] = "#webp: bad transform";
+const char wuffs_webp__error__short_chunk[] = "#webp: short chunk";
+const char wuffs_webp__error__truncated_input[] = "#webp: truncated input";
+const char wuffs_webp__error__unsupported_number_of_huffman_groups[] = "#webp: unsupported number of Huffman groups";
+const char wuffs_webp__error__unsupported_webp_file[] = "#webp: unsupported WebP file";
+const char wuffs_webp__error__internal_error_inconsistent_huffman_code[] = "#webp: internal error: inconsistent Huffman code";
+const char wuffs_webp__note__internal_note_short_read[] = "@webp: internal note: short read";
+const char wuffs_webp__note__internal_note_short_write[] = "@webp: internal note: short write";
+
+// ---------------- Private Consts
+
+#define WUFFS_WEBP__BITSTREAM_BUFFER_LENGTH 8192
+
+#define WUFFS_WEBP__BITSTREAM_PIXEL_LENGTH_MAX_INCL_WORST_CASE 16
+
+#define WUFFS_WEBP__HUFFMAN_GROUPS_MAX_INCL 256
+
+static const uint32_t
+WUFFS_WEBP__HUFFMAN_TABLE_OFFSETS[6] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  0, 2704, 3334, 3964, 4594, 5004,
+};
+
+#define WUFFS_WEBP__HUFFMAN_GROUP_SIZE 10008
+
+static const uint32_t
+WUFFS_WEBP__ALPHABET_SIZES[5] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  280, 256, 256, 256, 40,
+};
+
+static const uint8_t
+WUFFS_WEBP__CODE_LENGTH_CODE_ORDER[19] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  17, 18, 0, 1, 2, 3, 4, 5,
+  16, 6, 7, 8, 9, 10, 11, 12,
+  13, 14, 15,
+};
+
+static const uint8_t
+WUFFS_WEBP__DISTANCE_MAP[120] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  24, 7, 23, 25, 40, 6, 39, 41,
+  22, 26, 38, 42, 56, 5, 55, 57,
+  21, 27, 54, 58, 37, 43, 72, 4,
+  71, 73, 20, 28, 53, 59, 70, 74,
+  36, 44, 88, 69, 75, 52, 60, 3,
+  87, 89, 19, 29, 86, 90, 35, 45,
+  68, 76, 85, 91, 51, 61, 104, 2,
+  103, 105, 18, 30, 102, 106, 34, 46,
+  84, 92, 67, 77, 101, 107, 50, 62,
+  120, 1, 119, 121, 83, 93, 17, 31,
+  100, 108, 66, 78, 118, 122, 33, 47,
+  117, 123, 49, 63, 99, 109, 82, 94,
+  0, 116, 124, 65, 79, 16, 32, 98,
+  110, 48, 115, 125, 81, 95, 64, 114,
+  126, 97, 111, 80, 113, 127, 96, 112,
+};
+
+// ---------------- Private Initializer Prototypes
+
+// ---------------- Private Function Prototypes
+
+static wuffs_base__empty_struct
+wuffs_webp__decoder__fill_bitstream(
+    wuffs_webp__decoder* self,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status
+wuffs_webp__decoder__ensure_bits(
+    wuffs_webp__decoder* self,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__empty_struct
+wuffs_webp__decoder__refill_bits(
+    wuffs_webp__decoder* self);
+
+static uint32_t
+wuffs_webp__decoder__take_bits(
+    wuffs_webp__decoder* self,
+    uint32_t a_n);
+
+static wuffs_base__status
+wuffs_webp__decoder__decode_huffman_groups(
+    wuffs_webp__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf);
+
+static wuffs_base__status
+wuffs_webp__decoder__decode_huffman_code(
+    wuffs_webp__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf,
+    uint32_t a_g,
+    uint32_t a_k);
+
+static wuffs_base__status
+wuffs_webp__decoder__decode_code_lengths(
+    wuffs_webp__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    uint32_t a_n_symbols);
+
+static wuffs_base__empty_struct
+wuffs_webp__decoder__clear_code_lengths(
+    wuffs_webp__decoder* self,
+    uint32_t a_n);
+
+static wuffs_base__status
+wuffs_webp__decoder__build_group_huffman_table(
+    wuffs_webp__decoder* self,
+    wuffs_base__slice_u8 a_workbuf,
+    uint32_t a_g,
+    uint32_t a_k,
+    uint32_t a_n_symbols);
+
+static wuffs_base__status
+wuffs_webp__decoder__build_huffman_table(
+    wuffs_webp__decoder* self,
+    wuffs_base__slice_u8 a_t,
+    uint32_t a_n_symbols,
+    uint32_t a_root_bits);
+
+static uint32_t
+wuffs_webp__decoder__table_entry(
+    const wuffs_webp__decoder* self,
+    wuffs_base__slice_u8 a_t,
+    uint32_t a_i);
+
+static wuffs_base__empty_struct
+wuffs_webp__decoder__poke_table_entry(
+    wuffs_webp__decoder* self,
+    wuffs_base__slice_u8 a_t,
+    uint32_t a_i,
+    uint32_t a_e);
+
+static uint32_t
+wuffs_webp__decoder__huffman_lookup(
+    const wuffs_webp__decoder* self,
+    wuffs_base__slice_u8 a_t,
+    uint32_t a_offset,
+    uint64_t a_bits);
+
+static wuffs_base__status
+wuffs_webp__decoder__decode_pixels(
+    wuffs_webp__decoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_huff,
+    wuffs_base__slice_u8 a_ent,
+    uint32_t a_width);
+
+static uint32_t
+wuffs_webp__decoder__peek_pixel(
+    const wuffs_webp__decoder* self,
+    wuffs_base__slice_u8 a_s,
+    uint32_t a_i);
+
+static wuffs_base__empty_struct
+wuffs_webp__decoder__poke_pixel(
+    wuffs_webp__decoder* self,
+    wuffs_base__slice_u8 a_s,
+    uint32_t a_i,
+    uint32_t a_c);
+
+static wuffs_base__empty_struct
+wuffs_webp__decoder__apply_inverse_transforms(
+    wuffs_webp__decoder* self,
+    wuffs_base__slice_u8 a_workbuf);
+
+static wuffs_base__empty_struct
+wuffs_webp__decoder__apply_transform_predictor(
+    wuffs_webp__decoder* self,
+    wuffs_base__slice_u8 a_pix,
+    wuffs_base__slice_u8 a_data,
+    uint32_t a_width,
+    uint32_t a_bits);
+
+static uint32_t
+wuffs_webp__decoder__predict(
+    const wuffs_webp__decoder* self,
+    uint32_t a_mode,
+    uint32_t a_l,
+    uint32_t a_t,
+    uint32_t a_tr,
+    uint32_t a_tl);
+
+static uint32_t
+wuffs_webp__decoder__add_pixels(
+    const wuffs_webp__decoder* self,
+    uint32_t a_a,
+    uint32_t a_b);
+
+static uint32_t
+wuffs_webp__decoder__average_pixels(
+    const wuffs_webp__decoder* self,
+    uint32_t a_a,
+    uint32_t a_b);
+
+static uint32_t
+wuffs_webp__decoder__select(
+    const wuffs_webp__decoder* self,
+    uint32_t a_l,
+    uint32_t a_t,
+    uint32_t a_tl);
+
+static uint32_t
+wuffs_webp__decoder__clamp_add_subtract_full(
+    const wuffs_webp__decoder* self,
+    uint32_t a_a,
+    uint32_t a_b,
+    uint32_t a_c);
+
+static uint32_t
+wuffs_webp__decoder__clamp_add_subtract_half(
+    const wuffs_webp__decoder* self,
+    uint32_t a_a,
+    uint32_t a_b);
+
+static wuffs_base__empty_struct
+wuffs_webp__decoder__apply_transform_color(
+    wuffs_webp__decoder* self,
+    wuffs_base__slice_u8 a_pix,
+    wuffs_base__slice_u8 a_data,
+    uint32_t a_width,
+    uint32_t a_bits);
+
+static uint32_t
+wuffs_webp__decoder__sign_extend(
+    const wuffs_webp__decoder* self,
+    uint32_t a_v);
+
+static wuffs_base__empty_struct
+wuffs_webp__decoder__apply_transform_subtract_green(
+    wuffs_webp__decoder* self,
+    wuffs_base__slice_u8 a_pix,
+    uint32_t a_width);
+
+static wuffs_base__empty_struct
+wuffs_webp__decoder__apply_transform_color_indexing(
+    wuffs_webp__decoder* self,
+    wuffs_base__slice_u8 a_pix,
+    wuffs_base__slice_u8 a_data,
+    uint32_t a_width,
+    uint32_t a_bits);
+
+static uint32_t
+wuffs_webp__decoder__dst_pixfmt(
+    const wuffs_webp__decoder* self);
+
+static wuffs_base__empty_struct
+wuffs_webp__decoder__calculate_workbuf_offsets(
+    wuffs_webp__decoder* self);
+
+static wuffs_base__status
+wuffs_webp__decoder__decode_transforms(
+    wuffs_webp__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf);
+
+static wuffs_base__status
+wuffs_webp__decoder__decode_main_image(
+    wuffs_webp__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf);
+
+static wuffs_base__status
+wuffs_webp__decoder__decode_sub_image(
+    wuffs_webp__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf,
+    uint64_t a_offset,
+    uint32_t a_width,
+    uint32_t a_height);
+
+static uint32_t
+wuffs_webp__decoder__decode_color_cache_bits(
+    wuffs_webp__decoder* self);
+
+static wuffs_base__status
+wuffs_webp__decoder__decode_all_pixels(
+    wuffs_webp__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf,
+    uint64_t a_offset,
+    uint32_t a_width,
+    uint32_t a_height,
+    bool a_use_entropy_image);
+
+static wuffs_base__status
+wuffs_webp__decoder__decode_pixels_to_workbuf(
+    wuffs_webp__decoder* self,
+    wuffs_base__slice_u8 a_workbuf,
+    uint64_t a_offset,
+    uint32_t a_width,
+    uint32_t a_height,
+    bool a_use_entropy_image);
+
+static wuffs_base__empty_struct
+wuffs_webp__decoder__clear_color_cache(
+    wuffs_webp__decoder* self);
+
+static wuffs_base__status
+wuffs_webp__decoder__count_huffman_groups(
+    wuffs_webp__decoder* self,
+    wuffs_base__slice_u8 a_workbuf,
+    uint64_t a_n);
+
+static wuffs_base__empty_struct
+wuffs_webp__decoder__prepare_color_table(
+    wuffs_webp__decoder* self,
+    wuffs_base__slice_u8 a_workbuf,
+    uint32_t a_n);
+
+static uint32_t
+wuffs_webp__decoder__coded_width(
+    const wuffs_webp__decoder* self);
+
+static uint32_t
+wuffs_webp__decoder__div_round_up(
+    const wuffs_webp__decoder* self,
+    uint32_t a_a,
+    uint32_t a_bits);
+
+static wuffs_base__status
+wuffs_webp__decoder__swizzle(
+    wuffs_webp__decoder* self,
+    wuffs_base__pixel_buffer* a_dst,
+    wuffs_base__slice_u8 a_workbuf);
+
+// ---------------- VTables
+
+const wuffs_base__image_decoder__func_ptrs
+wuffs_webp__decoder__func_ptrs_for__wuffs_base__image_decoder = {
+  (bool(*)(const void*))(&wuffs_webp__decoder__can_decode_row_bands),
+  (wuffs_base__status(*)(void*,
+      wuffs_base__pixel_buffer*,
+      wuffs_base__io_buffer*,
+      wuffs_base__pixel_blend,
+      wuffs_base__slice_u8,
+      wuffs_base__decode_frame_options*))(&wuffs_webp__decoder__decode_frame),
+  (wuffs_base__status(*)(void*,
+      wuffs_base__frame_config*,
+      wuffs_base__io_buffer*))(&wuffs_webp__decoder__decode_frame_config),
+  (wuffs_base__status(*)(void*,
+      wuffs_base__image_config*,
+      wuffs_base__io_buffer*))(&wuffs_webp__decoder__decode_image_config),
+  (wuffs_base__rect_ie_u32(*)(const void*))(&wuffs_webp__decoder__frame_dirty_rect),
+  (uint32_t(*)(const void*))(&wuffs_webp__decoder__num_animation_loops),
+  (uint64_t(*)(const void*))(&wuffs_webp__decoder__num_decoded_frame_configs),
+  (uint64_t(*)(const void*))(&wuffs_webp__decoder__num_decoded_frames),
+  (wuffs_base__status(*)(void*,
+      uint64_t,
+      uint64_t))(&wuffs_webp__decoder__restart_frame),
+  (wuffs_base__empty_struct(*)(void*,
+      uint32_t,
+      bool))(&wuffs_webp__decoder__set_quirk_enabled),
+  (wuffs_base__empty_struct(*)(void*,
+      uint32_t,
+      bool))(&wuffs_webp__decoder__set_report_metadata),
+  (wuffs_base__status(*)(void*,
+      wuffs_base__io_buffer*,
+      wuffs_base__more_information*,
+      wuffs_base__io_buffer*))(&wuffs_webp__decoder__tell_me_more),
+  (wuffs_base__range_ii_u64(*)(const void*))(&wuffs_webp__decoder__workbuf_len),
+};
+
+// ---------------- Initializer Implementations
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+wuffs_webp__decoder__initialize(
+    wuffs_webp__decoder* self,
+    size_t sizeof_star_self,
+    uint64_t wuffs_version,
+    uint32_t options){
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  }
+
+  if ((options & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+    // The whole point of this if-check is to detect an uninitialized *self.
+    // We disable the warning on GCC. Clang-5.0 does not have this warning.
+    //
+    // The caller promises that *self is zeroed, so the empty asm tells GCC
+    // that private_impl is defined. Otherwise, once this function and a
+    // small method (e.g. one that reads a "choose" guard field) are both
+    // inlined into the caller, GCC -O3 warns about that method's read.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    __asm__ __volatile__("" : "+m"(self->private_impl));
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((options & WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      options |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    }
+  }
+
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__image_decoder.vtable_name =
+      wuffs_base__image_decoder__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__image_decoder.function_pointers =
+      (const void*)(&wuffs_webp__decoder__func_ptrs_for__wuffs_base__image_decoder);
+  return wuffs_base__make_status(NULL);
+}
+
+wuffs_webp__decoder*
+wuffs_webp__decoder__alloc() {
+  wuffs_webp__decoder* x =
+      (wuffs_webp__decoder*)(calloc(sizeof(wuffs_webp__decoder), 1));
+  if (!x) {
+    return NULL;
+  }
+  if (wuffs_webp__decoder__initialize(
+      x, sizeof(wuffs_webp__decoder), WUFFS_VERSION, WUFFS_INITIALIZE__ALREADY_ZEROED).repr) {
+    free(x);
+    return NULL;
+  }
+  return x;
+}
+
+size_t
+sizeof__wuffs_webp__decoder() {
+  return sizeof(wuffs_webp__decoder);
+}
+
+wuffs_base__stats
+wuffs_webp__decoder__stats(
+    const wuffs_webp__decoder* self) {
+  wuffs_base__stats ret = wuffs_base__make_empty_stats();
+#if defined(WUFFS_CONFIG__STATS)
+  if (!self) {
+    return ret;
+  }
+  ret = self->private_impl.stats;
+#else
+  (void)(self);
+#endif  // defined(WUFFS_CONFIG__STATS)
+  return ret;
+}
+
+// ---------------- Function Implementations
+
+// -------- func webp.decoder.fill_bitstream
+
+static wuffs_base__empty_struct
+wuffs_webp__decoder__fill_bitstream(
+    wuffs_webp__decoder* self,
+    wuffs_base__io_buffer* a_src) {
+  uint32_t v_ri = 0;
+  uint32_t v_wi = 0;
+  uint32_t v_n = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  v_ri = self->private_impl.f_bitstream_ri;
+  v_wi = self->private_impl.f_bitstream_wi;
+  if (v_wi < v_ri) {
+    self->private_impl.f_bitstream_ri = 0;
+    self->private_impl.f_bitstream_wi = 0;
+    if (a_src) {
+      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+    }
+    return wuffs_base__make_empty_struct();
+  }
+  if (v_ri >= 4096) {
+    wuffs_base__slice_u8__copy_from_slice(wuffs_base__make_slice_u8(self->private_data.f_bitstream_buffer, 8192), wuffs_base__slice_u8__subslice_ij(wuffs_base__make_slice_u8(self->private_data.f_bitstream_buffer, 8192), v_ri, v_wi));
+    v_wi -= v_ri;
+    v_ri = 0;
+    self->private_impl.f_bitstream_ri = 0;
+  }
+  v_n = wuffs_base__io_reader__limited_copy_u32_to_slice(
+      &iop_a_src, io2_a_src,self->private_impl.f_bitstream_remaining, wuffs_base__slice_u8__subslice_i(wuffs_base__make_slice_u8(self->private_data.f_bitstream_buffer, 8192), v_wi));
+  wuffs_base__u32__sat_sub_indirect(&self->private_impl.f_bitstream_remaining, v_n);
+  v_n += v_wi;
+  self->private_impl.f_bitstream_wi = wuffs_base__u32__min(v_n, 8192);
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func webp.decoder.ensure_bits
+
+static wuffs_base__status
+wuffs_webp__decoder__ensure_bits(
+    wuffs_webp__decoder* self,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_ensure_bits[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    label__0__continue:;
+    while (self->private_impl.f_bitstream_n_bits < 56) {
+      if ((self->private_impl.f_bitstream_remaining == 0) || (((uint32_t)(self->private_impl.f_bitstream_wi - self->private_impl.f_bitstream_ri)) >= 8)) {
+        wuffs_webp__decoder__refill_bits(self);
+        goto label__0__break;
+      }
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      wuffs_webp__decoder__fill_bitstream(self, a_src);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if ((self->private_impl.f_bitstream_remaining == 0) || (((uint32_t)(self->private_impl.f_bitstream_wi - self->private_impl.f_bitstream_ri)) >= 8)) {
+        goto label__0__continue;
+      } else if (a_src && a_src->meta.closed) {
+        status = wuffs_base__make_status(wuffs_webp__error__truncated_input);
+        goto exit;
+      }
+      status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
+    }
+    label__0__break:;
+
+    ok:
+    self->private_impl.p_ensure_bits[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_ensure_bits[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func webp.decoder.refill_bits
+
+static wuffs_base__empty_struct
+wuffs_webp__decoder__refill_bits(
+    wuffs_webp__decoder* self) {
+  uint64_t v_bits = 0;
+  uint32_t v_n_bits = 0;
+  uint32_t v_ri = 0;
+  uint32_t v_wi = 0;
+  uint32_t v_n = 0;
+  wuffs_base__slice_u8 v_s = {0};
+
+  v_n_bits = self->private_impl.f_bitstream_n_bits;
+  if (v_n_bits >= 56) {
+    return wuffs_base__make_empty_struct();
+  }
+  v_bits = self->private_impl.f_bitstream_bits;
+  v_ri = self->private_impl.f_bitstream_ri;
+  v_wi = self->private_impl.f_bitstream_wi;
+  if (v_ri <= v_wi) {
+    v_s = wuffs_base__slice_u8__subslice_ij(wuffs_base__make_slice_u8(self->private_data.f_bitstream_buffer, 8192), v_ri, v_wi);
+  }
+  if (((uint64_t)(v_s.len)) >= 8) {
+    v_bits |= ((uint64_t)(wuffs_base__peek_u64le__no_bounds_check(v_s.ptr) << v_n_bits));
+    v_n = (v_ri + ((63 - v_n_bits) >> 3));
+    v_ri = wuffs_base__u32__min(v_n, v_wi);
+    v_n_bits |= 56;
+  } else {
+    while (v_n_bits < 56) {
+      if ((v_ri < v_wi) && (v_ri < 8192)) {
+        v_bits |= ((uint64_t)(((uint64_t)(self->private_data.f_bitstream_buffer[v_ri])) << v_n_bits));
+        v_ri += 1;
+      } else {
+        wuffs_base__u32__sat_add_indirect(&self->private_impl.f_bitstream_n_padding_bits, 8);
+      }
+      v_n_bits += 8;
+    }
+  }
+  self->private_impl.f_bitstream_bits = v_bits;
+  self->private_impl.f_bitstream_n_bits = v_n_bits;
+  self->private_impl.f_bitstream_ri = v_ri;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func webp.decoder.take_bits
+
+static uint32_t
+wuffs_webp__decoder__take_bits(
+    wuffs_webp__decoder* self,
+    uint32_t a_n) {
+  uint32_t v_v = 0;
+
+  v_v = (((uint32_t)((self->private_impl.f_bitstream_bits & 65535))) & ((((uint32_t)(1)) << a_n) - 1));
+  self->private_impl.f_bitstream_bits >>= a_n;
+  self->private_impl.f_bitstream_n_bits = wuffs_base__u32__sat_sub(self->private_impl.f_bitstream_n_bits, a_n);
+  return v_v;
+}
+
+// -------- func webp.decoder.decode_huffman_groups
+
+static wuffs_base__status
+wuffs_webp__decoder__decode_huffman_groups(
+    wuffs_webp__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_g = 0;
+  uint32_t v_k = 0;
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_huffman_groups[0];
+  if (coro_susp_point) {
+    v_g = self->private_data.s_decode_huffman_groups[0].v_g;
+    v_k = self->private_data.s_decode_huffman_groups[0].v_k;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    v_g = 0;
+    while (v_g < self->private_impl.f_n_huffman_groups) {
+      v_k = 0;
+      while (v_k < 5) {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        status = wuffs_webp__decoder__decode_huffman_code(self,
+            a_src,
+            a_workbuf,
+            v_g,
+            v_k);
+        if (status.repr) {
+          goto suspend;
+        }
+        v_k += 1;
+      }
+      v_g += 1;
+    }
+    if (self->private_impl.f_bitstream_n_padding_bits > self->private_impl.f_bitstream_n_bits) {
+      status = wuffs_base__make_status(wuffs_webp__error__truncated_input);
+      goto exit;
+    }
+
+    goto ok;
+    ok:
+    self->private_impl.p_decode_huffman_groups[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_huffman_groups[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_decode_huffman_groups[0].v_g = v_g;
+  self->private_data.s_decode_huffman_groups[0].v_k = v_k;
+
+  goto exit;
+  exit:
+  return status;
+}
+
+// -------- func webp.decoder.decode_huffman_code
+
+static wuffs_base__status
+wuffs_webp__decoder__decode_huffman_code(
+    wuffs_webp__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf,
+    uint32_t a_g,
+    uint32_t a_k) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  uint32_t v_n_symbols = 0;
+  uint32_t v_two = 0;
+  uint32_t v_c = 0;
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_huffman_code[0];
+  if (coro_susp_point) {
+    v_n_symbols = self->private_data.s_decode_huffman_code[0].v_n_symbols;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    v_n_symbols = WUFFS_WEBP__ALPHABET_SIZES[a_k];
+    if ((a_k == 0) && (self->private_impl.f_color_cache_bits > 0)) {
+      v_n_symbols += (((uint32_t)(1)) << self->private_impl.f_color_cache_bits);
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+    status = wuffs_webp__decoder__ensure_bits(self, a_src);
+    if (status.repr) {
+      goto suspend;
+    }
+    v_c = wuffs_webp__decoder__take_bits(self, 1);
+    if (v_c != 0) {
+      wuffs_webp__decoder__clear_code_lengths(self, v_n_symbols);
+      v_two = wuffs_webp__decoder__take_bits(self, 1);
+      v_c = wuffs_webp__decoder__take_bits(self, 1);
+      if (v_c == 0) {
+        v_c = wuffs_webp__decoder__take_bits(self, 1);
+      } else {
+        v_c = wuffs_webp__decoder__take_bits(self, 8);
+      }
+      if (v_c < v_n_symbols) {
+        self->private_data.f_code_lengths[v_c] = 1;
+      }
+      if (v_two != 0) {
+        v_c = wuffs_webp__decoder__take_bits(self, 8);
+        if (v_c < v_n_symbols) {
+          self->private_data.f_code_lengths[v_c] = 1;
+        }
+      }
+    } else {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      status = wuffs_webp__decoder__decode_code_lengths(self, a_src, v_n_symbols);
+      if (status.repr) {
+        goto suspend;
+      }
+    }
+    v_status = wuffs_webp__decoder__build_group_huffman_table(self,
+        a_workbuf,
+        a_g,
+        a_k,
+        v_n_symbols);
+    if ( ! wuffs_base__status__is_ok(&v_status)) {
+      status = v_status;
+      if (wuffs_base__status__is_error(&status)) {
+        goto exit;
+      } else if (wuffs_base__status__is_suspension(&status)) {
+        status = wuffs_base__make_status(wuffs_base__error__cannot_return_a_suspension);
+        goto exit;
+      }
+      goto ok;
+    }
+
+    ok:
+    self->private_impl.p_decode_huffman_code[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_huffman_code[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_decode_huffman_code[0].v_n_symbols = v_n_symbols;
+
+  goto exit;
+  exit:
+  return status;
+}
+
+// -------- func webp.decoder.decode_code_lengths
+
+static wuffs_base__status
+wuffs_webp__decoder__decode_code_lengths(
+    wuffs_webp__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    uint32_t a_n_symbols) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  uint32_t v_n = 0;
+  uint32_t v_i = 0;
+  uint32_t v_max_symbol = 0;
+  uint32_t v_e = 0;
+  uint32_t v_c = 0;
+  uint8_t v_prev = 0;
+  uint8_t v_v = 0;
+  uint32_t v_repeat = 0;
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_code_lengths[0];
+  if (coro_susp_point) {
+    v_n = self->private_data.s_decode_code_lengths[0].v_n;
+    v_i = self->private_data.s_decode_code_lengths[0].v_i;
+    v_max_symbol = self->private_data.s_decode_code_lengths[0].v_max_symbol;
+    v_repeat = self->private_data.s_decode_code_lengths[0].v_repeat;
+    v_prev = self->private_data.s_decode_code_lengths[0].v_prev;
+    v_v = self->private_data.s_decode_code_lengths[0].v_v;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    v_c = wuffs_webp__decoder__take_bits(self, 4);
+    v_n = ((v_c & 15) + 4);
+    wuffs_webp__decoder__clear_code_lengths(self, 19);
+    v_i = 0;
+    while (v_i < v_n) {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      status = wuffs_webp__decoder__ensure_bits(self, a_src);
+      if (status.repr) {
+        goto suspend;
+      }
+      v_c = wuffs_webp__decoder__take_bits(self, 3);
+      self->private_data.f_code_lengths[WUFFS_WEBP__CODE_LENGTH_CODE_ORDER[v_i]] = ((uint8_t)((v_c & 7)));
+      v_i += 1;
+    }
+    v_status = wuffs_webp__decoder__build_huffman_table(self, wuffs_base__make_slice_u8(self->private_data.f_code_length_code_table, 256), 19, 7);
+    if ( ! wuffs_base__status__is_ok(&v_status)) {
+      status = v_status;
+      if (wuffs_base__status__is_error(&status)) {
+        goto exit;
+      } else if (wuffs_base__status__is_suspension(&status)) {
+        status = wuffs_base__make_status(wuffs_base__error__cannot_return_a_suspension);
+        goto exit;
+      }
+      goto ok;
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+    status = wuffs_webp__decoder__ensure_bits(self, a_src);
+    if (status.repr) {
+      goto suspend;
+    }
+    v_max_symbol = a_n_symbols;
+    v_c = wuffs_webp__decoder__take_bits(self, 1);
+    if (v_c != 0) {
+      v_c = wuffs_webp__decoder__take_bits(self, 3);
+      v_c = (2 + (2 * (v_c & 7)));
+      v_c = wuffs_webp__decoder__take_bits(self, wuffs_base__u32__min(v_c, 16));
+      v_max_symbol = (2 + v_c);
+      if (v_max_symbol > a_n_symbols) {
+        status = wuffs_base__make_status(wuffs_webp__error__bad_huffman_code);
+        goto exit;
+      }
+    }
+    wuffs_webp__decoder__clear_code_lengths(self, a_n_symbols);
+    v_prev = 8;
+    v_i = 0;
+    label__0__continue:;
+    while (v_i < a_n_symbols) {
+      if (v_max_symbol == 0) {
+        goto label__0__break;
+      }
+      v_max_symbol -= 1;
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      status = wuffs_webp__decoder__ensure_bits(self, a_src);
+      if (status.repr) {
+        goto suspend;
+      }
+      v_e = wuffs_webp__decoder__table_entry(self, wuffs_base__make_slice_u8(self->private_data.f_code_length_code_table, 256), ((uint32_t)((self->private_impl.f_bitstream_bits & 127))));
+      v_c = (v_e & 15);
+      self->private_impl.f_bitstream_bits >>= v_c;
+      self->private_impl.f_bitstream_n_bits = wuffs_base__u32__sat_sub(self->private_impl.f_bitstream_n_bits, v_c);
+      v_c = (v_e >> 4);
+      if (v_c < 16) {
+        if (v_i >= 2328) {
+          status = wuffs_base__make_status(wuffs_webp__error__internal_error_inconsistent_huffman_code);
+          goto exit;
+        }
+        self->private_data.f_code_lengths[v_i] = ((uint8_t)(v_c));
+        v_i += 1;
+        if (v_c != 0) {
+          v_prev = ((uint8_t)(v_c));
+        }
+        goto label__0__continue;
+      }
+      if (v_c == 16) {
+        v_repeat = wuffs_webp__decoder__take_bits(self, 2);
+        v_repeat += 3;
+        v_v = v_prev;
+      } else if (v_c == 17) {
+        v_repeat = wuffs_webp__decoder__take_bits(self, 3);
+        v_repeat += 3;
+        v_v = 0;
+      } else {
+        v_repeat = wuffs_webp__decoder__take_bits(self, 7);
+        v_repeat += 11;
+        v_v = 0;
+      }
+      if (v_repeat > ((uint32_t)(a_n_symbols - v_i))) {
+        status = wuffs_base__make_status(wuffs_webp__error__bad_huffman_code);
+        goto exit;
+      }
+      while (v_repeat > 0) {
+        if (v_i >= 2328) {
+          status = wuffs_base__make_status(wuffs_webp__error__internal_error_inconsistent_huffman_code);
+          goto exit;
+        }
+        self->private_data.f_code_lengths[v_i] = v_v;
+        v_i += 1;
+        v_repeat -= 1;
+      }
+    }
+    label__0__break:;
+
+    ok:
+    self->private_impl.p_decode_code_lengths[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_code_lengths[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_decode_code_lengths[0].v_n = v_n;
+  self->private_data.s_decode_code_lengths[0].v_i = v_i;
+  self->private_data.s_decode_code_lengths[0].v_max_symbol = v_max_symbol;
+  self->private_data.s_decode_code_lengths[0].v_repeat = v_repeat;
+  self->private_data.s_decode_code_lengths[0].v_prev = v_prev;
+  self->private_data.s_decode_code_lengths[0].v_v = v_v;
+
+  goto exit;
+  exit:
+  return status;
+}
+
+// -------- func webp.decoder.clear_code_lengths
+
+static wuffs_base__empty_struct
+wuffs_webp__decoder__clear_code_lengths(
+    wuffs_webp__decoder* self,
+    uint32_t a_n) {
+  uint32_t v_i = 0;
+
+  v_i = 0;
+  while (v_i < a_n) {
+    self->private_data.f_code_lengths[v_i] = 0;
+    v_i += 1;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func webp.decoder.build_group_huffman_table
+
+static wuffs_base__status
+wuffs_webp__decoder__build_group_huffman_table(
+    wuffs_webp__decoder* self,
+    wuffs_base__slice_u8 a_workbuf,
+    uint32_t a_g,
+    uint32_t a_k,
+    uint32_t a_n_symbols) {
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  wuffs_base__slice_u8 v_huff = {0};
+  uint64_t v_i = 0;
+  uint64_t v_j = 0;
+
+  if ((self->private_impl.f_workbuf_offsets[5] <= self->private_impl.f_workbuf_offsets[6]) && (self->private_impl.f_workbuf_offsets[6] <= ((uint64_t)(a_workbuf.len)))) {
+    v_huff = wuffs_base__slice_u8__subslice_ij(a_workbuf,
+        self->private_impl.f_workbuf_offsets[5],
+        self->private_impl.f_workbuf_offsets[6]);
+  }
+  v_i = ((((uint64_t)(a_g)) * ((uint64_t)(10008))) + (((uint64_t)(WUFFS_WEBP__HUFFMAN_TABLE_OFFSETS[a_k])) * 2));
+  v_j = ((((uint64_t)(a_g)) * ((uint64_t)(10008))) + (((uint64_t)(WUFFS_WEBP__HUFFMAN_TABLE_OFFSETS[(a_k + 1)])) * 2));
+  if ((v_i <= v_j) && (v_j <= ((uint64_t)(v_huff.len)))) {
+    v_status = wuffs_webp__decoder__build_huffman_table(self, wuffs_base__slice_u8__subslice_ij(v_huff, v_i, v_j), a_n_symbols, 8);
+    return wuffs_base__status__ensure_not_a_suspension(v_status);
+  }
+  return wuffs_base__make_status(wuffs_webp__error__internal_error_inconsistent_huffman_code);
+}
+
+// -------- func webp.decoder.build_huffman_table
+
+static wuffs_base__status
+wuffs_webp__decoder__build_huffman_table(
+    wuffs_webp__decoder* self,
+    wuffs_base__slice_u8 a_t,
+    uint32_t a_n_symbols,
+    uint32_t a_root_bits) {
+  uint32_t v_counts[16] = {0};
+  uint32_t v_offsets[16] = {0};
+  uint32_t v_i = 0;
+  uint32_t v_len = 0;
+  uint32_t v_total = 0;
+  uint32_t v_n_open = 0;
+  uint32_t v_n_nodes = 0;
+  uint32_t v_symbol = 0;
+  uint32_t v_key = 0;
+  uint32_t v_step = 0;
+  uint32_t v_s = 0;
+  uint32_t v_root_size = 0;
+  uint32_t v_root_mask = 0;
+  uint64_t v_t_length = 0;
+  uint32_t v_max_size = 0;
+  uint32_t v_top = 0;
+  uint32_t v_low = 0;
+  uint32_t v_table_bits = 0;
+  uint32_t v_table_size = 0;
+  uint32_t v_left = 0;
+  uint32_t v_j = 0;
+  uint32_t v_e = 0;
+
+  v_i = 0;
+  while (v_i < a_n_symbols) {
+    v_counts[(self->private_data.f_code_lengths[v_i] & 15)] += 1;
+    v_i += 1;
+  }
+  v_total = 0;
+  v_len = 1;
+  while (v_len < 16) {
+    if (v_counts[v_len] > (((uint32_t)(1)) << v_len)) {
+      return wuffs_base__make_status(wuffs_webp__error__bad_huffman_code_over_subscribed);
+    }
+    v_offsets[v_len] = v_total;
+    v_total += v_counts[v_len];
+    v_len += 1;
+  }
+  if (v_total == 0) {
+    return wuffs_base__make_status(wuffs_webp__error__bad_huffman_code);
+  }
+  v_i = 0;
+  while (v_i < a_n_symbols) {
+    v_len = ((uint32_t)((self->private_data.f_code_lengths[v_i] & 15)));
+    if (v_len > 0) {
+      v_j = v_offsets[v_len];
+      if (v_j >= 2328) {
+        return wuffs_base__make_status(wuffs_webp__error__internal_error_inconsistent_huffman_code);
+      }
+      self->private_data.f_sorted_symbols[v_j] = ((uint16_t)(v_i));
+      v_offsets[v_len] = (v_j + 1);
+    }
+    v_i += 1;
+  }
+  v_root_size = (((uint32_t)(1)) << a_root_bits);
+  v_root_mask = ((uint32_t)(v_root_size - 1));
+  v_t_length = (((uint64_t)(a_t.len)) / 2);
+  v_max_size = ((uint32_t)(wuffs_base__u64__min(v_t_length, 4096)));
+  if (v_max_size < v_root_size) {
+    return wuffs_base__make_status(wuffs_webp__error__internal_error_inconsistent_huffman_code);
+  }
+  if (v_total == 1) {
+    v_e = (((uint32_t)(self->private_data.f_sorted_symbols[0])) << 4);
+    v_j = 0;
+    while (v_j < v_root_size) {
+      wuffs_webp__decoder__poke_table_entry(self, a_t, v_j, v_e);
+      v_j += 1;
+    }
+    return wuffs_base__make_status(NULL);
+  }
+  v_key = 0;
+  v_n_open = 1;
+  v_n_nodes = 1;
+  v_symbol = 0;
+  v_len = 1;
+  v_step = 2;
+  while (v_len <= a_root_bits) {
+    v_n_open = ((v_n_open & 32767) << 1);
+    v_n_nodes += v_n_open;
+    if (v_n_open < v_counts[v_len]) {
+      return wuffs_base__make_status(wuffs_webp__error__bad_huffman_code_over_subscribed);
+    }
+    v_n_open -= v_counts[v_len];
+    while (v_counts[v_len] > 0) {
+      if (v_symbol >= 2328) {
+        return wuffs_base__make_status(wuffs_webp__error__internal_error_inconsistent_huffman_code);
+      }
+      v_e = ((((uint32_t)(self->private_data.f_sorted_symbols[v_symbol])) << 4) | v_len);
+      v_symbol += 1;
+      v_j = v_key;
+      while (v_j < v_root_size) {
+        wuffs_webp__decoder__poke_table_entry(self, a_t, v_j, v_e);
+        v_j += v_step;
+      }
+      v_s = (((uint32_t)(1)) << (v_len - 1));
+      while ((v_key & v_s) != 0) {
+        v_s >>= 1;
+      }
+      if (v_s != 0) {
+        v_key = ((uint32_t)((v_key & ((uint32_t)(v_s - 1))) + v_s));
+      }
+      v_counts[v_len] -= 1;
+    }
+    v_len += 1;
+    v_step = ((v_step & 32767) << 1);
+  }
+  v_top = 0;
+  v_low = 4294967295;
+  v_table_size = v_root_size;
+  v_len = (a_root_bits + 1);
+  v_step = 2;
+  while (v_len < 16) {
+    v_n_open = ((v_n_open & 32767) << 1);
+    v_n_nodes += v_n_open;
+    if (v_n_open < v_counts[v_len]) {
+      return wuffs_base__make_status(wuffs_webp__error__bad_huffman_code_over_subscribed);
+    }
+    v_n_open -= v_counts[v_len];
+    while (v_counts[v_len] > 0) {
+      if ((v_key & v_root_mask) != v_low) {
+        v_top += v_table_size;
+        v_j = ((uint32_t)(v_len - a_root_bits));
+        v_left = (((uint32_t)(1)) << wuffs_base__u32__min(v_j, 15));
+        v_j = v_len;
+        while (v_j < 15) {
+          if (v_left <= v_counts[v_j]) {
+            goto label__0__break;
+          }
+          v_left = (((v_left - v_counts[v_j]) & 32767) << 1);
+          v_j += 1;
+        }
+        label__0__break:;
+        v_j -= a_root_bits;
+        v_table_bits = wuffs_base__u32__min(v_j, 15);
+        v_table_size = (((uint32_t)(1)) << v_table_bits);
+        if (v_top > v_max_size) {
+          return wuffs_base__make_status(wuffs_webp__error__bad_huffman_code);
+        }
+        if (v_table_size > (v_max_size - v_top)) {
+          return wuffs_base__make_status(wuffs_webp__error__bad_huffman_code);
+        }
+        v_low = (v_key & v_root_mask);
+        wuffs_webp__decoder__poke_table_entry(self, a_t, v_low, (((v_top & 4095) << 4) | (((uint32_t)(v_table_bits + a_root_bits)) & 15)));
+      }
+      if (v_symbol >= 2328) {
+        return wuffs_base__make_status(wuffs_webp__error__internal_error_inconsistent_huffman_code);
+      }
+      v_e = ((((uint32_t)(self->private_data.f_sorted_symbols[v_symbol])) << 4) | (((uint32_t)(v_len - a_root_bits)) & 15));
+      v_symbol += 1;
+      v_j = (v_key >> a_root_bits);
+      while (v_j < v_table_size) {
+        wuffs_webp__decoder__poke_table_entry(self, a_t, ((uint32_t)(v_top + v_j)), v_e);
+        v_j += v_step;
+      }
+      v_s = (((uint32_t)(1)) << (v_len - 1));
+      while ((v_key & v_s) != 0) {
+        v_s >>= 1;
+      }
+      if (v_s != 0) {
+        v_key = ((uint32_t)((v_key & ((uint32_t)(v_s - 1))) + v_s));
+      }
+      v_counts[v_len] -= 1;
+    }
+    v_len += 1;
+    v_step = ((v_step & 32767) << 1);
+  }
+  if (v_n_nodes != ((uint32_t)(((uint32_t)(v_total * 2)) - 1))) {
+    return wuffs_base__make_status(wuffs_webp__error__bad_huffman_code_under_subscribed);
+  }
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func webp.decoder.table_entry
+
+static uint32_t
+wuffs_webp__decoder__table_entry(
+    const wuffs_webp__decoder* self,
+    wuffs_base__slice_u8 a_t,
+    uint32_t a_i) {
+  uint64_t v_j = 0;
+  wuffs_base__slice_u8 v_s = {0};
+
+  v_j = (((uint64_t)(a_i)) * 2);
+  if (v_j <= ((uint64_t)(a_t.len))) {
+    v_s = wuffs_base__slice_u8__subslice_i(a_t, v_j);
+    if (((uint64_t)(v_s.len)) >= 2) {
+      return ((uint32_t)(wuffs_base__peek_u16le__no_bounds_check(v_s.ptr)));
+    }
+  }
+  return 0;
+}
+
+// -------- func webp.decoder.poke_table_entry
+
+static wuffs_base__empty_struct
+wuffs_webp__decoder__poke_table_entry(
+    wuffs_webp__decoder* self,
+    wuffs_base__slice_u8 a_t,
+    uint32_t a_i,
+    uint32_t a_e) {
+  uint64_t v_j = 0;
+  wuffs_base__slice_u8 v_s = {0};
+
+  v_j = (((uint64_t)(a_i)) * 2);
+  if (v_j <= ((uint64_t)(a_t.len))) {
+    v_s = wuffs_base__slice_u8__subslice_i(a_t, v_j);
+    if (((uint64_t)(v_s.len)) >= 2) {
+      wuffs_base__poke_u16le__no_bounds_check(wuffs_base__slice_u8__subslice_j(v_s, 2).ptr, ((uint16_t)((a_e & 65535))));
+    }
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func webp.decoder.huffman_lookup
+
+static uint32_t
+wuffs_webp__decoder__huffman_lookup(
+    const wuffs_webp__decoder* self,
+    wuffs_base__slice_u8 a_t,
+    uint32_t a_offset,
+    uint64_t a_bits) {
+  uint32_t v_e = 0;
+  uint32_t v_n = 0;
+
+  v_e = wuffs_webp__decoder__table_entry(self, a_t, (a_offset + ((uint32_t)((a_bits & 255)))));
+  v_n = (v_e & 15);
+  if (v_n > 8) {
+    v_e = wuffs_webp__decoder__table_entry(self, a_t, (a_offset + (v_e >> 4) + (((uint32_t)(((a_bits >> 8) & 127))) & ((((uint32_t)(1)) << (v_n - 8)) - 1))));
+    return ((v_e & 65520) | (((v_e & 7) + 8) & 15));
+  }
+  return v_e;
+}
+
+// -------- func webp.decoder.decode_pixels
+
+static wuffs_base__status
+wuffs_webp__decoder__decode_pixels(
+    wuffs_webp__decoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_huff,
+    wuffs_base__slice_u8 a_ent,
+    uint32_t a_width) {
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  uint64_t v_bits = 0;
+  uint32_t v_n_bits = 0;
+  uint32_t v_ri = 0;
+  uint32_t v_wi = 0;
+  uint32_t v_n = 0;
+  wuffs_base__slice_u8 v_s = {0};
+  uint64_t v_dst_length = 0;
+  uint32_t v_n_pixels = 0;
+  uint32_t v_pos = 0;
+  uint32_t v_x = 0;
+  uint32_t v_y = 0;
+  uint32_t v_eb = 0;
+  uint32_t v_emask = 0;
+  uint32_t v_cache_bits = 0;
+  uint32_t v_cache_shift = 0;
+  wuffs_base__slice_u8 v_hg = {0};
+  bool v_hg_needed = false;
+  uint32_t v_g = 0;
+  uint32_t v_e = 0;
+  uint32_t v_green = 0;
+  uint32_t v_red = 0;
+  uint32_t v_blue = 0;
+  uint32_t v_alpha = 0;
+  uint32_t v_argb = 0;
+  uint32_t v_length = 0;
+  uint32_t v_dist = 0;
+  uint32_t v_c = 0;
+  uint32_t v_m = 0;
+
+  if (a_width <= 0) {
+    return wuffs_base__make_status(wuffs_webp__error__internal_error_inconsistent_huffman_code);
+  }
+  v_dst_length = (((uint64_t)(a_dst.len)) / 4);
+  v_n_pixels = ((uint32_t)(wuffs_base__u64__min(v_dst_length, 268435456)));
+  v_bits = self->private_impl.f_bitstream_bits;
+  v_n_bits = self->private_impl.f_bitstream_n_bits;
+  v_ri = self->private_impl.f_bitstream_ri;
+  v_wi = self->private_impl.f_bitstream_wi;
+  v_pos = self->private_impl.f_pixels_pos;
+  v_x = (v_pos % a_width);
+  v_y = (v_pos / a_width);
+  if (((uint64_t)(a_ent.len)) > 0) {
+    v_eb = self->private_impl.f_entropy_bits;
+  }
+  v_emask = ((((uint32_t)(1)) << v_eb) - 1);
+  v_cache_bits = self->private_impl.f_color_cache_bits;
+  v_cache_shift = ((32 - v_cache_bits) & 31);
+  v_hg_needed = true;
+  label__0__continue:;
+  while (v_pos < v_n_pixels) {
+    if ((self->private_impl.f_bitstream_remaining > 0) && (((uint32_t)(v_wi - v_ri)) < 16)) {
+      v_status = wuffs_base__make_status(wuffs_webp__note__internal_note_short_read);
+      goto label__0__break;
+    }
+    if (((v_x & v_emask) == 0) && (((uint64_t)(a_ent.len)) > 0)) {
+      v_hg_needed = true;
+    }
+    if (v_hg_needed) {
+      v_hg_needed = false;
+      v_g = 0;
+      if (((uint64_t)(a_ent.len)) > 0) {
+        v_g = ((wuffs_webp__decoder__peek_pixel(self, a_ent, ((uint32_t)(((uint32_t)((v_y >> v_eb) * self->private_impl.f_entropy_width)) + (v_x >> v_eb)))) >> 8) & 65535);
+        if (v_g >= self->private_impl.f_n_huffman_groups) {
+          v_status = wuffs_base__make_status(wuffs_webp__error__bad_huffman_code);
+          goto label__0__break;
+        }
+      }
+      v_hg = wuffs_base__utility__empty_slice_u8();
+      if ((((uint64_t)(v_g)) * ((uint64_t)(10008))) <= ((uint64_t)(a_huff.len))) {
+        v_hg = wuffs_base__slice_u8__subslice_i(a_huff, (((uint64_t)(v_g)) * ((uint64_t)(10008))));
+      }
+    }
+    if (v_n_bits < 56) {
+      v_s = wuffs_base__utility__empty_slice_u8();
+      if (v_ri <= v_wi) {
+        v_s = wuffs_base__slice_u8__subslice_ij(wuffs_base__make_slice_u8(self->private_data.f_bitstream_buffer, 8192), v_ri, v_wi);
+      }
+      if (((uint64_t)(v_s.len)) >= 8) {
+        v_bits |= ((uint64_t)(wuffs_base__peek_u64le__no_bounds_check(v_s.ptr) << v_n_bits));
+        v_n = (v_ri + ((63 - v_n_bits) >> 3));
+        v_ri = wuffs_base__u32__min(v_n, v_wi);
+        v_n_bits |= 56;
+      } else {
+        while (v_n_bits < 56) {
+          if ((v_ri < v_wi) && (v_ri < 8192)) {
+            v_bits |= ((uint64_t)(((uint64_t)(self->private_data.f_bitstream_buffer[v_ri])) << v_n_bits));
+            v_ri += 1;
+          } else {
+            wuffs_base__u32__sat_add_indirect(&self->private_impl.f_bitstream_n_padding_bits, 8);
+          }
+          v_n_bits += 8;
+        }
+        if (self->private_impl.f_bitstream_n_padding_bits > v_n_bits) {
+          v_status = wuffs_base__make_status(wuffs_webp__error__truncated_input);
+          goto label__0__break;
+        }
+      }
+    }
+    v_e = wuffs_webp__decoder__huffman_lookup(self, v_hg, WUFFS_WEBP__HUFFMAN_TABLE_OFFSETS[0], v_bits);
+    v_c = (v_e & 15);
+    v_bits >>= v_c;
+    v_n_bits = wuffs_base__u32__sat_sub(v_n_bits, v_c);
+    v_green = (v_e >> 4);
+    if (v_green < 256) {
+      v_e = wuffs_webp__decoder__huffman_lookup(self, v_hg, WUFFS_WEBP__HUFFMAN_TABLE_OFFSETS[1], v_bits);
+      v_c = (v_e & 15);
+      v_bits >>= v_c;
+      v_n_bits = wuffs_base__u32__sat_sub(v_n_bits, v_c);
+      v_red = ((v_e >> 4) & 255);
+      if (v_n_bits < 56) {
+        v_s = wuffs_base__utility__empty_slice_u8();
+        if (v_ri <= v_wi) {
+          v_s = wuffs_base__slice_u8__subslice_ij(wuffs_base__make_slice_u8(self->private_data.f_bitstream_buffer, 8192), v_ri, v_wi);
+        }
+        if (((uint64_t)(v_s.len)) >= 8) {
+          v_bits |= ((uint64_t)(wuffs_base__peek_u64le__no_bounds_check(v_s.ptr) << v_n_bits));
+          v_n = (v_ri + ((63 - v_n_bits) >> 3));
+          v_ri = wuffs_base__u32__min(v_n, v_wi);
+          v_n_bits |= 56;
+        } else {
+          while (v_n_bits < 56) {
+            if ((v_ri < v_wi) && (v_ri < 8192)) {
+              v_bits |= ((uint64_t)(((uint64_t)(self->private_data.f_bitstream_buffer[v_ri])) << v_n_bits));
+              v_ri += 1;
+            } else {
+              wuffs_base__u32__sat_add_indirect(&self->private_impl.f_bitstream_n_padding_bits, 8);
+            }
+            v_n_bits += 8;
+          }
+        }
+      }
+      v_e = wuffs_webp__decoder__huffman_lookup(self, v_hg, WUFFS_WEBP__HUFFMAN_TABLE_OFFSETS[2], v_bits);
+      v_c = (v_e & 15);
+      v_bits >>= v_c;
+      v_n_bits = wuffs_base__u32__sat_sub(v_n_bits, v_c);
+      v_blue = ((v_e >> 4) & 255);
+      v_e = wuffs_webp__decoder__huffman_lookup(self, v_hg, WUFFS_WEBP__HUFFMAN_TABLE_OFFSETS[3], v_bits);
+      v_c = (v_e & 15);
+      v_bits >>= v_c;
+      v_n_bits = wuffs_base__u32__sat_sub(v_n_bits, v_c);
+      v_alpha = ((v_e >> 4) & 255);
+      v_argb = ((v_alpha << 24) |
+          (v_red << 16) |
+          (v_green << 8) |
+          v_blue);
+      wuffs_webp__decoder__poke_pixel(self, a_dst, v_pos, v_argb);
+      if (v_cache_bits > 0) {
+        self->private_data.f_color_cache[((((uint32_t)(v_argb * 506832829)) >> v_cache_shift) & 2047)] = v_argb;
+      }
+      v_pos += 1;
+      v_x += 1;
+      if (v_x >= a_width) {
+        v_x = 0;
+        v_y += 1;
+      }
+      goto label__0__continue;
+    } else if (v_green >= 280) {
+      v_argb = self->private_data.f_color_cache[((v_green - 280) & 2047)];
+      wuffs_webp__decoder__poke_pixel(self, a_dst, v_pos, v_argb);
+      if (v_cache_bits > 0) {
+        self->private_data.f_color_cache[((((uint32_t)(v_argb * 506832829)) >> v_cache_shift) & 2047)] = v_argb;
+      }
+      v_pos += 1;
+      v_x += 1;
+      if (v_x >= a_width) {
+        v_x = 0;
+        v_y += 1;
+      }
+      goto label__0__continue;
+    }
+    v_c = (v_green - 256);
+    if (v_c < 4) {
+      v_length = (v_c + 1);
+    } else {
+      v_m = (((v_c - 2) >> 1) & 15);
+      v_length = (((((2 + (v_c & 1)) << v_m) | (((uint32_t)((v_bits & 16777215))) & ((((uint32_t)(1)) << v_m) - 1))) & 65535) + 1);
+      v_bits >>= v_m;
+      v_n_bits = wuffs_base__u32__sat_sub(v_n_bits, v_m);
+    }
+    if (v_n_bits < 56) {
+      v_s = wuffs_base__utility__empty_slice_u8();
+      if (v_ri <= v_wi) {
+        v_s = wuffs_base__slice_u8__subslice_ij(wuffs_base__make_slice_u8(self->private_data.f_bitstream_buffer, 8192), v_ri, v_wi);
+      }
+      if (((uint64_t)(v_s.len)) >= 8) {
+        v_bits |= ((uint64_t)(wuffs_base__peek_u64le__no_bounds_check(v_s.ptr) << v_n_bits));
+        v_n = (v_ri + ((63 - v_n_bits) >> 3));
+        v_ri = wuffs_base__u32__min(v_n, v_wi);
+        v_n_bits |= 56;
+      } else {
+        while (v_n_bits < 56) {
+          if ((v_ri < v_wi) && (v_ri < 8192)) {
+            v_bits |= ((uint64_t)(((uint64_t)(self->private_data.f_bitstream_buffer[v_ri])) << v_n_bits));
+            v_ri += 1;
+          } else {
+            wuffs_base__u32__sat_add_indirect(&self->private_impl.f_bitstream_n_padding_bits, 8);
+          }
+          v_n_bits += 8;
+        }
+      }
+    }
+    v_e = wuffs_webp__decoder__huffman_lookup(self, v_hg, WUFFS_WEBP__HUFFMAN_TABLE_OFFSETS[4], v_bits);
+    v_c = (v_e & 15);
+    v_bits >>= v_c;
+    v_n_bits = wuffs_base__u32__sat_sub(v_n_bits, v_c);
+    v_c = ((v_e >> 4) & 63);
+    if (v_c < 4) {
+      v_dist = (v_c + 1);
+    } else {
+      v_m = (((v_c - 2) >> 1) & 31);
+      v_dist = (((((2 + (v_c & 1)) << v_m) | (((uint32_t)((v_bits & 16777215))) & ((((uint32_t)(1)) << v_m) - 1))) & 16777215) + 1);
+      v_bits >>= v_m;
+      v_n_bits = wuffs_base__u32__sat_sub(v_n_bits, v_m);
+    }
+    if (v_dist > 120) {
+      v_dist -= 120;
+    } else {
+      v_m = ((uint32_t)(v_dist - 1));
+      v_m = ((uint32_t)(WUFFS_WEBP__DISTANCE_MAP[wuffs_base__u32__min(v_m, 119)]));
+      v_dist = (((v_m >> 4) * a_width) + 8);
+      if (v_dist <= (v_m & 15)) {
+        v_dist = 1;
+      } else {
+        v_dist -= (v_m & 15);
+      }
+    }
+    if ((v_dist > v_pos) || (v_length > ((uint32_t)(v_n_pixels - v_pos)))) {
+      v_status = wuffs_base__make_status(wuffs_webp__error__bad_back_reference);
+      goto label__0__break;
+    }
+    while (v_length > 0) {
+      v_argb = wuffs_webp__decoder__peek_pixel(self, a_dst, ((uint32_t)(v_pos - v_dist)));
+      wuffs_webp__decoder__poke_pixel(self, a_dst, v_pos, v_argb);
+      if (v_cache_bits > 0) {
+        self->private_data.f_color_cache[((((uint32_t)(v_argb * 506832829)) >> v_cache_shift) & 2047)] = v_argb;
+      }
+      v_pos += 1;
+      v_x += 1;
+      if (v_x >= a_width) {
+        v_x = 0;
+        v_y += 1;
+      }
+      v_length -= 1;
+    }
+    v_hg_needed = true;
+  }
+  label__0__break:;
+  self->private_impl.f_bitstream_bits = v_bits;
+  self->private_impl.f_bitstream_n_bits = v_n_bits;
+  self->private_impl.f_bitstream_ri = v_ri;
+  self->private_impl.f_pixels_pos = v_pos;
+  return wuffs_base__status__ensure_not_a_suspension(v_status);
+}
+
+// -------- func webp.decoder.peek_pixel
+
+static uint32_t
+wuffs_webp__decoder__peek_pixel(
+    const wuffs_webp__decoder* self,
+    wuffs_base__slice_u8 a_s,
+    uint32_t a_i) {
+  uint64_t v_j = 0;
+  wuffs_base__slice_u8 v_t = {0};
+
+  v_j = (((uint64_t)(a_i)) * 4);
+  if (v_j <= ((uint64_t)(a_s.len))) {
+    v_t = wuffs_base__slice_u8__subslice_i(a_s, v_j);
+    if (((uint64_t)(v_t.len)) >= 4) {
+      return wuffs_base__peek_u32le__no_bounds_check(v_t.ptr);
+    }
+  }
+  return 0;
+}
+
+// -------- func webp.decoder.poke_pixel
+
+static wuffs_base__empty_struct
+wuffs_webp__decoder__poke_pixel(
+    wuffs_webp__decoder* self,
+    wuffs_base__slice_u8 a_s,
+    uint32_t a_i,
+    uint32_t a_c) {
+  uint64_t v_j = 0;
+  wuffs_base__slice_u8 v_t = {0};
+
+  v_j = (((uint64_t)(a_i)) * 4);
+  if (v_j <= ((uint64_t)(a_s.len))) {
+    v_t = wuffs_base__slice_u8__subslice_i(a_s, v_j);
+    if (((uint64_t)(v_t.len)) >= 4) {
+      wuffs_base__poke_u32le__no_bounds_check(wuffs_base__slice_u8__subslice_j(v_t, 4).ptr, a_c);
+    }
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func webp.decoder.apply_inverse_transforms
+
+static wuffs_base__empty_struct
+wuffs_webp__decoder__apply_inverse_transforms(
+    wuffs_webp__decoder* self,
+    wuffs_base__slice_u8 a_workbuf) {
+  wuffs_base__slice_u8 v_pix = {0};
+  wuffs_base__slice_u8 v_data = {0};
+  uint32_t v_i = 0;
+  uint8_t v_t = 0;
+  uint32_t v_width = 0;
+  uint32_t v_bits = 0;
+
+  if (self->private_impl.f_workbuf_offsets[1] > ((uint64_t)(a_workbuf.len))) {
+    return wuffs_base__make_empty_struct();
+  }
+  v_pix = wuffs_base__slice_u8__subslice_j(a_workbuf, self->private_impl.f_workbuf_offsets[1]);
+  v_i = self->private_impl.f_n_transforms;
+  while (v_i > 0) {
+    v_i -= 1;
+    v_t = self->private_impl.f_transform_types[v_i];
+    v_width = self->private_impl.f_transform_widths[v_i];
+    v_bits = self->private_impl.f_transform_bits[v_i];
+    v_data = wuffs_base__utility__empty_slice_u8();
+    if ((self->private_impl.f_workbuf_offsets[(v_t + 1)] <= self->private_impl.f_workbuf_offsets[(v_t + 2)]) && (self->private_impl.f_workbuf_offsets[(v_t + 2)] <= ((uint64_t)(a_workbuf.len)))) {
+      v_data = wuffs_base__slice_u8__subslice_ij(a_workbuf,
+          self->private_impl.f_workbuf_offsets[(v_t + 1)],
+          self->private_impl.f_workbuf_offsets[(v_t + 2)]);
+    }
+    if (v_t == 0) {
+      wuffs_webp__decoder__apply_transform_predictor(self,
+          v_pix,
+          v_data,
+          v_width,
+          v_bits);
+    } else if (v_t == 1) {
+      wuffs_webp__decoder__apply_transform_color(self,
+          v_pix,
+          v_data,
+          v_width,
+          v_bits);
+    } else if (v_t == 2) {
+      wuffs_webp__decoder__apply_transform_subtract_green(self, v_pix, v_width);
+    } else {
+      wuffs_webp__decoder__apply_transform_color_indexing(self,
+          v_pix,
+          v_data,
+          v_width,
+          v_bits);
+    }
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func webp.decoder.apply_transform_predictor
+
+static wuffs_base__empty_struct
+wuffs_webp__decoder__apply_transform_predictor(
+    wuffs_webp__decoder* self,
+    wuffs_base__slice_u8 a_pix,
+    wuffs_base__slice_u8 a_data,
+    uint32_t a_width,
+    uint32_t a_bits) {
+  uint32_t v_tile_width = 0;
+  uint32_t v_y = 0;
+  uint32_t v_x = 0;
+  uint32_t v_curr_row = 0;
+  uint32_t v_prev_row = 0;
+  uint32_t v_tile_row = 0;
+  uint32_t v_mode = 0;
+  uint32_t v_l = 0;
+  uint32_t v_t = 0;
+  uint32_t v_tr = 0;
+  uint32_t v_tl = 0;
+
+  if (a_width <= 0) {
+    return wuffs_base__make_empty_struct();
+  }
+  v_tile_width = wuffs_webp__decoder__div_round_up(self, a_width, a_bits);
+  v_l = 4278190080;
+  v_x = 0;
+  while (v_x < a_width) {
+    v_l = wuffs_webp__decoder__add_pixels(self, wuffs_webp__decoder__peek_pixel(self, a_pix, v_x), v_l);
+    wuffs_webp__decoder__poke_pixel(self, a_pix, v_x, v_l);
+    v_x += 1;
+  }
+  v_y = 1;
+  while (v_y < self->private_impl.f_height) {
+    v_curr_row = ((uint32_t)(v_y * a_width));
+    v_prev_row = ((uint32_t)(v_curr_row - a_width));
+    v_tile_row = ((uint32_t)((v_y >> a_bits) * v_tile_width));
+    v_l = wuffs_webp__decoder__add_pixels(self, wuffs_webp__decoder__peek_pixel(self, a_pix, v_curr_row), wuffs_webp__decoder__peek_pixel(self, a_pix, v_prev_row));
+    wuffs_webp__decoder__poke_pixel(self, a_pix, v_curr_row, v_l);
+    v_x = 1;
+    while (v_x < a_width) {
+      v_mode = ((wuffs_webp__decoder__peek_pixel(self, a_data, ((uint32_t)(v_tile_row + (v_x >> a_bits)))) >> 8) & 15);
+      v_t = wuffs_webp__decoder__peek_pixel(self, a_pix, ((uint32_t)(v_prev_row + v_x)));
+      v_tl = wuffs_webp__decoder__peek_pixel(self, a_pix, ((uint32_t)(((uint32_t)(v_prev_row + v_x)) - 1)));
+      v_tr = wuffs_webp__decoder__peek_pixel(self, a_pix, ((uint32_t)(((uint32_t)(v_prev_row + v_x)) + 1)));
+      v_l = wuffs_webp__decoder__add_pixels(self, wuffs_webp__decoder__peek_pixel(self, a_pix, ((uint32_t)(v_curr_row + v_x))), wuffs_webp__decoder__predict(self,
+          v_mode,
+          v_l,
+          v_t,
+          v_tr,
+          v_tl));
+      wuffs_webp__decoder__poke_pixel(self, a_pix, ((uint32_t)(v_curr_row + v_x)), v_l);
+      v_x += 1;
+    }
+    v_y += 1;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func webp.decoder.predict
+
+static uint32_t
+wuffs_webp__decoder__predict(
+    const wuffs_webp__decoder* self,
+    uint32_t a_mode,
+    uint32_t a_l,
+    uint32_t a_t,
+    uint32_t a_tr,
+    uint32_t a_tl) {
+  if (a_mode == 1) {
+    return a_l;
+  } else if (a_mode == 2) {
+    return a_t;
+  } else if (a_mode == 3) {
+    return a_tr;
+  } else if (a_mode == 4) {
+    return a_tl;
+  } else if (a_mode == 5) {
+    return wuffs_webp__decoder__average_pixels(self, wuffs_webp__decoder__average_pixels(self, a_l, a_tr), a_t);
+  } else if (a_mode == 6) {
+    return wuffs_webp__decoder__average_pixels(self, a_l, a_tl);
+  } else if (a_mode == 7) {
+    return wuffs_webp__decoder__average_pixels(self, a_l, a_t);
+  } else if (a_mode == 8) {
+    return wuffs_webp__decoder__average_pixels(self, a_tl, a_t);
+  } else if (a_mode == 9) {
+    return wuffs_webp__decoder__average_pixels(self, a_t, a_tr);
+  } else if (a_mode == 10) {
+    return wuffs_webp__decoder__average_pixels(self, wuffs_webp__decoder__average_pixels(self, a_l, a_tl), wuffs_webp__decoder__average_pixels(self, a_t, a_tr));
+  } else if (a_mode == 11) {
+    return wuffs_webp__decoder__select(self, a_l, a_t, a_tl);
+  } else if (a_mode == 12) {
+    return wuffs_webp__decoder__clamp_add_subtract_full(self, a_l, a_t, a_tl);
+  } else if (a_mode == 13) {
+    return wuffs_webp__decoder__clamp_add_subtract_half(self, wuffs_webp__decoder__average_pixels(self, a_l, a_t), a_tl);
+  }
+  return 4278190080;
+}
+
+// -------- func webp.decoder.add_pixels
+
+static uint32_t
+wuffs_webp__decoder__add_pixels(
+    const wuffs_webp__decoder* self,
+    uint32_t a_a,
+    uint32_t a_b) {
+  return ((((uint32_t)((a_a & 4278255360) + (a_b & 4278255360))) & 4278255360) | (((uint32_t)((a_a & 16711935) + (a_b & 16711935))) & 16711935));
+}
+
+// -------- func webp.decoder.average_pixels
+
+static uint32_t
+wuffs_webp__decoder__average_pixels(
+    const wuffs_webp__decoder* self,
+    uint32_t a_a,
+    uint32_t a_b) {
+  return ((uint32_t)((((a_a ^ a_b) & 4278124286) >> 1) + (a_a & a_b)));
+}
+
+// -------- func webp.decoder.select
+
+static uint32_t
+wuffs_webp__decoder__select(
+    const wuffs_webp__decoder* self,
+    uint32_t a_l,
+    uint32_t a_t,
+    uint32_t a_tl) {
+  uint32_t v_pl = 0;
+  uint32_t v_pt = 0;
+  uint32_t v_shift = 0;
+  uint32_t v_a = 0;
+  uint32_t v_b = 0;
+  uint32_t v_c = 0;
+
+  v_shift = 0;
+  while (v_shift < 32) {
+    v_a = ((a_l >> v_shift) & 255);
+    v_b = ((a_t >> v_shift) & 255);
+    v_c = ((a_tl >> v_shift) & 255);
+    if (v_b >= v_c) {
+      v_pl += (v_b - v_c);
+    } else {
+      v_pl += ((uint32_t)(v_c - v_b));
+    }
+    if (v_a >= v_c) {
+      v_pt += (v_a - v_c);
+    } else {
+      v_pt += ((uint32_t)(v_c - v_a));
+    }
+    v_shift += 8;
+  }
+  if (v_pl < v_pt) {
+    return a_l;
+  }
+  return a_t;
+}
+
+// -------- func webp.decoder.clamp_add_subtract_full
+
+static uint32_t
+wuffs_webp__decoder__clamp_add_subtract_full(
+    const wuffs_webp__decoder* self,
+    uint32_t a_a,
+    uint32_t a_b,
+    uint32_t a_c) {
+  uint32_t v_ret = 0;
+  uint32_t v_shift = 0;
+  uint32_t v_v = 0;
+  uint32_t v_w = 0;
+
+  v_shift = 0;
+  while (v_shift < 32) {
+    v_v = (((a_a >> v_shift) & 255) + ((a_b >> v_shift) & 255));
+    v_w = ((a_c >> v_shift) & 255);
+    if (v_v <= v_w) {
+      v_v = 0;
+    } else {
+      v_v -= v_w;
+      v_v = wuffs_base__u32__min(v_v, 255);
+    }
+    v_ret |= ((uint32_t)(v_v << v_shift));
+    v_shift += 8;
+  }
+  return v_ret;
+}
+
+// -------- func webp.decoder.clamp_add_subtract_half
+
+static uint32_t
+wuffs_webp__decoder__clamp_add_subtract_half(
+    const wuffs_webp__decoder* self,
+    uint32_t a_a,
+    uint32_t a_b) {
+  uint32_t v_ret = 0;
+  uint32_t v_shift = 0;
+  uint32_t v_v = 0;
+  uint32_t v_x = 0;
+  uint32_t v_w = 0;
+  uint32_t v_d = 0;
+
+  v_shift = 0;
+  while (v_shift < 32) {
+    v_x = ((a_a >> v_shift) & 255);
+    v_w = ((a_b >> v_shift) & 255);
+    if (v_x >= v_w) {
+      v_v = (v_x + ((v_x - v_w) / 2));
+      v_v = wuffs_base__u32__min(v_v, 255);
+    } else {
+      v_d = (((uint32_t)(v_w - v_x)) / 2);
+      if (v_x > v_d) {
+        v_v = (v_x - v_d);
+      } else {
+        v_v = 0;
+      }
+    }
+    v_ret |= ((uint32_t)(v_v << v_shift));
+    v_shift += 8;
+  }
+  return v_ret;
+}
+
+// -------- func webp.decoder.apply_transform_color
+
+static wuffs_base__empty_struct
+wuffs_webp__decoder__apply_transform_color(
+    wuffs_webp__decoder* self,
+    wuffs_base__slice_u8 a_pix,
+    wuffs_base__slice_u8 a_data,
+    uint32_t a_width,
+    uint32_t a_bits) {
+  uint32_t v_tile_width = 0;
+  uint32_t v_y = 0;
+  uint32_t v_x = 0;
+  uint32_t v_tile_row = 0;
+  uint32_t v_i = 0;
+  uint32_t v_m = 0;
+  uint32_t v_g2r = 0;
+  uint32_t v_g2b = 0;
+  uint32_t v_r2b = 0;
+  uint32_t v_c = 0;
+  uint32_t v_g = 0;
+  uint32_t v_r = 0;
+  uint32_t v_b = 0;
+
+  v_tile_width = wuffs_webp__decoder__div_round_up(self, a_width, a_bits);
+  v_i = 0;
+  v_y = 0;
+  while (v_y < self->private_impl.f_height) {
+    v_tile_row = ((uint32_t)((v_y >> a_bits) * v_tile_width));
+    v_x = 0;
+    while (v_x < a_width) {
+      if ((v_x & ((((uint32_t)(1)) << a_bits) - 1)) == 0) {
+        v_m = wuffs_webp__decoder__peek_pixel(self, a_data, ((uint32_t)(v_tile_row + (v_x >> a_bits))));
+        v_g2r = wuffs_webp__decoder__sign_extend(self, (v_m & 255));
+        v_g2b = wuffs_webp__decoder__sign_extend(self, ((v_m >> 8) & 255));
+        v_r2b = wuffs_webp__decoder__sign_extend(self, ((v_m >> 16) & 255));
+      }
+      v_c = wuffs_webp__decoder__peek_pixel(self, a_pix, v_i);
+      v_g = wuffs_webp__decoder__sign_extend(self, ((v_c >> 8) & 255));
+      v_r = (((uint32_t)((v_c >> 16) + (((uint32_t)(v_g2r * v_g)) >> 5))) & 255);
+      v_b = ((uint32_t)(v_c + (((uint32_t)(v_g2b * v_g)) >> 5)));
+      v_b = (((uint32_t)(v_b + (((uint32_t)(v_r2b * wuffs_webp__decoder__sign_extend(self, v_r))) >> 5))) & 255);
+      wuffs_webp__decoder__poke_pixel(self, a_pix, v_i, ((v_c & 4278255360) | (v_r << 16) | v_b));
+      v_i += 1;
+      v_x += 1;
+    }
+    v_y += 1;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func webp.decoder.sign_extend
+
+static uint32_t
+wuffs_webp__decoder__sign_extend(
+    const wuffs_webp__decoder* self,
+    uint32_t a_v) {
+  return ((uint32_t)((a_v ^ 128) - 128));
+}
+
+// -------- func webp.decoder.apply_transform_subtract_green
+
+static wuffs_base__empty_struct
+wuffs_webp__decoder__apply_transform_subtract_green(
+    wuffs_webp__decoder* self,
+    wuffs_base__slice_u8 a_pix,
+    uint32_t a_width) {
+  wuffs_base__slice_u8 v_p = {0};
+  uint64_t v_n = 0;
+  uint32_t v_c = 0;
+  uint32_t v_g = 0;
+
+  v_n = (((uint64_t)(a_width)) * ((uint64_t)(self->private_impl.f_height)) * 4);
+  v_p = a_pix;
+  if (v_n <= ((uint64_t)(v_p.len))) {
+    v_p = wuffs_base__slice_u8__subslice_j(v_p, v_n);
+  }
+  while (((uint64_t)(v_p.len)) >= 4) {
+    v_c = wuffs_base__peek_u32le__no_bounds_check(v_p.ptr);
+    v_g = ((v_c >> 8) & 255);
+    v_c = ((v_c & 4278255360) | (((uint32_t)((v_c & 16711935) + (v_g * 65537))) & 16711935));
+    wuffs_base__poke_u32le__no_bounds_check(wuffs_base__slice_u8__subslice_j(v_p, 4).ptr, v_c);
+    v_p = wuffs_base__slice_u8__subslice_i(v_p, 4);
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func webp.decoder.apply_transform_color_indexing
+
+static wuffs_base__empty_struct
+wuffs_webp__decoder__apply_transform_color_indexing(
+    wuffs_webp__decoder* self,
+    wuffs_base__slice_u8 a_pix,
+    wuffs_base__slice_u8 a_data,
+    uint32_t a_width,
+    uint32_t a_bits) {
+  uint32_t v_packed_width = 0;
+  uint32_t v_index_bits = 0;
+  uint32_t v_index_mask = 0;
+  uint32_t v_x_mask = 0;
+  uint32_t v_y = 0;
+  uint32_t v_x = 0;
+  uint32_t v_c = 0;
+
+  if (a_bits > 3) {
+    return wuffs_base__make_empty_struct();
+  }
+  v_packed_width = wuffs_webp__decoder__div_round_up(self, a_width, a_bits);
+  v_index_bits = (((uint32_t)(8)) >> a_bits);
+  v_index_mask = ((((uint32_t)(1)) << v_index_bits) - 1);
+  v_x_mask = ((((uint32_t)(1)) << a_bits) - 1);
+  v_y = self->private_impl.f_height;
+  while (v_y > 0) {
+    v_y -= 1;
+    v_x = a_width;
+    while (v_x > 0) {
+      v_x -= 1;
+      v_c = wuffs_webp__decoder__peek_pixel(self, a_pix, ((uint32_t)(((uint32_t)(v_y * v_packed_width)) + (v_x >> a_bits))));
+      v_c = (((v_c >> 8) >> (((v_x & v_x_mask) * v_index_bits) & 31)) & v_index_mask);
+      wuffs_webp__decoder__poke_pixel(self, a_pix, ((uint32_t)(((uint32_t)(v_y * a_width)) + v_x)), wuffs_webp__decoder__peek_pixel(self, a_data, v_c));
+    }
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func webp.decoder.set_quirk_enabled
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_webp__decoder__set_quirk_enabled(
+    wuffs_webp__decoder* self,
+    uint32_t a_quirk,
+    bool a_enabled) {
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func webp.decoder.decode_image_config
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_webp__decoder__decode_image_config(
+    wuffs_webp__decoder* self,
+    wuffs_base__image_config* a_dst,
+    wuffs_base__io_buffer* a_src) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+        ? wuffs_base__error__disabled_by_previous_error
+        : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 1)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_c = 0;
+  uint32_t v_chunk_length = 0;
+  uint8_t v_flags = 0;
+  uint32_t v_canvas_width = 0;
+  uint32_t v_canvas_height = 0;
+  bool v_has_canvas = false;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_image_config[0];
+  if (coro_susp_point) {
+    v_c = self->private_data.s_decode_image_config[0].v_c;
+    v_chunk_length = self->private_data.s_decode_image_config[0].v_chunk_length;
+    v_canvas_width = self->private_data.s_decode_image_config[0].v_canvas_width;
+    v_canvas_height = self->private_data.s_decode_image_config[0].v_canvas_height;
+    v_has_canvas = self->private_data.s_decode_image_config[0].v_has_canvas;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_call_sequence != 0) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
+      goto exit;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      uint32_t t_0;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+        t_0 = wuffs_base__peek_u32le__no_bounds_check(iop_a_src);
+        iop_a_src += 4;
+      } else {
+        self->private_data.s_decode_image_config[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_image_config[0].scratch;
+          uint32_t num_bits_0 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_0;
+          if (num_bits_0 == 24) {
+            t_0 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_0 += 8;
+          *scratch |= ((uint64_t)(num_bits_0)) << 56;
+        }
+      }
+      v_c = t_0;
+    }
+    if (v_c != 1179011410) {
+      status = wuffs_base__make_status(wuffs_webp__error__bad_header);
+      goto exit;
+    }
+    self->private_data.s_decode_image_config[0].scratch = 4;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+    if (self->private_data.s_decode_image_config[0].scratch > ((uint64_t)(io2_a_src - iop_a_src))) {
+      self->private_data.s_decode_image_config[0].scratch -= ((uint64_t)(io2_a_src - iop_a_src));
+      iop_a_src = io2_a_src;
+      status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+      goto suspend;
+    }
+    iop_a_src += self->private_data.s_decode_image_config[0].scratch;
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+      uint32_t t_1;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+        t_1 = wuffs_base__peek_u32le__no_bounds_check(iop_a_src);
+        iop_a_src += 4;
+      } else {
+        self->private_data.s_decode_image_config[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_image_config[0].scratch;
+          uint32_t num_bits_1 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_1;
+          if (num_bits_1 == 24) {
+            t_1 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_1 += 8;
+          *scratch |= ((uint64_t)(num_bits_1)) << 56;
+        }
+      }
+      v_c = t_1;
+    }
+    if (v_c != 1346520407) {
+      status = wuffs_base__make_status(wuffs_webp__error__bad_header);
+      goto exit;
+    }
+    while (true) {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+        uint32_t t_2;
+        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+          t_2 = wuffs_base__peek_u32le__no_bounds_check(iop_a_src);
+          iop_a_src += 4;
+        } else {
+          self->private_data.s_decode_image_config[0].scratch = 0;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+          while (true) {
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint64_t* scratch = &self->private_data.s_decode_image_config[0].scratch;
+            uint32_t num_bits_2 = ((uint32_t)(*scratch >> 56));
+            *scratch <<= 8;
+            *scratch >>= 8;
+            *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_2;
+            if (num_bits_2 == 24) {
+              t_2 = ((uint32_t)(*scratch));
+              break;
+            }
+            num_bits_2 += 8;
+            *scratch |= ((uint64_t)(num_bits_2)) << 56;
+          }
+        }
+        v_c = t_2;
+      }
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+        uint32_t t_3;
+        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+          t_3 = wuffs_base__peek_u32le__no_bounds_check(iop_a_src);
+          iop_a_src += 4;
+        } else {
+          self->private_data.s_decode_image_config[0].scratch = 0;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
+          while (true) {
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint64_t* scratch = &self->private_data.s_decode_image_config[0].scratch;
+            uint32_t num_bits_3 = ((uint32_t)(*scratch >> 56));
+            *scratch <<= 8;
+            *scratch >>= 8;
+            *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_3;
+            if (num_bits_3 == 24) {
+              t_3 = ((uint32_t)(*scratch));
+              break;
+            }
+            num_bits_3 += 8;
+            *scratch |= ((uint64_t)(num_bits_3)) << 56;
+          }
+        }
+        v_chunk_length = t_3;
+      }
+      if (v_c == 1278758998) {
+        goto label__0__break;
+      } else if ((v_c == 540561494) ||
+          (v_c == 1296649793) ||
+          (v_c == 1179471425) ||
+          (v_c == 1213221953)) {
+        status = wuffs_base__make_status(wuffs_webp__error__unsupported_webp_file);
+        goto exit;
+      } else if (v_c == 1480085590) {
+        if (v_has_canvas || (v_chunk_length < 10)) {
+          status = wuffs_base__make_status(wuffs_webp__error__bad_header);
+          goto exit;
+        }
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(10);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint8_t t_4 = *iop_a_src++;
+          v_flags = t_4;
+        }
+        if ((v_flags & 2) != 0) {
+          status = wuffs_base__make_status(wuffs_webp__error__unsupported_webp_file);
+          goto exit;
+        }
+        self->private_data.s_decode_image_config[0].scratch = 3;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(11);
+        if (self->private_data.s_decode_image_config[0].scratch > ((uint64_t)(io2_a_src - iop_a_src))) {
+          self->private_data.s_decode_image_config[0].scratch -= ((uint64_t)(io2_a_src - iop_a_src));
+          iop_a_src = io2_a_src;
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        iop_a_src += self->private_data.s_decode_image_config[0].scratch;
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(12);
+          uint32_t t_5;
+          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 3)) {
+            t_5 = ((uint32_t)(wuffs_base__peek_u24le__no_bounds_check(iop_a_src)));
+            iop_a_src += 3;
+          } else {
+            self->private_data.s_decode_image_config[0].scratch = 0;
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(13);
+            while (true) {
+              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+                goto suspend;
+              }
+              uint64_t* scratch = &self->private_data.s_decode_image_config[0].scratch;
+              uint32_t num_bits_5 = ((uint32_t)(*scratch >> 56));
+              *scratch <<= 8;
+              *scratch >>= 8;
+              *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_5;
+              if (num_bits_5 == 16) {
+                t_5 = ((uint32_t)(*scratch));
+                break;
+              }
+              num_bits_5 += 8;
+              *scratch |= ((uint64_t)(num_bits_5)) << 56;
+            }
+          }
+          v_canvas_width = t_5;
+        }
+        v_canvas_width += 1;
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(14);
+          uint32_t t_6;
+          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 3)) {
+            t_6 = ((uint32_t)(wuffs_base__peek_u24le__no_bounds_check(iop_a_src)));
+            iop_a_src += 3;
+          } else {
+            self->private_data.s_decode_image_config[0].scratch = 0;
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(15);
+            while (true) {
+              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+                goto suspend;
+              }
+              uint64_t* scratch = &self->private_data.s_decode_image_config[0].scratch;
+              uint32_t num_bits_6 = ((uint32_t)(*scratch >> 56));
+              *scratch <<= 8;
+              *scratch >>= 8;
+              *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_6;
+              if (num_bits_6 == 16) {
+                t_6 = ((uint32_t)(*scratch));
+                break;
+              }
+              num_bits_6 += 8;
+              *scratch |= ((uint64_t)(num_bits_6)) << 56;
+            }
+          }
+          v_canvas_height = t_6;
+        }
+        v_canvas_height += 1;
+        v_has_canvas = true;
+        v_chunk_length -= 10;
+      }
+      self->private_data.s_decode_image_config[0].scratch = (((uint64_t)(v_chunk_length)) + ((uint64_t)((v_chunk_length & 1))));
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(16);
+      if (self->private_data.s_decode_image_config[0].scratch > ((uint64_t)(io2_a_src - iop_a_src))) {
+        self->private_data.s_decode_image_config[0].scratch -= ((uint64_t)(io2_a_src - iop_a_src));
+        iop_a_src = io2_a_src;
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      iop_a_src += self->private_data.s_decode_image_config[0].scratch;
+    }
+    label__0__break:;
+    if (v_chunk_length < 5) {
+      status = wuffs_base__make_status(wuffs_webp__error__short_chunk);
+      goto exit;
+    }
+    self->private_impl.f_bitstream_remaining = (v_chunk_length - 5);
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(17);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint32_t t_7 = *iop_a_src++;
+      v_c = t_7;
+    }
+    if (v_c != 47) {
+      status = wuffs_base__make_status(wuffs_webp__error__bad_header);
+      goto exit;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(18);
+      uint32_t t_8;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+        t_8 = wuffs_base__peek_u32le__no_bounds_check(iop_a_src);
+        iop_a_src += 4;
+      } else {
+        self->private_data.s_decode_image_config[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(19);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_image_config[0].scratch;
+          uint32_t num_bits_8 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_8;
+          if (num_bits_8 == 24) {
+            t_8 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_8 += 8;
+          *scratch |= ((uint64_t)(num_bits_8)) << 56;
+        }
+      }
+      v_c = t_8;
+    }
+    if ((v_c >> 29) != 0) {
+      status = wuffs_base__make_status(wuffs_webp__error__bad_header);
+      goto exit;
+    }
+    self->private_impl.f_width = ((v_c & 16383) + 1);
+    self->private_impl.f_height = (((v_c >> 14) & 16383) + 1);
+    self->private_impl.f_is_opaque = (((v_c >> 28) & 1) == 0);
+    if (v_has_canvas && ((v_canvas_width != self->private_impl.f_width) || (v_canvas_height != self->private_impl.f_height))) {
+      status = wuffs_base__make_status(wuffs_webp__error__bad_header);
+      goto exit;
+    }
+    wuffs_webp__decoder__calculate_workbuf_offsets(self);
+    self->private_impl.f_frame_config_io_position = wuffs_base__u64__sat_add((a_src ? a_src->meta.pos : 0), ((uint64_t)(iop_a_src - io0_a_src)));
+    if (a_dst != NULL) {
+      wuffs_base__image_config__set(
+          a_dst,
+          wuffs_webp__decoder__dst_pixfmt(self),
+          0,
+          self->private_impl.f_width,
+          self->private_impl.f_height,
+          self->private_impl.f_frame_config_io_position,
+          self->private_impl.f_is_opaque);
+    }
+    self->private_impl.f_call_sequence = 3;
+
+    goto ok;
+    ok:
+    self->private_impl.p_decode_image_config[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_image_config[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine = wuffs_base__status__is_suspension(&status) ? 1 : 0;
+  WUFFS_BASE__STATS__ADD(self->private_impl, WUFFS_BASE__STATS__SUSPENSIONS,
+      wuffs_base__status__is_suspension(&status) ? 1u : 0u);
+  self->private_data.s_decode_image_config[0].v_c = v_c;
+  self->private_data.s_decode_image_config[0].v_chunk_length = v_chunk_length;
+  self->private_data.s_decode_image_config[0].v_canvas_width = v_canvas_width;
+  self->private_data.s_decode_image_config[0].v_canvas_height = v_canvas_height;
+  self->private_data.s_decode_image_config[0].v_has_canvas = v_has_canvas;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func webp.decoder.dst_pixfmt
+
+static uint32_t
+wuffs_webp__decoder__dst_pixfmt(
+    const wuffs_webp__decoder* self) {
+  if (self->private_impl.f_is_opaque) {
+    return 2415954056;
+  }
+  return 2164295816;
+}
+
+// -------- func webp.decoder.calculate_workbuf_offsets
+
+static wuffs_base__empty_struct
+wuffs_webp__decoder__calculate_workbuf_offsets(
+    wuffs_webp__decoder* self) {
+  uint64_t v_e = 0;
+  uint64_t v_n_groups = 0;
+  uint64_t v_offset = 0;
+
+  v_e = (((uint64_t)(((self->private_impl.f_width + 3) / 4))) * ((uint64_t)(((self->private_impl.f_height + 3) / 4))));
+  v_n_groups = wuffs_base__u64__min(v_e, ((uint64_t)(256)));
+  v_offset = ((((uint64_t)(self->private_impl.f_width)) * ((uint64_t)(self->private_impl.f_height))) * 4);
+  self->private_impl.f_workbuf_offsets[0] = 0;
+  self->private_impl.f_workbuf_offsets[1] = v_offset;
+  v_offset += (v_e * 4);
+  self->private_impl.f_workbuf_offsets[2] = v_offset;
+  v_offset += (v_e * 4);
+  self->private_impl.f_workbuf_offsets[3] = v_offset;
+  v_offset += (v_e * 4);
+  self->private_impl.f_workbuf_offsets[4] = v_offset;
+  v_offset += 1024;
+  self->private_impl.f_workbuf_offsets[5] = v_offset;
+  v_offset += (v_n_groups * ((uint64_t)(10008)));
+  self->private_impl.f_workbuf_offsets[6] = v_offset;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func webp.decoder.decode_frame_config
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_webp__decoder__decode_frame_config(
+    wuffs_webp__decoder* self,
+    wuffs_base__frame_config* a_dst,
+    wuffs_base__io_buffer* a_src) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+        ? wuffs_base__error__disabled_by_previous_error
+        : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 2)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_frame_config[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_call_sequence < 3) {
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      status = wuffs_webp__decoder__decode_image_config(self, NULL, a_src);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+    } else if (self->private_impl.f_call_sequence == 3) {
+      if (self->private_impl.f_frame_config_io_position != wuffs_base__u64__sat_add((a_src ? a_src->meta.pos : 0), ((uint64_t)(iop_a_src - io0_a_src)))) {
+        status = wuffs_base__make_status(wuffs_base__error__bad_restart);
+        goto exit;
+      }
+    } else if (self->private_impl.f_call_sequence == 4) {
+      self->private_impl.f_call_sequence = 255;
+      status = wuffs_base__make_status(wuffs_base__note__end_of_data);
+      goto ok;
+    } else {
+      status = wuffs_base__make_status(wuffs_base__note__end_of_data);
+      goto ok;
+    }
+    if (a_dst != NULL) {
+      wuffs_base__frame_config__set(
+          a_dst,
+          wuffs_base__utility__make_rect_ie_u32(
+          0,
+          0,
+          self->private_impl.f_width,
+          self->private_impl.f_height),
+          ((wuffs_base__flicks)(0)),
+          0,
+          self->private_impl.f_frame_config_io_position,
+          0,
+          self->private_impl.f_is_opaque,
+          false,
+          0);
+    }
+    self->private_impl.f_call_sequence = 4;
+
+    ok:
+    self->private_impl.p_decode_frame_config[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_frame_config[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine = wuffs_base__status__is_suspension(&status) ? 2 : 0;
+  WUFFS_BASE__STATS__ADD(self->private_impl, WUFFS_BASE__STATS__SUSPENSIONS,
+      wuffs_base__status__is_suspension(&status) ? 1u : 0u);
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func webp.decoder.decode_frame
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_webp__decoder__decode_frame(
+    wuffs_webp__decoder* self,
+    wuffs_base__pixel_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__pixel_blend a_blend,
+    wuffs_base__slice_u8 a_workbuf,
+    wuffs_base__decode_frame_options* a_opts) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+        ? wuffs_base__error__disabled_by_previous_error
+        : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst || !a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 3)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  uint32_t v_roi = 0;
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_frame[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_call_sequence < 4) {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      status = wuffs_webp__decoder__decode_frame_config(self, NULL, a_src);
+      if (status.repr) {
+        goto suspend;
+      }
+    } else if (self->private_impl.f_call_sequence == 4) {
+    } else {
+      status = wuffs_base__make_status(wuffs_base__note__end_of_data);
+      goto ok;
+    }
+    v_roi = 4294967295;
+    self->private_impl.f_band_height = 0;
+    if (a_opts != NULL) {
+      if (wuffs_base__decode_frame_options__has_color_conversion(a_opts)) {
+        status = wuffs_base__make_status(wuffs_base__error__unsupported_option);
+        goto exit;
+      }
+      if (wuffs_base__decode_frame_options__downscale_shift(a_opts) > 0) {
+        status = wuffs_base__make_status(wuffs_base__error__unsupported_option);
+        goto exit;
+      }
+      v_roi = wuffs_base__decode_frame_options__roi_max_excl_x(a_opts);
+      self->private_impl.f_band_height = wuffs_base__decode_frame_options__row_band_height(a_opts);
+    }
+    self->private_impl.f_roi_x1 = wuffs_base__u32__min(v_roi, self->private_impl.f_width);
+    v_roi = 4294967295;
+    if (a_opts != NULL) {
+      v_roi = wuffs_base__decode_frame_options__roi_max_excl_y(a_opts);
+    }
+    self->private_impl.f_roi_y1 = wuffs_base__u32__min(v_roi, self->private_impl.f_height);
+    v_roi = 0;
+    if (a_opts != NULL) {
+      v_roi = wuffs_base__decode_frame_options__roi_min_incl_x(a_opts);
+    }
+    self->private_impl.f_roi_x0 = wuffs_base__u32__min(v_roi, self->private_impl.f_roi_x1);
+    v_roi = 0;
+    if (a_opts != NULL) {
+      v_roi = wuffs_base__decode_frame_options__roi_min_incl_y(a_opts);
+    }
+    self->private_impl.f_roi_y0 = wuffs_base__u32__min(v_roi, self->private_impl.f_roi_y1);
+    self->private_impl.f_band_y0 = self->private_impl.f_roi_y0;
+    self->private_impl.f_band_y1 = self->private_impl.f_roi_y1;
+    if (self->private_impl.f_band_height > 0) {
+      self->private_impl.f_band_y1 = wuffs_base__u32__min(self->private_impl.f_roi_y1, wuffs_base__u32__sat_add(self->private_impl.f_roi_y0, self->private_impl.f_band_height));
+    }
+    if (((uint64_t)(a_workbuf.len)) < self->private_impl.f_workbuf_offsets[6]) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_workbuf_length);
+      goto exit;
+    }
+    v_status = wuffs_base__pixel_swizzler__prepare(&self->private_impl.f_swizzler,
+        wuffs_base__pixel_buffer__pixel_format(a_dst),
+        wuffs_base__pixel_buffer__palette(a_dst),
+        wuffs_base__utility__make_pixel_format(2164295816),
+        wuffs_base__utility__empty_slice_u8(),
+        a_blend);
+    if ( ! wuffs_base__status__is_ok(&v_status)) {
+      status = v_status;
+      if (wuffs_base__status__is_error(&status)) {
+        goto exit;
+      } else if (wuffs_base__status__is_suspension(&status)) {
+        status = wuffs_base__make_status(wuffs_base__error__cannot_return_a_suspension);
+        goto exit;
+      }
+      goto ok;
+    }
+    self->private_impl.f_bitstream_bits = 0;
+    self->private_impl.f_bitstream_n_bits = 0;
+    self->private_impl.f_bitstream_n_padding_bits = 0;
+    self->private_impl.f_bitstream_ri = 0;
+    self->private_impl.f_bitstream_wi = 0;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+    status = wuffs_webp__decoder__decode_transforms(self, a_src, a_workbuf);
+    if (status.repr) {
+      goto suspend;
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+    status = wuffs_webp__decoder__decode_main_image(self, a_src, a_workbuf);
+    if (status.repr) {
+      goto suspend;
+    }
+    if (self->private_impl.f_bitstream_n_padding_bits > self->private_impl.f_bitstream_n_bits) {
+      status = wuffs_base__make_status(wuffs_webp__error__truncated_input);
+      goto exit;
+    }
+    wuffs_webp__decoder__apply_inverse_transforms(self, a_workbuf);
+    while (true) {
+      v_status = wuffs_webp__decoder__swizzle(self, a_dst, a_workbuf);
+      if (wuffs_base__status__is_ok(&v_status)) {
+        goto label__0__break;
+      } else if (v_status.repr != wuffs_webp__note__internal_note_short_write) {
+        status = v_status;
+        if (wuffs_base__status__is_error(&status)) {
+          goto exit;
+        } else if (wuffs_base__status__is_suspension(&status)) {
+          status = wuffs_base__make_status(wuffs_base__error__cannot_return_a_suspension);
+          goto exit;
+        }
+        goto ok;
+      }
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(4);
+      self->private_impl.f_band_y0 = self->private_impl.f_band_y1;
+      self->private_impl.f_band_y1 = wuffs_base__u32__min(self->private_impl.f_roi_y1, wuffs_base__u32__sat_add(self->private_impl.f_band_y0, self->private_impl.f_band_height));
+    }
+    label__0__break:;
+    self->private_impl.f_call_sequence = 255;
+
+    ok:
+    self->private_impl.p_decode_frame[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_frame[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine = wuffs_base__status__is_suspension(&status) ? 3 : 0;
+  WUFFS_BASE__STATS__ADD(self->private_impl, WUFFS_BASE__STATS__SUSPENSIONS,
+      wuffs_base__status__is_suspension(&status) ? 1u : 0u);
+
+  goto exit;
+  exit:
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func webp.decoder.decode_transforms
+
+static wuffs_base__status
+wuffs_webp__decoder__decode_transforms(
+    wuffs_webp__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_width = 0;
+  uint32_t v_t = 0;
+  uint32_t v_bits = 0;
+  uint32_t v_n = 0;
+  uint32_t v_i = 0;
+  uint32_t v_sub_width = 0;
+  uint32_t v_sub_height = 0;
+  uint32_t v_c = 0;
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_transforms[0];
+  if (coro_susp_point) {
+    v_width = self->private_data.s_decode_transforms[0].v_width;
+    v_t = self->private_data.s_decode_transforms[0].v_t;
+    v_bits = self->private_data.s_decode_transforms[0].v_bits;
+    v_n = self->private_data.s_decode_transforms[0].v_n;
+    v_i = self->private_data.s_decode_transforms[0].v_i;
+    v_sub_width = self->private_data.s_decode_transforms[0].v_sub_width;
+    v_sub_height = self->private_data.s_decode_transforms[0].v_sub_height;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    v_width = self->private_impl.f_width;
+    self->private_impl.f_n_transforms = 0;
+    self->private_impl.f_transforms_seen = 0;
+    while (true) {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      status = wuffs_webp__decoder__ensure_bits(self, a_src);
+      if (status.repr) {
+        goto suspend;
+      }
+      v_c = wuffs_webp__decoder__take_bits(self, 1);
+      if (v_c == 0) {
+        goto label__0__break;
+      }
+      v_c = wuffs_webp__decoder__take_bits(self, 2);
+      v_t = (v_c & 3);
+      if ((self->private_impl.f_transforms_seen & (((uint32_t)(1)) << v_t)) != 0) {
+        status = wuffs_base__make_status(wuffs_webp__error__bad_transform);
+        goto exit;
+      }
+      self->private_impl.f_transforms_seen |= (((uint32_t)(1)) << v_t);
+      v_i = self->private_impl.f_n_transforms;
+      if (v_i >= 4) {
+        status = wuffs_base__make_status(wuffs_webp__error__internal_error_inconsistent_huffman_code);
+        goto exit;
+      }
+      self->private_impl.f_transform_types[v_i] = ((uint8_t)(v_t));
+      self->private_impl.f_transform_widths[v_i] = v_width;
+      self->private_impl.f_transform_bits[v_i] = 0;
+      self->private_impl.f_n_transforms = (v_i + 1);
+      if (v_t <= 1) {
+        v_c = wuffs_webp__decoder__take_bits(self, 3);
+        v_bits = ((v_c & 7) + 2);
+        self->private_impl.f_transform_bits[v_i] = v_bits;
+        v_sub_width = wuffs_webp__decoder__div_round_up(self, v_width, v_bits);
+        v_sub_height = wuffs_webp__decoder__div_round_up(self, self->private_impl.f_height, v_bits);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        status = wuffs_webp__decoder__decode_sub_image(self,
+            a_src,
+            a_workbuf,
+            self->private_impl.f_workbuf_offsets[(1 + v_t)],
+            v_sub_width,
+            v_sub_height);
+        if (status.repr) {
+          goto suspend;
+        }
+      } else if (v_t == 3) {
+        v_c = wuffs_webp__decoder__take_bits(self, 8);
+        v_n = ((v_c & 255) + 1);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+        status = wuffs_webp__decoder__decode_sub_image(self,
+            a_src,
+            a_workbuf,
+            self->private_impl.f_workbuf_offsets[4],
+            v_n,
+            1);
+        if (status.repr) {
+          goto suspend;
+        }
+        wuffs_webp__decoder__prepare_color_table(self, a_workbuf, v_n);
+        if (v_n <= 2) {
+          v_bits = 3;
+        } else if (v_n <= 4) {
+          v_bits = 2;
+        } else if (v_n <= 16) {
+          v_bits = 1;
+        } else {
+          v_bits = 0;
+        }
+        self->private_impl.f_transform_bits[v_i] = v_bits;
+        v_width = wuffs_webp__decoder__div_round_up(self, v_width, v_bits);
+      }
+    }
+    label__0__break:;
+
+    goto ok;
+    ok:
+    self->private_impl.p_decode_transforms[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_transforms[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_decode_transforms[0].v_width = v_width;
+  self->private_data.s_decode_transforms[0].v_t = v_t;
+  self->private_data.s_decode_transforms[0].v_bits = v_bits;
+  self->private_data.s_decode_transforms[0].v_n = v_n;
+  self->private_data.s_decode_transforms[0].v_i = v_i;
+  self->private_data.s_decode_transforms[0].v_sub_width = v_sub_width;
+  self->private_data.s_decode_transforms[0].v_sub_height = v_sub_height;
+
+  goto exit;
+  exit:
+  return status;
+}
+
+// -------- func webp.decoder.decode_main_image
+
+static wuffs_base__status
+wuffs_webp__decoder__decode_main_image(
+    wuffs_webp__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  uint32_t v_width = 0;
+  uint32_t v_color_cache_bits = 0;
+  uint32_t v_bits = 0;
+  uint32_t v_sub_height = 0;
+  uint32_t v_c = 0;
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_main_image[0];
+  if (coro_susp_point) {
+    v_width = self->private_data.s_decode_main_image[0].v_width;
+    v_color_cache_bits = self->private_data.s_decode_main_image[0].v_color_cache_bits;
+    v_bits = self->private_data.s_decode_main_image[0].v_bits;
+    v_sub_height = self->private_data.s_decode_main_image[0].v_sub_height;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    v_width = self->private_impl.f_width;
+    if (self->private_impl.f_n_transforms > 0) {
+      v_width = wuffs_webp__decoder__coded_width(self);
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+    status = wuffs_webp__decoder__ensure_bits(self, a_src);
+    if (status.repr) {
+      goto suspend;
+    }
+    v_color_cache_bits = wuffs_webp__decoder__decode_color_cache_bits(self);
+    if (v_color_cache_bits > 11) {
+      status = wuffs_base__make_status(wuffs_webp__error__bad_color_cache);
+      goto exit;
+    }
+    self->private_impl.f_entropy_bits = 0;
+    self->private_impl.f_entropy_width = 0;
+    self->private_impl.f_n_huffman_groups = 1;
+    v_c = wuffs_webp__decoder__take_bits(self, 1);
+    if (v_c != 0) {
+      v_c = wuffs_webp__decoder__take_bits(self, 3);
+      v_bits = ((v_c & 7) + 2);
+      self->private_impl.f_entropy_width = wuffs_webp__decoder__div_round_up(self, v_width, v_bits);
+      v_sub_height = wuffs_webp__decoder__div_round_up(self, self->private_impl.f_height, v_bits);
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      status = wuffs_webp__decoder__decode_sub_image(self,
+          a_src,
+          a_workbuf,
+          self->private_impl.f_workbuf_offsets[3],
+          self->private_impl.f_entropy_width,
+          v_sub_height);
+      if (status.repr) {
+        goto suspend;
+      }
+      v_status = wuffs_webp__decoder__count_huffman_groups(self, a_workbuf, (((uint64_t)(self->private_impl.f_entropy_width)) * ((uint64_t)(v_sub_height))));
+      if ( ! wuffs_base__status__is_ok(&v_status)) {
+        status = v_status;
+        if (wuffs_base__status__is_error(&status)) {
+          goto exit;
+        } else if (wuffs_base__status__is_suspension(&status)) {
+          status = wuffs_base__make_status(wuffs_base__error__cannot_return_a_suspension);
+          goto exit;
+        }
+        goto ok;
+      }
+      self->private_impl.f_entropy_bits = v_bits;
+    }
+    self->private_impl.f_color_cache_bits = v_color_cache_bits;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+    status = wuffs_webp__decoder__decode_huffman_groups(self, a_src, a_workbuf);
+    if (status.repr) {
+      goto suspend;
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+    status = wuffs_webp__decoder__decode_all_pixels(self,
+        a_src,
+        a_workbuf,
+        0,
+        v_width,
+        self->private_impl.f_height,
+        (self->private_impl.f_entropy_bits > 0));
+    if (status.repr) {
+      goto suspend;
+    }
+
+    ok:
+    self->private_impl.p_decode_main_image[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_main_image[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_decode_main_image[0].v_width = v_width;
+  self->private_data.s_decode_main_image[0].v_color_cache_bits = v_color_cache_bits;
+  self->private_data.s_decode_main_image[0].v_bits = v_bits;
+  self->private_data.s_decode_main_image[0].v_sub_height = v_sub_height;
+
+  goto exit;
+  exit:
+  return status;
+}
+
+// -------- func webp.decoder.decode_sub_image
+
+static wuffs_base__status
+wuffs_webp__decoder__decode_sub_image(
+    wuffs_webp__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf,
+    uint64_t a_offset,
+    uint32_t a_width,
+    uint32_t a_height) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_color_cache_bits = 0;
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_sub_image[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+    status = wuffs_webp__decoder__ensure_bits(self, a_src);
+    if (status.repr) {
+      goto suspend;
+    }
+    v_color_cache_bits = wuffs_webp__decoder__decode_color_cache_bits(self);
+    if (v_color_cache_bits > 11) {
+      status = wuffs_base__make_status(wuffs_webp__error__bad_color_cache);
+      goto exit;
+    }
+    self->private_impl.f_color_cache_bits = v_color_cache_bits;
+    self->private_impl.f_n_huffman_groups = 1;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+    status = wuffs_webp__decoder__decode_huffman_groups(self, a_src, a_workbuf);
+    if (status.repr) {
+      goto suspend;
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+    status = wuffs_webp__decoder__decode_all_pixels(self,
+        a_src,
+        a_workbuf,
+        a_offset,
+        a_width,
+        a_height,
+        false);
+    if (status.repr) {
+      goto suspend;
+    }
+
+    goto ok;
+    ok:
+    self->private_impl.p_decode_sub_image[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_sub_image[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+  exit:
+  return status;
+}
+
+// -------- func webp.decoder.decode_color_cache_bits
+
+static uint32_t
+wuffs_webp__decoder__decode_color_cache_bits(
+    wuffs_webp__decoder* self) {
+  uint32_t v_n = 0;
+
+  v_n = wuffs_webp__decoder__take_bits(self, 1);
+  if (v_n == 0) {
+    return 0;
+  }
+  v_n = wuffs_webp__decoder__take_bits(self, 4);
+  if ((v_n < 1) || (11 < v_n)) {
+    return 12;
+  }
+  return v_n;
+}
+
+// -------- func webp.decoder.decode_all_pixels
+
+static wuffs_base__status
+wuffs_webp__decoder__decode_all_pixels(
+    wuffs_webp__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf,
+    uint64_t a_offset,
+    uint32_t a_width,
+    uint32_t a_height,
+    bool a_use_entropy_image) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_all_pixels[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    wuffs_webp__decoder__clear_color_cache(self);
+    self->private_impl.f_pixels_pos = 0;
+    label__0__continue:;
+    while (true) {
+      v_status = wuffs_webp__decoder__decode_pixels_to_workbuf(self,
+          a_workbuf,
+          a_offset,
+          a_width,
+          a_height,
+          a_use_entropy_image);
+      if (wuffs_base__status__is_ok(&v_status)) {
+        goto label__0__break;
+      } else if (v_status.repr != wuffs_webp__note__internal_note_short_read) {
+        status = v_status;
+        if (wuffs_base__status__is_error(&status)) {
+          goto exit;
+        } else if (wuffs_base__status__is_suspension(&status)) {
+          status = wuffs_base__make_status(wuffs_base__error__cannot_return_a_suspension);
+          goto exit;
+        }
+        goto ok;
+      }
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      wuffs_webp__decoder__fill_bitstream(self, a_src);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if ((self->private_impl.f_bitstream_remaining == 0) || (((uint32_t)(self->private_impl.f_bitstream_wi - self->private_impl.f_bitstream_ri)) >= 16)) {
+        goto label__0__continue;
+      } else if (a_src && a_src->meta.closed) {
+        status = wuffs_base__make_status(wuffs_webp__error__truncated_input);
+        goto exit;
+      }
+      status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
+    }
+    label__0__break:;
+
+    ok:
+    self->private_impl.p_decode_all_pixels[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_all_pixels[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func webp.decoder.decode_pixels_to_workbuf
+
+static wuffs_base__status
+wuffs_webp__decoder__decode_pixels_to_workbuf(
+    wuffs_webp__decoder* self,
+    wuffs_base__slice_u8 a_workbuf,
+    uint64_t a_offset,
+    uint32_t a_width,
+    uint32_t a_height,
+    bool a_use_entropy_image) {
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  uint64_t v_n = 0;
+  wuffs_base__slice_u8 v_dst = {0};
+  wuffs_base__slice_u8 v_huff = {0};
+  wuffs_base__slice_u8 v_ent = {0};
+
+  v_n = (((uint64_t)(a_width)) * ((uint64_t)(a_height)) * 4);
+  if (a_offset > ((uint64_t)(a_workbuf.len))) {
+    return wuffs_base__make_status(wuffs_webp__error__internal_error_inconsistent_huffman_code);
+  }
+  v_dst = wuffs_base__slice_u8__subslice_i(a_workbuf, a_offset);
+  if (v_n > ((uint64_t)(v_dst.len))) {
+    return wuffs_base__make_status(wuffs_webp__error__internal_error_inconsistent_huffman_code);
+  }
+  v_dst = wuffs_base__slice_u8__subslice_j(v_dst, v_n);
+  if ((self->private_impl.f_workbuf_offsets[5] <= self->private_impl.f_workbuf_offsets[6]) && (self->private_impl.f_workbuf_offsets[6] <= ((uint64_t)(a_workbuf.len)))) {
+    v_huff = wuffs_base__slice_u8__subslice_ij(a_workbuf,
+        self->private_impl.f_workbuf_offsets[5],
+        self->private_impl.f_workbuf_offsets[6]);
+  }
+  if (a_use_entropy_image && (self->private_impl.f_workbuf_offsets[3] <= self->private_impl.f_workbuf_offsets[4]) && (self->private_impl.f_workbuf_offsets[4] <= ((uint64_t)(a_workbuf.len)))) {
+    v_ent = wuffs_base__slice_u8__subslice_ij(a_workbuf,
+        self->private_impl.f_workbuf_offsets[3],
+        self->private_impl.f_workbuf_offsets[4]);
+  }
+  v_status = wuffs_webp__decoder__decode_pixels(self,
+      v_dst,
+      v_huff,
+      v_ent,
+      a_width);
+  return wuffs_base__status__ensure_not_a_suspension(v_status);
+}
+
+// -------- func webp.decoder.clear_color_cache
+
+static wuffs_base__empty_struct
+wuffs_webp__decoder__clear_color_cache(
+    wuffs_webp__decoder* self) {
+  uint32_t v_i = 0;
+
+  v_i = 0;
+  while (v_i < 2048) {
+    self->private_data.f_color_cache[v_i] = 0;
+    v_i += 1;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func webp.decoder.count_huffman_groups
+
+static wuffs_base__status
+wuffs_webp__decoder__count_huffman_groups(
+    wuffs_webp__decoder* self,
+    wuffs_base__slice_u8 a_workbuf,
+    uint64_t a_n) {
+  wuffs_base__slice_u8 v_ent = {0};
+  uint64_t v_i = 0;
+  uint32_t v_g = 0;
+  uint32_t v_max_g = 0;
+
+  if ((self->private_impl.f_workbuf_offsets[3] <= self->private_impl.f_workbuf_offsets[4]) && (self->private_impl.f_workbuf_offsets[4] <= ((uint64_t)(a_workbuf.len)))) {
+    v_ent = wuffs_base__slice_u8__subslice_ij(a_workbuf,
+        self->private_impl.f_workbuf_offsets[3],
+        self->private_impl.f_workbuf_offsets[4]);
+  }
+  v_i = 0;
+  while ((v_i < a_n) && (((uint64_t)(v_ent.len)) >= 4)) {
+    v_g = ((wuffs_base__peek_u32le__no_bounds_check(v_ent.ptr) >> 8) & 65535);
+    v_max_g = wuffs_base__u32__max(v_max_g, v_g);
+    v_ent = wuffs_base__slice_u8__subslice_i(v_ent, 4);
+    v_i += 1;
+  }
+  if ((v_max_g >= 256) || ((((uint64_t)(v_max_g)) * ((uint64_t)(10008))) >= ((uint64_t)(self->private_impl.f_workbuf_offsets[6] - self->private_impl.f_workbuf_offsets[5])))) {
+    return wuffs_base__make_status(wuffs_webp__error__unsupported_number_of_huffman_groups);
+  }
+  self->private_impl.f_n_huffman_groups = (v_max_g + 1);
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func webp.decoder.prepare_color_table
+
+static wuffs_base__empty_struct
+wuffs_webp__decoder__prepare_color_table(
+    wuffs_webp__decoder* self,
+    wuffs_base__slice_u8 a_workbuf,
+    uint32_t a_n) {
+  wuffs_base__slice_u8 v_tab = {0};
+  uint32_t v_i = 0;
+  uint32_t v_prev = 0;
+  uint32_t v_c = 0;
+
+  if ((self->private_impl.f_workbuf_offsets[4] <= self->private_impl.f_workbuf_offsets[5]) && (self->private_impl.f_workbuf_offsets[5] <= ((uint64_t)(a_workbuf.len)))) {
+    v_tab = wuffs_base__slice_u8__subslice_ij(a_workbuf,
+        self->private_impl.f_workbuf_offsets[4],
+        self->private_impl.f_workbuf_offsets[5]);
+  }
+  v_i = 0;
+  while ((v_i < 256) && (((uint64_t)(v_tab.len)) >= 4)) {
+    if (v_i < a_n) {
+      v_c = wuffs_webp__decoder__add_pixels(self, wuffs_base__peek_u32le__no_bounds_check(v_tab.ptr), v_prev);
+      v_prev = v_c;
+    } else {
+      v_c = 0;
+    }
+    wuffs_base__poke_u32le__no_bounds_check(wuffs_base__slice_u8__subslice_j(v_tab, 4).ptr, v_c);
+    v_tab = wuffs_base__slice_u8__subslice_i(v_tab, 4);
+    v_i += 1;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func webp.decoder.coded_width
+
+static uint32_t
+wuffs_webp__decoder__coded_width(
+    const wuffs_webp__decoder* self) {
+  uint32_t v_width = 0;
+  uint32_t v_i = 0;
+
+  v_width = self->private_impl.f_width;
+  v_i = 0;
+  while (v_i < self->private_impl.f_n_transforms) {
+    if (self->private_impl.f_transform_types[v_i] == 3) {
+      v_width = wuffs_webp__decoder__div_round_up(self, v_width, self->private_impl.f_transform_bits[v_i]);
+    }
+    v_i += 1;
+  }
+  return v_width;
+}
+
+// -------- func webp.decoder.div_round_up
+
+static uint32_t
+wuffs_webp__decoder__div_round_up(
+    const wuffs_webp__decoder* self,
+    uint32_t a_a,
+    uint32_t a_bits) {
+  if (a_bits == 0) {
+    return a_a;
+  }
+  return (((a_a + (((uint32_t)(1)) << a_bits)) - 1) >> a_bits);
+}
+
+// -------- func webp.decoder.swizzle
+
+static wuffs_base__status
+wuffs_webp__decoder__swizzle(
+    wuffs_webp__decoder* self,
+    wuffs_base__pixel_buffer* a_dst,
+    wuffs_base__slice_u8 a_workbuf) {
+  wuffs_base__pixel_format v_dst_pixfmt = {0};
+  uint32_t v_dst_bits_per_pixel = 0;
+  uint64_t v_dst_bytes_per_pixel = 0;
+  uint64_t v_dst_bytes_per_row = 0;
+  uint64_t v_src_bytes_per_row = 0;
+  wuffs_base__table_u8 v_tab = {0};
+  wuffs_base__slice_u8 v_dst = {0};
+  wuffs_base__slice_u8 v_src = {0};
+  uint32_t v_y = 0;
+
+  v_dst_pixfmt = wuffs_base__pixel_buffer__pixel_format(a_dst);
+  v_dst_bits_per_pixel = wuffs_base__pixel_format__bits_per_pixel(&v_dst_pixfmt);
+  if ((v_dst_bits_per_pixel & 7) != 0) {
+    return wuffs_base__make_status(wuffs_base__error__unsupported_option);
+  }
+  v_dst_bytes_per_pixel = ((uint64_t)((v_dst_bits_per_pixel / 8)));
+  v_dst_bytes_per_row = (((uint64_t)(((uint32_t)(self->private_impl.f_roi_x1 - self->private_impl.f_roi_x0)))) * v_dst_bytes_per_pixel);
+  v_src_bytes_per_row = (((uint64_t)(self->private_impl.f_width)) * 4);
+  v_tab = wuffs_base__pixel_buffer__plane(a_dst, 0);
+  v_y = self->private_impl.f_band_y0;
+  while (v_y < self->private_impl.f_band_y1) {
+    v_src = wuffs_base__utility__empty_slice_u8();
+    if (self->private_impl.f_workbuf_offsets[1] <= ((uint64_t)(a_workbuf.len))) {
+      v_src = wuffs_base__slice_u8__subslice_j(a_workbuf, self->private_impl.f_workbuf_offsets[1]);
+      if ((((uint64_t)(v_y)) * v_src_bytes_per_row) <= ((uint64_t)(v_src.len))) {
+        v_src = wuffs_base__slice_u8__subslice_i(v_src, (((uint64_t)(v_y)) * v_src_bytes_per_row));
+        if (v_src_bytes_per_row <= ((uint64_t)(v_src.len))) {
+          v_src = wuffs_base__slice_u8__subslice_j(v_src, v_src_bytes_per_row);
+        }
+      } else {
+        v_src = wuffs_base__utility__empty_slice_u8();
+      }
+      if ((((uint64_t)(self->private_impl.f_roi_x1)) * 4) <= ((uint64_t)(v_src.len))) {
+        v_src = wuffs_base__slice_u8__subslice_j(v_src, (((uint64_t)(self->private_impl.f_roi_x1)) * 4));
+      }
+      if ((((uint64_t)(self->private_impl.f_roi_x0)) * 4) <= ((uint64_t)(v_src.len))) {
+        v_src = wuffs_base__slice_u8__subslice_i(v_src, (((uint64_t)(self->private_impl.f_roi_x0)) * 4));
+      }
+    }
+    v_dst = wuffs_base__table_u8__row_u32(v_tab, ((uint32_t)(v_y - self->private_impl.f_band_y0)));
+    if (v_dst_bytes_per_row < ((uint64_t)(v_dst.len))) {
+      v_dst = wuffs_base__slice_u8__subslice_j(v_dst, v_dst_bytes_per_row);
+    }
+    wuffs_base__pixel_swizzler__swizzle_interleaved_from_slice(&self->private_impl.f_swizzler, v_dst, wuffs_base__pixel_buffer__palette(a_dst), v_src);
+    v_y += 1;
+  }
+  if (self->private_impl.f_band_y1 < self->private_impl.f_roi_y1) {
+    return wuffs_base__make_status(wuffs_webp__note__internal_note_short_write);
+  }
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func webp.decoder.can_decode_row_bands
+
+WUFFS_BASE__MAYBE_STATIC bool
+wuffs_webp__decoder__can_decode_row_bands(
+    const wuffs_webp__decoder* self) {
+  if (!self) {
+    return false;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return false;
+  }
+
+  return true;
+}
+
+// -------- func webp.decoder.frame_dirty_rect
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__rect_ie_u32
+wuffs_webp__decoder__frame_dirty_rect(
+    const wuffs_webp__decoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_rect_ie_u32();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_rect_ie_u32();
+  }
+
+  if (self->private_impl.f_band_height > 0) {
+    return wuffs_base__utility__make_rect_ie_u32(
+        0,
+        self->private_impl.f_band_y0,
+        self->private_impl.f_width,
+        self->private_impl.f_band_y1);
+  }
+  return wuffs_base__utility__make_rect_ie_u32(
+      0,
+      0,
+      self->private_impl.f_width,
+      self->private_impl.f_height);
+}
+
+// -------- func webp.decoder.num_animation_loops
+
+WUFFS_BASE__MAYBE_STATIC uint32_t
+wuffs_webp__decoder__num_animation_loops(
+    const wuffs_webp__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return 0;
+}
+
+// -------- func webp.decoder.num_decoded_frame_configs
+
+WUFFS_BASE__MAYBE_STATIC uint64_t
+wuffs_webp__decoder__num_decoded_frame_configs(
+    const wuffs_webp__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  if (self->private_impl.f_call_sequence > 3) {
+    return 1;
+  }
+  return 0;
+}
+
+// -------- func webp.decoder.num_decoded_frames
+
+WUFFS_BASE__MAYBE_STATIC uint64_t
+wuffs_webp__decoder__num_decoded_frames(
+    const wuffs_webp__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  if (self->private_impl.f_call_sequence > 4) {
+    return 1;
+  }
+  return 0;
+}
+
+// -------- func webp.decoder.restart_frame
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_webp__decoder__restart_frame(
+    wuffs_webp__decoder* self,
+    uint64_t a_index,
+    uint64_t a_io_position) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+        ? wuffs_base__error__disabled_by_previous_error
+        : wuffs_base__error__initialize_not_called);
+  }
+
+  if (self->private_impl.f_call_sequence < 3) {
+    return wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
+  }
+  if ((a_index != 0) || (a_io_position != self->private_impl.f_frame_config_io_position)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  self->private_impl.f_call_sequence = 3;
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func webp.decoder.set_report_metadata
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_webp__decoder__set_report_metadata(
+    wuffs_webp__decoder* self,
+    uint32_t a_fourcc,
+    bool a_report) {
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func webp.decoder.tell_me_more
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_webp__decoder__tell_me_more(
+    wuffs_webp__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__more_information* a_minfo,
+    wuffs_base__io_buffer* a_src) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+        ? wuffs_base__error__disabled_by_previous_error
+        : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst || !a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 4)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  status = wuffs_base__make_status(wuffs_base__error__no_more_information);
+  goto exit;
+
+  goto ok;
+  ok:
+  goto exit;
+  exit:
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func webp.decoder.workbuf_len
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64
+wuffs_webp__decoder__workbuf_len(
+    const wuffs_webp__decoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+
+  return wuffs_base__utility__make_range_ii_u64(self->private_impl.f_workbuf_offsets[6], self->private_impl.f_workbuf_offsets[6]);
+}
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__WEBP)
+
+
+#endif  // WUFFS_IMPLEMENTATION
+
+// ¡ WUFFS MONOLITHIC RELEASE DISCARDS EVERYTHING BELOW.
+
+#endif  // WUFFS_INCLUDE_GUARD__WEBP
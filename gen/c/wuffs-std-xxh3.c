@@ -0,0 +1,1105 @@
+#ifndef WUFFS_INCLUDE_GUARD__XXH3
+#define WUFFS_INCLUDE_GUARD__XXH3
+
+#if defined(WUFFS_IMPLEMENTATION) && !defined(WUFFS_CONFIG__MODULES)
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__XXH3
+#endif
+
+#include "./wuffs-base.c"
+
+// ¡ WUFFS MONOLITHIC RELEASE DISCARDS EVERYTHING ABOVE.
+
+
+// ---------------- Status Codes
+
+// ---------------- Public Consts
+
+// ---------------- Struct Declarations
+
+typedef struct wuffs_xxh3__hasher__struct wuffs_xxh3__hasher;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ---------------- Public Initializer Prototypes
+
+// For any given "wuffs_foo__bar* self", "wuffs_foo__bar__initialize(self,
+// etc)" should be called before any other "wuffs_foo__bar__xxx(self, etc)".
+//
+// Pass sizeof(*self) and WUFFS_VERSION for sizeof_star_self and wuffs_version.
+// Pass 0 (or some combination of WUFFS_INITIALIZE__XXX) for options.
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+wuffs_xxh3__hasher__initialize(
+    wuffs_xxh3__hasher* self,
+    size_t sizeof_star_self,
+    uint64_t wuffs_version,
+    uint32_t options);
+
+wuffs_base__stats
+wuffs_xxh3__hasher__stats(
+    const wuffs_xxh3__hasher* self);
+
+size_t
+sizeof__wuffs_xxh3__hasher();
+
+// ---------------- Allocs
+
+// These functions allocate and initialize Wuffs structs. They return NULL if
+// memory allocation fails. If they return non-NULL, there is no need to call
+// wuffs_foo__bar__initialize, but the caller is responsible for eventually
+// calling free on the returned pointer. That pointer is effectively a C++
+// std::unique_ptr<T, decltype(&free)>.
+
+wuffs_xxh3__hasher*
+wuffs_xxh3__hasher__alloc();
+
+static inline wuffs_base__hasher_u64*
+wuffs_xxh3__hasher__alloc_as__wuffs_base__hasher_u64() {
+  return (wuffs_base__hasher_u64*)(wuffs_xxh3__hasher__alloc());
+}
+
+// ---------------- Upcasts
+
+static inline wuffs_base__hasher_u64*
+wuffs_xxh3__hasher__upcast_as__wuffs_base__hasher_u64(
+    wuffs_xxh3__hasher* p) {
+  return (wuffs_base__hasher_u64*)p;
+}
+
+// ---------------- Public Function Prototypes
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_xxh3__hasher__set_quirk_enabled(
+    wuffs_xxh3__hasher* self,
+    uint32_t a_quirk,
+    bool a_enabled);
+
+WUFFS_BASE__MAYBE_STATIC uint64_t
+wuffs_xxh3__hasher__update_u64(
+    wuffs_xxh3__hasher* self,
+    wuffs_base__slice_u8 a_x);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+// ---------------- Struct Definitions
+
+// These structs' fields, and the sizeof them, are private implementation
+// details that aren't guaranteed to be stable across Wuffs versions.
+//
+// See https://en.wikipedia.org/wiki/Opaque_pointer#C
+
+#if defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
+
+struct wuffs_xxh3__hasher__struct {
+  // Do not access the private_impl's or private_data's fields directly. There
+  // is no API/ABI compatibility or safety guarantee if you do so. Instead, use
+  // the wuffs_foo__bar__baz functions.
+  //
+  // It is a struct, not a struct*, so that the outermost wuffs_foo__bar struct
+  // can be stack allocated when WUFFS_IMPLEMENTATION is defined.
+
+  struct {
+    uint32_t magic;
+    uint32_t active_coroutine;
+    wuffs_base__vtable vtable_for__wuffs_base__hasher_u64;
+    wuffs_base__vtable null_vtable;
+#if defined(WUFFS_CONFIG__STATS)
+    wuffs_base__stats stats;
+#endif  // defined(WUFFS_CONFIG__STATS)
+
+    uint64_t f_length_modulo_u64;
+    bool f_length_overflows_u64;
+    bool f_started;
+    uint32_t f_num_stripes;
+    uint32_t f_buf_len;
+    uint8_t f_buf_data[256];
+    uint64_t f_acc[8];
+
+    wuffs_base__empty_struct (*choosy_accumulate)(
+        wuffs_xxh3__hasher* self,
+        wuffs_base__slice_u8 a_x);
+  } private_impl;
+
+#ifdef __cplusplus
+#if defined(WUFFS_BASE__HAVE_UNIQUE_PTR)
+  using unique_ptr = std::unique_ptr<wuffs_xxh3__hasher, decltype(&free)>;
+
+  // On failure, the alloc_etc functions return nullptr. They don't throw.
+
+  static inline unique_ptr
+  alloc() {
+    return unique_ptr(wuffs_xxh3__hasher__alloc(), &free);
+  }
+
+  static inline wuffs_base__hasher_u64::unique_ptr
+  alloc_as__wuffs_base__hasher_u64() {
+    return wuffs_base__hasher_u64::unique_ptr(
+        wuffs_xxh3__hasher__alloc_as__wuffs_base__hasher_u64(), &free);
+  }
+#endif  // defined(WUFFS_BASE__HAVE_UNIQUE_PTR)
+
+#if defined(WUFFS_BASE__HAVE_EQ_DELETE) && !defined(WUFFS_IMPLEMENTATION)
+  // Disallow constructing or copying an object via standard C++ mechanisms,
+  // e.g. the "new" operator, as this struct is intentionally opaque. Its total
+  // size and field layout is not part of the public, stable, memory-safe API.
+  // Use malloc or memcpy and the sizeof__wuffs_foo__bar function instead, and
+  // call wuffs_foo__bar__baz methods (which all take a "this"-like pointer as
+  // their first argument) rather than tweaking bar.private_impl.qux fields.
+  //
+  // In C, we can just leave wuffs_foo__bar as an incomplete type (unless
+  // WUFFS_IMPLEMENTATION is #define'd). In C++, we define a complete type in
+  // order to provide convenience methods. These forward on "this", so that you
+  // can write "bar->baz(etc)" instead of "wuffs_foo__bar__baz(bar, etc)".
+  wuffs_xxh3__hasher__struct() = delete;
+  wuffs_xxh3__hasher__struct(const wuffs_xxh3__hasher__struct&) = delete;
+  wuffs_xxh3__hasher__struct& operator=(
+      const wuffs_xxh3__hasher__struct&) = delete;
+#endif  // defined(WUFFS_BASE__HAVE_EQ_DELETE) && !defined(WUFFS_IMPLEMENTATION)
+
+#if !defined(WUFFS_IMPLEMENTATION)
+  // As above, the size of the struct is not part of the public API, and unless
+  // WUFFS_IMPLEMENTATION is #define'd, this struct type T should be heap
+  // allocated, not stack allocated. Its size is not intended to be known at
+  // compile time, but it is unfortunately divulged as a side effect of
+  // defining C++ convenience methods. Use "sizeof__T()", calling the function,
+  // instead of "sizeof T", invoking the operator. To make the two values
+  // different, so that passing the latter will be rejected by the initialize
+  // function, we add an arbitrary amount of dead weight.
+  uint8_t dead_weight[123000000];  // 123 MB.
+#endif  // !defined(WUFFS_IMPLEMENTATION)
+
+  inline wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+  initialize(
+      size_t sizeof_star_self,
+      uint64_t wuffs_version,
+      uint32_t options) {
+    return wuffs_xxh3__hasher__initialize(
+        this, sizeof_star_self, wuffs_version, options);
+  }
+
+  inline wuffs_base__stats
+  stats() const {
+    return wuffs_xxh3__hasher__stats(this);
+  }
+
+  inline wuffs_base__hasher_u64*
+  upcast_as__wuffs_base__hasher_u64() {
+    return (wuffs_base__hasher_u64*)this;
+  }
+
+  inline wuffs_base__empty_struct
+  set_quirk_enabled(
+      uint32_t a_quirk,
+      bool a_enabled) {
+    return wuffs_xxh3__hasher__set_quirk_enabled(this, a_quirk, a_enabled);
+  }
+
+  inline uint64_t
+  update_u64(
+      wuffs_base__slice_u8 a_x) {
+    return wuffs_xxh3__hasher__update_u64(this, a_x);
+  }
+
+#endif  // __cplusplus
+};  // struct wuffs_xxh3__hasher__struct
+
+#endif  // defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
+
+
+// ‼ WUFFS C HEADER ENDS HERE.
+#ifdef WUFFS_IMPLEMENTATION
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__XXH3)
+
+// ---------------- Status Codes Implementations
+
+// ---------------- Private Consts
+
+#define WUFFS_XXH3__PRIME32_1 2654435761
+
+#define WUFFS_XXH3__PRIME32_2 2246822519
+
+#define WUFFS_XXH3__PRIME32_3 3266489917
+
+#define WUFFS_XXH3__PRIME64_1 11400714785074694791
+
+#define WUFFS_XXH3__PRIME64_2 14029467366897019727
+
+#define WUFFS_XXH3__PRIME64_3 1609587929392839161
+
+#define WUFFS_XXH3__PRIME64_4 9650029242287828579
+
+#define WUFFS_XXH3__PRIME64_5 2870177450012600261
+
+#define WUFFS_XXH3__PRIME_MX1 1609587791953885689
+
+#define WUFFS_XXH3__PRIME_MX2 11507291218515648293
+
+static const uint8_t
+WUFFS_XXH3__SECRET[192] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  184, 254, 108, 57, 35, 164, 75, 190,
+  124, 1, 129, 44, 247, 33, 173, 28,
+  222, 212, 109, 233, 131, 144, 151, 219,
+  114, 64, 164, 164, 183, 179, 103, 31,
+  203, 121, 230, 78, 204, 192, 229, 120,
+  130, 90, 208, 125, 204, 255, 114, 33,
+  184, 8, 70, 116, 247, 67, 36, 142,
+  224, 53, 144, 230, 129, 58, 38, 76,
+  60, 40, 82, 187, 145, 195, 0, 203,
+  136, 208, 101, 139, 27, 83, 46, 163,
+  113, 100, 72, 151, 162, 13, 249, 78,
+  56, 25, 239, 70, 169, 222, 172, 216,
+  168, 250, 118, 63, 227, 156, 52, 63,
+  249, 220, 187, 199, 199, 11, 79, 29,
+  138, 81, 224, 75, 205, 180, 89, 49,
+  200, 159, 126, 201, 217, 120, 115, 100,
+  234, 197, 172, 131, 52, 211, 235, 195,
+  197, 129, 160, 255, 250, 19, 99, 235,
+  23, 13, 221, 81, 183, 240, 218, 73,
+  211, 22, 85, 38, 41, 212, 104, 158,
+  43, 22, 190, 88, 125, 71, 161, 252,
+  143, 248, 184, 209, 122, 208, 49, 206,
+  69, 203, 58, 143, 149, 22, 4, 40,
+  175, 215, 251, 202, 187, 75, 64, 126,
+};
+
+// ---------------- Private Initializer Prototypes
+
+// ---------------- Private Function Prototypes
+
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+static wuffs_base__empty_struct
+wuffs_xxh3__hasher__accumulate_arm_neon(
+    wuffs_xxh3__hasher* self,
+    wuffs_base__slice_u8 a_x);
+#endif  // defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+static wuffs_base__empty_struct
+wuffs_xxh3__hasher__accumulate_x86_avx2(
+    wuffs_xxh3__hasher* self,
+    wuffs_base__slice_u8 a_x);
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+static wuffs_base__empty_struct
+wuffs_xxh3__hasher__accumulate_x86_sse42(
+    wuffs_xxh3__hasher* self,
+    wuffs_base__slice_u8 a_x);
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+
+static wuffs_base__empty_struct
+wuffs_xxh3__hasher__up(
+    wuffs_xxh3__hasher* self,
+    wuffs_base__slice_u8 a_x);
+
+static wuffs_base__empty_struct
+wuffs_xxh3__hasher__accumulate(
+    wuffs_xxh3__hasher* self,
+    wuffs_base__slice_u8 a_x);
+
+static wuffs_base__empty_struct
+wuffs_xxh3__hasher__accumulate__choosy_default(
+    wuffs_xxh3__hasher* self,
+    wuffs_base__slice_u8 a_x);
+
+static wuffs_base__empty_struct
+wuffs_xxh3__hasher__accumulate_stripe(
+    wuffs_xxh3__hasher* self,
+    wuffs_base__slice_u8 a_x,
+    uint32_t a_s);
+
+static wuffs_base__empty_struct
+wuffs_xxh3__hasher__scramble(
+    wuffs_xxh3__hasher* self);
+
+static uint64_t
+wuffs_xxh3__hasher__checksum_long(
+    wuffs_xxh3__hasher* self);
+
+static uint64_t
+wuffs_xxh3__hasher__checksum_short(
+    const wuffs_xxh3__hasher* self);
+
+static uint64_t
+wuffs_xxh3__hasher__mix16(
+    const wuffs_xxh3__hasher* self,
+    uint32_t a_i,
+    uint32_t a_s);
+
+static uint64_t
+wuffs_xxh3__hasher__mul_fold(
+    const wuffs_xxh3__hasher* self,
+    uint64_t a_a,
+    uint64_t a_b);
+
+static uint64_t
+wuffs_xxh3__hasher__avalanche(
+    const wuffs_xxh3__hasher* self,
+    uint64_t a_h);
+
+// ---------------- VTables
+
+const wuffs_base__hasher_u64__func_ptrs
+wuffs_xxh3__hasher__func_ptrs_for__wuffs_base__hasher_u64 = {
+  (wuffs_base__empty_struct(*)(void*,
+      uint32_t,
+      bool))(&wuffs_xxh3__hasher__set_quirk_enabled),
+  (uint64_t(*)(void*,
+      wuffs_base__slice_u8))(&wuffs_xxh3__hasher__update_u64),
+};
+
+// ---------------- Initializer Implementations
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+wuffs_xxh3__hasher__initialize(
+    wuffs_xxh3__hasher* self,
+    size_t sizeof_star_self,
+    uint64_t wuffs_version,
+    uint32_t options){
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  }
+
+  if ((options & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+    // The whole point of this if-check is to detect an uninitialized *self.
+    // We disable the warning on GCC. Clang-5.0 does not have this warning.
+    //
+    // The caller promises that *self is zeroed, so the empty asm tells GCC
+    // that private_impl is defined. Otherwise, once this function and a
+    // small method (e.g. one that reads a "choose" guard field) are both
+    // inlined into the caller, GCC -O3 warns about that method's read.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    __asm__ __volatile__("" : "+m"(self->private_impl));
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((options & WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      options |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    }
+  }
+
+  self->private_impl.choosy_accumulate = &wuffs_xxh3__hasher__accumulate__choosy_default;
+
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__hasher_u64.vtable_name =
+      wuffs_base__hasher_u64__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__hasher_u64.function_pointers =
+      (const void*)(&wuffs_xxh3__hasher__func_ptrs_for__wuffs_base__hasher_u64);
+  return wuffs_base__make_status(NULL);
+}
+
+wuffs_xxh3__hasher*
+wuffs_xxh3__hasher__alloc() {
+  wuffs_xxh3__hasher* x =
+      (wuffs_xxh3__hasher*)(calloc(sizeof(wuffs_xxh3__hasher), 1));
+  if (!x) {
+    return NULL;
+  }
+  if (wuffs_xxh3__hasher__initialize(
+      x, sizeof(wuffs_xxh3__hasher), WUFFS_VERSION, WUFFS_INITIALIZE__ALREADY_ZEROED).repr) {
+    free(x);
+    return NULL;
+  }
+  return x;
+}
+
+size_t
+sizeof__wuffs_xxh3__hasher() {
+  return sizeof(wuffs_xxh3__hasher);
+}
+
+wuffs_base__stats
+wuffs_xxh3__hasher__stats(
+    const wuffs_xxh3__hasher* self) {
+  wuffs_base__stats ret = wuffs_base__make_empty_stats();
+#if defined(WUFFS_CONFIG__STATS)
+  if (!self) {
+    return ret;
+  }
+  ret = self->private_impl.stats;
+#else
+  (void)(self);
+#endif  // defined(WUFFS_CONFIG__STATS)
+  return ret;
+}
+
+// ---------------- Function Implementations
+
+// ‼ WUFFS MULTI-FILE SECTION +arm_neon
+// -------- func xxh3.hasher.accumulate_arm_neon
+
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+static wuffs_base__empty_struct
+wuffs_xxh3__hasher__accumulate_arm_neon(
+    wuffs_xxh3__hasher* self,
+    wuffs_base__slice_u8 a_x) {
+  wuffs_base__slice_u8 v_p = {0};
+  uint32_t v_s = 0;
+  uint32_t v_t = 0;
+  uint32_t v_n = 0;
+  uint32x2_t v_prime = {0};
+  uint64x2_t v_acc0 = {0};
+  uint64x2_t v_acc1 = {0};
+  uint64x2_t v_acc2 = {0};
+  uint64x2_t v_acc3 = {0};
+  uint64x2_t v_d = {0};
+  uint64x2_t v_dk = {0};
+
+  v_acc0 = ((uint64x2_t){self->private_impl.f_acc[0], self->private_impl.f_acc[1]});
+  v_acc1 = ((uint64x2_t){self->private_impl.f_acc[2], self->private_impl.f_acc[3]});
+  v_acc2 = ((uint64x2_t){self->private_impl.f_acc[4], self->private_impl.f_acc[5]});
+  v_acc3 = ((uint64x2_t){self->private_impl.f_acc[6], self->private_impl.f_acc[7]});
+  v_prime = vdup_n_u32(2654435761);
+  v_n = self->private_impl.f_num_stripes;
+  {
+    wuffs_base__slice_u8 i_slice_p = a_x;
+    v_p.ptr = i_slice_p.ptr;
+    v_p.len = 64;
+    uint8_t* i_end0_p = v_p.ptr + (((i_slice_p.len - (size_t)(v_p.ptr - i_slice_p.ptr)) / 64) * 64);
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_p.ptr < i_end0_p) {
+      v_s = (v_n * 8);
+      v_t = v_s;
+      v_d = vreinterpretq_u64_u8(vld1q_u8(v_p.ptr));
+      v_dk = veorq_u64(v_d, vreinterpretq_u64_u8(vld1q_u8(WUFFS_XXH3__SECRET + v_t)));
+      v_acc0 = vaddq_u64(v_acc0, vextq_u64(v_d, v_d, 1));
+      v_acc0 = vmlal_u32(v_acc0, vmovn_u64(v_dk), vshrn_n_u64(v_dk, 32));
+      v_t = (v_s + 16);
+      v_d = vreinterpretq_u64_u8(vld1q_u8(v_p.ptr + 16));
+      v_dk = veorq_u64(v_d, vreinterpretq_u64_u8(vld1q_u8(WUFFS_XXH3__SECRET + v_t)));
+      v_acc1 = vaddq_u64(v_acc1, vextq_u64(v_d, v_d, 1));
+      v_acc1 = vmlal_u32(v_acc1, vmovn_u64(v_dk), vshrn_n_u64(v_dk, 32));
+      v_t = (v_s + 32);
+      v_d = vreinterpretq_u64_u8(vld1q_u8(v_p.ptr + 32));
+      v_dk = veorq_u64(v_d, vreinterpretq_u64_u8(vld1q_u8(WUFFS_XXH3__SECRET + v_t)));
+      v_acc2 = vaddq_u64(v_acc2, vextq_u64(v_d, v_d, 1));
+      v_acc2 = vmlal_u32(v_acc2, vmovn_u64(v_dk), vshrn_n_u64(v_dk, 32));
+      v_t = (v_s + 48);
+      v_d = vreinterpretq_u64_u8(vld1q_u8(v_p.ptr + 48));
+      v_dk = veorq_u64(v_d, vreinterpretq_u64_u8(vld1q_u8(WUFFS_XXH3__SECRET + v_t)));
+      v_acc3 = vaddq_u64(v_acc3, vextq_u64(v_d, v_d, 1));
+      v_acc3 = vmlal_u32(v_acc3, vmovn_u64(v_dk), vshrn_n_u64(v_dk, 32));
+      if (v_n < 15) {
+        v_n += 1;
+      } else {
+        v_n = 0;
+        v_dk = veorq_u64(v_acc0, vshrq_n_u64(v_acc0, 47));
+        v_dk = veorq_u64(v_dk, vreinterpretq_u64_u8(vld1q_u8(WUFFS_XXH3__SECRET + 128)));
+        v_acc0 = vshlq_n_u64(vmull_u32(vshrn_n_u64(v_dk, 32), v_prime), 32);
+        v_acc0 = vmlal_u32(v_acc0, vmovn_u64(v_dk), v_prime);
+        v_dk = veorq_u64(v_acc1, vshrq_n_u64(v_acc1, 47));
+        v_dk = veorq_u64(v_dk, vreinterpretq_u64_u8(vld1q_u8(WUFFS_XXH3__SECRET + 144)));
+        v_acc1 = vshlq_n_u64(vmull_u32(vshrn_n_u64(v_dk, 32), v_prime), 32);
+        v_acc1 = vmlal_u32(v_acc1, vmovn_u64(v_dk), v_prime);
+        v_dk = veorq_u64(v_acc2, vshrq_n_u64(v_acc2, 47));
+        v_dk = veorq_u64(v_dk, vreinterpretq_u64_u8(vld1q_u8(WUFFS_XXH3__SECRET + 160)));
+        v_acc2 = vshlq_n_u64(vmull_u32(vshrn_n_u64(v_dk, 32), v_prime), 32);
+        v_acc2 = vmlal_u32(v_acc2, vmovn_u64(v_dk), v_prime);
+        v_dk = veorq_u64(v_acc3, vshrq_n_u64(v_acc3, 47));
+        v_dk = veorq_u64(v_dk, vreinterpretq_u64_u8(vld1q_u8(WUFFS_XXH3__SECRET + 176)));
+        v_acc3 = vshlq_n_u64(vmull_u32(vshrn_n_u64(v_dk, 32), v_prime), 32);
+        v_acc3 = vmlal_u32(v_acc3, vmovn_u64(v_dk), v_prime);
+      }
+      v_p.ptr += 64;
+    }
+    v_p.len = 0;
+  }
+  self->private_impl.f_num_stripes = v_n;
+  self->private_impl.f_acc[0] = vgetq_lane_u64(v_acc0, 0);
+  self->private_impl.f_acc[1] = vgetq_lane_u64(v_acc0, 1);
+  self->private_impl.f_acc[2] = vgetq_lane_u64(v_acc1, 0);
+  self->private_impl.f_acc[3] = vgetq_lane_u64(v_acc1, 1);
+  self->private_impl.f_acc[4] = vgetq_lane_u64(v_acc2, 0);
+  self->private_impl.f_acc[5] = vgetq_lane_u64(v_acc2, 1);
+  self->private_impl.f_acc[6] = vgetq_lane_u64(v_acc3, 0);
+  self->private_impl.f_acc[7] = vgetq_lane_u64(v_acc3, 1);
+  return wuffs_base__make_empty_struct();
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+// ‼ WUFFS MULTI-FILE SECTION -arm_neon
+
+// ‼ WUFFS MULTI-FILE SECTION +x86_avx2
+// -------- func xxh3.hasher.accumulate_x86_avx2
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static wuffs_base__empty_struct
+wuffs_xxh3__hasher__accumulate_x86_avx2(
+    wuffs_xxh3__hasher* self,
+    wuffs_base__slice_u8 a_x) {
+  wuffs_base__slice_u8 v_p = {0};
+  uint32_t v_s = 0;
+  uint32_t v_t = 0;
+  uint32_t v_n = 0;
+  __m256i v_prime = {0};
+  __m256i v_acc0 = {0};
+  __m256i v_acc1 = {0};
+  __m256i v_d = {0};
+  __m256i v_dk = {0};
+  __m128i v_lo = {0};
+  __m128i v_hi = {0};
+
+  v_acc0 = _mm256_set_epi64x((int64_t)(self->private_impl.f_acc[3]), (int64_t)(self->private_impl.f_acc[2]), (int64_t)(self->private_impl.f_acc[1]), (int64_t)(self->private_impl.f_acc[0]));
+  v_acc1 = _mm256_set_epi64x((int64_t)(self->private_impl.f_acc[7]), (int64_t)(self->private_impl.f_acc[6]), (int64_t)(self->private_impl.f_acc[5]), (int64_t)(self->private_impl.f_acc[4]));
+  v_prime = _mm256_set1_epi32((int32_t)(2654435761));
+  v_n = self->private_impl.f_num_stripes;
+  {
+    wuffs_base__slice_u8 i_slice_p = a_x;
+    v_p.ptr = i_slice_p.ptr;
+    v_p.len = 64;
+    uint8_t* i_end0_p = v_p.ptr + (((i_slice_p.len - (size_t)(v_p.ptr - i_slice_p.ptr)) / 64) * 64);
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_p.ptr < i_end0_p) {
+      v_s = (v_n * 8);
+      v_t = v_s;
+      v_d = _mm256_lddqu_si256((const __m256i*)(const void*)(v_p.ptr));
+      v_dk = _mm256_xor_si256(v_d, _mm256_lddqu_si256((const __m256i*)(const void*)(WUFFS_XXH3__SECRET + v_t)));
+      v_acc0 = _mm256_add_epi64(v_acc0, _mm256_shuffle_epi32(v_d, (int32_t)(78)));
+      v_acc0 = _mm256_add_epi64(v_acc0, _mm256_mul_epu32(v_dk, _mm256_shuffle_epi32(v_dk, (int32_t)(49))));
+      v_t = (v_s + 32);
+      v_d = _mm256_lddqu_si256((const __m256i*)(const void*)(v_p.ptr + 32));
+      v_dk = _mm256_xor_si256(v_d, _mm256_lddqu_si256((const __m256i*)(const void*)(WUFFS_XXH3__SECRET + v_t)));
+      v_acc1 = _mm256_add_epi64(v_acc1, _mm256_shuffle_epi32(v_d, (int32_t)(78)));
+      v_acc1 = _mm256_add_epi64(v_acc1, _mm256_mul_epu32(v_dk, _mm256_shuffle_epi32(v_dk, (int32_t)(49))));
+      if (v_n < 15) {
+        v_n += 1;
+      } else {
+        v_n = 0;
+        v_dk = _mm256_xor_si256(v_acc0, _mm256_srli_epi64(v_acc0, (int32_t)(47)));
+        v_dk = _mm256_xor_si256(v_dk, _mm256_lddqu_si256((const __m256i*)(const void*)(WUFFS_XXH3__SECRET + 128)));
+        v_acc0 = _mm256_add_epi64(_mm256_mul_epu32(v_dk, v_prime), _mm256_slli_epi64(_mm256_mul_epu32(_mm256_shuffle_epi32(v_dk, (int32_t)(49)), v_prime), (int32_t)(32)));
+        v_dk = _mm256_xor_si256(v_acc1, _mm256_srli_epi64(v_acc1, (int32_t)(47)));
+        v_dk = _mm256_xor_si256(v_dk, _mm256_lddqu_si256((const __m256i*)(const void*)(WUFFS_XXH3__SECRET + 160)));
+        v_acc1 = _mm256_add_epi64(_mm256_mul_epu32(v_dk, v_prime), _mm256_slli_epi64(_mm256_mul_epu32(_mm256_shuffle_epi32(v_dk, (int32_t)(49)), v_prime), (int32_t)(32)));
+      }
+      v_p.ptr += 64;
+    }
+    v_p.len = 0;
+  }
+  self->private_impl.f_num_stripes = v_n;
+  v_lo = _mm256_extracti128_si256(v_acc0, (int32_t)(0));
+  v_hi = _mm256_extracti128_si256(v_acc0, (int32_t)(1));
+  self->private_impl.f_acc[0] = ((uint64_t)(_mm_extract_epi64(v_lo, (int32_t)(0))));
+  self->private_impl.f_acc[1] = ((uint64_t)(_mm_extract_epi64(v_lo, (int32_t)(1))));
+  self->private_impl.f_acc[2] = ((uint64_t)(_mm_extract_epi64(v_hi, (int32_t)(0))));
+  self->private_impl.f_acc[3] = ((uint64_t)(_mm_extract_epi64(v_hi, (int32_t)(1))));
+  v_lo = _mm256_extracti128_si256(v_acc1, (int32_t)(0));
+  v_hi = _mm256_extracti128_si256(v_acc1, (int32_t)(1));
+  self->private_impl.f_acc[4] = ((uint64_t)(_mm_extract_epi64(v_lo, (int32_t)(0))));
+  self->private_impl.f_acc[5] = ((uint64_t)(_mm_extract_epi64(v_lo, (int32_t)(1))));
+  self->private_impl.f_acc[6] = ((uint64_t)(_mm_extract_epi64(v_hi, (int32_t)(0))));
+  self->private_impl.f_acc[7] = ((uint64_t)(_mm_extract_epi64(v_hi, (int32_t)(1))));
+  return wuffs_base__make_empty_struct();
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// ‼ WUFFS MULTI-FILE SECTION -x86_avx2
+
+// ‼ WUFFS MULTI-FILE SECTION +x86_sse42
+// -------- func xxh3.hasher.accumulate_x86_sse42
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+static wuffs_base__empty_struct
+wuffs_xxh3__hasher__accumulate_x86_sse42(
+    wuffs_xxh3__hasher* self,
+    wuffs_base__slice_u8 a_x) {
+  wuffs_base__slice_u8 v_p = {0};
+  uint32_t v_s = 0;
+  uint32_t v_t = 0;
+  uint32_t v_n = 0;
+  __m128i v_prime = {0};
+  __m128i v_acc0 = {0};
+  __m128i v_acc1 = {0};
+  __m128i v_acc2 = {0};
+  __m128i v_acc3 = {0};
+  __m128i v_d = {0};
+  __m128i v_dk = {0};
+
+  v_acc0 = _mm_set_epi64x((int64_t)(self->private_impl.f_acc[1]), (int64_t)(self->private_impl.f_acc[0]));
+  v_acc1 = _mm_set_epi64x((int64_t)(self->private_impl.f_acc[3]), (int64_t)(self->private_impl.f_acc[2]));
+  v_acc2 = _mm_set_epi64x((int64_t)(self->private_impl.f_acc[5]), (int64_t)(self->private_impl.f_acc[4]));
+  v_acc3 = _mm_set_epi64x((int64_t)(self->private_impl.f_acc[7]), (int64_t)(self->private_impl.f_acc[6]));
+  v_prime = _mm_set1_epi32((int32_t)(2654435761));
+  v_n = self->private_impl.f_num_stripes;
+  {
+    wuffs_base__slice_u8 i_slice_p = a_x;
+    v_p.ptr = i_slice_p.ptr;
+    v_p.len = 64;
+    uint8_t* i_end0_p = v_p.ptr + (((i_slice_p.len - (size_t)(v_p.ptr - i_slice_p.ptr)) / 64) * 64);
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_p.ptr < i_end0_p) {
+      v_s = (v_n * 8);
+      v_t = v_s;
+      v_d = _mm_lddqu_si128((const __m128i*)(const void*)(v_p.ptr));
+      v_dk = _mm_xor_si128(v_d, _mm_lddqu_si128((const __m128i*)(const void*)(WUFFS_XXH3__SECRET + v_t)));
+      v_acc0 = _mm_add_epi64(v_acc0, _mm_shuffle_epi32(v_d, (int32_t)(78)));
+      v_acc0 = _mm_add_epi64(v_acc0, _mm_mul_epu32(v_dk, _mm_shuffle_epi32(v_dk, (int32_t)(49))));
+      v_t = (v_s + 16);
+      v_d = _mm_lddqu_si128((const __m128i*)(const void*)(v_p.ptr + 16));
+      v_dk = _mm_xor_si128(v_d, _mm_lddqu_si128((const __m128i*)(const void*)(WUFFS_XXH3__SECRET + v_t)));
+      v_acc1 = _mm_add_epi64(v_acc1, _mm_shuffle_epi32(v_d, (int32_t)(78)));
+      v_acc1 = _mm_add_epi64(v_acc1, _mm_mul_epu32(v_dk, _mm_shuffle_epi32(v_dk, (int32_t)(49))));
+      v_t = (v_s + 32);
+      v_d = _mm_lddqu_si128((const __m128i*)(const void*)(v_p.ptr + 32));
+      v_dk = _mm_xor_si128(v_d, _mm_lddqu_si128((const __m128i*)(const void*)(WUFFS_XXH3__SECRET + v_t)));
+      v_acc2 = _mm_add_epi64(v_acc2, _mm_shuffle_epi32(v_d, (int32_t)(78)));
+      v_acc2 = _mm_add_epi64(v_acc2, _mm_mul_epu32(v_dk, _mm_shuffle_epi32(v_dk, (int32_t)(49))));
+      v_t = (v_s + 48);
+      v_d = _mm_lddqu_si128((const __m128i*)(const void*)(v_p.ptr + 48));
+      v_dk = _mm_xor_si128(v_d, _mm_lddqu_si128((const __m128i*)(const void*)(WUFFS_XXH3__SECRET + v_t)));
+      v_acc3 = _mm_add_epi64(v_acc3, _mm_shuffle_epi32(v_d, (int32_t)(78)));
+      v_acc3 = _mm_add_epi64(v_acc3, _mm_mul_epu32(v_dk, _mm_shuffle_epi32(v_dk, (int32_t)(49))));
+      if (v_n < 15) {
+        v_n += 1;
+      } else {
+        v_n = 0;
+        v_dk = _mm_xor_si128(v_acc0, _mm_srli_epi64(v_acc0, (int32_t)(47)));
+        v_dk = _mm_xor_si128(v_dk, _mm_lddqu_si128((const __m128i*)(const void*)(WUFFS_XXH3__SECRET + 128)));
+        v_acc0 = _mm_add_epi64(_mm_mul_epu32(v_dk, v_prime), _mm_slli_epi64(_mm_mul_epu32(_mm_shuffle_epi32(v_dk, (int32_t)(49)), v_prime), (int32_t)(32)));
+        v_dk = _mm_xor_si128(v_acc1, _mm_srli_epi64(v_acc1, (int32_t)(47)));
+        v_dk = _mm_xor_si128(v_dk, _mm_lddqu_si128((const __m128i*)(const void*)(WUFFS_XXH3__SECRET + 144)));
+        v_acc1 = _mm_add_epi64(_mm_mul_epu32(v_dk, v_prime), _mm_slli_epi64(_mm_mul_epu32(_mm_shuffle_epi32(v_dk, (int32_t)(49)), v_prime), (int32_t)(32)));
+        v_dk = _mm_xor_si128(v_acc2, _mm_srli_epi64(v_acc2, (int32_t)(47)));
+        v_dk = _mm_xor_si128(v_dk, _mm_lddqu_si128((const __m128i*)(const void*)(WUFFS_XXH3__SECRET + 160)));
+        v_acc2 = _mm_add_epi64(_mm_mul_epu32(v_dk, v_prime), _mm_slli_epi64(_mm_mul_epu32(_mm_shuffle_epi32(v_dk, (int32_t)(49)), v_prime), (int32_t)(32)));
+        v_dk = _mm_xor_si128(v_acc3, _mm_srli_epi64(v_acc3, (int32_t)(47)));
+        v_dk = _mm_xor_si128(v_dk, _mm_lddqu_si128((const __m128i*)(const void*)(WUFFS_XXH3__SECRET + 176)));
+        v_acc3 = _mm_add_epi64(_mm_mul_epu32(v_dk, v_prime), _mm_slli_epi64(_mm_mul_epu32(_mm_shuffle_epi32(v_dk, (int32_t)(49)), v_prime), (int32_t)(32)));
+      }
+      v_p.ptr += 64;
+    }
+    v_p.len = 0;
+  }
+  self->private_impl.f_num_stripes = v_n;
+  self->private_impl.f_acc[0] = ((uint64_t)(_mm_extract_epi64(v_acc0, (int32_t)(0))));
+  self->private_impl.f_acc[1] = ((uint64_t)(_mm_extract_epi64(v_acc0, (int32_t)(1))));
+  self->private_impl.f_acc[2] = ((uint64_t)(_mm_extract_epi64(v_acc1, (int32_t)(0))));
+  self->private_impl.f_acc[3] = ((uint64_t)(_mm_extract_epi64(v_acc1, (int32_t)(1))));
+  self->private_impl.f_acc[4] = ((uint64_t)(_mm_extract_epi64(v_acc2, (int32_t)(0))));
+  self->private_impl.f_acc[5] = ((uint64_t)(_mm_extract_epi64(v_acc2, (int32_t)(1))));
+  self->private_impl.f_acc[6] = ((uint64_t)(_mm_extract_epi64(v_acc3, (int32_t)(0))));
+  self->private_impl.f_acc[7] = ((uint64_t)(_mm_extract_epi64(v_acc3, (int32_t)(1))));
+  return wuffs_base__make_empty_struct();
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// ‼ WUFFS MULTI-FILE SECTION -x86_sse42
+
+// -------- func xxh3.hasher.set_quirk_enabled
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_xxh3__hasher__set_quirk_enabled(
+    wuffs_xxh3__hasher* self,
+    uint32_t a_quirk,
+    bool a_enabled) {
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func xxh3.hasher.update_u64
+
+WUFFS_BASE__MAYBE_STATIC uint64_t
+wuffs_xxh3__hasher__update_u64(
+    wuffs_xxh3__hasher* self,
+    wuffs_base__slice_u8 a_x) {
+  if (!self) {
+    return 0;
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return 0;
+  }
+
+  uint64_t v_new_lmu = 0;
+  uint64_t v_ret = 0;
+
+  if ( ! self->private_impl.f_started) {
+    self->private_impl.f_started = true;
+    self->private_impl.f_acc[0] = ((uint64_t)(3266489917));
+    self->private_impl.f_acc[1] = 11400714785074694791u;
+    self->private_impl.f_acc[2] = 14029467366897019727u;
+    self->private_impl.f_acc[3] = 1609587929392839161;
+    self->private_impl.f_acc[4] = 9650029242287828579u;
+    self->private_impl.f_acc[5] = ((uint64_t)(2246822519));
+    self->private_impl.f_acc[6] = 2870177450012600261;
+    self->private_impl.f_acc[7] = ((uint64_t)(2654435761));
+    self->private_impl.choosy_accumulate = (
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+        wuffs_base__cpu_arch__have_arm_neon() ? &wuffs_xxh3__hasher__accumulate_arm_neon :
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+        wuffs_base__cpu_arch__have_x86_avx2() ? &wuffs_xxh3__hasher__accumulate_x86_avx2 :
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+        wuffs_base__cpu_arch__have_x86_sse42() ? &wuffs_xxh3__hasher__accumulate_x86_sse42 :
+#endif
+        self->private_impl.choosy_accumulate);
+  }
+  v_new_lmu = ((uint64_t)(self->private_impl.f_length_modulo_u64 + ((uint64_t)(a_x.len))));
+  self->private_impl.f_length_overflows_u64 = ((v_new_lmu < self->private_impl.f_length_modulo_u64) || self->private_impl.f_length_overflows_u64);
+  self->private_impl.f_length_modulo_u64 = v_new_lmu;
+  wuffs_xxh3__hasher__up(self, a_x);
+  if ((self->private_impl.f_length_modulo_u64 > 240) || self->private_impl.f_length_overflows_u64) {
+    v_ret = wuffs_xxh3__hasher__checksum_long(self);
+  } else {
+    v_ret = wuffs_xxh3__hasher__checksum_short(self);
+  }
+  return v_ret;
+}
+
+// -------- func xxh3.hasher.up
+
+static wuffs_base__empty_struct
+wuffs_xxh3__hasher__up(
+    wuffs_xxh3__hasher* self,
+    wuffs_base__slice_u8 a_x) {
+  uint32_t v_buf_len = 0;
+  uint64_t v_n = 0;
+
+  while (true) {
+    v_buf_len = self->private_impl.f_buf_len;
+    if (((uint64_t)(a_x.len)) <= 0) {
+      return wuffs_base__make_empty_struct();
+    } else if (v_buf_len >= 256) {
+      goto label__0__break;
+    }
+    self->private_impl.f_buf_data[v_buf_len] = a_x.ptr[0];
+    a_x = wuffs_base__slice_u8__subslice_i(a_x, 1);
+    self->private_impl.f_buf_len = (v_buf_len + 1);
+  }
+  label__0__break:;
+  wuffs_xxh3__hasher__accumulate(self, wuffs_base__make_slice_u8(self->private_impl.f_buf_data, 256));
+  self->private_impl.f_buf_len = 0;
+  if (((uint64_t)(a_x.len)) > 64) {
+    v_n = ((((uint64_t)(a_x.len)) - 1) & 18446744073709551552u);
+    if ((v_n < 64) || (v_n > ((uint64_t)(a_x.len)))) {
+      return wuffs_base__make_empty_struct();
+    }
+    wuffs_xxh3__hasher__accumulate(self, wuffs_base__slice_u8__subslice_j(a_x, v_n));
+    wuffs_base__slice_u8__copy_from_slice(wuffs_base__make_slice_u8((self->private_impl.f_buf_data) + 192, 64), wuffs_base__slice_u8__suffix(wuffs_base__slice_u8__subslice_j(a_x, v_n), 64));
+    a_x = wuffs_base__slice_u8__subslice_i(a_x, v_n);
+  }
+  v_n = wuffs_base__slice_u8__copy_from_slice(wuffs_base__make_slice_u8(self->private_impl.f_buf_data, 256), a_x);
+  self->private_impl.f_buf_len = ((uint32_t)(wuffs_base__u64__min(v_n, 256)));
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func xxh3.hasher.accumulate
+
+static wuffs_base__empty_struct
+wuffs_xxh3__hasher__accumulate(
+    wuffs_xxh3__hasher* self,
+    wuffs_base__slice_u8 a_x) {
+  return (*self->private_impl.choosy_accumulate)(self, a_x);
+}
+
+static wuffs_base__empty_struct
+wuffs_xxh3__hasher__accumulate__choosy_default(
+    wuffs_xxh3__hasher* self,
+    wuffs_base__slice_u8 a_x) {
+  wuffs_base__slice_u8 v_p = {0};
+  uint32_t v_s = 0;
+
+  {
+    wuffs_base__slice_u8 i_slice_p = a_x;
+    v_p.ptr = i_slice_p.ptr;
+    v_p.len = 64;
+    uint8_t* i_end0_p = v_p.ptr + (((i_slice_p.len - (size_t)(v_p.ptr - i_slice_p.ptr)) / 64) * 64);
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_p.ptr < i_end0_p) {
+      v_s = (self->private_impl.f_num_stripes * 8);
+      wuffs_xxh3__hasher__accumulate_stripe(self, v_p, v_s);
+      if (self->private_impl.f_num_stripes < 15) {
+        self->private_impl.f_num_stripes += 1;
+      } else {
+        self->private_impl.f_num_stripes = 0;
+        wuffs_xxh3__hasher__scramble(self);
+      }
+      v_p.ptr += 64;
+    }
+    v_p.len = 0;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func xxh3.hasher.accumulate_stripe
+
+static wuffs_base__empty_struct
+wuffs_xxh3__hasher__accumulate_stripe(
+    wuffs_xxh3__hasher* self,
+    wuffs_base__slice_u8 a_x,
+    uint32_t a_s) {
+  wuffs_base__slice_u8 v_p = {0};
+  uint32_t v_i = 0;
+  uint32_t v_o = 0;
+  uint64_t v_v0 = 0;
+  uint64_t v_v1 = 0;
+  uint64_t v_w0 = 0;
+  uint64_t v_w1 = 0;
+
+  {
+    wuffs_base__slice_u8 i_slice_p = a_x;
+    v_p.ptr = i_slice_p.ptr;
+    v_p.len = 16;
+    uint8_t* i_end0_p = v_p.ptr + (((i_slice_p.len - (size_t)(v_p.ptr - i_slice_p.ptr)) / 16) * 16);
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_p.ptr < i_end0_p) {
+      v_v0 = wuffs_base__peek_u64le__no_bounds_check(v_p.ptr);
+      v_v1 = wuffs_base__peek_u64le__no_bounds_check(v_p.ptr + 8);
+      v_o = (a_s + (v_i * 8));
+      v_w0 = (v_v0 ^ wuffs_base__peek_u64le__no_bounds_check(WUFFS_XXH3__SECRET + v_o));
+      v_o += 8;
+      v_w1 = (v_v1 ^ wuffs_base__peek_u64le__no_bounds_check(WUFFS_XXH3__SECRET + v_o));
+      self->private_impl.f_acc[v_i] += ((uint64_t)(v_v1 + ((uint64_t)((v_w0 & 4294967295) * (v_w0 >> 32)))));
+      self->private_impl.f_acc[(v_i + 1)] += ((uint64_t)(v_v0 + ((uint64_t)((v_w1 & 4294967295) * (v_w1 >> 32)))));
+      v_i = ((v_i + 2) & 6);
+      v_p.ptr += 16;
+    }
+    v_p.len = 0;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func xxh3.hasher.scramble
+
+static wuffs_base__empty_struct
+wuffs_xxh3__hasher__scramble(
+    wuffs_xxh3__hasher* self) {
+  uint32_t v_i = 0;
+  uint32_t v_o = 0;
+  uint64_t v_v = 0;
+
+  v_i = 0;
+  while (v_i < 8) {
+    v_o = (128 + (v_i * 8));
+    v_v = self->private_impl.f_acc[v_i];
+    v_v ^= (v_v >> 47);
+    v_v ^= wuffs_base__peek_u64le__no_bounds_check(WUFFS_XXH3__SECRET + v_o);
+    self->private_impl.f_acc[v_i] = ((uint64_t)(v_v * ((uint64_t)(2654435761))));
+    v_i += 1;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func xxh3.hasher.checksum_long
+
+static uint64_t
+wuffs_xxh3__hasher__checksum_long(
+    wuffs_xxh3__hasher* self) {
+  uint64_t v_saved[8] = {0};
+  uint32_t v_num_stripes = 0;
+  uint8_t v_last[64] = {0};
+  uint32_t v_buf_len = 0;
+  uint32_t v_m = 0;
+  uint32_t v_i = 0;
+  uint64_t v_ret = 0;
+
+  v_i = 0;
+  while (v_i < 8) {
+    v_saved[v_i] = self->private_impl.f_acc[v_i];
+    v_i += 1;
+  }
+  v_num_stripes = self->private_impl.f_num_stripes;
+  v_buf_len = self->private_impl.f_buf_len;
+  if (v_buf_len >= 64) {
+    wuffs_xxh3__hasher__accumulate(self, wuffs_base__slice_u8__subslice_j(wuffs_base__make_slice_u8(self->private_impl.f_buf_data, 256), (v_buf_len - 1)));
+    v_m = (v_buf_len - 64);
+    wuffs_base__slice_u8__copy_from_slice(wuffs_base__make_slice_u8(v_last, 64), wuffs_base__slice_u8__subslice_ij(wuffs_base__make_slice_u8(self->private_impl.f_buf_data, 256), v_m, (v_m + 64)));
+  } else {
+    wuffs_base__slice_u8__copy_from_slice(wuffs_base__make_slice_u8(v_last, 64), wuffs_base__slice_u8__subslice_i(wuffs_base__make_slice_u8(self->private_impl.f_buf_data, 256), (v_buf_len + 192)));
+    wuffs_base__slice_u8__copy_from_slice(wuffs_base__slice_u8__subslice_i(wuffs_base__make_slice_u8(v_last, 64), (64 - v_buf_len)), wuffs_base__slice_u8__subslice_j(wuffs_base__make_slice_u8(self->private_impl.f_buf_data, 256), v_buf_len));
+  }
+  wuffs_xxh3__hasher__accumulate_stripe(self, wuffs_base__make_slice_u8(v_last, 64), 121);
+  v_ret = ((uint64_t)(self->private_impl.f_length_modulo_u64 * 11400714785074694791u));
+  v_ret += wuffs_xxh3__hasher__mul_fold(self, (self->private_impl.f_acc[0] ^ wuffs_base__peek_u64le__no_bounds_check(WUFFS_XXH3__SECRET + 11)), (self->private_impl.f_acc[1] ^ wuffs_base__peek_u64le__no_bounds_check(WUFFS_XXH3__SECRET + 19)));
+  v_ret += wuffs_xxh3__hasher__mul_fold(self, (self->private_impl.f_acc[2] ^ wuffs_base__peek_u64le__no_bounds_check(WUFFS_XXH3__SECRET + 27)), (self->private_impl.f_acc[3] ^ wuffs_base__peek_u64le__no_bounds_check(WUFFS_XXH3__SECRET + 35)));
+  v_ret += wuffs_xxh3__hasher__mul_fold(self, (self->private_impl.f_acc[4] ^ wuffs_base__peek_u64le__no_bounds_check(WUFFS_XXH3__SECRET + 43)), (self->private_impl.f_acc[5] ^ wuffs_base__peek_u64le__no_bounds_check(WUFFS_XXH3__SECRET + 51)));
+  v_ret += wuffs_xxh3__hasher__mul_fold(self, (self->private_impl.f_acc[6] ^ wuffs_base__peek_u64le__no_bounds_check(WUFFS_XXH3__SECRET + 59)), (self->private_impl.f_acc[7] ^ wuffs_base__peek_u64le__no_bounds_check(WUFFS_XXH3__SECRET + 67)));
+  v_i = 0;
+  while (v_i < 8) {
+    self->private_impl.f_acc[v_i] = v_saved[v_i];
+    v_i += 1;
+  }
+  self->private_impl.f_num_stripes = v_num_stripes;
+  return wuffs_xxh3__hasher__avalanche(self, v_ret);
+}
+
+// -------- func xxh3.hasher.checksum_short
+
+static uint64_t
+wuffs_xxh3__hasher__checksum_short(
+    const wuffs_xxh3__hasher* self) {
+  uint32_t v_n = 0;
+  uint32_t v_m = 0;
+  uint64_t v_v = 0;
+  uint64_t v_w = 0;
+  uint64_t v_ret = 0;
+
+  v_n = self->private_impl.f_buf_len;
+  if (v_n > 128) {
+    if (v_n > 240) {
+      return 0;
+    }
+    v_ret = ((uint64_t)(((uint64_t)(v_n)) * 11400714785074694791u));
+    v_ret += wuffs_xxh3__hasher__mix16(self, 0, 0);
+    v_ret += wuffs_xxh3__hasher__mix16(self, 16, 16);
+    v_ret += wuffs_xxh3__hasher__mix16(self, 32, 32);
+    v_ret += wuffs_xxh3__hasher__mix16(self, 48, 48);
+    v_ret += wuffs_xxh3__hasher__mix16(self, 64, 64);
+    v_ret += wuffs_xxh3__hasher__mix16(self, 80, 80);
+    v_ret += wuffs_xxh3__hasher__mix16(self, 96, 96);
+    v_ret += wuffs_xxh3__hasher__mix16(self, 112, 112);
+    v_ret = wuffs_xxh3__hasher__avalanche(self, v_ret);
+    v_v = wuffs_xxh3__hasher__mix16(self, (v_n - 16), 119);
+    if (v_n >= 144) {
+      v_v += wuffs_xxh3__hasher__mix16(self, 128, 3);
+      if (v_n >= 160) {
+        v_v += wuffs_xxh3__hasher__mix16(self, 144, 19);
+        if (v_n >= 176) {
+          v_v += wuffs_xxh3__hasher__mix16(self, 160, 35);
+          if (v_n >= 192) {
+            v_v += wuffs_xxh3__hasher__mix16(self, 176, 51);
+            if (v_n >= 208) {
+              v_v += wuffs_xxh3__hasher__mix16(self, 192, 67);
+              if (v_n >= 224) {
+                v_v += wuffs_xxh3__hasher__mix16(self, 208, 83);
+                if (v_n >= 240) {
+                  v_v += wuffs_xxh3__hasher__mix16(self, 224, 99);
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+    return wuffs_xxh3__hasher__avalanche(self, ((uint64_t)(v_ret + v_v)));
+  } else if (v_n > 16) {
+    v_ret = ((uint64_t)(((uint64_t)(v_n)) * 11400714785074694791u));
+    if (v_n > 32) {
+      if (v_n > 64) {
+        if (v_n > 96) {
+          v_ret += wuffs_xxh3__hasher__mix16(self, 48, 96);
+          v_ret += wuffs_xxh3__hasher__mix16(self, (v_n - 64), 112);
+        }
+        v_ret += wuffs_xxh3__hasher__mix16(self, 32, 64);
+        v_ret += wuffs_xxh3__hasher__mix16(self, (v_n - 48), 80);
+      }
+      v_ret += wuffs_xxh3__hasher__mix16(self, 16, 32);
+      v_ret += wuffs_xxh3__hasher__mix16(self, (v_n - 32), 48);
+    }
+    v_ret += wuffs_xxh3__hasher__mix16(self, 0, 0);
+    v_ret += wuffs_xxh3__hasher__mix16(self, (v_n - 16), 16);
+    return wuffs_xxh3__hasher__avalanche(self, v_ret);
+  } else if (v_n > 8) {
+    v_m = (v_n - 8);
+    v_v = (wuffs_base__peek_u64le__no_bounds_check(self->private_impl.f_buf_data) ^ (wuffs_base__peek_u64le__no_bounds_check(WUFFS_XXH3__SECRET + 24) ^ wuffs_base__peek_u64le__no_bounds_check(WUFFS_XXH3__SECRET + 32)));
+    v_w = (wuffs_base__peek_u64le__no_bounds_check(self->private_impl.f_buf_data + v_m) ^ (wuffs_base__peek_u64le__no_bounds_check(WUFFS_XXH3__SECRET + 40) ^ wuffs_base__peek_u64le__no_bounds_check(WUFFS_XXH3__SECRET + 48)));
+    v_ret = ((uint64_t)(((uint64_t)(((uint64_t)(v_n)) + v_w)) + wuffs_xxh3__hasher__mul_fold(self, v_v, v_w)));
+    v_ret += (wuffs_base__peek_u64be__no_bounds_check(self->private_impl.f_buf_data) ^ (wuffs_base__peek_u64be__no_bounds_check(WUFFS_XXH3__SECRET + 24) ^ wuffs_base__peek_u64be__no_bounds_check(WUFFS_XXH3__SECRET + 32)));
+    return wuffs_xxh3__hasher__avalanche(self, v_ret);
+  } else if (v_n >= 4) {
+    v_m = (v_n - 4);
+    v_v = (((uint64_t)(wuffs_base__peek_u32le__no_bounds_check(self->private_impl.f_buf_data + v_m))) | (((uint64_t)(wuffs_base__peek_u32le__no_bounds_check(self->private_impl.f_buf_data))) << 32));
+    v_v ^= (wuffs_base__peek_u64le__no_bounds_check(WUFFS_XXH3__SECRET + 8) ^ wuffs_base__peek_u64le__no_bounds_check(WUFFS_XXH3__SECRET + 16));
+    v_v ^= ((((uint64_t)(v_v << 49)) | (v_v >> 15)) ^ (((uint64_t)(v_v << 24)) | (v_v >> 40)));
+    v_v *= 11507291218515648293u;
+    v_v ^= ((uint64_t)((v_v >> 35) + ((uint64_t)(v_n))));
+    v_v *= 11507291218515648293u;
+    return (v_v ^ (v_v >> 28));
+  } else if (v_n > 0) {
+    v_v = ((((uint64_t)(self->private_impl.f_buf_data[0])) << 16) |
+        (((uint64_t)(self->private_impl.f_buf_data[(v_n >> 1)])) << 24) |
+        ((uint64_t)(self->private_impl.f_buf_data[(v_n - 1)])) |
+        (((uint64_t)(v_n)) << 8));
+    v_v ^= ((uint64_t)((wuffs_base__peek_u32le__no_bounds_check(WUFFS_XXH3__SECRET + 0) ^ wuffs_base__peek_u32le__no_bounds_check(WUFFS_XXH3__SECRET + 4))));
+  } else {
+    v_v = (wuffs_base__peek_u64le__no_bounds_check(WUFFS_XXH3__SECRET + 56) ^ wuffs_base__peek_u64le__no_bounds_check(WUFFS_XXH3__SECRET + 64));
+  }
+  v_v ^= (v_v >> 33);
+  v_v *= 14029467366897019727u;
+  v_v ^= (v_v >> 29);
+  v_v *= 1609587929392839161;
+  return (v_v ^ (v_v >> 32));
+}
+
+// -------- func xxh3.hasher.mix16
+
+static uint64_t
+wuffs_xxh3__hasher__mix16(
+    const wuffs_xxh3__hasher* self,
+    uint32_t a_i,
+    uint32_t a_s) {
+  uint32_t v_i = 0;
+  uint32_t v_s = 0;
+  uint64_t v_a = 0;
+
+  v_i = a_i;
+  v_s = a_s;
+  v_a = (wuffs_base__peek_u64le__no_bounds_check(self->private_impl.f_buf_data + v_i) ^ wuffs_base__peek_u64le__no_bounds_check(WUFFS_XXH3__SECRET + v_s));
+  v_i += 8;
+  v_s += 8;
+  return wuffs_xxh3__hasher__mul_fold(self, v_a, (wuffs_base__peek_u64le__no_bounds_check(self->private_impl.f_buf_data + v_i) ^ wuffs_base__peek_u64le__no_bounds_check(WUFFS_XXH3__SECRET + v_s)));
+}
+
+// -------- func xxh3.hasher.mul_fold
+
+static uint64_t
+wuffs_xxh3__hasher__mul_fold(
+    const wuffs_xxh3__hasher* self,
+    uint64_t a_a,
+    uint64_t a_b) {
+  uint64_t v_lo_lo = 0;
+  uint64_t v_hi_lo = 0;
+  uint64_t v_lo_hi = 0;
+  uint64_t v_hi_hi = 0;
+  uint64_t v_cross = 0;
+
+  v_lo_lo = ((uint64_t)((a_a & 4294967295) * (a_b & 4294967295)));
+  v_hi_lo = ((uint64_t)((a_a >> 32) * (a_b & 4294967295)));
+  v_lo_hi = ((uint64_t)((a_a & 4294967295) * (a_b >> 32)));
+  v_hi_hi = ((uint64_t)((a_a >> 32) * (a_b >> 32)));
+  v_cross = ((uint64_t)(((uint64_t)((v_lo_lo >> 32) + (v_hi_lo & 4294967295))) + v_lo_hi));
+  return ((((uint64_t)(v_cross << 32)) | (v_lo_lo & 4294967295)) ^ ((uint64_t)(((uint64_t)(v_hi_hi + (v_hi_lo >> 32))) + (v_cross >> 32))));
+}
+
+// -------- func xxh3.hasher.avalanche
+
+static uint64_t
+wuffs_xxh3__hasher__avalanche(
+    const wuffs_xxh3__hasher* self,
+    uint64_t a_h) {
+  uint64_t v_v = 0;
+
+  v_v = (a_h ^ (a_h >> 37));
+  v_v *= 1609587791953885689;
+  return (v_v ^ (v_v >> 32));
+}
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__XXH3)
+
+
+#endif  // WUFFS_IMPLEMENTATION
+
+// ¡ WUFFS MONOLITHIC RELEASE DISCARDS EVERYTHING BELOW.
+
+#endif  // WUFFS_INCLUDE_GUARD__XXH3
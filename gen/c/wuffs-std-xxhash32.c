@@ -0,0 +1,556 @@
+#ifndef WUFFS_INCLUDE_GUARD__XXHASH32
+#define WUFFS_INCLUDE_GUARD__XXHASH32
+
+#if defined(WUFFS_IMPLEMENTATION) && !defined(WUFFS_CONFIG__MODULES)
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__XXHASH32
+#endif
+
+#include "./wuffs-base.c"
+
+// ¡ WUFFS MONOLITHIC RELEASE DISCARDS EVERYTHING ABOVE.
+
+
+// ---------------- Status Codes
+
+// ---------------- Public Consts
+
+// ---------------- Struct Declarations
+
+typedef struct wuffs_xxhash32__hasher__struct wuffs_xxhash32__hasher;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ---------------- Public Initializer Prototypes
+
+// For any given "wuffs_foo__bar* self", "wuffs_foo__bar__initialize(self,
+// etc)" should be called before any other "wuffs_foo__bar__xxx(self, etc)".
+//
+// Pass sizeof(*self) and WUFFS_VERSION for sizeof_star_self and wuffs_version.
+// Pass 0 (or some combination of WUFFS_INITIALIZE__XXX) for options.
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+wuffs_xxhash32__hasher__initialize(
+    wuffs_xxhash32__hasher* self,
+    size_t sizeof_star_self,
+    uint64_t wuffs_version,
+    uint32_t options);
+
+wuffs_base__stats
+wuffs_xxhash32__hasher__stats(
+    const wuffs_xxhash32__hasher* self);
+
+size_t
+sizeof__wuffs_xxhash32__hasher();
+
+// ---------------- Allocs
+
+// These functions allocate and initialize Wuffs structs. They return NULL if
+// memory allocation fails. If they return non-NULL, there is no need to call
+// wuffs_foo__bar__initialize, but the caller is responsible for eventually
+// calling free on the returned pointer. That pointer is effectively a C++
+// std::unique_ptr<T, decltype(&free)>.
+
+wuffs_xxhash32__hasher*
+wuffs_xxhash32__hasher__alloc();
+
+static inline wuffs_base__hasher_u32*
+wuffs_xxhash32__hasher__alloc_as__wuffs_base__hasher_u32() {
+  return (wuffs_base__hasher_u32*)(wuffs_xxhash32__hasher__alloc());
+}
+
+// ---------------- Upcasts
+
+static inline wuffs_base__hasher_u32*
+wuffs_xxhash32__hasher__upcast_as__wuffs_base__hasher_u32(
+    wuffs_xxhash32__hasher* p) {
+  return (wuffs_base__hasher_u32*)p;
+}
+
+// ---------------- Public Function Prototypes
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_xxhash32__hasher__set_quirk_enabled(
+    wuffs_xxhash32__hasher* self,
+    uint32_t a_quirk,
+    bool a_enabled);
+
+WUFFS_BASE__MAYBE_STATIC uint32_t
+wuffs_xxhash32__hasher__update_u32(
+    wuffs_xxhash32__hasher* self,
+    wuffs_base__slice_u8 a_x);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+// ---------------- Struct Definitions
+
+// These structs' fields, and the sizeof them, are private implementation
+// details that aren't guaranteed to be stable across Wuffs versions.
+//
+// See https://en.wikipedia.org/wiki/Opaque_pointer#C
+
+#if defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
+
+struct wuffs_xxhash32__hasher__struct {
+  // Do not access the private_impl's or private_data's fields directly. There
+  // is no API/ABI compatibility or safety guarantee if you do so. Instead, use
+  // the wuffs_foo__bar__baz functions.
+  //
+  // It is a struct, not a struct*, so that the outermost wuffs_foo__bar struct
+  // can be stack allocated when WUFFS_IMPLEMENTATION is defined.
+
+  struct {
+    uint32_t magic;
+    uint32_t active_coroutine;
+    wuffs_base__vtable vtable_for__wuffs_base__hasher_u32;
+    wuffs_base__vtable null_vtable;
+#if defined(WUFFS_CONFIG__STATS)
+    wuffs_base__stats stats;
+#endif  // defined(WUFFS_CONFIG__STATS)
+
+    uint32_t f_length_modulo_u32;
+    bool f_length_overflows_u32;
+    uint32_t f_buf_len;
+    uint8_t f_buf_data[16];
+    uint32_t f_v0;
+    uint32_t f_v1;
+    uint32_t f_v2;
+    uint32_t f_v3;
+  } private_impl;
+
+#ifdef __cplusplus
+#if defined(WUFFS_BASE__HAVE_UNIQUE_PTR)
+  using unique_ptr = std::unique_ptr<wuffs_xxhash32__hasher, decltype(&free)>;
+
+  // On failure, the alloc_etc functions return nullptr. They don't throw.
+
+  static inline unique_ptr
+  alloc() {
+    return unique_ptr(wuffs_xxhash32__hasher__alloc(), &free);
+  }
+
+  static inline wuffs_base__hasher_u32::unique_ptr
+  alloc_as__wuffs_base__hasher_u32() {
+    return wuffs_base__hasher_u32::unique_ptr(
+        wuffs_xxhash32__hasher__alloc_as__wuffs_base__hasher_u32(), &free);
+  }
+#endif  // defined(WUFFS_BASE__HAVE_UNIQUE_PTR)
+
+#if defined(WUFFS_BASE__HAVE_EQ_DELETE) && !defined(WUFFS_IMPLEMENTATION)
+  // Disallow constructing or copying an object via standard C++ mechanisms,
+  // e.g. the "new" operator, as this struct is intentionally opaque. Its total
+  // size and field layout is not part of the public, stable, memory-safe API.
+  // Use malloc or memcpy and the sizeof__wuffs_foo__bar function instead, and
+  // call wuffs_foo__bar__baz methods (which all take a "this"-like pointer as
+  // their first argument) rather than tweaking bar.private_impl.qux fields.
+  //
+  // In C, we can just leave wuffs_foo__bar as an incomplete type (unless
+  // WUFFS_IMPLEMENTATION is #define'd). In C++, we define a complete type in
+  // order to provide convenience methods. These forward on "this", so that you
+  // can write "bar->baz(etc)" instead of "wuffs_foo__bar__baz(bar, etc)".
+  wuffs_xxhash32__hasher__struct() = delete;
+  wuffs_xxhash32__hasher__struct(const wuffs_xxhash32__hasher__struct&) = delete;
+  wuffs_xxhash32__hasher__struct& operator=(
+      const wuffs_xxhash32__hasher__struct&) = delete;
+#endif  // defined(WUFFS_BASE__HAVE_EQ_DELETE) && !defined(WUFFS_IMPLEMENTATION)
+
+#if !defined(WUFFS_IMPLEMENTATION)
+  // As above, the size of the struct is not part of the public API, and unless
+  // WUFFS_IMPLEMENTATION is #define'd, this struct type T should be heap
+  // allocated, not stack allocated. Its size is not intended to be known at
+  // compile time, but it is unfortunately divulged as a side effect of
+  // defining C++ convenience methods. Use "sizeof__T()", calling the function,
+  // instead of "sizeof T", invoking the operator. To make the two values
+  // different, so that passing the latter will be rejected by the initialize
+  // function, we add an arbitrary amount of dead weight.
+  uint8_t dead_weight[123000000];  // 123 MB.
+#endif  // !defined(WUFFS_IMPLEMENTATION)
+
+  inline wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+  initialize(
+      size_t sizeof_star_self,
+      uint64_t wuffs_version,
+      uint32_t options) {
+    return wuffs_xxhash32__hasher__initialize(
+        this, sizeof_star_self, wuffs_version, options);
+  }
+
+  inline wuffs_base__stats
+  stats() const {
+    return wuffs_xxhash32__hasher__stats(this);
+  }
+
+  inline wuffs_base__hasher_u32*
+  upcast_as__wuffs_base__hasher_u32() {
+    return (wuffs_base__hasher_u32*)this;
+  }
+
+  inline wuffs_base__empty_struct
+  set_quirk_enabled(
+      uint32_t a_quirk,
+      bool a_enabled) {
+    return wuffs_xxhash32__hasher__set_quirk_enabled(this, a_quirk, a_enabled);
+  }
+
+  inline uint32_t
+  update_u32(
+      wuffs_base__slice_u8 a_x) {
+    return wuffs_xxhash32__hasher__update_u32(this, a_x);
+  }
+
+#endif  // __cplusplus
+};  // struct wuffs_xxhash32__hasher__struct
+
+#endif  // defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
+
+
+// ‼ WUFFS C HEADER ENDS HERE.
+#ifdef WUFFS_IMPLEMENTATION
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__XXHASH32)
+
+// ---------------- Status Codes Implementations
+
+// ---------------- Private Consts
+
+#define WUFFS_XXHASH32__PRIME32_1 2654435761
+
+#define WUFFS_XXHASH32__PRIME32_2 2246822519
+
+#define WUFFS_XXHASH32__PRIME32_3 3266489917
+
+#define WUFFS_XXHASH32__PRIME32_4 668265263
+
+#define WUFFS_XXHASH32__PRIME32_5 374761393
+
+// ---------------- Private Initializer Prototypes
+
+// ---------------- Private Function Prototypes
+
+static wuffs_base__empty_struct
+wuffs_xxhash32__hasher__up(
+    wuffs_xxhash32__hasher* self,
+    wuffs_base__slice_u8 a_x);
+
+static uint32_t
+wuffs_xxhash32__hasher__checksum_u32(
+    wuffs_xxhash32__hasher* self);
+
+// ---------------- VTables
+
+const wuffs_base__hasher_u32__func_ptrs
+wuffs_xxhash32__hasher__func_ptrs_for__wuffs_base__hasher_u32 = {
+  (wuffs_base__empty_struct(*)(void*,
+      uint32_t,
+      bool))(&wuffs_xxhash32__hasher__set_quirk_enabled),
+  (uint32_t(*)(void*,
+      wuffs_base__slice_u8))(&wuffs_xxhash32__hasher__update_u32),
+};
+
+// ---------------- Initializer Implementations
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+wuffs_xxhash32__hasher__initialize(
+    wuffs_xxhash32__hasher* self,
+    size_t sizeof_star_self,
+    uint64_t wuffs_version,
+    uint32_t options){
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  }
+
+  if ((options & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+    // The whole point of this if-check is to detect an uninitialized *self.
+    // We disable the warning on GCC. Clang-5.0 does not have this warning.
+    //
+    // The caller promises that *self is zeroed, so the empty asm tells GCC
+    // that private_impl is defined. Otherwise, once this function and a
+    // small method (e.g. one that reads a "choose" guard field) are both
+    // inlined into the caller, GCC -O3 warns about that method's read.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    __asm__ __volatile__("" : "+m"(self->private_impl));
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((options & WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      options |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    }
+  }
+
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__hasher_u32.vtable_name =
+      wuffs_base__hasher_u32__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__hasher_u32.function_pointers =
+      (const void*)(&wuffs_xxhash32__hasher__func_ptrs_for__wuffs_base__hasher_u32);
+  return wuffs_base__make_status(NULL);
+}
+
+wuffs_xxhash32__hasher*
+wuffs_xxhash32__hasher__alloc() {
+  wuffs_xxhash32__hasher* x =
+      (wuffs_xxhash32__hasher*)(calloc(sizeof(wuffs_xxhash32__hasher), 1));
+  if (!x) {
+    return NULL;
+  }
+  if (wuffs_xxhash32__hasher__initialize(
+      x, sizeof(wuffs_xxhash32__hasher), WUFFS_VERSION, WUFFS_INITIALIZE__ALREADY_ZEROED).repr) {
+    free(x);
+    return NULL;
+  }
+  return x;
+}
+
+size_t
+sizeof__wuffs_xxhash32__hasher() {
+  return sizeof(wuffs_xxhash32__hasher);
+}
+
+wuffs_base__stats
+wuffs_xxhash32__hasher__stats(
+    const wuffs_xxhash32__hasher* self) {
+  wuffs_base__stats ret = wuffs_base__make_empty_stats();
+#if defined(WUFFS_CONFIG__STATS)
+  if (!self) {
+    return ret;
+  }
+  ret = self->private_impl.stats;
+#else
+  (void)(self);
+#endif  // defined(WUFFS_CONFIG__STATS)
+  return ret;
+}
+
+// ---------------- Function Implementations
+
+// -------- func xxhash32.hasher.set_quirk_enabled
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_xxhash32__hasher__set_quirk_enabled(
+    wuffs_xxhash32__hasher* self,
+    uint32_t a_quirk,
+    bool a_enabled) {
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func xxhash32.hasher.update_u32
+
+WUFFS_BASE__MAYBE_STATIC uint32_t
+wuffs_xxhash32__hasher__update_u32(
+    wuffs_xxhash32__hasher* self,
+    wuffs_base__slice_u8 a_x) {
+  if (!self) {
+    return 0;
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return 0;
+  }
+
+  wuffs_base__slice_u8 v_remaining = {0};
+  uint32_t v_ret = 0;
+
+  if ((self->private_impl.f_length_modulo_u32 == 0) &&  ! self->private_impl.f_length_overflows_u32) {
+    self->private_impl.f_v0 = 606290984;
+    self->private_impl.f_v1 = 2246822519;
+    self->private_impl.f_v2 = 0;
+    self->private_impl.f_v3 = 1640531535;
+  }
+  while (((uint64_t)(a_x.len)) > 0) {
+    v_remaining = wuffs_base__slice_u8__subslice_j(a_x, 0);
+    if (((uint64_t)(a_x.len)) > 268435456) {
+      v_remaining = wuffs_base__slice_u8__subslice_i(a_x, 268435456);
+      a_x = wuffs_base__slice_u8__subslice_j(a_x, 268435456);
+    }
+    wuffs_xxhash32__hasher__up(self, a_x);
+    a_x = v_remaining;
+  }
+  v_ret = wuffs_xxhash32__hasher__checksum_u32(self);
+  return v_ret;
+}
+
+// -------- func xxhash32.hasher.up
+
+static wuffs_base__empty_struct
+wuffs_xxhash32__hasher__up(
+    wuffs_xxhash32__hasher* self,
+    wuffs_base__slice_u8 a_x) {
+  uint32_t v_new_lmu = 0;
+  uint32_t v_buf_u32 = 0;
+  uint64_t v_buf_u64 = 0;
+  uint32_t v_buf_len = 0;
+  uint32_t v_v0 = 0;
+  uint32_t v_v1 = 0;
+  uint32_t v_v2 = 0;
+  uint32_t v_v3 = 0;
+  wuffs_base__slice_u8 v_p = {0};
+  uint64_t v_n = 0;
+
+  v_new_lmu = ((uint32_t)(self->private_impl.f_length_modulo_u32 + ((uint32_t)((((uint64_t)(a_x.len)) & 4294967295)))));
+  self->private_impl.f_length_overflows_u32 = ((v_new_lmu < self->private_impl.f_length_modulo_u32) || self->private_impl.f_length_overflows_u32);
+  self->private_impl.f_length_modulo_u32 = v_new_lmu;
+  if (self->private_impl.f_buf_len > 0) {
+    while (true) {
+      v_buf_len = self->private_impl.f_buf_len;
+      if (v_buf_len >= 16) {
+        goto label__0__break;
+      } else if (((uint64_t)(a_x.len)) <= 0) {
+        return wuffs_base__make_empty_struct();
+      }
+      self->private_impl.f_buf_data[v_buf_len] = a_x.ptr[0];
+      a_x = wuffs_base__slice_u8__subslice_i(a_x, 1);
+      self->private_impl.f_buf_len = (v_buf_len + 1);
+    }
+    label__0__break:;
+    self->private_impl.f_buf_len = 0;
+    v_buf_u32 = (((uint32_t)(self->private_impl.f_buf_data[0])) |
+        (((uint32_t)(self->private_impl.f_buf_data[1])) << 8) |
+        (((uint32_t)(self->private_impl.f_buf_data[2])) << 16) |
+        (((uint32_t)(self->private_impl.f_buf_data[3])) << 24));
+    v_v0 = ((uint32_t)(self->private_impl.f_v0 + ((uint32_t)(v_buf_u32 * 2246822519))));
+    v_v0 = (((uint32_t)(v_v0 << 13)) | (v_v0 >> 19));
+    self->private_impl.f_v0 = ((uint32_t)(v_v0 * 2654435761));
+    v_buf_u32 = (((uint32_t)(self->private_impl.f_buf_data[4])) |
+        (((uint32_t)(self->private_impl.f_buf_data[5])) << 8) |
+        (((uint32_t)(self->private_impl.f_buf_data[6])) << 16) |
+        (((uint32_t)(self->private_impl.f_buf_data[7])) << 24));
+    v_v1 = ((uint32_t)(self->private_impl.f_v1 + ((uint32_t)(v_buf_u32 * 2246822519))));
+    v_v1 = (((uint32_t)(v_v1 << 13)) | (v_v1 >> 19));
+    self->private_impl.f_v1 = ((uint32_t)(v_v1 * 2654435761));
+    v_buf_u32 = (((uint32_t)(self->private_impl.f_buf_data[8])) |
+        (((uint32_t)(self->private_impl.f_buf_data[9])) << 8) |
+        (((uint32_t)(self->private_impl.f_buf_data[10])) << 16) |
+        (((uint32_t)(self->private_impl.f_buf_data[11])) << 24));
+    v_v2 = ((uint32_t)(self->private_impl.f_v2 + ((uint32_t)(v_buf_u32 * 2246822519))));
+    v_v2 = (((uint32_t)(v_v2 << 13)) | (v_v2 >> 19));
+    self->private_impl.f_v2 = ((uint32_t)(v_v2 * 2654435761));
+    v_buf_u32 = (((uint32_t)(self->private_impl.f_buf_data[12])) |
+        (((uint32_t)(self->private_impl.f_buf_data[13])) << 8) |
+        (((uint32_t)(self->private_impl.f_buf_data[14])) << 16) |
+        (((uint32_t)(self->private_impl.f_buf_data[15])) << 24));
+    v_v3 = ((uint32_t)(self->private_impl.f_v3 + ((uint32_t)(v_buf_u32 * 2246822519))));
+    v_v3 = (((uint32_t)(v_v3 << 13)) | (v_v3 >> 19));
+    self->private_impl.f_v3 = ((uint32_t)(v_v3 * 2654435761));
+  }
+  v_v0 = self->private_impl.f_v0;
+  v_v1 = self->private_impl.f_v1;
+  v_v2 = self->private_impl.f_v2;
+  v_v3 = self->private_impl.f_v3;
+  {
+    wuffs_base__slice_u8 i_slice_p = a_x;
+    v_p.ptr = i_slice_p.ptr;
+    v_p.len = 16;
+    uint8_t* i_end0_p = v_p.ptr + (((i_slice_p.len - (size_t)(v_p.ptr - i_slice_p.ptr)) / 16) * 16);
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_p.ptr < i_end0_p) {
+      v_buf_u64 = wuffs_base__peek_u64le__no_bounds_check(v_p.ptr);
+      v_buf_u32 = ((uint32_t)((v_buf_u64 & 4294967295)));
+      v_v0 = ((uint32_t)(v_v0 + ((uint32_t)(v_buf_u32 * 2246822519))));
+      v_v0 = (((uint32_t)(v_v0 << 13)) | (v_v0 >> 19));
+      v_v0 = ((uint32_t)(v_v0 * 2654435761));
+      v_buf_u32 = ((uint32_t)((v_buf_u64 >> 32)));
+      v_v1 = ((uint32_t)(v_v1 + ((uint32_t)(v_buf_u32 * 2246822519))));
+      v_v1 = (((uint32_t)(v_v1 << 13)) | (v_v1 >> 19));
+      v_v1 = ((uint32_t)(v_v1 * 2654435761));
+      v_buf_u64 = wuffs_base__peek_u64le__no_bounds_check(v_p.ptr + 8);
+      v_buf_u32 = ((uint32_t)((v_buf_u64 & 4294967295)));
+      v_v2 = ((uint32_t)(v_v2 + ((uint32_t)(v_buf_u32 * 2246822519))));
+      v_v2 = (((uint32_t)(v_v2 << 13)) | (v_v2 >> 19));
+      v_v2 = ((uint32_t)(v_v2 * 2654435761));
+      v_buf_u32 = ((uint32_t)((v_buf_u64 >> 32)));
+      v_v3 = ((uint32_t)(v_v3 + ((uint32_t)(v_buf_u32 * 2246822519))));
+      v_v3 = (((uint32_t)(v_v3 << 13)) | (v_v3 >> 19));
+      v_v3 = ((uint32_t)(v_v3 * 2654435761));
+      v_p.ptr += 16;
+    }
+    v_p.len = 0;
+  }
+  self->private_impl.f_v0 = v_v0;
+  self->private_impl.f_v1 = v_v1;
+  self->private_impl.f_v2 = v_v2;
+  self->private_impl.f_v3 = v_v3;
+  v_n = wuffs_base__slice_u8__copy_from_slice(wuffs_base__make_slice_u8(self->private_impl.f_buf_data, 16), wuffs_base__slice_u8__suffix(a_x, (((uint64_t)(a_x.len)) & 15)));
+  self->private_impl.f_buf_len = ((uint32_t)((v_n & 15)));
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func xxhash32.hasher.checksum_u32
+
+static uint32_t
+wuffs_xxhash32__hasher__checksum_u32(
+    wuffs_xxhash32__hasher* self) {
+  uint32_t v_ret = 0;
+  uint32_t v_buf_u32 = 0;
+  wuffs_base__slice_u8 v_p = {0};
+
+  if ((self->private_impl.f_length_modulo_u32 >= 16) || self->private_impl.f_length_overflows_u32) {
+    v_ret = (((uint32_t)(self->private_impl.f_v0 << 1)) | (self->private_impl.f_v0 >> 31));
+    v_ret += (((uint32_t)(self->private_impl.f_v1 << 7)) | (self->private_impl.f_v1 >> 25));
+    v_ret += (((uint32_t)(self->private_impl.f_v2 << 12)) | (self->private_impl.f_v2 >> 20));
+    v_ret += (((uint32_t)(self->private_impl.f_v3 << 18)) | (self->private_impl.f_v3 >> 14));
+    v_ret += self->private_impl.f_length_modulo_u32;
+  } else {
+    v_ret = ((uint32_t)(374761393 + self->private_impl.f_length_modulo_u32));
+  }
+  {
+    wuffs_base__slice_u8 i_slice_p = wuffs_base__slice_u8__subslice_j(wuffs_base__make_slice_u8(self->private_impl.f_buf_data, 16), self->private_impl.f_buf_len);
+    v_p.ptr = i_slice_p.ptr;
+    v_p.len = 4;
+    uint8_t* i_end0_p = v_p.ptr + (((i_slice_p.len - (size_t)(v_p.ptr - i_slice_p.ptr)) / 4) * 4);
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_p.ptr < i_end0_p) {
+      v_buf_u32 = (((uint32_t)(v_p.ptr[0])) |
+          (((uint32_t)(v_p.ptr[1])) << 8) |
+          (((uint32_t)(v_p.ptr[2])) << 16) |
+          (((uint32_t)(v_p.ptr[3])) << 24));
+      v_ret += ((uint32_t)(v_buf_u32 * 3266489917));
+      v_ret = (((uint32_t)(v_ret << 17)) | (v_ret >> 15));
+      v_ret *= 668265263;
+      v_p.ptr += 4;
+    }
+    v_p.len = 1;
+    uint8_t* i_end1_p = i_slice_p.ptr + i_slice_p.len;
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_p.ptr < i_end1_p) {
+      v_ret += ((uint32_t)(((uint32_t)(v_p.ptr[0])) * 374761393));
+      v_ret = (((uint32_t)(v_ret << 11)) | (v_ret >> 21));
+      v_ret *= 2654435761;
+      v_p.ptr += 1;
+    }
+    v_p.len = 0;
+  }
+  v_ret ^= (v_ret >> 15);
+  v_ret *= 2246822519;
+  v_ret ^= (v_ret >> 13);
+  v_ret *= 3266489917;
+  v_ret ^= (v_ret >> 16);
+  return v_ret;
+}
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__XXHASH32)
+
+
+#endif  // WUFFS_IMPLEMENTATION
+
+// ¡ WUFFS MONOLITHIC RELEASE DISCARDS EVERYTHING BELOW.
+
+#endif  // WUFFS_INCLUDE_GUARD__XXHASH32
@@ -0,0 +1,556 @@
+#ifndef WUFFS_INCLUDE_GUARD__XXHASH64
+#define WUFFS_INCLUDE_GUARD__XXHASH64
+
+#if defined(WUFFS_IMPLEMENTATION) && !defined(WUFFS_CONFIG__MODULES)
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__XXHASH64
+#endif
+
+#include "./wuffs-base.c"
+
+// ¡ WUFFS MONOLITHIC RELEASE DISCARDS EVERYTHING ABOVE.
+
+
+// ---------------- Status Codes
+
+// ---------------- Public Consts
+
+// ---------------- Struct Declarations
+
+typedef struct wuffs_xxhash64__hasher__struct wuffs_xxhash64__hasher;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ---------------- Public Initializer Prototypes
+
+// For any given "wuffs_foo__bar* self", "wuffs_foo__bar__initialize(self,
+// etc)" should be called before any other "wuffs_foo__bar__xxx(self, etc)".
+//
+// Pass sizeof(*self) and WUFFS_VERSION for sizeof_star_self and wuffs_version.
+// Pass 0 (or some combination of WUFFS_INITIALIZE__XXX) for options.
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+wuffs_xxhash64__hasher__initialize(
+    wuffs_xxhash64__hasher* self,
+    size_t sizeof_star_self,
+    uint64_t wuffs_version,
+    uint32_t options);
+
+wuffs_base__stats
+wuffs_xxhash64__hasher__stats(
+    const wuffs_xxhash64__hasher* self);
+
+size_t
+sizeof__wuffs_xxhash64__hasher();
+
+// ---------------- Allocs
+
+// These functions allocate and initialize Wuffs structs. They return NULL if
+// memory allocation fails. If they return non-NULL, there is no need to call
+// wuffs_foo__bar__initialize, but the caller is responsible for eventually
+// calling free on the returned pointer. That pointer is effectively a C++
+// std::unique_ptr<T, decltype(&free)>.
+
+wuffs_xxhash64__hasher*
+wuffs_xxhash64__hasher__alloc();
+
+static inline wuffs_base__hasher_u64*
+wuffs_xxhash64__hasher__alloc_as__wuffs_base__hasher_u64() {
+  return (wuffs_base__hasher_u64*)(wuffs_xxhash64__hasher__alloc());
+}
+
+// ---------------- Upcasts
+
+static inline wuffs_base__hasher_u64*
+wuffs_xxhash64__hasher__upcast_as__wuffs_base__hasher_u64(
+    wuffs_xxhash64__hasher* p) {
+  return (wuffs_base__hasher_u64*)p;
+}
+
+// ---------------- Public Function Prototypes
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_xxhash64__hasher__set_quirk_enabled(
+    wuffs_xxhash64__hasher* self,
+    uint32_t a_quirk,
+    bool a_enabled);
+
+WUFFS_BASE__MAYBE_STATIC uint64_t
+wuffs_xxhash64__hasher__update_u64(
+    wuffs_xxhash64__hasher* self,
+    wuffs_base__slice_u8 a_x);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+// ---------------- Struct Definitions
+
+// These structs' fields, and the sizeof them, are private implementation
+// details that aren't guaranteed to be stable across Wuffs versions.
+//
+// See https://en.wikipedia.org/wiki/Opaque_pointer#C
+
+#if defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
+
+struct wuffs_xxhash64__hasher__struct {
+  // Do not access the private_impl's or private_data's fields directly. There
+  // is no API/ABI compatibility or safety guarantee if you do so. Instead, use
+  // the wuffs_foo__bar__baz functions.
+  //
+  // It is a struct, not a struct*, so that the outermost wuffs_foo__bar struct
+  // can be stack allocated when WUFFS_IMPLEMENTATION is defined.
+
+  struct {
+    uint32_t magic;
+    uint32_t active_coroutine;
+    wuffs_base__vtable vtable_for__wuffs_base__hasher_u64;
+    wuffs_base__vtable null_vtable;
+#if defined(WUFFS_CONFIG__STATS)
+    wuffs_base__stats stats;
+#endif  // defined(WUFFS_CONFIG__STATS)
+
+    uint64_t f_length_modulo_u64;
+    bool f_length_overflows_u64;
+    uint32_t f_buf_len;
+    uint8_t f_buf_data[32];
+    uint64_t f_v0;
+    uint64_t f_v1;
+    uint64_t f_v2;
+    uint64_t f_v3;
+  } private_impl;
+
+#ifdef __cplusplus
+#if defined(WUFFS_BASE__HAVE_UNIQUE_PTR)
+  using unique_ptr = std::unique_ptr<wuffs_xxhash64__hasher, decltype(&free)>;
+
+  // On failure, the alloc_etc functions return nullptr. They don't throw.
+
+  static inline unique_ptr
+  alloc() {
+    return unique_ptr(wuffs_xxhash64__hasher__alloc(), &free);
+  }
+
+  static inline wuffs_base__hasher_u64::unique_ptr
+  alloc_as__wuffs_base__hasher_u64() {
+    return wuffs_base__hasher_u64::unique_ptr(
+        wuffs_xxhash64__hasher__alloc_as__wuffs_base__hasher_u64(), &free);
+  }
+#endif  // defined(WUFFS_BASE__HAVE_UNIQUE_PTR)
+
+#if defined(WUFFS_BASE__HAVE_EQ_DELETE) && !defined(WUFFS_IMPLEMENTATION)
+  // Disallow constructing or copying an object via standard C++ mechanisms,
+  // e.g. the "new" operator, as this struct is intentionally opaque. Its total
+  // size and field layout is not part of the public, stable, memory-safe API.
+  // Use malloc or memcpy and the sizeof__wuffs_foo__bar function instead, and
+  // call wuffs_foo__bar__baz methods (which all take a "this"-like pointer as
+  // their first argument) rather than tweaking bar.private_impl.qux fields.
+  //
+  // In C, we can just leave wuffs_foo__bar as an incomplete type (unless
+  // WUFFS_IMPLEMENTATION is #define'd). In C++, we define a complete type in
+  // order to provide convenience methods. These forward on "this", so that you
+  // can write "bar->baz(etc)" instead of "wuffs_foo__bar__baz(bar, etc)".
+  wuffs_xxhash64__hasher__struct() = delete;
+  wuffs_xxhash64__hasher__struct(const wuffs_xxhash64__hasher__struct&) = delete;
+  wuffs_xxhash64__hasher__struct& operator=(
+      const wuffs_xxhash64__hasher__struct&) = delete;
+#endif  // defined(WUFFS_BASE__HAVE_EQ_DELETE) && !defined(WUFFS_IMPLEMENTATION)
+
+#if !defined(WUFFS_IMPLEMENTATION)
+  // As above, the size of the struct is not part of the public API, and unless
+  // WUFFS_IMPLEMENTATION is #define'd, this struct type T should be heap
+  // allocated, not stack allocated. Its size is not intended to be known at
+  // compile time, but it is unfortunately divulged as a side effect of
+  // defining C++ convenience methods. Use "sizeof__T()", calling the function,
+  // instead of "sizeof T", invoking the operator. To make the two values
+  // different, so that passing the latter will be rejected by the initialize
+  // function, we add an arbitrary amount of dead weight.
+  uint8_t dead_weight[123000000];  // 123 MB.
+#endif  // !defined(WUFFS_IMPLEMENTATION)
+
+  inline wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+  initialize(
+      size_t sizeof_star_self,
+      uint64_t wuffs_version,
+      uint32_t options) {
+    return wuffs_xxhash64__hasher__initialize(
+        this, sizeof_star_self, wuffs_version, options);
+  }
+
+  inline wuffs_base__stats
+  stats() const {
+    return wuffs_xxhash64__hasher__stats(this);
+  }
+
+  inline wuffs_base__hasher_u64*
+  upcast_as__wuffs_base__hasher_u64() {
+    return (wuffs_base__hasher_u64*)this;
+  }
+
+  inline wuffs_base__empty_struct
+  set_quirk_enabled(
+      uint32_t a_quirk,
+      bool a_enabled) {
+    return wuffs_xxhash64__hasher__set_quirk_enabled(this, a_quirk, a_enabled);
+  }
+
+  inline uint64_t
+  update_u64(
+      wuffs_base__slice_u8 a_x) {
+    return wuffs_xxhash64__hasher__update_u64(this, a_x);
+  }
+
+#endif  // __cplusplus
+};  // struct wuffs_xxhash64__hasher__struct
+
+#endif  // defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
+
+
+// ‼ WUFFS C HEADER ENDS HERE.
+#ifdef WUFFS_IMPLEMENTATION
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__XXHASH64)
+
+// ---------------- Status Codes Implementations
+
+// ---------------- Private Consts
+
+#define WUFFS_XXHASH64__PRIME64_1 11400714785074694791
+
+#define WUFFS_XXHASH64__PRIME64_2 14029467366897019727
+
+#define WUFFS_XXHASH64__PRIME64_3 1609587929392839161
+
+#define WUFFS_XXHASH64__PRIME64_4 9650029242287828579
+
+#define WUFFS_XXHASH64__PRIME64_5 2870177450012600261
+
+// ---------------- Private Initializer Prototypes
+
+// ---------------- Private Function Prototypes
+
+static wuffs_base__empty_struct
+wuffs_xxhash64__hasher__up(
+    wuffs_xxhash64__hasher* self,
+    wuffs_base__slice_u8 a_x);
+
+static uint64_t
+wuffs_xxhash64__hasher__checksum_u64(
+    wuffs_xxhash64__hasher* self);
+
+// ---------------- VTables
+
+const wuffs_base__hasher_u64__func_ptrs
+wuffs_xxhash64__hasher__func_ptrs_for__wuffs_base__hasher_u64 = {
+  (wuffs_base__empty_struct(*)(void*,
+      uint32_t,
+      bool))(&wuffs_xxhash64__hasher__set_quirk_enabled),
+  (uint64_t(*)(void*,
+      wuffs_base__slice_u8))(&wuffs_xxhash64__hasher__update_u64),
+};
+
+// ---------------- Initializer Implementations
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+wuffs_xxhash64__hasher__initialize(
+    wuffs_xxhash64__hasher* self,
+    size_t sizeof_star_self,
+    uint64_t wuffs_version,
+    uint32_t options){
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  }
+
+  if ((options & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+    // The whole point of this if-check is to detect an uninitialized *self.
+    // We disable the warning on GCC. Clang-5.0 does not have this warning.
+    //
+    // The caller promises that *self is zeroed, so the empty asm tells GCC
+    // that private_impl is defined. Otherwise, once this function and a
+    // small method (e.g. one that reads a "choose" guard field) are both
+    // inlined into the caller, GCC -O3 warns about that method's read.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    __asm__ __volatile__("" : "+m"(self->private_impl));
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((options & WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      options |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    }
+  }
+
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__hasher_u64.vtable_name =
+      wuffs_base__hasher_u64__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__hasher_u64.function_pointers =
+      (const void*)(&wuffs_xxhash64__hasher__func_ptrs_for__wuffs_base__hasher_u64);
+  return wuffs_base__make_status(NULL);
+}
+
+wuffs_xxhash64__hasher*
+wuffs_xxhash64__hasher__alloc() {
+  wuffs_xxhash64__hasher* x =
+      (wuffs_xxhash64__hasher*)(calloc(sizeof(wuffs_xxhash64__hasher), 1));
+  if (!x) {
+    return NULL;
+  }
+  if (wuffs_xxhash64__hasher__initialize(
+      x, sizeof(wuffs_xxhash64__hasher), WUFFS_VERSION, WUFFS_INITIALIZE__ALREADY_ZEROED).repr) {
+    free(x);
+    return NULL;
+  }
+  return x;
+}
+
+size_t
+sizeof__wuffs_xxhash64__hasher() {
+  return sizeof(wuffs_xxhash64__hasher);
+}
+
+wuffs_base__stats
+wuffs_xxhash64__hasher__stats(
+    const wuffs_xxhash64__hasher* self) {
+  wuffs_base__stats ret = wuffs_base__make_empty_stats();
+#if defined(WUFFS_CONFIG__STATS)
+  if (!self) {
+    return ret;
+  }
+  ret = self->private_impl.stats;
+#else
+  (void)(self);
+#endif  // defined(WUFFS_CONFIG__STATS)
+  return ret;
+}
+
+// ---------------- Function Implementations
+
+// -------- func xxhash64.hasher.set_quirk_enabled
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_xxhash64__hasher__set_quirk_enabled(
+    wuffs_xxhash64__hasher* self,
+    uint32_t a_quirk,
+    bool a_enabled) {
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func xxhash64.hasher.update_u64
+
+WUFFS_BASE__MAYBE_STATIC uint64_t
+wuffs_xxhash64__hasher__update_u64(
+    wuffs_xxhash64__hasher* self,
+    wuffs_base__slice_u8 a_x) {
+  if (!self) {
+    return 0;
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return 0;
+  }
+
+  uint64_t v_ret = 0;
+
+  if ((self->private_impl.f_length_modulo_u64 == 0) &&  ! self->private_impl.f_length_overflows_u64) {
+    self->private_impl.f_v0 = 6983438078262162902;
+    self->private_impl.f_v1 = 14029467366897019727u;
+    self->private_impl.f_v2 = 0;
+    self->private_impl.f_v3 = 7046029288634856825;
+  }
+  wuffs_xxhash64__hasher__up(self, a_x);
+  v_ret = wuffs_xxhash64__hasher__checksum_u64(self);
+  return v_ret;
+}
+
+// -------- func xxhash64.hasher.up
+
+static wuffs_base__empty_struct
+wuffs_xxhash64__hasher__up(
+    wuffs_xxhash64__hasher* self,
+    wuffs_base__slice_u8 a_x) {
+  uint64_t v_new_lmu = 0;
+  uint64_t v_buf_u64 = 0;
+  uint32_t v_buf_len = 0;
+  uint64_t v_v0 = 0;
+  uint64_t v_v1 = 0;
+  uint64_t v_v2 = 0;
+  uint64_t v_v3 = 0;
+  wuffs_base__slice_u8 v_p = {0};
+  uint64_t v_n = 0;
+
+  v_new_lmu = ((uint64_t)(self->private_impl.f_length_modulo_u64 + ((uint64_t)(a_x.len))));
+  self->private_impl.f_length_overflows_u64 = ((v_new_lmu < self->private_impl.f_length_modulo_u64) || self->private_impl.f_length_overflows_u64);
+  self->private_impl.f_length_modulo_u64 = v_new_lmu;
+  if (self->private_impl.f_buf_len > 0) {
+    while (true) {
+      v_buf_len = self->private_impl.f_buf_len;
+      if (v_buf_len >= 32) {
+        goto label__0__break;
+      } else if (((uint64_t)(a_x.len)) <= 0) {
+        return wuffs_base__make_empty_struct();
+      }
+      self->private_impl.f_buf_data[v_buf_len] = a_x.ptr[0];
+      a_x = wuffs_base__slice_u8__subslice_i(a_x, 1);
+      self->private_impl.f_buf_len = (v_buf_len + 1);
+    }
+    label__0__break:;
+    self->private_impl.f_buf_len = 0;
+    v_buf_u64 = wuffs_base__peek_u64le__no_bounds_check(self->private_impl.f_buf_data + 0);
+    v_v0 = ((uint64_t)(self->private_impl.f_v0 + ((uint64_t)(v_buf_u64 * 14029467366897019727u))));
+    v_v0 = (((uint64_t)(v_v0 << 31)) | (v_v0 >> 33));
+    self->private_impl.f_v0 = ((uint64_t)(v_v0 * 11400714785074694791u));
+    v_buf_u64 = wuffs_base__peek_u64le__no_bounds_check(self->private_impl.f_buf_data + 8);
+    v_v1 = ((uint64_t)(self->private_impl.f_v1 + ((uint64_t)(v_buf_u64 * 14029467366897019727u))));
+    v_v1 = (((uint64_t)(v_v1 << 31)) | (v_v1 >> 33));
+    self->private_impl.f_v1 = ((uint64_t)(v_v1 * 11400714785074694791u));
+    v_buf_u64 = wuffs_base__peek_u64le__no_bounds_check(self->private_impl.f_buf_data + 16);
+    v_v2 = ((uint64_t)(self->private_impl.f_v2 + ((uint64_t)(v_buf_u64 * 14029467366897019727u))));
+    v_v2 = (((uint64_t)(v_v2 << 31)) | (v_v2 >> 33));
+    self->private_impl.f_v2 = ((uint64_t)(v_v2 * 11400714785074694791u));
+    v_buf_u64 = wuffs_base__peek_u64le__no_bounds_check(self->private_impl.f_buf_data + 24);
+    v_v3 = ((uint64_t)(self->private_impl.f_v3 + ((uint64_t)(v_buf_u64 * 14029467366897019727u))));
+    v_v3 = (((uint64_t)(v_v3 << 31)) | (v_v3 >> 33));
+    self->private_impl.f_v3 = ((uint64_t)(v_v3 * 11400714785074694791u));
+  }
+  v_v0 = self->private_impl.f_v0;
+  v_v1 = self->private_impl.f_v1;
+  v_v2 = self->private_impl.f_v2;
+  v_v3 = self->private_impl.f_v3;
+  {
+    wuffs_base__slice_u8 i_slice_p = a_x;
+    v_p.ptr = i_slice_p.ptr;
+    v_p.len = 32;
+    uint8_t* i_end0_p = v_p.ptr + (((i_slice_p.len - (size_t)(v_p.ptr - i_slice_p.ptr)) / 32) * 32);
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_p.ptr < i_end0_p) {
+      v_buf_u64 = wuffs_base__peek_u64le__no_bounds_check(v_p.ptr);
+      v_v0 = ((uint64_t)(v_v0 + ((uint64_t)(v_buf_u64 * 14029467366897019727u))));
+      v_v0 = (((uint64_t)(v_v0 << 31)) | (v_v0 >> 33));
+      v_v0 = ((uint64_t)(v_v0 * 11400714785074694791u));
+      v_buf_u64 = wuffs_base__peek_u64le__no_bounds_check(v_p.ptr + 8);
+      v_v1 = ((uint64_t)(v_v1 + ((uint64_t)(v_buf_u64 * 14029467366897019727u))));
+      v_v1 = (((uint64_t)(v_v1 << 31)) | (v_v1 >> 33));
+      v_v1 = ((uint64_t)(v_v1 * 11400714785074694791u));
+      v_buf_u64 = wuffs_base__peek_u64le__no_bounds_check(v_p.ptr + 16);
+      v_v2 = ((uint64_t)(v_v2 + ((uint64_t)(v_buf_u64 * 14029467366897019727u))));
+      v_v2 = (((uint64_t)(v_v2 << 31)) | (v_v2 >> 33));
+      v_v2 = ((uint64_t)(v_v2 * 11400714785074694791u));
+      v_buf_u64 = wuffs_base__peek_u64le__no_bounds_check(v_p.ptr + 24);
+      v_v3 = ((uint64_t)(v_v3 + ((uint64_t)(v_buf_u64 * 14029467366897019727u))));
+      v_v3 = (((uint64_t)(v_v3 << 31)) | (v_v3 >> 33));
+      v_v3 = ((uint64_t)(v_v3 * 11400714785074694791u));
+      v_p.ptr += 32;
+    }
+    v_p.len = 0;
+  }
+  self->private_impl.f_v0 = v_v0;
+  self->private_impl.f_v1 = v_v1;
+  self->private_impl.f_v2 = v_v2;
+  self->private_impl.f_v3 = v_v3;
+  v_n = wuffs_base__slice_u8__copy_from_slice(wuffs_base__make_slice_u8(self->private_impl.f_buf_data, 32), wuffs_base__slice_u8__suffix(a_x, (((uint64_t)(a_x.len)) & 31)));
+  self->private_impl.f_buf_len = ((uint32_t)((v_n & 31)));
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func xxhash64.hasher.checksum_u64
+
+static uint64_t
+wuffs_xxhash64__hasher__checksum_u64(
+    wuffs_xxhash64__hasher* self) {
+  uint64_t v_ret = 0;
+  uint64_t v_v = 0;
+  uint64_t v_buf_u64 = 0;
+  wuffs_base__slice_u8 v_p = {0};
+
+  if ((self->private_impl.f_length_modulo_u64 >= 32) || self->private_impl.f_length_overflows_u64) {
+    v_ret = (((uint64_t)(self->private_impl.f_v0 << 1)) | (self->private_impl.f_v0 >> 63));
+    v_ret += (((uint64_t)(self->private_impl.f_v1 << 7)) | (self->private_impl.f_v1 >> 57));
+    v_ret += (((uint64_t)(self->private_impl.f_v2 << 12)) | (self->private_impl.f_v2 >> 52));
+    v_ret += (((uint64_t)(self->private_impl.f_v3 << 18)) | (self->private_impl.f_v3 >> 46));
+    v_v = ((uint64_t)(self->private_impl.f_v0 * 14029467366897019727u));
+    v_v = (((uint64_t)(v_v << 31)) | (v_v >> 33));
+    v_ret ^= ((uint64_t)(v_v * 11400714785074694791u));
+    v_ret = ((uint64_t)(((uint64_t)(v_ret * 11400714785074694791u)) + 9650029242287828579u));
+    v_v = ((uint64_t)(self->private_impl.f_v1 * 14029467366897019727u));
+    v_v = (((uint64_t)(v_v << 31)) | (v_v >> 33));
+    v_ret ^= ((uint64_t)(v_v * 11400714785074694791u));
+    v_ret = ((uint64_t)(((uint64_t)(v_ret * 11400714785074694791u)) + 9650029242287828579u));
+    v_v = ((uint64_t)(self->private_impl.f_v2 * 14029467366897019727u));
+    v_v = (((uint64_t)(v_v << 31)) | (v_v >> 33));
+    v_ret ^= ((uint64_t)(v_v * 11400714785074694791u));
+    v_ret = ((uint64_t)(((uint64_t)(v_ret * 11400714785074694791u)) + 9650029242287828579u));
+    v_v = ((uint64_t)(self->private_impl.f_v3 * 14029467366897019727u));
+    v_v = (((uint64_t)(v_v << 31)) | (v_v >> 33));
+    v_ret ^= ((uint64_t)(v_v * 11400714785074694791u));
+    v_ret = ((uint64_t)(((uint64_t)(v_ret * 11400714785074694791u)) + 9650029242287828579u));
+  } else {
+    v_ret = 2870177450012600261;
+  }
+  v_ret += self->private_impl.f_length_modulo_u64;
+  {
+    wuffs_base__slice_u8 i_slice_p = wuffs_base__slice_u8__subslice_j(wuffs_base__make_slice_u8(self->private_impl.f_buf_data, 32), self->private_impl.f_buf_len);
+    v_p.ptr = i_slice_p.ptr;
+    v_p.len = 8;
+    uint8_t* i_end0_p = v_p.ptr + (((i_slice_p.len - (size_t)(v_p.ptr - i_slice_p.ptr)) / 8) * 8);
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_p.ptr < i_end0_p) {
+      v_buf_u64 = ((uint64_t)(wuffs_base__peek_u64le__no_bounds_check(v_p.ptr) * 14029467366897019727u));
+      v_buf_u64 = (((uint64_t)(v_buf_u64 << 31)) | (v_buf_u64 >> 33));
+      v_ret ^= ((uint64_t)(v_buf_u64 * 11400714785074694791u));
+      v_ret = (((uint64_t)(v_ret << 27)) | (v_ret >> 37));
+      v_ret = ((uint64_t)(((uint64_t)(v_ret * 11400714785074694791u)) + 9650029242287828579u));
+      v_p.ptr += 8;
+    }
+    v_p.len = 4;
+    uint8_t* i_end1_p = v_p.ptr + (((i_slice_p.len - (size_t)(v_p.ptr - i_slice_p.ptr)) / 4) * 4);
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_p.ptr < i_end1_p) {
+      v_ret ^= ((uint64_t)(((uint64_t)(wuffs_base__peek_u32le__no_bounds_check(v_p.ptr))) * 11400714785074694791u));
+      v_ret = (((uint64_t)(v_ret << 23)) | (v_ret >> 41));
+      v_ret = ((uint64_t)(((uint64_t)(v_ret * 14029467366897019727u)) + 1609587929392839161));
+      v_p.ptr += 4;
+    }
+    v_p.len = 1;
+    uint8_t* i_end2_p = i_slice_p.ptr + i_slice_p.len;
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_p.ptr < i_end2_p) {
+      v_ret ^= ((uint64_t)(((uint64_t)(v_p.ptr[0])) * 2870177450012600261));
+      v_ret = (((uint64_t)(v_ret << 11)) | (v_ret >> 53));
+      v_ret *= 11400714785074694791u;
+      v_p.ptr += 1;
+    }
+    v_p.len = 0;
+  }
+  v_ret ^= (v_ret >> 33);
+  v_ret *= 14029467366897019727u;
+  v_ret ^= (v_ret >> 29);
+  v_ret *= 1609587929392839161;
+  v_ret ^= (v_ret >> 32);
+  return v_ret;
+}
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__XXHASH64)
+
+
+#endif  // WUFFS_IMPLEMENTATION
+
+// ¡ WUFFS MONOLITHIC RELEASE DISCARDS EVERYTHING BELOW.
+
+#endif  // WUFFS_INCLUDE_GUARD__XXHASH64
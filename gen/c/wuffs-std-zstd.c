@@ -0,0 +1,3253 @@
+#ifndef WUFFS_INCLUDE_GUARD__ZSTD
+#define WUFFS_INCLUDE_GUARD__ZSTD
+
+#if defined(WUFFS_IMPLEMENTATION) && !defined(WUFFS_CONFIG__MODULES)
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__ZSTD
+#endif
+
+#include "./wuffs-base.c"
+#include "./wuffs-std-xxhash64.c"
+
+// ¡ WUFFS MONOLITHIC RELEASE DISCARDS EVERYTHING ABOVE.
+
+
+// ---------------- Status Codes
+
+extern const char wuffs_zstd__error__bad_block[];
+extern const char wuffs_zstd__error__bad_checksum[];
+extern const char wuffs_zstd__error__bad_content_size[];
+extern const char wuffs_zstd__error__bad_fse_table[];
+extern const char wuffs_zstd__error__bad_huffman_table[];
+extern const char wuffs_zstd__error__bad_header[];
+extern const char wuffs_zstd__error__bad_literals_section[];
+extern const char wuffs_zstd__error__bad_offset[];
+extern const char wuffs_zstd__error__bad_sequences_section[];
+extern const char wuffs_zstd__error__unsupported_zstandard_dictionary[];
+extern const char wuffs_zstd__error__unsupported_zstandard_window_size[];
+
+// ---------------- Public Consts
+
+#define WUFFS_ZSTD__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE 9437184
+
+// ---------------- Struct Declarations
+
+typedef struct wuffs_zstd__decoder__struct wuffs_zstd__decoder;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ---------------- Public Initializer Prototypes
+
+// For any given "wuffs_foo__bar* self", "wuffs_foo__bar__initialize(self,
+// etc)" should be called before any other "wuffs_foo__bar__xxx(self, etc)".
+//
+// Pass sizeof(*self) and WUFFS_VERSION for sizeof_star_self and wuffs_version.
+// Pass 0 (or some combination of WUFFS_INITIALIZE__XXX) for options.
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+wuffs_zstd__decoder__initialize(
+    wuffs_zstd__decoder* self,
+    size_t sizeof_star_self,
+    uint64_t wuffs_version,
+    uint32_t options);
+
+wuffs_base__stats
+wuffs_zstd__decoder__stats(
+    const wuffs_zstd__decoder* self);
+
+size_t
+sizeof__wuffs_zstd__decoder();
+
+// ---------------- Allocs
+
+// These functions allocate and initialize Wuffs structs. They return NULL if
+// memory allocation fails. If they return non-NULL, there is no need to call
+// wuffs_foo__bar__initialize, but the caller is responsible for eventually
+// calling free on the returned pointer. That pointer is effectively a C++
+// std::unique_ptr<T, decltype(&free)>.
+
+wuffs_zstd__decoder*
+wuffs_zstd__decoder__alloc();
+
+static inline wuffs_base__io_transformer*
+wuffs_zstd__decoder__alloc_as__wuffs_base__io_transformer() {
+  return (wuffs_base__io_transformer*)(wuffs_zstd__decoder__alloc());
+}
+
+// ---------------- Upcasts
+
+static inline wuffs_base__io_transformer*
+wuffs_zstd__decoder__upcast_as__wuffs_base__io_transformer(
+    wuffs_zstd__decoder* p) {
+  return (wuffs_base__io_transformer*)p;
+}
+
+// ---------------- Public Function Prototypes
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_zstd__decoder__set_quirk_enabled(
+    wuffs_zstd__decoder* self,
+    uint32_t a_quirk,
+    bool a_enabled);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64
+wuffs_zstd__decoder__workbuf_len(
+    const wuffs_zstd__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_zstd__decoder__transform_io(
+    wuffs_zstd__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+// ---------------- Struct Definitions
+
+// These structs' fields, and the sizeof them, are private implementation
+// details that aren't guaranteed to be stable across Wuffs versions.
+//
+// See https://en.wikipedia.org/wiki/Opaque_pointer#C
+
+#if defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
+
+struct wuffs_zstd__decoder__struct {
+  // Do not access the private_impl's or private_data's fields directly. There
+  // is no API/ABI compatibility or safety guarantee if you do so. Instead, use
+  // the wuffs_foo__bar__baz functions.
+  //
+  // It is a struct, not a struct*, so that the outermost wuffs_foo__bar struct
+  // can be stack allocated when WUFFS_IMPLEMENTATION is defined.
+
+  struct {
+    uint32_t magic;
+    uint32_t active_coroutine;
+    wuffs_base__vtable vtable_for__wuffs_base__io_transformer;
+    wuffs_base__vtable null_vtable;
+#if defined(WUFFS_CONFIG__STATS)
+    wuffs_base__stats stats;
+#endif  // defined(WUFFS_CONFIG__STATS)
+
+    bool f_ignore_checksum;
+    bool f_content_checksum_present;
+    bool f_content_size_present;
+    uint64_t f_content_size;
+    uint32_t f_window_size;
+    uint32_t f_block_max_size;
+    uint64_t f_frame_decoded;
+    uint32_t f_block_length;
+    uint32_t f_literals_ri;
+    uint32_t f_literals_wi;
+    uint32_t f_sequences_ri;
+    uint32_t f_n_sequences;
+    uint32_t f_seq_index;
+    bool f_huff_table_present;
+    uint32_t f_huff_table_bits;
+    uint32_t f_huff_n_weights;
+    bool f_ll_table_present;
+    bool f_of_table_present;
+    bool f_ml_table_present;
+    uint32_t f_ll_table_log;
+    uint32_t f_of_table_log;
+    uint32_t f_ml_table_log;
+    uint32_t f_rep0;
+    uint32_t f_rep1;
+    uint32_t f_rep2;
+    uint32_t f_fse_n_symbols;
+    uint32_t f_fse_table_log;
+    uint32_t f_n_consumed;
+    uint64_t f_transformed_history_count;
+    uint32_t f_history_index;
+
+    uint32_t p_transform_io[1];
+    uint32_t p_decode_frame[1];
+    uint32_t p_read_block[1];
+    uint32_t p_decode_raw_block[1];
+    uint32_t p_copy_literals[1];
+    uint32_t p_decode_compressed_block[1];
+    uint32_t p_execute_sequences[1];
+  } private_impl;
+
+  struct {
+    wuffs_xxhash64__hasher f_content_hasher;
+    uint16_t f_huff_table[2048];
+    uint8_t f_huff_weights[256];
+    uint64_t f_ll_table[512];
+    uint64_t f_of_table[256];
+    uint64_t f_ml_table[512];
+    uint16_t f_fse_counts[64];
+    uint32_t f_fse_next[64];
+    uint32_t f_fse_entries[512];
+
+    struct {
+      uint64_t scratch;
+      uint64_t v_window_size;
+      uint64_t v_n_block;
+      wuffs_base__status v_status;
+      uint64_t v_checksum_got;
+      uint32_t v_block_type;
+      uint32_t v_block_size;
+      uint8_t v_fhd;
+      bool v_single;
+      bool v_last_block;
+    } s_decode_frame[1];
+    struct {
+      uint32_t v_n_copied;
+    } s_read_block[1];
+    struct {
+      uint32_t v_ll;
+      uint32_t v_ml;
+      uint32_t v_offset;
+      uint32_t v_hlen;
+    } s_execute_sequences[1];
+  } private_data;
+
+#ifdef __cplusplus
+#if defined(WUFFS_BASE__HAVE_UNIQUE_PTR)
+  using unique_ptr = std::unique_ptr<wuffs_zstd__decoder, decltype(&free)>;
+
+  // On failure, the alloc_etc functions return nullptr. They don't throw.
+
+  static inline unique_ptr
+  alloc() {
+    return unique_ptr(wuffs_zstd__decoder__alloc(), &free);
+  }
+
+  static inline wuffs_base__io_transformer::unique_ptr
+  alloc_as__wuffs_base__io_transformer() {
+    return wuffs_base__io_transformer::unique_ptr(
+        wuffs_zstd__decoder__alloc_as__wuffs_base__io_transformer(), &free);
+  }
+#endif  // defined(WUFFS_BASE__HAVE_UNIQUE_PTR)
+
+#if defined(WUFFS_BASE__HAVE_EQ_DELETE) && !defined(WUFFS_IMPLEMENTATION)
+  // Disallow constructing or copying an object via standard C++ mechanisms,
+  // e.g. the "new" operator, as this struct is intentionally opaque. Its total
+  // size and field layout is not part of the public, stable, memory-safe API.
+  // Use malloc or memcpy and the sizeof__wuffs_foo__bar function instead, and
+  // call wuffs_foo__bar__baz methods (which all take a "this"-like pointer as
+  // their first argument) rather than tweaking bar.private_impl.qux fields.
+  //
+  // In C, we can just leave wuffs_foo__bar as an incomplete type (unless
+  // WUFFS_IMPLEMENTATION is #define'd). In C++, we define a complete type in
+  // order to provide convenience methods. These forward on "this", so that you
+  // can write "bar->baz(etc)" instead of "wuffs_foo__bar__baz(bar, etc)".
+  wuffs_zstd__decoder__struct() = delete;
+  wuffs_zstd__decoder__struct(const wuffs_zstd__decoder__struct&) = delete;
+  wuffs_zstd__decoder__struct& operator=(
+      const wuffs_zstd__decoder__struct&) = delete;
+#endif  // defined(WUFFS_BASE__HAVE_EQ_DELETE) && !defined(WUFFS_IMPLEMENTATION)
+
+#if !defined(WUFFS_IMPLEMENTATION)
+  // As above, the size of the struct is not part of the public API, and unless
+  // WUFFS_IMPLEMENTATION is #define'd, this struct type T should be heap
+  // allocated, not stack allocated. Its size is not intended to be known at
+  // compile time, but it is unfortunately divulged as a side effect of
+  // defining C++ convenience methods. Use "sizeof__T()", calling the function,
+  // instead of "sizeof T", invoking the operator. To make the two values
+  // different, so that passing the latter will be rejected by the initialize
+  // function, we add an arbitrary amount of dead weight.
+  uint8_t dead_weight[123000000];  // 123 MB.
+#endif  // !defined(WUFFS_IMPLEMENTATION)
+
+  inline wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+  initialize(
+      size_t sizeof_star_self,
+      uint64_t wuffs_version,
+      uint32_t options) {
+    return wuffs_zstd__decoder__initialize(
+        this, sizeof_star_self, wuffs_version, options);
+  }
+
+  inline wuffs_base__stats
+  stats() const {
+    return wuffs_zstd__decoder__stats(this);
+  }
+
+  inline wuffs_base__io_transformer*
+  upcast_as__wuffs_base__io_transformer() {
+    return (wuffs_base__io_transformer*)this;
+  }
+
+  inline wuffs_base__empty_struct
+  set_quirk_enabled(
+      uint32_t a_quirk,
+      bool a_enabled) {
+    return wuffs_zstd__decoder__set_quirk_enabled(this, a_quirk, a_enabled);
+  }
+
+  inline wuffs_base__range_ii_u64
+  workbuf_len() const {
+    return wuffs_zstd__decoder__workbuf_len(this);
+  }
+
+  inline wuffs_base__status
+  transform_io(
+      wuffs_base__io_buffer* a_dst,
+      wuffs_base__io_buffer* a_src,
+      wuffs_base__slice_u8 a_workbuf) {
+    return wuffs_zstd__decoder__transform_io(this, a_dst, a_src, a_workbuf);
+  }
+
+#endif  // __cplusplus
+};  // struct wuffs_zstd__decoder__struct
+
+#endif  // defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
+
+
+// ‼ WUFFS C HEADER ENDS HERE.
+#ifdef WUFFS_IMPLEMENTATION
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__ZSTD)
+
+// ---------------- Status Codes Implementations
+
+const char wuffs_zstd__error__bad_block[] = "#zstd: bad block";
+const char wuffs_zstd__error__bad_checksum[] = "#zstd: bad checksum";
+const char wuffs_zstd__error__bad_content_size[] = "#zstd: bad content size";
+const char wuffs_zstd__error__bad_fse_table[] = "#zstd: bad FSE table";
+const char wuffs_zstd__error__bad_huffman_table[] = "#zstd: bad Huffman table";
+const char wuffs_zstd__error__bad_header[] = "#zstd: bad header";
+const char wuffs_zstd__error__bad_literals_section[] = "#zstd: bad literals section";
+const char wuffs_zstd__error__bad_offset[] = "#zstd: bad offset";
+const char wuffs_zstd__error__bad_sequences_section[] = "#zstd: bad sequences section";
+const char wuffs_zstd__error__unsupported_zstandard_dictionary[] = "#zstd: unsupported Zstandard dictionary";
+const char wuffs_zstd__error__unsupported_zstandard_window_size[] = "#zstd: unsupported Zstandard window size";
+const char wuffs_zstd__error__internal_error_inconsistent_i_o[] = "#zstd: internal error: inconsistent I/O";
+const char wuffs_zstd__error__internal_error_inconsistent_workbuf_length[] = "#zstd: internal error: inconsistent workbuf length";
+
+// ---------------- Private Consts
+
+static const uint32_t
+WUFFS_ZSTD__LITERALS_LENGTH_BASES[36] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  0, 1, 2, 3, 4, 5, 6, 7,
+  8, 9, 10, 11, 12, 13, 14, 15,
+  16, 18, 20, 22, 24, 28, 32, 40,
+  48, 64, 128, 256, 512, 1024, 2048, 4096,
+  8192, 16384, 32768, 65536,
+};
+
+static const uint32_t
+WUFFS_ZSTD__LITERALS_LENGTH_EXTRA_BITS[36] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  1, 1, 1, 1, 2, 2, 3, 3,
+  4, 6, 7, 8, 9, 10, 11, 12,
+  13, 14, 15, 16,
+};
+
+static const uint32_t
+WUFFS_ZSTD__MATCH_LENGTH_BASES[53] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  3, 4, 5, 6, 7, 8, 9, 10,
+  11, 12, 13, 14, 15, 16, 17, 18,
+  19, 20, 21, 22, 23, 24, 25, 26,
+  27, 28, 29, 30, 31, 32, 33, 34,
+  35, 37, 39, 41, 43, 47, 51, 59,
+  67, 83, 99, 131, 259, 515, 1027, 2051,
+  4099, 8195, 16387, 32771, 65539,
+};
+
+static const uint32_t
+WUFFS_ZSTD__MATCH_LENGTH_EXTRA_BITS[53] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  1, 1, 1, 1, 2, 2, 3, 3,
+  4, 4, 5, 7, 8, 9, 10, 11,
+  12, 13, 14, 15, 16,
+};
+
+static const uint16_t
+WUFFS_ZSTD__PREDEFINED_LITERALS_LENGTH_COUNTS[36] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  4, 3, 2, 2, 2, 2, 2, 2,
+  2, 2, 2, 2, 2, 1, 1, 1,
+  2, 2, 2, 2, 2, 2, 2, 2,
+  2, 3, 2, 1, 1, 1, 1, 1,
+  65535, 65535, 65535, 65535,
+};
+
+static const uint16_t
+WUFFS_ZSTD__PREDEFINED_MATCH_LENGTH_COUNTS[53] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  1, 4, 3, 2, 2, 2, 2, 2,
+  2, 1, 1, 1, 1, 1, 1, 1,
+  1, 1, 1, 1, 1, 1, 1, 1,
+  1, 1, 1, 1, 1, 1, 1, 1,
+  1, 1, 1, 1, 1, 1, 1, 1,
+  1, 1, 1, 1, 1, 1, 65535, 65535,
+  65535, 65535, 65535, 65535, 65535,
+};
+
+static const uint16_t
+WUFFS_ZSTD__PREDEFINED_OFFSET_COUNTS[29] WUFFS_BASE__POTENTIALLY_UNUSED = {
+  1, 1, 1, 1, 1, 1, 2, 2,
+  2, 1, 1, 1, 1, 1, 1, 1,
+  1, 1, 1, 1, 1, 1, 1, 1,
+  65535, 65535, 65535, 65535, 65535,
+};
+
+#define WUFFS_ZSTD__WORKBUF_LITERALS_OFFSET 131072
+
+#define WUFFS_ZSTD__WORKBUF_SEQUENCES_OFFSET 262144
+
+#define WUFFS_ZSTD__WORKBUF_HISTORY_OFFSET 1048576
+
+// ---------------- Private Initializer Prototypes
+
+// ---------------- Private Function Prototypes
+
+static wuffs_base__status
+wuffs_zstd__decoder__read_fse_counts(
+    wuffs_zstd__decoder* self,
+    wuffs_base__slice_u8 a_s,
+    uint32_t a_max_symbol,
+    uint32_t a_max_table_log);
+
+static wuffs_base__status
+wuffs_zstd__decoder__build_fse_table(
+    wuffs_zstd__decoder* self);
+
+static wuffs_base__status
+wuffs_zstd__decoder__decode_literals(
+    wuffs_zstd__decoder* self,
+    wuffs_base__slice_u8 a_workbuf);
+
+static wuffs_base__status
+wuffs_zstd__decoder__read_huffman_table(
+    wuffs_zstd__decoder* self,
+    wuffs_base__slice_u8 a_s);
+
+static wuffs_base__status
+wuffs_zstd__decoder__decode_huffman_weights(
+    wuffs_zstd__decoder* self,
+    wuffs_base__slice_u8 a_s);
+
+static wuffs_base__status
+wuffs_zstd__decoder__decode_huffman_stream(
+    wuffs_zstd__decoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_src);
+
+static wuffs_base__status
+wuffs_zstd__decoder__decode_sequences_header(
+    wuffs_zstd__decoder* self,
+    wuffs_base__slice_u8 a_workbuf);
+
+static wuffs_base__status
+wuffs_zstd__decoder__make_sequence_table(
+    wuffs_zstd__decoder* self,
+    uint32_t a_kind,
+    uint32_t a_mode,
+    wuffs_base__slice_u8 a_s);
+
+static wuffs_base__status
+wuffs_zstd__decoder__decode_sequences(
+    wuffs_zstd__decoder* self,
+    wuffs_base__slice_u8 a_workbuf);
+
+static wuffs_base__empty_struct
+wuffs_zstd__decoder__add_history(
+    wuffs_zstd__decoder* self,
+    wuffs_base__slice_u8 a_hist,
+    wuffs_base__slice_u8 a_workbuf);
+
+static wuffs_base__status
+wuffs_zstd__decoder__decode_frame(
+    wuffs_zstd__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf);
+
+static wuffs_base__status
+wuffs_zstd__decoder__read_block(
+    wuffs_zstd__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf);
+
+static wuffs_base__status
+wuffs_zstd__decoder__decode_raw_block(
+    wuffs_zstd__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__empty_struct
+wuffs_zstd__decoder__fill_literals(
+    wuffs_zstd__decoder* self,
+    wuffs_base__slice_u8 a_workbuf,
+    uint8_t a_b,
+    uint32_t a_n);
+
+static wuffs_base__status
+wuffs_zstd__decoder__copy_literals(
+    wuffs_zstd__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__slice_u8 a_workbuf);
+
+static wuffs_base__status
+wuffs_zstd__decoder__decode_compressed_block(
+    wuffs_zstd__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__slice_u8 a_workbuf);
+
+static wuffs_base__status
+wuffs_zstd__decoder__execute_sequences(
+    wuffs_zstd__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__slice_u8 a_workbuf);
+
+static uint64_t
+wuffs_zstd__decoder__load_sequence(
+    wuffs_zstd__decoder* self,
+    wuffs_base__slice_u8 a_workbuf);
+
+static wuffs_base__status
+wuffs_zstd__decoder__execute_sequences_fast(
+    wuffs_zstd__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__slice_u8 a_workbuf);
+
+// ---------------- VTables
+
+const wuffs_base__io_transformer__func_ptrs
+wuffs_zstd__decoder__func_ptrs_for__wuffs_base__io_transformer = {
+  (wuffs_base__empty_struct(*)(void*,
+      uint32_t,
+      bool))(&wuffs_zstd__decoder__set_quirk_enabled),
+  (wuffs_base__status(*)(void*,
+      wuffs_base__io_buffer*,
+      wuffs_base__io_buffer*,
+      wuffs_base__slice_u8))(&wuffs_zstd__decoder__transform_io),
+  (wuffs_base__range_ii_u64(*)(const void*))(&wuffs_zstd__decoder__workbuf_len),
+};
+
+// ---------------- Initializer Implementations
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT
+wuffs_zstd__decoder__initialize(
+    wuffs_zstd__decoder* self,
+    size_t sizeof_star_self,
+    uint64_t wuffs_version,
+    uint32_t options){
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  }
+
+  if ((options & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+    // The whole point of this if-check is to detect an uninitialized *self.
+    // We disable the warning on GCC. Clang-5.0 does not have this warning.
+    //
+    // The caller promises that *self is zeroed, so the empty asm tells GCC
+    // that private_impl is defined. Otherwise, once this function and a
+    // small method (e.g. one that reads a "choose" guard field) are both
+    // inlined into the caller, GCC -O3 warns about that method's read.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    __asm__ __volatile__("" : "+m"(self->private_impl));
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((options & WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      options |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    }
+  }
+
+  {
+    wuffs_base__status z = wuffs_xxhash64__hasher__initialize(
+        &self->private_data.f_content_hasher, sizeof(self->private_data.f_content_hasher), WUFFS_VERSION, options);
+    if (z.repr) {
+      return z;
+    }
+  }
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.vtable_name =
+      wuffs_base__io_transformer__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.function_pointers =
+      (const void*)(&wuffs_zstd__decoder__func_ptrs_for__wuffs_base__io_transformer);
+  return wuffs_base__make_status(NULL);
+}
+
+wuffs_zstd__decoder*
+wuffs_zstd__decoder__alloc() {
+  wuffs_zstd__decoder* x =
+      (wuffs_zstd__decoder*)(calloc(sizeof(wuffs_zstd__decoder), 1));
+  if (!x) {
+    return NULL;
+  }
+  if (wuffs_zstd__decoder__initialize(
+      x, sizeof(wuffs_zstd__decoder), WUFFS_VERSION, WUFFS_INITIALIZE__ALREADY_ZEROED).repr) {
+    free(x);
+    return NULL;
+  }
+  return x;
+}
+
+size_t
+sizeof__wuffs_zstd__decoder() {
+  return sizeof(wuffs_zstd__decoder);
+}
+
+wuffs_base__stats
+wuffs_zstd__decoder__stats(
+    const wuffs_zstd__decoder* self) {
+  wuffs_base__stats ret = wuffs_base__make_empty_stats();
+#if defined(WUFFS_CONFIG__STATS)
+  if (!self) {
+    return ret;
+  }
+  ret = self->private_impl.stats;
+  {
+    wuffs_base__stats z = wuffs_xxhash64__hasher__stats(&self->private_data.f_content_hasher);
+    wuffs_base__stats__accumulate(&ret, &z);
+  }
+#else
+  (void)(self);
+#endif  // defined(WUFFS_CONFIG__STATS)
+  return ret;
+}
+
+// ---------------- Function Implementations
+
+// -------- func zstd.decoder.read_fse_counts
+
+static wuffs_base__status
+wuffs_zstd__decoder__read_fse_counts(
+    wuffs_zstd__decoder* self,
+    wuffs_base__slice_u8 a_s,
+    uint32_t a_max_symbol,
+    uint32_t a_max_table_log) {
+  wuffs_base__slice_u8 v_p = {0};
+  uint64_t v_bits = 0;
+  uint32_t v_n_bits = 0;
+  uint32_t v_n_virtual = 0;
+  uint32_t v_table_log = 0;
+  uint32_t v_remaining = 0;
+  uint32_t v_threshold = 0;
+  uint32_t v_nb = 0;
+  uint32_t v_max = 0;
+  uint32_t v_count = 0;
+  uint32_t v_sym = 0;
+  uint32_t v_n0 = 0;
+  bool v_previous0 = false;
+  uint32_t v_n_unused = 0;
+  uint64_t v_n_consumed = 0;
+
+  v_p = a_s;
+  while (v_n_bits <= 56) {
+    if (((uint64_t)(v_p.len)) > 0) {
+      v_bits |= (((uint64_t)(v_p.ptr[0])) << v_n_bits);
+      v_p = wuffs_base__slice_u8__subslice_i(v_p, 1);
+    } else {
+      wuffs_base__u32__sat_add_indirect(&v_n_virtual, 1);
+    }
+    v_n_bits += 8;
+  }
+  v_count = (((uint32_t)((v_bits & 15))) + 5);
+  if (v_count > a_max_table_log) {
+    return wuffs_base__make_status(wuffs_zstd__error__bad_fse_table);
+  }
+  v_table_log = v_count;
+  v_bits >>= 4;
+  v_n_bits -= 4;
+  v_remaining = ((((uint32_t)(1)) << v_table_log) + 1);
+  v_threshold = (((uint32_t)(1)) << v_table_log);
+  v_nb = (v_table_log + 1);
+  while ((v_remaining > 1) && (v_sym <= a_max_symbol)) {
+    if (v_previous0) {
+      v_n0 = v_sym;
+      while (true) {
+        while (v_n_bits <= 56) {
+          if (((uint64_t)(v_p.len)) > 0) {
+            v_bits |= (((uint64_t)(v_p.ptr[0])) << v_n_bits);
+            v_p = wuffs_base__slice_u8__subslice_i(v_p, 1);
+          } else {
+            wuffs_base__u32__sat_add_indirect(&v_n_virtual, 1);
+          }
+          v_n_bits += 8;
+        }
+        wuffs_base__u32__sat_add_indirect(&v_n0, ((uint32_t)((v_bits & 3))));
+        if ((v_bits & 3) != 3) {
+          v_bits >>= 2;
+          v_n_bits -= 2;
+          goto label__0__break;
+        }
+        v_bits >>= 2;
+        v_n_bits -= 2;
+      }
+      label__0__break:;
+      if (v_n0 > a_max_symbol) {
+        return wuffs_base__make_status(wuffs_zstd__error__bad_fse_table);
+      }
+      while (v_sym < v_n0) {
+        self->private_data.f_fse_counts[v_sym] = 0;
+        v_sym += 1;
+      }
+    }
+    while (v_n_bits <= 56) {
+      if (((uint64_t)(v_p.len)) > 0) {
+        v_bits |= (((uint64_t)(v_p.ptr[0])) << v_n_bits);
+        v_p = wuffs_base__slice_u8__subslice_i(v_p, 1);
+      } else {
+        wuffs_base__u32__sat_add_indirect(&v_n_virtual, 1);
+      }
+      v_n_bits += 8;
+    }
+    v_max = ((uint32_t)(((uint32_t)(((uint32_t)(v_threshold * 2)) - 1)) - v_remaining));
+    v_count = ((uint32_t)((v_bits & ((uint64_t)(((uint32_t)(v_threshold - 1)))))));
+    if (v_nb < 1) {
+      return wuffs_base__make_status(wuffs_zstd__error__bad_fse_table);
+    } else if (v_count < v_max) {
+      v_bits >>= (v_nb - 1);
+      v_n_bits -= (v_nb - 1);
+    } else {
+      v_count = ((uint32_t)((v_bits & ((uint64_t)(((uint32_t)(((uint32_t)(v_threshold * 2)) - 1)))))));
+      if (v_count >= v_threshold) {
+        v_count -= v_max;
+      }
+      v_bits >>= v_nb;
+      v_n_bits -= v_nb;
+    }
+    if (v_n_bits > 64) {
+      return wuffs_base__make_status(wuffs_zstd__error__bad_fse_table);
+    }
+    if ((v_sym > a_max_symbol) || (v_count > v_remaining) || (v_remaining < 1)) {
+      return wuffs_base__make_status(wuffs_zstd__error__bad_fse_table);
+    }
+    if (v_count == 0) {
+      self->private_data.f_fse_counts[v_sym] = 65535;
+      v_remaining -= 1;
+      v_previous0 = false;
+    } else {
+      v_remaining -= v_count;
+      v_remaining += 1;
+      v_count -= 1;
+      self->private_data.f_fse_counts[v_sym] = ((uint16_t)((v_count & 65535)));
+      v_previous0 = (v_count == 0);
+    }
+    v_sym += 1;
+    while ((v_remaining < v_threshold) && (v_nb > 1)) {
+      v_nb -= 1;
+      v_threshold >>= 1;
+    }
+  }
+  if (v_remaining != 1) {
+    return wuffs_base__make_status(wuffs_zstd__error__bad_fse_table);
+  }
+  self->private_impl.f_fse_n_symbols = v_sym;
+  self->private_impl.f_fse_table_log = v_table_log;
+  if (v_n_virtual > 8) {
+    return wuffs_base__make_status(wuffs_zstd__error__bad_fse_table);
+  }
+  v_n_unused = (v_n_virtual * 8);
+  if (v_n_bits < v_n_unused) {
+    return wuffs_base__make_status(wuffs_zstd__error__bad_fse_table);
+  }
+  v_n_unused = ((v_n_bits - v_n_unused) >> 3);
+  v_n_consumed = wuffs_base__u64__sat_sub(((uint64_t)(a_s.len)), ((uint64_t)(v_p.len)));
+  if (v_n_consumed < ((uint64_t)(v_n_unused))) {
+    return wuffs_base__make_status(wuffs_zstd__error__bad_fse_table);
+  }
+  self->private_impl.f_n_consumed = ((uint32_t)(((v_n_consumed - ((uint64_t)(v_n_unused))) & 4294967295)));
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func zstd.decoder.build_fse_table
+
+static wuffs_base__status
+wuffs_zstd__decoder__build_fse_table(
+    wuffs_zstd__decoder* self) {
+  uint32_t v_table_size = 0;
+  uint32_t v_high = 0;
+  uint32_t v_mask = 0;
+  uint32_t v_step = 0;
+  uint32_t v_pos = 0;
+  uint32_t v_sym = 0;
+  uint32_t v_count = 0;
+  uint32_t v_i = 0;
+  uint32_t v_ns = 0;
+  uint32_t v_nb = 0;
+
+  v_table_size = (((uint32_t)(1)) << self->private_impl.f_fse_table_log);
+  v_high = ((uint32_t)(v_table_size - 1));
+  v_mask = ((uint32_t)(v_table_size - 1));
+  while (v_sym < self->private_impl.f_fse_n_symbols) {
+    v_count = ((uint32_t)(self->private_data.f_fse_counts[v_sym]));
+    if (v_count == 65535) {
+      if (v_high >= v_table_size) {
+        return wuffs_base__make_status(wuffs_zstd__error__bad_fse_table);
+      }
+      self->private_data.f_fse_entries[(v_high & 511)] = v_sym;
+      v_high -= 1;
+      self->private_data.f_fse_next[v_sym] = 1;
+    } else {
+      self->private_data.f_fse_next[v_sym] = v_count;
+    }
+    v_sym += 1;
+  }
+  v_step = ((v_table_size >> 1) + (v_table_size >> 3) + 3);
+  v_sym = 0;
+  while (v_sym < self->private_impl.f_fse_n_symbols) {
+    v_count = ((uint32_t)(self->private_data.f_fse_counts[v_sym]));
+    if (v_count != 65535) {
+      v_i = 0;
+      while (v_i < v_count) {
+        if (v_pos >= v_table_size) {
+          return wuffs_base__make_status(wuffs_zstd__error__bad_fse_table);
+        }
+        self->private_data.f_fse_entries[(v_pos & 511)] = v_sym;
+        while (true) {
+          v_pos = (((uint32_t)(v_pos + v_step)) & v_mask);
+          if (v_pos <= v_high) {
+            goto label__0__break;
+          }
+        }
+        label__0__break:;
+        v_i += 1;
+      }
+    }
+    v_sym += 1;
+  }
+  if (v_pos != 0) {
+    return wuffs_base__make_status(wuffs_zstd__error__bad_fse_table);
+  }
+  v_i = 0;
+  while (v_i < v_table_size) {
+    v_sym = (self->private_data.f_fse_entries[v_i] & 63);
+    v_ns = self->private_data.f_fse_next[v_sym];
+    self->private_data.f_fse_next[v_sym] = ((uint32_t)(v_ns + 1));
+    if (v_ns == 0) {
+      return wuffs_base__make_status(wuffs_zstd__error__bad_fse_table);
+    }
+    v_nb = 0;
+    while ((((uint32_t)(v_ns << v_nb)) < v_table_size) && (v_nb < 16)) {
+      v_nb += 1;
+    }
+    self->private_data.f_fse_entries[v_i] = (((uint32_t)(v_sym)) | ((v_nb & 255) << 8) | ((((uint32_t)(((uint32_t)(v_ns << v_nb)) - v_table_size)) & 65535) << 16));
+    v_i += 1;
+  }
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func zstd.decoder.decode_literals
+
+static wuffs_base__status
+wuffs_zstd__decoder__decode_literals(
+    wuffs_zstd__decoder* self,
+    wuffs_base__slice_u8 a_workbuf) {
+  wuffs_base__slice_u8 v_block = {0};
+  uint64_t v_hdr = 0;
+  uint32_t v_lit_type = 0;
+  uint32_t v_size_fmt = 0;
+  uint32_t v_n_hdr = 0;
+  uint32_t v_regen = 0;
+  uint32_t v_c_size = 0;
+  uint32_t v_c_end = 0;
+  wuffs_base__slice_u8 v_literals = {0};
+  wuffs_base__slice_u8 v_src = {0};
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  uint32_t v_n_seg = 0;
+  uint32_t v_s1 = 0;
+  uint32_t v_s2 = 0;
+  uint32_t v_s3 = 0;
+  uint64_t v_fill = 0;
+  wuffs_base__slice_u8 v_p = {0};
+  wuffs_base__slice_u8 v_q = {0};
+
+  if ((((uint64_t)(a_workbuf.len)) < 262144) || (((uint64_t)(self->private_impl.f_block_length)) > ((uint64_t)(a_workbuf.len)))) {
+    return wuffs_base__make_status(wuffs_zstd__error__internal_error_inconsistent_workbuf_length);
+  }
+  v_block = wuffs_base__slice_u8__subslice_j(a_workbuf, self->private_impl.f_block_length);
+  v_literals = wuffs_base__slice_u8__subslice_ij(a_workbuf, 131072, 262144);
+  if (((uint64_t)(v_block.len)) >= 5) {
+    v_hdr = wuffs_base__peek_u40le__no_bounds_check(v_block.ptr);
+  } else if (((uint64_t)(v_block.len)) >= 1) {
+    v_hdr = ((uint64_t)(v_block.ptr[0]));
+    if (((uint64_t)(v_block.len)) >= 2) {
+      v_hdr |= (((uint64_t)(v_block.ptr[1])) << 8);
+      if (((uint64_t)(v_block.len)) >= 3) {
+        v_hdr |= (((uint64_t)(v_block.ptr[2])) << 16);
+        if (((uint64_t)(v_block.len)) >= 4) {
+          v_hdr |= (((uint64_t)(v_block.ptr[3])) << 24);
+        }
+      }
+    }
+  } else {
+    return wuffs_base__make_status(wuffs_zstd__error__bad_literals_section);
+  }
+  v_lit_type = ((uint32_t)((v_hdr & 3)));
+  v_size_fmt = ((uint32_t)(((v_hdr >> 2) & 3)));
+  if (v_lit_type <= 1) {
+    if ((v_size_fmt & 1) == 0) {
+      v_n_hdr = 1;
+      v_regen = ((uint32_t)(((v_hdr >> 3) & 31)));
+    } else if (v_size_fmt == 1) {
+      v_n_hdr = 2;
+      v_regen = ((uint32_t)(((v_hdr >> 4) & 4095)));
+    } else {
+      v_n_hdr = 3;
+      v_regen = ((uint32_t)(((v_hdr >> 4) & 1048575)));
+    }
+    if (v_regen > self->private_impl.f_block_max_size) {
+      return wuffs_base__make_status(wuffs_zstd__error__bad_literals_section);
+    }
+    if (v_lit_type == 0) {
+      if ((v_n_hdr + v_regen) > self->private_impl.f_block_length) {
+        return wuffs_base__make_status(wuffs_zstd__error__bad_literals_section);
+      }
+      self->private_impl.f_literals_ri = v_n_hdr;
+      self->private_impl.f_literals_wi = (v_n_hdr + v_regen);
+      self->private_impl.f_sequences_ri = (v_n_hdr + v_regen);
+      return wuffs_base__make_status(NULL);
+    }
+    if ((v_n_hdr + 1) > self->private_impl.f_block_length) {
+      return wuffs_base__make_status(wuffs_zstd__error__bad_literals_section);
+    }
+    v_fill = ((uint64_t)(((uint64_t)(((v_hdr >> (8 * v_n_hdr)) & 255))) * 72340172838076673));
+    self->private_impl.f_literals_ri = 131072;
+    self->private_impl.f_literals_wi = (131072 + v_regen);
+    self->private_impl.f_sequences_ri = (v_n_hdr + 1);
+    {
+      wuffs_base__slice_u8 i_slice_p = wuffs_base__slice_u8__subslice_j(v_literals, ((uint64_t)(v_regen)));
+      v_p.ptr = i_slice_p.ptr;
+      v_p.len = 8;
+      uint8_t* i_end0_p = v_p.ptr + (((i_slice_p.len - (size_t)(v_p.ptr - i_slice_p.ptr)) / 8) * 8);
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_p.ptr < i_end0_p) {
+        wuffs_base__poke_u64le__no_bounds_check(v_p.ptr, v_fill);
+        v_p.ptr += 8;
+      }
+      v_p.len = 1;
+      uint8_t* i_end1_p = i_slice_p.ptr + i_slice_p.len;
+      WUFFS_BASE__ITERATE_LOOP_HINT
+      while (v_p.ptr < i_end1_p) {
+        v_p.ptr[0] = ((uint8_t)((v_fill & 255)));
+        v_p.ptr += 1;
+      }
+      v_p.len = 0;
+    }
+    return wuffs_base__make_status(NULL);
+  }
+  if (v_size_fmt <= 1) {
+    v_n_hdr = 3;
+    v_regen = ((uint32_t)(((v_hdr >> 4) & 1023)));
+    v_c_size = ((uint32_t)(((v_hdr >> 14) & 1023)));
+  } else if (v_size_fmt == 2) {
+    v_n_hdr = 4;
+    v_regen = ((uint32_t)(((v_hdr >> 4) & 16383)));
+    v_c_size = ((uint32_t)(((v_hdr >> 18) & 16383)));
+  } else {
+    v_n_hdr = 5;
+    v_regen = ((uint32_t)(((v_hdr >> 4) & 262143)));
+    v_c_size = ((uint32_t)(((v_hdr >> 22) & 262143)));
+  }
+  if ((v_regen > self->private_impl.f_block_max_size) || ((v_n_hdr + v_c_size) > self->private_impl.f_block_length)) {
+    return wuffs_base__make_status(wuffs_zstd__error__bad_literals_section);
+  }
+  v_c_end = (v_n_hdr + v_c_size);
+  if (((uint64_t)(v_n_hdr)) > ((uint64_t)(v_block.len))) {
+    return wuffs_base__make_status(wuffs_zstd__error__bad_literals_section);
+  }
+  v_src = wuffs_base__slice_u8__subslice_i(v_block, ((uint64_t)(v_n_hdr)));
+  if (((uint64_t)(v_c_size)) > ((uint64_t)(v_src.len))) {
+    return wuffs_base__make_status(wuffs_zstd__error__bad_literals_section);
+  }
+  v_src = wuffs_base__slice_u8__subslice_j(v_src, ((uint64_t)(v_c_size)));
+  if (v_lit_type == 2) {
+    v_status = wuffs_zstd__decoder__read_huffman_table(self, v_src);
+    if ( ! wuffs_base__status__is_ok(&v_status)) {
+      return wuffs_base__status__ensure_not_a_suspension(v_status);
+    }
+    if (((uint64_t)(self->private_impl.f_n_consumed)) > ((uint64_t)(v_src.len))) {
+      return wuffs_base__make_status(wuffs_zstd__error__bad_huffman_table);
+    }
+    v_src = wuffs_base__slice_u8__subslice_i(v_src, ((uint64_t)(self->private_impl.f_n_consumed)));
+  } else if ( ! self->private_impl.f_huff_table_present) {
+    return wuffs_base__make_status(wuffs_zstd__error__bad_literals_section);
+  }
+  if (v_size_fmt == 0) {
+    v_status = wuffs_zstd__decoder__decode_huffman_stream(self, wuffs_base__slice_u8__subslice_j(v_literals, ((uint64_t)(v_regen))), v_src);
+    if ( ! wuffs_base__status__is_ok(&v_status)) {
+      return wuffs_base__status__ensure_not_a_suspension(v_status);
+    }
+  } else {
+    if ((((uint64_t)(v_src.len)) < 10) || (v_regen < 6)) {
+      return wuffs_base__make_status(wuffs_zstd__error__bad_literals_section);
+    }
+    v_s1 = ((uint32_t)(wuffs_base__peek_u16le__no_bounds_check(v_src.ptr)));
+    v_s2 = ((uint32_t)(wuffs_base__peek_u16le__no_bounds_check(v_src.ptr + 2)));
+    v_s3 = ((uint32_t)(wuffs_base__peek_u16le__no_bounds_check(v_src.ptr + 4)));
+    v_src = wuffs_base__slice_u8__subslice_i(v_src, 6);
+    v_n_seg = ((v_regen + 3) >> 2);
+    v_q = wuffs_base__slice_u8__subslice_j(v_literals, ((uint64_t)(v_regen)));
+    if ((((uint64_t)(v_n_seg)) > ((uint64_t)(v_q.len))) || (((uint64_t)(v_s1)) > ((uint64_t)(v_src.len)))) {
+      return wuffs_base__make_status(wuffs_zstd__error__bad_literals_section);
+    }
+    v_status = wuffs_zstd__decoder__decode_huffman_stream(self, wuffs_base__slice_u8__subslice_j(v_q, ((uint64_t)(v_n_seg))), wuffs_base__slice_u8__subslice_j(v_src, ((uint64_t)(v_s1))));
+    if ( ! wuffs_base__status__is_ok(&v_status)) {
+      return wuffs_base__status__ensure_not_a_suspension(v_status);
+    }
+    v_q = wuffs_base__slice_u8__subslice_i(v_q, ((uint64_t)(v_n_seg)));
+    v_src = wuffs_base__slice_u8__subslice_i(v_src, ((uint64_t)(v_s1)));
+    if ((((uint64_t)(v_n_seg)) > ((uint64_t)(v_q.len))) || (((uint64_t)(v_s2)) > ((uint64_t)(v_src.len)))) {
+      return wuffs_base__make_status(wuffs_zstd__error__bad_literals_section);
+    }
+    v_status = wuffs_zstd__decoder__decode_huffman_stream(self, wuffs_base__slice_u8__subslice_j(v_q, ((uint64_t)(v_n_seg))), wuffs_base__slice_u8__subslice_j(v_src, ((uint64_t)(v_s2))));
+    if ( ! wuffs_base__status__is_ok(&v_status)) {
+      return wuffs_base__status__ensure_not_a_suspension(v_status);
+    }
+    v_q = wuffs_base__slice_u8__subslice_i(v_q, ((uint64_t)(v_n_seg)));
+    v_src = wuffs_base__slice_u8__subslice_i(v_src, ((uint64_t)(v_s2)));
+    if ((((uint64_t)(v_n_seg)) > ((uint64_t)(v_q.len))) || (((uint64_t)(v_s3)) > ((uint64_t)(v_src.len)))) {
+      return wuffs_base__make_status(wuffs_zstd__error__bad_literals_section);
+    }
+    v_status = wuffs_zstd__decoder__decode_huffman_stream(self, wuffs_base__slice_u8__subslice_j(v_q, ((uint64_t)(v_n_seg))), wuffs_base__slice_u8__subslice_j(v_src, ((uint64_t)(v_s3))));
+    if ( ! wuffs_base__status__is_ok(&v_status)) {
+      return wuffs_base__status__ensure_not_a_suspension(v_status);
+    }
+    v_q = wuffs_base__slice_u8__subslice_i(v_q, ((uint64_t)(v_n_seg)));
+    v_src = wuffs_base__slice_u8__subslice_i(v_src, ((uint64_t)(v_s3)));
+    v_status = wuffs_zstd__decoder__decode_huffman_stream(self, v_q, v_src);
+    if ( ! wuffs_base__status__is_ok(&v_status)) {
+      return wuffs_base__status__ensure_not_a_suspension(v_status);
+    }
+  }
+  self->private_impl.f_literals_ri = 131072;
+  self->private_impl.f_literals_wi = (131072 + v_regen);
+  self->private_impl.f_sequences_ri = v_c_end;
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func zstd.decoder.read_huffman_table
+
+static wuffs_base__status
+wuffs_zstd__decoder__read_huffman_table(
+    wuffs_zstd__decoder* self,
+    wuffs_base__slice_u8 a_s) {
+  uint32_t v_header = 0;
+  uint32_t v_n_weights = 0;
+  uint32_t v_i = 0;
+  uint8_t v_c = 0;
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  uint32_t v_total = 0;
+  uint32_t v_max_bits = 0;
+  uint32_t v_rest = 0;
+  uint32_t v_w = 0;
+  uint32_t v_lw = 0;
+  uint32_t v_sym = 0;
+  uint32_t v_n = 0;
+  uint32_t v_pos = 0;
+  uint16_t v_entry = 0;
+
+  self->private_impl.f_huff_table_present = false;
+  if (((uint64_t)(a_s.len)) < 1) {
+    return wuffs_base__make_status(wuffs_zstd__error__bad_huffman_table);
+  }
+  v_header = ((uint32_t)(a_s.ptr[0]));
+  if (v_header >= 128) {
+    v_n_weights = (v_header - 127);
+    if (((uint64_t)((1 + ((v_n_weights + 1) >> 1)))) > ((uint64_t)(a_s.len))) {
+      return wuffs_base__make_status(wuffs_zstd__error__bad_huffman_table);
+    }
+    v_i = 0;
+    while (v_i < v_n_weights) {
+      if (((uint64_t)((1 + (v_i >> 1)))) >= ((uint64_t)(a_s.len))) {
+        return wuffs_base__make_status(wuffs_zstd__error__bad_huffman_table);
+      }
+      v_c = a_s.ptr[((uint64_t)((1 + (v_i >> 1))))];
+      if ((v_i & 1) == 0) {
+        self->private_data.f_huff_weights[v_i] = (v_c >> 4);
+      } else {
+        self->private_data.f_huff_weights[v_i] = (v_c & 15);
+      }
+      v_i += 1;
+    }
+    self->private_impl.f_n_consumed = (1 + ((v_n_weights + 1) >> 1));
+  } else {
+    if (((uint64_t)((1 + v_header))) > ((uint64_t)(a_s.len))) {
+      return wuffs_base__make_status(wuffs_zstd__error__bad_huffman_table);
+    }
+    v_status = wuffs_zstd__decoder__decode_huffman_weights(self, wuffs_base__slice_u8__subslice_ij(a_s, 1, ((uint64_t)((1 + v_header)))));
+    if ( ! wuffs_base__status__is_ok(&v_status)) {
+      return wuffs_base__status__ensure_not_a_suspension(v_status);
+    }
+    v_n_weights = self->private_impl.f_huff_n_weights;
+    self->private_impl.f_n_consumed = (1 + v_header);
+  }
+  v_total = 0;
+  v_i = 0;
+  while (v_i < v_n_weights) {
+    v_w = ((uint32_t)(self->private_data.f_huff_weights[v_i]));
+    if (v_w > 11) {
+      return wuffs_base__make_status(wuffs_zstd__error__bad_huffman_table);
+    } else if (v_w > 0) {
+      v_total += (((uint32_t)(1)) << (v_w - 1));
+    }
+    v_i += 1;
+  }
+  if (v_total == 0) {
+    return wuffs_base__make_status(wuffs_zstd__error__bad_huffman_table);
+  }
+  v_max_bits = 0;
+  while ((v_total >> v_max_bits) > 0) {
+    if (v_max_bits >= 12) {
+      return wuffs_base__make_status(wuffs_zstd__error__bad_huffman_table);
+    }
+    v_max_bits += 1;
+  }
+  if (v_max_bits > 11) {
+    return wuffs_base__make_status(wuffs_zstd__error__bad_huffman_table);
+  }
+  v_rest = ((uint32_t)((((uint32_t)(1)) << v_max_bits) - v_total));
+  v_lw = 0;
+  while ((((uint32_t)(1)) << v_lw) < v_rest) {
+    if (v_lw >= 11) {
+      return wuffs_base__make_status(wuffs_zstd__error__bad_huffman_table);
+    }
+    v_lw += 1;
+  }
+  if ((((uint32_t)(1)) << v_lw) != v_rest) {
+    return wuffs_base__make_status(wuffs_zstd__error__bad_huffman_table);
+  }
+  self->private_data.f_huff_weights[v_n_weights] = ((uint8_t)(((v_lw + 1) & 15)));
+  v_pos = 0;
+  v_w = 1;
+  while (v_w <= v_max_bits) {
+    v_entry = ((uint16_t)(((((uint32_t)((v_max_bits + 1) - v_w)) & 255) << 8)));
+    v_sym = 0;
+    while (v_sym <= v_n_weights) {
+      if (((uint32_t)(self->private_data.f_huff_weights[v_sym])) == v_w) {
+        v_n = (((uint32_t)(1)) << (((uint32_t)(v_w - 1)) & 15));
+        while (v_n > 0) {
+          if (v_pos >= 2048) {
+            return wuffs_base__make_status(wuffs_zstd__error__bad_huffman_table);
+          }
+          self->private_data.f_huff_table[v_pos] = (v_entry | ((uint16_t)((v_sym & 255))));
+          v_pos += 1;
+          v_n -= 1;
+        }
+      }
+      v_sym += 1;
+    }
+    v_w += 1;
+  }
+  self->private_impl.f_huff_table_bits = v_max_bits;
+  self->private_impl.f_huff_table_present = true;
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func zstd.decoder.decode_huffman_weights
+
+static wuffs_base__status
+wuffs_zstd__decoder__decode_huffman_weights(
+    wuffs_zstd__decoder* self,
+    wuffs_base__slice_u8 a_s) {
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  uint64_t v_bits = 0;
+  uint32_t v_n_bits = 0;
+  uint64_t v_ri = 0;
+  wuffs_base__slice_u8 v_x = {0};
+  uint32_t v_n = 0;
+  uint32_t v_table_log = 0;
+  uint32_t v_state1 = 0;
+  uint32_t v_state2 = 0;
+  uint32_t v_e = 0;
+  uint32_t v_nb = 0;
+  uint32_t v_n_weights = 0;
+  bool v_use_state1 = false;
+
+  v_status = wuffs_zstd__decoder__read_fse_counts(self, a_s, 15, 6);
+  if ( ! wuffs_base__status__is_ok(&v_status)) {
+    return wuffs_base__make_status(wuffs_zstd__error__bad_huffman_table);
+  }
+  v_status = wuffs_zstd__decoder__build_fse_table(self);
+  if ( ! wuffs_base__status__is_ok(&v_status)) {
+    return wuffs_base__make_status(wuffs_zstd__error__bad_huffman_table);
+  }
+  v_table_log = self->private_impl.f_fse_table_log;
+  if (((uint64_t)(self->private_impl.f_n_consumed)) > ((uint64_t)(a_s.len))) {
+    return wuffs_base__make_status(wuffs_zstd__error__bad_huffman_table);
+  }
+  a_s = wuffs_base__slice_u8__subslice_i(a_s, ((uint64_t)(self->private_impl.f_n_consumed)));
+  v_ri = ((uint64_t)(a_s.len));
+  if (v_ri < 1) {
+    return wuffs_base__make_status(wuffs_zstd__error__bad_huffman_table);
+  }
+  while ((v_n_bits <= 56) && (v_ri > 0) && (v_ri <= ((uint64_t)(a_s.len)))) {
+    v_x = wuffs_base__slice_u8__suffix(wuffs_base__slice_u8__subslice_j(a_s, v_ri), 1);
+    if (((uint64_t)(v_x.len)) >= 1) {
+      v_bits |= (((uint64_t)(v_x.ptr[0])) << (56 - v_n_bits));
+    }
+    v_ri -= 1;
+    v_n_bits += 8;
+  }
+  if ((v_bits >> 56) == 0) {
+    return wuffs_base__make_status(wuffs_zstd__error__bad_huffman_table);
+  }
+  while ((v_bits >> 63) == 0) {
+    v_bits <<= 1;
+    v_n_bits -= 1;
+  }
+  v_bits <<= 1;
+  v_n_bits -= 1;
+  v_state1 = ((uint32_t)(((v_bits >> 1) >> (63 - v_table_log))));
+  v_bits <<= v_table_log;
+  v_n_bits -= v_table_log;
+  v_state2 = ((uint32_t)(((v_bits >> 1) >> (63 - v_table_log))));
+  v_bits <<= v_table_log;
+  v_n_bits -= v_table_log;
+  v_use_state1 = true;
+  while (true) {
+    if (v_n_bits > 64) {
+      return wuffs_base__make_status(wuffs_zstd__error__bad_huffman_table);
+    }
+    while ((v_n_bits <= 56) && (v_ri > 0) && (v_ri <= ((uint64_t)(a_s.len)))) {
+      v_x = wuffs_base__slice_u8__suffix(wuffs_base__slice_u8__subslice_j(a_s, v_ri), 1);
+      if (((uint64_t)(v_x.len)) >= 1) {
+        v_bits |= (((uint64_t)(v_x.ptr[0])) << (56 - v_n_bits));
+      }
+      v_ri -= 1;
+      v_n_bits += 8;
+    }
+    if (v_n_weights >= 255) {
+      return wuffs_base__make_status(wuffs_zstd__error__bad_huffman_table);
+    }
+    if (v_use_state1) {
+      v_e = self->private_data.f_fse_entries[(v_state1 & 511)];
+    } else {
+      v_e = self->private_data.f_fse_entries[(v_state2 & 511)];
+    }
+    self->private_data.f_huff_weights[v_n_weights] = ((uint8_t)((v_e & 255)));
+    v_n_weights += 1;
+    v_nb = ((v_e >> 8) & 255);
+    if (v_nb > 9) {
+      return wuffs_base__make_status(wuffs_zstd__error__bad_huffman_table);
+    }
+    v_n = ((uint32_t)(((v_bits >> 1) >> (63 - v_nb))));
+    if (v_use_state1) {
+      v_state1 = ((uint32_t)((v_e >> 16) + v_n));
+    } else {
+      v_state2 = ((uint32_t)((v_e >> 16) + v_n));
+    }
+    v_bits <<= v_nb;
+    if ((v_ri == 0) && (v_nb > v_n_bits)) {
+      if (v_n_weights >= 255) {
+        return wuffs_base__make_status(wuffs_zstd__error__bad_huffman_table);
+      }
+      if (v_use_state1) {
+        v_e = self->private_data.f_fse_entries[(v_state2 & 511)];
+      } else {
+        v_e = self->private_data.f_fse_entries[(v_state1 & 511)];
+      }
+      self->private_data.f_huff_weights[v_n_weights] = ((uint8_t)((v_e & 255)));
+      v_n_weights += 1;
+      goto label__0__break;
+    }
+    v_n_bits -= v_nb;
+    v_use_state1 =  ! v_use_state1;
+  }
+  label__0__break:;
+  self->private_impl.f_huff_n_weights = v_n_weights;
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func zstd.decoder.decode_huffman_stream
+
+static wuffs_base__status
+wuffs_zstd__decoder__decode_huffman_stream(
+    wuffs_zstd__decoder* self,
+    wuffs_base__slice_u8 a_dst,
+    wuffs_base__slice_u8 a_src) {
+  uint64_t v_bits = 0;
+  uint32_t v_n_bits = 0;
+  uint64_t v_ri = 0;
+  wuffs_base__slice_u8 v_x = {0};
+  uint32_t v_n = 0;
+  uint32_t v_table_bits = 0;
+  uint16_t v_e = 0;
+  wuffs_base__slice_u8 v_p = {0};
+
+  v_table_bits = self->private_impl.f_huff_table_bits;
+  if (v_table_bits < 1) {
+    return wuffs_base__make_status(wuffs_zstd__error__bad_huffman_table);
+  }
+  v_ri = ((uint64_t)(a_src.len));
+  if (v_ri < 1) {
+    return wuffs_base__make_status(wuffs_zstd__error__bad_literals_section);
+  }
+  while ((v_n_bits <= 56) && (v_ri > 0) && (v_ri <= ((uint64_t)(a_src.len)))) {
+    v_x = wuffs_base__slice_u8__suffix(wuffs_base__slice_u8__subslice_j(a_src, v_ri), 1);
+    if (((uint64_t)(v_x.len)) >= 1) {
+      v_bits |= (((uint64_t)(v_x.ptr[0])) << (56 - v_n_bits));
+    }
+    v_ri -= 1;
+    v_n_bits += 8;
+  }
+  if ((v_bits >> 56) == 0) {
+    return wuffs_base__make_status(wuffs_zstd__error__bad_literals_section);
+  }
+  while ((v_bits >> 63) == 0) {
+    v_bits <<= 1;
+    v_n_bits -= 1;
+  }
+  v_bits <<= 1;
+  v_n_bits -= 1;
+  {
+    wuffs_base__slice_u8 i_slice_p = a_dst;
+    v_p.ptr = i_slice_p.ptr;
+    v_p.len = 4;
+    uint8_t* i_end0_p = v_p.ptr + (((i_slice_p.len - (size_t)(v_p.ptr - i_slice_p.ptr)) / 4) * 4);
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_p.ptr < i_end0_p) {
+      if ((v_n_bits <= 56) && (v_ri <= ((uint64_t)(a_src.len)))) {
+        v_x = wuffs_base__slice_u8__suffix(wuffs_base__slice_u8__subslice_j(a_src, v_ri), 8);
+        if ((((uint64_t)(v_x.len)) >= 8) && (v_ri >= 8)) {
+          v_bits |= (wuffs_base__peek_u64le__no_bounds_check(v_x.ptr) >> v_n_bits);
+          v_n = ((63 - v_n_bits) >> 3);
+          v_ri -= ((uint64_t)(v_n));
+          v_n_bits += (v_n << 3);
+        } else {
+          while ((v_n_bits <= 56) && (v_ri > 0) && (v_ri <= ((uint64_t)(a_src.len)))) {
+            v_x = wuffs_base__slice_u8__suffix(wuffs_base__slice_u8__subslice_j(a_src, v_ri), 1);
+            if (((uint64_t)(v_x.len)) >= 1) {
+              v_bits |= (((uint64_t)(v_x.ptr[0])) << (56 - v_n_bits));
+            }
+            v_ri -= 1;
+            v_n_bits += 8;
+          }
+        }
+      }
+      v_e = self->private_data.f_huff_table[(((v_bits >> 1) >> (63 - v_table_bits)) & 2047)];
+      v_p.ptr[0] = ((uint8_t)((v_e & 255)));
+      v_bits <<= ((v_e >> 8) & 15);
+      v_n_bits -= ((uint32_t)(((v_e >> 8) & 15)));
+      v_e = self->private_data.f_huff_table[(((v_bits >> 1) >> (63 - v_table_bits)) & 2047)];
+      v_p.ptr[1] = ((uint8_t)((v_e & 255)));
+      v_bits <<= ((v_e >> 8) & 15);
+      v_n_bits -= ((uint32_t)(((v_e >> 8) & 15)));
+      v_e = self->private_data.f_huff_table[(((v_bits >> 1) >> (63 - v_table_bits)) & 2047)];
+      v_p.ptr[2] = ((uint8_t)((v_e & 255)));
+      v_bits <<= ((v_e >> 8) & 15);
+      v_n_bits -= ((uint32_t)(((v_e >> 8) & 15)));
+      v_e = self->private_data.f_huff_table[(((v_bits >> 1) >> (63 - v_table_bits)) & 2047)];
+      v_p.ptr[3] = ((uint8_t)((v_e & 255)));
+      v_bits <<= ((v_e >> 8) & 15);
+      v_n_bits -= ((uint32_t)(((v_e >> 8) & 15)));
+      v_p.ptr += 4;
+    }
+    v_p.len = 1;
+    uint8_t* i_end1_p = i_slice_p.ptr + i_slice_p.len;
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_p.ptr < i_end1_p) {
+      while ((v_n_bits <= 56) && (v_ri > 0) && (v_ri <= ((uint64_t)(a_src.len)))) {
+        v_x = wuffs_base__slice_u8__suffix(wuffs_base__slice_u8__subslice_j(a_src, v_ri), 1);
+        if (((uint64_t)(v_x.len)) >= 1) {
+          v_bits |= (((uint64_t)(v_x.ptr[0])) << (56 - v_n_bits));
+        }
+        v_ri -= 1;
+        v_n_bits += 8;
+      }
+      v_e = self->private_data.f_huff_table[(((v_bits >> 1) >> (63 - v_table_bits)) & 2047)];
+      v_p.ptr[0] = ((uint8_t)((v_e & 255)));
+      v_bits <<= ((v_e >> 8) & 15);
+      v_n_bits -= ((uint32_t)(((v_e >> 8) & 15)));
+      v_p.ptr += 1;
+    }
+    v_p.len = 0;
+  }
+  if ((v_n_bits != 0) || (v_ri != 0)) {
+    return wuffs_base__make_status(wuffs_zstd__error__bad_literals_section);
+  }
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func zstd.decoder.decode_sequences_header
+
+static wuffs_base__status
+wuffs_zstd__decoder__decode_sequences_header(
+    wuffs_zstd__decoder* self,
+    wuffs_base__slice_u8 a_workbuf) {
+  wuffs_base__slice_u8 v_s = {0};
+  uint32_t v_n_hdr = 0;
+  uint32_t v_b0 = 0;
+  uint32_t v_modes = 0;
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+
+  if (((uint64_t)(self->private_impl.f_block_length)) > ((uint64_t)(a_workbuf.len))) {
+    return wuffs_base__make_status(wuffs_zstd__error__internal_error_inconsistent_workbuf_length);
+  }
+  v_s = wuffs_base__slice_u8__subslice_j(a_workbuf, ((uint64_t)(self->private_impl.f_block_length)));
+  if (((uint64_t)(self->private_impl.f_sequences_ri)) > ((uint64_t)(v_s.len))) {
+    return wuffs_base__make_status(wuffs_zstd__error__internal_error_inconsistent_workbuf_length);
+  }
+  v_s = wuffs_base__slice_u8__subslice_i(v_s, ((uint64_t)(self->private_impl.f_sequences_ri)));
+  if (((uint64_t)(v_s.len)) < 1) {
+    return wuffs_base__make_status(wuffs_zstd__error__bad_sequences_section);
+  }
+  v_b0 = ((uint32_t)(v_s.ptr[0]));
+  if (v_b0 == 0) {
+    if (((uint64_t)(v_s.len)) != 1) {
+      return wuffs_base__make_status(wuffs_zstd__error__bad_sequences_section);
+    }
+    self->private_impl.f_n_sequences = 0;
+    self->private_impl.f_sequences_ri = self->private_impl.f_block_length;
+    return wuffs_base__make_status(NULL);
+  } else if (v_b0 < 128) {
+    self->private_impl.f_n_sequences = v_b0;
+    v_n_hdr = 1;
+  } else if (v_b0 < 255) {
+    if (((uint64_t)(v_s.len)) < 2) {
+      return wuffs_base__make_status(wuffs_zstd__error__bad_sequences_section);
+    }
+    self->private_impl.f_n_sequences = (((v_b0 - 128) << 8) | ((uint32_t)(v_s.ptr[1])));
+    v_n_hdr = 2;
+  } else {
+    if (((uint64_t)(v_s.len)) < 3) {
+      return wuffs_base__make_status(wuffs_zstd__error__bad_sequences_section);
+    }
+    self->private_impl.f_n_sequences = (32512 + ((uint32_t)(wuffs_base__peek_u16le__no_bounds_check(v_s.ptr + 1))));
+    v_n_hdr = 3;
+  }
+  if (((uint64_t)(v_n_hdr)) > ((uint64_t)(v_s.len))) {
+    return wuffs_base__make_status(wuffs_zstd__error__bad_sequences_section);
+  }
+  v_s = wuffs_base__slice_u8__subslice_i(v_s, ((uint64_t)(v_n_hdr)));
+  if (((uint64_t)(v_s.len)) < 1) {
+    return wuffs_base__make_status(wuffs_zstd__error__bad_sequences_section);
+  }
+  v_modes = ((uint32_t)(v_s.ptr[0]));
+  if ((v_modes & 3) != 0) {
+    return wuffs_base__make_status(wuffs_zstd__error__bad_sequences_section);
+  }
+  v_s = wuffs_base__slice_u8__subslice_i(v_s, 1);
+  wuffs_base__u32__sat_add_indirect(&self->private_impl.f_sequences_ri, (v_n_hdr + 1));
+  v_status = wuffs_zstd__decoder__make_sequence_table(self, 0, (v_modes >> 6), v_s);
+  if ( ! wuffs_base__status__is_ok(&v_status)) {
+    return wuffs_base__status__ensure_not_a_suspension(v_status);
+  }
+  if (((uint64_t)(self->private_impl.f_n_consumed)) > ((uint64_t)(v_s.len))) {
+    return wuffs_base__make_status(wuffs_zstd__error__bad_sequences_section);
+  }
+  v_s = wuffs_base__slice_u8__subslice_i(v_s, ((uint64_t)(self->private_impl.f_n_consumed)));
+  wuffs_base__u32__sat_add_indirect(&self->private_impl.f_sequences_ri, self->private_impl.f_n_consumed);
+  v_status = wuffs_zstd__decoder__make_sequence_table(self, 1, ((v_modes >> 4) & 3), v_s);
+  if ( ! wuffs_base__status__is_ok(&v_status)) {
+    return wuffs_base__status__ensure_not_a_suspension(v_status);
+  }
+  if (((uint64_t)(self->private_impl.f_n_consumed)) > ((uint64_t)(v_s.len))) {
+    return wuffs_base__make_status(wuffs_zstd__error__bad_sequences_section);
+  }
+  v_s = wuffs_base__slice_u8__subslice_i(v_s, ((uint64_t)(self->private_impl.f_n_consumed)));
+  wuffs_base__u32__sat_add_indirect(&self->private_impl.f_sequences_ri, self->private_impl.f_n_consumed);
+  v_status = wuffs_zstd__decoder__make_sequence_table(self, 2, ((v_modes >> 2) & 3), v_s);
+  if ( ! wuffs_base__status__is_ok(&v_status)) {
+    return wuffs_base__status__ensure_not_a_suspension(v_status);
+  }
+  if (((uint64_t)(self->private_impl.f_n_consumed)) > ((uint64_t)(v_s.len))) {
+    return wuffs_base__make_status(wuffs_zstd__error__bad_sequences_section);
+  }
+  wuffs_base__u32__sat_add_indirect(&self->private_impl.f_sequences_ri, self->private_impl.f_n_consumed);
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func zstd.decoder.make_sequence_table
+
+static wuffs_base__status
+wuffs_zstd__decoder__make_sequence_table(
+    wuffs_zstd__decoder* self,
+    uint32_t a_kind,
+    uint32_t a_mode,
+    wuffs_base__slice_u8 a_s) {
+  uint32_t v_max_symbol = 0;
+  uint32_t v_max_table_log = 0;
+  uint32_t v_i = 0;
+  uint32_t v_table_size = 0;
+  uint32_t v_e = 0;
+  uint32_t v_sym = 0;
+  uint64_t v_b = 0;
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+
+  self->private_impl.f_n_consumed = 0;
+  if (a_kind == 0) {
+    v_max_symbol = 35;
+    v_max_table_log = 9;
+  } else if (a_kind == 1) {
+    v_max_symbol = 31;
+    v_max_table_log = 8;
+  } else {
+    v_max_symbol = 52;
+    v_max_table_log = 9;
+  }
+  if (a_mode == 0) {
+    if (a_kind == 0) {
+      while (v_i < 36) {
+        self->private_data.f_fse_counts[v_i] = WUFFS_ZSTD__PREDEFINED_LITERALS_LENGTH_COUNTS[v_i];
+        v_i += 1;
+      }
+      self->private_impl.f_fse_n_symbols = 36;
+      self->private_impl.f_fse_table_log = 6;
+    } else if (a_kind == 1) {
+      while (v_i < 29) {
+        self->private_data.f_fse_counts[v_i] = WUFFS_ZSTD__PREDEFINED_OFFSET_COUNTS[v_i];
+        v_i += 1;
+      }
+      self->private_impl.f_fse_n_symbols = 29;
+      self->private_impl.f_fse_table_log = 5;
+    } else {
+      while (v_i < 53) {
+        self->private_data.f_fse_counts[v_i] = WUFFS_ZSTD__PREDEFINED_MATCH_LENGTH_COUNTS[v_i];
+        v_i += 1;
+      }
+      self->private_impl.f_fse_n_symbols = 53;
+      self->private_impl.f_fse_table_log = 6;
+    }
+    v_status = wuffs_zstd__decoder__build_fse_table(self);
+    if ( ! wuffs_base__status__is_ok(&v_status)) {
+      return wuffs_base__status__ensure_not_a_suspension(v_status);
+    }
+  } else if (a_mode == 1) {
+    if (((uint64_t)(a_s.len)) < 1) {
+      return wuffs_base__make_status(wuffs_zstd__error__bad_sequences_section);
+    }
+    v_sym = ((uint32_t)(a_s.ptr[0]));
+    if (v_sym > v_max_symbol) {
+      return wuffs_base__make_status(wuffs_zstd__error__bad_sequences_section);
+    }
+    self->private_impl.f_n_consumed = 1;
+    self->private_data.f_fse_entries[0] = v_sym;
+    self->private_impl.f_fse_table_log = 0;
+  } else if (a_mode == 2) {
+    v_status = wuffs_zstd__decoder__read_fse_counts(self, a_s, v_max_symbol, v_max_table_log);
+    if ( ! wuffs_base__status__is_ok(&v_status)) {
+      return wuffs_base__status__ensure_not_a_suspension(v_status);
+    }
+    v_status = wuffs_zstd__decoder__build_fse_table(self);
+    if ( ! wuffs_base__status__is_ok(&v_status)) {
+      return wuffs_base__status__ensure_not_a_suspension(v_status);
+    }
+  } else {
+    if (a_kind == 0) {
+      if ( ! self->private_impl.f_ll_table_present) {
+        return wuffs_base__make_status(wuffs_zstd__error__bad_sequences_section);
+      }
+    } else if (a_kind == 1) {
+      if ( ! self->private_impl.f_of_table_present) {
+        return wuffs_base__make_status(wuffs_zstd__error__bad_sequences_section);
+      }
+    } else {
+      if ( ! self->private_impl.f_ml_table_present) {
+        return wuffs_base__make_status(wuffs_zstd__error__bad_sequences_section);
+      }
+    }
+    return wuffs_base__make_status(NULL);
+  }
+  v_table_size = (((uint32_t)(1)) << self->private_impl.f_fse_table_log);
+  v_i = 0;
+  while (v_i < v_table_size) {
+    v_e = self->private_data.f_fse_entries[v_i];
+    v_sym = (v_e & 255);
+    v_b = ((uint64_t)((((v_e >> 8) & 255) | (v_e & 4294901760))));
+    if (a_kind == 0) {
+      if (v_sym >= 36) {
+        return wuffs_base__make_status(wuffs_zstd__error__bad_sequences_section);
+      }
+      self->private_data.f_ll_table[v_i] = (v_b | (((uint64_t)(WUFFS_ZSTD__LITERALS_LENGTH_EXTRA_BITS[v_sym])) << 8) | (((uint64_t)(WUFFS_ZSTD__LITERALS_LENGTH_BASES[v_sym])) << 32));
+    } else if (a_kind == 1) {
+      if (v_sym >= 32) {
+        return wuffs_base__make_status(wuffs_zstd__error__bad_sequences_section);
+      }
+      self->private_data.f_of_table[(v_i & 255)] = (v_b | (((uint64_t)(v_sym)) << 8) | ((((uint64_t)(1)) << v_sym) << 32));
+    } else {
+      if (v_sym >= 53) {
+        return wuffs_base__make_status(wuffs_zstd__error__bad_sequences_section);
+      }
+      self->private_data.f_ml_table[v_i] = (v_b | (((uint64_t)(WUFFS_ZSTD__MATCH_LENGTH_EXTRA_BITS[v_sym])) << 8) | (((uint64_t)(WUFFS_ZSTD__MATCH_LENGTH_BASES[v_sym])) << 32));
+    }
+    v_i += 1;
+  }
+  if (a_kind == 0) {
+    self->private_impl.f_ll_table_log = self->private_impl.f_fse_table_log;
+    self->private_impl.f_ll_table_present = true;
+  } else if (a_kind == 1) {
+    self->private_impl.f_of_table_log = self->private_impl.f_fse_table_log;
+    self->private_impl.f_of_table_present = true;
+  } else {
+    self->private_impl.f_ml_table_log = self->private_impl.f_fse_table_log;
+    self->private_impl.f_ml_table_present = true;
+  }
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func zstd.decoder.decode_sequences
+
+static wuffs_base__status
+wuffs_zstd__decoder__decode_sequences(
+    wuffs_zstd__decoder* self,
+    wuffs_base__slice_u8 a_workbuf) {
+  wuffs_base__slice_u8 v_src = {0};
+  wuffs_base__slice_u8 v_dst = {0};
+  uint64_t v_bits = 0;
+  uint32_t v_n_bits = 0;
+  uint64_t v_ri = 0;
+  wuffs_base__slice_u8 v_x = {0};
+  uint32_t v_n = 0;
+  uint32_t v_ll_state = 0;
+  uint32_t v_of_state = 0;
+  uint32_t v_ml_state = 0;
+  uint64_t v_lle = 0;
+  uint64_t v_ofe = 0;
+  uint64_t v_mle = 0;
+  uint32_t v_nb = 0;
+  uint32_t v_of_value = 0;
+  uint32_t v_ll = 0;
+  uint32_t v_ml = 0;
+  uint32_t v_offset = 0;
+  uint32_t v_rep0 = 0;
+  uint32_t v_rep1 = 0;
+  uint32_t v_rep2 = 0;
+  uint32_t v_i = 0;
+  uint32_t v_lit_remaining = 0;
+  uint32_t v_block_decoded = 0;
+  uint64_t v_pos = 0;
+
+  if ((((uint64_t)(a_workbuf.len)) < 1048576) || (((uint64_t)(self->private_impl.f_block_length)) > ((uint64_t)(a_workbuf.len))) || (self->private_impl.f_literals_ri > self->private_impl.f_literals_wi)) {
+    return wuffs_base__make_status(wuffs_zstd__error__internal_error_inconsistent_workbuf_length);
+  }
+  v_lit_remaining = (self->private_impl.f_literals_wi - self->private_impl.f_literals_ri);
+  if (self->private_impl.f_n_sequences == 0) {
+    if (v_lit_remaining > self->private_impl.f_block_max_size) {
+      return wuffs_base__make_status(wuffs_zstd__error__bad_block);
+    }
+    return wuffs_base__make_status(NULL);
+  }
+  v_dst = wuffs_base__slice_u8__subslice_ij(a_workbuf, 262144, 1048576);
+  v_src = wuffs_base__slice_u8__subslice_j(a_workbuf, ((uint64_t)(self->private_impl.f_block_length)));
+  if (((uint64_t)(self->private_impl.f_sequences_ri)) > ((uint64_t)(v_src.len))) {
+    return wuffs_base__make_status(wuffs_zstd__error__internal_error_inconsistent_workbuf_length);
+  }
+  v_src = wuffs_base__slice_u8__subslice_i(v_src, ((uint64_t)(self->private_impl.f_sequences_ri)));
+  v_ri = ((uint64_t)(v_src.len));
+  if (v_ri < 1) {
+    return wuffs_base__make_status(wuffs_zstd__error__bad_sequences_section);
+  }
+  while ((v_n_bits <= 56) && (v_ri > 0) && (v_ri <= ((uint64_t)(v_src.len)))) {
+    v_x = wuffs_base__slice_u8__suffix(wuffs_base__slice_u8__subslice_j(v_src, v_ri), 1);
+    if (((uint64_t)(v_x.len)) >= 1) {
+      v_bits |= (((uint64_t)(v_x.ptr[0])) << (56 - v_n_bits));
+    }
+    v_ri -= 1;
+    v_n_bits += 8;
+  }
+  if ((v_bits >> 56) == 0) {
+    return wuffs_base__make_status(wuffs_zstd__error__bad_sequences_section);
+  }
+  while ((v_bits >> 63) == 0) {
+    v_bits <<= 1;
+    v_n_bits -= 1;
+  }
+  v_bits <<= 1;
+  v_n_bits -= 1;
+  v_nb = self->private_impl.f_ll_table_log;
+  v_ll_state = ((uint32_t)((((v_bits >> 1) >> (63 - v_nb)) & 4294967295)));
+  v_bits <<= v_nb;
+  v_n_bits -= v_nb;
+  v_nb = self->private_impl.f_of_table_log;
+  v_of_state = ((uint32_t)((((v_bits >> 1) >> (63 - v_nb)) & 4294967295)));
+  v_bits <<= v_nb;
+  v_n_bits -= v_nb;
+  v_nb = self->private_impl.f_ml_table_log;
+  v_ml_state = ((uint32_t)((((v_bits >> 1) >> (63 - v_nb)) & 4294967295)));
+  v_bits <<= v_nb;
+  v_n_bits -= v_nb;
+  v_rep0 = self->private_impl.f_rep0;
+  v_rep1 = self->private_impl.f_rep1;
+  v_rep2 = self->private_impl.f_rep2;
+  v_i = 0;
+  while (v_i < self->private_impl.f_n_sequences) {
+    v_lle = self->private_data.f_ll_table[(v_ll_state & 511)];
+    v_ofe = self->private_data.f_of_table[(v_of_state & 255)];
+    v_mle = self->private_data.f_ml_table[(v_ml_state & 511)];
+    if ((v_n_bits <= 56) && (v_ri <= ((uint64_t)(v_src.len)))) {
+      v_x = wuffs_base__slice_u8__suffix(wuffs_base__slice_u8__subslice_j(v_src, v_ri), 8);
+      if ((((uint64_t)(v_x.len)) >= 8) && (v_ri >= 8)) {
+        v_bits |= (wuffs_base__peek_u64le__no_bounds_check(v_x.ptr) >> v_n_bits);
+        v_n = ((63 - v_n_bits) >> 3);
+        v_ri -= ((uint64_t)(v_n));
+        v_n_bits += (v_n << 3);
+      } else {
+        while ((v_n_bits <= 56) && (v_ri > 0) && (v_ri <= ((uint64_t)(v_src.len)))) {
+          v_x = wuffs_base__slice_u8__suffix(wuffs_base__slice_u8__subslice_j(v_src, v_ri), 1);
+          if (((uint64_t)(v_x.len)) >= 1) {
+            v_bits |= (((uint64_t)(v_x.ptr[0])) << (56 - v_n_bits));
+          }
+          v_ri -= 1;
+          v_n_bits += 8;
+        }
+      }
+    }
+    v_nb = ((uint32_t)(((v_ofe >> 8) & 31)));
+    v_of_value = ((uint32_t)(((v_ofe >> 32) & 4294967295)));
+    v_of_value += ((uint32_t)((((v_bits >> 1) >> (63 - v_nb)) & 4294967295)));
+    v_bits <<= v_nb;
+    v_n_bits -= v_nb;
+    v_nb = ((uint32_t)(((v_mle >> 8) & 31)));
+    v_ml = ((uint32_t)(((v_mle >> 32) & 4294967295)));
+    v_ml += ((uint32_t)((((v_bits >> 1) >> (63 - v_nb)) & 4294967295)));
+    v_bits <<= v_nb;
+    v_n_bits -= v_nb;
+    if ((v_n_bits <= 56) && (v_ri <= ((uint64_t)(v_src.len)))) {
+      v_x = wuffs_base__slice_u8__suffix(wuffs_base__slice_u8__subslice_j(v_src, v_ri), 8);
+      if ((((uint64_t)(v_x.len)) >= 8) && (v_ri >= 8)) {
+        v_bits |= (wuffs_base__peek_u64le__no_bounds_check(v_x.ptr) >> v_n_bits);
+        v_n = ((63 - v_n_bits) >> 3);
+        v_ri -= ((uint64_t)(v_n));
+        v_n_bits += (v_n << 3);
+      } else {
+        while ((v_n_bits <= 56) && (v_ri > 0) && (v_ri <= ((uint64_t)(v_src.len)))) {
+          v_x = wuffs_base__slice_u8__suffix(wuffs_base__slice_u8__subslice_j(v_src, v_ri), 1);
+          if (((uint64_t)(v_x.len)) >= 1) {
+            v_bits |= (((uint64_t)(v_x.ptr[0])) << (56 - v_n_bits));
+          }
+          v_ri -= 1;
+          v_n_bits += 8;
+        }
+      }
+    }
+    v_nb = ((uint32_t)(((v_lle >> 8) & 31)));
+    v_ll = ((uint32_t)(((v_lle >> 32) & 4294967295)));
+    v_ll += ((uint32_t)((((v_bits >> 1) >> (63 - v_nb)) & 4294967295)));
+    v_bits <<= v_nb;
+    v_n_bits -= v_nb;
+    v_i += 1;
+    if (v_i < self->private_impl.f_n_sequences) {
+      v_nb = ((uint32_t)((v_lle & 15)));
+      v_ll_state = ((uint32_t)(((uint32_t)(((v_lle >> 16) & 65535))) + ((uint32_t)((((v_bits >> 1) >> (63 - v_nb)) & 65535)))));
+      v_bits <<= v_nb;
+      v_n_bits -= v_nb;
+      v_nb = ((uint32_t)((v_mle & 15)));
+      v_ml_state = ((uint32_t)(((uint32_t)(((v_mle >> 16) & 65535))) + ((uint32_t)((((v_bits >> 1) >> (63 - v_nb)) & 65535)))));
+      v_bits <<= v_nb;
+      v_n_bits -= v_nb;
+      v_nb = ((uint32_t)((v_ofe & 15)));
+      v_of_state = ((uint32_t)(((uint32_t)(((v_ofe >> 16) & 65535))) + ((uint32_t)((((v_bits >> 1) >> (63 - v_nb)) & 65535)))));
+      v_bits <<= v_nb;
+      v_n_bits -= v_nb;
+    }
+    if (v_of_value > 3) {
+      v_offset = (v_of_value - 3);
+      v_rep2 = v_rep1;
+      v_rep1 = v_rep0;
+      v_rep0 = v_offset;
+    } else {
+      if (v_ll == 0) {
+        v_of_value += 1;
+      }
+      if (v_of_value == 1) {
+        v_offset = v_rep0;
+      } else if (v_of_value == 2) {
+        v_offset = v_rep1;
+        v_rep1 = v_rep0;
+        v_rep0 = v_offset;
+      } else if (v_of_value == 3) {
+        v_offset = v_rep2;
+        v_rep2 = v_rep1;
+        v_rep1 = v_rep0;
+        v_rep0 = v_offset;
+      } else {
+        if (v_rep0 <= 1) {
+          return wuffs_base__make_status(wuffs_zstd__error__bad_offset);
+        }
+        v_offset = (v_rep0 - 1);
+        v_rep2 = v_rep1;
+        v_rep1 = v_rep0;
+        v_rep0 = v_offset;
+      }
+    }
+    if (v_ll > v_lit_remaining) {
+      return wuffs_base__make_status(wuffs_zstd__error__bad_sequences_section);
+    }
+    v_lit_remaining -= v_ll;
+    if ((v_ll > self->private_impl.f_block_max_size) || (v_ml > self->private_impl.f_block_max_size) || (wuffs_base__u32__sat_add(v_block_decoded, wuffs_base__u32__sat_add(v_ll, v_ml)) > self->private_impl.f_block_max_size)) {
+      return wuffs_base__make_status(wuffs_zstd__error__bad_block);
+    }
+    wuffs_base__u32__sat_add_indirect(&v_block_decoded, v_ll);
+    v_pos = wuffs_base__u64__sat_add(self->private_impl.f_frame_decoded, ((uint64_t)(v_block_decoded)));
+    wuffs_base__u32__sat_add_indirect(&v_block_decoded, v_ml);
+    if ((v_offset == 0) || (((uint64_t)(v_offset)) > v_pos) || (v_offset > self->private_impl.f_window_size)) {
+      return wuffs_base__make_status(wuffs_zstd__error__bad_offset);
+    }
+    if (((uint64_t)(v_dst.len)) < 8) {
+      return wuffs_base__make_status(wuffs_zstd__error__bad_sequences_section);
+    }
+    wuffs_base__poke_u64le__no_bounds_check(wuffs_base__slice_u8__subslice_j(v_dst, 8).ptr, ((((uint64_t)(v_ll)) << 42) | (((uint64_t)(v_ml)) << 24) | ((uint64_t)(v_offset))));
+    v_dst = wuffs_base__slice_u8__subslice_i(v_dst, 8);
+  }
+  if ((v_n_bits != 0) || (v_ri != 0)) {
+    return wuffs_base__make_status(wuffs_zstd__error__bad_sequences_section);
+  }
+  if (wuffs_base__u32__sat_add(v_block_decoded, v_lit_remaining) > self->private_impl.f_block_max_size) {
+    return wuffs_base__make_status(wuffs_zstd__error__bad_block);
+  }
+  self->private_impl.f_rep0 = v_rep0;
+  self->private_impl.f_rep1 = v_rep1;
+  self->private_impl.f_rep2 = v_rep2;
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func zstd.decoder.set_quirk_enabled
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct
+wuffs_zstd__decoder__set_quirk_enabled(
+    wuffs_zstd__decoder* self,
+    uint32_t a_quirk,
+    bool a_enabled) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  if (a_quirk == 1) {
+    self->private_impl.f_ignore_checksum = a_enabled;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func zstd.decoder.workbuf_len
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64
+wuffs_zstd__decoder__workbuf_len(
+    const wuffs_zstd__decoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+
+  return wuffs_base__utility__make_range_ii_u64(9437184, 9437184);
+}
+
+// -------- func zstd.decoder.transform_io
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status
+wuffs_zstd__decoder__transform_io(
+    wuffs_zstd__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+        ? wuffs_base__error__disabled_by_previous_error
+        : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst || !a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 1)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint64_t v_mark = 0;
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_transform_io[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    while (true) {
+      if (((uint64_t)(a_workbuf.len)) < 9437184) {
+        status = wuffs_base__make_status(wuffs_base__error__bad_workbuf_length);
+        goto exit;
+      }
+      v_mark = ((uint64_t)(iop_a_dst - io0_a_dst));
+      {
+        if (a_dst) {
+          a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+        }
+        wuffs_base__status t_0 = wuffs_zstd__decoder__decode_frame(self, a_dst, a_src, a_workbuf);
+        v_status = t_0;
+        if (a_dst) {
+          iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+        }
+      }
+      if ( ! wuffs_base__status__is_suspension(&v_status)) {
+        if (wuffs_base__status__is_ok(&v_status)) {
+          self->private_impl.f_transformed_history_count = 0;
+          self->private_impl.f_history_index = 0;
+        }
+        status = v_status;
+        if (wuffs_base__status__is_error(&status)) {
+          goto exit;
+        } else if (wuffs_base__status__is_suspension(&status)) {
+          status = wuffs_base__make_status(wuffs_base__error__cannot_return_a_suspension);
+          goto exit;
+        }
+        goto ok;
+      }
+      wuffs_base__u64__sat_add_indirect(&self->private_impl.f_transformed_history_count, wuffs_base__io__count_since(v_mark, ((uint64_t)(iop_a_dst - io0_a_dst))));
+      wuffs_zstd__decoder__add_history(self, wuffs_base__io__since(v_mark, ((uint64_t)(iop_a_dst - io0_a_dst)), io0_a_dst), a_workbuf);
+      status = v_status;
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
+    }
+
+    ok:
+    self->private_impl.p_transform_io[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_transform_io[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine = wuffs_base__status__is_suspension(&status) ? 1 : 0;
+  WUFFS_BASE__STATS__ADD(self->private_impl, WUFFS_BASE__STATS__SUSPENSIONS,
+      wuffs_base__status__is_suspension(&status) ? 1u : 0u);
+
+  goto exit;
+  exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func zstd.decoder.add_history
+
+static wuffs_base__empty_struct
+wuffs_zstd__decoder__add_history(
+    wuffs_zstd__decoder* self,
+    wuffs_base__slice_u8 a_hist,
+    wuffs_base__slice_u8 a_workbuf) {
+  wuffs_base__slice_u8 v_s = {0};
+  uint64_t v_n_copied = 0;
+  uint32_t v_already_full = 0;
+
+  if (((uint64_t)(a_workbuf.len)) < 9437184) {
+    return wuffs_base__make_empty_struct();
+  }
+  v_s = a_hist;
+  if (((uint64_t)(v_s.len)) >= 8388608) {
+    v_s = wuffs_base__slice_u8__suffix(v_s, 8388608);
+    wuffs_base__slice_u8__copy_from_slice(wuffs_base__slice_u8__subslice_ij(a_workbuf, 1048576, 9437184), v_s);
+    self->private_impl.f_history_index = 8388608;
+  } else {
+    v_n_copied = wuffs_base__slice_u8__copy_from_slice(wuffs_base__slice_u8__subslice_ij(a_workbuf, (1048576 + (self->private_impl.f_history_index & 8388607)), 9437184), v_s);
+    if (v_n_copied < ((uint64_t)(v_s.len))) {
+      v_s = wuffs_base__slice_u8__subslice_i(v_s, v_n_copied);
+      v_n_copied = wuffs_base__slice_u8__copy_from_slice(wuffs_base__slice_u8__subslice_ij(a_workbuf, 1048576, 9437184), v_s);
+      self->private_impl.f_history_index = (((uint32_t)((v_n_copied & 8388607))) + 8388608);
+    } else {
+      v_already_full = 0;
+      if (self->private_impl.f_history_index >= 8388608) {
+        v_already_full = 8388608;
+      }
+      self->private_impl.f_history_index = ((self->private_impl.f_history_index & 8388607) + ((uint32_t)((v_n_copied & 8388607))) + v_already_full);
+    }
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func zstd.decoder.decode_frame
+
+static wuffs_base__status
+wuffs_zstd__decoder__decode_frame(
+    wuffs_zstd__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_magic = 0;
+  uint32_t v_skip_length = 0;
+  uint8_t v_fhd = 0;
+  bool v_single = false;
+  uint32_t v_wd = 0;
+  uint32_t v_window_log = 0;
+  uint64_t v_window_size = 0;
+  uint32_t v_dict_id = 0;
+  uint32_t v_block_header = 0;
+  bool v_last_block = false;
+  uint32_t v_block_type = 0;
+  uint32_t v_block_size = 0;
+  uint8_t v_rle_byte = 0;
+  uint64_t v_n_block = 0;
+  uint64_t v_dmark = 0;
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  uint64_t v_checksum_got = 0;
+  uint32_t v_checksum_want = 0;
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_frame[0];
+  if (coro_susp_point) {
+    v_window_size = self->private_data.s_decode_frame[0].v_window_size;
+    v_n_block = self->private_data.s_decode_frame[0].v_n_block;
+    v_status = self->private_data.s_decode_frame[0].v_status;
+    v_checksum_got = self->private_data.s_decode_frame[0].v_checksum_got;
+    v_block_type = self->private_data.s_decode_frame[0].v_block_type;
+    v_block_size = self->private_data.s_decode_frame[0].v_block_size;
+    v_fhd = self->private_data.s_decode_frame[0].v_fhd;
+    v_single = self->private_data.s_decode_frame[0].v_single;
+    v_last_block = self->private_data.s_decode_frame[0].v_last_block;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    label__0__continue:;
+    while (true) {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        uint32_t t_0;
+        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+          t_0 = wuffs_base__peek_u32le__no_bounds_check(iop_a_src);
+          iop_a_src += 4;
+        } else {
+          self->private_data.s_decode_frame[0].scratch = 0;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+          while (true) {
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint64_t* scratch = &self->private_data.s_decode_frame[0].scratch;
+            uint32_t num_bits_0 = ((uint32_t)(*scratch >> 56));
+            *scratch <<= 8;
+            *scratch >>= 8;
+            *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_0;
+            if (num_bits_0 == 24) {
+              t_0 = ((uint32_t)(*scratch));
+              break;
+            }
+            num_bits_0 += 8;
+            *scratch |= ((uint64_t)(num_bits_0)) << 56;
+          }
+        }
+        v_magic = t_0;
+      }
+      if (v_magic == 4247762216) {
+        goto label__0__break;
+      } else if ((v_magic & 4294967280) == 407710288) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+          uint32_t t_1;
+          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+            t_1 = wuffs_base__peek_u32le__no_bounds_check(iop_a_src);
+            iop_a_src += 4;
+          } else {
+            self->private_data.s_decode_frame[0].scratch = 0;
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+            while (true) {
+              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+                goto suspend;
+              }
+              uint64_t* scratch = &self->private_data.s_decode_frame[0].scratch;
+              uint32_t num_bits_1 = ((uint32_t)(*scratch >> 56));
+              *scratch <<= 8;
+              *scratch >>= 8;
+              *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_1;
+              if (num_bits_1 == 24) {
+                t_1 = ((uint32_t)(*scratch));
+                break;
+              }
+              num_bits_1 += 8;
+              *scratch |= ((uint64_t)(num_bits_1)) << 56;
+            }
+          }
+          v_skip_length = t_1;
+        }
+        self->private_data.s_decode_frame[0].scratch = ((uint64_t)(v_skip_length));
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+        if (self->private_data.s_decode_frame[0].scratch > ((uint64_t)(io2_a_src - iop_a_src))) {
+          self->private_data.s_decode_frame[0].scratch -= ((uint64_t)(io2_a_src - iop_a_src));
+          iop_a_src = io2_a_src;
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        iop_a_src += self->private_data.s_decode_frame[0].scratch;
+        goto label__0__continue;
+      }
+      status = wuffs_base__make_status(wuffs_zstd__error__bad_header);
+      goto exit;
+    }
+    label__0__break:;
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_2 = *iop_a_src++;
+      v_fhd = t_2;
+    }
+    if ((v_fhd & 8) != 0) {
+      status = wuffs_base__make_status(wuffs_zstd__error__bad_header);
+      goto exit;
+    }
+    v_single = ((v_fhd & 32) != 0);
+    self->private_impl.f_content_checksum_present = ((v_fhd & 4) != 0);
+    v_window_size = 0;
+    if ( ! v_single) {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint32_t t_3 = *iop_a_src++;
+        v_wd = t_3;
+      }
+      v_window_log = (10 + (v_wd >> 3));
+      if (v_window_log > 23) {
+        status = wuffs_base__make_status(wuffs_zstd__error__unsupported_zstandard_window_size);
+        goto exit;
+      }
+      v_window_size = (((uint64_t)(1)) << v_window_log);
+      v_window_size += ((v_window_size >> 3) * ((uint64_t)((v_wd & 7))));
+    }
+    v_dict_id = 0;
+    if ((v_fhd & 3) == 1) {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint32_t t_4 = *iop_a_src++;
+        v_dict_id = t_4;
+      }
+    } else if ((v_fhd & 3) == 2) {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
+        uint32_t t_5;
+        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+          t_5 = ((uint32_t)(wuffs_base__peek_u16le__no_bounds_check(iop_a_src)));
+          iop_a_src += 2;
+        } else {
+          self->private_data.s_decode_frame[0].scratch = 0;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(10);
+          while (true) {
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint64_t* scratch = &self->private_data.s_decode_frame[0].scratch;
+            uint32_t num_bits_5 = ((uint32_t)(*scratch >> 56));
+            *scratch <<= 8;
+            *scratch >>= 8;
+            *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_5;
+            if (num_bits_5 == 8) {
+              t_5 = ((uint32_t)(*scratch));
+              break;
+            }
+            num_bits_5 += 8;
+            *scratch |= ((uint64_t)(num_bits_5)) << 56;
+          }
+        }
+        v_dict_id = t_5;
+      }
+    } else if ((v_fhd & 3) == 3) {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(11);
+        uint32_t t_6;
+        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+          t_6 = wuffs_base__peek_u32le__no_bounds_check(iop_a_src);
+          iop_a_src += 4;
+        } else {
+          self->private_data.s_decode_frame[0].scratch = 0;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(12);
+          while (true) {
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint64_t* scratch = &self->private_data.s_decode_frame[0].scratch;
+            uint32_t num_bits_6 = ((uint32_t)(*scratch >> 56));
+            *scratch <<= 8;
+            *scratch >>= 8;
+            *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_6;
+            if (num_bits_6 == 24) {
+              t_6 = ((uint32_t)(*scratch));
+              break;
+            }
+            num_bits_6 += 8;
+            *scratch |= ((uint64_t)(num_bits_6)) << 56;
+          }
+        }
+        v_dict_id = t_6;
+      }
+    }
+    if (v_dict_id != 0) {
+      status = wuffs_base__make_status(wuffs_zstd__error__unsupported_zstandard_dictionary);
+      goto exit;
+    }
+    self->private_impl.f_content_size_present = true;
+    if ((v_fhd >> 6) == 0) {
+      if (v_single) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(13);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t t_7 = *iop_a_src++;
+          self->private_impl.f_content_size = t_7;
+        }
+      } else {
+        self->private_impl.f_content_size_present = false;
+        self->private_impl.f_content_size = 0;
+      }
+    } else if ((v_fhd >> 6) == 1) {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(14);
+        uint64_t t_8;
+        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+          t_8 = ((uint64_t)(wuffs_base__peek_u16le__no_bounds_check(iop_a_src)));
+          iop_a_src += 2;
+        } else {
+          self->private_data.s_decode_frame[0].scratch = 0;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(15);
+          while (true) {
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint64_t* scratch = &self->private_data.s_decode_frame[0].scratch;
+            uint32_t num_bits_8 = ((uint32_t)(*scratch >> 56));
+            *scratch <<= 8;
+            *scratch >>= 8;
+            *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_8;
+            if (num_bits_8 == 8) {
+              t_8 = ((uint64_t)(*scratch));
+              break;
+            }
+            num_bits_8 += 8;
+            *scratch |= ((uint64_t)(num_bits_8)) << 56;
+          }
+        }
+        self->private_impl.f_content_size = t_8;
+      }
+      self->private_impl.f_content_size += 256;
+    } else if ((v_fhd >> 6) == 2) {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(16);
+        uint64_t t_9;
+        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+          t_9 = ((uint64_t)(wuffs_base__peek_u32le__no_bounds_check(iop_a_src)));
+          iop_a_src += 4;
+        } else {
+          self->private_data.s_decode_frame[0].scratch = 0;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(17);
+          while (true) {
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint64_t* scratch = &self->private_data.s_decode_frame[0].scratch;
+            uint32_t num_bits_9 = ((uint32_t)(*scratch >> 56));
+            *scratch <<= 8;
+            *scratch >>= 8;
+            *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_9;
+            if (num_bits_9 == 24) {
+              t_9 = ((uint64_t)(*scratch));
+              break;
+            }
+            num_bits_9 += 8;
+            *scratch |= ((uint64_t)(num_bits_9)) << 56;
+          }
+        }
+        self->private_impl.f_content_size = t_9;
+      }
+    } else {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(18);
+        uint64_t t_10;
+        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 8)) {
+          t_10 = wuffs_base__peek_u64le__no_bounds_check(iop_a_src);
+          iop_a_src += 8;
+        } else {
+          self->private_data.s_decode_frame[0].scratch = 0;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(19);
+          while (true) {
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint64_t* scratch = &self->private_data.s_decode_frame[0].scratch;
+            uint32_t num_bits_10 = ((uint32_t)(*scratch >> 56));
+            *scratch <<= 8;
+            *scratch >>= 8;
+            *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_10;
+            if (num_bits_10 == 56) {
+              t_10 = ((uint64_t)(*scratch));
+              break;
+            }
+            num_bits_10 += 8;
+            *scratch |= ((uint64_t)(num_bits_10)) << 56;
+          }
+        }
+        self->private_impl.f_content_size = t_10;
+      }
+    }
+    if (v_single) {
+      v_window_size = self->private_impl.f_content_size;
+    }
+    if (v_window_size > 8388608) {
+      status = wuffs_base__make_status(wuffs_zstd__error__unsupported_zstandard_window_size);
+      goto exit;
+    }
+    self->private_impl.f_window_size = ((uint32_t)(v_window_size));
+    if (v_window_size < 131072) {
+      self->private_impl.f_block_max_size = ((uint32_t)(v_window_size));
+    } else {
+      self->private_impl.f_block_max_size = 131072;
+    }
+    self->private_impl.f_frame_decoded = 0;
+    self->private_impl.f_huff_table_present = false;
+    self->private_impl.f_ll_table_present = false;
+    self->private_impl.f_of_table_present = false;
+    self->private_impl.f_ml_table_present = false;
+    self->private_impl.f_rep0 = 1;
+    self->private_impl.f_rep1 = 4;
+    self->private_impl.f_rep2 = 8;
+    while (true) {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(20);
+        uint32_t t_11;
+        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 3)) {
+          t_11 = ((uint32_t)(wuffs_base__peek_u24le__no_bounds_check(iop_a_src)));
+          iop_a_src += 3;
+        } else {
+          self->private_data.s_decode_frame[0].scratch = 0;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(21);
+          while (true) {
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint64_t* scratch = &self->private_data.s_decode_frame[0].scratch;
+            uint32_t num_bits_11 = ((uint32_t)(*scratch >> 56));
+            *scratch <<= 8;
+            *scratch >>= 8;
+            *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_11;
+            if (num_bits_11 == 16) {
+              t_11 = ((uint32_t)(*scratch));
+              break;
+            }
+            num_bits_11 += 8;
+            *scratch |= ((uint64_t)(num_bits_11)) << 56;
+          }
+        }
+        v_block_header = t_11;
+      }
+      v_last_block = ((v_block_header & 1) != 0);
+      v_block_type = ((v_block_header >> 1) & 3);
+      v_block_size = (v_block_header >> 3);
+      if ((v_block_type == 3) || (v_block_size > self->private_impl.f_block_max_size)) {
+        status = wuffs_base__make_status(wuffs_zstd__error__bad_block);
+        goto exit;
+      }
+      self->private_impl.f_block_length = v_block_size;
+      if (v_block_type == 1) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(22);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint8_t t_12 = *iop_a_src++;
+          v_rle_byte = t_12;
+        }
+        wuffs_zstd__decoder__fill_literals(self, a_workbuf, v_rle_byte, v_block_size);
+      } else if (v_block_type == 2) {
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(23);
+        status = wuffs_zstd__decoder__read_block(self, a_src, a_workbuf);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+      }
+      v_n_block = 0;
+      while (true) {
+        v_dmark = ((uint64_t)(iop_a_dst - io0_a_dst));
+        if (v_block_type == 0) {
+          {
+            if (a_dst) {
+              a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+            }
+            if (a_src) {
+              a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+            }
+            wuffs_base__status t_13 = wuffs_zstd__decoder__decode_raw_block(self, a_dst, a_src);
+            v_status = t_13;
+            if (a_dst) {
+              iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+            }
+            if (a_src) {
+              iop_a_src = a_src->data.ptr + a_src->meta.ri;
+            }
+          }
+        } else if (v_block_type == 1) {
+          {
+            if (a_dst) {
+              a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+            }
+            wuffs_base__status t_14 = wuffs_zstd__decoder__copy_literals(self, a_dst, a_workbuf);
+            v_status = t_14;
+            if (a_dst) {
+              iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+            }
+          }
+        } else {
+          {
+            if (a_dst) {
+              a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+            }
+            wuffs_base__status t_15 = wuffs_zstd__decoder__decode_compressed_block(self, a_dst, a_workbuf);
+            v_status = t_15;
+            if (a_dst) {
+              iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+            }
+          }
+        }
+        wuffs_base__u64__sat_add_indirect(&v_n_block, wuffs_base__io__count_since(v_dmark, ((uint64_t)(iop_a_dst - io0_a_dst))));
+        if (self->private_impl.f_content_checksum_present &&  ! self->private_impl.f_ignore_checksum) {
+          v_checksum_got = wuffs_xxhash64__hasher__update_u64(&self->private_data.f_content_hasher, wuffs_base__io__since(v_dmark, ((uint64_t)(iop_a_dst - io0_a_dst)), io0_a_dst));
+        }
+        if (wuffs_base__status__is_ok(&v_status)) {
+          goto label__1__break;
+        }
+        status = v_status;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(24);
+      }
+      label__1__break:;
+      wuffs_base__u64__sat_add_indirect(&self->private_impl.f_frame_decoded, v_n_block);
+      if (v_last_block) {
+        goto label__blocks__break;
+      }
+    }
+    label__blocks__break:;
+    if (self->private_impl.f_content_size_present && (self->private_impl.f_frame_decoded != self->private_impl.f_content_size)) {
+      status = wuffs_base__make_status(wuffs_zstd__error__bad_content_size);
+      goto exit;
+    }
+    if (self->private_impl.f_content_checksum_present) {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(25);
+        uint32_t t_16;
+        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+          t_16 = wuffs_base__peek_u32le__no_bounds_check(iop_a_src);
+          iop_a_src += 4;
+        } else {
+          self->private_data.s_decode_frame[0].scratch = 0;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(26);
+          while (true) {
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint64_t* scratch = &self->private_data.s_decode_frame[0].scratch;
+            uint32_t num_bits_16 = ((uint32_t)(*scratch >> 56));
+            *scratch <<= 8;
+            *scratch >>= 8;
+            *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_16;
+            if (num_bits_16 == 24) {
+              t_16 = ((uint32_t)(*scratch));
+              break;
+            }
+            num_bits_16 += 8;
+            *scratch |= ((uint64_t)(num_bits_16)) << 56;
+          }
+        }
+        v_checksum_want = t_16;
+      }
+      if ( ! self->private_impl.f_ignore_checksum) {
+        if (self->private_impl.f_frame_decoded == 0) {
+          v_checksum_got = 17241709254077376921u;
+        }
+        wuffs_base__ignore_status(wuffs_xxhash64__hasher__initialize(&self->private_data.f_content_hasher,
+            sizeof (wuffs_xxhash64__hasher), WUFFS_VERSION, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+        if (((uint32_t)((v_checksum_got & 4294967295))) != v_checksum_want) {
+          status = wuffs_base__make_status(wuffs_zstd__error__bad_checksum);
+          goto exit;
+        }
+      }
+    }
+
+    ok:
+    self->private_impl.p_decode_frame[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_frame[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_decode_frame[0].v_window_size = v_window_size;
+  self->private_data.s_decode_frame[0].v_n_block = v_n_block;
+  self->private_data.s_decode_frame[0].v_status = v_status;
+  self->private_data.s_decode_frame[0].v_checksum_got = v_checksum_got;
+  self->private_data.s_decode_frame[0].v_block_type = v_block_type;
+  self->private_data.s_decode_frame[0].v_block_size = v_block_size;
+  self->private_data.s_decode_frame[0].v_fhd = v_fhd;
+  self->private_data.s_decode_frame[0].v_single = v_single;
+  self->private_data.s_decode_frame[0].v_last_block = v_last_block;
+
+  goto exit;
+  exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func zstd.decoder.read_block
+
+static wuffs_base__status
+wuffs_zstd__decoder__read_block(
+    wuffs_zstd__decoder* self,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__slice_u8 a_workbuf) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  wuffs_base__slice_u8 v_s = {0};
+  uint32_t v_n_copied = 0;
+
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_read_block[0];
+  if (coro_susp_point) {
+    v_n_copied = self->private_data.s_read_block[0].v_n_copied;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    while (true) {
+      if (((uint64_t)(self->private_impl.f_block_length)) > ((uint64_t)(a_workbuf.len))) {
+        status = wuffs_base__make_status(wuffs_zstd__error__internal_error_inconsistent_workbuf_length);
+        goto exit;
+      }
+      v_s = wuffs_base__slice_u8__subslice_j(a_workbuf, ((uint64_t)(self->private_impl.f_block_length)));
+      if (((uint64_t)(v_n_copied)) >= ((uint64_t)(v_s.len))) {
+        goto label__0__break;
+      }
+      wuffs_base__u32__sat_add_indirect(&v_n_copied, wuffs_base__io_reader__limited_copy_u32_to_slice(
+          &iop_a_src, io2_a_src,4294967295, wuffs_base__slice_u8__subslice_i(v_s, ((uint64_t)(v_n_copied)))));
+      if (((uint64_t)(v_n_copied)) >= ((uint64_t)(v_s.len))) {
+        goto label__0__break;
+      }
+      status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
+    }
+    label__0__break:;
+
+    ok:
+    self->private_impl.p_read_block[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_read_block[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_read_block[0].v_n_copied = v_n_copied;
+
+  goto exit;
+  exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func zstd.decoder.decode_raw_block
+
+static wuffs_base__status
+wuffs_zstd__decoder__decode_raw_block(
+    wuffs_zstd__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_n_copied = 0;
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+  const uint8_t* iop_a_src = NULL;
+  const uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  const uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_raw_block[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    while (self->private_impl.f_block_length > 0) {
+      v_n_copied = wuffs_base__io_writer__limited_copy_u32_from_reader(
+          &iop_a_dst, io2_a_dst,self->private_impl.f_block_length, &iop_a_src, io2_a_src);
+      if (self->private_impl.f_block_length <= v_n_copied) {
+        self->private_impl.f_block_length = 0;
+        status = wuffs_base__make_status(NULL);
+        goto ok;
+      }
+      self->private_impl.f_block_length -= v_n_copied;
+      if (((uint64_t)(io2_a_dst - iop_a_dst)) == 0) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
+      } else {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(2);
+      }
+    }
+
+    ok:
+    self->private_impl.p_decode_raw_block[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_raw_block[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+  exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func zstd.decoder.fill_literals
+
+static wuffs_base__empty_struct
+wuffs_zstd__decoder__fill_literals(
+    wuffs_zstd__decoder* self,
+    wuffs_base__slice_u8 a_workbuf,
+    uint8_t a_b,
+    uint32_t a_n) {
+  uint64_t v_fill = 0;
+  wuffs_base__slice_u8 v_p = {0};
+
+  if (((uint64_t)(a_workbuf.len)) < 262144) {
+    return wuffs_base__make_empty_struct();
+  }
+  v_fill = ((uint64_t)(((uint64_t)(a_b)) * 72340172838076673));
+  self->private_impl.f_literals_ri = 131072;
+  self->private_impl.f_literals_wi = (131072 + a_n);
+  v_p = wuffs_base__slice_u8__subslice_ij(a_workbuf, 131072, 262144);
+  {
+    wuffs_base__slice_u8 i_slice_p = wuffs_base__slice_u8__subslice_j(v_p, ((uint64_t)(a_n)));
+    v_p.ptr = i_slice_p.ptr;
+    v_p.len = 8;
+    uint8_t* i_end0_p = v_p.ptr + (((i_slice_p.len - (size_t)(v_p.ptr - i_slice_p.ptr)) / 8) * 8);
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_p.ptr < i_end0_p) {
+      wuffs_base__poke_u64le__no_bounds_check(v_p.ptr, v_fill);
+      v_p.ptr += 8;
+    }
+    v_p.len = 1;
+    uint8_t* i_end1_p = i_slice_p.ptr + i_slice_p.len;
+    WUFFS_BASE__ITERATE_LOOP_HINT
+    while (v_p.ptr < i_end1_p) {
+      v_p.ptr[0] = a_b;
+      v_p.ptr += 1;
+    }
+    v_p.len = 0;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func zstd.decoder.copy_literals
+
+static wuffs_base__status
+wuffs_zstd__decoder__copy_literals(
+    wuffs_zstd__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__slice_u8 a_workbuf) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  wuffs_base__slice_u8 v_s = {0};
+  uint32_t v_n_copied = 0;
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_copy_literals[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    while (self->private_impl.f_literals_ri < self->private_impl.f_literals_wi) {
+      if (((uint64_t)(self->private_impl.f_literals_wi)) > ((uint64_t)(a_workbuf.len))) {
+        status = wuffs_base__make_status(wuffs_zstd__error__internal_error_inconsistent_workbuf_length);
+        goto exit;
+      }
+      v_s = wuffs_base__slice_u8__subslice_j(a_workbuf, ((uint64_t)(self->private_impl.f_literals_wi)));
+      if (((uint64_t)(self->private_impl.f_literals_ri)) > ((uint64_t)(v_s.len))) {
+        status = wuffs_base__make_status(wuffs_zstd__error__internal_error_inconsistent_workbuf_length);
+        goto exit;
+      }
+      v_n_copied = wuffs_base__io_writer__limited_copy_u32_from_slice(
+          &iop_a_dst, io2_a_dst,4294967295, wuffs_base__slice_u8__subslice_i(v_s, ((uint64_t)(self->private_impl.f_literals_ri))));
+      wuffs_base__u32__sat_add_indirect(&self->private_impl.f_literals_ri, v_n_copied);
+      if (self->private_impl.f_literals_ri < self->private_impl.f_literals_wi) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
+      }
+    }
+
+    ok:
+    self->private_impl.p_copy_literals[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_copy_literals[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+  exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func zstd.decoder.decode_compressed_block
+
+static wuffs_base__status
+wuffs_zstd__decoder__decode_compressed_block(
+    wuffs_zstd__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__slice_u8 a_workbuf) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_compressed_block[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    v_status = wuffs_zstd__decoder__decode_literals(self, a_workbuf);
+    if ( ! wuffs_base__status__is_ok(&v_status)) {
+      status = v_status;
+      if (wuffs_base__status__is_error(&status)) {
+        goto exit;
+      } else if (wuffs_base__status__is_suspension(&status)) {
+        status = wuffs_base__make_status(wuffs_base__error__cannot_return_a_suspension);
+        goto exit;
+      }
+      goto ok;
+    }
+    v_status = wuffs_zstd__decoder__decode_sequences_header(self, a_workbuf);
+    if ( ! wuffs_base__status__is_ok(&v_status)) {
+      status = v_status;
+      if (wuffs_base__status__is_error(&status)) {
+        goto exit;
+      } else if (wuffs_base__status__is_suspension(&status)) {
+        status = wuffs_base__make_status(wuffs_base__error__cannot_return_a_suspension);
+        goto exit;
+      }
+      goto ok;
+    }
+    v_status = wuffs_zstd__decoder__decode_sequences(self, a_workbuf);
+    if ( ! wuffs_base__status__is_ok(&v_status)) {
+      status = v_status;
+      if (wuffs_base__status__is_error(&status)) {
+        goto exit;
+      } else if (wuffs_base__status__is_suspension(&status)) {
+        status = wuffs_base__make_status(wuffs_base__error__cannot_return_a_suspension);
+        goto exit;
+      }
+      goto ok;
+    }
+    self->private_impl.f_seq_index = 0;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+    status = wuffs_zstd__decoder__execute_sequences(self, a_dst, a_workbuf);
+    if (status.repr) {
+      goto suspend;
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+    status = wuffs_zstd__decoder__copy_literals(self, a_dst, a_workbuf);
+    if (status.repr) {
+      goto suspend;
+    }
+
+    ok:
+    self->private_impl.p_decode_compressed_block[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_decode_compressed_block[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+  exit:
+  return status;
+}
+
+// -------- func zstd.decoder.execute_sequences
+
+static wuffs_base__status
+wuffs_zstd__decoder__execute_sequences(
+    wuffs_zstd__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__slice_u8 a_workbuf) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  wuffs_base__slice_u8 v_s = {0};
+  uint64_t v_e = 0;
+  uint32_t v_ll = 0;
+  uint32_t v_ml = 0;
+  uint32_t v_offset = 0;
+  uint32_t v_n_copied = 0;
+  uint32_t v_hlen = 0;
+  uint32_t v_hdist = 0;
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_execute_sequences[0];
+  if (coro_susp_point) {
+    v_ll = self->private_data.s_execute_sequences[0].v_ll;
+    v_ml = self->private_data.s_execute_sequences[0].v_ml;
+    v_offset = self->private_data.s_execute_sequences[0].v_offset;
+    v_hlen = self->private_data.s_execute_sequences[0].v_hlen;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    while (true) {
+      if (a_dst) {
+        a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+      }
+      v_status = wuffs_zstd__decoder__execute_sequences_fast(self, a_dst, a_workbuf);
+      if (a_dst) {
+        iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+      }
+      if (wuffs_base__status__is_error(&v_status)) {
+        status = v_status;
+        goto exit;
+      } else if (self->private_impl.f_seq_index >= self->private_impl.f_n_sequences) {
+        goto label__loop__break;
+      }
+      v_e = wuffs_zstd__decoder__load_sequence(self, a_workbuf);
+      v_ll = ((uint32_t)(((v_e >> 42) & 131071)));
+      if (((v_e >> 42) & 131072) != 0) {
+        v_ll = 131072;
+      }
+      v_ml = ((uint32_t)(((v_e >> 24) & 131071)));
+      if (((v_e >> 24) & 131072) != 0) {
+        v_ml = 131072;
+      }
+      v_offset = ((uint32_t)((v_e & 8388607)));
+      if ((v_e & 8388608) != 0) {
+        v_offset = 8388608;
+      }
+      wuffs_base__u32__sat_add_indirect(&self->private_impl.f_seq_index, 1);
+      while (v_ll > 0) {
+        if (((uint64_t)(self->private_impl.f_literals_wi)) > ((uint64_t)(a_workbuf.len))) {
+          status = wuffs_base__make_status(wuffs_zstd__error__internal_error_inconsistent_workbuf_length);
+          goto exit;
+        }
+        v_s = wuffs_base__slice_u8__subslice_j(a_workbuf, ((uint64_t)(self->private_impl.f_literals_wi)));
+        if (((uint64_t)(self->private_impl.f_literals_ri)) > ((uint64_t)(v_s.len))) {
+          status = wuffs_base__make_status(wuffs_zstd__error__internal_error_inconsistent_workbuf_length);
+          goto exit;
+        }
+        v_n_copied = wuffs_base__io_writer__limited_copy_u32_from_slice(
+            &iop_a_dst, io2_a_dst,v_ll, wuffs_base__slice_u8__subslice_i(v_s, ((uint64_t)(self->private_impl.f_literals_ri))));
+        wuffs_base__u32__sat_add_indirect(&self->private_impl.f_literals_ri, v_n_copied);
+        if (v_ll <= v_n_copied) {
+          goto label__0__break;
+        }
+        v_ll -= v_n_copied;
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
+      }
+      label__0__break:;
+      label__inner__continue:;
+      while (v_ml > 0) {
+        if (((uint64_t)(v_offset)) > ((uint64_t)(iop_a_dst - io0_a_dst))) {
+          v_hdist = ((uint32_t)((((uint64_t)(v_offset)) - ((uint64_t)(iop_a_dst - io0_a_dst)))));
+          if (v_hdist < v_ml) {
+            v_hlen = v_hdist;
+          } else {
+            v_hlen = v_ml;
+          }
+          v_hdist += ((uint32_t)((((uint64_t)(self->private_impl.f_transformed_history_count - (a_dst ? a_dst->meta.pos : 0))) & 4294967295)));
+          if (self->private_impl.f_history_index < v_hdist) {
+            status = wuffs_base__make_status(wuffs_zstd__error__bad_offset);
+            goto exit;
+          }
+          if (((uint64_t)(a_workbuf.len)) < 9437184) {
+            status = wuffs_base__make_status(wuffs_zstd__error__internal_error_inconsistent_workbuf_length);
+            goto exit;
+          }
+          v_n_copied = wuffs_base__io_writer__limited_copy_u32_from_slice(
+              &iop_a_dst, io2_a_dst,v_hlen, wuffs_base__slice_u8__subslice_ij(a_workbuf, (1048576 + ((self->private_impl.f_history_index - v_hdist) & 8388607)), 9437184));
+          if (v_n_copied < v_hlen) {
+            v_ml -= v_n_copied;
+            if (((uint64_t)(io2_a_dst - iop_a_dst)) == 0) {
+              status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+              WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(2);
+            }
+            goto label__inner__continue;
+          }
+          v_ml -= v_hlen;
+          if (v_ml == 0) {
+            goto label__inner__break;
+          }
+        }
+        v_n_copied = wuffs_base__io_writer__limited_copy_u32_from_history(
+            &iop_a_dst, io0_a_dst, io2_a_dst, v_ml, v_offset);
+        if (v_ml <= v_n_copied) {
+          goto label__inner__break;
+        }
+        v_ml -= v_n_copied;
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(3);
+      }
+      label__inner__break:;
+    }
+    label__loop__break:;
+
+    ok:
+    self->private_impl.p_execute_sequences[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+  suspend:
+  self->private_impl.p_execute_sequences[0] = wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_execute_sequences[0].v_ll = v_ll;
+  self->private_data.s_execute_sequences[0].v_ml = v_ml;
+  self->private_data.s_execute_sequences[0].v_offset = v_offset;
+  self->private_data.s_execute_sequences[0].v_hlen = v_hlen;
+
+  goto exit;
+  exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func zstd.decoder.load_sequence
+
+static uint64_t
+wuffs_zstd__decoder__load_sequence(
+    wuffs_zstd__decoder* self,
+    wuffs_base__slice_u8 a_workbuf) {
+  wuffs_base__slice_u8 v_s = {0};
+
+  if (((uint64_t)(a_workbuf.len)) < 1048576) {
+    return 0;
+  }
+  v_s = wuffs_base__slice_u8__subslice_ij(a_workbuf, 262144, 1048576);
+  if ((((uint64_t)(self->private_impl.f_seq_index)) * 8) > ((uint64_t)(v_s.len))) {
+    return 0;
+  }
+  v_s = wuffs_base__slice_u8__subslice_i(v_s, (((uint64_t)(self->private_impl.f_seq_index)) * 8));
+  if (((uint64_t)(v_s.len)) < 8) {
+    return 0;
+  }
+  return wuffs_base__peek_u64le__no_bounds_check(v_s.ptr);
+}
+
+// -------- func zstd.decoder.execute_sequences_fast
+
+static wuffs_base__status
+wuffs_zstd__decoder__execute_sequences_fast(
+    wuffs_zstd__decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__slice_u8 a_workbuf) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  wuffs_base__slice_u8 v_lits = {0};
+  wuffs_base__slice_u8 v_seqs = {0};
+  uint64_t v_e = 0;
+  uint32_t v_ll = 0;
+  uint32_t v_ml = 0;
+  uint32_t v_offset = 0;
+  uint32_t v_lit_ri = 0;
+  uint32_t v_seq_index = 0;
+  uint32_t v_n_copied = 0;
+  uint32_t v_hlen = 0;
+  uint32_t v_hdist = 0;
+  uint32_t v_hdist_adjustment = 0;
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+
+  if ((((uint64_t)(a_workbuf.len)) < 9437184) || (self->private_impl.f_literals_ri > self->private_impl.f_literals_wi) || (((uint64_t)(self->private_impl.f_literals_wi)) > ((uint64_t)(a_workbuf.len)))) {
+    status = wuffs_base__make_status(wuffs_zstd__error__internal_error_inconsistent_workbuf_length);
+    goto exit;
+  }
+  if (self->private_impl.f_transformed_history_count < (a_dst ? a_dst->meta.pos : 0)) {
+    status = wuffs_base__make_status(wuffs_base__error__bad_i_o_position);
+    goto exit;
+  }
+  v_hdist_adjustment = ((uint32_t)(((self->private_impl.f_transformed_history_count - (a_dst ? a_dst->meta.pos : 0)) & 4294967295)));
+  v_lits = wuffs_base__slice_u8__subslice_j(a_workbuf, ((uint64_t)(self->private_impl.f_literals_wi)));
+  v_seqs = wuffs_base__slice_u8__subslice_ij(a_workbuf, 262144, 1048576);
+  v_seq_index = self->private_impl.f_seq_index;
+  if ((((uint64_t)(v_seq_index)) * 8) > ((uint64_t)(v_seqs.len))) {
+    status = wuffs_base__make_status(wuffs_zstd__error__internal_error_inconsistent_workbuf_length);
+    goto exit;
+  }
+  v_seqs = wuffs_base__slice_u8__subslice_i(v_seqs, (((uint64_t)(v_seq_index)) * 8));
+  v_lit_ri = self->private_impl.f_literals_ri;
+  label__loop__continue:;
+  while ((v_seq_index < self->private_impl.f_n_sequences) && (((uint64_t)(v_seqs.len)) >= 8)) {
+    v_e = wuffs_base__peek_u64le__no_bounds_check(v_seqs.ptr);
+    v_ll = ((uint32_t)(((v_e >> 42) & 131071)));
+    if (((v_e >> 42) & 131072) != 0) {
+      v_ll = 131072;
+    }
+    v_ml = ((uint32_t)(((v_e >> 24) & 131071)));
+    if (((v_e >> 24) & 131072) != 0) {
+      v_ml = 131072;
+    }
+    v_offset = ((uint32_t)((v_e & 8388607)));
+    if ((v_e & 8388608) != 0) {
+      v_offset = 8388608;
+    }
+    if (((uint64_t)((v_ll + v_ml + 8))) > ((uint64_t)(io2_a_dst - iop_a_dst))) {
+      goto label__loop__break;
+    }
+    v_seqs = wuffs_base__slice_u8__subslice_i(v_seqs, 8);
+    v_seq_index += 1;
+    if (((uint64_t)(v_lit_ri)) > ((uint64_t)(v_lits.len))) {
+      status = wuffs_base__make_status(wuffs_zstd__error__internal_error_inconsistent_workbuf_length);
+      goto exit;
+    }
+    v_n_copied = wuffs_base__io_writer__limited_copy_u32_from_slice(
+        &iop_a_dst, io2_a_dst,v_ll, wuffs_base__slice_u8__subslice_i(v_lits, ((uint64_t)(v_lit_ri))));
+    wuffs_base__u32__sat_add_indirect(&v_lit_ri, v_n_copied);
+    if (v_n_copied != v_ll) {
+      status = wuffs_base__make_status(wuffs_zstd__error__internal_error_inconsistent_i_o);
+      goto exit;
+    }
+    if (v_ml == 0) {
+      goto label__loop__continue;
+    }
+    if (((uint64_t)(v_offset)) > ((uint64_t)(iop_a_dst - io0_a_dst))) {
+      v_hlen = 0;
+      v_hdist = ((uint32_t)((((uint64_t)(v_offset)) - ((uint64_t)(iop_a_dst - io0_a_dst)))));
+      if (v_ml > v_hdist) {
+        v_ml -= v_hdist;
+        v_hlen = v_hdist;
+      } else {
+        v_hlen = v_ml;
+        v_ml = 0;
+      }
+      v_hdist += v_hdist_adjustment;
+      if (self->private_impl.f_history_index < v_hdist) {
+        status = wuffs_base__make_status(wuffs_zstd__error__bad_offset);
+        goto exit;
+      }
+      if (((uint64_t)(a_workbuf.len)) < 9437184) {
+        status = wuffs_base__make_status(wuffs_zstd__error__internal_error_inconsistent_workbuf_length);
+        goto exit;
+      }
+      v_n_copied = wuffs_base__io_writer__limited_copy_u32_from_slice(
+          &iop_a_dst, io2_a_dst,v_hlen, wuffs_base__slice_u8__subslice_ij(a_workbuf, (1048576 + ((self->private_impl.f_history_index - v_hdist) & 8388607)), 9437184));
+      if ((v_n_copied < v_hlen) && (((uint64_t)(a_workbuf.len)) >= 9437184)) {
+        wuffs_base__io_writer__limited_copy_u32_from_slice(
+            &iop_a_dst, io2_a_dst,wuffs_base__u32__sat_sub(v_hlen, v_n_copied), wuffs_base__slice_u8__subslice_ij(a_workbuf, 1048576, 9437184));
+      }
+      if (v_ml == 0) {
+        goto label__loop__continue;
+      }
+      if ((((uint64_t)(v_offset)) > ((uint64_t)(iop_a_dst - io0_a_dst))) || (((uint64_t)((v_ml + 8))) > ((uint64_t)(io2_a_dst - iop_a_dst)))) {
+        status = wuffs_base__make_status(wuffs_zstd__error__internal_error_inconsistent_i_o);
+        goto exit;
+      }
+    }
+    if ((v_offset < 1) || (((uint64_t)(v_offset)) > ((uint64_t)(iop_a_dst - io0_a_dst))) || (((uint64_t)((v_ml + 8))) > ((uint64_t)(io2_a_dst - iop_a_dst)))) {
+      status = wuffs_base__make_status(wuffs_zstd__error__internal_error_inconsistent_i_o);
+      goto exit;
+    }
+    if (v_offset >= 8) {
+      wuffs_base__io_writer__limited_copy_u32_from_history_8_byte_chunks_fast(
+          &iop_a_dst, io0_a_dst, io2_a_dst, v_ml, v_offset);
+    } else if (v_offset == 1) {
+      wuffs_base__io_writer__limited_copy_u32_from_history_8_byte_chunks_distance_1_fast(
+          &iop_a_dst, io0_a_dst, io2_a_dst, v_ml, v_offset);
+    } else if (((uint64_t)(v_ml)) <= ((uint64_t)(io2_a_dst - iop_a_dst))) {
+      wuffs_base__io_writer__limited_copy_u32_from_history_fast(
+          &iop_a_dst, io0_a_dst, io2_a_dst, v_ml, v_offset);
+    } else {
+      status = wuffs_base__make_status(wuffs_zstd__error__internal_error_inconsistent_i_o);
+      goto exit;
+    }
+  }
+  label__loop__break:;
+  self->private_impl.f_seq_index = v_seq_index;
+  self->private_impl.f_literals_ri = v_lit_ri;
+  status = wuffs_base__make_status(NULL);
+  goto ok;
+
+  ok:
+  goto exit;
+  exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+
+  return status;
+}
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__ZSTD)
+
+
+#endif  // WUFFS_IMPLEMENTATION
+
+// ¡ WUFFS MONOLITHIC RELEASE DISCARDS EVERYTHING BELOW.
+
+#endif  // WUFFS_INCLUDE_GUARD__ZSTD
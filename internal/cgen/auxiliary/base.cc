@@ -19,25 +19,149 @@
 
 #if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__AUX__BASE)
 
+#if defined(__APPLE__) || defined(__unix__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <vector>
+
 namespace wuffs_aux {
 
+namespace private_impl {
+
+Allocator g_allocator = {nullptr, nullptr, nullptr, nullptr};
+std::atomic<uint64_t> g_allocator_num_allocations(0);
+std::atomic<uint64_t> g_allocator_num_bytes(0);
+
+static inline void  //
+AllocatorStatsAdd(uint64_t num_bytes) {
+  g_allocator_num_allocations.fetch_add(1, std::memory_order_relaxed);
+  g_allocator_num_bytes.fetch_add(num_bytes, std::memory_order_relaxed);
+}
+
+std::atomic<uint64_t> g_large_allocation_huge_page_threshold(0);
+std::atomic<bool> g_large_allocation_prefault(false);
+
+// AdviseLargeAllocation applies the LargeAllocationPolicy to the n bytes at
+// ptr, returning ptr. madvise needs page-aligned addresses, so only the whole
+// pages within those n bytes are advised.
+static inline void*  //
+AdviseLargeAllocation(void* ptr, size_t n) {
+#if (defined(__APPLE__) || defined(__unix__)) && \
+    (defined(MADV_HUGEPAGE) || defined(MADV_POPULATE_WRITE))
+  uint64_t threshold =
+      g_large_allocation_huge_page_threshold.load(std::memory_order_relaxed);
+  if (!ptr || (threshold == 0) || (n < threshold)) {
+    return ptr;
+  }
+  long page_size = sysconf(_SC_PAGESIZE);
+  if (page_size <= 0) {
+    return ptr;
+  }
+  uintptr_t mask = static_cast<uintptr_t>(page_size) - 1;
+  uintptr_t lo = (reinterpret_cast<uintptr_t>(ptr) + mask) & ~mask;
+  uintptr_t hi = (reinterpret_cast<uintptr_t>(ptr) + n) & ~mask;
+  if (lo >= hi) {
+    return ptr;
+  }
+  // The madvise calls are only hints. Their failure is not an error.
+#if defined(MADV_HUGEPAGE)
+  madvise(reinterpret_cast<void*>(lo), hi - lo, MADV_HUGEPAGE);
+#endif
+#if defined(MADV_POPULATE_WRITE)
+  if (g_large_allocation_prefault.load(std::memory_order_relaxed)) {
+    madvise(reinterpret_cast<void*>(lo), hi - lo, MADV_POPULATE_WRITE);
+  }
+#endif
+#endif
+  return ptr;
+}
+
+}  // namespace private_impl
+
+void  //
+SetAllocator(const Allocator& allocator) {
+  private_impl::g_allocator = allocator;
+}
+
+AllocatorStats  //
+GetAllocatorStats() {
+  AllocatorStats ret;
+  ret.num_allocations = private_impl::g_allocator_num_allocations.load(
+      std::memory_order_relaxed);
+  ret.num_bytes =
+      private_impl::g_allocator_num_bytes.load(std::memory_order_relaxed);
+  return ret;
+}
+
+void*  //
+Malloc(size_t n) {
+  private_impl::AllocatorStatsAdd(n);
+  return private_impl::AdviseLargeAllocation(
+      private_impl::g_allocator.malloc_func
+          ? (*private_impl::g_allocator.malloc_func)(n)
+          : malloc(n),
+      n);
+}
+
+void*  //
+Calloc(size_t n, size_t size) {
+  private_impl::AllocatorStatsAdd((uint64_t)n * (uint64_t)size);
+  return private_impl::AdviseLargeAllocation(
+      private_impl::g_allocator.calloc_func
+          ? (*private_impl::g_allocator.calloc_func)(n, size)
+          : calloc(n, size),
+      n * size);
+}
+
+void*  //
+Realloc(void* ptr, size_t n) {
+  private_impl::AllocatorStatsAdd(n);
+  return private_impl::AdviseLargeAllocation(
+      private_impl::g_allocator.realloc_func
+          ? (*private_impl::g_allocator.realloc_func)(ptr, n)
+          : realloc(ptr, n),
+      n);
+}
+
+void  //
+Free(void* ptr) noexcept {
+  if (private_impl::g_allocator.free_func) {
+    (*private_impl::g_allocator.free_func)(ptr);
+  } else {
+    free(ptr);
+  }
+}
+
+void  //
+SetLargeAllocationPolicy(const LargeAllocationPolicy& policy) {
+  private_impl::g_large_allocation_prefault.store(policy.prefault,
+                                                  std::memory_order_relaxed);
+  private_impl::g_large_allocation_huge_page_threshold.store(
+      policy.huge_page_threshold, std::memory_order_relaxed);
+}
+
 namespace sync_io {
 
 // --------
 
 DynIOBuffer::DynIOBuffer(uint64_t max_incl)
-    : m_buf(wuffs_base__empty_io_buffer()), m_max_incl(max_incl) {}
+    : m_buf(wuffs_base__empty_io_buffer()),
+      m_max_incl(max_incl),
+      m_size_hint(0) {}
 
 DynIOBuffer::~DynIOBuffer() {
   if (m_buf.data.ptr) {
-    free(m_buf.data.ptr);
+    Free(m_buf.data.ptr);
   }
 }
 
 void  //
 DynIOBuffer::drop() {
   if (m_buf.data.ptr) {
-    free(m_buf.data.ptr);
+    Free(m_buf.data.ptr);
   }
   m_buf = wuffs_base__empty_io_buffer();
 }
@@ -45,12 +169,15 @@ DynIOBuffer::drop() {
 DynIOBuffer::GrowResult  //
 DynIOBuffer::grow(uint64_t min_incl) {
   uint64_t n = round_up(min_incl, m_max_incl);
+  if ((n != 0) && (min_incl <= m_size_hint)) {
+    n = (m_size_hint < m_max_incl) ? m_size_hint : m_max_incl;
+  }
   if (n == 0) {
     return ((min_incl == 0) && (m_max_incl == 0))
                ? DynIOBuffer::GrowResult::OK
                : DynIOBuffer::GrowResult::FailedMaxInclExceeded;
   } else if (n > m_buf.data.len) {
-    uint8_t* ptr = static_cast<uint8_t*>(realloc(m_buf.data.ptr, n));
+    uint8_t* ptr = static_cast<uint8_t*>(Realloc(m_buf.data.ptr, n));
     if (!ptr) {
       return DynIOBuffer::GrowResult::FailedOutOfMemory;
     }
@@ -60,6 +187,11 @@ DynIOBuffer::grow(uint64_t min_incl) {
   return DynIOBuffer::GrowResult::OK;
 }
 
+void  //
+DynIOBuffer::set_size_hint(uint64_t size_hint) {
+  m_size_hint = size_hint;
+}
+
 // round_up rounds min_incl up, returning the smallest value x satisfying
 // (min_incl <= x) and (x <= max_incl) and some other constraints. It returns 0
 // if there is no such x.
@@ -123,6 +255,89 @@ FileInput::CopyIn(IOBuffer* dst) {
 
 // --------
 
+MmapInput::MmapInput(FILE* f)
+    : FileInput(f),
+      m_mapped_ptr(nullptr),
+      m_mapped_len(0),
+      m_is_mapped(false),
+      m_io(wuffs_base__empty_io_buffer()) {
+#if defined(__APPLE__) || defined(__unix__)
+  if (!f) {
+    return;
+  }
+  long pos = ftell(f);
+  struct stat st;
+  if ((pos < 0) || (fstat(fileno(f), &st) != 0) || !S_ISREG(st.st_mode) ||
+      (st.st_size < pos) ||
+      (static_cast<uint64_t>(st.st_size) > static_cast<uint64_t>(SIZE_MAX))) {
+    return;
+  }
+  size_t len = static_cast<size_t>(st.st_size);
+  if (len > 0) {
+    void* ptr = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fileno(f), 0);
+    if (ptr == MAP_FAILED) {
+      return;
+    }
+    // The madvise calls are only hints. Their failure is not an error.
+    madvise(ptr, len, MADV_SEQUENTIAL);
+#if defined(MADV_HUGEPAGE)
+    madvise(ptr, len, MADV_HUGEPAGE);
+#endif
+    m_mapped_ptr = ptr;
+    m_mapped_len = len;
+  }
+  m_is_mapped = true;
+  m_io = wuffs_base__ptr_u8__reader(static_cast<uint8_t*>(m_mapped_ptr), len,
+                                    true);
+  m_io.meta.ri = static_cast<size_t>(pos);
+#endif
+}
+
+MmapInput::~MmapInput() {
+#if defined(__APPLE__) || defined(__unix__)
+  if (m_mapped_ptr) {
+    munmap(m_mapped_ptr, m_mapped_len);
+  }
+#endif
+}
+
+IOBuffer*  //
+MmapInput::BringsItsOwnIOBuffer() {
+  return m_is_mapped ? &m_io : nullptr;
+}
+
+std::string  //
+MmapInput::CopyIn(IOBuffer* dst) {
+  if (!m_is_mapped) {
+    return FileInput::CopyIn(dst);
+  } else if (!dst) {
+    return "wuffs_aux::sync_io::MmapInput: nullptr IOBuffer";
+  } else if (dst->meta.closed) {
+    return "wuffs_aux::sync_io::MmapInput: end of file";
+  } else if (wuffs_base__slice_u8__overlaps(dst->data, m_io.data)) {
+    // Treat m_io's data as immutable, so don't compact dst or otherwise write
+    // to it.
+    return "wuffs_aux::sync_io::MmapInput: overlapping buffers";
+  } else {
+    dst->compact();
+    size_t nd = dst->writer_length();
+    size_t ns = m_io.reader_length();
+    size_t n = (nd < ns) ? nd : ns;
+    memcpy(dst->writer_pointer(), m_io.reader_pointer(), n);
+    m_io.meta.ri += n;
+    dst->meta.wi += n;
+    dst->meta.closed = m_io.reader_length() == 0;
+  }
+  return "";
+}
+
+bool  //
+MmapInput::is_mapped() const {
+  return m_is_mapped;
+}
+
+// --------
+
 MemoryInput::MemoryInput(const char* ptr, size_t len)
     : m_io(wuffs_base__ptr_u8__reader(
           static_cast<uint8_t*>(static_cast<void*>(const_cast<char*>(ptr))),
@@ -162,6 +377,158 @@ MemoryInput::CopyIn(IOBuffer* dst) {
 
 // --------
 
+TransformInput::TransformInput(Input& src,
+                               wuffs_base__io_transformer* transformer,
+                               size_t src_buffer_size)
+    : m_src(src),
+      m_transformer(transformer),
+      m_src_array(nullptr, &Free),
+      m_workbuf_array(nullptr, &Free),
+      m_src_fallback_io(wuffs_base__empty_io_buffer()),
+      m_src_io(src.BringsItsOwnIOBuffer()),
+      m_workbuf(wuffs_base__empty_slice_u8()) {
+  if (!m_transformer) {
+    m_error_message = "wuffs_aux::sync_io::TransformInput: nullptr transformer";
+    return;
+  }
+
+  uint64_t workbuf_len = m_transformer->workbuf_len().max_incl;
+  if (workbuf_len > SIZE_MAX) {
+    m_error_message = "wuffs_aux::sync_io::TransformInput: out of memory";
+    return;
+  } else if (workbuf_len > 0) {
+    m_workbuf_array = MemOwner(Malloc(static_cast<size_t>(workbuf_len)), &Free);
+    if (!m_workbuf_array) {
+      m_error_message = "wuffs_aux::sync_io::TransformInput: out of memory";
+      return;
+    }
+    m_workbuf =
+        wuffs_base__make_slice_u8(static_cast<uint8_t*>(m_workbuf_array.get()),
+                                  static_cast<size_t>(workbuf_len));
+  }
+
+  if (!m_src_io) {
+    if (src_buffer_size == 0) {
+      src_buffer_size = 65536;
+    }
+    m_src_array = MemOwner(Malloc(src_buffer_size), &Free);
+    if (!m_src_array) {
+      m_error_message = "wuffs_aux::sync_io::TransformInput: out of memory";
+      return;
+    }
+    m_src_fallback_io = wuffs_base__ptr_u8__writer(
+        static_cast<uint8_t*>(m_src_array.get()), src_buffer_size);
+    m_src_io = &m_src_fallback_io;
+  }
+}
+
+std::string  //
+TransformInput::CopyIn(IOBuffer* dst) {
+  if (!m_error_message.empty()) {
+    return m_error_message;
+  } else if (!dst) {
+    return "wuffs_aux::sync_io::TransformInput: nullptr IOBuffer";
+  } else if (dst->meta.closed) {
+    return "wuffs_aux::sync_io::TransformInput: end of file";
+  } else if (wuffs_base__slice_u8__overlaps(dst->data, m_src_io->data)) {
+    return "wuffs_aux::sync_io::TransformInput: overlapping buffers";
+  }
+
+  dst->compact();
+  while (true) {
+    wuffs_base__status status =
+        m_transformer->transform_io(dst, m_src_io, m_workbuf);
+    if (status.is_ok()) {
+      dst->meta.closed = true;
+      return "";
+    } else if (status.repr == wuffs_base__suspension__short_write) {
+      return "";
+    } else if (status.repr != wuffs_base__suspension__short_read) {
+      m_error_message = status.message();
+      return m_error_message;
+    } else if (m_src_io->meta.closed) {
+      m_error_message =
+          "wuffs_aux::sync_io::TransformInput: unexpected end of file";
+      return m_error_message;
+    }
+    std::string error_message = m_src.CopyIn(m_src_io);
+    if (!error_message.empty()) {
+      m_error_message = error_message;
+      return m_error_message;
+    }
+  }
+}
+
+// --------
+
+Output::~Output() {}
+
+IOBuffer*  //
+Output::BringsItsOwnIOBuffer() {
+  return nullptr;
+}
+
+// --------
+
+FileOutput::FileOutput(FILE* f) : m_f(f) {}
+
+std::string  //
+FileOutput::CopyOut(IOBuffer* src) {
+  if (!m_f) {
+    return "wuffs_aux::sync_io::FileOutput: nullptr file";
+  } else if (!src) {
+    return "wuffs_aux::sync_io::FileOutput: nullptr IOBuffer";
+  }
+  while (src->reader_length() > 0) {
+    size_t n = fwrite(src->reader_pointer(), 1, src->reader_length(), m_f);
+    src->meta.ri += n;
+    if (ferror(m_f)) {
+      return "wuffs_aux::sync_io::FileOutput: error writing file";
+    }
+  }
+  src->compact();
+  return "";
+}
+
+// --------
+
+MemoryOutput::MemoryOutput(char* ptr, size_t len)
+    : m_io(wuffs_base__ptr_u8__writer(
+          static_cast<uint8_t*>(static_cast<void*>(ptr)), len)) {}
+
+MemoryOutput::MemoryOutput(uint8_t* ptr, size_t len)
+    : m_io(wuffs_base__ptr_u8__writer(ptr, len)) {}
+
+IOBuffer*  //
+MemoryOutput::BringsItsOwnIOBuffer() {
+  return &m_io;
+}
+
+std::string  //
+MemoryOutput::CopyOut(IOBuffer* src) {
+  if (!src) {
+    return "wuffs_aux::sync_io::MemoryOutput: nullptr IOBuffer";
+  } else if (src == &m_io) {
+    // The bytes are already in place. Mark them as consumed, but don't
+    // compact, as that would move them.
+    m_io.meta.ri = m_io.meta.wi;
+    return "";
+  } else if (wuffs_base__slice_u8__overlaps(src->data, m_io.data)) {
+    return "wuffs_aux::sync_io::MemoryOutput: overlapping buffers";
+  }
+  size_t n = src->reader_length();
+  if (n > m_io.writer_length()) {
+    return "wuffs_aux::sync_io::MemoryOutput: out of space";
+  }
+  memcpy(m_io.writer_pointer(), src->reader_pointer(), n);
+  m_io.meta.wi += n;
+  src->meta.ri += n;
+  src->compact();
+  return "";
+}
+
+// --------
+
 }  // namespace sync_io
 
 namespace private_impl {
@@ -225,10 +592,19 @@ HandleMetadata(
     std::string (*handle_metadata_func)(void*,
                                         const wuffs_base__more_information*,
                                         wuffs_base__slice_u8),
+    std::string (*handle_metadata_ranges_func)(
+        void*,
+        const wuffs_base__more_information*,
+        const std::vector<wuffs_base__range_ie_u64>&),
     void* handle_metadata_receiver) {
   wuffs_base__more_information minfo = wuffs_base__empty_more_information();
   // Reset raw but keep its backing array (the raw.m_buf.data slice).
   raw.m_buf.meta = wuffs_base__empty_io_buffer_meta();
+  // With a non-null handle_metadata_ranges_func, RAW_PASSTHROUGH metadata is
+  // skipped over instead of copied into raw, and its (coalesced) I/O position
+  // ranges are collected here.
+  std::vector<wuffs_base__range_ie_u64> ranges;
+  bool passthrough = false;
 
   while (true) {
     minfo = wuffs_base__empty_more_information();
@@ -242,8 +618,24 @@ HandleMetadata(
 
       case WUFFS_BASE__MORE_INFORMATION__FLAVOR__METADATA_RAW_PASSTHROUGH: {
         wuffs_base__range_ie_u64 r = minfo.metadata_raw_passthrough__range();
+        passthrough = true;
         if (r.is_empty()) {
           break;
+        } else if (handle_metadata_ranges_func) {
+          if (io_buf.reader_position() > r.min_incl) {
+            return error_messages.resolve(error_messages.unsupported_metadata);
+          }
+          std::string error_message =
+              AdvanceIOBufferTo(error_messages, input, io_buf, r.max_excl);
+          if (!error_message.empty()) {
+            return error_message;
+          } else if (!ranges.empty() &&
+                     (ranges.back().max_excl == r.min_incl)) {
+            ranges.back().max_excl = r.max_excl;
+          } else {
+            ranges.push_back(r);
+          }
+          break;
         }
         uint64_t num_to_copy = r.length();
         if (num_to_copy > (raw.m_max_incl - raw.m_buf.meta.wi)) {
@@ -316,6 +708,10 @@ HandleMetadata(
     }
   }
 
+  if (passthrough && handle_metadata_ranges_func) {
+    return (*handle_metadata_ranges_func)(handle_metadata_receiver, &minfo,
+                                          ranges);
+  }
   return (*handle_metadata_func)(handle_metadata_receiver, &minfo,
                                  raw.m_buf.reader_slice());
 }
@@ -19,6 +19,7 @@
 
 #include <stdio.h>
 
+#include <atomic>
 #include <string>
 
 namespace wuffs_aux {
@@ -32,6 +33,83 @@ using IOBuffer = wuffs_base__io_buffer;
 // nullptr, since calling free(nullptr) is a no-op.
 using MemOwner = std::unique_ptr<void, decltype(&free)>;
 
+// --------
+
+// Allocator is the set of malloc-like functions that the auxiliary code uses
+// for the memory that it allocates itself, such as DynIOBuffer's byte array,
+// DecodeCbor's and DecodeJson's fallback I/O arrays and the default
+// DecodeImageCallbacks::AllocEtc implementations. Such memory is paired (in a
+// MemOwner or otherwise) with wuffs_aux::Free, which calls the free_func.
+//
+// It does not cover the Wuffs decoders themselves (the C code's
+// wuffs_foo__bar__alloc functions use calloc) or the std::vector and
+// std::thread objects used by the Parallel etc functions.
+//
+// A nullptr function means the C standard library's malloc, calloc, realloc
+// or free.
+struct Allocator {
+  void* (*malloc_func)(size_t n);
+  void* (*calloc_func)(size_t n, size_t size);
+  void* (*realloc_func)(void* ptr, size_t n);
+  void (*free_func)(void* ptr);
+};
+
+// SetAllocator sets the process-wide Allocator. It is not thread-safe and,
+// since memory allocated by one Allocator has to be freed by the same one,
+// should be called once, before any other auxiliary code runs.
+void  //
+SetAllocator(const Allocator& allocator);
+
+// AllocatorStats counts the auxiliary code's calls to the Malloc, Calloc and
+// Realloc functions below (and the bytes requested by those calls) since the
+// program started. The difference in stats before and after a DecodeImage
+// (or DecodeCbor, DecodeJson, etc) call, run on a single thread, measures
+// that call's allocations.
+struct AllocatorStats {
+  uint64_t num_allocations;
+  uint64_t num_bytes;
+};
+
+AllocatorStats  //
+GetAllocatorStats();
+
+// Malloc, Calloc, Realloc and Free call the SetAllocator functions (or their
+// C standard library defaults), updating the GetAllocatorStats counters.
+void*  //
+Malloc(size_t n);
+void*  //
+Calloc(size_t n, size_t size);
+void*  //
+Realloc(void* ptr, size_t n);
+void  //
+Free(void* ptr) noexcept;
+
+// LargeAllocationPolicy is how the Malloc, Calloc and Realloc functions above
+// treat large allocations, such as a 4K or 8K image's pixel buffer or a big
+// DynIOBuffer. For those, the cost of TLB misses and of taking one page fault
+// per (typically 4 KiB) page can be comparable to the cost of decoding.
+//
+// A zero huge_page_threshold, the default, disables the policy. Otherwise,
+// each successful allocation of at least that many bytes is advised (via
+// madvise's MADV_HUGEPAGE) to be backed by transparent huge pages (typically
+// 2 MiB). If prefault is true, its pages are also pre-faulted (via madvise's
+// MADV_POPULATE_WRITE) in a single system call, instead of one page fault at a
+// time as the decoder first touches them. These are only hints: on platforms
+// or kernels without those madvise flags, they have no effect.
+//
+// A huge_page_threshold of 2 MiB (the huge page size) is a reasonable choice.
+// Smaller allocations rarely span a whole, aligned huge page.
+struct LargeAllocationPolicy {
+  uint64_t huge_page_threshold;
+  bool prefault;
+};
+
+// SetLargeAllocationPolicy sets the process-wide LargeAllocationPolicy. Unlike
+// SetAllocator, it is thread-safe and can be called at any time. It affects
+// subsequent allocations, whichever Allocator they use.
+void  //
+SetLargeAllocationPolicy(const LargeAllocationPolicy& policy);
+
 namespace sync_io {
 
 // --------
@@ -81,9 +159,24 @@ class DynIOBuffer {
   // max_incl. It returns FailedMaxInclExceeded if that would require
   // allocating more than max_incl bytes, including the case where (min_incl >
   // max_incl). It returns FailedOutOfMemory if memory allocation failed.
+  //
+  // By default, the size is rounded up to a power of 2, so that growing one
+  // byte at a time still only allocates (and copies) O(log(N)) times.
+  // Like other Realloc calls, large arrays follow the LargeAllocationPolicy.
   GrowResult grow(uint64_t min_incl);
 
+  // set_size_hint sets the expected final size of the byte array, e.g. from a
+  // file format's header or trailer. While min_incl is at most the hint, grow
+  // rounds up to exactly the hint (capped by max_incl) instead of to a power
+  // of 2, so that a correct hint means a single allocation and no copying. An
+  // incorrect hint costs memory or extra allocations but it is not an error:
+  // grow still ensures that the size is at least min_incl. Zero, the default,
+  // means no hint.
+  void set_size_hint(uint64_t size_hint);
+
  private:
+  uint64_t m_size_hint;
+
   // Delete the copy and assign constructors.
   DynIOBuffer(const DynIOBuffer&) = delete;
   DynIOBuffer& operator=(const DynIOBuffer&) = delete;
@@ -122,6 +215,46 @@ class FileInput : public Input {
 
 // --------
 
+// MmapInput is an Input that reads from a file source by memory-mapping it.
+// Like MemoryInput, it brings its own IOBuffer, so that consumers like
+// DecodeImage, DecodeJson and DecodeCbor read the file's bytes in place,
+// instead of copying them (via fread) into a separate buffer.
+//
+// The file is mapped (read-only) at construction, from its start. Any bytes
+// before the FILE's current position (ftell) are marked as already read. The
+// mapping is advised for sequential access (and, where supported, for huge
+// pages) and is removed when the MmapInput is destroyed.
+//
+// If the file cannot be mapped (e.g. it is a pipe or a terminal, instead of a
+// regular file, or the platform does not support mmap), an MmapInput falls
+// back to behaving like a FileInput: BringsItsOwnIOBuffer returns nullptr and
+// CopyIn reads from the file. The is_mapped method distinguishes the two.
+//
+// It does not take responsibility for closing the file when done. The file
+// should not be modified (e.g. truncated) while the MmapInput exists.
+class MmapInput : public FileInput {
+ public:
+  MmapInput(FILE* f);
+  virtual ~MmapInput();
+
+  virtual IOBuffer* BringsItsOwnIOBuffer();
+  virtual std::string CopyIn(IOBuffer* dst);
+
+  bool is_mapped() const;
+
+ private:
+  void* m_mapped_ptr;
+  size_t m_mapped_len;
+  bool m_is_mapped;
+  IOBuffer m_io;
+
+  // Delete the copy and assign constructors.
+  MmapInput(const MmapInput&) = delete;
+  MmapInput& operator=(const MmapInput&) = delete;
+};
+
+// --------
+
 // MemoryInput is an Input that reads from an in-memory source.
 //
 // It does not take responsibility for freeing the memory when done.
@@ -143,6 +276,115 @@ class MemoryInput : public Input {
 
 // --------
 
+// TransformInput is an Input that transforms (e.g. decompresses) another
+// Input on demand, so that a consumer like DecodeJson, DecodeCbor or
+// DecodeImage can read a ".json.gz" or similar file without first
+// decompressing all of it into memory.
+//
+// The transformer is any wuffs_base__io_transformer, such as a
+// wuffs_gzip__decoder, wuffs_zlib__decoder, wuffs_deflate__decoder or
+// (configured with its literal width quirk) wuffs_lzw__decoder. Each CopyIn
+// call runs the transformer straight into the consumer's IOBuffer (there is no
+// intermediate buffer for the transformed bytes), stopping when that IOBuffer
+// is full.
+//
+// The transformer's source bytes are read in place if src brings its own
+// IOBuffer (e.g. it is a MemoryInput or MmapInput). Otherwise, they are copied
+// in (via src.CopyIn) to a src_buffer_size byte buffer (zero means 64 KiB).
+// Either way, memory use is bounded by those fixed-size buffers and the
+// transformer's workbuf (e.g. a 32 KiB history, for deflate), not by the
+// length of the transformed data.
+//
+// It does not take responsibility for the src Input or for the transformer,
+// which should be freshly initialized (and configured) before the first
+// CopyIn call. Any source bytes after the end of the transformed stream (e.g.
+// after the first member of a multi-member gzip file) are ignored.
+class TransformInput : public Input {
+ public:
+  TransformInput(Input& src,
+                 wuffs_base__io_transformer* transformer,
+                 size_t src_buffer_size = 0);
+
+  virtual std::string CopyIn(IOBuffer* dst);
+
+ private:
+  Input& m_src;
+  wuffs_base__io_transformer* m_transformer;
+  MemOwner m_src_array;
+  MemOwner m_workbuf_array;
+  IOBuffer m_src_fallback_io;
+  IOBuffer* m_src_io;
+  wuffs_base__slice_u8 m_workbuf;
+  std::string m_error_message;
+
+  // Delete the copy and assign constructors.
+  TransformInput(const TransformInput&) = delete;
+  TransformInput& operator=(const TransformInput&) = delete;
+};
+
+// --------
+
+// Output is the counterpart of Input: a sink for bytes (the reader side of an
+// IOBuffer) that something like a wuffs_aux::JsonEncoder produces.
+class Output {
+ public:
+  virtual ~Output();
+
+  // BringsItsOwnIOBuffer returns an IOBuffer whose writer side the producer
+  // can write to directly, or nullptr if the Output has no such buffer (and
+  // the producer should use its own).
+  virtual IOBuffer* BringsItsOwnIOBuffer();
+
+  // CopyOut consumes all of src's readable bytes and then compacts src, making
+  // room for more writes. When src is the BringsItsOwnIOBuffer buffer, the
+  // bytes are already in place and CopyOut may be unable to make more room.
+  virtual std::string CopyOut(IOBuffer* src) = 0;
+};
+
+// --------
+
+// FileOutput is an Output that writes to a file sink.
+//
+// It does not take responsibility for closing (or flushing) the file when
+// done.
+class FileOutput : public Output {
+ public:
+  FileOutput(FILE* f);
+
+  virtual std::string CopyOut(IOBuffer* src);
+
+ private:
+  FILE* m_f;
+
+  // Delete the copy and assign constructors.
+  FileOutput(const FileOutput&) = delete;
+  FileOutput& operator=(const FileOutput&) = delete;
+};
+
+// --------
+
+// MemoryOutput is an Output that writes to an in-memory sink of fixed size.
+// The number of bytes written so far is BringsItsOwnIOBuffer()->meta.wi.
+//
+// It does not take responsibility for freeing the memory when done.
+class MemoryOutput : public Output {
+ public:
+  MemoryOutput(char* ptr, size_t len);
+  MemoryOutput(uint8_t* ptr, size_t len);
+
+  virtual IOBuffer* BringsItsOwnIOBuffer();
+  virtual std::string CopyOut(IOBuffer* src);
+
+ private:
+  IOBuffer m_io;
+
+  // Delete the copy and assign constructors.
+  MemoryOutput(const MemoryOutput&) = delete;
+  MemoryOutput& operator=(const MemoryOutput&) = delete;
+};
+
+// --------
+
 }  // namespace sync_io
 
 }  // namespace wuffs_aux
@@ -16,6 +16,9 @@
 
 #if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__AUX__CBOR)
 
+#include <atomic>
+#include <mutex>
+#include <thread>
 #include <utility>
 
 namespace wuffs_aux {
@@ -27,6 +30,16 @@ DecodeCborResult::DecodeCborResult(std::string&& error_message0,
 
 DecodeCborCallbacks::~DecodeCborCallbacks() {}
 
+std::string  //
+DecodeCborCallbacks::AppendBorrowedByteString(const char* ptr, size_t len) {
+  return AppendByteString(std::string(ptr, len));
+}
+
+std::string  //
+DecodeCborCallbacks::AppendBorrowedTextString(const char* ptr, size_t len) {
+  return AppendTextString(std::string(ptr, len));
+}
+
 void  //
 DecodeCborCallbacks::Done(DecodeCborResult& result,
                           sync_io::Input& input,
@@ -50,10 +63,16 @@ DecodeCbor(DecodeCborCallbacks& callbacks,
   // Prepare the wuffs_base__io_buffer and the resultant error_message.
   wuffs_base__io_buffer* io_buf = input.BringsItsOwnIOBuffer();
   wuffs_base__io_buffer fallback_io_buf = wuffs_base__empty_io_buffer();
-  std::unique_ptr<uint8_t[]> fallback_io_array(nullptr);
+  MemOwner fallback_io_array(nullptr, &Free);
   if (!io_buf) {
-    fallback_io_array = std::unique_ptr<uint8_t[]>(new uint8_t[4096]);
-    fallback_io_buf = wuffs_base__ptr_u8__writer(fallback_io_array.get(), 4096);
+    fallback_io_array = MemOwner(Malloc(4096), &Free);
+    if (!fallback_io_array) {
+      DecodeCborResult result("wuffs_aux::DecodeCbor: out of memory", 0);
+      callbacks.Done(result, input, fallback_io_buf);
+      return result;
+    }
+    fallback_io_buf = wuffs_base__ptr_u8__writer(
+        static_cast<uint8_t*>(fallback_io_array.get()), 4096);
     io_buf = &fallback_io_buf;
   }
   // cursor_index is discussed at
@@ -80,9 +99,12 @@ DecodeCbor(DecodeCborCallbacks& callbacks,
             &tok_array[0], (sizeof(tok_array) / sizeof(tok_array[0]))));
     wuffs_base__status tok_status = wuffs_base__make_status(nullptr);
 
-    // Prepare other state.
+    // Prepare other state. A string's bytes are either borrowed (pointing
+    // into io_buf) or, if they are not contiguous there, copied to str.
     int32_t depth = 0;
     std::string str;
+    const char* borrowed_ptr = nullptr;
+    size_t borrowed_len = 0;
     int64_t extension_category = 0;
     uint64_t extension_detail = 0;
 
@@ -225,17 +247,41 @@ DecodeCbor(DecodeCborCallbacks& callbacks,
                      WUFFS_BASE__TOKEN__VBD__STRING__CONVERT_1_DST_1_SRC_COPY) {
             const char* ptr =  // Convert from (uint8_t*).
                 static_cast<const char*>(static_cast<void*>(token_ptr));
-            str.append(ptr, static_cast<size_t>(token_len));
+            if (!str.empty()) {
+              str.append(ptr, static_cast<size_t>(token_len));
+            } else if (borrowed_len == 0) {
+              borrowed_ptr = ptr;
+              borrowed_len = static_cast<size_t>(token_len);
+            } else if ((borrowed_ptr + borrowed_len) == ptr) {
+              borrowed_len += static_cast<size_t>(token_len);
+            } else {
+              str.append(borrowed_ptr, borrowed_len);
+              str.append(ptr, static_cast<size_t>(token_len));
+              borrowed_len = 0;
+            }
           } else {
             goto fail;
           }
           if (token.continued()) {
+            // Getting the next token can compact io_buf, moving its bytes,
+            // but only when tok_buf is empty.
+            if ((borrowed_len > 0) && (tok_buf.meta.ri >= tok_buf.meta.wi)) {
+              str.append(borrowed_ptr, borrowed_len);
+              borrowed_len = 0;
+            }
             continue;
           }
+          if (borrowed_len == 0) {
+            borrowed_ptr = str.data();
+            borrowed_len = str.size();
+          }
           ret_error_message =
               (vbd & WUFFS_BASE__TOKEN__VBD__STRING__CHAIN_MUST_BE_UTF_8)
-                  ? callbacks.AppendTextString(std::move(str))
-                  : callbacks.AppendByteString(std::move(str));
+                  ? callbacks.AppendBorrowedTextString(borrowed_ptr,
+                                                       borrowed_len)
+                  : callbacks.AppendBorrowedByteString(borrowed_ptr,
+                                                       borrowed_len);
+          borrowed_len = 0;
           str.clear();
           goto parsed_a_value;
         }
@@ -248,6 +294,10 @@ DecodeCbor(DecodeCborCallbacks& callbacks,
               static_cast<uint32_t>(vbd));
           const char* ptr =  // Convert from (uint8_t*).
               static_cast<const char*>(static_cast<void*>(&u[0]));
+          if (borrowed_len > 0) {
+            str.append(borrowed_ptr, borrowed_len);
+            borrowed_len = 0;
+          }
           str.append(ptr, n);
           if (token.continued()) {
             continue;
@@ -369,6 +419,197 @@ done:
   return result;
 }
 
+// IndexCborSequence_Frame is an open container, or indefinite-length string,
+// on IndexCborSequence's stack. num_remaining is the number of child items
+// still to come, or UINT64_MAX for indefinite-length frames, which end with a
+// 0xFF break byte instead. string_major is the major type of an
+// indefinite-length string's chunks, or 0xFF for containers.
+struct IndexCborSequence_Frame {
+  uint64_t num_remaining;
+  uint8_t string_major;
+};
+
+std::string  //
+IndexCborSequence(std::vector<uint64_t>& offsets,
+                  const uint8_t* ptr,
+                  size_t len) {
+  std::vector<IndexCborSequence_Frame> stack;
+  // tagged is whether the previous header was a tag, which is part of the
+  // same item as the header that follows it.
+  bool tagged = false;
+  size_t i = 0;
+  while (true) {
+    if (!tagged) {
+      while (!stack.empty() && (stack.back().num_remaining == 0)) {
+        stack.pop_back();
+      }
+      if (stack.empty()) {
+        if (i >= len) {
+          break;
+        }
+        offsets.push_back(i);
+      }
+    }
+    if (i >= len) {
+      return "wuffs_aux::IndexCborSequence: unexpected end of file";
+    }
+    uint8_t c = ptr[i++];
+
+    if (tagged) {
+      tagged = false;
+    } else if (!stack.empty()) {
+      IndexCborSequence_Frame& f = stack.back();
+      if (f.num_remaining != UINT64_MAX) {
+        f.num_remaining--;
+      } else if (c == 0xFF) {
+        stack.pop_back();
+        continue;
+      } else if ((f.string_major != 0xFF) &&
+                 (((c >> 5) != f.string_major) || ((c & 31) == 31))) {
+        return "wuffs_aux::IndexCborSequence: invalid CBOR";
+      }
+    }
+
+    uint8_t major = c >> 5;
+    uint8_t minor = c & 31;
+    uint64_t arg = minor;
+    if (minor < 24) {
+      // No-op.
+    } else if (minor < 28) {
+      size_t n = static_cast<size_t>(1) << (minor - 24);
+      if (n > (len - i)) {
+        return "wuffs_aux::IndexCborSequence: unexpected end of file";
+      }
+      arg = 0;
+      for (; n > 0; n--) {
+        arg = (arg << 8) | ptr[i++];
+      }
+    } else if ((minor < 31) || (major < 2) || (major == 6) || (major == 7)) {
+      // Reserved values, indefinite-length integers or tags and a break byte
+      // outside of an indefinite-length frame are all invalid.
+      return "wuffs_aux::IndexCborSequence: invalid CBOR";
+    }
+
+    switch (major) {
+      case 2:
+      case 3:
+        if (minor == 31) {
+          stack.push_back({UINT64_MAX, major});
+        } else if (arg > (len - i)) {
+          return "wuffs_aux::IndexCborSequence: unexpected end of file";
+        } else {
+          i += static_cast<size_t>(arg);
+        }
+        break;
+      case 4:
+      case 5:
+        // Like DecodeCbor, count every container (even an empty one) but not
+        // indefinite-length strings towards the depth limit. Only containers
+        // are on the stack here, as strings' chunks cannot be containers.
+        if (stack.size() >= WUFFS_CBOR__DECODER_DEPTH_MAX_INCL) {
+          return "wuffs_aux::IndexCborSequence: unsupported recursion depth";
+        } else if (minor == 31) {
+          stack.push_back({UINT64_MAX, 0xFF});
+          break;
+        }
+        // Every child item is at least 1 byte long, and a map has 2 child
+        // items (a key and a value) per entry.
+        if ((arg > (len - i)) || ((major == 5) && ((arg * 2) > (len - i)))) {
+          return "wuffs_aux::IndexCborSequence: unexpected end of file";
+        } else if (arg > 0) {
+          stack.push_back({(major == 5) ? (arg * 2) : arg, 0xFF});
+        }
+        break;
+      case 6:
+        tagged = true;
+        break;
+    }
+  }
+  return "";
+}
+
+ParallelDecodeCborSequenceCallbacks::~ParallelDecodeCborSequenceCallbacks() {}
+
+std::string  //
+ParallelDecodeCborSequence(ParallelDecodeCborSequenceCallbacks& callbacks,
+                           const uint8_t* ptr,
+                           size_t len,
+                           const std::vector<uint64_t>& offsets,
+                           uint32_t num_threads,
+                           DecodeCborArgQuirks quirks) {
+  for (size_t k = 0; k < offsets.size(); k++) {
+    if ((offsets[k] >= len) || ((k > 0) && (offsets[k] <= offsets[k - 1]))) {
+      return "wuffs_aux::ParallelDecodeCborSequence: invalid offsets";
+    }
+  }
+
+  if (num_threads == 0) {
+    num_threads = std::thread::hardware_concurrency();
+    if (num_threads == 0) {
+      num_threads = 1;
+    }
+  }
+  if (num_threads > offsets.size()) {
+    num_threads = static_cast<uint32_t>(offsets.size());
+  }
+
+  // Workers claim items in order, via num_claimed. first_failed is the
+  // earliest failed item's index, or SIZE_MAX.
+  std::atomic<size_t> num_claimed(0);
+  std::atomic<size_t> first_failed(SIZE_MAX);
+  std::mutex mutex;
+  std::string error_message;
+
+  auto run_worker = [&]() {
+    while (true) {
+      size_t k = num_claimed.fetch_add(1);
+      if ((k >= offsets.size()) || (k > first_failed.load())) {
+        return;
+      }
+      size_t begin = static_cast<size_t>(offsets[k]);
+      size_t end = ((k + 1) < offsets.size())
+                       ? static_cast<size_t>(offsets[k + 1])
+                       : len;
+
+      std::string item_error_message;
+      std::unique_ptr<DecodeCborCallbacks> item_callbacks =
+          callbacks.NewItemCallbacks(k);
+      if (!item_callbacks) {
+        item_error_message =
+            "wuffs_aux::ParallelDecodeCborSequence: null callbacks";
+      } else {
+        sync_io::MemoryInput input(ptr + begin, end - begin);
+        DecodeCborResult result = DecodeCbor(*item_callbacks, input, quirks);
+        if (!result.error_message.empty()) {
+          item_error_message = std::move(result.error_message);
+        } else if (result.cursor_position != (end - begin)) {
+          item_error_message =
+              "wuffs_aux::ParallelDecodeCborSequence: invalid offsets";
+        }
+      }
+      if (item_error_message.empty()) {
+        continue;
+      }
+
+      std::lock_guard<std::mutex> lock(mutex);
+      if (k < first_failed.load()) {
+        first_failed.store(k);
+        error_message = std::move(item_error_message);
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (uint32_t t = 1; t < num_threads; t++) {
+    threads.emplace_back(run_worker);
+  }
+  run_worker();
+  for (auto& t : threads) {
+    t.join();
+  }
+  return error_message;
+}
+
 }  // namespace wuffs_aux
 
 #endif  // !defined(WUFFS_CONFIG__MODULES) ||
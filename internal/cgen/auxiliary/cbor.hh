@@ -14,6 +14,9 @@
 
 // ---------------- Auxiliary - CBOR
 
+#include <memory>
+#include <vector>
+
 namespace wuffs_aux {
 
 struct DecodeCborResult {
@@ -41,6 +44,20 @@ class DecodeCborCallbacks {
   virtual std::string AppendCborSimpleValue(uint8_t val) = 0;
   virtual std::string AppendCborTag(uint64_t val) = 0;
 
+  // AppendBorrowedXxxString are like AppendXxxString but the string is passed
+  // as a pointer and length, borrowed for the duration of the call. Do not
+  // keep a reference to ptr after it returns. When the string sits
+  // contiguously in the IOBuffer (e.g. it is not an indefinite-length string
+  // of several chunks), ptr points into that buffer and no copy is made.
+  // Otherwise, ptr points to a scratch buffer that is re-used across strings.
+  //
+  // DecodeCbor only calls these methods, not AppendXxxString directly.
+  // Callbacks implementations that want to avoid allocating a std::string per
+  // string token should override them. The default implementations copy to a
+  // std::string and call AppendXxxString.
+  virtual std::string AppendBorrowedByteString(const char* ptr, size_t len);
+  virtual std::string AppendBorrowedTextString(const char* ptr, size_t len);
+
   // Push and Pop are called for container nodes: CBOR arrays (lists) and CBOR
   // maps (dictionaries).
   //
@@ -99,4 +116,64 @@ DecodeCbor(DecodeCborCallbacks& callbacks,
            sync_io::Input& input,
            DecodeCborArgQuirks quirks = DecodeCborArgQuirks::DefaultValue());
 
+// IndexCborSequence walks an in-memory CBOR sequence (RFC 8742), a
+// concatenation of zero or more top-level CBOR data items, appending each
+// item's starting offset to offsets. Item i ends where item (i+1) starts or,
+// for the last item, at len.
+//
+// It only looks at each item's headers (the initial byte and its argument),
+// skipping over string contents and not emitting any tokens or callbacks, so
+// it is much faster than DecodeCbor. It checks the sequence's structure but
+// not e.g. that text strings are valid UTF-8 or that simple values are
+// well-formed: DecodeCbor (or ParallelDecodeCborSequence) still does that.
+//
+// Like DecodeCbor, it does not support nesting containers more deeply than
+// WUFFS_CBOR__DECODER_DEPTH_MAX_INCL.
+//
+// It returns an empty string on success or an error message otherwise. On
+// failure, offsets may have been partially appended to.
+std::string  //
+IndexCborSequence(std::vector<uint64_t>& offsets,
+                  const uint8_t* ptr,
+                  size_t len);
+
+// ParallelDecodeCborSequenceCallbacks are the callbacks for
+// ParallelDecodeCborSequence.
+class ParallelDecodeCborSequenceCallbacks {
+ public:
+  virtual ~ParallelDecodeCborSequenceCallbacks();
+
+  // NewItemCallbacks returns the DecodeCborCallbacks for the item_index'th
+  // item. That item is decoded (by DecodeCbor, whose Done method call sees
+  // that item's result) and then the returned object is destroyed, all on the
+  // same worker thread. NewItemCallbacks may be called concurrently, from any
+  // worker thread, and items may be decoded in any order.
+  //
+  // Returning nullptr stops ParallelDecodeCborSequence, which then returns an
+  // error.
+  virtual std::unique_ptr<DecodeCborCallbacks>  //
+  NewItemCallbacks(size_t item_index) = 0;
+};
+
+// ParallelDecodeCborSequence decodes an in-memory CBOR sequence, given the
+// item offsets found by IndexCborSequence (possibly on an earlier run, for
+// the same data). Each item is decoded as if by DecodeCbor.
+//
+// Unlike the rest of Wuffs, it is not single-threaded. Up to num_threads
+// (zero means std::thread::hardware_concurrency()) worker threads, the
+// calling thread being one of them, claim and decode items concurrently.
+// Each DecodeCbor call uses its own wuffs_cbor__decoder.
+//
+// It returns an empty string on success or an error message otherwise. After
+// an item fails, no later items are started, but earlier items may still be
+// decoded. The error message returned is that of the earliest failed item.
+std::string  //
+ParallelDecodeCborSequence(
+    ParallelDecodeCborSequenceCallbacks& callbacks,
+    const uint8_t* ptr,
+    size_t len,
+    const std::vector<uint64_t>& offsets,
+    uint32_t num_threads = 0,
+    DecodeCborArgQuirks quirks = DecodeCborArgQuirks::DefaultValue());
+
 }  // namespace wuffs_aux
@@ -0,0 +1,330 @@
+// Copyright 2022 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ---------------- Auxiliary - DOM
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__AUX__DOM)
+
+#include <vector>
+
+namespace wuffs_aux {
+
+bool  //
+DomNode::is_container() const {
+  return (m_kind == List) || (m_kind == Dict);
+}
+
+bool  //
+DomNode::is_string() const {
+  return (m_kind == ByteString) || (m_kind == TextString);
+}
+
+int64_t  //
+DomNode::as_i64() const {
+  return static_cast<int64_t>(m_value);
+}
+
+double  //
+DomNode::as_f64() const {
+  return wuffs_base__ieee_754_bit_representation__from_u64_to_f64(m_value);
+}
+
+Dom::Dom() : m_nodes(), m_arena(), m_stack() {}
+
+void  //
+Dom::reset() {
+  // The clear methods keep the std::vector and std::string capacities.
+  m_nodes.clear();
+  m_arena.clear();
+  m_stack.clear();
+}
+
+size_t  //
+Dom::next(size_t i) const {
+  while ((i < m_nodes.size()) && (m_nodes[i].m_kind == DomNode::CborTag)) {
+    i++;
+  }
+  if (i >= m_nodes.size()) {
+    return m_nodes.size();
+  }
+  const DomNode& node = m_nodes[i];
+  return i + (node.is_container() ? static_cast<size_t>(node.m_value) : 1);
+}
+
+size_t  //
+Dom::child(size_t i, uint32_t n) const {
+  if ((i >= m_nodes.size()) || !m_nodes[i].is_container() ||
+      (n >= m_nodes[i].m_count)) {
+    return npos;
+  }
+  size_t j = i + 1;
+  for (; n > 0; n--) {
+    j = next(j);
+  }
+  return j;
+}
+
+size_t  //
+Dom::find(size_t i, const char* key_ptr, size_t key_len) const {
+  if ((i >= m_nodes.size()) || (m_nodes[i].m_kind != DomNode::Dict)) {
+    return npos;
+  }
+  size_t j = i + 1;
+  for (uint32_t n = m_nodes[i].m_count / 2; n > 0; n--) {
+    const DomNode& key = m_nodes[j];
+    size_t v = next(j);
+    if ((key.m_kind == DomNode::TextString) && (key.m_count == key_len) &&
+        ((key_len == 0) ||
+         (memcmp(m_arena.data() + key.m_value, key_ptr, key_len) == 0))) {
+      return v;
+    }
+    j = next(v);
+  }
+  return npos;
+}
+
+const char*  //
+Dom::string_ptr(size_t i) const {
+  return m_arena.data() + m_nodes[i].m_value;
+}
+
+size_t  //
+Dom::string_len(size_t i) const {
+  return m_nodes[i].m_count;
+}
+
+const char DecodeDom_TooLarge[] =  //
+    "wuffs_aux::DecodeDom: too large";
+
+// --------
+
+namespace {
+
+// DecodeDom_FinishValue updates the parent container (if any) after a
+// complete value (a leaf node or a popped container node) was appended.
+std::string  //
+DecodeDom_FinishValue(Dom& dom) {
+  if (!dom.m_stack.empty()) {
+    DomNode& parent = dom.m_nodes[dom.m_stack.back()];
+    if (parent.m_count == 0xFFFFFFFF) {
+      return DecodeDom_TooLarge;
+    }
+    parent.m_count++;
+  }
+  return "";
+}
+
+std::string  //
+DecodeDom_AppendLeaf(Dom& dom, uint32_t kind, uint64_t value) {
+  DomNode node = {kind, 0, value};
+  dom.m_nodes.push_back(node);
+  // A CborTag applies to the next value, which will finish both of them.
+  return (kind == DomNode::CborTag) ? "" : DecodeDom_FinishValue(dom);
+}
+
+std::string  //
+DecodeDom_AppendString(Dom& dom, uint32_t kind, const char* ptr, size_t len) {
+  if (len > 0xFFFFFFFF) {
+    return DecodeDom_TooLarge;
+  }
+  DomNode node = {kind, static_cast<uint32_t>(len), dom.m_arena.size()};
+  dom.m_arena.append(ptr, len);
+  dom.m_nodes.push_back(node);
+  return DecodeDom_FinishValue(dom);
+}
+
+std::string  //
+DecodeDom_Push(Dom& dom, uint32_t flags) {
+  uint32_t kind = (flags & WUFFS_BASE__TOKEN__VBD__STRUCTURE__TO_DICT)
+                      ? DomNode::Dict
+                      : DomNode::List;
+  DomNode node = {kind, 0, 1};
+  dom.m_stack.push_back(dom.m_nodes.size());
+  dom.m_nodes.push_back(node);
+  return "";
+}
+
+std::string  //
+DecodeDom_Pop(Dom& dom, uint32_t flags) {
+  if (dom.m_stack.empty()) {
+    return "wuffs_aux::DecodeDom: internal error: bad depth";
+  }
+  size_t i = dom.m_stack.back();
+  dom.m_stack.pop_back();
+  dom.m_nodes[i].m_value = dom.m_nodes.size() - i;
+  return DecodeDom_FinishValue(dom);
+}
+
+}  // namespace
+
+// --------
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__AUX__JSON)
+
+namespace {
+
+class DecodeJsonDom_Callbacks : public DecodeJsonCallbacks {
+ public:
+  explicit DecodeJsonDom_Callbacks(Dom& dom) : m_dom(dom) {}
+
+  std::string AppendNull() override {
+    return DecodeDom_AppendLeaf(m_dom, DomNode::Null, 0);
+  }
+
+  std::string AppendBool(bool val) override {
+    return DecodeDom_AppendLeaf(m_dom, DomNode::Bool, val ? 1 : 0);
+  }
+
+  std::string AppendF64(double val) override {
+    return DecodeDom_AppendLeaf(
+        m_dom, DomNode::F64,
+        wuffs_base__ieee_754_bit_representation__from_f64_to_u64(val));
+  }
+
+  std::string AppendI64(int64_t val) override {
+    return DecodeDom_AppendLeaf(m_dom, DomNode::I64,
+                                static_cast<uint64_t>(val));
+  }
+
+  std::string AppendTextString(std::string&& val) override {
+    return DecodeDom_AppendString(m_dom, DomNode::TextString, val.data(),
+                                  val.size());
+  }
+
+  std::string AppendBorrowedTextString(const char* ptr, size_t len) override {
+    return DecodeDom_AppendString(m_dom, DomNode::TextString, ptr, len);
+  }
+
+  std::string Push(uint32_t flags) override {
+    return DecodeDom_Push(m_dom, flags);
+  }
+
+  std::string Pop(uint32_t flags) override {
+    return DecodeDom_Pop(m_dom, flags);
+  }
+
+ private:
+  Dom& m_dom;
+};
+
+}  // namespace
+
+DecodeJsonResult  //
+DecodeJsonDom(Dom& dom,
+              sync_io::Input& input,
+              DecodeJsonArgQuirks quirks,
+              DecodeJsonArgJsonPointer json_pointer) {
+  dom.reset();
+  DecodeJsonDom_Callbacks callbacks(dom);
+  return DecodeJson(callbacks, input, quirks, json_pointer);
+}
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) ||
+        // defined(WUFFS_CONFIG__MODULE__AUX__JSON)
+
+// --------
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__AUX__CBOR)
+
+namespace {
+
+class DecodeCborDom_Callbacks : public DecodeCborCallbacks {
+ public:
+  explicit DecodeCborDom_Callbacks(Dom& dom) : m_dom(dom) {}
+
+  std::string AppendNull() override {
+    return DecodeDom_AppendLeaf(m_dom, DomNode::Null, 0);
+  }
+
+  std::string AppendUndefined() override {
+    return DecodeDom_AppendLeaf(m_dom, DomNode::Undefined, 0);
+  }
+
+  std::string AppendBool(bool val) override {
+    return DecodeDom_AppendLeaf(m_dom, DomNode::Bool, val ? 1 : 0);
+  }
+
+  std::string AppendF64(double val) override {
+    return DecodeDom_AppendLeaf(
+        m_dom, DomNode::F64,
+        wuffs_base__ieee_754_bit_representation__from_f64_to_u64(val));
+  }
+
+  std::string AppendI64(int64_t val) override {
+    return DecodeDom_AppendLeaf(m_dom, DomNode::I64,
+                                static_cast<uint64_t>(val));
+  }
+
+  std::string AppendU64(uint64_t val) override {
+    return DecodeDom_AppendLeaf(m_dom, DomNode::U64, val);
+  }
+
+  std::string AppendByteString(std::string&& val) override {
+    return DecodeDom_AppendString(m_dom, DomNode::ByteString, val.data(),
+                                  val.size());
+  }
+
+  std::string AppendTextString(std::string&& val) override {
+    return DecodeDom_AppendString(m_dom, DomNode::TextString, val.data(),
+                                  val.size());
+  }
+
+  std::string AppendBorrowedByteString(const char* ptr, size_t len) override {
+    return DecodeDom_AppendString(m_dom, DomNode::ByteString, ptr, len);
+  }
+
+  std::string AppendBorrowedTextString(const char* ptr, size_t len) override {
+    return DecodeDom_AppendString(m_dom, DomNode::TextString, ptr, len);
+  }
+
+  std::string AppendMinus1MinusX(uint64_t val) override {
+    return DecodeDom_AppendLeaf(m_dom, DomNode::Minus1MinusX, val);
+  }
+
+  std::string AppendCborSimpleValue(uint8_t val) override {
+    return DecodeDom_AppendLeaf(m_dom, DomNode::CborSimpleValue, val);
+  }
+
+  std::string AppendCborTag(uint64_t val) override {
+    return DecodeDom_AppendLeaf(m_dom, DomNode::CborTag, val);
+  }
+
+  std::string Push(uint32_t flags) override {
+    return DecodeDom_Push(m_dom, flags);
+  }
+
+  std::string Pop(uint32_t flags) override {
+    return DecodeDom_Pop(m_dom, flags);
+  }
+
+ private:
+  Dom& m_dom;
+};
+
+}  // namespace
+
+DecodeCborResult  //
+DecodeCborDom(Dom& dom, sync_io::Input& input, DecodeCborArgQuirks quirks) {
+  dom.reset();
+  DecodeCborDom_Callbacks callbacks(dom);
+  return DecodeCbor(callbacks, input, quirks);
+}
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) ||
+        // defined(WUFFS_CONFIG__MODULE__AUX__CBOR)
+
+}  // namespace wuffs_aux
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) ||
+        // defined(WUFFS_CONFIG__MODULE__AUX__DOM)
@@ -0,0 +1,143 @@
+// Copyright 2022 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ---------------- Auxiliary - DOM
+
+#include <vector>
+
+namespace wuffs_aux {
+
+// DomNode is one node of a Dom. It is 16 bytes, regardless of its kind.
+struct DomNode {
+  enum Kind {
+    Null = 0,
+    Undefined = 1,
+    Bool = 2,
+    I64 = 3,
+    U64 = 4,
+    F64 = 5,
+    Minus1MinusX = 6,
+    ByteString = 7,
+    TextString = 8,
+    CborSimpleValue = 9,
+    CborTag = 10,
+    List = 11,
+    Dict = 12,
+  };
+
+  // m_kind is one of the Kind values.
+  uint32_t m_kind;
+
+  // m_count is, for a List or Dict, its number of children (for a Dict, that
+  // is twice its number of key-value pairs, keys and values alternating) and,
+  // for a ByteString or TextString, its length in bytes. It is zero for other
+  // kinds.
+  uint32_t m_count;
+
+  // m_value is, for a List or Dict, its subtree length: the number of nodes
+  // (including itself) that it and its descendents occupy. For a ByteString or
+  // TextString, it is the string's offset in the Dom's m_arena. For a Bool, it
+  // is 0 or 1. For a F64, it is the IEEE 754 bit representation. For other
+  // kinds, it is the value itself (for an I64, as a two's complement uint64_t).
+  uint64_t m_value;
+
+  bool is_container() const;
+  bool is_string() const;
+
+  int64_t as_i64() const;
+  double as_f64() const;
+};
+
+// Dom is a "tape" style document object model: a JSON or CBOR document's
+// nodes are stored contiguously (in m_nodes, in depth-first order, each
+// container node immediately followed by its children's subtrees) and its
+// strings' bytes are stored contiguously (in m_arena). Compared to a tree of
+// separately allocated std::map, std::vector and std::string objects, this
+// needs far fewer memory allocations and is more cache friendly.
+//
+// A container's subtree length is stored in the container node, so skipping
+// over it (to its next sibling) is O(1). A CborTag node applies to the node
+// that immediately follows it and is not counted as a separate child of its
+// parent: the tag and its tagged node are one subtree.
+//
+// Calling reset (explicitly, or implicitly by DecodeJsonDom or DecodeCborDom)
+// clears the Dom but keeps its allocated memory, so that re-using a Dom for a
+// sequence of similar documents will eventually stop allocating.
+class Dom {
+ public:
+  // npos is returned by the find and child methods when there is no match.
+  static constexpr size_t npos = static_cast<size_t>(-1);
+
+  std::vector<DomNode> m_nodes;
+  std::string m_arena;
+
+  // m_stack is scratch space used while building the Dom: the m_nodes
+  // indexes of the not-yet-closed containers.
+  std::vector<size_t> m_stack;
+
+  Dom();
+
+  // reset clears the Dom, without freeing its memory.
+  void reset();
+
+  // next returns the m_nodes index just after the subtree at index i, which is
+  // the index of i's next sibling if there is one.
+  size_t next(size_t i) const;
+
+  // child returns the m_nodes index of the n'th child of the List or Dict at
+  // index i. It returns npos if there is no such child.
+  size_t child(size_t i, uint32_t n) const;
+
+  // find returns the m_nodes index of the value for the first key (a
+  // TextString) equal to (key_ptr, key_len) in the Dict at index i. It
+  // returns npos if there is no such key.
+  size_t find(size_t i, const char* key_ptr, size_t key_len) const;
+
+  // string_ptr returns a pointer to the bytes of the ByteString or TextString
+  // at index i. It is invalidated by any subsequent modification of m_arena.
+  const char* string_ptr(size_t i) const;
+
+  // string_len returns the length of the ByteString or TextString at index i.
+  size_t string_len(size_t i) const;
+
+ private:
+  // Delete the copy and assign constructors.
+  Dom(const Dom&) = delete;
+  Dom& operator=(const Dom&) = delete;
+};
+
+extern const char DecodeDom_TooLarge[];
+
+// DecodeJsonDom resets dom and fills it from the JSON-formatted data in input.
+// Its arguments and result are like those of DecodeJson. On failure, dom is
+// left with whatever was decoded before the error and should not be
+// navigated.
+DecodeJsonResult  //
+DecodeJsonDom(Dom& dom,
+              sync_io::Input& input,
+              DecodeJsonArgQuirks quirks =
+                  DecodeJsonArgQuirks::DefaultValue(),
+              DecodeJsonArgJsonPointer json_pointer =
+                  DecodeJsonArgJsonPointer::DefaultValue());
+
+// DecodeCborDom resets dom and fills it from the CBOR-formatted data in input.
+// Its arguments and result are like those of DecodeCbor. On failure, dom is
+// left with whatever was decoded before the error and should not be
+// navigated.
+DecodeCborResult  //
+DecodeCborDom(Dom& dom,
+              sync_io::Input& input,
+              DecodeCborArgQuirks quirks = DecodeCborArgQuirks::DefaultValue());
+
+}  // namespace wuffs_aux
@@ -0,0 +1,894 @@
+// Copyright 2022 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ---------------- Auxiliary - Encode
+
+#if !defined(WUFFS_CONFIG__MODULES) || \
+    defined(WUFFS_CONFIG__MODULE__AUX__ENCODE)
+
+#include <vector>
+
+namespace wuffs_aux {
+
+const char JsonEncoder_BadDepth[] =  //
+    "wuffs_aux::JsonEncoder: bad depth";
+const char JsonEncoder_InvalidMapKey[] =  //
+    "wuffs_aux::JsonEncoder: invalid map key";
+const char JsonEncoder_OutputIsFull[] =  //
+    "wuffs_aux::JsonEncoder: output is full";
+const char CborEncoder_BadDepth[] =  //
+    "wuffs_aux::CborEncoder: bad depth";
+const char CborEncoder_OutputIsFull[] =  //
+    "wuffs_aux::CborEncoder: output is full";
+
+namespace {
+
+const char JsonEncoder_NewLineThen256Spaces[] =
+    "\n                                                                      "
+    "                                                                        "
+    "                                                                        "
+    "                                          ";
+
+const char JsonEncoder_NewLineThen256Tabs[] =
+    "\n\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t"
+    "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t"
+    "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t"
+    "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t"
+    "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t"
+    "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t"
+    "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t"
+    "\t\t\t\t\t";
+
+// JsonEncoder_FindEscape returns the index of the first byte in ptr[:len]
+// that needs escaping in a JSON string: '"', '\\' or an ASCII control code.
+// It returns len if there is no such byte.
+size_t  //
+JsonEncoder_FindEscape(const uint8_t* ptr, size_t len) {
+  size_t i = 0;
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY) && defined(__SSE2__)
+  // The SSE2 loop only finds which 16 byte chunk holds the first escape. The
+  // scalar loop below then finds where, within that chunk.
+  const __m128i quote = _mm_set1_epi8(+0x22);
+  const __m128i backslash = _mm_set1_epi8(+0x5C);
+  const __m128i x1f = _mm_set1_epi8(+0x1F);
+  for (; (len - i) >= 16; i += 16) {
+    __m128i x = _mm_loadu_si128(
+        static_cast<const __m128i*>(static_cast<const void*>(ptr + i)));
+    // A byte x is at most 0x1F if and only if (min(x, 0x1F) == x).
+    __m128i m = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(x, quote), _mm_cmpeq_epi8(x, backslash)),
+        _mm_cmpeq_epi8(_mm_min_epu8(x, x1f), x));
+    if (_mm_movemask_epi8(m) != 0) {
+      break;
+    }
+  }
+#endif
+
+  // This "SIMD within a register" loop works 8 bytes at a time. Each mask has
+  // a byte's high bit set if and only if that byte is less than 0x20, or
+  // equals '"', or equals '\\', given that (u ^ c) has a zero byte when u has
+  // a c byte. There may be false positives in the high bits of bytes after a
+  // true positive, but the any-byte-matches answer is exact.
+  for (; (len - i) >= 8; i += 8) {
+    uint64_t u = wuffs_base__peek_u64le__no_bounds_check(ptr + i);
+    uint64_t q = u ^ 0x2222222222222222u;
+    uint64_t b = u ^ 0x5C5C5C5C5C5C5C5Cu;
+    uint64_t m = ((u - 0x2020202020202020u) & ~u) |
+                 ((q - 0x0101010101010101u) & ~q) |
+                 ((b - 0x0101010101010101u) & ~b);
+    if ((m & 0x8080808080808080u) != 0) {
+      break;
+    }
+  }
+
+  for (; i < len; i++) {
+    uint8_t c = ptr[i];
+    if ((c == '"') || (c == '\\') || (c < 0x20)) {
+      break;
+    }
+  }
+  return i;
+}
+
+// JsonEncoder_Escape writes the JSON escape sequence for c (a byte that
+// JsonEncoder_FindEscape stopped at) to dst, returning its length.
+size_t  //
+JsonEncoder_Escape(uint8_t* dst, uint8_t c) {
+  dst[0] = '\\';
+  switch (c) {
+    case '"':
+    case '\\':
+      dst[1] = c;
+      return 2;
+    case '\b':
+      dst[1] = 'b';
+      return 2;
+    case '\t':
+      dst[1] = 't';
+      return 2;
+    case '\n':
+      dst[1] = 'n';
+      return 2;
+    case '\f':
+      dst[1] = 'f';
+      return 2;
+    case '\r':
+      dst[1] = 'r';
+      return 2;
+  }
+  static const char hex[] = "0123456789ABCDEF";
+  dst[1] = 'u';
+  dst[2] = '0';
+  dst[3] = '0';
+  dst[4] = static_cast<uint8_t>(hex[c >> 4]);
+  dst[5] = static_cast<uint8_t>(hex[c & 15]);
+  return 6;
+}
+
+}  // namespace
+
+// --------
+
+JsonEncoder::JsonEncoder(sync_io::Output& output,
+                         uint32_t flags,
+                         uint32_t spaces)
+    : m_output(output),
+      m_buf(output.BringsItsOwnIOBuffer()),
+      m_staging_buf(wuffs_base__ptr_u8__writer(&m_staging_array[0],
+                                               sizeof(m_staging_array))),
+      m_flushed_length(0),
+      m_flags(flags),
+      m_bytes_per_indent_depth((flags & FLAG_TABS) ? 1
+                               : (spaces <= 8)     ? spaces
+                                                   : 8),
+      m_new_line_then_256_indent_bytes((flags & FLAG_TABS)
+                                           ? JsonEncoder_NewLineThen256Tabs
+                                           : JsonEncoder_NewLineThen256Spaces),
+      m_depth(0),
+      m_ctx(Context::TopLevel),
+      m_cbor_tags() {
+  if (!m_buf) {
+    m_buf = &m_staging_buf;
+  }
+}
+
+std::string  //
+JsonEncoder::WriteSlow(const void* ptr, size_t len) {
+  const uint8_t* p = static_cast<const uint8_t*>(ptr);
+  while (len > 0) {
+    size_t n = m_buf->writer_length();
+    if (n == 0) {
+      std::string z = Flush();
+      if (!z.empty()) {
+        return z;
+      }
+      n = m_buf->writer_length();
+      if (n == 0) {
+        return JsonEncoder_OutputIsFull;
+      }
+    }
+    if (n > len) {
+      n = len;
+    }
+    memcpy(m_buf->writer_pointer(), p, n);
+    m_buf->meta.wi += n;
+    p += n;
+    len -= n;
+  }
+  return "";
+}
+
+inline std::string  //
+JsonEncoder::Write(const void* ptr, size_t len) {
+  if ((len > 0) && (len <= m_buf->writer_length())) {
+    memcpy(m_buf->writer_pointer(), ptr, len);
+    m_buf->meta.wi += len;
+    return "";
+  }
+  return WriteSlow(ptr, len);
+}
+
+std::string  //
+JsonEncoder::WriteIndent() {
+  uint32_t indent = m_depth * m_bytes_per_indent_depth;
+  std::string z =
+      Write(m_new_line_then_256_indent_bytes, 1 + (indent & 0xFF));
+  for (indent >>= 8; z.empty() && (indent > 0); indent--) {
+    z = Write(m_new_line_then_256_indent_bytes + 1, 0x100);
+  }
+  return z;
+}
+
+// WritePreamble writes any punctuation, whitespace and indentation that
+// precedes the next value (or key) and updates m_ctx. Afterwards, m_ctx is
+// InDictAfterKey if and only if that next value is a dict key.
+std::string  //
+JsonEncoder::WritePreamble() {
+  std::string z;
+  bool indent = false;
+  switch (m_ctx) {
+    case Context::TopLevel:
+      break;
+    case Context::InListAfterBracket:
+      m_ctx = Context::InListAfterValue;
+      indent = true;
+      break;
+    case Context::InListAfterValue:
+      z = Write(",", 1);
+      indent = true;
+      break;
+    case Context::InDictAfterBrace:
+      m_ctx = Context::InDictAfterKey;
+      indent = true;
+      break;
+    case Context::InDictAfterKey:
+      z = Write(": ", (m_flags & FLAG_INDENT) ? 2 : 1);
+      m_ctx = Context::InDictAfterValue;
+      break;
+    case Context::InDictAfterValue:
+      z = Write(",", 1);
+      m_ctx = Context::InDictAfterKey;
+      indent = true;
+      break;
+  }
+  if (z.empty() && indent && (m_flags & FLAG_INDENT)) {
+    z = WriteIndent();
+  }
+
+  if (z.empty() && !m_cbor_tags.empty()) {
+    for (uint64_t cbor_tag : m_cbor_tags) {
+      uint8_t buf[WUFFS_BASE__U64__BYTE_LENGTH__MAX_INCL];
+      size_t n = wuffs_base__render_number_u64(
+          wuffs_base__make_slice_u8(&buf[0], sizeof buf), cbor_tag,
+          WUFFS_BASE__RENDER_NUMBER_XXX__DEFAULT_OPTIONS);
+      if (!(z = Write("/*cbor:tag", 10)).empty() ||
+          !(z = Write(&buf[0], n)).empty() ||  //
+          !(z = Write("*/", 2)).empty()) {
+        break;
+      }
+    }
+    m_cbor_tags.clear();
+  }
+  return z;
+}
+
+std::string  //
+JsonEncoder::WriteNonKeyPreamble() {
+  std::string z = WritePreamble();
+  if (z.empty() && (m_ctx == Context::InDictAfterKey)) {
+    return JsonEncoder_InvalidMapKey;
+  }
+  return z;
+}
+
+// WriteNumber writes an integer's decimal digits, quoted if it is a dict key.
+std::string  //
+JsonEncoder::WriteNumber(const uint8_t* ptr, size_t len) {
+  std::string z = WritePreamble();
+  if (!z.empty()) {
+    return z;
+  } else if (m_ctx != Context::InDictAfterKey) {
+    return Write(ptr, len);
+  } else if (!(z = Write("\"", 1)).empty() ||  //
+             !(z = Write(ptr, len)).empty()) {
+    return z;
+  }
+  return Write("\"", 1);
+}
+
+std::string  //
+JsonEncoder::AppendNull() {
+  std::string z = WriteNonKeyPreamble();
+  return z.empty() ? Write("null", 4) : z;
+}
+
+std::string  //
+JsonEncoder::AppendUndefined() {
+  std::string z = WriteNonKeyPreamble();
+  if (!z.empty()) {
+    return z;
+  }
+  // JSON's closest approximation to "undefined" is "null".
+  if (m_flags & FLAG_CBOR_METADATA_AS_COMMENTS) {
+    return Write("/*cbor:undefined*/null", 22);
+  }
+  return Write("null", 4);
+}
+
+std::string  //
+JsonEncoder::AppendBool(bool val) {
+  std::string z = WriteNonKeyPreamble();
+  if (!z.empty()) {
+    return z;
+  }
+  return val ? Write("true", 4) : Write("false", 5);
+}
+
+std::string  //
+JsonEncoder::AppendF64(double val) {
+  std::string z = WriteNonKeyPreamble();
+  if (!z.empty()) {
+    return z;
+  }
+
+  uint8_t buf[64];
+  constexpr uint32_t precision = 0;
+  size_t n = wuffs_base__render_number_f64(
+      wuffs_base__make_slice_u8(&buf[0], sizeof buf), val, precision,
+      WUFFS_BASE__RENDER_NUMBER_FXX__JUST_ENOUGH_PRECISION);
+  if (!(m_flags & FLAG_INF_NAN_NUMBERS)) {
+    // JSON numbers don't include Infinities or NaNs. For such numbers, their
+    // IEEE 754 bit representation's 11 exponent bits are all on.
+    uint64_t u = wuffs_base__ieee_754_bit_representation__from_f64_to_u64(val);
+    if (((u >> 52) & 0x7FF) == 0x7FF) {
+      if ((m_flags & FLAG_CBOR_METADATA_AS_COMMENTS) &&
+          (!(z = Write("/*cbor:", 7)).empty() ||
+           !(z = Write(&buf[0], n)).empty() ||  //
+           !(z = Write("*/", 2)).empty())) {
+        return z;
+      }
+      return Write("null", 4);
+    }
+  }
+  return Write(&buf[0], n);
+}
+
+std::string  //
+JsonEncoder::AppendI64(int64_t val) {
+  uint8_t buf[WUFFS_BASE__I64__BYTE_LENGTH__MAX_INCL];
+  size_t n = wuffs_base__render_number_i64(
+      wuffs_base__make_slice_u8(&buf[0], sizeof buf), val,
+      WUFFS_BASE__RENDER_NUMBER_XXX__DEFAULT_OPTIONS);
+  return WriteNumber(&buf[0], n);
+}
+
+std::string  //
+JsonEncoder::AppendU64(uint64_t val) {
+  uint8_t buf[WUFFS_BASE__U64__BYTE_LENGTH__MAX_INCL];
+  size_t n = wuffs_base__render_number_u64(
+      wuffs_base__make_slice_u8(&buf[0], sizeof buf), val,
+      WUFFS_BASE__RENDER_NUMBER_XXX__DEFAULT_OPTIONS);
+  return WriteNumber(&buf[0], n);
+}
+
+std::string  //
+JsonEncoder::AppendByteString(const char* ptr, size_t len) {
+  std::string z = WritePreamble();
+  if (!z.empty()) {
+    return z;
+  } else if (m_flags & FLAG_CBOR_METADATA_AS_COMMENTS) {
+    z = Write("/*cbor:base64url*/\"", 19);
+  } else {
+    z = Write("\"", 1);
+  }
+  if (!z.empty()) {
+    return z;
+  }
+
+  // Base-64 encode directly into m_buf, flushing it whenever it fills up.
+  // Zero progress straight after a flush means that the output is full.
+  const uint8_t* p = static_cast<const uint8_t*>(static_cast<const void*>(ptr));
+  bool flushed = false;
+  while (true) {
+    constexpr bool closed = true;
+    wuffs_base__transform__output o = wuffs_base__base_64__encode(
+        m_buf->writer_slice(),
+        wuffs_base__make_slice_u8(const_cast<uint8_t*>(p), len), closed,
+        WUFFS_BASE__BASE_64__URL_ALPHABET);
+    m_buf->meta.wi += o.num_dst;
+    p += o.num_src;
+    len -= o.num_src;
+    if (o.status.repr == nullptr) {
+      break;
+    } else if (o.status.repr != wuffs_base__suspension__short_write) {
+      return o.status.message();
+    } else if (flushed && (o.num_src == 0)) {
+      return JsonEncoder_OutputIsFull;
+    } else if (!(z = Flush()).empty()) {
+      return z;
+    }
+    flushed = true;
+  }
+
+  return Write("\"", 1);
+}
+
+std::string  //
+JsonEncoder::AppendTextString(const char* ptr, size_t len) {
+  std::string z = WritePreamble();
+  if (!z.empty() || !(z = Write("\"", 1)).empty()) {
+    return z;
+  }
+
+  const uint8_t* p = static_cast<const uint8_t*>(static_cast<const void*>(ptr));
+  while (len > 0) {
+    size_t i = JsonEncoder_FindEscape(p, len);
+    if ((i > 0) && !(z = Write(p, i)).empty()) {
+      return z;
+    } else if (i == len) {
+      break;
+    }
+    uint8_t esc[8];
+    size_t n = JsonEncoder_Escape(&esc[0], p[i]);
+    if (!(z = Write(&esc[0], n)).empty()) {
+      return z;
+    }
+    p += i + 1;
+    len -= i + 1;
+  }
+
+  return Write("\"", 1);
+}
+
+std::string  //
+JsonEncoder::AppendMinus1MinusX(uint64_t val) {
+  val++;
+  if (val == 0) {
+    // See the cbor.TOKEN_VALUE_MINOR__MINUS_1_MINUS_X comment re overflow.
+    return WriteNumber(
+        static_cast<const uint8_t*>(
+            static_cast<const void*>("-18446744073709551616")),
+        21);
+  }
+  uint8_t buf[1 + WUFFS_BASE__U64__BYTE_LENGTH__MAX_INCL];
+  buf[0] = '-';
+  size_t n = wuffs_base__render_number_u64(
+      wuffs_base__make_slice_u8(&buf[1], sizeof buf - 1), val,
+      WUFFS_BASE__RENDER_NUMBER_XXX__DEFAULT_OPTIONS);
+  return WriteNumber(&buf[0], 1 + n);
+}
+
+std::string  //
+JsonEncoder::AppendCborSimpleValue(uint8_t val) {
+  std::string z = WriteNonKeyPreamble();
+  if (!z.empty()) {
+    return z;
+  } else if (!(m_flags & FLAG_CBOR_METADATA_AS_COMMENTS)) {
+    return Write("null", 4);
+  }
+  uint8_t buf[WUFFS_BASE__U64__BYTE_LENGTH__MAX_INCL];
+  size_t n = wuffs_base__render_number_u64(
+      wuffs_base__make_slice_u8(&buf[0], sizeof buf), val,
+      WUFFS_BASE__RENDER_NUMBER_XXX__DEFAULT_OPTIONS);
+  if (!(z = Write("/*cbor:simple", 13)).empty() ||
+      !(z = Write(&buf[0], n)).empty()) {
+    return z;
+  }
+  return Write("*/null", 6);
+}
+
+std::string  //
+JsonEncoder::AppendCborTag(uint64_t val) {
+  // A CBOR tag isn't a value. It decorates the upcoming value, so it is
+  // written (if at all) by that value's WritePreamble call.
+  if (m_flags & FLAG_CBOR_METADATA_AS_COMMENTS) {
+    m_cbor_tags.push_back(val);
+  }
+  return "";
+}
+
+std::string  //
+JsonEncoder::Push(uint32_t flags) {
+  std::string z = WriteNonKeyPreamble();
+  if (!z.empty()) {
+    return z;
+  } else if (m_depth == 0xFFFFFFFF) {
+    return JsonEncoder_BadDepth;
+  }
+  m_depth++;
+  bool to_list = flags & WUFFS_BASE__TOKEN__VBD__STRUCTURE__TO_LIST;
+  m_ctx = to_list ? Context::InListAfterBracket : Context::InDictAfterBrace;
+  return Write(to_list ? "[" : "{", 1);
+}
+
+std::string  //
+JsonEncoder::Pop(uint32_t flags) {
+  // No call to WritePreamble. We write the extra comma, outdent, etc.
+  // ourselves.
+  if (m_depth == 0) {
+    return JsonEncoder_BadDepth;
+  }
+  m_depth--;
+  std::string z;
+  if ((m_flags & FLAG_INDENT) && (m_ctx != Context::InListAfterBracket) &&
+      (m_ctx != Context::InDictAfterBrace)) {
+    if (((m_flags & FLAG_EXTRA_COMMA) && !(z = Write(",", 1)).empty()) ||
+        !(z = WriteIndent()).empty()) {
+      return z;
+    }
+  }
+  if (flags & WUFFS_BASE__TOKEN__VBD__STRUCTURE__TO_LIST) {
+    m_ctx = Context::InListAfterValue;
+  } else if (flags & WUFFS_BASE__TOKEN__VBD__STRUCTURE__TO_DICT) {
+    m_ctx = Context::InDictAfterValue;
+  } else {
+    m_ctx = Context::TopLevel;
+  }
+  return Write(
+      (flags & WUFFS_BASE__TOKEN__VBD__STRUCTURE__FROM_LIST) ? "]" : "}", 1);
+}
+
+std::string  //
+JsonEncoder::Flush() {
+  m_flushed_length += m_buf->reader_length();
+  return m_output.CopyOut(m_buf);
+}
+
+uint64_t  //
+JsonEncoder::num_bytes_written() const {
+  return m_flushed_length + m_buf->reader_length();
+}
+
+// --------
+
+CborEncoder::CborEncoder(sync_io::Output& output)
+    : m_output(output),
+      m_buf(output.BringsItsOwnIOBuffer()),
+      m_staging_buf(wuffs_base__ptr_u8__writer(&m_staging_array[0],
+                                               sizeof(m_staging_array))),
+      m_flushed_length(0),
+      m_depth(0) {
+  if (!m_buf) {
+    m_buf = &m_staging_buf;
+  }
+}
+
+std::string  //
+CborEncoder::WriteSlow(const void* ptr, size_t len) {
+  const uint8_t* p = static_cast<const uint8_t*>(ptr);
+  while (len > 0) {
+    size_t n = m_buf->writer_length();
+    if (n == 0) {
+      std::string z = Flush();
+      if (!z.empty()) {
+        return z;
+      }
+      n = m_buf->writer_length();
+      if (n == 0) {
+        return CborEncoder_OutputIsFull;
+      }
+    }
+    if (n > len) {
+      n = len;
+    }
+    memcpy(m_buf->writer_pointer(), p, n);
+    m_buf->meta.wi += n;
+    p += n;
+    len -= n;
+  }
+  return "";
+}
+
+inline std::string  //
+CborEncoder::Write(const void* ptr, size_t len) {
+  if ((len > 0) && (len <= m_buf->writer_length())) {
+    memcpy(m_buf->writer_pointer(), ptr, len);
+    m_buf->meta.wi += len;
+    return "";
+  }
+  return WriteSlow(ptr, len);
+}
+
+// WriteHeader writes the initial byte (and any following argument bytes) of a
+// CBOR data item with the given major type (0 ..= 7) and argument n.
+std::string  //
+CborEncoder::WriteHeader(uint8_t major_type, uint64_t n) {
+  uint8_t c[9];
+  uint8_t base = static_cast<uint8_t>(major_type << 5);
+  if (n < 0x18) {
+    c[0] = static_cast<uint8_t>(base | n);
+    return Write(&c[0], 1);
+  } else if (n <= 0xFF) {
+    c[0] = static_cast<uint8_t>(base | 0x18);
+    c[1] = static_cast<uint8_t>(n);
+    return Write(&c[0], 2);
+  } else if (n <= 0xFFFF) {
+    c[0] = static_cast<uint8_t>(base | 0x19);
+    wuffs_base__poke_u16be__no_bounds_check(&c[1], static_cast<uint16_t>(n));
+    return Write(&c[0], 3);
+  } else if (n <= 0xFFFFFFFF) {
+    c[0] = static_cast<uint8_t>(base | 0x1A);
+    wuffs_base__poke_u32be__no_bounds_check(&c[1], static_cast<uint32_t>(n));
+    return Write(&c[0], 5);
+  }
+  c[0] = static_cast<uint8_t>(base | 0x1B);
+  wuffs_base__poke_u64be__no_bounds_check(&c[1], n);
+  return Write(&c[0], 9);
+}
+
+std::string  //
+CborEncoder::AppendNull() {
+  return Write("\xF6", 1);
+}
+
+std::string  //
+CborEncoder::AppendUndefined() {
+  return Write("\xF7", 1);
+}
+
+std::string  //
+CborEncoder::AppendBool(bool val) {
+  return Write(val ? "\xF5" : "\xF4", 1);
+}
+
+std::string  //
+CborEncoder::AppendF64(double val) {
+  uint8_t c[9];
+  wuffs_base__lossy_value_u16 lv16 =
+      wuffs_base__ieee_754_bit_representation__from_f64_to_u16_truncate(val);
+  if (!lv16.lossy) {
+    c[0] = 0xF9;
+    wuffs_base__poke_u16be__no_bounds_check(&c[1], lv16.value);
+    return Write(&c[0], 3);
+  }
+  wuffs_base__lossy_value_u32 lv32 =
+      wuffs_base__ieee_754_bit_representation__from_f64_to_u32_truncate(val);
+  if (!lv32.lossy) {
+    c[0] = 0xFA;
+    wuffs_base__poke_u32be__no_bounds_check(&c[1], lv32.value);
+    return Write(&c[0], 5);
+  }
+  c[0] = 0xFB;
+  wuffs_base__poke_u64be__no_bounds_check(
+      &c[1], wuffs_base__ieee_754_bit_representation__from_f64_to_u64(val));
+  return Write(&c[0], 9);
+}
+
+std::string  //
+CborEncoder::AppendI64(int64_t val) {
+  return (val >= 0) ? WriteHeader(0, static_cast<uint64_t>(val))
+                    : WriteHeader(1, static_cast<uint64_t>(-(val + 1)));
+}
+
+std::string  //
+CborEncoder::AppendU64(uint64_t val) {
+  return WriteHeader(0, val);
+}
+
+std::string  //
+CborEncoder::AppendByteString(const char* ptr, size_t len) {
+  std::string z = WriteHeader(2, len);
+  return z.empty() ? Write(ptr, len) : z;
+}
+
+std::string  //
+CborEncoder::AppendTextString(const char* ptr, size_t len) {
+  std::string z = WriteHeader(3, len);
+  return z.empty() ? Write(ptr, len) : z;
+}
+
+std::string  //
+CborEncoder::AppendMinus1MinusX(uint64_t val) {
+  return WriteHeader(1, val);
+}
+
+std::string  //
+CborEncoder::AppendCborSimpleValue(uint8_t val) {
+  uint8_t c[2];
+  if (val < 0x18) {
+    c[0] = static_cast<uint8_t>(0xE0 | val);
+    return Write(&c[0], 1);
+  }
+  c[0] = 0xF8;
+  c[1] = val;
+  return Write(&c[0], 2);
+}
+
+std::string  //
+CborEncoder::AppendCborTag(uint64_t val) {
+  return WriteHeader(6, val);
+}
+
+std::string  //
+CborEncoder::Push(uint32_t flags) {
+  if (m_depth == 0xFFFFFFFF) {
+    return CborEncoder_BadDepth;
+  }
+  m_depth++;
+  return Write(
+      (flags & WUFFS_BASE__TOKEN__VBD__STRUCTURE__TO_LIST) ? "\x9F" : "\xBF",
+      1);
+}
+
+std::string  //
+CborEncoder::Pop(uint32_t flags) {
+  if (m_depth == 0) {
+    return CborEncoder_BadDepth;
+  }
+  m_depth--;
+  return Write("\xFF", 1);
+}
+
+std::string  //
+CborEncoder::Flush() {
+  m_flushed_length += m_buf->reader_length();
+  return m_output.CopyOut(m_buf);
+}
+
+uint64_t  //
+CborEncoder::num_bytes_written() const {
+  return m_flushed_length + m_buf->reader_length();
+}
+
+// --------
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__AUX__CBOR)
+
+namespace {
+
+class TranscodeCborToJson_Callbacks : public DecodeCborCallbacks {
+ public:
+  explicit TranscodeCborToJson_Callbacks(JsonEncoder& encoder)
+      : m_encoder(encoder) {}
+
+  std::string AppendNull() override { return m_encoder.AppendNull(); }
+
+  std::string AppendUndefined() override {
+    return m_encoder.AppendUndefined();
+  }
+
+  std::string AppendBool(bool val) override {
+    return m_encoder.AppendBool(val);
+  }
+
+  std::string AppendF64(double val) override {
+    return m_encoder.AppendF64(val);
+  }
+
+  std::string AppendI64(int64_t val) override {
+    return m_encoder.AppendI64(val);
+  }
+
+  std::string AppendU64(uint64_t val) override {
+    return m_encoder.AppendU64(val);
+  }
+
+  std::string AppendByteString(std::string&& val) override {
+    return m_encoder.AppendByteString(val.data(), val.size());
+  }
+
+  std::string AppendTextString(std::string&& val) override {
+    return m_encoder.AppendTextString(val.data(), val.size());
+  }
+
+  std::string AppendBorrowedByteString(const char* ptr, size_t len) override {
+    return m_encoder.AppendByteString(ptr, len);
+  }
+
+  std::string AppendBorrowedTextString(const char* ptr, size_t len) override {
+    return m_encoder.AppendTextString(ptr, len);
+  }
+
+  std::string AppendMinus1MinusX(uint64_t val) override {
+    return m_encoder.AppendMinus1MinusX(val);
+  }
+
+  std::string AppendCborSimpleValue(uint8_t val) override {
+    return m_encoder.AppendCborSimpleValue(val);
+  }
+
+  std::string AppendCborTag(uint64_t val) override {
+    return m_encoder.AppendCborTag(val);
+  }
+
+  std::string Push(uint32_t flags) override { return m_encoder.Push(flags); }
+
+  std::string Pop(uint32_t flags) override { return m_encoder.Pop(flags); }
+
+ private:
+  JsonEncoder& m_encoder;
+};
+
+}  // namespace
+
+DecodeCborResult  //
+TranscodeCborToJson(JsonEncoder& encoder,
+                    sync_io::Input& input,
+                    DecodeCborArgQuirks quirks) {
+  TranscodeCborToJson_Callbacks callbacks(encoder);
+  DecodeCborResult result = DecodeCbor(callbacks, input, quirks);
+  std::string z = encoder.Flush();
+  if (result.error_message.empty()) {
+    result.error_message = std::move(z);
+  }
+  return result;
+}
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) ||
+        // defined(WUFFS_CONFIG__MODULE__AUX__CBOR)
+
+// --------
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__AUX__JSON)
+
+namespace {
+
+// TranscodeJson_Callbacks' Encoder type is JsonEncoder or CborEncoder.
+template <typename Encoder>
+class TranscodeJson_Callbacks : public DecodeJsonCallbacks {
+ public:
+  explicit TranscodeJson_Callbacks(Encoder& encoder) : m_encoder(encoder) {}
+
+  std::string AppendNull() override { return m_encoder.AppendNull(); }
+
+  std::string AppendBool(bool val) override {
+    return m_encoder.AppendBool(val);
+  }
+
+  std::string AppendF64(double val) override {
+    return m_encoder.AppendF64(val);
+  }
+
+  std::string AppendI64(int64_t val) override {
+    return m_encoder.AppendI64(val);
+  }
+
+  std::string AppendTextString(std::string&& val) override {
+    return m_encoder.AppendTextString(val.data(), val.size());
+  }
+
+  std::string AppendBorrowedTextString(const char* ptr, size_t len) override {
+    return m_encoder.AppendTextString(ptr, len);
+  }
+
+  std::string Push(uint32_t flags) override { return m_encoder.Push(flags); }
+
+  std::string Pop(uint32_t flags) override { return m_encoder.Pop(flags); }
+
+ private:
+  Encoder& m_encoder;
+};
+
+template <typename Encoder>
+DecodeJsonResult  //
+TranscodeJson(Encoder& encoder,
+              sync_io::Input& input,
+              DecodeJsonArgQuirks quirks,
+              DecodeJsonArgJsonPointer json_pointer) {
+  TranscodeJson_Callbacks<Encoder> callbacks(encoder);
+  DecodeJsonResult result =
+      DecodeJson(callbacks, input, quirks, std::move(json_pointer));
+  std::string z = encoder.Flush();
+  if (result.error_message.empty()) {
+    result.error_message = std::move(z);
+  }
+  return result;
+}
+
+}  // namespace
+
+DecodeJsonResult  //
+TranscodeJsonToCbor(CborEncoder& encoder,
+                    sync_io::Input& input,
+                    DecodeJsonArgQuirks quirks,
+                    DecodeJsonArgJsonPointer json_pointer) {
+  return TranscodeJson(encoder, input, quirks, std::move(json_pointer));
+}
+
+DecodeJsonResult  //
+TranscodeJsonToJson(JsonEncoder& encoder,
+                    sync_io::Input& input,
+                    DecodeJsonArgQuirks quirks,
+                    DecodeJsonArgJsonPointer json_pointer) {
+  return TranscodeJson(encoder, input, quirks, std::move(json_pointer));
+}
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) ||
+        // defined(WUFFS_CONFIG__MODULE__AUX__JSON)
+
+}  // namespace wuffs_aux
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) ||
+        // defined(WUFFS_CONFIG__MODULE__AUX__ENCODE)
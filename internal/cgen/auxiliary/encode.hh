@@ -0,0 +1,231 @@
+// Copyright 2022 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ---------------- Auxiliary - Encode
+
+#include <vector>
+
+namespace wuffs_aux {
+
+// JsonEncoder writes JSON-formatted data to a sync_io::Output.
+//
+// Its AppendXxx, Push and Pop methods mirror the DecodeJsonCallbacks and
+// DecodeCborCallbacks methods (and take the same flags), so that it can be
+// driven by DecodeJson or DecodeCbor (see the TranscodeXxx functions below) as
+// well as called directly. Each method returns an empty string on success or
+// an error message otherwise. Once a method fails, the JsonEncoder should not
+// be used any further.
+//
+// Output is staged in a fixed size buffer (or in the sync_io::Output's own
+// IOBuffer) and the encoder does not allocate memory, other than for
+// FLAG_CBOR_METADATA_AS_COMMENTS' pending CBOR tags. Text strings are scanned
+// for bytes that need escaping 16 bytes at a time (using SSE2 on x86_64) and
+// unescaped runs are copied in bulk.
+//
+// Call Flush after the last value, to write any staged bytes.
+//
+// CBOR values that JSON cannot represent (undefined, simple values, infinite
+// and not-a-number floating point values) are written as null, unless the
+// FLAG_CBOR_METADATA_AS_COMMENTS or FLAG_INF_NAN_NUMBERS flags say otherwise.
+// CBOR tags are dropped. Byte strings are written as base64url text strings.
+// JSON map keys must be strings: integer keys like 123 are quoted to be
+// string keys like "123" and other keys are rejected.
+class JsonEncoder {
+ public:
+  // These are bits of the flags constructor argument.
+  //
+  // FLAG_INDENT writes each list element and dict entry on its own line,
+  // indented by the spaces constructor argument (0 ..= 8) per depth or, with
+  // FLAG_TABS, by one tab per depth. Without FLAG_INDENT, output is compact:
+  // it contains no whitespace outside of strings.
+  //
+  // FLAG_EXTRA_COMMA writes output like "[1,2,]", with a comma after the
+  // final element of a list or dict. It is ignored without FLAG_INDENT.
+  //
+  // FLAG_INF_NAN_NUMBERS writes Inf and NaN instead of a substitute null.
+  //
+  // FLAG_CBOR_METADATA_AS_COMMENTS writes CBOR tags, undefined and simple
+  // values as "/*comments*/".
+  //
+  // The last three flags are non-compliant with the JSON specification but
+  // many parsers accept such output.
+  static constexpr uint32_t FLAG_INDENT = 0x01;
+  static constexpr uint32_t FLAG_TABS = 0x02;
+  static constexpr uint32_t FLAG_EXTRA_COMMA = 0x04;
+  static constexpr uint32_t FLAG_INF_NAN_NUMBERS = 0x08;
+  static constexpr uint32_t FLAG_CBOR_METADATA_AS_COMMENTS = 0x10;
+
+  explicit JsonEncoder(sync_io::Output& output,
+                       uint32_t flags = 0,
+                       uint32_t spaces = 4);
+
+  std::string AppendNull();
+  std::string AppendUndefined();
+  std::string AppendBool(bool val);
+  std::string AppendF64(double val);
+  std::string AppendI64(int64_t val);
+  std::string AppendU64(uint64_t val);
+  std::string AppendByteString(const char* ptr, size_t len);
+  std::string AppendTextString(const char* ptr, size_t len);
+  std::string AppendMinus1MinusX(uint64_t val);
+  std::string AppendCborSimpleValue(uint8_t val);
+  std::string AppendCborTag(uint64_t val);
+
+  std::string Push(uint32_t flags);
+  std::string Pop(uint32_t flags);
+
+  // Flush writes any staged bytes to the sync_io::Output.
+  std::string Flush();
+
+  // num_bytes_written returns the total number of bytes written, including
+  // any staged bytes not yet flushed.
+  uint64_t num_bytes_written() const;
+
+ private:
+  enum Context {
+    TopLevel,
+    InListAfterBracket,
+    InListAfterValue,
+    InDictAfterBrace,
+    InDictAfterKey,
+    InDictAfterValue,
+  };
+
+  std::string WriteSlow(const void* ptr, size_t len);
+  inline std::string Write(const void* ptr, size_t len);
+  std::string WriteIndent();
+  std::string WritePreamble();
+  std::string WriteNonKeyPreamble();
+  std::string WriteNumber(const uint8_t* ptr, size_t len);
+
+  sync_io::Output& m_output;
+  IOBuffer* m_buf;
+  IOBuffer m_staging_buf;
+  uint64_t m_flushed_length;
+
+  const uint32_t m_flags;
+  const uint32_t m_bytes_per_indent_depth;
+  const char* m_new_line_then_256_indent_bytes;
+  uint32_t m_depth;
+  Context m_ctx;
+
+  std::vector<uint64_t> m_cbor_tags;
+
+  // m_staging_array backs m_staging_buf, used when the sync_io::Output does
+  // not bring its own IOBuffer.
+  uint8_t m_staging_array[4096];
+
+  // Delete the copy and assign constructors.
+  JsonEncoder(const JsonEncoder&) = delete;
+  JsonEncoder& operator=(const JsonEncoder&) = delete;
+};
+
+extern const char JsonEncoder_BadDepth[];
+extern const char JsonEncoder_InvalidMapKey[];
+extern const char JsonEncoder_OutputIsFull[];
+
+// CborEncoder writes CBOR-formatted data to a sync_io::Output.
+//
+// Like JsonEncoder, its AppendXxx, Push and Pop methods mirror the
+// DecodeJsonCallbacks and DecodeCborCallbacks methods, its output is staged in
+// a fixed size buffer and it does not allocate memory. Call Flush after the
+// last value, to write any staged bytes.
+//
+// Lists and dicts are written as indefinite-length CBOR arrays and maps, so
+// that their element counts need not be known in advance. Floating point
+// values are written in the shortest of the 16, 32 or 64 bit forms that is
+// lossless. The output is not canonicalized in the RFC 7049 Section 3.9 sense.
+class CborEncoder {
+ public:
+  explicit CborEncoder(sync_io::Output& output);
+
+  std::string AppendNull();
+  std::string AppendUndefined();
+  std::string AppendBool(bool val);
+  std::string AppendF64(double val);
+  std::string AppendI64(int64_t val);
+  std::string AppendU64(uint64_t val);
+  std::string AppendByteString(const char* ptr, size_t len);
+  std::string AppendTextString(const char* ptr, size_t len);
+  std::string AppendMinus1MinusX(uint64_t val);
+  std::string AppendCborSimpleValue(uint8_t val);
+  std::string AppendCborTag(uint64_t val);
+
+  std::string Push(uint32_t flags);
+  std::string Pop(uint32_t flags);
+
+  // Flush writes any staged bytes to the sync_io::Output.
+  std::string Flush();
+
+  // num_bytes_written returns the total number of bytes written, including
+  // any staged bytes not yet flushed.
+  uint64_t num_bytes_written() const;
+
+ private:
+  std::string WriteSlow(const void* ptr, size_t len);
+  inline std::string Write(const void* ptr, size_t len);
+  std::string WriteHeader(uint8_t major_type, uint64_t n);
+
+  sync_io::Output& m_output;
+  IOBuffer* m_buf;
+  IOBuffer m_staging_buf;
+  uint64_t m_flushed_length;
+
+  uint32_t m_depth;
+
+  // m_staging_array backs m_staging_buf, used when the sync_io::Output does
+  // not bring its own IOBuffer.
+  uint8_t m_staging_array[4096];
+
+  // Delete the copy and assign constructors.
+  CborEncoder(const CborEncoder&) = delete;
+  CborEncoder& operator=(const CborEncoder&) = delete;
+};
+
+extern const char CborEncoder_BadDepth[];
+extern const char CborEncoder_OutputIsFull[];
+
+// TranscodeCborToJson decodes the CBOR-formatted data in input, encoding it
+// with encoder (and then flushing encoder). Its input, quirks and result are
+// like those of DecodeCbor. Strings are passed from the decoder to the
+// encoder without copying, when they sit contiguously in the input buffer.
+DecodeCborResult  //
+TranscodeCborToJson(JsonEncoder& encoder,
+                    sync_io::Input& input,
+                    DecodeCborArgQuirks quirks =
+                        DecodeCborArgQuirks::DefaultValue());
+
+// TranscodeJsonToCbor decodes the JSON-formatted data in input, encoding it
+// with encoder (and then flushing encoder). Its input, quirks, json_pointer
+// and result are like those of DecodeJson.
+DecodeJsonResult  //
+TranscodeJsonToCbor(CborEncoder& encoder,
+                    sync_io::Input& input,
+                    DecodeJsonArgQuirks quirks =
+                        DecodeJsonArgQuirks::DefaultValue(),
+                    DecodeJsonArgJsonPointer json_pointer =
+                        DecodeJsonArgJsonPointer::DefaultValue());
+
+// TranscodeJsonToJson is like TranscodeJsonToCbor but it re-encodes as JSON,
+// e.g. to re-format (indent or compact) it. Numbers are parsed and re-rendered,
+// so that "1.50" becomes "1.5".
+DecodeJsonResult  //
+TranscodeJsonToJson(JsonEncoder& encoder,
+                    sync_io::Input& input,
+                    DecodeJsonArgQuirks quirks =
+                        DecodeJsonArgQuirks::DefaultValue(),
+                    DecodeJsonArgJsonPointer json_pointer =
+                        DecodeJsonArgJsonPointer::DefaultValue());
+
+}  // namespace wuffs_aux
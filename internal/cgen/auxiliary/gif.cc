@@ -0,0 +1,903 @@
+// Copyright 2022 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ---------------- Auxiliary - GIF
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__AUX__GIF)
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace wuffs_aux {
+
+ParallelDecodeGifCallbacks::~ParallelDecodeGifCallbacks() {}
+
+std::string  //
+ParallelDecodeGifCallbacks::ImageConfig(
+    const wuffs_base__image_config& image_config,
+    const std::vector<wuffs_base__frame_config>& frame_configs) {
+  return "";
+}
+
+GifCompositor::GifCompositor()
+    : m_canvas(),
+      m_canvas_pixbuf(wuffs_base__null_pixel_buffer()),
+      m_swizzler_palette(
+          WUFFS_BASE__PIXEL_FORMAT__INDEXED__PALETTE_BYTE_LENGTH),
+      m_dirty_rect(wuffs_base__empty_rect_ie_u32()),
+      m_previous(wuffs_base__null_frame_config()),
+      m_has_previous(false),
+      m_saved(),
+      m_saved_rect(wuffs_base__empty_rect_ie_u32()) {}
+
+std::string  //
+GifCompositor::reset(uint32_t width, uint32_t height) {
+  m_dirty_rect = wuffs_base__empty_rect_ie_u32();
+  m_has_previous = false;
+  m_saved_rect = wuffs_base__empty_rect_ie_u32();
+
+  uint64_t n = static_cast<uint64_t>(width) * height;
+  if (n > (SIZE_MAX / 4)) {
+    return "wuffs_aux::GifCompositor: image is too large";
+  }
+  m_canvas.resize(static_cast<size_t>(n * 4));
+  wuffs_base__pixel_config pixcfg;
+  pixcfg.set(WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+             WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, width, height);
+  wuffs_base__status status = m_canvas_pixbuf.set_from_slice(
+      &pixcfg, wuffs_base__make_slice_u8(m_canvas.data(), m_canvas.size()));
+  if (!status.is_ok()) {
+    return status.message();
+  }
+  return "";
+}
+
+std::string  //
+GifCompositor::composite(const wuffs_base__frame_config& frame_config,
+                         wuffs_base__pixel_buffer* src,
+                         wuffs_base__rect_ie_u32 frame_dirty_rect) {
+  if (!src) {
+    return "wuffs_aux::GifCompositor: invalid argument";
+  }
+  wuffs_base__rect_ie_u32 bounds = m_canvas_pixbuf.pixcfg.bounds();
+  size_t stride = 4 * static_cast<size_t>(m_canvas_pixbuf.pixcfg.width());
+
+  // Apply the previous frame's disposal, as example/gifplayer does.
+  if (!m_has_previous) {
+    m_canvas_pixbuf.set_color_u32_fill_rect(bounds,
+                                            frame_config.background_color());
+    m_dirty_rect = bounds;
+  } else {
+    m_dirty_rect = wuffs_base__empty_rect_ie_u32();
+    switch (m_previous.disposal()) {
+      case WUFFS_BASE__ANIMATION_DISPOSAL__RESTORE_BACKGROUND:
+        m_dirty_rect = m_previous.bounds().intersect(bounds);
+        m_canvas_pixbuf.set_color_u32_fill_rect(m_dirty_rect,
+                                                m_previous.background_color());
+        break;
+      case WUFFS_BASE__ANIMATION_DISPOSAL__RESTORE_PREVIOUS:
+        m_dirty_rect = m_saved_rect;
+        copy_rect(m_canvas.data(), stride, m_saved.data(),
+                  4 * static_cast<size_t>(m_saved_rect.width()), m_saved_rect);
+        break;
+    }
+  }
+  m_previous = frame_config;
+  m_has_previous = true;
+
+  // Only the pixels that this frame changes need saving for its
+  // restore-previous disposal.
+  wuffs_base__rect_ie_u32 r = frame_dirty_rect.intersect(bounds);
+  m_saved_rect = wuffs_base__empty_rect_ie_u32();
+  if (frame_config.disposal() ==
+      WUFFS_BASE__ANIMATION_DISPOSAL__RESTORE_PREVIOUS) {
+    m_saved_rect = r;
+    m_saved.resize(4 * static_cast<size_t>(r.width()) * r.height());
+    copy_rect(m_saved.data(), 4 * static_cast<size_t>(r.width()),
+              m_canvas.data(), stride, r);
+  }
+  m_dirty_rect = m_dirty_rect.unite(r);
+  if (r.is_empty()) {
+    return "";
+  }
+
+  // The swizzler converts src's palette (if any) to the canvas' pixel format,
+  // into m_swizzler_palette.
+  wuffs_base__pixel_format src_pixfmt = src->pixel_format();
+  uint32_t src_bits_per_pixel = src_pixfmt.bits_per_pixel();
+  if (!src_pixfmt.is_interleaved() || ((src_bits_per_pixel & 7) != 0) ||
+      (src->pixcfg.width() < r.max_excl_x) ||
+      (src->pixcfg.height() < r.max_excl_y)) {
+    return "wuffs_aux::GifCompositor: unsupported source pixel buffer";
+  }
+  wuffs_base__slice_u8 swizzler_palette = wuffs_base__make_slice_u8(
+      m_swizzler_palette.data(), m_swizzler_palette.size());
+  wuffs_base__pixel_swizzler swizzler;
+  wuffs_base__status status = swizzler.prepare(
+      m_canvas_pixbuf.pixel_format(), swizzler_palette, src_pixfmt,
+      src->palette(),
+      frame_config.overwrite_instead_of_blend()
+          ? WUFFS_BASE__PIXEL_BLEND__SRC
+          : WUFFS_BASE__PIXEL_BLEND__SRC_OVER);
+  if (!status.is_ok()) {
+    return status.message();
+  }
+  size_t src_bytes_per_pixel = src_bits_per_pixel / 8;
+  wuffs_base__table_u8 src_table = src->plane(0);
+  for (size_t y = r.min_incl_y; y < r.max_excl_y; y++) {
+    swizzler.swizzle_interleaved_from_slice(
+        wuffs_base__make_slice_u8(m_canvas.data() + (y * stride) +
+                                      (4 * static_cast<size_t>(r.min_incl_x)),
+                                  4 * static_cast<size_t>(r.width())),
+        swizzler_palette,
+        wuffs_base__make_slice_u8(
+            src_table.ptr + (y * src_table.stride) +
+                (src_bytes_per_pixel * static_cast<size_t>(r.min_incl_x)),
+            src_bytes_per_pixel * static_cast<size_t>(r.width())));
+  }
+  return "";
+}
+
+wuffs_base__pixel_buffer*  //
+GifCompositor::canvas() {
+  return &m_canvas_pixbuf;
+}
+
+wuffs_base__rect_ie_u32  //
+GifCompositor::dirty_rect() const {
+  return m_dirty_rect;
+}
+
+void  //
+GifCompositor::copy_rect(uint8_t* dst,
+                         size_t dst_stride,
+                         const uint8_t* src,
+                         size_t src_stride,
+                         wuffs_base__rect_ie_u32 r) {
+  if (r.is_empty()) {
+    return;
+  }
+  size_t n = 4 * static_cast<size_t>(r.width());
+  size_t canvas_stride =
+      4 * static_cast<size_t>(m_canvas_pixbuf.pixcfg.width());
+  // Exactly one of dst and src is the canvas, addressed by r's position. The
+  // other is packed, starting at r's top-left pixel.
+  size_t offset = (r.min_incl_y * canvas_stride) + (4 * r.min_incl_x);
+  if (dst == m_canvas.data()) {
+    dst += offset;
+  } else {
+    src += offset;
+  }
+  for (uint32_t y = r.min_incl_y; y < r.max_excl_y; y++) {
+    memcpy(dst, src, n);
+    dst += dst_stride;
+    src += src_stride;
+  }
+}
+
+namespace {
+
+// ParallelDecodeGif_Slot holds a decoded frame's palette indexes until that
+// frame is composited. The indexes buffer covers the whole image but only the
+// dirty_rect part of it is valid.
+struct ParallelDecodeGif_Slot {
+  ParallelDecodeGif_Slot();
+
+  bool finished;
+  std::vector<uint8_t> indexes;
+  std::vector<uint8_t> palette;
+  wuffs_base__rect_ie_u32 dirty_rect;
+  std::string error_message;
+};
+
+ParallelDecodeGif_Slot::ParallelDecodeGif_Slot()
+    : finished(false),
+      indexes(),
+      palette(),
+      dirty_rect(wuffs_base__empty_rect_ie_u32()),
+      error_message() {}
+
+// ParallelDecodeGif_State is shared by the ParallelDecodeGif worker threads.
+// The fields after m_mutex are guarded by it. m_compositor is only touched
+// by the (one) delivering thread.
+//
+// Every worker thread can composite and deliver finished frames (call
+// FrameDone) but only one thread does so at a time (the one that set
+// m_delivering), without holding m_mutex, so that the other workers can carry
+// on decoding.
+struct ParallelDecodeGif_State {
+  ParallelDecodeGif_State(ParallelDecodeGifCallbacks& callbacks,
+                          const uint8_t* ptr,
+                          size_t len,
+                          size_t window);
+
+  void run_worker();
+  void decode_frame(wuffs_gif__decoder* dec,
+                    IOBuffer* src,
+                    wuffs_base__slice_u8 workbuf,
+                    size_t frame_index,
+                    ParallelDecodeGif_Slot& slot);
+  void composite_frame(size_t frame_index, ParallelDecodeGif_Slot& slot);
+  void deliver(std::unique_lock<std::mutex>& lock);
+
+  ParallelDecodeGifCallbacks& m_callbacks;
+  const uint8_t* m_ptr;
+  const size_t m_len;
+  const size_t m_window;
+  wuffs_base__image_config m_image_config;
+  std::vector<wuffs_base__frame_config> m_frame_configs;
+
+  GifCompositor m_compositor;
+
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::string m_error_message;
+  size_t m_num_claimed;
+  size_t m_num_delivered;
+  size_t m_num_waiting;
+  bool m_delivering;
+
+  // m_ring is indexed by frame_index % m_window.
+  std::vector<ParallelDecodeGif_Slot> m_ring;
+};
+
+ParallelDecodeGif_State::ParallelDecodeGif_State(
+    ParallelDecodeGifCallbacks& callbacks,
+    const uint8_t* ptr,
+    size_t len,
+    size_t window)
+    : m_callbacks(callbacks),
+      m_ptr(ptr),
+      m_len(len),
+      m_window(window),
+      m_image_config(wuffs_base__null_image_config()),
+      m_frame_configs(),
+      m_compositor(),
+      m_error_message(),
+      m_num_claimed(0),
+      m_num_delivered(0),
+      m_num_waiting(0),
+      m_delivering(false),
+      m_ring(window) {}
+
+void  //
+ParallelDecodeGif_State::run_worker() {
+  // Each worker thread has its own wuffs_gif__decoder, which decodes the image
+  // config once and then seeks (with restart_frame) to each claimed frame.
+  std::string error_message;
+  wuffs_gif__decoder::unique_ptr dec = wuffs_gif__decoder::alloc();
+  std::vector<uint8_t> workbuf;
+  IOBuffer src =
+      wuffs_base__ptr_u8__reader(const_cast<uint8_t*>(m_ptr), m_len, true);
+  if (!dec) {
+    error_message = "wuffs_aux::ParallelDecodeGif: out of memory";
+  } else {
+    wuffs_base__status status = dec->decode_image_config(nullptr, &src);
+    if (!status.is_ok()) {
+      error_message = status.message();
+    } else {
+      workbuf.resize(dec->workbuf_len().max_incl);
+    }
+  }
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  if (!error_message.empty() && m_error_message.empty()) {
+    m_error_message = std::move(error_message);
+    if (m_num_waiting > 0) {
+      m_cv.notify_all();
+    }
+  }
+  while (true) {
+    // Bound how far the claimed frames can run ahead of the delivered ones,
+    // so that memory use does not grow with the number of frames.
+    while (m_error_message.empty() &&
+           (m_num_claimed < m_frame_configs.size()) &&
+           ((m_num_claimed - m_num_delivered) >= m_window)) {
+      m_num_waiting++;
+      m_cv.wait(lock);
+      m_num_waiting--;
+    }
+    if (!m_error_message.empty() ||
+        (m_num_claimed >= m_frame_configs.size())) {
+      return;
+    }
+
+    // No other thread touches this slot until it is marked finished.
+    size_t i = m_num_claimed++;
+    ParallelDecodeGif_Slot& slot = m_ring[i % m_window];
+
+    lock.unlock();
+    decode_frame(dec.get(), &src,
+                 wuffs_base__make_slice_u8(workbuf.data(), workbuf.size()), i,
+                 slot);
+    lock.lock();
+
+    slot.finished = true;
+    if (!m_delivering) {
+      deliver(lock);
+    }
+  }
+}
+
+void  //
+ParallelDecodeGif_State::decode_frame(wuffs_gif__decoder* dec,
+                                      IOBuffer* src,
+                                      wuffs_base__slice_u8 workbuf,
+                                      size_t frame_index,
+                                      ParallelDecodeGif_Slot& slot) {
+  slot.dirty_rect = wuffs_base__empty_rect_ie_u32();
+  slot.error_message.clear();
+
+  uint32_t width = m_image_config.pixcfg.width();
+  uint32_t height = m_image_config.pixcfg.height();
+  if (slot.indexes.empty()) {
+    slot.indexes.resize(static_cast<size_t>(width) * height);
+    slot.palette.resize(WUFFS_BASE__PIXEL_FORMAT__INDEXED__PALETTE_BYTE_LENGTH);
+  }
+  wuffs_base__pixel_config pixcfg;
+  pixcfg.set(WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_BINARY,
+             WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, width, height);
+  wuffs_base__pixel_buffer pixbuf;
+  wuffs_base__status status = pixbuf.set_interleaved(
+      &pixcfg,
+      wuffs_base__make_table_u8(slot.indexes.data(), width, height, width),
+      wuffs_base__make_slice_u8(slot.palette.data(), slot.palette.size()));
+  if (!status.is_ok()) {
+    slot.error_message = status.message();
+    return;
+  }
+
+  // The whole GIF file is in memory (and src->meta.pos is zero), so seeking
+  // to a frame's io_position just sets the read index.
+  uint64_t io_position = m_frame_configs[frame_index].io_position();
+  if (io_position > m_len) {
+    slot.error_message = "wuffs_aux::ParallelDecodeGif: bad io_position";
+    return;
+  }
+  src->meta.ri = static_cast<size_t>(io_position);
+  status = dec->restart_frame(frame_index, io_position);
+  if (!status.is_ok()) {
+    slot.error_message = status.message();
+    return;
+  }
+  status = dec->decode_frame_config(nullptr, src);
+  if (!status.is_ok()) {
+    slot.error_message = status.message();
+    return;
+  }
+
+  // Blending with WUFFS_BASE__PIXEL_BLEND__SRC copies the frame's indexes
+  // (including any transparent index) and palette verbatim. Blending onto the
+  // canvas happens later, in composite_frame.
+  status = dec->decode_frame(&pixbuf, src, WUFFS_BASE__PIXEL_BLEND__SRC,
+                             workbuf, nullptr);
+  if (!status.is_ok()) {
+    slot.error_message = status.message();
+    return;
+  }
+  slot.dirty_rect = dec->frame_dirty_rect();
+}
+
+void  //
+ParallelDecodeGif_State::composite_frame(size_t frame_index,
+                                         ParallelDecodeGif_Slot& slot) {
+  uint32_t width = m_image_config.pixcfg.width();
+  uint32_t height = m_image_config.pixcfg.height();
+  wuffs_base__pixel_config pixcfg;
+  pixcfg.set(WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_BINARY,
+             WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, width, height);
+  wuffs_base__pixel_buffer pixbuf;
+  wuffs_base__status status = pixbuf.set_interleaved(
+      &pixcfg,
+      wuffs_base__make_table_u8(slot.indexes.data(), width, height, width),
+      wuffs_base__make_slice_u8(slot.palette.data(), slot.palette.size()));
+  if (!status.is_ok()) {
+    slot.error_message = status.message();
+    return;
+  }
+  slot.error_message = m_compositor.composite(m_frame_configs[frame_index],
+                                              &pixbuf, slot.dirty_rect);
+}
+
+void  //
+ParallelDecodeGif_State::deliver(std::unique_lock<std::mutex>& lock) {
+  m_delivering = true;
+  while (m_error_message.empty()) {
+    ParallelDecodeGif_Slot& slot = m_ring[m_num_delivered % m_window];
+    if (!slot.finished) {
+      break;
+    }
+
+    lock.unlock();
+    size_t frame_index = m_num_delivered;
+    if (slot.error_message.empty()) {
+      composite_frame(frame_index, slot);
+    }
+    std::string error_message = std::move(slot.error_message);
+    if (error_message.empty()) {
+      error_message = m_callbacks.FrameDone(m_frame_configs[frame_index],
+                                            m_compositor.canvas());
+    }
+    lock.lock();
+
+    slot.finished = false;
+    m_num_delivered++;
+    if (!error_message.empty() && m_error_message.empty()) {
+      m_error_message = std::move(error_message);
+    }
+    if (m_num_waiting > 0) {
+      m_cv.notify_all();
+    }
+  }
+  m_delivering = false;
+}
+
+}  // namespace
+
+// --------
+
+std::string  //
+ParallelDecodeGif(ParallelDecodeGifCallbacks& callbacks,
+                  const uint8_t* ptr,
+                  size_t len,
+                  uint32_t num_threads) {
+  if (!ptr && (len > 0)) {
+    return "wuffs_aux::ParallelDecodeGif: invalid argument";
+  } else if (num_threads == 0) {
+    num_threads = std::thread::hardware_concurrency();
+    if (num_threads == 0) {
+      num_threads = 1;
+    }
+  }
+
+  // Each in-flight frame holds one byte per pixel, so the window (the number
+  // of frames in flight) is a small multiple of the number of threads.
+  ParallelDecodeGif_State state(callbacks, ptr, len, 2 * num_threads);
+
+  // Find every frame's io_position. Skipping (not decoding) the frames' LZW
+  // data is cheap.
+  {
+    wuffs_gif__decoder::unique_ptr dec = wuffs_gif__decoder::alloc();
+    if (!dec) {
+      return "wuffs_aux::ParallelDecodeGif: out of memory";
+    }
+    IOBuffer src =
+        wuffs_base__ptr_u8__reader(const_cast<uint8_t*>(ptr), len, true);
+    wuffs_base__status status =
+        dec->decode_image_config(&state.m_image_config, &src);
+    if (!status.is_ok()) {
+      return status.message();
+    }
+    while (true) {
+      wuffs_base__frame_config fc = wuffs_base__null_frame_config();
+      status = dec->decode_frame_config(&fc, &src);
+      if (status.repr == wuffs_base__note__end_of_data) {
+        break;
+      } else if (!status.is_ok()) {
+        return status.message();
+      }
+      state.m_frame_configs.push_back(fc);
+    }
+  }
+
+  std::string error_message =
+      callbacks.ImageConfig(state.m_image_config, state.m_frame_configs);
+  if (!error_message.empty() || state.m_frame_configs.empty()) {
+    return error_message;
+  }
+
+  error_message =
+      state.m_compositor.reset(state.m_image_config.pixcfg.width(),
+                               state.m_image_config.pixcfg.height());
+  if (!error_message.empty()) {
+    return error_message;
+  }
+
+  size_t n = num_threads;
+  if (n > state.m_frame_configs.size()) {
+    n = state.m_frame_configs.size();
+  }
+
+  // The calling thread is one of the n workers.
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < n; i++) {
+    threads.emplace_back(&ParallelDecodeGif_State::run_worker, &state);
+  }
+  state.run_worker();
+  for (auto& t : threads) {
+    t.join();
+  }
+  return std::move(state.m_error_message);
+}
+
+namespace {
+
+// EncodeGifToVector runs enc->encode_frame (or, if src is nullptr,
+// enc->encode_trailer), appending its output to dst and growing dst as
+// needed.
+std::string  //
+EncodeGifToVector(wuffs_gif__encoder* enc,
+                  std::vector<uint8_t>& dst,
+                  wuffs_base__pixel_buffer* src) {
+  size_t wi = dst.size();
+  dst.resize(wi + 65536);
+  while (true) {
+    IOBuffer buf = wuffs_base__ptr_u8__writer(dst.data(), dst.size());
+    buf.meta.wi = wi;
+    wuffs_base__status status =
+        src ? enc->encode_frame(&buf, src) : enc->encode_trailer(&buf);
+    wi = buf.meta.wi;
+    if (status.repr == wuffs_base__suspension__short_write) {
+      dst.resize(2 * dst.size());
+      continue;
+    }
+    dst.resize(wi);
+    if (!status.is_ok()) {
+      return status.message();
+    }
+    return "";
+  }
+}
+
+}  // namespace
+
+GifEncoder::GifEncoder()
+    : m_encoder(nullptr, &free),
+      m_finder(),
+      m_width(0),
+      m_height(0),
+      m_finished(true),
+      m_canvas(),
+      m_next(),
+      m_has_pending(false),
+      m_pending_duration(0),
+      m_pending_rect(wuffs_base__empty_rect_ie_u32()),
+      m_frame(),
+      m_bin_counts(),
+      m_bin_sums(),
+      m_bins_used() {}
+
+std::string  //
+GifEncoder::reset(uint32_t width, uint32_t height, uint32_t loop_count) {
+  m_finished = true;
+  m_has_pending = false;
+  if ((width == 0) || (width > 0xFFFF) || (height == 0) || (height > 0xFFFF)) {
+    return "wuffs_aux::GifEncoder: invalid argument";
+  }
+  m_encoder = MemOwner(wuffs_gif__encoder__alloc(), &free);
+  if (!m_finder) {
+    m_finder.reset(new wuffs_base__pixel_palette_finder());
+  }
+  if (!m_encoder || !m_finder) {
+    return "wuffs_aux::GifEncoder: out of memory";
+  }
+  wuffs_gif__encoder* enc = static_cast<wuffs_gif__encoder*>(m_encoder.get());
+  enc->set_canvas(width, height);
+  // A loop_count of N, other than zero, plays the animation N times, which a
+  // NETSCAPE2.0 extension expresses as repeating it (N - 1) times.
+  if (loop_count == 0) {
+    enc->set_loop_count(0);
+  } else if (loop_count > 1) {
+    enc->set_loop_count((loop_count <= 0x10000) ? (loop_count - 1) : 0xFFFF);
+  }
+
+  m_width = width;
+  m_height = height;
+  m_canvas.assign(4 * static_cast<size_t>(width) * height, 0);
+  m_next.resize(m_canvas.size());
+  m_bin_counts.assign(32768, 0);
+  m_bin_sums.assign(3 * 32768, 0);
+  m_bins_used.clear();
+  m_finished = false;
+  return "";
+}
+
+std::string  //
+GifEncoder::add_frame(std::vector<uint8_t>& dst,
+                      wuffs_base__pixel_buffer* src,
+                      uint64_t duration) {
+  if (m_finished) {
+    return "wuffs_aux::GifEncoder: reset was not called";
+  }
+  wuffs_base__pixel_format src_pixfmt =
+      src ? src->pixel_format() : wuffs_base__make_pixel_format(0);
+  uint32_t src_bits_per_pixel = src_pixfmt.bits_per_pixel();
+  if (!src || !src_pixfmt.is_interleaved() || ((src_bits_per_pixel & 7) != 0) ||
+      (src->pixcfg.width() != m_width) || (src->pixcfg.height() != m_height)) {
+    return "wuffs_aux::GifEncoder: invalid argument";
+  }
+
+  // Convert src to m_next, with binary alpha.
+  wuffs_base__pixel_swizzler swizzler;
+  wuffs_base__status status = swizzler.prepare(
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      wuffs_base__empty_slice_u8(), src_pixfmt, src->palette(),
+      WUFFS_BASE__PIXEL_BLEND__SRC);
+  if (!status.is_ok()) {
+    return status.message();
+  }
+  size_t stride = 4 * static_cast<size_t>(m_width);
+  size_t src_row_length =
+      (src_bits_per_pixel / 8) * static_cast<size_t>(m_width);
+  wuffs_base__table_u8 src_table = src->plane(0);
+  for (size_t y = 0; y < m_height; y++) {
+    uint8_t* row = m_next.data() + (y * stride);
+    swizzler.swizzle_interleaved_from_slice(
+        wuffs_base__make_slice_u8(row, stride), wuffs_base__empty_slice_u8(),
+        wuffs_base__make_slice_u8(src_table.ptr + (y * src_table.stride),
+                                  src_row_length));
+    for (uint8_t* p = row; p < (row + stride); p += 4) {
+      if (p[3] < 0x80) {
+        wuffs_base__poke_u32le__no_bounds_check(p, 0);
+      } else {
+        p[3] = 0xFF;
+      }
+    }
+  }
+
+  if (m_has_pending) {
+    // GIF can only make a canvas pixel transparent again by disposing of the
+    // frame that last drew it, so extend the pending frame to cover any such
+    // pixels and give it a restore-background disposal.
+    wuffs_base__rect_ie_u32 r = wuffs_base__empty_rect_ie_u32();
+    for (uint32_t y = 0; y < m_height; y++) {
+      const uint8_t* n = m_next.data() + (y * stride);
+      const uint8_t* c = m_canvas.data() + (y * stride);
+      for (uint32_t x = 0; x < m_width; x++, n += 4, c += 4) {
+        if ((n[3] == 0) && (c[3] != 0)) {
+          r = r.unite(wuffs_base__make_rect_ie_u32(x, y, x + 1, y + 1));
+        }
+      }
+    }
+    uint8_t disposal = WUFFS_BASE__ANIMATION_DISPOSAL__NONE;
+    if (!r.is_empty()) {
+      m_pending_rect = m_pending_rect.unite(r);
+      disposal = WUFFS_BASE__ANIMATION_DISPOSAL__RESTORE_BACKGROUND;
+    }
+    std::string error_message = flush_pending(dst, disposal);
+    if (!error_message.empty()) {
+      return error_message;
+    }
+    if (disposal == WUFFS_BASE__ANIMATION_DISPOSAL__RESTORE_BACKGROUND) {
+      for (uint32_t y = m_pending_rect.min_incl_y;
+           y < m_pending_rect.max_excl_y; y++) {
+        memset(m_canvas.data() + (y * stride) +
+                   (4 * static_cast<size_t>(m_pending_rect.min_incl_x)),
+               0, 4 * static_cast<size_t>(m_pending_rect.width()));
+      }
+    }
+  }
+
+  // The new frame's dirty rect is where m_next differs from the canvas. GIF
+  // frames cannot be empty, so an unchanged frame still draws one pixel.
+  uint32_t min_y = 0;
+  while ((min_y < m_height) &&
+         !memcmp(m_next.data() + (min_y * stride),
+                 m_canvas.data() + (min_y * stride), stride)) {
+    min_y++;
+  }
+  uint32_t max_y = m_height;
+  while ((max_y > min_y) &&
+         !memcmp(m_next.data() + ((max_y - 1) * stride),
+                 m_canvas.data() + ((max_y - 1) * stride), stride)) {
+    max_y--;
+  }
+  uint32_t min_x = m_width;
+  uint32_t max_x = 0;
+  for (uint32_t y = min_y; y < max_y; y++) {
+    const uint8_t* n = m_next.data() + (y * stride);
+    const uint8_t* c = m_canvas.data() + (y * stride);
+    for (uint32_t x = 0; x < min_x; x++) {
+      if (memcmp(n + (4 * x), c + (4 * x), 4)) {
+        min_x = x;
+        break;
+      }
+    }
+    for (uint32_t x = m_width; x > max_x; x--) {
+      if (memcmp(n + (4 * (x - 1)), c + (4 * (x - 1)), 4)) {
+        max_x = x;
+        break;
+      }
+    }
+  }
+  if (min_x < max_x) {
+    m_pending_rect = wuffs_base__make_rect_ie_u32(min_x, min_y, max_x, max_y);
+  } else {
+    m_pending_rect = wuffs_base__make_rect_ie_u32(0, 0, 1, 1);
+  }
+  m_canvas.swap(m_next);
+  m_has_pending = true;
+  m_pending_duration = duration;
+  return "";
+}
+
+std::string  //
+GifEncoder::finish(std::vector<uint8_t>& dst) {
+  if (m_finished) {
+    return "wuffs_aux::GifEncoder: reset was not called";
+  }
+  m_finished = true;
+  if (m_has_pending) {
+    std::string error_message =
+        flush_pending(dst, WUFFS_BASE__ANIMATION_DISPOSAL__NONE);
+    if (!error_message.empty()) {
+      return error_message;
+    }
+  }
+  return EncodeGifToVector(static_cast<wuffs_gif__encoder*>(m_encoder.get()),
+                           dst, nullptr);
+}
+
+std::string  //
+GifEncoder::flush_pending(std::vector<uint8_t>& dst, uint8_t disposal) {
+  m_has_pending = false;
+  wuffs_base__rect_ie_u32 r = m_pending_rect;
+  quantize(r);
+
+  wuffs_base__pixel_config pixcfg;
+  pixcfg.set(WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_BINARY,
+             WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, r.width(), r.height());
+  wuffs_base__pixel_buffer pixbuf;
+  wuffs_base__status status = pixbuf.set_from_slice(
+      &pixcfg, wuffs_base__make_slice_u8(m_frame.data(), m_frame.size()));
+  if (!status.is_ok()) {
+    return status.message();
+  }
+  wuffs_gif__encoder* enc = static_cast<wuffs_gif__encoder*>(m_encoder.get());
+  enc->set_frame(r.min_incl_x, r.min_incl_y, m_pending_duration, disposal);
+  return EncodeGifToVector(enc, dst, &pixbuf);
+}
+
+// quantize sets m_frame to the palette and pixels of m_canvas' r part.
+void  //
+GifEncoder::quantize(wuffs_base__rect_ie_u32 r) {
+  size_t w = r.width();
+  size_t h = r.height();
+  size_t stride = 4 * static_cast<size_t>(m_width);
+  m_frame.assign(
+      WUFFS_BASE__PIXEL_FORMAT__INDEXED__PALETTE_BYTE_LENGTH + (w * h), 0);
+  uint8_t* palette = m_frame.data();
+  uint8_t* indexes =
+      palette + WUFFS_BASE__PIXEL_FORMAT__INDEXED__PALETTE_BYTE_LENGTH;
+  const uint8_t* pixels = m_canvas.data() + (r.min_incl_y * stride) +
+                          (4 * static_cast<size_t>(r.min_incl_x));
+
+  // Look for 256 or fewer distinct opaque colors, in a small open addressing
+  // hash set. Zero marks an empty slot, as opaque colors have non-zero alpha.
+  bool has_transparent = false;
+  bool exact = true;
+  uint32_t set[512] = {0};
+  uint32_t num_colors = 0;
+  for (size_t y = 0; exact && (y < h); y++) {
+    const uint8_t* p = pixels + (y * stride);
+    for (size_t x = 0; x < w; x++, p += 4) {
+      uint32_t c = wuffs_base__peek_u32le__no_bounds_check(p);
+      if (c == 0) {
+        has_transparent = true;
+        continue;
+      }
+      uint32_t i = (c * 0x9E3779B1u) >> 23;
+      while ((set[i] != 0) && (set[i] != c)) {
+        i = (i + 1) & 511;
+      }
+      if (set[i] == 0) {
+        if (num_colors == 256) {
+          exact = false;
+          break;
+        }
+        set[i] = c;
+        num_colors++;
+      }
+    }
+  }
+  uint32_t max_colors = has_transparent ? 255 : 256;
+
+  if (exact && (num_colors <= max_colors)) {
+    uint8_t* q = palette;
+    for (uint32_t i = 0; i < 512; i++) {
+      if (set[i] != 0) {
+        wuffs_base__poke_u32le__no_bounds_check(q, set[i]);
+        q += 4;
+      }
+    }
+
+  } else {
+    // Popularity quantization: bin the opaque colors by their high 5 bits
+    // per channel and pick the most common bins' average colors.
+    has_transparent = false;
+    for (size_t y = 0; y < h; y++) {
+      const uint8_t* p = pixels + (y * stride);
+      for (size_t x = 0; x < w; x++, p += 4) {
+        if (p[3] == 0) {
+          has_transparent = true;
+          continue;
+        }
+        uint32_t bin = (static_cast<uint32_t>(p[2] >> 3) << 10) |
+                       (static_cast<uint32_t>(p[1] >> 3) << 5) |
+                       (static_cast<uint32_t>(p[0] >> 3) << 0);
+        if (m_bin_counts[bin]++ == 0) {
+          m_bins_used.push_back(bin);
+        }
+        m_bin_sums[(3 * bin) + 0] += p[0];
+        m_bin_sums[(3 * bin) + 1] += p[1];
+        m_bin_sums[(3 * bin) + 2] += p[2];
+      }
+    }
+    max_colors = has_transparent ? 255 : 256;
+
+    const std::vector<uint32_t>& counts = m_bin_counts;
+    auto more_popular = [&counts](uint32_t a, uint32_t b) {
+      return (counts[a] != counts[b]) ? (counts[a] > counts[b]) : (a < b);
+    };
+    num_colors = static_cast<uint32_t>(
+        std::min<size_t>(m_bins_used.size(), max_colors));
+    std::partial_sort(m_bins_used.begin(), m_bins_used.begin() + num_colors,
+                      m_bins_used.end(), more_popular);
+    for (uint32_t i = 0; i < num_colors; i++) {
+      uint32_t bin = m_bins_used[i];
+      uint64_t n = m_bin_counts[bin];
+      for (int j = 0; j < 3; j++) {
+        palette[(4 * i) + j] =
+            static_cast<uint8_t>((m_bin_sums[(3 * bin) + j] + (n / 2)) / n);
+      }
+      palette[(4 * i) + 3] = 0xFF;
+    }
+    for (uint32_t bin : m_bins_used) {
+      m_bin_counts[bin] = 0;
+      m_bin_sums[(3 * bin) + 0] = 0;
+      m_bin_sums[(3 * bin) + 1] = 0;
+      m_bin_sums[(3 * bin) + 2] = 0;
+    }
+    m_bins_used.clear();
+  }
+
+  // The transparent index (if any) follows the opaque colors. Unused palette
+  // entries are opaque black.
+  for (uint32_t i = num_colors + (has_transparent ? 1 : 0); i < 256; i++) {
+    palette[(4 * i) + 3] = 0xFF;
+  }
+
+  // Map each pixel to its palette index. The pixels have binary alpha, so
+  // they are valid BGRA_PREMUL as well as BGRA_NONPREMUL.
+  if (num_colors > 0) {
+    m_finder->prepare(
+        wuffs_base__make_slice_u8(palette, 4 * num_colors),
+        wuffs_base__make_pixel_format(
+            WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_NONPREMUL));
+  }
+  for (size_t y = 0; y < h; y++) {
+    const uint8_t* p = pixels + (y * stride);
+    uint8_t* d = indexes + (y * w);
+    if (num_colors > 0) {
+      m_finder->closest_elements(
+          wuffs_base__make_slice_u8(d, w),
+          wuffs_base__make_slice_u8(const_cast<uint8_t*>(p), 4 * w));
+    }
+    if (has_transparent) {
+      for (size_t x = 0; x < w; x++) {
+        if (p[(4 * x) + 3] == 0) {
+          d[x] = static_cast<uint8_t>(num_colors);
+        }
+      }
+    }
+  }
+}
+
+}  // namespace wuffs_aux
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) ||
+        // defined(WUFFS_CONFIG__MODULE__AUX__GIF)
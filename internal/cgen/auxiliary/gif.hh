@@ -0,0 +1,226 @@
+// Copyright 2022 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ---------------- Auxiliary - GIF
+
+#include <memory>
+#include <vector>
+
+namespace wuffs_aux {
+
+// GifCompositor composites an animated image's frames, in order, onto a
+// canvas whose pixel format is WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+// applying each frame's disposal (WUFFS_BASE__ANIMATION_DISPOSAL__ETC) before
+// the next frame is drawn.
+//
+// Work is proportional to the number of changed pixels, not to the canvas
+// size. Only each frame's dirty rect is blended. A restore-background
+// disposal only fills that frame's bounds. A restore-previous disposal only
+// saves (and later restores) the pixels under that frame's dirty rect,
+// instead of the whole canvas. The dirty_rect method reports what changed, so
+// that callers (e.g. players or transcoders) can also limit their own work.
+class GifCompositor {
+ public:
+  GifCompositor();
+
+  // reset prepares a width × height canvas for a new animation.
+  //
+  // It returns an empty string on success or an error message otherwise.
+  std::string reset(uint32_t width, uint32_t height);
+
+  // composite applies the previous frame's disposal and then blends src's
+  // pixels within frame_dirty_rect onto the canvas. src is in canvas
+  // coordinates and can be in any interleaved pixel format that
+  // wuffs_base__pixel_swizzler can convert from, such as the
+  // WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_BINARY pixel buffer (and
+  // frame_dirty_rect) that wuffs_gif__decoder produces. For the first frame
+  // after reset, the whole canvas is first filled with its background color.
+  //
+  // It returns an empty string on success or an error message otherwise.
+  std::string composite(const wuffs_base__frame_config& frame_config,
+                        wuffs_base__pixel_buffer* src,
+                        wuffs_base__rect_ie_u32 frame_dirty_rect);
+
+  // canvas returns the canvas. Its pixels are valid until the next reset or
+  // composite call.
+  wuffs_base__pixel_buffer* canvas();
+
+  // dirty_rect returns the part of the canvas that the last composite call
+  // could have changed: the previous frame's disposal unioned with the
+  // current frame's dirty rect. Outside of it, the canvas is unchanged since
+  // the composite call before that one.
+  wuffs_base__rect_ie_u32 dirty_rect() const;
+
+ private:
+  void copy_rect(uint8_t* dst,
+                 size_t dst_stride,
+                 const uint8_t* src,
+                 size_t src_stride,
+                 wuffs_base__rect_ie_u32 r);
+
+  std::vector<uint8_t> m_canvas;
+  wuffs_base__pixel_buffer m_canvas_pixbuf;
+  std::vector<uint8_t> m_swizzler_palette;
+  wuffs_base__rect_ie_u32 m_dirty_rect;
+
+  // m_previous is the previous frame's configuration, whose disposal is still
+  // to be applied, if m_has_previous. For a restore-previous disposal,
+  // m_saved holds the canvas' pixels under m_saved_rect from before that
+  // frame was composited, packed with no padding between rows.
+  wuffs_base__frame_config m_previous;
+  bool m_has_previous;
+  std::vector<uint8_t> m_saved;
+  wuffs_base__rect_ie_u32 m_saved_rect;
+
+  // Delete the copy and assign constructors.
+  GifCompositor(const GifCompositor&) = delete;
+  GifCompositor& operator=(const GifCompositor&) = delete;
+};
+
+// ParallelDecodeGifCallbacks are the callbacks for ParallelDecodeGif.
+class ParallelDecodeGifCallbacks {
+ public:
+  virtual ~ParallelDecodeGifCallbacks();
+
+  // ImageConfig is called once, before any frames are decoded, with the
+  // image's configuration and the configuration of all of its frames (in
+  // frame order). Returning a non-empty string stops ParallelDecodeGif, which
+  // then returns that string.
+  //
+  // The default implementation returns an empty string.
+  virtual std::string  //
+  ImageConfig(const wuffs_base__image_config& image_config,
+              const std::vector<wuffs_base__frame_config>& frame_configs);
+
+  // FrameDone is called once per frame, in frame order, after that frame has
+  // been composited (honoring the previous frames' disposal) onto canvas,
+  // whose pixel format is WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL. It is never
+  // called concurrently, but may be called from any worker thread. The canvas
+  // pixels are only valid until FrameDone returns.
+  //
+  // Returning a non-empty string stops ParallelDecodeGif, which then returns
+  // that string.
+  virtual std::string  //
+  FrameDone(const wuffs_base__frame_config& frame_config,
+            wuffs_base__pixel_buffer* canvas) = 0;
+};
+
+// ParallelDecodeGif decodes an in-memory, animated GIF image, composites its
+// frames in order and passes each composited frame to callbacks.FrameDone.
+//
+// Unlike the rest of Wuffs, it is not single-threaded. A first pass runs one
+// wuffs_gif__decoder's decode_frame_config over the whole image, which skips
+// each frame's LZW-compressed data without decompressing it, to find every
+// frame's io_position. No frame's LZW data depends on any other frame's, so
+// up to num_threads (zero means std::thread::hardware_concurrency()) worker
+// threads, the calling thread being one of them, then decode frames
+// concurrently. Each worker has its own wuffs_gif__decoder and uses its
+// restart_frame method to seek to the frames it claims, decoding them into
+// per-frame palette index buffers (one byte per pixel). Compositing those
+// indexes onto the canvas (with a GifCompositor), which depends on the
+// previous frames, is serial.
+//
+// Only a bounded number of frames are in flight (decoded but not yet
+// composited) at any one time, so memory use does not grow with the number
+// of frames. Still images and small animations use fewer threads.
+//
+// It returns an empty string on success or an error message otherwise.
+std::string  //
+ParallelDecodeGif(ParallelDecodeGifCallbacks& callbacks,
+                  const uint8_t* ptr,
+                  size_t len,
+                  uint32_t num_threads = 0);
+
+// GifEncoder encodes a sequence of true-color frames as an animated GIF,
+// appending its output to a std::vector.
+//
+// Each frame is quantized to its own (Local Color Table) palette of up to 256
+// colors. If it has 256 or fewer distinct colors, they are used exactly.
+// Otherwise, a fast popularity quantizer picks the most common colors, after
+// binning them to 5 bits per channel, and each pixel is mapped to its closest
+// palette entry by a wuffs_base__pixel_palette_finder. There is no dithering.
+// Alpha is binary: an alpha below 0x80 is transparent and anything else is
+// opaque.
+//
+// Only each frame's dirty rect, the part that differs from what the previous
+// frames left on the canvas, is encoded. Frames are written one frame late,
+// so that a frame whose successor needs some of its pixels to become
+// transparent again (which GIF cannot otherwise express) can be given a
+// restore-background disposal over enough of the canvas.
+class GifEncoder {
+ public:
+  GifEncoder();
+
+  // reset prepares to encode a width × height animation that plays
+  // loop_count times (like wuffs_gif__decoder's num_animation_loops), where
+  // zero means to loop forever. It discards any frames that were added but
+  // not yet finished.
+  //
+  // It returns an empty string on success or an error message otherwise.
+  std::string reset(uint32_t width, uint32_t height, uint32_t loop_count = 0);
+
+  // add_frame adds a frame to the animation, shown for duration flicks. src
+  // has the canvas' size and can be in any interleaved pixel format that
+  // wuffs_base__pixel_swizzler can convert to BGRA_NONPREMUL. It may append
+  // the previous frame's encoding to dst.
+  //
+  // It returns an empty string on success or an error message otherwise.
+  std::string add_frame(std::vector<uint8_t>& dst,
+                        wuffs_base__pixel_buffer* src,
+                        uint64_t duration);
+
+  // finish appends the last frame's encoding and the GIF trailer to dst.
+  // Afterwards, reset must be called before adding more frames.
+  //
+  // It returns an empty string on success or an error message otherwise.
+  std::string finish(std::vector<uint8_t>& dst);
+
+ private:
+  std::string flush_pending(std::vector<uint8_t>& dst, uint8_t disposal);
+  void quantize(wuffs_base__rect_ie_u32 r);
+
+  // m_encoder is a heap allocated wuffs_gif__encoder. It is held as a
+  // MemOwner so that this header does not depend on the std/gif module.
+  MemOwner m_encoder;
+  std::unique_ptr<wuffs_base__pixel_palette_finder> m_finder;
+  uint32_t m_width;
+  uint32_t m_height;
+  bool m_finished;
+
+  // m_canvas and m_next hold BGRA_NONPREMUL pixels with binary alpha (each
+  // pixel is either 0x00000000 or has an alpha of 0xFF). m_canvas is the
+  // canvas after the pending frame (not yet written to dst), whose duration
+  // and dirty rect are m_pending_duration and m_pending_rect.
+  std::vector<uint8_t> m_canvas;
+  std::vector<uint8_t> m_next;
+  bool m_has_pending;
+  uint64_t m_pending_duration;
+  wuffs_base__rect_ie_u32 m_pending_rect;
+
+  // m_frame is the INDEXED__BGRA_BINARY palette (1024 bytes) and pixels of
+  // the frame being encoded.
+  std::vector<uint8_t> m_frame;
+
+  // The quantizer's per-bin pixel counts and BGR sums, plus the list of bins
+  // that are in use, so that only those need resetting.
+  std::vector<uint32_t> m_bin_counts;
+  std::vector<uint64_t> m_bin_sums;
+  std::vector<uint32_t> m_bins_used;
+
+  // Delete the copy and assign constructors.
+  GifEncoder(const GifEncoder&) = delete;
+  GifEncoder& operator=(const GifEncoder&) = delete;
+};
+
+}  // namespace wuffs_aux
@@ -16,6 +16,11 @@
 
 #if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__AUX__IMAGE)
 
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
 #include <utility>
 
 namespace wuffs_aux {
@@ -34,6 +39,17 @@ DecodeImageResult::DecodeImageResult(std::string&& error_message0)
 
 DecodeImageCallbacks::~DecodeImageCallbacks() {}
 
+DecodeImageCallbacks::AllocIOBufferResult::AllocIOBufferResult(
+    MemOwner&& mem_owner0,
+    wuffs_base__slice_u8 array0)
+    : mem_owner(std::move(mem_owner0)), array(array0), error_message("") {}
+
+DecodeImageCallbacks::AllocIOBufferResult::AllocIOBufferResult(
+    std::string&& error_message0)
+    : mem_owner(nullptr, &free),
+      array(wuffs_base__empty_slice_u8()),
+      error_message(std::move(error_message0)) {}
+
 DecodeImageCallbacks::AllocPixbufResult::AllocPixbufResult(
     MemOwner&& mem_owner0,
     wuffs_base__pixel_buffer pixbuf0)
@@ -56,6 +72,16 @@ DecodeImageCallbacks::AllocWorkbufResult::AllocWorkbufResult(
       workbuf(wuffs_base__empty_slice_u8()),
       error_message(std::move(error_message0)) {}
 
+DecodeImageCallbacks::AllocIOBufferResult  //
+DecodeImageCallbacks::AllocIOBuffer() {
+  void* ptr = Malloc(32768);
+  if (!ptr) {
+    return AllocIOBufferResult(DecodeImage_OutOfMemory);
+  }
+  return AllocIOBufferResult(MemOwner(ptr, &Free),
+                             wuffs_base__make_slice_u8((uint8_t*)ptr, 32768));
+}
+
 wuffs_base__image_decoder::unique_ptr  //
 DecodeImageCallbacks::SelectDecoder(uint32_t fourcc,
                                     wuffs_base__slice_u8 prefix_data,
@@ -71,6 +97,20 @@ DecodeImageCallbacks::SelectDecoder(uint32_t fourcc,
       return wuffs_gif__decoder::alloc_as__wuffs_base__image_decoder();
 #endif
 
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__ICO)
+    case WUFFS_BASE__FOURCC__ICO: {
+      auto dec = wuffs_ico__decoder::alloc_as__wuffs_base__image_decoder();
+      // Favor faster decodes over rejecting invalid checksums.
+      dec->set_quirk_enabled(WUFFS_BASE__QUIRK_IGNORE_CHECKSUM, true);
+      return dec;
+    }
+#endif
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__JPEG)
+    case WUFFS_BASE__FOURCC__JPEG:
+      return wuffs_jpeg__decoder::alloc_as__wuffs_base__image_decoder();
+#endif
+
 #if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__NIE)
     case WUFFS_BASE__FOURCC__NIE:
       return wuffs_nie__decoder::alloc_as__wuffs_base__image_decoder();
@@ -94,6 +134,11 @@ DecodeImageCallbacks::SelectDecoder(uint32_t fourcc,
     case WUFFS_BASE__FOURCC__WBMP:
       return wuffs_wbmp__decoder::alloc_as__wuffs_base__image_decoder();
 #endif
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__WEBP)
+    case WUFFS_BASE__FOURCC__WEBP:
+      return wuffs_webp__decoder::alloc_as__wuffs_base__image_decoder();
+#endif
   }
 
   return wuffs_base__image_decoder::unique_ptr(nullptr, &free);
@@ -105,12 +150,25 @@ DecodeImageCallbacks::HandleMetadata(const wuffs_base__more_information& minfo,
   return "";
 }
 
+std::string  //
+DecodeImageCallbacks::HandleMetadataRanges(
+    const wuffs_base__more_information& minfo,
+    const std::vector<wuffs_base__range_ie_u64>& ranges) {
+  return "";
+}
+
 wuffs_base__pixel_format  //
 DecodeImageCallbacks::SelectPixfmt(
     const wuffs_base__image_config& image_config) {
   return wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL);
 }
 
+uint32_t  //
+DecodeImageCallbacks::SelectRowBandHeight(
+    const wuffs_base__image_config& image_config) {
+  return 0;
+}
+
 DecodeImageCallbacks::AllocPixbufResult  //
 DecodeImageCallbacks::AllocPixbuf(const wuffs_base__image_config& image_config,
                                   bool allow_uninitialized_memory) {
@@ -124,7 +182,7 @@ DecodeImageCallbacks::AllocPixbuf(const wuffs_base__image_config& image_config,
     return AllocPixbufResult(DecodeImage_UnsupportedPixelConfiguration);
   }
   void* ptr =
-      allow_uninitialized_memory ? malloc((size_t)len) : calloc((size_t)len, 1);
+      allow_uninitialized_memory ? Malloc((size_t)len) : Calloc((size_t)len, 1);
   if (!ptr) {
     return AllocPixbufResult(DecodeImage_OutOfMemory);
   }
@@ -133,10 +191,10 @@ DecodeImageCallbacks::AllocPixbuf(const wuffs_base__image_config& image_config,
       &image_config.pixcfg,
       wuffs_base__make_slice_u8((uint8_t*)ptr, (size_t)len));
   if (!status.is_ok()) {
-    free(ptr);
+    Free(ptr);
     return AllocPixbufResult(status.message());
   }
-  return AllocPixbufResult(MemOwner(ptr, &free), pixbuf);
+  return AllocPixbufResult(MemOwner(ptr, &Free), pixbuf);
 }
 
 DecodeImageCallbacks::AllocWorkbufResult  //
@@ -149,15 +207,22 @@ DecodeImageCallbacks::AllocWorkbuf(wuffs_base__range_ii_u64 len_range,
     return AllocWorkbufResult(DecodeImage_OutOfMemory);
   }
   void* ptr =
-      allow_uninitialized_memory ? malloc((size_t)len) : calloc((size_t)len, 1);
+      allow_uninitialized_memory ? Malloc((size_t)len) : Calloc((size_t)len, 1);
   if (!ptr) {
     return AllocWorkbufResult(DecodeImage_OutOfMemory);
   }
   return AllocWorkbufResult(
-      MemOwner(ptr, &free),
+      MemOwner(ptr, &Free),
       wuffs_base__make_slice_u8((uint8_t*)ptr, (size_t)len));
 }
 
+std::string  //
+DecodeImageCallbacks::HandleRowBand(wuffs_base__pixel_buffer& pixbuf,
+                                    uint32_t y,
+                                    uint32_t num_rows) {
+  return "";
+}
+
 void  //
 DecodeImageCallbacks::Done(
     DecodeImageResult& result,
@@ -165,6 +230,273 @@ DecodeImageCallbacks::Done(
     IOBuffer& buffer,
     wuffs_base__image_decoder::unique_ptr image_decoder) {}
 
+// --------
+
+namespace {
+
+template <typename T>
+bool  //
+PoolingDecodeImageCallbacks_Reinitialize(wuffs_base__image_decoder* dec,
+                                         size_t sizeof_t) {
+  // The alloc_as__wuffs_base__image_decoder functions return a T* cast to a
+  // wuffs_base__image_decoder*, so that this cast back is valid.
+  return reinterpret_cast<T*>(dec)
+      ->initialize(sizeof_t, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED)
+      .is_ok();
+}
+
+// PoolingDecodeImageCallbacks_Reset re-initializes dec, an image decoder for
+// the given fourcc returned by DecodeImageCallbacks::SelectDecoder, and
+// re-applies that SelectDecoder's quirks. It returns whether it succeeded.
+bool  //
+PoolingDecodeImageCallbacks_Reset(uint32_t fourcc,
+                                  wuffs_base__image_decoder* dec) {
+  switch (fourcc) {
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__BMP)
+    case WUFFS_BASE__FOURCC__BMP:
+      return PoolingDecodeImageCallbacks_Reinitialize<wuffs_bmp__decoder>(
+          dec, sizeof__wuffs_bmp__decoder());
+#endif
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__GIF)
+    case WUFFS_BASE__FOURCC__GIF:
+      return PoolingDecodeImageCallbacks_Reinitialize<wuffs_gif__decoder>(
+          dec, sizeof__wuffs_gif__decoder());
+#endif
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__ICO)
+    case WUFFS_BASE__FOURCC__ICO:
+      if (!PoolingDecodeImageCallbacks_Reinitialize<wuffs_ico__decoder>(
+              dec, sizeof__wuffs_ico__decoder())) {
+        return false;
+      }
+      dec->set_quirk_enabled(WUFFS_BASE__QUIRK_IGNORE_CHECKSUM, true);
+      return true;
+#endif
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__JPEG)
+    case WUFFS_BASE__FOURCC__JPEG:
+      return PoolingDecodeImageCallbacks_Reinitialize<wuffs_jpeg__decoder>(
+          dec, sizeof__wuffs_jpeg__decoder());
+#endif
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__NIE)
+    case WUFFS_BASE__FOURCC__NIE:
+      return PoolingDecodeImageCallbacks_Reinitialize<wuffs_nie__decoder>(
+          dec, sizeof__wuffs_nie__decoder());
+#endif
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__PNG)
+    case WUFFS_BASE__FOURCC__PNG:
+      if (!PoolingDecodeImageCallbacks_Reinitialize<wuffs_png__decoder>(
+              dec, sizeof__wuffs_png__decoder())) {
+        return false;
+      }
+      dec->set_quirk_enabled(WUFFS_BASE__QUIRK_IGNORE_CHECKSUM, true);
+      return true;
+#endif
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__TGA)
+    case WUFFS_BASE__FOURCC__TGA:
+      return PoolingDecodeImageCallbacks_Reinitialize<wuffs_tga__decoder>(
+          dec, sizeof__wuffs_tga__decoder());
+#endif
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__WBMP)
+    case WUFFS_BASE__FOURCC__WBMP:
+      return PoolingDecodeImageCallbacks_Reinitialize<wuffs_wbmp__decoder>(
+          dec, sizeof__wuffs_wbmp__decoder());
+#endif
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__WEBP)
+    case WUFFS_BASE__FOURCC__WEBP:
+      return PoolingDecodeImageCallbacks_Reinitialize<wuffs_webp__decoder>(
+          dec, sizeof__wuffs_webp__decoder());
+#endif
+  }
+
+  return false;
+}
+
+}  // namespace
+
+PoolingDecodeImageCallbacks::PoolingDecodeImageCallbacks()
+    : m_decoders(),
+      m_selected_fourcc(0),
+      m_selected_decoder(nullptr),
+      m_workbuf_mem_owner(nullptr, &free),
+      m_workbuf_len(0),
+      m_io_array_mem_owner(nullptr, &free),
+      m_pixbuf_mem_owner(nullptr, &free),
+      m_pixbuf_len(0),
+      m_lent_pixbuf_ptr(nullptr),
+      m_lent_pixbuf_len(0) {}
+
+void  //
+PoolingDecodeImageCallbacks::drop() {
+  m_decoders.clear();
+  m_selected_fourcc = 0;
+  m_selected_decoder = nullptr;
+  m_workbuf_mem_owner.reset();
+  m_workbuf_len = 0;
+  m_io_array_mem_owner.reset();
+  m_pixbuf_mem_owner.reset();
+  m_pixbuf_len = 0;
+  m_lent_pixbuf_ptr = nullptr;
+  m_lent_pixbuf_len = 0;
+}
+
+void  //
+PoolingDecodeImageCallbacks::recycle(DecodeImageResult& result) {
+  MemOwner mem_owner = std::move(result.pixbuf_mem_owner);
+  wuffs_base__table_u8 tab = result.pixbuf.plane(0);
+  result.pixbuf = wuffs_base__null_pixel_buffer();
+  uint8_t* ptr = static_cast<uint8_t*>(mem_owner.get());
+  // Only memory paired with Free came from AllocPixbuf (or, at least, from
+  // Malloc or Calloc), so that AllocPixbuf can hand it out again.
+  if (!ptr || (mem_owner.get_deleter() != &Free)) {
+    return;
+  }
+  size_t len = 0;
+  if (ptr == m_lent_pixbuf_ptr) {
+    len = m_lent_pixbuf_len;
+    m_lent_pixbuf_ptr = nullptr;
+    m_lent_pixbuf_len = 0;
+  } else if ((tab.ptr >= ptr) && (tab.height > 0)) {
+    // The memory runs at least up to the end of the pixels, so this is a
+    // lower bound on its length.
+    len = (size_t)(tab.ptr - ptr) + ((tab.height - 1) * tab.stride) +
+          tab.width;
+  }
+  if ((len > 0) && (len >= m_pixbuf_len)) {
+    m_pixbuf_mem_owner = std::move(mem_owner);
+    m_pixbuf_len = len;
+  }
+}
+
+DecodeImageCallbacks::AllocIOBufferResult  //
+PoolingDecodeImageCallbacks::AllocIOBuffer() {
+  if (!m_io_array_mem_owner) {
+    AllocIOBufferResult result = DecodeImageCallbacks::AllocIOBuffer();
+    if (!result.error_message.empty()) {
+      return result;
+    }
+    m_io_array_mem_owner = std::move(result.mem_owner);
+  }
+  // The returned MemOwner is a no-op: this object keeps the memory.
+  return AllocIOBufferResult(
+      MemOwner(nullptr, &free),
+      wuffs_base__make_slice_u8((uint8_t*)m_io_array_mem_owner.get(), 32768));
+}
+
+wuffs_base__image_decoder::unique_ptr  //
+PoolingDecodeImageCallbacks::SelectDecoder(uint32_t fourcc,
+                                           wuffs_base__slice_u8 prefix_data,
+                                           bool prefix_closed) {
+  wuffs_base__image_decoder::unique_ptr dec(nullptr, &free);
+  for (auto& entry : m_decoders) {
+    if ((entry.first == fourcc) && entry.second) {
+      if (PoolingDecodeImageCallbacks_Reset(fourcc, entry.second.get())) {
+        dec = std::move(entry.second);
+      } else {
+        entry.second.reset();
+      }
+      break;
+    }
+  }
+  if (!dec) {
+    dec = DecodeImageCallbacks::SelectDecoder(fourcc, prefix_data,
+                                              prefix_closed);
+  }
+  m_selected_fourcc = fourcc;
+  m_selected_decoder = dec.get();
+  return dec;
+}
+
+DecodeImageCallbacks::AllocPixbufResult  //
+PoolingDecodeImageCallbacks::AllocPixbuf(
+    const wuffs_base__image_config& image_config,
+    bool allow_uninitialized_memory) {
+  uint64_t len = image_config.pixcfg.pixbuf_len();
+  if ((len == 0) || (m_pixbuf_len < len)) {
+    AllocPixbufResult result = DecodeImageCallbacks::AllocPixbuf(
+        image_config, allow_uninitialized_memory);
+    m_lent_pixbuf_ptr = result.mem_owner.get();
+    m_lent_pixbuf_len = (size_t)len;
+    return result;
+  }
+  if (!allow_uninitialized_memory) {
+    memset(m_pixbuf_mem_owner.get(), 0, (size_t)len);
+  }
+  wuffs_base__pixel_buffer pixbuf;
+  wuffs_base__status status = pixbuf.set_from_slice(
+      &image_config.pixcfg,
+      wuffs_base__make_slice_u8((uint8_t*)m_pixbuf_mem_owner.get(),
+                                (size_t)len));
+  if (!status.is_ok()) {
+    return AllocPixbufResult(status.message());
+  }
+  // Unlike the workbuf, ownership passes to the caller, until recycled.
+  m_lent_pixbuf_ptr = m_pixbuf_mem_owner.get();
+  m_lent_pixbuf_len = m_pixbuf_len;
+  m_pixbuf_len = 0;
+  return AllocPixbufResult(std::move(m_pixbuf_mem_owner), pixbuf);
+}
+
+DecodeImageCallbacks::AllocWorkbufResult  //
+PoolingDecodeImageCallbacks::AllocWorkbuf(wuffs_base__range_ii_u64 len_range,
+                                          bool allow_uninitialized_memory) {
+  uint64_t len = len_range.max_incl;
+  if (len == 0) {
+    return AllocWorkbufResult("");
+  } else if (SIZE_MAX < len) {
+    return AllocWorkbufResult(DecodeImage_OutOfMemory);
+  }
+  if (m_workbuf_len < len) {
+    m_workbuf_mem_owner.reset();
+    m_workbuf_len = 0;
+    void* ptr = Malloc((size_t)len);
+    if (!ptr) {
+      return AllocWorkbufResult(DecodeImage_OutOfMemory);
+    }
+    m_workbuf_mem_owner = MemOwner(ptr, &Free);
+    m_workbuf_len = (size_t)len;
+  }
+  if (!allow_uninitialized_memory) {
+    memset(m_workbuf_mem_owner.get(), 0, (size_t)len);
+  }
+  // The returned MemOwner is a no-op: this object keeps the memory.
+  return AllocWorkbufResult(
+      MemOwner(nullptr, &free),
+      wuffs_base__make_slice_u8((uint8_t*)m_workbuf_mem_owner.get(),
+                                (size_t)len));
+}
+
+void  //
+PoolingDecodeImageCallbacks::Done(
+    DecodeImageResult& result,
+    sync_io::Input& input,
+    IOBuffer& buffer,
+    wuffs_base__image_decoder::unique_ptr image_decoder) {
+  uint32_t fourcc = m_selected_fourcc;
+  bool poolable = image_decoder && (image_decoder.get() == m_selected_decoder);
+  m_selected_fourcc = 0;
+  m_selected_decoder = nullptr;
+  if (!poolable) {
+    return;
+  }
+  for (auto& entry : m_decoders) {
+    if (entry.first == fourcc) {
+      entry.second = std::move(image_decoder);
+      return;
+    }
+  }
+  m_decoders.push_back(std::make_pair(fourcc, std::move(image_decoder)));
+}
+
+// --------
+
 const char DecodeImage_BufferIsTooShort[] =  //
     "wuffs_aux::DecodeImage: buffer is too short";
 const char DecodeImage_MaxInclDimensionExceeded[] =  //
@@ -239,6 +571,24 @@ DecodeImageArgMaxInclMetadataLength::DefaultValue() {
   return DecodeImageArgMaxInclMetadataLength(16777215);
 }
 
+DecodeImageArgRegionOfInterest::DecodeImageArgRegionOfInterest(
+    wuffs_base__rect_ie_u32 repr0)
+    : repr(repr0) {}
+
+DecodeImageArgRegionOfInterest  //
+DecodeImageArgRegionOfInterest::DefaultValue() {
+  return DecodeImageArgRegionOfInterest(
+      wuffs_base__make_rect_ie_u32(0, 0, 0xFFFFFFFF, 0xFFFFFFFF));
+}
+
+DecodeImageArgDownscaleShift::DecodeImageArgDownscaleShift(uint32_t repr0)
+    : repr(repr0) {}
+
+DecodeImageArgDownscaleShift  //
+DecodeImageArgDownscaleShift::DefaultValue() {
+  return DecodeImageArgDownscaleShift(0);
+}
+
 // --------
 
 namespace {
@@ -275,16 +625,49 @@ DIHM1(void* self,
   return static_cast<DecodeImageCallbacks*>(self)->HandleMetadata(*minfo, raw);
 }
 
+std::string  //
+DIHM2(void* self,
+      const wuffs_base__more_information* minfo,
+      const std::vector<wuffs_base__range_ie_u64>& ranges) {
+  return static_cast<DecodeImageCallbacks*>(self)->HandleMetadataRanges(
+      *minfo, ranges);
+}
+
 std::string  //
 DecodeImageHandleMetadata(wuffs_base__image_decoder::unique_ptr& image_decoder,
                           DecodeImageCallbacks& callbacks,
                           sync_io::Input& input,
                           wuffs_base__io_buffer& io_buf,
-                          sync_io::DynIOBuffer& raw_metadata_buf) {
-  return private_impl::HandleMetadata(DecodeImageErrorMessages, input, io_buf,
-                                      raw_metadata_buf, DIHM0,
-                                      static_cast<void*>(image_decoder.get()),
-                                      DIHM1, static_cast<void*>(&callbacks));
+                          sync_io::DynIOBuffer& raw_metadata_buf,
+                          uint64_t flags) {
+  return private_impl::HandleMetadata(
+      DecodeImageErrorMessages, input, io_buf, raw_metadata_buf, DIHM0,
+      static_cast<void*>(image_decoder.get()), DIHM1,
+      (flags & DecodeImageArgFlags::REPORT_METADATA_RAW_PASSTHROUGH_AS_RANGES)
+          ? DIHM2
+          : nullptr,
+      static_cast<void*>(&callbacks));
+}
+
+// DecodeImageHandleRowBand passes the frame_dirty_rect rows of a row band
+// decode to callbacks.HandleRowBand, relative to the region of interest.
+std::string  //
+DecodeImageHandleRowBand(wuffs_base__image_decoder::unique_ptr& image_decoder,
+                         DecodeImageCallbacks& callbacks,
+                         wuffs_base__pixel_buffer& pixel_buffer,
+                         const wuffs_base__rect_ie_u32& roi) {
+  wuffs_base__rect_ie_u32 band =
+      roi.intersect(image_decoder->frame_dirty_rect());
+  uint32_t num_rows = band.height();
+  uint32_t pixbuf_height = pixel_buffer.pixcfg.height();
+  if (num_rows > pixbuf_height) {
+    num_rows = pixbuf_height;
+  }
+  if (num_rows == 0) {
+    return "";
+  }
+  return callbacks.HandleRowBand(pixel_buffer, band.min_incl_y - roi.min_incl_y,
+                                 num_rows);
 }
 
 DecodeImageResult  //
@@ -297,7 +680,9 @@ DecodeImage0(wuffs_base__image_decoder::unique_ptr& image_decoder,
              wuffs_base__pixel_blend pixel_blend,
              wuffs_base__color_u32_argb_premul background_color,
              uint32_t max_incl_dimension,
-             uint64_t max_incl_metadata_length) {
+             uint64_t max_incl_metadata_length,
+             wuffs_base__rect_ie_u32 region_of_interest,
+             uint32_t downscale_shift) {
   // Check args.
   switch (pixel_blend) {
     case WUFFS_BASE__PIXEL_BLEND__SRC:
@@ -416,8 +801,9 @@ redirect:
         redirected = true;
         goto redirect;
       } else if (id_dic_status.repr == wuffs_base__note__metadata_reported) {
-        std::string error_message = DecodeImageHandleMetadata(
-            image_decoder, callbacks, input, io_buf, raw_metadata_buf);
+        std::string error_message =
+            DecodeImageHandleMetadata(image_decoder, callbacks, input, io_buf,
+                                      raw_metadata_buf, flags);
         if (!error_message.empty()) {
           return DecodeImageResult(std::move(error_message));
         }
@@ -459,6 +845,39 @@ redirect:
                             WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, w, h);
   }
 
+  // Shrink the pixel buffer to the region of interest, downscaled.
+  wuffs_base__decode_frame_options decode_frame_options =
+      wuffs_base__null_decode_frame_options();
+  decode_frame_options.set_roi(region_of_interest);
+  decode_frame_options.set_downscale_shift(downscale_shift);
+  downscale_shift = decode_frame_options.downscale_shift();
+  if ((downscale_shift > 0) && (pixel_blend != WUFFS_BASE__PIXEL_BLEND__SRC)) {
+    return DecodeImageResult(DecodeImage_UnsupportedPixelBlend);
+  }
+  wuffs_base__rect_ie_u32 roi =
+      image_config.pixcfg.bounds().intersect(region_of_interest);
+  uint32_t bias = (((uint32_t)1) << downscale_shift) - 1;
+  uint32_t pw = (uint32_t)((((uint64_t)roi.width()) + bias) >> downscale_shift);
+  uint32_t ph =
+      (uint32_t)((((uint64_t)roi.height()) + bias) >> downscale_shift);
+  if ((pw != w) || (ph != h)) {
+    image_config.pixcfg.set(image_config.pixcfg.pixel_format().repr,
+                            image_config.pixcfg.pixel_subsampling().repr, pw,
+                            ph);
+  }
+
+  // Shrink the pixel buffer further, to a band of rows, when streaming.
+  uint32_t row_band_height = callbacks.SelectRowBandHeight(image_config);
+  bool streaming = (row_band_height > 0) && (row_band_height < ph) &&
+                   (downscale_shift == 0) &&
+                   image_decoder->can_decode_row_bands();
+  if (streaming) {
+    decode_frame_options.set_row_band_height(row_band_height);
+    image_config.pixcfg.set(image_config.pixcfg.pixel_format().repr,
+                            image_config.pixcfg.pixel_subsampling().repr, pw,
+                            row_band_height);
+  }
+
   // Allocate the pixel buffer.
   bool valid_background_color =
       wuffs_base__color_u32_argb_premul__is_valid(background_color);
@@ -479,6 +898,13 @@ redirect:
   // Allocate the work buffer. Wuffs' decoders conventionally assume that this
   // can be uninitialized memory.
   wuffs_base__range_ii_u64 workbuf_len = image_decoder->workbuf_len();
+  uint64_t downscale_workbuf_len =
+      decode_frame_options.downscale_workbuf_len(w);
+  if (downscale_workbuf_len > 0) {
+    workbuf_len = wuffs_base__make_range_ii_u64(
+        wuffs_base__u64__sat_add(workbuf_len.min_incl, downscale_workbuf_len),
+        wuffs_base__u64__sat_add(workbuf_len.max_incl, downscale_workbuf_len));
+  }
   DecodeImageCallbacks::AllocWorkbufResult alloc_workbuf_result =
       callbacks.AllocWorkbuf(workbuf_len, true);
   if (!alloc_workbuf_result.error_message.empty()) {
@@ -518,9 +944,29 @@ redirect:
   while (true) {
     wuffs_base__status id_df_status =
         image_decoder->decode_frame(&pixel_buffer, &io_buf, pixel_blend,
-                                    alloc_workbuf_result.workbuf, nullptr);
+                                    alloc_workbuf_result.workbuf,
+                                    &decode_frame_options);
     if (id_df_status.repr == nullptr) {
       break;
+    } else if (streaming &&
+               (id_df_status.repr == wuffs_base__suspension__short_write)) {
+      message = DecodeImageHandleRowBand(image_decoder, callbacks,
+                                         pixel_buffer, roi);
+      if (!message.empty()) {
+        break;
+      }
+      // Restore the re-used pixel buffer's background, for the next band.
+      if (valid_background_color ||
+          (pixel_blend == WUFFS_BASE__PIXEL_BLEND__SRC_OVER)) {
+        wuffs_base__status pb_scufr_status =
+            pixel_buffer.set_color_u32_fill_rect(
+                pixel_buffer.pixcfg.bounds(),
+                valid_background_color ? background_color : 0);
+        if (pb_scufr_status.repr != nullptr) {
+          message = pb_scufr_status.message();
+          break;
+        }
+      }
     } else if (id_df_status.repr != wuffs_base__suspension__short_read) {
       message = id_df_status.message();
       break;
@@ -535,6 +981,17 @@ redirect:
       }
     }
   }
+
+  // Hand over the final band or, when falling back from streaming, the whole
+  // output image.
+  if (message.empty() && (row_band_height > 0)) {
+    if (streaming) {
+      message = DecodeImageHandleRowBand(image_decoder, callbacks,
+                                         pixel_buffer, roi);
+    } else if (ph > 0) {
+      message = callbacks.HandleRowBand(pixel_buffer, 0, ph);
+    }
+  }
   return DecodeImageResult(std::move(alloc_pixbuf_result.mem_owner),
                            pixel_buffer, std::move(message));
 }
@@ -549,26 +1006,464 @@ DecodeImage(DecodeImageCallbacks& callbacks,
             DecodeImageArgPixelBlend pixel_blend,
             DecodeImageArgBackgroundColor background_color,
             DecodeImageArgMaxInclDimension max_incl_dimension,
-            DecodeImageArgMaxInclMetadataLength max_incl_metadata_length) {
+            DecodeImageArgMaxInclMetadataLength max_incl_metadata_length,
+            DecodeImageArgRegionOfInterest region_of_interest,
+            DecodeImageArgDownscaleShift downscale_shift) {
   wuffs_base__io_buffer* io_buf = input.BringsItsOwnIOBuffer();
   wuffs_base__io_buffer fallback_io_buf = wuffs_base__empty_io_buffer();
-  std::unique_ptr<uint8_t[]> fallback_io_array(nullptr);
+  MemOwner fallback_io_array_mem_owner(nullptr, &free);
+  wuffs_base__image_decoder::unique_ptr image_decoder(nullptr, &free);
   if (!io_buf) {
-    fallback_io_array = std::unique_ptr<uint8_t[]>(new uint8_t[32768]);
+    DecodeImageCallbacks::AllocIOBufferResult alloc_io_buffer_result =
+        callbacks.AllocIOBuffer();
+    if (!alloc_io_buffer_result.error_message.empty()) {
+      DecodeImageResult result(
+          std::move(alloc_io_buffer_result.error_message));
+      callbacks.Done(result, input, fallback_io_buf, std::move(image_decoder));
+      return result;
+    } else if (alloc_io_buffer_result.array.len == 0) {
+      DecodeImageResult result(DecodeImage_BufferIsTooShort);
+      callbacks.Done(result, input, fallback_io_buf, std::move(image_decoder));
+      return result;
+    }
+    fallback_io_array_mem_owner = std::move(alloc_io_buffer_result.mem_owner);
     fallback_io_buf =
-        wuffs_base__ptr_u8__writer(fallback_io_array.get(), 32768);
+        wuffs_base__slice_u8__writer(alloc_io_buffer_result.array);
     io_buf = &fallback_io_buf;
   }
 
-  wuffs_base__image_decoder::unique_ptr image_decoder(nullptr, &free);
   DecodeImageResult result =
       DecodeImage0(image_decoder, callbacks, input, *io_buf, quirks.repr,
                    flags.repr, pixel_blend.repr, background_color.repr,
-                   max_incl_dimension.repr, max_incl_metadata_length.repr);
+                   max_incl_dimension.repr, max_incl_metadata_length.repr,
+                   region_of_interest.repr, downscale_shift.repr);
   callbacks.Done(result, input, *io_buf, std::move(image_decoder));
   return result;
 }
 
+// --------
+
+DecodeImagesCallbacks::OpenInputResult::OpenInputResult(
+    std::unique_ptr<sync_io::Input>&& input0)
+    : input(std::move(input0)), error_message() {}
+
+DecodeImagesCallbacks::OpenInputResult::OpenInputResult(
+    std::string&& error_message0)
+    : input(nullptr), error_message(std::move(error_message0)) {}
+
+DecodeImagesCallbacks::~DecodeImagesCallbacks() {}
+
+std::unique_ptr<DecodeImageCallbacks>  //
+DecodeImagesCallbacks::NewWorkerCallbacks(uint32_t worker_index) {
+  return std::unique_ptr<DecodeImageCallbacks>(
+      new PoolingDecodeImageCallbacks());
+}
+
+namespace {
+
+// DecodeImagesPool schedules DecodeImages' work. Inputs are claimed in order
+// from a shared counter. Subtasks (parts of one large image) go on per-worker
+// double-ended queues: a worker pushes and pops its own subtasks at the back
+// (the most recently pushed, whose data is most likely to be in its cache)
+// and steals other workers' subtasks from the front.
+//
+// Subtasks are coarse (e.g. 64 KiB or more of compressed data each) and
+// inputs are whole images, so a single mutex guards all of the queues and
+// counters. It also lets idle workers sleep (instead of spinning) until there
+// is more work or until every other worker is done.
+class DecodeImagesPool {
+ public:
+  struct Subtask {
+    std::function<void()>* func;
+    size_t* num_remaining;
+  };
+
+  DecodeImagesPool(size_t num_inputs, uint32_t num_workers)
+      : m_queues(num_workers),
+        m_next_input(0),
+        m_num_inputs(num_inputs),
+        m_num_busy(0) {}
+
+  // NumSpareWorkers returns how many workers are idle, or soon will be,
+  // because there are fewer unclaimed inputs than workers that are not busy.
+  // Such workers are free to steal subtasks.
+  uint32_t NumSpareWorkers() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t num_not_busy = m_queues.size() - m_num_busy;
+    size_t num_unclaimed = m_num_inputs - m_next_input;
+    return (num_not_busy > num_unclaimed)
+               ? static_cast<uint32_t>(num_not_busy - num_unclaimed)
+               : 0;
+  }
+
+  // RunSubtasks runs tasks, pushing all but the first onto worker_index's
+  // queue for idle workers to steal, and returns once they are all done.
+  // While waiting, worker_index helps with any queued subtasks, but does not
+  // claim new inputs.
+  void RunSubtasks(uint32_t worker_index,
+                   std::vector<std::function<void()>>& tasks) {
+    if (tasks.empty()) {
+      return;
+    }
+    size_t num_remaining = tasks.size();
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (size_t i = 1; i < tasks.size(); i++) {
+      m_queues[worker_index].push_back(Subtask{&tasks[i], &num_remaining});
+    }
+    m_cond.notify_all();
+
+    Subtask subtask{&tasks[0], &num_remaining};
+    while (true) {
+      if (subtask.func) {
+        lock.unlock();
+        (*subtask.func)();
+        lock.lock();
+        if (--*subtask.num_remaining == 0) {
+          m_cond.notify_all();
+        }
+      }
+      if (num_remaining == 0) {
+        break;
+      } else if (!PopOrSteal(worker_index, &subtask)) {
+        subtask.func = nullptr;
+        m_cond.wait(lock);
+      }
+    }
+  }
+
+  // Work runs worker_index's loop: running (popped or stolen) subtasks, or
+  // else decoding the next input, until there is nothing left to do.
+  void Work(uint32_t worker_index,
+            const std::function<void(uint32_t, size_t)>& decode_input) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+      Subtask subtask{nullptr, nullptr};
+      if (PopOrSteal(worker_index, &subtask)) {
+        m_num_busy++;
+        lock.unlock();
+        (*subtask.func)();
+        lock.lock();
+        m_num_busy--;
+        if (--*subtask.num_remaining == 0) {
+          m_cond.notify_all();
+        }
+      } else if (m_next_input < m_num_inputs) {
+        size_t input_index = m_next_input++;
+        m_num_busy++;
+        lock.unlock();
+        decode_input(worker_index, input_index);
+        lock.lock();
+        m_num_busy--;
+        if (m_num_busy == 0) {
+          m_cond.notify_all();
+        }
+      } else if (m_num_busy == 0) {
+        // No queued subtasks, no inputs left and no busy worker that could
+        // push more subtasks.
+        return;
+      } else {
+        m_cond.wait(lock);
+      }
+    }
+  }
+
+ private:
+  // PopOrSteal must be called with m_mutex held.
+  bool PopOrSteal(uint32_t worker_index, Subtask* subtask) {
+    std::deque<Subtask>& own = m_queues[worker_index];
+    if (!own.empty()) {
+      *subtask = own.back();
+      own.pop_back();
+      return true;
+    }
+    for (size_t i = 1; i < m_queues.size(); i++) {
+      std::deque<Subtask>& other =
+          m_queues[(worker_index + i) % m_queues.size()];
+      if (!other.empty()) {
+        *subtask = other.front();
+        other.pop_front();
+        return true;
+      }
+    }
+    return false;
+  }
+
+  std::mutex m_mutex;
+  std::condition_variable m_cond;
+  std::vector<std::deque<Subtask>> m_queues;
+  size_t m_next_input;
+  size_t m_num_inputs;
+  uint32_t m_num_busy;
+};
+
+#if !defined(WUFFS_CONFIG__MODULES) || \
+    (defined(WUFFS_CONFIG__MODULE__AUX__PNG) && \
+     defined(WUFFS_CONFIG__MODULE__PNG))
+
+// DecodeImagesPrefilledPngCallbacks wraps a worker's DecodeImageCallbacks,
+// for decoding a PNG image whose workbuf (the inflated IDAT data) has already
+// been filled in.
+class DecodeImagesPrefilledPngCallbacks : public DecodeImageCallbacks {
+ public:
+  DecodeImagesPrefilledPngCallbacks(DecodeImageCallbacks& inner,
+                                    wuffs_base__slice_u8 workbuf)
+      : m_inner(inner), m_workbuf(workbuf) {}
+
+  AllocIOBufferResult  //
+  AllocIOBuffer() override {
+    return m_inner.AllocIOBuffer();
+  }
+
+  wuffs_base__image_decoder::unique_ptr  //
+  SelectDecoder(uint32_t fourcc,
+                wuffs_base__slice_u8 prefix_data,
+                bool prefix_closed) override {
+    if (fourcc != WUFFS_BASE__FOURCC__PNG) {
+      return m_inner.SelectDecoder(fourcc, prefix_data, prefix_closed);
+    }
+    wuffs_base__image_decoder::unique_ptr dec =
+        wuffs_png__decoder::alloc_as__wuffs_base__image_decoder();
+    if (dec) {
+      // The alloc_as__wuffs_base__image_decoder function returns a
+      // wuffs_png__decoder* cast to a wuffs_base__image_decoder*, so that
+      // this cast back is valid. The Adler-32 checksum was already verified.
+      reinterpret_cast<wuffs_png__decoder*>(dec.get())
+          ->set_workbuf_prefilled(true);
+      dec->set_quirk_enabled(WUFFS_BASE__QUIRK_IGNORE_CHECKSUM, true);
+    }
+    return dec;
+  }
+
+  std::string  //
+  HandleMetadata(const wuffs_base__more_information& minfo,
+                 wuffs_base__slice_u8 raw) override {
+    return m_inner.HandleMetadata(minfo, raw);
+  }
+
+  std::string  //
+  HandleMetadataRanges(
+      const wuffs_base__more_information& minfo,
+      const std::vector<wuffs_base__range_ie_u64>& ranges) override {
+    return m_inner.HandleMetadataRanges(minfo, ranges);
+  }
+
+  wuffs_base__pixel_format  //
+  SelectPixfmt(const wuffs_base__image_config& image_config) override {
+    return m_inner.SelectPixfmt(image_config);
+  }
+
+  uint32_t  //
+  SelectRowBandHeight(const wuffs_base__image_config& image_config) override {
+    return m_inner.SelectRowBandHeight(image_config);
+  }
+
+  AllocPixbufResult  //
+  AllocPixbuf(const wuffs_base__image_config& image_config,
+              bool allow_uninitialized_memory) override {
+    return m_inner.AllocPixbuf(image_config, allow_uninitialized_memory);
+  }
+
+  AllocWorkbufResult  //
+  AllocWorkbuf(wuffs_base__range_ii_u64 len_range,
+               bool allow_uninitialized_memory) override {
+    if (len_range.max_incl != m_workbuf.len) {
+      return AllocWorkbufResult(
+          "wuffs_aux::DecodeImages: unexpected work buffer length");
+    }
+    // The returned MemOwner is a no-op: DecodeImagesSplitPng keeps the
+    // memory.
+    return AllocWorkbufResult(MemOwner(nullptr, &free), m_workbuf);
+  }
+
+  std::string  //
+  HandleRowBand(wuffs_base__pixel_buffer& pixbuf,
+                uint32_t y,
+                uint32_t num_rows) override {
+    return m_inner.HandleRowBand(pixbuf, y, num_rows);
+  }
+
+  void  //
+  Done(DecodeImageResult& result,
+       sync_io::Input& input,
+       IOBuffer& buffer,
+       wuffs_base__image_decoder::unique_ptr image_decoder) override {
+    m_inner.Done(result, input, buffer, std::move(image_decoder));
+  }
+
+ private:
+  DecodeImageCallbacks& m_inner;
+  wuffs_base__slice_u8 m_workbuf;
+};
+
+// DecodeImagesSplitPng decodes input, if it is a large enough, in-memory,
+// non-interlaced PNG image, inflating its IDAT data as pool subtasks. It
+// returns false (and the caller should fall back to DecodeImage) otherwise,
+// including if the IDAT data is invalid, so that the error message is the
+// same as DecodeImage's.
+bool  //
+DecodeImagesSplitPng(DecodeImageResult& result,
+                     DecodeImagesPool& pool,
+                     uint32_t worker_index,
+                     DecodeImageCallbacks& callbacks,
+                     sync_io::Input& input,
+                     DecodeImageArgQuirks quirks,
+                     DecodeImageArgFlags flags,
+                     DecodeImageArgPixelBlend pixel_blend,
+                     DecodeImageArgBackgroundColor background_color,
+                     DecodeImageArgMaxInclDimension max_incl_dimension,
+                     DecodeImageArgMaxInclMetadataLength max_incl_metadata_length,
+                     DecodeImageArgRegionOfInterest region_of_interest) {
+  // Smaller images aren't worth splitting. ParallelInflatePngIdatWith's
+  // bands are at least 64 KiB each.
+  static constexpr size_t min_len = 262144;
+
+  wuffs_base__io_buffer* io_buf = input.BringsItsOwnIOBuffer();
+  if (!io_buf || !io_buf->meta.closed || (io_buf->meta.ri != 0) ||
+      (io_buf->meta.wi < min_len)) {
+    return false;
+  }
+  const uint8_t* ptr = io_buf->data.ptr;
+  size_t len = io_buf->meta.wi;
+  // The IHDR chunk's interlace method is at offset 28, after the 8 byte
+  // signature, 8 byte chunk header and 12 other bytes of IHDR payload.
+  if ((wuffs_base__magic_number_guess_fourcc(
+           wuffs_base__make_slice_u8(const_cast<uint8_t*>(ptr), len), true) !=
+       WUFFS_BASE__FOURCC__PNG) ||
+      (ptr[28] != 0)) {
+    return false;
+  }
+
+  // Find the workbuf length, which for a non-interlaced image is the
+  // inflated IDAT data's length.
+  wuffs_png__decoder::unique_ptr dec = wuffs_png__decoder::alloc();
+  if (!dec) {
+    return false;
+  }
+  wuffs_base__image_config image_config = wuffs_base__null_image_config();
+  wuffs_base__io_buffer src =
+      wuffs_base__ptr_u8__reader(const_cast<uint8_t*>(ptr), len, true);
+  if (!dec->decode_image_config(&image_config, &src).is_ok()) {
+    return false;
+  }
+  uint64_t workbuf_len = dec->workbuf_len().max_incl;
+  if ((workbuf_len == 0) || (SIZE_MAX < workbuf_len)) {
+    return false;
+  }
+  DecodeImageCallbacks::AllocWorkbufResult alloc_workbuf_result =
+      callbacks.AllocWorkbuf(
+          wuffs_base__make_range_ii_u64(workbuf_len, workbuf_len), true);
+  if (!alloc_workbuf_result.error_message.empty() ||
+      (alloc_workbuf_result.workbuf.len < workbuf_len)) {
+    return false;
+  }
+  wuffs_base__slice_u8 workbuf = wuffs_base__make_slice_u8(
+      alloc_workbuf_result.workbuf.ptr, (size_t)workbuf_len);
+
+  uint32_t max_num_bands = 1 + pool.NumSpareWorkers();
+  if (!private_impl::ParallelInflatePngIdatWith(
+           workbuf, ptr, len, max_num_bands,
+           [&pool, worker_index](std::vector<std::function<void()>>& tasks) {
+             pool.RunSubtasks(worker_index, tasks);
+           })
+           .empty()) {
+    return false;
+  }
+
+  DecodeImagesPrefilledPngCallbacks prefilled_callbacks(callbacks, workbuf);
+  result = DecodeImage(prefilled_callbacks, input, quirks, flags, pixel_blend,
+                       background_color, max_incl_dimension,
+                       max_incl_metadata_length, region_of_interest);
+  return true;
+}
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) ||
+        // (defined(WUFFS_CONFIG__MODULE__AUX__PNG) &&
+        //  defined(WUFFS_CONFIG__MODULE__PNG))
+
+}  // namespace
+
+std::string  //
+DecodeImages(DecodeImagesCallbacks& callbacks,
+             size_t num_inputs,
+             uint32_t num_threads,
+             DecodeImageArgQuirks quirks,
+             DecodeImageArgFlags flags,
+             DecodeImageArgPixelBlend pixel_blend,
+             DecodeImageArgBackgroundColor background_color,
+             DecodeImageArgMaxInclDimension max_incl_dimension,
+             DecodeImageArgMaxInclMetadataLength max_incl_metadata_length,
+             DecodeImageArgRegionOfInterest region_of_interest,
+             DecodeImageArgDownscaleShift downscale_shift) {
+  if (num_inputs == 0) {
+    return "";
+  } else if (num_threads == 0) {
+    num_threads = std::thread::hardware_concurrency();
+    if (num_threads == 0) {
+      num_threads = 1;
+    }
+  }
+
+  std::vector<std::unique_ptr<DecodeImageCallbacks>> worker_callbacks;
+  for (uint32_t i = 0; i < num_threads; i++) {
+    worker_callbacks.push_back(callbacks.NewWorkerCallbacks(i));
+    if (!worker_callbacks.back()) {
+      return "wuffs_aux::DecodeImages: NewWorkerCallbacks returned nullptr";
+    }
+  }
+
+  DecodeImagesPool pool(num_inputs, num_threads);
+  std::function<void(uint32_t, size_t)> decode_input =
+      [&](uint32_t worker_index, size_t input_index) {
+        DecodeImagesCallbacks::OpenInputResult open_input_result =
+            callbacks.OpenInput(input_index);
+        if (!open_input_result.error_message.empty() ||
+            !open_input_result.input) {
+          DecodeImageResult result(
+              open_input_result.error_message.empty()
+                  ? "wuffs_aux::DecodeImages: OpenInput returned nullptr"
+                  : std::move(open_input_result.error_message));
+          callbacks.Done(input_index, result);
+          return;
+        }
+        DecodeImageCallbacks& worker = *worker_callbacks[worker_index];
+        sync_io::Input& input = *open_input_result.input;
+
+#if !defined(WUFFS_CONFIG__MODULES) || \
+    (defined(WUFFS_CONFIG__MODULE__AUX__PNG) && \
+     defined(WUFFS_CONFIG__MODULE__PNG))
+        if ((downscale_shift.repr == 0) && (pool.NumSpareWorkers() > 0)) {
+          DecodeImageResult result("");
+          if (DecodeImagesSplitPng(result, pool, worker_index, worker, input,
+                                   quirks, flags, pixel_blend,
+                                   background_color, max_incl_dimension,
+                                   max_incl_metadata_length,
+                                   region_of_interest)) {
+            callbacks.Done(input_index, result);
+            return;
+          }
+        }
+#endif
+
+        DecodeImageResult result =
+            DecodeImage(worker, input, quirks, flags, pixel_blend,
+                        background_color, max_incl_dimension,
+                        max_incl_metadata_length, region_of_interest,
+                        downscale_shift);
+        callbacks.Done(input_index, result);
+      };
+
+  std::vector<std::thread> threads;
+  for (uint32_t i = 1; i < num_threads; i++) {
+    threads.emplace_back(&DecodeImagesPool::Work, &pool, i,
+                         std::cref(decode_input));
+  }
+  pool.Work(0, decode_input);
+  for (auto& t : threads) {
+    t.join();
+  }
+  return "";
+}
+
 }  // namespace wuffs_aux
 
 #endif  // !defined(WUFFS_CONFIG__MODULES) ||
@@ -14,6 +14,10 @@
 
 // ---------------- Auxiliary - Image
 
+#include <memory>
+#include <utility>
+#include <vector>
+
 namespace wuffs_aux {
 
 struct DecodeImageResult {
@@ -29,17 +33,34 @@ struct DecodeImageResult {
 
 // DecodeImageCallbacks are the callbacks given to DecodeImage. They are always
 // called in this order:
-//  1. SelectDecoder
-//  2. HandleMetadata
-//  3. SelectPixfmt
-//  4. AllocPixbuf
-//  5. AllocWorkbuf
-//  6. Done
+//  1. AllocIOBuffer
+//  2. SelectDecoder
+//  3. HandleMetadata (or HandleMetadataRanges)
+//  4. SelectPixfmt
+//  5. SelectRowBandHeight
+//  6. AllocPixbuf
+//  7. AllocWorkbuf
+//  8. HandleRowBand
+//  9. Done
 //
 // It may return early - the third callback might not be invoked if the second
-// one fails - but the final callback (Done) is always invoked.
+// one fails - but the final callback (Done) is always invoked. HandleRowBand
+// may be invoked zero, one or more times. AllocIOBuffer is only invoked if the
+// sync_io::Input does not bring its own IOBuffer.
 class DecodeImageCallbacks {
  public:
+  // AllocIOBufferResult holds a memory allocation (the result of malloc or
+  // new, a statically allocated pointer, etc), or an error message. The memory
+  // is de-allocated when mem_owner goes out of scope and is destroyed.
+  struct AllocIOBufferResult {
+    AllocIOBufferResult(MemOwner&& mem_owner0, wuffs_base__slice_u8 array0);
+    AllocIOBufferResult(std::string&& error_message0);
+
+    MemOwner mem_owner;
+    wuffs_base__slice_u8 array;
+    std::string error_message;
+  };
+
   // AllocPixbufResult holds a memory allocation (the result of malloc or new,
   // a statically allocated pointer, etc), or an error message. The memory is
   // de-allocated when mem_owner goes out of scope and is destroyed.
@@ -66,6 +87,15 @@ class DecodeImageCallbacks {
 
   virtual ~DecodeImageCallbacks();
 
+  // AllocIOBuffer allocates the backing array for the IOBuffer that the input
+  // data is read into (via sync_io::Input::CopyIn). The array's contents need
+  // not be initialized. It should be at least a few KiB long, since the
+  // SelectDecoder prefix_data is limited by it.
+  //
+  // The default AllocIOBuffer implementation allocates 32 KiB.
+  virtual AllocIOBufferResult  //
+  AllocIOBuffer();
+
   // SelectDecoder returns the image decoder for the input data's file format.
   // Returning a nullptr means failure (DecodeImage_UnsupportedImageFormat).
   //
@@ -89,10 +119,13 @@ class DecodeImageCallbacks {
   // WUFFS_CONFIG__MODULE__ETC).
   //  - WUFFS_BASE__FOURCC__BMP
   //  - WUFFS_BASE__FOURCC__GIF
+  //  - WUFFS_BASE__FOURCC__ICO
+  //  - WUFFS_BASE__FOURCC__JPEG
   //  - WUFFS_BASE__FOURCC__NIE
   //  - WUFFS_BASE__FOURCC__PNG
   //  - WUFFS_BASE__FOURCC__TGA
   //  - WUFFS_BASE__FOURCC__WBMP
+  //  - WUFFS_BASE__FOURCC__WEBP
   virtual wuffs_base__image_decoder::unique_ptr  //
   SelectDecoder(uint32_t fourcc,
                 wuffs_base__slice_u8 prefix_data,
@@ -114,6 +147,29 @@ class DecodeImageCallbacks {
   HandleMetadata(const wuffs_base__more_information& minfo,
                  wuffs_base__slice_u8 raw);
 
+  // HandleMetadataRanges is like HandleMetadata but, instead of a copy of the
+  // metadata bytes, it is given where they are in the input: a list of
+  // non-empty, non-adjacent, increasing I/O position ranges. It is called
+  // instead of HandleMetadata for WUFFS_BASE__MORE_INFORMATION__FLAVOR__
+  // METADATA_RAW_PASSTHROUGH metadata, if the REPORT_METADATA_RAW_
+  // PASSTHROUGH_AS_RANGES DecodeImageArgFlags bit was passed to DecodeImage.
+  //
+  // For example, a PNG eXIf chunk's payload is one range but a GIF ICC
+  // profile, split over multiple GIF data sub-blocks, can be many ranges.
+  //
+  // For a sync_io::MemoryInput (or any other input whose IOBuffer holds the
+  // whole file, starting at I/O position zero), the ranges are offsets into
+  // that memory, which callers can slice directly, without any copying.
+  // Otherwise, DecodeImage skips over those bytes and the ranges can be used
+  // to re-read them (e.g. with pread) later, if at all.
+  //
+  // It returns an error message, or an empty string on success.
+  //
+  // The default HandleMetadataRanges implementation is a no-op.
+  virtual std::string  //
+  HandleMetadataRanges(const wuffs_base__more_information& minfo,
+                       const std::vector<wuffs_base__range_ie_u64>& ranges);
+
   // SelectPixfmt returns the destination pixel format for AllocPixbuf. It
   // should return wuffs_base__make_pixel_format(etc) called with one of:
   //  - WUFFS_BASE__PIXEL_FORMAT__BGR_565
@@ -135,6 +191,26 @@ class DecodeImageCallbacks {
   virtual wuffs_base__pixel_format  //
   SelectPixfmt(const wuffs_base__image_config& image_config);
 
+  // SelectRowBandHeight returns how many rows high the pixel buffer should be,
+  // to stream the decoded image (in bands of rows) through HandleRowBand
+  // instead of holding all of it at once. The image_config describes the
+  // whole (region_of_interest clipped, downscaled) output image.
+  //
+  // Returning zero, the default, means to allocate (via AllocPixbuf) and
+  // decode the whole output image without calling HandleRowBand.
+  //
+  // Returning non-zero means that AllocPixbuf is passed an image_config that
+  // is only that many rows high and that HandleRowBand is called with each
+  // band of rows, as soon as it is decoded, re-using that pixel buffer. Memory
+  // use is then proportional to the image width, not its area. This needs a
+  // decoder that supports row bands for that image (see
+  // wuffs_base__decode_frame_options__set_row_band_height), without
+  // downscaling. Otherwise (e.g. for GIF or interlaced PNG images), DecodeImage
+  // falls back to allocating the whole output image and calling HandleRowBand
+  // once, after the image is completely decoded.
+  virtual uint32_t  //
+  SelectRowBandHeight(const wuffs_base__image_config& image_config);
+
   // AllocPixbuf allocates the pixel buffer.
   //
   // allow_uninitialized_memory will be true if a valid background_color was
@@ -158,6 +234,23 @@ class DecodeImageCallbacks {
   AllocWorkbuf(wuffs_base__range_ii_u64 len_range,
                bool allow_uninitialized_memory);
 
+  // HandleRowBand acknowledges a band of decoded rows, if SelectRowBandHeight
+  // returned non-zero. The pixel buffer's rows [0, num_rows) hold the output
+  // image's rows [y, y + num_rows). Bands are typically top to bottom but can
+  // also be bottom to top (e.g. for bottom-up BMP images). After HandleRowBand
+  // returns, the pixel buffer is re-used for the next band, so do not keep a
+  // reference to its pixels. An incomplete band (e.g. for a truncated input
+  // file) is not handed over, but is still left in the DecodeImageResult's
+  // pixbuf.
+  //
+  // It returns an error message, or an empty string on success.
+  //
+  // The default HandleRowBand implementation is a no-op.
+  virtual std::string  //
+  HandleRowBand(wuffs_base__pixel_buffer& pixbuf,
+                uint32_t y,
+                uint32_t num_rows);
+
   // Done is always the last Callback method called by DecodeImage, whether or
   // not parsing the input encountered an error. Even when successful, trailing
   // data may remain in input and buffer.
@@ -189,6 +282,105 @@ extern const char DecodeImage_UnsupportedPixelBlend[];
 extern const char DecodeImage_UnsupportedPixelConfiguration[];
 extern const char DecodeImage_UnsupportedPixelFormat[];
 
+// PoolingDecodeImageCallbacks are DecodeImageCallbacks that re-use memory
+// across DecodeImage calls, instead of allocating and freeing it for every
+// image. This can be noticeably faster when decoding many small images.
+//
+// Three sorts of memory are pooled:
+//  - The image decoders (at most one per FourCC) returned by SelectDecoder and
+//    handed back via Done. A pooled decoder is re-initialized with
+//    WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, which is cheaper
+//    than allocating (and zeroing) a new one. Only decoders returned by the
+//    default SelectDecoder implementation (which this class's SelectDecoder
+//    falls back to) are pooled.
+//  - The work buffer, which grows to be as large as the largest requested.
+//  - The IOBuffer's backing array.
+//
+// The pixel buffer is different, as its ownership passes to the
+// DecodeImageResult. Callers that are done with a result's pixels can hand
+// its memory back via the recycle method, for the next AllocPixbuf call to
+// re-use (if it is large enough) instead of allocating afresh. For large
+// images, re-using memory whose pages are already faulted in (and, under a
+// LargeAllocationPolicy, backed by huge pages) avoids most of the page faults
+// that a fresh allocation would otherwise take.
+//
+// Subclasses can override the other callbacks as usual. Those that override
+// SelectDecoder, AllocPixbuf, AllocWorkbuf, AllocIOBuffer or Done should call
+// the PoolingDecodeImageCallbacks implementation to keep the pooling behavior.
+//
+// The pooled memory is only used by one DecodeImage call at a time. Do not use
+// one PoolingDecodeImageCallbacks for concurrent (or nested) DecodeImage
+// calls. Giving each thread its own one (e.g. as a thread_local variable) is
+// fine. The memory is held until the PoolingDecodeImageCallbacks is destroyed
+// or the drop method is called.
+class PoolingDecodeImageCallbacks : public DecodeImageCallbacks {
+ public:
+  PoolingDecodeImageCallbacks();
+
+  // drop frees the pooled memory. It should not be called during a
+  // DecodeImage call.
+  void drop();
+
+  // recycle takes result's pixel buffer memory (leaving result.pixbuf_mem_owner
+  // empty) into the pool, if it was allocated by AllocPixbuf (this class's or
+  // the default implementation) and is at least as large as what the pool
+  // already holds. Otherwise, that memory is freed. Either way, result.pixbuf
+  // is no longer valid afterwards. It should not be called during a
+  // DecodeImage call.
+  void recycle(DecodeImageResult& result);
+
+  AllocIOBufferResult  //
+  AllocIOBuffer() override;
+
+  wuffs_base__image_decoder::unique_ptr  //
+  SelectDecoder(uint32_t fourcc,
+                wuffs_base__slice_u8 prefix_data,
+                bool prefix_closed) override;
+
+  AllocPixbufResult  //
+  AllocPixbuf(const wuffs_base__image_config& image_config,
+              bool allow_uninitialized_memory) override;
+
+  AllocWorkbufResult  //
+  AllocWorkbuf(wuffs_base__range_ii_u64 len_range,
+               bool allow_uninitialized_memory) override;
+
+  void  //
+  Done(DecodeImageResult& result,
+       sync_io::Input& input,
+       IOBuffer& buffer,
+       wuffs_base__image_decoder::unique_ptr image_decoder) override;
+
+ private:
+  // m_decoders holds the pooled image decoders, keyed by FourCC.
+  std::vector<std::pair<uint32_t, wuffs_base__image_decoder::unique_ptr>>
+      m_decoders;
+
+  // m_selected_fourcc and m_selected_decoder identify the image decoder most
+  // recently returned by SelectDecoder, which Done may return to the pool.
+  uint32_t m_selected_fourcc;
+  wuffs_base__image_decoder* m_selected_decoder;
+
+  MemOwner m_workbuf_mem_owner;
+  size_t m_workbuf_len;
+
+  MemOwner m_io_array_mem_owner;
+
+  // m_pixbuf_mem_owner holds the pooled pixel buffer memory, m_pixbuf_len
+  // bytes long. m_lent_pixbuf_ptr and m_lent_pixbuf_len identify the memory
+  // that AllocPixbuf most recently handed out, which can be longer than that
+  // image's pixbuf_len, so that recycle can take back all of it.
+  MemOwner m_pixbuf_mem_owner;
+  size_t m_pixbuf_len;
+  void* m_lent_pixbuf_ptr;
+  size_t m_lent_pixbuf_len;
+
+  // Delete the copy and assign constructors.
+  PoolingDecodeImageCallbacks(const PoolingDecodeImageCallbacks&) = delete;
+  PoolingDecodeImageCallbacks& operator=(const PoolingDecodeImageCallbacks&) =
+      delete;
+};
+
 // The FooArgBar types add structure to Foo's optional arguments. They wrap
 // inner representations for several reasons:
 //  - It provides a home for the DefaultValue static method, for Foo callers
@@ -245,6 +437,16 @@ struct DecodeImageArgFlags {
   // Extensible Metadata Platform.
   static constexpr uint64_t REPORT_METADATA_XMP = 0x0400;
 
+  // Report RAW_PASSTHROUGH metadata (e.g. PNG EXIF or GIF ICCP and XMP) as
+  // input byte ranges, via the HandleMetadataRanges callback, instead of
+  // copying it for the HandleMetadata callback. This is not a metadata kind
+  // itself: it applies to the other REPORT_METADATA_ETC bits. Since nothing
+  // is copied, the max_incl_metadata_length limit does not apply to such
+  // metadata. Metadata that needs transforming (e.g. zlib-compressed PNG ICCP
+  // or KVP) is still copied.
+  static constexpr uint64_t REPORT_METADATA_RAW_PASSTHROUGH_AS_RANGES =
+      0x8000000000000000;
+
   uint64_t repr;
 };
 
@@ -290,6 +492,26 @@ struct DecodeImageArgMaxInclMetadataLength {
   uint64_t repr;
 };
 
+// DecodeImageArgRegionOfInterest wraps an optional argument to DecodeImage.
+struct DecodeImageArgRegionOfInterest {
+  explicit DecodeImageArgRegionOfInterest(wuffs_base__rect_ie_u32 repr0);
+
+  // DefaultValue returns (0, 0)-(0xFFFF_FFFF, 0xFFFF_FFFF), the whole image.
+  static DecodeImageArgRegionOfInterest DefaultValue();
+
+  wuffs_base__rect_ie_u32 repr;
+};
+
+// DecodeImageArgDownscaleShift wraps an optional argument to DecodeImage.
+struct DecodeImageArgDownscaleShift {
+  explicit DecodeImageArgDownscaleShift(uint32_t repr0);
+
+  // DefaultValue returns 0, meaning no downscaling.
+  static DecodeImageArgDownscaleShift DefaultValue();
+
+  uint32_t repr;
+};
+
 // DecodeImage decodes the image data in input. A variety of image file formats
 // can be decoded, depending on what callbacks.SelectDecoder returns.
 //
@@ -301,6 +523,9 @@ struct DecodeImageArgMaxInclMetadataLength {
 // the network), use Wuffs' lower level C API instead of its higher level,
 // simplified C++ API (the wuffs_aux API).
 //
+// When streaming (see DecodeImageCallbacks::SelectRowBandHeight), the
+// DecodeImageResult's pixbuf holds only the final band of rows.
+//
 // The DecodeImageResult's fields depend on whether decoding succeeded:
 //  - On total success, the error_message is empty and pixbuf.pixcfg.is_valid()
 //    is true.
@@ -311,10 +536,12 @@ struct DecodeImageArgMaxInclMetadataLength {
 //  - On failure, the error_message is non_empty and pixbuf.pixcfg.is_valid()
 //    is false.
 //
-// The callbacks allocate the pixel buffer memory and work buffer memory. On
-// success, pixel buffer memory ownership is passed to the DecodeImage caller
-// as the returned pixbuf_mem_owner. Regardless of success or failure, the work
-// buffer memory is deleted.
+// The callbacks allocate the pixel buffer memory, work buffer memory and (if
+// the input does not bring its own) I/O buffer memory. On success, pixel
+// buffer memory ownership is passed to the DecodeImage caller as the returned
+// pixbuf_mem_owner. Regardless of success or failure, the work buffer and I/O
+// buffer memory is deleted (or, for PoolingDecodeImageCallbacks, kept for the
+// next DecodeImage call).
 //
 // The pixel_blend (one of the constants listed below) determines how to
 // composite the decoded image over the pixel buffer's original pixels (as
@@ -334,6 +561,18 @@ struct DecodeImageArgMaxInclMetadataLength {
 // Decoding fails (with DecodeImage_MaxInclDimensionExceeded) if the image's
 // width or height is greater than max_incl_dimension or if any opted-in (via
 // flags bits) metadata is longer than max_incl_metadata_length.
+//
+// The region_of_interest, in the image's coordinate space, limits which pixels
+// are decoded. The image_config passed to callbacks.AllocPixbuf has the width
+// and height of the region_of_interest (intersected with the image bounds)
+// and the returned pixbuf's top left pixel is the region_of_interest's top
+// left pixel. The max_incl_dimension check still applies to the whole image.
+//
+// A non-zero downscale_shift (1, 2 or 3) box-filters the region_of_interest
+// down by a factor of 2, 4 or 8 in each dimension as it is decoded, so that
+// the image_config passed to callbacks.AllocPixbuf is correspondingly smaller
+// (rounding up). Not every decoder, pixel format or pixel_blend supports this,
+// per wuffs_base__decode_frame_options__set_downscale_shift.
 DecodeImageResult  //
 DecodeImage(DecodeImageCallbacks& callbacks,
             sync_io::Input& input,
@@ -346,6 +585,98 @@ DecodeImage(DecodeImageCallbacks& callbacks,
             DecodeImageArgMaxInclDimension max_incl_dimension =
                 DecodeImageArgMaxInclDimension::DefaultValue(),
             DecodeImageArgMaxInclMetadataLength max_incl_metadata_length =
-                DecodeImageArgMaxInclMetadataLength::DefaultValue());
+                DecodeImageArgMaxInclMetadataLength::DefaultValue(),
+            DecodeImageArgRegionOfInterest region_of_interest =
+                DecodeImageArgRegionOfInterest::DefaultValue(),
+            DecodeImageArgDownscaleShift downscale_shift =
+                DecodeImageArgDownscaleShift::DefaultValue());
+
+// DecodeImagesCallbacks are the callbacks given to DecodeImages.
+class DecodeImagesCallbacks {
+ public:
+  // OpenInputResult holds an input (and any state it refers to, such as an
+  // mmap'ed file, should be owned by that sync_io::Input subclass), or an
+  // error message.
+  struct OpenInputResult {
+    OpenInputResult(std::unique_ptr<sync_io::Input>&& input0);
+    OpenInputResult(std::string&& error_message0);
+
+    std::unique_ptr<sync_io::Input> input;
+    std::string error_message;
+  };
+
+  virtual ~DecodeImagesCallbacks();
+
+  // NewWorkerCallbacks returns the DecodeImageCallbacks that one worker
+  // (numbered from 0 up to but excluding the number of workers) uses for
+  // every image that it decodes, one image at a time. It is called for every
+  // worker, serially, before any input is opened. Returning a nullptr means
+  // failure.
+  //
+  // The default NewWorkerCallbacks implementation returns a new
+  // PoolingDecodeImageCallbacks, so that each worker re-uses its own decoders
+  // and work buffer without locking.
+  virtual std::unique_ptr<DecodeImageCallbacks>  //
+  NewWorkerCallbacks(uint32_t worker_index);
+
+  // OpenInput returns the input_index'th input. It may be called concurrently
+  // (for different input_index values) from different worker threads.
+  virtual OpenInputResult  //
+  OpenInput(size_t input_index) = 0;
+
+  // Done is called once per input_index, with the DecodeImage-like result of
+  // decoding that input (or of failing to open it). It may be called
+  // concurrently (for different input_index values) from different worker
+  // threads, in any order. Like any DecodeImageResult, ownership of the pixel
+  // buffer memory moves to the Done implementation.
+  virtual void  //
+  Done(size_t input_index, DecodeImageResult& result) = 0;
+};
+
+// DecodeImages decodes num_inputs images, as if calling DecodeImage for each
+// of them, passing each result to callbacks.Done. The optional arguments have
+// the same meaning as for DecodeImage and apply to every input.
+//
+// Unlike the rest of Wuffs, it is not single-threaded. There are up to
+// num_threads (zero means std::thread::hardware_concurrency()) workers, the
+// calling thread being one of them, each with its own DecodeImageCallbacks
+// (see NewWorkerCallbacks). Workers claim inputs in order, one at a time.
+// Each worker also has a double-ended queue of subtasks: it pushes and pops
+// its own at the back and, when it has nothing else to do, steals from the
+// front of other workers' queues.
+//
+// When other workers are idle, or soon will be because there are fewer
+// unclaimed inputs than workers (e.g. at the end of a batch, or for a batch of
+// one), a worker can split a single large image into subtasks. Currently,
+// this applies to non-interlaced, in-memory (see
+// sync_io::Input::BringsItsOwnIOBuffer) PNG images whose IDAT zlib stream has
+// full flush points: the bands between flush points are inflated as subtasks
+// (see ParallelInflatePngIdat) and the worker then decodes the image with a
+// wuffs_png__decoder configured with set_workbuf_prefilled(true). Other
+// images are decoded whole, by one worker. In particular, for animated
+// formats like GIF, DecodeImage only decodes the first frame, so there are no
+// other frames to split off (see ParallelDecodeGif instead).
+//
+// It returns an empty string on success or an error message otherwise. An
+// individual input's failure (reported via callbacks.Done) does not stop the
+// other inputs from being decoded and is not an overall failure.
+std::string  //
+DecodeImages(DecodeImagesCallbacks& callbacks,
+             size_t num_inputs,
+             uint32_t num_threads = 0,
+             DecodeImageArgQuirks quirks = DecodeImageArgQuirks::DefaultValue(),
+             DecodeImageArgFlags flags = DecodeImageArgFlags::DefaultValue(),
+             DecodeImageArgPixelBlend pixel_blend =
+                 DecodeImageArgPixelBlend::DefaultValue(),
+             DecodeImageArgBackgroundColor background_color =
+                 DecodeImageArgBackgroundColor::DefaultValue(),
+             DecodeImageArgMaxInclDimension max_incl_dimension =
+                 DecodeImageArgMaxInclDimension::DefaultValue(),
+             DecodeImageArgMaxInclMetadataLength max_incl_metadata_length =
+                 DecodeImageArgMaxInclMetadataLength::DefaultValue(),
+             DecodeImageArgRegionOfInterest region_of_interest =
+                 DecodeImageArgRegionOfInterest::DefaultValue(),
+             DecodeImageArgDownscaleShift downscale_shift =
+                 DecodeImageArgDownscaleShift::DefaultValue());
 
 }  // namespace wuffs_aux
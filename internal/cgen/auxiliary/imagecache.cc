@@ -0,0 +1,241 @@
+// Copyright 2022 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ---------------- Auxiliary - Image Cache
+
+#if !defined(WUFFS_CONFIG__MODULES) || \
+    defined(WUFFS_CONFIG__MODULE__AUX__IMAGECACHE)
+
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace wuffs_aux {
+
+namespace {
+
+void  //
+DecodeImageCache_AppendU32(std::string& s, uint32_t x) {
+  char buf[4] = {
+      static_cast<char>(x >> 0),
+      static_cast<char>(x >> 8),
+      static_cast<char>(x >> 16),
+      static_cast<char>(x >> 24),
+  };
+  s.append(buf, 4);
+}
+
+void  //
+DecodeImageCache_AppendU64(std::string& s, uint64_t x) {
+  DecodeImageCache_AppendU32(s, static_cast<uint32_t>(x >> 0));
+  DecodeImageCache_AppendU32(s, static_cast<uint32_t>(x >> 32));
+}
+
+}  // namespace
+
+struct DecodeImageCache::Shard {
+  // Flight is one decode, shared by the caller that does it and by any
+  // callers that join it.
+  struct Flight {
+    Flight() : done(false), result(nullptr) {}
+
+    bool done;
+    std::shared_ptr<const DecodeImageResult> result;
+  };
+
+  struct Entry {
+    std::shared_ptr<Flight> flight;
+    uint64_t num_bytes;
+    // lru is only valid once flight->done.
+    std::list<const std::string*>::iterator lru;
+  };
+
+  Shard()
+      : num_bytes(0),
+        num_hits(0),
+        num_misses(0),
+        num_joins(0),
+        num_evictions(0) {}
+
+  std::mutex mutex;
+  std::condition_variable cond;
+  std::unordered_map<std::string, Entry> entries;
+  // lru holds the completed entries' keys (pointing into the entries map,
+  // whose elements do not move), most recently used first.
+  std::list<const std::string*> lru;
+  uint64_t num_bytes;
+
+  uint64_t num_hits;
+  uint64_t num_misses;
+  uint64_t num_joins;
+  uint64_t num_evictions;
+
+  void evict_back() {
+    const std::string* key = lru.back();
+    lru.pop_back();
+    auto iter = entries.find(*key);
+    num_bytes -= iter->second.num_bytes;
+    entries.erase(iter);
+  }
+};
+
+DecodeImageCache::DecodeImageCache(uint64_t max_incl_num_bytes,
+                                   uint32_t num_shards)
+    : m_shards(nullptr),
+      m_num_shards(num_shards ? num_shards : 16),
+      m_max_incl_num_bytes_per_shard(0) {
+  m_shards.reset(new Shard[m_num_shards]);
+  m_max_incl_num_bytes_per_shard = max_incl_num_bytes / m_num_shards;
+}
+
+DecodeImageCache::~DecodeImageCache() {}
+
+std::shared_ptr<const DecodeImageResult>  //
+DecodeImageCache::DecodeImage(
+    DecodeImageCallbacks& callbacks,
+    uint64_t callbacks_key,
+    const uint8_t* ptr,
+    size_t len,
+    DecodeImageArgQuirks quirks,
+    DecodeImageArgFlags flags,
+    DecodeImageArgPixelBlend pixel_blend,
+    DecodeImageArgBackgroundColor background_color,
+    DecodeImageArgMaxInclDimension max_incl_dimension,
+    DecodeImageArgMaxInclMetadataLength max_incl_metadata_length,
+    DecodeImageArgRegionOfInterest region_of_interest,
+    DecodeImageArgDownscaleShift downscale_shift) {
+  // Hash the input, outside of any lock. The key is the hash and length of
+  // the input and every other argument that affects the decoded pixels.
+  wuffs_xxhash64__hasher::unique_ptr hasher = wuffs_xxhash64__hasher::alloc();
+  if (!hasher) {
+    return std::make_shared<const DecodeImageResult>(DecodeImage_OutOfMemory);
+  }
+  uint64_t hash = hasher->update_u64(
+      wuffs_base__make_slice_u8(const_cast<uint8_t*>(ptr), ptr ? len : 0));
+
+  std::string key;
+  key.reserve(80 + (4 * quirks.repr.len));
+  DecodeImageCache_AppendU64(key, hash);
+  DecodeImageCache_AppendU64(key, static_cast<uint64_t>(len));
+  DecodeImageCache_AppendU64(key, callbacks_key);
+  DecodeImageCache_AppendU64(key, flags.repr);
+  DecodeImageCache_AppendU32(key, static_cast<uint32_t>(pixel_blend.repr));
+  DecodeImageCache_AppendU32(key, background_color.repr);
+  DecodeImageCache_AppendU32(key, max_incl_dimension.repr);
+  DecodeImageCache_AppendU64(key, max_incl_metadata_length.repr);
+  DecodeImageCache_AppendU32(key, region_of_interest.repr.min_incl_x);
+  DecodeImageCache_AppendU32(key, region_of_interest.repr.min_incl_y);
+  DecodeImageCache_AppendU32(key, region_of_interest.repr.max_excl_x);
+  DecodeImageCache_AppendU32(key, region_of_interest.repr.max_excl_y);
+  DecodeImageCache_AppendU32(key, downscale_shift.repr);
+  DecodeImageCache_AppendU64(key, static_cast<uint64_t>(quirks.repr.len));
+  for (size_t i = 0; i < quirks.repr.len; i++) {
+    DecodeImageCache_AppendU32(key, quirks.repr.ptr[i]);
+  }
+
+  Shard& shard = m_shards[hash % m_num_shards];
+  std::shared_ptr<Shard::Flight> flight;
+  {
+    std::unique_lock<std::mutex> lock(shard.mutex);
+    auto iter = shard.entries.find(key);
+    if (iter != shard.entries.end()) {
+      flight = iter->second.flight;
+      if (flight->done) {
+        shard.num_hits++;
+        shard.lru.splice(shard.lru.begin(), shard.lru, iter->second.lru);
+        return flight->result;
+      }
+      shard.num_joins++;
+      while (!flight->done) {
+        shard.cond.wait(lock);
+      }
+      return flight->result;
+    }
+    shard.num_misses++;
+    flight = std::make_shared<Shard::Flight>();
+    Shard::Entry entry;
+    entry.flight = flight;
+    entry.num_bytes = 0;
+    shard.entries.insert(std::make_pair(key, std::move(entry)));
+  }
+
+  // Decode, outside of any lock.
+  sync_io::MemoryInput input(ptr, len);
+  std::shared_ptr<const DecodeImageResult> result =
+      std::make_shared<const DecodeImageResult>(wuffs_aux::DecodeImage(
+          callbacks, input, quirks, flags, pixel_blend, background_color,
+          max_incl_dimension, max_incl_metadata_length, region_of_interest,
+          downscale_shift));
+  uint64_t num_bytes = result->pixbuf.pixcfg.pixbuf_len();
+
+  {
+    std::unique_lock<std::mutex> lock(shard.mutex);
+    flight->done = true;
+    flight->result = result;
+
+    // Completed entries are only removed under the lock, and this entry was
+    // not completed until now, so it is still there.
+    auto iter = shard.entries.find(key);
+    if (!result->error_message.empty() || !result->pixbuf.pixcfg.is_valid() ||
+        (num_bytes > m_max_incl_num_bytes_per_shard)) {
+      shard.entries.erase(iter);
+    } else {
+      iter->second.num_bytes = num_bytes;
+      shard.lru.push_front(&iter->first);
+      iter->second.lru = shard.lru.begin();
+      shard.num_bytes += num_bytes;
+      // The new entry fits, so eviction stops before it is evicted.
+      while (shard.num_bytes > m_max_incl_num_bytes_per_shard) {
+        shard.evict_back();
+        shard.num_evictions++;
+      }
+    }
+    shard.cond.notify_all();
+  }
+  return result;
+}
+
+void  //
+DecodeImageCache::Clear() {
+  for (uint32_t i = 0; i < m_num_shards; i++) {
+    Shard& shard = m_shards[i];
+    std::unique_lock<std::mutex> lock(shard.mutex);
+    while (!shard.lru.empty()) {
+      shard.evict_back();
+    }
+  }
+}
+
+DecodeImageCache::Stats  //
+DecodeImageCache::GetStats() {
+  Stats stats = {};
+  for (uint32_t i = 0; i < m_num_shards; i++) {
+    Shard& shard = m_shards[i];
+    std::unique_lock<std::mutex> lock(shard.mutex);
+    stats.num_hits += shard.num_hits;
+    stats.num_misses += shard.num_misses;
+    stats.num_joins += shard.num_joins;
+    stats.num_evictions += shard.num_evictions;
+    stats.num_entries += shard.lru.size();
+    stats.num_bytes += shard.num_bytes;
+  }
+  return stats;
+}
+
+}  // namespace wuffs_aux
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) ||
+        // defined(WUFFS_CONFIG__MODULE__AUX__IMAGECACHE)
@@ -0,0 +1,115 @@
+// Copyright 2022 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ---------------- Auxiliary - Image Cache
+
+namespace wuffs_aux {
+
+// DecodeImageCache is a size-bounded cache of DecodeImage results, keyed by
+// the (in-memory) input's contents and by the other DecodeImage arguments. It
+// is content-addressed: the same image bytes at two different addresses (e.g.
+// two copies of a popular asset, fetched twice) share one cache entry.
+//
+// Unlike most of wuffs_aux, it is thread-safe. Concurrent DecodeImage calls
+// for the same key share one decode (single-flight): the first caller decodes
+// and the others wait for and share its result. Calls for different keys only
+// contend when they land in the same shard, each shard having its own lock
+// and its own least-recently-used eviction list.
+//
+// Results are reference-counted. Evicting an entry (or destroying the cache)
+// does not free a pixel buffer that a caller still holds.
+//
+// The code is in its own module (WUFFS_CONFIG__MODULE__AUX__IMAGECACHE),
+// which needs the AUX__IMAGE and XXHASH64 modules.
+class DecodeImageCache {
+ public:
+  struct Stats {
+    // num_hits counts the DecodeImage calls that found a completed entry.
+    uint64_t num_hits;
+    // num_misses counts the DecodeImage calls that decoded the image.
+    uint64_t num_misses;
+    // num_joins counts the DecodeImage calls that waited for another
+    // thread's in-flight decode of the same key.
+    uint64_t num_joins;
+    // num_evictions counts the entries removed to stay within the size bound.
+    uint64_t num_evictions;
+    // num_entries and num_bytes are the number and the total pixel buffer
+    // size of the entries currently cached.
+    uint64_t num_entries;
+    uint64_t num_bytes;
+  };
+
+  // max_incl_num_bytes bounds the total size of the cached pixel buffers. It
+  // is split evenly over num_shards shards (zero means 16). An image larger
+  // than one shard's share is decoded but not cached.
+  DecodeImageCache(uint64_t max_incl_num_bytes, uint32_t num_shards = 0);
+  ~DecodeImageCache();
+
+  // DecodeImage is like the wuffs_aux::DecodeImage function, for the image
+  // data at [ptr .. ptr + len), except that the result might come from (or
+  // be shared with) other calls.
+  //
+  // What the callbacks do is not part of the cache key, so callbacks_key must
+  // distinguish callbacks that would give different pixels. Typically, it is
+  // the repr of the pixel format that callbacks.SelectPixfmt returns. Callbacks
+  // are only called on a miss, not on a hit or join. In particular, on a hit,
+  // HandleMetadata is not called. Streaming callbacks (see
+  // DecodeImageCallbacks::SelectRowBandHeight) should not be used, since the
+  // cached pixbuf would only hold the final band of rows.
+  //
+  // Only total successes (per wuffs_aux::DecodeImage) are cached. On failure
+  // or partial success, the result is returned (including to any joined
+  // callers) but not kept.
+  //
+  // The returned result is shared, so its pixel buffer must not be modified.
+  // The returned pointer is never nullptr.
+  std::shared_ptr<const DecodeImageResult>  //
+  DecodeImage(DecodeImageCallbacks& callbacks,
+              uint64_t callbacks_key,
+              const uint8_t* ptr,
+              size_t len,
+              DecodeImageArgQuirks quirks = DecodeImageArgQuirks::DefaultValue(),
+              DecodeImageArgFlags flags = DecodeImageArgFlags::DefaultValue(),
+              DecodeImageArgPixelBlend pixel_blend =
+                  DecodeImageArgPixelBlend::DefaultValue(),
+              DecodeImageArgBackgroundColor background_color =
+                  DecodeImageArgBackgroundColor::DefaultValue(),
+              DecodeImageArgMaxInclDimension max_incl_dimension =
+                  DecodeImageArgMaxInclDimension::DefaultValue(),
+              DecodeImageArgMaxInclMetadataLength max_incl_metadata_length =
+                  DecodeImageArgMaxInclMetadataLength::DefaultValue(),
+              DecodeImageArgRegionOfInterest region_of_interest =
+                  DecodeImageArgRegionOfInterest::DefaultValue(),
+              DecodeImageArgDownscaleShift downscale_shift =
+                  DecodeImageArgDownscaleShift::DefaultValue());
+
+  // Clear removes every completed entry. In-flight decodes are unaffected.
+  void Clear();
+
+  // GetStats returns the cache's counters, summed over all shards.
+  Stats GetStats();
+
+ private:
+  struct Shard;
+
+  std::unique_ptr<Shard[]> m_shards;
+  uint32_t m_num_shards;
+  uint64_t m_max_incl_num_bytes_per_shard;
+
+  // Delete the copy and assign constructors.
+  DecodeImageCache(const DecodeImageCache&) = delete;
+  DecodeImageCache& operator=(const DecodeImageCache&) = delete;
+};
+
+}  // namespace wuffs_aux
@@ -16,7 +16,12 @@
 
 #if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__AUX__JSON)
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
 #include <utility>
+#include <vector>
 
 namespace wuffs_aux {
 
@@ -27,6 +32,13 @@ DecodeJsonResult::DecodeJsonResult(std::string&& error_message0,
 
 DecodeJsonCallbacks::~DecodeJsonCallbacks() {}
 
+std::string  //
+DecodeJsonCallbacks::AppendBorrowedTextString(const char* ptr, size_t len) {
+  return AppendTextString(std::string(ptr, len));
+}
+
+DecodeJsonLinesCallbacks::~DecodeJsonLinesCallbacks() {}
+
 void  //
 DecodeJsonCallbacks::Done(DecodeJsonResult& result,
                           sync_io::Input& input,
@@ -36,6 +48,10 @@ const char DecodeJson_BadJsonPointer[] =  //
     "wuffs_aux::DecodeJson: bad JSON Pointer";
 const char DecodeJson_NoMatch[] =  //
     "wuffs_aux::DecodeJson: no match";
+const char DecodeJsonLines_NullCallbacks[] =  //
+    "wuffs_aux::DecodeJsonLines: null callbacks";
+const char DecodeJsonLines_TrailingData[] =  //
+    "wuffs_aux::DecodeJsonLines: trailing data";
 
 DecodeJsonArgQuirks::DecodeJsonArgQuirks(wuffs_base__slice_u32 repr0)
     : repr(repr0) {}
@@ -172,12 +188,27 @@ DecodeJson_SplitJsonPointer(std::string& s,
   return std::make_pair(std::move(fragment), i);
 }
 
+// DecodeJson_MatchJsonPointerFragment returns whether the n bytes at ptr
+// match the fragment, starting at its matched'th byte, advancing matched.
+bool  //
+DecodeJson_MatchJsonPointerFragment(std::string& fragment,
+                                    size_t& matched,
+                                    const uint8_t* ptr,
+                                    size_t n) {
+  if (((fragment.size() - matched) < n) ||
+      ((n > 0) && (memcmp(fragment.data() + matched, ptr, n) != 0))) {
+    return false;
+  }
+  matched += n;
+  return true;
+}
+
 // --------
 
 std::string  //
 DecodeJson_WalkJsonPointerFragment(wuffs_base__token_buffer& tok_buf,
                                    wuffs_base__status& tok_status,
-                                   wuffs_json__decoder::unique_ptr& dec,
+                                   wuffs_json__decoder* dec,
                                    wuffs_base__io_buffer* io_buf,
                                    std::string& io_error_message,
                                    size_t& cursor_index,
@@ -206,8 +237,15 @@ do_dict:
   //    done (success). If we've reached the dict's end (VBD__STRUCTURE__POP)
   //    so that there was no next dict key, we're done (failure).
   //  2. Otherwise, skip the next dict value.
+  //
+  // The key is not assembled into a std::string. Instead, each of its pieces
+  // (raw bytes or, for backslash-escapes, code points) is compared against
+  // the fragment as it arrives. The first difference settles it as a
+  // mismatch, after which the rest of the key is only skipped over.
   while (true) {
-    for (std::string str; true;) {
+    size_t matched = 0;
+    bool mismatched = false;
+    while (true) {
       WUFFS_AUX__DECODE_JSON__GET_THE_NEXT_TOKEN;
 
       int64_t vbc = token.value_base_category();
@@ -227,9 +265,10 @@ do_dict:
             // No-op.
           } else if (vbd &
                      WUFFS_BASE__TOKEN__VBD__STRING__CONVERT_1_DST_1_SRC_COPY) {
-            const char* ptr =  // Convert from (uint8_t*).
-                static_cast<const char*>(static_cast<void*>(token_ptr));
-            str.append(ptr, static_cast<size_t>(token_len));
+            mismatched = mismatched ||
+                         !DecodeJson_MatchJsonPointerFragment(
+                             json_pointer_fragment, matched, token_ptr,
+                             static_cast<size_t>(token_len));
           } else {
             goto fail;
           }
@@ -242,9 +281,9 @@ do_dict:
               wuffs_base__make_slice_u8(
                   &u[0], WUFFS_BASE__UTF_8__BYTE_LENGTH__MAX_INCL),
               static_cast<uint32_t>(vbd));
-          const char* ptr =  // Convert from (uint8_t*).
-              static_cast<const char*>(static_cast<void*>(&u[0]));
-          str.append(ptr, n);
+          mismatched = mismatched ||
+                       !DecodeJson_MatchJsonPointerFragment(
+                           json_pointer_fragment, matched, &u[0], n);
           break;
         }
 
@@ -255,7 +294,7 @@ do_dict:
       if (token.continued()) {
         continue;
       }
-      if (str == json_pointer_fragment) {
+      if (!mismatched && (matched == json_pointer_fragment.size())) {
         return "";
       }
       goto skip_the_next_dict_value;
@@ -354,22 +393,29 @@ done:
   return ret_error_message;
 }
 
-}  // namespace
-
 // --------
 
+// DecodeJson_Impl is DecodeJson, except that it re-uses reusable_dec (if
+// non-nullptr) instead of allocating its own wuffs_json__decoder.
 DecodeJsonResult  //
-DecodeJson(DecodeJsonCallbacks& callbacks,
-           sync_io::Input& input,
-           DecodeJsonArgQuirks quirks,
-           DecodeJsonArgJsonPointer json_pointer) {
+DecodeJson_Impl(DecodeJsonCallbacks& callbacks,
+                sync_io::Input& input,
+                DecodeJsonArgQuirks& quirks,
+                DecodeJsonArgJsonPointer& json_pointer,
+                wuffs_json__decoder* reusable_dec) {
   // Prepare the wuffs_base__io_buffer and the resultant error_message.
   wuffs_base__io_buffer* io_buf = input.BringsItsOwnIOBuffer();
   wuffs_base__io_buffer fallback_io_buf = wuffs_base__empty_io_buffer();
-  std::unique_ptr<uint8_t[]> fallback_io_array(nullptr);
+  MemOwner fallback_io_array(nullptr, &Free);
   if (!io_buf) {
-    fallback_io_array = std::unique_ptr<uint8_t[]>(new uint8_t[4096]);
-    fallback_io_buf = wuffs_base__ptr_u8__writer(fallback_io_array.get(), 4096);
+    fallback_io_array = MemOwner(Malloc(4096), &Free);
+    if (!fallback_io_array) {
+      DecodeJsonResult result("wuffs_aux::DecodeJson: out of memory", 0);
+      callbacks.Done(result, input, fallback_io_buf);
+      return result;
+    }
+    fallback_io_buf = wuffs_base__ptr_u8__writer(
+        static_cast<uint8_t*>(fallback_io_array.get()), 4096);
     io_buf = &fallback_io_buf;
   }
   // cursor_index is discussed at
@@ -380,7 +426,20 @@ DecodeJson(DecodeJsonCallbacks& callbacks,
 
   do {
     // Prepare the low-level JSON decoder.
-    wuffs_json__decoder::unique_ptr dec = wuffs_json__decoder::alloc();
+    wuffs_json__decoder::unique_ptr owned_dec(nullptr, &free);
+    wuffs_json__decoder* dec = reusable_dec;
+    if (dec) {
+      wuffs_base__status status = dec->initialize(
+          sizeof__wuffs_json__decoder(), WUFFS_VERSION,
+          WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED);
+      if (!status.is_ok()) {
+        ret_error_message = status.message();
+        goto done;
+      }
+    } else {
+      owned_dec = wuffs_json__decoder::alloc();
+      dec = owned_dec.get();
+    }
     if (!dec) {
       ret_error_message = "wuffs_aux::DecodeJson: out of memory";
       goto done;
@@ -406,9 +465,12 @@ DecodeJson(DecodeJsonCallbacks& callbacks,
     wuffs_base__status tok_status =
         dec->decode_tokens(&tok_buf, io_buf, wuffs_base__empty_slice_u8());
 
-    // Prepare other state.
+    // Prepare other state. A string's bytes are either borrowed (pointing
+    // into io_buf) or, if they are not contiguous there, copied to str.
     int32_t depth = 0;
     std::string str;
+    const char* borrowed_ptr = nullptr;
+    size_t borrowed_len = 0;
 
     // Walk the (optional) JSON Pointer.
     for (size_t i = 0; i < json_pointer.repr.size();) {
@@ -474,14 +536,37 @@ DecodeJson(DecodeJsonCallbacks& callbacks,
                      WUFFS_BASE__TOKEN__VBD__STRING__CONVERT_1_DST_1_SRC_COPY) {
             const char* ptr =  // Convert from (uint8_t*).
                 static_cast<const char*>(static_cast<void*>(token_ptr));
-            str.append(ptr, static_cast<size_t>(token_len));
+            if (!str.empty()) {
+              str.append(ptr, static_cast<size_t>(token_len));
+            } else if (borrowed_len == 0) {
+              borrowed_ptr = ptr;
+              borrowed_len = static_cast<size_t>(token_len);
+            } else if ((borrowed_ptr + borrowed_len) == ptr) {
+              borrowed_len += static_cast<size_t>(token_len);
+            } else {
+              str.append(borrowed_ptr, borrowed_len);
+              str.append(ptr, static_cast<size_t>(token_len));
+              borrowed_len = 0;
+            }
           } else {
             goto fail;
           }
           if (token.continued()) {
+            // Getting the next token can compact io_buf, moving its bytes,
+            // but only when tok_buf is empty.
+            if ((borrowed_len > 0) && (tok_buf.meta.ri >= tok_buf.meta.wi)) {
+              str.append(borrowed_ptr, borrowed_len);
+              borrowed_len = 0;
+            }
             continue;
           }
-          ret_error_message = callbacks.AppendTextString(std::move(str));
+          if (borrowed_len == 0) {
+            borrowed_ptr = str.data();
+            borrowed_len = str.size();
+          }
+          ret_error_message =
+              callbacks.AppendBorrowedTextString(borrowed_ptr, borrowed_len);
+          borrowed_len = 0;
           str.clear();
           goto parsed_a_value;
         }
@@ -494,6 +579,10 @@ DecodeJson(DecodeJsonCallbacks& callbacks,
               static_cast<uint32_t>(vbd));
           const char* ptr =  // Convert from (uint8_t*).
               static_cast<const char*>(static_cast<void*>(&u[0]));
+          if (borrowed_len > 0) {
+            str.append(borrowed_ptr, borrowed_len);
+            borrowed_len = 0;
+          }
           str.append(ptr, n);
           if (token.continued()) {
             continue;
@@ -592,8 +681,929 @@ done:
   return result;
 }
 
+}  // namespace
+
+// --------
+
+DecodeJsonResult  //
+DecodeJson(DecodeJsonCallbacks& callbacks,
+           sync_io::Input& input,
+           DecodeJsonArgQuirks quirks,
+           DecodeJsonArgJsonPointer json_pointer) {
+  return DecodeJson_Impl(callbacks, input, quirks, json_pointer, nullptr);
+}
+
+// --------
+
+JsonColumn::JsonColumn(std::string json_pointer0, uint32_t type0)
+    : m_json_pointer(std::move(json_pointer0)),
+      m_type(type0),
+      m_valid(),
+      m_i64s(),
+      m_f64s(),
+      m_bools(),
+      m_string_offsets((type0 == TextString) ? 1 : 0, 0),
+      m_arena() {}
+
+namespace {
+
+void  //
+JsonColumn_AppendNull(JsonColumn& column) {
+  column.m_valid.push_back(0);
+  switch (column.m_type) {
+    case JsonColumn::I64:
+      column.m_i64s.push_back(0);
+      break;
+    case JsonColumn::F64:
+      column.m_f64s.push_back(0.0);
+      break;
+    case JsonColumn::Bool:
+      column.m_bools.push_back(0);
+      break;
+    case JsonColumn::TextString:
+      column.m_string_offsets.push_back(column.m_arena.size());
+      break;
+  }
+}
+
+// JsonColumn_Truncate drops every row from the num_rows'th onwards.
+void  //
+JsonColumn_Truncate(JsonColumn& column, size_t num_rows) {
+  if (column.m_valid.size() <= num_rows) {
+    return;
+  }
+  column.m_valid.resize(num_rows);
+  switch (column.m_type) {
+    case JsonColumn::I64:
+      column.m_i64s.resize(num_rows);
+      break;
+    case JsonColumn::F64:
+      column.m_f64s.resize(num_rows);
+      break;
+    case JsonColumn::Bool:
+      column.m_bools.resize(num_rows);
+      break;
+    case JsonColumn::TextString:
+      column.m_string_offsets.resize(num_rows + 1);
+      column.m_arena.resize(
+          static_cast<size_t>(column.m_string_offsets[num_rows]));
+      break;
+  }
+}
+
+}  // namespace
+
+JsonColumns::JsonColumns() : m_columns(), m_num_rows(0) {}
+
+size_t  //
+JsonColumns::add_column(std::string json_pointer, uint32_t type) {
+  m_columns.emplace_back(std::move(json_pointer), type);
+  JsonColumn& column = m_columns.back();
+  for (size_t i = 0; i < m_num_rows; i++) {
+    JsonColumn_AppendNull(column);
+  }
+  return m_columns.size() - 1;
+}
+
+void  //
+JsonColumns::reset() {
+  for (auto& column : m_columns) {
+    JsonColumn_Truncate(column, 0);
+  }
+  m_num_rows = 0;
+}
+
+namespace {
+
+// DecodeJsonColumns_Node is a node in the trie of the columns' JSON Pointers.
+// Node 0 is the root, for the empty JSON Pointer. Each other node is one
+// (unescaped) '/'-separated fragment below its parent.
+struct DecodeJsonColumns_Node {
+  std::string fragment;
+  // list_index is the fragment parsed as a decimal number (for matching list
+  // elements) or UINT64_MAX if it isn't one.
+  uint64_t list_index;
+  // columns holds the m_columns indexes of the columns whose JSON Pointer
+  // ends at this node. There can be more than one.
+  std::vector<size_t> columns;
+  std::vector<size_t> children;
+};
+
+// DecodeJsonColumns_Frame is an open list or dict that is (or whose
+// descendents are) matched by some column's JSON Pointer. Other lists and
+// dicts are skipped without pushing a frame.
+struct DecodeJsonColumns_Frame {
+  size_t node;
+  bool is_dict;
+  bool expecting_key;
+  uint64_t list_index;
+  size_t value_node;
+};
+
+// DecodeJsonColumns_Scratch is state (and memory) that is re-used when
+// decoding multiple rows.
+struct DecodeJsonColumns_Scratch {
+  std::vector<DecodeJsonColumns_Node> nodes;
+  std::vector<DecodeJsonColumns_Frame> stack;
+  std::string str;
+};
+
+std::string  //
+DecodeJsonColumns_BuildTrie(DecodeJsonColumns_Scratch& scratch,
+                            JsonColumns& columns,
+                            DecodeJsonArgQuirks& quirks) {
+  bool allow_tilde_n_tilde_r_tilde_t = false;
+  for (size_t i = 0; i < quirks.repr.len; i++) {
+    if (quirks.repr.ptr[i] ==
+        WUFFS_JSON__QUIRK_JSON_POINTER_ALLOW_TILDE_N_TILDE_R_TILDE_T) {
+      allow_tilde_n_tilde_r_tilde_t = true;
+    }
+  }
+
+  std::vector<DecodeJsonColumns_Node>& nodes = scratch.nodes;
+  nodes.clear();
+  nodes.push_back(DecodeJsonColumns_Node{std::string(), UINT64_MAX,
+                                         std::vector<size_t>(),
+                                         std::vector<size_t>()});
+  for (size_t c = 0; c < columns.m_columns.size(); c++) {
+    std::string& json_pointer = columns.m_columns[c].m_json_pointer;
+    size_t n = 0;
+    for (size_t i = 0; i < json_pointer.size();) {
+      if (json_pointer[i] != '/') {
+        return DecodeJson_BadJsonPointer;
+      }
+      std::pair<std::string, size_t> split = DecodeJson_SplitJsonPointer(
+          json_pointer, i + 1, allow_tilde_n_tilde_r_tilde_t);
+      i = split.second;
+      if (i == 0) {
+        return DecodeJson_BadJsonPointer;
+      }
+
+      size_t child = SIZE_MAX;
+      for (size_t k : nodes[n].children) {
+        if (nodes[k].fragment == split.first) {
+          child = k;
+          break;
+        }
+      }
+      if (child == SIZE_MAX) {
+        wuffs_base__result_u64 result_u64 = wuffs_base__parse_number_u64(
+            wuffs_base__make_slice_u8(
+                static_cast<uint8_t*>(static_cast<void*>(
+                    const_cast<char*>(split.first.data()))),
+                split.first.size()),
+            WUFFS_BASE__PARSE_NUMBER_XXX__DEFAULT_OPTIONS);
+        child = nodes.size();
+        nodes[n].children.push_back(child);
+        nodes.push_back(DecodeJsonColumns_Node{
+            std::move(split.first),
+            result_u64.status.is_ok() ? result_u64.value : UINT64_MAX,
+            std::vector<size_t>(), std::vector<size_t>()});
+      }
+      n = child;
+    }
+    nodes[n].columns.push_back(c);
+  }
+  return "";
+}
+
+// DecodeJsonColumns_NextValueNode returns the trie node for the next value
+// (not dict key) in the innermost open frame, or SIZE_MAX if no column's
+// JSON Pointer reaches it.
+size_t  //
+DecodeJsonColumns_NextValueNode(DecodeJsonColumns_Scratch& scratch) {
+  if (scratch.stack.empty()) {
+    return 0;
+  }
+  DecodeJsonColumns_Frame& f = scratch.stack.back();
+  if (f.is_dict) {
+    f.expecting_key = true;
+    return f.value_node;
+  }
+  uint64_t list_index = f.list_index++;
+  for (size_t k : scratch.nodes[f.node].children) {
+    if (scratch.nodes[k].list_index == list_index) {
+      return k;
+    }
+  }
+  return SIZE_MAX;
+}
+
+// DecodeJsonColumns_AppendNulls appends a null to each of node's columns that
+// has no value yet for this row. It is called once a value at node has been
+// seen (and any column that takes that value has taken it), so that the first
+// match wins even if it is of another type.
+void  //
+DecodeJsonColumns_AppendNulls(JsonColumns& columns,
+                              const DecodeJsonColumns_Node& node,
+                              size_t row) {
+  for (size_t c : node.columns) {
+    JsonColumn& column = columns.m_columns[c];
+    if (column.m_valid.size() == row) {
+      JsonColumn_AppendNull(column);
+    }
+  }
+}
+
+// DecodeJsonColumns_Impl is DecodeJsonColumns, except that it re-uses
+// reusable_dec (if non-nullptr) and the scratch (whose trie must already be
+// built).
+DecodeJsonResult  //
+DecodeJsonColumns_Impl(JsonColumns& columns,
+                       sync_io::Input& input,
+                       DecodeJsonArgQuirks& quirks,
+                       wuffs_json__decoder* reusable_dec,
+                       DecodeJsonColumns_Scratch& scratch) {
+  // Prepare the wuffs_base__io_buffer and the resultant error_message.
+  wuffs_base__io_buffer* io_buf = input.BringsItsOwnIOBuffer();
+  wuffs_base__io_buffer fallback_io_buf = wuffs_base__empty_io_buffer();
+  MemOwner fallback_io_array(nullptr, &Free);
+  if (!io_buf) {
+    fallback_io_array = MemOwner(Malloc(4096), &Free);
+    if (!fallback_io_array) {
+      return DecodeJsonResult("wuffs_aux::DecodeJsonColumns: out of memory",
+                              0);
+    }
+    fallback_io_buf = wuffs_base__ptr_u8__writer(
+        static_cast<uint8_t*>(fallback_io_array.get()), 4096);
+    io_buf = &fallback_io_buf;
+  }
+  size_t cursor_index = 0;
+  std::string ret_error_message;
+  std::string io_error_message;
+
+  const std::vector<DecodeJsonColumns_Node>& nodes = scratch.nodes;
+  std::vector<DecodeJsonColumns_Frame>& stack = scratch.stack;
+  std::string& str = scratch.str;
+  stack.clear();
+  const size_t row = columns.m_num_rows;
+  bool row_done = false;
+
+  do {
+    // Prepare the low-level JSON decoder.
+    wuffs_json__decoder::unique_ptr owned_dec(nullptr, &free);
+    wuffs_json__decoder* dec = reusable_dec;
+    if (dec) {
+      wuffs_base__status status = dec->initialize(
+          sizeof__wuffs_json__decoder(), WUFFS_VERSION,
+          WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED);
+      if (!status.is_ok()) {
+        ret_error_message = status.message();
+        goto done;
+      }
+    } else {
+      owned_dec = wuffs_json__decoder::alloc();
+      dec = owned_dec.get();
+    }
+    if (!dec) {
+      ret_error_message = "wuffs_aux::DecodeJsonColumns: out of memory";
+      goto done;
+    }
+    for (size_t i = 0; i < quirks.repr.len; i++) {
+      dec->set_quirk_enabled(quirks.repr.ptr[i], true);
+    }
+
+    // Prepare the wuffs_base__tok_buffer. 256 tokens is 2KiB.
+    wuffs_base__token tok_array[256];
+    wuffs_base__token_buffer tok_buf =
+        wuffs_base__slice_token__writer(wuffs_base__make_slice_token(
+            &tok_array[0], (sizeof(tok_array) / sizeof(tok_array[0]))));
+    wuffs_base__status tok_status =
+        dec->decode_tokens(&tok_buf, io_buf, wuffs_base__empty_slice_u8());
+
+    // skip_depth is positive while skipping over a list or dict that no
+    // column's JSON Pointer reaches into. in_string is whether the previous
+    // token was a continued string (a dict key if in_key), whose bytes are
+    // accumulated in str if want_string. node is the trie node for the
+    // current value, or SIZE_MAX.
+    uint32_t skip_depth = 0;
+    bool in_string = false;
+    bool in_key = false;
+    bool want_string = false;
+    size_t node = SIZE_MAX;
+
+    while (true) {
+      WUFFS_AUX__DECODE_JSON__GET_THE_NEXT_TOKEN;
+
+      int64_t vbc = token.value_base_category();
+      uint64_t vbd = token.value_base_detail();
+      if (vbc == WUFFS_BASE__TOKEN__VBC__FILLER) {
+        continue;
+      } else if (skip_depth > 0) {
+        if (token.continued() || (vbc != WUFFS_BASE__TOKEN__VBC__STRUCTURE)) {
+          continue;
+        } else if (vbd & WUFFS_BASE__TOKEN__VBD__STRUCTURE__PUSH) {
+          skip_depth++;
+          continue;
+        } else if (--skip_depth > 0) {
+          continue;
+        }
+        goto parsed_a_value;
+      } else if (row_done) {
+        goto fail;
+      }
+
+      switch (vbc) {
+        case WUFFS_BASE__TOKEN__VBC__STRUCTURE: {
+          if (vbd & WUFFS_BASE__TOKEN__VBD__STRUCTURE__PUSH) {
+            node = DecodeJsonColumns_NextValueNode(scratch);
+            if (node != SIZE_MAX) {
+              DecodeJsonColumns_AppendNulls(columns, nodes[node], row);
+            }
+            if ((node == SIZE_MAX) || nodes[node].children.empty()) {
+              skip_depth = 1;
+            } else {
+              bool is_dict =
+                  (vbd & WUFFS_BASE__TOKEN__VBD__STRUCTURE__TO_DICT) != 0;
+              stack.push_back(
+                  DecodeJsonColumns_Frame{node, is_dict, is_dict, 0, SIZE_MAX});
+            }
+            continue;
+          } else if (stack.empty()) {
+            goto fail;
+          }
+          stack.pop_back();
+          goto parsed_a_value;
+        }
+
+        case WUFFS_BASE__TOKEN__VBC__STRING:
+        case WUFFS_BASE__TOKEN__VBC__UNICODE_CODE_POINT: {
+          if (!in_string) {
+            in_string = true;
+            in_key = !stack.empty() && stack.back().expecting_key;
+            str.clear();
+            if (in_key) {
+              want_string = true;
+            } else {
+              node = DecodeJsonColumns_NextValueNode(scratch);
+              want_string = false;
+              if (node != SIZE_MAX) {
+                for (size_t c : nodes[node].columns) {
+                  JsonColumn& column = columns.m_columns[c];
+                  want_string = want_string ||
+                                ((column.m_type == JsonColumn::TextString) &&
+                                 (column.m_valid.size() == row));
+                }
+              }
+            }
+          }
+
+          if (vbc == WUFFS_BASE__TOKEN__VBC__UNICODE_CODE_POINT) {
+            if (want_string) {
+              uint8_t u[WUFFS_BASE__UTF_8__BYTE_LENGTH__MAX_INCL];
+              size_t n = wuffs_base__utf_8__encode(
+                  wuffs_base__make_slice_u8(
+                      &u[0], WUFFS_BASE__UTF_8__BYTE_LENGTH__MAX_INCL),
+                  static_cast<uint32_t>(vbd));
+              str.append(static_cast<const char*>(static_cast<void*>(&u[0])),
+                         n);
+            }
+          } else if (vbd &
+                     WUFFS_BASE__TOKEN__VBD__STRING__CONVERT_0_DST_1_SRC_DROP) {
+            // No-op.
+          } else if (vbd &
+                     WUFFS_BASE__TOKEN__VBD__STRING__CONVERT_1_DST_1_SRC_COPY) {
+            if (want_string) {
+              str.append(
+                  static_cast<const char*>(static_cast<void*>(token_ptr)),
+                  static_cast<size_t>(token_len));
+            }
+          } else {
+            goto fail;
+          }
+          if (token.continued()) {
+            continue;
+          }
+          in_string = false;
+
+          if (in_key) {
+            DecodeJsonColumns_Frame& f = stack.back();
+            f.expecting_key = false;
+            f.value_node = SIZE_MAX;
+            for (size_t k : nodes[f.node].children) {
+              if (nodes[k].fragment == str) {
+                f.value_node = k;
+                break;
+              }
+            }
+            continue;
+          } else if (want_string) {
+            for (size_t c : nodes[node].columns) {
+              JsonColumn& column = columns.m_columns[c];
+              if ((column.m_type == JsonColumn::TextString) &&
+                  (column.m_valid.size() == row)) {
+                column.m_valid.push_back(1);
+                column.m_arena.append(str);
+                column.m_string_offsets.push_back(column.m_arena.size());
+              }
+            }
+          }
+          goto parsed_a_value;
+        }
+
+        case WUFFS_BASE__TOKEN__VBC__LITERAL: {
+          node = DecodeJsonColumns_NextValueNode(scratch);
+          if ((node == SIZE_MAX) ||
+              !(vbd & (WUFFS_BASE__TOKEN__VBD__LITERAL__FALSE |
+                       WUFFS_BASE__TOKEN__VBD__LITERAL__TRUE))) {
+            goto parsed_a_value;
+          }
+          for (size_t c : nodes[node].columns) {
+            JsonColumn& column = columns.m_columns[c];
+            if ((column.m_type == JsonColumn::Bool) &&
+                (column.m_valid.size() == row)) {
+              column.m_valid.push_back(1);
+              column.m_bools.push_back(
+                  (vbd & WUFFS_BASE__TOKEN__VBD__LITERAL__TRUE) ? 1 : 0);
+            }
+          }
+          goto parsed_a_value;
+        }
+
+        case WUFFS_BASE__TOKEN__VBC__NUMBER: {
+          node = DecodeJsonColumns_NextValueNode(scratch);
+          if (node == SIZE_MAX) {
+            goto parsed_a_value;
+          }
+          for (size_t c : nodes[node].columns) {
+            JsonColumn& column = columns.m_columns[c];
+            if (column.m_valid.size() != row) {
+              continue;
+            } else if (column.m_type == JsonColumn::I64) {
+              if ((vbd & WUFFS_BASE__TOKEN__VBD__NUMBER__FORMAT_TEXT) &&
+                  (vbd &
+                   WUFFS_BASE__TOKEN__VBD__NUMBER__CONTENT_INTEGER_SIGNED)) {
+                wuffs_base__result_i64 r = wuffs_base__parse_number_i64(
+                    wuffs_base__make_slice_u8(token_ptr,
+                                              static_cast<size_t>(token_len)),
+                    WUFFS_BASE__PARSE_NUMBER_XXX__DEFAULT_OPTIONS);
+                if (r.status.is_ok()) {
+                  column.m_valid.push_back(1);
+                  column.m_i64s.push_back(r.value);
+                }
+              }
+            } else if (column.m_type == JsonColumn::F64) {
+              uint64_t bits = 0;
+              if (vbd & WUFFS_BASE__TOKEN__VBD__NUMBER__FORMAT_TEXT) {
+                wuffs_base__result_f64 r = wuffs_base__parse_number_f64(
+                    wuffs_base__make_slice_u8(token_ptr,
+                                              static_cast<size_t>(token_len)),
+                    WUFFS_BASE__PARSE_NUMBER_XXX__DEFAULT_OPTIONS);
+                if (!r.status.is_ok()) {
+                  continue;
+                }
+                bits = wuffs_base__ieee_754_bit_representation__from_f64_to_u64(
+                    r.value);
+              } else if (vbd &
+                         WUFFS_BASE__TOKEN__VBD__NUMBER__CONTENT_NEG_INF) {
+                bits = 0xFFF0000000000000ul;
+              } else if (vbd &
+                         WUFFS_BASE__TOKEN__VBD__NUMBER__CONTENT_POS_INF) {
+                bits = 0x7FF0000000000000ul;
+              } else if (vbd &
+                         WUFFS_BASE__TOKEN__VBD__NUMBER__CONTENT_NEG_NAN) {
+                bits = 0xFFFFFFFFFFFFFFFFul;
+              } else if (vbd &
+                         WUFFS_BASE__TOKEN__VBD__NUMBER__CONTENT_POS_NAN) {
+                bits = 0x7FFFFFFFFFFFFFFFul;
+              } else {
+                continue;
+              }
+              column.m_valid.push_back(1);
+              column.m_f64s.push_back(
+                  wuffs_base__ieee_754_bit_representation__from_u64_to_f64(
+                      bits));
+            }
+          }
+          goto parsed_a_value;
+        }
+      }
+
+    fail:
+      ret_error_message =
+          "wuffs_aux::DecodeJsonColumns: internal error: unexpected token";
+      goto done;
+
+    parsed_a_value:
+      if (node != SIZE_MAX) {
+        DecodeJsonColumns_AppendNulls(columns, nodes[node], row);
+      }
+      // As for DecodeJson (with an empty json_pointer), keep the loop running
+      // after the root value, in case quirks allow trailing filler.
+      row_done = stack.empty() && (skip_depth == 0);
+    }
+  } while (false);
+
+done:
+  if (ret_error_message.empty() && !row_done) {
+    ret_error_message =
+        "wuffs_aux::DecodeJsonColumns: internal error: incomplete value";
+  }
+  if (ret_error_message.empty()) {
+    for (auto& column : columns.m_columns) {
+      if (column.m_valid.size() == row) {
+        JsonColumn_AppendNull(column);
+      }
+    }
+    columns.m_num_rows = row + 1;
+  } else {
+    for (auto& column : columns.m_columns) {
+      JsonColumn_Truncate(column, row);
+    }
+  }
+  return DecodeJsonResult(
+      std::move(ret_error_message),
+      wuffs_base__u64__sat_add(io_buf->meta.pos, cursor_index));
+}
+
+}  // namespace
+
+DecodeJsonResult  //
+DecodeJsonColumns(JsonColumns& columns,
+                  sync_io::Input& input,
+                  DecodeJsonArgQuirks quirks) {
+  DecodeJsonColumns_Scratch scratch;
+  std::string error_message =
+      DecodeJsonColumns_BuildTrie(scratch, columns, quirks);
+  if (!error_message.empty()) {
+    return DecodeJsonResult(std::move(error_message), 0);
+  }
+  return DecodeJsonColumns_Impl(columns, input, quirks, nullptr, scratch);
+}
+
 #undef WUFFS_AUX__DECODE_JSON__GET_THE_NEXT_TOKEN
 
+// --------
+
+namespace {
+
+// DecodeJsonLines_Record is one '\n'-terminated record's position (in the
+// overall input) and length (excluding the '\n').
+struct DecodeJsonLines_Record {
+  size_t position;
+  size_t length;
+};
+
+// DecodeJsonLines_Slot holds a decoded record until it is passed to
+// DecodeJsonLinesCallbacks::RecordDone.
+struct DecodeJsonLines_Slot {
+  DecodeJsonLines_Slot();
+
+  bool finished;
+  uint64_t record_index;
+  std::unique_ptr<DecodeJsonCallbacks> record_callbacks;
+  std::string error_message;
+  uint64_t cursor_position;
+};
+
+DecodeJsonLines_Slot::DecodeJsonLines_Slot()
+    : finished(false),
+      record_index(0),
+      record_callbacks(nullptr),
+      error_message(),
+      cursor_position(0) {}
+
+// DecodeJsonLines_State is shared by the DecodeJsonLines worker threads. The
+// fields after m_mutex are guarded by it.
+//
+// Every worker thread can deliver finished records (call RecordDone) but only
+// one thread does so at a time (the one that set m_delivering), without
+// holding m_mutex, so that the other workers can carry on decoding.
+struct DecodeJsonLines_State {
+  DecodeJsonLines_State(DecodeJsonLinesCallbacks& callbacks,
+                        const uint8_t* ptr,
+                        DecodeJsonArgQuirks& quirks,
+                        bool in_input_order,
+                        size_t batch_size,
+                        size_t window);
+
+  void run_worker();
+  void decode_record(wuffs_json__decoder* dec,
+                     size_t record_index,
+                     DecodeJsonLines_Slot& slot);
+  void deliver(std::unique_lock<std::mutex>& lock);
+
+  DecodeJsonLinesCallbacks& m_callbacks;
+  const uint8_t* m_ptr;
+  DecodeJsonArgQuirks& m_quirks;
+  const bool m_in_input_order;
+  const size_t m_batch_size;
+  const size_t m_window;
+  std::vector<DecodeJsonLines_Record> m_records;
+
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::string m_error_message;
+  size_t m_num_claimed;
+  size_t m_num_delivered;
+  size_t m_num_waiting;
+  bool m_delivering;
+
+  // m_ring (for in_input_order) is indexed by record_index % m_window. m_ready
+  // (for completion order) is a FIFO queue.
+  std::vector<DecodeJsonLines_Slot> m_ring;
+  std::deque<DecodeJsonLines_Slot> m_ready;
+};
+
+DecodeJsonLines_State::DecodeJsonLines_State(
+    DecodeJsonLinesCallbacks& callbacks,
+    const uint8_t* ptr,
+    DecodeJsonArgQuirks& quirks,
+    bool in_input_order,
+    size_t batch_size,
+    size_t window)
+    : m_callbacks(callbacks),
+      m_ptr(ptr),
+      m_quirks(quirks),
+      m_in_input_order(in_input_order),
+      m_batch_size(batch_size),
+      m_window(window),
+      m_records(),
+      m_error_message(),
+      m_num_claimed(0),
+      m_num_delivered(0),
+      m_num_waiting(0),
+      m_delivering(false),
+      m_ring(),
+      m_ready() {
+  if (in_input_order) {
+    m_ring.resize(window);
+  }
+}
+
+void  //
+DecodeJsonLines_State::run_worker() {
+  // Each worker thread has its own wuffs_json__decoder, re-used (and re-
+  // initialized) for every record that the thread decodes.
+  wuffs_json__decoder::unique_ptr dec = wuffs_json__decoder::alloc();
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  if (!dec && m_error_message.empty()) {
+    m_error_message = "wuffs_aux::DecodeJsonLines: out of memory";
+  }
+  std::vector<DecodeJsonLines_Slot> batch;
+  while (true) {
+    // Bound how far the claimed records can run ahead of the delivered ones,
+    // so that memory use does not grow with the input size.
+    while (m_error_message.empty() && (m_num_claimed < m_records.size()) &&
+           ((m_num_claimed - m_num_delivered) >= m_window)) {
+      m_num_waiting++;
+      m_cv.wait(lock);
+      m_num_waiting--;
+    }
+    if (!m_error_message.empty() || (m_num_claimed >= m_records.size())) {
+      return;
+    }
+
+    // Claim a batch of consecutive records, to amortize the locking.
+    size_t i = m_num_claimed;
+    size_t n = m_records.size() - i;
+    n = (n < m_batch_size) ? n : m_batch_size;
+    size_t room = m_window - (m_num_claimed - m_num_delivered);
+    n = (n < room) ? n : room;
+    m_num_claimed += n;
+
+    lock.unlock();
+    batch.resize(n);
+    for (size_t j = 0; j < n; j++) {
+      decode_record(dec.get(), i + j, batch[j]);
+    }
+    lock.lock();
+
+    if (!m_error_message.empty()) {
+      return;
+    }
+    for (auto& slot : batch) {
+      if (m_in_input_order) {
+        m_ring[slot.record_index % m_window] = std::move(slot);
+      } else {
+        m_ready.push_back(std::move(slot));
+      }
+    }
+    if (!m_delivering) {
+      deliver(lock);
+    }
+  }
+}
+
+void  //
+DecodeJsonLines_State::decode_record(wuffs_json__decoder* dec,
+                                     size_t record_index,
+                                     DecodeJsonLines_Slot& slot) {
+  slot.finished = true;
+  slot.record_index = record_index;
+  slot.record_callbacks = m_callbacks.MakeRecordCallbacks(record_index);
+  if (!slot.record_callbacks) {
+    slot.error_message = DecodeJsonLines_NullCallbacks;
+    return;
+  }
+
+  const uint8_t* ptr = m_ptr + m_records[record_index].position;
+  size_t len = m_records[record_index].length;
+  sync_io::MemoryInput input(ptr, len);
+  DecodeJsonArgJsonPointer json_pointer =
+      DecodeJsonArgJsonPointer::DefaultValue();
+  DecodeJsonResult result = DecodeJson_Impl(*slot.record_callbacks, input,
+                                            m_quirks, json_pointer, dec);
+
+  // A record holds exactly one JSON value, so anything other than whitespace
+  // after it is an error, even if DecodeJson itself would stop early.
+  if (result.error_message.empty()) {
+    for (uint64_t i = result.cursor_position; i < len; i++) {
+      uint8_t c = ptr[i];
+      if ((c != ' ') && (c != '\t') && (c != '\r')) {
+        result.error_message = DecodeJsonLines_TrailingData;
+        result.cursor_position = i;
+        break;
+      }
+    }
+  }
+  slot.error_message = std::move(result.error_message);
+  slot.cursor_position = result.cursor_position;
+}
+
+void  //
+DecodeJsonLines_State::deliver(std::unique_lock<std::mutex>& lock) {
+  m_delivering = true;
+  while (m_error_message.empty()) {
+    DecodeJsonLines_Slot slot;
+    if (m_in_input_order) {
+      DecodeJsonLines_Slot& next = m_ring[m_num_delivered % m_window];
+      if (!next.finished) {
+        break;
+      }
+      slot = std::move(next);
+      next.finished = false;
+    } else if (!m_ready.empty()) {
+      slot = std::move(m_ready.front());
+      m_ready.pop_front();
+    } else {
+      break;
+    }
+
+    lock.unlock();
+    DecodeJsonResult result(std::move(slot.error_message),
+                            slot.cursor_position);
+    std::string error_message = m_callbacks.RecordDone(
+        slot.record_index, m_records[slot.record_index].position, result,
+        std::move(slot.record_callbacks));
+    lock.lock();
+
+    m_num_delivered++;
+    if (!error_message.empty() && m_error_message.empty()) {
+      m_error_message = std::move(error_message);
+    }
+    if (m_num_waiting > 0) {
+      m_cv.notify_all();
+    }
+  }
+  m_delivering = false;
+}
+
+// DecodeJsonLines_FindRecordEnd returns the index (at or after i) of the
+// first '\n' that is not inside a JSON string, or len if there is none.
+size_t  //
+DecodeJsonLines_FindRecordEnd(const uint8_t* ptr, size_t i, size_t len) {
+  while (i < len) {
+    uint8_t c = ptr[i++];
+    if (c == '\n') {
+      return i - 1;
+    } else if (c != '"') {
+      continue;
+    }
+    // Skip to the closing '"', stepping over backslash-escaped bytes.
+    while (i < len) {
+      c = ptr[i++];
+      if (c == '"') {
+        break;
+      } else if (c == '\\') {
+        i += (i < len) ? 1 : 0;
+      }
+    }
+  }
+  return len;
+}
+
+bool  //
+DecodeJsonLines_IsBlank(const uint8_t* ptr, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    uint8_t c = ptr[i];
+    if ((c != ' ') && (c != '\t') && (c != '\r')) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+// --------
+
+std::string  //
+DecodeJsonLines(DecodeJsonLinesCallbacks& callbacks,
+                const uint8_t* ptr,
+                size_t len,
+                DecodeJsonArgQuirks quirks,
+                bool in_input_order,
+                uint32_t num_threads) {
+  static constexpr size_t min_bytes_per_thread = 65536;
+  static constexpr size_t batch_size = 16;
+
+  if (!ptr && (len > 0)) {
+    return "wuffs_aux::DecodeJsonLines: invalid argument";
+  } else if (num_threads == 0) {
+    num_threads = std::thread::hardware_concurrency();
+    if (num_threads == 0) {
+      num_threads = 1;
+    }
+  }
+  size_t n = len / min_bytes_per_thread;
+  if (n > num_threads) {
+    n = num_threads;
+  } else if (n < 1) {
+    n = 1;
+  }
+
+  DecodeJsonLines_State state(callbacks, ptr, quirks, in_input_order,
+                              batch_size, 64 * n * batch_size);
+  for (size_t i = 0; i < len;) {
+    size_t j = DecodeJsonLines_FindRecordEnd(ptr, i, len);
+    if (!DecodeJsonLines_IsBlank(ptr + i, j - i)) {
+      state.m_records.push_back(DecodeJsonLines_Record{i, j - i});
+    }
+    i = j + 1;
+  }
+  if (n > state.m_records.size()) {
+    n = state.m_records.size();
+  }
+
+  // The calling thread is one of the n workers.
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < n; i++) {
+    threads.emplace_back(&DecodeJsonLines_State::run_worker, &state);
+  }
+  state.run_worker();
+  for (auto& t : threads) {
+    t.join();
+  }
+  return std::move(state.m_error_message);
+}
+
+DecodeJsonResult  //
+DecodeJsonLinesColumns(JsonColumns& columns,
+                       const uint8_t* ptr,
+                       size_t len,
+                       DecodeJsonArgQuirks quirks) {
+  if (!ptr && (len > 0)) {
+    return DecodeJsonResult(
+        "wuffs_aux::DecodeJsonLinesColumns: invalid argument", 0);
+  }
+  DecodeJsonColumns_Scratch scratch;
+  std::string error_message =
+      DecodeJsonColumns_BuildTrie(scratch, columns, quirks);
+  if (!error_message.empty()) {
+    return DecodeJsonResult(std::move(error_message), 0);
+  }
+  wuffs_json__decoder::unique_ptr dec = wuffs_json__decoder::alloc();
+  if (!dec) {
+    return DecodeJsonResult("wuffs_aux::DecodeJsonLinesColumns: out of memory",
+                            0);
+  }
+
+  for (size_t i = 0; i < len;) {
+    size_t j = DecodeJsonLines_FindRecordEnd(ptr, i, len);
+    if (DecodeJsonLines_IsBlank(ptr + i, j - i)) {
+      i = j + 1;
+      continue;
+    }
+    sync_io::MemoryInput input(ptr + i, j - i);
+    DecodeJsonResult result =
+        DecodeJsonColumns_Impl(columns, input, quirks, dec.get(), scratch);
+    // A record holds exactly one JSON value, so anything other than whitespace
+    // after it is an error. Undo that record's row.
+    if (result.error_message.empty()) {
+      for (size_t k = i + static_cast<size_t>(result.cursor_position); k < j;
+           k++) {
+        if (!DecodeJsonLines_IsBlank(ptr + k, 1)) {
+          columns.m_num_rows--;
+          for (auto& column : columns.m_columns) {
+            JsonColumn_Truncate(column, columns.m_num_rows);
+          }
+          result.error_message = DecodeJsonLines_TrailingData;
+          result.cursor_position = k - i;
+          break;
+        }
+      }
+    }
+    if (!result.error_message.empty()) {
+      result.cursor_position += i;
+      return result;
+    }
+    i = j + 1;
+  }
+  return DecodeJsonResult(std::string(), len);
+}
+
 }  // namespace wuffs_aux
 
 #endif  // !defined(WUFFS_CONFIG__MODULES) ||
@@ -14,6 +14,8 @@
 
 // ---------------- Auxiliary - JSON
 
+#include <vector>
+
 namespace wuffs_aux {
 
 struct DecodeJsonResult {
@@ -37,6 +39,19 @@ class DecodeJsonCallbacks {
   virtual std::string AppendI64(int64_t val) = 0;
   virtual std::string AppendTextString(std::string&& val) = 0;
 
+  // AppendBorrowedTextString is like AppendTextString but the string is passed
+  // as a pointer and length, borrowed for the duration of the call. Do not
+  // keep a reference to ptr after it returns. When the string has no escapes
+  // and sits contiguously in the IOBuffer, ptr points into that buffer and no
+  // copy is made. Otherwise, ptr points to a scratch buffer that is re-used
+  // across strings.
+  //
+  // DecodeJson only calls this method, not AppendTextString directly.
+  // Callbacks implementations that want to avoid allocating a std::string per
+  // string token should override it. The default implementation copies to a
+  // std::string and calls AppendTextString.
+  virtual std::string AppendBorrowedTextString(const char* ptr, size_t len);
+
   // Push and Pop are called for container nodes: JSON arrays (lists) and JSON
   // objects (dictionaries).
   //
@@ -120,4 +135,161 @@ DecodeJson(DecodeJsonCallbacks& callbacks,
            DecodeJsonArgJsonPointer json_pointer =
                DecodeJsonArgJsonPointer::DefaultValue());
 
+// DecodeJsonLinesCallbacks are the callbacks for DecodeJsonLines. Unlike
+// DecodeJsonCallbacks, there is one of these per DecodeJsonLines call, which
+// makes one DecodeJsonCallbacks per record.
+class DecodeJsonLinesCallbacks {
+ public:
+  virtual ~DecodeJsonLinesCallbacks();
+
+  // MakeRecordCallbacks returns the DecodeJsonCallbacks for the
+  // record_index'th record (counting from zero, skipping blank lines). It may
+  // be called concurrently, from multiple worker threads. Returning nullptr
+  // fails that record with DecodeJsonLines_NullCallbacks.
+  virtual std::unique_ptr<DecodeJsonCallbacks>  //
+  MakeRecordCallbacks(uint64_t record_index) = 0;
+
+  // RecordDone is called once per record, after that record's DecodeJson call
+  // (including its DecodeJsonCallbacks::Done call) has finished, whether or
+  // not it succeeded. It is never called concurrently, but may be called from
+  // any worker thread. result.cursor_position is relative to the record's
+  // start, which is record_position bytes into the DecodeJsonLines input.
+  //
+  // Returning a non-empty string stops DecodeJsonLines, which then returns
+  // that string. Returning an empty string (e.g. for a record that failed to
+  // decode, to skip it) continues with the next record.
+  virtual std::string  //
+  RecordDone(uint64_t record_index,
+             uint64_t record_position,
+             DecodeJsonResult& result,
+             std::unique_ptr<DecodeJsonCallbacks> record_callbacks) = 0;
+};
+
+extern const char DecodeJsonLines_NullCallbacks[];
+extern const char DecodeJsonLines_TrailingData[];
+
+// DecodeJsonLines decodes in-memory JSON Lines (also known as NDJSON) data:
+// one JSON value per '\n'-separated record. Blank (whitespace only) lines are
+// skipped. A record with anything other than whitespace after its JSON value
+// fails with DecodeJsonLines_TrailingData.
+//
+// Records are split at each '\n' byte outside of a JSON string, tracking '"'
+// and backslash escapes. An unterminated string therefore makes its record
+// run on to a later line (and fail to decode). Quirks such as
+// WUFFS_JSON__QUIRK_ALLOW_COMMENT_BLOCK, which allow '\n' or unbalanced '"'
+// bytes outside of strings, are not supported by the splitter.
+//
+// Unlike DecodeJson, it is not single-threaded. Records are decoded by up to
+// num_threads (zero means std::thread::hardware_concurrency()) worker threads,
+// the calling thread being one of them, each with its own wuffs_json__decoder.
+// Small inputs use fewer threads. RecordDone is called in input order
+// (records are buffered until their predecessors are done) if in_input_order
+// is true, otherwise in completion order. Either way, only a bounded number of
+// records are in flight at any one time.
+//
+// It returns an empty string on success or an error message otherwise.
+std::string  //
+DecodeJsonLines(DecodeJsonLinesCallbacks& callbacks,
+                const uint8_t* ptr,
+                size_t len,
+                DecodeJsonArgQuirks quirks =
+                    DecodeJsonArgQuirks::DefaultValue(),
+                bool in_input_order = true,
+                uint32_t num_threads = 0);
+
+// JsonColumn is one column of a JsonColumns table: the values found at one
+// JSON Pointer, one per row.
+struct JsonColumn {
+  enum Type {
+    I64 = 0,
+    F64 = 1,
+    Bool = 2,
+    TextString = 3,
+  };
+
+  JsonColumn(std::string json_pointer0, uint32_t type0);
+
+  // m_json_pointer is a query in the JSON Pointer (RFC 6901) syntax, relative
+  // to each row's root value. Like DecodeJson, the first match wins.
+  std::string m_json_pointer;
+
+  // m_type is one of the Type values.
+  uint32_t m_type;
+
+  // m_valid has one element per row: 1 if that row has a value in this column
+  // or 0 if it is null. A row's value is null if m_json_pointer did not match
+  // or if it matched a JSON null or a value of another type. An I64 column
+  // only takes numbers that are integers (in the int64_t range) and an F64
+  // column takes any number.
+  std::vector<uint8_t> m_valid;
+
+  // Exactly one of the next four fields is used, depending on m_type. For the
+  // first three, there is one element per row (zero for a null row).
+  std::vector<int64_t> m_i64s;
+  std::vector<double> m_f64s;
+  std::vector<uint8_t> m_bools;
+
+  // For a TextString column, row i's (unescaped, UTF-8) string is the bytes of
+  // m_arena from m_string_offsets[i] up to m_string_offsets[i + 1]. Like an
+  // Apache Arrow string column, m_string_offsets starts with a 0 and so has
+  // one more element than there are rows.
+  std::vector<uint64_t> m_string_offsets;
+  std::string m_arena;
+};
+
+// JsonColumns is a table of JSON values, stored column by column: the
+// "columnar" layout used by e.g. Apache Arrow. Each DecodeJsonColumns call
+// appends one row. Compared to DecodeJson and DecodeJsonCallbacks, there is
+// no virtual method call per JSON value and no std::string per JSON value or
+// per dict key. Values are stored directly into contiguous typed arrays.
+class JsonColumns {
+ public:
+  std::vector<JsonColumn> m_columns;
+  size_t m_num_rows;
+
+  JsonColumns();
+
+  // add_column appends a column to m_columns and returns its index. If there
+  // are already rows, the new column is null for each of them.
+  size_t add_column(std::string json_pointer, uint32_t type);
+
+  // reset removes all rows, keeping the columns and without freeing memory.
+  void reset();
+
+ private:
+  // Delete the copy and assign constructors.
+  JsonColumns(const JsonColumns&) = delete;
+  JsonColumns& operator=(const JsonColumns&) = delete;
+};
+
+// DecodeJsonColumns appends one row to columns, from the JSON-formatted data
+// (one JSON value) in input. Its arguments and result are otherwise like those
+// of DecodeJson. The value is walked once, with every column's JSON Pointer
+// matched at the same time. Sub-trees that no column's JSON Pointer reaches
+// into are skipped.
+//
+// On failure, no row is appended: columns' rows are left as they were before
+// the call.
+DecodeJsonResult  //
+DecodeJsonColumns(JsonColumns& columns,
+                  sync_io::Input& input,
+                  DecodeJsonArgQuirks quirks =
+                      DecodeJsonArgQuirks::DefaultValue());
+
+// DecodeJsonLinesColumns is like DecodeJsonColumns, appending one row per
+// record, but for in-memory JSON Lines (also known as NDJSON) data. Records
+// are split as per DecodeJsonLines, but decoded on the calling thread only,
+// re-using one wuffs_json__decoder for every record.
+//
+// On success, the returned error_message is empty and cursor_position is len.
+// On failure, error_message is non-empty, cursor_position is the location of
+// the error (relative to ptr) and the rows for the records before the failed
+// one are kept.
+DecodeJsonResult  //
+DecodeJsonLinesColumns(JsonColumns& columns,
+                       const uint8_t* ptr,
+                       size_t len,
+                       DecodeJsonArgQuirks quirks =
+                           DecodeJsonArgQuirks::DefaultValue());
+
 }  // namespace wuffs_aux
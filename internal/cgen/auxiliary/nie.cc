@@ -0,0 +1,95 @@
+// Copyright 2022 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ---------------- Auxiliary - NIE
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__AUX__NIE)
+
+namespace wuffs_aux {
+
+const char ViewNie_BadHeader[] =  //
+    "wuffs_aux::ViewNie: bad header";
+const char ViewNie_TruncatedInput[] =  //
+    "wuffs_aux::ViewNie: truncated input";
+const char ViewNie_UnsupportedPixelFormat[] =  //
+    "wuffs_aux::ViewNie: unsupported pixel format";
+
+ViewNieResult::ViewNieResult(wuffs_base__pixel_buffer pixbuf0)
+    : pixbuf(pixbuf0), error_message("") {}
+
+ViewNieResult::ViewNieResult(std::string&& error_message0)
+    : pixbuf(wuffs_base__null_pixel_buffer()),
+      error_message(std::move(error_message0)) {}
+
+ViewNieResult  //
+ViewNie(const uint8_t* ptr, size_t len, wuffs_base__pixel_format pixfmt) {
+  if (!ptr || (len < 16)) {
+    return ViewNieResult(ViewNie_TruncatedInput);
+  }
+
+  // See the NIE specification (doc/spec/nie-spec.md) for the 16 byte header.
+  uint32_t magic = wuffs_base__peek_u32le__no_bounds_check(ptr + 0);
+  uint32_t config = wuffs_base__peek_u32le__no_bounds_check(ptr + 4);
+  uint32_t width = wuffs_base__peek_u32le__no_bounds_check(ptr + 8);
+  uint32_t height = wuffs_base__peek_u32le__no_bounds_check(ptr + 12);
+  if ((magic != 0x45AFC36E) || (width >= 0x80000000) ||
+      (height >= 0x80000000)) {
+    return ViewNieResult(ViewNie_BadHeader);
+  }
+  uint32_t have_pixfmt = 0;
+  switch (config) {
+    case 0x346E62FF:  // "\xFFbn4".
+      have_pixfmt = WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL;
+      break;
+    case 0x386E62FF:  // "\xFFbn8".
+      have_pixfmt = WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE;
+      break;
+    case 0x347062FF:  // "\xFFbp4".
+      have_pixfmt = WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL;
+      break;
+    case 0x387062FF:  // "\xFFbp8".
+      have_pixfmt = WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL_4X16LE;
+      break;
+    default:
+      return ViewNieResult(ViewNie_BadHeader);
+  }
+  if (have_pixfmt != pixfmt.repr) {
+    return ViewNieResult(ViewNie_UnsupportedPixelFormat);
+  }
+
+  // The payload is tightly packed: each row is width * bytes_per_pixel long.
+  uint64_t bytes_per_pixel = (config >> 24) - '0';
+  uint64_t num_pixels = ((uint64_t)width) * ((uint64_t)height);
+  if (num_pixels > ((len - 16) / bytes_per_pixel)) {
+    return ViewNieResult(ViewNie_TruncatedInput);
+  }
+
+  wuffs_base__pixel_config pixcfg;
+  pixcfg.set(have_pixfmt, WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, width, height);
+  wuffs_base__pixel_buffer pixbuf;
+  // The const_cast is safe if the caller does not write to the pixel buffer,
+  // as per the ViewNie documentation.
+  wuffs_base__status status = pixbuf.set_from_slice(
+      &pixcfg, wuffs_base__make_slice_u8(const_cast<uint8_t*>(ptr + 16),
+                                         (size_t)(num_pixels * bytes_per_pixel)));
+  if (!status.is_ok()) {
+    return ViewNieResult(status.message());
+  }
+  return ViewNieResult(pixbuf);
+}
+
+}  // namespace wuffs_aux
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) ||
+        // defined(WUFFS_CONFIG__MODULE__AUX__NIE)
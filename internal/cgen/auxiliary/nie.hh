@@ -0,0 +1,49 @@
+// Copyright 2022 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ---------------- Auxiliary - NIE
+
+namespace wuffs_aux {
+
+struct ViewNieResult {
+  ViewNieResult(wuffs_base__pixel_buffer pixbuf0);
+  ViewNieResult(std::string&& error_message0);
+
+  wuffs_base__pixel_buffer pixbuf;
+  std::string error_message;
+};
+
+// ViewNie returns a pixel buffer whose pixels are the NIE image's payload, in
+// place, without decoding or copying them. The NIE image (16 bytes of header
+// and then the payload) is at [ptr .. ptr + len), such as the bytes of a
+// sync_io::MmapInput's BringsItsOwnIOBuffer. Those bytes must outlive the
+// pixel buffer.
+//
+// This is how a cache of decoded images (e.g. written by the
+// wuffs_nie__encoder) can be read back: a cache hit costs a page fault, not a
+// decode. Mapping the file read-only is fine, but the caller must then not
+// write to the pixel buffer.
+//
+// It fails with ViewNie_UnsupportedPixelFormat if the NIE image's pixel format
+// (one of BGRA_NONPREMUL, BGRA_PREMUL or their 4X16LE variants) differs from
+// the requested one. The caller can then fall back to DecodeImage, which
+// converts the pixels.
+ViewNieResult  //
+ViewNie(const uint8_t* ptr, size_t len, wuffs_base__pixel_format pixfmt);
+
+extern const char ViewNie_BadHeader[];
+extern const char ViewNie_TruncatedInput[];
+extern const char ViewNie_UnsupportedPixelFormat[];
+
+}  // namespace wuffs_aux
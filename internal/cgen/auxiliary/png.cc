@@ -0,0 +1,466 @@
+// Copyright 2022 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ---------------- Auxiliary - PNG
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__AUX__PNG)
+
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace wuffs_aux {
+
+namespace private_impl {
+
+// PngIdatBand is a unit of work: decompressing the deflate bytes [src_min ..
+// src_max) into either fixed (if its ptr is non-null) or buf[0 .. wi). Only
+// the last band is expected to end with a final deflate block. The other
+// bands are expected to end exactly at a flush point.
+struct PngIdatBand {
+  PngIdatBand()
+      : src_min(0),
+        src_max(0),
+        is_last(false),
+        fixed(wuffs_base__empty_slice_u8()),
+        wi(0),
+        speculation_failed(false) {}
+
+  size_t src_min;
+  size_t src_max;
+  bool is_last;
+  wuffs_base__slice_u8 fixed;
+  std::vector<uint8_t> buf;
+  size_t wi;
+  bool speculation_failed;
+  std::string error_message;
+};
+
+static inline uint32_t  //
+PngPeekU32BE(const uint8_t* p) {
+  return (static_cast<uint32_t>(p[0]) << 24) |
+         (static_cast<uint32_t>(p[1]) << 16) |
+         (static_cast<uint32_t>(p[2]) << 8) | (static_cast<uint32_t>(p[3]));
+}
+
+// ConcatenatePngIdat appends the payloads of the first run of consecutive
+// IDAT chunks to dst.
+static std::string  //
+ConcatenatePngIdat(std::vector<uint8_t>& dst, const uint8_t* ptr, size_t len) {
+  static const uint8_t signature[8] = {0x89, 0x50, 0x4E, 0x47,
+                                       0x0D, 0x0A, 0x1A, 0x0A};
+  if ((len < 8) || (memcmp(ptr, signature, 8) != 0)) {
+    return "wuffs_aux::ParallelInflatePngIdat: bad PNG signature";
+  }
+  bool seen_idat = false;
+  for (size_t i = 8; true;) {
+    if ((len - i) < 12) {
+      return "wuffs_aux::ParallelInflatePngIdat: truncated PNG chunk";
+    }
+    uint32_t chunk_length = PngPeekU32BE(ptr + i);
+    uint32_t chunk_type = PngPeekU32BE(ptr + i + 4);
+    if ((chunk_length > 0x7FFFFFFF) || ((len - i - 12) < chunk_length)) {
+      return "wuffs_aux::ParallelInflatePngIdat: truncated PNG chunk";
+    }
+    if (chunk_type == 0x49444154) {  // "IDAT"
+      seen_idat = true;
+      dst.insert(dst.end(), ptr + i + 8, ptr + i + 8 + chunk_length);
+    } else if (seen_idat) {
+      break;
+    } else if (chunk_type == 0x49454E44) {  // "IEND"
+      return "wuffs_aux::ParallelInflatePngIdat: missing IDAT chunk";
+    }
+    i += 12 + static_cast<size_t>(chunk_length);
+  }
+  return "";
+}
+
+// FindPngFullFlushPoint returns the position just after the first "00 00 FF
+// FF" (the LEN and NLEN of an empty stored deflate block) in p[min .. max), or
+// max if there is no such pattern. It is only a candidate flush point.
+static size_t  //
+FindPngFullFlushPoint(const uint8_t* p, size_t min, size_t max) {
+  for (size_t i = min; (i + 4) <= max; i++) {
+    if ((p[i + 3] == 0xFF) && (p[i + 2] == 0xFF) && (p[i + 1] == 0x00) &&
+        (p[i + 0] == 0x00)) {
+      return i + 4;
+    }
+  }
+  return max;
+}
+
+static void  //
+InflatePngIdatBand(const uint8_t* src_ptr, PngIdatBand* band) {
+  wuffs_deflate__decoder::unique_ptr dec = wuffs_deflate__decoder::alloc();
+  if (!dec) {
+    band->error_message = "wuffs_aux::ParallelInflatePngIdat: out of memory";
+    return;
+  }
+  // dst holds all of the band's output, so the decoder can resolve
+  // back-references from dst and needs no workbuf for its history.
+  dec->set_dst_holds_history(true);
+  dec->set_report_block_boundaries(!band->is_last);
+
+  IOBuffer src = wuffs_base__ptr_u8__reader(
+      const_cast<uint8_t*>(src_ptr + band->src_min),
+      band->src_max - band->src_min, band->is_last);
+  IOBuffer dst = wuffs_base__empty_io_buffer();
+  if (band->fixed.ptr) {
+    dst = wuffs_base__ptr_u8__writer(band->fixed.ptr, band->fixed.len);
+  } else {
+    // Deflate's compression ratio is rarely above 8:1 for PNG data.
+    band->buf.resize(8 * (band->src_max - band->src_min) + 4096);
+    dst = wuffs_base__ptr_u8__writer(band->buf.data(), band->buf.size());
+  }
+
+  while (true) {
+    wuffs_base__status status =
+        dec->transform_io(&dst, &src, wuffs_base__empty_slice_u8());
+    band->wi = dst.meta.wi;
+    if (status.repr == wuffs_deflate__note__block_boundary) {
+      // A non-last band is verified once its compressed bytes are consumed
+      // exactly, up to a byte-aligned block boundary.
+      if ((src.meta.ri == src.meta.wi) && (dec->pending_n_bits() == 0)) {
+        return;
+      }
+      continue;
+    } else if (status.repr == wuffs_base__suspension__short_write) {
+      if (!band->fixed.ptr) {
+        // Resizing keeps the bytes written so far (the decoder's history),
+        // so it is OK for the dst buffer to move.
+        band->buf.resize(2 * band->buf.size());
+        dst.data =
+            wuffs_base__make_slice_u8(band->buf.data(), band->buf.size());
+        continue;
+      } else if (band->is_last) {
+        band->error_message =
+            "wuffs_aux::ParallelInflatePngIdat: dst is too short";
+        return;
+      }
+    } else if (status.is_ok()) {
+      if (band->is_last) {
+        return;
+      }
+    } else if (band->is_last) {
+      band->error_message = status.message();
+      return;
+    }
+    // A non-last band's guessed start or end was not a real flush point.
+    band->speculation_failed = true;
+    return;
+  }
+}
+
+// PngEncodeBand is a unit of work: encoding the rows [y_min .. y_max) as raw
+// deflate bytes, buf, with their (filtered) Adler-32 checksum and length.
+struct PngEncodeBand {
+  PngEncodeBand() : y_min(0), y_max(0), checksum(0), length(0) {}
+
+  uint32_t y_min;
+  uint32_t y_max;
+  std::vector<uint8_t> buf;
+  uint32_t checksum;
+  uint64_t length;
+  std::string error_message;
+};
+
+// EncodePngToVector runs enc->encode_image, appending its output to dst and
+// growing dst as needed.
+static std::string  //
+EncodePngToVector(wuffs_png__encoder* enc,
+                  std::vector<uint8_t>& dst,
+                  wuffs_base__pixel_buffer* src,
+                  wuffs_base__slice_u8 workbuf) {
+  size_t wi = dst.size();
+  dst.resize(wi + 65536);
+  while (true) {
+    IOBuffer buf = wuffs_base__ptr_u8__writer(dst.data(), dst.size());
+    buf.meta.wi = wi;
+    wuffs_base__status status = enc->encode_image(&buf, src, workbuf);
+    wi = buf.meta.wi;
+    if (status.repr == wuffs_base__suspension__short_write) {
+      dst.resize(2 * dst.size());
+      continue;
+    }
+    dst.resize(wi);
+    if (!status.is_ok()) {
+      return status.message();
+    }
+    return "";
+  }
+}
+
+static void  //
+EncodePngBand(wuffs_base__pixel_buffer* src,
+              uint32_t level,
+              PngEncodeBand* band) {
+  wuffs_png__encoder::unique_ptr enc = wuffs_png__encoder::alloc();
+  if (!enc) {
+    band->error_message = "wuffs_aux::ParallelEncodePng: out of memory";
+    return;
+  }
+  enc->set_level(level);
+  enc->set_row_band(band->y_min, band->y_max);
+  std::vector<uint8_t> workbuf(
+      enc->workbuf_len(src->pixel_format(), src->pixcfg.width()).max_incl);
+  band->error_message = EncodePngToVector(
+      enc.get(), band->buf, src,
+      wuffs_base__make_slice_u8(workbuf.data(), workbuf.size()));
+  band->checksum = enc->row_band_checksum();
+  band->length = enc->row_band_length();
+}
+
+}  // namespace private_impl
+
+std::string  //
+private_impl::ParallelInflatePngIdatWith(
+    wuffs_base__slice_u8 dst,
+    const uint8_t* ptr,
+    size_t len,
+    uint32_t max_num_bands,
+    const std::function<void(std::vector<std::function<void()>>&)>& run_tasks) {
+  // Bands that are too small aren't worth a thread.
+  static constexpr size_t min_band_size = 65536;
+
+  std::vector<uint8_t> idat;
+  std::string error_message = private_impl::ConcatenatePngIdat(idat, ptr, len);
+  if (!error_message.empty()) {
+    return error_message;
+  }
+
+  // Check the 2 byte zlib header (no preset dictionary, 32 KiB window or
+  // less) and split off the 4 byte Adler-32 trailer.
+  if (idat.size() < 6) {
+    return "wuffs_aux::ParallelInflatePngIdat: truncated zlib stream";
+  }
+  uint32_t header = (static_cast<uint32_t>(idat[0]) << 8) | idat[1];
+  if (((header >> 8) & 0x8F) != 0x08) {
+    return "wuffs_aux::ParallelInflatePngIdat: bad zlib compression method";
+  } else if ((header % 31) != 0) {
+    return "wuffs_aux::ParallelInflatePngIdat: bad zlib parity";
+  } else if ((header & 0x20) != 0) {
+    return "wuffs_aux::ParallelInflatePngIdat: unsupported zlib preset "
+           "dictionary";
+  }
+  size_t deflate_min = 2;
+  size_t deflate_max = idat.size() - 4;
+  uint32_t want_checksum =
+      private_impl::PngPeekU32BE(idat.data() + deflate_max);
+
+  // Pick the bands. The first band decodes straight into dst.
+  size_t deflate_len = deflate_max - deflate_min;
+  size_t n = deflate_len / min_band_size;
+  if (n > max_num_bands) {
+    n = max_num_bands;
+  }
+  if (n < 1) {
+    n = 1;
+  }
+  std::vector<private_impl::PngIdatBand> bands;
+  for (size_t i = 0, src_min = deflate_min; (i < n) && (src_min < deflate_max);
+       i++) {
+    size_t src_max = deflate_max;
+    if ((i + 1) < n) {
+      size_t target = deflate_min + ((i + 1) * (deflate_len / n));
+      if (target < src_min) {
+        target = src_min;
+      }
+      src_max = private_impl::FindPngFullFlushPoint(idat.data(), target,
+                                                    deflate_max);
+    }
+    bands.emplace_back();
+    bands.back().src_min = src_min;
+    bands.back().src_max = src_max;
+    src_min = src_max;
+  }
+  bands.back().is_last = true;
+  bands.front().fixed = dst;
+
+  std::vector<std::function<void()>> tasks;
+  for (auto& band : bands) {
+    private_impl::PngIdatBand* b = &band;
+    const uint8_t* idat_ptr = idat.data();
+    tasks.push_back([idat_ptr, b]() {
+      private_impl::InflatePngIdatBand(idat_ptr, b);
+    });
+  }
+  run_tasks(tasks);
+
+  // An error in any band could be due to a wrong guess (a band starting at a
+  // false flush point) instead of bad data, so retry single-threaded.
+  bool speculation_failed = false;
+  for (auto& band : bands) {
+    speculation_failed = speculation_failed || band.speculation_failed ||
+                         !band.error_message.empty();
+  }
+  size_t wi = 0;
+  if (speculation_failed) {
+    private_impl::PngIdatBand serial;
+    serial.src_min = deflate_min;
+    serial.src_max = deflate_max;
+    serial.is_last = true;
+    serial.fixed = dst;
+    private_impl::InflatePngIdatBand(idat.data(), &serial);
+    if (!serial.error_message.empty()) {
+      return serial.error_message;
+    }
+    wi = serial.wi;
+  } else {
+    for (auto& band : bands) {
+      if (band.fixed.ptr) {
+        wi = band.wi;
+        continue;
+      } else if ((dst.len - wi) < band.wi) {
+        return "wuffs_aux::ParallelInflatePngIdat: dst is too short";
+      }
+      memcpy(dst.ptr + wi, band.buf.data(), band.wi);
+      wi += band.wi;
+    }
+  }
+  if (wi != dst.len) {
+    return "wuffs_aux::ParallelInflatePngIdat: dst is too long";
+  }
+
+  wuffs_adler32__hasher::unique_ptr hasher = wuffs_adler32__hasher::alloc();
+  if (!hasher) {
+    return "wuffs_aux::ParallelInflatePngIdat: out of memory";
+  } else if (hasher->update_u32(dst) != want_checksum) {
+    return "wuffs_aux::ParallelInflatePngIdat: bad checksum";
+  }
+  return "";
+}
+
+std::string  //
+ParallelInflatePngIdat(wuffs_base__slice_u8 dst,
+                       const uint8_t* ptr,
+                       size_t len,
+                       uint32_t num_threads) {
+  if (num_threads == 0) {
+    num_threads = std::thread::hardware_concurrency();
+    if (num_threads == 0) {
+      num_threads = 1;
+    }
+  }
+  return private_impl::ParallelInflatePngIdatWith(
+      dst, ptr, len, num_threads,
+      [](std::vector<std::function<void()>>& tasks) {
+        std::vector<std::thread> threads;
+        for (size_t i = 1; i < tasks.size(); i++) {
+          threads.emplace_back(tasks[i]);
+        }
+        if (!tasks.empty()) {
+          tasks[0]();
+        }
+        for (auto& t : threads) {
+          t.join();
+        }
+      });
+}
+
+std::string  //
+ParallelEncodePng(std::vector<uint8_t>& dst,
+                  wuffs_base__pixel_buffer* src,
+                  uint32_t level,
+                  uint32_t num_threads) {
+  // Bands with fewer pixel bytes than this aren't worth a thread.
+  static constexpr uint64_t min_band_size = 262144;
+
+  // These are the second byte of the zlib header (after 0x78), indexed by the
+  // compression level. They match the wuffs_png__encoder's own zlib headers.
+  static const uint8_t zlib_flgs[10] = {
+      0x01, 0x01, 0x5E, 0x5E, 0x5E, 0x5E, 0x9C, 0xDA, 0xDA, 0xDA,
+  };
+
+  if (!src) {
+    return "wuffs_aux::ParallelEncodePng: null src";
+  } else if (level > 9) {
+    level = 9;
+  }
+  uint32_t height = src->pixcfg.height();
+  uint64_t pixbuf_len = src->pixcfg.pixbuf_len();
+
+  if (num_threads == 0) {
+    num_threads = std::thread::hardware_concurrency();
+    if (num_threads == 0) {
+      num_threads = 1;
+    }
+  }
+  uint64_t n = pixbuf_len / min_band_size;
+  if (n > num_threads) {
+    n = num_threads;
+  }
+  if (n > height) {
+    n = height;
+  }
+
+  wuffs_png__encoder::unique_ptr enc = wuffs_png__encoder::alloc();
+  if (!enc) {
+    return "wuffs_aux::ParallelEncodePng: out of memory";
+  }
+  enc->set_level(level);
+
+  if (n <= 1) {
+    std::vector<uint8_t> workbuf(
+        enc->workbuf_len(src->pixel_format(), src->pixcfg.width()).max_incl);
+    return private_impl::EncodePngToVector(
+        enc.get(), dst, src,
+        wuffs_base__make_slice_u8(workbuf.data(), workbuf.size()));
+  }
+
+  std::vector<private_impl::PngEncodeBand> bands(n);
+  for (size_t i = 0; i < bands.size(); i++) {
+    bands[i].y_min = static_cast<uint32_t>((i * height) / n);
+    bands[i].y_max = static_cast<uint32_t>(((i + 1) * height) / n);
+  }
+
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < bands.size(); i++) {
+    threads.emplace_back(private_impl::EncodePngBand, src, level, &bands[i]);
+  }
+  private_impl::EncodePngBand(src, level, &bands[0]);
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  // Assemble the zlib stream: header, the concatenated bands and the
+  // combined Adler-32 checksum.
+  wuffs_adler32__hasher::unique_ptr hasher = wuffs_adler32__hasher::alloc();
+  if (!hasher) {
+    return "wuffs_aux::ParallelEncodePng: out of memory";
+  }
+  std::vector<uint8_t> zlib;
+  zlib.push_back(0x78);
+  zlib.push_back(zlib_flgs[level]);
+  uint32_t checksum = 1;
+  for (auto& band : bands) {
+    if (!band.error_message.empty()) {
+      return band.error_message;
+    }
+    zlib.insert(zlib.end(), band.buf.begin(), band.buf.end());
+    checksum = hasher->combine_u32(band.checksum, band.length);
+  }
+  zlib.push_back(static_cast<uint8_t>(checksum >> 24));
+  zlib.push_back(static_cast<uint8_t>(checksum >> 16));
+  zlib.push_back(static_cast<uint8_t>(checksum >> 8));
+  zlib.push_back(static_cast<uint8_t>(checksum >> 0));
+
+  enc->set_workbuf_prefilled(true);
+  return private_impl::EncodePngToVector(
+      enc.get(), dst, src, wuffs_base__make_slice_u8(zlib.data(), zlib.size()));
+}
+
+}  // namespace wuffs_aux
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) ||
+        // defined(WUFFS_CONFIG__MODULE__AUX__PNG)
@@ -0,0 +1,90 @@
+// Copyright 2022 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ---------------- Auxiliary - PNG
+
+#include <functional>
+#include <vector>
+
+namespace wuffs_aux {
+
+namespace private_impl {
+
+// ParallelInflatePngIdatWith is like ParallelInflatePngIdat but, instead of
+// spawning its own threads, it splits the work into up to max_num_bands tasks
+// and passes them to run_tasks, which should run them all (in any order,
+// possibly concurrently) and return once they are done. It lets a scheduler
+// like wuffs_aux::DecodeImages' worker pool do the work.
+std::string  //
+ParallelInflatePngIdatWith(
+    wuffs_base__slice_u8 dst,
+    const uint8_t* ptr,
+    size_t len,
+    uint32_t max_num_bands,
+    const std::function<void(std::vector<std::function<void()>>&)>& run_tasks);
+
+}  // namespace private_impl
+
+// ParallelInflatePngIdat decompresses an in-memory PNG file's IDAT data (the
+// zlib stream split over one or more IDAT chunks) into dst, which should be
+// exactly as long as that zlib stream's decompressed size. For a
+// non-interlaced image, that is the wuffs_png__decoder's workbuf_len, and the
+// result can then be passed to a wuffs_png__decoder configured with
+// set_workbuf_prefilled(true), which then only needs to apply the PNG filters
+// and swizzle the pixels.
+//
+// Unlike the rest of Wuffs, it is not single-threaded. A zlib stream is
+// usually a single serial dependency chain but, if the encoder emitted full
+// flush points (an empty stored deflate block, after which no back-reference
+// crosses the flush point), the bands between flush points can be decompressed
+// independently. This function looks for up to num_threads bands (zero means
+// std::thread::hardware_concurrency()), each decompressed on its own thread
+// with its own wuffs_deflate__decoder. The "00 00 FF FF" byte pattern used to
+// find candidate flush points can also occur by chance, so each band's end is
+// verified against the next band's start, falling back to a single-threaded
+// decode if any guess was wrong. The Adler-32 checksum is always verified.
+//
+// It returns an empty string on success or an error message otherwise.
+std::string  //
+ParallelInflatePngIdat(wuffs_base__slice_u8 dst,
+                       const uint8_t* ptr,
+                       size_t len,
+                       uint32_t num_threads = 0);
+
+// ParallelEncodePng encodes src as a PNG file, appending it to dst, at the
+// given deflate compression level (from 0 to 9).
+//
+// Like ParallelInflatePngIdat, it is not single-threaded. It splits src into
+// up to num_threads (zero means std::thread::hardware_concurrency()) row
+// bands, each filtered and compressed on its own thread by its own
+// wuffs_png__encoder configured with set_row_band. All but the last band end
+// with a deflate full flush, so that concatenating them gives a valid zlib
+// stream, whose Adler-32 checksum is combined from the bands' checksums. A
+// final wuffs_png__encoder, configured with set_workbuf_prefilled(true), then
+// wraps that zlib stream in PNG chunks. Each band's first row is filtered
+// against the previous band's last row, so the output is also decodable by
+// ParallelInflatePngIdat in parallel.
+//
+// Compressing each band separately costs a little compression ratio, as no
+// back-reference crosses a band boundary. Small images are encoded as a
+// single band.
+//
+// It returns an empty string on success or an error message otherwise.
+std::string  //
+ParallelEncodePng(std::vector<uint8_t>& dst,
+                  wuffs_base__pixel_buffer* src,
+                  uint32_t level = 6,
+                  uint32_t num_threads = 0);
+
+}  // namespace wuffs_aux
@@ -0,0 +1,415 @@
+// Copyright 2021 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ---------------- Auxiliary - RAC
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__AUX__RAC)
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace wuffs_aux {
+
+namespace sync_io {
+
+namespace private_impl {
+
+// RacInputUnit is a unit of work: decompressing the DRange [dmin .. dmax) into
+// buf[0 .. wi). The state and generation fields are guarded by the
+// RacInputState's mutex. The other fields are owned by either a worker thread
+// (when Running) or the CopyIn caller (when Done).
+struct RacInputUnit {
+  enum State {
+    Free = 0,
+    Queued = 1,
+    Running = 2,
+    Done = 3,
+  };
+
+  RacInputUnit() : state(Free), generation(0), dmin(0), dmax(0), wi(0) {}
+
+  State state;
+  uint64_t generation;
+  uint64_t dmin;
+  uint64_t dmax;
+  size_t wi;
+  std::vector<uint8_t> buf;
+  std::string error_message;
+};
+
+struct RacInputState {
+  RacInputState(const uint8_t* ptr, size_t len, size_t unit_size);
+
+  void dispatch();
+  void run_worker();
+  std::string find_decompressed_size();
+  std::string decode(wuffs_rac__decoder::unique_ptr& dec,
+                     std::vector<uint8_t>& workbuf,
+                     RacInputUnit* unit);
+
+  const uint8_t* const m_ptr;
+  const size_t m_len;
+  const size_t m_unit_size;
+
+  std::mutex m_mutex;
+  std::condition_variable m_work_cv;
+  std::condition_variable m_done_cv;
+
+  // These fields are guarded by m_mutex. The m_generation field is also
+  // atomic, so that worker threads can check for cancelation without the
+  // mutex.
+  std::atomic<uint64_t> m_generation;
+  bool m_shutting_down;
+  std::deque<RacInputUnit*> m_queue;
+  std::vector<RacInputUnit> m_units;
+
+  // These fields are only used by the RacInput caller's thread. The
+  // m_error_message is sticky: it is about finding the root node, not about
+  // any particular unit of work.
+  std::vector<std::thread> m_threads;
+  std::string m_error_message;
+  bool m_have_decompressed_size;
+  uint64_t m_decompressed_size;
+  uint64_t m_pos;
+  uint64_t m_next_dispatch_pos;
+};
+
+RacInputState::RacInputState(const uint8_t* ptr, size_t len, size_t unit_size)
+    : m_ptr(ptr),
+      m_len(len),
+      m_unit_size(unit_size),
+      m_generation(1),
+      m_shutting_down(false),
+      m_have_decompressed_size(false),
+      m_decompressed_size(0),
+      m_pos(0),
+      m_next_dispatch_pos(0) {}
+
+// dispatch queues more units of work, up to the number of Free units. The
+// caller must hold m_mutex.
+void  //
+RacInputState::dispatch() {
+  uint64_t generation = m_generation.load();
+  for (auto& unit : m_units) {
+    if (m_next_dispatch_pos >= m_decompressed_size) {
+      break;
+    } else if (unit.state != RacInputUnit::Free) {
+      continue;
+    }
+    uint64_t n = m_decompressed_size - m_next_dispatch_pos;
+    if (n > m_unit_size) {
+      n = m_unit_size;
+    }
+    unit.state = RacInputUnit::Queued;
+    unit.generation = generation;
+    unit.dmin = m_next_dispatch_pos;
+    unit.dmax = m_next_dispatch_pos + n;
+    unit.wi = 0;
+    unit.error_message.clear();
+    m_next_dispatch_pos += n;
+    m_queue.push_back(&unit);
+    m_work_cv.notify_one();
+  }
+}
+
+void  //
+RacInputState::run_worker() {
+  wuffs_rac__decoder::unique_ptr dec(nullptr, &free);
+  std::vector<uint8_t> workbuf;
+
+  while (true) {
+    RacInputUnit* unit = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      while (!m_shutting_down && m_queue.empty()) {
+        m_work_cv.wait(lock);
+      }
+      if (m_shutting_down) {
+        return;
+      }
+      unit = m_queue.front();
+      m_queue.pop_front();
+      unit->state = RacInputUnit::Running;
+    }
+
+    std::string error_message = decode(dec, workbuf, unit);
+
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      if (unit->generation == m_generation.load()) {
+        unit->error_message = std::move(error_message);
+        unit->state = RacInputUnit::Done;
+      } else {
+        unit->state = RacInputUnit::Free;
+      }
+    }
+    m_done_cv.notify_all();
+  }
+}
+
+std::string  //
+RacInputState::find_decompressed_size() {
+  wuffs_rac__decoder::unique_ptr dec = wuffs_rac__decoder::alloc();
+  std::vector<uint8_t> workbuf(
+      WUFFS_RAC__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE);
+  if (!dec) {
+    return "wuffs_aux::sync_io::RacInput: out of memory";
+  }
+  dec->set_compressed_size(m_len);
+
+  // Decoding the empty DRange still has to find (and validate) the root node,
+  // which gives the DFileSize.
+  IOBuffer src = wuffs_base__ptr_u8__reader(const_cast<uint8_t*>(m_ptr),  //
+                                            m_len, true);
+  IOBuffer dst = wuffs_base__empty_io_buffer();
+  while (true) {
+    wuffs_base__status status = dec->transform_io(
+        &dst, &src, wuffs_base__make_slice_u8(workbuf.data(), workbuf.size()));
+    if (status.repr == wuffs_base__suspension__mispositioned_read) {
+      uint64_t pos = dec->io_seek_position();
+      if (pos > m_len) {
+        return "wuffs_aux::sync_io::RacInput: io_seek_position out of bounds";
+      }
+      src.meta.ri = static_cast<size_t>(pos);
+      continue;
+    } else if (!status.is_ok()) {
+      return status.message();
+    }
+    break;
+  }
+  m_decompressed_size = dec->decompressed_size();
+  m_have_decompressed_size = true;
+  return "";
+}
+
+std::string  //
+RacInputState::decode(wuffs_rac__decoder::unique_ptr& dec,
+                      std::vector<uint8_t>& workbuf,
+                      RacInputUnit* unit) {
+  // Check for cancelation after (at most) every 64 KiB of output.
+  static constexpr size_t window_size = 65536;
+
+  if (!dec) {
+    dec = wuffs_rac__decoder::alloc();
+    if (!dec) {
+      return "wuffs_aux::sync_io::RacInput: out of memory";
+    }
+    dec->set_compressed_size(m_len);
+    workbuf.resize(WUFFS_RAC__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE);
+  }
+  if (unit->buf.size() < m_unit_size) {
+    unit->buf.resize(m_unit_size);
+  }
+  size_t unit_len = static_cast<size_t>(unit->dmax - unit->dmin);
+
+  // Re-using the decoder (after an ok status) skips re-finding the root node.
+  dec->set_drange(unit->dmin, unit->dmax);
+  IOBuffer src = wuffs_base__ptr_u8__reader(const_cast<uint8_t*>(m_ptr),  //
+                                            m_len, true);
+  IOBuffer dst = wuffs_base__ptr_u8__writer(unit->buf.data(), 0);
+  while (true) {
+    if (unit->generation != m_generation.load()) {
+      // Canceled. The decoder is mid-coroutine, so start afresh next time.
+      dec.reset();
+      return "";
+    }
+    dst.data.len = dst.meta.wi + window_size;
+    if (dst.data.len > unit_len) {
+      dst.data.len = unit_len;
+    }
+    wuffs_base__status status = dec->transform_io(
+        &dst, &src, wuffs_base__make_slice_u8(workbuf.data(), workbuf.size()));
+    unit->wi = dst.meta.wi;
+    if (status.repr == wuffs_base__suspension__short_write) {
+      if (dst.meta.wi < unit_len) {
+        continue;
+      }
+    } else if (status.repr == wuffs_base__suspension__mispositioned_read) {
+      uint64_t pos = dec->io_seek_position();
+      if (pos <= m_len) {
+        src.meta.ri = static_cast<size_t>(pos);
+        continue;
+      }
+    } else if (status.is_ok()) {
+      if (dst.meta.wi == unit_len) {
+        return "";
+      }
+    } else {
+      dec.reset();
+      return status.message();
+    }
+    dec.reset();
+    return "wuffs_aux::sync_io::RacInput: internal error: inconsistent state";
+  }
+}
+
+}  // namespace private_impl
+
+// --------
+
+RacInput::RacInput(const uint8_t* ptr,
+                   size_t len,
+                   uint32_t num_threads,
+                   uint32_t num_units_in_flight,
+                   size_t unit_size) {
+  if (num_threads == 0) {
+    num_threads = std::thread::hardware_concurrency();
+    if (num_threads == 0) {
+      num_threads = 1;
+    }
+  }
+  if (num_units_in_flight == 0) {
+    num_units_in_flight = 2 * num_threads;
+  }
+  if (unit_size == 0) {
+    unit_size = 1048576;
+  }
+
+  m_state.reset(new private_impl::RacInputState(ptr, len, unit_size));
+  m_state->m_units.resize(num_units_in_flight);
+  m_state->m_threads.reserve(num_threads);
+  for (uint32_t i = 0; i < num_threads; i++) {
+    m_state->m_threads.emplace_back(&private_impl::RacInputState::run_worker,
+                                    m_state.get());
+  }
+}
+
+RacInput::~RacInput() {
+  {
+    std::unique_lock<std::mutex> lock(m_state->m_mutex);
+    m_state->m_shutting_down = true;
+    m_state->m_generation++;
+  }
+  m_state->m_work_cv.notify_all();
+  for (auto& t : m_state->m_threads) {
+    t.join();
+  }
+}
+
+uint64_t  //
+RacInput::DecompressedSize() const {
+  return m_state->m_decompressed_size;
+}
+
+std::string  //
+RacInput::Seek(uint64_t pos) {
+  private_impl::RacInputState* s = m_state.get();
+  if (!s->m_have_decompressed_size && s->m_error_message.empty()) {
+    s->m_error_message = s->find_decompressed_size();
+  }
+  if (!s->m_error_message.empty()) {
+    return s->m_error_message;
+  }
+
+  std::unique_lock<std::mutex> lock(s->m_mutex);
+  s->m_generation++;
+  s->m_queue.clear();
+  for (auto& unit : s->m_units) {
+    // Running units are freed by their worker thread, once it notices that
+    // the generation has changed.
+    if (unit.state != private_impl::RacInputUnit::Running) {
+      unit.state = private_impl::RacInputUnit::Free;
+    }
+  }
+  s->m_pos = pos;
+  s->m_next_dispatch_pos = pos;
+  return "";
+}
+
+std::string  //
+RacInput::CopyIn(IOBuffer* dst) {
+  private_impl::RacInputState* s = m_state.get();
+  if (!dst) {
+    return "wuffs_aux::sync_io::RacInput: nullptr IOBuffer";
+  } else if (dst->meta.closed) {
+    return "wuffs_aux::sync_io::RacInput: end of file";
+  }
+  if (!s->m_have_decompressed_size && s->m_error_message.empty()) {
+    s->m_error_message = s->find_decompressed_size();
+  }
+  if (!s->m_error_message.empty()) {
+    return s->m_error_message;
+  }
+
+  dst->compact();
+  while ((s->m_pos < s->m_decompressed_size) && (dst->writer_length() > 0)) {
+    private_impl::RacInputUnit* unit = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(s->m_mutex);
+      while (true) {
+        s->dispatch();
+        for (auto& u : s->m_units) {
+          if ((u.state != private_impl::RacInputUnit::Free) &&
+              (u.generation == s->m_generation.load()) &&
+              (u.dmin <= s->m_pos) && (s->m_pos < u.dmax)) {
+            unit = &u;
+            break;
+          }
+        }
+        if (!unit) {
+          // After a Seek, every unit might still be Running (canceled) work
+          // for the old position. Wait for one of them to become Free.
+          bool any_running = false;
+          for (auto& u : s->m_units) {
+            any_running |= u.state == private_impl::RacInputUnit::Running;
+          }
+          if (!any_running) {
+            return "wuffs_aux::sync_io::RacInput: internal error: no unit";
+          }
+        } else if (unit->state == private_impl::RacInputUnit::Done) {
+          break;
+        } else if (dst->meta.wi > 0) {
+          // Don't wait if the caller already has something to work with.
+          return "";
+        }
+        unit = nullptr;
+        s->m_done_cv.wait(lock);
+      }
+    }
+
+    // The unit is Done, so it is owned by this thread and we can read its
+    // buffer without holding the mutex.
+    if (!unit->error_message.empty()) {
+      return unit->error_message;
+    }
+    size_t i = static_cast<size_t>(s->m_pos - unit->dmin);
+    size_t n = unit->wi - i;
+    if (n > dst->writer_length()) {
+      n = dst->writer_length();
+    }
+    memcpy(dst->writer_pointer(), unit->buf.data() + i, n);
+    dst->meta.wi += n;
+    s->m_pos += n;
+
+    if (s->m_pos >= unit->dmax) {
+      std::unique_lock<std::mutex> lock(s->m_mutex);
+      unit->state = private_impl::RacInputUnit::Free;
+    }
+  }
+  dst->meta.closed = s->m_pos >= s->m_decompressed_size;
+  return "";
+}
+
+// --------
+
+}  // namespace sync_io
+
+}  // namespace wuffs_aux
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) ||
+        // defined(WUFFS_CONFIG__MODULE__AUX__RAC)
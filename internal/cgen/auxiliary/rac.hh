@@ -0,0 +1,79 @@
+// Copyright 2021 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ---------------- Auxiliary - RAC
+
+namespace wuffs_aux {
+
+namespace sync_io {
+
+// --------
+
+namespace private_impl {
+struct RacInputState;
+}  // namespace private_impl
+
+// RacInput is an Input that decompresses an in-memory RAC (Random Access
+// Compression) file. Unlike the other Input implementations, it is not
+// single-threaded: it keeps up to num_units_in_flight units of work (each
+// decompressing at most unit_size bytes in DSpace) in flight on a pool of
+// num_threads worker threads, so that sequential reads of large RAC files
+// scale with the number of CPU cores. Each worker thread has its own
+// wuffs_rac__decoder and the units' buffers are recycled.
+//
+// Zero-valued constructor arguments (other than ptr and len) mean to use a
+// default value: std::thread::hardware_concurrency() worker threads, twice as
+// many units in flight and a unit_size of 1 MiB. A unit boundary can fall in
+// the middle of a RAC chunk, in which case that chunk is (partially)
+// decompressed twice, so the unit_size should be much larger than the RAC
+// file's chunk size.
+//
+// It does not take responsibility for freeing the memory when done.
+class RacInput : public Input {
+ public:
+  RacInput(const uint8_t* ptr,
+           size_t len,
+           uint32_t num_threads = 0,
+           uint32_t num_units_in_flight = 0,
+           size_t unit_size = 0);
+  virtual ~RacInput();
+
+  virtual std::string CopyIn(IOBuffer* dst);
+
+  // DecompressedSize returns the RAC file's size in DSpace. It returns zero if
+  // that isn't known yet, which is until after the first CopyIn or Seek call.
+  uint64_t DecompressedSize() const;
+
+  // Seek sets the position (in DSpace) of the next byte that CopyIn writes.
+  // It cancels any work-in-progress, although the worker threads only notice
+  // that periodically (between chunks or after every 64 KiB decompressed).
+  //
+  // Callers should also discard any unread bytes in their IOBuffer (e.g. set
+  // its meta.ri, meta.wi and meta.closed to the default values) before the
+  // next CopyIn call.
+  std::string Seek(uint64_t pos);
+
+ private:
+  std::unique_ptr<private_impl::RacInputState> m_state;
+
+  // Delete the copy and assign constructors.
+  RacInput(const RacInput&) = delete;
+  RacInput& operator=(const RacInput&) = delete;
+};
+
+// --------
+
+}  // namespace sync_io
+
+}  // namespace wuffs_aux
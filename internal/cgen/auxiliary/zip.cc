@@ -0,0 +1,470 @@
+// Copyright 2022 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ---------------- Auxiliary - Zip
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__AUX__ZIP)
+
+#include <atomic>
+#include <thread>
+
+namespace wuffs_aux {
+
+const char ZipReader_BadArchive[] =  //
+    "wuffs_aux::ZipReader: bad archive";
+const char ZipReader_BadChecksum[] =  //
+    "wuffs_aux::ZipReader: bad checksum";
+const char ZipReader_BadIndex[] =  //
+    "wuffs_aux::ZipReader: bad index";
+const char ZipReader_BadUncompressedSize[] =  //
+    "wuffs_aux::ZipReader: bad uncompressed size";
+const char ZipReader_OutOfMemory[] =  //
+    "wuffs_aux::ZipReader: out of memory";
+const char ZipReader_UnsupportedArchive[] =  //
+    "wuffs_aux::ZipReader: unsupported archive";
+const char ZipReader_UnsupportedMember[] =  //
+    "wuffs_aux::ZipReader: unsupported member";
+
+namespace {
+
+// These are the Zip format's record signatures and fixed lengths. See
+// https://pkware.cachefly.net/webdocs/casestudies/APPNOTE.TXT
+constexpr uint32_t ZipReader_CentralDirectoryHeaderSignature = 0x02014B50;
+constexpr uint32_t ZipReader_LocalFileHeaderSignature = 0x04034B50;
+constexpr uint32_t ZipReader_EOCDSignature = 0x06054B50;
+constexpr uint32_t ZipReader_Zip64EOCDSignature = 0x06064B50;
+constexpr uint32_t ZipReader_Zip64EOCDLocatorSignature = 0x07064B50;
+
+constexpr size_t ZipReader_CentralDirectoryHeaderLength = 46;
+constexpr size_t ZipReader_LocalFileHeaderLength = 30;
+constexpr size_t ZipReader_EOCDLength = 22;
+constexpr size_t ZipReader_Zip64EOCDLength = 56;
+constexpr size_t ZipReader_Zip64EOCDLocatorLength = 20;
+
+// ZipReader_Hash is the 32-bit FNV-1a hash of a member name.
+uint32_t  //
+ZipReader_Hash(const char* ptr, size_t len) {
+  uint32_t h = 0x811C9DC5;
+  for (size_t i = 0; i < len; i++) {
+    h ^= static_cast<uint8_t>(ptr[i]);
+    h *= 0x01000193;
+  }
+  return h;
+}
+
+// ZipReader_ParseZip64ExtraField replaces those of usize, csize and lho that
+// are 0xFFFF_FFFF with their 64-bit values from the Zip64 extended
+// information extra field (whose header ID is 0x0001), in that order.
+bool  //
+ZipReader_ParseZip64ExtraField(const uint8_t* p,
+                               size_t n,
+                               uint64_t* usize,
+                               uint64_t* csize,
+                               uint64_t* lho) {
+  while (n >= 4) {
+    uint16_t id = wuffs_base__peek_u16le__no_bounds_check(p + 0);
+    size_t len = wuffs_base__peek_u16le__no_bounds_check(p + 2);
+    p += 4;
+    n -= 4;
+    if (len > n) {
+      return false;
+    } else if (id == 0x0001) {
+      uint64_t* fields[3] = {usize, csize, lho};
+      for (uint64_t* f : fields) {
+        if (*f != 0xFFFFFFFF) {
+          continue;
+        } else if (len < 8) {
+          return false;
+        }
+        *f = wuffs_base__peek_u64le__no_bounds_check(p);
+        p += 8;
+        n -= 8;
+        len -= 8;
+      }
+      return true;
+    }
+    p += len;
+    n -= len;
+  }
+  return (*usize != 0xFFFFFFFF) && (*csize != 0xFFFFFFFF) &&
+         (*lho != 0xFFFFFFFF);
+}
+
+}  // namespace
+
+ZipReader::ZipReader(const uint8_t* ptr, size_t len, uint32_t flags)
+    : m_ptr(ptr),
+      m_len(ptr ? len : 0),
+      m_flags(flags),
+      m_error_message(),
+      m_entries(),
+      m_hash_table() {
+  m_error_message = parse_central_directory();
+  if (!m_error_message.empty()) {
+    m_entries.clear();
+    m_hash_table.clear();
+  }
+}
+
+const std::string&  //
+ZipReader::error_message() const {
+  return m_error_message;
+}
+
+size_t  //
+ZipReader::num_entries() const {
+  return m_entries.size();
+}
+
+const ZipEntry&  //
+ZipReader::entry(size_t index) const {
+  return m_entries[index];
+}
+
+size_t  //
+ZipReader::Find(const char* name_ptr, size_t name_len) const {
+  if (m_hash_table.empty()) {
+    return npos;
+  }
+  size_t mask = m_hash_table.size() - 1;
+  for (size_t i = ZipReader_Hash(name_ptr, name_len) & mask;;
+       i = (i + 1) & mask) {
+    uint32_t slot = m_hash_table[i];
+    if (slot == 0) {
+      return npos;
+    }
+    const ZipEntry& e = m_entries[slot - 1];
+    if ((e.name_len == name_len) &&
+        ((name_len == 0) || !memcmp(e.name_ptr, name_ptr, name_len))) {
+      return slot - 1;
+    }
+  }
+}
+
+size_t  //
+ZipReader::Find(const std::string& name) const {
+  return Find(name.data(), name.size());
+}
+
+std::string  //
+ZipReader::parse_central_directory() {
+  // The EOCD (End Of Central Directory) record is at the end of the archive,
+  // followed by a variable length (up to 0xFFFF bytes) comment. Scan
+  // backwards for its signature.
+  if (m_len < ZipReader_EOCDLength) {
+    return ZipReader_BadArchive;
+  }
+  size_t eocd = m_len - ZipReader_EOCDLength;
+  size_t eocd_min = (eocd > 0xFFFF) ? (eocd - 0xFFFF) : 0;
+  while (wuffs_base__peek_u32le__no_bounds_check(m_ptr + eocd) !=
+         ZipReader_EOCDSignature) {
+    if (eocd <= eocd_min) {
+      return ZipReader_BadArchive;
+    }
+    eocd--;
+  }
+
+  const uint8_t* p = m_ptr + eocd;
+  uint32_t disk = wuffs_base__peek_u16le__no_bounds_check(p + 4);
+  uint32_t cd_disk = wuffs_base__peek_u16le__no_bounds_check(p + 6);
+  uint64_t num_entries = wuffs_base__peek_u16le__no_bounds_check(p + 10);
+  uint64_t cd_size = wuffs_base__peek_u32le__no_bounds_check(p + 12);
+  uint64_t cd_offset = wuffs_base__peek_u32le__no_bounds_check(p + 16);
+
+  // Look for the Zip64 EOCD locator (and then the Zip64 EOCD record) if any
+  // of the EOCD fields are saturated.
+  if ((num_entries == 0xFFFF) || (cd_size == 0xFFFFFFFF) ||
+      (cd_offset == 0xFFFFFFFF)) {
+    if (eocd < ZipReader_Zip64EOCDLocatorLength) {
+      return ZipReader_BadArchive;
+    }
+    p = m_ptr + eocd - ZipReader_Zip64EOCDLocatorLength;
+    if (wuffs_base__peek_u32le__no_bounds_check(p) ==
+        ZipReader_Zip64EOCDLocatorSignature) {
+      uint64_t offset = wuffs_base__peek_u64le__no_bounds_check(p + 8);
+      if ((offset > m_len) || ((m_len - offset) < ZipReader_Zip64EOCDLength)) {
+        return ZipReader_BadArchive;
+      }
+      p = m_ptr + offset;
+      if (wuffs_base__peek_u32le__no_bounds_check(p) !=
+          ZipReader_Zip64EOCDSignature) {
+        return ZipReader_BadArchive;
+      }
+      disk = wuffs_base__peek_u32le__no_bounds_check(p + 16);
+      cd_disk = wuffs_base__peek_u32le__no_bounds_check(p + 20);
+      num_entries = wuffs_base__peek_u64le__no_bounds_check(p + 32);
+      cd_size = wuffs_base__peek_u64le__no_bounds_check(p + 40);
+      cd_offset = wuffs_base__peek_u64le__no_bounds_check(p + 48);
+    }
+  }
+
+  if ((disk != 0) || (cd_disk != 0)) {
+    return ZipReader_UnsupportedArchive;
+  } else if ((cd_offset > m_len) || (cd_size > (m_len - cd_offset)) ||
+             (num_entries >
+              (cd_size / ZipReader_CentralDirectoryHeaderLength))) {
+    return ZipReader_BadArchive;
+  } else if (num_entries >= 0x40000000) {
+    return ZipReader_UnsupportedArchive;
+  }
+
+  m_entries.reserve(static_cast<size_t>(num_entries));
+  p = m_ptr + cd_offset;
+  size_t n = static_cast<size_t>(cd_size);
+  for (uint64_t i = 0; i < num_entries; i++) {
+    if ((n < ZipReader_CentralDirectoryHeaderLength) ||
+        (wuffs_base__peek_u32le__no_bounds_check(p) !=
+         ZipReader_CentralDirectoryHeaderSignature)) {
+      return ZipReader_BadArchive;
+    }
+    size_t name_len = wuffs_base__peek_u16le__no_bounds_check(p + 28);
+    size_t extra_len = wuffs_base__peek_u16le__no_bounds_check(p + 30);
+    size_t comment_len = wuffs_base__peek_u16le__no_bounds_check(p + 32);
+    size_t record_len = ZipReader_CentralDirectoryHeaderLength + name_len +
+                        extra_len + comment_len;
+    if (record_len > n) {
+      return ZipReader_BadArchive;
+    }
+
+    ZipEntry e;
+    e.name_ptr = reinterpret_cast<const char*>(
+        p + ZipReader_CentralDirectoryHeaderLength);
+    e.name_len = name_len;
+    e.local_header_offset = wuffs_base__peek_u32le__no_bounds_check(p + 42);
+    e.compressed_size = wuffs_base__peek_u32le__no_bounds_check(p + 20);
+    e.uncompressed_size = wuffs_base__peek_u32le__no_bounds_check(p + 24);
+    e.crc32 = wuffs_base__peek_u32le__no_bounds_check(p + 16);
+    e.flags = wuffs_base__peek_u16le__no_bounds_check(p + 8);
+    e.method = wuffs_base__peek_u16le__no_bounds_check(p + 10);
+    if (((e.uncompressed_size == 0xFFFFFFFF) ||
+         (e.compressed_size == 0xFFFFFFFF) ||
+         (e.local_header_offset == 0xFFFFFFFF)) &&
+        !ZipReader_ParseZip64ExtraField(
+            p + ZipReader_CentralDirectoryHeaderLength + name_len, extra_len,
+            &e.uncompressed_size, &e.compressed_size,
+            &e.local_header_offset)) {
+      return ZipReader_BadArchive;
+    }
+    m_entries.push_back(e);
+
+    p += record_len;
+    n -= record_len;
+  }
+
+  // Build the hash table, with a load factor of at most 50%. For duplicate
+  // names, Find returns the first one.
+  size_t table_len = 1;
+  while (table_len < (2 * m_entries.size())) {
+    table_len *= 2;
+  }
+  m_hash_table.resize(table_len);
+  size_t mask = table_len - 1;
+  for (size_t j = 0; j < m_entries.size(); j++) {
+    const ZipEntry& e = m_entries[j];
+    if (Find(e.name_ptr, e.name_len) != npos) {
+      continue;
+    }
+    size_t k = ZipReader_Hash(e.name_ptr, e.name_len) & mask;
+    while (m_hash_table[k] != 0) {
+      k = (k + 1) & mask;
+    }
+    m_hash_table[k] = static_cast<uint32_t>(j + 1);
+  }
+  return "";
+}
+
+ZipExtractResult  //
+ZipReader::Extract(size_t index, std::vector<uint8_t>& buffer) const {
+  wuffs_deflate__decoder::unique_ptr dec = wuffs_deflate__decoder::alloc();
+  wuffs_crc32__ieee_hasher::unique_ptr hasher =
+      wuffs_crc32__ieee_hasher::alloc();
+  if (!dec || !hasher) {
+    ZipExtractResult result;
+    result.error_message = ZipReader_OutOfMemory;
+    result.data_ptr = nullptr;
+    result.data_len = 0;
+    return result;
+  }
+  return extract(dec.get(), hasher.get(), index, buffer);
+}
+
+size_t  //
+ZipReader::ExtractMany(ZipExtractResult* results,
+                       std::vector<uint8_t>* buffers,
+                       const size_t* indexes,
+                       size_t n,
+                       uint32_t num_threads) const {
+  if (n == 0) {
+    return 0;
+  } else if (num_threads == 0) {
+    num_threads = std::thread::hardware_concurrency();
+    if (num_threads == 0) {
+      num_threads = 1;
+    }
+  }
+
+  // Workers claim the next unextracted member until there are none left.
+  // Each result is written by exactly one worker.
+  std::atomic<size_t> next(0);
+  auto run_worker = [&]() {
+    wuffs_deflate__decoder::unique_ptr dec = wuffs_deflate__decoder::alloc();
+    wuffs_crc32__ieee_hasher::unique_ptr hasher =
+        wuffs_crc32__ieee_hasher::alloc();
+    for (size_t i = next++; i < n; i = next++) {
+      if (!dec || !hasher) {
+        results[i].error_message = ZipReader_OutOfMemory;
+        results[i].data_ptr = nullptr;
+        results[i].data_len = 0;
+        continue;
+      }
+      results[i] = extract(dec.get(), hasher.get(), indexes[i], buffers[i]);
+    }
+  };
+
+  size_t num_workers = num_threads;
+  if (num_workers > n) {
+    num_workers = n;
+  }
+
+  // The calling thread is one of the num_workers workers.
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < num_workers; i++) {
+    threads.emplace_back(run_worker);
+  }
+  run_worker();
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  size_t num_ok = 0;
+  for (size_t i = 0; i < n; i++) {
+    num_ok += results[i].error_message.empty() ? 1 : 0;
+  }
+  return num_ok;
+}
+
+ZipExtractResult  //
+ZipReader::extract(wuffs_deflate__decoder* dec,
+                   wuffs_crc32__ieee_hasher* hasher,
+                   size_t index,
+                   std::vector<uint8_t>& buffer) const {
+  ZipExtractResult result;
+  result.data_ptr = nullptr;
+  result.data_len = 0;
+  if (index >= m_entries.size()) {
+    result.error_message = ZipReader_BadIndex;
+    return result;
+  }
+  const ZipEntry& e = m_entries[index];
+  if ((e.flags & 0x0001) || ((e.method != 0) && (e.method != 8))) {
+    // Bit 0 of the flags means that the member is encrypted.
+    result.error_message = ZipReader_UnsupportedMember;
+    return result;
+  }
+
+  // The local file header's name and extra field lengths can differ from the
+  // central directory's. Its sizes and CRC-32 (which may be zero, if bit 3 of
+  // the flags is set, with the real values in a trailing data descriptor) are
+  // ignored.
+  uint64_t lho = e.local_header_offset;
+  if ((lho > m_len) || ((m_len - lho) < ZipReader_LocalFileHeaderLength) ||
+      (wuffs_base__peek_u32le__no_bounds_check(m_ptr + lho) !=
+       ZipReader_LocalFileHeaderSignature)) {
+    result.error_message = ZipReader_BadArchive;
+    return result;
+  }
+  uint64_t data_offset =
+      lho + ZipReader_LocalFileHeaderLength +
+      wuffs_base__peek_u16le__no_bounds_check(m_ptr + lho + 26) +
+      wuffs_base__peek_u16le__no_bounds_check(m_ptr + lho + 28);
+  if ((data_offset > m_len) || (e.compressed_size > (m_len - data_offset))) {
+    result.error_message = ZipReader_BadArchive;
+    return result;
+  }
+  const uint8_t* src_ptr = m_ptr + data_offset;
+  size_t src_len = static_cast<size_t>(e.compressed_size);
+
+  if (e.method == 0) {
+    if (e.compressed_size != e.uncompressed_size) {
+      result.error_message = ZipReader_BadUncompressedSize;
+      return result;
+    }
+    result.data_ptr = src_ptr;
+    result.data_len = src_len;
+
+  } else {
+    if (e.uncompressed_size > buffer.max_size()) {
+      result.error_message = ZipReader_OutOfMemory;
+      return result;
+    }
+    buffer.resize(static_cast<size_t>(e.uncompressed_size));
+
+    // Re-initializing with LEAVE_INTERNAL_BUFFERS_UNINITIALIZED resets the
+    // previous member's state but skips zeroing the Huffman tables. The flat
+    // dst buffer holds the whole of the history, so no workbuf is needed.
+    wuffs_base__status status = dec->initialize(
+        sizeof__wuffs_deflate__decoder(), WUFFS_VERSION,
+        WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED);
+    if (!status.is_ok()) {
+      result.error_message.assign(status.message());
+      return result;
+    }
+    dec->set_dst_holds_history(true);
+
+    wuffs_base__io_buffer src = wuffs_base__ptr_u8__reader(
+        const_cast<uint8_t*>(src_ptr), src_len, true);
+    wuffs_base__io_buffer dst =
+        wuffs_base__ptr_u8__writer(buffer.data(), buffer.size());
+    status = dec->transform_io(&dst, &src, wuffs_base__empty_slice_u8());
+    if (status.repr == wuffs_base__suspension__short_read) {
+      result.error_message = ZipReader_BadArchive;
+      return result;
+    } else if ((status.repr == wuffs_base__suspension__short_write) ||
+               (status.is_ok() && (dst.meta.wi != buffer.size()))) {
+      result.error_message = ZipReader_BadUncompressedSize;
+      return result;
+    } else if (!status.is_ok()) {
+      result.error_message.assign(status.message());
+      return result;
+    }
+    result.data_ptr = buffer.data();
+    result.data_len = buffer.size();
+  }
+
+  if (!(m_flags & FLAG_IGNORE_CHECKSUM)) {
+    wuffs_base__status status = hasher->initialize(
+        sizeof__wuffs_crc32__ieee_hasher(), WUFFS_VERSION,
+        WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED);
+    if (!status.is_ok()) {
+      result.error_message.assign(status.message());
+      result.data_ptr = nullptr;
+      result.data_len = 0;
+      return result;
+    }
+    uint32_t checksum = hasher->update_u32(wuffs_base__make_slice_u8(
+        const_cast<uint8_t*>(result.data_ptr), result.data_len));
+    if (checksum != e.crc32) {
+      result.error_message = ZipReader_BadChecksum;
+      result.data_ptr = nullptr;
+      result.data_len = 0;
+      return result;
+    }
+  }
+  return result;
+}
+
+}  // namespace wuffs_aux
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) ||
+        // defined(WUFFS_CONFIG__MODULE__AUX__ZIP)
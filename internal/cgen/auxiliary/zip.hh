@@ -0,0 +1,138 @@
+// Copyright 2022 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ---------------- Auxiliary - Zip
+
+#include <vector>
+
+namespace wuffs_aux {
+
+// ZipEntry is one member (a file or a directory) of a Zip archive, as listed
+// in its central directory. name_ptr points into the archive's bytes: it is
+// not NUL-terminated and is only valid for as long as those bytes are.
+struct ZipEntry {
+  const char* name_ptr;
+  size_t name_len;
+  uint64_t local_header_offset;
+  uint64_t compressed_size;
+  uint64_t uncompressed_size;
+  uint32_t crc32;
+  uint16_t flags;
+  uint16_t method;
+};
+
+// ZipExtractResult is the outcome of extracting one ZipEntry. On success,
+// error_message is empty and [data_ptr .. data_ptr + data_len) holds the
+// member's uncompressed contents. For stored (uncompressed) members, data_ptr
+// points into the archive's bytes. For deflated members, it points into the
+// caller-supplied std::vector<uint8_t> buffer.
+struct ZipExtractResult {
+  std::string error_message;
+  const uint8_t* data_ptr;
+  size_t data_len;
+};
+
+// ZipReader reads members of an in-memory Zip archive (including Jar, Docx
+// and Xlsx files, which are Zip archives too), such as one mapped by a
+// sync_io::MmapInput. Zip64 archives are supported. Multi-disk archives,
+// encrypted members and compression methods other than stored (0) and deflate
+// (8) are not.
+//
+// The constructor parses the central directory once, into a compact index
+// whose ZipEntry names point into the archive's bytes, plus a hash table that
+// makes Find an O(1) operation. The archive's bytes are not copied and must
+// outlive the ZipReader.
+//
+// Extracting a stored member is zero-copy. Extracting a deflated member
+// decompresses it into a flat buffer (sized to the member's uncompressed
+// size), with the wuffs_deflate__decoder's set_dst_holds_history option so
+// that no workbuf is needed. Either way, the member's CRC-32 checksum is
+// verified, unless the FLAG_IGNORE_CHECKSUM flag is set.
+//
+// Like ParallelDecodeGif, and unlike the rest of Wuffs, ExtractMany is not
+// single-threaded. After construction, a ZipReader is immutable and its const
+// methods can be called concurrently.
+class ZipReader {
+ public:
+  // These are bits of the flags constructor argument.
+  //
+  // FLAG_IGNORE_CHECKSUM skips verifying the members' CRC-32 checksums.
+  static constexpr uint32_t FLAG_IGNORE_CHECKSUM = 0x01;
+
+  // npos is what Find returns when there is no such member.
+  static constexpr size_t npos = SIZE_MAX;
+
+  ZipReader(const uint8_t* ptr, size_t len, uint32_t flags = 0);
+
+  // error_message is empty if the central directory was parsed successfully.
+  // Otherwise, the ZipReader has no entries.
+  const std::string& error_message() const;
+
+  size_t num_entries() const;
+  const ZipEntry& entry(size_t index) const;
+
+  // Find returns the index of the (first) entry with the given name, or npos.
+  size_t Find(const char* name_ptr, size_t name_len) const;
+  size_t Find(const std::string& name) const;
+
+  // Extract extracts the index'th entry. buffer is only used (and resized)
+  // for deflated members.
+  ZipExtractResult Extract(size_t index, std::vector<uint8_t>& buffer) const;
+
+  // ExtractMany extracts entries[indexes[i]] into results[i], using
+  // buffers[i], for each i in [0 .. n). One member's failure does not stop
+  // the others from being extracted. It returns the number of members that
+  // were extracted successfully.
+  //
+  // The work is spread over up to num_threads (zero means
+  // std::thread::hardware_concurrency()) worker threads, the calling thread
+  // being one of them, each with its own wuffs_deflate__decoder and
+  // wuffs_crc32__ieee_hasher.
+  size_t  //
+  ExtractMany(ZipExtractResult* results,
+              std::vector<uint8_t>* buffers,
+              const size_t* indexes,
+              size_t n,
+              uint32_t num_threads = 0) const;
+
+ private:
+  std::string parse_central_directory();
+  ZipExtractResult extract(wuffs_deflate__decoder* dec,
+                           wuffs_crc32__ieee_hasher* hasher,
+                           size_t index,
+                           std::vector<uint8_t>& buffer) const;
+
+  const uint8_t* m_ptr;
+  const size_t m_len;
+  const uint32_t m_flags;
+  std::string m_error_message;
+  std::vector<ZipEntry> m_entries;
+  // m_hash_table holds (1 + an index into m_entries), or 0 for an empty slot.
+  // Its length is a power of 2 and at least twice m_entries' length.
+  std::vector<uint32_t> m_hash_table;
+
+  // Delete the copy and assign constructors.
+  ZipReader(const ZipReader&) = delete;
+  ZipReader& operator=(const ZipReader&) = delete;
+};
+
+extern const char ZipReader_BadArchive[];
+extern const char ZipReader_BadChecksum[];
+extern const char ZipReader_BadIndex[];
+extern const char ZipReader_BadUncompressedSize[];
+extern const char ZipReader_OutOfMemory[];
+extern const char ZipReader_UnsupportedArchive[];
+extern const char ZipReader_UnsupportedMember[];
+
+}  // namespace wuffs_aux
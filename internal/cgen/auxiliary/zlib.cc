@@ -0,0 +1,1085 @@
+// Copyright 2022 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ---------------- Auxiliary - Zlib
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__AUX__ZLIB)
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace wuffs_aux {
+
+const char ZlibBatchDecoder_DstIsTooShort[] =  //
+    "wuffs_aux::ZlibBatchDecoder: dst is too short";
+const char ZlibBatchDecoder_OutOfMemory[] =  //
+    "wuffs_aux::ZlibBatchDecoder: out of memory";
+const char ZlibBatchDecoder_UnexpectedEndOfFile[] =  //
+    "wuffs_aux::ZlibBatchDecoder: unexpected end of file";
+const char ZlibBatchDecoder_UnsupportedDictionary[] =  //
+    "wuffs_aux::ZlibBatchDecoder: unsupported dictionary";
+
+ZlibBatchDecoder::ZlibBatchDecoder(uint32_t flags)
+    : m_flags(flags), m_dec(wuffs_zlib__decoder::alloc()) {}
+
+size_t  //
+ZlibBatchDecoder::Decode(ZlibBatchResult* results,
+                         const ZlibBatchStream* streams,
+                         size_t n) {
+  size_t num_ok = 0;
+  for (size_t i = 0; i < n; i++) {
+    ZlibBatchResult& result = results[i];
+    result.error_message.clear();
+    result.num_dst_bytes = 0;
+    result.num_src_bytes = 0;
+    if (!m_dec) {
+      result.error_message = ZlibBatchDecoder_OutOfMemory;
+      continue;
+    }
+
+    // Re-initializing with LEAVE_INTERNAL_BUFFERS_UNINITIALIZED resets the
+    // previous stream's state (including any error state) but skips zeroing
+    // the Huffman tables, which are always overwritten before being read.
+    wuffs_base__status status = m_dec->initialize(
+        sizeof__wuffs_zlib__decoder(), WUFFS_VERSION,
+        WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED);
+    if (!status.is_ok()) {
+      result.error_message.assign(status.message());
+      continue;
+    }
+    if (m_flags & FLAG_RAW_DEFLATE) {
+      m_dec->set_quirk_enabled(WUFFS_ZLIB__QUIRK_JUST_RAW_DEFLATE, true);
+    }
+    if (m_flags & FLAG_IGNORE_CHECKSUM) {
+      m_dec->set_quirk_enabled(WUFFS_BASE__QUIRK_IGNORE_CHECKSUM, true);
+    }
+    m_dec->set_dst_holds_history(true);
+
+    const ZlibBatchStream& stream = streams[i];
+    wuffs_base__io_buffer src = wuffs_base__ptr_u8__reader(
+        const_cast<uint8_t*>(stream.src_ptr), stream.src_len, true);
+    wuffs_base__io_buffer dst =
+        wuffs_base__ptr_u8__writer(stream.dst_ptr, stream.dst_len);
+    status = m_dec->transform_io(&dst, &src, wuffs_base__empty_slice_u8());
+    result.num_dst_bytes = dst.meta.wi;
+    result.num_src_bytes = src.meta.ri;
+
+    if (status.is_ok()) {
+      num_ok++;
+    } else if (status.repr == wuffs_base__suspension__short_write) {
+      result.error_message = ZlibBatchDecoder_DstIsTooShort;
+    } else if (status.repr == wuffs_base__suspension__short_read) {
+      result.error_message = ZlibBatchDecoder_UnexpectedEndOfFile;
+    } else if (status.repr == wuffs_zlib__note__dictionary_required) {
+      result.error_message = ZlibBatchDecoder_UnsupportedDictionary;
+    } else {
+      result.error_message.assign(status.message());
+    }
+  }
+  return num_ok;
+}
+
+namespace private_impl {
+
+// ParallelInflateGzipBits reads a deflate stream's bits, least significant bit
+// first, from ptr[.. len), buffering up to 63 bits at a time. Reading past the
+// end gives zero bits, so callers check pos() against (8 * len) to detect a
+// truncated stream.
+struct ParallelInflateGzipBits {
+  ParallelInflateGzipBits(const uint8_t* ptr0, size_t len0, uint64_t pos0)
+      : ptr(ptr0), len(len0), next(0), buf(0), n(0) {
+    set_pos(pos0);
+  }
+
+  const uint8_t* ptr;
+  size_t len;
+  // next is the position (in bytes) just after the n bits held in buf.
+  size_t next;
+  uint64_t buf;
+  uint32_t n;
+
+  // pos returns the position (in bits) of the next bit to read.
+  inline uint64_t pos() const {
+    return (8 * static_cast<uint64_t>(next)) - n;
+  }
+
+  inline void set_pos(uint64_t p) {
+    next = static_cast<size_t>(p >> 3);
+    buf = 0;
+    n = 0;
+    refill();
+    skip(static_cast<uint32_t>(p & 7));
+  }
+
+  // refill tops buf up to at least 56 bits.
+  inline void refill() {
+    if ((next < len) && ((len - next) >= 8)) {
+      buf |= wuffs_base__peek_u64le__no_bounds_check(ptr + next) << n;
+      next += (63 - n) >> 3;
+      n |= 56;
+      return;
+    }
+    for (; n <= 56; n += 8) {
+      uint64_t b = (next < len) ? ptr[next] : 0;
+      buf |= b << n;
+      next++;
+    }
+  }
+
+  // peek returns the next 32 bits (in the low bits).
+  inline uint32_t peek() {
+    if (n < 32) {
+      refill();
+    }
+    return static_cast<uint32_t>(buf);
+  }
+
+  // skip consumes k bits, for k up to 32, after a peek.
+  inline void skip(uint32_t k) {
+    buf >>= k;
+    n -= k;
+  }
+
+  // read returns the next k bits, for k up to 24.
+  inline uint32_t read(uint32_t k) {
+    uint32_t x = peek() & ((1u << k) - 1);
+    skip(k);
+    return x;
+  }
+};
+
+// ParallelInflateGzipHuffman is a canonical Huffman code. Codes of up to
+// fast_bits bits are decoded by table look-up. Longer codes are decoded one bit
+// at a time, as per zlib's contrib/puff/puff.c.
+struct ParallelInflateGzipHuffman {
+  static constexpr uint32_t fast_bits = 10;
+
+  // fast[i] is ((symbol << 4) | length), or zero for a longer code.
+  uint16_t fast[1 << fast_bits];
+  uint16_t counts[16];
+  uint16_t symbols[320];
+
+  // build returns whether lengths[0 .. n) are valid code lengths. An
+  // incomplete code is only valid if allow_incomplete and it has at most one
+  // symbol (as for zlib's distance codes).
+  bool build(const uint8_t* lengths, uint32_t n, bool allow_incomplete) {
+    memset(counts, 0, sizeof(counts));
+    for (uint32_t i = 0; i < n; i++) {
+      counts[lengths[i]]++;
+    }
+    counts[0] = 0;
+    int32_t left = 1;
+    uint32_t max_length = 0;
+    for (uint32_t l = 1; l < 16; l++) {
+      left = (left << 1) - counts[l];
+      if (left < 0) {
+        return false;
+      } else if (counts[l]) {
+        max_length = l;
+      }
+    }
+    if ((left > 0) && (!allow_incomplete || (max_length > 1))) {
+      return false;
+    }
+
+    uint16_t offsets[16];
+    uint32_t next_codes[16];
+    offsets[1] = 0;
+    next_codes[1] = 0;
+    for (uint32_t l = 1; l < 15; l++) {
+      offsets[l + 1] = static_cast<uint16_t>(offsets[l] + counts[l]);
+      next_codes[l + 1] = (next_codes[l] + counts[l]) << 1;
+    }
+
+    memset(fast, 0, sizeof(fast));
+    for (uint32_t sym = 0; sym < n; sym++) {
+      uint32_t l = lengths[sym];
+      if (l == 0) {
+        continue;
+      }
+      symbols[offsets[l]++] = static_cast<uint16_t>(sym);
+      uint32_t code = next_codes[l]++;
+      if (l > fast_bits) {
+        continue;
+      }
+      // Deflate packs Huffman codes most significant bit first.
+      uint32_t reversed = 0;
+      for (uint32_t i = 0; i < l; i++) {
+        reversed |= ((code >> i) & 1) << (l - 1 - i);
+      }
+      for (uint32_t i = reversed; i < (1u << fast_bits); i += (1u << l)) {
+        fast[i] = static_cast<uint16_t>((sym << 4) | l);
+      }
+    }
+    return true;
+  }
+
+  // decode returns the next symbol, or -1 for an invalid code.
+  inline int32_t decode(ParallelInflateGzipBits& bits) const {
+    uint32_t x = bits.peek();
+    uint32_t e = fast[x & ((1u << fast_bits) - 1)];
+    if (e) {
+      bits.skip(e & 15);
+      return static_cast<int32_t>(e >> 4);
+    }
+    int32_t code = 0;
+    int32_t first = 0;
+    int32_t index = 0;
+    for (uint32_t l = 1; l < 16; l++) {
+      code |= static_cast<int32_t>((x >> (l - 1)) & 1);
+      int32_t count = counts[l];
+      if ((code - first) < count) {
+        bits.skip(l);
+        return symbols[index + (code - first)];
+      }
+      index += count;
+      first = (first + count) << 1;
+      code <<= 1;
+    }
+    return -1;
+  }
+};
+
+// ParallelInflateGzipChunk is a unit of work: decoding the deflate blocks from
+// the bit position start_pos up to a block boundary at stop_pos (or, for the
+// last chunk, whose stop_pos is UINT64_MAX, up to and including the final
+// block) into symbols.
+//
+// A symbol below 0x100 is a literal byte. Other than the first chunk, a chunk
+// is decoded without knowing the previous 32 KiB of output (its history), so a
+// back-reference into that history is recorded symbolically, as a symbol at or
+// above 0x8000: (0x10000 - symbol) is how many bytes before the start of the
+// chunk's output the referenced byte is.
+struct ParallelInflateGzipChunk {
+  ParallelInflateGzipChunk()
+      : start_pos(UINT64_MAX), stop_pos(UINT64_MAX), end_pos(0), ok(false) {}
+
+  uint64_t start_pos;
+  uint64_t stop_pos;
+  uint64_t end_pos;
+  bool ok;
+  std::vector<uint16_t> symbols;
+};
+
+// ParallelInflateGzipDecode decodes deflate blocks, appending symbols to out,
+// until (1) the block boundary at stop_pos, (2) max_blocks blocks or (3) the
+// final block, if stop_pos is UINT64_MAX. It returns false for an invalid
+// block, a final block before stop_pos, a back-reference further back than
+// allow_history bytes (zero or 32 KiB) before out's start or for out growing
+// beyond (roughly) max_out symbols.
+static bool  //
+ParallelInflateGzipDecode(ParallelInflateGzipBits& bits,
+                          uint64_t stop_pos,
+                          uint32_t max_blocks,
+                          size_t allow_history,
+                          size_t max_out,
+                          std::vector<uint16_t>& out) {
+  static const uint16_t length_bases[29] = {
+      3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+      31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258,
+  };
+  static const uint8_t length_extras[29] = {
+      0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+      2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0,
+  };
+  static const uint16_t distance_bases[30] = {
+      1,    2,    3,    4,    5,    7,     9,     13,    17,  25,
+      33,   49,   65,   97,   129,  193,   257,   385,   513, 769,
+      1025, 1537, 2049, 3073, 4097, 6145,  8193,  12289, 16385, 24577,
+  };
+  static const uint8_t distance_extras[30] = {
+      0, 0, 0, 0, 1, 1, 2, 2, 3,  3,  4,  4,  5,  5,  6,
+      6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13,
+  };
+  static const uint8_t code_length_order[19] = {
+      16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15,
+  };
+
+  ParallelInflateGzipHuffman lit;
+  ParallelInflateGzipHuffman dist;
+  uint8_t lengths[320];
+  const uint64_t end_pos = 8 * static_cast<uint64_t>(bits.len);
+  size_t n = out.size();
+
+  for (uint32_t num_blocks = 0; true; num_blocks++) {
+    uint64_t pos = bits.pos();
+    if ((pos == stop_pos) || (num_blocks == max_blocks)) {
+      out.resize(n);
+      return true;
+    } else if ((pos > stop_pos) || (pos > end_pos)) {
+      return false;
+    }
+    uint32_t header = bits.read(3);
+    uint32_t block_type = header >> 1;
+
+    if (block_type == 0) {  // Stored.
+      size_t i = static_cast<size_t>((bits.pos() + 7) >> 3);
+      if ((i > bits.len) || ((bits.len - i) < 4)) {
+        return false;
+      }
+      uint32_t length =
+          wuffs_base__peek_u16le__no_bounds_check(bits.ptr + i + 0);
+      uint32_t nlength =
+          wuffs_base__peek_u16le__no_bounds_check(bits.ptr + i + 2);
+      i += 4;
+      if ((length != (0xFFFF & ~nlength)) || ((bits.len - i) < length) ||
+          (n > max_out) || ((max_out - n) < length)) {
+        return false;
+      } else if ((out.size() - n) < length) {
+        out.resize(2 * out.size() + length);
+      }
+      for (uint32_t j = 0; j < length; j++) {
+        out[n + j] = bits.ptr[i + j];
+      }
+      n += length;
+      bits.set_pos(8 * static_cast<uint64_t>(i + length));
+
+    } else if (block_type == 3) {
+      return false;
+
+    } else {
+      if (block_type == 1) {  // Fixed Huffman.
+        memset(lengths + 0, 8, 144);
+        memset(lengths + 144, 9, 112);
+        memset(lengths + 256, 7, 24);
+        memset(lengths + 280, 8, 8);
+        memset(lengths + 288, 5, 32);
+        lit.build(lengths + 0, 288, false);
+        dist.build(lengths + 288, 32, false);
+
+      } else {  // Dynamic Huffman.
+        uint32_t num_lit = 257 + bits.read(5);
+        uint32_t num_dist = 1 + bits.read(5);
+        uint32_t num_code_lengths = 4 + bits.read(4);
+        if ((num_lit > 286) || (num_dist > 30)) {
+          return false;
+        }
+        // The code length code is only needed until lit and dist are built,
+        // so it borrows dist.
+        uint8_t code_lengths[19] = {0};
+        for (uint32_t i = 0; i < num_code_lengths; i++) {
+          code_lengths[code_length_order[i]] =
+              static_cast<uint8_t>(bits.read(3));
+        }
+        if (!dist.build(code_lengths, 19, false)) {
+          return false;
+        }
+        uint32_t num_lengths = num_lit + num_dist;
+        for (uint32_t i = 0; i < num_lengths;) {
+          int32_t sym = dist.decode(bits);
+          if (sym < 0) {
+            return false;
+          } else if (sym < 16) {
+            lengths[i++] = static_cast<uint8_t>(sym);
+            continue;
+          }
+          uint8_t repeated = 0;
+          uint32_t count = 0;
+          if (sym == 16) {
+            if (i == 0) {
+              return false;
+            }
+            repeated = lengths[i - 1];
+            count = 3 + bits.read(2);
+          } else if (sym == 17) {
+            count = 3 + bits.read(3);
+          } else {
+            count = 11 + bits.read(7);
+          }
+          if ((num_lengths - i) < count) {
+            return false;
+          }
+          memset(lengths + i, repeated, count);
+          i += count;
+        }
+        if ((lengths[256] == 0) || !lit.build(lengths, num_lit, true) ||
+            !dist.build(lengths + num_lit, num_dist, true)) {
+          return false;
+        }
+      }
+
+      while (true) {
+        // Keep room for the longest (258 symbol) copy, so that the literal
+        // and copy paths below need no further bounds checks.
+        if ((out.size() - n) < 258) {
+          if (out.size() >= max_out) {
+            return false;
+          }
+          out.resize(2 * out.size() + 258);
+        }
+        if (bits.pos() > end_pos) {
+          return false;
+        }
+        int32_t sym = lit.decode(bits);
+        if (sym < 256) {
+          if (sym < 0) {
+            return false;
+          }
+          out[n++] = static_cast<uint16_t>(sym);
+          continue;
+        } else if (sym == 256) {
+          break;
+        } else if (sym > 285) {
+          return false;
+        }
+        uint32_t length = length_bases[sym - 257] +
+                          bits.read(length_extras[sym - 257]);
+        int32_t dsym = dist.decode(bits);
+        if ((dsym < 0) || (dsym >= 30)) {
+          return false;
+        }
+        size_t distance =
+            distance_bases[dsym] + bits.read(distance_extras[dsym]);
+        uint16_t* p = out.data() + n;
+        if (distance > n) {
+          if ((distance - n) > allow_history) {
+            return false;
+          }
+          for (uint32_t j = 0; j < length; j++) {
+            size_t k = n + j;
+            p[j] = (k < distance)
+                       ? static_cast<uint16_t>(0x10000 - distance + k)
+                       : out[k - distance];
+          }
+        } else if (length <= distance) {
+          memcpy(p, p - distance, length * sizeof(uint16_t));
+        } else {
+          // The source and destination overlap, so copy one symbol at a time.
+          const uint16_t* q = p - distance;
+          for (uint32_t j = 0; j < length; j++) {
+            p[j] = q[j];
+          }
+        }
+        n += length;
+      }
+    }
+
+    if (header & 1) {  // BFINAL.
+      out.resize(n);
+      return stop_pos == UINT64_MAX;
+    }
+  }
+}
+
+// ParallelInflateGzipFindStart returns the first bit position in [min_pos ..
+// max_pos) that looks like the start of a non-final, dynamic Huffman deflate
+// block, or UINT64_MAX if there is no such position.
+//
+// Looking like a block start means that the block's header has valid, complete
+// Huffman codes and that the whole block then decodes cleanly, followed by
+// something that could be another block header. That rules out almost all
+// false positives. The rare remaining ones are caught later, as the previous
+// chunk then does not end exactly at this position.
+static uint64_t  //
+ParallelInflateGzipFindStart(const uint8_t* ptr,
+                             size_t len,
+                             uint64_t min_pos,
+                             uint64_t max_pos) {
+  // Real encoders (e.g. zlib) flush their blocks long before this many bytes
+  // of output. Trial decodes are abandoned after it.
+  static constexpr size_t max_block_size = 8388608;
+
+  std::vector<uint16_t> scratch;
+  ParallelInflateGzipBits bits(ptr, len, min_pos);
+  for (uint64_t pos = min_pos; pos < max_pos; pos++) {
+    bits.set_pos(pos);
+    uint32_t x = bits.peek();
+    // Look for BFINAL = 0, BTYPE = 2, HLIT <= 29 and HDIST <= 29.
+    if (((x & 7) != 4) || (((x >> 3) & 31) > 29) || (((x >> 8) & 31) > 29)) {
+      continue;
+    }
+    scratch.clear();
+    if (ParallelInflateGzipDecode(bits, UINT64_MAX, 1, 32768, max_block_size,
+                                  scratch) &&
+        (bits.pos() <= (8 * static_cast<uint64_t>(len))) &&
+        (((bits.peek() >> 1) & 3) != 3)) {
+      return pos;
+    }
+  }
+  return UINT64_MAX;
+}
+
+static void  //
+ParallelInflateGzipFindChunkStart(const uint8_t* ptr,
+                                  size_t len,
+                                  uint64_t max_pos,
+                                  ParallelInflateGzipChunk* chunk) {
+  chunk->start_pos =
+      ParallelInflateGzipFindStart(ptr, len, chunk->start_pos, max_pos);
+}
+
+static void  //
+ParallelInflateGzipDecodeChunk(const uint8_t* ptr,
+                               size_t len,
+                               size_t allow_history,
+                               ParallelInflateGzipChunk* chunk) {
+  // Deflate's maximum compression ratio is a little over 1032:1.
+  uint64_t max_pos = 8 * static_cast<uint64_t>(len);
+  if (max_pos > chunk->stop_pos) {
+    max_pos = chunk->stop_pos;
+  }
+  uint64_t src_len = ((max_pos - chunk->start_pos) / 8) + 1;
+  size_t max_out = (src_len < (SIZE_MAX / 2048)) ? (2048 * src_len) : SIZE_MAX;
+
+  ParallelInflateGzipBits bits(ptr, len, chunk->start_pos);
+  chunk->symbols.reserve(static_cast<size_t>(4 * src_len));
+  chunk->ok = ParallelInflateGzipDecode(bits, chunk->stop_pos, UINT32_MAX,
+                                        allow_history, max_out, chunk->symbols);
+  chunk->end_pos = bits.pos();
+}
+
+// ParallelInflateGzipResolve converts chunk symbols [i_min .. i_max) to bytes,
+// writing to dst[offset + i] for each i. dst[.. offset] holds the preceding
+// chunks' (already resolved) output.
+static bool  //
+ParallelInflateGzipResolve(uint8_t* dst,
+                           size_t offset,
+                           const uint16_t* symbols,
+                           size_t i_min,
+                           size_t i_max) {
+  uint8_t* d = dst + offset;
+  for (size_t i = i_min; i < i_max; i++) {
+    uint32_t s = symbols[i];
+    if (s < 0x100) {
+      d[i] = static_cast<uint8_t>(s);
+      continue;
+    }
+    size_t k = 0x10000 - s;
+    if (k > offset) {
+      return false;
+    }
+    d[i] = d[-static_cast<ptrdiff_t>(k)];
+  }
+  return true;
+}
+
+static void  //
+ParallelInflateGzipResolveHead(uint8_t* dst,
+                               size_t offset,
+                               const ParallelInflateGzipChunk* chunk,
+                               bool* ok) {
+  size_t n = chunk->symbols.size();
+  *ok = (n <= 32768) || ParallelInflateGzipResolve(dst, offset,
+                                                   chunk->symbols.data(), 0,
+                                                   n - 32768);
+}
+
+// GzipTrailerSizeHint returns the decompressed length (modulo 2**32) from the
+// trailer of the gzip file ptr[.. len). It is only a hint: the trailer might
+// be truncated or bogus. To limit the damage (the memory allocated) for a
+// bogus hint, it is capped by deflate's maximum compression ratio, a little
+// over 1032:1.
+static uint64_t  //
+GzipTrailerSizeHint(const uint8_t* ptr, size_t len) {
+  // A gzip file is at least 18 bytes long: a 10 byte header, an (empty)
+  // deflate stream and an 8 byte trailer.
+  if (len < 18) {
+    return 0;
+  }
+  uint64_t isize = wuffs_base__peek_u32le__no_bounds_check(ptr + len - 4);
+  uint64_t max_isize = 1033 * static_cast<uint64_t>(len);
+  return (isize < max_isize) ? isize : max_isize;
+}
+
+static std::string  //
+ParallelInflateGzipSequentially(std::vector<uint8_t>& dst,
+                                const uint8_t* ptr,
+                                size_t len) {
+  wuffs_gzip__decoder::unique_ptr dec = wuffs_gzip__decoder::alloc();
+  if (!dec) {
+    return "wuffs_aux::ParallelInflateGzip: out of memory";
+  }
+  std::vector<uint8_t> workbuf(dec->workbuf_len().max_incl);
+  IOBuffer src =
+      wuffs_base__ptr_u8__reader(const_cast<uint8_t*>(ptr), len, true);
+  size_t wi = dst.size();
+  dst.resize(wi + static_cast<size_t>(GzipTrailerSizeHint(ptr, len)));
+  while (true) {
+    // The decoder keeps its own copy of the history, so it is OK for the dst
+    // buffer to move when resized.
+    IOBuffer buf = wuffs_base__ptr_u8__writer(dst.data(), dst.size());
+    buf.meta.wi = wi;
+    wuffs_base__status status = dec->transform_io(
+        &buf, &src, wuffs_base__make_slice_u8(workbuf.data(), workbuf.size()));
+    wi = buf.meta.wi;
+    if (status.repr == wuffs_base__suspension__short_write) {
+      dst.resize((2 * dst.size()) + 65536);
+      continue;
+    }
+    dst.resize(wi);
+    if (status.is_ok()) {
+      return "";
+    } else if (status.repr == wuffs_base__suspension__short_read) {
+      return "wuffs_aux::ParallelInflateGzip: unexpected end of file";
+    }
+    return status.message();
+  }
+}
+
+// GzipHeaderLength returns the length of the gzip header (RFC 1952) at the
+// start of ptr[.. len), or zero if it is invalid.
+static size_t  //
+GzipHeaderLength(const uint8_t* ptr, size_t len) {
+  if ((len < 10) || (ptr[0] != 0x1F) || (ptr[1] != 0x8B) || (ptr[2] != 0x08) ||
+      (ptr[3] & 0xE0)) {
+    return 0;
+  }
+  uint8_t flags = ptr[3];
+  size_t i = 10;
+  if (flags & 0x04) {  // FEXTRA.
+    if ((len - i) < 2) {
+      return 0;
+    }
+    size_t xlen = wuffs_base__peek_u16le__no_bounds_check(ptr + i);
+    i += 2;
+    if ((len - i) < xlen) {
+      return 0;
+    }
+    i += xlen;
+  }
+  for (uint8_t flag = 0x08; flag <= 0x10; flag <<= 1) {  // FNAME, FCOMMENT.
+    if (flags & flag) {
+      do {
+        if (i >= len) {
+          return 0;
+        }
+      } while (ptr[i++] != 0);
+    }
+  }
+  if (flags & 0x02) {  // FHCRC.
+    if ((len - i) < 2) {
+      return 0;
+    }
+    i += 2;
+  }
+  return i;
+}
+
+// GzipBgzfMemberLength returns the length of the BGZF member at the start of
+// ptr[.. len), whose (valid) gzip header is ptr[.. header_len), or zero if it
+// is not a BGZF member. BGZF (SAMv1 section 4.1) puts BSIZE, the member
+// length minus 1, in a "BC" extra subfield.
+static size_t  //
+GzipBgzfMemberLength(const uint8_t* ptr, size_t len, size_t header_len) {
+  if (!(ptr[3] & 0x04)) {  // FEXTRA.
+    return 0;
+  }
+  size_t xlen = wuffs_base__peek_u16le__no_bounds_check(ptr + 10);
+  const uint8_t* x = ptr + 12;
+  while (xlen >= 4) {
+    size_t slen = wuffs_base__peek_u16le__no_bounds_check(x + 2);
+    if ((xlen - 4) < slen) {
+      break;
+    } else if ((x[0] == 'B') && (x[1] == 'C') && (slen == 2)) {
+      size_t n = 1 + wuffs_base__peek_u16le__no_bounds_check(x + 4);
+      return ((n >= (header_len + 8)) && (n <= len)) ? n : 0;
+    }
+    x += 4 + slen;
+    xlen -= 4 + slen;
+  }
+  return 0;
+}
+
+// GzipScanMemberLength returns the length of the member at the start of
+// ptr[.. len), whose (valid) gzip header is ptr[.. header_len), by scanning
+// for the next member: a valid gzip header preceded by a plausible trailer,
+// whose ISIZE is within deflate's maximum compression ratio. It is only a
+// guess: the deflate data could contain such bytes. If there is no next
+// member, the member runs to the end of ptr[.. len).
+static size_t  //
+GzipScanMemberLength(const uint8_t* ptr, size_t len, size_t header_len) {
+  // The shortest deflate stream is 2 bytes long: an empty fixed Huffman block.
+  for (size_t i = header_len + 2 + 8; i < len; i++) {
+    const void* p = memchr(ptr + i, 0x1F, len - i);
+    if (!p) {
+      break;
+    }
+    i = static_cast<size_t>(static_cast<const uint8_t*>(p) - ptr);
+    uint64_t isize = wuffs_base__peek_u32le__no_bounds_check(ptr + i - 4);
+    if ((isize <= (1033 * static_cast<uint64_t>(i))) &&
+        GzipHeaderLength(ptr + i, len - i)) {
+      return i;
+    }
+  }
+  return len;
+}
+
+// ParallelInflateGzipMembersJob is the state shared by the
+// ParallelInflateGzipMembers worker threads.
+struct ParallelInflateGzipMembersJob {
+  uint8_t* dst_ptr;
+  const uint8_t* src_ptr;
+  const std::vector<GzipMember>* members;
+  std::atomic<size_t> next_member;
+  std::atomic<bool> failed;
+};
+
+// ParallelInflateGzipMembersWork decodes members, each into its own slice of
+// dst, until there are none left or any worker fails.
+static void  //
+ParallelInflateGzipMembersWork(ParallelInflateGzipMembersJob* job) {
+  wuffs_gzip__decoder::unique_ptr dec = wuffs_gzip__decoder::alloc();
+  if (!dec) {
+    job->failed = true;
+    return;
+  }
+  std::vector<uint8_t> workbuf(dec->workbuf_len().max_incl);
+  while (!job->failed) {
+    size_t i = job->next_member++;
+    if (i >= job->members->size()) {
+      return;
+    }
+    // Each successful transform_io call decodes exactly one member, leaving
+    // dec ready for the next one, from any other position.
+    const GzipMember& m = (*job->members)[i];
+    IOBuffer dst = wuffs_base__ptr_u8__writer(
+        job->dst_ptr + static_cast<size_t>(m.dst_offset), m.isize);
+    IOBuffer src = wuffs_base__ptr_u8__reader(
+        const_cast<uint8_t*>(job->src_ptr + m.src_offset), m.src_length, true);
+    wuffs_base__status status = dec->transform_io(
+        &dst, &src, wuffs_base__make_slice_u8(workbuf.data(), workbuf.size()));
+    if (!status.is_ok() || (dst.meta.wi != m.isize) ||
+        (src.meta.ri != m.src_length)) {
+      job->failed = true;
+      return;
+    }
+  }
+}
+
+static ParallelInflateGzipMembersResult  //
+ParallelInflateGzipMembersSequentially(uint8_t* dst_ptr,
+                                       size_t dst_len,
+                                       const uint8_t* ptr,
+                                       size_t len) {
+  wuffs_gzip__decoder::unique_ptr dec = wuffs_gzip__decoder::alloc();
+  wuffs_crc32__ieee_hasher::unique_ptr hasher =
+      wuffs_crc32__ieee_hasher::alloc();
+  if (!dec || !hasher) {
+    return {"wuffs_aux::ParallelInflateGzipMembers: out of memory", 0, 0};
+  }
+  std::vector<uint8_t> workbuf(dec->workbuf_len().max_incl);
+  IOBuffer dst = wuffs_base__ptr_u8__writer(dst_ptr, dst_len);
+  IOBuffer src =
+      wuffs_base__ptr_u8__reader(const_cast<uint8_t*>(ptr), len, true);
+  do {
+    wuffs_base__status status = dec->transform_io(
+        &dst, &src, wuffs_base__make_slice_u8(workbuf.data(), workbuf.size()));
+    if (status.repr == wuffs_base__suspension__short_write) {
+      return {"wuffs_aux::ParallelInflateGzipMembers: dst is too short", 0, 0};
+    } else if (status.repr == wuffs_base__suspension__short_read) {
+      return {"wuffs_aux::ParallelInflateGzipMembers: unexpected end of file",
+              0, 0};
+    } else if (!status.is_ok()) {
+      return {status.message(), 0, 0};
+    }
+  } while (src.meta.ri < src.meta.wi);
+  return {"", dst.meta.wi,
+          hasher->update_u32(wuffs_base__make_slice_u8(dst_ptr, dst.meta.wi))};
+}
+
+}  // namespace private_impl
+
+std::string  //
+DecodeGzip(sync_io::DynIOBuffer& dst, const uint8_t* ptr, size_t len) {
+  wuffs_gzip__decoder::unique_ptr dec = wuffs_gzip__decoder::alloc();
+  if (!dec) {
+    return "wuffs_aux::DecodeGzip: out of memory";
+  }
+  std::vector<uint8_t> workbuf(dec->workbuf_len().max_incl);
+
+  dst.set_size_hint(dst.m_buf.meta.wi +
+                    private_impl::GzipTrailerSizeHint(ptr, len));
+
+  IOBuffer src =
+      wuffs_base__ptr_u8__reader(const_cast<uint8_t*>(ptr), len, true);
+  while (true) {
+    wuffs_base__status status = dec->transform_io(
+        &dst.m_buf, &src,
+        wuffs_base__make_slice_u8(workbuf.data(), workbuf.size()));
+    if (status.is_ok()) {
+      return "";
+    } else if (status.repr == wuffs_base__suspension__short_read) {
+      return "wuffs_aux::DecodeGzip: unexpected end of file";
+    } else if (status.repr != wuffs_base__suspension__short_write) {
+      return status.message();
+    }
+    switch (dst.grow(dst.m_buf.data.len + 1)) {
+      case sync_io::DynIOBuffer::GrowResult::OK:
+        break;
+      case sync_io::DynIOBuffer::GrowResult::FailedMaxInclExceeded:
+        return "wuffs_aux::DecodeGzip: max_incl exceeded";
+      case sync_io::DynIOBuffer::GrowResult::FailedOutOfMemory:
+        return "wuffs_aux::DecodeGzip: out of memory";
+    }
+  }
+}
+
+std::string  //
+ParallelInflateGzip(std::vector<uint8_t>& dst,
+                    const uint8_t* ptr,
+                    size_t len,
+                    uint32_t num_threads) {
+  // Chunks that are too small aren't worth a thread. Finding where a chunk
+  // starts costs a trial decode per candidate bit position, so the search
+  // gives up (merging the chunk into the previous one) after max_search_size
+  // bytes. Real encoders (e.g. zlib) emit blocks far more often than that,
+  // unless they are stored (uncompressed) blocks, which aren't searched for.
+  static constexpr size_t min_chunk_size = 1048576;
+  static constexpr size_t max_search_size = 262144;
+
+  if (num_threads == 0) {
+    num_threads = std::thread::hardware_concurrency();
+    if (num_threads == 0) {
+      num_threads = 1;
+    }
+  }
+  size_t deflate_min = private_impl::GzipHeaderLength(ptr, len);
+  if ((deflate_min == 0) || ((len - deflate_min) < 8)) {
+    return private_impl::ParallelInflateGzipSequentially(dst, ptr, len);
+  }
+  size_t deflate_max = len - 8;
+  size_t deflate_len = deflate_max - deflate_min;
+  size_t n = deflate_len / min_chunk_size;
+  if (n > num_threads) {
+    n = num_threads;
+  }
+  if (n < 2) {
+    return private_impl::ParallelInflateGzipSequentially(dst, ptr, len);
+  }
+
+  // Phase 1: find where each chunk (other than the first) starts, in parallel.
+  // A chunk that finds no block start is merged into the previous chunk.
+  std::vector<private_impl::ParallelInflateGzipChunk> chunks(n);
+  chunks[0].start_pos = 8 * static_cast<uint64_t>(deflate_min);
+  {
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < n; i++) {
+      chunks[i].start_pos =
+          8 * static_cast<uint64_t>(deflate_min + (i * (deflate_len / n)));
+      uint64_t max_pos =
+          8 * static_cast<uint64_t>(deflate_min + (i * (deflate_len / n)) +
+                                    max_search_size);
+      threads.emplace_back(private_impl::ParallelInflateGzipFindChunkStart,
+                           ptr, deflate_max, max_pos, &chunks[i]);
+    }
+    for (auto& t : threads) {
+      t.join();
+    }
+  }
+  size_t num_found = 1;
+  for (size_t i = 1; i < n; i++) {
+    if (chunks[i].start_pos != UINT64_MAX) {
+      chunks[num_found++].start_pos = chunks[i].start_pos;
+    }
+  }
+  chunks.resize(num_found);
+  if (chunks.size() < 2) {
+    return private_impl::ParallelInflateGzipSequentially(dst, ptr, len);
+  }
+  for (size_t i = 0; (i + 1) < chunks.size(); i++) {
+    chunks[i].stop_pos = chunks[i + 1].start_pos;
+  }
+
+  // Phase 2: decode each chunk into symbols, in parallel.
+  {
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < chunks.size(); i++) {
+      threads.emplace_back(private_impl::ParallelInflateGzipDecodeChunk, ptr,
+                           deflate_max, 32768, &chunks[i]);
+    }
+    private_impl::ParallelInflateGzipDecodeChunk(ptr, deflate_max, 0,
+                                                 &chunks[0]);
+    for (auto& t : threads) {
+      t.join();
+    }
+  }
+
+  // Any failure could be due to a wrong guess (a chunk starting at a false
+  // block boundary) instead of bad data, so retry single-threaded. So does a
+  // stream that does not end exactly at the gzip trailer.
+  bool speculation_failed =
+      ((chunks.back().end_pos + 7) / 8) != static_cast<uint64_t>(deflate_max);
+  size_t total = 0;
+  std::vector<size_t> offsets;
+  for (auto& chunk : chunks) {
+    speculation_failed = speculation_failed || !chunk.ok;
+    offsets.push_back(total);
+    total += chunk.symbols.size();
+  }
+  if (speculation_failed) {
+    chunks.clear();
+    return private_impl::ParallelInflateGzipSequentially(dst, ptr, len);
+  }
+
+  // Phase 3: resolve each chunk's last 32 KiB of symbols, in order, as the
+  // next chunk's history.
+  size_t base = dst.size();
+  dst.resize(base + total);
+  uint8_t* d = dst.data() + base;
+  for (size_t i = 0; i < chunks.size(); i++) {
+    size_t num_symbols = chunks[i].symbols.size();
+    size_t i_min = (num_symbols > 32768) ? (num_symbols - 32768) : 0;
+    speculation_failed =
+        speculation_failed ||
+        !private_impl::ParallelInflateGzipResolve(
+            d, offsets[i], chunks[i].symbols.data(), i_min, num_symbols);
+  }
+
+  // Phase 4: resolve the rest of each chunk, in parallel. A chunk's history is
+  // entirely within the previous chunks' last 32 KiB, already resolved.
+  if (!speculation_failed) {
+    std::unique_ptr<bool[]> oks(new bool[chunks.size()]);
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < chunks.size(); i++) {
+      threads.emplace_back(private_impl::ParallelInflateGzipResolveHead, d,
+                           offsets[i], &chunks[i], &oks[i]);
+    }
+    private_impl::ParallelInflateGzipResolveHead(d, offsets[0], &chunks[0],
+                                                 &oks[0]);
+    for (auto& t : threads) {
+      t.join();
+    }
+    for (size_t i = 0; i < chunks.size(); i++) {
+      speculation_failed = speculation_failed || !oks[i];
+    }
+  }
+  chunks.clear();
+
+  // Verify the CRC-32 checksum and the length (modulo 2**32) from the gzip
+  // trailer. On mismatch, the sequential decoder also reports the error.
+  if (!speculation_failed) {
+    wuffs_crc32__ieee_hasher::unique_ptr hasher =
+        wuffs_crc32__ieee_hasher::alloc();
+    if (!hasher) {
+      return "wuffs_aux::ParallelInflateGzip: out of memory";
+    }
+    uint32_t checksum =
+        hasher->update_u32(wuffs_base__make_slice_u8(d, total));
+    if ((checksum ==
+         wuffs_base__peek_u32le__no_bounds_check(ptr + deflate_max)) &&
+        (static_cast<uint32_t>(total) ==
+         wuffs_base__peek_u32le__no_bounds_check(ptr + deflate_max + 4))) {
+      return "";
+    }
+  }
+  dst.resize(base);
+  return private_impl::ParallelInflateGzipSequentially(dst, ptr, len);
+}
+
+std::string  //
+IndexGzipMembers(std::vector<GzipMember>& members,
+                 const uint8_t* ptr,
+                 size_t len) {
+  members.clear();
+  uint64_t dst_offset = 0;
+  size_t pos = 0;
+  do {
+    const uint8_t* p = ptr + pos;
+    size_t n = len - pos;
+    size_t header_len = private_impl::GzipHeaderLength(p, n);
+    if (header_len == 0) {
+      return "wuffs_aux::IndexGzipMembers: bad header";
+    }
+    // A BGZF member is followed by another member or by the end of the file.
+    // If not, its BSIZE is bogus and we scan instead.
+    size_t member_len = private_impl::GzipBgzfMemberLength(p, n, header_len);
+    if ((member_len > 0) && (member_len < n) &&
+        !private_impl::GzipHeaderLength(p + member_len, n - member_len)) {
+      member_len = 0;
+    }
+    if (member_len == 0) {
+      member_len = private_impl::GzipScanMemberLength(p, n, header_len);
+      if ((member_len - header_len) < 8) {
+        return "wuffs_aux::IndexGzipMembers: unexpected end of file";
+      }
+    }
+    GzipMember m;
+    m.src_offset = pos;
+    m.src_length = member_len;
+    m.dst_offset = dst_offset;
+    m.crc32 = wuffs_base__peek_u32le__no_bounds_check(p + member_len - 8);
+    m.isize = wuffs_base__peek_u32le__no_bounds_check(p + member_len - 4);
+    members.push_back(m);
+    dst_offset += m.isize;
+    pos += member_len;
+  } while (pos < len);
+  return "";
+}
+
+ParallelInflateGzipMembersResult  //
+ParallelInflateGzipMembers(uint8_t* dst_ptr,
+                           size_t dst_len,
+                           const uint8_t* ptr,
+                           size_t len,
+                           uint32_t num_threads) {
+  if (num_threads == 0) {
+    num_threads = std::thread::hardware_concurrency();
+    if (num_threads == 0) {
+      num_threads = 1;
+    }
+  }
+
+  // An index that is bad or that doesn't fit in dst could be due to a wrong
+  // guess (a false member boundary, or ISIZE overflow) instead of bad data.
+  // Either way, decoding sequentially either succeeds or reports the error.
+  std::vector<GzipMember> members;
+  if (!IndexGzipMembers(members, ptr, len).empty() ||
+      ((members.back().dst_offset + members.back().isize) > dst_len)) {
+    return private_impl::ParallelInflateGzipMembersSequentially(
+        dst_ptr, dst_len, ptr, len);
+  }
+  size_t total =
+      static_cast<size_t>(members.back().dst_offset + members.back().isize);
+
+  private_impl::ParallelInflateGzipMembersJob job;
+  job.dst_ptr = dst_ptr;
+  job.src_ptr = ptr;
+  job.members = &members;
+  job.next_member = 0;
+  job.failed = false;
+  {
+    size_t n = (members.size() < num_threads) ? members.size() : num_threads;
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < n; i++) {
+      threads.emplace_back(private_impl::ParallelInflateGzipMembersWork, &job);
+    }
+    private_impl::ParallelInflateGzipMembersWork(&job);
+    for (auto& t : threads) {
+      t.join();
+    }
+  }
+  if (job.failed) {
+    return private_impl::ParallelInflateGzipMembersSequentially(
+        dst_ptr, dst_len, ptr, len);
+  }
+
+  // Each member's decoder verified its CRC-32 checksum, so combining them
+  // gives the whole output's checksum without hashing it again.
+  wuffs_crc32__ieee_hasher::unique_ptr hasher =
+      wuffs_crc32__ieee_hasher::alloc();
+  if (!hasher) {
+    return {"wuffs_aux::ParallelInflateGzipMembers: out of memory", 0, 0};
+  }
+  uint32_t checksum = 0;
+  for (const auto& m : members) {
+    checksum = hasher->combine_u32(m.crc32, m.isize);
+  }
+  return {"", total, checksum};
+}
+
+}  // namespace wuffs_aux
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) ||
+        // defined(WUFFS_CONFIG__MODULE__AUX__ZLIB)
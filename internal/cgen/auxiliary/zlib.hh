@@ -0,0 +1,219 @@
+// Copyright 2022 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ---------------- Auxiliary - Zlib
+
+#include <vector>
+
+namespace wuffs_aux {
+
+// ZlibBatchStream is one compressed input of a ZlibBatchDecoder::Decode call,
+// and where to write its decompressed output.
+struct ZlibBatchStream {
+  const uint8_t* src_ptr;
+  size_t src_len;
+  uint8_t* dst_ptr;
+  size_t dst_len;
+};
+
+// ZlibBatchResult is the outcome of decoding one ZlibBatchStream. On success,
+// error_message is empty and num_dst_bytes is the decompressed length. On
+// failure, num_dst_bytes is how many of the dst bytes were written before the
+// error, which may be partially valid output (e.g. for DstIsTooShort).
+//
+// num_src_bytes is how many of the src bytes were consumed. On success, any
+// src bytes after the end of the compressed stream are ignored.
+struct ZlibBatchResult {
+  std::string error_message;
+  size_t num_dst_bytes;
+  size_t num_src_bytes;
+};
+
+// ZlibBatchDecoder decodes many small, independent zlib (or, with the
+// FLAG_RAW_DEFLATE flag, raw deflate) streams, each held entirely in memory
+// and decompressed into its own flat dst buffer.
+//
+// Calling a low-level decoder's initialize function (without the
+// WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED option) for every
+// small stream can cost more than actually decoding it. A ZlibBatchDecoder
+// instead keeps one warm wuffs_zlib__decoder and, between streams, only resets
+// the decoder's (small) state fields, not its (large) Huffman tables. It also
+// needs no workbuf: each stream's back-references are resolved directly from
+// its dst buffer, as per the wuffs_zlib__decoder's set_dst_holds_history
+// method.
+//
+// A ZlibBatchDecoder can be re-used for multiple Decode calls but it is not
+// thread-safe: concurrent decoding needs one ZlibBatchDecoder per thread.
+// Preset dictionaries are not supported.
+class ZlibBatchDecoder {
+ public:
+  // These are bits of the flags constructor argument.
+  //
+  // FLAG_RAW_DEFLATE decodes raw deflate (RFC 1951) streams instead of
+  // zlib-wrapped (RFC 1950) ones.
+  //
+  // FLAG_IGNORE_CHECKSUM skips verifying the zlib streams' Adler-32 checksums,
+  // as per WUFFS_BASE__QUIRK_IGNORE_CHECKSUM.
+  static constexpr uint32_t FLAG_RAW_DEFLATE = 0x01;
+  static constexpr uint32_t FLAG_IGNORE_CHECKSUM = 0x02;
+
+  explicit ZlibBatchDecoder(uint32_t flags = 0);
+
+  // Decode decodes streams[i] into its dst buffer, recording the outcome in
+  // results[i], for each i in [0 .. n). One stream's failure does not stop
+  // the others from being decoded. It returns the number of streams that were
+  // decoded successfully (so that, if it returns n, there is no need to check
+  // each result's error_message).
+  size_t  //
+  Decode(ZlibBatchResult* results, const ZlibBatchStream* streams, size_t n);
+
+ private:
+  const uint32_t m_flags;
+  wuffs_zlib__decoder::unique_ptr m_dec;
+
+  // Delete the copy and assign constructors.
+  ZlibBatchDecoder(const ZlibBatchDecoder&) = delete;
+  ZlibBatchDecoder& operator=(const ZlibBatchDecoder&) = delete;
+};
+
+extern const char ZlibBatchDecoder_DstIsTooShort[];
+extern const char ZlibBatchDecoder_OutOfMemory[];
+extern const char ZlibBatchDecoder_UnexpectedEndOfFile[];
+extern const char ZlibBatchDecoder_UnsupportedDictionary[];
+
+
+// DecodeGzip decompresses an in-memory gzip file's first member, appending it
+// to dst (after dst.m_buf.meta.wi). dst's max_incl bounds the total length.
+//
+// A gzip file's last 4 bytes (its ISIZE field) are the decompressed length,
+// modulo 2**32. DecodeGzip passes that to dst.set_size_hint, so that, for a
+// single-member file under 4 GiB, dst's byte array is allocated just once, at
+// exactly the right size, instead of being repeatedly doubled and copied. The
+// ISIZE is only trusted as a hint: if it is wrong (e.g. for a multi-member or
+// a 4 GiB or larger file), dst grows as usual and the decoder still verifies
+// the actual length and CRC-32 checksum. A bogus ISIZE can cost memory, but
+// no more than deflate's maximum compression ratio (about 1032:1) times len.
+//
+// It returns an empty string on success or an error message otherwise.
+std::string  //
+DecodeGzip(sync_io::DynIOBuffer& dst, const uint8_t* ptr, size_t len);
+
+// ParallelInflateGzip decompresses an in-memory gzip file's first member,
+// appending it to dst.
+//
+// It is experimental. Unlike the rest of Wuffs, it is not single-threaded.
+// Even without flush points (see ParallelInflatePngIdat), a single deflate
+// stream can be decompressed in parallel, as per "pugz: a parallel
+// decompressor for gzip" (Kerbiriou and Chikhi, 2019). The compressed bytes
+// are split into up to num_threads chunks (zero means
+// std::thread::hardware_concurrency()). Each chunk (other than the first)
+// looks for a plausible block boundary and decodes from there without knowing
+// the previous 32 KiB of output, recording back-references into that unknown
+// history symbolically. Once each preceding chunk's last 32 KiB is known, the
+// symbols are resolved to bytes, again in parallel.
+//
+// Decoding with unknown history uses its own (simpler, slower) deflate decoder,
+// as wuffs_deflate__decoder cannot start mid-byte or emit symbolic
+// back-references. The speculative result is only used if the chunks join up
+// exactly at their guessed block boundaries and if the gzip trailer's CRC-32
+// checksum and length match. Otherwise (and for small inputs, where threads
+// aren't worth it), it falls back to a single-threaded wuffs_gzip__decoder,
+// whose error message (if any) is returned. The speculative path needs an extra
+// 2 bytes of memory per decompressed byte.
+//
+// The code is in the AUX__ZLIB module, which also needs the CRC32 and GZIP
+// modules.
+//
+// It returns an empty string on success or an error message otherwise. On
+// failure, dst may have been partially appended to.
+std::string  //
+ParallelInflateGzip(std::vector<uint8_t>& dst,
+                    const uint8_t* ptr,
+                    size_t len,
+                    uint32_t num_threads = 0);
+
+// GzipMember locates one member (RFC 1952 section 2.2) of a multi-member gzip
+// file, such as those produced by pigz, bgzip or "cat a.gz b.gz". Its
+// compressed bytes (header, deflate data and trailer) are src[src_offset ..
+// src_offset + src_length) and its decompressed bytes are dst[dst_offset ..
+// dst_offset + isize). The crc32 and isize fields come from its trailer.
+struct GzipMember {
+  size_t src_offset;
+  size_t src_length;
+  uint64_t dst_offset;
+  uint32_t crc32;
+  uint32_t isize;
+};
+
+// IndexGzipMembers finds the members of the in-memory gzip file ptr[.. len),
+// replacing the contents of members, without decompressing anything.
+//
+// A BGZF member (as used by bgzip, BAM and tabix files) records its own
+// length, in the BSIZE field of a "BC" extra subfield, so finding the next
+// member is O(1). For other members, it scans forward for the next gzip header
+// whose preceding trailer is plausible (its ISIZE is within deflate's maximum
+// compression ratio of the compressed length).
+//
+// A trailer's ISIZE is the decompressed length modulo 2**32, so the dst_offset
+// fields (and the total decompressed length, the last member's dst_offset plus
+// its isize) are only right if each member is under 4 GiB. Also, the scan can
+// be fooled by compressed data that happens to look like a gzip header. The
+// index is therefore a guess, which decoding (e.g. by
+// ParallelInflateGzipMembers) confirms.
+//
+// It returns an empty string on success or an error message otherwise.
+std::string  //
+IndexGzipMembers(std::vector<GzipMember>& members,
+                 const uint8_t* ptr,
+                 size_t len);
+
+// ParallelInflateGzipMembersResult is the outcome of a
+// ParallelInflateGzipMembers call. On success, error_message is empty,
+// num_dst_bytes is the total decompressed length and checksum is the CRC-32
+// checksum of all of those bytes.
+struct ParallelInflateGzipMembersResult {
+  std::string error_message;
+  size_t num_dst_bytes;
+  uint32_t checksum;
+};
+
+// ParallelInflateGzipMembers decompresses every member of an in-memory,
+// multi-member gzip file into dst_ptr[.. dst_len).
+//
+// Unlike the rest of Wuffs, it is not single-threaded. Members are
+// independent, so after IndexGzipMembers finds them, up to num_threads (zero
+// means std::thread::hardware_concurrency()) worker threads, the calling
+// thread being one of them, each use their own wuffs_gzip__decoder to decode
+// whole members directly into their slices of dst. Each member's decoder
+// verifies that member's CRC-32 checksum and that it decodes to exactly its
+// ISIZE bytes. The members' checksums are then combined (via
+// wuffs_crc32__ieee_hasher's combine_u32 method) into the whole output's
+// checksum, without re-hashing it.
+//
+// If the index is wrong (e.g. a false member boundary, a member of 4 GiB or
+// more, or a total that does not fit in dst_len) then it falls back to a
+// single wuffs_gzip__decoder decoding all of the members in sequence, whose
+// error message (if any) is returned. A single-member file gains nothing
+// from this function: see ParallelInflateGzip instead.
+//
+// The code is in the AUX__ZLIB module, which also needs the CRC32 and GZIP
+// modules.
+ParallelInflateGzipMembersResult  //
+ParallelInflateGzipMembers(uint8_t* dst_ptr,
+                           size_t dst_len,
+                           const uint8_t* ptr,
+                           size_t len,
+                           uint32_t num_threads = 0);
+
+}  // namespace wuffs_aux
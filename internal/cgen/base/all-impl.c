@@ -115,6 +115,153 @@ const uint32_t wuffs_base__pixel_format__bits_per_channel[16] = {
     0x08, 0x0A, 0x0C, 0x10, 0x18, 0x20, 0x30, 0x40,
 };
 
+// --------
+
+// wuffs_base__private_implementation__cpu_arch__detected_features holds the
+// detected WUFFS_BASE__CPU_ARCH__FEATURE__ETC bits, or'ed with the DETECTED
+// bit so that zero means "not yet detected".
+#define WUFFS_BASE__PRIVATE_IMPLEMENTATION__CPU_ARCH__DETECTED 0x80000000
+
+static uint32_t
+    wuffs_base__private_implementation__cpu_arch__detected_features = 0;
+static uint32_t
+    wuffs_base__private_implementation__cpu_arch__disabled_features = 0;
+
+// Racing threads can only ever write the same detected value, and the disabled
+// features are set as a whole, so relaxed (unordered but untorn) loads and
+// stores are enough. MSVC's volatile accesses are untorn for aligned 32-bit
+// values.
+#if defined(__GNUC__) || defined(__clang__)
+#define WUFFS_BASE__PRIVATE_IMPLEMENTATION__LOAD_U32_RELAXED(p) \
+  __atomic_load_n(p, __ATOMIC_RELAXED)
+#define WUFFS_BASE__PRIVATE_IMPLEMENTATION__STORE_U32_RELAXED(p, v) \
+  __atomic_store_n(p, v, __ATOMIC_RELAXED)
+#else
+#define WUFFS_BASE__PRIVATE_IMPLEMENTATION__LOAD_U32_RELAXED(p) \
+  (*((volatile uint32_t*)(p)))
+#define WUFFS_BASE__PRIVATE_IMPLEMENTATION__STORE_U32_RELAXED(p, v) \
+  (*((volatile uint32_t*)(p)) = (v))
+#endif
+
+static uint32_t  //
+wuffs_base__private_implementation__cpu_arch__detect_features() {
+  uint32_t ret = WUFFS_BASE__PRIVATE_IMPLEMENTATION__CPU_ARCH__DETECTED;
+
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_CRC32)
+  ret |= WUFFS_BASE__CPU_ARCH__FEATURE__ARM_CRC32;
+#endif  // defined(WUFFS_BASE__CPU_ARCH__ARM_CRC32)
+
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+  ret |= WUFFS_BASE__CPU_ARCH__FEATURE__ARM_NEON;
+#endif  // defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+  // GCC defines these macros but MSVC does not.
+  //  - bit_PCLMUL  = (1 <<  1)
+  //  - bit_POPCNT  = (1 << 23)
+  //  - bit_SSE4_2  = (1 << 20)
+  //  - bit_OSXSAVE = (1 << 27)
+  const unsigned int sse42_ecx1 = 0x00900002;
+  const unsigned int osxsave_ecx1 = 0x08000000;
+  // GCC defines these macros but MSVC does not.
+  //  - bit_AVX2     = (1 <<  5)
+  //  - bit_BMI2     = (1 <<  8)
+  //  - bit_AVX512F  = (1 << 16)
+  //  - bit_AVX512BW = (1 << 30)
+  //  - bit_AVX512VL = (1 << 31)
+  const unsigned int avx2_ebx7 = 0x00000020;
+  const unsigned int bmi2_ebx7 = 0x00000100;
+  const unsigned int avx512_ebx7 = 0xC0010020;
+  // GCC defines these macros but MSVC does not.
+  //  - bit_VPCLMULQDQ = (1 << 10)
+  const unsigned int avx512_ecx7 = 0x00000400;
+  // The XCR0 register's SSE, AVX, opmask, ZMM_Hi256 and Hi16_ZMM state bits.
+  const unsigned int avx512_xcr0 = 0x000000E6;
+
+  unsigned int ecx1 = 0;
+  unsigned int ebx7 = 0;
+  unsigned int ecx7 = 0;
+  unsigned int xcr0 = 0;
+
+  // clang defines __GNUC__ and clang-cl defines _MSC_VER (but not __GNUC__).
+#if defined(__GNUC__)
+  unsigned int eax = 0;
+  unsigned int ebx = 0;
+  unsigned int ecx = 0;
+  unsigned int edx = 0;
+  if (__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+    ecx1 = ecx;
+  }
+  if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+    ebx7 = ebx;
+    ecx7 = ecx;
+  }
+  if ((ecx1 & osxsave_ecx1) == osxsave_ecx1) {
+    // Use inline assembly rather than the _xgetbv intrinsic, which would
+    // require an "xsave" target attribute.
+    unsigned int xcr0_lo = 0;
+    unsigned int xcr0_hi = 0;
+    __asm__ __volatile__("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+    xcr0 = xcr0_lo;
+  }
+#elif defined(_MSC_VER)  // defined(__GNUC__)
+  int x1[4];
+  __cpuid(x1, 1);
+  ecx1 = (unsigned int)(x1[2]);
+  int x7[4];
+  __cpuidex(x7, 7, 0);
+  ebx7 = (unsigned int)(x7[1]);
+  ecx7 = (unsigned int)(x7[2]);
+  if ((ecx1 & osxsave_ecx1) == osxsave_ecx1) {
+    xcr0 = (unsigned int)(_xgetbv(0));
+  }
+#else
+#error "WUFFS_BASE__CPU_ARCH__ETC combined with an unsupported compiler"
+#endif  // defined(__GNUC__); defined(_MSC_VER)
+
+  if ((ecx1 & sse42_ecx1) == sse42_ecx1) {
+    ret |= WUFFS_BASE__CPU_ARCH__FEATURE__X86_SSE42;
+    if ((ebx7 & avx2_ebx7) == avx2_ebx7) {
+      ret |= WUFFS_BASE__CPU_ARCH__FEATURE__X86_AVX2;
+      if (((ebx7 & avx512_ebx7) == avx512_ebx7) &&
+          ((ecx7 & avx512_ecx7) == avx512_ecx7) &&
+          ((xcr0 & avx512_xcr0) == avx512_xcr0)) {
+        ret |= WUFFS_BASE__CPU_ARCH__FEATURE__X86_AVX512;
+      }
+    }
+  }
+  if ((ebx7 & bmi2_ebx7) == bmi2_ebx7) {
+    ret |= WUFFS_BASE__CPU_ARCH__FEATURE__X86_BMI2;
+  }
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+
+  return ret;
+}
+
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_base__cpu_arch__features() {
+  uint32_t detected = WUFFS_BASE__PRIVATE_IMPLEMENTATION__LOAD_U32_RELAXED(
+      &wuffs_base__private_implementation__cpu_arch__detected_features);
+  if (detected == 0) {
+    detected = wuffs_base__private_implementation__cpu_arch__detect_features();
+    WUFFS_BASE__PRIVATE_IMPLEMENTATION__STORE_U32_RELAXED(
+        &wuffs_base__private_implementation__cpu_arch__detected_features,
+        detected);
+  }
+  uint32_t disabled = WUFFS_BASE__PRIVATE_IMPLEMENTATION__LOAD_U32_RELAXED(
+      &wuffs_base__private_implementation__cpu_arch__disabled_features);
+  return detected & ~disabled & WUFFS_BASE__CPU_ARCH__FEATURE__ALL;
+}
+
+WUFFS_BASE__MAYBE_STATIC void  //
+wuffs_base__cpu_arch__set_disabled_features(uint32_t features) {
+  WUFFS_BASE__PRIVATE_IMPLEMENTATION__STORE_U32_RELAXED(
+      &wuffs_base__private_implementation__cpu_arch__disabled_features,
+      features);
+}
+
+// --------
+
 // ¡ INSERT wuffs_base__status strings.
 
 // ¡ INSERT vtable names.
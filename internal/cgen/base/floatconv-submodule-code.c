@@ -955,6 +955,129 @@ wuffs_base__private_implementation__high_prec_dec__round_just_enough(
   }
 }
 
+// wuffs_base__private_implementation__schubfach_round_to_odd returns the high
+// 64 bits of the 192-bit product of the 128-bit (g_hi, g_lo) and the 64-bit
+// cp, with the low bit set ("round to odd") if the remaining 128 bits are
+// neither 0 nor 1. It is the rop function in "The Schubfach way to render
+// doubles" by Raffaello Giulietti, 2020:
+// https://github.com/c4f7fcce9cb06515/Schubfach
+static inline uint64_t  //
+wuffs_base__private_implementation__schubfach_round_to_odd(uint64_t g_lo,
+                                                           uint64_t g_hi,
+                                                           uint64_t cp) {
+  wuffs_base__multiply_u64__output x = wuffs_base__multiply_u64(g_lo, cp);
+  wuffs_base__multiply_u64__output y = wuffs_base__multiply_u64(g_hi, cp);
+  uint64_t z = y.lo + x.hi;
+  uint64_t y_hi = y.hi + ((z < y.lo) ? 1 : 0);
+  return y_hi | ((z > 1) ? 1 : 0);
+}
+
+// wuffs_base__private_implementation__high_prec_dec__assign_shortest sets h to
+// represent the shortest decimal number that rounds to the positive f, the
+// number (mantissa * (2 ** (exp2 - 52))), with ties (two shortest candidates)
+// resolved to the nearer one, then to the even one. This is the same as what
+// high_prec_dec__assign, high_prec_dec__lshift and
+// high_prec_dec__round_just_enough would compute, but much faster. It uses the
+// Schubfach algorithm (see above) with the powers_of_10 table, instead of
+// multi-hundred-digit decimal arithmetic.
+//
+// It returns false, leaving h unmodified, if f is too small for the
+// powers_of_10 table (roughly less than 1e-270), in which case the caller
+// should fall back to the slow path.
+//
+// Preconditions:
+//  - h is non-NULL.
+//  - mantissa is non-zero.
+static bool  //
+wuffs_base__private_implementation__high_prec_dec__assign_shortest(
+    wuffs_base__private_implementation__high_prec_dec* h,
+    int32_t exp2,
+    uint64_t mantissa,
+    bool negative) {
+  // Let f equal (c * (2 ** q)), for an odd or even integer c.
+  //
+  // The lower boundary is closer (f's lower neighbor is only half as far away
+  // as its upper neighbor) when c is an exact power of 2 and f is normal.
+  int32_t q = exp2 - 52;
+  uint64_t c = mantissa;
+  bool closer = (mantissa == 0x0010000000000000ul) && (exp2 > -1022);
+
+  // k is floor(log10((3/4) * (2 ** q))) when closer and floor(log10(2 ** q))
+  // otherwise. We need the approximation to (10 ** -k) in the table.
+  int32_t k = ((q * 1262611) - (closer ? 524031 : 0)) >> 22;
+  if ((-k) > 288) {
+    return false;
+  }
+  const uint64_t* po10 =
+      &wuffs_base__private_implementation__powers_of_10[307 - k][0];
+
+  // The table holds floor(10 ** -k) normalized to 128 bits, but Schubfach
+  // needs one more than that. The s_shift is in the range [1 ..= 4].
+  uint64_t g_lo = po10[0] + 1;
+  uint64_t g_hi = po10[1] + ((g_lo == 0) ? 1 : 0);
+  int32_t s_shift = q + (((-k) * 1741647) >> 19) + 1;
+
+  // The bounds are halfway to f's neighbors, scaled by (4 * (10 ** -k)). The
+  // bounds themselves are valid outputs only when c is even, so that IEEE 754
+  // round-to-even would round them to f.
+  uint64_t vbl = wuffs_base__private_implementation__schubfach_round_to_odd(
+      g_lo, g_hi, ((4 * c) - 2 + (closer ? 1 : 0)) << s_shift);
+  uint64_t vb = wuffs_base__private_implementation__schubfach_round_to_odd(
+      g_lo, g_hi, (4 * c) << s_shift);
+  uint64_t vbr = wuffs_base__private_implementation__schubfach_round_to_odd(
+      g_lo, g_hi, ((4 * c) + 2) << s_shift);
+  uint64_t even = ((c & 1) == 0) ? 0 : 1;
+  uint64_t lower = vbl + even;
+  uint64_t upper = vbr - even;
+
+  // Try ten times coarser first, then (10 ** k) granularity: either one of s
+  // and (s + 1) is uniquely within the bounds or pick the nearer to f.
+  uint64_t digits = 0;
+  uint64_t s = vb >> 2;
+  do {
+    if (s >= 10) {
+      uint64_t sp = s / 10;
+      bool up_inside = lower <= (40 * sp);
+      bool wp_inside = ((40 * sp) + 40) <= upper;
+      if (up_inside != wp_inside) {
+        digits = sp + (wp_inside ? 1 : 0);
+        k++;
+        break;
+      }
+    }
+    bool u_inside = lower <= (4 * s);
+    bool w_inside = ((4 * s) + 4) <= upper;
+    if (u_inside != w_inside) {
+      digits = s + (w_inside ? 1 : 0);
+      break;
+    }
+    uint64_t mid = (4 * s) + 2;
+    digits = s + (((vb > mid) || ((vb == mid) && ((s & 1) != 0))) ? 1 : 0);
+  } while (0);
+
+  // Convert digits, at most 17 of them, to h->digits. Work right-to-left,
+  // dropping trailing zeroes.
+  uint8_t buf[24];
+  uint32_t n = 0;
+  while ((digits % 10) == 0) {
+    digits /= 10;
+    k++;
+  }
+  while (digits > 0) {
+    buf[n++] = (uint8_t)(digits % 10);
+    digits /= 10;
+  }
+  uint32_t i = 0;
+  for (; i < n; i++) {
+    h->digits[i] = buf[n - 1 - i];
+  }
+  h->num_digits = n;
+  h->decimal_point = ((int32_t)n) + k;
+  h->negative = negative;
+  h->truncated = false;
+  return true;
+}
+
 // --------
 
 // wuffs_base__private_implementation__parse_number_f64_eisel_lemire produces
@@ -1495,6 +1618,21 @@ wuffs_base__parse_number_f64(wuffs_base__slice_u8 s, uint32_t options) {
     } else if (wuffs_base__private_implementation__is_decimal_digit(*p)) {
       man = ((uint8_t)(*p - '0'));
       p++;
+      // Consume 8 digits at a time while they (and 8 bytes) remain, then 1
+      // at a time. Again, it's OK if man overflows now.
+      //
+      // The 8 byte loads are from s, not z. Loading from z, just after the
+      // memcpy wrote to it, can stall on store-to-load forwarding.
+      while ((s.len - ((size_t)(p - &z[0]))) >= 8) {
+        uint64_t x =
+            wuffs_base__peek_u64le__no_bounds_check(s.ptr + (p - &z[0]));
+        if (!wuffs_base__private_implementation__is_eight_decimal_digits(x)) {
+          break;
+        }
+        man = (100000000 * man) +
+              wuffs_base__private_implementation__parse_eight_decimal_digits(x);
+        p += 8;
+      }
       for (; wuffs_base__private_implementation__is_decimal_digit(*p); p++) {
         man = (10 * man) + ((uint8_t)(*p - '0'));
       }
@@ -1516,6 +1654,16 @@ wuffs_base__parse_number_f64(wuffs_base__slice_u8 s, uint32_t options) {
       }
       man = (10 * man) + ((uint8_t)(*p - '0'));
       p++;
+      while ((s.len - ((size_t)(p - &z[0]))) >= 8) {
+        uint64_t x =
+            wuffs_base__peek_u64le__no_bounds_check(s.ptr + (p - &z[0]));
+        if (!wuffs_base__private_implementation__is_eight_decimal_digits(x)) {
+          break;
+        }
+        man = (100000000 * man) +
+              wuffs_base__private_implementation__parse_eight_decimal_digits(x);
+        p += 8;
+      }
       for (; wuffs_base__private_implementation__is_decimal_digit(*p); p++) {
         man = (10 * man) + ((uint8_t)(*p - '0'));
       }
@@ -1878,21 +2026,31 @@ wuffs_base__render_number_f64(wuffs_base__slice_u8 dst,
     precision = 4095;
   }
 
-  // Convert from the (neg, exp2, man) tuple to an HPD.
+  // Convert from the (neg, exp2, man) tuple to an HPD. For just enough
+  // precision, the fast path goes straight to the shortest digits. The slow
+  // path computes all of the digits and then rounds.
   wuffs_base__private_implementation__high_prec_dec h;
-  wuffs_base__private_implementation__high_prec_dec__assign(&h, man, neg);
-  if (h.num_digits > 0) {
-    wuffs_base__private_implementation__high_prec_dec__lshift(
-        &h, exp2 - 52);  // 52 mantissa bits.
+  bool just_enough =
+      (options & WUFFS_BASE__RENDER_NUMBER_FXX__JUST_ENOUGH_PRECISION) != 0;
+  if (!just_enough || (man == 0) ||
+      !wuffs_base__private_implementation__high_prec_dec__assign_shortest(
+          &h, exp2, man, neg)) {
+    wuffs_base__private_implementation__high_prec_dec__assign(&h, man, neg);
+    if (h.num_digits > 0) {
+      wuffs_base__private_implementation__high_prec_dec__lshift(
+          &h, exp2 - 52);  // 52 mantissa bits.
+    }
+    if (just_enough) {
+      wuffs_base__private_implementation__high_prec_dec__round_just_enough(
+          &h, exp2, man);
+    }
   }
 
   // Handle the "%e" and "%f" formats.
   switch (options & (WUFFS_BASE__RENDER_NUMBER_FXX__EXPONENT_ABSENT |
                      WUFFS_BASE__RENDER_NUMBER_FXX__EXPONENT_PRESENT)) {
     case WUFFS_BASE__RENDER_NUMBER_FXX__EXPONENT_ABSENT:  // The "%"f" format.
-      if (options & WUFFS_BASE__RENDER_NUMBER_FXX__JUST_ENOUGH_PRECISION) {
-        wuffs_base__private_implementation__high_prec_dec__round_just_enough(
-            &h, exp2, man);
+      if (just_enough) {
         int32_t p = ((int32_t)(h.num_digits)) - h.decimal_point;
         precision = ((uint32_t)(wuffs_base__i32__max(0, p)));
       } else {
@@ -1903,9 +2061,7 @@ wuffs_base__render_number_f64(wuffs_base__slice_u8 dst,
           dst, &h, precision, options);
 
     case WUFFS_BASE__RENDER_NUMBER_FXX__EXPONENT_PRESENT:  // The "%e" format.
-      if (options & WUFFS_BASE__RENDER_NUMBER_FXX__JUST_ENOUGH_PRECISION) {
-        wuffs_base__private_implementation__high_prec_dec__round_just_enough(
-            &h, exp2, man);
+      if (just_enough) {
         precision = (h.num_digits > 0) ? (h.num_digits - 1) : 0;
       } else {
         wuffs_base__private_implementation__high_prec_dec__round_nearest(
@@ -1919,9 +2075,7 @@ wuffs_base__render_number_f64(wuffs_base__slice_u8 dst,
   // digits, not the number of digits after the decimal separator. Perform
   // rounding and determine whether to use "%e" or "%f".
   int32_t e_threshold = 0;
-  if (options & WUFFS_BASE__RENDER_NUMBER_FXX__JUST_ENOUGH_PRECISION) {
-    wuffs_base__private_implementation__high_prec_dec__round_just_enough(
-        &h, exp2, man);
+  if (just_enough) {
     precision = h.num_digits;
     e_threshold = 6;
   } else {
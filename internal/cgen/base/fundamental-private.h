@@ -49,6 +49,21 @@
   goto suspend;                                                 \
   case n:;
 
+// The _FRESH variants are for the copy of a coroutine's body that runs when
+// the coroutine starts at the top (instead of resuming). They record the
+// suspension point but have no case labels: resuming always goes through the
+// switch in the other copy.
+#define WUFFS_BASE__COROUTINE_SUSPENSION_POINT_FRESH(n) coro_susp_point = n;
+
+#define WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND_FRESH(n) \
+  if (!status.repr) {                                                 \
+    goto ok;                                                          \
+  } else if (*status.repr != '$') {                                   \
+    goto exit;                                                        \
+  }                                                                   \
+  coro_susp_point = n;                                                \
+  goto suspend;
+
 // The "defined(__clang__)" isn't redundant. While vanilla clang defines
 // __GNUC__, clang-cl (which mimics MSVC's cl.exe) does not.
 #if defined(__GNUC__) || defined(__clang__)
@@ -59,6 +74,32 @@
 #define WUFFS_BASE__UNLIKELY(expr) (expr)
 #endif
 
+// WUFFS_BASE__STATS__ADD is what the "utility.stats_add!" Wuffs built-in
+// compiles to. The private_impl.stats field only exists when
+// WUFFS_CONFIG__STATS is defined. Otherwise, n is still evaluated (and then
+// discarded), so that any variables it uses aren't unused.
+#if defined(WUFFS_CONFIG__STATS)
+#define WUFFS_BASE__STATS__ADD(private_impl, counter, n) \
+  ((private_impl).stats.counters[counter] += (uint64_t)(n))
+#else
+#define WUFFS_BASE__STATS__ADD(private_impl, counter, n) ((void)(n))
+#endif
+
+// WUFFS_BASE__ITERATE_LOOP_HINT precedes the "while" loop of every iterate
+// loop round. It is empty by default but can be set via
+// WUFFS_CONFIG__ITERATE_LOOP_HINT to a compiler-specific loop pragma, such as
+// _Pragma("GCC unroll 4") or _Pragma("clang loop vectorize(enable)").
+//
+// Hints that assert the absence of aliasing or of loop-carried dependencies
+// (such as "GCC ivdep" or "omp simd") are unsafe: some iterate loop bodies
+// read bytes written by earlier iterations (e.g. PNG's Sub, Average and Paeth
+// filters) and Wuffs does not prove that distinct slices are disjoint.
+#if defined(WUFFS_CONFIG__ITERATE_LOOP_HINT)
+#define WUFFS_BASE__ITERATE_LOOP_HINT WUFFS_CONFIG__ITERATE_LOOP_HINT
+#else
+#define WUFFS_BASE__ITERATE_LOOP_HINT
+#endif
+
 // --------
 
 static inline wuffs_base__empty_struct  //
@@ -116,6 +157,24 @@ wuffs_base__iterate_total_advance(size_t total_len,
   return 0;
 }
 
+// --------
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// wuffs_base__private_implementation__use_x86_sse42 returns whether to take
+// an SSE4.2 code path over len bytes of input. Unless the compiler already
+// targets SSE4.2, that means calling wuffs_base__cpu_arch__have_x86_sse42.
+// Its CPUID result is cached, so the check is cheap, but the SIMD code paths
+// work in 16 byte (or larger) chunks and are only worth it for a few chunks.
+static inline bool  //
+wuffs_base__private_implementation__use_x86_sse42(size_t len) {
+#if defined(__SSE4_2__)
+  return true;
+#else
+  return (len >= 64) && wuffs_base__cpu_arch__have_x86_sse42();
+#endif
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+
 // ---------------- Numeric Types
 
 extern const uint8_t wuffs_base__low_bits_mask__u8[8];
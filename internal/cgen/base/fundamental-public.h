@@ -76,6 +76,11 @@
 // POPCNT. This is checked at runtime via cpuid, not at compile time.
 //
 // Likewise, "cpu_arch >= x86_avx2" also requires PCLMUL, POPCNT and SSE4.2.
+//
+// And "cpu_arch >= x86_avx512" also requires AVX2 (and everything that that
+// implies), AVX-512F, AVX-512BW, AVX-512VL and VPCLMULQDQ, as well as OS
+// support for saving the 512-bit register state. In practice, that means Intel
+// Ice Lake, AMD Zen 4 or later.
 #if defined(__i386__) || defined(__x86_64__)
 #if !defined(__native_client__)
 #include <cpuid.h>
@@ -85,6 +90,15 @@
 #endif  // !defined(__native_client__)
 #endif  // defined(__i386__) || defined(__x86_64__)
 
+// WebAssembly has no runtime feature detection. SIMD128 is a compile-time
+// property of the whole module (e.g. clang's or emcc's -msimd128 flag), like
+// ARM NEON. It is only used by hand-written base library code (such as pixel
+// swizzlers), not by code generated from Wuffs-the-language's cpu_arch.
+#if defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define WUFFS_BASE__CPU_ARCH__WASM_SIMD128
+#endif  // defined(__wasm_simd128__)
+
 #elif defined(_MSC_VER)  // (#if-chain ref AVOID_CPU_ARCH_1)
 
 #if defined(_M_IX86) || defined(_M_X64)
@@ -135,12 +149,79 @@
 #define WUFFS_BASE__MAYBE_STATIC
 #endif  // defined(WUFFS_CONFIG__STATIC_FUNCTIONS)
 
+// Define WUFFS_CONFIG__DST_PIXEL_FORMAT__ENABLE_ALLOWLIST (combined with
+// WUFFS_IMPLEMENTATION) to limit the destination pixel formats that the
+// pixel swizzler (and therefore image decoders) support to those with a
+// corresponding WUFFS_CONFIG__DST_PIXEL_FORMAT__ALLOW_ETC macro defined. For
+// example, also defining WUFFS_CONFIG__DST_PIXEL_FORMAT__ALLOW_BGRA_PREMUL
+// allows converting to WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL and nothing else.
+//
+// The code for converting to any other destination pixel format is compiled
+// out, producing smaller binaries. Calling wuffs_base__pixel_swizzler__prepare
+// with any other destination pixel format returns
+// wuffs_base__error__unsupported_pixel_swizzler_option.
+
+// Define WUFFS_CONFIG__STATS to have each decoder (and other Wuffs struct)
+// count events on its hot paths, such as coroutine suspensions or bytes
+// produced by fast and slow code paths, for the wuffs_foo__bar__stats
+// functions to report. It changes those structs' layout and so, unlike most
+// other WUFFS_CONFIG__ETC macros, must be defined (or not defined) the same
+// way for every compilation unit that includes the Wuffs header. When not
+// defined, counting compiles to nothing and the stats functions report zeroes.
+
 // ---------------- CPU Architecture
 
+// These are the bits of wuffs_base__cpu_arch__features' return value. Each
+// bit corresponds to a "cpu_arch >= etc" condition in Wuffs code (and to a
+// wuffs_base__cpu_arch__have_etc function), so X86_AVX2 also implies PCLMUL,
+// POPCNT and SSE4.2, and X86_AVX512 also implies VPCLMULQDQ, as per the
+// comments in the "Configuration" section above.
+#define WUFFS_BASE__CPU_ARCH__FEATURE__ARM_CRC32 0x00000001
+#define WUFFS_BASE__CPU_ARCH__FEATURE__ARM_NEON 0x00000002
+#define WUFFS_BASE__CPU_ARCH__FEATURE__X86_AVX2 0x00000100
+#define WUFFS_BASE__CPU_ARCH__FEATURE__X86_AVX512 0x00000200
+#define WUFFS_BASE__CPU_ARCH__FEATURE__X86_BMI2 0x00000400
+#define WUFFS_BASE__CPU_ARCH__FEATURE__X86_SSE42 0x00000800
+
+#define WUFFS_BASE__CPU_ARCH__FEATURE__ALL 0x00000F03
+
+// wuffs_base__cpu_arch__features returns the CPU features (a bitmask of
+// WUFFS_BASE__CPU_ARCH__FEATURE__ETC bits) that Wuffs may use: those detected,
+// minus those disabled by wuffs_base__cpu_arch__set_disabled_features.
+//
+// On x86, detection runs CPUID, a serializing instruction that can cost
+// microseconds under virtualization. It runs only once per process (per
+// WUFFS_IMPLEMENTATION), the first time that this function is called, and the
+// result is cached. Concurrent first calls are safe: they just detect the same
+// features.
+//
+// For modular builds that divide the base module into sub-modules, using this
+// function requires the WUFFS_CONFIG__MODULE__BASE__CORE sub-module.
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_base__cpu_arch__features();
+
+// wuffs_base__cpu_arch__set_disabled_features stops Wuffs from using the given
+// CPU features (a bitmask of WUFFS_BASE__CPU_ARCH__FEATURE__ETC bits), even if
+// the CPU has them, replacing any previously disabled set. Passing zero
+// re-enables all detected features. This can be useful for A/B benchmarking or
+// for avoiding e.g. AVX-512 frequency throttling.
+//
+// Decoders choose their implementations (e.g. via "choose" statements) when
+// they are initialized, so this affects decoders initialized afterwards, not
+// those initialized beforehand. It also does not affect code paths that the
+// compiler already targets at build time (e.g. code built with -mavx2 may use
+// AVX2 regardless).
+//
+// For modular builds that divide the base module into sub-modules, using this
+// function requires the WUFFS_CONFIG__MODULE__BASE__CORE sub-module.
+WUFFS_BASE__MAYBE_STATIC void  //
+wuffs_base__cpu_arch__set_disabled_features(uint32_t features);
+
 static inline bool  //
 wuffs_base__cpu_arch__have_arm_crc32() {
 #if defined(WUFFS_BASE__CPU_ARCH__ARM_CRC32)
-  return true;
+  return wuffs_base__cpu_arch__features() &
+         WUFFS_BASE__CPU_ARCH__FEATURE__ARM_CRC32;
 #else
   return false;
 #endif  // defined(WUFFS_BASE__CPU_ARCH__ARM_CRC32)
@@ -149,7 +230,8 @@ wuffs_base__cpu_arch__have_arm_crc32() {
 static inline bool  //
 wuffs_base__cpu_arch__have_arm_neon() {
 #if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
-  return true;
+  return wuffs_base__cpu_arch__features() &
+         WUFFS_BASE__CPU_ARCH__FEATURE__ARM_NEON;
 #else
   return false;
 #endif  // defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
@@ -158,109 +240,41 @@ wuffs_base__cpu_arch__have_arm_neon() {
 static inline bool  //
 wuffs_base__cpu_arch__have_x86_avx2() {
 #if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
-  // GCC defines these macros but MSVC does not.
-  //  - bit_AVX2 = (1 <<  5)
-  const unsigned int avx2_ebx7 = 0x00000020;
-  // GCC defines these macros but MSVC does not.
-  //  - bit_PCLMUL = (1 <<  1)
-  //  - bit_POPCNT = (1 << 23)
-  //  - bit_SSE4_2 = (1 << 20)
-  const unsigned int avx2_ecx1 = 0x00900002;
-
-  // clang defines __GNUC__ and clang-cl defines _MSC_VER (but not __GNUC__).
-#if defined(__GNUC__)
-  unsigned int eax7 = 0;
-  unsigned int ebx7 = 0;
-  unsigned int ecx7 = 0;
-  unsigned int edx7 = 0;
-  if (__get_cpuid_count(7, 0, &eax7, &ebx7, &ecx7, &edx7) &&
-      ((ebx7 & avx2_ebx7) == avx2_ebx7)) {
-    unsigned int eax1 = 0;
-    unsigned int ebx1 = 0;
-    unsigned int ecx1 = 0;
-    unsigned int edx1 = 0;
-    if (__get_cpuid(1, &eax1, &ebx1, &ecx1, &edx1) &&
-        ((ecx1 & avx2_ecx1) == avx2_ecx1)) {
-      return true;
-    }
-  }
-#elif defined(_MSC_VER)  // defined(__GNUC__)
-  int x7[4];
-  __cpuidex(x7, 7, 0);
-  if ((((unsigned int)(x7[1])) & avx2_ebx7) == avx2_ebx7) {
-    int x1[4];
-    __cpuid(x1, 1);
-    if ((((unsigned int)(x1[2])) & avx2_ecx1) == avx2_ecx1) {
-      return true;
-    }
-  }
+  return wuffs_base__cpu_arch__features() &
+         WUFFS_BASE__CPU_ARCH__FEATURE__X86_AVX2;
 #else
-#error "WUFFS_BASE__CPU_ARCH__ETC combined with an unsupported compiler"
-#endif  // defined(__GNUC__); defined(_MSC_VER)
+  return false;
 #endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+}
+
+static inline bool  //
+wuffs_base__cpu_arch__have_x86_avx512() {
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+  return wuffs_base__cpu_arch__features() &
+         WUFFS_BASE__CPU_ARCH__FEATURE__X86_AVX512;
+#else
   return false;
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
 }
 
 static inline bool  //
 wuffs_base__cpu_arch__have_x86_bmi2() {
 #if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
-  // GCC defines these macros but MSVC does not.
-  //  - bit_BMI2 = (1 <<  8)
-  const unsigned int bmi2_ebx7 = 0x00000100;
-
-  // clang defines __GNUC__ and clang-cl defines _MSC_VER (but not __GNUC__).
-#if defined(__GNUC__)
-  unsigned int eax7 = 0;
-  unsigned int ebx7 = 0;
-  unsigned int ecx7 = 0;
-  unsigned int edx7 = 0;
-  if (__get_cpuid_count(7, 0, &eax7, &ebx7, &ecx7, &edx7) &&
-      ((ebx7 & bmi2_ebx7) == bmi2_ebx7)) {
-    return true;
-  }
-#elif defined(_MSC_VER)  // defined(__GNUC__)
-  int x7[4];
-  __cpuidex(x7, 7, 0);
-  if ((((unsigned int)(x7[1])) & bmi2_ebx7) == bmi2_ebx7) {
-    return true;
-  }
+  return wuffs_base__cpu_arch__features() &
+         WUFFS_BASE__CPU_ARCH__FEATURE__X86_BMI2;
 #else
-#error "WUFFS_BASE__CPU_ARCH__ETC combined with an unsupported compiler"
-#endif  // defined(__GNUC__); defined(_MSC_VER)
-#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
   return false;
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
 }
 
 static inline bool  //
 wuffs_base__cpu_arch__have_x86_sse42() {
 #if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
-  // GCC defines these macros but MSVC does not.
-  //  - bit_PCLMUL = (1 <<  1)
-  //  - bit_POPCNT = (1 << 23)
-  //  - bit_SSE4_2 = (1 << 20)
-  const unsigned int sse42_ecx1 = 0x00900002;
-
-  // clang defines __GNUC__ and clang-cl defines _MSC_VER (but not __GNUC__).
-#if defined(__GNUC__)
-  unsigned int eax1 = 0;
-  unsigned int ebx1 = 0;
-  unsigned int ecx1 = 0;
-  unsigned int edx1 = 0;
-  if (__get_cpuid(1, &eax1, &ebx1, &ecx1, &edx1) &&
-      ((ecx1 & sse42_ecx1) == sse42_ecx1)) {
-    return true;
-  }
-#elif defined(_MSC_VER)  // defined(__GNUC__)
-  int x1[4];
-  __cpuid(x1, 1);
-  if ((((unsigned int)(x1[2])) & sse42_ecx1) == sse42_ecx1) {
-    return true;
-  }
+  return wuffs_base__cpu_arch__features() &
+         WUFFS_BASE__CPU_ARCH__FEATURE__X86_SSE42;
 #else
-#error "WUFFS_BASE__CPU_ARCH__ETC combined with an unsupported compiler"
-#endif  // defined(__GNUC__); defined(_MSC_VER)
-#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
   return false;
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
 }
 
 // ---------------- Fundamentals
@@ -346,6 +360,53 @@ typedef struct wuffs_base__utility__struct {
   uint8_t private_impl;
 } wuffs_base__utility;
 
+// --------
+
+// wuffs_base__stats holds the counters reported by the wuffs_foo__bar__stats
+// functions, which are all zero unless WUFFS_CONFIG__STATS is defined.
+//
+// The WUFFS_BASE__STATS__ETC indexes below 8 mean the same thing for every
+// package and include the counts of any sub-structs, such as the zlib decoder
+// within a PNG decoder. Indexes 8 and above are package-specific.
+typedef struct wuffs_base__stats__struct {
+  uint64_t counters[16];
+} wuffs_base__stats;
+
+// SUSPENSIONS counts the times that a public coroutine method returned a
+// suspension status such as "$short read".
+#define WUFFS_BASE__STATS__SUSPENSIONS 0
+// FAST_PATH_BYTES and SLOW_PATH_BYTES count the bytes produced by a package's
+// fast (assuming ample I/O buffer space) and slow (suspendible) code paths.
+#define WUFFS_BASE__STATS__FAST_PATH_BYTES 1
+#define WUFFS_BASE__STATS__SLOW_PATH_BYTES 2
+// TABLE_BUILDS counts the times that lookup tables, such as Huffman decoding
+// tables, were (re)built.
+#define WUFFS_BASE__STATS__TABLE_BUILDS 3
+
+#define WUFFS_BASE__STATS__NUM_COMMON_COUNTERS 8
+#define WUFFS_BASE__STATS__NUM_COUNTERS 16
+
+static inline wuffs_base__stats  //
+wuffs_base__make_empty_stats() {
+  wuffs_base__stats ret;
+  size_t i;
+  for (i = 0; i < WUFFS_BASE__STATS__NUM_COUNTERS; i++) {
+    ret.counters[i] = 0;
+  }
+  return ret;
+}
+
+// wuffs_base__stats__accumulate adds src's common (package-independent)
+// counters to dst's.
+static inline void  //
+wuffs_base__stats__accumulate(wuffs_base__stats* dst,
+                              const wuffs_base__stats* src) {
+  size_t i;
+  for (i = 0; i < WUFFS_BASE__STATS__NUM_COMMON_COUNTERS; i++) {
+    dst->counters[i] += src->counters[i];
+  }
+}
+
 typedef struct wuffs_base__vtable__struct {
   const char* vtable_name;
   const void* function_pointers;
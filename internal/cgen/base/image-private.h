@@ -38,6 +38,58 @@ wuffs_base__pixel_swizzler__swizzle_interleaved_transparent_black(
     wuffs_base__slice_u8 dst_palette,
     uint64_t num_pixels);
 
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_base__pixel_swizzler__swizzle_interleaved_from_packed_slice(
+    const wuffs_base__pixel_swizzler* p,
+    wuffs_base__slice_u8 dst,
+    wuffs_base__slice_u8 dst_palette,
+    wuffs_base__slice_u8 src,
+    uint32_t src_bits_per_pixel,
+    uint32_t src_skip,
+    uint64_t num_pixels,
+    bool scale_to_u8);
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_base__pixel_swizzler__swizzle_interleaved_from_u16be_slice(
+    const wuffs_base__pixel_swizzler* p,
+    wuffs_base__slice_u8 dst,
+    wuffs_base__slice_u8 dst_palette,
+    wuffs_base__slice_u8 src,
+    uint32_t src_num_channels,
+    uint64_t num_pixels);
+
+WUFFS_BASE__MAYBE_STATIC void  //
+wuffs_base__utility__downscale_accumulate(wuffs_base__slice_u8 accumulator,
+                                          wuffs_base__slice_u8 src,
+                                          uint32_t x,
+                                          uint32_t num_rows,
+                                          uint32_t bytes_per_pixel,
+                                          uint32_t shift);
+
+WUFFS_BASE__MAYBE_STATIC void  //
+wuffs_base__utility__downscale_flush(wuffs_base__slice_u8 dst,
+                                     wuffs_base__slice_u8 accumulator,
+                                     uint32_t x0,
+                                     uint32_t x1,
+                                     uint32_t num_rows,
+                                     uint32_t bytes_per_pixel,
+                                     uint32_t shift);
+
+// ---------------- Images (Accessors)
+
+static inline uint8_t  //
+wuffs_base__pixel_blend__repr(const wuffs_base__pixel_blend* b) {
+  return *b;
+}
+
+static inline uint32_t  //
+wuffs_base__pixel_format__repr(const wuffs_base__pixel_format* f) {
+  return f->repr;
+}
+
 // ---------------- Images (Utility)
 
+#define wuffs_base__utility__make_pixel_blend(repr) \
+  ((wuffs_base__pixel_blend)(repr))
+
 #define wuffs_base__utility__make_pixel_format wuffs_base__make_pixel_format
@@ -199,6 +199,32 @@ wuffs_base__color_u64__as__color_u32(uint64_t c) {
   return (a << 24) | (r << 16) | (g << 8) | (b << 0);
 }
 
+// wuffs_base__color_ycc__as__color_u32 converts from YCbCr to 0xAARRGGBB. The
+// alpha bits are always 0xFF. The arithmetic matches libjpeg's (the JFIF
+// specification's) fixed point conversion, including its rounding.
+static inline wuffs_base__color_u32_argb_premul  //
+wuffs_base__color_ycc__as__color_u32(uint32_t yy, uint32_t cb, uint32_t cr) {
+  // Work in 16.16 fixed point. The 0x1000000 bias (and subtracting 0x100
+  // after the shift) avoids right-shifting negative numbers. For example,
+  // 91881 is (1.40200 * 0x10000), rounded to the nearest integer.
+  int32_t cb8 = ((int32_t)(0xFF & cb)) - 0x80;
+  int32_t cr8 = ((int32_t)(0xFF & cr)) - 0x80;
+  int32_t y = (int32_t)(0xFF & yy);
+  int32_t r = y - 0x100 +
+              ((int32_t)(((uint32_t)(0x1008000 + (91881 * cr8))) >> 16));
+  int32_t g = y - 0x100 +
+              ((int32_t)(((uint32_t)(0x1008000 - (22554 * cb8) -
+                                     (46802 * cr8))) >>
+                         16));
+  int32_t b = y - 0x100 +
+              ((int32_t)(((uint32_t)(0x1008000 + (116130 * cb8))) >> 16));
+  r = (r < 0) ? 0 : ((r > 0xFF) ? 0xFF : r);
+  g = (g < 0) ? 0 : ((g > 0xFF) ? 0xFF : g);
+  b = (b < 0) ? 0 : ((b > 0xFF) ? 0xFF : b);
+  return 0xFF000000 | (((uint32_t)r) << 16) | (((uint32_t)g) << 8) |
+         (((uint32_t)b) << 0);
+}
+
 // --------
 
 typedef uint8_t wuffs_base__pixel_blend;
@@ -1449,20 +1475,383 @@ wuffs_base__pixel_buffer::set_color_u32_fill_rect(
 
 // --------
 
+// wuffs_base__color_conversion is a color correction (such as a gamma
+// adjustment or a change of color primaries) that a wuffs_base__pixel_swizzler
+// applies to each pixel as it converts it, so that color correction does not
+// need a separate pass over the whole image. It refers to, but does not own,
+// caller-precomputed lookup tables, which must outlive its use.
+//
+// There are two forms:
+//  - Per-channel tables, from wuffs_base__make_color_conversion_tables. The
+//    Blue, Green and Red channels (but not Alpha) each have their own table.
+//  - A 3×3 matrix, from wuffs_base__make_color_conversion_matrix, typically
+//    for converting between color primaries. Each channel is linearized (by
+//    table), the matrix is applied and the result is de-linearized (by table).
+//
+// It only applies to destination pixel formats with 8 bits per channel (BGR,
+// BGRA_NONPREMUL, BGRA_PREMUL, BGRA_BINARY, BGRX and their RGB-ordered
+// counterparts) or, for per-channel tables only, BGRA_NONPREMUL_4X16LE. For
+// premultiplied alpha formats, partially transparent pixels are converted as
+// non-premultiplied colors, which costs a division per pixel.
+typedef struct wuffs_base__color_conversion__struct {
+  // Do not access the private_impl's fields directly. There is no API/ABI
+  // compatibility or safety guarantee if you do so.
+  struct {
+    const uint8_t* table_u8;
+    const uint16_t* table_u16;
+    const uint16_t* linearize_u16;
+    const uint8_t* delinearize_u8;
+    int32_t matrix[9];
+  } private_impl;
+} wuffs_base__color_conversion;
+
+// wuffs_base__make_color_conversion_tables returns per-channel tables.
+//
+// table_u8, for 8 bits per channel destinations, holds 3 × 256 elements: 256
+// for Blue, then 256 for Green, then 256 for Red. Each channel value v becomes
+// table_u8[(256 * c) + v], where c is 0, 1 or 2.
+//
+// table_u16, for 16 bits per channel destinations, holds 3 × 4096 elements,
+// in the same channel order, indexed by the high 12 bits of the channel value.
+//
+// Either table may be NULL, in which case the corresponding destination pixel
+// formats are not supported.
+static inline wuffs_base__color_conversion  //
+wuffs_base__make_color_conversion_tables(const uint8_t* table_u8,
+                                         const uint16_t* table_u16) {
+  wuffs_base__color_conversion ret;
+  memset(&ret, 0, sizeof(ret));
+  ret.private_impl.table_u8 = table_u8;
+  ret.private_impl.table_u16 = table_u16;
+  return ret;
+}
+
+// wuffs_base__make_color_conversion_matrix returns a 3×3 matrix conversion,
+// for 8 bits per channel destinations.
+//
+// linearize_u16 holds 256 elements, mapping an encoded (e.g. sRGB) 8-bit
+// channel value to a linear 16-bit value. delinearize_u8 holds 4096 elements,
+// mapping the high 12 bits of a linear 16-bit value to an encoded 8-bit value.
+//
+// matrix holds 9 elements, in row-major order, in 16.16 fixed point (so that
+// 0x10000 means 1.0). The rows and columns are in Red, Green, Blue order, as is
+// conventional for color matrices: the linear output Red value is ((matrix[0] *
+// R) + (matrix[1] * G) + (matrix[2] * B)) >> 16, clamped to [0, 0xFFFF].
+static inline wuffs_base__color_conversion  //
+wuffs_base__make_color_conversion_matrix(const uint16_t* linearize_u16,
+                                         const int32_t* matrix,
+                                         const uint8_t* delinearize_u8) {
+  wuffs_base__color_conversion ret;
+  memset(&ret, 0, sizeof(ret));
+  if (linearize_u16 && matrix && delinearize_u8) {
+    ret.private_impl.linearize_u16 = linearize_u16;
+    ret.private_impl.delinearize_u8 = delinearize_u8;
+    memcpy(&ret.private_impl.matrix[0], matrix, 9 * sizeof(int32_t));
+  }
+  return ret;
+}
+
+// --------
+
+// wuffs_base__decode_frame_options holds optional arguments for an image
+// decoder's decode_frame method. Passing a NULL pointer is equivalent to
+// passing a zero-initialized (or wuffs_base__null_decode_frame_options) value.
 typedef struct wuffs_base__decode_frame_options__struct {
   // Do not access the private_impl's fields directly. There is no API/ABI
   // compatibility or safety guarantee if you do so.
   struct {
-    uint8_t TODO;
+    wuffs_base__rect_ie_u32 roi;
+    bool has_roi;
+    uint32_t downscale_shift;
+    uint32_t row_band_height;
+    const wuffs_base__color_conversion* color_conversion;
   } private_impl;
 
 #ifdef __cplusplus
+  inline void set_roi(wuffs_base__rect_ie_u32 roi);
+  inline wuffs_base__rect_ie_u32 roi() const;
+  inline uint32_t roi_min_incl_x() const;
+  inline uint32_t roi_min_incl_y() const;
+  inline uint32_t roi_max_excl_x() const;
+  inline uint32_t roi_max_excl_y() const;
+  inline void set_downscale_shift(uint32_t shift);
+  inline uint32_t downscale_shift() const;
+  inline uint64_t downscale_workbuf_len(uint32_t image_width) const;
+  inline void set_row_band_height(uint32_t height);
+  inline uint32_t row_band_height() const;
+  inline void set_color_conversion(const wuffs_base__color_conversion* c);
+  inline const wuffs_base__color_conversion* color_conversion() const;
+  inline bool has_color_conversion() const;
 #endif  // __cplusplus
 
 } wuffs_base__decode_frame_options;
 
+static inline wuffs_base__decode_frame_options  //
+wuffs_base__null_decode_frame_options() {
+  wuffs_base__decode_frame_options ret;
+  ret.private_impl.roi = wuffs_base__make_rect_ie_u32(0, 0, 0, 0);
+  ret.private_impl.has_roi = false;
+  ret.private_impl.downscale_shift = 0;
+  ret.private_impl.row_band_height = 0;
+  ret.private_impl.color_conversion = NULL;
+  return ret;
+}
+
+// wuffs_base__decode_frame_options__set_roi sets the Region of Interest (ROI),
+// in the image's coordinate space. The decoder will only write the pixels
+// inside the ROI (intersected with the frame bounds) and, instead of writing
+// the image pixel (x, y) to the pixel buffer's (x, y), it will write it to the
+// pixel buffer's (x - roi.min_incl_x, y - roi.min_incl_y). The pixel buffer
+// therefore only needs to be as large as the ROI (intersected with the image
+// bounds), not as large as the whole image.
+//
+// The decoder still reads all of the frame's source data, but skipping the
+// pixels outside of the ROI saves swizzling time as well as pixel buffer
+// memory.
+//
+// Without an ROI, the default, the whole image is decoded.
+static inline void  //
+wuffs_base__decode_frame_options__set_roi(wuffs_base__decode_frame_options* o,
+                                          wuffs_base__rect_ie_u32 roi) {
+  if (o) {
+    o->private_impl.roi = roi;
+    o->private_impl.has_roi = true;
+  }
+}
+
+// wuffs_base__decode_frame_options__roi returns the Region of Interest. If no
+// ROI was set then it returns the rectangle of all representable points.
+static inline wuffs_base__rect_ie_u32  //
+wuffs_base__decode_frame_options__roi(
+    const wuffs_base__decode_frame_options* o) {
+  if (o && o->private_impl.has_roi) {
+    return o->private_impl.roi;
+  }
+  return wuffs_base__make_rect_ie_u32(0, 0, 0xFFFFFFFF, 0xFFFFFFFF);
+}
+
+static inline uint32_t  //
+wuffs_base__decode_frame_options__roi_min_incl_x(
+    const wuffs_base__decode_frame_options* o) {
+  return (o && o->private_impl.has_roi) ? o->private_impl.roi.min_incl_x : 0;
+}
+
+static inline uint32_t  //
+wuffs_base__decode_frame_options__roi_min_incl_y(
+    const wuffs_base__decode_frame_options* o) {
+  return (o && o->private_impl.has_roi) ? o->private_impl.roi.min_incl_y : 0;
+}
+
+static inline uint32_t  //
+wuffs_base__decode_frame_options__roi_max_excl_x(
+    const wuffs_base__decode_frame_options* o) {
+  return (o && o->private_impl.has_roi) ? o->private_impl.roi.max_excl_x
+                                        : 0xFFFFFFFF;
+}
+
+static inline uint32_t  //
+wuffs_base__decode_frame_options__roi_max_excl_y(
+    const wuffs_base__decode_frame_options* o) {
+  return (o && o->private_impl.has_roi) ? o->private_impl.roi.max_excl_y
+                                        : 0xFFFFFFFF;
+}
+
+// wuffs_base__decode_frame_options__set_downscale_shift sets the decode-time
+// downscaling factor: the decoder box-filters each (1 << shift) by (1 << shift)
+// block of pixels down to a single pixel, for a shift of 0 (no downscaling,
+// the default), 1, 2 or 3. Larger shifts are clamped to 3. The blocks are
+// aligned to the Region of Interest's top left corner (see
+// wuffs_base__decode_frame_options__set_roi) and so the pixel buffer only
+// needs to be the ROI's width and height divided by (1 << shift), rounded up.
+//
+// Averaging is per 8-bit channel, so the destination pixel format must not be
+// indexed and must have 1, 3 or 4 bytes per pixel. The averaged pixels replace
+// the pixel buffer's, so the pixel blend should be WUFFS_BASE__PIXEL_BLEND__SRC
+// (other blends are memory-safe but give unspecified pixel values).
+//
+// Decoding with a non-zero shift needs an additional
+// wuffs_base__decode_frame_options__downscale_workbuf_len bytes at the end of
+// the work buffer, after the decoder's usual workbuf_len. Decoders that do not
+// support downscaling (or that do not support it for particular images, such
+// as interlaced ones) reject a non-zero shift with
+// wuffs_base__error__unsupported_option.
+static inline void  //
+wuffs_base__decode_frame_options__set_downscale_shift(
+    wuffs_base__decode_frame_options* o,
+    uint32_t shift) {
+  if (o) {
+    o->private_impl.downscale_shift = (shift < 3) ? shift : 3;
+  }
+}
+
+static inline uint32_t  //
+wuffs_base__decode_frame_options__downscale_shift(
+    const wuffs_base__decode_frame_options* o) {
+  return o ? o->private_impl.downscale_shift : 0;
+}
+
+// wuffs_base__decode_frame_options__downscale_workbuf_len returns how many
+// additional work buffer bytes are needed to decode, with these options, an
+// image whose width is image_width. It is zero when not downscaling.
+static inline uint64_t  //
+wuffs_base__decode_frame_options__downscale_workbuf_len(
+    const wuffs_base__decode_frame_options* o,
+    uint32_t image_width) {
+  uint32_t shift = wuffs_base__decode_frame_options__downscale_shift(o);
+  if (shift == 0) {
+    return 0;
+  }
+  uint32_t x1 = wuffs_base__decode_frame_options__roi_max_excl_x(o);
+  x1 = (x1 < image_width) ? x1 : image_width;
+  uint32_t x0 = wuffs_base__decode_frame_options__roi_min_incl_x(o);
+  x0 = (x0 < x1) ? x0 : x1;
+  uint64_t w = (uint64_t)(x1 - x0);
+  uint64_t bias = (((uint64_t)1) << shift) - 1;
+  return (4 * w) + (8 * ((w + bias) >> shift));
+}
+
+// wuffs_base__decode_frame_options__set_row_band_height sets the height of
+// the row bands that the frame is decoded in, so that the pixel buffer only
+// needs to hold that many rows (of the Region of Interest's width) instead of
+// the whole ROI. A zero height, the default, means to decode the whole frame
+// into one pixel buffer.
+//
+// With a non-zero height, every time a band of rows is complete (and more rows
+// remain), decode_frame returns wuffs_base__suspension__short_write. The
+// frame_dirty_rect method then returns the band, in the image's coordinate
+// space: the image's row y is at the pixel buffer's row (y -
+// frame_dirty_rect().min_incl_y). After consuming the band's rows, call
+// decode_frame again (with the same arguments) to decode the next band. The
+// final band is reported when decode_frame returns OK. Bands run top to bottom
+// for top-down images and bottom to top for bottom-up images (such as some BMP
+// and TGA images).
+//
+// The image_decoder's can_decode_row_bands method reports, after
+// decode_image_config, whether a decoder supports this for the image. Those
+// that do not (or that do not for particular images, such as interlaced ones)
+// reject a non-zero height with wuffs_base__error__unsupported_option, as do
+// all decoders when also downscaling.
+static inline void  //
+wuffs_base__decode_frame_options__set_row_band_height(
+    wuffs_base__decode_frame_options* o,
+    uint32_t height) {
+  if (o) {
+    o->private_impl.row_band_height = height;
+  }
+}
+
+static inline uint32_t  //
+wuffs_base__decode_frame_options__row_band_height(
+    const wuffs_base__decode_frame_options* o) {
+  return o ? o->private_impl.row_band_height : 0;
+}
+
+// wuffs_base__decode_frame_options__set_color_conversion sets the color
+// conversion (see wuffs_base__color_conversion) that the decoder applies as
+// it writes pixels. The wuffs_base__color_conversion (and its tables) must
+// outlive the decode_frame calls. NULL, the default, means no conversion.
+//
+// The pixel blend must be WUFFS_BASE__PIXEL_BLEND__SRC and the destination
+// pixel format must be one that the conversion supports. Otherwise, decoding
+// fails with wuffs_base__error__unsupported_pixel_swizzler_option. Decoders
+// that do not support color conversion reject a non-NULL one with
+// wuffs_base__error__unsupported_option.
+static inline void  //
+wuffs_base__decode_frame_options__set_color_conversion(
+    wuffs_base__decode_frame_options* o,
+    const wuffs_base__color_conversion* c) {
+  if (o) {
+    o->private_impl.color_conversion = c;
+  }
+}
+
+static inline const wuffs_base__color_conversion*  //
+wuffs_base__decode_frame_options__color_conversion(
+    const wuffs_base__decode_frame_options* o) {
+  return o ? o->private_impl.color_conversion : NULL;
+}
+
+static inline bool  //
+wuffs_base__decode_frame_options__has_color_conversion(
+    const wuffs_base__decode_frame_options* o) {
+  return o && o->private_impl.color_conversion;
+}
+
 #ifdef __cplusplus
 
+inline void  //
+wuffs_base__decode_frame_options::set_roi(wuffs_base__rect_ie_u32 roi) {
+  wuffs_base__decode_frame_options__set_roi(this, roi);
+}
+
+inline wuffs_base__rect_ie_u32  //
+wuffs_base__decode_frame_options::roi() const {
+  return wuffs_base__decode_frame_options__roi(this);
+}
+
+inline uint32_t  //
+wuffs_base__decode_frame_options::roi_min_incl_x() const {
+  return wuffs_base__decode_frame_options__roi_min_incl_x(this);
+}
+
+inline uint32_t  //
+wuffs_base__decode_frame_options::roi_min_incl_y() const {
+  return wuffs_base__decode_frame_options__roi_min_incl_y(this);
+}
+
+inline uint32_t  //
+wuffs_base__decode_frame_options::roi_max_excl_x() const {
+  return wuffs_base__decode_frame_options__roi_max_excl_x(this);
+}
+
+inline uint32_t  //
+wuffs_base__decode_frame_options::roi_max_excl_y() const {
+  return wuffs_base__decode_frame_options__roi_max_excl_y(this);
+}
+
+inline void  //
+wuffs_base__decode_frame_options::set_downscale_shift(uint32_t shift) {
+  wuffs_base__decode_frame_options__set_downscale_shift(this, shift);
+}
+
+inline uint32_t  //
+wuffs_base__decode_frame_options::downscale_shift() const {
+  return wuffs_base__decode_frame_options__downscale_shift(this);
+}
+
+inline uint64_t  //
+wuffs_base__decode_frame_options::downscale_workbuf_len(
+    uint32_t image_width) const {
+  return wuffs_base__decode_frame_options__downscale_workbuf_len(this,
+                                                                 image_width);
+}
+
+inline void  //
+wuffs_base__decode_frame_options::set_row_band_height(uint32_t height) {
+  wuffs_base__decode_frame_options__set_row_band_height(this, height);
+}
+
+inline uint32_t  //
+wuffs_base__decode_frame_options::row_band_height() const {
+  return wuffs_base__decode_frame_options__row_band_height(this);
+}
+
+inline void  //
+wuffs_base__decode_frame_options::set_color_conversion(
+    const wuffs_base__color_conversion* c) {
+  wuffs_base__decode_frame_options__set_color_conversion(this, c);
+}
+
+inline const wuffs_base__color_conversion*  //
+wuffs_base__decode_frame_options::color_conversion() const {
+  return wuffs_base__decode_frame_options__color_conversion(this);
+}
+
+inline bool  //
+wuffs_base__decode_frame_options::has_color_conversion() const {
+  return wuffs_base__decode_frame_options__has_color_conversion(this);
+}
+
 #endif  // __cplusplus
 
 // --------
@@ -1484,6 +1873,110 @@ wuffs_base__pixel_palette__closest_element(
 
 // --------
 
+// wuffs_base__pixel_palette_finder is a prepared form of a palette that makes
+// finding the closest palette element much faster than repeatedly calling
+// wuffs_base__pixel_palette__closest_element, such as when converting every
+// pixel of a true-color image to an indexed pixel format. It produces exactly
+// the same results as that function, including how ties are broken.
+//
+// It holds a converted (and re-ordered) copy of the palette, plus lazily
+// computed per-region lists of candidate elements, so it must be prepared
+// again whenever the palette changes. It is about 50 KiB in size, large enough
+// that it should usually be heap allocated instead of on the stack.
+typedef struct wuffs_base__pixel_palette_finder__struct {
+  // Do not access the private_impl's fields directly. There is no API/ABI
+  // compatibility or safety guarantee if you do so.
+  struct {
+    uint32_t num_elements;
+    // Each element is {g, b, r, a} as 16-bit premultiplied alpha color, with
+    // elements sorted by g (the channel with the most perceptual weight).
+    uint16_t elements[256][4];
+    uint8_t indexes[256];
+    // Opaque colors are split into 16x16x16 cells, by the high 4 bits of
+    // their blue, green and red. Each cell's {offset, length} refers to a
+    // list of elements (in the candidates array) that could be closest to
+    // any color in that cell. A zero length means that the list isn't computed yet. A
+    // 0xFFFF length means that the list didn't fit.
+    uint16_t cells[4096][2];
+    uint32_t num_candidates;
+    uint8_t candidates[32768];
+  } private_impl;
+
+#ifdef __cplusplus
+  inline wuffs_base__status prepare(wuffs_base__slice_u8 palette_slice,
+                                    wuffs_base__pixel_format palette_format);
+  inline uint8_t closest_element(wuffs_base__color_u32_argb_premul c);
+  inline uint64_t closest_elements(wuffs_base__slice_u8 dst,
+                                   wuffs_base__slice_u8 src);
+#endif  // __cplusplus
+
+} wuffs_base__pixel_palette_finder;
+
+// wuffs_base__pixel_palette_finder__prepare readies the palette finder so that
+// its other methods may be called. Its arguments have the same meaning as for
+// wuffs_base__pixel_palette__closest_element. The palette_slice's contents are
+// copied: the finder does not retain a reference to them.
+//
+// For modular builds that divide the base module into sub-modules, using this
+// function requires the WUFFS_CONFIG__MODULE__BASE__PIXCONV sub-module, not
+// just WUFFS_CONFIG__MODULE__BASE__CORE.
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_base__pixel_palette_finder__prepare(
+    wuffs_base__pixel_palette_finder* f,
+    wuffs_base__slice_u8 palette_slice,
+    wuffs_base__pixel_format palette_format);
+
+// wuffs_base__pixel_palette_finder__closest_element is like
+// wuffs_base__pixel_palette__closest_element but with a prepared palette.
+//
+// For modular builds that divide the base module into sub-modules, using this
+// function requires the WUFFS_CONFIG__MODULE__BASE__PIXCONV sub-module, not
+// just WUFFS_CONFIG__MODULE__BASE__CORE.
+WUFFS_BASE__MAYBE_STATIC uint8_t  //
+wuffs_base__pixel_palette_finder__closest_element(
+    wuffs_base__pixel_palette_finder* f,
+    wuffs_base__color_u32_argb_premul c);
+
+// wuffs_base__pixel_palette_finder__closest_elements maps a row of src pixels,
+// in the WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL format (4 bytes per pixel), to
+// a row of dst palette indexes (1 byte per pixel). It returns the number of
+// pixels converted, the minimum of dst.len and (src.len / 4).
+//
+// For modular builds that divide the base module into sub-modules, using this
+// function requires the WUFFS_CONFIG__MODULE__BASE__PIXCONV sub-module, not
+// just WUFFS_CONFIG__MODULE__BASE__CORE.
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_base__pixel_palette_finder__closest_elements(
+    wuffs_base__pixel_palette_finder* f,
+    wuffs_base__slice_u8 dst,
+    wuffs_base__slice_u8 src);
+
+#ifdef __cplusplus
+
+inline wuffs_base__status  //
+wuffs_base__pixel_palette_finder::prepare(
+    wuffs_base__slice_u8 palette_slice,
+    wuffs_base__pixel_format palette_format) {
+  return wuffs_base__pixel_palette_finder__prepare(this, palette_slice,
+                                                   palette_format);
+}
+
+inline uint8_t  //
+wuffs_base__pixel_palette_finder::closest_element(
+    wuffs_base__color_u32_argb_premul c) {
+  return wuffs_base__pixel_palette_finder__closest_element(this, c);
+}
+
+inline uint64_t  //
+wuffs_base__pixel_palette_finder::closest_elements(wuffs_base__slice_u8 dst,
+                                                   wuffs_base__slice_u8 src) {
+  return wuffs_base__pixel_palette_finder__closest_elements(this, dst, src);
+}
+
+#endif  // __cplusplus
+
+// --------
+
 // TODO: should the func type take restrict pointers?
 typedef uint64_t (*wuffs_base__pixel_swizzler__func)(uint8_t* dst_ptr,
                                                      size_t dst_len,
@@ -1508,6 +2001,9 @@ typedef struct wuffs_base__pixel_swizzler__struct {
     wuffs_base__pixel_swizzler__transparent_black_func transparent_black_func;
     uint32_t dst_pixfmt_bytes_per_pixel;
     uint32_t src_pixfmt_bytes_per_pixel;
+    uint32_t dst_pixfmt_repr;
+    wuffs_base__pixel_blend blend;
+    const wuffs_base__color_conversion* color_conversion;
   } private_impl;
 
 #ifdef __cplusplus
@@ -1516,6 +2012,8 @@ typedef struct wuffs_base__pixel_swizzler__struct {
                                     wuffs_base__pixel_format src_pixfmt,
                                     wuffs_base__slice_u8 src_palette,
                                     wuffs_base__pixel_blend blend);
+  inline wuffs_base__status set_color_conversion(
+      const wuffs_base__color_conversion* c);
   inline uint64_t swizzle_interleaved_from_slice(
       wuffs_base__slice_u8 dst,
       wuffs_base__slice_u8 dst_palette,
@@ -1538,6 +2036,32 @@ wuffs_base__pixel_swizzler__prepare(wuffs_base__pixel_swizzler* p,
                                     wuffs_base__slice_u8 src_palette,
                                     wuffs_base__pixel_blend blend);
 
+// wuffs_base__pixel_swizzler__set_color_conversion sets the color conversion
+// (see wuffs_base__color_conversion) that the swizzler's other methods apply
+// to each converted pixel. It must be called after
+// wuffs_base__pixel_swizzler__prepare, which resets it to NULL (meaning no
+// conversion). The wuffs_base__color_conversion must outlive its use.
+//
+// It returns wuffs_base__error__unsupported_pixel_swizzler_option if the
+// swizzler's pixel blend is not WUFFS_BASE__PIXEL_BLEND__SRC or if the
+// conversion does not support the destination pixel format.
+//
+// For modular builds that divide the base module into sub-modules, using this
+// function requires the WUFFS_CONFIG__MODULE__BASE__PIXCONV sub-module, not
+// just WUFFS_CONFIG__MODULE__BASE__CORE.
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_base__pixel_swizzler__set_color_conversion(
+    wuffs_base__pixel_swizzler* p,
+    const wuffs_base__color_conversion* c);
+
+// wuffs_base__pixel_swizzler__set_color_conversion_from_options is like
+// wuffs_base__pixel_swizzler__set_color_conversion, taking the conversion
+// from the (possibly NULL) options. It is what the image decoders call.
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_base__pixel_swizzler__set_color_conversion_from_options(
+    wuffs_base__pixel_swizzler* p,
+    const wuffs_base__decode_frame_options* opts);
+
 // wuffs_base__pixel_swizzler__swizzle_interleaved_from_slice converts pixels
 // from a source format to a destination format.
 //
@@ -1563,6 +2087,12 @@ wuffs_base__pixel_swizzler::prepare(wuffs_base__pixel_format dst_pixfmt,
                                              src_pixfmt, src_palette, blend);
 }
 
+inline wuffs_base__status  //
+wuffs_base__pixel_swizzler::set_color_conversion(
+    const wuffs_base__color_conversion* c) {
+  return wuffs_base__pixel_swizzler__set_color_conversion(this, c);
+}
+
 uint64_t  //
 wuffs_base__pixel_swizzler::swizzle_interleaved_from_slice(
     wuffs_base__slice_u8 dst,
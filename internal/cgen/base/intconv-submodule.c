@@ -249,6 +249,20 @@ decimal:
     const uint64_t max10 = 1844674407370955161u;
     const uint8_t max1 = 5;
 
+    // Consume 8 digits at a time while that cannot overflow: (v <= max8)
+    // implies that ((100000000 * v) + 99999999) <= UINT64_MAX. Underscores,
+    // non-digits and the last few digits are left for the 1-digit loop below.
+    const uint64_t max8 = 184467440736u;
+    while (((q - p) >= 8) && (v <= max8)) {
+      uint64_t x = wuffs_base__peek_u64le__no_bounds_check(p);
+      if (!wuffs_base__private_implementation__is_eight_decimal_digits(x)) {
+        break;
+      }
+      v = (100000000 * v) +
+          wuffs_base__private_implementation__parse_eight_decimal_digits(x);
+      p += 8;
+    }
+
     for (; p < q; p++) {
       if ((*p == '_') &&
           (options & WUFFS_BASE__PARSE_NUMBER_XXX__ALLOW_UNDERSCORES)) {
@@ -425,6 +439,126 @@ wuffs_base__render_number_u64(wuffs_base__slice_u8 dst,
 
 // ---------------- Base-16
 
+// ‼ WUFFS MULTI-FILE SECTION +x86_sse42
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// wuffs_base__base_16__digits__sse42 maps each byte of c to its hexadecimal
+// digit value. Like the low 4 bits of the
+// wuffs_base__parse_number__hexadecimal_digits table, it maps non-digits to 0.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+static inline __m128i  //
+wuffs_base__base_16__digits__sse42(__m128i c) {
+  // Bytes are compared as signed values, so that 0x80 ..= 0xFF (negative) are
+  // never in range. OR-ing with 0x20 maps 'A' ..= 'F' to 'a' ..= 'f'.
+  __m128i lc = _mm_or_si128(c, _mm_set1_epi8(+0x20));
+  __m128i is_09 = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8(+0x2F)),
+                                _mm_cmplt_epi8(c, _mm_set1_epi8(+0x3A)));
+  __m128i is_af = _mm_and_si128(_mm_cmpgt_epi8(lc, _mm_set1_epi8(+0x60)),
+                                _mm_cmplt_epi8(lc, _mm_set1_epi8(+0x67)));
+  return _mm_or_si128(
+      _mm_and_si128(is_09, _mm_sub_epi8(c, _mm_set1_epi8(+0x30))),
+      _mm_and_si128(is_af, _mm_sub_epi8(lc, _mm_set1_epi8(+0x57))));
+}
+
+// wuffs_base__base_16__decode2__sse42 decodes the first (n / 16) * 16 bytes
+// of dst from s, returning how many bytes it decoded.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+static size_t  //
+wuffs_base__base_16__decode2__sse42(uint8_t* d, const uint8_t* s, size_t n) {
+  // The multiply-add combines each pair of bytes as ((16 * hi) + lo).
+  const __m128i pairs = _mm_set1_epi16(+0x0110);
+  size_t i = 0;
+  for (; (n - i) >= 16; i += 16) {
+    __m128i x0 = wuffs_base__base_16__digits__sse42(
+        _mm_lddqu_si128((const __m128i*)(const void*)(s + 0x00)));
+    __m128i x1 = wuffs_base__base_16__digits__sse42(
+        _mm_lddqu_si128((const __m128i*)(const void*)(s + 0x10)));
+    _mm_storeu_si128((__m128i*)(void*)d,
+                     _mm_packus_epi16(_mm_maddubs_epi16(x0, pairs),
+                                      _mm_maddubs_epi16(x1, pairs)));
+    d += 16;
+    s += 32;
+  }
+  return i;
+}
+
+// wuffs_base__base_16__decode4__sse42 is like
+// wuffs_base__base_16__decode2__sse42 but for 4 source bytes per dst byte,
+// the first 2 of which (usually "\\x") are ignored.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+static size_t  //
+wuffs_base__base_16__decode4__sse42(uint8_t* d, const uint8_t* s, size_t n) {
+  // The multiply-add places ((16 * s[2]) + s[3]) in the high 16 bits of each
+  // 32 bits.
+  const __m128i quads = _mm_set1_epi32(+0x01100000);
+  size_t i = 0;
+  for (; (n - i) >= 16; i += 16) {
+    __m128i x0 = wuffs_base__base_16__digits__sse42(
+        _mm_lddqu_si128((const __m128i*)(const void*)(s + 0x00)));
+    __m128i x1 = wuffs_base__base_16__digits__sse42(
+        _mm_lddqu_si128((const __m128i*)(const void*)(s + 0x10)));
+    __m128i x2 = wuffs_base__base_16__digits__sse42(
+        _mm_lddqu_si128((const __m128i*)(const void*)(s + 0x20)));
+    __m128i x3 = wuffs_base__base_16__digits__sse42(
+        _mm_lddqu_si128((const __m128i*)(const void*)(s + 0x30)));
+    __m128i y0 = _mm_srli_epi32(_mm_maddubs_epi16(x0, quads), 16);
+    __m128i y1 = _mm_srli_epi32(_mm_maddubs_epi16(x1, quads), 16);
+    __m128i y2 = _mm_srli_epi32(_mm_maddubs_epi16(x2, quads), 16);
+    __m128i y3 = _mm_srli_epi32(_mm_maddubs_epi16(x3, quads), 16);
+    _mm_storeu_si128((__m128i*)(void*)d,
+                     _mm_packus_epi16(_mm_packus_epi32(y0, y1),
+                                      _mm_packus_epi32(y2, y3)));
+    d += 16;
+    s += 64;
+  }
+  return i;
+}
+
+// wuffs_base__base_16__encode__sse42 encodes the first (n / 16) * 16 bytes of
+// s to d, returning how many bytes it encoded. Each source byte becomes 2 or
+// 4 (with a "\\x" prefix) dst bytes.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+static size_t  //
+wuffs_base__base_16__encode__sse42(uint8_t* d,
+                                   const uint8_t* s,
+                                   size_t n,
+                                   bool backslash_x) {
+  const __m128i digits = _mm_setr_epi8(  //
+      +0x30, +0x31, +0x32, +0x33,        // '0' ..= '3'.
+      +0x34, +0x35, +0x36, +0x37,        // '4' ..= '7'.
+      +0x38, +0x39, +0x41, +0x42,        // '8' ..= 'B'.
+      +0x43, +0x44, +0x45, +0x46);       // 'C' ..= 'F'.
+  const __m128i nibble_mask = _mm_set1_epi8(+0x0F);
+  const __m128i prefix = _mm_set1_epi16(+0x785C);  // "\\x" little-endian.
+  size_t i = 0;
+  for (; (n - i) >= 16; i += 16) {
+    __m128i x = _mm_lddqu_si128((const __m128i*)(const void*)s);
+    __m128i hi = _mm_shuffle_epi8(
+        digits, _mm_and_si128(_mm_srli_epi16(x, 4), nibble_mask));
+    __m128i lo = _mm_shuffle_epi8(digits, _mm_and_si128(x, nibble_mask));
+    __m128i p0 = _mm_unpacklo_epi8(hi, lo);
+    __m128i p1 = _mm_unpackhi_epi8(hi, lo);
+    if (backslash_x) {
+      _mm_storeu_si128((__m128i*)(void*)(d + 0x00),
+                       _mm_unpacklo_epi16(prefix, p0));
+      _mm_storeu_si128((__m128i*)(void*)(d + 0x10),
+                       _mm_unpackhi_epi16(prefix, p0));
+      _mm_storeu_si128((__m128i*)(void*)(d + 0x20),
+                       _mm_unpacklo_epi16(prefix, p1));
+      _mm_storeu_si128((__m128i*)(void*)(d + 0x30),
+                       _mm_unpackhi_epi16(prefix, p1));
+      d += 64;
+    } else {
+      _mm_storeu_si128((__m128i*)(void*)(d + 0x00), p0);
+      _mm_storeu_si128((__m128i*)(void*)(d + 0x10), p1);
+      d += 32;
+    }
+    s += 16;
+  }
+  return i;
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// ‼ WUFFS MULTI-FILE SECTION -x86_sse42
+
 WUFFS_BASE__MAYBE_STATIC wuffs_base__transform__output  //
 wuffs_base__base_16__decode2(wuffs_base__slice_u8 dst,
                              wuffs_base__slice_u8 src,
@@ -451,6 +585,15 @@ wuffs_base__base_16__decode2(wuffs_base__slice_u8 dst,
   uint8_t* s = src.ptr;
   size_t n = len;
 
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+  if (wuffs_base__private_implementation__use_x86_sse42(n * 2)) {
+    size_t i = wuffs_base__base_16__decode2__sse42(d, s, n);
+    d += i;
+    s += i * 2;
+    n -= i;
+  }
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+
   while (n--) {
     *d = (uint8_t)((wuffs_base__parse_number__hexadecimal_digits[s[0]] << 4) |
                    (wuffs_base__parse_number__hexadecimal_digits[s[1]] & 0x0F));
@@ -489,6 +632,15 @@ wuffs_base__base_16__decode4(wuffs_base__slice_u8 dst,
   uint8_t* s = src.ptr;
   size_t n = len;
 
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+  if (wuffs_base__private_implementation__use_x86_sse42(n * 4)) {
+    size_t i = wuffs_base__base_16__decode4__sse42(d, s, n);
+    d += i;
+    s += i * 4;
+    n -= i;
+  }
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+
   while (n--) {
     *d = (uint8_t)((wuffs_base__parse_number__hexadecimal_digits[s[2]] << 4) |
                    (wuffs_base__parse_number__hexadecimal_digits[s[3]] & 0x0F));
@@ -525,6 +677,15 @@ wuffs_base__base_16__encode2(wuffs_base__slice_u8 dst,
   uint8_t* s = src.ptr;
   size_t n = len;
 
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+  if (wuffs_base__private_implementation__use_x86_sse42(n)) {
+    size_t i = wuffs_base__base_16__encode__sse42(d, s, n, false);
+    d += i * 2;
+    s += i;
+    n -= i;
+  }
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+
   while (n--) {
     uint8_t c = *s;
     d[0] = wuffs_base__private_implementation__encode_base16[c >> 4];
@@ -562,6 +723,15 @@ wuffs_base__base_16__encode4(wuffs_base__slice_u8 dst,
   uint8_t* s = src.ptr;
   size_t n = len;
 
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+  if (wuffs_base__private_implementation__use_x86_sse42(n)) {
+    size_t i = wuffs_base__base_16__encode__sse42(d, s, n, true);
+    d += i * 4;
+    s += i;
+    n -= i;
+  }
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+
   while (n--) {
     uint8_t c = *s;
     d[0] = '\\';
@@ -695,6 +865,151 @@ static const uint8_t wuffs_base__base_64__encode_url[64] = {
 
 // --------
 
+// ‼ WUFFS MULTI-FILE SECTION +x86_sse42
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// wuffs_base__base_64__decode__sse42 decodes 16 source bytes (with no
+// padding) to 12 dst bytes at a time, stopping at the first 16 byte block
+// that contains anything other than the alphabet's 64 codes. It returns the
+// number of blocks decoded, leaving the rest to the scalar code.
+//
+// Compare-based range checks map each code to its 6-bit value. Multiply-adds
+// then combine them: pairs of 6 bits into 12 bits and pairs of those into 24
+// bits. "Faster Base64 Encoding and Decoding using AVX2 Instructions" by
+// Wojciech Muła and Daniel Lemire (https://arxiv.org/abs/1704.00605) has more
+// detail.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+static size_t  //
+wuffs_base__base_64__decode__sse42(uint8_t* d_ptr,
+                                   size_t d_len,
+                                   const uint8_t* s_ptr,
+                                   size_t s_len,
+                                   bool url) {
+  // Code 62 is '+' or '-'. Code 63 is '/' or '_'.
+  int8_t c62 = url ? 0x2D : 0x2B;
+  int8_t c63 = url ? 0x5F : 0x2F;
+  const __m128i eq_62 = _mm_set1_epi8(c62);
+  const __m128i eq_63 = _mm_set1_epi8(c63);
+  const __m128i delta_62 = _mm_set1_epi8((int8_t)(62 - c62));
+  const __m128i delta_63 = _mm_set1_epi8((int8_t)(63 - c63));
+  const __m128i ab_bc = _mm_set1_epi32(+0x01400140);
+  const __m128i abcd = _mm_set1_epi32(+0x00011000);
+  const __m128i reorder = _mm_setr_epi8(  //
+      +0x02, +0x01, +0x00, +0x06,         //
+      +0x05, +0x04, +0x0A, +0x09,         //
+      +0x08, +0x0E, +0x0D, +0x0C,         //
+      -0x01, -0x01, -0x01, -0x01);
+
+  size_t n = 0;
+  while ((s_len >= 16) && (d_len >= 12)) {
+    __m128i c = _mm_lddqu_si128((const __m128i*)(const void*)s_ptr);
+
+    // Bytes are compared as signed values, so that 0x80 ..= 0xFF (negative)
+    // are never in range.
+    __m128i is_uc = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8(+0x40)),
+                                  _mm_cmplt_epi8(c, _mm_set1_epi8(+0x5B)));
+    __m128i is_lc = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8(+0x60)),
+                                  _mm_cmplt_epi8(c, _mm_set1_epi8(+0x7B)));
+    __m128i is_09 = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8(+0x2F)),
+                                  _mm_cmplt_epi8(c, _mm_set1_epi8(+0x3A)));
+    __m128i is_62 = _mm_cmpeq_epi8(c, eq_62);
+    __m128i is_63 = _mm_cmpeq_epi8(c, eq_63);
+    __m128i valid =
+        _mm_or_si128(_mm_or_si128(is_uc, is_lc),
+                     _mm_or_si128(is_09, _mm_or_si128(is_62, is_63)));
+    if (_mm_movemask_epi8(valid) != 0xFFFF) {
+      break;
+    }
+
+    // 'A' is 0x41 (code 0), 'a' is 0x61 (code 26) and '0' is 0x30 (code 52).
+    __m128i delta = _mm_or_si128(
+        _mm_or_si128(_mm_and_si128(is_uc, _mm_set1_epi8(-0x41)),
+                     _mm_and_si128(is_lc, _mm_set1_epi8(-0x47))),
+        _mm_or_si128(_mm_and_si128(is_09, _mm_set1_epi8(+0x04)),
+                     _mm_or_si128(_mm_and_si128(is_62, delta_62),
+                                  _mm_and_si128(is_63, delta_63))));
+    __m128i x = _mm_add_epi8(c, delta);
+    x = _mm_madd_epi16(_mm_maddubs_epi16(x, ab_bc), abcd);
+    x = _mm_shuffle_epi8(x, reorder);
+    _mm_storel_epi64((__m128i*)(void*)d_ptr, x);
+    wuffs_base__poke_u32le__no_bounds_check(
+        d_ptr + 8, (uint32_t)(_mm_extract_epi32(x, 2)));
+
+    d_ptr += 12;
+    d_len -= 12;
+    s_ptr += 16;
+    s_len -= 16;
+    n++;
+  }
+  return n;
+}
+
+// wuffs_base__base_64__encode__sse42 encodes 12 source bytes to 16 dst bytes
+// at a time, as Muła and Lemire's paper (see above) describes. It loads 16
+// source bytes at a time, so it stops when fewer than 16 are left. It returns
+// the number of blocks encoded, leaving the rest to the scalar code.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+static size_t  //
+wuffs_base__base_64__encode__sse42(uint8_t* d_ptr,
+                                   size_t d_len,
+                                   const uint8_t* s_ptr,
+                                   size_t s_len,
+                                   bool url) {
+  // Code 62 is '+' or '-'. Code 63 is '/' or '_'. Before the adjustments for
+  // those, codes 52 ..= 63 are offset by -4, to map to '0' ..= '9' and more.
+  int8_t c62 = url ? 0x2D : 0x2B;
+  int8_t c63 = url ? 0x5F : 0x2F;
+  const __m128i delta_62 = _mm_set1_epi8((int8_t)(c62 - 62 + 4));
+  const __m128i delta_63 = _mm_set1_epi8((int8_t)(c63 - 63 + 4));
+  const __m128i spread = _mm_setr_epi8(  //
+      +0x01, +0x00, +0x02, +0x01,        //
+      +0x04, +0x03, +0x05, +0x04,        //
+      +0x07, +0x06, +0x08, +0x07,        //
+      +0x0A, +0x09, +0x0B, +0x0A);
+
+  size_t n = 0;
+  while ((s_len >= 16) && (d_len >= 16)) {
+    __m128i x = _mm_lddqu_si128((const __m128i*)(const void*)s_ptr);
+
+    // Spread each 3 source bytes over 4 bytes and then shift each 6 bits
+    // into its own byte.
+    x = _mm_shuffle_epi8(x, spread);
+    __m128i t0 =
+        _mm_mulhi_epu16(_mm_and_si128(x, _mm_set1_epi32(+0x0FC0FC00)),
+                        _mm_set1_epi32(+0x04000040));
+    __m128i t1 =
+        _mm_mullo_epi16(_mm_and_si128(x, _mm_set1_epi32(+0x003F03F0)),
+                        _mm_set1_epi32(+0x01000010));
+    x = _mm_or_si128(t0, t1);
+
+    // Map codes 0 ..= 25 to 'A' ..= 'Z', 26 ..= 51 to 'a' ..= 'z', etc.
+    __m128i offset = _mm_set1_epi8(+0x41);
+    offset = _mm_add_epi8(
+        offset, _mm_and_si128(_mm_cmpgt_epi8(x, _mm_set1_epi8(+25)),
+                              _mm_set1_epi8(+0x06)));
+    offset = _mm_add_epi8(
+        offset, _mm_and_si128(_mm_cmpgt_epi8(x, _mm_set1_epi8(+51)),
+                              _mm_set1_epi8(-0x4B)));
+    offset = _mm_add_epi8(
+        offset,
+        _mm_and_si128(_mm_cmpeq_epi8(x, _mm_set1_epi8(+62)), delta_62));
+    offset = _mm_add_epi8(
+        offset,
+        _mm_and_si128(_mm_cmpeq_epi8(x, _mm_set1_epi8(+63)), delta_63));
+    _mm_storeu_si128((__m128i*)(void*)d_ptr, _mm_add_epi8(x, offset));
+
+    d_ptr += 16;
+    d_len -= 16;
+    s_ptr += 12;
+    s_len -= 12;
+    n++;
+  }
+  return n;
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// ‼ WUFFS MULTI-FILE SECTION -x86_sse42
+
+// --------
+
 WUFFS_BASE__MAYBE_STATIC wuffs_base__transform__output  //
 wuffs_base__base_64__decode(wuffs_base__slice_u8 dst,
                             wuffs_base__slice_u8 src,
@@ -710,6 +1025,18 @@ wuffs_base__base_64__decode(wuffs_base__slice_u8 dst,
   size_t s_len = src.len;
   bool pad = false;
 
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+  if (wuffs_base__private_implementation__use_x86_sse42(s_len)) {
+    size_t n = wuffs_base__base_64__decode__sse42(
+        d_ptr, d_len, s_ptr, s_len,
+        (options & WUFFS_BASE__BASE_64__URL_ALPHABET) != 0);
+    d_ptr += n * 12;
+    d_len -= n * 12;
+    s_ptr += n * 16;
+    s_len -= n * 16;
+  }
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+
   while (s_len >= 4) {
     uint32_t s = wuffs_base__peek_u32le__no_bounds_check(s_ptr);
     uint32_t s0 = alphabet[0xFF & (s >> 0)];
@@ -828,6 +1155,18 @@ wuffs_base__base_64__encode(wuffs_base__slice_u8 dst,
   size_t s_len = src.len;
 
   do {
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+    if (wuffs_base__private_implementation__use_x86_sse42(s_len)) {
+      size_t n = wuffs_base__base_64__encode__sse42(
+          d_ptr, d_len, s_ptr, s_len,
+          (options & WUFFS_BASE__BASE_64__URL_ALPHABET) != 0);
+      d_ptr += n * 16;
+      d_len -= n * 16;
+      s_ptr += n * 12;
+      s_len -= n * 12;
+    }
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+
     while (s_len >= 3) {
       if (d_len < 4) {
         o.status.repr = wuffs_base__suspension__short_write;
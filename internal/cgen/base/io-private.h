@@ -206,6 +206,13 @@ wuffs_base__io_writer__limited_copy_u32_from_history(uint8_t** ptr_iop_w,
 //  - length   <= (io2_w      - *ptr_iop_w)
 //  - distance >= 1
 //  - distance <= (*ptr_iop_w - io0_w)
+//
+// Callers typically use the 8_byte_chunks variants below for distances of 1
+// or at least 8, so that this function sees the short periodic distances (2
+// ..= 7). For those, once 8 bytes have been copied one at a time, the next
+// bytes repeat the same 8 byte pattern every (distance * (8 / distance))
+// bytes, so that longer copies can write 8 bytes at a time without
+// overshooting.
 static inline uint32_t  //
 wuffs_base__io_writer__limited_copy_u32_from_history_fast(uint8_t** ptr_iop_w,
                                                           uint8_t* io0_w,
@@ -215,6 +222,20 @@ wuffs_base__io_writer__limited_copy_u32_from_history_fast(uint8_t** ptr_iop_w,
   uint8_t* p = *ptr_iop_w;
   uint8_t* q = p - distance;
   uint32_t n = length;
+  if ((n >= 16) && (distance < 8)) {
+    for (uint32_t i = 0; i < 8; i++) {
+      p[i] = q[i];
+    }
+    uint64_t x = wuffs_base__peek_u64le__no_bounds_check(p);
+    uint32_t stride = distance * (8 / distance);
+    p += stride;
+    n -= stride;
+    for (; n >= 8; n -= stride) {
+      wuffs_base__poke_u64le__no_bounds_check(p, x);
+      p += stride;
+    }
+    q = p - distance;
+  }
   for (; n >= 3; n -= 3) {
     *p++ = *q++;
     *p++ = *q++;
@@ -254,6 +275,14 @@ wuffs_base__io_writer__limited_copy_u32_from_history_8_byte_chunks_distance_1_fa
   x |= x << 16;
   x |= x << 32;
   uint32_t n = length;
+  // Long runs (e.g. of zeroes) are common enough to be worth unrolling.
+  for (; n > 32; n -= 32) {
+    wuffs_base__poke_u64le__no_bounds_check(p + 0x00, x);
+    wuffs_base__poke_u64le__no_bounds_check(p + 0x08, x);
+    wuffs_base__poke_u64le__no_bounds_check(p + 0x10, x);
+    wuffs_base__poke_u64le__no_bounds_check(p + 0x18, x);
+    p += 32;
+  }
   while (1) {
     wuffs_base__poke_u64le__no_bounds_check(p, x);
     if (n <= 8) {
@@ -291,6 +320,15 @@ wuffs_base__io_writer__limited_copy_u32_from_history_8_byte_chunks_fast(
   uint8_t* p = *ptr_iop_w;
   uint8_t* q = p - distance;
   uint32_t n = length;
+  // When the source and destination are far enough apart, copy 32 byte
+  // chunks. The memcpy calls compile to wide (e.g. SIMD) loads and stores.
+  if (distance >= 32) {
+    for (; n > 32; n -= 32) {
+      memcpy(p, q, 32);
+      p += 32;
+      q += 32;
+    }
+  }
   while (1) {
     memcpy(p, q, 8);
     if (n <= 8) {
@@ -328,6 +366,44 @@ wuffs_base__io_writer__limited_copy_u32_from_reader(uint8_t** ptr_iop_w,
   return (uint32_t)(n);
 }
 
+// wuffs_base__io_writer__limited_copy_u32_from_reader_16_byte_chunks_fast is
+// like the wuffs_base__io_writer__limited_copy_u32_from_reader function above,
+// but copies 16 byte chunks at a time and has stronger pre-conditions.
+//
+// In terms of number of bytes copied, length is rounded up to a multiple of
+// 16. As a special case, a zero length rounds up to 16 (even though 0 is
+// already a multiple of 16), since there is always at least one 16 byte chunk
+// copied.
+//
+// In terms of advancing *ptr_iop_w and *ptr_iop_r, length is not rounded up.
+//
+// The caller needs to prove that:
+//  - (length + 16) <= (io2_w      - *ptr_iop_w)
+//  - (length + 16) <= (io2_r      - *ptr_iop_r)
+static inline uint32_t  //
+wuffs_base__io_writer__limited_copy_u32_from_reader_16_byte_chunks_fast(
+    uint8_t** ptr_iop_w,
+    uint8_t* io2_w,
+    uint32_t length,
+    const uint8_t** ptr_iop_r,
+    const uint8_t* io2_r) {
+  uint8_t* p = *ptr_iop_w;
+  const uint8_t* q = *ptr_iop_r;
+  uint32_t n = length;
+  while (1) {
+    memcpy(p, q, 16);
+    if (n <= 16) {
+      break;
+    }
+    p += 16;
+    q += 16;
+    n -= 16;
+  }
+  *ptr_iop_w += length;
+  *ptr_iop_r += length;
+  return length;
+}
+
 static inline uint32_t  //
 wuffs_base__io_writer__limited_copy_u32_from_slice(uint8_t** ptr_iop_w,
                                                    uint8_t* io2_w,
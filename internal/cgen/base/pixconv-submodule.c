@@ -14,6 +14,102 @@
 
 // ---------------- Pixel Swizzler
 
+// WUFFS_BASE__PIXCONV__DST__ETC is defined for each destination pixel format
+// that wuffs_base__pixel_swizzler__prepare supports: all of them unless
+// WUFFS_CONFIG__DST_PIXEL_FORMAT__ENABLE_ALLOWLIST is defined.
+#if !defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ENABLE_ALLOWLIST) || \
+    defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ALLOW_Y)
+#define WUFFS_BASE__PIXCONV__DST__Y
+#endif
+#if !defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ENABLE_ALLOWLIST) || \
+    defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ALLOW_Y_16LE)
+#define WUFFS_BASE__PIXCONV__DST__Y_16LE
+#endif
+#if !defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ENABLE_ALLOWLIST) || \
+    defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ALLOW_Y_16BE)
+#define WUFFS_BASE__PIXCONV__DST__Y_16BE
+#endif
+#if !defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ENABLE_ALLOWLIST) || \
+    defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ALLOW_BGR_565)
+#define WUFFS_BASE__PIXCONV__DST__BGR_565
+#endif
+#if !defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ENABLE_ALLOWLIST) || \
+    defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ALLOW_BGR)
+#define WUFFS_BASE__PIXCONV__DST__BGR
+#endif
+#if !defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ENABLE_ALLOWLIST) || \
+    defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ALLOW_BGRA_NONPREMUL)
+#define WUFFS_BASE__PIXCONV__DST__BGRA_NONPREMUL
+#endif
+#if !defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ENABLE_ALLOWLIST) || \
+    defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ALLOW_BGRA_NONPREMUL_4X16LE)
+#define WUFFS_BASE__PIXCONV__DST__BGRA_NONPREMUL_4X16LE
+#endif
+#if !defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ENABLE_ALLOWLIST) || \
+    defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ALLOW_BGRA_PREMUL)
+#define WUFFS_BASE__PIXCONV__DST__BGRA_PREMUL
+#endif
+#if !defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ENABLE_ALLOWLIST) || \
+    defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ALLOW_BGRA_PREMUL_4X16LE)
+#define WUFFS_BASE__PIXCONV__DST__BGRA_PREMUL_4X16LE
+#endif
+#if !defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ENABLE_ALLOWLIST) || \
+    defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ALLOW_BGRA_BINARY)
+#define WUFFS_BASE__PIXCONV__DST__BGRA_BINARY
+#endif
+#if !defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ENABLE_ALLOWLIST) || \
+    defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ALLOW_BGRX)
+#define WUFFS_BASE__PIXCONV__DST__BGRX
+#endif
+#if !defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ENABLE_ALLOWLIST) || \
+    defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ALLOW_RGB)
+#define WUFFS_BASE__PIXCONV__DST__RGB
+#endif
+#if !defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ENABLE_ALLOWLIST) || \
+    defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ALLOW_RGBA_NONPREMUL)
+#define WUFFS_BASE__PIXCONV__DST__RGBA_NONPREMUL
+#endif
+#if !defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ENABLE_ALLOWLIST) || \
+    defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ALLOW_RGBA_NONPREMUL_4X16LE)
+#define WUFFS_BASE__PIXCONV__DST__RGBA_NONPREMUL_4X16LE
+#endif
+#if !defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ENABLE_ALLOWLIST) || \
+    defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ALLOW_RGBA_PREMUL)
+#define WUFFS_BASE__PIXCONV__DST__RGBA_PREMUL
+#endif
+#if !defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ENABLE_ALLOWLIST) || \
+    defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ALLOW_RGBA_PREMUL_4X16LE)
+#define WUFFS_BASE__PIXCONV__DST__RGBA_PREMUL_4X16LE
+#endif
+#if !defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ENABLE_ALLOWLIST) || \
+    defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ALLOW_RGBA_BINARY)
+#define WUFFS_BASE__PIXCONV__DST__RGBA_BINARY
+#endif
+#if !defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ENABLE_ALLOWLIST) || \
+    defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ALLOW_RGBX)
+#define WUFFS_BASE__PIXCONV__DST__RGBX
+#endif
+#if !defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ENABLE_ALLOWLIST) || \
+    defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ALLOW_INDEXED__BGRA_NONPREMUL)
+#define WUFFS_BASE__PIXCONV__DST__INDEXED__BGRA_NONPREMUL
+#endif
+#if !defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ENABLE_ALLOWLIST) || \
+    defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ALLOW_INDEXED__BGRA_PREMUL)
+#define WUFFS_BASE__PIXCONV__DST__INDEXED__BGRA_PREMUL
+#endif
+#if !defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ENABLE_ALLOWLIST) || \
+    defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ALLOW_INDEXED__BGRA_BINARY)
+#define WUFFS_BASE__PIXCONV__DST__INDEXED__BGRA_BINARY
+#endif
+
+// With an allowlist, the swizzler functions for other destination pixel
+// formats are still defined but are no longer referenced.
+#if defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ENABLE_ALLOWLIST) && \
+    defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-function"
+#endif
+
 static inline uint32_t  //
 wuffs_base__swap_u32_argb_abgr(uint32_t u) {
   uint32_t o = u & 0xFF00FF00ul;
@@ -232,6 +328,29 @@ wuffs_base__pixel_buffer__set_color_u32_at(
 
 // --------
 
+static inline void  //
+wuffs_base__pixel_buffer__set_color_u32_fill_rect__x(
+    wuffs_base__pixel_buffer* pb,
+    wuffs_base__rect_ie_u32 rect,
+    uint8_t color) {
+  size_t stride = pb->private_impl.planes[0].stride;
+  uint32_t width = wuffs_base__rect_ie_u32__width(&rect);
+  if ((stride == ((uint64_t)width)) && (rect.min_incl_x == 0)) {
+    uint8_t* ptr =
+        pb->private_impl.planes[0].ptr + (stride * ((size_t)rect.min_incl_y));
+    uint32_t height = wuffs_base__rect_ie_u32__height(&rect);
+    memset(ptr, color, ((size_t)width) * ((size_t)height));
+    return;
+  }
+
+  uint32_t y;
+  for (y = rect.min_incl_y; y < rect.max_excl_y; y++) {
+    uint8_t* ptr = pb->private_impl.planes[0].ptr + (stride * ((size_t)y)) +
+                   ((size_t)rect.min_incl_x);
+    memset(ptr, color, (size_t)width);
+  }
+}
+
 static inline void  //
 wuffs_base__pixel_buffer__set_color_u32_fill_rect__xx(
     wuffs_base__pixel_buffer* pb,
@@ -385,6 +504,23 @@ wuffs_base__pixel_buffer__set_color_u32_fill_rect(
 
       // Common formats above. Rarer formats below.
 
+    case WUFFS_BASE__PIXEL_FORMAT__Y:
+      wuffs_base__pixel_buffer__set_color_u32_fill_rect__x(
+          pb, rect,
+          wuffs_base__color_u32_argb_premul__as__color_u8_gray(color));
+      return wuffs_base__make_status(NULL);
+
+    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_NONPREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_PREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_BINARY:
+      // Search the palette once, not once per pixel.
+      wuffs_base__pixel_buffer__set_color_u32_fill_rect__x(
+          pb, rect,
+          wuffs_base__pixel_palette__closest_element(
+              wuffs_base__pixel_buffer__palette(pb),
+              pb->pixcfg.private_impl.pixfmt, color));
+      return wuffs_base__make_status(NULL);
+
     case WUFFS_BASE__PIXEL_FORMAT__BGR_565:
       wuffs_base__pixel_buffer__set_color_u32_fill_rect__xx(
           pb, rect,
@@ -497,6 +633,308 @@ wuffs_base__pixel_palette__closest_element(
 
 // --------
 
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_base__pixel_palette_finder__prepare(
+    wuffs_base__pixel_palette_finder* f,
+    wuffs_base__slice_u8 palette_slice,
+    wuffs_base__pixel_format palette_format) {
+  if (!f) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  memset(&f->private_impl, 0, sizeof(f->private_impl));
+
+  switch (palette_format.repr) {
+    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_NONPREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_PREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_BINARY:
+      break;
+    default:
+      // Like wuffs_base__pixel_palette__closest_element, an unsupported
+      // palette format means that every color maps to the 0 index.
+      return wuffs_base__make_status(NULL);
+  }
+  bool nonpremul =
+      palette_format.repr == WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_NONPREMUL;
+
+  size_t n = palette_slice.len / 4;
+  if (n > (WUFFS_BASE__PIXEL_FORMAT__INDEXED__PALETTE_BYTE_LENGTH / 4)) {
+    n = (WUFFS_BASE__PIXEL_FORMAT__INDEXED__PALETTE_BYTE_LENGTH / 4);
+  }
+
+  // Convert each element to 16-bit premultiplied alpha color, the same way
+  // that wuffs_base__pixel_palette__closest_element does, and insertion sort
+  // by green. Equal greens keep their original (increasing index) order.
+  size_t i;
+  for (i = 0; i < n; i++) {
+    uint32_t pb = 0x101 * ((uint32_t)(palette_slice.ptr[(4 * i) + 0]));
+    uint32_t pg = 0x101 * ((uint32_t)(palette_slice.ptr[(4 * i) + 1]));
+    uint32_t pr = 0x101 * ((uint32_t)(palette_slice.ptr[(4 * i) + 2]));
+    uint32_t pa = 0x101 * ((uint32_t)(palette_slice.ptr[(4 * i) + 3]));
+    if (nonpremul && (pa != 0xFFFF)) {
+      pb = (pb * pa) / 0xFFFF;
+      pg = (pg * pa) / 0xFFFF;
+      pr = (pr * pa) / 0xFFFF;
+    }
+
+    size_t j = i;
+    while ((j > 0) && (f->private_impl.elements[j - 1][0] > pg)) {
+      memcpy(f->private_impl.elements[j], f->private_impl.elements[j - 1],
+             sizeof(f->private_impl.elements[j]));
+      f->private_impl.indexes[j] = f->private_impl.indexes[j - 1];
+      j--;
+    }
+    f->private_impl.elements[j][0] = (uint16_t)pg;
+    f->private_impl.elements[j][1] = (uint16_t)pb;
+    f->private_impl.elements[j][2] = (uint16_t)pr;
+    f->private_impl.elements[j][3] = (uint16_t)pa;
+    f->private_impl.indexes[j] = (uint8_t)i;
+  }
+  f->private_impl.num_elements = (uint32_t)n;
+
+  return wuffs_base__make_status(NULL);
+}
+
+static uint8_t  //
+wuffs_base__pixel_palette_finder__search(wuffs_base__pixel_palette_finder* f,
+                                         wuffs_base__color_u32_argb_premul c) {
+  uint32_t n = f->private_impl.num_elements;
+  if (n == 0) {
+    return 0;
+  }
+
+  // Work in 16-bit color.
+  uint32_t ca = 0x101 * (0xFF & (c >> 24));
+  uint32_t cr = 0x101 * (0xFF & (c >> 16));
+  uint32_t cg = 0x101 * (0xFF & (c >> 8));
+  uint32_t cb = 0x101 * (0xFF & (c >> 0));
+
+  // Binary search for the first element whose green is at least cg.
+  uint32_t lo = 0;
+  uint32_t hi = n;
+  while (lo < hi) {
+    uint32_t mid = (lo + hi) / 2;
+    if (f->private_impl.elements[mid][0] < cg) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+
+  uint32_t best_index = 0x100;
+  uint64_t best_score = 0xFFFFFFFFFFFFFFFF;
+
+  // Visit the elements in order of increasing green delta, scanning outwards
+  // from lo. The squared green delta alone is a lower bound on an element's
+  // score, so once that exceeds the best score so far, no remaining element
+  // can win (or tie, for the lowest index tie-break).
+  uint32_t up = lo;
+  uint32_t down = lo;
+  while (true) {
+    uint32_t k;
+    if ((up < n) &&
+        ((down == 0) ||
+         ((f->private_impl.elements[up][0] - cg) <=
+          (cg - f->private_impl.elements[down - 1][0])))) {
+      k = up++;
+    } else if (down > 0) {
+      k = --down;
+    } else {
+      break;
+    }
+
+    const uint16_t* e = f->private_impl.elements[k];
+    // These deltas are conceptually int32_t (signed) but after squaring,
+    // it's equivalent to work in uint32_t (unsigned).
+    uint32_t dg = ((uint32_t)(e[0])) - cg;
+    uint64_t score = ((uint64_t)(dg * dg));
+    if (score > best_score) {
+      break;
+    }
+    uint32_t db = ((uint32_t)(e[1])) - cb;
+    uint32_t dr = ((uint32_t)(e[2])) - cr;
+    uint32_t da = ((uint32_t)(e[3])) - ca;
+    score += ((uint64_t)(db * db)) + ((uint64_t)(dr * dr)) +
+             ((uint64_t)(da * da));
+    uint32_t index = f->private_impl.indexes[k];
+    if ((best_score > score) ||
+        ((best_score == score) && (best_index > index))) {
+      best_score = score;
+      best_index = index;
+    }
+  }
+
+  return (uint8_t)best_index;
+}
+
+static uint16_t  //
+wuffs_base__pixel_palette_finder__compute_cell(
+    wuffs_base__pixel_palette_finder* f,
+    uint32_t cell) {
+  // The cell's bounds, in 16-bit color, for the b, g and r channels. Alpha is
+  // always 0xFFFF.
+  uint32_t lo[3];
+  uint32_t hi[3];
+  lo[0] = 0x101 * (16 * (0x0F & (cell >> 0)));
+  lo[1] = 0x101 * (16 * (0x0F & (cell >> 4)));
+  lo[2] = 0x101 * (16 * (0x0F & (cell >> 8)));
+  hi[0] = lo[0] + (0x101 * 15);
+  hi[1] = lo[1] + (0x101 * 15);
+  hi[2] = lo[2] + (0x101 * 15);
+
+  // An element can only be the closest (or tied closest) to some color in the
+  // cell if its minimum distance to the cell is no more than every element's
+  // maximum distance to the cell.
+  uint64_t min_dists[256];
+  uint64_t min_max_dist = 0xFFFFFFFFFFFFFFFF;
+  uint32_t n = f->private_impl.num_elements;
+  uint32_t k;
+  for (k = 0; k < n; k++) {
+    const uint16_t* e = f->private_impl.elements[k];
+    uint32_t ebgr[3];
+    ebgr[0] = e[1];
+    ebgr[1] = e[0];
+    ebgr[2] = e[2];
+    uint32_t da = 0xFFFF - ((uint32_t)(e[3]));
+    uint64_t min_dist = ((uint64_t)(da * da));
+    uint64_t max_dist = ((uint64_t)(da * da));
+    int c;
+    for (c = 0; c < 3; c++) {
+      uint32_t d_lo = (ebgr[c] > lo[c]) ? (ebgr[c] - lo[c]) : (lo[c] - ebgr[c]);
+      uint32_t d_hi = (ebgr[c] > hi[c]) ? (ebgr[c] - hi[c]) : (hi[c] - ebgr[c]);
+      uint32_t d_min = 0;
+      if (ebgr[c] < lo[c]) {
+        d_min = d_lo;
+      } else if (ebgr[c] > hi[c]) {
+        d_min = d_hi;
+      }
+      uint32_t d_max = (d_lo > d_hi) ? d_lo : d_hi;
+      min_dist += ((uint64_t)(d_min * d_min));
+      max_dist += ((uint64_t)(d_max * d_max));
+    }
+    min_dists[k] = min_dist;
+    if (min_max_dist > max_dist) {
+      min_max_dist = max_dist;
+    }
+  }
+
+  uint32_t count = 0;
+  for (k = 0; k < n; k++) {
+    count += (min_dists[k] <= min_max_dist) ? 1 : 0;
+  }
+  if (count > (sizeof(f->private_impl.candidates) -
+               f->private_impl.num_candidates)) {
+    f->private_impl.cells[cell][1] = 0xFFFF;
+    return 0xFFFF;
+  }
+
+  // List the candidates in palette index order, so that the first of any
+  // equal-score elements has the lowest index.
+  uint8_t ks[256];
+  for (k = 0; k < n; k++) {
+    ks[f->private_impl.indexes[k]] = (uint8_t)k;
+  }
+  uint32_t offset = f->private_impl.num_candidates;
+  uint8_t* ptr = f->private_impl.candidates + offset;
+  uint32_t i;
+  for (i = 0; i < n; i++) {
+    if (min_dists[ks[i]] <= min_max_dist) {
+      *ptr++ = ks[i];
+    }
+  }
+  f->private_impl.num_candidates = offset + count;
+  f->private_impl.cells[cell][0] = (uint16_t)offset;
+  f->private_impl.cells[cell][1] = (uint16_t)count;
+  return (uint16_t)count;
+}
+
+WUFFS_BASE__MAYBE_STATIC uint8_t  //
+wuffs_base__pixel_palette_finder__closest_element(
+    wuffs_base__pixel_palette_finder* f,
+    wuffs_base__color_u32_argb_premul c) {
+  if (!f || (f->private_impl.num_elements == 0)) {
+    return 0;
+  } else if ((c >> 24) != 0xFF) {
+    return wuffs_base__pixel_palette_finder__search(f, c);
+  }
+
+  uint32_t cell =
+      (0x00F & (c >> 4)) | (0x0F0 & (c >> 8)) | (0xF00 & (c >> 12));
+  uint16_t count = f->private_impl.cells[cell][1];
+  if (count == 0) {
+    count = wuffs_base__pixel_palette_finder__compute_cell(f, cell);
+  }
+  if (count == 0xFFFF) {
+    return wuffs_base__pixel_palette_finder__search(f, c);
+  }
+
+  // Work in 16-bit color.
+  uint32_t cr = 0x101 * (0xFF & (c >> 16));
+  uint32_t cg = 0x101 * (0xFF & (c >> 8));
+  uint32_t cb = 0x101 * (0xFF & (c >> 0));
+
+  uint32_t best_k = 0;
+  uint64_t best_score = 0xFFFFFFFFFFFFFFFF;
+  const uint8_t* ptr =
+      f->private_impl.candidates + f->private_impl.cells[cell][0];
+  for (; count > 0; count--) {
+    uint32_t k = *ptr++;
+    const uint16_t* e = f->private_impl.elements[k];
+    // These deltas are conceptually int32_t (signed) but after squaring,
+    // it's equivalent to work in uint32_t (unsigned).
+    uint32_t dg = ((uint32_t)(e[0])) - cg;
+    uint32_t db = ((uint32_t)(e[1])) - cb;
+    uint32_t dr = ((uint32_t)(e[2])) - cr;
+    uint32_t da = ((uint32_t)(e[3])) - 0xFFFF;
+    uint64_t score = ((uint64_t)(dg * dg)) + ((uint64_t)(db * db)) +
+                     ((uint64_t)(dr * dr)) + ((uint64_t)(da * da));
+    if (best_score > score) {
+      best_score = score;
+      best_k = k;
+    }
+  }
+  return f->private_impl.indexes[best_k];
+}
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_base__pixel_palette_finder__closest_elements(
+    wuffs_base__pixel_palette_finder* f,
+    wuffs_base__slice_u8 dst,
+    wuffs_base__slice_u8 src) {
+  if (!f) {
+    return 0;
+  }
+  size_t len = src.len / 4;
+  if (len > dst.len) {
+    len = dst.len;
+  }
+  uint8_t* d = dst.ptr;
+  const uint8_t* s = src.ptr;
+
+  // Runs of identical colors are common, so remember the previous pixel's
+  // color and closest element.
+  uint32_t prev_c = 0;
+  uint8_t prev_index = 0;
+  if (len > 0) {
+    prev_c = wuffs_base__peek_u32le__no_bounds_check(s);
+    prev_index = wuffs_base__pixel_palette_finder__closest_element(f, prev_c);
+  }
+
+  size_t n;
+  for (n = len; n > 0; n--) {
+    uint32_t c = wuffs_base__peek_u32le__no_bounds_check(s);
+    if (prev_c != c) {
+      prev_c = c;
+      prev_index = wuffs_base__pixel_palette_finder__closest_element(f, c);
+    }
+    *d = prev_index;
+    d += 1;
+    s += 4;
+  }
+  return len;
+}
+
+// --------
+
 static inline uint32_t  //
 wuffs_base__composite_nonpremul_nonpremul_u32_axxx(uint32_t dst_nonpremul,
                                                    uint32_t src_nonpremul) {
@@ -827,6 +1265,95 @@ wuffs_base__pixel_swizzler__swap_rgb_bgr(uint8_t* dst_ptr,
   return len;
 }
 
+// ‼ WUFFS MULTI-FILE SECTION +arm_neon
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+static uint64_t  //
+wuffs_base__pixel_swizzler__swap_rgbx_bgrx__neon(uint8_t* dst_ptr,
+                                                 size_t dst_len,
+                                                 uint8_t* dst_palette_ptr,
+                                                 size_t dst_palette_len,
+                                                 const uint8_t* src_ptr,
+                                                 size_t src_len) {
+  size_t len = (dst_len < src_len ? dst_len : src_len) / 4;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 16) {
+    uint8x16x4_t x = vld4q_u8(s);
+    uint8x16_t x0 = x.val[0];
+    x.val[0] = x.val[2];
+    x.val[2] = x0;
+    vst4q_u8(d, x);
+
+    s += 16 * 4;
+    d += 16 * 4;
+    n -= 16;
+  }
+
+  while (n--) {
+    uint8_t s0 = s[0];
+    uint8_t s1 = s[1];
+    uint8_t s2 = s[2];
+    uint8_t s3 = s[3];
+    d[0] = s2;
+    d[1] = s1;
+    d[2] = s0;
+    d[3] = s3;
+    s += 4;
+    d += 4;
+  }
+  return len;
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+// ‼ WUFFS MULTI-FILE SECTION -arm_neon
+
+// ‼ WUFFS MULTI-FILE SECTION +wasm_simd128
+#if defined(WUFFS_BASE__CPU_ARCH__WASM_SIMD128)
+static uint64_t  //
+wuffs_base__pixel_swizzler__swap_rgbx_bgrx__wasm_simd128(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t len = (dst_len < src_len ? dst_len : src_len) / 4;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 4) {
+    v128_t x = wasm_v128_load(s);
+    x = wasm_i8x16_shuffle(x, x,                  //
+                           0x02, 0x01, 0x00, 0x03,  //
+                           0x06, 0x05, 0x04, 0x07,  //
+                           0x0A, 0x09, 0x08, 0x0B,  //
+                           0x0E, 0x0D, 0x0C, 0x0F);
+    wasm_v128_store(d, x);
+
+    s += 4 * 4;
+    d += 4 * 4;
+    n -= 4;
+  }
+
+  while (n--) {
+    uint8_t s0 = s[0];
+    uint8_t s1 = s[1];
+    uint8_t s2 = s[2];
+    uint8_t s3 = s[3];
+    d[0] = s2;
+    d[1] = s1;
+    d[2] = s0;
+    d[3] = s3;
+    s += 4;
+    d += 4;
+  }
+  return len;
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__WASM_SIMD128)
+// ‼ WUFFS MULTI-FILE SECTION -wasm_simd128
+
 // ‼ WUFFS MULTI-FILE SECTION +x86_sse42
 #if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
 WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
@@ -2145,8 +2672,10 @@ wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_nonpremul__src_over(
   return len;
 }
 
+// ‼ WUFFS MULTI-FILE SECTION +arm_neon
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_nonpremul_4x16le__src(
+wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_nonpremul_4x16le__src__neon(
     uint8_t* dst_ptr,
     size_t dst_len,
     uint8_t* dst_palette_ptr,
@@ -2158,8 +2687,22 @@ wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_nonpremul_4x16le__src(
   size_t len = (dst_len4 < src_len8) ? dst_len4 : src_len8;
   uint8_t* d = dst_ptr;
   const uint8_t* s = src_ptr;
-
   size_t n = len;
+
+  while (n >= 8) {
+    uint16x8x4_t x = vld4q_u16((const uint16_t*)(const void*)s);
+    uint8x8x4_t y;
+    y.val[0] = vshrn_n_u16(x.val[0], 8);
+    y.val[1] = vshrn_n_u16(x.val[1], 8);
+    y.val[2] = vshrn_n_u16(x.val[2], 8);
+    y.val[3] = vshrn_n_u16(x.val[3], 8);
+    vst4_u8(d, y);
+
+    s += 8 * 8;
+    d += 8 * 4;
+    n -= 8;
+  }
+
   while (n >= 1) {
     wuffs_base__poke_u32le__no_bounds_check(
         d + (0 * 4), wuffs_base__color_u64__as__color_u32(
@@ -2171,9 +2714,14 @@ wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_nonpremul_4x16le__src(
   }
   return len;
 }
+#endif  // defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+// ‼ WUFFS MULTI-FILE SECTION -arm_neon
 
+// ‼ WUFFS MULTI-FILE SECTION +x86_sse42
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_nonpremul_4x16le__src_over(
+wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_nonpremul_4x16le__src__sse42(
     uint8_t* dst_ptr,
     size_t dst_len,
     uint8_t* dst_palette_ptr,
@@ -2187,25 +2735,40 @@ wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_nonpremul_4x16le__src_over(
   const uint8_t* s = src_ptr;
   size_t n = len;
 
+  // Keep the high byte of each 16-bit channel.
+  __m128i shuffle = _mm_set_epi8(-0x80, -0x80, -0x80, -0x80,  //
+                                 -0x80, -0x80, -0x80, -0x80,  //
+                                 +0x0F, +0x0D, +0x0B, +0x09,  //
+                                 +0x07, +0x05, +0x03, +0x01);
+
+  while (n >= 4) {
+    __m128i x0 = _mm_lddqu_si128((const __m128i*)(const void*)(s + 0x00));
+    __m128i x1 = _mm_lddqu_si128((const __m128i*)(const void*)(s + 0x10));
+    x0 = _mm_shuffle_epi8(x0, shuffle);
+    x1 = _mm_shuffle_epi8(x1, shuffle);
+    _mm_storeu_si128((__m128i*)(void*)d, _mm_unpacklo_epi64(x0, x1));
+
+    s += 4 * 8;
+    d += 4 * 4;
+    n -= 4;
+  }
+
   while (n >= 1) {
-    uint64_t d0 = wuffs_base__color_u32__as__color_u64(
-        wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4)));
-    uint64_t s0 = wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8));
     wuffs_base__poke_u32le__no_bounds_check(
-        d + (0 * 4),
-        wuffs_base__color_u64__as__color_u32(
-            wuffs_base__composite_nonpremul_nonpremul_u64_axxx(d0, s0)));
+        d + (0 * 4), wuffs_base__color_u64__as__color_u32(
+                         wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8))));
 
     s += 1 * 8;
     d += 1 * 4;
     n -= 1;
   }
-
   return len;
 }
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// ‼ WUFFS MULTI-FILE SECTION -x86_sse42
 
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_premul__src(
+wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_nonpremul_4x16le__src(
     uint8_t* dst_ptr,
     size_t dst_len,
     uint8_t* dst_palette_ptr,
@@ -2213,18 +2776,77 @@ wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_premul__src(
     const uint8_t* src_ptr,
     size_t src_len) {
   size_t dst_len4 = dst_len / 4;
-  size_t src_len4 = src_len / 4;
-  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
+  size_t src_len8 = src_len / 8;
+  size_t len = (dst_len4 < src_len8) ? dst_len4 : src_len8;
   uint8_t* d = dst_ptr;
   const uint8_t* s = src_ptr;
-  size_t n = len;
 
+  size_t n = len;
   while (n >= 1) {
-    uint32_t s0 = wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4));
     wuffs_base__poke_u32le__no_bounds_check(
-        d + (0 * 4),
-        wuffs_base__color_u32_argb_premul__as__color_u32_argb_nonpremul(s0));
-
+        d + (0 * 4), wuffs_base__color_u64__as__color_u32(
+                         wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8))));
+
+    s += 1 * 8;
+    d += 1 * 4;
+    n -= 1;
+  }
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_nonpremul_4x16le__src_over(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len8 = src_len / 8;
+  size_t len = (dst_len4 < src_len8) ? dst_len4 : src_len8;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 1) {
+    uint64_t d0 = wuffs_base__color_u32__as__color_u64(
+        wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4)));
+    uint64_t s0 = wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4),
+        wuffs_base__color_u64__as__color_u32(
+            wuffs_base__composite_nonpremul_nonpremul_u64_axxx(d0, s0)));
+
+    s += 1 * 8;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_premul__src(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 1) {
+    uint32_t s0 = wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4),
+        wuffs_base__color_u32_argb_premul__as__color_u32_argb_nonpremul(s0));
+
     s += 1 * 4;
     d += 1 * 4;
     n -= 1;
@@ -2391,6 +3013,110 @@ wuffs_base__pixel_swizzler__bgra_nonpremul__rgba_premul__src_over(
 
 // --------
 
+// ‼ WUFFS MULTI-FILE SECTION +arm_neon
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__bgra_nonpremul__src__neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len8 = dst_len / 8;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len8 < src_len4) ? dst_len8 : src_len4;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  // Widening each channel c to 16 bits is (0x101 * c): zip c with itself.
+  while (n >= 4) {
+    uint8x16_t x = vld1q_u8(s);
+    uint8x16x2_t y = vzipq_u8(x, x);
+    vst1q_u8(d + 0x00, y.val[0]);
+    vst1q_u8(d + 0x10, y.val[1]);
+
+    s += 4 * 4;
+    d += 4 * 8;
+    n -= 4;
+  }
+
+  while (n >= 1) {
+    uint8_t s0 = s[0];
+    uint8_t s1 = s[1];
+    uint8_t s2 = s[2];
+    uint8_t s3 = s[3];
+    d[0] = s0;
+    d[1] = s0;
+    d[2] = s1;
+    d[3] = s1;
+    d[4] = s2;
+    d[5] = s2;
+    d[6] = s3;
+    d[7] = s3;
+
+    s += 1 * 4;
+    d += 1 * 8;
+    n -= 1;
+  }
+  return len;
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+// ‼ WUFFS MULTI-FILE SECTION -arm_neon
+
+// ‼ WUFFS MULTI-FILE SECTION +x86_sse42
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__bgra_nonpremul__src__sse42(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len8 = dst_len / 8;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len8 < src_len4) ? dst_len8 : src_len4;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  // Widening each channel c to 16 bits is (0x101 * c): unpack c with itself.
+  while (n >= 4) {
+    __m128i x = _mm_lddqu_si128((const __m128i*)(const void*)s);
+    _mm_storeu_si128((__m128i*)(void*)(d + 0x00), _mm_unpacklo_epi8(x, x));
+    _mm_storeu_si128((__m128i*)(void*)(d + 0x10), _mm_unpackhi_epi8(x, x));
+
+    s += 4 * 4;
+    d += 4 * 8;
+    n -= 4;
+  }
+
+  while (n >= 1) {
+    uint8_t s0 = s[0];
+    uint8_t s1 = s[1];
+    uint8_t s2 = s[2];
+    uint8_t s3 = s[3];
+    d[0] = s0;
+    d[1] = s0;
+    d[2] = s1;
+    d[3] = s1;
+    d[4] = s2;
+    d[5] = s2;
+    d[6] = s3;
+    d[7] = s3;
+
+    s += 1 * 4;
+    d += 1 * 8;
+    n -= 1;
+  }
+  return len;
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// ‼ WUFFS MULTI-FILE SECTION -x86_sse42
+
 static uint64_t  //
 wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__bgra_nonpremul__src(
     uint8_t* dst_ptr,
@@ -2706,8 +3432,24 @@ wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__rgba_premul__src_over(
 
 // --------
 
+// ‼ WUFFS MULTI-FILE SECTION +arm_neon
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+// wuffs_base__premul_u8x8__neon calculates the same (bit-exact) result as
+// wuffs_base__color_u32_argb_nonpremul__as__color_u32_argb_premul, for one
+// channel of 8 pixels at a time. Like the
+// wuffs_base__composite_premul_nonpremul_u8x8__neon function, the 16-bit math
+// ((0x101 * c) * (0x101 * a) / 0xFFFF) >> 8 is equivalent to (0x101 * x) /
+// 0xFF00, where x = (c * a), and that division is ((y + 1 + (y >> 8)) >> 8)
+// where y = (x + (x >> 8)).
+static inline uint8x8_t  //
+wuffs_base__premul_u8x8__neon(uint8x8_t c, uint8x8_t a) {
+  uint16x8_t x = vmull_u8(c, a);
+  uint16x8_t y = vsraq_n_u16(x, x, 8);
+  return vshrn_n_u16(vsraq_n_u16(vaddq_u16(y, vdupq_n_u16(1)), y, 8), 8);
+}
+
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src(
+wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src__neon(
     uint8_t* dst_ptr,
     size_t dst_len,
     uint8_t* dst_palette_ptr,
@@ -2721,7 +3463,19 @@ wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src(
   const uint8_t* s = src_ptr;
   size_t n = len;
 
-  // TODO: unroll.
+  while (n >= 8) {
+    uint8x8x4_t x = vld4_u8(s);
+    uint8x8x4_t y;
+    y.val[0] = wuffs_base__premul_u8x8__neon(x.val[0], x.val[3]);
+    y.val[1] = wuffs_base__premul_u8x8__neon(x.val[1], x.val[3]);
+    y.val[2] = wuffs_base__premul_u8x8__neon(x.val[2], x.val[3]);
+    y.val[3] = x.val[3];
+    vst4_u8(d, y);
+
+    s += 8 * 4;
+    d += 8 * 4;
+    n -= 8;
+  }
 
   while (n >= 1) {
     uint32_t s0 = wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4));
@@ -2736,9 +3490,41 @@ wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src(
 
   return len;
 }
+#endif  // defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+// ‼ WUFFS MULTI-FILE SECTION -arm_neon
+
+// ‼ WUFFS MULTI-FILE SECTION +wasm_simd128
+#if defined(WUFFS_BASE__CPU_ARCH__WASM_SIMD128)
+// wuffs_base__premul_u8x16__wasm_simd128 calculates the same (bit-exact)
+// result as wuffs_base__color_u32_argb_nonpremul__as__color_u32_argb_premul,
+// for 4 pixels at a time, using the same math as the u8x8__neon function.
+static inline v128_t  //
+wuffs_base__premul_u8x16__wasm_simd128(v128_t x) {
+  const v128_t u16_0x0001 = wasm_u16x8_splat(0x0001);
+
+  v128_t a = wasm_i8x16_shuffle(x, x,                  //
+                                0x03, 0x03, 0x03, 0x03,  //
+                                0x07, 0x07, 0x07, 0x07,  //
+                                0x0B, 0x0B, 0x0B, 0x0B,  //
+                                0x0F, 0x0F, 0x0F, 0x0F);
+  v128_t p0 = wasm_u16x8_extmul_low_u8x16(x, a);
+  v128_t p1 = wasm_u16x8_extmul_high_u8x16(x, a);
+  p0 = wasm_i16x8_add(p0, wasm_u16x8_shr(p0, 8));
+  p1 = wasm_i16x8_add(p1, wasm_u16x8_shr(p1, 8));
+  p0 = wasm_u16x8_shr(
+      wasm_i16x8_add(wasm_i16x8_add(p0, u16_0x0001), wasm_u16x8_shr(p0, 8)), 8);
+  p1 = wasm_u16x8_shr(
+      wasm_i16x8_add(wasm_i16x8_add(p1, u16_0x0001), wasm_u16x8_shr(p1, 8)), 8);
+  // Keep the original (not the squared) alpha.
+  return wasm_i8x16_shuffle(wasm_u8x16_narrow_i16x8(p0, p1), x,  //
+                            0x00, 0x01, 0x02, 0x13,              //
+                            0x04, 0x05, 0x06, 0x17,              //
+                            0x08, 0x09, 0x0A, 0x1B,              //
+                            0x0C, 0x0D, 0x0E, 0x1F);
+}
 
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul_4x16le__src(
+wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src__wasm_simd128(
     uint8_t* dst_ptr,
     size_t dst_len,
     uint8_t* dst_palette_ptr,
@@ -2746,30 +3532,39 @@ wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul_4x16le__src(
     const uint8_t* src_ptr,
     size_t src_len) {
   size_t dst_len4 = dst_len / 4;
-  size_t src_len8 = src_len / 8;
-  size_t len = (dst_len4 < src_len8) ? dst_len4 : src_len8;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
   uint8_t* d = dst_ptr;
   const uint8_t* s = src_ptr;
   size_t n = len;
 
-  // TODO: unroll.
+  while (n >= 4) {
+    v128_t x = wasm_v128_load(s);
+    wasm_v128_store(d, wuffs_base__premul_u8x16__wasm_simd128(x));
+
+    s += 4 * 4;
+    d += 4 * 4;
+    n -= 4;
+  }
 
   while (n >= 1) {
-    uint64_t s0 = wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8));
+    uint32_t s0 = wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4));
     wuffs_base__poke_u32le__no_bounds_check(
         d + (0 * 4),
-        wuffs_base__color_u64_argb_nonpremul__as__color_u32_argb_premul(s0));
+        wuffs_base__color_u32_argb_nonpremul__as__color_u32_argb_premul(s0));
 
-    s += 1 * 8;
+    s += 1 * 4;
     d += 1 * 4;
     n -= 1;
   }
 
   return len;
 }
+#endif  // defined(WUFFS_BASE__CPU_ARCH__WASM_SIMD128)
+// ‼ WUFFS MULTI-FILE SECTION -wasm_simd128
 
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src_over(
+wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src(
     uint8_t* dst_ptr,
     size_t dst_len,
     uint8_t* dst_palette_ptr,
@@ -2786,10 +3581,10 @@ wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src_over(
   // TODO: unroll.
 
   while (n >= 1) {
-    uint32_t d0 = wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4));
     uint32_t s0 = wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4));
     wuffs_base__poke_u32le__no_bounds_check(
-        d + (0 * 4), wuffs_base__composite_premul_nonpremul_u32_axxx(d0, s0));
+        d + (0 * 4),
+        wuffs_base__color_u32_argb_nonpremul__as__color_u32_argb_premul(s0));
 
     s += 1 * 4;
     d += 1 * 4;
@@ -2799,8 +3594,24 @@ wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src_over(
   return len;
 }
 
+// ‼ WUFFS MULTI-FILE SECTION +arm_neon
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+// wuffs_base__premul_u16x8__neon calculates the same (bit-exact) result as
+// wuffs_base__color_u64_argb_nonpremul__as__color_u32_argb_premul, for one
+// channel of 8 pixels at a time. For 16-bit c and a, the 32-bit product x = (c
+// * a) divided by 0xFFFF is exactly ((x + (x >> 16) + 1) >> 16), and that is
+// then narrowed to 8 bits.
+static inline uint8x8_t  //
+wuffs_base__premul_u16x8__neon(uint16x8_t c, uint16x8_t a) {
+  uint32x4_t x0 = vmull_u16(vget_low_u16(c), vget_low_u16(a));
+  uint32x4_t x1 = vmull_u16(vget_high_u16(c), vget_high_u16(a));
+  x0 = vaddq_u32(vsraq_n_u32(x0, x0, 16), vdupq_n_u32(1));
+  x1 = vaddq_u32(vsraq_n_u32(x1, x1, 16), vdupq_n_u32(1));
+  return vshrn_n_u16(vcombine_u16(vshrn_n_u32(x0, 16), vshrn_n_u32(x1, 16)), 8);
+}
+
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul_4x16le__src_over(
+wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul_4x16le__src__neon(
     uint8_t* dst_ptr,
     size_t dst_len,
     uint8_t* dst_palette_ptr,
@@ -2814,16 +3625,25 @@ wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul_4x16le__src_over(
   const uint8_t* s = src_ptr;
   size_t n = len;
 
-  // TODO: unroll.
+  while (n >= 8) {
+    uint16x8x4_t x = vld4q_u16((const uint16_t*)(const void*)s);
+    uint8x8x4_t y;
+    y.val[0] = wuffs_base__premul_u16x8__neon(x.val[0], x.val[3]);
+    y.val[1] = wuffs_base__premul_u16x8__neon(x.val[1], x.val[3]);
+    y.val[2] = wuffs_base__premul_u16x8__neon(x.val[2], x.val[3]);
+    y.val[3] = vshrn_n_u16(x.val[3], 8);
+    vst4_u8(d, y);
+
+    s += 8 * 8;
+    d += 8 * 4;
+    n -= 8;
+  }
 
   while (n >= 1) {
-    uint64_t d0 = wuffs_base__color_u32__as__color_u64(
-        wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4)));
     uint64_t s0 = wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8));
     wuffs_base__poke_u32le__no_bounds_check(
         d + (0 * 4),
-        wuffs_base__color_u64__as__color_u32(
-            wuffs_base__composite_premul_nonpremul_u64_axxx(d0, s0)));
+        wuffs_base__color_u64_argb_nonpremul__as__color_u32_argb_premul(s0));
 
     s += 1 * 8;
     d += 1 * 4;
@@ -2832,9 +3652,41 @@ wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul_4x16le__src_over(
 
   return len;
 }
+#endif  // defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+// ‼ WUFFS MULTI-FILE SECTION -arm_neon
 
+// ‼ WUFFS MULTI-FILE SECTION +x86_avx2
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// wuffs_base__premul_u16x16__avx2 is like the u16x8__sse42 function (see its
+// comments) for 4 pixels at a time.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static inline __m256i  //
+wuffs_base__premul_u16x16__avx2(__m256i x) {
+  const __m256i alpha_shuffle = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(+0x0F, +0x0E, +0x0F, +0x0E, +0x0F, +0x0E, +0x0F, +0x0E,  //
+                   +0x07, +0x06, +0x07, +0x06, +0x07, +0x06, +0x07, +0x06));
+  const __m256i u32_0x0001 = _mm256_set1_epi32(0x0001);
+
+  __m256i a = _mm256_shuffle_epi8(x, alpha_shuffle);
+  __m256i lo = _mm256_mullo_epi16(x, a);
+  __m256i hi = _mm256_mulhi_epu16(x, a);
+  __m256i p0 = _mm256_unpacklo_epi16(lo, hi);
+  __m256i p1 = _mm256_unpackhi_epi16(lo, hi);
+  p0 = _mm256_srli_epi32(
+      _mm256_add_epi32(_mm256_add_epi32(p0, _mm256_srli_epi32(p0, 16)),
+                       u32_0x0001),
+      24);
+  p1 = _mm256_srli_epi32(
+      _mm256_add_epi32(_mm256_add_epi32(p1, _mm256_srli_epi32(p1, 16)),
+                       u32_0x0001),
+      24);
+  return _mm256_blend_epi16(_mm256_packus_epi32(p0, p1),
+                            _mm256_srli_epi16(x, 8), 0x88);
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgra_premul__bgra_premul__src_over(
+wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul_4x16le__src__avx2(
     uint8_t* dst_ptr,
     size_t dst_len,
     uint8_t* dst_palette_ptr,
@@ -2842,65 +3694,119 @@ wuffs_base__pixel_swizzler__bgra_premul__bgra_premul__src_over(
     const uint8_t* src_ptr,
     size_t src_len) {
   size_t dst_len4 = dst_len / 4;
-  size_t src_len4 = src_len / 4;
-  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
+  size_t src_len8 = src_len / 8;
+  size_t len = (dst_len4 < src_len8) ? dst_len4 : src_len8;
   uint8_t* d = dst_ptr;
   const uint8_t* s = src_ptr;
   size_t n = len;
 
-  // TODO: unroll.
+  while (n >= 8) {
+    __m256i x0 = _mm256_lddqu_si256((const __m256i*)(const void*)(s + 0x00));
+    __m256i x1 = _mm256_lddqu_si256((const __m256i*)(const void*)(s + 0x20));
+    // Packing works within each 128-bit lane, so the pixels come out in the
+    // order 0, 1, 4, 5, 2, 3, 6, 7 and need a 64-bit permute.
+    __m256i y = _mm256_packus_epi16(wuffs_base__premul_u16x16__avx2(x0),
+                                    wuffs_base__premul_u16x16__avx2(x1));
+    _mm256_storeu_si256((__m256i*)(void*)d,
+                        _mm256_permute4x64_epi64(y, 0xD8));
+
+    s += 8 * 8;
+    d += 8 * 4;
+    n -= 8;
+  }
 
   while (n >= 1) {
-    uint32_t d0 = wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4));
-    uint32_t s0 = wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4));
+    uint64_t s0 = wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8));
     wuffs_base__poke_u32le__no_bounds_check(
-        d + (0 * 4), wuffs_base__composite_premul_premul_u32_axxx(d0, s0));
+        d + (0 * 4),
+        wuffs_base__color_u64_argb_nonpremul__as__color_u32_argb_premul(s0));
 
-    s += 1 * 4;
+    s += 1 * 8;
     d += 1 * 4;
     n -= 1;
   }
 
   return len;
 }
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// ‼ WUFFS MULTI-FILE SECTION -x86_avx2
+
+// ‼ WUFFS MULTI-FILE SECTION +x86_sse42
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// wuffs_base__premul_u16x8__sse42 calculates the same (bit-exact) result as
+// wuffs_base__color_u64_argb_nonpremul__as__color_u32_argb_premul, for 2
+// pixels at a time. Each of the 8 16-bit lanes of the result holds an 8-bit
+// value, ready for _mm_packus_epi16. As for the u16x8__neon function, the
+// 32-bit product x = (c * a) divided by 0xFFFF is exactly ((x + (x >> 16) + 1)
+// >> 16). The alpha channel is just narrowed: its lanes come from (x >> 8).
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+static inline __m128i  //
+wuffs_base__premul_u16x8__sse42(__m128i x) {
+  const __m128i alpha_shuffle =
+      _mm_set_epi8(+0x0F, +0x0E, +0x0F, +0x0E, +0x0F, +0x0E, +0x0F, +0x0E,  //
+                   +0x07, +0x06, +0x07, +0x06, +0x07, +0x06, +0x07, +0x06);
+  const __m128i u32_0x0001 = _mm_set1_epi32(0x0001);
+
+  __m128i a = _mm_shuffle_epi8(x, alpha_shuffle);
+  __m128i lo = _mm_mullo_epi16(x, a);
+  __m128i hi = _mm_mulhi_epu16(x, a);
+  __m128i p0 = _mm_unpacklo_epi16(lo, hi);
+  __m128i p1 = _mm_unpackhi_epi16(lo, hi);
+  p0 = _mm_srli_epi32(
+      _mm_add_epi32(_mm_add_epi32(p0, _mm_srli_epi32(p0, 16)), u32_0x0001),
+      24);
+  p1 = _mm_srli_epi32(
+      _mm_add_epi32(_mm_add_epi32(p1, _mm_srli_epi32(p1, 16)), u32_0x0001),
+      24);
+  return _mm_blend_epi16(_mm_packus_epi32(p0, p1), _mm_srli_epi16(x, 8), 0x88);
+}
 
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgra_premul__index_bgra_nonpremul__src_over(
+wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul_4x16le__src__sse42(
     uint8_t* dst_ptr,
     size_t dst_len,
     uint8_t* dst_palette_ptr,
     size_t dst_palette_len,
     const uint8_t* src_ptr,
     size_t src_len) {
-  if (dst_palette_len !=
-      WUFFS_BASE__PIXEL_FORMAT__INDEXED__PALETTE_BYTE_LENGTH) {
-    return 0;
-  }
   size_t dst_len4 = dst_len / 4;
-  size_t len = (dst_len4 < src_len) ? dst_len4 : src_len;
+  size_t src_len8 = src_len / 8;
+  size_t len = (dst_len4 < src_len8) ? dst_len4 : src_len8;
   uint8_t* d = dst_ptr;
   const uint8_t* s = src_ptr;
   size_t n = len;
 
-  // TODO: unroll.
+  while (n >= 4) {
+    __m128i x0 = _mm_lddqu_si128((const __m128i*)(const void*)(s + 0x00));
+    __m128i x1 = _mm_lddqu_si128((const __m128i*)(const void*)(s + 0x10));
+    _mm_storeu_si128((__m128i*)(void*)d,
+                     _mm_packus_epi16(wuffs_base__premul_u16x8__sse42(x0),
+                                      wuffs_base__premul_u16x8__sse42(x1)));
+
+    s += 4 * 8;
+    d += 4 * 4;
+    n -= 4;
+  }
 
   while (n >= 1) {
-    uint32_t d0 = wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4));
-    uint32_t s0 = wuffs_base__peek_u32le__no_bounds_check(dst_palette_ptr +
-                                                          ((size_t)s[0] * 4));
+    uint64_t s0 = wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8));
     wuffs_base__poke_u32le__no_bounds_check(
-        d + (0 * 4), wuffs_base__composite_premul_nonpremul_u32_axxx(d0, s0));
+        d + (0 * 4),
+        wuffs_base__color_u64_argb_nonpremul__as__color_u32_argb_premul(s0));
 
-    s += 1 * 1;
+    s += 1 * 8;
     d += 1 * 4;
     n -= 1;
   }
 
   return len;
 }
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// ‼ WUFFS MULTI-FILE SECTION -x86_sse42
 
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src(
+wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul_4x16le__src(
     uint8_t* dst_ptr,
     size_t dst_len,
     uint8_t* dst_palette_ptr,
@@ -2908,8 +3814,8 @@ wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src(
     const uint8_t* src_ptr,
     size_t src_len) {
   size_t dst_len4 = dst_len / 4;
-  size_t src_len4 = src_len / 4;
-  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
+  size_t src_len8 = src_len / 8;
+  size_t len = (dst_len4 < src_len8) ? dst_len4 : src_len8;
   uint8_t* d = dst_ptr;
   const uint8_t* s = src_ptr;
   size_t n = len;
@@ -2917,13 +3823,12 @@ wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src(
   // TODO: unroll.
 
   while (n >= 1) {
-    uint32_t s0 = wuffs_base__swap_u32_argb_abgr(
-        wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4)));
+    uint64_t s0 = wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8));
     wuffs_base__poke_u32le__no_bounds_check(
         d + (0 * 4),
-        wuffs_base__color_u32_argb_nonpremul__as__color_u32_argb_premul(s0));
+        wuffs_base__color_u64_argb_nonpremul__as__color_u32_argb_premul(s0));
 
-    s += 1 * 4;
+    s += 1 * 8;
     d += 1 * 4;
     n -= 1;
   }
@@ -2931,8 +3836,23 @@ wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src(
   return len;
 }
 
+// ‼ WUFFS MULTI-FILE SECTION +arm_neon
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+// wuffs_base__composite_premul_nonpremul_u8x8__neon is like the u8x16__sse42
+// function (see its comments) but for a single channel (given the src alpha
+// sa and its inverse ia) of 8 pixels at a time.
+static inline uint8x8_t  //
+wuffs_base__composite_premul_nonpremul_u8x8__neon(uint8x8_t dst_premul,
+                                                  uint8x8_t src_nonpremul,
+                                                  uint8x8_t sa,
+                                                  uint8x8_t ia) {
+  uint16x8_t x = vmlal_u8(vmull_u8(src_nonpremul, sa), dst_premul, ia);
+  uint16x8_t y = vsraq_n_u16(x, x, 8);
+  return vshrn_n_u16(vsraq_n_u16(vaddq_u16(y, vdupq_n_u16(1)), y, 8), 8);
+}
+
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src_over(
+wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src_over__neon(
     uint8_t* dst_ptr,
     size_t dst_len,
     uint8_t* dst_palette_ptr,
@@ -2946,12 +3866,31 @@ wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src_over(
   const uint8_t* s = src_ptr;
   size_t n = len;
 
-  // TODO: unroll.
+  uint8x8_t opaque = vdup_n_u8(0xFF);
+
+  while (n >= 8) {
+    uint8x8x4_t s8 = vld4_u8(s);
+    uint8x8x4_t d8 = vld4_u8(d);
+    uint8x8_t sa = s8.val[3];
+    uint8x8_t ia = vmvn_u8(sa);
+    d8.val[0] = wuffs_base__composite_premul_nonpremul_u8x8__neon(
+        d8.val[0], s8.val[0], sa, ia);
+    d8.val[1] = wuffs_base__composite_premul_nonpremul_u8x8__neon(
+        d8.val[1], s8.val[1], sa, ia);
+    d8.val[2] = wuffs_base__composite_premul_nonpremul_u8x8__neon(
+        d8.val[2], s8.val[2], sa, ia);
+    d8.val[3] = wuffs_base__composite_premul_nonpremul_u8x8__neon(
+        d8.val[3], opaque, sa, ia);
+    vst4_u8(d, d8);
+
+    s += 8 * 4;
+    d += 8 * 4;
+    n -= 8;
+  }
 
   while (n >= 1) {
     uint32_t d0 = wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4));
-    uint32_t s0 = wuffs_base__swap_u32_argb_abgr(
-        wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4)));
+    uint32_t s0 = wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4));
     wuffs_base__poke_u32le__no_bounds_check(
         d + (0 * 4), wuffs_base__composite_premul_nonpremul_u32_axxx(d0, s0));
 
@@ -2964,7 +3903,7 @@ wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src_over(
 }
 
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul_4x16le__src(
+wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src_over__neon(
     uint8_t* dst_ptr,
     size_t dst_len,
     uint8_t* dst_palette_ptr,
@@ -2972,32 +3911,99 @@ wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul_4x16le__src(
     const uint8_t* src_ptr,
     size_t src_len) {
   size_t dst_len4 = dst_len / 4;
-  size_t src_len8 = src_len / 8;
-  size_t len = (dst_len4 < src_len8) ? dst_len4 : src_len8;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
   uint8_t* d = dst_ptr;
   const uint8_t* s = src_ptr;
   size_t n = len;
 
-  // TODO: unroll.
+  uint8x8_t opaque = vdup_n_u8(0xFF);
+
+  while (n >= 8) {
+    uint8x8x4_t s8 = vld4_u8(s);
+    uint8x8x4_t d8 = vld4_u8(d);
+    uint8x8_t sa = s8.val[3];
+    uint8x8_t ia = vmvn_u8(sa);
+    d8.val[0] = wuffs_base__composite_premul_nonpremul_u8x8__neon(
+        d8.val[0], s8.val[2], sa, ia);
+    d8.val[1] = wuffs_base__composite_premul_nonpremul_u8x8__neon(
+        d8.val[1], s8.val[1], sa, ia);
+    d8.val[2] = wuffs_base__composite_premul_nonpremul_u8x8__neon(
+        d8.val[2], s8.val[0], sa, ia);
+    d8.val[3] = wuffs_base__composite_premul_nonpremul_u8x8__neon(
+        d8.val[3], opaque, sa, ia);
+    vst4_u8(d, d8);
+
+    s += 8 * 4;
+    d += 8 * 4;
+    n -= 8;
+  }
 
   while (n >= 1) {
-    uint64_t s0 = wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8));
+    uint32_t d0 = wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4));
+    uint32_t s0 = wuffs_base__swap_u32_argb_abgr(
+        wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4)));
     wuffs_base__poke_u32le__no_bounds_check(
-        d + (0 * 4),
-        wuffs_base__swap_u32_argb_abgr(
-            wuffs_base__color_u64_argb_nonpremul__as__color_u32_argb_premul(
-                s0)));
+        d + (0 * 4), wuffs_base__composite_premul_nonpremul_u32_axxx(d0, s0));
 
-    s += 1 * 8;
+    s += 1 * 4;
     d += 1 * 4;
     n -= 1;
   }
 
   return len;
 }
+#endif  // defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+// ‼ WUFFS MULTI-FILE SECTION -arm_neon
 
+// ‼ WUFFS MULTI-FILE SECTION +x86_avx2
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// wuffs_base__composite_premul_nonpremul_u8x32__avx2 is like the
+// u8x16__sse42 function (see its comments) for 8 pixels at a time.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static inline __m256i  //
+wuffs_base__composite_premul_nonpremul_u8x32__avx2(
+    __m256i dst_premul,
+    __m256i src_nonpremul) {
+  const __m256i alpha_shuffle_lo = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(-0x80, +0x07, -0x80, +0x07, -0x80, +0x07, -0x80, +0x07,  //
+                   -0x80, +0x03, -0x80, +0x03, -0x80, +0x03, -0x80, +0x03));
+  const __m256i alpha_shuffle_hi = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(-0x80, +0x0F, -0x80, +0x0F, -0x80, +0x0F, -0x80, +0x0F,  //
+                   -0x80, +0x0B, -0x80, +0x0B, -0x80, +0x0B, -0x80, +0x0B));
+  const __m256i opaque = _mm256_set1_epi32((int)0xFF000000u);
+  const __m256i u16_0x00FF = _mm256_set1_epi16(0x00FF);
+  const __m256i u16_0x0001 = _mm256_set1_epi16(0x0001);
+  const __m256i zeroes = _mm256_setzero_si256();
+
+  __m256i sa_lo = _mm256_shuffle_epi8(src_nonpremul, alpha_shuffle_lo);
+  __m256i sa_hi = _mm256_shuffle_epi8(src_nonpremul, alpha_shuffle_hi);
+  __m256i ia_lo = _mm256_sub_epi16(u16_0x00FF, sa_lo);
+  __m256i ia_hi = _mm256_sub_epi16(u16_0x00FF, sa_hi);
+  __m256i s = _mm256_or_si256(src_nonpremul, opaque);
+
+  __m256i x_lo = _mm256_add_epi16(
+      _mm256_mullo_epi16(_mm256_unpacklo_epi8(s, zeroes), sa_lo),
+      _mm256_mullo_epi16(_mm256_unpacklo_epi8(dst_premul, zeroes), ia_lo));
+  __m256i x_hi = _mm256_add_epi16(
+      _mm256_mullo_epi16(_mm256_unpackhi_epi8(s, zeroes), sa_hi),
+      _mm256_mullo_epi16(_mm256_unpackhi_epi8(dst_premul, zeroes), ia_hi));
+  __m256i y_lo = _mm256_add_epi16(x_lo, _mm256_srli_epi16(x_lo, 8));
+  __m256i y_hi = _mm256_add_epi16(x_hi, _mm256_srli_epi16(x_hi, 8));
+  __m256i q_lo = _mm256_srli_epi16(
+      _mm256_add_epi16(_mm256_add_epi16(y_lo, u16_0x0001),
+                       _mm256_srli_epi16(y_lo, 8)),
+      8);
+  __m256i q_hi = _mm256_srli_epi16(
+      _mm256_add_epi16(_mm256_add_epi16(y_hi, u16_0x0001),
+                       _mm256_srli_epi16(y_hi, 8)),
+      8);
+  return _mm256_packus_epi16(q_lo, q_hi);
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul_4x16le__src_over(
+wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src_over__avx2(
     uint8_t* dst_ptr,
     size_t dst_len,
     uint8_t* dst_palette_ptr,
@@ -3005,25 +4011,31 @@ wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul_4x16le__src_over(
     const uint8_t* src_ptr,
     size_t src_len) {
   size_t dst_len4 = dst_len / 4;
-  size_t src_len8 = src_len / 8;
-  size_t len = (dst_len4 < src_len8) ? dst_len4 : src_len8;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
   uint8_t* d = dst_ptr;
   const uint8_t* s = src_ptr;
   size_t n = len;
 
-  // TODO: unroll.
+  while (n >= 8) {
+    __m256i x = _mm256_lddqu_si256((const __m256i*)(const void*)s);
+    __m256i y = _mm256_lddqu_si256((const __m256i*)(const void*)d);
+    _mm256_storeu_si256(
+        (__m256i*)(void*)d,
+        wuffs_base__composite_premul_nonpremul_u8x32__avx2(y, x));
+
+    s += 8 * 4;
+    d += 8 * 4;
+    n -= 8;
+  }
 
   while (n >= 1) {
-    uint64_t d0 = wuffs_base__color_u32__as__color_u64(
-        wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4)));
-    uint64_t s0 = wuffs_base__swap_u64_argb_abgr(
-        wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8)));
+    uint32_t d0 = wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4));
+    uint32_t s0 = wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4));
     wuffs_base__poke_u32le__no_bounds_check(
-        d + (0 * 4),
-        wuffs_base__color_u64__as__color_u32(
-            wuffs_base__composite_premul_nonpremul_u64_axxx(d0, s0)));
+        d + (0 * 4), wuffs_base__composite_premul_nonpremul_u32_axxx(d0, s0));
 
-    s += 1 * 8;
+    s += 1 * 4;
     d += 1 * 4;
     n -= 1;
   }
@@ -3031,8 +4043,9 @@ wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul_4x16le__src_over(
   return len;
 }
 
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgra_premul__rgba_premul__src_over(
+wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src_over__avx2(
     uint8_t* dst_ptr,
     size_t dst_len,
     uint8_t* dst_palette_ptr,
@@ -3046,12 +4059,31 @@ wuffs_base__pixel_swizzler__bgra_premul__rgba_premul__src_over(
   const uint8_t* s = src_ptr;
   size_t n = len;
 
+  const __m256i shuffle = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(+0x0F, +0x0C, +0x0D, +0x0E,  //
+                   +0x0B, +0x08, +0x09, +0x0A,  //
+                   +0x07, +0x04, +0x05, +0x06,  //
+                   +0x03, +0x00, +0x01, +0x02));
+
+  while (n >= 8) {
+    __m256i x = _mm256_lddqu_si256((const __m256i*)(const void*)s);
+    __m256i y = _mm256_lddqu_si256((const __m256i*)(const void*)d);
+    x = _mm256_shuffle_epi8(x, shuffle);
+    _mm256_storeu_si256(
+        (__m256i*)(void*)d,
+        wuffs_base__composite_premul_nonpremul_u8x32__avx2(y, x));
+
+    s += 8 * 4;
+    d += 8 * 4;
+    n -= 8;
+  }
+
   while (n >= 1) {
     uint32_t d0 = wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4));
     uint32_t s0 = wuffs_base__swap_u32_argb_abgr(
         wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4)));
     wuffs_base__poke_u32le__no_bounds_check(
-        d + (0 * 4), wuffs_base__composite_premul_premul_u32_axxx(d0, s0));
+        d + (0 * 4), wuffs_base__composite_premul_nonpremul_u32_axxx(d0, s0));
 
     s += 1 * 4;
     d += 1 * 4;
@@ -3060,31 +4092,95 @@ wuffs_base__pixel_swizzler__bgra_premul__rgba_premul__src_over(
 
   return len;
 }
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// ‼ WUFFS MULTI-FILE SECTION -x86_avx2
 
-// --------
+// ‼ WUFFS MULTI-FILE SECTION +x86_sse42
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// wuffs_base__composite_premul_nonpremul_u8x16__sse42 calculates the same
+// (bit-exact) result as wuffs_base__composite_premul_nonpremul_u32_axxx, for 4
+// pixels at a time.
+//
+// That scalar function works with 16-bit color 0x101 * c and divides by
+// 0xFFFF. For each color channel c (and for the alpha channel, if the src
+// alpha channel's value is replaced by 0xFF), it is equivalent to 8-bit math:
+// the result is ((0x101 * x) / 0xFF00), where x = ((s_c * s_a) + (d_c * (0xFF
+// - s_a))) fits in 16 bits. Furthermore, with y = (x + (x >> 8)), that
+// division is ((y + 1 + (y >> 8)) >> 8), all in 16-bit arithmetic.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+static inline __m128i  //
+wuffs_base__composite_premul_nonpremul_u8x16__sse42(
+    __m128i dst_premul,
+    __m128i src_nonpremul) {
+  const __m128i alpha_shuffle_lo =
+      _mm_set_epi8(-0x80, +0x07, -0x80, +0x07, -0x80, +0x07, -0x80, +0x07,  //
+                   -0x80, +0x03, -0x80, +0x03, -0x80, +0x03, -0x80, +0x03);
+  const __m128i alpha_shuffle_hi =
+      _mm_set_epi8(-0x80, +0x0F, -0x80, +0x0F, -0x80, +0x0F, -0x80, +0x0F,  //
+                   -0x80, +0x0B, -0x80, +0x0B, -0x80, +0x0B, -0x80, +0x0B);
+  const __m128i opaque = _mm_set1_epi32((int)0xFF000000u);
+  const __m128i u16_0x00FF = _mm_set1_epi16(0x00FF);
+  const __m128i u16_0x0001 = _mm_set1_epi16(0x0001);
+  const __m128i zeroes = _mm_setzero_si128();
+
+  __m128i sa_lo = _mm_shuffle_epi8(src_nonpremul, alpha_shuffle_lo);
+  __m128i sa_hi = _mm_shuffle_epi8(src_nonpremul, alpha_shuffle_hi);
+  __m128i ia_lo = _mm_sub_epi16(u16_0x00FF, sa_lo);
+  __m128i ia_hi = _mm_sub_epi16(u16_0x00FF, sa_hi);
+  __m128i s = _mm_or_si128(src_nonpremul, opaque);
+
+  __m128i x_lo = _mm_add_epi16(
+      _mm_mullo_epi16(_mm_unpacklo_epi8(s, zeroes), sa_lo),
+      _mm_mullo_epi16(_mm_unpacklo_epi8(dst_premul, zeroes), ia_lo));
+  __m128i x_hi = _mm_add_epi16(
+      _mm_mullo_epi16(_mm_unpackhi_epi8(s, zeroes), sa_hi),
+      _mm_mullo_epi16(_mm_unpackhi_epi8(dst_premul, zeroes), ia_hi));
+  __m128i y_lo = _mm_add_epi16(x_lo, _mm_srli_epi16(x_lo, 8));
+  __m128i y_hi = _mm_add_epi16(x_hi, _mm_srli_epi16(x_hi, 8));
+  __m128i q_lo = _mm_srli_epi16(
+      _mm_add_epi16(_mm_add_epi16(y_lo, u16_0x0001), _mm_srli_epi16(y_lo, 8)),
+      8);
+  __m128i q_hi = _mm_srli_epi16(
+      _mm_add_epi16(_mm_add_epi16(y_hi, u16_0x0001), _mm_srli_epi16(y_hi, 8)),
+      8);
+  return _mm_packus_epi16(q_lo, q_hi);
+}
 
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgrw__bgr(uint8_t* dst_ptr,
-                                      size_t dst_len,
-                                      uint8_t* dst_palette_ptr,
-                                      size_t dst_palette_len,
-                                      const uint8_t* src_ptr,
-                                      size_t src_len) {
+wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src_over__sse42(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
   size_t dst_len4 = dst_len / 4;
-  size_t src_len3 = src_len / 3;
-  size_t len = (dst_len4 < src_len3) ? dst_len4 : src_len3;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
   uint8_t* d = dst_ptr;
   const uint8_t* s = src_ptr;
   size_t n = len;
 
-  // TODO: unroll.
+  while (n >= 4) {
+    __m128i x = _mm_lddqu_si128((const __m128i*)(const void*)s);
+    __m128i y = _mm_lddqu_si128((const __m128i*)(const void*)d);
+    _mm_storeu_si128(
+        (__m128i*)(void*)d,
+        wuffs_base__composite_premul_nonpremul_u8x16__sse42(y, x));
+
+    s += 4 * 4;
+    d += 4 * 4;
+    n -= 4;
+  }
 
   while (n >= 1) {
+    uint32_t d0 = wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4));
+    uint32_t s0 = wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4));
     wuffs_base__poke_u32le__no_bounds_check(
-        d + (0 * 4),
-        0xFF000000 | wuffs_base__peek_u24le__no_bounds_check(s + (0 * 3)));
+        d + (0 * 4), wuffs_base__composite_premul_nonpremul_u32_axxx(d0, s0));
 
-    s += 1 * 3;
+    s += 1 * 4;
     d += 1 * 4;
     n -= 1;
   }
@@ -3092,42 +4188,65 @@ wuffs_base__pixel_swizzler__bgrw__bgr(uint8_t* dst_ptr,
   return len;
 }
 
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgrw__bgr_565(uint8_t* dst_ptr,
-                                          size_t dst_len,
-                                          uint8_t* dst_palette_ptr,
-                                          size_t dst_palette_len,
-                                          const uint8_t* src_ptr,
-                                          size_t src_len) {
+wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src_over__sse42(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
   size_t dst_len4 = dst_len / 4;
-  size_t src_len2 = src_len / 2;
-  size_t len = (dst_len4 < src_len2) ? dst_len4 : src_len2;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
   uint8_t* d = dst_ptr;
   const uint8_t* s = src_ptr;
   size_t n = len;
 
-  // TODO: unroll.
+  const __m128i shuffle = _mm_set_epi8(+0x0F, +0x0C, +0x0D, +0x0E,  //
+                                       +0x0B, +0x08, +0x09, +0x0A,  //
+                                       +0x07, +0x04, +0x05, +0x06,  //
+                                       +0x03, +0x00, +0x01, +0x02);
+
+  while (n >= 4) {
+    __m128i x = _mm_lddqu_si128((const __m128i*)(const void*)s);
+    __m128i y = _mm_lddqu_si128((const __m128i*)(const void*)d);
+    x = _mm_shuffle_epi8(x, shuffle);
+    _mm_storeu_si128(
+        (__m128i*)(void*)d,
+        wuffs_base__composite_premul_nonpremul_u8x16__sse42(y, x));
+
+    s += 4 * 4;
+    d += 4 * 4;
+    n -= 4;
+  }
 
   while (n >= 1) {
+    uint32_t d0 = wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4));
+    uint32_t s0 = wuffs_base__swap_u32_argb_abgr(
+        wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4)));
     wuffs_base__poke_u32le__no_bounds_check(
-        d + (0 * 4), wuffs_base__color_u16_rgb_565__as__color_u32_argb_premul(
-                         wuffs_base__peek_u16le__no_bounds_check(s + (0 * 2))));
+        d + (0 * 4), wuffs_base__composite_premul_nonpremul_u32_axxx(d0, s0));
 
-    s += 1 * 2;
+    s += 1 * 4;
     d += 1 * 4;
     n -= 1;
   }
 
   return len;
 }
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// ‼ WUFFS MULTI-FILE SECTION -x86_sse42
 
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgrw__bgrx(uint8_t* dst_ptr,
-                                       size_t dst_len,
-                                       uint8_t* dst_palette_ptr,
-                                       size_t dst_palette_len,
-                                       const uint8_t* src_ptr,
-                                       size_t src_len) {
+wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src_over(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
   size_t dst_len4 = dst_len / 4;
   size_t src_len4 = src_len / 4;
   size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
@@ -3138,9 +4257,10 @@ wuffs_base__pixel_swizzler__bgrw__bgrx(uint8_t* dst_ptr,
   // TODO: unroll.
 
   while (n >= 1) {
+    uint32_t d0 = wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4));
+    uint32_t s0 = wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4));
     wuffs_base__poke_u32le__no_bounds_check(
-        d + (0 * 4),
-        0xFF000000 | wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4)));
+        d + (0 * 4), wuffs_base__composite_premul_nonpremul_u32_axxx(d0, s0));
 
     s += 1 * 4;
     d += 1 * 4;
@@ -3150,87 +4270,64 @@ wuffs_base__pixel_swizzler__bgrw__bgrx(uint8_t* dst_ptr,
   return len;
 }
 
-// ‼ WUFFS MULTI-FILE SECTION +x86_sse42
-#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
-WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgrw__rgb__sse42(uint8_t* dst_ptr,
-                                             size_t dst_len,
-                                             uint8_t* dst_palette_ptr,
-                                             size_t dst_palette_len,
-                                             const uint8_t* src_ptr,
-                                             size_t src_len) {
+wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul_4x16le__src_over(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
   size_t dst_len4 = dst_len / 4;
-  size_t src_len3 = src_len / 3;
-  size_t len = (dst_len4 < src_len3) ? dst_len4 : src_len3;
+  size_t src_len8 = src_len / 8;
+  size_t len = (dst_len4 < src_len8) ? dst_len4 : src_len8;
   uint8_t* d = dst_ptr;
   const uint8_t* s = src_ptr;
   size_t n = len;
 
-  __m128i shuffle = _mm_set_epi8(+0x00, +0x09, +0x0A, +0x0B,  //
-                                 +0x00, +0x06, +0x07, +0x08,  //
-                                 +0x00, +0x03, +0x04, +0x05,  //
-                                 +0x00, +0x00, +0x01, +0x02);
-  __m128i or_ff = _mm_set_epi8(-0x01, +0x00, +0x00, +0x00,  //
-                               -0x01, +0x00, +0x00, +0x00,  //
-                               -0x01, +0x00, +0x00, +0x00,  //
-                               -0x01, +0x00, +0x00, +0x00);
-
-  while (n >= 6) {
-    __m128i x;
-    x = _mm_lddqu_si128((const __m128i*)(const void*)s);
-    x = _mm_shuffle_epi8(x, shuffle);
-    x = _mm_or_si128(x, or_ff);
-    _mm_storeu_si128((__m128i*)(void*)d, x);
-
-    s += 4 * 3;
-    d += 4 * 4;
-    n -= 4;
-  }
+  // TODO: unroll.
 
   while (n >= 1) {
-    uint8_t b0 = s[0];
-    uint8_t b1 = s[1];
-    uint8_t b2 = s[2];
-    d[0] = b2;
-    d[1] = b1;
-    d[2] = b0;
-    d[3] = 0xFF;
+    uint64_t d0 = wuffs_base__color_u32__as__color_u64(
+        wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4)));
+    uint64_t s0 = wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4),
+        wuffs_base__color_u64__as__color_u32(
+            wuffs_base__composite_premul_nonpremul_u64_axxx(d0, s0)));
 
-    s += 1 * 3;
+    s += 1 * 8;
     d += 1 * 4;
     n -= 1;
   }
 
   return len;
 }
-#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
-// ‼ WUFFS MULTI-FILE SECTION -x86_sse42
 
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgrw__rgb(uint8_t* dst_ptr,
-                                      size_t dst_len,
-                                      uint8_t* dst_palette_ptr,
-                                      size_t dst_palette_len,
-                                      const uint8_t* src_ptr,
-                                      size_t src_len) {
+wuffs_base__pixel_swizzler__bgra_premul__bgra_premul__src_over(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
   size_t dst_len4 = dst_len / 4;
-  size_t src_len3 = src_len / 3;
-  size_t len = (dst_len4 < src_len3) ? dst_len4 : src_len3;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
   uint8_t* d = dst_ptr;
   const uint8_t* s = src_ptr;
   size_t n = len;
 
+  // TODO: unroll.
+
   while (n >= 1) {
-    uint8_t b0 = s[0];
-    uint8_t b1 = s[1];
-    uint8_t b2 = s[2];
-    d[0] = b2;
-    d[1] = b1;
-    d[2] = b0;
-    d[3] = 0xFF;
+    uint32_t d0 = wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4));
+    uint32_t s0 = wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4), wuffs_base__composite_premul_premul_u32_axxx(d0, s0));
 
-    s += 1 * 3;
+    s += 1 * 4;
     d += 1 * 4;
     n -= 1;
   }
@@ -3239,12 +4336,840 @@ wuffs_base__pixel_swizzler__bgrw__rgb(uint8_t* dst_ptr,
 }
 
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgrw__rgbx(uint8_t* dst_ptr,
-                                       size_t dst_len,
-                                       uint8_t* dst_palette_ptr,
-                                       size_t dst_palette_len,
-                                       const uint8_t* src_ptr,
-                                       size_t src_len) {
+wuffs_base__pixel_swizzler__bgra_premul__index_bgra_nonpremul__src_over(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  if (dst_palette_len !=
+      WUFFS_BASE__PIXEL_FORMAT__INDEXED__PALETTE_BYTE_LENGTH) {
+    return 0;
+  }
+  size_t dst_len4 = dst_len / 4;
+  size_t len = (dst_len4 < src_len) ? dst_len4 : src_len;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  // TODO: unroll.
+
+  while (n >= 1) {
+    uint32_t d0 = wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4));
+    uint32_t s0 = wuffs_base__peek_u32le__no_bounds_check(dst_palette_ptr +
+                                                          ((size_t)s[0] * 4));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4), wuffs_base__composite_premul_nonpremul_u32_axxx(d0, s0));
+
+    s += 1 * 1;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+// ‼ WUFFS MULTI-FILE SECTION +arm_neon
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src__neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 8) {
+    uint8x8x4_t x = vld4_u8(s);
+    uint8x8x4_t y;
+    y.val[0] = wuffs_base__premul_u8x8__neon(x.val[2], x.val[3]);
+    y.val[1] = wuffs_base__premul_u8x8__neon(x.val[1], x.val[3]);
+    y.val[2] = wuffs_base__premul_u8x8__neon(x.val[0], x.val[3]);
+    y.val[3] = x.val[3];
+    vst4_u8(d, y);
+
+    s += 8 * 4;
+    d += 8 * 4;
+    n -= 8;
+  }
+
+  while (n >= 1) {
+    uint32_t s0 = wuffs_base__swap_u32_argb_abgr(
+        wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4)));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4),
+        wuffs_base__color_u32_argb_nonpremul__as__color_u32_argb_premul(s0));
+
+    s += 1 * 4;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+// ‼ WUFFS MULTI-FILE SECTION -arm_neon
+
+// ‼ WUFFS MULTI-FILE SECTION +wasm_simd128
+#if defined(WUFFS_BASE__CPU_ARCH__WASM_SIMD128)
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src__wasm_simd128(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 4) {
+    v128_t x = wasm_v128_load(s);
+    x = wasm_i8x16_shuffle(x, x,                  //
+                           0x02, 0x01, 0x00, 0x03,  //
+                           0x06, 0x05, 0x04, 0x07,  //
+                           0x0A, 0x09, 0x08, 0x0B,  //
+                           0x0E, 0x0D, 0x0C, 0x0F);
+    wasm_v128_store(d, wuffs_base__premul_u8x16__wasm_simd128(x));
+
+    s += 4 * 4;
+    d += 4 * 4;
+    n -= 4;
+  }
+
+  while (n >= 1) {
+    uint32_t s0 = wuffs_base__swap_u32_argb_abgr(
+        wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4)));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4),
+        wuffs_base__color_u32_argb_nonpremul__as__color_u32_argb_premul(s0));
+
+    s += 1 * 4;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__WASM_SIMD128)
+// ‼ WUFFS MULTI-FILE SECTION -wasm_simd128
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  // TODO: unroll.
+
+  while (n >= 1) {
+    uint32_t s0 = wuffs_base__swap_u32_argb_abgr(
+        wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4)));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4),
+        wuffs_base__color_u32_argb_nonpremul__as__color_u32_argb_premul(s0));
+
+    s += 1 * 4;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src_over(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  // TODO: unroll.
+
+  while (n >= 1) {
+    uint32_t d0 = wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4));
+    uint32_t s0 = wuffs_base__swap_u32_argb_abgr(
+        wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4)));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4), wuffs_base__composite_premul_nonpremul_u32_axxx(d0, s0));
+
+    s += 1 * 4;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+// ‼ WUFFS MULTI-FILE SECTION +arm_neon
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul_4x16le__src__neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len8 = src_len / 8;
+  size_t len = (dst_len4 < src_len8) ? dst_len4 : src_len8;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 8) {
+    uint16x8x4_t x = vld4q_u16((const uint16_t*)(const void*)s);
+    uint8x8x4_t y;
+    y.val[0] = wuffs_base__premul_u16x8__neon(x.val[2], x.val[3]);
+    y.val[1] = wuffs_base__premul_u16x8__neon(x.val[1], x.val[3]);
+    y.val[2] = wuffs_base__premul_u16x8__neon(x.val[0], x.val[3]);
+    y.val[3] = vshrn_n_u16(x.val[3], 8);
+    vst4_u8(d, y);
+
+    s += 8 * 8;
+    d += 8 * 4;
+    n -= 8;
+  }
+
+  while (n >= 1) {
+    uint64_t s0 = wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4),
+        wuffs_base__swap_u32_argb_abgr(
+            wuffs_base__color_u64_argb_nonpremul__as__color_u32_argb_premul(
+                s0)));
+
+    s += 1 * 8;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+// ‼ WUFFS MULTI-FILE SECTION -arm_neon
+
+// ‼ WUFFS MULTI-FILE SECTION +x86_avx2
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul_4x16le__src__avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len8 = src_len / 8;
+  size_t len = (dst_len4 < src_len8) ? dst_len4 : src_len8;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  const __m256i shuffle = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(+0x0F, +0x0C, +0x0D, +0x0E,  //
+                   +0x0B, +0x08, +0x09, +0x0A,  //
+                   +0x07, +0x04, +0x05, +0x06,  //
+                   +0x03, +0x00, +0x01, +0x02));
+
+  while (n >= 8) {
+    __m256i x0 = _mm256_lddqu_si256((const __m256i*)(const void*)(s + 0x00));
+    __m256i x1 = _mm256_lddqu_si256((const __m256i*)(const void*)(s + 0x20));
+    __m256i y = _mm256_packus_epi16(wuffs_base__premul_u16x16__avx2(x0),
+                                    wuffs_base__premul_u16x16__avx2(x1));
+    y = _mm256_shuffle_epi8(y, shuffle);
+    _mm256_storeu_si256((__m256i*)(void*)d,
+                        _mm256_permute4x64_epi64(y, 0xD8));
+
+    s += 8 * 8;
+    d += 8 * 4;
+    n -= 8;
+  }
+
+  while (n >= 1) {
+    uint64_t s0 = wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4),
+        wuffs_base__swap_u32_argb_abgr(
+            wuffs_base__color_u64_argb_nonpremul__as__color_u32_argb_premul(
+                s0)));
+
+    s += 1 * 8;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// ‼ WUFFS MULTI-FILE SECTION -x86_avx2
+
+// ‼ WUFFS MULTI-FILE SECTION +x86_sse42
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul_4x16le__src__sse42(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len8 = src_len / 8;
+  size_t len = (dst_len4 < src_len8) ? dst_len4 : src_len8;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  const __m128i shuffle = _mm_set_epi8(+0x0F, +0x0C, +0x0D, +0x0E,  //
+                                       +0x0B, +0x08, +0x09, +0x0A,  //
+                                       +0x07, +0x04, +0x05, +0x06,  //
+                                       +0x03, +0x00, +0x01, +0x02);
+
+  while (n >= 4) {
+    __m128i x0 = _mm_lddqu_si128((const __m128i*)(const void*)(s + 0x00));
+    __m128i x1 = _mm_lddqu_si128((const __m128i*)(const void*)(s + 0x10));
+    __m128i y = _mm_packus_epi16(wuffs_base__premul_u16x8__sse42(x0),
+                                 wuffs_base__premul_u16x8__sse42(x1));
+    _mm_storeu_si128((__m128i*)(void*)d, _mm_shuffle_epi8(y, shuffle));
+
+    s += 4 * 8;
+    d += 4 * 4;
+    n -= 4;
+  }
+
+  while (n >= 1) {
+    uint64_t s0 = wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4),
+        wuffs_base__swap_u32_argb_abgr(
+            wuffs_base__color_u64_argb_nonpremul__as__color_u32_argb_premul(
+                s0)));
+
+    s += 1 * 8;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// ‼ WUFFS MULTI-FILE SECTION -x86_sse42
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul_4x16le__src(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len8 = src_len / 8;
+  size_t len = (dst_len4 < src_len8) ? dst_len4 : src_len8;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  // TODO: unroll.
+
+  while (n >= 1) {
+    uint64_t s0 = wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4),
+        wuffs_base__swap_u32_argb_abgr(
+            wuffs_base__color_u64_argb_nonpremul__as__color_u32_argb_premul(
+                s0)));
+
+    s += 1 * 8;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul_4x16le__src_over(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len8 = src_len / 8;
+  size_t len = (dst_len4 < src_len8) ? dst_len4 : src_len8;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  // TODO: unroll.
+
+  while (n >= 1) {
+    uint64_t d0 = wuffs_base__color_u32__as__color_u64(
+        wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4)));
+    uint64_t s0 = wuffs_base__swap_u64_argb_abgr(
+        wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8)));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4),
+        wuffs_base__color_u64__as__color_u32(
+            wuffs_base__composite_premul_nonpremul_u64_axxx(d0, s0)));
+
+    s += 1 * 8;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__rgba_premul__src_over(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 1) {
+    uint32_t d0 = wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4));
+    uint32_t s0 = wuffs_base__swap_u32_argb_abgr(
+        wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4)));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4), wuffs_base__composite_premul_premul_u32_axxx(d0, s0));
+
+    s += 1 * 4;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+// --------
+
+// ‼ WUFFS MULTI-FILE SECTION +arm_neon
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgrw__bgr__neon(uint8_t* dst_ptr,
+                                            size_t dst_len,
+                                            uint8_t* dst_palette_ptr,
+                                            size_t dst_palette_len,
+                                            const uint8_t* src_ptr,
+                                            size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len3 = src_len / 3;
+  size_t len = (dst_len4 < src_len3) ? dst_len4 : src_len3;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 16) {
+    uint8x16x3_t x = vld3q_u8(s);
+    uint8x16x4_t y;
+    y.val[0] = x.val[0];
+    y.val[1] = x.val[1];
+    y.val[2] = x.val[2];
+    y.val[3] = vdupq_n_u8(0xFF);
+    vst4q_u8(d, y);
+
+    s += 16 * 3;
+    d += 16 * 4;
+    n -= 16;
+  }
+
+  while (n >= 1) {
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4),
+        0xFF000000 | wuffs_base__peek_u24le__no_bounds_check(s + (0 * 3)));
+
+    s += 1 * 3;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+// ‼ WUFFS MULTI-FILE SECTION -arm_neon
+
+// ‼ WUFFS MULTI-FILE SECTION +wasm_simd128
+#if defined(WUFFS_BASE__CPU_ARCH__WASM_SIMD128)
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgrw__bgr__wasm_simd128(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len3 = src_len / 3;
+  size_t len = (dst_len4 < src_len3) ? dst_len4 : src_len3;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  // Each 16-byte load spans 5 and a bit source pixels, of which only the first
+  // 4 are used, hence the "n >= 6" below. Shuffle indexes 0x10 and up select
+  // from the second argument (all 0xFF), for the alpha channel.
+  const v128_t u8_0xFF = wasm_u8x16_splat(0xFF);
+
+  while (n >= 6) {
+    v128_t x = wasm_v128_load(s);
+    x = wasm_i8x16_shuffle(x, u8_0xFF,  //
+                           0x00, 0x01, 0x02, 0x10,  //
+                           0x03, 0x04, 0x05, 0x10,  //
+                           0x06, 0x07, 0x08, 0x10,  //
+                           0x09, 0x0A, 0x0B, 0x10);
+    wasm_v128_store(d, x);
+
+    s += 4 * 3;
+    d += 4 * 4;
+    n -= 4;
+  }
+
+  while (n >= 1) {
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4),
+        0xFF000000 | wuffs_base__peek_u24le__no_bounds_check(s + (0 * 3)));
+
+    s += 1 * 3;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__WASM_SIMD128)
+// ‼ WUFFS MULTI-FILE SECTION -wasm_simd128
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgrw__bgr(uint8_t* dst_ptr,
+                                      size_t dst_len,
+                                      uint8_t* dst_palette_ptr,
+                                      size_t dst_palette_len,
+                                      const uint8_t* src_ptr,
+                                      size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len3 = src_len / 3;
+  size_t len = (dst_len4 < src_len3) ? dst_len4 : src_len3;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  // TODO: unroll.
+
+  while (n >= 1) {
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4),
+        0xFF000000 | wuffs_base__peek_u24le__no_bounds_check(s + (0 * 3)));
+
+    s += 1 * 3;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgrw__bgr_565(uint8_t* dst_ptr,
+                                          size_t dst_len,
+                                          uint8_t* dst_palette_ptr,
+                                          size_t dst_palette_len,
+                                          const uint8_t* src_ptr,
+                                          size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len2 = src_len / 2;
+  size_t len = (dst_len4 < src_len2) ? dst_len4 : src_len2;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  // TODO: unroll.
+
+  while (n >= 1) {
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4), wuffs_base__color_u16_rgb_565__as__color_u32_argb_premul(
+                         wuffs_base__peek_u16le__no_bounds_check(s + (0 * 2))));
+
+    s += 1 * 2;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgrw__bgrx(uint8_t* dst_ptr,
+                                       size_t dst_len,
+                                       uint8_t* dst_palette_ptr,
+                                       size_t dst_palette_len,
+                                       const uint8_t* src_ptr,
+                                       size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  // TODO: unroll.
+
+  while (n >= 1) {
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4),
+        0xFF000000 | wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4)));
+
+    s += 1 * 4;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+// ‼ WUFFS MULTI-FILE SECTION +arm_neon
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgrw__rgb__neon(uint8_t* dst_ptr,
+                                            size_t dst_len,
+                                            uint8_t* dst_palette_ptr,
+                                            size_t dst_palette_len,
+                                            const uint8_t* src_ptr,
+                                            size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len3 = src_len / 3;
+  size_t len = (dst_len4 < src_len3) ? dst_len4 : src_len3;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 16) {
+    uint8x16x3_t x = vld3q_u8(s);
+    uint8x16x4_t y;
+    y.val[0] = x.val[2];
+    y.val[1] = x.val[1];
+    y.val[2] = x.val[0];
+    y.val[3] = vdupq_n_u8(0xFF);
+    vst4q_u8(d, y);
+
+    s += 16 * 3;
+    d += 16 * 4;
+    n -= 16;
+  }
+
+  while (n >= 1) {
+    uint8_t b0 = s[0];
+    uint8_t b1 = s[1];
+    uint8_t b2 = s[2];
+    d[0] = b2;
+    d[1] = b1;
+    d[2] = b0;
+    d[3] = 0xFF;
+
+    s += 1 * 3;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+// ‼ WUFFS MULTI-FILE SECTION -arm_neon
+
+// ‼ WUFFS MULTI-FILE SECTION +wasm_simd128
+#if defined(WUFFS_BASE__CPU_ARCH__WASM_SIMD128)
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgrw__rgb__wasm_simd128(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len3 = src_len / 3;
+  size_t len = (dst_len4 < src_len3) ? dst_len4 : src_len3;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  // Each 16-byte load spans 5 and a bit source pixels, of which only the first
+  // 4 are used, hence the "n >= 6" below. Shuffle indexes 0x10 and up select
+  // from the second argument (all 0xFF), for the alpha channel.
+  const v128_t u8_0xFF = wasm_u8x16_splat(0xFF);
+
+  while (n >= 6) {
+    v128_t x = wasm_v128_load(s);
+    x = wasm_i8x16_shuffle(x, u8_0xFF,  //
+                           0x02, 0x01, 0x00, 0x10,  //
+                           0x05, 0x04, 0x03, 0x10,  //
+                           0x08, 0x07, 0x06, 0x10,  //
+                           0x0B, 0x0A, 0x09, 0x10);
+    wasm_v128_store(d, x);
+
+    s += 4 * 3;
+    d += 4 * 4;
+    n -= 4;
+  }
+
+  while (n >= 1) {
+    uint8_t b0 = s[0];
+    uint8_t b1 = s[1];
+    uint8_t b2 = s[2];
+    d[0] = b2;
+    d[1] = b1;
+    d[2] = b0;
+    d[3] = 0xFF;
+
+    s += 1 * 3;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__WASM_SIMD128)
+// ‼ WUFFS MULTI-FILE SECTION -wasm_simd128
+
+// ‼ WUFFS MULTI-FILE SECTION +x86_sse42
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgrw__rgb__sse42(uint8_t* dst_ptr,
+                                             size_t dst_len,
+                                             uint8_t* dst_palette_ptr,
+                                             size_t dst_palette_len,
+                                             const uint8_t* src_ptr,
+                                             size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len3 = src_len / 3;
+  size_t len = (dst_len4 < src_len3) ? dst_len4 : src_len3;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  __m128i shuffle = _mm_set_epi8(+0x00, +0x09, +0x0A, +0x0B,  //
+                                 +0x00, +0x06, +0x07, +0x08,  //
+                                 +0x00, +0x03, +0x04, +0x05,  //
+                                 +0x00, +0x00, +0x01, +0x02);
+  __m128i or_ff = _mm_set_epi8(-0x01, +0x00, +0x00, +0x00,  //
+                               -0x01, +0x00, +0x00, +0x00,  //
+                               -0x01, +0x00, +0x00, +0x00,  //
+                               -0x01, +0x00, +0x00, +0x00);
+
+  while (n >= 6) {
+    __m128i x;
+    x = _mm_lddqu_si128((const __m128i*)(const void*)s);
+    x = _mm_shuffle_epi8(x, shuffle);
+    x = _mm_or_si128(x, or_ff);
+    _mm_storeu_si128((__m128i*)(void*)d, x);
+
+    s += 4 * 3;
+    d += 4 * 4;
+    n -= 4;
+  }
+
+  while (n >= 1) {
+    uint8_t b0 = s[0];
+    uint8_t b1 = s[1];
+    uint8_t b2 = s[2];
+    d[0] = b2;
+    d[1] = b1;
+    d[2] = b0;
+    d[3] = 0xFF;
+
+    s += 1 * 3;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// ‼ WUFFS MULTI-FILE SECTION -x86_sse42
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgrw__rgb(uint8_t* dst_ptr,
+                                      size_t dst_len,
+                                      uint8_t* dst_palette_ptr,
+                                      size_t dst_palette_len,
+                                      const uint8_t* src_ptr,
+                                      size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len3 = src_len / 3;
+  size_t len = (dst_len4 < src_len3) ? dst_len4 : src_len3;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 1) {
+    uint8_t b0 = s[0];
+    uint8_t b1 = s[1];
+    uint8_t b2 = s[2];
+    d[0] = b2;
+    d[1] = b1;
+    d[2] = b0;
+    d[3] = 0xFF;
+
+    s += 1 * 3;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgrw__rgbx(uint8_t* dst_ptr,
+                                       size_t dst_len,
+                                       uint8_t* dst_palette_ptr,
+                                       size_t dst_palette_len,
+                                       const uint8_t* src_ptr,
+                                       size_t src_len) {
   size_t dst_len4 = dst_len / 4;
   size_t src_len4 = src_len / 4;
   size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
@@ -3273,6 +5198,73 @@ wuffs_base__pixel_swizzler__bgrw__rgbx(uint8_t* dst_ptr,
 
 // --------
 
+// ‼ WUFFS MULTI-FILE SECTION +x86_sse42
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgrw_4x16le__bgr__sse42(uint8_t* dst_ptr,
+                                                    size_t dst_len,
+                                                    uint8_t* dst_palette_ptr,
+                                                    size_t dst_palette_len,
+                                                    const uint8_t* src_ptr,
+                                                    size_t src_len) {
+  size_t dst_len8 = dst_len / 8;
+  size_t src_len3 = src_len / 3;
+  size_t len = (dst_len8 < src_len3) ? dst_len8 : src_len3;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  // Each shuffle duplicates the B, G and R bytes of two pixels, giving (0x101
+  // * c). The alpha bytes are zero, until or_ffff sets them.
+  __m128i shuffle0 = _mm_set_epi8(-0x80, -0x80, +0x05, +0x05,  //
+                                  +0x04, +0x04, +0x03, +0x03,  //
+                                  -0x80, -0x80, +0x02, +0x02,  //
+                                  +0x01, +0x01, +0x00, +0x00);
+  __m128i shuffle1 = _mm_set_epi8(-0x80, -0x80, +0x0B, +0x0B,  //
+                                  +0x0A, +0x0A, +0x09, +0x09,  //
+                                  -0x80, -0x80, +0x08, +0x08,  //
+                                  +0x07, +0x07, +0x06, +0x06);
+  __m128i or_ffff = _mm_set_epi8(-0x01, -0x01, +0x00, +0x00,  //
+                                 +0x00, +0x00, +0x00, +0x00,  //
+                                 -0x01, -0x01, +0x00, +0x00,  //
+                                 +0x00, +0x00, +0x00, +0x00);
+
+  while (n >= 6) {
+    __m128i x = _mm_lddqu_si128((const __m128i*)(const void*)s);
+    _mm_storeu_si128((__m128i*)(void*)(d + 0x00),
+                     _mm_or_si128(_mm_shuffle_epi8(x, shuffle0), or_ffff));
+    _mm_storeu_si128((__m128i*)(void*)(d + 0x10),
+                     _mm_or_si128(_mm_shuffle_epi8(x, shuffle1), or_ffff));
+
+    s += 4 * 3;
+    d += 4 * 8;
+    n -= 4;
+  }
+
+  while (n >= 1) {
+    uint8_t s0 = s[0];
+    uint8_t s1 = s[1];
+    uint8_t s2 = s[2];
+    d[0] = s0;
+    d[1] = s0;
+    d[2] = s1;
+    d[3] = s1;
+    d[4] = s2;
+    d[5] = s2;
+    d[6] = 0xFF;
+    d[7] = 0xFF;
+
+    s += 1 * 3;
+    d += 1 * 8;
+    n -= 1;
+  }
+
+  return len;
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// ‼ WUFFS MULTI-FILE SECTION -x86_sse42
+
 static uint64_t  //
 wuffs_base__pixel_swizzler__bgrw_4x16le__bgr(uint8_t* dst_ptr,
                                              size_t dst_len,
@@ -3337,6 +5329,73 @@ wuffs_base__pixel_swizzler__bgrw_4x16le__bgr_565(uint8_t* dst_ptr,
   return len;
 }
 
+// ‼ WUFFS MULTI-FILE SECTION +x86_sse42
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgrw_4x16le__bgrx__sse42(uint8_t* dst_ptr,
+                                                     size_t dst_len,
+                                                     uint8_t* dst_palette_ptr,
+                                                     size_t dst_palette_len,
+                                                     const uint8_t* src_ptr,
+                                                     size_t src_len) {
+  size_t dst_len8 = dst_len / 8;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len8 < src_len4) ? dst_len8 : src_len4;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  // Each shuffle duplicates the B, G and R bytes of two pixels, giving (0x101
+  // * c). The alpha bytes are zero, until or_ffff sets them.
+  __m128i shuffle0 = _mm_set_epi8(-0x80, -0x80, +0x06, +0x06,  //
+                                  +0x05, +0x05, +0x04, +0x04,  //
+                                  -0x80, -0x80, +0x02, +0x02,  //
+                                  +0x01, +0x01, +0x00, +0x00);
+  __m128i shuffle1 = _mm_set_epi8(-0x80, -0x80, +0x0E, +0x0E,  //
+                                  +0x0D, +0x0D, +0x0C, +0x0C,  //
+                                  -0x80, -0x80, +0x0A, +0x0A,  //
+                                  +0x09, +0x09, +0x08, +0x08);
+  __m128i or_ffff = _mm_set_epi8(-0x01, -0x01, +0x00, +0x00,  //
+                                 +0x00, +0x00, +0x00, +0x00,  //
+                                 -0x01, -0x01, +0x00, +0x00,  //
+                                 +0x00, +0x00, +0x00, +0x00);
+
+  while (n >= 4) {
+    __m128i x = _mm_lddqu_si128((const __m128i*)(const void*)s);
+    _mm_storeu_si128((__m128i*)(void*)(d + 0x00),
+                     _mm_or_si128(_mm_shuffle_epi8(x, shuffle0), or_ffff));
+    _mm_storeu_si128((__m128i*)(void*)(d + 0x10),
+                     _mm_or_si128(_mm_shuffle_epi8(x, shuffle1), or_ffff));
+
+    s += 4 * 4;
+    d += 4 * 8;
+    n -= 4;
+  }
+
+  while (n >= 1) {
+    uint8_t s0 = s[0];
+    uint8_t s1 = s[1];
+    uint8_t s2 = s[2];
+    d[0] = s0;
+    d[1] = s0;
+    d[2] = s1;
+    d[3] = s1;
+    d[4] = s2;
+    d[5] = s2;
+    d[6] = 0xFF;
+    d[7] = 0xFF;
+
+    s += 1 * 4;
+    d += 1 * 8;
+    n -= 1;
+  }
+
+  return len;
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// ‼ WUFFS MULTI-FILE SECTION -x86_sse42
+
 static uint64_t  //
 wuffs_base__pixel_swizzler__bgrw_4x16le__bgrx(uint8_t* dst_ptr,
                                               size_t dst_len,
@@ -3372,6 +5431,73 @@ wuffs_base__pixel_swizzler__bgrw_4x16le__bgrx(uint8_t* dst_ptr,
   return len;
 }
 
+// ‼ WUFFS MULTI-FILE SECTION +x86_sse42
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgrw_4x16le__rgb__sse42(uint8_t* dst_ptr,
+                                                    size_t dst_len,
+                                                    uint8_t* dst_palette_ptr,
+                                                    size_t dst_palette_len,
+                                                    const uint8_t* src_ptr,
+                                                    size_t src_len) {
+  size_t dst_len8 = dst_len / 8;
+  size_t src_len3 = src_len / 3;
+  size_t len = (dst_len8 < src_len3) ? dst_len8 : src_len3;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  // Each shuffle swaps and duplicates the R, G and B bytes of two pixels,
+  // giving (0x101 * c). The alpha bytes are zero, until or_ffff sets them.
+  __m128i shuffle0 = _mm_set_epi8(-0x80, -0x80, +0x03, +0x03,  //
+                                  +0x04, +0x04, +0x05, +0x05,  //
+                                  -0x80, -0x80, +0x00, +0x00,  //
+                                  +0x01, +0x01, +0x02, +0x02);
+  __m128i shuffle1 = _mm_set_epi8(-0x80, -0x80, +0x09, +0x09,  //
+                                  +0x0A, +0x0A, +0x0B, +0x0B,  //
+                                  -0x80, -0x80, +0x06, +0x06,  //
+                                  +0x07, +0x07, +0x08, +0x08);
+  __m128i or_ffff = _mm_set_epi8(-0x01, -0x01, +0x00, +0x00,  //
+                                 +0x00, +0x00, +0x00, +0x00,  //
+                                 -0x01, -0x01, +0x00, +0x00,  //
+                                 +0x00, +0x00, +0x00, +0x00);
+
+  while (n >= 6) {
+    __m128i x = _mm_lddqu_si128((const __m128i*)(const void*)s);
+    _mm_storeu_si128((__m128i*)(void*)(d + 0x00),
+                     _mm_or_si128(_mm_shuffle_epi8(x, shuffle0), or_ffff));
+    _mm_storeu_si128((__m128i*)(void*)(d + 0x10),
+                     _mm_or_si128(_mm_shuffle_epi8(x, shuffle1), or_ffff));
+
+    s += 4 * 3;
+    d += 4 * 8;
+    n -= 4;
+  }
+
+  while (n >= 1) {
+    uint8_t s0 = s[0];
+    uint8_t s1 = s[1];
+    uint8_t s2 = s[2];
+    d[0] = s2;
+    d[1] = s2;
+    d[2] = s1;
+    d[3] = s1;
+    d[4] = s0;
+    d[5] = s0;
+    d[6] = 0xFF;
+    d[7] = 0xFF;
+
+    s += 1 * 3;
+    d += 1 * 8;
+    n -= 1;
+  }
+
+  return len;
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// ‼ WUFFS MULTI-FILE SECTION -x86_sse42
+
 static uint64_t  //
 wuffs_base__pixel_swizzler__bgrw_4x16le__rgb(uint8_t* dst_ptr,
                                              size_t dst_len,
@@ -3387,27 +5513,122 @@ wuffs_base__pixel_swizzler__bgrw_4x16le__rgb(uint8_t* dst_ptr,
   size_t n = len;
 
   while (n >= 1) {
-    uint8_t s0 = s[0];
-    uint8_t s1 = s[1];
-    uint8_t s2 = s[2];
-    d[0] = s2;
-    d[1] = s2;
-    d[2] = s1;
-    d[3] = s1;
-    d[4] = s0;
-    d[5] = s0;
-    d[6] = 0xFF;
-    d[7] = 0xFF;
+    uint8_t s0 = s[0];
+    uint8_t s1 = s[1];
+    uint8_t s2 = s[2];
+    d[0] = s2;
+    d[1] = s2;
+    d[2] = s1;
+    d[3] = s1;
+    d[4] = s0;
+    d[5] = s0;
+    d[6] = 0xFF;
+    d[7] = 0xFF;
+
+    s += 1 * 3;
+    d += 1 * 8;
+    n -= 1;
+  }
+
+  return len;
+}
+
+// --------
+
+// ‼ WUFFS MULTI-FILE SECTION +arm_neon
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+static uint64_t  //
+wuffs_base__pixel_swizzler__rgba_nonpremul__bgra_nonpremul_4x16le__src__neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len8 = src_len / 8;
+  size_t len = (dst_len4 < src_len8) ? dst_len4 : src_len8;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 8) {
+    uint16x8x4_t x = vld4q_u16((const uint16_t*)(const void*)s);
+    uint8x8x4_t y;
+    y.val[0] = vshrn_n_u16(x.val[2], 8);
+    y.val[1] = vshrn_n_u16(x.val[1], 8);
+    y.val[2] = vshrn_n_u16(x.val[0], 8);
+    y.val[3] = vshrn_n_u16(x.val[3], 8);
+    vst4_u8(d, y);
+
+    s += 8 * 8;
+    d += 8 * 4;
+    n -= 8;
+  }
+
+  while (n >= 1) {
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4), wuffs_base__color_u64__as__color_u32__swap_u32_argb_abgr(
+                         wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8))));
+
+    s += 1 * 8;
+    d += 1 * 4;
+    n -= 1;
+  }
+  return len;
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+// ‼ WUFFS MULTI-FILE SECTION -arm_neon
+
+// ‼ WUFFS MULTI-FILE SECTION +x86_sse42
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__rgba_nonpremul__bgra_nonpremul_4x16le__src__sse42(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len8 = src_len / 8;
+  size_t len = (dst_len4 < src_len8) ? dst_len4 : src_len8;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  // Keep the high byte of each 16-bit channel, swapping B and R.
+  __m128i shuffle = _mm_set_epi8(-0x80, -0x80, -0x80, -0x80,  //
+                                 -0x80, -0x80, -0x80, -0x80,  //
+                                 +0x0F, +0x09, +0x0B, +0x0D,  //
+                                 +0x07, +0x01, +0x03, +0x05);
+
+  while (n >= 4) {
+    __m128i x0 = _mm_lddqu_si128((const __m128i*)(const void*)(s + 0x00));
+    __m128i x1 = _mm_lddqu_si128((const __m128i*)(const void*)(s + 0x10));
+    x0 = _mm_shuffle_epi8(x0, shuffle);
+    x1 = _mm_shuffle_epi8(x1, shuffle);
+    _mm_storeu_si128((__m128i*)(void*)d, _mm_unpacklo_epi64(x0, x1));
+
+    s += 4 * 8;
+    d += 4 * 4;
+    n -= 4;
+  }
+
+  while (n >= 1) {
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4), wuffs_base__color_u64__as__color_u32__swap_u32_argb_abgr(
+                         wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8))));
 
-    s += 1 * 3;
-    d += 1 * 8;
+    s += 1 * 8;
+    d += 1 * 4;
     n -= 1;
   }
-
   return len;
 }
-
-// --------
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// ‼ WUFFS MULTI-FILE SECTION -x86_sse42
 
 static uint64_t  //
 wuffs_base__pixel_swizzler__rgba_nonpremul__bgra_nonpremul_4x16le__src(
@@ -3862,6 +6083,48 @@ wuffs_base__pixel_swizzler__xxxx__index_binary_alpha__src_over(
   return len;
 }
 
+// ‼ WUFFS MULTI-FILE SECTION +arm_neon
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+static uint64_t  //
+wuffs_base__pixel_swizzler__xxxx__y__neon(uint8_t* dst_ptr,
+                                          size_t dst_len,
+                                          uint8_t* dst_palette_ptr,
+                                          size_t dst_palette_len,
+                                          const uint8_t* src_ptr,
+                                          size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t len = (dst_len4 < src_len) ? dst_len4 : src_len;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 16) {
+    uint8x16x4_t y;
+    y.val[0] = vld1q_u8(s);
+    y.val[1] = y.val[0];
+    y.val[2] = y.val[0];
+    y.val[3] = vdupq_n_u8(0xFF);
+    vst4q_u8(d, y);
+
+    s += 16 * 1;
+    d += 16 * 4;
+    n -= 16;
+  }
+
+  while (n >= 1) {
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4), 0xFF000000 | (0x010101 * (uint32_t)s[0]));
+
+    s += 1 * 1;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+// ‼ WUFFS MULTI-FILE SECTION -arm_neon
+
 // ‼ WUFFS MULTI-FILE SECTION +x86_sse42
 #if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
 WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
@@ -4102,7 +6365,226 @@ wuffs_base__pixel_swizzler__y__y_16be(uint8_t* dst_ptr,
   while (n >= 1) {
     d[0] = s[0];
 
-    s += 1 * 2;
+    s += 1 * 2;
+    d += 1 * 1;
+    n -= 1;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__y_16le__y_16be(uint8_t* dst_ptr,
+                                           size_t dst_len,
+                                           uint8_t* dst_palette_ptr,
+                                           size_t dst_palette_len,
+                                           const uint8_t* src_ptr,
+                                           size_t src_len) {
+  size_t dst_len2 = dst_len / 2;
+  size_t src_len2 = src_len / 2;
+  size_t len = (dst_len2 < src_len2) ? dst_len2 : src_len2;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 1) {
+    uint8_t s0 = s[0];
+    uint8_t s1 = s[1];
+    d[0] = s1;
+    d[1] = s0;
+
+    s += 1 * 2;
+    d += 1 * 2;
+    n -= 1;
+  }
+
+  return len;
+}
+
+// --------
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgr_565__ycbcr(uint8_t* dst_ptr,
+                                           size_t dst_len,
+                                           uint8_t* dst_palette_ptr,
+                                           size_t dst_palette_len,
+                                           const uint8_t* src_ptr,
+                                           size_t src_len) {
+  size_t dst_len2 = dst_len / 2;
+  size_t src_len3 = src_len / 3;
+  size_t len = (dst_len2 < src_len3) ? dst_len2 : src_len3;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 1) {
+    wuffs_base__poke_u16le__no_bounds_check(
+        d + (0 * 2),
+        wuffs_base__color_u32_argb_premul__as__color_u16_rgb_565(
+            wuffs_base__color_ycc__as__color_u32(s[0], s[1], s[2])));
+
+    s += 1 * 3;
+    d += 1 * 2;
+    n -= 1;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgr__ycbcr(uint8_t* dst_ptr,
+                                       size_t dst_len,
+                                       uint8_t* dst_palette_ptr,
+                                       size_t dst_palette_len,
+                                       const uint8_t* src_ptr,
+                                       size_t src_len) {
+  size_t dst_len3 = dst_len / 3;
+  size_t src_len3 = src_len / 3;
+  size_t len = (dst_len3 < src_len3) ? dst_len3 : src_len3;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 1) {
+    wuffs_base__poke_u24le__no_bounds_check(
+        d + (0 * 3), wuffs_base__color_ycc__as__color_u32(s[0], s[1], s[2]));
+
+    s += 1 * 3;
+    d += 1 * 3;
+    n -= 1;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgrw__ycbcr(uint8_t* dst_ptr,
+                                        size_t dst_len,
+                                        uint8_t* dst_palette_ptr,
+                                        size_t dst_palette_len,
+                                        const uint8_t* src_ptr,
+                                        size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len3 = src_len / 3;
+  size_t len = (dst_len4 < src_len3) ? dst_len4 : src_len3;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 1) {
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4), wuffs_base__color_ycc__as__color_u32(s[0], s[1], s[2]));
+
+    s += 1 * 3;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgrw_4x16le__ycbcr(uint8_t* dst_ptr,
+                                               size_t dst_len,
+                                               uint8_t* dst_palette_ptr,
+                                               size_t dst_palette_len,
+                                               const uint8_t* src_ptr,
+                                               size_t src_len) {
+  size_t dst_len8 = dst_len / 8;
+  size_t src_len3 = src_len / 3;
+  size_t len = (dst_len8 < src_len3) ? dst_len8 : src_len3;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 1) {
+    wuffs_base__poke_u64le__no_bounds_check(
+        d + (0 * 8),
+        wuffs_base__color_u32__as__color_u64(
+            wuffs_base__color_ycc__as__color_u32(s[0], s[1], s[2])));
+
+    s += 1 * 3;
+    d += 1 * 8;
+    n -= 1;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__rgb__ycbcr(uint8_t* dst_ptr,
+                                       size_t dst_len,
+                                       uint8_t* dst_palette_ptr,
+                                       size_t dst_palette_len,
+                                       const uint8_t* src_ptr,
+                                       size_t src_len) {
+  size_t dst_len3 = dst_len / 3;
+  size_t src_len3 = src_len / 3;
+  size_t len = (dst_len3 < src_len3) ? dst_len3 : src_len3;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 1) {
+    uint32_t c = wuffs_base__color_ycc__as__color_u32(s[0], s[1], s[2]);
+    d[0] = (uint8_t)(c >> 16);
+    d[1] = (uint8_t)(c >> 8);
+    d[2] = (uint8_t)(c >> 0);
+
+    s += 1 * 3;
+    d += 1 * 3;
+    n -= 1;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__rgbw__ycbcr(uint8_t* dst_ptr,
+                                        size_t dst_len,
+                                        uint8_t* dst_palette_ptr,
+                                        size_t dst_palette_len,
+                                        const uint8_t* src_ptr,
+                                        size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len3 = src_len / 3;
+  size_t len = (dst_len4 < src_len3) ? dst_len4 : src_len3;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 1) {
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4),
+        wuffs_base__swap_u32_argb_abgr(
+            wuffs_base__color_ycc__as__color_u32(s[0], s[1], s[2])));
+
+    s += 1 * 3;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__y__ycbcr(uint8_t* dst_ptr,
+                                     size_t dst_len,
+                                     uint8_t* dst_palette_ptr,
+                                     size_t dst_palette_len,
+                                     const uint8_t* src_ptr,
+                                     size_t src_len) {
+  size_t src_len3 = src_len / 3;
+  size_t len = (dst_len < src_len3) ? dst_len : src_len3;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  // The Y in YCbCr is already the luma.
+  while (n >= 1) {
+    d[0] = s[0];
+
+    s += 1 * 3;
     d += 1 * 1;
     n -= 1;
   }
@@ -4110,33 +6592,91 @@ wuffs_base__pixel_swizzler__y__y_16be(uint8_t* dst_ptr,
   return len;
 }
 
+// ‼ WUFFS MULTI-FILE SECTION +x86_sse42
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
 static uint64_t  //
-wuffs_base__pixel_swizzler__y_16le__y_16be(uint8_t* dst_ptr,
-                                           size_t dst_len,
-                                           uint8_t* dst_palette_ptr,
-                                           size_t dst_palette_len,
-                                           const uint8_t* src_ptr,
-                                           size_t src_len) {
-  size_t dst_len2 = dst_len / 2;
-  size_t src_len2 = src_len / 2;
-  size_t len = (dst_len2 < src_len2) ? dst_len2 : src_len2;
+wuffs_base__pixel_swizzler__bgrw__ycbcr__sse42(uint8_t* dst_ptr,
+                                               size_t dst_len,
+                                               uint8_t* dst_palette_ptr,
+                                               size_t dst_palette_len,
+                                               const uint8_t* src_ptr,
+                                               size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len3 = src_len / 3;
+  size_t len = (dst_len4 < src_len3) ? dst_len4 : src_len3;
   uint8_t* d = dst_ptr;
   const uint8_t* s = src_ptr;
   size_t n = len;
 
+  // This is bit-for-bit compatible with the
+  // wuffs_base__color_ycc__as__color_u32 function. Arithmetic (signed) right
+  // shifts round towards negative infinity, the same as that function's bias
+  // trick, and the saturating packs do the clamping to [0 ..= 255].
+  __m128i shuffle_y = _mm_set_epi8(-0x80, -0x80, -0x80, +0x09,  //
+                                   -0x80, -0x80, -0x80, +0x06,  //
+                                   -0x80, -0x80, -0x80, +0x03,  //
+                                   -0x80, -0x80, -0x80, +0x00);
+  __m128i shuffle_cb = _mm_set_epi8(-0x80, -0x80, -0x80, +0x0A,  //
+                                    -0x80, -0x80, -0x80, +0x07,  //
+                                    -0x80, -0x80, -0x80, +0x04,  //
+                                    -0x80, -0x80, -0x80, +0x01);
+  __m128i shuffle_cr = _mm_set_epi8(-0x80, -0x80, -0x80, +0x0B,  //
+                                    -0x80, -0x80, -0x80, +0x08,  //
+                                    -0x80, -0x80, -0x80, +0x05,  //
+                                    -0x80, -0x80, -0x80, +0x02);
+  __m128i shuffle_out = _mm_set_epi8(+0x0F, +0x0B, +0x07, +0x03,  //
+                                     +0x0E, +0x0A, +0x06, +0x02,  //
+                                     +0x0D, +0x09, +0x05, +0x01,  //
+                                     +0x0C, +0x08, +0x04, +0x00);
+  __m128i k_0x80 = _mm_set1_epi32(0x80);
+  __m128i k_half = _mm_set1_epi32(0x8000);
+  __m128i k_r_cr = _mm_set1_epi32(91881);
+  __m128i k_g_cb = _mm_set1_epi32(22554);
+  __m128i k_g_cr = _mm_set1_epi32(46802);
+  __m128i k_b_cb = _mm_set1_epi32(116130);
+  __m128i k_0xff = _mm_set1_epi32(0xFF);
+
+  // Each loop iteration converts 4 pixels (12 bytes) but loads 16 bytes.
+  while (n >= 6) {
+    __m128i x = _mm_lddqu_si128((const __m128i*)(const void*)s);
+    __m128i y = _mm_shuffle_epi8(x, shuffle_y);
+    __m128i cb = _mm_sub_epi32(_mm_shuffle_epi8(x, shuffle_cb), k_0x80);
+    __m128i cr = _mm_sub_epi32(_mm_shuffle_epi8(x, shuffle_cr), k_0x80);
+
+    __m128i r = _mm_add_epi32(
+        y, _mm_srai_epi32(
+               _mm_add_epi32(_mm_mullo_epi32(cr, k_r_cr), k_half), 16));
+    __m128i g = _mm_add_epi32(
+        y, _mm_srai_epi32(
+               _mm_sub_epi32(_mm_sub_epi32(k_half, _mm_mullo_epi32(cb, k_g_cb)),
+                             _mm_mullo_epi32(cr, k_g_cr)),
+               16));
+    __m128i b = _mm_add_epi32(
+        y, _mm_srai_epi32(
+               _mm_add_epi32(_mm_mullo_epi32(cb, k_b_cb), k_half), 16));
+
+    x = _mm_packus_epi16(_mm_packs_epi32(b, g), _mm_packs_epi32(r, k_0xff));
+    _mm_storeu_si128((__m128i*)(void*)d, _mm_shuffle_epi8(x, shuffle_out));
+
+    s += 4 * 3;
+    d += 4 * 4;
+    n -= 4;
+  }
+
   while (n >= 1) {
-    uint8_t s0 = s[0];
-    uint8_t s1 = s[1];
-    d[0] = s1;
-    d[1] = s0;
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4), wuffs_base__color_ycc__as__color_u32(s[0], s[1], s[2]));
 
-    s += 1 * 2;
-    d += 1 * 2;
+    s += 1 * 3;
+    d += 1 * 4;
     n -= 1;
   }
 
   return len;
 }
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// ‼ WUFFS MULTI-FILE SECTION -x86_sse42
 
 // --------
 
@@ -4180,16 +6720,31 @@ wuffs_base__pixel_swizzler__prepare__y(wuffs_base__pixel_swizzler* p,
                                        wuffs_base__slice_u8 src_palette,
                                        wuffs_base__pixel_blend blend) {
   switch (dst_pixfmt.repr) {
+#if defined(WUFFS_BASE__PIXCONV__DST__Y)
     case WUFFS_BASE__PIXEL_FORMAT__Y:
       return wuffs_base__pixel_swizzler__copy_1_1;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGR_565)
     case WUFFS_BASE__PIXEL_FORMAT__BGR_565:
       return wuffs_base__pixel_swizzler__bgr_565__y;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGR) || \
+    defined(WUFFS_BASE__PIXCONV__DST__RGB)
     case WUFFS_BASE__PIXEL_FORMAT__BGR:
     case WUFFS_BASE__PIXEL_FORMAT__RGB:
       return wuffs_base__pixel_swizzler__xxx__y;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRA_NONPREMUL) || \
+    defined(WUFFS_BASE__PIXCONV__DST__BGRA_PREMUL) || \
+    defined(WUFFS_BASE__PIXCONV__DST__BGRA_BINARY) || \
+    defined(WUFFS_BASE__PIXCONV__DST__BGRX) || \
+    defined(WUFFS_BASE__PIXCONV__DST__RGBA_NONPREMUL) || \
+    defined(WUFFS_BASE__PIXCONV__DST__RGBA_PREMUL) || \
+    defined(WUFFS_BASE__PIXCONV__DST__RGBA_BINARY) || \
+    defined(WUFFS_BASE__PIXCONV__DST__RGBX)
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:
@@ -4198,18 +6753,28 @@ wuffs_base__pixel_swizzler__prepare__y(wuffs_base__pixel_swizzler* p,
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:
     case WUFFS_BASE__PIXEL_FORMAT__RGBX:
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+      return wuffs_base__pixel_swizzler__xxxx__y__neon;
+#else
 #if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
       if (wuffs_base__cpu_arch__have_x86_sse42()) {
         return wuffs_base__pixel_swizzler__xxxx__y__sse42;
       }
 #endif
       return wuffs_base__pixel_swizzler__xxxx__y;
+#endif
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRA_NONPREMUL_4X16LE) || \
+    defined(WUFFS_BASE__PIXCONV__DST__BGRA_PREMUL_4X16LE) || \
+    defined(WUFFS_BASE__PIXCONV__DST__RGBA_NONPREMUL_4X16LE) || \
+    defined(WUFFS_BASE__PIXCONV__DST__RGBA_PREMUL_4X16LE)
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL_4X16LE:
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL_4X16LE:
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_4X16LE:
       return wuffs_base__pixel_swizzler__xxxxxxxx__y;
+#endif
   }
   return NULL;
 }
@@ -4221,22 +6786,41 @@ wuffs_base__pixel_swizzler__prepare__y_16be(wuffs_base__pixel_swizzler* p,
                                             wuffs_base__slice_u8 src_palette,
                                             wuffs_base__pixel_blend blend) {
   switch (dst_pixfmt.repr) {
+#if defined(WUFFS_BASE__PIXCONV__DST__Y)
     case WUFFS_BASE__PIXEL_FORMAT__Y:
       return wuffs_base__pixel_swizzler__y__y_16be;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__Y_16LE)
     case WUFFS_BASE__PIXEL_FORMAT__Y_16LE:
       return wuffs_base__pixel_swizzler__y_16le__y_16be;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__Y_16BE)
     case WUFFS_BASE__PIXEL_FORMAT__Y_16BE:
       return wuffs_base__pixel_swizzler__copy_2_2;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGR_565)
     case WUFFS_BASE__PIXEL_FORMAT__BGR_565:
       return wuffs_base__pixel_swizzler__bgr_565__y_16be;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGR) || \
+    defined(WUFFS_BASE__PIXCONV__DST__RGB)
     case WUFFS_BASE__PIXEL_FORMAT__BGR:
     case WUFFS_BASE__PIXEL_FORMAT__RGB:
       return wuffs_base__pixel_swizzler__xxx__y_16be;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRA_NONPREMUL) || \
+    defined(WUFFS_BASE__PIXCONV__DST__BGRA_PREMUL) || \
+    defined(WUFFS_BASE__PIXCONV__DST__BGRA_BINARY) || \
+    defined(WUFFS_BASE__PIXCONV__DST__BGRX) || \
+    defined(WUFFS_BASE__PIXCONV__DST__RGBA_NONPREMUL) || \
+    defined(WUFFS_BASE__PIXCONV__DST__RGBA_PREMUL) || \
+    defined(WUFFS_BASE__PIXCONV__DST__RGBA_BINARY) || \
+    defined(WUFFS_BASE__PIXCONV__DST__RGBX)
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:
@@ -4246,12 +6830,18 @@ wuffs_base__pixel_swizzler__prepare__y_16be(wuffs_base__pixel_swizzler* p,
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:
     case WUFFS_BASE__PIXEL_FORMAT__RGBX:
       return wuffs_base__pixel_swizzler__xxxx__y_16be;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRA_NONPREMUL_4X16LE) || \
+    defined(WUFFS_BASE__PIXCONV__DST__BGRA_PREMUL_4X16LE) || \
+    defined(WUFFS_BASE__PIXCONV__DST__RGBA_NONPREMUL_4X16LE) || \
+    defined(WUFFS_BASE__PIXCONV__DST__RGBA_PREMUL_4X16LE)
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL_4X16LE:
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL_4X16LE:
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_4X16LE:
       return wuffs_base__pixel_swizzler__xxxxxxxx__y_16be;
+#endif
   }
   return NULL;
 }
@@ -4264,6 +6854,7 @@ wuffs_base__pixel_swizzler__prepare__indexed__bgra_nonpremul(
     wuffs_base__slice_u8 src_palette,
     wuffs_base__pixel_blend blend) {
   switch (dst_pixfmt.repr) {
+#if defined(WUFFS_BASE__PIXCONV__DST__INDEXED__BGRA_NONPREMUL)
     case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_NONPREMUL:
       if (wuffs_base__slice_u8__copy_from_slice(dst_palette, src_palette) !=
           WUFFS_BASE__PIXEL_FORMAT__INDEXED__PALETTE_BYTE_LENGTH) {
@@ -4274,7 +6865,9 @@ wuffs_base__pixel_swizzler__prepare__indexed__bgra_nonpremul(
           return wuffs_base__pixel_swizzler__copy_1_1;
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGR_565)
     case WUFFS_BASE__PIXEL_FORMAT__BGR_565:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
@@ -4293,7 +6886,9 @@ wuffs_base__pixel_swizzler__prepare__indexed__bgra_nonpremul(
           return wuffs_base__pixel_swizzler__bgr_565__index_bgra_nonpremul__src_over;
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGR)
     case WUFFS_BASE__PIXEL_FORMAT__BGR:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
@@ -4312,7 +6907,9 @@ wuffs_base__pixel_swizzler__prepare__indexed__bgra_nonpremul(
           return wuffs_base__pixel_swizzler__xxx__index_bgra_nonpremul__src_over;
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRA_NONPREMUL)
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
       if (wuffs_base__slice_u8__copy_from_slice(dst_palette, src_palette) !=
           WUFFS_BASE__PIXEL_FORMAT__INDEXED__PALETTE_BYTE_LENGTH) {
@@ -4325,7 +6922,9 @@ wuffs_base__pixel_swizzler__prepare__indexed__bgra_nonpremul(
           return wuffs_base__pixel_swizzler__bgra_nonpremul__index_bgra_nonpremul__src_over;
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRA_NONPREMUL_4X16LE)
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE:
       if (wuffs_base__slice_u8__copy_from_slice(dst_palette, src_palette) !=
           WUFFS_BASE__PIXEL_FORMAT__INDEXED__PALETTE_BYTE_LENGTH) {
@@ -4338,7 +6937,9 @@ wuffs_base__pixel_swizzler__prepare__indexed__bgra_nonpremul(
           return wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__index_bgra_nonpremul__src_over;
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRA_PREMUL)
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
@@ -4357,11 +6958,15 @@ wuffs_base__pixel_swizzler__prepare__indexed__bgra_nonpremul(
           return wuffs_base__pixel_swizzler__bgra_premul__index_bgra_nonpremul__src_over;
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__RGB)
     case WUFFS_BASE__PIXEL_FORMAT__RGB:
       // TODO.
       break;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__RGBA_NONPREMUL)
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
       if (wuffs_base__pixel_swizzler__swap_rgbx_bgrx(
               dst_palette.ptr, dst_palette.len, NULL, 0, src_palette.ptr,
@@ -4376,7 +6981,9 @@ wuffs_base__pixel_swizzler__prepare__indexed__bgra_nonpremul(
           return wuffs_base__pixel_swizzler__bgra_nonpremul__index_bgra_nonpremul__src_over;
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__RGBA_PREMUL)
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
@@ -4397,10 +7004,13 @@ wuffs_base__pixel_swizzler__prepare__indexed__bgra_nonpremul(
           return wuffs_base__pixel_swizzler__bgra_premul__index_bgra_nonpremul__src_over;
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__RGBX)
     case WUFFS_BASE__PIXEL_FORMAT__RGBX:
       // TODO.
       break;
+#endif
   }
   return NULL;
 }
@@ -4413,6 +7023,9 @@ wuffs_base__pixel_swizzler__prepare__indexed__bgra_binary(
     wuffs_base__slice_u8 src_palette,
     wuffs_base__pixel_blend blend) {
   switch (dst_pixfmt.repr) {
+#if defined(WUFFS_BASE__PIXCONV__DST__INDEXED__BGRA_NONPREMUL) || \
+    defined(WUFFS_BASE__PIXCONV__DST__INDEXED__BGRA_PREMUL) || \
+    defined(WUFFS_BASE__PIXCONV__DST__INDEXED__BGRA_BINARY)
     case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_NONPREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_PREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_BINARY:
@@ -4425,7 +7038,9 @@ wuffs_base__pixel_swizzler__prepare__indexed__bgra_binary(
           return wuffs_base__pixel_swizzler__copy_1_1;
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGR_565)
     case WUFFS_BASE__PIXEL_FORMAT__BGR_565:
       if (wuffs_base__pixel_swizzler__squash_align4_bgr_565_8888(
               dst_palette.ptr, dst_palette.len, src_palette.ptr,
@@ -4440,7 +7055,9 @@ wuffs_base__pixel_swizzler__prepare__indexed__bgra_binary(
           return wuffs_base__pixel_swizzler__bgr_565__index_binary_alpha__src_over;
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGR)
     case WUFFS_BASE__PIXEL_FORMAT__BGR:
       if (wuffs_base__slice_u8__copy_from_slice(dst_palette, src_palette) !=
           WUFFS_BASE__PIXEL_FORMAT__INDEXED__PALETTE_BYTE_LENGTH) {
@@ -4453,7 +7070,11 @@ wuffs_base__pixel_swizzler__prepare__indexed__bgra_binary(
           return wuffs_base__pixel_swizzler__xxx__index_binary_alpha__src_over;
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRA_NONPREMUL) || \
+    defined(WUFFS_BASE__PIXCONV__DST__BGRA_PREMUL) || \
+    defined(WUFFS_BASE__PIXCONV__DST__BGRA_BINARY)
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:
@@ -4468,7 +7089,10 @@ wuffs_base__pixel_swizzler__prepare__indexed__bgra_binary(
           return wuffs_base__pixel_swizzler__xxxx__index_binary_alpha__src_over;
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRA_NONPREMUL_4X16LE) || \
+    defined(WUFFS_BASE__PIXCONV__DST__BGRA_PREMUL_4X16LE)
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL_4X16LE:
       if (wuffs_base__slice_u8__copy_from_slice(dst_palette, src_palette) !=
@@ -4482,7 +7106,9 @@ wuffs_base__pixel_swizzler__prepare__indexed__bgra_binary(
           return wuffs_base__pixel_swizzler__xxxxxxxx__index_binary_alpha__src_over;
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__RGB)
     case WUFFS_BASE__PIXEL_FORMAT__RGB:
       if (wuffs_base__pixel_swizzler__swap_rgbx_bgrx(
               dst_palette.ptr, dst_palette.len, NULL, 0, src_palette.ptr,
@@ -4497,7 +7123,11 @@ wuffs_base__pixel_swizzler__prepare__indexed__bgra_binary(
           return wuffs_base__pixel_swizzler__xxx__index_binary_alpha__src_over;
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__RGBA_NONPREMUL) || \
+    defined(WUFFS_BASE__PIXCONV__DST__RGBA_PREMUL) || \
+    defined(WUFFS_BASE__PIXCONV__DST__RGBA_BINARY)
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:
@@ -4514,6 +7144,7 @@ wuffs_base__pixel_swizzler__prepare__indexed__bgra_binary(
           return wuffs_base__pixel_swizzler__xxxx__index_binary_alpha__src_over;
       }
       return NULL;
+#endif
   }
   return NULL;
 }
@@ -4526,27 +7157,44 @@ wuffs_base__pixel_swizzler__prepare__bgr_565(
     wuffs_base__slice_u8 src_palette,
     wuffs_base__pixel_blend blend) {
   switch (dst_pixfmt.repr) {
+#if defined(WUFFS_BASE__PIXCONV__DST__BGR_565)
     case WUFFS_BASE__PIXEL_FORMAT__BGR_565:
       return wuffs_base__pixel_swizzler__copy_2_2;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGR)
     case WUFFS_BASE__PIXEL_FORMAT__BGR:
       return wuffs_base__pixel_swizzler__bgr__bgr_565;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRA_NONPREMUL) || \
+    defined(WUFFS_BASE__PIXCONV__DST__BGRA_PREMUL) || \
+    defined(WUFFS_BASE__PIXCONV__DST__BGRA_BINARY) || \
+    defined(WUFFS_BASE__PIXCONV__DST__BGRX)
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:
     case WUFFS_BASE__PIXEL_FORMAT__BGRX:
       return wuffs_base__pixel_swizzler__bgrw__bgr_565;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRA_NONPREMUL_4X16LE) || \
+    defined(WUFFS_BASE__PIXCONV__DST__BGRA_PREMUL_4X16LE)
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL_4X16LE:
       return wuffs_base__pixel_swizzler__bgrw_4x16le__bgr_565;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__RGBA_NONPREMUL) || \
+    defined(WUFFS_BASE__PIXCONV__DST__RGBA_PREMUL) || \
+    defined(WUFFS_BASE__PIXCONV__DST__RGBA_BINARY) || \
+    defined(WUFFS_BASE__PIXCONV__DST__RGBX)
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:
     case WUFFS_BASE__PIXEL_FORMAT__RGBX:
       return wuffs_base__pixel_swizzler__rgbw__bgr_565;
+#endif
   }
   return NULL;
 }
@@ -4558,35 +7206,71 @@ wuffs_base__pixel_swizzler__prepare__bgr(wuffs_base__pixel_swizzler* p,
                                          wuffs_base__slice_u8 src_palette,
                                          wuffs_base__pixel_blend blend) {
   switch (dst_pixfmt.repr) {
+#if defined(WUFFS_BASE__PIXCONV__DST__BGR_565)
     case WUFFS_BASE__PIXEL_FORMAT__BGR_565:
       return wuffs_base__pixel_swizzler__bgr_565__bgr;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGR)
     case WUFFS_BASE__PIXEL_FORMAT__BGR:
       return wuffs_base__pixel_swizzler__copy_3_3;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRA_NONPREMUL) || \
+    defined(WUFFS_BASE__PIXCONV__DST__BGRA_PREMUL) || \
+    defined(WUFFS_BASE__PIXCONV__DST__BGRA_BINARY) || \
+    defined(WUFFS_BASE__PIXCONV__DST__BGRX)
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:
     case WUFFS_BASE__PIXEL_FORMAT__BGRX:
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+      return wuffs_base__pixel_swizzler__bgrw__bgr__neon;
+#elif defined(WUFFS_BASE__CPU_ARCH__WASM_SIMD128)
+      return wuffs_base__pixel_swizzler__bgrw__bgr__wasm_simd128;
+#else
       return wuffs_base__pixel_swizzler__bgrw__bgr;
+#endif
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRA_NONPREMUL_4X16LE) || \
+    defined(WUFFS_BASE__PIXCONV__DST__BGRA_PREMUL_4X16LE)
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL_4X16LE:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+      if (wuffs_base__cpu_arch__have_x86_sse42()) {
+        return wuffs_base__pixel_swizzler__bgrw_4x16le__bgr__sse42;
+      }
+#endif
       return wuffs_base__pixel_swizzler__bgrw_4x16le__bgr;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__RGB)
     case WUFFS_BASE__PIXEL_FORMAT__RGB:
       return wuffs_base__pixel_swizzler__swap_rgb_bgr;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__RGBA_NONPREMUL) || \
+    defined(WUFFS_BASE__PIXCONV__DST__RGBA_PREMUL) || \
+    defined(WUFFS_BASE__PIXCONV__DST__RGBA_BINARY) || \
+    defined(WUFFS_BASE__PIXCONV__DST__RGBX)
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:
     case WUFFS_BASE__PIXEL_FORMAT__RGBX:
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+      return wuffs_base__pixel_swizzler__bgrw__rgb__neon;
+#elif defined(WUFFS_BASE__CPU_ARCH__WASM_SIMD128)
+      return wuffs_base__pixel_swizzler__bgrw__rgb__wasm_simd128;
+#else
 #if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
       if (wuffs_base__cpu_arch__have_x86_sse42()) {
         return wuffs_base__pixel_swizzler__bgrw__rgb__sse42;
       }
 #endif
       return wuffs_base__pixel_swizzler__bgrw__rgb;
+#endif
+#endif
   }
   return NULL;
 }
@@ -4599,6 +7283,7 @@ wuffs_base__pixel_swizzler__prepare__bgra_nonpremul(
     wuffs_base__slice_u8 src_palette,
     wuffs_base__pixel_blend blend) {
   switch (dst_pixfmt.repr) {
+#if defined(WUFFS_BASE__PIXCONV__DST__BGR_565)
     case WUFFS_BASE__PIXEL_FORMAT__BGR_565:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
@@ -4607,7 +7292,9 @@ wuffs_base__pixel_swizzler__prepare__bgra_nonpremul(
           return wuffs_base__pixel_swizzler__bgr_565__bgra_nonpremul__src_over;
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGR)
     case WUFFS_BASE__PIXEL_FORMAT__BGR:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
@@ -4616,7 +7303,9 @@ wuffs_base__pixel_swizzler__prepare__bgra_nonpremul(
           return wuffs_base__pixel_swizzler__bgr__bgra_nonpremul__src_over;
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRA_NONPREMUL)
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
@@ -4625,61 +7314,127 @@ wuffs_base__pixel_swizzler__prepare__bgra_nonpremul(
           return wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_nonpremul__src_over;
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRA_NONPREMUL_4X16LE)
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          return wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__bgra_nonpremul__src__neon;
+#else
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+          if (wuffs_base__cpu_arch__have_x86_sse42()) {
+            return wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__bgra_nonpremul__src__sse42;
+          }
+#endif
           return wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__bgra_nonpremul__src;
+#endif
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
           return wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__bgra_nonpremul__src_over;
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRA_PREMUL)
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src__neon;
+#elif defined(WUFFS_BASE__CPU_ARCH__WASM_SIMD128)
+          return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src__wasm_simd128;
+#else
           return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src;
+#endif
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src_over__neon;
+#else
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src_over__avx2;
+          } else if (wuffs_base__cpu_arch__have_x86_sse42()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src_over__sse42;
+          }
+#endif
           return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src_over;
+#endif
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRA_BINARY) || \
+    defined(WUFFS_BASE__PIXCONV__DST__BGRX)
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:
     case WUFFS_BASE__PIXEL_FORMAT__BGRX:
       // TODO.
       break;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__RGB)
     case WUFFS_BASE__PIXEL_FORMAT__RGB:
       // TODO.
       break;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__RGBA_NONPREMUL)
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          return wuffs_base__pixel_swizzler__swap_rgbx_bgrx__neon;
+#elif defined(WUFFS_BASE__CPU_ARCH__WASM_SIMD128)
+          return wuffs_base__pixel_swizzler__swap_rgbx_bgrx__wasm_simd128;
+#else
 #if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
           if (wuffs_base__cpu_arch__have_x86_sse42()) {
             return wuffs_base__pixel_swizzler__swap_rgbx_bgrx__sse42;
           }
 #endif
           return wuffs_base__pixel_swizzler__swap_rgbx_bgrx;
+#endif
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
           return wuffs_base__pixel_swizzler__bgra_nonpremul__rgba_nonpremul__src_over;
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__RGBA_PREMUL)
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          return wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src__neon;
+#elif defined(WUFFS_BASE__CPU_ARCH__WASM_SIMD128)
+          return wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src__wasm_simd128;
+#else
           return wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src;
+#endif
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          return wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src_over__neon;
+#else
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src_over__avx2;
+          } else if (wuffs_base__cpu_arch__have_x86_sse42()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src_over__sse42;
+          }
+#endif
           return wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src_over;
+#endif
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__RGBA_BINARY) || \
+    defined(WUFFS_BASE__PIXCONV__DST__RGBX)
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:
     case WUFFS_BASE__PIXEL_FORMAT__RGBX:
       // TODO.
       break;
+#endif
   }
   return NULL;
 }
@@ -4692,6 +7447,7 @@ wuffs_base__pixel_swizzler__prepare__bgra_nonpremul_4x16le(
     wuffs_base__slice_u8 src_palette,
     wuffs_base__pixel_blend blend) {
   switch (dst_pixfmt.repr) {
+#if defined(WUFFS_BASE__PIXCONV__DST__BGR_565)
     case WUFFS_BASE__PIXEL_FORMAT__BGR_565:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
@@ -4700,7 +7456,9 @@ wuffs_base__pixel_swizzler__prepare__bgra_nonpremul_4x16le(
           return wuffs_base__pixel_swizzler__bgr_565__bgra_nonpremul_4x16le__src_over;
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGR)
     case WUFFS_BASE__PIXEL_FORMAT__BGR:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
@@ -4709,16 +7467,29 @@ wuffs_base__pixel_swizzler__prepare__bgra_nonpremul_4x16le(
           return wuffs_base__pixel_swizzler__bgr__bgra_nonpremul_4x16le__src_over;
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRA_NONPREMUL)
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          return wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_nonpremul_4x16le__src__neon;
+#else
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+          if (wuffs_base__cpu_arch__have_x86_sse42()) {
+            return wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_nonpremul_4x16le__src__sse42;
+          }
+#endif
           return wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_nonpremul_4x16le__src;
+#endif
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
           return wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_nonpremul_4x16le__src_over;
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRA_NONPREMUL_4X16LE)
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
@@ -4727,47 +7498,93 @@ wuffs_base__pixel_swizzler__prepare__bgra_nonpremul_4x16le(
           return wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__bgra_nonpremul_4x16le__src_over;
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRA_PREMUL)
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul_4x16le__src__neon;
+#else
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul_4x16le__src__avx2;
+          } else if (wuffs_base__cpu_arch__have_x86_sse42()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul_4x16le__src__sse42;
+          }
+#endif
           return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul_4x16le__src;
+#endif
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
           return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul_4x16le__src_over;
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRA_BINARY) || \
+    defined(WUFFS_BASE__PIXCONV__DST__BGRX)
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:
     case WUFFS_BASE__PIXEL_FORMAT__BGRX:
       // TODO.
       break;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__RGB)
     case WUFFS_BASE__PIXEL_FORMAT__RGB:
       // TODO.
       break;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__RGBA_NONPREMUL)
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          return wuffs_base__pixel_swizzler__rgba_nonpremul__bgra_nonpremul_4x16le__src__neon;
+#else
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+          if (wuffs_base__cpu_arch__have_x86_sse42()) {
+            return wuffs_base__pixel_swizzler__rgba_nonpremul__bgra_nonpremul_4x16le__src__sse42;
+          }
+#endif
           return wuffs_base__pixel_swizzler__rgba_nonpremul__bgra_nonpremul_4x16le__src;
+#endif
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
           return wuffs_base__pixel_swizzler__rgba_nonpremul__bgra_nonpremul_4x16le__src_over;
       }
       break;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__RGBA_PREMUL)
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          return wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul_4x16le__src__neon;
+#else
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul_4x16le__src__avx2;
+          } else if (wuffs_base__cpu_arch__have_x86_sse42()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul_4x16le__src__sse42;
+          }
+#endif
           return wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul_4x16le__src;
+#endif
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
           return wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul_4x16le__src_over;
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__RGBA_BINARY) || \
+    defined(WUFFS_BASE__PIXCONV__DST__RGBX)
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:
     case WUFFS_BASE__PIXEL_FORMAT__RGBX:
       // TODO.
       break;
+#endif
   }
   return NULL;
 }
@@ -4780,6 +7597,7 @@ wuffs_base__pixel_swizzler__prepare__bgra_premul(
     wuffs_base__slice_u8 src_palette,
     wuffs_base__pixel_blend blend) {
   switch (dst_pixfmt.repr) {
+#if defined(WUFFS_BASE__PIXCONV__DST__BGR_565)
     case WUFFS_BASE__PIXEL_FORMAT__BGR_565:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
@@ -4788,7 +7606,9 @@ wuffs_base__pixel_swizzler__prepare__bgra_premul(
           return wuffs_base__pixel_swizzler__bgr_565__bgra_premul__src_over;
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGR)
     case WUFFS_BASE__PIXEL_FORMAT__BGR:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
@@ -4797,7 +7617,9 @@ wuffs_base__pixel_swizzler__prepare__bgra_premul(
           return wuffs_base__pixel_swizzler__bgr__bgra_premul__src_over;
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRA_NONPREMUL)
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
@@ -4806,7 +7628,9 @@ wuffs_base__pixel_swizzler__prepare__bgra_premul(
           return wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_premul__src_over;
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRA_NONPREMUL_4X16LE)
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
@@ -4815,7 +7639,9 @@ wuffs_base__pixel_swizzler__prepare__bgra_premul(
           return wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__bgra_premul__src_over;
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRA_PREMUL)
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
@@ -4824,7 +7650,9 @@ wuffs_base__pixel_swizzler__prepare__bgra_premul(
           return wuffs_base__pixel_swizzler__bgra_premul__bgra_premul__src_over;
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__RGBA_NONPREMUL)
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
@@ -4833,20 +7661,29 @@ wuffs_base__pixel_swizzler__prepare__bgra_premul(
           return wuffs_base__pixel_swizzler__bgra_nonpremul__rgba_premul__src_over;
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__RGBA_PREMUL)
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          return wuffs_base__pixel_swizzler__swap_rgbx_bgrx__neon;
+#elif defined(WUFFS_BASE__CPU_ARCH__WASM_SIMD128)
+          return wuffs_base__pixel_swizzler__swap_rgbx_bgrx__wasm_simd128;
+#else
 #if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
           if (wuffs_base__cpu_arch__have_x86_sse42()) {
             return wuffs_base__pixel_swizzler__swap_rgbx_bgrx__sse42;
           }
 #endif
           return wuffs_base__pixel_swizzler__swap_rgbx_bgrx;
+#endif
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
           return wuffs_base__pixel_swizzler__bgra_premul__rgba_premul__src_over;
       }
       return NULL;
+#endif
   }
   return NULL;
 }
@@ -4858,32 +7695,56 @@ wuffs_base__pixel_swizzler__prepare__bgrx(wuffs_base__pixel_swizzler* p,
                                           wuffs_base__slice_u8 src_palette,
                                           wuffs_base__pixel_blend blend) {
   switch (dst_pixfmt.repr) {
+#if defined(WUFFS_BASE__PIXCONV__DST__BGR_565)
     case WUFFS_BASE__PIXEL_FORMAT__BGR_565:
       return wuffs_base__pixel_swizzler__bgr_565__bgrx;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGR)
     case WUFFS_BASE__PIXEL_FORMAT__BGR:
       return wuffs_base__pixel_swizzler__xxx__xxxx;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRA_NONPREMUL) || \
+    defined(WUFFS_BASE__PIXCONV__DST__BGRA_PREMUL) || \
+    defined(WUFFS_BASE__PIXCONV__DST__BGRA_BINARY)
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:
       return wuffs_base__pixel_swizzler__bgrw__bgrx;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRA_NONPREMUL_4X16LE)
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+      if (wuffs_base__cpu_arch__have_x86_sse42()) {
+        return wuffs_base__pixel_swizzler__bgrw_4x16le__bgrx__sse42;
+      }
+#endif
       return wuffs_base__pixel_swizzler__bgrw_4x16le__bgrx;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRX)
     case WUFFS_BASE__PIXEL_FORMAT__BGRX:
       return wuffs_base__pixel_swizzler__copy_4_4;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__RGB)
     case WUFFS_BASE__PIXEL_FORMAT__RGB:
       // TODO.
       break;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__RGBA_NONPREMUL) || \
+    defined(WUFFS_BASE__PIXCONV__DST__RGBA_PREMUL) || \
+    defined(WUFFS_BASE__PIXCONV__DST__RGBA_BINARY) || \
+    defined(WUFFS_BASE__PIXCONV__DST__RGBX)
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:
     case WUFFS_BASE__PIXEL_FORMAT__RGBX:
       return wuffs_base__pixel_swizzler__bgrw__rgbx;
+#endif
   }
   return NULL;
 }
@@ -4895,34 +7756,69 @@ wuffs_base__pixel_swizzler__prepare__rgb(wuffs_base__pixel_swizzler* p,
                                          wuffs_base__slice_u8 src_palette,
                                          wuffs_base__pixel_blend blend) {
   switch (dst_pixfmt.repr) {
+#if defined(WUFFS_BASE__PIXCONV__DST__BGR_565)
     case WUFFS_BASE__PIXEL_FORMAT__BGR_565:
       return wuffs_base__pixel_swizzler__bgr_565__rgb;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGR)
     case WUFFS_BASE__PIXEL_FORMAT__BGR:
       return wuffs_base__pixel_swizzler__swap_rgb_bgr;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRA_NONPREMUL) || \
+    defined(WUFFS_BASE__PIXCONV__DST__BGRA_PREMUL) || \
+    defined(WUFFS_BASE__PIXCONV__DST__BGRA_BINARY) || \
+    defined(WUFFS_BASE__PIXCONV__DST__BGRX)
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:
     case WUFFS_BASE__PIXEL_FORMAT__BGRX:
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+      return wuffs_base__pixel_swizzler__bgrw__rgb__neon;
+#elif defined(WUFFS_BASE__CPU_ARCH__WASM_SIMD128)
+      return wuffs_base__pixel_swizzler__bgrw__rgb__wasm_simd128;
+#else
 #if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
       if (wuffs_base__cpu_arch__have_x86_sse42()) {
         return wuffs_base__pixel_swizzler__bgrw__rgb__sse42;
       }
 #endif
       return wuffs_base__pixel_swizzler__bgrw__rgb;
+#endif
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRA_NONPREMUL_4X16LE)
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+      if (wuffs_base__cpu_arch__have_x86_sse42()) {
+        return wuffs_base__pixel_swizzler__bgrw_4x16le__rgb__sse42;
+      }
+#endif
       return wuffs_base__pixel_swizzler__bgrw_4x16le__rgb;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__RGB)
     case WUFFS_BASE__PIXEL_FORMAT__RGB:
       return wuffs_base__pixel_swizzler__copy_3_3;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__RGBA_NONPREMUL) || \
+    defined(WUFFS_BASE__PIXCONV__DST__RGBA_PREMUL) || \
+    defined(WUFFS_BASE__PIXCONV__DST__RGBA_BINARY) || \
+    defined(WUFFS_BASE__PIXCONV__DST__RGBX)
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:
     case WUFFS_BASE__PIXEL_FORMAT__RGBX:
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+      return wuffs_base__pixel_swizzler__bgrw__bgr__neon;
+#elif defined(WUFFS_BASE__CPU_ARCH__WASM_SIMD128)
+      return wuffs_base__pixel_swizzler__bgrw__bgr__wasm_simd128;
+#else
       return wuffs_base__pixel_swizzler__bgrw__bgr;
+#endif
+#endif
   }
   return NULL;
 }
@@ -4935,6 +7831,7 @@ wuffs_base__pixel_swizzler__prepare__rgba_nonpremul(
     wuffs_base__slice_u8 src_palette,
     wuffs_base__pixel_blend blend) {
   switch (dst_pixfmt.repr) {
+#if defined(WUFFS_BASE__PIXCONV__DST__BGR_565)
     case WUFFS_BASE__PIXEL_FORMAT__BGR_565:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
@@ -4943,7 +7840,9 @@ wuffs_base__pixel_swizzler__prepare__rgba_nonpremul(
           return wuffs_base__pixel_swizzler__bgr_565__rgba_nonpremul__src_over;
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGR)
     case WUFFS_BASE__PIXEL_FORMAT__BGR:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
@@ -4952,21 +7851,31 @@ wuffs_base__pixel_swizzler__prepare__rgba_nonpremul(
           return wuffs_base__pixel_swizzler__bgr__rgba_nonpremul__src_over;
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRA_NONPREMUL)
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          return wuffs_base__pixel_swizzler__swap_rgbx_bgrx__neon;
+#elif defined(WUFFS_BASE__CPU_ARCH__WASM_SIMD128)
+          return wuffs_base__pixel_swizzler__swap_rgbx_bgrx__wasm_simd128;
+#else
 #if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
           if (wuffs_base__cpu_arch__have_x86_sse42()) {
             return wuffs_base__pixel_swizzler__swap_rgbx_bgrx__sse42;
           }
 #endif
           return wuffs_base__pixel_swizzler__swap_rgbx_bgrx;
+#endif
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
           return wuffs_base__pixel_swizzler__bgra_nonpremul__rgba_nonpremul__src_over;
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRA_NONPREMUL_4X16LE)
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
@@ -4975,25 +7884,51 @@ wuffs_base__pixel_swizzler__prepare__rgba_nonpremul(
           return wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__rgba_nonpremul__src_over;
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRA_PREMUL)
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          return wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src__neon;
+#elif defined(WUFFS_BASE__CPU_ARCH__WASM_SIMD128)
+          return wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src__wasm_simd128;
+#else
           return wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src;
+#endif
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          return wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src_over__neon;
+#else
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src_over__avx2;
+          } else if (wuffs_base__cpu_arch__have_x86_sse42()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src_over__sse42;
+          }
+#endif
           return wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src_over;
+#endif
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRA_BINARY) || \
+    defined(WUFFS_BASE__PIXCONV__DST__BGRX)
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:
     case WUFFS_BASE__PIXEL_FORMAT__BGRX:
       // TODO.
       break;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__RGB)
     case WUFFS_BASE__PIXEL_FORMAT__RGB:
       // TODO.
       break;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__RGBA_NONPREMUL)
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
@@ -5002,20 +7937,43 @@ wuffs_base__pixel_swizzler__prepare__rgba_nonpremul(
           return wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_nonpremul__src_over;
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__RGBA_PREMUL)
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src__neon;
+#elif defined(WUFFS_BASE__CPU_ARCH__WASM_SIMD128)
+          return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src__wasm_simd128;
+#else
           return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src;
+#endif
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src_over__neon;
+#else
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src_over__avx2;
+          } else if (wuffs_base__cpu_arch__have_x86_sse42()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src_over__sse42;
+          }
+#endif
           return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src_over;
+#endif
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__RGBA_BINARY) || \
+    defined(WUFFS_BASE__PIXCONV__DST__RGBX)
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:
     case WUFFS_BASE__PIXEL_FORMAT__RGBX:
       // TODO.
       break;
+#endif
   }
   return NULL;
 }
@@ -5028,6 +7986,7 @@ wuffs_base__pixel_swizzler__prepare__rgba_premul(
     wuffs_base__slice_u8 src_palette,
     wuffs_base__pixel_blend blend) {
   switch (dst_pixfmt.repr) {
+#if defined(WUFFS_BASE__PIXCONV__DST__BGR_565)
     case WUFFS_BASE__PIXEL_FORMAT__BGR_565:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
@@ -5036,7 +7995,9 @@ wuffs_base__pixel_swizzler__prepare__rgba_premul(
           return wuffs_base__pixel_swizzler__bgr_565__rgba_premul__src_over;
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGR)
     case WUFFS_BASE__PIXEL_FORMAT__BGR:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
@@ -5045,7 +8006,9 @@ wuffs_base__pixel_swizzler__prepare__rgba_premul(
           return wuffs_base__pixel_swizzler__bgr__rgba_premul__src_over;
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRA_NONPREMUL)
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
@@ -5054,7 +8017,9 @@ wuffs_base__pixel_swizzler__prepare__rgba_premul(
           return wuffs_base__pixel_swizzler__bgra_nonpremul__rgba_premul__src_over;
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRA_NONPREMUL_4X16LE)
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
@@ -5063,21 +8028,31 @@ wuffs_base__pixel_swizzler__prepare__rgba_premul(
           return wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__rgba_premul__src_over;
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRA_PREMUL)
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          return wuffs_base__pixel_swizzler__swap_rgbx_bgrx__neon;
+#elif defined(WUFFS_BASE__CPU_ARCH__WASM_SIMD128)
+          return wuffs_base__pixel_swizzler__swap_rgbx_bgrx__wasm_simd128;
+#else
 #if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
           if (wuffs_base__cpu_arch__have_x86_sse42()) {
             return wuffs_base__pixel_swizzler__swap_rgbx_bgrx__sse42;
           }
 #endif
           return wuffs_base__pixel_swizzler__swap_rgbx_bgrx;
+#endif
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
           return wuffs_base__pixel_swizzler__bgra_premul__rgba_premul__src_over;
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__RGBA_NONPREMUL)
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
@@ -5086,7 +8061,9 @@ wuffs_base__pixel_swizzler__prepare__rgba_premul(
           return wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_premul__src_over;
       }
       return NULL;
+#endif
 
+#if defined(WUFFS_BASE__PIXCONV__DST__RGBA_PREMUL)
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
@@ -5095,6 +8072,74 @@ wuffs_base__pixel_swizzler__prepare__rgba_premul(
           return wuffs_base__pixel_swizzler__bgra_premul__bgra_premul__src_over;
       }
       return NULL;
+#endif
+  }
+  return NULL;
+}
+
+// --------
+
+static wuffs_base__pixel_swizzler__func  //
+wuffs_base__pixel_swizzler__prepare__ycbcr(wuffs_base__pixel_swizzler* p,
+                                           wuffs_base__pixel_format dst_pixfmt,
+                                           wuffs_base__slice_u8 dst_palette,
+                                           wuffs_base__slice_u8 src_palette,
+                                           wuffs_base__pixel_blend blend) {
+  // YCbCr is opaque, so SRC and SRC_OVER blends are equivalent.
+  switch (dst_pixfmt.repr) {
+#if defined(WUFFS_BASE__PIXCONV__DST__Y)
+    case WUFFS_BASE__PIXEL_FORMAT__Y:
+      return wuffs_base__pixel_swizzler__y__ycbcr;
+#endif
+
+#if defined(WUFFS_BASE__PIXCONV__DST__BGR_565)
+    case WUFFS_BASE__PIXEL_FORMAT__BGR_565:
+      return wuffs_base__pixel_swizzler__bgr_565__ycbcr;
+#endif
+
+#if defined(WUFFS_BASE__PIXCONV__DST__BGR)
+    case WUFFS_BASE__PIXEL_FORMAT__BGR:
+      return wuffs_base__pixel_swizzler__bgr__ycbcr;
+#endif
+
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRA_NONPREMUL) || \
+    defined(WUFFS_BASE__PIXCONV__DST__BGRA_PREMUL) || \
+    defined(WUFFS_BASE__PIXCONV__DST__BGRA_BINARY) || \
+    defined(WUFFS_BASE__PIXCONV__DST__BGRX)
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRX:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+      if (wuffs_base__cpu_arch__have_x86_sse42()) {
+        return wuffs_base__pixel_swizzler__bgrw__ycbcr__sse42;
+      }
+#endif
+      return wuffs_base__pixel_swizzler__bgrw__ycbcr;
+#endif
+
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRA_NONPREMUL_4X16LE) || \
+    defined(WUFFS_BASE__PIXCONV__DST__BGRA_PREMUL_4X16LE)
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL_4X16LE:
+      return wuffs_base__pixel_swizzler__bgrw_4x16le__ycbcr;
+#endif
+
+#if defined(WUFFS_BASE__PIXCONV__DST__RGB)
+    case WUFFS_BASE__PIXEL_FORMAT__RGB:
+      return wuffs_base__pixel_swizzler__rgb__ycbcr;
+#endif
+
+#if defined(WUFFS_BASE__PIXCONV__DST__RGBA_NONPREMUL) || \
+    defined(WUFFS_BASE__PIXCONV__DST__RGBA_PREMUL) || \
+    defined(WUFFS_BASE__PIXCONV__DST__RGBA_BINARY) || \
+    defined(WUFFS_BASE__PIXCONV__DST__RGBX)
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBX:
+      return wuffs_base__pixel_swizzler__rgbw__ycbcr;
+#endif
   }
   return NULL;
 }
@@ -5115,6 +8160,9 @@ wuffs_base__pixel_swizzler__prepare(wuffs_base__pixel_swizzler* p,
   p->private_impl.transparent_black_func = NULL;
   p->private_impl.dst_pixfmt_bytes_per_pixel = 0;
   p->private_impl.src_pixfmt_bytes_per_pixel = 0;
+  p->private_impl.dst_pixfmt_repr = 0;
+  p->private_impl.blend = 0;
+  p->private_impl.color_conversion = NULL;
 
   wuffs_base__pixel_swizzler__func func = NULL;
   wuffs_base__pixel_swizzler__transparent_black_func transparent_black_func =
@@ -5128,8 +8176,85 @@ wuffs_base__pixel_swizzler__prepare(wuffs_base__pixel_swizzler* p,
         wuffs_base__error__unsupported_pixel_swizzler_option);
   }
 
+#if defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ENABLE_ALLOWLIST)
+  switch (dst_pixfmt.repr) {
+    default:
+      return wuffs_base__make_status(
+          wuffs_base__error__unsupported_pixel_swizzler_option);
+#if defined(WUFFS_BASE__PIXCONV__DST__Y)
+    case WUFFS_BASE__PIXEL_FORMAT__Y:
+#endif
+#if defined(WUFFS_BASE__PIXCONV__DST__Y_16LE)
+    case WUFFS_BASE__PIXEL_FORMAT__Y_16LE:
+#endif
+#if defined(WUFFS_BASE__PIXCONV__DST__Y_16BE)
+    case WUFFS_BASE__PIXEL_FORMAT__Y_16BE:
+#endif
+#if defined(WUFFS_BASE__PIXCONV__DST__BGR_565)
+    case WUFFS_BASE__PIXEL_FORMAT__BGR_565:
+#endif
+#if defined(WUFFS_BASE__PIXCONV__DST__BGR)
+    case WUFFS_BASE__PIXEL_FORMAT__BGR:
+#endif
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRA_NONPREMUL)
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
+#endif
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRA_NONPREMUL_4X16LE)
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE:
+#endif
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRA_PREMUL)
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
+#endif
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRA_PREMUL_4X16LE)
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL_4X16LE:
+#endif
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRA_BINARY)
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:
+#endif
+#if defined(WUFFS_BASE__PIXCONV__DST__BGRX)
+    case WUFFS_BASE__PIXEL_FORMAT__BGRX:
+#endif
+#if defined(WUFFS_BASE__PIXCONV__DST__RGB)
+    case WUFFS_BASE__PIXEL_FORMAT__RGB:
+#endif
+#if defined(WUFFS_BASE__PIXCONV__DST__RGBA_NONPREMUL)
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
+#endif
+#if defined(WUFFS_BASE__PIXCONV__DST__RGBA_NONPREMUL_4X16LE)
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL_4X16LE:
+#endif
+#if defined(WUFFS_BASE__PIXCONV__DST__RGBA_PREMUL)
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
+#endif
+#if defined(WUFFS_BASE__PIXCONV__DST__RGBA_PREMUL_4X16LE)
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_4X16LE:
+#endif
+#if defined(WUFFS_BASE__PIXCONV__DST__RGBA_BINARY)
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:
+#endif
+#if defined(WUFFS_BASE__PIXCONV__DST__RGBX)
+    case WUFFS_BASE__PIXEL_FORMAT__RGBX:
+#endif
+#if defined(WUFFS_BASE__PIXCONV__DST__INDEXED__BGRA_NONPREMUL)
+    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_NONPREMUL:
+#endif
+#if defined(WUFFS_BASE__PIXCONV__DST__INDEXED__BGRA_PREMUL)
+    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_PREMUL:
+#endif
+#if defined(WUFFS_BASE__PIXCONV__DST__INDEXED__BGRA_BINARY)
+    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_BINARY:
+#endif
+      break;
+  }
+#endif  // defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ENABLE_ALLOWLIST)
+
   uint32_t src_pixfmt_bits_per_pixel =
       wuffs_base__pixel_format__bits_per_pixel(&src_pixfmt);
+  // As a swizzler source, YCbCr is interleaved (3 bytes per pixel) instead of
+  // planar, as produced row by row by the JPEG decoder.
+  if (src_pixfmt.repr == WUFFS_BASE__PIXEL_FORMAT__YCBCR) {
+    src_pixfmt_bits_per_pixel = 24;
+  }
   if ((src_pixfmt_bits_per_pixel == 0) ||
       ((src_pixfmt_bits_per_pixel & 7) != 0)) {
     return wuffs_base__make_status(
@@ -5215,16 +8340,203 @@ wuffs_base__pixel_swizzler__prepare(wuffs_base__pixel_swizzler* p,
       func = wuffs_base__pixel_swizzler__prepare__rgba_premul(
           p, dst_pixfmt, dst_palette, src_palette, blend);
       break;
+
+    case WUFFS_BASE__PIXEL_FORMAT__YCBCR:
+      func = wuffs_base__pixel_swizzler__prepare__ycbcr(
+          p, dst_pixfmt, dst_palette, src_palette, blend);
+      break;
   }
 
   p->private_impl.func = func;
   p->private_impl.transparent_black_func = transparent_black_func;
   p->private_impl.dst_pixfmt_bytes_per_pixel = dst_pixfmt_bits_per_pixel / 8;
   p->private_impl.src_pixfmt_bytes_per_pixel = src_pixfmt_bits_per_pixel / 8;
+  p->private_impl.dst_pixfmt_repr = dst_pixfmt.repr;
+  p->private_impl.blend = blend;
   return wuffs_base__make_status(
       func ? NULL : wuffs_base__error__unsupported_pixel_swizzler_option);
 }
 
+// --------
+
+// wuffs_base__pixel_swizzler__color_conversion_layout describes where a
+// destination pixel format's channels are, for color conversion. It returns
+// false if color conversion does not support that pixel format.
+static bool  //
+wuffs_base__pixel_swizzler__color_conversion_layout(uint32_t dst_pixfmt_repr,
+                                                    size_t* bytes_per_pixel,
+                                                    bool* is_rgb,
+                                                    bool* is_premul) {
+  *bytes_per_pixel = 4;
+  *is_rgb = false;
+  *is_premul = false;
+  switch (dst_pixfmt_repr) {
+    case WUFFS_BASE__PIXEL_FORMAT__BGR:
+      *bytes_per_pixel = 3;
+      return true;
+    case WUFFS_BASE__PIXEL_FORMAT__RGB:
+      *bytes_per_pixel = 3;
+      *is_rgb = true;
+      return true;
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRX:
+      return true;
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
+      *is_premul = true;
+      return true;
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBX:
+      *is_rgb = true;
+      return true;
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
+      *is_rgb = true;
+      *is_premul = true;
+      return true;
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE:
+      *bytes_per_pixel = 8;
+      return true;
+  }
+  return false;
+}
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_base__pixel_swizzler__set_color_conversion(
+    wuffs_base__pixel_swizzler* p,
+    const wuffs_base__color_conversion* c) {
+  if (!p) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  } else if (!p->private_impl.func) {
+    return wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
+  }
+  p->private_impl.color_conversion = NULL;
+  if (!c) {
+    return wuffs_base__make_status(NULL);
+  }
+
+  size_t bytes_per_pixel = 0;
+  bool is_rgb = false;
+  bool is_premul = false;
+  if ((p->private_impl.blend != WUFFS_BASE__PIXEL_BLEND__SRC) ||
+      !wuffs_base__pixel_swizzler__color_conversion_layout(
+          p->private_impl.dst_pixfmt_repr, &bytes_per_pixel, &is_rgb,
+          &is_premul)) {
+    return wuffs_base__make_status(
+        wuffs_base__error__unsupported_pixel_swizzler_option);
+  }
+
+  bool ok = false;
+  if (bytes_per_pixel == 8) {
+    ok = c->private_impl.table_u16 != NULL;
+  } else {
+    ok = (c->private_impl.table_u8 != NULL) ||
+         (c->private_impl.linearize_u16 != NULL);
+  }
+  if (!ok) {
+    return wuffs_base__make_status(
+        wuffs_base__error__unsupported_pixel_swizzler_option);
+  }
+  p->private_impl.color_conversion = c;
+  return wuffs_base__make_status(NULL);
+}
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_base__pixel_swizzler__set_color_conversion_from_options(
+    wuffs_base__pixel_swizzler* p,
+    const wuffs_base__decode_frame_options* opts) {
+  return wuffs_base__pixel_swizzler__set_color_conversion(
+      p, wuffs_base__decode_frame_options__color_conversion(opts));
+}
+
+// wuffs_base__pixel_swizzler__convert_color_u8 converts one pixel's three 8
+// bit color channels in place, in Blue, Green, Red order.
+static inline void  //
+wuffs_base__pixel_swizzler__convert_color_u8(
+    const wuffs_base__color_conversion* c,
+    uint8_t* b,
+    uint8_t* g,
+    uint8_t* r) {
+  const uint8_t* t = c->private_impl.table_u8;
+  if (t) {
+    *b = t[0x000 + *b];
+    *g = t[0x100 + *g];
+    *r = t[0x200 + *r];
+    return;
+  }
+
+  const uint16_t* lin = c->private_impl.linearize_u16;
+  const uint8_t* delin = c->private_impl.delinearize_u8;
+  const int32_t* m = &c->private_impl.matrix[0];
+  int64_t lr = lin[*r];
+  int64_t lg = lin[*g];
+  int64_t lb = lin[*b];
+  int64_t x[3];
+  for (int i = 0; i < 3; i++) {
+    int64_t v = ((m[(3 * i) + 0] * lr) + (m[(3 * i) + 1] * lg) +
+                 (m[(3 * i) + 2] * lb)) >>
+                16;
+    x[i] = (v < 0) ? 0 : ((v > 0xFFFF) ? 0xFFFF : v);
+  }
+  *r = delin[x[0] >> 4];
+  *g = delin[x[1] >> 4];
+  *b = delin[x[2] >> 4];
+}
+
+// wuffs_base__pixel_swizzler__apply_color_conversion applies p's color
+// conversion, if any, to the n pixels at dst_ptr, which the swizzler has just
+// written and so are probably still in the CPU's cache.
+static void  //
+wuffs_base__pixel_swizzler__apply_color_conversion(
+    const wuffs_base__pixel_swizzler* p,
+    uint8_t* dst_ptr,
+    uint64_t n) {
+  const wuffs_base__color_conversion* c = p->private_impl.color_conversion;
+  size_t bytes_per_pixel = 0;
+  bool is_rgb = false;
+  bool is_premul = false;
+  if (!c || !wuffs_base__pixel_swizzler__color_conversion_layout(
+                p->private_impl.dst_pixfmt_repr, &bytes_per_pixel, &is_rgb,
+                &is_premul)) {
+    return;
+  }
+  uint8_t* d = dst_ptr;
+
+  if (bytes_per_pixel == 8) {
+    const uint16_t* t = c->private_impl.table_u16;
+    for (; n > 0; n--) {
+      for (uint32_t i = 0; i < 3; i++) {
+        uint16_t v = wuffs_base__peek_u16le__no_bounds_check(d + (2 * i));
+        wuffs_base__poke_u16le__no_bounds_check(d + (2 * i),
+                                                t[(4096 * i) + (v >> 4)]);
+      }
+      d += 8;
+    }
+    return;
+  }
+
+  size_t ib = is_rgb ? 2 : 0;
+  size_t ir = is_rgb ? 0 : 2;
+  for (; n > 0; n--) {
+    uint32_t a = is_premul ? d[3] : 0xFF;
+    if (a == 0xFF) {
+      wuffs_base__pixel_swizzler__convert_color_u8(c, d + ib, d + 1, d + ir);
+    } else if (a > 0) {
+      // Un-premultiply, convert and re-premultiply.
+      uint8_t u[3];
+      for (size_t i = 0; i < 3; i++) {
+        uint32_t v = ((d[i] * 0xFFu) + (a / 2)) / a;
+        u[i] = (uint8_t)((v < 0xFF) ? v : 0xFF);
+      }
+      wuffs_base__pixel_swizzler__convert_color_u8(c, u + ib, u + 1, u + ir);
+      for (size_t i = 0; i < 3; i++) {
+        d[i] = (uint8_t)(((u[i] * a) + 0x7Fu) / 0xFFu);
+      }
+    }
+    d += bytes_per_pixel;
+  }
+}
+
 WUFFS_BASE__MAYBE_STATIC uint64_t  //
 wuffs_base__pixel_swizzler__limited_swizzle_u32_interleaved_from_reader(
     const wuffs_base__pixel_swizzler* p,
@@ -5242,6 +8554,9 @@ wuffs_base__pixel_swizzler__limited_swizzle_u32_interleaved_from_reader(
     uint64_t n =
         (*p->private_impl.func)(dst.ptr, dst.len, dst_palette.ptr,
                                 dst_palette.len, iop_r, (size_t)src_len);
+    if (p->private_impl.color_conversion) {
+      wuffs_base__pixel_swizzler__apply_color_conversion(p, dst.ptr, n);
+    }
     *ptr_iop_r += n * p->private_impl.src_pixfmt_bytes_per_pixel;
     return n;
   }
@@ -5261,6 +8576,9 @@ wuffs_base__pixel_swizzler__swizzle_interleaved_from_reader(
     uint64_t n =
         (*p->private_impl.func)(dst.ptr, dst.len, dst_palette.ptr,
                                 dst_palette.len, iop_r, (size_t)src_len);
+    if (p->private_impl.color_conversion) {
+      wuffs_base__pixel_swizzler__apply_color_conversion(p, dst.ptr, n);
+    }
     *ptr_iop_r += n * p->private_impl.src_pixfmt_bytes_per_pixel;
     return n;
   }
@@ -5274,8 +8592,12 @@ wuffs_base__pixel_swizzler__swizzle_interleaved_from_slice(
     wuffs_base__slice_u8 dst_palette,
     wuffs_base__slice_u8 src) {
   if (p && p->private_impl.func) {
-    return (*p->private_impl.func)(dst.ptr, dst.len, dst_palette.ptr,
-                                   dst_palette.len, src.ptr, src.len);
+    uint64_t n = (*p->private_impl.func)(dst.ptr, dst.len, dst_palette.ptr,
+                                         dst_palette.len, src.ptr, src.len);
+    if (p->private_impl.color_conversion) {
+      wuffs_base__pixel_swizzler__apply_color_conversion(p, dst.ptr, n);
+    }
+    return n;
   }
   return 0;
 }
@@ -5293,3 +8615,645 @@ wuffs_base__pixel_swizzler__swizzle_interleaved_transparent_black(
   }
   return 0;
 }
+
+// --------
+
+// wuffs_base__pixel_swizzler__unpack_bits expands each of the src_len bytes
+// into (8 / depth) dst bytes, one per depth-bit value, most significant bits
+// first. When scale_to_u8 is true, each value is also scaled from [0, (1 <<
+// depth) - 1] to [0, 255], as if it were a gray level instead of an index.
+static void  //
+wuffs_base__pixel_swizzler__unpack_bits(uint8_t* dst_ptr,
+                                        const uint8_t* src_ptr,
+                                        size_t src_len,
+                                        uint32_t depth,
+                                        bool scale_to_u8) {
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = src_len;
+
+  if (depth == 1) {
+    uint8_t m = scale_to_u8 ? 0xFF : 0x01;
+    while (n--) {
+      uint32_t s0 = *s++;
+      d[0] = (uint8_t)(m & (0u - (1 & (s0 >> 7))));
+      d[1] = (uint8_t)(m & (0u - (1 & (s0 >> 6))));
+      d[2] = (uint8_t)(m & (0u - (1 & (s0 >> 5))));
+      d[3] = (uint8_t)(m & (0u - (1 & (s0 >> 4))));
+      d[4] = (uint8_t)(m & (0u - (1 & (s0 >> 3))));
+      d[5] = (uint8_t)(m & (0u - (1 & (s0 >> 2))));
+      d[6] = (uint8_t)(m & (0u - (1 & (s0 >> 1))));
+      d[7] = (uint8_t)(m & (0u - (1 & (s0 >> 0))));
+      d += 8;
+    }
+
+  } else if (depth == 2) {
+    uint32_t m = scale_to_u8 ? 0x55 : 0x01;
+    while (n--) {
+      uint32_t s0 = *s++;
+      d[0] = (uint8_t)(m * (3 & (s0 >> 6)));
+      d[1] = (uint8_t)(m * (3 & (s0 >> 4)));
+      d[2] = (uint8_t)(m * (3 & (s0 >> 2)));
+      d[3] = (uint8_t)(m * (3 & (s0 >> 0)));
+      d += 4;
+    }
+
+  } else if (depth == 4) {
+    uint32_t m = scale_to_u8 ? 0x11 : 0x01;
+    while (n--) {
+      uint32_t s0 = *s++;
+      d[0] = (uint8_t)(m * (15 & (s0 >> 4)));
+      d[1] = (uint8_t)(m * (15 & (s0 >> 0)));
+      d += 2;
+    }
+  }
+}
+
+// ‼ WUFFS MULTI-FILE SECTION +x86_sse42
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+static void  //
+wuffs_base__pixel_swizzler__unpack_bits__sse42(uint8_t* dst_ptr,
+                                               const uint8_t* src_ptr,
+                                               size_t src_len,
+                                               uint32_t depth,
+                                               bool scale_to_u8) {
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = src_len;
+
+  if (depth == 1) {
+    // Broadcast each of two source bytes to eight lanes, then test each
+    // lane's bit, producing 0x00 or 0xFF.
+    __m128i shuffle = _mm_set_epi8(+0x01, +0x01, +0x01, +0x01,  //
+                                   +0x01, +0x01, +0x01, +0x01,  //
+                                   +0x00, +0x00, +0x00, +0x00,  //
+                                   +0x00, +0x00, +0x00, +0x00);
+    __m128i bits = _mm_set_epi8(+0x01, +0x02, +0x04, +0x08,  //
+                                +0x10, +0x20, +0x40, -0x80,  //
+                                +0x01, +0x02, +0x04, +0x08,  //
+                                +0x10, +0x20, +0x40, -0x80);
+    __m128i m = _mm_set1_epi8(scale_to_u8 ? -0x01 : +0x01);
+
+    while (n >= 2) {
+      __m128i x;
+      x = _mm_cvtsi32_si128((int)(wuffs_base__peek_u16le__no_bounds_check(s)));
+      x = _mm_shuffle_epi8(x, shuffle);
+      x = _mm_cmpeq_epi8(_mm_and_si128(x, bits), bits);
+      x = _mm_and_si128(x, m);
+      _mm_storeu_si128((__m128i*)(void*)d, x);
+
+      s += 2;
+      d += 16;
+      n -= 2;
+    }
+
+  } else if (depth == 4) {
+    // Split eight source bytes into high and low nibbles, then interleave
+    // them (high nibble first).
+    __m128i mask = _mm_set1_epi8(+0x0F);
+
+    while (n >= 8) {
+      __m128i x;
+      __m128i hi;
+      __m128i lo;
+      x = _mm_loadl_epi64((const __m128i*)(const void*)s);
+      hi = _mm_and_si128(_mm_srli_epi16(x, 4), mask);
+      lo = _mm_and_si128(x, mask);
+      x = _mm_unpacklo_epi8(hi, lo);
+      if (scale_to_u8) {
+        x = _mm_or_si128(x, _mm_slli_epi16(x, 4));
+      }
+      _mm_storeu_si128((__m128i*)(void*)d, x);
+
+      s += 8;
+      d += 16;
+      n -= 8;
+    }
+  }
+
+  wuffs_base__pixel_swizzler__unpack_bits(d, s, n, depth, scale_to_u8);
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// ‼ WUFFS MULTI-FILE SECTION -x86_sse42
+
+// wuffs_base__pixel_swizzler__swizzle_interleaved_from_packed_slice is like
+// wuffs_base__pixel_swizzler__swizzle_interleaved_from_slice but the source
+// pixels are packed 1, 2 or 4 bits each (most significant bits first), not
+// one byte each. The swizzler must have been prepared with an 8 bits per
+// pixel source format, such as Y or INDEXED__BGRA_BINARY.
+//
+// The first src_skip packed pixels of src are skipped. At most num_pixels
+// pixels are converted. It returns the number of pixels converted.
+//
+// The packed pixels are unpacked in chunks, on the stack, and each chunk is
+// then swizzled with one call, instead of calling the swizzler once per
+// pixel.
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_base__pixel_swizzler__swizzle_interleaved_from_packed_slice(
+    const wuffs_base__pixel_swizzler* p,
+    wuffs_base__slice_u8 dst,
+    wuffs_base__slice_u8 dst_palette,
+    wuffs_base__slice_u8 src,
+    uint32_t src_bits_per_pixel,
+    uint32_t src_skip,
+    uint64_t num_pixels,
+    bool scale_to_u8) {
+  if (!p || !p->private_impl.func ||
+      (p->private_impl.src_pixfmt_bytes_per_pixel != 1) ||
+      (p->private_impl.dst_pixfmt_bytes_per_pixel == 0) ||
+      ((src_bits_per_pixel != 1) && (src_bits_per_pixel != 2) &&
+       (src_bits_per_pixel != 4))) {
+    return 0;
+  }
+  size_t dst_bpp = p->private_impl.dst_pixfmt_bytes_per_pixel;
+  uint64_t pixels_per_byte = 8 / src_bits_per_pixel;
+
+  uint64_t skip_bytes = src_skip / pixels_per_byte;
+  if (skip_bytes >= src.len) {
+    return 0;
+  }
+  const uint8_t* s = src.ptr + skip_bytes;
+  size_t s_len = src.len - (size_t)skip_bytes;
+  size_t head = (size_t)(src_skip % pixels_per_byte);
+
+  uint64_t n = (s_len * pixels_per_byte) - head;
+  if (n > num_pixels) {
+    n = num_pixels;
+  }
+  if (n > (dst.len / dst_bpp)) {
+    n = dst.len / dst_bpp;
+  }
+
+  void (*unpack)(uint8_t*, const uint8_t*, size_t, uint32_t, bool) =
+      &wuffs_base__pixel_swizzler__unpack_bits;
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+  if (wuffs_base__cpu_arch__have_x86_sse42()) {
+    unpack = &wuffs_base__pixel_swizzler__unpack_bits__sse42;
+  }
+#endif
+
+  uint8_t buf[256];
+  uint8_t* d = dst.ptr;
+  size_t d_len = dst.len;
+  uint64_t total = 0;
+  while (total < n) {
+    uint64_t want = (n - total) + head;
+    size_t num_src_bytes = (size_t)((want + pixels_per_byte - 1) /
+                                    pixels_per_byte);
+    if (num_src_bytes > (sizeof(buf) / pixels_per_byte)) {
+      num_src_bytes = (size_t)(sizeof(buf) / pixels_per_byte);
+    }
+    (*unpack)(buf, s, num_src_bytes, src_bits_per_pixel, scale_to_u8);
+
+    size_t num_buf_pixels = (size_t)(num_src_bytes * pixels_per_byte) - head;
+    if (num_buf_pixels > (n - total)) {
+      num_buf_pixels = (size_t)(n - total);
+    }
+    uint64_t m = (*p->private_impl.func)(d, d_len, dst_palette.ptr,
+                                         dst_palette.len, buf + head,
+                                         num_buf_pixels);
+    if (p->private_impl.color_conversion) {
+      wuffs_base__pixel_swizzler__apply_color_conversion(p, d, m);
+    }
+    total += m;
+    if (m < num_buf_pixels) {
+      break;
+    }
+    d += (size_t)m * dst_bpp;
+    d_len -= (size_t)m * dst_bpp;
+    s += num_src_bytes;
+    head = 0;
+  }
+  return total;
+}
+
+// --------
+
+// wuffs_base__pixel_swizzler__unpack_u16be converts num_pixels pixels, each
+// with num_channels (1, 2, 3 or 4) big-endian 16-bit channels (Y, YA, RGB or
+// RGBA, as in 16-bit PNG images), to BGRA_NONPREMUL_4X16LE.
+static void  //
+wuffs_base__pixel_swizzler__unpack_u16be(uint8_t* dst_ptr,
+                                         const uint8_t* src_ptr,
+                                         size_t num_pixels,
+                                         uint32_t num_channels) {
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = num_pixels;
+
+  if (num_channels == 1) {
+    while (n--) {
+      d[0] = s[1];
+      d[1] = s[0];
+      d[2] = s[1];
+      d[3] = s[0];
+      d[4] = s[1];
+      d[5] = s[0];
+      d[6] = 0xFF;
+      d[7] = 0xFF;
+      s += 2;
+      d += 8;
+    }
+
+  } else if (num_channels == 2) {
+    while (n--) {
+      d[0] = s[1];
+      d[1] = s[0];
+      d[2] = s[1];
+      d[3] = s[0];
+      d[4] = s[1];
+      d[5] = s[0];
+      d[6] = s[3];
+      d[7] = s[2];
+      s += 4;
+      d += 8;
+    }
+
+  } else if (num_channels == 3) {
+    while (n--) {
+      d[0] = s[5];
+      d[1] = s[4];
+      d[2] = s[3];
+      d[3] = s[2];
+      d[4] = s[1];
+      d[5] = s[0];
+      d[6] = 0xFF;
+      d[7] = 0xFF;
+      s += 6;
+      d += 8;
+    }
+
+  } else if (num_channels == 4) {
+    while (n--) {
+      d[0] = s[5];
+      d[1] = s[4];
+      d[2] = s[3];
+      d[3] = s[2];
+      d[4] = s[1];
+      d[5] = s[0];
+      d[6] = s[7];
+      d[7] = s[6];
+      s += 8;
+      d += 8;
+    }
+  }
+}
+
+// ‼ WUFFS MULTI-FILE SECTION +arm_neon
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+static inline uint16x8_t  //
+wuffs_base__swap_u16x8__neon(uint16x8_t x) {
+  return vreinterpretq_u16_u8(vrev16q_u8(vreinterpretq_u8_u16(x)));
+}
+
+static void  //
+wuffs_base__pixel_swizzler__unpack_u16be__neon(uint8_t* dst_ptr,
+                                               const uint8_t* src_ptr,
+                                               size_t num_pixels,
+                                               uint32_t num_channels) {
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = num_pixels;
+  uint16x8_t opaque = vdupq_n_u16(0xFFFF);
+
+  // De-interleaving loads and the byte swaps give the channels in the
+  // platform's (little-endian) order. Re-interleaving stores then write them
+  // in B, G, R, A order.
+  if (num_channels == 1) {
+    while (n >= 8) {
+      uint16x8x4_t y;
+      y.val[0] = wuffs_base__swap_u16x8__neon(
+          vld1q_u16((const uint16_t*)(const void*)s));
+      y.val[1] = y.val[0];
+      y.val[2] = y.val[0];
+      y.val[3] = opaque;
+      vst4q_u16((uint16_t*)(void*)d, y);
+      s += 8 * 2;
+      d += 8 * 8;
+      n -= 8;
+    }
+
+  } else if (num_channels == 2) {
+    while (n >= 8) {
+      uint16x8x2_t x = vld2q_u16((const uint16_t*)(const void*)s);
+      uint16x8x4_t y;
+      y.val[0] = wuffs_base__swap_u16x8__neon(x.val[0]);
+      y.val[1] = y.val[0];
+      y.val[2] = y.val[0];
+      y.val[3] = wuffs_base__swap_u16x8__neon(x.val[1]);
+      vst4q_u16((uint16_t*)(void*)d, y);
+      s += 8 * 4;
+      d += 8 * 8;
+      n -= 8;
+    }
+
+  } else if (num_channels == 3) {
+    while (n >= 8) {
+      uint16x8x3_t x = vld3q_u16((const uint16_t*)(const void*)s);
+      uint16x8x4_t y;
+      y.val[0] = wuffs_base__swap_u16x8__neon(x.val[2]);
+      y.val[1] = wuffs_base__swap_u16x8__neon(x.val[1]);
+      y.val[2] = wuffs_base__swap_u16x8__neon(x.val[0]);
+      y.val[3] = opaque;
+      vst4q_u16((uint16_t*)(void*)d, y);
+      s += 8 * 6;
+      d += 8 * 8;
+      n -= 8;
+    }
+
+  } else if (num_channels == 4) {
+    while (n >= 8) {
+      uint16x8x4_t x = vld4q_u16((const uint16_t*)(const void*)s);
+      uint16x8x4_t y;
+      y.val[0] = wuffs_base__swap_u16x8__neon(x.val[2]);
+      y.val[1] = wuffs_base__swap_u16x8__neon(x.val[1]);
+      y.val[2] = wuffs_base__swap_u16x8__neon(x.val[0]);
+      y.val[3] = wuffs_base__swap_u16x8__neon(x.val[3]);
+      vst4q_u16((uint16_t*)(void*)d, y);
+      s += 8 * 8;
+      d += 8 * 8;
+      n -= 8;
+    }
+  }
+
+  wuffs_base__pixel_swizzler__unpack_u16be(d, s, n, num_channels);
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+// ‼ WUFFS MULTI-FILE SECTION -arm_neon
+
+// ‼ WUFFS MULTI-FILE SECTION +x86_sse42
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+static void  //
+wuffs_base__pixel_swizzler__unpack_u16be__sse42(uint8_t* dst_ptr,
+                                                const uint8_t* src_ptr,
+                                                size_t num_pixels,
+                                                uint32_t num_channels) {
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = num_pixels;
+
+  // Each shuffle produces two BGRA_NONPREMUL_4X16LE pixels. A -0x80 index
+  // produces a zero byte, for or_ffff to set to an opaque alpha.
+  __m128i or_ffff = _mm_set_epi8(-0x01, -0x01, +0x00, +0x00,  //
+                                 +0x00, +0x00, +0x00, +0x00,  //
+                                 -0x01, -0x01, +0x00, +0x00,  //
+                                 +0x00, +0x00, +0x00, +0x00);
+
+  if (num_channels == 1) {
+    __m128i shuffle0 = _mm_set_epi8(-0x80, -0x80, +0x02, +0x03,  //
+                                    +0x02, +0x03, +0x02, +0x03,  //
+                                    -0x80, -0x80, +0x00, +0x01,  //
+                                    +0x00, +0x01, +0x00, +0x01);
+    __m128i shuffle1 = _mm_set_epi8(-0x80, -0x80, +0x06, +0x07,  //
+                                    +0x06, +0x07, +0x06, +0x07,  //
+                                    -0x80, -0x80, +0x04, +0x05,  //
+                                    +0x04, +0x05, +0x04, +0x05);
+    __m128i shuffle2 = _mm_set_epi8(-0x80, -0x80, +0x0A, +0x0B,  //
+                                    +0x0A, +0x0B, +0x0A, +0x0B,  //
+                                    -0x80, -0x80, +0x08, +0x09,  //
+                                    +0x08, +0x09, +0x08, +0x09);
+    __m128i shuffle3 = _mm_set_epi8(-0x80, -0x80, +0x0E, +0x0F,  //
+                                    +0x0E, +0x0F, +0x0E, +0x0F,  //
+                                    -0x80, -0x80, +0x0C, +0x0D,  //
+                                    +0x0C, +0x0D, +0x0C, +0x0D);
+    while (n >= 8) {
+      __m128i x = _mm_lddqu_si128((const __m128i*)(const void*)s);
+      _mm_storeu_si128((__m128i*)(void*)(d + 0x00),
+                       _mm_or_si128(_mm_shuffle_epi8(x, shuffle0), or_ffff));
+      _mm_storeu_si128((__m128i*)(void*)(d + 0x10),
+                       _mm_or_si128(_mm_shuffle_epi8(x, shuffle1), or_ffff));
+      _mm_storeu_si128((__m128i*)(void*)(d + 0x20),
+                       _mm_or_si128(_mm_shuffle_epi8(x, shuffle2), or_ffff));
+      _mm_storeu_si128((__m128i*)(void*)(d + 0x30),
+                       _mm_or_si128(_mm_shuffle_epi8(x, shuffle3), or_ffff));
+      s += 8 * 2;
+      d += 8 * 8;
+      n -= 8;
+    }
+
+  } else if (num_channels == 2) {
+    __m128i shuffle0 = _mm_set_epi8(+0x06, +0x07, +0x04, +0x05,  //
+                                    +0x04, +0x05, +0x04, +0x05,  //
+                                    +0x02, +0x03, +0x00, +0x01,  //
+                                    +0x00, +0x01, +0x00, +0x01);
+    __m128i shuffle1 = _mm_set_epi8(+0x0E, +0x0F, +0x0C, +0x0D,  //
+                                    +0x0C, +0x0D, +0x0C, +0x0D,  //
+                                    +0x0A, +0x0B, +0x08, +0x09,  //
+                                    +0x08, +0x09, +0x08, +0x09);
+    while (n >= 4) {
+      __m128i x = _mm_lddqu_si128((const __m128i*)(const void*)s);
+      _mm_storeu_si128((__m128i*)(void*)(d + 0x00),
+                       _mm_shuffle_epi8(x, shuffle0));
+      _mm_storeu_si128((__m128i*)(void*)(d + 0x10),
+                       _mm_shuffle_epi8(x, shuffle1));
+      s += 4 * 4;
+      d += 4 * 8;
+      n -= 4;
+    }
+
+  } else if (num_channels == 3) {
+    __m128i shuffle = _mm_set_epi8(-0x80, -0x80, +0x06, +0x07,  //
+                                   +0x08, +0x09, +0x0A, +0x0B,  //
+                                   -0x80, -0x80, +0x00, +0x01,  //
+                                   +0x02, +0x03, +0x04, +0x05);
+    // Loading 16 bytes reads past the two pixels' 12 bytes, so stop early.
+    while (n >= 3) {
+      __m128i x = _mm_lddqu_si128((const __m128i*)(const void*)s);
+      _mm_storeu_si128((__m128i*)(void*)d,
+                       _mm_or_si128(_mm_shuffle_epi8(x, shuffle), or_ffff));
+      s += 2 * 6;
+      d += 2 * 8;
+      n -= 2;
+    }
+
+  } else if (num_channels == 4) {
+    __m128i shuffle = _mm_set_epi8(+0x0E, +0x0F, +0x08, +0x09,  //
+                                   +0x0A, +0x0B, +0x0C, +0x0D,  //
+                                   +0x06, +0x07, +0x00, +0x01,  //
+                                   +0x02, +0x03, +0x04, +0x05);
+    while (n >= 2) {
+      __m128i x = _mm_lddqu_si128((const __m128i*)(const void*)s);
+      _mm_storeu_si128((__m128i*)(void*)d, _mm_shuffle_epi8(x, shuffle));
+      s += 2 * 8;
+      d += 2 * 8;
+      n -= 2;
+    }
+  }
+
+  wuffs_base__pixel_swizzler__unpack_u16be(d, s, n, num_channels);
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// ‼ WUFFS MULTI-FILE SECTION -x86_sse42
+
+// wuffs_base__pixel_swizzler__swizzle_interleaved_from_u16be_slice is like
+// wuffs_base__pixel_swizzler__swizzle_interleaved_from_slice but the source
+// pixels have src_num_channels (1, 2, 3 or 4) big-endian 16-bit channels: Y,
+// YA, RGB or RGBA, as in 16-bit PNG images. The swizzler must have been
+// prepared with a BGRA_NONPREMUL_4X16LE source format.
+//
+// At most num_pixels pixels are converted. It returns the number of pixels
+// converted.
+//
+// Like wuffs_base__pixel_swizzler__swizzle_interleaved_from_packed_slice, the
+// source pixels are converted (here, byte-swapped and re-ordered) in chunks,
+// on the stack, and each chunk is then swizzled with one call.
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_base__pixel_swizzler__swizzle_interleaved_from_u16be_slice(
+    const wuffs_base__pixel_swizzler* p,
+    wuffs_base__slice_u8 dst,
+    wuffs_base__slice_u8 dst_palette,
+    wuffs_base__slice_u8 src,
+    uint32_t src_num_channels,
+    uint64_t num_pixels) {
+  if (!p || !p->private_impl.func ||
+      (p->private_impl.src_pixfmt_bytes_per_pixel != 8) ||
+      (p->private_impl.dst_pixfmt_bytes_per_pixel == 0) ||
+      (src_num_channels < 1) || (src_num_channels > 4)) {
+    return 0;
+  }
+  size_t dst_bpp = p->private_impl.dst_pixfmt_bytes_per_pixel;
+  size_t src_bpp = 2 * (size_t)src_num_channels;
+
+  uint64_t n = src.len / src_bpp;
+  if (n > num_pixels) {
+    n = num_pixels;
+  }
+  if (n > (dst.len / dst_bpp)) {
+    n = dst.len / dst_bpp;
+  }
+
+  void (*unpack)(uint8_t*, const uint8_t*, size_t, uint32_t) =
+      &wuffs_base__pixel_swizzler__unpack_u16be;
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+  unpack = &wuffs_base__pixel_swizzler__unpack_u16be__neon;
+#elif defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+  if (wuffs_base__cpu_arch__have_x86_sse42()) {
+    unpack = &wuffs_base__pixel_swizzler__unpack_u16be__sse42;
+  }
+#endif
+
+  uint8_t buf[1024];
+  const uint8_t* s = src.ptr;
+  uint8_t* d = dst.ptr;
+  size_t d_len = dst.len;
+  uint64_t total = 0;
+  while (total < n) {
+    size_t num_buf_pixels = sizeof(buf) / 8;
+    if (num_buf_pixels > (n - total)) {
+      num_buf_pixels = (size_t)(n - total);
+    }
+    (*unpack)(buf, s, num_buf_pixels, src_num_channels);
+
+    uint64_t m = (*p->private_impl.func)(d, d_len, dst_palette.ptr,
+                                         dst_palette.len, buf,
+                                         num_buf_pixels * 8);
+    if (p->private_impl.color_conversion) {
+      wuffs_base__pixel_swizzler__apply_color_conversion(p, d, m);
+    }
+    total += m;
+    if (m < num_buf_pixels) {
+      break;
+    }
+    d += (size_t)m * dst_bpp;
+    d_len -= (size_t)m * dst_bpp;
+    s += num_buf_pixels * src_bpp;
+  }
+  return total;
+}
+
+// --------
+
+// wuffs_base__utility__downscale_accumulate adds the src pixels, whose first
+// pixel is in column x, to the accumulator. The accumulator holds, for each
+// (1 << shift) wide block of columns, one uint16_t little-endian sum per byte
+// of a bytes_per_pixel pixel. Passing a zero num_rows (the number of rows
+// already accumulated) starts afresh, discarding the blocks' previous sums.
+WUFFS_BASE__MAYBE_STATIC void  //
+wuffs_base__utility__downscale_accumulate(wuffs_base__slice_u8 accumulator,
+                                          wuffs_base__slice_u8 src,
+                                          uint32_t x,
+                                          uint32_t num_rows,
+                                          uint32_t bytes_per_pixel,
+                                          uint32_t shift) {
+  if ((bytes_per_pixel == 0) || (bytes_per_pixel > 4) || (shift > 3)) {
+    return;
+  }
+  size_t bpp = bytes_per_pixel;
+  size_t n = src.len / bpp;
+  size_t acc_columns = (accumulator.len / (2 * bpp)) << shift;
+  if (((size_t)x) >= acc_columns) {
+    return;
+  } else if (n > (acc_columns - ((size_t)x))) {
+    n = acc_columns - ((size_t)x);
+  }
+
+  if (num_rows == 0) {
+    size_t b0 = ((size_t)x) >> shift;
+    size_t b1 = ((((size_t)x) + n) + ((((size_t)1) << shift) - 1)) >> shift;
+    memset(accumulator.ptr + (b0 * 2 * bpp), 0, (b1 - b0) * 2 * bpp);
+  }
+
+  const uint8_t* s = src.ptr;
+  size_t i;
+  for (i = 0; i < n; i++) {
+    uint8_t* a = accumulator.ptr + (((((size_t)x) + i) >> shift) * 2 * bpp);
+    size_t c;
+    for (c = 0; c < bpp; c++) {
+      uint16_t sum = wuffs_base__peek_u16le__no_bounds_check(a + (2 * c));
+      wuffs_base__poke_u16le__no_bounds_check(a + (2 * c),
+                                              (uint16_t)(sum + s[c]));
+    }
+    s += bpp;
+  }
+}
+
+// wuffs_base__utility__downscale_flush writes the average of the accumulated
+// pixels to dst, one pixel per block that overlaps the columns [x0, x1). Each
+// average is over the num_rows rows and those columns of the block that are
+// in [x0, x1). dst's first pixel is for the block at column 0.
+WUFFS_BASE__MAYBE_STATIC void  //
+wuffs_base__utility__downscale_flush(wuffs_base__slice_u8 dst,
+                                     wuffs_base__slice_u8 accumulator,
+                                     uint32_t x0,
+                                     uint32_t x1,
+                                     uint32_t num_rows,
+                                     uint32_t bytes_per_pixel,
+                                     uint32_t shift) {
+  if ((bytes_per_pixel == 0) || (bytes_per_pixel > 4) || (shift > 3) ||
+      (num_rows == 0) || (x0 >= x1)) {
+    return;
+  }
+  size_t bpp = bytes_per_pixel;
+  size_t b = ((size_t)x0) >> shift;
+  size_t b1 = ((((size_t)x1) - 1) >> shift) + 1;
+  size_t dst_blocks = dst.len / bpp;
+  size_t acc_blocks = accumulator.len / (2 * bpp);
+  if (b1 > dst_blocks) {
+    b1 = dst_blocks;
+  }
+  if (b1 > acc_blocks) {
+    b1 = acc_blocks;
+  }
+
+  for (; b < b1; b++) {
+    uint32_t bx0 = ((uint32_t)b) << shift;
+    uint32_t bx1 = bx0 + (((uint32_t)1) << shift);
+    bx0 = (bx0 > x0) ? bx0 : x0;
+    bx1 = (bx1 < x1) ? bx1 : x1;
+    uint32_t divisor = (bx1 - bx0) * num_rows;
+    const uint8_t* a = accumulator.ptr + (b * 2 * bpp);
+    uint8_t* d = dst.ptr + (b * bpp);
+    size_t c;
+    for (c = 0; c < bpp; c++) {
+      uint32_t sum = wuffs_base__peek_u16le__no_bounds_check(a + (2 * c));
+      d[c] = (uint8_t)((sum + (divisor / 2)) / divisor);
+    }
+  }
+}
+
+#if defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ENABLE_ALLOWLIST) && \
+    defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
@@ -14,4 +14,35 @@
 
 // ---------------- String Conversions
 
+// wuffs_base__private_implementation__is_eight_decimal_digits returns whether
+// all 8 bytes of x, e.g. from a little-endian load of "12345678", are ASCII
+// decimal digits.
+//
+// A byte b is a digit when neither (b + 0x46) nor (b - 0x30) has its high bit
+// set. Carries and borrows only propagate towards higher bytes, and only out
+// of non-digit bytes, so they cannot hide a non-digit byte.
+static inline bool  //
+wuffs_base__private_implementation__is_eight_decimal_digits(uint64_t x) {
+  return (((x + 0x4646464646464646) | (x - 0x3030303030303030)) &
+          0x8080808080808080) == 0;
+}
+
+// wuffs_base__private_implementation__parse_eight_decimal_digits converts 8
+// ASCII decimal digits, loaded little-endian (so that the first, most
+// significant, digit is the low byte), to their value in 0 ..= 99999999. It
+// combines adjacent digits into 2-digit, then 4-digit and then 8-digit lanes,
+// with 3 multiplies instead of 8.
+//
+// See "SWAR explained: parsing eight digits" by Lemire
+// (https://lemire.me/blog/2022/01/21/swar-explained-parsing-eight-digits/).
+static inline uint32_t  //
+wuffs_base__private_implementation__parse_eight_decimal_digits(uint64_t x) {
+  x -= 0x3030303030303030;
+  x = (x * 10) + (x >> 8);
+  x = (((x & 0x000000FF000000FF) * 0x000F424000000064) +
+       (((x >> 16) & 0x000000FF000000FF) * 0x0000271000000001)) >>
+      32;
+  return (uint32_t)x;
+}
+
 // ---------------- Unicode and UTF-8
@@ -197,14 +197,160 @@ wuffs_base__utf_8__next_from_end(const uint8_t* s_ptr, size_t s_len) {
       WUFFS_BASE__UNICODE_REPLACEMENT_CHARACTER, 1);
 }
 
+// ‼ WUFFS MULTI-FILE SECTION +x86_sse42
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// wuffs_base__utf_8__errors__sse42 returns a non-zero vector if the 16 bytes
+// of x, preceded by the 16 bytes of prev, are not valid UTF-8. A multi-byte
+// encoding that starts in prev and is incomplete is an error, but one that
+// starts in x and is incomplete (continues after x) is not.
+//
+// It uses the lookup algorithm from "Validating UTF-8 In Less Than One
+// Instruction Per Byte" by John Keiser and Daniel Lemire
+// (https://arxiv.org/abs/2010.03090). Three 16-entry look-up tables, indexed
+// by nibbles, map each pair of consecutive bytes to a bit set of the errors it
+// could be. A pair is invalid if the bitwise-and of those is non-zero, apart
+// from the third and fourth bytes of 3- and 4-byte encodings, which must be
+// continuation bytes and are checked separately.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+static inline __m128i  //
+wuffs_base__utf_8__errors__sse42(__m128i x, __m128i prev) {
+  // The error bits are TOO_SHORT (0x01), TOO_LONG (0x02), OVERLONG_3 (0x04),
+  // TOO_LARGE (0x08), SURROGATE (0x10), OVERLONG_2 (0x20), TOO_LARGE_1000 or
+  // OVERLONG_4 (0x40) and TWO_CONTS (0x80). CARRY is TOO_SHORT | TOO_LONG |
+  // TWO_CONTS (0x83).
+  //
+  // The first table is indexed by the previous byte's high nibble.
+  const __m128i byte_1_high = _mm_setr_epi8(  //
+      +0x02, +0x02, +0x02, +0x02,             // 0x00 ..= 0x3F, ASCII.
+      +0x02, +0x02, +0x02, +0x02,             // 0x40 ..= 0x7F, ASCII.
+      -0x80, -0x80, -0x80, -0x80,             // 0x80 ..= 0xBF, continuation.
+      +0x21, +0x01, +0x15, +0x49);            // 0xC0 ..= 0xFF, lead.
+  // The second table is indexed by the previous byte's low nibble.
+  const __m128i byte_1_low = _mm_setr_epi8(  //
+      -0x19, -0x5D, -0x7D, -0x7D,            // 0x_0 ..= 0x_3.
+      -0x75, -0x35, -0x35, -0x35,            // 0x_4 ..= 0x_7.
+      -0x35, -0x35, -0x35, -0x35,            // 0x_8 ..= 0x_B.
+      -0x35, -0x25, -0x35, -0x35);           // 0x_C ..= 0x_F.
+  // The third table is indexed by the current byte's high nibble.
+  const __m128i byte_2_high = _mm_setr_epi8(  //
+      +0x01, +0x01, +0x01, +0x01,             // 0x00 ..= 0x3F, ASCII.
+      +0x01, +0x01, +0x01, +0x01,             // 0x40 ..= 0x7F, ASCII.
+      -0x1A, -0x52, -0x46, -0x46,             // 0x80 ..= 0xBF, continuation.
+      +0x01, +0x01, +0x01, +0x01);            // 0xC0 ..= 0xFF, lead.
+  const __m128i nibble_mask = _mm_set1_epi8(+0x0F);
+  const __m128i third_byte_sub = _mm_set1_epi8(+0x60);   // 0xE0 - 0x80.
+  const __m128i fourth_byte_sub = _mm_set1_epi8(+0x70);  // 0xF0 - 0x80.
+  const __m128i high_bits = _mm_set1_epi8(-0x80);
+
+  __m128i prev1 = _mm_alignr_epi8(x, prev, 15);
+  __m128i b1h = _mm_shuffle_epi8(
+      byte_1_high, _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble_mask));
+  __m128i b1l = _mm_shuffle_epi8(byte_1_low, _mm_and_si128(prev1, nibble_mask));
+  __m128i b2h = _mm_shuffle_epi8(
+      byte_2_high, _mm_and_si128(_mm_srli_epi16(x, 4), nibble_mask));
+  __m128i special = _mm_and_si128(_mm_and_si128(b1h, b1l), b2h);
+
+  __m128i prev2 = _mm_alignr_epi8(x, prev, 14);
+  __m128i prev3 = _mm_alignr_epi8(x, prev, 13);
+  __m128i must23 =
+      _mm_and_si128(_mm_or_si128(_mm_subs_epu8(prev2, third_byte_sub),
+                                 _mm_subs_epu8(prev3, fourth_byte_sub)),
+                    high_bits);
+
+  return _mm_xor_si128(must23, special);
+}
+
+// wuffs_base__utf_8__longest_valid_prefix__sse42 returns the length n of a
+// prefix of s that is valid UTF-8 and ends on a code point boundary. The
+// longest valid prefix of s is then n plus the longest valid prefix of s[n..],
+// which the caller finds with the one-code-point-at-a-time loop. That loop has
+// at most 67 bytes more to look at than it would otherwise need to.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+static size_t  //
+wuffs_base__utf_8__longest_valid_prefix__sse42(const uint8_t* s_ptr,
+                                               size_t s_len) {
+  // Saturating-subtracting these leaves a non-zero byte wherever a lead byte
+  // in the last three positions needs continuation bytes beyond the block.
+  const __m128i incomplete_max = _mm_setr_epi8(  //
+      -0x01, -0x01, -0x01, -0x01,                // [0 ..= 3].
+      -0x01, -0x01, -0x01, -0x01,                // [4 ..= 7].
+      -0x01, -0x01, -0x01, -0x01,                // [8 ..= 11].
+      -0x01, -0x11, -0x21, -0x41);               // [12 ..= 15].
+
+  // Check 64 bytes (4 blocks) per loop iteration. Branching less often is
+  // faster, even if it means re-checking more bytes after an error.
+  const uint8_t* p = s_ptr;
+  const uint8_t* q = s_ptr + s_len;
+  __m128i prev = _mm_setzero_si128();
+  __m128i prev_incomplete = _mm_setzero_si128();
+  while ((q - p) >= 64) {
+    __m128i x0 = _mm_lddqu_si128((const __m128i*)(const void*)(p + 0x00));
+    __m128i x1 = _mm_lddqu_si128((const __m128i*)(const void*)(p + 0x10));
+    __m128i x2 = _mm_lddqu_si128((const __m128i*)(const void*)(p + 0x20));
+    __m128i x3 = _mm_lddqu_si128((const __m128i*)(const void*)(p + 0x30));
+
+    __m128i all = _mm_or_si128(_mm_or_si128(x0, x1), _mm_or_si128(x2, x3));
+    if (_mm_movemask_epi8(all) == 0) {
+      // All-ASCII blocks are valid, if the previous block was complete.
+      if (!_mm_testz_si128(prev_incomplete, prev_incomplete)) {
+        break;
+      }
+    } else {
+      __m128i errors = _mm_or_si128(
+          _mm_or_si128(wuffs_base__utf_8__errors__sse42(x0, prev),
+                       wuffs_base__utf_8__errors__sse42(x1, x0)),
+          _mm_or_si128(wuffs_base__utf_8__errors__sse42(x2, x1),
+                       wuffs_base__utf_8__errors__sse42(x3, x2)));
+      if (!_mm_testz_si128(errors, errors)) {
+        break;
+      }
+      prev_incomplete = _mm_subs_epu8(x3, incomplete_max);
+    }
+    prev = x3;
+    p += 64;
+  }
+
+  // The bytes before p are valid UTF-8, except that the last 1, 2 or 3 of
+  // them might be an incomplete multi-byte encoding. If so, back up to its
+  // lead byte.
+  size_t i = 1;
+  for (; (i <= 3) && (i <= ((size_t)(p - s_ptr))); i++) {
+    uint8_t c = p[-((ptrdiff_t)i)];
+    if (c < 0x80) {
+      break;
+    } else if (c >= 0xC0) {
+      if (wuffs_base__utf_8__byte_length_minus_1[c] >= i) {
+        p -= i;
+      }
+      break;
+    }
+  }
+  return (size_t)(p - s_ptr);
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+// ‼ WUFFS MULTI-FILE SECTION -x86_sse42
+
 WUFFS_BASE__MAYBE_STATIC size_t  //
 wuffs_base__utf_8__longest_valid_prefix(const uint8_t* s_ptr, size_t s_len) {
-  // TODO: possibly optimize the all-ASCII case (4 or 8 bytes at a time).
-  //
-  // TODO: possibly optimize this by manually inlining the
-  // wuffs_base__utf_8__next calls.
   size_t original_len = s_len;
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+  if ((s_len >= 64) &&
+      wuffs_base__private_implementation__use_x86_sse42(s_len)) {
+    size_t n = wuffs_base__utf_8__longest_valid_prefix__sse42(s_ptr, s_len);
+    s_ptr += n;
+    s_len -= n;
+  }
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+
   while (s_len > 0) {
+    // Skip over ASCII 8 bytes at a time.
+    if ((s_len >= 8) && ((wuffs_base__peek_u64le__no_bounds_check(s_ptr) &
+                          0x8080808080808080ul) == 0)) {
+      s_ptr += 8;
+      s_len -= 8;
+      continue;
+    }
     wuffs_base__utf_8__next__output o = wuffs_base__utf_8__next(s_ptr, s_len);
     if ((o.code_point > 0x7F) && (o.byte_length == 1)) {
       break;
@@ -217,10 +363,25 @@ wuffs_base__utf_8__longest_valid_prefix(const uint8_t* s_ptr, size_t s_len) {
 
 WUFFS_BASE__MAYBE_STATIC size_t  //
 wuffs_base__ascii__longest_valid_prefix(const uint8_t* s_ptr, size_t s_len) {
-  // TODO: possibly optimize this by checking 4 or 8 bytes at a time.
   const uint8_t* original_ptr = s_ptr;
   const uint8_t* p = s_ptr;
   const uint8_t* q = s_ptr + s_len;
+  // Check 32 and then 8 bytes at a time, before the final 0 to 7 bytes.
+  for (; (q - p) >= 32; p += 32) {
+    uint64_t x = wuffs_base__peek_u64le__no_bounds_check(p + 0x00) |
+                 wuffs_base__peek_u64le__no_bounds_check(p + 0x08) |
+                 wuffs_base__peek_u64le__no_bounds_check(p + 0x10) |
+                 wuffs_base__peek_u64le__no_bounds_check(p + 0x18);
+    if ((x & 0x8080808080808080ul) != 0) {
+      break;
+    }
+  }
+  for (; (q - p) >= 8; p += 8) {
+    if ((wuffs_base__peek_u64le__no_bounds_check(p) & 0x8080808080808080ul) !=
+        0) {
+      break;
+    }
+  }
   for (; (p != q) && ((*p & 0x80) == 0); p++) {
   }
   return (size_t)(p - original_ptr);
@@ -145,6 +145,18 @@ func (g *gen) writeBuiltinCall(b *buffer, n *a.Expr, sideEffectsOnly bool, depth
 				}
 				b.writes("&empty_io_buffer")
 				return nil
+			case t.IDStatsAdd:
+				b.writes("WUFFS_BASE__STATS__ADD(self->private_impl, ")
+				for i, o := range n.Args() {
+					if i > 0 {
+						b.writes(", ")
+					}
+					if err := g.writeExpr(b, o.AsArg().Value(), false, depth); err != nil {
+						return err
+					}
+				}
+				b.writes(")")
+				return nil
 			}
 		}
 	}
@@ -322,14 +334,15 @@ func (g *gen) writeBuiltinIOWriter(b *buffer, recv *a.Expr, method t.ID, args []
 		b.writeb(')')
 		return nil
 
-	case t.IDLimitedCopyU32FromReader:
+	case t.IDLimitedCopyU32FromReader,
+		t.IDLimitedCopyU32FromReader16ByteChunksFast:
 		readerName, err := g.recvName(args[1].AsArg().Value())
 		if err != nil {
 			return err
 		}
 
-		b.printf("wuffs_base__io_writer__limited_copy_u32_from_reader(\n&%s%s, %s%s,",
-			iopPrefix, recvName, io2Prefix, recvName)
+		b.printf("wuffs_base__io_writer__%s(\n&%s%s, %s%s,",
+			method.Str(g.tm), iopPrefix, recvName, io2Prefix, recvName)
 		if err := g.writeExpr(b, args[0].AsArg().Value(), false, depth); err != nil {
 			return err
 		}
@@ -457,7 +470,8 @@ func (g *gen) writeBuiltinCPUArch(b *buffer, recv *a.Expr, method t.ID, args []*
 	case id.IsBuiltInCPUArchARMNeon():
 		return g.writeBuiltinCPUArchARMNeon(b, recv, method, args, sideEffectsOnly, depth)
 	case id == t.IDX86SSE42Utility, id == t.IDX86M128I,
-		id == t.IDX86AVX2Utility, id == t.IDX86M256I:
+		id == t.IDX86AVX2Utility, id == t.IDX86M256I,
+		id == t.IDX86AVX512Utility, id == t.IDX86M512I:
 		return g.writeBuiltinCPUArchX86(b, recv, method, args, sideEffectsOnly, depth)
 	}
 	return fmt.Errorf("internal error: unsupported cpu_arch method %s.%s",
@@ -656,6 +670,15 @@ func (g *gen) writeBuiltinCPUArchX86(b *buffer, recv *a.Expr, method t.ID, args
 			fName, tName, ptr = "_mm256_lddqu_si256", "const __m256i*)(const void*", true
 		case "make_m256i_zeroes":
 			fName, tName = "_mm256_setzero_si256", ""
+
+		case "make_m512i_multiple_u64":
+			fName, tName = "_mm512_set_epi64", "int64_t"
+		case "make_m512i_repeat_u64":
+			fName, tName = "_mm512_set1_epi64", "int64_t"
+		case "make_m512i_slice512":
+			fName, tName, ptr = "_mm512_loadu_si512", "const void*", true
+		case "make_m512i_zeroes":
+			fName, tName = "_mm512_setzero_si512", ""
 		default:
 			return fmt.Errorf("internal error: unsupported cpu_arch method %q", methodStr)
 		}
@@ -695,6 +718,8 @@ func (g *gen) writeBuiltinCPUArchX86(b *buffer, recv *a.Expr, method t.ID, args
 			b.writes("_mm_storeu_si64((void*)(")
 		case "store_slice128":
 			b.writes("_mm_storeu_si128((__m128i*)(void*)(")
+		case "store_slice512":
+			b.writes("_mm512_storeu_si512((void*)(")
 		}
 		if err := g.writeExprDotPtr(b, args[0].AsArg().Value(), false, depth); err != nil {
 			return err
@@ -731,6 +756,14 @@ func (g *gen) writeBuiltinCPUArchX86(b *buffer, recv *a.Expr, method t.ID, args
 		}
 		b.writes("))))")
 		return nil
+
+	} else if methodStr == "_mm_movemask_epi8" {
+		b.writes("((uint32_t)(_mm_movemask_epi8(")
+		if err := g.writeExpr(b, recv, false, depth); err != nil {
+			return err
+		}
+		b.writes(")))")
+		return nil
 	}
 
 	b.writes(methodStr)
@@ -901,6 +934,15 @@ func (g *gen) writeBuiltinSlice(b *buffer, recv *a.Expr, method t.ID, args []*a.
 		b.writes(".ptr)))")
 		return nil
 
+	case t.IDPrefix:
+		// TODO: don't assume that the slice is a slice of base.u8.
+		b.writes("wuffs_base__slice_u8__prefix(")
+		if err := g.writeExpr(b, recv, false, depth); err != nil {
+			return err
+		}
+		b.writes(", ")
+		return g.writeArgs(b, args, depth)
+
 	case t.IDSuffix:
 		// TODO: don't assume that the slice is a slice of base.u8.
 		b.writes("wuffs_base__slice_u8__suffix(")
@@ -917,10 +959,10 @@ func (g *gen) writeBuiltinSlice(b *buffer, recv *a.Expr, method t.ID, args []*a.
 			s = s[:i]
 		}
 		b.printf("wuffs_base__%s__no_bounds_check(", s)
-		if err := g.writeExpr(b, recv, false, depth); err != nil {
+		if err := g.writeExprDotPtr(b, recv, false, depth); err != nil {
 			return err
 		}
-		b.writes(".ptr)")
+		b.writes(")")
 		return nil
 	}
 
@@ -995,14 +995,8 @@ func (g *gen) gatherStatuses(b *buffer, n *a.Status) error {
 }
 
 func (g *gen) addStatus(qid t.QID, msg string, public bool) error {
-	category := "note__"
-	if msg[0] == '$' {
-		category = "suspension__"
-	} else if msg[0] == '#' {
-		category = "error__"
-	}
 	z := status{
-		cName:       g.packagePrefix(qid) + category + cName(msg, ""),
+		cName:       g.packagePrefix(qid) + statusCategory(msg) + cName(msg, ""),
 		msg:         msg,
 		fromThisPkg: qid[0] == 0,
 		public:      public,
@@ -1012,6 +1006,37 @@ func (g *gen) addStatus(qid t.QID, msg string, public bool) error {
 	return nil
 }
 
+// lookupStatus returns the status for qid. Public statuses of used packages
+// (other than base), such as deflate."@block boundary", are not in statusMap,
+// but the type checker has already verified that they exist, so their C names
+// can be derived from their messages.
+func (g *gen) lookupStatus(qid t.QID) status {
+	if z := g.statusMap[qid]; z.cName != "" {
+		return z
+	}
+	if (qid[0] == 0) || (qid[0] == t.IDBase) {
+		return status{}
+	}
+	msg, ok := t.Unescape(qid[1].Str(g.tm))
+	if !ok || (msg == "") {
+		return status{}
+	}
+	return status{
+		cName:  g.packagePrefix(qid) + statusCategory(msg) + cName(msg, ""),
+		msg:    msg,
+		public: true,
+	}
+}
+
+func statusCategory(msg string) string {
+	if msg[0] == '$' {
+		return "suspension__"
+	} else if msg[0] == '#' {
+		return "error__"
+	}
+	return "note__"
+}
+
 func (g *gen) gatherScalarConsts(b *buffer, n *a.Const) error {
 	if cv := n.Value().ConstValue(); cv != nil {
 		g.scalarConstsMap[n.QID()] = n
@@ -1078,6 +1103,9 @@ func (g *gen) writeStructPrivateImpl(b *buffer, n *a.Struct) error {
 				qid[0].Str(g.tm), qid[1].Str(g.tm))
 		}
 		b.writes("wuffs_base__vtable null_vtable;\n")
+		b.writes("#if defined(WUFFS_CONFIG__STATS)\n")
+		b.writes("wuffs_base__stats stats;\n")
+		b.writes("#endif  // defined(WUFFS_CONFIG__STATS)\n")
 		b.writes("\n")
 	}
 
@@ -1168,14 +1196,16 @@ func (g *gen) writeStructPrivateImpl(b *buffer, n *a.Struct) error {
 				}
 				b.writes("struct {\n")
 				oldInnerLenB1 := len(*b)
+				// The 8-byte scratch comes first, then the other fields in
+				// packedVarList order, to minimize padding.
+				if k.usesScratch {
+					b.writes("uint64_t scratch;\n")
+				}
 				if k.coroSuspPoint != 0 {
 					if err := g.writeVars(b, &k, true); err != nil {
 						return err
 					}
 				}
-				if k.usesScratch {
-					b.writes("uint64_t scratch;\n")
-				}
 				if oldInnerLenB1 != len(*b) {
 					b.printf("} %s%s[%d];\n", sPrefix, o.FuncName().Str(g.tm), maxDepth)
 				} else {
@@ -1271,6 +1301,9 @@ func (g *gen) writeCppMethods(b *buffer, n *a.Struct) error {
 	b.printf("return %s%s__initialize(\nthis, sizeof_star_self, wuffs_version, options);\n}\n\n",
 		g.pkgPrefix, structName)
 
+	b.writes("inline wuffs_base__stats\nstats() const {\n")
+	b.printf("return %s%s__stats(this);\n}\n\n", g.pkgPrefix, structName)
+
 	for _, impl := range n.Implements() {
 		iQID := impl.AsTypeExpr().QID()
 		iName := fmt.Sprintf("wuffs_%s__%s", iQID[0].Str(g.tm), iQID[1].Str(g.tm))
@@ -1374,6 +1407,13 @@ func (g *gen) writeSizeofSignature(b *buffer, n *a.Struct) error {
 	return nil
 }
 
+func (g *gen) writeStatsSignature(b *buffer, n *a.Struct) error {
+	structName := n.QID().Str(g.tm)
+	b.printf("wuffs_base__stats\n%s%s__stats(\n    const %s%s* self)",
+		g.pkgPrefix, structName, g.pkgPrefix, structName)
+	return nil
+}
+
 func (g *gen) writeInitializerPrototype(b *buffer, n *a.Struct) error {
 	if !n.Classy() {
 		return nil
@@ -1383,6 +1423,11 @@ func (g *gen) writeInitializerPrototype(b *buffer, n *a.Struct) error {
 	}
 	b.writes(";\n\n")
 
+	if err := g.writeStatsSignature(b, n); err != nil {
+		return err
+	}
+	b.writes(";\n\n")
+
 	if n.Public() {
 		if err := g.writeSizeofSignature(b, n); err != nil {
 			return err
@@ -1415,9 +1460,15 @@ func (g *gen) writeInitializerImpl(b *buffer, n *a.Struct) error {
 	b.writes("if ((options & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {\n")
 	b.writes("  // The whole point of this if-check is to detect an uninitialized *self.\n")
 	b.writes("  // We disable the warning on GCC. Clang-5.0 does not have this warning.\n")
+	b.writes("  //\n")
+	b.writes("  // The caller promises that *self is zeroed, so the empty asm tells GCC\n")
+	b.writes("  // that private_impl is defined. Otherwise, once this function and a\n")
+	b.writes("  // small method (e.g. one that reads a \"choose\" guard field) are both\n")
+	b.writes("  // inlined into the caller, GCC -O3 warns about that method's read.\n")
 	b.writes("  #if !defined(__clang__) && defined(__GNUC__)\n")
 	b.writes("  #pragma GCC diagnostic push\n")
 	b.writes("  #pragma GCC diagnostic ignored \"-Wmaybe-uninitialized\"\n")
+	b.writes("  __asm__ __volatile__(\"\" : \"+m\"(self->private_impl));\n")
 	b.writes("  #endif\n")
 	b.writes("  if (self->private_impl.magic != 0) {\n")
 	b.writes("    return wuffs_base__make_status(wuffs_base__error__initialize_falsely_claimed_already_zeroed);\n")
@@ -1518,5 +1569,51 @@ func (g *gen) writeInitializerImpl(b *buffer, n *a.Struct) error {
 		}
 		b.printf(" {\nreturn sizeof(%s%s);\n}\n\n", g.pkgPrefix, structName)
 	}
+
+	return g.writeStatsImpl(b, n)
+}
+
+func (g *gen) writeStatsImpl(b *buffer, n *a.Struct) error {
+	if err := g.writeStatsSignature(b, n); err != nil {
+		return err
+	}
+	b.writes(" {\n")
+	b.writes("wuffs_base__stats ret = wuffs_base__make_empty_stats();\n")
+	b.writes("#if defined(WUFFS_CONFIG__STATS)\n")
+	b.writes("if (!self) {\nreturn ret;\n}\n")
+	b.writes("ret = self->private_impl.stats;\n")
+
+	// Add the common counters of any sub-structs, skipping the same fields
+	// (base types and arrays) that writeInitializerImpl skips.
+	for _, f := range n.Fields() {
+		f := f.AsField()
+		x := f.XType()
+		if x != x.Innermost() {
+			continue
+		}
+
+		prefix := g.pkgPrefix
+		qid := x.QID()
+		if qid[0] == t.IDBase {
+			continue
+		} else if qid[0] != 0 {
+			otherPkg := g.tm.ByID(qid[0])
+			prefix = "wuffs_" + otherPkg + "__"
+		} else if (g.structMap[qid] == nil) || !g.structMap[qid].Classy() {
+			continue
+		}
+
+		b.writes("{\n")
+		b.printf("wuffs_base__stats z = %s%s__stats(&self->private_data.%s%s);\n",
+			prefix, qid[1].Str(g.tm), fPrefix, f.Name().Str(g.tm))
+		b.writes("wuffs_base__stats__accumulate(&ret, &z);\n")
+		b.writes("}\n")
+	}
+
+	b.writes("#else\n")
+	b.writes("(void)(self);\n")
+	b.writes("#endif  // defined(WUFFS_CONFIG__STATS)\n")
+	b.writes("return ret;\n")
+	b.writes("}\n\n")
 	return nil
 }
@@ -117,26 +117,100 @@ var embedAuxCborCc EmbeddedString
 //go:embed auxiliary/cbor.hh
 var embedAuxCborHh EmbeddedString
 
+//go:embed auxiliary/dom.cc
+var embedAuxDomCc EmbeddedString
+
+//go:embed auxiliary/dom.hh
+var embedAuxDomHh EmbeddedString
+
+//go:embed auxiliary/encode.cc
+var embedAuxEncodeCc EmbeddedString
+
+//go:embed auxiliary/encode.hh
+var embedAuxEncodeHh EmbeddedString
+
+//go:embed auxiliary/gif.cc
+var embedAuxGifCc EmbeddedString
+
+//go:embed auxiliary/gif.hh
+var embedAuxGifHh EmbeddedString
+
 //go:embed auxiliary/image.cc
 var embedAuxImageCc EmbeddedString
 
 //go:embed auxiliary/image.hh
 var embedAuxImageHh EmbeddedString
 
+//go:embed auxiliary/imagecache.cc
+var embedAuxImagecacheCc EmbeddedString
+
+//go:embed auxiliary/imagecache.hh
+var embedAuxImagecacheHh EmbeddedString
+
 //go:embed auxiliary/json.cc
 var embedAuxJsonCc EmbeddedString
 
 //go:embed auxiliary/json.hh
 var embedAuxJsonHh EmbeddedString
 
+//go:embed auxiliary/nie.cc
+var embedAuxNieCc EmbeddedString
+
+//go:embed auxiliary/nie.hh
+var embedAuxNieHh EmbeddedString
+
+//go:embed auxiliary/png.cc
+var embedAuxPngCc EmbeddedString
+
+//go:embed auxiliary/png.hh
+var embedAuxPngHh EmbeddedString
+
+//go:embed auxiliary/rac.cc
+var embedAuxRacCc EmbeddedString
+
+//go:embed auxiliary/rac.hh
+var embedAuxRacHh EmbeddedString
+
+//go:embed auxiliary/zlib.cc
+var embedAuxZlibCc EmbeddedString
+
+//go:embed auxiliary/zlib.hh
+var embedAuxZlibHh EmbeddedString
+
+//go:embed auxiliary/zip.cc
+var embedAuxZipCc EmbeddedString
+
+//go:embed auxiliary/zip.hh
+var embedAuxZipHh EmbeddedString
+
 var EmbeddedStrings_AuxNonBaseCcFiles = []EmbeddedString{
 	embedAuxCborCc,
+	embedAuxGifCc,
 	embedAuxImageCc,
+	embedAuxImagecacheCc,
 	embedAuxJsonCc,
+	embedAuxNieCc,
+	embedAuxPngCc,
+	embedAuxRacCc,
+	embedAuxZipCc,
+	embedAuxZlibCc,
+	// dom and encode come after cbor and json, as they build on them.
+	embedAuxDomCc,
+	embedAuxEncodeCc,
 }
 
 var EmbeddedStrings_AuxNonBaseHhFiles = []EmbeddedString{
 	embedAuxCborHh,
+	embedAuxGifHh,
 	embedAuxImageHh,
+	embedAuxImagecacheHh,
 	embedAuxJsonHh,
+	embedAuxNieHh,
+	embedAuxPngHh,
+	embedAuxRacHh,
+	embedAuxZipHh,
+	embedAuxZlibHh,
+	// dom and encode come after cbor and json, as they build on them.
+	embedAuxDomHh,
+	embedAuxEncodeHh,
 }
@@ -222,9 +222,18 @@ func (g *gen) writeExprOther(b *buffer, n *a.Expr, sideEffectsOnly bool, depth u
 		}
 		if rhs != nil {
 			b.writes(comma)
+			// The base pointer was already advanced by mcv, so the rhs index
+			// is relative to that.
+			if mcv != nil {
+				b.writeb('(')
+			}
 			if err := g.writeExpr(b, rhs, false, depth); err != nil {
 				return err
 			}
+			if mcv != nil {
+				b.writes(") - ")
+				b.writes(mcv.String())
+			}
 		}
 		if mhs != nil || rhs != nil {
 			b.writeb(')')
@@ -238,7 +247,7 @@ func (g *gen) writeExprOther(b *buffer, n *a.Expr, sideEffectsOnly bool, depth u
 			b.writes(n.Ident().Str(g.tm))
 			return nil
 		} else if (lhs.Operator() == 0) && n.Ident().IsDQStrLiteral(g.tm) {
-			if z := g.statusMap[t.QID{lhs.Ident(), n.Ident()}]; z.cName != "" {
+			if z := g.lookupStatus(t.QID{lhs.Ident(), n.Ident()}); z.cName != "" {
 				b.writes("wuffs_base__make_status(")
 				b.writes(z.cName)
 				b.writes(")")
@@ -373,7 +382,7 @@ func (g *gen) writeExprRepr(b *buffer, n *a.Expr, depth uint32) error {
 			if op == t.IDDot {
 				qid[0] = n.LHS().AsExpr().Ident()
 			}
-			if z := g.statusMap[qid]; z.cName != "" {
+			if z := g.lookupStatus(qid); z.cName != "" {
 				b.writes(z.cName)
 				return nil
 			}
@@ -593,6 +602,7 @@ var cTypeNames = [...]string{
 	t.IDARMNeonU64x2: "uint64x2_t",
 	t.IDX86M128I:     "__m128i",
 	t.IDX86M256I:     "__m256i",
+	t.IDX86M512I:     "__m512i",
 }
 
 const noSuchCOperator = " no_such_C_operator "
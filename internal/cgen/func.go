@@ -27,6 +27,7 @@ type funk struct {
 	bPrologue    buffer
 	bBodyResume  buffer
 	bBody        buffer
+	bBodyFresh   buffer
 	bBodySuspend buffer
 	bEpilogue    buffer
 
@@ -46,9 +47,19 @@ type funk struct {
 	usesEmptyIOBuffer bool
 	usesScratch       bool
 	hasGotoOK         bool
+	fresh             bool
 }
 
 func (k *funk) jumpTarget(tm *t.Map, n a.Loop) (string, error) {
+	jt, err := k.jumpTarget1(tm, n)
+	if k.fresh {
+		// The fresh copy of the function body needs its own C labels.
+		jt = "fresh_" + jt
+	}
+	return jt, err
+}
+
+func (k *funk) jumpTarget1(tm *t.Map, n a.Loop) (string, error) {
 	if label := n.Label(); label != 0 {
 		return label.Str(tm), nil
 	}
@@ -314,6 +325,9 @@ func (g *gen) gatherFuncImpl(_ *buffer, n *a.Func) error {
 	if err := g.writeFuncImplBody(&g.currFunk.bBody); err != nil {
 		return err
 	}
+	if err := g.writeFuncImplBodyFresh(&g.currFunk.bBodyFresh); err != nil {
+		return err
+	}
 
 	if err := g.writeFuncImplPrologue(&g.currFunk.bPrologue); err != nil {
 		return err
@@ -342,6 +356,9 @@ func writeOutParamZeroValue(b *buffer, tm *t.Map, typ *a.TypeExpr) error {
 	} else if typ.IsNumType() {
 		b.writes("0")
 		return nil
+	} else if typ.IsBool() {
+		b.writes("false")
+		return nil
 	} else if typ.IsSliceType() {
 		if inner := typ.Inner(); (inner.Decorator() == 0) && (inner.QID() == t.QID{t.IDBase, t.IDU8}) {
 			b.writes("wuffs_base__make_slice_u8(NULL, 0)")
@@ -482,6 +499,14 @@ func (g *gen) writeFuncImplBodyResume(b *buffer) error {
 			b.writes("}\n")
 		}
 
+		// Starting at the top, instead of resuming, runs the fresh copy of
+		// the function body. See writeFuncImplBodyFresh.
+		if len(g.currFunk.bBodyFresh) > 0 {
+			b.writes("if (!coro_susp_point) {\n")
+			b.writex(g.currFunk.bBodyFresh)
+			b.writes("goto ok;\n}\n\n")
+		}
+
 		// Generate a coroutine switch similiar to the technique in
 		// https://www.chiark.greenend.org.uk/~sgtatham/coroutines.html
 		//
@@ -500,6 +525,33 @@ func (g *gen) writeFuncImplBody(b *buffer) error {
 	return nil
 }
 
+// writeFuncImplBodyFresh writes a second copy of a coroutine's body, used
+// when the coroutine starts at the top instead of resuming. It has the same
+// suspension points (with the same numbers) but none of the switch's case
+// labels, so that its loops have a single entry and the C compiler can keep
+// local variables in registers, instead of having to assume that any
+// suspension point could jump into the middle of a loop. Suspending from the
+// fresh copy saves the same state as the original, and resuming always goes
+// through the original's switch.
+func (g *gen) writeFuncImplBodyFresh(b *buffer) error {
+	if !g.currFunk.astFunc.Fresh() || (g.currFunk.coroSuspPoint == 0) {
+		return nil
+	}
+	k := &g.currFunk
+	coroSuspPoint, ioManips, tempW, tempR := k.coroSuspPoint, k.ioManips, k.tempW, k.tempR
+	k.coroSuspPoint, k.ioManips, k.tempW, k.tempR = 0, 0, 0, 0
+	k.fresh = true
+	if err := g.writeFuncImplBody(b); err != nil {
+		return err
+	}
+	k.fresh = false
+	if (k.coroSuspPoint != coroSuspPoint) || (k.ioManips != ioManips) ||
+		(k.tempW != tempW) || (k.tempR != tempR) {
+		return fmt.Errorf("internal error: fresh function body out of sync")
+	}
+	return nil
+}
+
 func (g *gen) writeFuncImplBodySuspend(b *buffer) error {
 	if (g.currFunk.coroSuspPoint > 0) || g.currFunk.astFunc.Effect().Coroutine() {
 		if !g.currFunk.hasGotoOK {
@@ -524,6 +576,8 @@ func (g *gen) writeFuncImplBodySuspend(b *buffer) error {
 		if g.currFunk.astFunc.Public() {
 			b.printf("self->private_impl.active_coroutine = "+
 				"wuffs_base__status__is_suspension(&status) ? %d : 0;\n", g.currFunk.coroID)
+			b.writes("WUFFS_BASE__STATS__ADD(self->private_impl, WUFFS_BASE__STATS__SUSPENSIONS,\n" +
+				"wuffs_base__status__is_suspension(&status) ? 1u : 0u);\n")
 		}
 		if err := g.writeResumeSuspend(b, &g.currFunk, true); err != nil {
 			return err
@@ -85,8 +85,7 @@ func (g *gen) writeStatementAssign(b *buffer, op t.ID, lhs *a.Expr, rhs *a.Expr,
 	depth++
 
 	needWriteLoadExprDerivedVars := false
-	if (len(g.currFunk.derivedVars) > 0) &&
-		(rhs.Operator() == a.ExprOperatorCall) {
+	if rhs.Operator() == a.ExprOperatorCall {
 		method := rhs.LHS().AsExpr()
 		recvTyp := method.LHS().MType().Pointee()
 		if (recvTyp.Decorator() == 0) && (recvTyp.QID()[0] != t.IDBase) {
@@ -283,6 +282,10 @@ func cpuArchCNames(asserts []*a.Node) (caMacro string, caName string, caAttribut
 				caMacro, caName, caAttribute =
 					"X86_FAMILY", "x86_avx2",
 					"WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET(\"pclmul,popcnt,sse4.2,avx2\")"
+			case t.IDX86AVX512:
+				caMacro, caName, caAttribute =
+					"X86_FAMILY", "x86_avx512",
+					"WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET(\"pclmul,popcnt,sse4.2,avx2,avx512f,avx512bw,avx512vl,vpclmulqdq\")"
 			case t.IDX86BMI2:
 				caMacro, caName, caAttribute =
 					"X86_FAMILY", "x86_bmi2",
@@ -656,6 +659,7 @@ func (g *gen) writeIterateRound(b *buffer, assigns []*a.Node, body []*a.Node, ro
 			vPrefix, name0, iPrefix, name0,
 			length+(advance*(unroll-1)), advance*unroll)
 	}
+	b.writes("WUFFS_BASE__ITERATE_LOOP_HINT\n")
 	b.printf("while (%s%s.ptr < %send%d_%s) {\n", vPrefix, name0, iPrefix, round, name0)
 	for i := 0; i < unroll; i++ {
 		for _, o := range body {
@@ -684,6 +688,9 @@ func (g *gen) writeCoroSuspPoint(b *buffer, maybeSuspend bool) error {
 		macro = "_MAYBE_SUSPEND"
 		g.currFunk.hasGotoOK = true
 	}
+	if g.currFunk.fresh {
+		macro += "_FRESH"
+	}
 	b.printf("WUFFS_BASE__COROUTINE_SUSPENSION_POINT%s(%d);\n", macro, g.currFunk.coroSuspPoint)
 	return nil
 }
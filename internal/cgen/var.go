@@ -17,6 +17,7 @@ package cgen
 import (
 	"errors"
 	"fmt"
+	"sort"
 
 	a "github.com/google/wuffs/lang/ast"
 	t "github.com/google/wuffs/lang/token"
@@ -62,6 +63,11 @@ func (g *gen) needDerivedVar(name t.ID) bool {
 					if recv.MType().Eq(typeExprPixelSwizzler) && argsContainsArgsDotFoo(args, name) {
 						return errNeedDerivedVar
 					}
+				case t.IDLimitedCopyU32FromReader,
+					t.IDLimitedCopyU32FromReader16ByteChunksFast:
+					if argsContainsArgsDotFoo(args, name) {
+						return errNeedDerivedVar
+					}
 				}
 
 			case a.KIOManip:
@@ -248,7 +254,7 @@ func (g *gen) couldHaveDerivedVar(n *a.Expr) bool {
 }
 
 func (g *gen) writeLoadExprDerivedVars(b *buffer, n *a.Expr) error {
-	if (g.currFunk.derivedVars != nil) && (n.Operator() == a.ExprOperatorCall) {
+	if n.Operator() == a.ExprOperatorCall {
 		for _, o := range n.Args() {
 			if v := o.AsArg().Value(); g.couldHaveDerivedVar(v) {
 				if err := g.writeLoadDerivedVar(b, v); err != nil {
@@ -261,7 +267,7 @@ func (g *gen) writeLoadExprDerivedVars(b *buffer, n *a.Expr) error {
 }
 
 func (g *gen) writeSaveExprDerivedVars(b *buffer, n *a.Expr) error {
-	if (g.currFunk.derivedVars != nil) && (n.Operator() == a.ExprOperatorCall) {
+	if n.Operator() == a.ExprOperatorCall {
 		for _, o := range n.Args() {
 			if v := o.AsArg().Value(); g.couldHaveDerivedVar(v) {
 				if err := g.writeSaveDerivedVar(b, v); err != nil {
@@ -313,7 +319,7 @@ func (g *gen) writeResumeSuspend1(b *buffer, f *funk, n *a.Var, suspend bool) er
 }
 
 func (g *gen) writeResumeSuspend(b *buffer, f *funk, suspend bool) error {
-	for _, n := range f.varList {
+	for _, n := range packedVarList(f) {
 		if err := g.writeResumeSuspend1(b, f, n, suspend); err != nil {
 			return err
 		}
@@ -321,8 +327,46 @@ func (g *gen) writeResumeSuspend(b *buffer, f *funk, suspend bool) error {
 	return nil
 }
 
+// packedVarList returns f's local variables, largest C alignment first but
+// otherwise in declaration order, so that the struct of resumable variables
+// (the coroutine stack) has little or no padding.
+func packedVarList(f *funk) []*a.Var {
+	vars := append([]*a.Var(nil), f.varList...)
+	sort.SliceStable(vars, func(i int, j int) bool {
+		return cAlignment(vars[i].XType()) > cAlignment(vars[j].XType())
+	})
+	return vars
+}
+
+// cAlignment approximates the alignment of typ's C type. Anything other than
+// a bool or base integer (or an array of those) is assumed to need 8 bytes.
+func cAlignment(typ *a.TypeExpr) uint32 {
+	for typ.Decorator() == t.IDArray {
+		typ = typ.Inner()
+	}
+	if typ.Decorator() != 0 {
+		return 8
+	} else if typ.IsBool() {
+		return 1
+	} else if qid := typ.QID(); qid[0] == t.IDBase {
+		switch qid[1] {
+		case t.IDI8, t.IDU8:
+			return 1
+		case t.IDI16, t.IDU16:
+			return 2
+		case t.IDI32, t.IDU32:
+			return 4
+		}
+	}
+	return 8
+}
+
 func (g *gen) writeVars(b *buffer, f *funk, inStructDecl bool) error {
-	for _, n := range f.varList {
+	varList := f.varList
+	if inStructDecl {
+		varList = packedVarList(f)
+	}
+	for _, n := range varList {
 		typ := n.XType()
 		if typ.Innermost().IsEtcUtilityType() {
 			continue
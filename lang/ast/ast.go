@@ -107,6 +107,7 @@ const (
 	FlagsPrivateData      = Flags(0x00008000)
 	FlagsChoosy           = Flags(0x00010000)
 	FlagsHasChooseCPUArch = Flags(0x00020000)
+	FlagsFresh            = Flags(0x00040000)
 )
 
 func (f Flags) AsEffect() Effect { return Effect(f) }
@@ -496,7 +497,7 @@ func (n *Assert) IsChooseCPUArch() bool {
 		return false
 	}
 	switch rhs.Ident() {
-	case t.IDARMCRC32, t.IDARMNeon, t.IDX86SSE42, t.IDX86AVX2, t.IDX86BMI2:
+	case t.IDARMCRC32, t.IDARMNeon, t.IDX86SSE42, t.IDX86AVX2, t.IDX86BMI2, t.IDX86AVX512:
 		return true
 	}
 	return false
@@ -971,6 +972,7 @@ type Func Node
 func (n *Func) AsNode() *Node          { return (*Node)(n) }
 func (n *Func) Choosy() bool           { return n.flags&FlagsChoosy != 0 }
 func (n *Func) Effect() Effect         { return Effect(n.flags) }
+func (n *Func) Fresh() bool            { return n.flags&FlagsFresh != 0 }
 func (n *Func) HasChooseCPUArch() bool { return n.flags&FlagsHasChooseCPUArch != 0 }
 func (n *Func) Public() bool           { return n.flags&FlagsPublic != 0 }
 func (n *Func) Filename() string       { return n.filename }
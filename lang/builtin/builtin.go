@@ -112,6 +112,11 @@ var Consts = [...]struct {
 
 	// ----
 
+	{t.IDU8, "0", "PIXEL_BLEND__SRC"},
+	{t.IDU8, "1", "PIXEL_BLEND__SRC_OVER"},
+
+	// ----
+
 	{t.IDU32, "0x02000008", "PIXEL_FORMAT__A"},
 
 	{t.IDU32, "0x20000008", "PIXEL_FORMAT__Y"},
@@ -336,6 +341,9 @@ var Types = []string{
 
 	"x86_avx2_utility",
 	"x86_m256i",
+
+	"x86_avx512_utility",
+	"x86_m512i",
 }
 
 var Funcs = [][]string{
@@ -367,6 +375,10 @@ var funcsOther = [...]string{
 	// ---- utility
 
 	"utility.cpu_arch_is_32_bit() bool",
+	"utility.downscale_accumulate!(accumulator: slice u8, src: slice u8," +
+		"x: u32, num_rows: u32, bytes_per_pixel: u32, shift: u32)",
+	"utility.downscale_flush!(dst: slice u8, accumulator: slice u8," +
+		"x0: u32, x1: u32, num_rows: u32, bytes_per_pixel: u32, shift: u32)",
 	"utility.empty_io_reader() io_reader",
 	"utility.empty_io_writer() io_writer",
 	"utility.empty_range_ii_u32() range_ii_u32",
@@ -376,6 +388,7 @@ var funcsOther = [...]string{
 	"utility.empty_rect_ii_u32() rect_ii_u32",
 	"utility.empty_rect_ie_u32() rect_ie_u32",
 	"utility.empty_slice_u8() slice u8",
+	"utility.make_pixel_blend(repr: u8) pixel_blend",
 	"utility.make_pixel_format(repr: u32) pixel_format",
 	"utility.make_range_ii_u32(min_incl: u32, max_incl: u32) range_ii_u32",
 	"utility.make_range_ie_u32(min_incl: u32, max_excl: u32) range_ie_u32",
@@ -385,6 +398,7 @@ var funcsOther = [...]string{
 		"min_incl_x: u32, min_incl_y: u32, max_incl_x: u32, max_incl_y: u32) rect_ii_u32",
 	"utility.make_rect_ie_u32(" +
 		"min_incl_x: u32, min_incl_y: u32, max_excl_x: u32, max_excl_y: u32) rect_ie_u32",
+	"utility.stats_add!(counter: u32[..= 15], n: u64)",
 
 	// ---- ranges
 
@@ -587,6 +601,12 @@ var funcsOther = [...]string{
 	// For now, that's all implicitly checked (i.e. hard coded).
 	"io_writer.limited_copy_u32_from_history_8_byte_chunks_distance_1_fast!(up_to: u32, distance: u32) u32",
 
+	// TODO: this should have explicit pre-conditions:
+	//  - (up_to + 16) <= this.length()
+	//  - (up_to + 16) <= r.length()
+	// For now, that's all implicitly checked (i.e. hard coded).
+	"io_writer.limited_copy_u32_from_reader_16_byte_chunks_fast!(up_to: u32, r: io_reader) u32",
+
 	// ---- token_writer
 
 	"token_writer.write_simple_token_fast!(" +
@@ -598,6 +618,16 @@ var funcsOther = [...]string{
 
 	"token_writer.length() u64",
 
+	// ---- decode_frame_options
+
+	"decode_frame_options.roi_min_incl_x() u32",
+	"decode_frame_options.roi_min_incl_y() u32",
+	"decode_frame_options.roi_max_excl_x() u32",
+	"decode_frame_options.roi_max_excl_y() u32",
+	"decode_frame_options.downscale_shift() u32[..= 3]",
+	"decode_frame_options.row_band_height() u32",
+	"decode_frame_options.has_color_conversion() bool",
+
 	// ---- frame_config
 
 	"frame_config.blend() u8",
@@ -615,6 +645,10 @@ var funcsOther = [...]string{
 	"image_config.set!(pixfmt: u32, pixsub: u32, width: u32, height: u32," +
 		"first_frame_io_position: u64, first_frame_is_opaque: bool)",
 
+	// ---- pixel_blend
+
+	"pixel_blend.repr() u8",
+
 	// ---- pixel_buffer
 
 	"pixel_buffer.palette() slice u8",
@@ -625,12 +659,16 @@ var funcsOther = [...]string{
 	// ---- pixel_format
 
 	"pixel_format.bits_per_pixel() u32[..= 256]",
+	"pixel_format.is_indexed() bool",
+	"pixel_format.repr() u32",
+	"pixel_format.transparency() u32[..= 3]",
 
 	// ---- pixel_swizzler
 
 	"pixel_swizzler.prepare!(" +
 		"dst_pixfmt: pixel_format, dst_palette: slice u8," +
 		"src_pixfmt: pixel_format, src_palette: slice u8, blend: pixel_blend) status",
+	"pixel_swizzler.set_color_conversion_from_options!(opts: nptr decode_frame_options) status",
 
 	"pixel_swizzler.limited_swizzle_u32_interleaved_from_reader!(" +
 		"up_to_num_pixels: u32, dst: slice u8, dst_palette: slice u8, src: io_reader) u64",
@@ -638,6 +676,12 @@ var funcsOther = [...]string{
 		"dst: slice u8, dst_palette: slice u8, src: io_reader) u64",
 	"pixel_swizzler.swizzle_interleaved_from_slice!(" +
 		"dst: slice u8, dst_palette: slice u8, src: slice u8) u64",
+	"pixel_swizzler.swizzle_interleaved_from_packed_slice!(" +
+		"dst: slice u8, dst_palette: slice u8, src: slice u8," +
+		"src_bits_per_pixel: u32, src_skip: u32, num_pixels: u64, scale_to_u8: bool) u64",
+	"pixel_swizzler.swizzle_interleaved_from_u16be_slice!(" +
+		"dst: slice u8, dst_palette: slice u8, src: slice u8," +
+		"src_num_channels: u32, num_pixels: u64) u64",
 	"pixel_swizzler.swizzle_interleaved_transparent_black!(" +
 		"dst: slice u8, dst_palette: slice u8, num_pixels: u64) u64",
 
@@ -701,9 +745,9 @@ var funcsOther = [...]string{
 	"arm_neon_u32x2.as_u8x8() arm_neon_u8x8",
 	"arm_neon_u64x1.as_u8x8() arm_neon_u8x8",
 
-	"arm_neon_u16x8.as_u16x8() arm_neon_u16x8",
-	"arm_neon_u16x8.as_u32x4() arm_neon_u32x4",
-	"arm_neon_u16x8.as_u64x2() arm_neon_u64x2",
+	"arm_neon_u8x16.as_u16x8() arm_neon_u16x8",
+	"arm_neon_u8x16.as_u32x4() arm_neon_u32x4",
+	"arm_neon_u8x16.as_u64x2() arm_neon_u64x2",
 
 	"arm_neon_u16x8.as_u8x16() arm_neon_u8x16",
 	"arm_neon_u32x4.as_u8x16() arm_neon_u8x16",
@@ -761,6 +805,7 @@ var funcsOther = [...]string{
 	"x86_m128i._mm_cmpeq_epi32(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_cmpeq_epi64(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_cmpeq_epi8(b: x86_m128i) x86_m128i",
+	"x86_m128i._mm_cmplt_epi8(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_extract_epi16(imm8: u32) u16",
 	"x86_m128i._mm_extract_epi32(imm8: u32) u32",
 	"x86_m128i._mm_extract_epi64(imm8: u32) u64",
@@ -779,6 +824,9 @@ var funcsOther = [...]string{
 	"x86_m128i._mm_min_epu16(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_min_epu32(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_min_epu8(b: x86_m128i) x86_m128i",
+	"x86_m128i._mm_movemask_epi8() u32[..= 0xFFFF]",
+	"x86_m128i._mm_mul_epu32(b: x86_m128i) x86_m128i",
+	"x86_m128i._mm_or_si128(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_packus_epi16(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_sad_epu8(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_shuffle_epi32(imm8: u32) x86_m128i",
@@ -847,7 +895,9 @@ var funcsOther = [...]string{
 	"x86_m256i._mm256_extracti128_si256(imm8: u32) x86_m128i",
 	"x86_m256i._mm256_madd_epi16(b: x86_m256i) x86_m256i",
 	"x86_m256i._mm256_maddubs_epi16(b: x86_m256i) x86_m256i",
+	"x86_m256i._mm256_mul_epu32(b: x86_m256i) x86_m256i",
 	"x86_m256i._mm256_sad_epu8(b: x86_m256i) x86_m256i",
+	"x86_m256i._mm256_shuffle_epi32(imm8: u32) x86_m256i",
 	"x86_m256i._mm256_slli_epi16(imm8: u32) x86_m256i",
 	"x86_m256i._mm256_slli_epi32(imm8: u32) x86_m256i",
 	"x86_m256i._mm256_slli_epi64(imm8: u32) x86_m256i",
@@ -856,10 +906,35 @@ var funcsOther = [...]string{
 	"x86_m256i._mm256_srli_epi32(imm8: u32) x86_m256i",
 	"x86_m256i._mm256_srli_epi64(imm8: u32) x86_m256i",
 	"x86_m256i._mm256_srli_si256(imm8: u32) x86_m256i",
+	"x86_m256i._mm256_xor_si256(b: x86_m256i) x86_m256i",
+
+	// ---- x86_avx512_utility
+
+	"x86_avx512_utility.make_m512i_multiple_u64(" +
+		"a00: u64, a01: u64, a02: u64, a03: u64," +
+		"a04: u64, a05: u64, a06: u64, a07: u64) x86_m512i",
+
+	"x86_avx512_utility.make_m512i_repeat_u64(a: u64) x86_m512i",
+
+	"x86_avx512_utility.make_m512i_slice512(a: slice base.u8) x86_m512i",
+
+	"x86_avx512_utility.make_m512i_zeroes() x86_m512i",
+
+	// ---- x86_m512i
+
+	// TODO: generate these methods automatically?
+
+	"x86_m512i._mm512_clmulepi64_epi128(b: x86_m512i, imm8: u32) x86_m512i",
+	"x86_m512i._mm512_extracti32x4_epi32(imm8: u32) x86_m128i",
+	"x86_m512i._mm512_ternarylogic_epi64(b: x86_m512i, c: x86_m512i, imm8: u32) x86_m512i",
+	"x86_m512i._mm512_xor_si512(b: x86_m512i) x86_m512i",
+
+	"x86_m512i.store_slice512!(a: slice base.u8)",
 }
 
 var Interfaces = []string{
 	"hasher_u32",
+	"hasher_u64",
 	"image_decoder",
 	"io_transformer",
 	"token_decoder",
@@ -867,6 +942,7 @@ var Interfaces = []string{
 
 var InterfacesMap = map[string]bool{
 	"hasher_u32":     true,
+	"hasher_u64":     true,
 	"image_decoder":  true,
 	"io_transformer": true,
 	"token_decoder":  true,
@@ -878,8 +954,14 @@ var InterfaceFuncs = []string{
 	"hasher_u32.set_quirk_enabled!(quirk: u32, enabled: bool)",
 	"hasher_u32.update_u32!(x: slice u8) u32",
 
+	// ---- hasher_u64
+
+	"hasher_u64.set_quirk_enabled!(quirk: u32, enabled: bool)",
+	"hasher_u64.update_u64!(x: slice u8) u64",
+
 	// ---- image_decoder
 
+	"image_decoder.can_decode_row_bands() bool",
 	"image_decoder.decode_frame?(" +
 		"dst: ptr pixel_buffer, src: io_reader, blend: pixel_blend," +
 		"workbuf: slice u8, opts: nptr decode_frame_options)",
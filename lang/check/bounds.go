@@ -522,22 +522,9 @@ func (q *checker) bcheckAssignment(lhs *a.Expr, op t.ID, rhs *a.Expr) error {
 			}
 		}
 
-		// Look for "lhs = x[i .. j]" where i and j are constants.
+		// Look for "lhs = x[i .. j]" where (j - i) is a constant.
 		if _, i, j, ok := rhs.IsSlice(); ok {
-			icv := (*big.Int)(nil)
-			if i == nil {
-				icv = zero
-			} else if i.ConstValue() != nil {
-				icv = i.ConstValue()
-			}
-
-			jcv := (*big.Int)(nil)
-			if (j != nil) && (j.ConstValue() != nil) {
-				jcv = j.ConstValue()
-			}
-
-			if (icv != nil) && (jcv != nil) {
-				n := big.NewInt(0).Sub(jcv, icv)
+			if n := constSliceLength(i, j); n != nil {
 				id, err := q.tm.Insert(n.String())
 				if err != nil {
 					return err
@@ -1180,6 +1167,11 @@ func (q *checker) bcheckExprCallSpecialCases(n *a.Expr, depth uint32) (bounds, e
 				return bounds{}, err
 			}
 
+		} else if method == t.IDLimitedCopyU32FromReader16ByteChunksFast {
+			if err := q.canLimitedCopyU32FromReaderFast(recv, n.Args(), sixteen); err != nil {
+				return bounds{}, err
+			}
+
 		} else if method == t.IDSkipU32Fast {
 			args := n.Args()
 			if len(args) != 2 {
@@ -1298,51 +1290,8 @@ func (q *checker) canLimitedCopyU32FromHistoryFast(recv *a.Expr, args []*a.Node,
 	distance := args[1].AsArg().Value()
 
 	// Check "upTo <= this.length()".
-check0:
-	for {
-		for _, x := range q.facts {
-			if x.Operator() != t.IDXBinaryLessEq {
-				continue
-			}
-
-			// Check that the LHS is "(upTo + adj) as base.u64".
-			lhs := x.LHS().AsExpr()
-			if lhs.Operator() != t.IDXBinaryAs {
-				continue
-			}
-			llhs, lrhs := lhs.LHS().AsExpr(), lhs.RHS().AsTypeExpr()
-			if !lrhs.Eq(typeExprU64) {
-				continue
-			}
-			if adj == nil {
-				if !llhs.Eq(upTo) {
-					continue
-				}
-			} else {
-				if (llhs.Operator() != t.IDXBinaryPlus) || !llhs.LHS().AsExpr().Eq(upTo) {
-					continue
-				} else if cv := llhs.RHS().AsExpr().ConstValue(); (cv == nil) || (cv.Cmp(adj) != 0) {
-					continue
-				}
-			}
-
-			// Check that the RHS is "recv.length()".
-			y, method, yArgs := splitReceiverMethodArgs(x.RHS().AsExpr())
-			if method != t.IDLength || len(yArgs) != 0 {
-				continue
-			}
-			if !y.Eq(recv) {
-				continue
-			}
-
-			break check0
-		}
-		if adj == nil {
-			return fmt.Errorf("check: could not prove (%s as base.u64) <= %s.length()",
-				upTo.Str(q.tm), recv.Str(q.tm))
-		}
-		return fmt.Errorf("check: could not prove ((%s + %v) as base.u64) <= %s.length()",
-			upTo.Str(q.tm), adj, recv.Str(q.tm))
+	if err := q.canUpToPlusAdjBeLessEqLength(recv, upTo, adj); err != nil {
+		return err
 	}
 
 	// Check "distance >= minDistance".
@@ -1417,6 +1366,72 @@ check2:
 	return nil
 }
 
+func (q *checker) canLimitedCopyU32FromReaderFast(recv *a.Expr, args []*a.Node, adj *big.Int) error {
+	// As per cgen's io-private.h, there are two pre-conditions:
+	//  - (upTo + adj) <= this.length()
+	//  - (upTo + adj) <= r.length()
+
+	if len(args) != 2 {
+		return fmt.Errorf("check: internal error: inconsistent limited_copy_u32_from_reader_fast arguments")
+	}
+	upTo := args[0].AsArg().Value()
+	r := args[1].AsArg().Value()
+
+	if err := q.canUpToPlusAdjBeLessEqLength(recv, upTo, adj); err != nil {
+		return err
+	}
+	return q.canUpToPlusAdjBeLessEqLength(r, upTo, adj)
+}
+
+// canUpToPlusAdjBeLessEqLength checks that "((upTo + adj) as base.u64) <=
+// recv.length()" is a known fact. adj may be nil, in which case (upTo + adj)
+// is just upTo.
+func (q *checker) canUpToPlusAdjBeLessEqLength(recv *a.Expr, upTo *a.Expr, adj *big.Int) error {
+	for _, x := range q.facts {
+		if x.Operator() != t.IDXBinaryLessEq {
+			continue
+		}
+
+		// Check that the LHS is "(upTo + adj) as base.u64".
+		lhs := x.LHS().AsExpr()
+		if lhs.Operator() != t.IDXBinaryAs {
+			continue
+		}
+		llhs, lrhs := lhs.LHS().AsExpr(), lhs.RHS().AsTypeExpr()
+		if !lrhs.Eq(typeExprU64) {
+			continue
+		}
+		if adj == nil {
+			if !llhs.Eq(upTo) {
+				continue
+			}
+		} else {
+			if (llhs.Operator() != t.IDXBinaryPlus) || !llhs.LHS().AsExpr().Eq(upTo) {
+				continue
+			} else if cv := llhs.RHS().AsExpr().ConstValue(); (cv == nil) || (cv.Cmp(adj) != 0) {
+				continue
+			}
+		}
+
+		// Check that the RHS is "recv.length()".
+		y, method, yArgs := splitReceiverMethodArgs(x.RHS().AsExpr())
+		if method != t.IDLength || len(yArgs) != 0 {
+			continue
+		}
+		if !y.Eq(recv) {
+			continue
+		}
+
+		return nil
+	}
+	if adj == nil {
+		return fmt.Errorf("check: could not prove (%s as base.u64) <= %s.length()",
+			upTo.Str(q.tm), recv.Str(q.tm))
+	}
+	return fmt.Errorf("check: could not prove ((%s + %v) as base.u64) <= %s.length()",
+		upTo.Str(q.tm), adj, recv.Str(q.tm))
+}
+
 var ioMethodAdvances = [...]struct {
 	advance *big.Int
 	update  bool
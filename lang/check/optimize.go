@@ -30,6 +30,32 @@ import (
 	t "github.com/google/wuffs/lang/token"
 )
 
+// constSliceLength returns the length of the "a[i .. j]" slice if it is a
+// constant: either both i and j are constants (a nil i means zero) or j is "i +
+// c" for some constant c. It returns nil otherwise.
+//
+// The "i + c" form lets "a[i .. i + 8]" (for a variable i) satisfy a "length()
+// >= 8" pre-condition. Bounds checking "a[i .. i + 8]" itself separately
+// proves that (i <= (i + 8)) and that (i + 8) does not overflow.
+func constSliceLength(i *a.Expr, j *a.Expr) *big.Int {
+	if j == nil {
+		return nil
+	}
+	icv := zero
+	if i != nil {
+		icv = i.ConstValue()
+	}
+	if jcv := j.ConstValue(); (icv != nil) && (jcv != nil) {
+		return big.NewInt(0).Sub(jcv, icv)
+	}
+	if (i != nil) && (j.Operator() == t.IDXBinaryPlus) && j.LHS().AsExpr().Eq(i) {
+		if cv := j.RHS().AsExpr().ConstValue(); (cv != nil) && (cv.Sign() >= 0) {
+			return cv
+		}
+	}
+	return nil
+}
+
 // splitReceiverMethodArgs returns the "receiver", "method" and "args" in the
 // expression "receiver.method(args)".
 func splitReceiverMethodArgs(n *a.Expr) (receiver *a.Expr, method t.ID, args []*a.Node) {
@@ -53,26 +79,11 @@ func (q *checker) optimizeIOMethodAdvance(receiver *a.Expr, advance *big.Int, ad
 		return q.optimizeIOMethodAdvanceExpr(receiver, advanceExpr, update)
 	}
 
-	// Check if receiver looks like "a[i .. j]" where i and j are constants and
+	// Check if receiver looks like "a[i .. j]" where (j - i) is a constant and
 	// ((j - i) >= advance).
 	if _, i, j, ok := receiver.IsSlice(); ok {
-		icv := (*big.Int)(nil)
-		if i == nil {
-			icv = zero
-		} else if i.ConstValue() != nil {
-			icv = i.ConstValue()
-		}
-
-		jcv := (*big.Int)(nil)
-		if (j != nil) && (j.ConstValue() != nil) {
-			jcv = j.ConstValue()
-		}
-
-		if (icv != nil) && (jcv != nil) {
-			n := big.NewInt(0).Sub(jcv, icv)
-			if n.Cmp(advance) >= 0 {
-				retOK = true
-			}
+		if n := constSliceLength(i, j); (n != nil) && (n.Cmp(advance) >= 0) {
+			retOK = true
 		}
 	}
 
@@ -25,10 +25,11 @@ import (
 type cpuArchBits uint32
 
 const (
-	cpuArchBitsARMCRC32 = cpuArchBits(0x00000001)
-	cpuArchBitsARMNeon  = cpuArchBits(0x00000002)
-	cpuArchBitsX86SSE42 = cpuArchBits(0x00000004)
-	cpuArchBitsX86AVX2  = cpuArchBits(0x00000008)
+	cpuArchBitsARMCRC32  = cpuArchBits(0x00000001)
+	cpuArchBitsARMNeon   = cpuArchBits(0x00000002)
+	cpuArchBitsX86SSE42  = cpuArchBits(0x00000004)
+	cpuArchBitsX86AVX2   = cpuArchBits(0x00000008)
+	cpuArchBitsX86AVX512 = cpuArchBits(0x00000010)
 )
 
 func calcCPUArchBits(n *a.Func) (ret cpuArchBits) {
@@ -46,6 +47,8 @@ func calcCPUArchBits(n *a.Func) (ret cpuArchBits) {
 			ret |= cpuArchBitsX86SSE42
 		case t.IDX86AVX2:
 			ret |= cpuArchBitsX86SSE42 | cpuArchBitsX86AVX2
+		case t.IDX86AVX512:
+			ret |= cpuArchBitsX86SSE42 | cpuArchBitsX86AVX2 | cpuArchBitsX86AVX512
 		}
 	}
 	return ret
@@ -63,6 +66,8 @@ func (q *checker) tcheckCPUArchBits(cab cpuArchBits, typ *a.TypeExpr) error {
 			need = cpuArchBitsARMNeon
 		case t.IDX86SSE42Utility, t.IDX86M128I:
 			need = cpuArchBitsX86SSE42
+		case t.IDX86AVX512Utility, t.IDX86M512I:
+			need = cpuArchBitsX86AVX512
 		}
 		if (cab & need) != need {
 			return fmt.Errorf("check: missing cpu_arch for %q", typ.Innermost().Str(q.tm))
@@ -244,6 +244,21 @@ func (p *parser) parseTopLevelDecl() (*a.Node, error) {
 						p.src = p.src[1:]
 					}
 				}
+				if p.peek1() == t.IDFresh {
+					p.src = p.src[1:]
+					if !p.funcEffect.Coroutine() {
+						return nil, fmt.Errorf(`parse: fresh function must be a coroutine at %s:%d`,
+							p.filename, p.line())
+					}
+					flags |= a.FlagsFresh
+					if p.peek1() != t.IDOpenCurly {
+						if x := p.peek1(); x != t.IDComma {
+							return nil, fmt.Errorf(`parse: expected ",", got %q at %s:%d`,
+								p.tm.ByID(x), p.filename, p.line())
+						}
+						p.src = p.src[1:]
+					}
+				}
 
 				asserts, err = p.parseList(t.IDOpenCurly, (*parser).parseAssertNode)
 				if err != nil {
@@ -140,7 +140,8 @@ func (x ID) IsEtcUtility() bool {
 		case IDARMCRC32Utility,
 			IDARMNeonUtility,
 			IDX86SSE42Utility,
-			IDX86AVX2Utility:
+			IDX86AVX2Utility,
+			IDX86AVX512Utility:
 			return true
 		}
 	}
@@ -374,24 +375,25 @@ const (
 	IDContinue   = ID(0xB5)
 	IDElse       = ID(0xB6)
 	IDEndwhile   = ID(0xB7)
-	IDFunc       = ID(0xB8)
-	IDIOBind     = ID(0xB9)
-	IDIOLimit    = ID(0xBA)
-	IDIf         = ID(0xBB)
-	IDImplements = ID(0xBC)
-	IDInv        = ID(0xBD)
-	IDIterate    = ID(0xBE)
-	IDPost       = ID(0xBF)
-	IDPre        = ID(0xC0)
-	IDPri        = ID(0xC1)
-	IDPub        = ID(0xC2)
-	IDReturn     = ID(0xC3)
-	IDStruct     = ID(0xC4)
-	IDUse        = ID(0xC5)
-	IDVar        = ID(0xC6)
-	IDVia        = ID(0xC7)
-	IDWhile      = ID(0xC8)
-	IDYield      = ID(0xC9)
+	IDFresh      = ID(0xB8)
+	IDFunc       = ID(0xB9)
+	IDIOBind     = ID(0xBA)
+	IDIOLimit    = ID(0xBB)
+	IDIf         = ID(0xBC)
+	IDImplements = ID(0xBD)
+	IDInv        = ID(0xBE)
+	IDIterate    = ID(0xBF)
+	IDPost       = ID(0xC0)
+	IDPre        = ID(0xC1)
+	IDPri        = ID(0xC2)
+	IDPub        = ID(0xC3)
+	IDReturn     = ID(0xC4)
+	IDStruct     = ID(0xC5)
+	IDUse        = ID(0xC6)
+	IDVar        = ID(0xC7)
+	IDVia        = ID(0xC8)
+	IDWhile      = ID(0xC9)
+	IDYield      = ID(0xCA)
 )
 
 const (
@@ -513,6 +515,7 @@ const (
 	IDLimitedCopyU32FromReader                          = ID(0x175)
 	IDLimitedCopyU32FromSlice                           = ID(0x176)
 	IDLimitedCopyU32ToSlice                             = ID(0x177)
+	IDLimitedCopyU32FromReader16ByteChunksFast          = ID(0x178)
 
 	// -------- 0x180 block.
 
@@ -649,8 +652,9 @@ const (
 	IDLength         = ID(0x204)
 	IDReset          = ID(0x205)
 	IDSet            = ID(0x206)
-	IDUnroll         = ID(0x207)
-	IDUpdate         = ID(0x208)
+	IDStatsAdd       = ID(0x207)
+	IDUnroll         = ID(0x208)
+	IDUpdate         = ID(0x209)
 
 	// TODO: range/rect methods like intersection and contains?
 
@@ -709,14 +713,17 @@ const (
 	IDARMNeonU32x4 = ID(0x322)
 	IDARMNeonU64x2 = ID(0x323)
 
-	IDX86SSE42        = ID(0x390)
-	IDX86SSE42Utility = ID(0x391)
-	IDX86AVX2         = ID(0x392)
-	IDX86AVX2Utility  = ID(0x393)
-	IDX86BMI2         = ID(0x394)
+	IDX86SSE42         = ID(0x390)
+	IDX86SSE42Utility  = ID(0x391)
+	IDX86AVX2          = ID(0x392)
+	IDX86AVX2Utility   = ID(0x393)
+	IDX86BMI2          = ID(0x394)
+	IDX86AVX512        = ID(0x395)
+	IDX86AVX512Utility = ID(0x396)
 
 	IDX86M128I = ID(0x3A0)
 	IDX86M256I = ID(0x3A1)
+	IDX86M512I = ID(0x3A2)
 )
 
 var builtInsByID = [nBuiltInIDs]string{
@@ -801,6 +808,7 @@ var builtInsByID = [nBuiltInIDs]string{
 	IDContinue:   "continue",
 	IDElse:       "else",
 	IDEndwhile:   "endwhile",
+	IDFresh:      "fresh",
 	IDFunc:       "func",
 	IDIOBind:     "io_bind",
 	IDIOLimit:    "io_limit",
@@ -943,6 +951,7 @@ var builtInsByID = [nBuiltInIDs]string{
 	IDLimitedCopyU32FromReader:                          "limited_copy_u32_from_reader",
 	IDLimitedCopyU32FromSlice:                           "limited_copy_u32_from_slice",
 	IDLimitedCopyU32ToSlice:                             "limited_copy_u32_to_slice",
+	IDLimitedCopyU32FromReader16ByteChunksFast:          "limited_copy_u32_from_reader_16_byte_chunks_fast",
 
 	// -------- 0x180 block.
 
@@ -1077,6 +1086,7 @@ var builtInsByID = [nBuiltInIDs]string{
 	IDLength:         "length",
 	IDReset:          "reset",
 	IDSet:            "set",
+	IDStatsAdd:       "stats_add",
 	IDUnroll:         "unroll",
 	IDUpdate:         "update",
 
@@ -1126,14 +1136,17 @@ var builtInsByID = [nBuiltInIDs]string{
 	IDARMNeonU32x4: "arm_neon_u32x4",
 	IDARMNeonU64x2: "arm_neon_u64x2",
 
-	IDX86SSE42:        "x86_sse42",
-	IDX86SSE42Utility: "x86_sse42_utility",
-	IDX86AVX2:         "x86_avx2",
-	IDX86AVX2Utility:  "x86_avx2_utility",
-	IDX86BMI2:         "x86_bmi2",
+	IDX86SSE42:         "x86_sse42",
+	IDX86SSE42Utility:  "x86_sse42_utility",
+	IDX86AVX2:          "x86_avx2",
+	IDX86AVX2Utility:   "x86_avx2_utility",
+	IDX86BMI2:          "x86_bmi2",
+	IDX86AVX512:        "x86_avx512",
+	IDX86AVX512Utility: "x86_avx512_utility",
 
 	IDX86M128I: "x86_m128i",
 	IDX86M256I: "x86_m256i",
+	IDX86M512I: "x86_m512i",
 }
 
 var builtInsByName = map[string]ID{}
@@ -1299,9 +1312,12 @@ func init() {
 // addXForms modifies table so that, if table[x] == y, then table[y] = y.
 //
 // For example, for the unaryForms table, the explicit entries are like:
-//  IDPlus:        IDXUnaryPlus,
+//
+//	IDPlus:        IDXUnaryPlus,
+//
 // and this function implicitly addes entries like:
-//  IDXUnaryPlus:  IDXUnaryPlus,
+//
+//	IDXUnaryPlus:  IDXUnaryPlus,
 func addXForms(table *[nBuiltInSymbolicIDs]ID) {
 	implicitEntries := [nBuiltInSymbolicIDs]bool{}
 	for _, y := range table {
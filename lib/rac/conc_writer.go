@@ -0,0 +1,217 @@
+// Copyright 2022 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package rac
+
+const (
+	numWBuffersPerWorker = 2
+)
+
+// wBuffer holds one chunk, both uncompressed (in DSpace) and compressed (in
+// CSpace). The backing arrays are re-used for subsequent chunks.
+type wBuffer struct {
+	dBytes []byte
+	cBytes []byte
+}
+
+// wWork is a unit of work for concurrent writing. The concWriter sends
+// uncompressed chunks for Workers to compress. Workers send compressed chunks
+// back to the concWriter.
+type wWork struct {
+	err error
+
+	// seq is the chunk's position in the sequence of chunks, counting from 0.
+	seq uint64
+
+	// dSize is the chunk's size in DSpace. It can be larger than
+	// len(buffer.dBytes), as trailing zeroes are implicit in a RAC file and
+	// are not compressed.
+	dSize uint64
+
+	// codec, index2 and index3 are set by the Worker, per the return values
+	// of CodecWriter.Compress.
+	codec  Codec
+	index2 int
+	index3 int
+
+	// buffer holds the chunk's bytes. Its dBytes are set by the concWriter
+	// and its cBytes by the Worker.
+	buffer *wBuffer
+}
+
+// concWriter co-ordinates multiple Worker goroutines serving a Writer. Chunks
+// are compressed concurrently, so they may complete out of order, but they are
+// written in order, so that the output is the same as for a non-concurrent
+// Writer.
+type concWriter struct {
+	// Channels between the concWriter and multiple Workers.
+	//
+	// The concWriter sends reqc and    recvs resc.
+	// Each Worker    recvs reqc and    sends resc.
+	//
+	// Both channels can hold every buffer, so that neither the concWriter
+	// nor the Workers block on sending.
+	reqc chan wWork // Work-Request  channel.
+	resc chan wWork // Work-Response channel.
+
+	// freeBuffers hold the buffers not in use by any unit of work. Up to
+	// canAlloc more buffers can be allocated.
+	freeBuffers []*wBuffer
+	canAlloc    int
+
+	// completedWorks hold compressed chunks that are not the next chunk to be
+	// written. Works may arrive out of order.
+	//
+	// The map is keyed by a wWork's seq.
+	completedWorks map[uint64]wWork
+
+	// sendSeq and writeSeq are the seq of the next chunk to send to a Worker
+	// and of the next chunk to write. Chunks in between are work-in-progress.
+	sendSeq  uint64
+	writeSeq uint64
+}
+
+func (c *concWriter) initialize(racWriter *Writer) {
+	if racWriter.Concurrency <= 1 {
+		return
+	}
+	numWorkers := racWriter.Concurrency
+	if numWorkers > 65536 {
+		numWorkers = 65536
+	}
+	c.canAlloc = numWorkers * numWBuffersPerWorker
+	c.completedWorks = map[uint64]wWork{}
+
+	c.reqc = make(chan wWork, c.canAlloc)
+	c.resc = make(chan wWork, c.canAlloc)
+	for i := 0; i < numWorkers; i++ {
+		go runWWorker(c.resc, c.reqc, racWriter.CodecWriter.Clone(), racWriter.ResourcesData)
+	}
+}
+
+func (c *concWriter) ready() bool {
+	return c.reqc != nil
+}
+
+// Close shuts down the Workers. Any work-in-progress is abandoned.
+func (c *concWriter) Close() {
+	if c.reqc != nil {
+		close(c.reqc)
+		c.reqc = nil
+	}
+}
+
+// writeDChunks is like Writer.writeDChunks but compresses on the Workers.
+func (c *concWriter) writeDChunks(w *Writer, eof bool) error {
+	for {
+		peek0, peek1 := w.uncompressed.peek(w.dChunkSize)
+		dSize := uint64(len(peek0)) + uint64(len(peek1))
+		if (dSize == 0) || (!eof && (dSize < w.dChunkSize)) {
+			break
+		}
+
+		buffer, err := c.nextFreeBuffer(w)
+		if err != nil {
+			return err
+		}
+
+		peek1 = stripTrailingZeroes(peek1)
+		if len(peek1) == 0 {
+			peek0 = stripTrailingZeroes(peek0)
+		}
+		buffer.dBytes = append(buffer.dBytes[:0], peek0...)
+		buffer.dBytes = append(buffer.dBytes, peek1...)
+
+		c.reqc <- wWork{seq: c.sendSeq, dSize: dSize, buffer: buffer}
+		c.sendSeq++
+		w.uncompressed.advance(dSize)
+	}
+
+	if eof {
+		for c.writeSeq < c.sendSeq {
+			if err := c.writeCompletedWorks(w); err != nil {
+				return err
+			}
+		}
+	}
+	return nil
+}
+
+// nextFreeBuffer returns a buffer for the next chunk, waiting for (and
+// writing) earlier chunks if all of the buffers are in use.
+func (c *concWriter) nextFreeBuffer(w *Writer) (*wBuffer, error) {
+	for len(c.freeBuffers) == 0 {
+		if c.canAlloc > 0 {
+			c.canAlloc--
+			return &wBuffer{}, nil
+		}
+		if err := c.writeCompletedWorks(w); err != nil {
+			return nil, err
+		}
+	}
+	buffer := c.freeBuffers[len(c.freeBuffers)-1]
+	c.freeBuffers = c.freeBuffers[:len(c.freeBuffers)-1]
+	return buffer, nil
+}
+
+// writeCompletedWorks waits for one unit of work to complete and then writes
+// as many chunks, in order, as are available.
+func (c *concWriter) writeCompletedWorks(w *Writer) error {
+	work := <-c.resc
+	c.completedWorks[work.seq] = work
+
+	for {
+		work, ok := c.completedWorks[c.writeSeq]
+		if !ok {
+			return nil
+		}
+		delete(c.completedWorks, c.writeSeq)
+		c.writeSeq++
+
+		if work.err != nil {
+			w.err = work.err
+			return w.err
+		}
+		res2, err := w.useResource(work.index2)
+		if err != nil {
+			return err
+		}
+		res3, err := w.useResource(work.index3)
+		if err != nil {
+			return err
+		}
+		if err := w.chunkWriter.AddChunk(work.dSize, work.codec, work.buffer.cBytes, res2, res3); err != nil {
+			w.err = err
+			return err
+		}
+		c.freeBuffers = append(c.freeBuffers, work.buffer)
+	}
+}
+
+func runWWorker(resc chan<- wWork, reqc <-chan wWork, codecWriter CodecWriter, resourcesData [][]byte) {
+	defer codecWriter.Close()
+
+	for work := range reqc {
+		codec, cBytes, index2, index3, err :=
+			codecWriter.Compress(work.buffer.dBytes, nil, resourcesData)
+		work.err = err
+		work.codec = codec
+		work.index2 = index2
+		work.index3 = index3
+		// The cBytes can be clobbered by the next Compress call, so we copy
+		// them to the buffer.
+		work.buffer.cBytes = append(work.buffer.cBytes[:0], cBytes...)
+		resc <- work
+	}
+}
@@ -311,6 +311,23 @@ type Writer struct {
 	// https://github.com/google/brotli/blob/master/research/dictionary_generator.cc
 	ResourcesData [][]byte
 
+	// Concurrency is how many worker goroutines are used to compress RAC
+	// chunks. Bigger values often lead to faster throughput, up to a
+	// hardware-dependent point, but also larger memory requirements: each
+	// worker can hold two chunks' worth of buffers.
+	//
+	// Chunks are compressed out of order but written in order, so the output
+	// does not depend on Concurrency. Each worker uses its own CodecWriter,
+	// from calling CodecWriter.Clone.
+	//
+	// Concurrency only applies when DChunkSize is non-zero (or if both
+	// CChunkSize and DChunkSize are zero). With a CChunkSize, where each
+	// chunk ends wherever its compressed form is cut, the chunks are
+	// compressed one after another.
+	//
+	// Values less than 2 mean a non-concurrent (single-goroutine) writer.
+	Concurrency int
+
 	// resourcesIDs is the OptResource for each ResourcesData element. Zero
 	// means that corresponding resource is not yet used (and not yet written
 	// to the RAC file).
@@ -329,6 +346,10 @@ type Writer struct {
 	// chunkWriter is the low-level chunk writer.
 	chunkWriter ChunkWriter
 
+	// concWriter co-ordinates multiple goroutines, if Concurrency is 2 or
+	// more and the chunks have a fixed DSpace size.
+	concWriter concWriter
+
 	// uncompressed are the uncompressed bytes that have been given to this
 	// (via the Write method) but not yet compressed as a chunk.
 	uncompressed writeBuffer
@@ -374,6 +395,9 @@ func (w *Writer) initialize() error {
 	w.chunkWriter.IndexLocation = w.IndexLocation
 	w.chunkWriter.TempFile = w.TempFile
 	w.chunkWriter.CPageSize = w.CPageSize
+	if w.dChunkSize > 0 {
+		w.concWriter.initialize(w)
+	}
 	return nil
 }
 
@@ -422,7 +446,9 @@ func (w *Writer) Write(p []byte) (int, error) {
 }
 
 func (w *Writer) write(eof bool) error {
-	if w.dChunkSize > 0 {
+	if w.concWriter.ready() {
+		return w.concWriter.writeDChunks(w, eof)
+	} else if w.dChunkSize > 0 {
 		return w.writeDChunks(eof)
 	}
 	return w.writeCChunks(eof)
@@ -566,7 +592,8 @@ func (w *Writer) tryCChunk(targetDChunkSize uint64, force bool) error {
 // Close writes the RAC index to w.Writer and marks that w accepts no further
 // method calls.
 //
-// Calling Close will call Close on w's CodecWriter.
+// Calling Close will call Close on w's CodecWriter (and on its clones, if
+// Concurrency is 2 or more).
 //
 // For a one pass encoding, no further action is taken. For a two pass encoding
 // (i.e. IndexLocationAtStart), it then copies w.TempFile to w.Writer. Either
@@ -590,6 +617,7 @@ func (w *Writer) Close() error {
 	if w.err == nil {
 		w.err = w.chunkWriter.Close()
 	}
+	w.concWriter.Close()
 	if err := w.CodecWriter.Close(); w.err == nil {
 		w.err = err
 	}
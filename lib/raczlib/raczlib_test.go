@@ -58,7 +58,7 @@ const (
 		"\x66"
 )
 
-func racCompress(original []byte, cChunkSize uint64, dChunkSize uint64, resourcesData [][]byte) ([]byte, error) {
+func racCompress(original []byte, cChunkSize uint64, dChunkSize uint64, resourcesData [][]byte, concurrency int) ([]byte, error) {
 	buf := &bytes.Buffer{}
 	w := &rac.Writer{
 		Writer:        buf,
@@ -66,6 +66,7 @@ func racCompress(original []byte, cChunkSize uint64, dChunkSize uint64, resource
 		CChunkSize:    cChunkSize,
 		DChunkSize:    dChunkSize,
 		ResourcesData: resourcesData,
+		Concurrency:   concurrency,
 	}
 	if _, err := w.Write(original); err != nil {
 		return nil, fmt.Errorf("Write: %v", err)
@@ -197,7 +198,7 @@ func TestZeroedBytes(tt *testing.T) {
 			dChunkSize = 8
 		}
 
-		compressed, err := racCompress(original, cChunkSize, dChunkSize, nil)
+		compressed, err := racCompress(original, cChunkSize, dChunkSize, nil, 0)
 		if err != nil {
 			tt.Fatalf("i=%d: racCompress: %v", i, err)
 		}
@@ -256,7 +257,7 @@ func TestSharedDictionary(tt *testing.T) {
 		}
 
 		// Compress.
-		compressed, err := racCompress(original, 0, n, resourcesData)
+		compressed, err := racCompress(original, 0, n, resourcesData, 0)
 		if err != nil {
 			tt.Fatalf("i=%d: racCompress: %v", i, err)
 		}
@@ -283,6 +284,61 @@ func TestSharedDictionary(tt *testing.T) {
 	}
 }
 
+func TestConcurrentWriter(tt *testing.T) {
+	// Make some compressible data, with runs of zeroes (some of which are a
+	// chunk's trailing zeroes) and some dictionary-friendly data.
+	dictionary := []byte("One sheep. Two sheep. Three sheep. Four sheep. ")
+	original := []byte(nil)
+	for i := 0; len(original) < 100000; i++ {
+		original = append(original, dictionary[i%len(dictionary):]...)
+		original = append(original, make([]byte, i%777)...)
+		original = append(original, fmt.Sprintf("%d sheep.\n", i)...)
+	}
+
+	for _, resourcesData := range [][][]byte{nil, {dictionary}} {
+		want, err := racCompress(original, 0, 1000, resourcesData, 0)
+		if err != nil {
+			tt.Fatalf("racCompress (non-concurrent): %v", err)
+		}
+		for _, concurrency := range []int{2, 3, 8} {
+			// Writing in small pieces exercises Write calls that do not
+			// complete a chunk.
+			buf := &bytes.Buffer{}
+			w := &rac.Writer{
+				Writer:        buf,
+				CodecWriter:   &CodecWriter{},
+				DChunkSize:    1000,
+				ResourcesData: resourcesData,
+				Concurrency:   concurrency,
+			}
+			for p := original; len(p) > 0; {
+				n := 333
+				if n > len(p) {
+					n = len(p)
+				}
+				if _, err := w.Write(p[:n]); err != nil {
+					tt.Fatalf("concurrency=%d: Write: %v", concurrency, err)
+				}
+				p = p[n:]
+			}
+			if err := w.Close(); err != nil {
+				tt.Fatalf("concurrency=%d: Close: %v", concurrency, err)
+			}
+			if got := buf.Bytes(); !bytes.Equal(got, want) {
+				tt.Fatalf("concurrency=%d: output differs from the non-concurrent writer's", concurrency)
+			}
+		}
+
+		decompressed, err := racDecompress(want, 0)
+		if err != nil {
+			tt.Fatalf("racDecompress: %v", err)
+		}
+		if !bytes.Equal(decompressed, original) {
+			tt.Fatalf("racDecompress: round trip did not match original")
+		}
+	}
+}
+
 // rsSansReadAt wraps a strings.Reader to have only Read and Seek methods.
 type rsSansReadAt struct {
 	r *strings.Reader
@@ -0,0 +1,259 @@
+// Copyright 2022 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ----------------
+
+// This file contains a hand-written C++ benchmark of different strategies for
+// allocating the memory that wuffs_aux::DecodeImage decodes large images into.
+//
+// The input images are synthesized NIE images (4K and 8K UHD, i.e. 3840 × 2160
+// and 7680 × 4320 pixels). NIE is uncompressed, so decoding is little more
+// than a memcpy and the time spent in the kernel (page faults) and the TLB is
+// not hidden by any decompression work. Each image is decoded to 4 bytes per
+// pixel (BGRA_NONPREMUL, the same as the NIE payload), so the pixel buffer
+// alone is 32 MiB or 127 MiB. Compressed formats (e.g. PNG) take the same
+// page faults but spend more time otherwise.
+//
+// The strategies are:
+//  - Default:        plain wuffs_aux::DecodeImageCallbacks.
+//  - HugePages:      as Default, with a wuffs_aux::LargeAllocationPolicy
+//                    huge_page_threshold of 2 MiB.
+//  - HugePrefault:   as HugePages, with prefault set.
+//  - Pooled:         wuffs_aux::PoolingDecodeImageCallbacks, recycling each
+//                    DecodeImageResult so that the next decode re-uses its
+//                    (already faulted in) memory.
+//  - PooledHuge:     as Pooled, with a 2 MiB huge_page_threshold.
+//
+// Usage: g++ -O3 bench-cc-aux-large-allocations.cc && ./a.out
+//
+// For example, with gcc 12.2 (and -O3) on a Linux x86_64 machine whose
+// /sys/kernel/mm/transparent_hugepage/enabled is "madvise" (the relative
+// column is per image size):
+//
+// name                  time/op  relative
+// Default/4K/gcc        4.42ms   1.00x
+// HugePages/4K/gcc      3.61ms   1.23x
+// HugePrefault/4K/gcc   3.91ms   1.13x
+// Pooled/4K/gcc         3.53ms   1.25x
+// PooledHuge/4K/gcc     3.50ms   1.26x
+// Default/8K/gcc        67.4ms   1.00x
+// HugePages/8K/gcc      25.3ms   2.67x
+// HugePrefault/8K/gcc   23.8ms   2.84x
+// Pooled/8K/gcc         21.5ms   3.14x
+// PooledHuge/8K/gcc     20.2ms   3.34x
+//
+// Results vary with the kernel's transparent huge page settings (with
+// "never", the HugeEtc strategies are no faster than their counterparts) and
+// with the C library's malloc. glibc's malloc serves allocations above its
+// mmap threshold (which adapts, up to 32 MiB) by mmap and returns them to the
+// kernel on free, so that every Default/8K decode takes fresh page faults,
+// but it re-uses the Default/4K pixel buffer's (just under 32 MiB) memory.
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include <string>
+#include <vector>
+
+// Wuffs ships as a "single file C library" or "header file library" as per
+// https://github.com/nothings/stb/blob/master/docs/stb_howto.txt
+//
+// To use that single file as a "foo.c"-like implementation, instead of a
+// "foo.h"-like header, #define WUFFS_IMPLEMENTATION before #include'ing or
+// compiling it.
+#define WUFFS_IMPLEMENTATION
+
+// Defining the WUFFS_CONFIG__MODULE* macros are optional, but it lets users of
+// release/c/etc.c choose which parts of Wuffs to build. That file contains the
+// entire Wuffs standard library, implementing a variety of codecs and file
+// formats. Without this macro definition, an optimizing compiler or linker may
+// very well discard Wuffs code for unused codecs, but listing the Wuffs
+// modules we use makes that process explicit. Preprocessing means that such
+// code simply isn't compiled.
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__AUX__BASE
+#define WUFFS_CONFIG__MODULE__AUX__IMAGE
+#define WUFFS_CONFIG__MODULE__BASE
+#define WUFFS_CONFIG__MODULE__NIE
+
+// If building this program in an environment that doesn't easily accommodate
+// relative includes, you can use the script/inline-c-relative-includes.go
+// program to generate a stand-alone C file.
+#include "../release/c/wuffs-unsupported-snapshot.c"
+
+// The order matters here. Clang also defines "__GNUC__".
+#if defined(__clang__)
+const char* g_cc = "clang";
+const char* g_cc_version = __clang_version__;
+#elif defined(__GNUC__)
+const char* g_cc = "gcc";
+const char* g_cc_version = __VERSION__;
+#elif defined(_MSC_VER)
+const char* g_cc = "cl";
+const char* g_cc_version = "???";
+#else
+const char* g_cc = "cc";
+const char* g_cc_version = "???";
+#endif
+
+#define NUM_REPS 20
+
+// make_nie returns a width × height NIE image (with 4 bytes per pixel) whose
+// pixels are a simple gradient.
+std::vector<uint8_t>  //
+make_nie(uint32_t width, uint32_t height) {
+  std::vector<uint8_t> v(16 + (4 * (size_t)width * (size_t)height));
+  static const uint8_t header[8] = {0x6E, 0xC3, 0xAF, 0x45,
+                                    0xFF, 0x62, 0x6E, 0x34};
+  memcpy(v.data(), header, 8);
+  wuffs_base__poke_u32le__no_bounds_check(v.data() + 8, width);
+  wuffs_base__poke_u32le__no_bounds_check(v.data() + 12, height);
+  uint8_t* p = v.data() + 16;
+  for (uint32_t y = 0; y < height; y++) {
+    for (uint32_t x = 0; x < width; x++) {
+      p[0] = (uint8_t)x;
+      p[1] = (uint8_t)y;
+      p[2] = (uint8_t)(x ^ y);
+      p[3] = 0xFF;
+      p += 4;
+    }
+  }
+  return v;
+}
+
+class Bgra : public wuffs_aux::DecodeImageCallbacks {
+ public:
+  wuffs_base__pixel_format  //
+  SelectPixfmt(const wuffs_base__image_config& image_config) override {
+    return wuffs_base__make_pixel_format(
+        WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL);
+  }
+};
+
+class PooledBgra : public wuffs_aux::PoolingDecodeImageCallbacks {
+ public:
+  wuffs_base__pixel_format  //
+  SelectPixfmt(const wuffs_base__image_config& image_config) override {
+    return wuffs_base__make_pixel_format(
+        WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL);
+  }
+};
+
+// decode_once decodes the NIE image, returning an error message or nullptr.
+// pooled may be nullptr, in which case plain (non-pooling) callbacks are used.
+const char*  //
+decode_once(const std::vector<uint8_t>& src, PooledBgra* pooled) {
+  Bgra plain;
+  wuffs_aux::DecodeImageCallbacks& callbacks =
+      pooled ? static_cast<wuffs_aux::DecodeImageCallbacks&>(*pooled)
+             : static_cast<wuffs_aux::DecodeImageCallbacks&>(plain);
+  wuffs_aux::sync_io::MemoryInput input(src.data(), src.size());
+  wuffs_aux::DecodeImageResult result =
+      wuffs_aux::DecodeImage(callbacks, input);
+  if (!result.error_message.empty()) {
+    static std::string s_error_message;
+    s_error_message = result.error_message;
+    return s_error_message.c_str();
+  }
+  if (pooled) {
+    pooled->recycle(result);
+  }
+  return nullptr;
+}
+
+const char*  //
+bench(const char* name,
+      const char* size_name,
+      const std::vector<uint8_t>& src,
+      bool pool,
+      wuffs_aux::LargeAllocationPolicy policy) {
+  wuffs_aux::SetLargeAllocationPolicy(policy);
+  PooledBgra pooled;
+
+  // Warm up, which also fills the pool (if any).
+  const char* z = decode_once(src, pool ? &pooled : nullptr);
+  if (z) {
+    return z;
+  }
+
+  struct timeval bench_start_tv;
+  gettimeofday(&bench_start_tv, NULL);
+
+  for (int i = 0; i < NUM_REPS; i++) {
+    z = decode_once(src, pool ? &pooled : nullptr);
+    if (z) {
+      return z;
+    }
+  }
+
+  struct timeval bench_finish_tv;
+  gettimeofday(&bench_finish_tv, NULL);
+  int64_t micros =
+      (int64_t)(bench_finish_tv.tv_sec - bench_start_tv.tv_sec) * 1000000 +
+      (int64_t)(bench_finish_tv.tv_usec - bench_start_tv.tv_usec);
+  uint64_t nanos = 1;
+  if (micros > 0) {
+    nanos = (uint64_t)(micros)*1000;
+  }
+
+  printf("Benchmark%s/%s/%s\t%8d\t%8" PRIu64 " ns/op\n", name, size_name,
+         g_cc, NUM_REPS, nanos / NUM_REPS);
+  return nullptr;
+}
+
+const char*  //
+main1(int argc, char** argv) {
+  static const struct {
+    const char* name;
+    uint32_t width;
+    uint32_t height;
+  } sizes[2] = {
+      {"4K", 3840, 2160},
+      {"8K", 7680, 4320},
+  };
+
+  const uint64_t huge = 2 * 1024 * 1024;
+  for (int i = 0; i < 2; i++) {
+    std::vector<uint8_t> src = make_nie(sizes[i].width, sizes[i].height);
+    const char* z = nullptr;
+    (z = bench("Default", sizes[i].name, src, false, {0, false})) ||
+        (z = bench("HugePages", sizes[i].name, src, false, {huge, false})) ||
+        (z = bench("HugePrefault", sizes[i].name, src, false, {huge, true})) ||
+        (z = bench("Pooled", sizes[i].name, src, true, {0, false})) ||
+        (z = bench("PooledHuge", sizes[i].name, src, true, {huge, false}));
+    if (z) {
+      return z;
+    }
+  }
+  return nullptr;
+}
+
+int  //
+main(int argc, char** argv) {
+  printf("# %s version %s\n#\n", g_cc, g_cc_version);
+  printf(
+      "# The output format, including the \"Benchmark\" prefixes, is "
+      "compatible with Go's\n"
+      "# benchmark tool. To get the relative times, run it through\n"
+      "# script/benchstat-ratio.go.\n");
+
+  const char* z = main1(argc, argv);
+  if (z) {
+    fprintf(stderr, "%s\n", z);
+    return 1;
+  }
+  return 0;
+}
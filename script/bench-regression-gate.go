@@ -0,0 +1,300 @@
+// Copyright 2022 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//go:build ignore
+// +build ignore
+
+package main
+
+// bench-regression-gate.go converts benchmark output (the benchstat
+// compatible text printed by "wuffs bench" or by a test/c/std/*.c program's
+// "-bench" mode) to JSON and, optionally, compares it against a previously
+// saved JSON baseline, exiting non-zero if any benchmark got significantly
+// slower by more than a threshold.
+//
+// The benchmarks' test data is the test/data directory, which is checked in
+// to this repository, so that two runs (of the same commit or of different
+// commits) measure the same work.
+//
+// For example, to save a baseline and later compare against it:
+//
+// wuffs bench -reps=10 std/... | go run script/bench-regression-gate.go -out=old.json
+// (update or edit Wuffs)
+// wuffs bench -reps=10 std/... | go run script/bench-regression-gate.go -baseline=old.json
+//
+// Each benchmark is summarized by the median of its repetitions. A change is
+// significant if a two-sided Mann-Whitney U test (as used by benchstat) gives
+// a p-value below -alpha, which needs at least 5 repetitions in each run. A
+// significant slow-down of more than -threshold percent is a regression.
+//
+// With -baseline, this prints a benchstat-like table, one line per benchmark
+// present in both runs, and exits with status 1 if there were any
+// regressions. With -out (or with neither -baseline nor -out, which prints to
+// stdout), this writes the current run as JSON.
+//
+// The JSON also records each package's "cpu_arch features" (see the
+// wuffs_base__cpu_arch__features C function), so that runs on different
+// hardware, or with and without the test programs' -nosimd flag, are easier
+// to tell apart. Wuffs' decoders do not allocate memory, so there are no
+// allocation counts to record.
+
+import (
+	"bufio"
+	"encoding/json"
+	"flag"
+	"fmt"
+	"math"
+	"os"
+	"sort"
+	"strconv"
+	"strings"
+)
+
+var (
+	alpha     = flag.Float64("alpha", 0.05, "p-value below which a change is significant")
+	baseline  = flag.String("baseline", "", "JSON file (previously written by -out) to compare against")
+	out       = flag.String("out", "", "JSON file to write the current run to")
+	threshold = flag.Float64("threshold", 5, "slow-down percentage above which a significant change is a regression")
+)
+
+func main() {
+	if err := main1(); err != nil {
+		os.Stderr.WriteString(err.Error() + "\n")
+		os.Exit(1)
+	}
+}
+
+func main1() error {
+	flag.Parse()
+
+	curr, err := parse(bufio.NewScanner(os.Stdin))
+	if err != nil {
+		return err
+	}
+
+	if (*out != "") || (*baseline == "") {
+		enc, err := json.MarshalIndent(curr, "", "  ")
+		if err != nil {
+			return err
+		}
+		enc = append(enc, '\n')
+		if *out == "" {
+			os.Stdout.Write(enc)
+		} else if err := os.WriteFile(*out, enc, 0644); err != nil {
+			return err
+		}
+	}
+
+	if *baseline == "" {
+		return nil
+	}
+	prev := &run{}
+	if enc, err := os.ReadFile(*baseline); err != nil {
+		return err
+	} else if err := json.Unmarshal(enc, prev); err != nil {
+		return fmt.Errorf("could not parse %s: %v", *baseline, err)
+	}
+	if n := compare(prev, curr); n > 0 {
+		return fmt.Errorf("bench-regression-gate: %d regression(s)", n)
+	}
+	return nil
+}
+
+type run struct {
+	Packages   []pkg    `json:"packages"`
+	Benchmarks []*bench `json:"benchmarks"`
+}
+
+type pkg struct {
+	Name            string `json:"name"`
+	Compiler        string `json:"compiler"`
+	CPUArchFeatures string `json:"cpu_arch_features,omitempty"`
+}
+
+type bench struct {
+	Name          string    `json:"name"`
+	Package       string    `json:"package"`
+	MedianNsPerOp float64   `json:"median_ns_per_op"`
+	MedianMBPerS  float64   `json:"median_mb_per_s,omitempty"`
+	NsPerOp       []float64 `json:"ns_per_op"`
+	MBPerS        []float64 `json:"mb_per_s,omitempty"`
+}
+
+func parse(r *bufio.Scanner) (*run, error) {
+	ret := &run{}
+	byName := map[string]*bench{}
+	currPkg := ""
+	for r.Scan() {
+		line := strings.TrimSpace(r.Text())
+
+		if strings.HasPrefix(line, "# ") {
+			line = line[2:]
+			if strings.HasPrefix(line, "std/") {
+				currPkg = line
+				ret.Packages = append(ret.Packages, pkg{Name: currPkg})
+			} else if len(ret.Packages) == 0 {
+				// No-op.
+			} else if p := &ret.Packages[len(ret.Packages)-1]; p.Compiler == "" {
+				p.Compiler = line
+			} else if s := strings.TrimPrefix(line, "cpu_arch features "); s != line {
+				p.CPUArchFeatures = s
+			}
+			continue
+		} else if !strings.HasPrefix(line, "Benchmark") {
+			continue
+		}
+
+		// A line looks like one of:
+		//  - "Benchmarkfoo/gcc10  1000  1234 ns/op"
+		//  - "Benchmarkfoo/gcc10  1000  1234 ns/op  56.789 MB/s"
+		fields := strings.Fields(line[len("Benchmark"):])
+		if (len(fields) < 4) || (fields[3] != "ns/op") {
+			return nil, fmt.Errorf("could not parse %q", line)
+		}
+		ns, err := strconv.ParseFloat(fields[2], 64)
+		if err != nil {
+			return nil, fmt.Errorf("could not parse %q", line)
+		}
+		mbs := 0.0
+		if (len(fields) >= 6) && (fields[5] == "MB/s") {
+			if mbs, err = strconv.ParseFloat(fields[4], 64); err != nil {
+				return nil, fmt.Errorf("could not parse %q", line)
+			}
+		}
+
+		b := byName[fields[0]]
+		if b == nil {
+			b = &bench{Name: fields[0], Package: currPkg}
+			byName[b.Name] = b
+			ret.Benchmarks = append(ret.Benchmarks, b)
+		}
+		b.NsPerOp = append(b.NsPerOp, ns)
+		if mbs > 0 {
+			b.MBPerS = append(b.MBPerS, mbs)
+		}
+	}
+	if err := r.Err(); err != nil {
+		return nil, err
+	}
+
+	for _, b := range ret.Benchmarks {
+		b.MedianNsPerOp = median(b.NsPerOp)
+		b.MedianMBPerS = median(b.MBPerS)
+	}
+	return ret, nil
+}
+
+func compare(prev *run, curr *run) (numRegressions int) {
+	prevByName := map[string]*bench{}
+	for _, b := range prev.Benchmarks {
+		prevByName[b.Name] = b
+	}
+
+	tooFewReps := false
+	fmt.Printf("%-60s %12s %12s %8s %8s\n", "name", "old ns/op", "new ns/op", "delta", "p")
+	for _, c := range curr.Benchmarks {
+		p := prevByName[c.Name]
+		if (p == nil) || (p.MedianNsPerOp <= 0) {
+			continue
+		}
+		if (len(p.NsPerOp) < 5) || (len(c.NsPerOp) < 5) {
+			tooFewReps = true
+		}
+
+		delta := 100 * (c.MedianNsPerOp - p.MedianNsPerOp) / p.MedianNsPerOp
+		pValue := mannWhitneyU(p.NsPerOp, c.NsPerOp)
+		verdict := ""
+		if pValue >= *alpha {
+			verdict = "~"
+		} else if delta > *threshold {
+			verdict = "REGRESSION"
+			numRegressions++
+		}
+		fmt.Printf("%-60s %12.0f %12.0f %+7.2f%% %8.3f  %s\n",
+			c.Name, p.MedianNsPerOp, c.MedianNsPerOp, delta, pValue, verdict)
+	}
+
+	if tooFewReps {
+		fmt.Printf("\n# Some benchmarks had fewer than 5 reps, too few for significance.\n")
+	}
+	return numRegressions
+}
+
+func median(x []float64) float64 {
+	if len(x) == 0 {
+		return 0
+	}
+	s := append([]float64(nil), x...)
+	sort.Float64s(s)
+	if n := len(s); (n & 1) == 0 {
+		return (s[(n/2)-1] + s[n/2]) / 2
+	}
+	return s[len(s)/2]
+}
+
+// mannWhitneyU returns the two-sided p-value of the Mann-Whitney U test that
+// x and y come from the same distribution. It uses the normal approximation,
+// with tie correction, which is reasonable for 5 or more samples each.
+func mannWhitneyU(x []float64, y []float64) float64 {
+	n1, n2 := len(x), len(y)
+	if (n1 < 5) || (n2 < 5) {
+		return 1
+	}
+
+	type sample struct {
+		v     float64
+		fromX bool
+	}
+	all := make([]sample, 0, n1+n2)
+	for _, v := range x {
+		all = append(all, sample{v, true})
+	}
+	for _, v := range y {
+		all = append(all, sample{v, false})
+	}
+	sort.Slice(all, func(i int, j int) bool { return all[i].v < all[j].v })
+
+	// Assign ranks (1-based), averaging over ties.
+	rankSumX, tieTerm := 0.0, 0.0
+	for i := 0; i < len(all); {
+		j := i + 1
+		for (j < len(all)) && (all[j].v == all[i].v) {
+			j++
+		}
+		rank := float64(i+j+1) / 2
+		for k := i; k < j; k++ {
+			if all[k].fromX {
+				rankSumX += rank
+			}
+		}
+		if t := float64(j - i); t > 1 {
+			tieTerm += (t * t * t) - t
+		}
+		i = j
+	}
+
+	fn1, fn2 := float64(n1), float64(n2)
+	n := fn1 + fn2
+	u := rankSumX - (fn1 * (fn1 + 1) / 2)
+	mean := fn1 * fn2 / 2
+	variance := (fn1 * fn2 / 12) * ((n + 1) - (tieTerm / (n * (n - 1))))
+	if variance <= 0 {
+		return 1
+	}
+	z := (math.Abs(u-mean) - 0.5) / math.Sqrt(variance)
+	if z < 0 {
+		z = 0
+	}
+	return math.Erfc(z / math.Sqrt2)
+}
@@ -0,0 +1,377 @@
+// Copyright 2022 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//go:build ignore
+// +build ignore
+
+package main
+
+// convert-png-to-tiff.go decodes PNG from stdin and encodes TIFF to stdout.
+// Gray PNG images become 8-bit (or with -depth16, 16-bit) gray TIFF images and
+// other PNG images become 8-bit RGB TIFF images.
+//
+// Its flags select the TIFF byte order, compression (none, lzw, deflate or
+// packbits), predictor and strip or tile layout, to exercise the various code
+// paths of a TIFF decoder. The IFD (Image File Directory) is written after the
+// pixel data.
+//
+// Usage: go run convert-png-to-tiff.go -compression=lzw < foo.png > foo.tiff
+
+import (
+	"bytes"
+	"compress/zlib"
+	"encoding/binary"
+	"errors"
+	"flag"
+	"image"
+	"image/draw"
+	"image/png"
+	"os"
+	"sort"
+)
+
+var (
+	bigEndian    = flag.Bool("bigendian", false, "use the MM (big-endian) byte order")
+	compression  = flag.String("compression", "none", "none, lzw, deflate or packbits")
+	depth16      = flag.Bool("depth16", false, "use 16 bits per sample (gray only)")
+	predictor    = flag.Bool("predictor", false, "use horizontal differencing")
+	rowsPerStrip = flag.Int("rowsperstrip", 0, "rows per strip (0 means one strip)")
+	tileSize     = flag.Int("tilesize", 0, "tile width and height (0 means strips)")
+)
+
+func main() {
+	if err := main1(); err != nil {
+		os.Stderr.WriteString(err.Error() + "\n")
+		os.Exit(1)
+	}
+}
+
+func main1() error {
+	flag.Parse()
+	if (*tileSize < 0) || ((*tileSize % 16) != 0) {
+		return errors.New("bad -tilesize")
+	}
+	var order byteOrder = binary.LittleEndian
+	if *bigEndian {
+		order = binary.BigEndian
+	}
+
+	src, err := png.Decode(os.Stdin)
+	if err != nil {
+		return err
+	}
+	b := src.Bounds()
+	width, height := b.Dx(), b.Dy()
+
+	// Convert to chunky samples, one row after another.
+	samplesPerPixel, bytesPerSample, photometric := 3, 1, 2
+	pix := []byte(nil)
+	switch src.(type) {
+	case *image.Gray, *image.Gray16:
+		samplesPerPixel, photometric = 1, 1
+		dst := image.NewGray16(b)
+		draw.Draw(dst, b, src, b.Min, draw.Src)
+		if *depth16 {
+			bytesPerSample = 2
+			for i := 0; i < len(dst.Pix); i += 2 {
+				pix = order.AppendUint16(pix, binary.BigEndian.Uint16(dst.Pix[i:]))
+			}
+		} else {
+			for i := 0; i < len(dst.Pix); i += 2 {
+				pix = append(pix, dst.Pix[i])
+			}
+		}
+	default:
+		if *depth16 {
+			return errors.New("-depth16 requires a gray image")
+		}
+		dst := image.NewNRGBA(b)
+		draw.Draw(dst, b, src, b.Min, draw.Src)
+		for i := 0; i < len(dst.Pix); i += 4 {
+			pix = append(pix, dst.Pix[i:i+3]...)
+		}
+	}
+	bytesPerPixel := samplesPerPixel * bytesPerSample
+
+	// Lay out the strips or tiles. Tiles at the right and bottom edges are
+	// padded (with zeroes) to the full tile size.
+	chunkWidth, chunkHeight := width, height
+	if *tileSize > 0 {
+		chunkWidth, chunkHeight = *tileSize, *tileSize
+	} else if (*rowsPerStrip > 0) && (*rowsPerStrip < height) {
+		chunkHeight = *rowsPerStrip
+	}
+	chunks := [][]byte(nil)
+	for y0 := 0; y0 < height; y0 += chunkHeight {
+		for x0 := 0; x0 < width; x0 += chunkWidth {
+			rows := chunkHeight
+			if (*tileSize == 0) && (rows > (height - y0)) {
+				rows = height - y0
+			}
+			chunk := make([]byte, chunkWidth*rows*bytesPerPixel)
+			for y := 0; y < rows; y++ {
+				if (y0 + y) >= height {
+					break
+				}
+				n := chunkWidth
+				if n > (width - x0) {
+					n = width - x0
+				}
+				i := ((y0+y)*width + x0) * bytesPerPixel
+				copy(chunk[y*chunkWidth*bytesPerPixel:], pix[i:i+(n*bytesPerPixel)])
+			}
+			if *predictor {
+				applyPredictor(chunk, chunkWidth*bytesPerPixel, samplesPerPixel, bytesPerSample, order)
+			}
+			c, err := compress(chunk)
+			if err != nil {
+				return err
+			}
+			chunks = append(chunks, c)
+		}
+	}
+
+	out := []byte(nil)
+	if *bigEndian {
+		out = append(out, "MM\x00\x2A\x00\x00\x00\x00"...)
+	} else {
+		out = append(out, "II\x2A\x00\x00\x00\x00\x00"...)
+	}
+	offsets := []uint32(nil)
+	byteCounts := []uint32(nil)
+	for _, c := range chunks {
+		offsets = append(offsets, uint32(len(out)))
+		byteCounts = append(byteCounts, uint32(len(c)))
+		out = append(out, c...)
+	}
+
+	compressionValue := map[string]uint32{
+		"none":     1,
+		"lzw":      5,
+		"deflate":  8,
+		"packbits": 32773,
+	}[*compression]
+	predictorValue := uint32(1)
+	if *predictor {
+		predictorValue = 2
+	}
+	bitsPerSample := []uint32(nil)
+	for i := 0; i < samplesPerPixel; i++ {
+		bitsPerSample = append(bitsPerSample, uint32(8*bytesPerSample))
+	}
+
+	entries := []entry{
+		{256, 4, []uint32{uint32(width)}},
+		{257, 4, []uint32{uint32(height)}},
+		{258, 3, bitsPerSample},
+		{259, 3, []uint32{compressionValue}},
+		{262, 3, []uint32{uint32(photometric)}},
+		{277, 3, []uint32{uint32(samplesPerPixel)}},
+		{284, 3, []uint32{1}},
+		{317, 3, []uint32{predictorValue}},
+	}
+	if *tileSize > 0 {
+		entries = append(entries,
+			entry{322, 3, []uint32{uint32(chunkWidth)}},
+			entry{323, 3, []uint32{uint32(chunkHeight)}},
+			entry{324, 4, offsets},
+			entry{325, 4, byteCounts},
+		)
+	} else {
+		entries = append(entries,
+			entry{273, 4, offsets},
+			entry{278, 4, []uint32{uint32(chunkHeight)}},
+			entry{279, 4, byteCounts},
+		)
+	}
+	sort.Slice(entries, func(i, j int) bool { return entries[i].tag < entries[j].tag })
+
+	// Write the out-of-line values and then the IFD.
+	valueOffsets := make([]uint32, len(entries))
+	for i, e := range entries {
+		if v := e.encode(order); len(v) > 4 {
+			if (len(out) & 1) != 0 {
+				out = append(out, 0)
+			}
+			valueOffsets[i] = uint32(len(out))
+			out = append(out, v...)
+		}
+	}
+	if (len(out) & 1) != 0 {
+		out = append(out, 0)
+	}
+	order.PutUint32(out[4:], uint32(len(out)))
+	out = order.AppendUint16(out, uint16(len(entries)))
+	for i, e := range entries {
+		out = order.AppendUint16(out, e.tag)
+		out = order.AppendUint16(out, e.typ)
+		out = order.AppendUint32(out, uint32(len(e.values)))
+		if v := e.encode(order); len(v) > 4 {
+			out = order.AppendUint32(out, valueOffsets[i])
+		} else {
+			out = append(out, v...)
+			out = append(out, make([]byte, 4-len(v))...)
+		}
+	}
+	out = order.AppendUint32(out, 0)
+
+	_, err = os.Stdout.Write(out)
+	return err
+}
+
+type byteOrder interface {
+	binary.ByteOrder
+	binary.AppendByteOrder
+}
+
+type entry struct {
+	tag    uint16
+	typ    uint16
+	values []uint32
+}
+
+func (e entry) encode(order byteOrder) (b []byte) {
+	for _, v := range e.values {
+		if e.typ == 3 {
+			b = order.AppendUint16(b, uint16(v))
+		} else {
+			b = order.AppendUint32(b, v)
+		}
+	}
+	return b
+}
+
+func applyPredictor(chunk []byte, bytesPerRow int, samplesPerPixel int, bytesPerSample int, order byteOrder) {
+	for r := 0; r < len(chunk); r += bytesPerRow {
+		row := chunk[r : r+bytesPerRow]
+		if bytesPerSample == 1 {
+			for i := len(row) - 1; i >= samplesPerPixel; i-- {
+				row[i] -= row[i-samplesPerPixel]
+			}
+		} else {
+			for i := len(row) - 2; i >= 2; i -= 2 {
+				order.PutUint16(row[i:], order.Uint16(row[i:])-order.Uint16(row[i-2:]))
+			}
+		}
+	}
+}
+
+func compress(chunk []byte) ([]byte, error) {
+	switch *compression {
+	case "none":
+		return chunk, nil
+	case "lzw":
+		return compressLZW(chunk), nil
+	case "deflate":
+		buf := &bytes.Buffer{}
+		w := zlib.NewWriter(buf)
+		w.Write(chunk)
+		if err := w.Close(); err != nil {
+			return nil, err
+		}
+		return buf.Bytes(), nil
+	case "packbits":
+		return compressPackBits(chunk), nil
+	}
+	return nil, errors.New("bad -compression")
+}
+
+// compressLZW implements TIFF's LZW flavor: MSB first, 8-bit literals and the
+// code width growing one code early (the "EarlyChange" option).
+func compressLZW(src []byte) []byte {
+	const clear, end = 256, 257
+	dst := []byte(nil)
+	bits, nBits, width := uint32(0), uint32(0), uint32(9)
+	emit := func(code uint32) {
+		bits |= code << (32 - width - nBits)
+		nBits += width
+		for nBits >= 8 {
+			dst = append(dst, uint8(bits>>24))
+			bits <<= 8
+			nBits -= 8
+		}
+	}
+
+	table := map[string]uint32{}
+	next := uint32(258)
+	emit(clear)
+	prefix := ""
+	for _, c := range src {
+		s := prefix + string([]byte{c})
+		if _, ok := table[s]; ok || (len(s) == 1) {
+			prefix = s
+			continue
+		}
+		emit(codeOf(table, prefix))
+		table[s] = next
+		next++
+		if next == (1 << width) {
+			width++
+		}
+		if next == 4094 {
+			emit(clear)
+			table = map[string]uint32{}
+			next, width = 258, 9
+		}
+		prefix = string([]byte{c})
+	}
+	if prefix != "" {
+		emit(codeOf(table, prefix))
+		next++
+		if next == (1 << width) {
+			width++
+		}
+	}
+	emit(end)
+	if nBits > 0 {
+		dst = append(dst, uint8(bits>>24))
+	}
+	return dst
+}
+
+func codeOf(table map[string]uint32, s string) uint32 {
+	if len(s) == 1 {
+		return uint32(s[0])
+	}
+	return table[s]
+}
+
+func compressPackBits(src []byte) []byte {
+	dst := []byte(nil)
+	for len(src) > 0 {
+		// Look for a run of at least 3 identical bytes.
+		n := 1
+		for (n < len(src)) && (n < 128) && (src[n] == src[0]) {
+			n++
+		}
+		if n >= 3 {
+			dst = append(dst, uint8(257-n), src[0])
+			src = src[n:]
+			continue
+		}
+
+		// Otherwise, emit literals up to the next such run.
+		n = 0
+		for (n < len(src)) && (n < 128) {
+			if ((n + 2) < len(src)) && (src[n] == src[n+1]) && (src[n] == src[n+2]) {
+				break
+			}
+			n++
+		}
+		dst = append(dst, uint8(n-1))
+		dst = append(dst, src[:n]...)
+		src = src[n:]
+	}
+	return dst
+}
@@ -0,0 +1,229 @@
+// Copyright 2022 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//go:build ignore
+// +build ignore
+
+package main
+
+// convert-pngs-to-ico.go decodes one or more PNG files and encodes a multiple
+// entry ICO file to stdout, one entry per PNG file, in argument order.
+//
+// Each argument is "format:filename", where the format is one of:
+//  - png:   the PNG file's bytes, embedded verbatim.
+//  - bmp1, bmp4 or bmp8: a 1, 4 or 8 bits per pixel palette-based DIB. The PNG
+//    image must be palette-based, with few enough colors.
+//  - bmp24: a 24 bits per pixel BGR DIB.
+//  - bmp32: a 32 bits per pixel BGRA (non-premultiplied) DIB.
+//
+// For all DIB formats, the AND mask's bits are set for pixels whose alpha is
+// less than 0x80. For bmp1, bmp4, bmp8 and bmp24, those pixels' color is
+// zeroed in the DIB's pixel data.
+//
+// Usage: go run convert-pngs-to-ico.go bmp24:foo.png png:bar.png > foo.ico
+
+import (
+	"encoding/binary"
+	"errors"
+	"image"
+	"image/color"
+	"image/png"
+	"os"
+	"strings"
+)
+
+func main() {
+	if err := main1(); err != nil {
+		os.Stderr.WriteString(err.Error() + "\n")
+		os.Exit(1)
+	}
+}
+
+type entry struct {
+	width  int
+	height int
+	colors int
+	bpp    int
+	data   []byte
+}
+
+func main1() error {
+	args := os.Args[1:]
+	if (len(args) == 0) || (len(args) > 0xFFFF) {
+		return errors.New("usage: go run convert-pngs-to-ico.go format:filename...")
+	}
+
+	entries := []entry(nil)
+	for _, arg := range args {
+		i := strings.IndexByte(arg, ':')
+		if i < 0 {
+			return errors.New("bad argument: " + arg)
+		}
+		e, err := makeEntry(arg[:i], arg[i+1:])
+		if err != nil {
+			return err
+		}
+		entries = append(entries, e)
+	}
+
+	// Write the ICONDIR and then the ICONDIRENTRY's.
+	out := []byte(nil)
+	out = appendU16(out, 0)
+	out = appendU16(out, 1)
+	out = appendU16(out, uint32(len(entries)))
+	offset := 6 + (16 * len(entries))
+	for _, e := range entries {
+		out = append(out,
+			uint8(e.width),
+			uint8(e.height),
+			uint8(e.colors),
+			0,
+		)
+		out = appendU16(out, 1)
+		out = appendU16(out, uint32(e.bpp))
+		out = appendU32(out, uint32(len(e.data)))
+		out = appendU32(out, uint32(offset))
+		offset += len(e.data)
+	}
+	for _, e := range entries {
+		out = append(out, e.data...)
+	}
+	_, err := os.Stdout.Write(out)
+	return err
+}
+
+func makeEntry(format string, filename string) (entry, error) {
+	raw, err := os.ReadFile(filename)
+	if err != nil {
+		return entry{}, err
+	}
+	f, err := os.Open(filename)
+	if err != nil {
+		return entry{}, err
+	}
+	defer f.Close()
+	src, err := png.Decode(f)
+	if err != nil {
+		return entry{}, err
+	}
+	b := src.Bounds()
+	e := entry{
+		width:  b.Dx(),
+		height: b.Dy(),
+	}
+	if (e.width > 256) || (e.height > 256) {
+		return entry{}, errors.New("image is too large: " + filename)
+	}
+
+	switch format {
+	case "png":
+		e.bpp, e.data = 32, raw
+		return e, nil
+	case "bmp1":
+		e.bpp = 1
+	case "bmp4":
+		e.bpp = 4
+	case "bmp8":
+		e.bpp = 8
+	case "bmp24":
+		e.bpp = 24
+	case "bmp32":
+		e.bpp = 32
+	default:
+		return entry{}, errors.New("bad format: " + format)
+	}
+
+	palette := color.Palette(nil)
+	if e.bpp <= 8 {
+		p, ok := src.(*image.Paletted)
+		if !ok || (len(p.Palette) > (1 << e.bpp)) {
+			return entry{}, errors.New("image is not palette-based with few enough colors: " + filename)
+		}
+		palette = p.Palette
+		if len(palette) < 256 {
+			e.colors = len(palette)
+		}
+	}
+
+	// Write the 40 byte BITMAPINFOHEADER, with a doubled height, and then the
+	// palette (if any).
+	data := []byte(nil)
+	data = appendU32(data, 40)
+	data = appendU32(data, uint32(e.width))
+	data = appendU32(data, uint32(2*e.height))
+	data = appendU16(data, 1)
+	data = appendU16(data, uint32(e.bpp))
+	data = appendU32(data, 0)
+	data = appendU32(data, 0)
+	data = appendU32(data, 0)
+	data = appendU32(data, 0)
+	data = appendU32(data, uint32(len(palette)))
+	data = appendU32(data, 0)
+	for _, c := range palette {
+		n := color.NRGBAModel.Convert(c).(color.NRGBA)
+		data = append(data, n.B, n.G, n.R, 0)
+	}
+
+	// Write the pixel data and then the AND mask, both bottom-up, with each
+	// row padded to a multiple of 4 bytes.
+	xorStride := (((e.width * e.bpp) + 31) / 32) * 4
+	andStride := ((e.width + 31) / 32) * 4
+	xor := make([]byte, xorStride*e.height)
+	and := make([]byte, andStride*e.height)
+	for y := 0; y < e.height; y++ {
+		xorRow := xor[(e.height-1-y)*xorStride:]
+		andRow := and[(e.height-1-y)*andStride:]
+		for x := 0; x < e.width; x++ {
+			n := color.NRGBAModel.Convert(src.At(b.Min.X+x, b.Min.Y+y)).(color.NRGBA)
+			masked := n.A < 0x80
+			if masked {
+				andRow[x/8] |= 0x80 >> uint(x%8)
+			}
+
+			switch e.bpp {
+			case 1, 4, 8:
+				if !masked {
+					index := uint32(src.(*image.Paletted).ColorIndexAt(b.Min.X+x, b.Min.Y+y))
+					bitPos := x * e.bpp
+					shift := uint(8 - e.bpp - (bitPos % 8))
+					xorRow[bitPos/8] |= uint8(index << shift)
+				}
+			case 24:
+				if !masked {
+					xorRow[(3*x)+0] = n.B
+					xorRow[(3*x)+1] = n.G
+					xorRow[(3*x)+2] = n.R
+				}
+			case 32:
+				xorRow[(4*x)+0] = n.B
+				xorRow[(4*x)+1] = n.G
+				xorRow[(4*x)+2] = n.R
+				xorRow[(4*x)+3] = n.A
+			}
+		}
+	}
+	data = append(data, xor...)
+	data = append(data, and...)
+
+	e.data = data
+	return e, nil
+}
+
+func appendU16(b []byte, x uint32) []byte {
+	return binary.LittleEndian.AppendUint16(b, uint16(x))
+}
+
+func appendU32(b []byte, x uint32) []byte {
+	return binary.LittleEndian.AppendUint32(b, x)
+}
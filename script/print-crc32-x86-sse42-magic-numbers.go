@@ -46,6 +46,10 @@ package main
 // k5' = 0x1_63CD_6124
 // k6' = 0x1_DB71_0640
 // μ'  = 0x1_F701_1641
+//
+// The bit-reflected numbers for folding 2048 bits (4×512) at a time.
+// k1' = 0x1_1542_778A
+// k2' = 0x1_322D_1430
 
 import (
 	"fmt"
@@ -64,7 +68,7 @@ const px = "100000100110000010001110110110111"
 // P(x)' = 0x1_11011011_01110001_00000110_01000001
 const pxdash = "111011011011100010000011001000001"
 
-var spaces = strings.Repeat(" ", 1024)
+var spaces = strings.Repeat(" ", 4096)
 
 func debugf(format string, a ...interface{}) {
 	if false { // Change false to true to show the long divisions.
@@ -149,4 +153,12 @@ func main() {
 	calcKn("k5'", 64)
 	calcKn("k6'", 32)
 	calcMu("μ' ")
+
+	fmt.Println()
+
+	// These are used by std/crc32's up_x86_avx512, which folds four 512-bit
+	// registers per loop iteration, instead of four 128-bit registers.
+	fmt.Println("The bit-reflected numbers for folding 2048 bits (4×512) at a time.")
+	calcKn("k1'", 2048+32)
+	calcKn("k2'", 2048-32)
 }
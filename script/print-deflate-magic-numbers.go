@@ -20,6 +20,11 @@ package main
 // print-deflate-magic-numbers.go prints the std/deflate lcode_magic_numbers
 // and dcode_magic_numbers values based on the tables in RFC 1951 secion 3.2.5.
 //
+// It then prints the std/deflate fixed_lcode_huffs and fixed_dcode_huffs
+// values: the decoder.huffs tables (9 and 5 bits wide) for the fixed Huffman
+// codes in RFC 1951 section 3.2.6, as the decoder's init_huff method would
+// build them from those code lengths.
+//
 // The lcode base numbers are biased by -3 so that (base_number_minus_3 +
 // extra_bits) fits in the range [0, 255]. This makes a bitwise-and with 0xFF a
 // no-op, in terms of computed value, but proves to the compiler that the
@@ -50,6 +55,7 @@ func main1() error {
 	// See the "base numbers" comment above.
 	biases := [2]uint32{3, 1}
 
+	magicNumbers := [2][32]uint32{}
 	for i := 0; i < 2; i++ {
 		if i != 0 {
 			fmt.Println()
@@ -59,15 +65,101 @@ func main1() error {
 			if bn := baseNumbers[i][j]; bn != bad {
 				x = 0x40000000 | ((bn - biases[i]) << 8) | (extraBits[i][j] << 4)
 			}
+			magicNumbers[i][j] = x
 			fmt.Printf("0x%08X,", x)
 			if j&7 == 7 {
 				fmt.Println()
 			}
 		}
 	}
+
+	// The fixed code lengths. Symbols 286 and 287 (and distance symbols 30
+	// and 31) are part of the code but will never occur in valid data.
+	codeLengths := [2][]uint32{make([]uint32, 288), make([]uint32, 32)}
+	for j := range codeLengths[0] {
+		switch {
+		case j < 144:
+			codeLengths[0][j] = 8
+		case j < 256:
+			codeLengths[0][j] = 9
+		case j < 280:
+			codeLengths[0][j] = 7
+		default:
+			codeLengths[0][j] = 8
+		}
+	}
+	for j := range codeLengths[1] {
+		codeLengths[1][j] = 5
+	}
+
+	for i := 0; i < 2; i++ {
+		fmt.Println()
+		huffs := buildHuffs(codeLengths[i], i, magicNumbers[i])
+		for j, x := range huffs {
+			fmt.Printf("0x%04X_%04X,", x>>16, x&0xFFFF)
+			if j&7 == 7 {
+				fmt.Println()
+			} else {
+				fmt.Print(" ")
+			}
+		}
+	}
 	return nil
 }
 
+// buildHuffs returns the single level decoder.huffs table for the given code
+// lengths, all of which must be at most 9. Each code is assigned per RFC 1951
+// section 3.2.2 and, as deflate packs Huffman codes starting with their most
+// significant bit, is bit-reversed to be the table index (duplicated over all
+// values of the unused high bits).
+func buildHuffs(codeLengths []uint32, which int, magicNumbers [32]uint32) []uint32 {
+	maxCL := uint32(0)
+	counts := [16]uint32{}
+	for _, cl := range codeLengths {
+		counts[cl]++
+		if maxCL < cl {
+			maxCL = cl
+		}
+	}
+
+	nextCode := [16]uint32{}
+	code := uint32(0)
+	for cl := 1; cl < 16; cl++ {
+		code = (code + counts[cl-1]) << 1
+		nextCode[cl] = code
+	}
+
+	huffs := make([]uint32, 1<<maxCL)
+	for symbol, cl := range codeLengths {
+		code := nextCode[cl]
+		nextCode[cl]++
+		reversed := uint32(0)
+		for k := uint32(0); k < cl; k++ {
+			reversed |= ((code >> k) & 1) << (cl - 1 - k)
+		}
+
+		value := uint32(0)
+		switch {
+		case (which == 0) && (symbol == 256):
+			// End-of-block.
+			value = 0x20000000 | cl
+		case (which == 0) && (symbol < 256):
+			// Literal.
+			value = 0x80000000 | (uint32(symbol) << 8) | cl
+		case which == 0:
+			// Base number + extra bits.
+			value = magicNumbers[(symbol-257)&31] | cl
+		default:
+			value = magicNumbers[symbol&31] | cl
+		}
+
+		for j := reversed; j < uint32(len(huffs)); j += 1 << cl {
+			huffs[j] = value
+		}
+	}
+	return huffs
+}
+
 const bad = 0xFFFFFFFF
 
 var (
@@ -0,0 +1,490 @@
+// Copyright 2022 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ----------------
+
+/*
+This test program exercises the C++ (not C) wuffs_aux::IndexCborSequence and
+wuffs_aux::ParallelDecodeCborSequence functions, comparing their verdicts
+with wuffs_aux::DecodeCbor's. Unlike the test/c/std programs, it does not use
+test/c/testlib (which is C only).
+
+To manually run this test, from the repository's root directory:
+
+for CXX in clang++ g++; do
+  $CXX -std=c++11 -Wall -Werror -pthread test/c/auxiliary/cbor.cc && ./a.out
+  rm -f a.out
+done
+
+Each edition should print "PASS", amongst other information, and exit(0).
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+// Wuffs ships as a "single file C library" or "header file library" as per
+// https://github.com/nothings/stb/blob/master/docs/stb_howto.txt
+//
+// To use that single file as a "foo.c"-like implementation, instead of a
+// "foo.h"-like header, #define WUFFS_IMPLEMENTATION before #include'ing or
+// compiling it.
+#define WUFFS_IMPLEMENTATION
+
+// Defining the WUFFS_CONFIG__MODULE* macros are optional, but it lets users of
+// release/c/etc.c choose which parts of Wuffs to build. That file contains the
+// entire Wuffs standard library, implementing a variety of codecs and file
+// formats. Without this macro definition, an optimizing compiler or linker may
+// very well discard Wuffs code for unused codecs, but listing the Wuffs
+// modules we use makes that process explicit. Preprocessing means that such
+// code simply isn't compiled.
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__AUX__BASE
+#define WUFFS_CONFIG__MODULE__AUX__CBOR
+#define WUFFS_CONFIG__MODULE__BASE
+#define WUFFS_CONFIG__MODULE__CBOR
+
+// If building this program in an environment that doesn't easily accommodate
+// relative includes, you can use the script/inline-c-relative-includes.go
+// program to generate a stand-alone C file.
+#include "../../../release/c/wuffs-unsupported-snapshot.c"
+
+// The order matters here. Clang also defines "__GNUC__".
+#if defined(__clang__)
+const char* g_cc = "clang";
+#elif defined(__GNUC__)
+const char* g_cc = "gcc";
+#elif defined(_MSC_VER)
+const char* g_cc = "cl";
+#else
+const char* g_cc = "cc";
+#endif
+
+// g_fail_message holds the most recent test failure's message.
+std::string g_fail_message;
+
+#define CHECK(cond, ...)                                                      \
+  do {                                                                        \
+    if (!(cond)) {                                                            \
+      char fail_buf[1024];                                                    \
+      snprintf(fail_buf, sizeof fail_buf, "%s: ", __func__);                  \
+      size_t fail_n = strlen(fail_buf);                                       \
+      snprintf(fail_buf + fail_n, sizeof fail_buf - fail_n, __VA_ARGS__);     \
+      g_fail_message = fail_buf;                                              \
+      return g_fail_message.c_str();                                          \
+    }                                                                         \
+  } while (false)
+
+#define CHECK_STRING(string)       \
+  do {                             \
+    const char* z = (string);      \
+    if (z) {                       \
+      return z;                    \
+    }                              \
+  } while (false)
+
+// ---------------- Helpers
+
+const char*  //
+read_file(std::vector<uint8_t>& dst, const char* path) {
+  FILE* f = fopen(path, "rb");
+  if (!f) {
+    g_fail_message = std::string("read_file: could not open ") + path;
+    return g_fail_message.c_str();
+  }
+  uint8_t buf[4096];
+  while (true) {
+    size_t n = fread(buf, 1, sizeof buf, f);
+    dst.insert(dst.end(), buf, buf + n);
+    if (n < sizeof buf) {
+      break;
+    }
+  }
+  bool ok = !ferror(f);
+  fclose(f);
+  if (!ok) {
+    g_fail_message = std::string("read_file: could not read ") + path;
+    return g_fail_message.c_str();
+  }
+  return nullptr;
+}
+
+// Recorder is a DecodeCborCallbacks that records the values it sees as a
+// compact, JSON-like string. If m_done is non-null, Done copies that string
+// (or, on failure, the error message) to *m_done.
+class Recorder : public wuffs_aux::DecodeCborCallbacks {
+ public:
+  std::string m_s;
+  std::string* m_done = nullptr;
+
+  std::string AppendNull() override { return append("n"); }
+  std::string AppendUndefined() override { return append("undefined"); }
+  std::string AppendBool(bool val) override { return append(val ? "t" : "f"); }
+
+  std::string AppendF64(double val) override {
+    char buf[64];
+    snprintf(buf, sizeof buf, "%.17g", val);
+    return append(buf);
+  }
+
+  std::string AppendI64(int64_t val) override {
+    return append(std::to_string(val));
+  }
+
+  std::string AppendU64(uint64_t val) override {
+    return append(std::to_string(val));
+  }
+
+  std::string AppendByteString(std::string&& val) override {
+    return append("b\"" + val + "\"");
+  }
+
+  std::string AppendTextString(std::string&& val) override {
+    return append("\"" + val + "\"");
+  }
+
+  std::string AppendMinus1MinusX(uint64_t val) override {
+    return append("-1-" + std::to_string(val));
+  }
+
+  std::string AppendCborSimpleValue(uint8_t val) override {
+    return append("simple" + std::to_string(val));
+  }
+
+  std::string AppendCborTag(uint64_t val) override {
+    return append("tag" + std::to_string(val));
+  }
+
+  std::string Push(uint32_t flags) override {
+    std::string z = append(
+        (flags & WUFFS_BASE__TOKEN__VBD__STRUCTURE__TO_DICT) ? "{" : "[");
+    m_need_comma = false;
+    return z;
+  }
+
+  std::string Pop(uint32_t flags) override {
+    m_s += (flags & WUFFS_BASE__TOKEN__VBD__STRUCTURE__FROM_DICT) ? "}" : "]";
+    m_need_comma = true;
+    return "";
+  }
+
+  void Done(wuffs_aux::DecodeCborResult& result,
+            wuffs_aux::sync_io::Input& input,
+            wuffs_aux::IOBuffer& buffer) override {
+    if (m_done) {
+      *m_done = result.error_message.empty() ? m_s
+                                             : ("!" + result.error_message);
+    }
+  }
+
+ private:
+  bool m_need_comma = false;
+
+  std::string append(const std::string& s) {
+    if (m_need_comma) {
+      m_s += ",";
+    }
+    m_s += s;
+    m_need_comma = true;
+    return "";
+  }
+};
+
+// ItemsRecorder is a ParallelDecodeCborSequenceCallbacks whose m_items[k]
+// holds what the k'th item's Recorder saw.
+class ItemsRecorder : public wuffs_aux::ParallelDecodeCborSequenceCallbacks {
+ public:
+  ItemsRecorder(size_t num_items) : m_items(num_items) {}
+
+  std::vector<std::string> m_items;
+
+  std::unique_ptr<wuffs_aux::DecodeCborCallbacks>  //
+  NewItemCallbacks(size_t item_index) override {
+    Recorder* r = new Recorder();
+    r->m_done = &m_items[item_index];
+    return std::unique_ptr<wuffs_aux::DecodeCborCallbacks>(r);
+  }
+};
+
+// decode_cbor_sequence is the reference: it calls DecodeCbor on each item in
+// turn, each call starting where the previous one stopped. It returns the
+// first item's error message, if any.
+std::string  //
+decode_cbor_sequence(std::vector<uint64_t>& offsets,
+                     std::vector<std::string>& items,
+                     const uint8_t* ptr,
+                     size_t len) {
+  size_t i = 0;
+  while (i < len) {
+    Recorder r;
+    wuffs_aux::sync_io::MemoryInput input(ptr + i, len - i);
+    wuffs_aux::DecodeCborResult result = wuffs_aux::DecodeCbor(r, input);
+    if (!result.error_message.empty()) {
+      return result.error_message;
+    }
+    offsets.push_back(i);
+    items.push_back(r.m_s);
+    i += static_cast<size_t>(result.cursor_position);
+  }
+  return "";
+}
+
+// check_sequence checks that IndexCborSequence and ParallelDecodeCborSequence
+// agree with decode_cbor_sequence on whether src is a valid CBOR sequence
+// and, if so, on its items. It sets *valid to that verdict.
+const char*  //
+check_sequence(bool* valid, const std::string& name, const uint8_t* ptr,
+               size_t len) {
+  std::vector<uint64_t> want_offsets;
+  std::vector<std::string> want_items;
+  std::string want_error =
+      decode_cbor_sequence(want_offsets, want_items, ptr, len);
+  *valid = want_error.empty();
+
+  std::vector<uint64_t> offsets;
+  std::string index_error = wuffs_aux::IndexCborSequence(offsets, ptr, len);
+  if (!index_error.empty()) {
+    CHECK(!want_error.empty(), "%s: IndexCborSequence: %s", name.c_str(),
+          index_error.c_str());
+    return nullptr;
+  }
+  // IndexCborSequence does not check everything that DecodeCbor does, but
+  // the items it finds are where DecodeCbor (if it got that far) found them.
+  for (size_t k = 0; k < want_offsets.size(); k++) {
+    CHECK((k < offsets.size()) && (offsets[k] == want_offsets[k]),
+          "%s: offsets[%zu] differ", name.c_str(), k);
+  }
+
+  for (uint32_t num_threads : {1u, 2u, 8u}) {
+    ItemsRecorder callbacks(offsets.size());
+    std::string error = wuffs_aux::ParallelDecodeCborSequence(
+        callbacks, ptr, len, offsets, num_threads);
+    CHECK(error == want_error,
+          "%s: num_threads=%u: have \"%s\", want \"%s\"", name.c_str(),
+          num_threads, error.c_str(), want_error.c_str());
+    if (!error.empty()) {
+      continue;
+    }
+    CHECK(offsets.size() == want_offsets.size(),
+          "%s: num_items: have %zu, want %zu", name.c_str(), offsets.size(),
+          want_offsets.size());
+    for (size_t k = 0; k < offsets.size(); k++) {
+      CHECK(callbacks.m_items[k] == want_items[k],
+            "%s: num_threads=%u: item %zu: have %s, want %s", name.c_str(),
+            num_threads, k, callbacks.m_items[k].c_str(),
+            want_items[k].c_str());
+    }
+  }
+  return nullptr;
+}
+
+// ---------------- Tests
+
+const char*  //
+test_wuffs_aux_cbor_sequence_depth() {
+  // Nesting containers up to WUFFS_CBOR__DECODER_DEPTH_MAX_INCL deep is
+  // valid. One more is not, whether they are definite or indefinite-length,
+  // tagged or not, or empty. An indefinite-length string is not a container.
+  const size_t max = WUFFS_CBOR__DECODER_DEPTH_MAX_INCL;
+  for (size_t depth : {max - 1, max, max + 1}) {
+    for (int variant = 0; variant < 5; variant++) {
+      std::string s;
+      for (size_t d = 0; d < depth; d++) {
+        s += (variant == 2) ? "\xC1" : "";
+        s += (variant & 1) ? "\x9F" : "\x81";
+      }
+      if (variant == 3) {
+        s += "\x7F\x61z\xFF";
+      } else if (variant == 4) {
+        s += "\x80";
+      } else {
+        s += std::string(1, 0);
+      }
+      for (size_t d = 0; d < depth; d++) {
+        s += (variant & 1) ? "\xFF" : "";
+      }
+      s += "\x01";
+      bool valid = false;
+      char name[64];
+      snprintf(name, sizeof name, "depth=%zu, variant=%d", depth, variant);
+      CHECK_STRING(check_sequence(&valid, name,
+                                  reinterpret_cast<const uint8_t*>(s.data()),
+                                  s.size()));
+      CHECK(valid == ((depth + ((variant == 4) ? 1 : 0)) <= max),
+            "%s: valid: have %d", name, valid);
+    }
+  }
+  return nullptr;
+}
+
+const char*  //
+test_wuffs_aux_cbor_sequence_examples() {
+  struct {
+    const char* src;
+    size_t len;
+    bool want_valid;
+  } cases[] = {
+      // Valid sequences.
+      {"", 0, true},
+      {"\x00\x01\x17\x18\x18\x19\x01\x00\x20\x3B\xFF\xFF\xFF\xFF\xFF"
+       "\xFF\xFF\xFF",
+       18, true},
+      {"\xF9\x3C\x00\xFA\x47\xC3\x50\x00\xFB\x3F\xF1\x99\x99\x99\x99"
+       "\x99\x9A",
+       17, true},
+      {"\xF4\xF5\xF6\xF7\xF0\xF8\xFF", 7, true},
+      {"\x80\xA0\x40\x60\x83\x01\x82\x02\x03\x81\x04", 11, true},
+      {"\xA2\x61\x61\x01\x61\x62\x82\x02\x03\x44\x01\x02\x03\x04", 14,
+       true},
+      {"\xC0\x74\x32\x30\x31\x33\x2D\x30\x33\x2D\x32\x31\x54\x32\x30"
+       "\x3A\x30\x34\x3A\x30\x30\x5A\xC1\xC1\x1A\x51\x4B\x67\xB0",
+       29, true},
+      {"\x9F\xFF\xBF\xFF\x5F\xFF\x7F\xFF", 8, true},
+      {"\x5F\x42\x01\x02\x43\x03\x04\x05\xFF\x7F\x65\x73\x74\x72\x65"
+       "\x61\x64\x6D\x69\x6E\x67\xFF",
+       22, true},
+      {"\x9F\x01\x82\x02\x03\x9F\x04\x05\xFF\xFF\xBF\x61\x61\x01\x61"
+       "\x62\x9F\x02\x03\xFF\xFF",
+       21, true},
+      // Empty chunks do not end an indefinite-length string.
+      {"\x5F\x40\xFF\x5F\x41\x61\x40\x42\x62\x63\xFF", 11, true},
+      {"\x7F\x60\x61\x61\x60\xFF\x82\x5F\x40\xFF\x7F\x60\xFF", 13, true},
+
+      // Invalid sequences: a top-level or misplaced break.
+      {"\x00\xFF", 2, false},
+      {"\x82\x00\xFF", 3, false},
+      {"\xA1\x00\xFF", 3, false},
+      // Indefinite-length string chunks of the wrong major type, or that are
+      // themselves indefinite-length.
+      {"\x5F\x61\x61\xFF", 4, false},
+      {"\x7F\x41\x61\xFF", 4, false},
+      {"\x5F\x00\xFF", 3, false},
+      {"\x5F\x5F\xFF\xFF", 4, false},
+      {"\x7F\x7F\xFF\xFF", 4, false},
+      {"\x5F\x40\x7F\x61\x61\xFF\xFF", 7, false},
+      {"\x7F\x60\x5F\xFF\xFF", 5, false},
+      // Reserved or indefinite-length headers for ints and tags.
+      {"\x1C", 1, false},
+      {"\x1F", 1, false},
+      {"\x3F", 1, false},
+      {"\xDF\x00", 2, false},
+      {"\xFC", 1, false},
+      // Truncated items.
+      {"\x18", 1, false},
+      {"\x19\x01", 2, false},
+      {"\x62\x61", 2, false},
+      {"\x82\x01", 2, false},
+      {"\xA1\x01", 2, false},
+      {"\x9F\x01", 2, false},
+      {"\xC1", 1, false},
+      {"\x00\xC1", 2, false},
+      {"\x5F\x41\x61", 3, false},
+      // Huge (but truncated) lengths.
+      {"\x5B\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF", 9, false},
+      {"\x9B\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\x00", 10, false},
+      {"\xBB\x80\x00\x00\x00\x00\x00\x00\x00\x00\x00", 11, false},
+      // Items that IndexCborSequence accepts but DecodeCbor does not.
+      {"\x00\x62\xC3\x28\x00", 5, false},
+      {"\xF8\x10", 2, false},
+  };
+
+  for (size_t c = 0; c < (sizeof cases / sizeof cases[0]); c++) {
+    bool valid = false;
+    CHECK_STRING(check_sequence(
+        &valid, "case " + std::to_string(c),
+        reinterpret_cast<const uint8_t*>(cases[c].src), cases[c].len));
+    CHECK(valid == cases[c].want_valid, "case %zu: valid: have %d", c, valid);
+  }
+  return nullptr;
+}
+
+const char*  //
+test_wuffs_aux_cbor_sequence_mutations() {
+  // The RFC 7049 examples file is one indefinite-length array. Its elements,
+  // followed by the json-things item, are a valid sequence. So are that
+  // sequence's prefixes that end on item boundaries. Other prefixes, and most
+  // mutations, are not.
+  std::vector<uint8_t> src;
+  CHECK_STRING(read_file(src, "test/data/cbor-rfc-7049-examples.cbor"));
+  CHECK((src.size() > 2) && (src.front() == 0x9F) && (src.back() == 0xFF),
+        "unexpected RFC 7049 examples");
+  src.pop_back();
+  src.erase(src.begin());
+  CHECK_STRING(read_file(src, "test/data/json-things.cbor"));
+  bool valid = false;
+  CHECK_STRING(check_sequence(&valid, "original", src.data(), src.size()));
+  CHECK(valid, "original: invalid");
+
+  std::vector<uint64_t> offsets;
+  CHECK(wuffs_aux::IndexCborSequence(offsets, src.data(), src.size()).empty(),
+        "IndexCborSequence failed");
+  CHECK(offsets.size() > 50, "num_items: have %zu", offsets.size());
+  size_t k = 0;
+  for (size_t n = 0; n < src.size(); n++) {
+    bool boundary = (k < offsets.size()) && (offsets[k] == n);
+    k += boundary ? 1 : 0;
+    CHECK_STRING(check_sequence(&valid, "prefix " + std::to_string(n),
+                                src.data(), n));
+    CHECK(valid == boundary, "prefix %zu: valid: have %d", n, valid);
+  }
+
+  size_t num_valid = 0;
+  size_t num_invalid = 0;
+  uint32_t x = 1;
+  for (int i = 0; i < 4000; i++) {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    std::vector<uint8_t> mutated(src);
+    mutated[x % mutated.size()] = static_cast<uint8_t>(x >> 24);
+    if ((i % 2) == 0) {
+      mutated[(x >> 8) % mutated.size()] = static_cast<uint8_t>(x >> 16);
+    }
+    CHECK_STRING(check_sequence(&valid, "mutation " + std::to_string(i),
+                                mutated.data(), mutated.size()));
+    (valid ? num_valid : num_invalid)++;
+  }
+  CHECK((num_valid > 100) && (num_invalid > 100),
+        "have %zu valid and %zu invalid mutations", num_valid, num_invalid);
+  return nullptr;
+}
+
+// ---------------- Manifest
+
+typedef const char* (*proc)();
+
+proc g_tests[] = {
+    test_wuffs_aux_cbor_sequence_depth,
+    test_wuffs_aux_cbor_sequence_examples,
+    test_wuffs_aux_cbor_sequence_mutations,
+    nullptr,
+};
+
+int  //
+main(int argc, char** argv) {
+  int num_tests = 0;
+  for (proc* p = g_tests; *p; p++) {
+    const char* z = (*p)();
+    if (z) {
+      printf("%-16s%-8sFAIL %s\n", "auxiliary/cbor", g_cc, z);
+      return 1;
+    }
+    num_tests++;
+  }
+  printf("%-16s%-8sPASS (%d tests)\n", "auxiliary/cbor", g_cc, num_tests);
+  return 0;
+}
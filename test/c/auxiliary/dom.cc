@@ -0,0 +1,291 @@
+// Copyright 2026 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ----------------
+
+/*
+This test program exercises the C++ (not C) wuffs_aux::Dom class and the
+wuffs_aux::DecodeJsonDom and wuffs_aux::DecodeCborDom functions. Unlike the
+test/c/std programs, it does not use test/c/testlib (which is C only).
+
+To manually run this test, from the repository's root directory:
+
+for CXX in clang++ g++; do
+  $CXX -std=c++11 -Wall -Werror -pthread test/c/auxiliary/dom.cc && ./a.out
+  rm -f a.out
+done
+
+Each edition should print "PASS", amongst other information, and exit(0).
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+// Wuffs ships as a "single file C library" or "header file library" as per
+// https://github.com/nothings/stb/blob/master/docs/stb_howto.txt
+//
+// To use that single file as a "foo.c"-like implementation, instead of a
+// "foo.h"-like header, #define WUFFS_IMPLEMENTATION before #include'ing or
+// compiling it.
+#define WUFFS_IMPLEMENTATION
+
+// Defining the WUFFS_CONFIG__MODULE* macros are optional, but it lets users of
+// release/c/etc.c choose which parts of Wuffs to build. That file contains the
+// entire Wuffs standard library, implementing a variety of codecs and file
+// formats. Without this macro definition, an optimizing compiler or linker may
+// very well discard Wuffs code for unused codecs, but listing the Wuffs
+// modules we use makes that process explicit. Preprocessing means that such
+// code simply isn't compiled.
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__AUX__BASE
+#define WUFFS_CONFIG__MODULE__AUX__CBOR
+#define WUFFS_CONFIG__MODULE__AUX__DOM
+#define WUFFS_CONFIG__MODULE__AUX__JSON
+#define WUFFS_CONFIG__MODULE__BASE
+#define WUFFS_CONFIG__MODULE__CBOR
+#define WUFFS_CONFIG__MODULE__JSON
+
+// If building this program in an environment that doesn't easily accommodate
+// relative includes, you can use the script/inline-c-relative-includes.go
+// program to generate a stand-alone C file.
+#include "../../../release/c/wuffs-unsupported-snapshot.c"
+
+// The order matters here. Clang also defines "__GNUC__".
+#if defined(__clang__)
+const char* g_cc = "clang";
+#elif defined(__GNUC__)
+const char* g_cc = "gcc";
+#elif defined(_MSC_VER)
+const char* g_cc = "cl";
+#else
+const char* g_cc = "cc";
+#endif
+
+// g_fail_message holds the most recent test failure's message.
+std::string g_fail_message;
+
+#define CHECK(cond, ...)                                                      \
+  do {                                                                        \
+    if (!(cond)) {                                                            \
+      char fail_buf[1024];                                                    \
+      snprintf(fail_buf, sizeof fail_buf, "%s: ", __func__);                  \
+      size_t fail_n = strlen(fail_buf);                                       \
+      snprintf(fail_buf + fail_n, sizeof fail_buf - fail_n, __VA_ARGS__);     \
+      g_fail_message = fail_buf;                                              \
+      return g_fail_message.c_str();                                          \
+    }                                                                         \
+  } while (false)
+
+#define CHECK_STRING(string)       \
+  do {                             \
+    const char* z = (string);      \
+    if (z) {                       \
+      return z;                    \
+    }                              \
+  } while (false)
+
+// ---------------- Helpers
+
+// slow_next is like Dom::next but it does not use a container's subtree length
+// (its m_value), only the number of children (its m_count).
+size_t  //
+slow_next(const wuffs_aux::Dom& dom, size_t i) {
+  while ((i < dom.m_nodes.size()) &&
+         (dom.m_nodes[i].m_kind == wuffs_aux::DomNode::CborTag)) {
+    i++;
+  }
+  if (i >= dom.m_nodes.size()) {
+    return dom.m_nodes.size();
+  }
+  size_t j = i + 1;
+  if (dom.m_nodes[i].is_container()) {
+    for (uint32_t n = dom.m_nodes[i].m_count; n > 0; n--) {
+      j = slow_next(dom, j);
+    }
+  }
+  return j;
+}
+
+// check_navigation checks Dom::next and Dom::child, for every node, against
+// slow_next.
+const char*  //
+check_navigation(const wuffs_aux::Dom& dom) {
+  CHECK(dom.next(0) == dom.m_nodes.size(), "next(0): have %zu, want %zu",
+        dom.next(0), dom.m_nodes.size());
+  for (size_t i = 0; i < dom.m_nodes.size(); i++) {
+    CHECK(dom.next(i) == slow_next(dom, i), "i=%zu: next: have %zu, want %zu",
+          i, dom.next(i), slow_next(dom, i));
+    const wuffs_aux::DomNode& node = dom.m_nodes[i];
+    uint32_t num_children = node.is_container() ? node.m_count : 0;
+    size_t j = i + 1;
+    for (uint32_t n = 0; n < num_children; n++) {
+      CHECK(dom.child(i, n) == j, "i=%zu, n=%u: child: have %zu, want %zu", i,
+            n, dom.child(i, n), j);
+      j = slow_next(dom, j);
+    }
+    CHECK(!node.is_container() || (j == dom.next(i)),
+          "i=%zu: children do not end at next(i)", i);
+    CHECK(dom.child(i, num_children) == wuffs_aux::Dom::npos,
+          "i=%zu: child(i, %u) is not npos", i, num_children);
+  }
+  return nullptr;
+}
+
+// ---------------- Tests
+
+const char*  //
+test_wuffs_aux_dom_decode_cbor_dom() {
+  // The CBOR is [1(100), 2([3, 4]), 5, {"k": 6(7)}]. Each CborTag node and
+  // its tagged node are one child. CBOR's unsigned integers are U64 nodes.
+  static const uint8_t src[] = {
+      0x84, 0xC1, 0x18, 0x64, 0xC2, 0x82, 0x03, 0x04,
+      0x05, 0xA1, 0x61, 0x6B, 0xC6, 0x07,
+  };
+  wuffs_aux::Dom dom;
+  wuffs_aux::sync_io::MemoryInput input(src, sizeof src);
+  wuffs_aux::DecodeCborResult result = wuffs_aux::DecodeCborDom(dom, input);
+  CHECK(result.error_message.empty(), "%s", result.error_message.c_str());
+  CHECK_STRING(check_navigation(dom));
+  CHECK(dom.m_nodes.size() == 12, "m_nodes.size(): have %zu, want 12",
+        dom.m_nodes.size());
+  CHECK(dom.m_nodes[0].m_count == 4, "m_count: have %u, want 4",
+        dom.m_nodes[0].m_count);
+
+  static const struct {
+    uint32_t n;
+    size_t want_index;
+    uint32_t want_kind;
+  } children[] = {
+      {0, 1, wuffs_aux::DomNode::CborTag},
+      {1, 3, wuffs_aux::DomNode::CborTag},
+      {2, 7, wuffs_aux::DomNode::U64},
+      {3, 8, wuffs_aux::DomNode::Dict},
+  };
+  for (const auto& c : children) {
+    size_t i = dom.child(0, c.n);
+    CHECK((i == c.want_index) && (dom.m_nodes[i].m_kind == c.want_kind),
+          "n=%u: have index %zu, kind %u", c.n, i, dom.m_nodes[i].m_kind);
+  }
+  CHECK(dom.next(1) == 3, "next(1): have %zu, want 3", dom.next(1));
+  CHECK(dom.next(3) == 7, "next(3): have %zu, want 7", dom.next(3));
+  size_t v = dom.find(8, "k", 1);
+  CHECK((v == 10) && (dom.m_nodes[v].m_kind == wuffs_aux::DomNode::CborTag) &&
+            (dom.m_nodes[v].m_value == 6) &&
+            (dom.m_nodes[v + 1].m_value == 7),
+        "find(8, k): have %zu", v);
+  return nullptr;
+}
+
+const char*  //
+test_wuffs_aux_dom_decode_json_dom() {
+  // find looks at the root dict's keys, not its values (such as "c", the
+  // value for "b") or its descendents' keys (such as "x"). The second "a" key
+  // is a duplicate.
+  static const char src[] =
+      "{\"a\": [1, [2, [], 3], {\"x\": null}], \"b\": \"c\", \"a\": 9,"
+      " \"c\": {\"d\": {\"e\": true}}, \"\": [], \"f\": 1.5}";
+  wuffs_aux::Dom dom;
+  wuffs_aux::sync_io::MemoryInput input(src, strlen(src));
+  wuffs_aux::DecodeJsonResult result = wuffs_aux::DecodeJsonDom(dom, input);
+  CHECK(result.error_message.empty(), "%s", result.error_message.c_str());
+  CHECK_STRING(check_navigation(dom));
+  CHECK(dom.m_nodes[0].m_kind == wuffs_aux::DomNode::Dict,
+        "root: not a Dict");
+  CHECK(dom.m_nodes[0].m_count == 12, "root: m_count: have %u, want 12",
+        dom.m_nodes[0].m_count);
+
+  size_t a = dom.find(0, "a", 1);
+  CHECK((a != wuffs_aux::Dom::npos) &&
+            (dom.m_nodes[a].m_kind == wuffs_aux::DomNode::List) &&
+            (dom.m_nodes[a].m_count == 3),
+        "find(a): have %zu", a);
+  size_t a1 = dom.child(a, 1);
+  size_t a2 = dom.child(a, 2);
+  CHECK(dom.next(a1) == a2, "next(a1): have %zu, want %zu", dom.next(a1), a2);
+  CHECK((dom.m_nodes[dom.child(a, 0)].as_i64() == 1) &&
+            (dom.m_nodes[a2].m_kind == wuffs_aux::DomNode::Dict) &&
+            (dom.m_nodes[dom.child(a1, 2)].as_i64() == 3),
+        "a's children mismatch");
+  CHECK(dom.child(dom.child(a1, 1), 0) == wuffs_aux::Dom::npos,
+        "child of an empty list is not npos");
+
+  size_t b = dom.find(0, "b", 1);
+  CHECK((b != wuffs_aux::Dom::npos) &&
+            (dom.m_nodes[b].m_kind == wuffs_aux::DomNode::TextString) &&
+            (std::string(dom.string_ptr(b), dom.string_len(b)) == "c"),
+        "find(b): have %zu", b);
+  size_t c = dom.find(0, "c", 1);
+  CHECK((c != wuffs_aux::Dom::npos) && (c != b) &&
+            (dom.m_nodes[c].m_kind == wuffs_aux::DomNode::Dict),
+        "find(c): have %zu", c);
+  size_t e = dom.find(dom.find(c, "d", 1), "e", 1);
+  CHECK((e != wuffs_aux::Dom::npos) &&
+            (dom.m_nodes[e].m_kind == wuffs_aux::DomNode::Bool) &&
+            (dom.m_nodes[e].m_value == 1),
+        "find(c/d/e): have %zu", e);
+  size_t empty = dom.find(0, "", 0);
+  CHECK((empty != wuffs_aux::Dom::npos) &&
+            (dom.m_nodes[empty].m_kind == wuffs_aux::DomNode::List) &&
+            (dom.m_nodes[empty].m_count == 0),
+        "find(\"\"): have %zu", empty);
+  size_t f = dom.find(0, "f", 1);
+  CHECK((f != wuffs_aux::Dom::npos) && (dom.m_nodes[f].as_f64() == 1.5),
+        "find(f): have %zu", f);
+
+  CHECK(dom.find(0, "x", 1) == wuffs_aux::Dom::npos, "find(x) is not npos");
+  CHECK(dom.find(0, "aa", 2) == wuffs_aux::Dom::npos, "find(aa) is not npos");
+  CHECK(dom.find(a, "x", 1) == wuffs_aux::Dom::npos,
+        "find on a List is not npos");
+  CHECK(dom.find(dom.m_nodes.size(), "a", 1) == wuffs_aux::Dom::npos,
+        "find out of bounds is not npos");
+
+  // A re-used Dom gives the same nodes.
+  std::vector<wuffs_aux::DomNode> nodes = dom.m_nodes;
+  wuffs_aux::sync_io::MemoryInput input2(src, strlen(src));
+  result = wuffs_aux::DecodeJsonDom(dom, input2);
+  CHECK(result.error_message.empty(), "%s", result.error_message.c_str());
+  CHECK((nodes.size() == dom.m_nodes.size()) &&
+            (memcmp(nodes.data(), dom.m_nodes.data(),
+                    nodes.size() * sizeof(nodes[0])) == 0),
+        "re-used Dom differs");
+  return nullptr;
+}
+
+// ---------------- Manifest
+
+typedef const char* (*proc)();
+
+proc g_tests[] = {
+    test_wuffs_aux_dom_decode_cbor_dom,
+    test_wuffs_aux_dom_decode_json_dom,
+    nullptr,
+};
+
+int  //
+main(int argc, char** argv) {
+  int num_tests = 0;
+  for (proc* p = g_tests; *p; p++) {
+    const char* z = (*p)();
+    if (z) {
+      printf("%-16s%-8sFAIL %s\n", "auxiliary/dom", g_cc, z);
+      return 1;
+    }
+    num_tests++;
+  }
+  printf("%-16s%-8sPASS (%d tests)\n", "auxiliary/dom", g_cc, num_tests);
+  return 0;
+}
@@ -0,0 +1,497 @@
+// Copyright 2026 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ----------------
+
+/*
+This test program exercises the C++ (not C) wuffs_aux::JsonEncoder and
+wuffs_aux::CborEncoder classes, checking that what they encode decodes (via
+wuffs_aux::DecodeJson and wuffs_aux::DecodeCbor) to what went in. Unlike the
+test/c/std programs, it does not use test/c/testlib (which is C only).
+
+To manually run this test, from the repository's root directory:
+
+for CXX in clang++ g++; do
+  $CXX -std=c++11 -Wall -Werror -pthread test/c/auxiliary/encode.cc && ./a.out
+  rm -f a.out
+done
+
+Each edition should print "PASS", amongst other information, and exit(0).
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+// Wuffs ships as a "single file C library" or "header file library" as per
+// https://github.com/nothings/stb/blob/master/docs/stb_howto.txt
+//
+// To use that single file as a "foo.c"-like implementation, instead of a
+// "foo.h"-like header, #define WUFFS_IMPLEMENTATION before #include'ing or
+// compiling it.
+#define WUFFS_IMPLEMENTATION
+
+// Defining the WUFFS_CONFIG__MODULE* macros are optional, but it lets users of
+// release/c/etc.c choose which parts of Wuffs to build. That file contains the
+// entire Wuffs standard library, implementing a variety of codecs and file
+// formats. Without this macro definition, an optimizing compiler or linker may
+// very well discard Wuffs code for unused codecs, but listing the Wuffs
+// modules we use makes that process explicit. Preprocessing means that such
+// code simply isn't compiled.
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__AUX__BASE
+#define WUFFS_CONFIG__MODULE__AUX__CBOR
+#define WUFFS_CONFIG__MODULE__AUX__ENCODE
+#define WUFFS_CONFIG__MODULE__AUX__JSON
+#define WUFFS_CONFIG__MODULE__BASE
+#define WUFFS_CONFIG__MODULE__CBOR
+#define WUFFS_CONFIG__MODULE__JSON
+
+// If building this program in an environment that doesn't easily accommodate
+// relative includes, you can use the script/inline-c-relative-includes.go
+// program to generate a stand-alone C file.
+#include "../../../release/c/wuffs-unsupported-snapshot.c"
+
+// The order matters here. Clang also defines "__GNUC__".
+#if defined(__clang__)
+const char* g_cc = "clang";
+#elif defined(__GNUC__)
+const char* g_cc = "gcc";
+#elif defined(_MSC_VER)
+const char* g_cc = "cl";
+#else
+const char* g_cc = "cc";
+#endif
+
+// g_fail_message holds the most recent test failure's message.
+std::string g_fail_message;
+
+#define CHECK(cond, ...)                                                      \
+  do {                                                                        \
+    if (!(cond)) {                                                            \
+      char fail_buf[1024];                                                    \
+      snprintf(fail_buf, sizeof fail_buf, "%s: ", __func__);                  \
+      size_t fail_n = strlen(fail_buf);                                       \
+      snprintf(fail_buf + fail_n, sizeof fail_buf - fail_n, __VA_ARGS__);     \
+      g_fail_message = fail_buf;                                              \
+      return g_fail_message.c_str();                                          \
+    }                                                                         \
+  } while (false)
+
+#define CHECK_STRING(string)       \
+  do {                             \
+    const char* z = (string);      \
+    if (z) {                       \
+      return z;                    \
+    }                              \
+  } while (false)
+
+// ---------------- Helpers
+
+// StringOutput is a sync_io::Output that appends to a std::string. Unlike a
+// sync_io::MemoryOutput, it does not bring its own IOBuffer, so the encoders
+// stage their output in their own (4 KiB) buffers.
+class StringOutput : public wuffs_aux::sync_io::Output {
+ public:
+  std::string m_s;
+
+  std::string CopyOut(wuffs_aux::IOBuffer* src) override {
+    m_s.append(reinterpret_cast<const char*>(src->reader_pointer()),
+               src->reader_length());
+    src->meta.ri = src->meta.wi;
+    src->compact();
+    return "";
+  }
+};
+
+// Recorder is a DecodeJsonCallbacks and a DecodeCborCallbacks that records
+// the values it sees as a compact string, such as [1,t,"x",{"k",n}] (with a
+// comma, not a colon, after dict keys and with t, f and n for true, false and
+// null). Strings are recorded unescaped.
+class Recorder : public wuffs_aux::DecodeJsonCallbacks,
+                 public wuffs_aux::DecodeCborCallbacks {
+ public:
+  std::string m_s;
+
+  std::string AppendNull() override { return append("n"); }
+  std::string AppendUndefined() override { return append("undefined"); }
+  std::string AppendBool(bool val) override { return append(val ? "t" : "f"); }
+
+  std::string AppendF64(double val) override {
+    char buf[64];
+    snprintf(buf, sizeof buf, "%.17g", val);
+    return append(buf);
+  }
+
+  std::string AppendI64(int64_t val) override {
+    return append(std::to_string(val));
+  }
+
+  std::string AppendU64(uint64_t val) override {
+    return append(std::to_string(val));
+  }
+
+  std::string AppendByteString(std::string&& val) override {
+    return append("b\"" + val + "\"");
+  }
+
+  std::string AppendTextString(std::string&& val) override {
+    return append("\"" + val + "\"");
+  }
+
+  std::string AppendMinus1MinusX(uint64_t val) override {
+    return append("-1-" + std::to_string(val));
+  }
+
+  std::string AppendCborSimpleValue(uint8_t val) override {
+    return append("simple" + std::to_string(val));
+  }
+
+  std::string AppendCborTag(uint64_t val) override {
+    return append("tag" + std::to_string(val));
+  }
+
+  std::string Push(uint32_t flags) override {
+    std::string z = append(
+        (flags & WUFFS_BASE__TOKEN__VBD__STRUCTURE__TO_DICT) ? "{" : "[");
+    m_need_comma = false;
+    return z;
+  }
+
+  std::string Pop(uint32_t flags) override {
+    m_s += (flags & WUFFS_BASE__TOKEN__VBD__STRUCTURE__FROM_DICT) ? "}" : "]";
+    m_need_comma = true;
+    return "";
+  }
+
+ private:
+  bool m_need_comma = false;
+
+  std::string append(const std::string& s) {
+    if (m_need_comma) {
+      m_s += ",";
+    }
+    m_s += s;
+    m_need_comma = true;
+    return "";
+  }
+};
+
+// escape_json returns s as a JSON string (including the quotes), escaping
+// the bytes that JsonEncoder escapes in the way that it does, one byte at a
+// time. It is a reference implementation for the encoder's SIMD scanner.
+std::string  //
+escape_json(const std::string& s) {
+  std::string ret = "\"";
+  for (char c : s) {
+    uint8_t u = static_cast<uint8_t>(c);
+    switch (u) {
+      case '"':
+        ret += "\\\"";
+        break;
+      case '\\':
+        ret += "\\\\";
+        break;
+      case '\b':
+        ret += "\\b";
+        break;
+      case '\t':
+        ret += "\\t";
+        break;
+      case '\n':
+        ret += "\\n";
+        break;
+      case '\f':
+        ret += "\\f";
+        break;
+      case '\r':
+        ret += "\\r";
+        break;
+      default:
+        if (u < 0x20) {
+          char buf[8];
+          snprintf(buf, sizeof buf, "\\u%04X", u);
+          ret += buf;
+        } else {
+          ret += c;
+        }
+    }
+  }
+  return ret + "\"";
+}
+
+// write_values encodes some values with a JsonEncoder or a CborEncoder. As for
+// DecodeJsonCallbacks, the Push and Pop flags' TO_ETC and FROM_ETC bits give
+// the enclosing container (if any) as well as the pushed or popped one.
+template <typename Encoder>
+const char*  //
+write_values(Encoder& enc) {
+  static const uint32_t list = WUFFS_BASE__TOKEN__VBD__STRUCTURE__TO_LIST;
+  static const uint32_t dict = WUFFS_BASE__TOKEN__VBD__STRUCTURE__TO_DICT;
+  static const uint32_t none = WUFFS_BASE__TOKEN__VBD__STRUCTURE__TO_NONE;
+  static const uint32_t from_list =
+      WUFFS_BASE__TOKEN__VBD__STRUCTURE__FROM_LIST;
+  static const uint32_t from_dict =
+      WUFFS_BASE__TOKEN__VBD__STRUCTURE__FROM_DICT;
+  static const uint32_t from_none =
+      WUFFS_BASE__TOKEN__VBD__STRUCTURE__FROM_NONE;
+  std::string long_string(5000, 'L');
+  long_string[4321] = '"';
+
+  std::string z;
+  CHECK((z = enc.Push(from_none | list)).empty(), "%s", z.c_str());
+  CHECK((z = enc.AppendNull()).empty(), "%s", z.c_str());
+  CHECK((z = enc.AppendBool(true)).empty(), "%s", z.c_str());
+  CHECK((z = enc.AppendBool(false)).empty(), "%s", z.c_str());
+  CHECK((z = enc.AppendI64(0)).empty(), "%s", z.c_str());
+  CHECK((z = enc.AppendI64(-23)).empty(), "%s", z.c_str());
+  CHECK((z = enc.AppendI64(INT64_MIN)).empty(), "%s", z.c_str());
+  CHECK((z = enc.AppendU64(UINT64_MAX)).empty(), "%s", z.c_str());
+  CHECK((z = enc.AppendF64(1.5)).empty(), "%s", z.c_str());
+  CHECK((z = enc.AppendF64(0.1)).empty(), "%s", z.c_str());
+  CHECK((z = enc.AppendF64(-65504.0)).empty(), "%s", z.c_str());
+  CHECK((z = enc.AppendF64(1e300)).empty(), "%s", z.c_str());
+  CHECK((z = enc.Push(from_list | dict)).empty(), "%s", z.c_str());
+  CHECK((z = enc.AppendTextString("k", 1)).empty(), "%s", z.c_str());
+  CHECK((z = enc.Push(from_dict | list)).empty(), "%s", z.c_str());
+  CHECK((z = enc.Pop(from_list | dict)).empty(), "%s", z.c_str());
+  CHECK((z = enc.AppendTextString("", 0)).empty(), "%s", z.c_str());
+  CHECK((z = enc.AppendTextString("caf\xC3\xA9\x7F", 6)).empty(), "%s",
+        z.c_str());
+  CHECK((z = enc.Pop(from_dict | list)).empty(), "%s", z.c_str());
+  CHECK((z = enc.AppendTextString(long_string.data(), long_string.size()))
+            .empty(),
+        "%s", z.c_str());
+  CHECK((z = enc.Pop(from_list | none)).empty(), "%s", z.c_str());
+  CHECK((z = enc.Flush()).empty(), "%s", z.c_str());
+  return nullptr;
+}
+
+// want_values is what write_values' values decode to. DecodeJson (but not
+// DecodeCbor) passes integers outside of the int64_t range as float64.
+std::string  //
+want_values(bool json) {
+  std::string long_string(5000, 'L');
+  long_string[4321] = '"';
+  return std::string("[n,t,f,0,-23,-9223372036854775808,") +
+         (json ? "1.8446744073709552e+19" : "18446744073709551615") +
+         ",1.5,0.10000000000000001,-65504,1.0000000000000001e+300,"
+         "{\"k\",[],\"\",\"caf\xC3\xA9\x7F\"},\"" +
+         long_string + "\"]";
+}
+
+// ---------------- Tests
+
+const char*  //
+test_wuffs_aux_encode_cbor_round_trip() {
+  for (int own_buffer = 0; own_buffer < 2; own_buffer++) {
+    std::vector<uint8_t> mem(65536);
+    wuffs_aux::sync_io::MemoryOutput memory_output(mem.data(), mem.size());
+    StringOutput string_output;
+    wuffs_aux::CborEncoder enc(
+        own_buffer ? static_cast<wuffs_aux::sync_io::Output&>(memory_output)
+                   : static_cast<wuffs_aux::sync_io::Output&>(string_output));
+    const char* z = write_values(enc);
+    CHECK(!z, "own_buffer=%d: %s", own_buffer, z);
+    std::string cbor =
+        own_buffer ? std::string(reinterpret_cast<const char*>(mem.data()),
+                                 static_cast<size_t>(enc.num_bytes_written()))
+                   : string_output.m_s;
+    CHECK(cbor.size() == enc.num_bytes_written(),
+          "own_buffer=%d: num_bytes_written: have %zu, want %zu", own_buffer,
+          static_cast<size_t>(enc.num_bytes_written()), cbor.size());
+
+    Recorder callbacks;
+    wuffs_aux::sync_io::MemoryInput input(cbor.data(), cbor.size());
+    wuffs_aux::DecodeCborResult result =
+        wuffs_aux::DecodeCbor(callbacks, input);
+    CHECK(result.error_message.empty(), "own_buffer=%d: DecodeCbor: %s",
+          own_buffer, result.error_message.c_str());
+    CHECK(callbacks.m_s == want_values(false), "own_buffer=%d: have %s",
+          own_buffer, callbacks.m_s.c_str());
+  }
+  return nullptr;
+}
+
+const char*  //
+test_wuffs_aux_encode_json_escapes() {
+  // Put each escaped byte (and some that aren't escaped) at every position
+  // of strings up to 48 bytes long, with the string starting at every offset
+  // (mod 16) in the output buffer. This exercises the 16 and 8 byte (SIMD and
+  // SWAR) scanners' chunks and tails, including escapes that straddle them.
+  static const uint8_t specials[] = {
+      '"', '\\', 0x00, 0x01, '\b', '\t', '\n', '\r', 0x1F,
+      ' ', 0x7F, 0x80, 0xFF, '!',  '#',  '[',  ']',  '~',
+  };
+  for (size_t offset = 0; offset < 16; offset++) {
+    for (size_t len = 1; len <= 48; len++) {
+      for (size_t pos = 0; pos < len; pos++) {
+        for (uint8_t special : specials) {
+          std::string s(len, 'a');
+          s[pos] = static_cast<char>(special);
+          s[len - 1] = ((len - 1) == pos) ? s[len - 1] : '\n';
+          std::string prefix(offset, 'p');
+
+          StringOutput output;
+          wuffs_aux::JsonEncoder enc(output);
+          std::string z;
+          if (!(z = enc.Push(WUFFS_BASE__TOKEN__VBD__STRUCTURE__FROM_NONE |
+                             WUFFS_BASE__TOKEN__VBD__STRUCTURE__TO_LIST))
+                   .empty() ||
+              !(z = enc.AppendTextString(prefix.data(), prefix.size()))
+                   .empty() ||
+              !(z = enc.AppendTextString(s.data(), s.size())).empty() ||
+              !(z = enc.Pop(WUFFS_BASE__TOKEN__VBD__STRUCTURE__FROM_LIST |
+                            WUFFS_BASE__TOKEN__VBD__STRUCTURE__TO_NONE))
+                   .empty() ||
+              !(z = enc.Flush()).empty()) {
+            CHECK(false, "offset=%zu, len=%zu, pos=%zu: %s", offset, len, pos,
+                  z.c_str());
+          }
+          std::string want =
+              "[" + escape_json(prefix) + "," + escape_json(s) + "]";
+          CHECK(output.m_s == want,
+                "offset=%zu, len=%zu, pos=%zu, special=0x%02X: have %s", offset,
+                len, pos, special, output.m_s.c_str());
+
+          // 0x80 and 0xFF are not valid UTF-8, so DecodeJson replaces them.
+          if (special >= 0x80) {
+            continue;
+          }
+          Recorder callbacks;
+          wuffs_aux::sync_io::MemoryInput input(output.m_s.data(),
+                                                output.m_s.size());
+          wuffs_aux::DecodeJsonResult result =
+              wuffs_aux::DecodeJson(callbacks, input);
+          CHECK(result.error_message.empty() &&
+                    (callbacks.m_s == ("[\"" + prefix + "\",\"" + s + "\"]")),
+                "offset=%zu, len=%zu, pos=%zu, special=0x%02X: round trip",
+                offset, len, pos, special);
+        }
+      }
+    }
+  }
+  return nullptr;
+}
+
+const char*  //
+test_wuffs_aux_encode_json_round_trip() {
+  static const uint32_t flags_list[] = {
+      0,
+      wuffs_aux::JsonEncoder::FLAG_INDENT,
+      wuffs_aux::JsonEncoder::FLAG_INDENT | wuffs_aux::JsonEncoder::FLAG_TABS,
+  };
+  for (int own_buffer = 0; own_buffer < 2; own_buffer++) {
+    for (uint32_t flags : flags_list) {
+      std::vector<uint8_t> mem(65536);
+      wuffs_aux::sync_io::MemoryOutput memory_output(mem.data(), mem.size());
+      StringOutput string_output;
+      wuffs_aux::JsonEncoder enc(
+          own_buffer
+              ? static_cast<wuffs_aux::sync_io::Output&>(memory_output)
+              : static_cast<wuffs_aux::sync_io::Output&>(string_output),
+          flags);
+      const char* z = write_values(enc);
+      CHECK(!z, "own_buffer=%d, flags=0x%X: %s", own_buffer, flags, z);
+      std::string json =
+          own_buffer
+              ? std::string(reinterpret_cast<const char*>(mem.data()),
+                            static_cast<size_t>(enc.num_bytes_written()))
+              : string_output.m_s;
+      CHECK(json.size() == enc.num_bytes_written(),
+            "own_buffer=%d, flags=0x%X: num_bytes_written mismatch",
+            own_buffer, flags);
+
+      Recorder callbacks;
+      wuffs_aux::sync_io::MemoryInput input(json.data(), json.size());
+      wuffs_aux::DecodeJsonResult result =
+          wuffs_aux::DecodeJson(callbacks, input);
+      CHECK(result.error_message.empty(), "own_buffer=%d, flags=0x%X: %s",
+            own_buffer, flags, result.error_message.c_str());
+      CHECK(callbacks.m_s == want_values(true),
+            "own_buffer=%d, flags=0x%X: have %s", own_buffer, flags,
+            callbacks.m_s.c_str());
+    }
+  }
+  return nullptr;
+}
+
+const char*  //
+test_wuffs_aux_encode_transcode() {
+  // JSON to CBOR to JSON gives the same as JSON to JSON.
+  static const char src[] =
+      "{\"a\": [1, -2, 3.25, true, null, \"\\u00e9\\n\"], \"b\": {}, "
+      "\"c\": \"0123456789abcdef0123456789ABCDEF\\\"\"}";
+  StringOutput cbor_output;
+  wuffs_aux::CborEncoder cbor_enc(cbor_output);
+  wuffs_aux::sync_io::MemoryInput src_input(src, strlen(src));
+  wuffs_aux::DecodeJsonResult json_result =
+      wuffs_aux::TranscodeJsonToCbor(cbor_enc, src_input);
+  CHECK(json_result.error_message.empty(), "TranscodeJsonToCbor: %s",
+        json_result.error_message.c_str());
+
+  StringOutput have_output;
+  wuffs_aux::JsonEncoder have_enc(have_output);
+  wuffs_aux::sync_io::MemoryInput cbor_input(cbor_output.m_s.data(),
+                                             cbor_output.m_s.size());
+  wuffs_aux::DecodeCborResult cbor_result =
+      wuffs_aux::TranscodeCborToJson(have_enc, cbor_input);
+  CHECK(cbor_result.error_message.empty(), "TranscodeCborToJson: %s",
+        cbor_result.error_message.c_str());
+
+  StringOutput want_output;
+  wuffs_aux::JsonEncoder want_enc(want_output);
+  wuffs_aux::sync_io::MemoryInput src_input2(src, strlen(src));
+  json_result = wuffs_aux::TranscodeJsonToJson(want_enc, src_input2);
+  CHECK(json_result.error_message.empty(), "TranscodeJsonToJson: %s",
+        json_result.error_message.c_str());
+
+  static const char want[] =
+      "{\"a\":[1,-2,3.25,true,null,\"\xC3\xA9\\n\"],\"b\":{},"
+      "\"c\":\"0123456789abcdef0123456789ABCDEF\\\"\"}";
+  CHECK(want_output.m_s == want, "JSON to JSON: have %s, want %s",
+        want_output.m_s.c_str(), want);
+  CHECK(have_output.m_s == want, "JSON to CBOR to JSON: have %s, want %s",
+        have_output.m_s.c_str(), want);
+  return nullptr;
+}
+
+// ---------------- Manifest
+
+typedef const char* (*proc)();
+
+proc g_tests[] = {
+    test_wuffs_aux_encode_cbor_round_trip,
+    test_wuffs_aux_encode_json_escapes,
+    test_wuffs_aux_encode_json_round_trip,
+    test_wuffs_aux_encode_transcode,
+    nullptr,
+};
+
+int  //
+main(int argc, char** argv) {
+  int num_tests = 0;
+  for (proc* p = g_tests; *p; p++) {
+    const char* z = (*p)();
+    if (z) {
+      printf("%-20s%-8sFAIL %s\n", "auxiliary/encode", g_cc, z);
+      return 1;
+    }
+    num_tests++;
+  }
+  printf("%-20s%-8sPASS (%d tests)\n", "auxiliary/encode", g_cc, num_tests);
+  return 0;
+}
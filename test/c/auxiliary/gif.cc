@@ -0,0 +1,603 @@
+// Copyright 2022 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ----------------
+
+/*
+This test program exercises the C++ (not C) wuffs_aux::ParallelDecodeGif
+function and wuffs_aux::GifEncoder class. Unlike the test/c/std programs, it
+does not use test/c/testlib (which is C only).
+
+To manually run this test, from the repository's root directory:
+
+for CXX in clang++ g++; do
+  $CXX -std=c++11 -Wall -Werror -pthread test/c/auxiliary/gif.cc && ./a.out
+  rm -f a.out
+done
+
+Each edition should print "PASS", amongst other information, and exit(0).
+*/
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+// Wuffs ships as a "single file C library" or "header file library" as per
+// https://github.com/nothings/stb/blob/master/docs/stb_howto.txt
+//
+// To use that single file as a "foo.c"-like implementation, instead of a
+// "foo.h"-like header, #define WUFFS_IMPLEMENTATION before #include'ing or
+// compiling it.
+#define WUFFS_IMPLEMENTATION
+
+// Defining the WUFFS_CONFIG__MODULE* macros are optional, but it lets users of
+// release/c/etc.c choose which parts of Wuffs to build. That file contains the
+// entire Wuffs standard library, implementing a variety of codecs and file
+// formats. Without this macro definition, an optimizing compiler or linker may
+// very well discard Wuffs code for unused codecs, but listing the Wuffs
+// modules we use makes that process explicit. Preprocessing means that such
+// code simply isn't compiled.
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__AUX__BASE
+#define WUFFS_CONFIG__MODULE__AUX__GIF
+#define WUFFS_CONFIG__MODULE__BASE
+#define WUFFS_CONFIG__MODULE__GIF
+#define WUFFS_CONFIG__MODULE__LZW
+
+// If building this program in an environment that doesn't easily accommodate
+// relative includes, you can use the script/inline-c-relative-includes.go
+// program to generate a stand-alone C file.
+#include "../../../release/c/wuffs-unsupported-snapshot.c"
+
+// The order matters here. Clang also defines "__GNUC__".
+#if defined(__clang__)
+const char* g_cc = "clang";
+#elif defined(__GNUC__)
+const char* g_cc = "gcc";
+#elif defined(_MSC_VER)
+const char* g_cc = "cl";
+#else
+const char* g_cc = "cc";
+#endif
+
+// g_fail_message holds the most recent test failure's message.
+std::string g_fail_message;
+
+#define CHECK(cond, ...)                                                      \
+  do {                                                                        \
+    if (!(cond)) {                                                            \
+      char fail_buf[1024];                                                    \
+      snprintf(fail_buf, sizeof fail_buf, "%s: ", __func__);                  \
+      size_t fail_n = strlen(fail_buf);                                       \
+      snprintf(fail_buf + fail_n, sizeof fail_buf - fail_n, __VA_ARGS__);     \
+      g_fail_message = fail_buf;                                              \
+      return g_fail_message.c_str();                                          \
+    }                                                                         \
+  } while (false)
+
+#define CHECK_STRING(string)       \
+  do {                             \
+    const char* z = (string);      \
+    if (z) {                       \
+      return z;                    \
+    }                              \
+  } while (false)
+
+// ---------------- Helpers
+
+const char*  //
+read_file(std::vector<uint8_t>& dst, const char* path) {
+  FILE* f = fopen(path, "rb");
+  if (!f) {
+    g_fail_message = std::string("read_file: could not open ") + path;
+    return g_fail_message.c_str();
+  }
+  uint8_t buf[4096];
+  while (true) {
+    size_t n = fread(buf, 1, sizeof buf, f);
+    dst.insert(dst.end(), buf, buf + n);
+    if (n < sizeof buf) {
+      break;
+    }
+  }
+  bool ok = !ferror(f);
+  fclose(f);
+  if (!ok) {
+    g_fail_message = std::string("read_file: could not read ") + path;
+    return g_fail_message.c_str();
+  }
+  return nullptr;
+}
+
+// g_gif_filenames are the test/data GIF files, including some that are
+// invalid.
+const char* g_gif_filenames[] = {
+    "test/data/animated-red-blue.gif",
+    "test/data/artificial-gif/background-color.gif",
+    "test/data/artificial-gif/empty-palette.gif",
+    "test/data/artificial-gif/frame-out-of-bounds.gif",
+    "test/data/artificial-gif/metadata-empty.gif",
+    "test/data/artificial-gif/metadata-full.gif",
+    "test/data/artificial-gif/multiple-graphic-controls.gif",
+    "test/data/artificial-gif/multiple-loop-counts.gif",
+    "test/data/artificial-gif/no-frames.gif",
+    "test/data/artificial-gif/pixel-data-none.gif",
+    "test/data/artificial-gif/pixel-data-not-enough.gif",
+    "test/data/artificial-gif/pixel-data-too-much-bad-lzw.gif",
+    "test/data/artificial-gif/pixel-data-too-much-good-lzw.gif",
+    "test/data/artificial-gif/small-frame-interlaced.gif",
+    "test/data/artificial-gif/transparent-index.gif",
+    "test/data/artificial-gif/zero-width-frame.gif",
+    "test/data/bricks-dither.gif",
+    "test/data/bricks-gray.gif",
+    "test/data/bricks-nodither.gif",
+    "test/data/gifplayer-muybridge.gif",
+    "test/data/harvesters.gif",
+    "test/data/hat.gif",
+    "test/data/hibiscus.primitive.gif",
+    "test/data/hibiscus.regular.gif",
+    "test/data/hippopotamus.interlaced.gif",
+    "test/data/hippopotamus.interlaced.truncated.gif",
+    "test/data/hippopotamus.masked-with-muybridge.gif",
+    "test/data/hippopotamus.regular.gif",
+    "test/data/muybridge.gif",
+    "test/data/pjw-thumbnail.gif",
+};
+
+// hash_canvas returns the 64-bit FNV-1a hash of pixbuf's BGRA_PREMUL pixels.
+uint64_t  //
+hash_canvas(wuffs_base__pixel_buffer* pixbuf) {
+  wuffs_base__table_u8 tab = pixbuf->plane(0);
+  uint64_t h = 0xCBF29CE484222325;
+  for (size_t y = 0; y < tab.height; y++) {
+    const uint8_t* p = tab.ptr + (y * tab.stride);
+    for (size_t x = 0; x < tab.width; x++) {
+      h ^= p[x];
+      h *= 0x100000001B3;
+    }
+  }
+  return h;
+}
+
+// DecodedGif holds each frame's duration and composited BGRA_PREMUL canvas
+// (and that canvas' hash).
+struct DecodedGif {
+  uint32_t width = 0;
+  uint32_t height = 0;
+  uint32_t num_animation_loops = 0;
+  std::vector<uint64_t> durations;
+  std::vector<uint64_t> hashes;
+  std::vector<std::vector<uint8_t>> canvases;
+};
+
+// decode_gif_sequentially is the reference. Like example/gifplayer, it
+// decodes src's frames, in order and on one thread, straight onto a
+// BGRA_PREMUL canvas, applying each frame's disposal afterwards. It appends
+// each frame to out and returns the error message, if any.
+std::string  //
+decode_gif_sequentially(DecodedGif& out, const std::vector<uint8_t>& src) {
+  wuffs_gif__decoder::unique_ptr dec = wuffs_gif__decoder::alloc();
+  wuffs_base__io_buffer s = wuffs_base__ptr_u8__reader(
+      const_cast<uint8_t*>(src.data()), src.size(), true);
+  wuffs_base__image_config ic = wuffs_base__null_image_config();
+  wuffs_base__status status = dec->decode_image_config(&ic, &s);
+  if (!status.is_ok()) {
+    return status.message();
+  }
+  uint32_t width = ic.pixcfg.width();
+  uint32_t height = ic.pixcfg.height();
+  out.width = width;
+  out.height = height;
+  ic.pixcfg.set(WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+                WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, width, height);
+  size_t len = static_cast<size_t>(ic.pixcfg.pixbuf_len());
+  std::vector<uint8_t> curr(len);
+  std::vector<uint8_t> prev(len);
+  std::vector<uint8_t> workbuf(
+      static_cast<size_t>(dec->workbuf_len().max_incl));
+  wuffs_base__pixel_buffer pixbuf;
+  status = pixbuf.set_from_slice(
+      &ic.pixcfg, wuffs_base__make_slice_u8(curr.data(), curr.size()));
+  if (!status.is_ok()) {
+    return status.message();
+  }
+
+  while (true) {
+    wuffs_base__frame_config fc = wuffs_base__null_frame_config();
+    status = dec->decode_frame_config(&fc, &s);
+    if (status.repr == wuffs_base__note__end_of_data) {
+      out.num_animation_loops = dec->num_animation_loops();
+      return "";
+    } else if (!status.is_ok()) {
+      return status.message();
+    }
+    if (fc.index() == 0) {
+      for (size_t i = 0; i < len; i += 4) {
+        wuffs_base__poke_u32le__no_bounds_check(curr.data() + i,
+                                                fc.background_color());
+      }
+    }
+    if (fc.disposal() == WUFFS_BASE__ANIMATION_DISPOSAL__RESTORE_PREVIOUS) {
+      prev = curr;
+    }
+    status = dec->decode_frame(&pixbuf, &s,
+                               fc.overwrite_instead_of_blend()
+                                   ? WUFFS_BASE__PIXEL_BLEND__SRC
+                                   : WUFFS_BASE__PIXEL_BLEND__SRC_OVER,
+                               wuffs_base__make_slice_u8(workbuf.data(),
+                                                         workbuf.size()),
+                               nullptr);
+    if (!status.is_ok()) {
+      return status.message();
+    }
+    out.durations.push_back(fc.duration());
+    out.hashes.push_back(hash_canvas(&pixbuf));
+    out.canvases.push_back(curr);
+
+    if (fc.disposal() == WUFFS_BASE__ANIMATION_DISPOSAL__RESTORE_BACKGROUND) {
+      wuffs_base__rect_ie_u32 r = fc.bounds();
+      for (uint32_t y = r.min_incl_y; y < r.max_excl_y; y++) {
+        for (uint32_t x = r.min_incl_x; x < r.max_excl_x; x++) {
+          wuffs_base__poke_u32le__no_bounds_check(
+              curr.data() + (4 * ((static_cast<size_t>(y) * width) + x)),
+              fc.background_color());
+        }
+      }
+    } else if (fc.disposal() ==
+               WUFFS_BASE__ANIMATION_DISPOSAL__RESTORE_PREVIOUS) {
+      curr = prev;
+    }
+  }
+}
+
+// HashingCallbacks records each composited frame's canvas hash. If
+// m_stop_after is non-zero, FrameDone fails after that many frames.
+class HashingCallbacks : public wuffs_aux::ParallelDecodeGifCallbacks {
+ public:
+  std::vector<uint64_t> m_hashes;
+  size_t m_num_frame_configs = 0;
+  size_t m_stop_after = 0;
+  bool m_bad_frame_order = false;
+
+  std::string  //
+  ImageConfig(const wuffs_base__image_config& image_config,
+              const std::vector<wuffs_base__frame_config>& frame_configs)
+      override {
+    m_num_frame_configs = frame_configs.size();
+    return "";
+  }
+
+  std::string  //
+  FrameDone(const wuffs_base__frame_config& frame_config,
+            wuffs_base__pixel_buffer* canvas) override {
+    m_bad_frame_order = m_bad_frame_order ||
+                        (frame_config.index() != m_hashes.size());
+    m_hashes.push_back(hash_canvas(canvas));
+    return (m_hashes.size() == m_stop_after) ? "stop!" : "";
+  }
+};
+
+// encode_gif encodes frames, each a width × height canvas in the given
+// pixel format, with GifEncoder.
+std::string  //
+encode_gif(std::vector<uint8_t>& dst,
+           uint32_t pixfmt,
+           uint32_t width,
+           uint32_t height,
+           uint32_t loop_count,
+           std::vector<std::vector<uint8_t>>& frames,
+           const std::vector<uint64_t>& durations) {
+  wuffs_aux::GifEncoder enc;
+  std::string error = enc.reset(width, height, loop_count);
+  if (!error.empty()) {
+    return error;
+  }
+  wuffs_base__pixel_config pixcfg;
+  pixcfg.set(pixfmt, WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, width, height);
+  for (size_t i = 0; i < frames.size(); i++) {
+    wuffs_base__pixel_buffer pixbuf;
+    wuffs_base__status status = pixbuf.set_from_slice(
+        &pixcfg, wuffs_base__make_slice_u8(frames[i].data(), frames[i].size()));
+    if (!status.is_ok()) {
+      return status.message();
+    }
+    error = enc.add_frame(dst, &pixbuf, durations[i]);
+    if (!error.empty()) {
+      return error;
+    }
+  }
+  return enc.finish(dst);
+}
+
+// ---------------- Tests
+
+const char*  //
+test_wuffs_aux_gif_parallel_decode_gif() {
+  size_t num_valid = 0;
+  size_t max_num_frames = 0;
+  for (const char* filename : g_gif_filenames) {
+    std::vector<uint8_t> src;
+    CHECK_STRING(read_file(src, filename));
+    DecodedGif decoded;
+    std::string want_error = decode_gif_sequentially(decoded, src);
+    const std::vector<uint64_t>& want = decoded.hashes;
+    num_valid += want_error.empty() ? 1 : 0;
+    max_num_frames = std::max(max_num_frames, want.size());
+
+    for (uint32_t num_threads : {1u, 3u, 8u}) {
+      HashingCallbacks callbacks;
+      std::string error = wuffs_aux::ParallelDecodeGif(
+          callbacks, src.data(), src.size(), num_threads);
+      CHECK(error == want_error,
+            "%s, num_threads=%u: have \"%s\", want \"%s\"", filename,
+            num_threads, error.c_str(), want_error.c_str());
+      if (!error.empty()) {
+        continue;
+      }
+      CHECK(!callbacks.m_bad_frame_order, "%s, num_threads=%u: bad order",
+            filename, num_threads);
+      CHECK(callbacks.m_num_frame_configs == want.size(),
+            "%s, num_threads=%u: num_frame_configs: have %zu, want %zu",
+            filename, num_threads, callbacks.m_num_frame_configs,
+            want.size());
+      CHECK(callbacks.m_hashes.size() == want.size(),
+            "%s, num_threads=%u: num_frames: have %zu, want %zu", filename,
+            num_threads, callbacks.m_hashes.size(), want.size());
+      for (size_t i = 0; i < want.size(); i++) {
+        CHECK(callbacks.m_hashes[i] == want[i],
+              "%s, num_threads=%u: frame %zu: have 0x%016llX, want 0x%016llX",
+              filename, num_threads, i,
+              static_cast<unsigned long long>(callbacks.m_hashes[i]),
+              static_cast<unsigned long long>(want[i]));
+      }
+    }
+  }
+  CHECK(num_valid >= 20, "num_valid: have %zu", num_valid);
+  CHECK(max_num_frames >= 20, "max_num_frames: have %zu", max_num_frames);
+  return nullptr;
+}
+
+const char*  //
+test_wuffs_aux_gif_parallel_decode_gif_stop() {
+  // A FrameDone error stops the decode: no later frame is passed on.
+  std::vector<uint8_t> src;
+  CHECK_STRING(read_file(src, "test/data/muybridge.gif"));
+  for (uint32_t num_threads : {1u, 3u, 8u}) {
+    for (size_t stop_after : {1u, 2u, 7u}) {
+      HashingCallbacks callbacks;
+      callbacks.m_stop_after = stop_after;
+      std::string error = wuffs_aux::ParallelDecodeGif(
+          callbacks, src.data(), src.size(), num_threads);
+      CHECK(error == "stop!",
+            "num_threads=%u, stop_after=%zu: have \"%s\"", num_threads,
+            stop_after, error.c_str());
+      CHECK(callbacks.m_hashes.size() == stop_after,
+            "num_threads=%u, stop_after=%zu: num_frames: have %zu",
+            num_threads, stop_after, callbacks.m_hashes.size());
+    }
+  }
+  return nullptr;
+}
+
+const char*  //
+test_wuffs_aux_gif_gif_encoder_errors() {
+  const char* bad_argument = "wuffs_aux::GifEncoder: invalid argument";
+  const char* not_reset = "wuffs_aux::GifEncoder: reset was not called";
+  std::vector<uint8_t> dst;
+  std::vector<uint8_t> pixels(4 * 3 * 2);
+  wuffs_base__pixel_config pixcfg;
+  pixcfg.set(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+             WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, 3, 2);
+  wuffs_base__pixel_buffer pixbuf;
+  CHECK_STRING(pixbuf
+                   .set_from_slice(&pixcfg, wuffs_base__make_slice_u8(
+                                                pixels.data(), pixels.size()))
+                   .message());
+
+  wuffs_aux::GifEncoder enc;
+  std::string error = enc.add_frame(dst, &pixbuf, 0);
+  CHECK(error == not_reset, "add_frame: have \"%s\"", error.c_str());
+  error = enc.finish(dst);
+  CHECK(error == not_reset, "finish: have \"%s\"", error.c_str());
+  error = enc.reset(0, 2);
+  CHECK(error == bad_argument, "reset(0, 2): have \"%s\"", error.c_str());
+  error = enc.reset(3, 0x10000);
+  CHECK(error == bad_argument, "reset(3, 0x10000): have \"%s\"",
+        error.c_str());
+  error = enc.add_frame(dst, &pixbuf, 0);
+  CHECK(error == not_reset, "add_frame after a failed reset: have \"%s\"",
+        error.c_str());
+
+  error = enc.reset(2, 3);
+  CHECK(error.empty(), "reset(2, 3): %s", error.c_str());
+  error = enc.add_frame(dst, &pixbuf, 0);
+  CHECK(error == bad_argument, "add_frame(3×2 onto 2×3): have \"%s\"",
+        error.c_str());
+  error = enc.add_frame(dst, nullptr, 0);
+  CHECK(error == bad_argument, "add_frame(nullptr): have \"%s\"",
+        error.c_str());
+  error = enc.finish(dst);
+  CHECK(error.empty(), "finish: %s", error.c_str());
+  error = enc.finish(dst);
+  CHECK(error == not_reset, "finish after finish: have \"%s\"",
+        error.c_str());
+  CHECK(dst.size() > 0, "dst.size(): have 0");
+  return nullptr;
+}
+
+const char*  //
+test_wuffs_aux_gif_gif_encoder_quantize() {
+  // This image has more than 256 colors, so it can only be approximated, but
+  // they are noisy variations of only 24 colors, each within one of the
+  // quantizer's bins. Its left column is transparent.
+  const uint32_t width = 64;
+  const uint32_t height = 48;
+  std::vector<std::vector<uint8_t>> frames(1);
+  frames[0].resize(4 * width * height);
+  uint32_t rng = 1;
+  for (uint32_t y = 0; y < height; y++) {
+    for (uint32_t x = 0; x < width; x++) {
+      rng ^= rng << 13;
+      rng ^= rng >> 17;
+      rng ^= rng << 5;
+      uint32_t base = ((x / 16) * 6) + (y / 8);
+      uint8_t* p = frames[0].data() + (4 * ((y * width) + x));
+      p[0] = static_cast<uint8_t>((0x28 * base) + ((rng >> 0) & 7));
+      p[1] = static_cast<uint8_t>((0x48 * base) + ((rng >> 3) & 7));
+      p[2] = static_cast<uint8_t>((0x98 * base) + ((rng >> 6) & 7));
+      p[3] = (x == 0) ? 0x20 : 0xC0;
+    }
+  }
+  std::vector<uint8_t> encoded;
+  std::string error =
+      encode_gif(encoded, WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL, width,
+                 height, 0, frames, {0});
+  CHECK(error.empty(), "encode: %s", error.c_str());
+  DecodedGif decoded;
+  error = decode_gif_sequentially(decoded, encoded);
+  CHECK(error.empty(), "decode: %s", error.c_str());
+  CHECK(decoded.canvases.size() == 1, "num_frames: have %zu",
+        decoded.canvases.size());
+
+  int max_diff = 0;
+  for (size_t i = 0; i < frames[0].size(); i += 4) {
+    const uint8_t* have = decoded.canvases[0].data() + i;
+    const uint8_t* want = frames[0].data() + i;
+    if (want[3] < 0x80) {
+      CHECK(wuffs_base__peek_u32le__no_bounds_check(have) == 0,
+            "pixel %zu: not transparent", i / 4);
+      continue;
+    }
+    CHECK(have[3] == 0xFF, "pixel %zu: not opaque", i / 4);
+    for (int c = 0; c < 3; c++) {
+      max_diff = std::max(max_diff, std::abs(have[c] - want[c]));
+    }
+  }
+  CHECK(max_diff <= 4, "max_diff: have %d", max_diff);
+  return nullptr;
+}
+
+const char*  //
+test_wuffs_aux_gif_gif_encoder_round_trip() {
+  // Re-encoding a decoded GIF's canvases is lossless, as each frame's dirty
+  // rect has no more than 256 colors. This includes animations with
+  // transparency, which need a restore-background disposal to make a pixel
+  // transparent again.
+  uint64_t cs = WUFFS_BASE__FLICKS_PER_SECOND / 100;
+  std::vector<std::vector<uint8_t>> synthetic(4);
+  std::vector<uint64_t> synthetic_durations = {10 * cs, 20 * cs, 0, 5 * cs};
+  for (size_t i = 0; i < synthetic.size(); i++) {
+    synthetic[i].resize(4 * 9 * 7);
+    for (size_t j = 0; j < (9 * 7); j++) {
+      // Frame 2 is the same as frame 1. Frame 3 has fewer opaque pixels.
+      size_t k = (i == 2) ? 1 : i;
+      bool opaque = ((j + k) % 3) != 0;
+      if ((k == 3) && (j >= 30)) {
+        opaque = false;
+      }
+      wuffs_base__poke_u32le__no_bounds_check(
+          synthetic[i].data() + (4 * j),
+          opaque ? (0xFF000000 | (0x102030 * static_cast<uint32_t>(j + k)))
+                 : 0);
+    }
+  }
+
+  const char* filenames[] = {
+      nullptr,  // The synthetic animation.
+      "test/data/animated-red-blue.gif",
+      "test/data/artificial-gif/background-color.gif",
+      "test/data/artificial-gif/transparent-index.gif",
+      "test/data/bricks-dither.gif",
+      "test/data/hat.gif",
+      "test/data/hippopotamus.masked-with-muybridge.gif",
+      "test/data/muybridge.gif",
+      "test/data/pjw-thumbnail.gif",
+  };
+  for (const char* filename : filenames) {
+    DecodedGif want;
+    if (filename) {
+      std::vector<uint8_t> src;
+      CHECK_STRING(read_file(src, filename));
+      std::string error = decode_gif_sequentially(want, src);
+      CHECK(error.empty(), "%s: reference: %s", filename, error.c_str());
+    } else {
+      filename = "synthetic";
+      want.width = 9;
+      want.height = 7;
+      want.num_animation_loops = 3;
+      want.durations = synthetic_durations;
+      want.canvases = synthetic;
+    }
+
+    std::vector<uint8_t> encoded;
+    std::string error = encode_gif(
+        encoded, WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL, want.width,
+        want.height, want.num_animation_loops, want.canvases, want.durations);
+    CHECK(error.empty(), "%s: encode: %s", filename, error.c_str());
+    DecodedGif have;
+    error = decode_gif_sequentially(have, encoded);
+    CHECK(error.empty(), "%s: decode: %s", filename, error.c_str());
+
+    CHECK((have.width == want.width) && (have.height == want.height),
+          "%s: dimensions: have %" PRIu32 "×%" PRIu32 ", want %" PRIu32
+          "×%" PRIu32,
+          filename, have.width, have.height, want.width, want.height);
+    CHECK(have.num_animation_loops == want.num_animation_loops,
+          "%s: num_animation_loops: have %" PRIu32 ", want %" PRIu32,
+          filename, have.num_animation_loops, want.num_animation_loops);
+    CHECK(have.canvases.size() == want.canvases.size(),
+          "%s: num_frames: have %zu, want %zu", filename,
+          have.canvases.size(), want.canvases.size());
+    for (size_t i = 0; i < want.canvases.size(); i++) {
+      CHECK(have.durations[i] == want.durations[i],
+            "%s: frame %zu: duration: have %" PRIu64 ", want %" PRIu64,
+            filename, i, have.durations[i], want.durations[i]);
+      CHECK(have.canvases[i] == want.canvases[i], "%s: frame %zu: pixels",
+            filename, i);
+    }
+  }
+  return nullptr;
+}
+
+// ---------------- Manifest
+
+typedef const char* (*proc)();
+
+proc g_tests[] = {
+    test_wuffs_aux_gif_gif_encoder_errors,
+    test_wuffs_aux_gif_gif_encoder_quantize,
+    test_wuffs_aux_gif_gif_encoder_round_trip,
+    test_wuffs_aux_gif_parallel_decode_gif,
+    test_wuffs_aux_gif_parallel_decode_gif_stop,
+    nullptr,
+};
+
+int  //
+main(int argc, char** argv) {
+  int num_tests = 0;
+  for (proc* p = g_tests; *p; p++) {
+    const char* z = (*p)();
+    if (z) {
+      printf("%-16s%-8sFAIL %s\n", "auxiliary/gif", g_cc, z);
+      return 1;
+    }
+    num_tests++;
+  }
+  printf("%-16s%-8sPASS (%d tests)\n", "auxiliary/gif", g_cc, num_tests);
+  return 0;
+}
@@ -0,0 +1,634 @@
+// Copyright 2022 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ----------------
+
+/*
+This test program exercises the C++ (not C) wuffs_aux::DecodeImage and
+DecodeImages functions (and their Allocator and PoolingDecodeImageCallbacks
+helpers). Unlike the test/c/std programs, it does not use test/c/testlib
+(which is C only).
+
+To manually run this test, from the repository's root directory:
+
+for CXX in clang++ g++; do
+  $CXX -std=c++11 -Wall -Werror -pthread test/c/auxiliary/image.cc && ./a.out
+  rm -f a.out
+done
+
+Each edition should print "PASS", amongst other information, and exit(0).
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Wuffs ships as a "single file C library" or "header file library" as per
+// https://github.com/nothings/stb/blob/master/docs/stb_howto.txt
+//
+// To use that single file as a "foo.c"-like implementation, instead of a
+// "foo.h"-like header, #define WUFFS_IMPLEMENTATION before #include'ing or
+// compiling it.
+#define WUFFS_IMPLEMENTATION
+
+// Defining the WUFFS_CONFIG__MODULE* macros are optional, but it lets users of
+// release/c/etc.c choose which parts of Wuffs to build. That file contains the
+// entire Wuffs standard library, implementing a variety of codecs and file
+// formats. Without this macro definition, an optimizing compiler or linker may
+// very well discard Wuffs code for unused codecs, but listing the Wuffs
+// modules we use makes that process explicit. Preprocessing means that such
+// code simply isn't compiled.
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__ADLER32
+#define WUFFS_CONFIG__MODULE__AUX__BASE
+#define WUFFS_CONFIG__MODULE__AUX__IMAGE
+#define WUFFS_CONFIG__MODULE__AUX__PNG
+#define WUFFS_CONFIG__MODULE__BASE
+#define WUFFS_CONFIG__MODULE__CRC32
+#define WUFFS_CONFIG__MODULE__DEFLATE
+#define WUFFS_CONFIG__MODULE__PNG
+#define WUFFS_CONFIG__MODULE__ZLIB
+
+// If building this program in an environment that doesn't easily accommodate
+// relative includes, you can use the script/inline-c-relative-includes.go
+// program to generate a stand-alone C file.
+#include "../../../release/c/wuffs-unsupported-snapshot.c"
+
+// The order matters here. Clang also defines "__GNUC__".
+#if defined(__clang__)
+const char* g_cc = "clang";
+#elif defined(__GNUC__)
+const char* g_cc = "gcc";
+#elif defined(_MSC_VER)
+const char* g_cc = "cl";
+#else
+const char* g_cc = "cc";
+#endif
+
+// g_fail_message holds the most recent test failure's message.
+std::string g_fail_message;
+
+#define CHECK(cond, ...)                                                      \
+  do {                                                                        \
+    if (!(cond)) {                                                            \
+      char fail_buf[1024];                                                    \
+      snprintf(fail_buf, sizeof fail_buf, "%s: ", __func__);                  \
+      size_t fail_n = strlen(fail_buf);                                       \
+      snprintf(fail_buf + fail_n, sizeof fail_buf - fail_n, __VA_ARGS__);     \
+      g_fail_message = fail_buf;                                              \
+      return g_fail_message.c_str();                                          \
+    }                                                                         \
+  } while (false)
+
+#define CHECK_STRING(string)       \
+  do {                             \
+    const char* z = (string);      \
+    if (z) {                       \
+      return z;                    \
+    }                              \
+  } while (false)
+
+// ---------------- Helpers
+
+const char*  //
+read_file(std::vector<uint8_t>& dst, const char* path) {
+  FILE* f = fopen(path, "rb");
+  if (!f) {
+    g_fail_message = std::string("read_file: could not open ") + path;
+    return g_fail_message.c_str();
+  }
+  uint8_t buf[4096];
+  while (true) {
+    size_t n = fread(buf, 1, sizeof buf, f);
+    dst.insert(dst.end(), buf, buf + n);
+    if (n < sizeof buf) {
+      break;
+    }
+  }
+  bool ok = !ferror(f);
+  fclose(f);
+  if (!ok) {
+    g_fail_message = std::string("read_file: could not read ") + path;
+    return g_fail_message.c_str();
+  }
+  return nullptr;
+}
+
+// The counting_etc functions are the Allocator that main installs. They
+// count the calls and the bytes requested, like GetAllocatorStats, and also
+// the number of live (allocated but not yet freed) blocks.
+std::atomic<uint64_t> g_counting_num_calls(0);
+std::atomic<uint64_t> g_counting_num_bytes(0);
+std::atomic<int64_t> g_counting_num_live(0);
+
+void*  //
+counting_malloc(size_t n) {
+  g_counting_num_calls++;
+  g_counting_num_bytes += n;
+  void* ret = malloc(n);
+  g_counting_num_live += ret ? 1 : 0;
+  return ret;
+}
+
+void*  //
+counting_calloc(size_t n, size_t size) {
+  g_counting_num_calls++;
+  g_counting_num_bytes += n * size;
+  void* ret = calloc(n, size);
+  g_counting_num_live += ret ? 1 : 0;
+  return ret;
+}
+
+void*  //
+counting_realloc(void* ptr, size_t n) {
+  g_counting_num_calls++;
+  g_counting_num_bytes += n;
+  void* ret = realloc(ptr, n);
+  g_counting_num_live += (!ptr && ret) ? 1 : 0;
+  return ret;
+}
+
+void  //
+counting_free(void* ptr) {
+  g_counting_num_live -= ptr ? 1 : 0;
+  free(ptr);
+}
+
+// decode_image decodes src (using callbacks) into *result.
+const char*  //
+decode_image(wuffs_aux::DecodeImageResult* result,
+             wuffs_aux::DecodeImageCallbacks& callbacks,
+             const std::vector<uint8_t>& src) {
+  wuffs_aux::sync_io::MemoryInput input(src.data(), src.size());
+  *result = wuffs_aux::DecodeImage(callbacks, input);
+  CHECK(result->error_message.empty(), "%s", result->error_message.c_str());
+  return nullptr;
+}
+
+// check_same_pixels checks that have and want hold the same pixels.
+const char*  //
+check_same_pixels(const wuffs_aux::DecodeImageResult& have,
+                  const wuffs_aux::DecodeImageResult& want) {
+  // plane is not a const method, so take copies of the pixbufs.
+  wuffs_base__pixel_buffer have_pixbuf = have.pixbuf;
+  wuffs_base__pixel_buffer want_pixbuf = want.pixbuf;
+  wuffs_base__table_u8 h = have_pixbuf.plane(0);
+  wuffs_base__table_u8 w = want_pixbuf.plane(0);
+  CHECK((h.width == w.width) && (h.height == w.height),
+        "dimensions: have %zux%zu, want %zux%zu", h.width, h.height, w.width,
+        w.height);
+  for (size_t y = 0; y < h.height; y++) {
+    CHECK(!memcmp(h.ptr + (y * h.stride), w.ptr + (y * w.stride), h.width),
+          "row %zu differs", y);
+  }
+  return nullptr;
+}
+
+// CountingWorkerCallbacks are DecodeImages' per-worker callbacks. They count
+// how often a PNG decoder is selected, which DecodeImages' PNG splitting
+// (which brings its own, prefilled, decoder) skips.
+class CountingWorkerCallbacks : public wuffs_aux::PoolingDecodeImageCallbacks {
+ public:
+  CountingWorkerCallbacks(std::atomic<int>* num_png_decoders)
+      : m_num_png_decoders(num_png_decoders) {}
+
+  wuffs_base__image_decoder::unique_ptr  //
+  SelectDecoder(uint32_t fourcc,
+                wuffs_base__slice_u8 prefix_data,
+                bool prefix_closed) override {
+    if (fourcc == WUFFS_BASE__FOURCC__PNG) {
+      (*m_num_png_decoders)++;
+    }
+    return wuffs_aux::PoolingDecodeImageCallbacks::SelectDecoder(
+        fourcc, prefix_data, prefix_closed);
+  }
+
+ private:
+  std::atomic<int>* m_num_png_decoders;
+};
+
+// BatchCallbacks decode m_srcs with DecodeImages, keeping the results. An
+// empty src fails to open, as does (with a nullptr Input) a nullptr src.
+class BatchCallbacks : public wuffs_aux::DecodeImagesCallbacks {
+ public:
+  BatchCallbacks(const std::vector<const std::vector<uint8_t>*>& srcs)
+      : m_srcs(srcs),
+        m_results(srcs.size()),
+        m_num_done(srcs.size()),
+        m_num_png_decoders(0),
+        m_worker_callbacks_fail(false) {}
+
+  std::unique_ptr<wuffs_aux::DecodeImageCallbacks>  //
+  NewWorkerCallbacks(uint32_t worker_index) override {
+    if (m_worker_callbacks_fail && (worker_index > 0)) {
+      return nullptr;
+    }
+    return std::unique_ptr<wuffs_aux::DecodeImageCallbacks>(
+        new CountingWorkerCallbacks(&m_num_png_decoders));
+  }
+
+  OpenInputResult  //
+  OpenInput(size_t input_index) override {
+    const std::vector<uint8_t>* src = m_srcs[input_index];
+    if (!src) {
+      return OpenInputResult(std::unique_ptr<wuffs_aux::sync_io::Input>());
+    } else if (src->empty()) {
+      return OpenInputResult("open failed");
+    }
+    return OpenInputResult(std::unique_ptr<wuffs_aux::sync_io::Input>(
+        new wuffs_aux::sync_io::MemoryInput(src->data(), src->size())));
+  }
+
+  void  //
+  Done(size_t input_index, wuffs_aux::DecodeImageResult& result) override {
+    m_num_done[input_index]++;
+    m_results[input_index].reset(
+        new wuffs_aux::DecodeImageResult(std::move(result)));
+  }
+
+  const std::vector<const std::vector<uint8_t>*>& m_srcs;
+  std::vector<std::unique_ptr<wuffs_aux::DecodeImageResult>> m_results;
+  std::vector<int> m_num_done;
+  std::atomic<int> m_num_png_decoders;
+  bool m_worker_callbacks_fail;
+};
+
+// check_decode_images checks that DecodeImages, with num_threads workers,
+// gives the same results as calling DecodeImage on each src.
+const char*  //
+check_decode_images(BatchCallbacks& callbacks, uint32_t num_threads) {
+  std::string error = wuffs_aux::DecodeImages(
+      callbacks, callbacks.m_srcs.size(), num_threads);
+  CHECK(error.empty(), "num_threads=%u: %s", num_threads, error.c_str());
+  for (size_t i = 0; i < callbacks.m_srcs.size(); i++) {
+    CHECK(callbacks.m_num_done[i] == 1,
+          "num_threads=%u, input %zu: num_done: have %d, want 1", num_threads,
+          i, callbacks.m_num_done[i]);
+    const wuffs_aux::DecodeImageResult& have = *callbacks.m_results[i];
+
+    const std::vector<uint8_t>* src = callbacks.m_srcs[i];
+    std::string want_error =
+        !src ? "wuffs_aux::DecodeImages: OpenInput returned nullptr"
+             : src->empty() ? "open failed" : "";
+    wuffs_aux::DecodeImageResult want(std::move(want_error));
+    if (src && !src->empty()) {
+      wuffs_aux::DecodeImageCallbacks want_callbacks;
+      wuffs_aux::sync_io::MemoryInput input(src->data(), src->size());
+      want = wuffs_aux::DecodeImage(want_callbacks, input);
+    }
+
+    CHECK(have.error_message == want.error_message,
+          "num_threads=%u, input %zu: have \"%s\", want \"%s\"",
+          num_threads, i, have.error_message.c_str(),
+          want.error_message.c_str());
+    if (want.error_message.empty()) {
+      const char* z = check_same_pixels(have, want);
+      CHECK(!z, "num_threads=%u, input %zu: %s", num_threads, i, z);
+    }
+  }
+  return nullptr;
+}
+
+// make_flushed_png re-encodes filename with ParallelEncodePng, so that its
+// IDAT zlib stream has full flush points.
+const char*  //
+make_flushed_png(std::vector<uint8_t>& dst, const char* filename) {
+  std::vector<uint8_t> src;
+  CHECK_STRING(read_file(src, filename));
+  wuffs_aux::DecodeImageCallbacks callbacks;
+  wuffs_aux::DecodeImageResult result("");
+  CHECK_STRING(decode_image(&result, callbacks, src));
+  std::string error = wuffs_aux::ParallelEncodePng(dst, &result.pixbuf, 1, 8);
+  CHECK(error.empty(), "ParallelEncodePng: %s", error.c_str());
+  return nullptr;
+}
+
+// ---------------- Tests
+
+const char*  //
+test_wuffs_aux_image_allocator_stats() {
+  std::vector<uint8_t> src;
+  CHECK_STRING(read_file(src, "test/data/hat.png"));
+  int64_t live0 = g_counting_num_live;
+
+  // The Allocator sees exactly the calls (and bytes) that GetAllocatorStats
+  // counts: the work buffer and the pixel buffer. A MemoryInput brings its
+  // own I/O buffer.
+  for (int i = 0; i < 2; i++) {
+    wuffs_aux::AllocatorStats s0 = wuffs_aux::GetAllocatorStats();
+    uint64_t calls0 = g_counting_num_calls;
+    uint64_t bytes0 = g_counting_num_bytes;
+    {
+      wuffs_aux::DecodeImageCallbacks callbacks;
+      wuffs_aux::DecodeImageResult result("");
+      CHECK_STRING(decode_image(&result, callbacks, src));
+      CHECK(g_counting_num_live > live0, "i=%d: nothing is live", i);
+    }
+    wuffs_aux::AllocatorStats s1 = wuffs_aux::GetAllocatorStats();
+    uint64_t num_allocations = s1.num_allocations - s0.num_allocations;
+    uint64_t num_bytes = s1.num_bytes - s0.num_bytes;
+    CHECK(num_allocations == (g_counting_num_calls - calls0),
+          "i=%d: num_allocations: have %zu, want %zu", i,
+          static_cast<size_t>(num_allocations),
+          static_cast<size_t>(g_counting_num_calls - calls0));
+    CHECK(num_bytes == (g_counting_num_bytes - bytes0),
+          "i=%d: num_bytes: have %zu, want %zu", i,
+          static_cast<size_t>(num_bytes),
+          static_cast<size_t>(g_counting_num_bytes - bytes0));
+    CHECK(num_allocations == 2, "i=%d: num_allocations: have %zu, want 2", i,
+          static_cast<size_t>(num_allocations));
+    CHECK(num_bytes > (90 * 112 * 4), "i=%d: num_bytes: have %zu",
+          i, static_cast<size_t>(num_bytes));
+    CHECK(g_counting_num_live == live0, "i=%d: num_live: have %zd, want %zd",
+          i, static_cast<ptrdiff_t>(g_counting_num_live.load()),
+          static_cast<ptrdiff_t>(live0));
+  }
+
+  // So does DynIOBuffer.
+  wuffs_aux::AllocatorStats s0 = wuffs_aux::GetAllocatorStats();
+  {
+    wuffs_aux::sync_io::DynIOBuffer dyn(1 << 20);
+    CHECK(dyn.grow(1000) == dyn.OK, "grow(1000) failed");
+    CHECK(dyn.grow(100000) == dyn.OK, "grow(100000) failed");
+    CHECK(dyn.grow(2 << 20) == dyn.FailedMaxInclExceeded,
+          "grow(2 MiB) succeeded");
+  }
+  wuffs_aux::AllocatorStats s1 = wuffs_aux::GetAllocatorStats();
+  CHECK(s1.num_allocations == (s0.num_allocations + 2),
+        "DynIOBuffer: num_allocations: have %zu, want 2",
+        static_cast<size_t>(s1.num_allocations - s0.num_allocations));
+  CHECK(s1.num_bytes >= (s0.num_bytes + 101000),
+        "DynIOBuffer: num_bytes: have %zu",
+        static_cast<size_t>(s1.num_bytes - s0.num_bytes));
+  CHECK(g_counting_num_live == live0, "DynIOBuffer: num_live: have %zd",
+        static_cast<ptrdiff_t>(g_counting_num_live.load()));
+  return nullptr;
+}
+
+const char*  //
+test_wuffs_aux_image_pooling_decode_image_callbacks() {
+  std::vector<uint8_t> big_src;
+  std::vector<uint8_t> small_src;
+  CHECK_STRING(read_file(big_src, "test/data/bricks-color.png"));
+  CHECK_STRING(read_file(small_src, "test/data/hat.png"));
+  int64_t live0 = g_counting_num_live;
+
+  wuffs_aux::DecodeImageCallbacks plain;
+  wuffs_aux::DecodeImageResult big_want("");
+  wuffs_aux::DecodeImageResult small_want("");
+  CHECK_STRING(decode_image(&big_want, plain, big_src));
+  CHECK_STRING(decode_image(&small_want, plain, small_src));
+  const uint64_t big_len = big_want.pixbuf.pixcfg.pixbuf_len();
+  const uint64_t small_len = small_want.pixbuf.pixcfg.pixbuf_len();
+  CHECK(big_len > small_len, "big_len: have %zu, small_len %zu",
+        static_cast<size_t>(big_len), static_cast<size_t>(small_len));
+
+  {
+    wuffs_aux::PoolingDecodeImageCallbacks pool;
+    wuffs_aux::DecodeImageResult r1("");
+    wuffs_aux::DecodeImageResult r2("");
+    wuffs_aux::DecodeImageResult r3("");
+
+    // The first decode allocates everything. The second decode, after
+    // recycling the first result, re-uses everything (including the pixel
+    // buffer memory, at the same address), so it allocates nothing.
+    CHECK_STRING(decode_image(&r1, pool, big_src));
+    CHECK_STRING(check_same_pixels(r1, big_want));
+    void* big_ptr = r1.pixbuf_mem_owner.get();
+    pool.recycle(r1);
+    CHECK(!r1.pixbuf_mem_owner && !r1.pixbuf.pixcfg.is_valid(),
+          "recycle did not take r1's memory");
+    uint64_t n0 = wuffs_aux::GetAllocatorStats().num_allocations;
+    CHECK_STRING(decode_image(&r2, pool, big_src));
+    CHECK_STRING(check_same_pixels(r2, big_want));
+    CHECK(wuffs_aux::GetAllocatorStats().num_allocations == n0,
+          "recycled decode: allocations were made");
+    CHECK(r2.pixbuf_mem_owner.get() == big_ptr,
+          "recycled decode: pixbuf memory not re-used");
+
+    // Without recycling r2, the pool has no pixel buffer memory, so decoding
+    // again allocates (only) that.
+    n0 = wuffs_aux::GetAllocatorStats().num_allocations;
+    uint64_t b0 = wuffs_aux::GetAllocatorStats().num_bytes;
+    CHECK_STRING(decode_image(&r3, pool, small_src));
+    CHECK_STRING(check_same_pixels(r3, small_want));
+    CHECK((wuffs_aux::GetAllocatorStats().num_allocations == (n0 + 1)) &&
+              (wuffs_aux::GetAllocatorStats().num_bytes == (b0 + small_len)),
+          "unrecycled decode: want one pixbuf allocation");
+
+    // Recycling keeps the larger memory and frees the smaller. A smaller
+    // image re-uses (and, once recycled, gives back all of) larger memory.
+    int64_t live1 = g_counting_num_live;
+    pool.recycle(r3);
+    pool.recycle(r2);
+    CHECK(g_counting_num_live == (live1 - 1), "recycle: num_live: have %zd",
+          static_cast<ptrdiff_t>(g_counting_num_live - live1));
+    n0 = wuffs_aux::GetAllocatorStats().num_allocations;
+    for (int i = 0; i < 4; i++) {
+      bool big = (i & 1) != 0;
+      CHECK_STRING(decode_image(&r1, pool, big ? big_src : small_src));
+      CHECK_STRING(check_same_pixels(r1, big ? big_want : small_want));
+      CHECK(r1.pixbuf_mem_owner.get() == big_ptr,
+            "i=%d: pixbuf memory not re-used", i);
+      pool.recycle(r1);
+    }
+    CHECK(wuffs_aux::GetAllocatorStats().num_allocations == n0,
+          "alternating decodes: allocations were made");
+
+    // Memory from the plain DecodeImageCallbacks (also paired with
+    // wuffs_aux::Free) can be recycled too, but only if it is at least as
+    // large as what the pool holds. Otherwise, it is freed.
+    int64_t live2 = g_counting_num_live;
+    pool.recycle(small_want);
+    CHECK(!small_want.pixbuf_mem_owner, "recycle did not take small_want");
+    CHECK(g_counting_num_live == (live2 - 1),
+          "smaller memory was kept by the pool");
+    CHECK_STRING(decode_image(&r1, pool, big_src));
+    CHECK(r1.pixbuf_mem_owner.get() == big_ptr,
+          "smaller memory replaced the pool's");
+    CHECK_STRING(decode_image(&small_want, plain, small_src));
+    CHECK_STRING(decode_image(&r2, plain, small_src));
+    void* plain_ptr = r2.pixbuf_mem_owner.get();
+    pool.recycle(r2);
+    CHECK_STRING(decode_image(&r2, pool, small_src));
+    CHECK_STRING(check_same_pixels(r2, small_want));
+    CHECK(r2.pixbuf_mem_owner.get() == plain_ptr,
+          "plain pixbuf memory not re-used");
+
+    // Memory paired with something other than wuffs_aux::Free is freed (by
+    // its own deleter), not pooled.
+    wuffs_aux::DecodeImageResult other(
+        wuffs_aux::MemOwner(malloc(1 << 20), &free), r2.pixbuf, "");
+    pool.recycle(other);
+    CHECK(!other.pixbuf_mem_owner, "recycle did not take other");
+    CHECK_STRING(decode_image(&r3, pool, small_src));
+    CHECK_STRING(check_same_pixels(r3, small_want));
+
+    // drop frees the pooled memory (here, just the work buffer: r1 and r3
+    // hold the pixel buffers).
+    int64_t live3 = g_counting_num_live;
+    pool.drop();
+    CHECK(g_counting_num_live < live3, "drop: nothing was freed");
+    n0 = wuffs_aux::GetAllocatorStats().num_allocations;
+    CHECK_STRING(decode_image(&r2, pool, small_src));
+    CHECK_STRING(check_same_pixels(r2, small_want));
+    CHECK(wuffs_aux::GetAllocatorStats().num_allocations == (n0 + 2),
+          "after drop: num_allocations: have %zu, want 2",
+          static_cast<size_t>(wuffs_aux::GetAllocatorStats().num_allocations -
+                              n0));
+  }
+
+  // Nothing leaks, once the pool and its results are gone (small_want and
+  // big_want are still live).
+  CHECK(g_counting_num_live == (live0 + 2), "num_live: have %zd, want %zd",
+        static_cast<ptrdiff_t>(g_counting_num_live.load()),
+        static_cast<ptrdiff_t>(live0 + 2));
+  return nullptr;
+}
+
+const char*  //
+test_wuffs_aux_image_decode_images() {
+  // A mixed batch: PNG images that can (or can't) be split, bad inputs and
+  // inputs that fail to open.
+  std::vector<uint8_t> flushed;
+  CHECK_STRING(make_flushed_png(flushed, "test/data/harvesters.png"));
+  CHECK(flushed.size() >= 1000000, "flushed.size(): have %zu",
+        flushed.size());
+  std::vector<uint8_t> truncated(flushed.begin(),
+                                 flushed.begin() + (flushed.size() / 2));
+  std::vector<uint8_t> corrupt_middle = flushed;
+  corrupt_middle[corrupt_middle.size() / 2] ^= 0x55;
+  std::vector<uint8_t> corrupt_trailer = flushed;
+  // The last 12 bytes are the IEND chunk and the 4 before are the last IDAT
+  // chunk's CRC-32, so this is the Adler-32 checksum.
+  corrupt_trailer[corrupt_trailer.size() - 17] ^= 0x01;
+
+  const char* filenames[] = {
+      "test/data/bricks-color.png",
+      "test/data/harvesters.png",
+      "test/data/hat.png",
+      "test/data/hibiscus.regular.png",
+      "test/data/hippopotamus.interlaced.png",
+      "test/data/pjw-thumbnail.png",
+  };
+  std::vector<std::vector<uint8_t>> files(6);
+  for (size_t i = 0; i < 6; i++) {
+    CHECK_STRING(read_file(files[i], filenames[i]));
+  }
+  std::vector<uint8_t> empty;
+  std::vector<uint8_t> garbage(1000, 0x42);
+
+  std::vector<const std::vector<uint8_t>*> srcs = {
+      &flushed,  &files[0],        &truncated, &files[1],
+      &empty,    &corrupt_middle,  &files[2],  nullptr,
+      &files[3], &corrupt_trailer, &garbage,   &files[4],
+      &flushed,  &files[5],        &flushed,   &flushed,
+  };
+  for (uint32_t num_threads : {1u, 3u, 32u}) {
+    BatchCallbacks callbacks(srcs);
+    CHECK_STRING(check_decode_images(callbacks, num_threads));
+  }
+
+  // An empty batch does nothing and failing to make every worker's callbacks
+  // is an overall failure.
+  std::vector<const std::vector<uint8_t>*> no_srcs;
+  BatchCallbacks no_callbacks(no_srcs);
+  std::string error = wuffs_aux::DecodeImages(no_callbacks, 0, 4);
+  CHECK(error.empty(), "empty batch: %s", error.c_str());
+  BatchCallbacks failing_callbacks(srcs);
+  failing_callbacks.m_worker_callbacks_fail = true;
+  error = wuffs_aux::DecodeImages(failing_callbacks, srcs.size(), 4);
+  CHECK(error == "wuffs_aux::DecodeImages: NewWorkerCallbacks returned nullptr",
+        "NewWorkerCallbacks failure: have \"%s\"", error.c_str());
+  for (size_t i = 0; i < srcs.size(); i++) {
+    CHECK(failing_callbacks.m_num_done[i] == 0, "input %zu: Done was called",
+          i);
+  }
+  return nullptr;
+}
+
+const char*  //
+test_wuffs_aux_image_decode_images_split_png() {
+  // A batch of one large, non-interlaced, in-memory PNG image whose IDAT has
+  // full flush points is split into bands, when there are spare workers. The
+  // PNG decoder is then a prefilled one, not the worker callbacks' own.
+  std::vector<uint8_t> flushed;
+  CHECK_STRING(make_flushed_png(flushed, "test/data/harvesters.png"));
+  std::vector<uint8_t> small;
+  CHECK_STRING(read_file(small, "test/data/hat.png"));
+
+  for (uint32_t num_threads : {1u, 2u, 4u, 8u}) {
+    std::vector<const std::vector<uint8_t>*> srcs = {&flushed};
+    BatchCallbacks callbacks(srcs);
+    CHECK_STRING(check_decode_images(callbacks, num_threads));
+    int want = (num_threads == 1) ? 1 : 0;
+    CHECK(callbacks.m_num_png_decoders == want,
+          "num_threads=%u: num_png_decoders: have %d, want %d", num_threads,
+          callbacks.m_num_png_decoders.load(), want);
+  }
+
+  // With more images than workers, the batch's last images (once workers
+  // run out of inputs to claim) can still be split, and their bands stolen
+  // by the other workers. Small images are never split.
+  for (int i = 0; i < 4; i++) {
+    std::vector<const std::vector<uint8_t>*> srcs = {
+        &small, &flushed, &small, &flushed, &flushed, &small, &flushed,
+    };
+    BatchCallbacks callbacks(srcs);
+    CHECK_STRING(check_decode_images(callbacks, 3));
+    CHECK(callbacks.m_num_png_decoders >= 3,
+          "i=%d: num_png_decoders: have %d", i,
+          callbacks.m_num_png_decoders.load());
+  }
+  return nullptr;
+}
+
+// ---------------- Manifest
+
+typedef const char* (*proc)();
+
+proc g_tests[] = {
+    test_wuffs_aux_image_allocator_stats,
+    test_wuffs_aux_image_decode_images,
+    test_wuffs_aux_image_decode_images_split_png,
+    test_wuffs_aux_image_pooling_decode_image_callbacks,
+    nullptr,
+};
+
+int  //
+main(int argc, char** argv) {
+  wuffs_aux::Allocator allocator;
+  allocator.malloc_func = counting_malloc;
+  allocator.calloc_func = counting_calloc;
+  allocator.realloc_func = counting_realloc;
+  allocator.free_func = counting_free;
+  wuffs_aux::SetAllocator(allocator);
+
+  int num_tests = 0;
+  for (proc* p = g_tests; *p; p++) {
+    const char* z = (*p)();
+    if (z) {
+      printf("%-16s%-8sFAIL %s\n", "auxiliary/image", g_cc, z);
+      return 1;
+    }
+    num_tests++;
+  }
+  printf("%-16s%-8sPASS (%d tests)\n", "auxiliary/image", g_cc, num_tests);
+  return 0;
+}
@@ -0,0 +1,464 @@
+// Copyright 2022 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ----------------
+
+/*
+This test program exercises the C++ (not C) wuffs_aux::DecodeImageCache class,
+including from multiple threads. Unlike the test/c/std programs, it does not
+use test/c/testlib (which is C only).
+
+To manually run this test, from the repository's root directory:
+
+for CXX in clang++ g++; do
+  $CXX -std=c++11 -Wall -Werror -pthread test/c/auxiliary/imagecache.cc && \
+    ./a.out
+  rm -f a.out
+done
+
+Each edition should print "PASS", amongst other information, and exit(0).
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Wuffs ships as a "single file C library" or "header file library" as per
+// https://github.com/nothings/stb/blob/master/docs/stb_howto.txt
+//
+// To use that single file as a "foo.c"-like implementation, instead of a
+// "foo.h"-like header, #define WUFFS_IMPLEMENTATION before #include'ing or
+// compiling it.
+#define WUFFS_IMPLEMENTATION
+
+// Defining the WUFFS_CONFIG__MODULE* macros are optional, but it lets users of
+// release/c/etc.c choose which parts of Wuffs to build. That file contains the
+// entire Wuffs standard library, implementing a variety of codecs and file
+// formats. Without this macro definition, an optimizing compiler or linker may
+// very well discard Wuffs code for unused codecs, but listing the Wuffs
+// modules we use makes that process explicit. Preprocessing means that such
+// code simply isn't compiled.
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__AUX__BASE
+#define WUFFS_CONFIG__MODULE__AUX__IMAGE
+#define WUFFS_CONFIG__MODULE__AUX__IMAGECACHE
+#define WUFFS_CONFIG__MODULE__BASE
+#define WUFFS_CONFIG__MODULE__WBMP
+#define WUFFS_CONFIG__MODULE__XXHASH64
+
+// If building this program in an environment that doesn't easily accommodate
+// relative includes, you can use the script/inline-c-relative-includes.go
+// program to generate a stand-alone C file.
+#include "../../../release/c/wuffs-unsupported-snapshot.c"
+
+// The order matters here. Clang also defines "__GNUC__".
+#if defined(__clang__)
+const char* g_cc = "clang";
+#elif defined(__GNUC__)
+const char* g_cc = "gcc";
+#elif defined(_MSC_VER)
+const char* g_cc = "cl";
+#else
+const char* g_cc = "cc";
+#endif
+
+// g_fail_message holds the most recent test failure's message.
+std::string g_fail_message;
+
+#define CHECK(cond, ...)                                                      \
+  do {                                                                        \
+    if (!(cond)) {                                                            \
+      char fail_buf[1024];                                                    \
+      snprintf(fail_buf, sizeof fail_buf, "%s: ", __func__);                  \
+      size_t fail_n = strlen(fail_buf);                                       \
+      snprintf(fail_buf + fail_n, sizeof fail_buf - fail_n, __VA_ARGS__);     \
+      g_fail_message = fail_buf;                                              \
+      return g_fail_message.c_str();                                          \
+    }                                                                         \
+  } while (false)
+
+#define CHECK_STRING(string)       \
+  do {                             \
+    const char* z = (string);      \
+    if (z) {                       \
+      return z;                    \
+    }                              \
+  } while (false)
+
+// ---------------- Helpers
+
+// make_wbmp returns a width x height WBMP image (width and height must be
+// less than 128) whose pixels depend on seed. Decoded (to 4 bytes per pixel),
+// its pixel buffer is (4 * width * height) bytes long.
+std::vector<uint8_t>  //
+make_wbmp(uint32_t width, uint32_t height, uint32_t seed) {
+  std::vector<uint8_t> v = {0x00, 0x00, static_cast<uint8_t>(width),
+                            static_cast<uint8_t>(height)};
+  uint32_t x = (2 * seed) + 1;
+  for (uint32_t i = 0; i < (((width + 7) / 8) * height); i++) {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    v.push_back(static_cast<uint8_t>(x));
+  }
+  return v;
+}
+
+// CountingCallbacks counts the decodes (the SelectPixfmt calls) it is used
+// for. If gated, each decode also waits in SelectPixfmt until Open is called.
+class CountingCallbacks : public wuffs_aux::DecodeImageCallbacks {
+ public:
+  CountingCallbacks(bool gated) : m_num_decodes(0), m_open(!gated) {}
+
+  wuffs_base__pixel_format  //
+  SelectPixfmt(const wuffs_base__image_config& image_config) override {
+    m_num_decodes++;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_open) {
+      m_cond.wait(lock);
+    }
+    return wuffs_aux::DecodeImageCallbacks::SelectPixfmt(image_config);
+  }
+
+  void Open() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_open = true;
+    m_cond.notify_all();
+  }
+
+  std::atomic<int> m_num_decodes;
+
+ private:
+  std::mutex m_mutex;
+  std::condition_variable m_cond;
+  bool m_open;
+};
+
+// check_pixels checks that have holds the same pixels as decoding src
+// directly, without a cache.
+const char*  //
+check_pixels(const wuffs_aux::DecodeImageResult& have,
+             const std::vector<uint8_t>& src) {
+  wuffs_aux::DecodeImageCallbacks callbacks;
+  wuffs_aux::sync_io::MemoryInput input(src.data(), src.size());
+  wuffs_aux::DecodeImageResult want = wuffs_aux::DecodeImage(callbacks, input);
+  CHECK(want.error_message.empty(), "want: %s", want.error_message.c_str());
+  CHECK(have.error_message.empty(), "have: %s", have.error_message.c_str());
+  // plane is not a const method, so take a copy of the (shared) pixbuf.
+  wuffs_base__pixel_buffer have_pixbuf = have.pixbuf;
+  wuffs_base__table_u8 h = have_pixbuf.plane(0);
+  wuffs_base__table_u8 w = want.pixbuf.plane(0);
+  CHECK((h.width == w.width) && (h.height == w.height),
+        "dimensions: have %zux%zu, want %zux%zu", h.width, h.height, w.width,
+        w.height);
+  for (size_t y = 0; y < h.height; y++) {
+    CHECK(!memcmp(h.ptr + (y * h.stride), w.ptr + (y * w.stride), h.width),
+          "row %zu differs", y);
+  }
+  return nullptr;
+}
+
+// ---------------- Tests
+
+const char*  //
+test_wuffs_aux_imagecache_concurrent() {
+  // Many threads decode a mix of images (some repeated, some larger than a
+  // shard's share, some invalid) through one small, sharded cache. Every
+  // result should match an uncached decode and the counters should add up.
+  const uint32_t num_images = 40;
+  std::vector<std::vector<uint8_t> > images;
+  for (uint32_t i = 0; i < num_images; i++) {
+    if ((i % 10) == 9) {
+      images.push_back(std::vector<uint8_t>{0x00, 0x00, 0x08});
+    } else if ((i % 10) == 8) {
+      images.push_back(make_wbmp(100, 100, i));
+    } else {
+      images.push_back(make_wbmp(8 + (i % 5), 8, i));
+    }
+  }
+
+  // 4 shards of 2048 bytes each. A 100x100 image (40000 bytes) is too large
+  // to cache. Each shard holds a few of the smaller (256 to 384 byte) ones.
+  wuffs_aux::DecodeImageCache cache(8192, 4);
+  const int num_threads = 8;
+  const int num_calls_per_thread = 500;
+  std::vector<std::string> failures(num_threads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; t++) {
+    threads.emplace_back([&, t]() {
+      CountingCallbacks callbacks(false);
+      uint32_t x = static_cast<uint32_t>(t + 1) * 0x9E3779B9u;
+      for (int c = 0; c < num_calls_per_thread; c++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        // Favor the first few images, so that there are hits and evictions.
+        uint32_t i = (x % 4) ? ((x >> 8) % 8) : ((x >> 8) % num_images);
+        const std::vector<uint8_t>& src = images[i];
+        std::shared_ptr<const wuffs_aux::DecodeImageResult> result =
+            cache.DecodeImage(callbacks, 0, src.data(), src.size());
+        if (!result) {
+          failures[t] = "nullptr result";
+          return;
+        } else if ((i % 10) == 9) {
+          if (result->error_message.empty()) {
+            failures[t] = "invalid image decoded";
+            return;
+          }
+          continue;
+        }
+        const char* z = check_pixels(*result, src);
+        if (z) {
+          failures[t] = z;
+          return;
+        }
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  for (int t = 0; t < num_threads; t++) {
+    CHECK(failures[t].empty(), "t=%d: %s", t, failures[t].c_str());
+  }
+
+  wuffs_aux::DecodeImageCache::Stats stats = cache.GetStats();
+  uint64_t total = num_threads * num_calls_per_thread;
+  CHECK((stats.num_hits + stats.num_misses + stats.num_joins) == total,
+        "hits + misses + joins: have %zu, want %zu",
+        static_cast<size_t>(stats.num_hits + stats.num_misses +
+                            stats.num_joins),
+        static_cast<size_t>(total));
+  CHECK(stats.num_hits > 0, "num_hits: have 0");
+  CHECK(stats.num_evictions > 0, "num_evictions: have 0");
+  CHECK(stats.num_bytes <= 8192, "num_bytes: have %zu",
+        static_cast<size_t>(stats.num_bytes));
+  CHECK((stats.num_entries > 0) && (stats.num_entries <= (4 * 8)),
+        "num_entries: have %zu", static_cast<size_t>(stats.num_entries));
+
+  cache.Clear();
+  stats = cache.GetStats();
+  CHECK((stats.num_entries == 0) && (stats.num_bytes == 0),
+        "after Clear: have %zu entries, %zu bytes",
+        static_cast<size_t>(stats.num_entries),
+        static_cast<size_t>(stats.num_bytes));
+  return nullptr;
+}
+
+const char*  //
+test_wuffs_aux_imagecache_failures_are_not_cached() {
+  std::vector<uint8_t> good = make_wbmp(8, 8, 1);
+  std::vector<uint8_t> bad(good.begin(), good.begin() + 10);
+  wuffs_aux::DecodeImageCache cache(1 << 20, 1);
+  CountingCallbacks callbacks(false);
+
+  for (int i = 0; i < 3; i++) {
+    std::shared_ptr<const wuffs_aux::DecodeImageResult> result =
+        cache.DecodeImage(callbacks, 0, bad.data(), bad.size());
+    CHECK(!result->error_message.empty(), "i=%d: no error", i);
+  }
+  CHECK(callbacks.m_num_decodes == 3, "num_decodes: have %d, want 3",
+        callbacks.m_num_decodes.load());
+  wuffs_aux::DecodeImageCache::Stats stats = cache.GetStats();
+  CHECK((stats.num_hits == 0) && (stats.num_misses == 3) &&
+            (stats.num_entries == 0) && (stats.num_bytes == 0),
+        "stats: have %zu hits, %zu misses, %zu entries, %zu bytes",
+        static_cast<size_t>(stats.num_hits),
+        static_cast<size_t>(stats.num_misses),
+        static_cast<size_t>(stats.num_entries),
+        static_cast<size_t>(stats.num_bytes));
+
+  // Joined callers share a failed decode's result, but the next caller
+  // decodes again.
+  CountingCallbacks gated(true);
+  const int n = 6;
+  std::vector<std::shared_ptr<const wuffs_aux::DecodeImageResult> > results(n);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < n; t++) {
+    threads.emplace_back([&, t]() {
+      results[t] = cache.DecodeImage(gated, 0, bad.data(), bad.size());
+    });
+  }
+  while (cache.GetStats().num_joins < (n - 1)) {
+    std::this_thread::yield();
+  }
+  gated.Open();
+  for (auto& t : threads) {
+    t.join();
+  }
+  CHECK(gated.m_num_decodes == 1, "gated: num_decodes: have %d, want 1",
+        gated.m_num_decodes.load());
+  for (int t = 0; t < n; t++) {
+    CHECK(results[t].get() == results[0].get(), "t=%d: result not shared", t);
+    CHECK(!results[t]->error_message.empty(), "t=%d: no error", t);
+  }
+  cache.DecodeImage(callbacks, 0, bad.data(), bad.size());
+  CHECK(callbacks.m_num_decodes == 4, "num_decodes: have %d, want 4",
+        callbacks.m_num_decodes.load());
+
+  // A good image, at the same length, is still cached.
+  std::vector<uint8_t> also_good = make_wbmp(8, 8, 2);
+  for (int i = 0; i < 3; i++) {
+    cache.DecodeImage(callbacks, 0, also_good.data(), also_good.size());
+  }
+  CHECK(callbacks.m_num_decodes == 5, "num_decodes: have %d, want 5",
+        callbacks.m_num_decodes.load());
+  return nullptr;
+}
+
+const char*  //
+test_wuffs_aux_imagecache_lru_eviction() {
+  // One shard, with room for three 8x8 images (256 bytes each).
+  wuffs_aux::DecodeImageCache cache(3 * 256, 1);
+  CountingCallbacks callbacks(false);
+  std::vector<std::vector<uint8_t> > images;
+  for (uint32_t i = 0; i < 5; i++) {
+    images.push_back(make_wbmp(8, 8, i));
+  }
+  auto decode = [&](size_t i) {
+    return cache.DecodeImage(callbacks, 0, images[i].data(), images[i].size());
+  };
+
+  std::shared_ptr<const wuffs_aux::DecodeImageResult> held = decode(0);
+  decode(1);
+  decode(2);
+  CHECK(callbacks.m_num_decodes == 3, "num_decodes: have %d, want 3",
+        callbacks.m_num_decodes.load());
+
+  // Using image 0 makes image 1 the least recently used, so adding image 3
+  // evicts image 1 (not image 0).
+  decode(0);
+  decode(3);
+  wuffs_aux::DecodeImageCache::Stats stats = cache.GetStats();
+  CHECK((stats.num_hits == 1) && (stats.num_misses == 4) &&
+            (stats.num_evictions == 1) && (stats.num_entries == 3) &&
+            (stats.num_bytes == (3 * 256)),
+        "stats: have %zu hits, %zu misses, %zu evictions, %zu entries",
+        static_cast<size_t>(stats.num_hits),
+        static_cast<size_t>(stats.num_misses),
+        static_cast<size_t>(stats.num_evictions),
+        static_cast<size_t>(stats.num_entries));
+  int n = callbacks.m_num_decodes;
+  decode(0);
+  decode(2);
+  decode(3);
+  CHECK(callbacks.m_num_decodes == n, "images 0, 2 and 3 were not cached");
+  decode(1);
+  CHECK(callbacks.m_num_decodes == (n + 1), "image 1 was not evicted");
+
+  // The callbacks_key is part of the cache key.
+  cache.DecodeImage(callbacks, 1, images[3].data(), images[3].size());
+  CHECK(callbacks.m_num_decodes == (n + 2), "callbacks_key was ignored");
+
+  // An image larger than the shard's share is decoded but not cached, and
+  // does not evict anything.
+  std::vector<uint8_t> large = make_wbmp(16, 16, 9);
+  stats = cache.GetStats();
+  for (int i = 0; i < 2; i++) {
+    std::shared_ptr<const wuffs_aux::DecodeImageResult> result =
+        cache.DecodeImage(callbacks, 0, large.data(), large.size());
+    CHECK_STRING(check_pixels(*result, large));
+  }
+  CHECK(callbacks.m_num_decodes == (n + 4), "large image was cached");
+  CHECK(cache.GetStats().num_evictions == stats.num_evictions,
+        "large image evicted something");
+
+  // Evicted (or cleared) results stay valid while they are still held.
+  cache.Clear();
+  CHECK(cache.GetStats().num_entries == 0, "Clear left entries");
+  CHECK_STRING(check_pixels(*held, images[0]));
+  return nullptr;
+}
+
+const char*  //
+test_wuffs_aux_imagecache_single_flight() {
+  // The first caller decodes (blocking in SelectPixfmt until the others have
+  // all joined it) and the others share its result.
+  std::vector<uint8_t> src = make_wbmp(16, 8, 7);
+  wuffs_aux::DecodeImageCache cache(1 << 20);
+  CountingCallbacks gated(true);
+  const int n = 16;
+  std::vector<std::shared_ptr<const wuffs_aux::DecodeImageResult> > results(n);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < n; t++) {
+    threads.emplace_back([&, t]() {
+      results[t] = cache.DecodeImage(gated, 0, src.data(), src.size());
+    });
+  }
+  while (cache.GetStats().num_joins < (n - 1)) {
+    std::this_thread::yield();
+  }
+  gated.Open();
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  CHECK(gated.m_num_decodes == 1, "num_decodes: have %d, want 1",
+        gated.m_num_decodes.load());
+  for (int t = 0; t < n; t++) {
+    CHECK(results[t].get() == results[0].get(), "t=%d: result not shared", t);
+  }
+  CHECK_STRING(check_pixels(*results[0], src));
+
+  // The same bytes, at a different address, are a hit.
+  std::vector<uint8_t> copy(src);
+  std::shared_ptr<const wuffs_aux::DecodeImageResult> result =
+      cache.DecodeImage(gated, 0, copy.data(), copy.size());
+  CHECK(result.get() == results[0].get(), "copy: result not shared");
+  wuffs_aux::DecodeImageCache::Stats stats = cache.GetStats();
+  CHECK((stats.num_hits == 1) && (stats.num_misses == 1) &&
+            (stats.num_joins == (n - 1)) && (stats.num_entries == 1) &&
+            (stats.num_bytes == (16 * 8 * 4)),
+        "stats: have %zu hits, %zu misses, %zu joins, %zu entries",
+        static_cast<size_t>(stats.num_hits),
+        static_cast<size_t>(stats.num_misses),
+        static_cast<size_t>(stats.num_joins),
+        static_cast<size_t>(stats.num_entries));
+  return nullptr;
+}
+
+// ---------------- Manifest
+
+typedef const char* (*proc)();
+
+proc g_tests[] = {
+    test_wuffs_aux_imagecache_concurrent,
+    test_wuffs_aux_imagecache_failures_are_not_cached,
+    test_wuffs_aux_imagecache_lru_eviction,
+    test_wuffs_aux_imagecache_single_flight,
+    nullptr,
+};
+
+int  //
+main(int argc, char** argv) {
+  int num_tests = 0;
+  for (proc* p = g_tests; *p; p++) {
+    const char* z = (*p)();
+    if (z) {
+      printf("%-24s%-8sFAIL %s\n", "auxiliary/imagecache", g_cc, z);
+      return 1;
+    }
+    num_tests++;
+  }
+  printf("%-24s%-8sPASS (%d tests)\n", "auxiliary/imagecache", g_cc,
+         num_tests);
+  return 0;
+}
@@ -0,0 +1,672 @@
+// Copyright 2026 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ----------------
+
+/*
+This test program exercises the C++ (not C) wuffs_aux::DecodeJsonLines,
+wuffs_aux::DecodeJsonColumns and wuffs_aux::DecodeJsonLinesColumns functions,
+as well as wuffs_aux::DecodeJson reading through a
+wuffs_aux::sync_io::TransformInput. Unlike the test/c/std programs, it does
+not use test/c/testlib (which is C only).
+
+To manually run this test, from the repository's root directory:
+
+for CXX in clang++ g++; do
+  $CXX -std=c++11 -Wall -Werror -pthread test/c/auxiliary/json.cc && ./a.out
+  rm -f a.out
+done
+
+Each edition should print "PASS", amongst other information, and exit(0).
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Wuffs ships as a "single file C library" or "header file library" as per
+// https://github.com/nothings/stb/blob/master/docs/stb_howto.txt
+//
+// To use that single file as a "foo.c"-like implementation, instead of a
+// "foo.h"-like header, #define WUFFS_IMPLEMENTATION before #include'ing or
+// compiling it.
+#define WUFFS_IMPLEMENTATION
+
+// Defining the WUFFS_CONFIG__MODULE* macros are optional, but it lets users of
+// release/c/etc.c choose which parts of Wuffs to build. That file contains the
+// entire Wuffs standard library, implementing a variety of codecs and file
+// formats. Without this macro definition, an optimizing compiler or linker may
+// very well discard Wuffs code for unused codecs, but listing the Wuffs
+// modules we use makes that process explicit. Preprocessing means that such
+// code simply isn't compiled.
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__AUX__BASE
+#define WUFFS_CONFIG__MODULE__AUX__JSON
+#define WUFFS_CONFIG__MODULE__BASE
+#define WUFFS_CONFIG__MODULE__CRC32
+#define WUFFS_CONFIG__MODULE__DEFLATE
+#define WUFFS_CONFIG__MODULE__GZIP
+#define WUFFS_CONFIG__MODULE__JSON
+
+// If building this program in an environment that doesn't easily accommodate
+// relative includes, you can use the script/inline-c-relative-includes.go
+// program to generate a stand-alone C file.
+#include "../../../release/c/wuffs-unsupported-snapshot.c"
+
+// The order matters here. Clang also defines "__GNUC__".
+#if defined(__clang__)
+const char* g_cc = "clang";
+#elif defined(__GNUC__)
+const char* g_cc = "gcc";
+#elif defined(_MSC_VER)
+const char* g_cc = "cl";
+#else
+const char* g_cc = "cc";
+#endif
+
+// g_fail_message holds the most recent test failure's message.
+std::string g_fail_message;
+
+#define CHECK(cond, ...)                                                      \
+  do {                                                                        \
+    if (!(cond)) {                                                            \
+      char fail_buf[1024];                                                    \
+      snprintf(fail_buf, sizeof fail_buf, "%s: ", __func__);                  \
+      size_t fail_n = strlen(fail_buf);                                       \
+      snprintf(fail_buf + fail_n, sizeof fail_buf - fail_n, __VA_ARGS__);     \
+      g_fail_message = fail_buf;                                              \
+      return g_fail_message.c_str();                                          \
+    }                                                                         \
+  } while (false)
+
+#define CHECK_STRING(string)       \
+  do {                             \
+    const char* z = (string);      \
+    if (z) {                       \
+      return z;                    \
+    }                              \
+  } while (false)
+
+// ---------------- Helpers
+
+// Recorder is a DecodeJsonCallbacks that records the values it sees as a
+// compact, JSON-like string, such as {"k",[1,t,"x"]} (with a comma, not a
+// colon, after dict keys and with t, f and n for true, false and null).
+class Recorder : public wuffs_aux::DecodeJsonCallbacks {
+ public:
+  std::string m_s;
+
+  std::string AppendNull() override { return append("n"); }
+
+  std::string AppendBool(bool val) override { return append(val ? "t" : "f"); }
+
+  std::string AppendF64(double val) override {
+    char buf[64];
+    snprintf(buf, sizeof buf, "%g", val);
+    return append(buf);
+  }
+
+  std::string AppendI64(int64_t val) override {
+    return append(std::to_string(val));
+  }
+
+  std::string AppendTextString(std::string&& val) override {
+    return append("\"" + val + "\"");
+  }
+
+  std::string Push(uint32_t flags) override {
+    std::string z = append(
+        (flags & WUFFS_BASE__TOKEN__VBD__STRUCTURE__TO_DICT) ? "{" : "[");
+    m_need_comma = false;
+    return z;
+  }
+
+  std::string Pop(uint32_t flags) override {
+    m_s += (flags & WUFFS_BASE__TOKEN__VBD__STRUCTURE__FROM_DICT) ? "}" : "]";
+    m_need_comma = true;
+    return "";
+  }
+
+ private:
+  bool m_need_comma = false;
+
+  std::string append(const std::string& s) {
+    if (m_need_comma) {
+      m_s += ",";
+    }
+    m_s += s;
+    m_need_comma = true;
+    return "";
+  }
+};
+
+// DoneRecord is one DecodeJsonLinesCallbacks::RecordDone call's arguments.
+struct DoneRecord {
+  uint64_t index;
+  uint64_t position;
+  std::string error_message;
+  std::string value;
+};
+
+class LinesRecorder : public wuffs_aux::DecodeJsonLinesCallbacks {
+ public:
+  std::vector<DoneRecord> m_done;
+  uint64_t m_stop_after = UINT64_MAX;
+
+  std::unique_ptr<wuffs_aux::DecodeJsonCallbacks>  //
+  MakeRecordCallbacks(uint64_t record_index) override {
+    return std::unique_ptr<wuffs_aux::DecodeJsonCallbacks>(new Recorder());
+  }
+
+  std::string  //
+  RecordDone(uint64_t record_index,
+             uint64_t record_position,
+             wuffs_aux::DecodeJsonResult& result,
+             std::unique_ptr<wuffs_aux::DecodeJsonCallbacks> record_callbacks)
+      override {
+    m_done.push_back(DoneRecord{
+        record_index, record_position, result.error_message,
+        static_cast<Recorder*>(record_callbacks.get())->m_s});
+    return (m_done.size() >= m_stop_after) ? "stop!" : "";
+  }
+};
+
+// TrickleInput is an Input that does not bring its own IOBuffer and copies
+// in at most 7 bytes per CopyIn call.
+class TrickleInput : public wuffs_aux::sync_io::Input {
+ public:
+  TrickleInput(const std::vector<uint8_t>& src) : m_src(src), m_pos(0) {}
+
+  std::string CopyIn(wuffs_aux::IOBuffer* dst) override {
+    dst->compact();
+    size_t n = std::min(std::min(dst->writer_length(), m_src.size() - m_pos),
+                        static_cast<size_t>(7));
+    memcpy(dst->writer_pointer(), m_src.data() + m_pos, n);
+    m_pos += n;
+    dst->meta.wi += n;
+    dst->meta.closed = m_pos == m_src.size();
+    return "";
+  }
+
+ private:
+  const std::vector<uint8_t>& m_src;
+  size_t m_pos;
+};
+
+// gzip_encode returns src, compressed as a single gzip member.
+std::vector<uint8_t>  //
+gzip_encode(const std::string& src) {
+  wuffs_deflate__encoder::unique_ptr enc = wuffs_deflate__encoder::alloc();
+  enc->set_level(6);
+  std::vector<uint8_t> dst(src.size() + (src.size() / 8) + 65536);
+  static const uint8_t header[10] = {
+      0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF,
+  };
+  memcpy(dst.data(), header, 10);
+  wuffs_base__io_buffer d =
+      wuffs_base__ptr_u8__writer(dst.data() + 10, dst.size() - 18);
+  wuffs_base__io_buffer s = wuffs_base__ptr_u8__reader(
+      reinterpret_cast<uint8_t*>(const_cast<char*>(src.data())), src.size(),
+      true);
+  if (!enc->transform_io(&d, &s, wuffs_base__empty_slice_u8()).is_ok()) {
+    return std::vector<uint8_t>();
+  }
+  wuffs_crc32__ieee_hasher::unique_ptr hasher =
+      wuffs_crc32__ieee_hasher::alloc();
+  uint8_t* trailer = dst.data() + 10 + d.meta.wi;
+  wuffs_base__poke_u32le__no_bounds_check(
+      trailer + 0, hasher->update_u32(s.data));
+  wuffs_base__poke_u32le__no_bounds_check(trailer + 4,
+                                          static_cast<uint32_t>(src.size()));
+  dst.resize(10 + d.meta.wi + 8);
+  return dst;
+}
+
+// decode_json_gzip runs DecodeJson on src, decompressed by a TransformInput
+// and a wuffs_gzip__decoder. If trickle, src is read via a TrickleInput and a
+// small source buffer, instead of in place via a MemoryInput.
+wuffs_aux::DecodeJsonResult  //
+decode_json_gzip(Recorder& callbacks,
+                 const std::vector<uint8_t>& src,
+                 bool trickle) {
+  wuffs_gzip__decoder::unique_ptr dec = wuffs_gzip__decoder::alloc();
+  wuffs_aux::sync_io::MemoryInput memory_input(src.data(), src.size());
+  TrickleInput trickle_input(src);
+  wuffs_aux::sync_io::TransformInput input(
+      trickle ? static_cast<wuffs_aux::sync_io::Input&>(trickle_input)
+              : static_cast<wuffs_aux::sync_io::Input&>(memory_input),
+      dec->upcast_as__wuffs_base__io_transformer(),
+      trickle ? 16 : 0);
+  return wuffs_aux::DecodeJson(callbacks, input);
+}
+
+// column_string returns a JsonColumn's rows as a '|'-separated string, such
+// as "1|null|3" (with t and f for true and false).
+std::string  //
+column_string(const wuffs_aux::JsonColumn& column, size_t num_rows) {
+  std::string s;
+  for (size_t i = 0; i < num_rows; i++) {
+    if (i > 0) {
+      s += "|";
+    }
+    if ((i >= column.m_valid.size()) || !column.m_valid[i]) {
+      s += "null";
+      continue;
+    }
+    char buf[64];
+    switch (column.m_type) {
+      case wuffs_aux::JsonColumn::I64:
+        s += std::to_string(column.m_i64s[i]);
+        break;
+      case wuffs_aux::JsonColumn::F64:
+        snprintf(buf, sizeof buf, "%g", column.m_f64s[i]);
+        s += buf;
+        break;
+      case wuffs_aux::JsonColumn::Bool:
+        s += column.m_bools[i] ? "t" : "f";
+        break;
+      case wuffs_aux::JsonColumn::TextString:
+        s += "\"" +
+             column.m_arena.substr(
+                 static_cast<size_t>(column.m_string_offsets[i]),
+                 static_cast<size_t>(column.m_string_offsets[i + 1] -
+                                     column.m_string_offsets[i])) +
+             "\"";
+        break;
+    }
+  }
+  return s;
+}
+
+// check_column_sizes checks that every column has exactly one element per
+// row in its used arrays, and none in its unused ones.
+const char*  //
+check_column_sizes(const wuffs_aux::JsonColumns& columns) {
+  size_t n = columns.m_num_rows;
+  for (size_t c = 0; c < columns.m_columns.size(); c++) {
+    const wuffs_aux::JsonColumn& column = columns.m_columns[c];
+    uint32_t t = column.m_type;
+    CHECK((column.m_valid.size() == n) &&
+              (column.m_i64s.size() == ((t == column.I64) ? n : 0)) &&
+              (column.m_f64s.size() == ((t == column.F64) ? n : 0)) &&
+              (column.m_bools.size() == ((t == column.Bool) ? n : 0)) &&
+              (column.m_string_offsets.size() ==
+               ((t == column.TextString) ? (n + 1) : 0)),
+          "c=%zu: sizes do not match num_rows=%zu", c, n);
+    CHECK((t != column.TextString) ||
+              (column.m_arena.size() == column.m_string_offsets.back()),
+          "c=%zu: arena size mismatch", c);
+  }
+  return nullptr;
+}
+
+// ---------------- Tests
+
+const char*  //
+test_wuffs_aux_json_decode_json_lines_order() {
+  // Build enough records (over 64 KiB each per worker thread) to use several
+  // threads. Every 37th record is much longer than the rest, so that records
+  // are likely (but not guaranteed) to complete out of order.
+  std::string src;
+  std::vector<std::string> want_values;
+  std::vector<uint64_t> want_positions;
+  for (int i = 0; i < 6000; i++) {
+    want_positions.push_back(src.size());
+    std::string value = "{\"id\"," + std::to_string(i) + ",\"xs\",[";
+    src += "{\"id\":" + std::to_string(i) + ",\"xs\":[";
+    int n = ((i % 37) == 0) ? 2000 : 3;
+    for (int j = 0; j < n; j++) {
+      value += (j ? "," : "") + std::to_string(j);
+      src += (j ? ", " : "") + std::to_string(j);
+    }
+    want_values.push_back(value + "]}");
+    src += "]}\n";
+  }
+
+  for (int in_input_order = 0; in_input_order < 2; in_input_order++) {
+    for (uint32_t num_threads = 1; num_threads <= 4; num_threads++) {
+      LinesRecorder callbacks;
+      std::string error_message = wuffs_aux::DecodeJsonLines(
+          callbacks, reinterpret_cast<const uint8_t*>(src.data()), src.size(),
+          wuffs_aux::DecodeJsonArgQuirks::DefaultValue(), in_input_order != 0,
+          num_threads);
+      CHECK(error_message.empty(), "in_input_order=%d, num_threads=%u: %s",
+            in_input_order, num_threads, error_message.c_str());
+      CHECK(callbacks.m_done.size() == want_values.size(),
+            "in_input_order=%d, num_threads=%u: size: have %zu, want %zu",
+            in_input_order, num_threads, callbacks.m_done.size(),
+            want_values.size());
+
+      // In input order, RecordDone's record_index counts up. Otherwise, each
+      // record_index is seen exactly once.
+      std::vector<uint8_t> seen(want_values.size());
+      for (size_t k = 0; k < callbacks.m_done.size(); k++) {
+        const DoneRecord& d = callbacks.m_done[k];
+        CHECK(!in_input_order || (d.index == k),
+              "in_input_order=%d, num_threads=%u: k=%zu: index: have %zu",
+              in_input_order, num_threads, k, static_cast<size_t>(d.index));
+        CHECK((d.index < seen.size()) && !seen[d.index],
+              "in_input_order=%d, num_threads=%u: k=%zu: bad index %zu",
+              in_input_order, num_threads, k, static_cast<size_t>(d.index));
+        seen[d.index] = 1;
+        CHECK(d.error_message.empty() && (d.value == want_values[d.index]) &&
+                  (d.position == want_positions[d.index]),
+              "in_input_order=%d, num_threads=%u: index=%zu: mismatch",
+              in_input_order, num_threads, static_cast<size_t>(d.index));
+      }
+    }
+  }
+
+  // A RecordDone error stops DecodeJsonLines.
+  for (uint32_t num_threads = 1; num_threads <= 4; num_threads++) {
+    LinesRecorder callbacks;
+    callbacks.m_stop_after = 100;
+    std::string error_message = wuffs_aux::DecodeJsonLines(
+        callbacks, reinterpret_cast<const uint8_t*>(src.data()), src.size(),
+        wuffs_aux::DecodeJsonArgQuirks::DefaultValue(), true, num_threads);
+    CHECK(error_message == "stop!", "num_threads=%u: have \"%s\"", num_threads,
+          error_message.c_str());
+    CHECK(callbacks.m_done.size() == 100, "num_threads=%u: size: have %zu",
+          num_threads, callbacks.m_done.size());
+  }
+  return nullptr;
+}
+
+const char*  //
+test_wuffs_aux_json_decode_json_lines_splitter() {
+  // Each '\n' inside a JSON string (escaped or not) is not a record
+  // separator. A raw '\n' inside a string is invalid JSON, so that record
+  // fails, but the records after it are still found.
+  static const char src[] =
+      "{\"k\": \"a\\\"b\\n\"}\n"  // An escaped '"' and an escaped 'n'.
+      "\n"                       // A blank line.
+      " \t \r\n"                 // A whitespace-only line.
+      "[\"\\\\\", 1]\n"          // A string that ends with an escaped '\\'.
+      "\"line\nbreak\"\n"        // A raw '\n' inside a string.
+      "12 34\n"                  // Trailing data.
+      "  [true]  ";              // No final '\n'.
+
+  struct {
+    uint64_t position;
+    const char* error_message;
+    const char* value;
+  } want[] = {
+      {0, "", "{\"k\",\"a\"b\n\"}"},
+      {22, "", "[\"\\\",1]"},
+      {32, wuffs_json__error__bad_new_line_in_a_string + 1, nullptr},
+      {45, wuffs_aux::DecodeJsonLines_TrailingData, "12"},
+      {51, "", "[t]"},
+  };
+  size_t num_want = sizeof want / sizeof want[0];
+
+  LinesRecorder callbacks;
+  std::string error_message = wuffs_aux::DecodeJsonLines(
+      callbacks, reinterpret_cast<const uint8_t*>(src), strlen(src));
+  CHECK(error_message.empty(), "%s", error_message.c_str());
+  CHECK(callbacks.m_done.size() == num_want, "size: have %zu, want %zu",
+        callbacks.m_done.size(), num_want);
+  for (size_t i = 0; i < num_want; i++) {
+    const DoneRecord& d = callbacks.m_done[i];
+    CHECK(d.index == i, "i=%zu: index: have %zu", i,
+          static_cast<size_t>(d.index));
+    CHECK(d.position == want[i].position, "i=%zu: position: have %zu, want %zu",
+          i, static_cast<size_t>(d.position),
+          static_cast<size_t>(want[i].position));
+    CHECK(d.error_message == want[i].error_message,
+          "i=%zu: error_message: have \"%s\", want \"%s\"", i,
+          d.error_message.c_str(), want[i].error_message);
+    CHECK(!want[i].value || (d.value == want[i].value),
+          "i=%zu: value: have %s, want %s", i, d.value.c_str(), want[i].value);
+  }
+  return nullptr;
+}
+
+const char*  //
+test_wuffs_aux_json_decode_json_columns() {
+  // Columns whose JSON Pointers share prefixes ("/a", "/ab" and "/a/b") share
+  // trie nodes (or not). "/c/1" indexes into a list and "/d~1e" unescapes to
+  // a "d/e" key. "/x/y" never matches and the sub-trees under "z" (which no
+  // JSON Pointer reaches into) are skipped.
+  wuffs_aux::JsonColumns columns;
+  const struct {
+    const char* json_pointer;
+    uint32_t type;
+    const char* want;
+  } cols[] = {
+      {"/a", wuffs_aux::JsonColumn::I64, "null|7|null"},
+      {"/a/b", wuffs_aux::JsonColumn::I64, "5|null|null"},
+      {"/a/b", wuffs_aux::JsonColumn::F64, "5|null|-8.5"},
+      {"/ab", wuffs_aux::JsonColumn::TextString, "\"str\"|\"\"|null"},
+      {"/ab", wuffs_aux::JsonColumn::I64, "null|null|null"},
+      {"/c/1", wuffs_aux::JsonColumn::Bool, "t|null|f"},
+      {"/d~1e", wuffs_aux::JsonColumn::F64, "1.5|2|null"},
+      {"/x/y", wuffs_aux::JsonColumn::Bool, "null|null|null"},
+  };
+  for (const auto& col : cols) {
+    columns.add_column(col.json_pointer, col.type);
+  }
+
+  // In the third row, "/a/b" is -8.5, which is not an integer, so it is null
+  // in the I64 column. Likewise, a JSON string or null is null in an I64
+  // column. Duplicate keys take the first match.
+  static const char* rows[] = {
+      "{\"a\": {\"b\": 5}, \"ab\": \"str\", \"c\": [0, true],"
+      " \"d/e\": 1.5, \"z\": {\"a\": [{\"b\": 6}]}}",
+      "{\"z\": [[[]]], \"a\": 7, \"a\": 8, \"ab\": \"\","
+      " \"d/e\": 2, \"c\": {\"1\": 3}}",
+      "{\"a\": {\"b\": -8.5, \"b\": 9}, \"ab\": null, \"c\": [{}, false],"
+      " \"x\": [1]}",
+  };
+  for (const char* row : rows) {
+    wuffs_aux::sync_io::MemoryInput input(row, strlen(row));
+    wuffs_aux::DecodeJsonResult result =
+        wuffs_aux::DecodeJsonColumns(columns, input);
+    CHECK(result.error_message.empty(), "%s", result.error_message.c_str());
+    CHECK(result.cursor_position == strlen(row),
+          "cursor_position: have %zu, want %zu",
+          static_cast<size_t>(result.cursor_position), strlen(row));
+  }
+  CHECK(columns.m_num_rows == 3, "m_num_rows: have %zu, want 3",
+        columns.m_num_rows);
+  CHECK_STRING(check_column_sizes(columns));
+  for (size_t c = 0; c < columns.m_columns.size(); c++) {
+    std::string have = column_string(columns.m_columns[c], 3);
+    CHECK(have == cols[c].want, "c=%zu (%s): have %s, want %s", c,
+          cols[c].json_pointer, have.c_str(), cols[c].want);
+  }
+
+  // A row that fails to decode, even after some columns have taken a value
+  // (including a string, which grows the arena), is rolled back.
+  static const char* bad_rows[] = {
+      "{\"ab\": \"abandoned\", \"a\": {\"b\": 1}, \"c\": [0, true}",
+      "{\"ab\": \"abandoned\", \"a\": 1",
+  };
+  for (const char* row : bad_rows) {
+    wuffs_aux::sync_io::MemoryInput input(row, strlen(row));
+    wuffs_aux::DecodeJsonResult result =
+        wuffs_aux::DecodeJsonColumns(columns, input);
+    CHECK(!result.error_message.empty(), "\"%s\": no error", row);
+    CHECK(columns.m_num_rows == 3, "m_num_rows: have %zu, want 3",
+          columns.m_num_rows);
+    CHECK_STRING(check_column_sizes(columns));
+    for (size_t c = 0; c < columns.m_columns.size(); c++) {
+      std::string have = column_string(columns.m_columns[c], 3);
+      CHECK(have == cols[c].want, "c=%zu (%s): have %s, want %s", c,
+            cols[c].json_pointer, have.c_str(), cols[c].want);
+    }
+  }
+
+  // A bad JSON Pointer fails without decoding anything.
+  columns.add_column("no/leading/slash", wuffs_aux::JsonColumn::I64);
+  wuffs_aux::sync_io::MemoryInput input(rows[0], strlen(rows[0]));
+  wuffs_aux::DecodeJsonResult result =
+      wuffs_aux::DecodeJsonColumns(columns, input);
+  CHECK(result.error_message == wuffs_aux::DecodeJson_BadJsonPointer,
+        "bad JSON Pointer: have \"%s\"", result.error_message.c_str());
+  CHECK(columns.m_num_rows == 3, "m_num_rows: have %zu, want 3",
+        columns.m_num_rows);
+  return nullptr;
+}
+
+const char*  //
+test_wuffs_aux_json_decode_json_lines_columns() {
+  wuffs_aux::JsonColumns columns;
+  columns.add_column("/n", wuffs_aux::JsonColumn::I64);
+  columns.add_column("/s", wuffs_aux::JsonColumn::TextString);
+
+  static const char good[] =
+      "{\"n\": 1, \"s\": \"one\"}\n"
+      "\n"
+      "{\"s\": \"line\\nbreak\", \"n\": \"2\"}\n"
+      "  {\"n\": 3}  ";
+  wuffs_aux::DecodeJsonResult result = wuffs_aux::DecodeJsonLinesColumns(
+      columns, reinterpret_cast<const uint8_t*>(good), strlen(good));
+  CHECK(result.error_message.empty(), "good: %s",
+        result.error_message.c_str());
+  CHECK(result.cursor_position == strlen(good),
+        "good: cursor_position: have %zu, want %zu",
+        static_cast<size_t>(result.cursor_position), strlen(good));
+  CHECK(columns.m_num_rows == 3, "good: m_num_rows: have %zu, want 3",
+        columns.m_num_rows);
+  CHECK_STRING(check_column_sizes(columns));
+  std::string have = column_string(columns.m_columns[0], 3) + " " +
+                     column_string(columns.m_columns[1], 3);
+  const char* want = "1|null|3 \"one\"|\"line\nbreak\"|null";
+  CHECK(have == want, "good: have %s, want %s", have.c_str(), want);
+
+  // The rows for the records before a failed one are kept, including when
+  // the failure (trailing data) is only found after the record's value.
+  const struct {
+    const char* src;
+    uint64_t want_cursor_position;
+    const char* want_error_message;
+  } cases[] = {
+      {"{\"n\": 4}\n{\"n\": 5, \"s\": \"x\"} 6\n{\"n\": 7}", 28,
+       wuffs_aux::DecodeJsonLines_TrailingData},
+      {"{\"n\": 4}\n{\"n\": 5, \"s\": \"x\", }\n{\"n\": 7}", 28,
+       wuffs_json__error__bad_input + 1},
+  };
+  for (const auto& c : cases) {
+    columns.reset();
+    result = wuffs_aux::DecodeJsonLinesColumns(
+        columns, reinterpret_cast<const uint8_t*>(c.src), strlen(c.src));
+    CHECK(result.error_message == c.want_error_message,
+          "\"%s\": have \"%s\", want \"%s\"", c.src,
+          result.error_message.c_str(), c.want_error_message);
+    CHECK(result.cursor_position == c.want_cursor_position,
+          "\"%s\": cursor_position: have %zu, want %zu", c.src,
+          static_cast<size_t>(result.cursor_position),
+          static_cast<size_t>(c.want_cursor_position));
+    CHECK(columns.m_num_rows == 1, "\"%s\": m_num_rows: have %zu, want 1",
+          c.src, columns.m_num_rows);
+    CHECK_STRING(check_column_sizes(columns));
+    have = column_string(columns.m_columns[0], 1) + " " +
+           column_string(columns.m_columns[1], 1);
+    CHECK(have == "4 null", "\"%s\": have %s, want 4 null", c.src,
+          have.c_str());
+  }
+  return nullptr;
+}
+
+const char*  //
+test_wuffs_aux_json_decode_json_transform_input() {
+  // Build a document that decompresses to several times DecodeJson's
+  // (and the gzip decoder's) buffer sizes, so that it takes many CopyIn calls.
+  std::string json = "[";
+  for (int i = 0; i < 20000; i++) {
+    json += (i > 0) ? ",\n" : "\n";
+    json += "{\"i\":" + std::to_string(i) + ",\"s\":\"" +
+            std::string(static_cast<size_t>(i % 23), 'a' + (i % 26)) +
+            "\",\"b\":" + ((i % 3) ? "true" : "null") + "}";
+  }
+  json += "\n]\n";
+  CHECK(json.size() > 400000, "json.size(): have %zu", json.size());
+
+  Recorder want;
+  wuffs_aux::sync_io::MemoryInput plain_input(json.data(), json.size());
+  wuffs_aux::DecodeJsonResult result = wuffs_aux::DecodeJson(want, plain_input);
+  CHECK(result.error_message.empty(), "plain: %s",
+        result.error_message.c_str());
+
+  std::vector<uint8_t> gz = gzip_encode(json);
+  CHECK(!gz.empty(), "gzip_encode failed");
+  CHECK(gz.size() < (json.size() / 4), "gz.size(): have %zu, json.size() %zu",
+        gz.size(), json.size());
+
+  for (int trickle = 0; trickle < 2; trickle++) {
+    Recorder have;
+    result = decode_json_gzip(have, gz, trickle);
+    CHECK(result.error_message.empty(), "trickle=%d: %s", trickle,
+          result.error_message.c_str());
+    CHECK(result.cursor_position == (json.size() - 1),
+          "trickle=%d: cursor_position: have %zu, want %zu", trickle,
+          static_cast<size_t>(result.cursor_position), json.size() - 1);
+    CHECK(have.m_s == want.m_s, "trickle=%d: recorded values differ", trickle);
+
+    // Truncating the compressed source is an error (from the TransformInput,
+    // not from the JSON decoder).
+    std::vector<uint8_t> truncated(gz.begin(), gz.begin() + (gz.size() / 2));
+    Recorder have_truncated;
+    result = decode_json_gzip(have_truncated, truncated, trickle);
+    CHECK(result.error_message ==
+              "wuffs_aux::sync_io::TransformInput: unexpected end of file",
+          "trickle=%d: truncated: have \"%s\"", trickle,
+          result.error_message.c_str());
+
+    // So is a bad gzip header.
+    std::vector<uint8_t> bad_header(gz);
+    bad_header[2] = 0x07;
+    Recorder have_bad_header;
+    result = decode_json_gzip(have_bad_header, bad_header, trickle);
+    CHECK(result.error_message ==
+              (wuffs_gzip__error__bad_compression_method + 1),
+          "trickle=%d: bad_header: have \"%s\"", trickle,
+          result.error_message.c_str());
+    CHECK(have_bad_header.m_s.empty(), "trickle=%d: bad_header: have %s",
+          trickle, have_bad_header.m_s.c_str());
+  }
+  return nullptr;
+}
+
+// ---------------- Manifest
+
+typedef const char* (*proc)();
+
+proc g_tests[] = {
+    test_wuffs_aux_json_decode_json_columns,
+    test_wuffs_aux_json_decode_json_lines_columns,
+    test_wuffs_aux_json_decode_json_lines_order,
+    test_wuffs_aux_json_decode_json_lines_splitter,
+    test_wuffs_aux_json_decode_json_transform_input,
+    nullptr,
+};
+
+int  //
+main(int argc, char** argv) {
+  int num_tests = 0;
+  for (proc* p = g_tests; *p; p++) {
+    const char* z = (*p)();
+    if (z) {
+      printf("%-16s%-8sFAIL %s\n", "auxiliary/json", g_cc, z);
+      return 1;
+    }
+    num_tests++;
+  }
+  printf("%-16s%-8sPASS (%d tests)\n", "auxiliary/json", g_cc, num_tests);
+  return 0;
+}
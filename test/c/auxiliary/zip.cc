@@ -0,0 +1,545 @@
+// Copyright 2022 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ----------------
+
+/*
+This test program exercises the C++ (not C) wuffs_aux::ZipReader class. Unlike
+the test/c/std programs, it does not use test/c/testlib (which is C only).
+
+To manually run this test, from the repository's root directory:
+
+for CXX in clang++ g++; do
+  $CXX -std=c++11 -Wall -Werror -pthread test/c/auxiliary/zip.cc && ./a.out
+  rm -f a.out
+done
+
+Each edition should print "PASS", amongst other information, and exit(0).
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+// Wuffs ships as a "single file C library" or "header file library" as per
+// https://github.com/nothings/stb/blob/master/docs/stb_howto.txt
+//
+// To use that single file as a "foo.c"-like implementation, instead of a
+// "foo.h"-like header, #define WUFFS_IMPLEMENTATION before #include'ing or
+// compiling it.
+#define WUFFS_IMPLEMENTATION
+
+// Defining the WUFFS_CONFIG__MODULE* macros are optional, but it lets users of
+// release/c/etc.c choose which parts of Wuffs to build. That file contains the
+// entire Wuffs standard library, implementing a variety of codecs and file
+// formats. Without this macro definition, an optimizing compiler or linker may
+// very well discard Wuffs code for unused codecs, but listing the Wuffs
+// modules we use makes that process explicit. Preprocessing means that such
+// code simply isn't compiled.
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__AUX__BASE
+#define WUFFS_CONFIG__MODULE__AUX__ZIP
+#define WUFFS_CONFIG__MODULE__BASE
+#define WUFFS_CONFIG__MODULE__CRC32
+#define WUFFS_CONFIG__MODULE__DEFLATE
+
+// If building this program in an environment that doesn't easily accommodate
+// relative includes, you can use the script/inline-c-relative-includes.go
+// program to generate a stand-alone C file.
+#include "../../../release/c/wuffs-unsupported-snapshot.c"
+
+// The order matters here. Clang also defines "__GNUC__".
+#if defined(__clang__)
+const char* g_cc = "clang";
+#elif defined(__GNUC__)
+const char* g_cc = "gcc";
+#elif defined(_MSC_VER)
+const char* g_cc = "cl";
+#else
+const char* g_cc = "cc";
+#endif
+
+// g_fail_message holds the most recent test failure's message.
+std::string g_fail_message;
+
+#define CHECK(cond, ...)                                                      \
+  do {                                                                        \
+    if (!(cond)) {                                                            \
+      char fail_buf[1024];                                                    \
+      snprintf(fail_buf, sizeof fail_buf, "%s: ", __func__);                  \
+      size_t fail_n = strlen(fail_buf);                                       \
+      snprintf(fail_buf + fail_n, sizeof fail_buf - fail_n, __VA_ARGS__);     \
+      g_fail_message = fail_buf;                                              \
+      return g_fail_message.c_str();                                          \
+    }                                                                         \
+  } while (false)
+
+#define CHECK_STRING(string)       \
+  do {                             \
+    const char* z = (string);      \
+    if (z) {                       \
+      return z;                    \
+    }                              \
+  } while (false)
+
+// ---------------- Helpers
+
+const char*  //
+read_file(std::vector<uint8_t>& dst, const char* path) {
+  FILE* f = fopen(path, "rb");
+  if (!f) {
+    g_fail_message = std::string("read_file: could not open ") + path;
+    return g_fail_message.c_str();
+  }
+  uint8_t buf[4096];
+  while (true) {
+    size_t n = fread(buf, 1, sizeof buf, f);
+    dst.insert(dst.end(), buf, buf + n);
+    if (n < sizeof buf) {
+      break;
+    }
+  }
+  bool ok = !ferror(f);
+  fclose(f);
+  if (!ok) {
+    g_fail_message = std::string("read_file: could not read ") + path;
+    return g_fail_message.c_str();
+  }
+  return nullptr;
+}
+
+// WantEntry is what test/data/archive.zip's central directory should hold.
+struct WantEntry {
+  const char* name;
+  uint64_t local_header_offset;
+  uint64_t compressed_size;
+  uint64_t uncompressed_size;
+  uint32_t crc32;
+  uint16_t method;
+};
+
+const WantEntry g_archive_zip_entries[] = {
+    {"artificial/0.bytes", 0, 0, 0, 0x00000000, 0},
+    {"github-tags.json", 76, 270, 853, 0xFEDD8F35, 8},
+    {"hello.sh", 420, 422, 693, 0x87EE5E05, 8},
+    {"non-ascii/\xCE\xB1\xCE\xB2.txt", 908, 72, 104, 0x703E9270, 8},
+    {"non-ascii/\xF0\x9F\x98\xBB.txt", 1056, 145, 151, 0xC37CB538, 8},
+    {"pjw-thumbnail.png", 1277, 205, 208, 0x2B0B23B0, 8},
+    {"romeo.txt", 1557, 530, 942, 0xABE507EF, 8},
+    {"romeo.txt.gz", 2154, 558, 558, 0x67FABE9C, 0},
+};
+
+// check_extract_result checks that result holds the contents of the
+// test/data file named by the index'th entry. The archive's artificial/0.bytes
+// member has no such file: it is empty.
+const char*  //
+check_extract_result(const wuffs_aux::ZipReader& zr,
+                     size_t index,
+                     const wuffs_aux::ZipExtractResult& result) {
+  const wuffs_aux::ZipEntry& e = zr.entry(index);
+  std::string name(e.name_ptr, e.name_len);
+  std::vector<uint8_t> want;
+  if (name != "artificial/0.bytes") {
+    CHECK_STRING(read_file(want, ("test/data/" + name).c_str()));
+  }
+  CHECK(result.error_message.empty(), "%s: %s", name.c_str(),
+        result.error_message.c_str());
+  CHECK(result.data_len == want.size(), "%s: data_len: have %zu, want %zu",
+        name.c_str(), result.data_len, want.size());
+  CHECK((want.empty() || !memcmp(result.data_ptr, want.data(), want.size())),
+        "%s: contents differ", name.c_str());
+  return nullptr;
+}
+
+// data_offset returns the offset of the member data after the local file
+// header at lho, whose name and extra field lengths are at lho + 26 and 28.
+size_t  //
+data_offset(const std::vector<uint8_t>& archive, size_t lho) {
+  return lho + 30 +
+         wuffs_base__peek_u16le__no_bounds_check(archive.data() + lho + 26) +
+         wuffs_base__peek_u16le__no_bounds_check(archive.data() + lho + 28);
+}
+
+// ---------------- Tests
+
+const char*  //
+test_wuffs_aux_zip_bad_checksum() {
+  std::vector<uint8_t> archive;
+  CHECK_STRING(read_file(archive, "test/data/archive.zip"));
+
+  // Corrupt one byte of a stored member's data and the central directory's
+  // CRC-32 of a deflated one. The CRC-32 field is 30 bytes before the name.
+  archive[data_offset(archive, 2154) + 100] ^= 0x01;
+  {
+    wuffs_aux::ZipReader zr(archive.data(), archive.size());
+    size_t i = zr.Find("romeo.txt");
+    CHECK(i != zr.npos, "Find(romeo.txt) failed");
+    archive[static_cast<size_t>(
+        reinterpret_cast<const uint8_t*>(zr.entry(i).name_ptr) - 30 -
+        archive.data())] ^= 0x01;
+  }
+
+  for (int ignore = 0; ignore < 2; ignore++) {
+    wuffs_aux::ZipReader zr(
+        archive.data(), archive.size(),
+        ignore ? wuffs_aux::ZipReader::FLAG_IGNORE_CHECKSUM : 0);
+    CHECK(zr.error_message().empty(), "ignore=%d: %s", ignore,
+          zr.error_message().c_str());
+    std::vector<uint8_t> buffer;
+    for (const char* name : {"romeo.txt", "romeo.txt.gz"}) {
+      size_t i = zr.Find(name);
+      wuffs_aux::ZipExtractResult result = zr.Extract(i, buffer);
+      if (!ignore) {
+        CHECK(result.error_message == wuffs_aux::ZipReader_BadChecksum,
+              "ignore=%d: %s: have \"%s\"", ignore, name,
+              result.error_message.c_str());
+        CHECK(!result.data_ptr && !result.data_len,
+              "ignore=%d: %s: have data", ignore, name);
+      } else if (!strcmp(name, "romeo.txt")) {
+        CHECK_STRING(check_extract_result(zr, i, result));
+      } else {
+        CHECK(result.error_message.empty() && (result.data_len == 558),
+              "ignore=%d: %s: have \"%s\", %zu", ignore, name,
+              result.error_message.c_str(), result.data_len);
+      }
+    }
+
+    // The other members are unaffected.
+    size_t i = zr.Find("hello.sh");
+    CHECK_STRING(check_extract_result(zr, i, zr.Extract(i, buffer)));
+  }
+  return nullptr;
+}
+
+const char*  //
+test_wuffs_aux_zip_central_directory() {
+  std::vector<uint8_t> archive;
+  CHECK_STRING(read_file(archive, "test/data/archive.zip"));
+  wuffs_aux::ZipReader zr(archive.data(), archive.size());
+  CHECK(zr.error_message().empty(), "%s", zr.error_message().c_str());
+
+  const size_t n =
+      sizeof g_archive_zip_entries / sizeof g_archive_zip_entries[0];
+  CHECK(zr.num_entries() == n, "num_entries: have %zu, want %zu",
+        zr.num_entries(), n);
+  for (size_t i = 0; i < n; i++) {
+    const WantEntry& want = g_archive_zip_entries[i];
+    const wuffs_aux::ZipEntry& e = zr.entry(i);
+    CHECK(std::string(e.name_ptr, e.name_len) == want.name,
+          "i=%zu: name: have \"%.*s\", want \"%s\"", i,
+          static_cast<int>(e.name_len), e.name_ptr, want.name);
+    CHECK((e.local_header_offset == want.local_header_offset) &&
+              (e.compressed_size == want.compressed_size) &&
+              (e.uncompressed_size == want.uncompressed_size) &&
+              (e.crc32 == want.crc32) && (e.flags == 0) &&
+              (e.method == want.method),
+          "i=%zu (%s): fields do not match", i, want.name);
+
+    // Names point into the archive's bytes.
+    CHECK((reinterpret_cast<const uint8_t*>(e.name_ptr) >= archive.data()) &&
+              (reinterpret_cast<const uint8_t*>(e.name_ptr) + e.name_len <=
+               archive.data() + archive.size()),
+          "i=%zu: name_ptr is outside the archive", i);
+  }
+
+  // Truncating the archive (or not having one) loses the EOCD record.
+  size_t lens[4] = {0, 21, 1000, archive.size() - 1};
+  for (size_t len : lens) {
+    wuffs_aux::ZipReader truncated(archive.data(), len);
+    CHECK(truncated.error_message() == wuffs_aux::ZipReader_BadArchive,
+          "len=%zu: have \"%s\"", len, truncated.error_message().c_str());
+    CHECK(truncated.num_entries() == 0, "len=%zu: num_entries: have %zu", len,
+          truncated.num_entries());
+    CHECK(truncated.Find("hello.sh") == truncated.npos,
+          "len=%zu: Find succeeded", len);
+  }
+  wuffs_aux::ZipReader null_archive(nullptr, 1000);
+  CHECK(null_archive.error_message() == wuffs_aux::ZipReader_BadArchive,
+        "nullptr: have \"%s\"", null_archive.error_message().c_str());
+
+  // Encrypted members are listed but cannot be extracted.
+  std::vector<uint8_t> encrypted;
+  CHECK_STRING(
+      read_file(encrypted, "test/data/archive.password-is-asdf.zip"));
+  wuffs_aux::ZipReader zr_encrypted(encrypted.data(), encrypted.size());
+  CHECK(zr_encrypted.error_message().empty(), "encrypted: %s",
+        zr_encrypted.error_message().c_str());
+  CHECK(zr_encrypted.num_entries() == n,
+        "encrypted: num_entries: have %zu, want %zu",
+        zr_encrypted.num_entries(), n);
+  std::vector<uint8_t> buffer;
+  for (size_t i = 0; i < n; i++) {
+    CHECK(zr_encrypted.entry(i).flags & 0x0001,
+          "encrypted: i=%zu: flags: have 0x%04X", i,
+          zr_encrypted.entry(i).flags);
+    wuffs_aux::ZipExtractResult result = zr_encrypted.Extract(i, buffer);
+    CHECK(result.error_message == wuffs_aux::ZipReader_UnsupportedMember,
+          "encrypted: i=%zu: have \"%s\"", i, result.error_message.c_str());
+  }
+  return nullptr;
+}
+
+const char*  //
+test_wuffs_aux_zip_extract() {
+  std::vector<uint8_t> archive;
+  CHECK_STRING(read_file(archive, "test/data/archive.zip"));
+  wuffs_aux::ZipReader zr(archive.data(), archive.size());
+  CHECK(zr.error_message().empty(), "%s", zr.error_message().c_str());
+
+  // Re-use one buffer for every member.
+  std::vector<uint8_t> buffer;
+  for (size_t i = 0; i < zr.num_entries(); i++) {
+    wuffs_aux::ZipExtractResult result = zr.Extract(i, buffer);
+    CHECK_STRING(check_extract_result(zr, i, result));
+
+    // Stored members are zero-copy. Deflated ones use the buffer.
+    if (zr.entry(i).method == 0) {
+      CHECK((result.data_len == 0) ||
+                ((result.data_ptr > archive.data()) &&
+                 (result.data_ptr < archive.data() + archive.size())),
+            "i=%zu: stored data_ptr is outside the archive", i);
+    } else {
+      CHECK(result.data_ptr == buffer.data(),
+            "i=%zu: deflated data_ptr is not the buffer", i);
+    }
+  }
+
+  wuffs_aux::ZipExtractResult result = zr.Extract(zr.num_entries(), buffer);
+  CHECK(result.error_message == wuffs_aux::ZipReader_BadIndex,
+        "bad index: have \"%s\"", result.error_message.c_str());
+
+  // Overstating or understating a deflated member's uncompressed size (in
+  // the central directory, 22 bytes before the name) is an error, not a
+  // buffer overflow.
+  size_t i = zr.Find("romeo.txt");
+  size_t usize_offset = static_cast<size_t>(
+      reinterpret_cast<const uint8_t*>(zr.entry(i).name_ptr) - 22 -
+      archive.data());
+  for (uint32_t usize : {941u, 943u, 0u}) {
+    std::vector<uint8_t> bad(archive);
+    wuffs_base__poke_u32le__no_bounds_check(bad.data() + usize_offset, usize);
+    wuffs_aux::ZipReader zr_bad(bad.data(), bad.size());
+    CHECK(zr_bad.entry(i).uncompressed_size == usize,
+          "usize=%u: uncompressed_size: have %zu", usize,
+          static_cast<size_t>(zr_bad.entry(i).uncompressed_size));
+    result = zr_bad.Extract(i, buffer);
+    CHECK(result.error_message == wuffs_aux::ZipReader_BadUncompressedSize,
+          "usize=%u: have \"%s\"", usize, result.error_message.c_str());
+  }
+  return nullptr;
+}
+
+const char*  //
+test_wuffs_aux_zip_extract_many() {
+  std::vector<uint8_t> archive;
+  CHECK_STRING(read_file(archive, "test/data/archive.zip"));
+  // Corrupt the romeo.txt member's compressed data.
+  archive[data_offset(archive, 1557) + 200] ^= 0x55;
+  wuffs_aux::ZipReader zr(archive.data(), archive.size());
+  CHECK(zr.error_message().empty(), "%s", zr.error_message().c_str());
+
+  // Extract every member several times over, plus a bad index.
+  std::vector<size_t> indexes;
+  for (int rep = 0; rep < 5; rep++) {
+    for (size_t i = 0; i < zr.num_entries(); i++) {
+      indexes.push_back(i);
+    }
+  }
+  indexes.push_back(zr.num_entries());
+  const size_t n = indexes.size();
+  size_t romeo = zr.Find("romeo.txt");
+
+  for (uint32_t num_threads : {0u, 1u, 2u, 8u, 100u}) {
+    std::vector<wuffs_aux::ZipExtractResult> results(n);
+    std::vector<std::vector<uint8_t> > buffers(n);
+    size_t num_ok = zr.ExtractMany(results.data(), buffers.data(),
+                                   indexes.data(), n, num_threads);
+    CHECK(num_ok == (n - 6), "num_threads=%u: num_ok: have %zu, want %zu",
+          num_threads, num_ok, n - 6);
+
+    std::vector<uint8_t> buffer;
+    for (size_t j = 0; j < n; j++) {
+      size_t i = indexes[j];
+      wuffs_aux::ZipExtractResult want = zr.Extract(i, buffer);
+      CHECK(results[j].error_message == want.error_message,
+            "num_threads=%u: j=%zu: have \"%s\", want \"%s\"", num_threads,
+            j, results[j].error_message.c_str(), want.error_message.c_str());
+      if ((i == romeo) || (i == zr.num_entries())) {
+        CHECK(!results[j].error_message.empty(),
+              "num_threads=%u: j=%zu: extracted a bad member", num_threads, j);
+        continue;
+      }
+      CHECK_STRING(check_extract_result(zr, i, results[j]));
+      CHECK((zr.entry(i).method == 0) ||
+                (results[j].data_ptr == buffers[j].data()),
+            "num_threads=%u: j=%zu: deflated data_ptr is not buffers[j]",
+            num_threads, j);
+    }
+  }
+
+  CHECK(zr.ExtractMany(nullptr, nullptr, nullptr, 0) == 0,
+        "n=0: ExtractMany returned non-zero");
+  return nullptr;
+}
+
+const char*  //
+test_wuffs_aux_zip_find() {
+  std::vector<uint8_t> archive;
+  CHECK_STRING(read_file(archive, "test/data/archive.zip"));
+  wuffs_aux::ZipReader zr(archive.data(), archive.size());
+  CHECK(zr.error_message().empty(), "%s", zr.error_message().c_str());
+
+  const size_t n =
+      sizeof g_archive_zip_entries / sizeof g_archive_zip_entries[0];
+  for (size_t i = 0; i < n; i++) {
+    std::string name = g_archive_zip_entries[i].name;
+    CHECK(zr.Find(name) == i, "\"%s\": have %zu, want %zu", name.c_str(),
+          zr.Find(name), i);
+    CHECK(zr.Find(name.data(), name.size()) == i, "\"%s\": ptr/len failed",
+          name.c_str());
+
+    // Near misses (prefixes, extensions and case changes) are not found,
+    // unless they are another member's name.
+    for (const std::string& s :
+         {name.substr(0, name.size() - 1), name + "x", name + std::string(1, 0),
+          "/" + name, std::string(name.size(), 'X')}) {
+      size_t have = zr.Find(s);
+      CHECK((have == zr.npos) ||
+                (std::string(zr.entry(have).name_ptr,
+                             zr.entry(have).name_len) == s),
+            "\"%s\": near miss found %zu", name.c_str(), have);
+    }
+  }
+  CHECK(zr.Find("romeo.txt.g") == zr.npos, "romeo.txt.g found");
+  CHECK(zr.Find("") == zr.npos, "empty name found");
+  CHECK(zr.Find("non-ascii/") == zr.npos, "non-ascii/ found");
+  CHECK(zr.Find("HELLO.SH") == zr.npos, "HELLO.SH found");
+
+  // For duplicate names, Find returns the first one. Rename (in the central
+  // directory) the other two 18 byte names to match the second non-ascii one.
+  std::vector<uint8_t> dupes(archive);
+  for (size_t k : {0, 3}) {
+    size_t offset = static_cast<size_t>(
+        reinterpret_cast<const uint8_t*>(zr.entry(k).name_ptr) -
+        archive.data());
+    memcpy(dupes.data() + offset, zr.entry(4).name_ptr, 18);
+  }
+  wuffs_aux::ZipReader zr_dupes(dupes.data(), dupes.size());
+  CHECK(zr_dupes.error_message().empty(), "dupes: %s",
+        zr_dupes.error_message().c_str());
+  CHECK(zr_dupes.num_entries() == n, "dupes: num_entries: have %zu",
+        zr_dupes.num_entries());
+  CHECK(zr_dupes.Find(g_archive_zip_entries[4].name) == 0,
+        "dupes: have %zu, want 0",
+        zr_dupes.Find(g_archive_zip_entries[4].name));
+  for (size_t k : {0, 3}) {
+    CHECK(zr_dupes.Find(g_archive_zip_entries[k].name) == zr_dupes.npos,
+          "dupes: k=%zu: found", k);
+  }
+  for (size_t k : {1, 2, 5, 6, 7}) {
+    CHECK(zr_dupes.Find(g_archive_zip_entries[k].name) == k,
+          "dupes: k=%zu: not found", k);
+  }
+  return nullptr;
+}
+
+const char*  //
+test_wuffs_aux_zip_zip64() {
+  std::vector<uint8_t> archive;
+  CHECK_STRING(read_file(archive, "test/data/archive.zip64.zip"));
+  wuffs_aux::ZipReader zr(archive.data(), archive.size());
+  CHECK(zr.error_message().empty(), "%s", zr.error_message().c_str());
+  CHECK(zr.num_entries() == 2, "num_entries: have %zu, want 2",
+        zr.num_entries());
+
+  // Every entry's sizes and offset are 0xFFFF_FFFF in the central directory,
+  // with the real values in its Zip64 extra field. The EOCD record's counts,
+  // size and offset are saturated too, with the real values in the Zip64 EOCD
+  // record.
+  static const WantEntry wants[2] = {
+      {"hello.sh", 0, 422, 693, 0x87EE5E05, 8},
+      {"romeo.txt.gz", 480, 558, 558, 0x67FABE9C, 0},
+  };
+  std::vector<uint8_t> buffer;
+  for (size_t i = 0; i < 2; i++) {
+    const WantEntry& want = wants[i];
+    const wuffs_aux::ZipEntry& e = zr.entry(i);
+    CHECK((std::string(e.name_ptr, e.name_len) == want.name) &&
+              (e.local_header_offset == want.local_header_offset) &&
+              (e.compressed_size == want.compressed_size) &&
+              (e.uncompressed_size == want.uncompressed_size) &&
+              (e.crc32 == want.crc32) && (e.method == want.method),
+          "i=%zu (%s): fields do not match", i, want.name);
+    CHECK(zr.Find(want.name) == i, "Find(%s) failed", want.name);
+    CHECK_STRING(check_extract_result(zr, i, zr.Extract(i, buffer)));
+  }
+
+  // Breaking the Zip64 EOCD record's signature (the locator, 20 bytes before
+  // the 22 byte EOCD record, holds its offset) breaks the archive. So does
+  // truncating the Zip64 extra field's length to 8 bytes.
+  std::vector<uint8_t> bad(archive);
+  size_t z64 = static_cast<size_t>(wuffs_base__peek_u64le__no_bounds_check(
+      bad.data() + bad.size() - 22 - 20 + 8));
+  CHECK(wuffs_base__peek_u32le__no_bounds_check(bad.data() + z64) ==
+            0x06064B50,
+        "Zip64 EOCD record not found");
+  bad[z64] ^= 0x01;
+  wuffs_aux::ZipReader zr_bad(bad.data(), bad.size());
+  CHECK(zr_bad.error_message() == wuffs_aux::ZipReader_BadArchive,
+        "bad Zip64 EOCD: have \"%s\"", zr_bad.error_message().c_str());
+
+  bad = archive;
+  size_t extra = static_cast<size_t>(
+      reinterpret_cast<const uint8_t*>(zr.entry(0).name_ptr) + 8 -
+      archive.data());
+  CHECK(wuffs_base__peek_u16le__no_bounds_check(bad.data() + extra + 2) == 24,
+        "Zip64 extra field not found");
+  bad[extra + 2] = 8;
+  wuffs_aux::ZipReader zr_bad_extra(bad.data(), bad.size());
+  CHECK(zr_bad_extra.error_message() == wuffs_aux::ZipReader_BadArchive,
+        "bad Zip64 extra: have \"%s\"",
+        zr_bad_extra.error_message().c_str());
+  return nullptr;
+}
+
+// ---------------- Manifest
+
+typedef const char* (*proc)();
+
+proc g_tests[] = {
+    test_wuffs_aux_zip_bad_checksum,
+    test_wuffs_aux_zip_central_directory,
+    test_wuffs_aux_zip_extract,
+    test_wuffs_aux_zip_extract_many,
+    test_wuffs_aux_zip_find,
+    test_wuffs_aux_zip_zip64,
+    nullptr,
+};
+
+int  //
+main(int argc, char** argv) {
+  int num_tests = 0;
+  for (proc* p = g_tests; *p; p++) {
+    const char* z = (*p)();
+    if (z) {
+      printf("%-16s%-8sFAIL %s\n", "auxiliary/zip", g_cc, z);
+      return 1;
+    }
+    num_tests++;
+  }
+  printf("%-16s%-8sPASS (%d tests)\n", "auxiliary/zip", g_cc, num_tests);
+  return 0;
+}
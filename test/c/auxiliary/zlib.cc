@@ -0,0 +1,614 @@
+// Copyright 2022 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ----------------
+
+/*
+This test program exercises the C++ (not C) wuffs_aux::IndexGzipMembers,
+wuffs_aux::ParallelInflateGzip and wuffs_aux::ParallelInflateGzipMembers
+functions. Unlike the test/c/std programs, it does not use test/c/testlib
+(which is C only).
+
+To manually run this test, from the repository's root directory:
+
+for CXX in clang++ g++; do
+  $CXX -std=c++11 -Wall -Werror -pthread test/c/auxiliary/zlib.cc && ./a.out
+  rm -f a.out
+done
+
+Each edition should print "PASS", amongst other information, and exit(0).
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+// Wuffs ships as a "single file C library" or "header file library" as per
+// https://github.com/nothings/stb/blob/master/docs/stb_howto.txt
+//
+// To use that single file as a "foo.c"-like implementation, instead of a
+// "foo.h"-like header, #define WUFFS_IMPLEMENTATION before #include'ing or
+// compiling it.
+#define WUFFS_IMPLEMENTATION
+
+// Defining the WUFFS_CONFIG__MODULE* macros are optional, but it lets users of
+// release/c/etc.c choose which parts of Wuffs to build. That file contains the
+// entire Wuffs standard library, implementing a variety of codecs and file
+// formats. Without this macro definition, an optimizing compiler or linker may
+// very well discard Wuffs code for unused codecs, but listing the Wuffs
+// modules we use makes that process explicit. Preprocessing means that such
+// code simply isn't compiled.
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__ADLER32
+#define WUFFS_CONFIG__MODULE__AUX__BASE
+#define WUFFS_CONFIG__MODULE__AUX__ZLIB
+#define WUFFS_CONFIG__MODULE__BASE
+#define WUFFS_CONFIG__MODULE__CRC32
+#define WUFFS_CONFIG__MODULE__DEFLATE
+#define WUFFS_CONFIG__MODULE__GZIP
+#define WUFFS_CONFIG__MODULE__ZLIB
+
+// If building this program in an environment that doesn't easily accommodate
+// relative includes, you can use the script/inline-c-relative-includes.go
+// program to generate a stand-alone C file.
+#include "../../../release/c/wuffs-unsupported-snapshot.c"
+
+// The order matters here. Clang also defines "__GNUC__".
+#if defined(__clang__)
+const char* g_cc = "clang";
+#elif defined(__GNUC__)
+const char* g_cc = "gcc";
+#elif defined(_MSC_VER)
+const char* g_cc = "cl";
+#else
+const char* g_cc = "cc";
+#endif
+
+// g_fail_message holds the most recent test failure's message.
+std::string g_fail_message;
+
+#define CHECK(cond, ...)                                                      \
+  do {                                                                        \
+    if (!(cond)) {                                                            \
+      char fail_buf[1024];                                                    \
+      snprintf(fail_buf, sizeof fail_buf, "%s: ", __func__);                  \
+      size_t fail_n = strlen(fail_buf);                                       \
+      snprintf(fail_buf + fail_n, sizeof fail_buf - fail_n, __VA_ARGS__);     \
+      g_fail_message = fail_buf;                                              \
+      return g_fail_message.c_str();                                          \
+    }                                                                         \
+  } while (false)
+
+#define CHECK_STRING(string)       \
+  do {                             \
+    const char* z = (string);      \
+    if (z) {                       \
+      return z;                    \
+    }                              \
+  } while (false)
+
+// ---------------- Helpers
+
+const char*  //
+read_file(std::vector<uint8_t>& dst, const char* path) {
+  FILE* f = fopen(path, "rb");
+  if (!f) {
+    g_fail_message = std::string("read_file: could not open ") + path;
+    return g_fail_message.c_str();
+  }
+  uint8_t buf[4096];
+  while (true) {
+    size_t n = fread(buf, 1, sizeof buf, f);
+    dst.insert(dst.end(), buf, buf + n);
+    if (n < sizeof buf) {
+      break;
+    }
+  }
+  bool ok = !ferror(f);
+  fclose(f);
+  if (!ok) {
+    g_fail_message = std::string("read_file: could not read ") + path;
+    return g_fail_message.c_str();
+  }
+  return nullptr;
+}
+
+uint32_t  //
+crc32_ieee(const std::vector<uint8_t>& data) {
+  wuffs_crc32__ieee_hasher::unique_ptr hasher =
+      wuffs_crc32__ieee_hasher::alloc();
+  return hasher->update_u32(wuffs_base__make_slice_u8(
+      const_cast<uint8_t*>(data.data()), data.size()));
+}
+
+// append_gzip_member appends a gzip member to dst. Its deflate data,
+// compressed, decompresses to decompressed. If bgzf, its header has BGZF's
+// (SAMv1 section 4.1) "BC" extra subfield, holding the member length minus 1.
+void  //
+append_gzip_member(std::vector<uint8_t>& dst,
+                   const std::vector<uint8_t>& compressed,
+                   const std::vector<uint8_t>& decompressed,
+                   bool bgzf) {
+  uint8_t header[18] = {
+      0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0xFF, 0x06, 0x00, 0x42, 0x43, 0x02, 0x00, 0x00, 0x00,
+  };
+  size_t n = (bgzf ? 18 : 10) + compressed.size() + 8;
+  if (bgzf) {
+    header[3] = 0x04;  // FEXTRA.
+    wuffs_base__poke_u16le__no_bounds_check(header + 16,
+                                            static_cast<uint16_t>(n - 1));
+  }
+  dst.insert(dst.end(), header, header + (bgzf ? 18 : 10));
+  dst.insert(dst.end(), compressed.begin(), compressed.end());
+  uint8_t trailer[8];
+  wuffs_base__poke_u32le__no_bounds_check(trailer + 0,
+                                          crc32_ieee(decompressed));
+  wuffs_base__poke_u32le__no_bounds_check(
+      trailer + 4, static_cast<uint32_t>(decompressed.size()));
+  dst.insert(dst.end(), trailer, trailer + 8);
+}
+
+// stored_deflate returns deflate data, a single stored (uncompressed) block,
+// that decompresses to s.
+std::vector<uint8_t>  //
+stored_deflate(const std::vector<uint8_t>& s) {
+  std::vector<uint8_t> v(5);
+  v[0] = 0x01;
+  wuffs_base__poke_u16le__no_bounds_check(v.data() + 1,
+                                          static_cast<uint16_t>(s.size()));
+  wuffs_base__poke_u16le__no_bounds_check(v.data() + 3,
+                                          static_cast<uint16_t>(~s.size()));
+  v.insert(v.end(), s.begin(), s.end());
+  return v;
+}
+
+// deflate_encode returns src, compressed by wuffs_deflate__encoder.
+std::vector<uint8_t>  //
+deflate_encode(const std::vector<uint8_t>& src, uint32_t level) {
+  wuffs_deflate__encoder::unique_ptr enc = wuffs_deflate__encoder::alloc();
+  enc->set_level(level);
+  std::vector<uint8_t> dst(src.size() + (src.size() / 8) + 65536);
+  wuffs_base__io_buffer d = wuffs_base__ptr_u8__writer(dst.data(), dst.size());
+  wuffs_base__io_buffer s = wuffs_base__ptr_u8__reader(
+      const_cast<uint8_t*>(src.data()), src.size(), true);
+  wuffs_base__status status =
+      enc->transform_io(&d, &s, wuffs_base__empty_slice_u8());
+  dst.resize(status.is_ok() ? d.meta.wi : 0);
+  return dst;
+}
+
+// gzip_decode decodes src's first gzip member with a plain (single-threaded)
+// wuffs_gzip__decoder, replacing the contents of dst. It returns the
+// decoder's error message, if any, as ParallelInflateGzip should.
+std::string  //
+gzip_decode(std::vector<uint8_t>& dst, const std::vector<uint8_t>& src) {
+  wuffs_gzip__decoder::unique_ptr dec = wuffs_gzip__decoder::alloc();
+  std::vector<uint8_t> workbuf(dec->workbuf_len().max_incl);
+  std::vector<uint8_t> buf(65536);
+  wuffs_base__io_buffer s = wuffs_base__ptr_u8__reader(
+      const_cast<uint8_t*>(src.data()), src.size(), true);
+  dst.clear();
+  while (true) {
+    // The decoder's history (for back-references) tracks the absolute
+    // position, so carry it over from one (reused) buf to the next.
+    wuffs_base__io_buffer d =
+        wuffs_base__ptr_u8__writer(buf.data(), buf.size());
+    d.meta.pos = dst.size();
+    wuffs_base__status status = dec->transform_io(
+        &d, &s, wuffs_base__make_slice_u8(workbuf.data(), workbuf.size()));
+    dst.insert(dst.end(), buf.data(), buf.data() + d.meta.wi);
+    if (status.is_ok()) {
+      return "";
+    } else if (status.repr == wuffs_base__suspension__short_read) {
+      return "wuffs_aux::ParallelInflateGzip: unexpected end of file";
+    } else if (status.repr != wuffs_base__suspension__short_write) {
+      return status.message();
+    }
+  }
+}
+
+// make_text returns n bytes of English-like text: pseudo-random words from a
+// small vocabulary, so that it has plenty of back-references.
+std::vector<uint8_t>  //
+make_text(size_t n) {
+  static const char* words[] = {
+      "the ",   "quick ", "brown ",   "fox ",     "jumps ", "over ",
+      "lazy ",  "dog ",   "and ",     "then ",    "some ",  "more ",
+      "words ", "a ",     "thing, ",  "which ",   "is ",    "not ",
+      "quite ", "what ",  "it was. ", "Indeed\n", "we ",    "find ",
+  };
+  std::vector<uint8_t> v;
+  v.reserve(n + 16);
+  uint32_t x = 0x12345678;
+  while (v.size() < n) {
+    x = (x * 1103515245) + 12345;
+    const char* w = words[(x >> 16) % (sizeof words / sizeof words[0])];
+    v.insert(v.end(), w, w + strlen(w));
+  }
+  v.resize(n);
+  return v;
+}
+
+// make_random returns n bytes of pseudo-random lower case letters (and
+// spaces). It has few back-references but still compresses (via Huffman
+// codes) to much less than n bytes, unlike uniformly random bytes, whose
+// deflate encoding would be stored blocks.
+std::vector<uint8_t>  //
+make_random(size_t n) {
+  std::vector<uint8_t> v(n);
+  uint64_t x = 0x0123456789ABCDEF;
+  for (size_t i = 0; i < n; i++) {
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    uint32_t c = static_cast<uint32_t>(x >> 32) % 27;
+    v[i] = static_cast<uint8_t>((c < 26) ? ('a' + c) : ' ');
+  }
+  return v;
+}
+
+// parallel_inflate_gzip calls ParallelInflateGzip, with 1, 2 and N threads,
+// and checks that it produces what gzip_decode does (including any error
+// message). dst starts non-empty, as ParallelInflateGzip appends to it.
+const char*  //
+parallel_inflate_gzip(const std::vector<uint8_t>& src) {
+  std::vector<uint8_t> want;
+  std::string want_error_message = gzip_decode(want, src);
+  static const uint32_t num_threads_list[] = {1, 2, 8};
+  for (uint32_t num_threads : num_threads_list) {
+    std::vector<uint8_t> have(3, 'x');
+    std::string error_message = wuffs_aux::ParallelInflateGzip(
+        have, src.data(), src.size(), num_threads);
+    CHECK(error_message == want_error_message,
+          "num_threads=%u: have \"%s\", want \"%s\"", num_threads,
+          error_message.c_str(), want_error_message.c_str());
+    if (!error_message.empty()) {
+      continue;
+    }
+    CHECK(have.size() == (3 + want.size()),
+          "num_threads=%u: size: have %zu, want %zu", num_threads,
+          have.size(), 3 + want.size());
+    CHECK(std::equal(want.begin(), want.end(), have.begin() + 3),
+          "num_threads=%u: contents differ", num_threads);
+  }
+  return nullptr;
+}
+
+// decode_members calls ParallelInflateGzipMembers, with a dst buffer exactly
+// as long as want, and checks that it produces want.
+const char*  //
+decode_members(const std::vector<uint8_t>& src,
+               const std::vector<uint8_t>& want,
+               uint32_t num_threads) {
+  std::vector<uint8_t> have(want.size());
+  wuffs_aux::ParallelInflateGzipMembersResult result =
+      wuffs_aux::ParallelInflateGzipMembers(have.data(), have.size(),
+                                            src.data(), src.size(),
+                                            num_threads);
+  CHECK(result.error_message.empty(), "num_threads=%u: %s", num_threads,
+        result.error_message.c_str());
+  CHECK(result.num_dst_bytes == want.size(),
+        "num_threads=%u: num_dst_bytes: have %zu, want %zu", num_threads,
+        result.num_dst_bytes, want.size());
+  CHECK(have == want, "num_threads=%u: contents differ", num_threads);
+  CHECK(result.checksum == crc32_ieee(want),
+        "num_threads=%u: checksum: have 0x%08X, want 0x%08X", num_threads,
+        result.checksum, crc32_ieee(want));
+  return nullptr;
+}
+
+// ---------------- Tests
+
+const char*  //
+test_wuffs_aux_zlib_bgzf() {
+  // Build a BGZF file out of raw deflate data: the .deflate file as is, the
+  // .zlib file without its 2 byte header or 4 byte Adler-32 trailer and a
+  // stored block that contains what looks like a member boundary. The last
+  // member is BGZF's empty EOF marker.
+  std::vector<uint8_t> romeo_deflate;
+  std::vector<uint8_t> midsummer_zlib;
+  std::vector<uint8_t> want;
+  CHECK_STRING(read_file(romeo_deflate, "test/data/romeo.txt.deflate"));
+  CHECK_STRING(read_file(midsummer_zlib, "test/data/midsummer.txt.zlib"));
+  CHECK(midsummer_zlib.size() >= 6, "midsummer.txt.zlib is too short");
+  std::vector<uint8_t> midsummer_deflate(midsummer_zlib.begin() + 2,
+                                         midsummer_zlib.end() - 4);
+  std::vector<uint8_t> romeo;
+  std::vector<uint8_t> midsummer;
+  CHECK_STRING(read_file(romeo, "test/data/romeo.txt"));
+  CHECK_STRING(read_file(midsummer, "test/data/midsummer.txt"));
+  static const uint8_t lookalike_bytes[] = {
+      'a',  'b',  'c',  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0xFF, 'x',  'y',  'z',
+  };
+  std::vector<uint8_t> lookalike(lookalike_bytes,
+                                 lookalike_bytes + sizeof lookalike_bytes);
+
+  std::vector<uint8_t> src;
+  std::vector<size_t> src_offsets;
+  src_offsets.push_back(src.size());
+  append_gzip_member(src, romeo_deflate, romeo, true);
+  src_offsets.push_back(src.size());
+  append_gzip_member(src, stored_deflate(lookalike), lookalike, true);
+  src_offsets.push_back(src.size());
+  append_gzip_member(src, midsummer_deflate, midsummer, true);
+  src_offsets.push_back(src.size());
+  append_gzip_member(src, std::vector<uint8_t>({0x03, 0x00}),
+                     std::vector<uint8_t>(), true);
+  src_offsets.push_back(src.size());
+  want.insert(want.end(), romeo.begin(), romeo.end());
+  want.insert(want.end(), lookalike.begin(), lookalike.end());
+  want.insert(want.end(), midsummer.begin(), midsummer.end());
+
+  // BSIZE gives the exact member boundaries, despite the lookalike.
+  std::vector<wuffs_aux::GzipMember> members;
+  std::string error_message =
+      wuffs_aux::IndexGzipMembers(members, src.data(), src.size());
+  CHECK(error_message.empty(), "IndexGzipMembers: %s", error_message.c_str());
+  CHECK(members.size() == 4, "members.size(): have %zu, want 4",
+        members.size());
+  uint64_t dst_offset = 0;
+  for (size_t i = 0; i < members.size(); i++) {
+    CHECK(members[i].src_offset == src_offsets[i],
+          "i=%zu: src_offset: have %zu, want %zu", i, members[i].src_offset,
+          src_offsets[i]);
+    CHECK(members[i].src_length == (src_offsets[i + 1] - src_offsets[i]),
+          "i=%zu: src_length: have %zu, want %zu", i, members[i].src_length,
+          src_offsets[i + 1] - src_offsets[i]);
+    CHECK(members[i].dst_offset == dst_offset, "i=%zu: dst_offset mismatch",
+          i);
+    dst_offset += members[i].isize;
+  }
+  CHECK(dst_offset == want.size(), "total isize: have %zu, want %zu",
+        static_cast<size_t>(dst_offset), want.size());
+
+  for (uint32_t num_threads = 1; num_threads <= 4; num_threads++) {
+    CHECK_STRING(decode_members(src, want, num_threads));
+  }
+  return nullptr;
+}
+
+const char*  //
+test_wuffs_aux_zlib_false_member_boundary() {
+  // A (non-BGZF) member's stored block contains what looks like a member
+  // boundary: a trailer (whose ISIZE is zero) followed by a valid header.
+  static const uint8_t lookalike_bytes[] = {
+      'a',  'b',  'c',  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0xFF, 'x',  'y',  'z',
+  };
+  std::vector<uint8_t> lookalike(lookalike_bytes,
+                                 lookalike_bytes + sizeof lookalike_bytes);
+  std::vector<uint8_t> romeo_gz;
+  std::vector<uint8_t> romeo;
+  CHECK_STRING(read_file(romeo_gz, "test/data/romeo.txt.gz"));
+  CHECK_STRING(read_file(romeo, "test/data/romeo.txt"));
+
+  std::vector<uint8_t> src;
+  append_gzip_member(src, stored_deflate(lookalike), lookalike, false);
+  src.insert(src.end(), romeo_gz.begin(), romeo_gz.end());
+  std::vector<uint8_t> want(lookalike);
+  want.insert(want.end(), romeo.begin(), romeo.end());
+
+  // Scanning (without decoding) is fooled into finding three members.
+  std::vector<wuffs_aux::GzipMember> members;
+  std::string error_message =
+      wuffs_aux::IndexGzipMembers(members, src.data(), src.size());
+  CHECK(error_message.empty(), "IndexGzipMembers: %s", error_message.c_str());
+  CHECK(members.size() == 3, "members.size(): have %zu, want 3",
+        members.size());
+
+  // Decoding still gets it right, by falling back to a sequential decode.
+  for (uint32_t num_threads = 1; num_threads <= 2; num_threads++) {
+    CHECK_STRING(decode_members(src, want, num_threads));
+  }
+  return nullptr;
+}
+
+const char*  //
+test_wuffs_aux_zlib_invalid_members() {
+  std::vector<uint8_t> romeo_gz;
+  std::vector<uint8_t> romeo;
+  CHECK_STRING(read_file(romeo_gz, "test/data/romeo.txt.gz"));
+  CHECK_STRING(read_file(romeo, "test/data/romeo.txt"));
+  std::vector<uint8_t> src(romeo_gz);
+  src.insert(src.end(), romeo_gz.begin(), romeo_gz.end());
+  std::vector<uint8_t> dst(2 * romeo.size());
+
+  const struct {
+    const char* name;
+    size_t src_len;
+    size_t dst_len;
+    size_t corrupt_offset;
+    const char* want;
+  } cases[] = {
+      {"dst too short", src.size(), dst.size() - 1, 0,
+       "wuffs_aux::ParallelInflateGzipMembers: dst is too short"},
+      {"src truncated", src.size() - 1, dst.size(), 0,
+       "wuffs_aux::ParallelInflateGzipMembers: unexpected end of file"},
+      {"bad checksum", src.size(), dst.size(), src.size() - 8,
+       wuffs_gzip__error__bad_checksum + 1},
+      {"empty src", 0, dst.size(), 0,
+       "wuffs_aux::ParallelInflateGzipMembers: unexpected end of file"},
+  };
+  for (const auto& c : cases) {
+    std::vector<uint8_t> s(src.begin(), src.begin() + c.src_len);
+    if (c.corrupt_offset) {
+      s[c.corrupt_offset] ^= 0x01;
+    }
+    for (uint32_t num_threads = 1; num_threads <= 2; num_threads++) {
+      wuffs_aux::ParallelInflateGzipMembersResult result =
+          wuffs_aux::ParallelInflateGzipMembers(dst.data(), c.dst_len,
+                                                s.data(), s.size(),
+                                                num_threads);
+      CHECK(result.error_message == c.want,
+            "%s: num_threads=%u: have \"%s\", want \"%s\"", c.name,
+            num_threads, result.error_message.c_str(), c.want);
+    }
+  }
+  return nullptr;
+}
+
+const char*  //
+test_wuffs_aux_zlib_multiple_members() {
+  // Concatenate three gzip members, like "cat pi.txt.gz romeo.txt.gz etc".
+  static const char* filenames[3][2] = {
+      {"test/data/pi.txt.gz", "test/data/pi.txt"},
+      {"test/data/romeo.txt.gz", "test/data/romeo.txt"},
+      {"test/data/midsummer.txt.gz", "test/data/midsummer.txt"},
+  };
+  std::vector<uint8_t> src;
+  std::vector<uint8_t> want;
+  std::vector<size_t> src_offsets;
+  for (int i = 0; i < 3; i++) {
+    src_offsets.push_back(src.size());
+    CHECK_STRING(read_file(src, filenames[i][0]));
+    CHECK_STRING(read_file(want, filenames[i][1]));
+  }
+  src_offsets.push_back(src.size());
+
+  std::vector<wuffs_aux::GzipMember> members;
+  std::string error_message =
+      wuffs_aux::IndexGzipMembers(members, src.data(), src.size());
+  CHECK(error_message.empty(), "IndexGzipMembers: %s", error_message.c_str());
+  CHECK(members.size() == 3, "members.size(): have %zu, want 3",
+        members.size());
+  for (size_t i = 0; i < members.size(); i++) {
+    CHECK(members[i].src_offset == src_offsets[i],
+          "i=%zu: src_offset: have %zu, want %zu", i, members[i].src_offset,
+          src_offsets[i]);
+  }
+
+  for (uint32_t num_threads = 0; num_threads <= 4; num_threads++) {
+    CHECK_STRING(decode_members(src, want, num_threads));
+  }
+  return nullptr;
+}
+
+const char*  //
+test_wuffs_aux_zlib_parallel_inflate_gzip_fallbacks() {
+  std::vector<uint8_t> random = make_random(4 << 20);
+  std::vector<uint8_t> random_gz;
+  append_gzip_member(random_gz, deflate_encode(random, 1), random, false);
+  std::vector<uint8_t> stored_gz;
+  append_gzip_member(stored_gz, deflate_encode(random, 0), random, false);
+  std::vector<uint8_t> romeo_gz;
+  CHECK_STRING(read_file(romeo_gz, "test/data/romeo.txt.gz"));
+  CHECK(random_gz.size() > (2 << 20), "random_gz is too short");
+
+  // A second member means that the first member's deflate stream does not
+  // end where the (assumed) gzip trailer starts, so the chunks don't join
+  // up. The other cases either have no block boundaries to find (stored
+  // blocks aren't searched for), are too small to split or fail the
+  // trailer's checks. All of them fall back to a sequential decode.
+  std::vector<uint8_t> two_members(random_gz);
+  two_members.insert(two_members.end(), romeo_gz.begin(), romeo_gz.end());
+  std::vector<uint8_t> bad_crc32(random_gz);
+  bad_crc32[bad_crc32.size() - 8] ^= 0x01;
+  std::vector<uint8_t> bad_isize(random_gz);
+  bad_isize[bad_isize.size() - 4] ^= 0x01;
+  std::vector<uint8_t> truncated(random_gz.begin(), random_gz.end() - 1);
+
+  const struct {
+    const char* name;
+    const std::vector<uint8_t>* src;
+  } cases[] = {
+      {"two members", &two_members},
+      {"stored blocks", &stored_gz},
+      {"small", &romeo_gz},
+      {"bad CRC-32", &bad_crc32},
+      {"bad ISIZE", &bad_isize},
+      {"truncated", &truncated},
+  };
+  for (const auto& c : cases) {
+    const char* z = parallel_inflate_gzip(*c.src);
+    CHECK(!z, "%s: %s", c.name, z);
+  }
+
+  std::vector<uint8_t> dst;
+  std::string error_message = gzip_decode(dst, two_members);
+  CHECK(error_message.empty() && (dst == random),
+        "two members: gzip_decode: \"%s\"", error_message.c_str());
+  static const char* want_errors[3] = {
+      wuffs_gzip__error__bad_checksum + 1,
+      wuffs_gzip__error__bad_checksum + 1,
+      "wuffs_aux::ParallelInflateGzip: unexpected end of file",
+  };
+  const std::vector<uint8_t>* bad_srcs[3] = {&bad_crc32, &bad_isize,
+                                             &truncated};
+  for (int i = 0; i < 3; i++) {
+    error_message = gzip_decode(dst, *bad_srcs[i]);
+    CHECK(error_message == want_errors[i], "i=%d: have \"%s\", want \"%s\"",
+          i, error_message.c_str(), want_errors[i]);
+  }
+  return nullptr;
+}
+
+const char*  //
+test_wuffs_aux_zlib_parallel_inflate_gzip_random() {
+  // The compressed data is about 5 MiB, enough to split into several (but
+  // fewer than 8) chunks, each at least 1 MiB.
+  std::vector<uint8_t> random = make_random(8 << 20);
+  std::vector<uint8_t> src;
+  append_gzip_member(src, deflate_encode(random, 1), random, false);
+  CHECK(src.size() > (4 << 20), "src.size(): have %zu, want > 4 MiB",
+        src.size());
+  return parallel_inflate_gzip(src);
+}
+
+const char*  //
+test_wuffs_aux_zlib_parallel_inflate_gzip_text() {
+  // The compressed data is about 3 MiB.
+  std::vector<uint8_t> text = make_text(16 << 20);
+  std::vector<uint8_t> src;
+  append_gzip_member(src, deflate_encode(text, 6), text, false);
+  CHECK(src.size() > (2 << 20), "src.size(): have %zu, want > 2 MiB",
+        src.size());
+  return parallel_inflate_gzip(src);
+}
+
+// ---------------- Manifest
+
+typedef const char* (*proc)();
+
+proc g_tests[] = {
+    test_wuffs_aux_zlib_bgzf,
+    test_wuffs_aux_zlib_false_member_boundary,
+    test_wuffs_aux_zlib_invalid_members,
+    test_wuffs_aux_zlib_multiple_members,
+    test_wuffs_aux_zlib_parallel_inflate_gzip_fallbacks,
+    test_wuffs_aux_zlib_parallel_inflate_gzip_random,
+    test_wuffs_aux_zlib_parallel_inflate_gzip_text,
+    nullptr,
+};
+
+int  //
+main(int argc, char** argv) {
+  int num_tests = 0;
+  for (proc* p = g_tests; *p; p++) {
+    const char* z = (*p)();
+    if (z) {
+      printf("%-16s%-8sFAIL %s\n", "auxiliary/zlib", g_cc, z);
+      return 1;
+    }
+    num_tests++;
+  }
+  printf("%-16s%-8sPASS (%d tests)\n", "auxiliary/zlib", g_cc, num_tests);
+  return 0;
+}
@@ -0,0 +1,48 @@
+// Copyright 2022 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ----------------
+
+// The mimic library is libcbor (https://github.com/PJK/libcbor).
+//
+// Unlike Wuffs' std/cbor, which produces tokens and does not allocate,
+// libcbor's cbor_load builds a tree of reference-counted items. As with the
+// other mimic libraries, the benchmarks include this cost, as it is part of
+// the work done to parse CBOR with that library.
+
+#include "cbor.h"
+
+const char*  //
+mimic_cbor_decode(wuffs_base__io_buffer* dst,
+                  wuffs_base__io_buffer* src,
+                  uint32_t wuffs_initialize_flags,
+                  uint64_t wlimit,
+                  uint64_t rlimit) {
+  if ((wlimit < UINT64_MAX) || (rlimit < UINT64_MAX)) {
+    return "unsupported I/O limit";
+  }
+  struct cbor_load_result result;
+  cbor_item_t* item =
+      cbor_load(wuffs_base__io_buffer__reader_pointer(src),
+                wuffs_base__io_buffer__reader_length(src), &result);
+  if (!item || (result.error.code != CBOR_ERR_NONE)) {
+    if (item) {
+      cbor_decref(&item);
+    }
+    return "mimic_cbor_decode: cbor_load failed";
+  }
+  src->meta.ri += result.read;
+  cbor_decref(&item);
+  return NULL;
+}
@@ -15,13 +15,19 @@
 // ----------------
 
 // Uncomment one of these #define lines to test and bench alternative mimic
-// libraries (libdeflate or miniz) instead of zlib-the-library.
+// libraries (libdeflate, miniz or zlib-ng) instead of zlib-the-library.
 //
 // These are collectively referred to as
 // WUFFS_MIMICLIB_USE_XXX_INSTEAD_OF_ZLIB.
 //
 // #define WUFFS_MIMICLIB_USE_LIBDEFLATE_INSTEAD_OF_ZLIB 1
 // #define WUFFS_MIMICLIB_USE_MINIZ_INSTEAD_OF_ZLIB 1
+// #define WUFFS_MIMICLIB_USE_ZLIB_NG_INSTEAD_OF_ZLIB 1
+//
+// The libdeflate and zlib-ng options also need changing the "wuffs mimic
+// cflags"' "-lz" to "-ldeflate" or "-lz-ng". A zlib-ng library built in its
+// zlib-compatible mode (ZLIB_COMPAT) instead needs no #define, only linking
+// with it instead of with zlib-the-library.
 
 // -------------------------------- WUFFS_MIMICLIB_USE_XXX_INSTEAD_OF_ZLIB
 #if defined(WUFFS_MIMICLIB_USE_LIBDEFLATE_INSTEAD_OF_ZLIB)
@@ -262,7 +268,22 @@ mimic_zlib_decode_with_dictionary(wuffs_base__io_buffer* dst,
 
 // -------------------------------- WUFFS_MIMICLIB_USE_XXX_INSTEAD_OF_ZLIB
 #else
+#if defined(WUFFS_MIMICLIB_USE_ZLIB_NG_INSTEAD_OF_ZLIB)
+// zlib-ng's native API is zlib's API with "zng_" prefixes.
+#include <limits.h>
+
+#include "zlib-ng.h"
+typedef uint32_t uInt;
+#define adler32 zng_adler32
+#define crc32 zng_crc32
+#define inflate zng_inflate
+#define inflateEnd zng_inflateEnd
+#define inflateInit2 zng_inflateInit2
+#define inflateSetDictionary zng_inflateSetDictionary
+#define z_stream zng_stream
+#else
 #include "zlib.h"
+#endif
 
 // We deliberately do not define the
 // WUFFS_MIMICLIB_DEFLATE_DOES_NOT_SUPPORT_STREAMING macro.
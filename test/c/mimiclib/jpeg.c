@@ -0,0 +1,140 @@
+// Copyright 2022 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ----------------
+
+// The mimic library is libjpeg (or libjpeg-turbo, which implements the same
+// API). Its default (JDCT_ISLOW) inverse DCT and "fancy upsampling" are what
+// Wuffs' std/jpeg matches exactly.
+
+#include <setjmp.h>
+#include <stdio.h>
+
+#include "jpeglib.h"
+
+struct mimic_jpeg_error_mgr {
+  struct jpeg_error_mgr pub;
+  jmp_buf jmpbuf;
+};
+
+static void  //
+mimic_jpeg_error_exit(j_common_ptr cinfo) {
+  struct mimic_jpeg_error_mgr* e = (struct mimic_jpeg_error_mgr*)(cinfo->err);
+  longjmp(e->jmpbuf, 1);
+}
+
+static void  //
+mimic_jpeg_output_message(j_common_ptr cinfo) {
+  // No-op. Don't print warnings to stderr.
+}
+
+const char*  //
+mimic_jpeg_decode(uint64_t* n_bytes_out,
+                  wuffs_base__io_buffer* dst,
+                  uint32_t wuffs_initialize_flags,
+                  wuffs_base__pixel_format pixfmt,
+                  uint32_t* quirks_ptr,
+                  size_t quirks_len,
+                  wuffs_base__io_buffer* src) {
+  wuffs_base__io_buffer dst_fallback =
+      wuffs_base__slice_u8__writer(g_mimiclib_scratch_slice_u8);
+  if (!dst) {
+    dst = &dst_fallback;
+  }
+
+  size_t bytes_per_pixel = 0;
+  switch (pixfmt.repr) {
+    case WUFFS_BASE__PIXEL_FORMAT__Y:
+      bytes_per_pixel = 1;
+      break;
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
+      bytes_per_pixel = 4;
+      break;
+    default:
+      return "mimic_jpeg_decode: unsupported pixfmt";
+  }
+
+  // volatile is needed because of the setjmp.
+  const char* volatile ret = NULL;
+  uint8_t* volatile row = NULL;
+
+  struct jpeg_decompress_struct cinfo;
+  struct mimic_jpeg_error_mgr jerr;
+  cinfo.err = jpeg_std_error(&jerr.pub);
+  jerr.pub.error_exit = mimic_jpeg_error_exit;
+  jerr.pub.output_message = mimic_jpeg_output_message;
+  if (setjmp(jerr.jmpbuf)) {
+    ret = "mimic_jpeg_decode: libjpeg failed";
+    goto cleanup0;
+  }
+  jpeg_create_decompress(&cinfo);
+  jpeg_mem_src(&cinfo, wuffs_base__io_buffer__reader_pointer(src),
+               wuffs_base__io_buffer__reader_length(src));
+  if (jpeg_read_header(&cinfo, TRUE) != JPEG_HEADER_OK) {
+    ret = "mimic_jpeg_decode: jpeg_read_header failed";
+    goto cleanup0;
+  }
+  cinfo.out_color_space = (bytes_per_pixel == 1) ? JCS_GRAYSCALE : JCS_RGB;
+  cinfo.dct_method = JDCT_ISLOW;
+  cinfo.do_fancy_upsampling = TRUE;
+  jpeg_start_decompress(&cinfo);
+
+  size_t width = cinfo.output_width;
+  size_t n = bytes_per_pixel * width * cinfo.output_height;
+  if (n > wuffs_base__io_buffer__writer_length(dst)) {
+    ret = "mimic_jpeg_decode: image is too large";
+    goto cleanup0;
+  }
+  row = (uint8_t*)malloc(width * 3);
+  if (!row) {
+    ret = "mimic_jpeg_decode: out of memory";
+    goto cleanup0;
+  }
+
+  while (cinfo.output_scanline < cinfo.output_height) {
+    JSAMPROW rows[1];
+    rows[0] = row;
+    if (jpeg_read_scanlines(&cinfo, rows, 1) != 1) {
+      ret = "mimic_jpeg_decode: jpeg_read_scanlines failed";
+      goto cleanup0;
+    }
+    uint8_t* d = wuffs_base__io_buffer__writer_pointer(dst);
+    if (bytes_per_pixel == 1) {
+      memcpy(d, row, width);
+      dst->meta.wi += width;
+      continue;
+    }
+    // libjpeg gives RGB. Convert to BGRA.
+    const uint8_t* s = row;
+    size_t i;
+    for (i = 0; i < width; i++) {
+      d[0] = s[2];
+      d[1] = s[1];
+      d[2] = s[0];
+      d[3] = 0xFF;
+      d += 4;
+      s += 3;
+    }
+    dst->meta.wi += 4 * width;
+  }
+  jpeg_finish_decompress(&cinfo);
+  if (n_bytes_out) {
+    *n_bytes_out += n;
+  }
+
+cleanup0:;
+  free(row);
+  jpeg_destroy_decompress(&cinfo);
+  return ret;
+}
@@ -0,0 +1,52 @@
+// Copyright 2022 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ----------------
+
+// The mimic library is yyjson (https://github.com/ibireme/yyjson). Other
+// popular JSON libraries, such as RapidJSON and simdjson, are C++ libraries,
+// which these C test programs cannot #include, but yyjson's performance is
+// comparable to theirs.
+//
+// Unlike Wuffs' std/json, which produces tokens and does not allocate, yyjson
+// builds a DOM (Document Object Model) tree. As with the other mimic
+// libraries, the benchmarks include this cost, as it is part of the work done
+// to parse JSON with that library.
+
+#include "yyjson.h"
+
+const char*  //
+mimic_json_decode(wuffs_base__io_buffer* dst,
+                  wuffs_base__io_buffer* src,
+                  uint32_t wuffs_initialize_flags,
+                  uint64_t wlimit,
+                  uint64_t rlimit) {
+  if ((wlimit < UINT64_MAX) || (rlimit < UINT64_MAX)) {
+    return "unsupported I/O limit";
+  }
+  // Without the YYJSON_READ_INSITU flag, yyjson does not modify its input.
+  yyjson_read_err err;
+  yyjson_doc* doc =
+      yyjson_read_opts((char*)(wuffs_base__io_buffer__reader_pointer(src)),
+                       wuffs_base__io_buffer__reader_length(src),
+                       YYJSON_READ_NOFLAG, NULL, &err);
+  if (!doc) {
+    return "mimic_json_decode: yyjson_read_opts failed";
+  }
+  // Without the YYJSON_READ_STOP_WHEN_DONE flag, yyjson consumes (or rejects)
+  // all of its input.
+  src->meta.ri = src->meta.wi;
+  yyjson_doc_free(doc);
+  return NULL;
+}
@@ -0,0 +1,62 @@
+// Copyright 2022 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ----------------
+
+// The mimic library is libwebp. Its lossless (VP8L) decoder is exact, so
+// Wuffs' std/webp output should match it byte for byte.
+
+#include "webp/decode.h"
+
+const char*  //
+mimic_webp_decode(uint64_t* n_bytes_out,
+                  wuffs_base__io_buffer* dst,
+                  uint32_t wuffs_initialize_flags,
+                  wuffs_base__pixel_format pixfmt,
+                  uint32_t* quirks_ptr,
+                  size_t quirks_len,
+                  wuffs_base__io_buffer* src) {
+  wuffs_base__io_buffer dst_fallback =
+      wuffs_base__slice_u8__writer(g_mimiclib_scratch_slice_u8);
+  if (!dst) {
+    dst = &dst_fallback;
+  }
+
+  if (pixfmt.repr != WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL) {
+    return "mimic_webp_decode: unsupported pixfmt";
+  }
+
+  const uint8_t* data = wuffs_base__io_buffer__reader_pointer(src);
+  size_t data_size = wuffs_base__io_buffer__reader_length(src);
+  int width = 0;
+  int height = 0;
+  if (!WebPGetInfo(data, data_size, &width, &height)) {
+    return "mimic_webp_decode: WebPGetInfo failed";
+  }
+
+  size_t n = 4 * ((size_t)width) * ((size_t)height);
+  if (n > wuffs_base__io_buffer__writer_length(dst)) {
+    return "mimic_webp_decode: image is too large";
+  }
+  if (!WebPDecodeBGRAInto(data, data_size,
+                          wuffs_base__io_buffer__writer_pointer(dst), n,
+                          4 * width)) {
+    return "mimic_webp_decode: WebPDecodeBGRAInto failed";
+  }
+  dst->meta.wi += n;
+  if (n_bytes_out) {
+    *n_bytes_out += n;
+  }
+  return NULL;
+}
@@ -0,0 +1,62 @@
+// Copyright 2022 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// ----------------
+
+#include "zstd.h"
+
+const char*  //
+mimic_zstd_decode(wuffs_base__io_buffer* dst,
+                  wuffs_base__io_buffer* src,
+                  uint32_t wuffs_initialize_flags,
+                  uint64_t wlimit,
+                  uint64_t rlimit) {
+  ZSTD_DStream* zds = ZSTD_createDStream();
+  if (!zds) {
+    return "ZSTD_createDStream failed";
+  }
+
+  const char* ret = NULL;
+  while (true) {
+    size_t n_dst = dst->data.len - dst->meta.wi;
+    if (n_dst > wlimit) {
+      n_dst = wlimit;
+    }
+    size_t n_src = src->meta.wi - src->meta.ri;
+    if (n_src > rlimit) {
+      n_src = rlimit;
+    }
+
+    ZSTD_outBuffer out = {dst->data.ptr + dst->meta.wi, n_dst, 0};
+    ZSTD_inBuffer in = {src->data.ptr + src->meta.ri, n_src, 0};
+    size_t hint = ZSTD_decompressStream(zds, &out, &in);
+    dst->meta.wi += out.pos;
+    src->meta.ri += in.pos;
+
+    if (ZSTD_isError(hint)) {
+      ret = ZSTD_getErrorName(hint);
+      break;
+    } else if (hint == 0) {
+      break;
+    } else if ((out.pos == 0) && (in.pos == 0)) {
+      ret = (dst->meta.wi == dst->data.len) ? "dst is full"
+                                             : "src is truncated";
+      break;
+    }
+  }
+
+  ZSTD_freeDStream(zds);
+  return ret;
+}
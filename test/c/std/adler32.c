@@ -77,8 +77,59 @@ golden_test g_adler32_pi_gt = {
     .src_filename = "test/data/pi.txt",
 };
 
+golden_test g_adler32_harvesters_gt = {
+    .src_filename = "test/data/harvesters.bmp",
+};
+
 // ---------------- Adler32 Tests
 
+const char*  //
+test_wuffs_adler32_combine() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, "test/data/hat.png"));
+  // The want value is determined by script/checksum.go.
+  const uint32_t want = 0xDFC6C9C6;
+
+  size_t splits[] = {
+      0, 1, 63, 64, 255, 256, 1000, src.meta.wi / 2, src.meta.wi - 1,
+      src.meta.wi,
+  };
+  for (size_t tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(splits); tc++) {
+    wuffs_base__slice_u8 a = ((wuffs_base__slice_u8){
+        .ptr = src.data.ptr,
+        .len = splits[tc],
+    });
+    wuffs_base__slice_u8 b = ((wuffs_base__slice_u8){
+        .ptr = src.data.ptr + splits[tc],
+        .len = src.meta.wi - splits[tc],
+    });
+
+    wuffs_adler32__hasher ha;
+    CHECK_STATUS("initialize a",
+                 wuffs_adler32__hasher__initialize(
+                     &ha, sizeof ha, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_adler32__hasher hb;
+    CHECK_STATUS("initialize b",
+                 wuffs_adler32__hasher__initialize(
+                     &hb, sizeof hb, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+
+    wuffs_adler32__hasher__update_u32(&ha, a);
+    uint32_t checksum_b = wuffs_adler32__hasher__update_u32(&hb, b);
+    uint32_t have = wuffs_adler32__hasher__combine_u32(&ha, checksum_b, b.len);
+    if (have != want) {
+      RETURN_FAIL("tc=%zu: have 0x%08" PRIX32 ", want 0x%08" PRIX32, tc, have,
+                  want);
+    }
+  }
+  return NULL;
+}
+
 const char*  //
 test_wuffs_adler32_interface() {
   CHECK_FOCUS(__func__);
@@ -225,6 +276,64 @@ test_wuffs_adler32_pi() {
   return NULL;
 }
 
+const char*  //
+test_wuffs_adler32_x4() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, "test/data/hat.png"));
+
+  // Each lane hashes a different (offset, length) range of src, in two
+  // update_x4 calls, and should agree with a single-lane hasher.
+  const size_t lengths[] = {
+      0, 1, 15, 16, 31, 32, 33, 63, 64, 100, 127, 128, 200, 1000, 5553, 10000,
+  };
+  const size_t n = WUFFS_TESTLIB_ARRAY_SIZE(lengths);
+  for (size_t tc = 0; tc < n * n; tc++) {
+    wuffs_base__slice_u8 x[4][2];
+    uint32_t want[4];
+    for (size_t i = 0; i < 4; i++) {
+      size_t length = lengths[((tc / n) + (i * (tc % n))) % n];
+      size_t split = (tc % 3 == 0) ? 0 : (length / (tc % 3));
+      uint8_t* ptr = src.data.ptr + (3 * i);
+      if ((3 * i + length) > src.meta.wi) {
+        RETURN_FAIL("source file is too short");
+      }
+      x[i][0] = wuffs_base__make_slice_u8(ptr, split);
+      x[i][1] = wuffs_base__make_slice_u8(ptr + split, length - split);
+
+      wuffs_adler32__hasher h;
+      CHECK_STATUS("initialize",
+                   wuffs_adler32__hasher__initialize(
+                       &h, sizeof h, WUFFS_VERSION,
+                       WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+      want[i] = wuffs_adler32__hasher__update_u32(
+          &h, wuffs_base__make_slice_u8(ptr, length));
+    }
+
+    wuffs_adler32__hasher_x4 h;
+    CHECK_STATUS("initialize x4",
+                 wuffs_adler32__hasher_x4__initialize(
+                     &h, sizeof h, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    for (size_t j = 0; j < 2; j++) {
+      wuffs_adler32__hasher_x4__update_x4(&h, x[0][j], x[1][j], x[2][j],
+                                          x[3][j]);
+    }
+    for (size_t i = 0; i < 4; i++) {
+      uint32_t have =
+          wuffs_adler32__hasher_x4__checksum_u32(&h, (uint32_t)i);
+      if (have != want[i]) {
+        RETURN_FAIL("tc=%zu, lane=%zu: have 0x%08" PRIX32 ", want 0x%08" PRIX32,
+                    tc, i, have, want[i]);
+      }
+    }
+  }
+  return NULL;
+}
+
 // ---------------- Adler32 Benches
 
 uint32_t g_wuffs_adler32_unused_u32;
@@ -270,6 +379,15 @@ bench_wuffs_adler32_100k() {
       &g_adler32_pi_gt, UINT64_MAX, UINT64_MAX, 150);
 }
 
+const char*  //
+bench_wuffs_adler32_1000k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_bench_adler32,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_src,
+      &g_adler32_harvesters_gt, UINT64_MAX, UINT64_MAX, 5);
+}
+
 // ---------------- Mimic Benches
 
 #ifdef WUFFS_MIMIC
@@ -289,6 +407,14 @@ bench_mimic_adler32_100k() {
                              &g_adler32_pi_gt, UINT64_MAX, UINT64_MAX, 150);
 }
 
+const char*  //
+bench_mimic_adler32_1000k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(mimic_bench_adler32, 0, tcounter_src,
+                             &g_adler32_harvesters_gt, UINT64_MAX, UINT64_MAX,
+                             5);
+}
+
 #endif  // WUFFS_MIMIC
 
 // ---------------- Manifest
@@ -298,9 +424,11 @@ bench_mimic_adler32_100k() {
 
 proc g_tests[] = {
 
+    test_wuffs_adler32_combine,
     test_wuffs_adler32_golden,
     test_wuffs_adler32_interface,
     test_wuffs_adler32_pi,
+    test_wuffs_adler32_x4,
 
     NULL,
 };
@@ -309,11 +437,13 @@ proc g_benches[] = {
 
     bench_wuffs_adler32_10k,
     bench_wuffs_adler32_100k,
+    bench_wuffs_adler32_1000k,
 
 #ifdef WUFFS_MIMIC
 
     bench_mimic_adler32_10k,
     bench_mimic_adler32_100k,
+    bench_mimic_adler32_1000k,
 
 #endif  // WUFFS_MIMIC
 
@@ -179,6 +179,139 @@ test_wuffs_bmp_decode_io_redirect() {
   return NULL;
 }
 
+const char*  //
+test_wuffs_bmp_decode_roi() {
+  CHECK_FOCUS(__func__);
+
+  // These cover the none, RLE, bitfields and low bit depth compressions.
+  const char* filenames[4] = {
+      "test/data/hat.bmp",
+      "test/data/bricks-dither.bmp",
+      "test/data/hibiscus.primitive.bmp",
+      "test/data/pjw-thumbnail.bmp",
+  };
+
+  int i;
+  for (i = 0; i < 4; i++) {
+    wuffs_bmp__decoder full_dec;
+    CHECK_STATUS("initialize",
+                 wuffs_bmp__decoder__initialize(
+                     &full_dec, sizeof full_dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_bmp__decoder roi_dec;
+    CHECK_STATUS("initialize",
+                 wuffs_bmp__decoder__initialize(
+                     &roi_dec, sizeof roi_dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    CHECK_STRING(do_test__wuffs_base__image_decoder_roi(
+        wuffs_bmp__decoder__upcast_as__wuffs_base__image_decoder(&full_dec),
+        wuffs_bmp__decoder__upcast_as__wuffs_base__image_decoder(&roi_dec),
+        filenames[i], wuffs_base__make_rect_ie_u32(5, 9, 29, 1000), 57));
+  }
+  return NULL;
+}
+
+const char*  //
+do_test_wuffs_bmp_decode_blend(wuffs_base__slice_u8 dst,
+                               wuffs_base__pixel_blend blend,
+                               const char* src_filename,
+                               size_t* n_bytes) {
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, src_filename));
+
+  wuffs_bmp__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_bmp__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_base__image_config ic = ((wuffs_base__image_config){});
+  CHECK_STATUS("decode_image_config",
+               wuffs_bmp__decoder__decode_image_config(&dec, &ic, &src));
+  uint32_t width = wuffs_base__pixel_config__width(&ic.pixcfg);
+  uint32_t height = wuffs_base__pixel_config__height(&ic.pixcfg);
+  if (((uint64_t)width * (uint64_t)height * 4) > dst.len) {
+    return "image dimensions are too large";
+  }
+  *n_bytes = (size_t)width * (size_t)height * 4;
+  memset(dst.ptr, 0, *n_bytes);
+  wuffs_base__pixel_config__set(&ic.pixcfg,
+                                WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+                                WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, width,
+                                height);
+  wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("set_from_slice",
+               wuffs_base__pixel_buffer__set_from_slice(&pb, &ic.pixcfg, dst));
+  CHECK_STATUS("decode_frame",
+               wuffs_bmp__decoder__decode_frame(&dec, &pb, &src, blend,
+                                                g_work_slice_u8, NULL));
+  return NULL;
+}
+
+const char*  //
+test_wuffs_bmp_decode_rle_runs() {
+  CHECK_FOCUS(__func__);
+
+  // With the SRC blend, RLE runs are swizzled once and then replicated. With
+  // SRC_OVER, they go one pixel at a time. The image is opaque, so both
+  // blends should produce the same pixels.
+  size_t want_n = 0;
+  CHECK_STRING(do_test_wuffs_bmp_decode_blend(
+      g_want_slice_u8, WUFFS_BASE__PIXEL_BLEND__SRC, "test/data/bricks-dither.bmp", &want_n));
+  size_t have_n = 0;
+  CHECK_STRING(do_test_wuffs_bmp_decode_blend(
+      g_have_slice_u8, WUFFS_BASE__PIXEL_BLEND__SRC_OVER, "test/data/bricks-dither.bmp", &have_n));
+  if (have_n != want_n) {
+    RETURN_FAIL("n_bytes: have %zu, want %zu", have_n, want_n);
+  }
+  size_t i;
+  for (i = 0; i < want_n; i++) {
+    if (g_have_slice_u8.ptr[i] != g_want_slice_u8.ptr[i]) {
+      RETURN_FAIL("byte #%zu: have 0x%02X, want 0x%02X", i,
+                  g_have_slice_u8.ptr[i], g_want_slice_u8.ptr[i]);
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_bmp_decode_row_bands() {
+  CHECK_FOCUS(__func__);
+
+  // These cover the none, bitfields and low bit depth compressions. RLE
+  // compression does not support row bands.
+  const char* filenames[3] = {
+      "test/data/hat.bmp",
+      "test/data/hibiscus.primitive.bmp",
+      "test/data/pjw-thumbnail.bmp",
+  };
+  const uint32_t band_heights[3] = {1, 7, 1000};
+
+  int i;
+  for (i = 0; i < 3; i++) {
+    int j;
+    for (j = 0; j < 3; j++) {
+      wuffs_bmp__decoder full_dec;
+      CHECK_STATUS("initialize",
+                   wuffs_bmp__decoder__initialize(
+                       &full_dec, sizeof full_dec, WUFFS_VERSION,
+                       WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+      wuffs_bmp__decoder band_dec;
+      CHECK_STATUS("initialize",
+                   wuffs_bmp__decoder__initialize(
+                       &band_dec, sizeof band_dec, WUFFS_VERSION,
+                       WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+      CHECK_STRING(do_test__wuffs_base__image_decoder_row_bands(
+          wuffs_bmp__decoder__upcast_as__wuffs_base__image_decoder(&full_dec),
+          wuffs_bmp__decoder__upcast_as__wuffs_base__image_decoder(&band_dec),
+          filenames[i], wuffs_base__make_rect_ie_u32(5, 9, 29, 1000), band_heights[j],
+          57));
+    }
+  }
+  return NULL;
+}
+
 // ---------------- Mimic Tests
 
 #ifdef WUFFS_MIMIC
@@ -213,6 +346,9 @@ proc g_tests[] = {
     test_wuffs_bmp_decode_frame_config,
     test_wuffs_bmp_decode_interface,
     test_wuffs_bmp_decode_io_redirect,
+    test_wuffs_bmp_decode_rle_runs,
+    test_wuffs_bmp_decode_roi,
+    test_wuffs_bmp_decode_row_bands,
 
 #ifdef WUFFS_MIMIC
 
@@ -37,7 +37,7 @@ the first "./a.out" with "./a.out -bench". Combine these changes with the
 "wuffs mimic cflags" to run the mimic benchmarks.
 */
 
-// ¿ wuffs mimic cflags: -DWUFFS_MIMIC
+// ¿ wuffs mimic cflags: -DWUFFS_MIMIC -lcbor
 
 // Wuffs ships as a "single file C library" or "header file library" as per
 // https://github.com/nothings/stb/blob/master/docs/stb_howto.txt
@@ -64,7 +64,7 @@ the first "./a.out" with "./a.out -bench". Combine these changes with the
 #include "../../../release/c/wuffs-unsupported-snapshot.c"
 #include "../testlib/testlib.c"
 #ifdef WUFFS_MIMIC
-// No mimic library.
+#include "../mimiclib/cbor.c"
 #endif
 
 // ---------------- Golden Tests
@@ -74,8 +74,64 @@ golden_test g_cbor_cbor_rfc_7049_examples_gt = {
     .src_filename = "test/data/cbor-rfc-7049-examples.cbor",
 };
 
+golden_test g_cbor_nobel_prizes_gt = {
+    .src_filename = "test/data/nobel-prizes.cbor",
+};
+
+// gen_cbor_deeply_nested generates indefinite-length arrays (0x9F ... 0xFF),
+// nested as deep as the decoder allows. It is a worst case input: every byte
+// changes the depth.
+const char*  //
+gen_cbor_deeply_nested(wuffs_base__io_buffer* dst) {
+  size_t depth = WUFFS_CBOR__DECODER_DEPTH_MAX_INCL;
+  if ((dst->data.len - dst->meta.wi) < (2 * depth)) {
+    return "gen_cbor_deeply_nested: dst buffer is too short";
+  }
+  memset(dst->data.ptr + dst->meta.wi, 0x9F, depth);
+  dst->meta.wi += depth;
+  memset(dst->data.ptr + dst->meta.wi, 0xFF, depth);
+  dst->meta.wi += depth;
+  return NULL;
+}
+
+golden_test g_cbor_deeply_nested_gt = {
+    .src_generator = gen_cbor_deeply_nested,
+};
+
 // ---------------- CBOR Tests
 
+const char*  //
+wuffs_cbor_decode(wuffs_base__token_buffer* tok,
+                  wuffs_base__io_buffer* src,
+                  uint32_t wuffs_initialize_flags,
+                  uint64_t wlimit,
+                  uint64_t rlimit) {
+  wuffs_cbor__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_cbor__decoder__initialize(&dec, sizeof dec, WUFFS_VERSION,
+                                               wuffs_initialize_flags));
+
+  while (true) {
+    wuffs_base__token_buffer limited_tok =
+        make_limited_token_writer(*tok, wlimit);
+    wuffs_base__io_buffer limited_src = make_limited_reader(*src, rlimit);
+
+    wuffs_base__status status = wuffs_cbor__decoder__decode_tokens(
+        &dec, &limited_tok, &limited_src, g_work_slice_u8);
+
+    tok->meta.wi += limited_tok.meta.wi;
+    src->meta.ri += limited_src.meta.ri;
+
+    if (((wlimit < UINT64_MAX) &&
+         (status.repr == wuffs_base__suspension__short_write)) ||
+        ((rlimit < UINT64_MAX) &&
+         (status.repr == wuffs_base__suspension__short_read))) {
+      continue;
+    }
+    return status.repr;
+  }
+}
+
 const char*  //
 test_wuffs_cbor_decode_interface() {
   CHECK_FOCUS(__func__);
@@ -188,19 +244,58 @@ test_wuffs_cbor_decode_valid() {
 
 #ifdef WUFFS_MIMIC
 
-// No mimic tests.
+// The RFC 7049 examples include unassigned simple values (e.g. "simple(16)"),
+// which libcbor rejects, so the mimic tests use a different file.
+
+const char*  //
+test_mimic_cbor_decode_nobel_prizes() {
+  CHECK_FOCUS(__func__);
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, g_cbor_nobel_prizes_gt.src_filename));
+  CHECK_STRING(mimic_cbor_decode(&have, &src, WUFFS_INITIALIZE__DEFAULT_OPTIONS,
+                                 UINT64_MAX, UINT64_MAX));
+  if (src.meta.ri != src.meta.wi) {
+    RETURN_FAIL("src.meta.ri: have %zu, want %zu", src.meta.ri, src.meta.wi);
+  }
+  return NULL;
+}
 
 #endif  // WUFFS_MIMIC
 
 // ---------------- CBOR Benches
 
-// No CBOR benches.
+const char*  //
+bench_wuffs_cbor_decode_190k_stringy() {
+  CHECK_FOCUS(__func__);
+  return do_bench_token_decoder(
+      wuffs_cbor_decode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      tcounter_src, &g_cbor_nobel_prizes_gt, UINT64_MAX, UINT64_MAX, 30);
+}
+
+const char*  //
+bench_wuffs_cbor_decode_2k_deeply_nested() {
+  CHECK_FOCUS(__func__);
+  return do_bench_token_decoder(
+      wuffs_cbor_decode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      tcounter_src, &g_cbor_deeply_nested_gt, UINT64_MAX, UINT64_MAX, 2000);
+}
 
 // ---------------- Mimic Benches
 
 #ifdef WUFFS_MIMIC
 
-// No mimic benches.
+const char*  //
+bench_mimic_cbor_decode_190k_stringy() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      mimic_cbor_decode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      tcounter_src, &g_cbor_nobel_prizes_gt, UINT64_MAX, UINT64_MAX, 30);
+}
 
 #endif  // WUFFS_MIMIC
 
@@ -214,7 +309,7 @@ proc g_tests[] = {
 
 #ifdef WUFFS_MIMIC
 
-// No mimic tests.
+    test_mimic_cbor_decode_nobel_prizes,
 
 #endif  // WUFFS_MIMIC
 
@@ -223,11 +318,12 @@ proc g_tests[] = {
 
 proc g_benches[] = {
 
-// No CBOR benches.
+    bench_wuffs_cbor_decode_190k_stringy,
+    bench_wuffs_cbor_decode_2k_deeply_nested,
 
 #ifdef WUFFS_MIMIC
 
-// No mimic benches.
+    bench_mimic_cbor_decode_190k_stringy,
 
 #endif  // WUFFS_MIMIC
 
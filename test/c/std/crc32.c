@@ -77,8 +77,60 @@ golden_test g_crc32_pi_gt = {
     .src_filename = "test/data/pi.txt",
 };
 
+golden_test g_crc32_harvesters_gt = {
+    .src_filename = "test/data/harvesters.bmp",
+};
+
 // ---------------- CRC32 Tests
 
+const char*  //
+test_wuffs_crc32_ieee_combine() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, "test/data/hat.png"));
+  // The want value is determined by script/checksum.go.
+  const uint32_t want = 0xD5DA5C2F;
+
+  size_t splits[] = {
+      0, 1, 63, 64, 255, 256, 1000, src.meta.wi / 2, src.meta.wi - 1,
+      src.meta.wi,
+  };
+  for (size_t tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(splits); tc++) {
+    wuffs_base__slice_u8 a = ((wuffs_base__slice_u8){
+        .ptr = src.data.ptr,
+        .len = splits[tc],
+    });
+    wuffs_base__slice_u8 b = ((wuffs_base__slice_u8){
+        .ptr = src.data.ptr + splits[tc],
+        .len = src.meta.wi - splits[tc],
+    });
+
+    wuffs_crc32__ieee_hasher ha;
+    CHECK_STATUS("initialize a",
+                 wuffs_crc32__ieee_hasher__initialize(
+                     &ha, sizeof ha, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_crc32__ieee_hasher hb;
+    CHECK_STATUS("initialize b",
+                 wuffs_crc32__ieee_hasher__initialize(
+                     &hb, sizeof hb, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+
+    wuffs_crc32__ieee_hasher__update_u32(&ha, a);
+    uint32_t checksum_b = wuffs_crc32__ieee_hasher__update_u32(&hb, b);
+    uint32_t have =
+        wuffs_crc32__ieee_hasher__combine_u32(&ha, checksum_b, b.len);
+    if (have != want) {
+      RETURN_FAIL("tc=%zu: have 0x%08" PRIX32 ", want 0x%08" PRIX32, tc, have,
+                  want);
+    }
+  }
+  return NULL;
+}
+
 const char*  //
 test_wuffs_crc32_ieee_interface() {
   CHECK_FOCUS(__func__);
@@ -92,6 +144,54 @@ test_wuffs_crc32_ieee_interface() {
       "test/data/hat.lossy.webp", 0, SIZE_MAX, 0x89F53B4E);
 }
 
+const char*  //
+test_wuffs_crc32_ieee_disabled_cpu_arch() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, "test/data/hat.png"));
+  // The want value is determined by script/checksum.go.
+  const uint32_t want = 0xD5DA5C2F;
+
+  // Each hasher chooses its implementation when first updated, so every
+  // combination of enabled features should give the same checksum.
+  wuffs_base__cpu_arch__set_disabled_features(0);
+  uint32_t detected = wuffs_base__cpu_arch__features();
+  uint32_t disableds[] = {
+      0,
+      WUFFS_BASE__CPU_ARCH__FEATURE__X86_AVX512,
+      WUFFS_BASE__CPU_ARCH__FEATURE__X86_AVX512 |
+          WUFFS_BASE__CPU_ARCH__FEATURE__X86_AVX2,
+      WUFFS_BASE__CPU_ARCH__FEATURE__ALL,
+  };
+  const char* ret = NULL;
+  for (size_t tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(disableds); tc++) {
+    wuffs_base__cpu_arch__set_disabled_features(disableds[tc]);
+    uint32_t features = wuffs_base__cpu_arch__features();
+    if (features != (detected & ~disableds[tc])) {
+      ret = "features: inconsistent with set_disabled_features";
+      break;
+    }
+
+    wuffs_crc32__ieee_hasher h;
+    CHECK_STATUS("initialize",
+                 wuffs_crc32__ieee_hasher__initialize(
+                     &h, sizeof h, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    uint32_t have = wuffs_crc32__ieee_hasher__update_u32(
+        &h, wuffs_base__io_buffer__reader_slice(&src));
+    if (have != want) {
+      ret = "checksum: have the wrong value";
+      break;
+    }
+  }
+  wuffs_base__cpu_arch__set_disabled_features(
+      g_flags.nosimd ? WUFFS_BASE__CPU_ARCH__FEATURE__ALL : 0);
+  return ret;
+}
+
 const char*  //
 test_wuffs_crc32_ieee_golden() {
   CHECK_FOCUS(__func__);
@@ -250,6 +350,64 @@ test_wuffs_crc32_ieee_pi() {
   return do_test_xxxxx_crc32_ieee_pi(false);
 }
 
+const char*  //
+test_wuffs_crc32_ieee_x4() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, "test/data/hat.png"));
+
+  // Each lane hashes a different (offset, length) range of src, in two
+  // update_x4 calls, and should agree with a single-lane ieee_hasher.
+  const size_t lengths[] = {
+      0, 1, 15, 16, 31, 32, 33, 63, 64, 100, 127, 128, 200, 1000, 5553, 10000,
+  };
+  const size_t n = WUFFS_TESTLIB_ARRAY_SIZE(lengths);
+  for (size_t tc = 0; tc < n * n; tc++) {
+    wuffs_base__slice_u8 x[4][2];
+    uint32_t want[4];
+    for (size_t i = 0; i < 4; i++) {
+      size_t length = lengths[((tc / n) + (i * (tc % n))) % n];
+      size_t split = (tc % 3 == 0) ? 0 : (length / (tc % 3));
+      uint8_t* ptr = src.data.ptr + (3 * i);
+      if ((3 * i + length) > src.meta.wi) {
+        RETURN_FAIL("source file is too short");
+      }
+      x[i][0] = wuffs_base__make_slice_u8(ptr, split);
+      x[i][1] = wuffs_base__make_slice_u8(ptr + split, length - split);
+
+      wuffs_crc32__ieee_hasher h;
+      CHECK_STATUS("initialize",
+                   wuffs_crc32__ieee_hasher__initialize(
+                       &h, sizeof h, WUFFS_VERSION,
+                       WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+      want[i] = wuffs_crc32__ieee_hasher__update_u32(
+          &h, wuffs_base__make_slice_u8(ptr, length));
+    }
+
+    wuffs_crc32__ieee_hasher_x4 h;
+    CHECK_STATUS("initialize x4",
+                 wuffs_crc32__ieee_hasher_x4__initialize(
+                     &h, sizeof h, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    for (size_t j = 0; j < 2; j++) {
+      wuffs_crc32__ieee_hasher_x4__update_x4(&h, x[0][j], x[1][j], x[2][j],
+                                             x[3][j]);
+    }
+    for (size_t i = 0; i < 4; i++) {
+      uint32_t have =
+          wuffs_crc32__ieee_hasher_x4__checksum_u32(&h, (uint32_t)i);
+      if (have != want[i]) {
+        RETURN_FAIL("tc=%zu, lane=%zu: have 0x%08" PRIX32 ", want 0x%08" PRIX32,
+                    tc, i, have, want[i]);
+      }
+    }
+  }
+  return NULL;
+}
+
 // ---------------- Mimic Tests
 
 #ifdef WUFFS_MIMIC
@@ -307,6 +465,15 @@ bench_wuffs_crc32_ieee_100k() {
       &g_crc32_pi_gt, UINT64_MAX, UINT64_MAX, 150);
 }
 
+const char*  //
+bench_wuffs_crc32_ieee_1000k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_bench_crc32_ieee,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_src,
+      &g_crc32_harvesters_gt, UINT64_MAX, UINT64_MAX, 5);
+}
+
 // ---------------- Mimic Benches
 
 #ifdef WUFFS_MIMIC
@@ -326,6 +493,14 @@ bench_mimic_crc32_ieee_100k() {
                              &g_crc32_pi_gt, UINT64_MAX, UINT64_MAX, 150);
 }
 
+const char*  //
+bench_mimic_crc32_ieee_1000k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(mimic_bench_crc32_ieee, 0, tcounter_src,
+                             &g_crc32_harvesters_gt, UINT64_MAX, UINT64_MAX,
+                             5);
+}
+
 #endif  // WUFFS_MIMIC
 
 // ---------------- Manifest
@@ -335,9 +510,12 @@ bench_mimic_crc32_ieee_100k() {
 
 proc g_tests[] = {
 
+    test_wuffs_crc32_ieee_combine,
+    test_wuffs_crc32_ieee_disabled_cpu_arch,
     test_wuffs_crc32_ieee_golden,
     test_wuffs_crc32_ieee_interface,
     test_wuffs_crc32_ieee_pi,
+    test_wuffs_crc32_ieee_x4,
 
 #ifdef WUFFS_MIMIC
 
@@ -352,11 +530,13 @@ proc g_benches[] = {
 
     bench_wuffs_crc32_ieee_10k,
     bench_wuffs_crc32_ieee_100k,
+    bench_wuffs_crc32_ieee_1000k,
 
 #ifdef WUFFS_MIMIC
 
     bench_mimic_crc32_ieee_10k,
     bench_mimic_crc32_ieee_100k,
+    bench_mimic_crc32_ieee_1000k,
 
 #endif  // WUFFS_MIMIC
 
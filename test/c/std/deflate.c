@@ -125,6 +125,10 @@ golden_test g_deflate_deflate_huffman_primlen_9_gt = {
         "huffman-primlen-9.deflate",
 };
 
+golden_test g_deflate_encode_pi_gt = {
+    .src_filename = "test/data/pi.txt",
+};
+
 golden_test g_deflate_midsummer_gt = {
     .want_filename = "test/data/midsummer.txt",
     .src_filename = "test/data/midsummer.txt.gz",
@@ -151,6 +155,98 @@ golden_test g_deflate_romeo_fixed_gt = {
     .src_filename = "test/data/romeo.txt.fixed-huff.deflate",
 };
 
+// gen_deflate_bit_writer writes LSB-first bits, as per RFC 1951.
+typedef struct {
+  wuffs_base__io_buffer* dst;
+  uint64_t bits;
+  uint32_t n_bits;
+  bool overflow;
+} gen_deflate_bit_writer;
+
+void  //
+gen_deflate_write_bits(gen_deflate_bit_writer* w,
+                       uint32_t value,
+                       uint32_t width) {
+  w->bits |= ((uint64_t)value) << w->n_bits;
+  w->n_bits += width;
+  while (w->n_bits >= 8) {
+    if (w->dst->meta.wi >= w->dst->data.len) {
+      w->overflow = true;
+      return;
+    }
+    w->dst->data.ptr[w->dst->meta.wi++] = (uint8_t)(w->bits);
+    w->bits >>= 8;
+    w->n_bits -= 8;
+  }
+}
+
+// gen_deflate_write_code writes a Huffman code, which (unlike other values)
+// is packed starting with its most significant bit.
+void  //
+gen_deflate_write_code(gen_deflate_bit_writer* w,
+                       uint32_t code,
+                       uint32_t width) {
+  uint32_t reversed = 0;
+  for (uint32_t i = 0; i < width; i++) {
+    reversed = (reversed << 1) | ((code >> i) & 1);
+  }
+  gen_deflate_write_bits(w, reversed, width);
+}
+
+// gen_deflate_many_tiny_blocks generates thousands of dynamic Huffman blocks,
+// each holding only 8 literals. It is a worst case input: the decoder spends
+// most of its time building Huffman tables, each used for only a few symbols.
+const char*  //
+gen_deflate_many_tiny_blocks(wuffs_base__io_buffer* dst) {
+  // The code length code lengths, in the RFC 1951 section 3.2.7 order, give
+  // the 1, 8, 9 and 16 symbols a 2 bit code: 0b00, 0b01, 0b10 and 0b11.
+  static const uint8_t clcls[18] = {
+      2, 0, 0, 0, 2, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2,
+  };
+  const uint32_t n_blocks = 4096;
+
+  gen_deflate_bit_writer w = ((gen_deflate_bit_writer){.dst = dst});
+  for (uint32_t i = 0; i < n_blocks; i++) {
+    gen_deflate_write_bits(&w, (i + 1 == n_blocks) ? 1 : 0, 1);  // BFINAL.
+    gen_deflate_write_bits(&w, 2, 2);   // BTYPE: dynamic Huffman.
+    gen_deflate_write_bits(&w, 0, 5);   // HLIT: 257 literal/length codes.
+    gen_deflate_write_bits(&w, 1, 5);   // HDIST: 2 distance codes.
+    gen_deflate_write_bits(&w, 14, 4);  // HCLEN: 18 code length codes.
+    for (uint32_t j = 0; j < 18; j++) {
+      gen_deflate_write_bits(&w, clcls[j], 3);
+    }
+
+    // Literals 0 ..= 254 have length 8. Literal 255 and the end-of-block
+    // code (256) have length 9. Both distance codes have length 1.
+    gen_deflate_write_code(&w, 1, 2);
+    for (uint32_t j = 0; j < 42; j++) {
+      gen_deflate_write_code(&w, 3, 2);   // Repeat the previous length...
+      gen_deflate_write_bits(&w, 3, 2);   // ...6 times.
+    }
+    gen_deflate_write_code(&w, 1, 2);
+    gen_deflate_write_code(&w, 1, 2);
+    gen_deflate_write_code(&w, 2, 2);
+    gen_deflate_write_code(&w, 2, 2);
+    gen_deflate_write_code(&w, 0, 2);
+    gen_deflate_write_code(&w, 0, 2);
+
+    // The canonical codes are 0 ..= 254 (8 bits) then 510 and 511 (9 bits).
+    for (uint32_t j = 0; j < 8; j++) {
+      gen_deflate_write_code(&w, (i + j) & 0x7F, 8);
+    }
+    gen_deflate_write_code(&w, 511, 9);
+  }
+  gen_deflate_write_bits(&w, 0, 7);  // Flush.
+  if (w.overflow) {
+    return "gen_deflate_many_tiny_blocks: dst buffer is too short";
+  }
+  return NULL;
+}
+
+golden_test g_deflate_many_tiny_blocks_gt = {
+    .src_generator = gen_deflate_many_tiny_blocks,
+};
+
 // ---------------- Deflate Tests
 
 const char*  //
@@ -197,6 +293,51 @@ wuffs_deflate_decode(wuffs_base__io_buffer* dst,
   }
 }
 
+const char*  //
+wuffs_deflate_decode_dst_holds_history(wuffs_base__io_buffer* dst,
+                                       wuffs_base__io_buffer* src,
+                                       uint32_t wuffs_initialize_flags,
+                                       uint64_t wlimit,
+                                       uint64_t rlimit) {
+  wuffs_deflate__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_deflate__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION, wuffs_initialize_flags));
+  wuffs_deflate__decoder__set_dst_holds_history(&dec, true);
+
+  while (true) {
+    // Slide a window over dst, so that the window's history is (up to) the
+    // most recent 32 KiB of what was written to dst.
+    size_t n_history = (dst->meta.wi < 0x8000) ? dst->meta.wi : 0x8000;
+    size_t n_room = dst->data.len - dst->meta.wi;
+    if (n_room > wlimit) {
+      n_room = (size_t)wlimit;
+    }
+    wuffs_base__io_buffer window = ((wuffs_base__io_buffer){
+        .data = wuffs_base__make_slice_u8(
+            dst->data.ptr + dst->meta.wi - n_history, n_history + n_room),
+        .meta = wuffs_base__make_io_buffer_meta(
+            n_history, 0, dst->meta.pos + dst->meta.wi - n_history,
+            dst->meta.closed),
+    });
+    wuffs_base__io_buffer limited_src = make_limited_reader(*src, rlimit);
+
+    wuffs_base__status status = wuffs_deflate__decoder__transform_io(
+        &dec, &window, &limited_src, wuffs_base__empty_slice_u8());
+
+    dst->meta.wi += window.meta.wi - n_history;
+    src->meta.ri += limited_src.meta.ri;
+
+    if (((wlimit < UINT64_MAX) &&
+         (status.repr == wuffs_base__suspension__short_write)) ||
+        ((rlimit < UINT64_MAX) &&
+         (status.repr == wuffs_base__suspension__short_read))) {
+      continue;
+    }
+    return status.repr;
+  }
+}
+
 const char*  //
 test_wuffs_deflate_decode_256_bytes() {
   CHECK_FOCUS(__func__);
@@ -270,8 +411,10 @@ test_wuffs_deflate_decode_deflate_huffman_primlen_9() {
                                    &dec, &have, &src, g_work_slice_u8));
 
   for (int i = 0; i < 2; i++) {
-    // Find the first unused (i.e. zero) entry in the i'th huffs table.
-    int have = WUFFS_DEFLATE__HUFFS_TABLE_SIZE;
+    // Find the first unused (i.e. zero) entry in the i'th huffs table. The
+    // clcode table, held at the end of huffs[0], is not part of the count.
+    int have = (i == 0) ? WUFFS_DEFLATE__CLCODE_HUFFS_TOP
+                        : WUFFS_DEFLATE__HUFFS_TABLE_SIZE;
     while ((have > 0) && (dec.private_data.f_huffs[i][have - 1] == 0)) {
       have--;
     }
@@ -294,6 +437,73 @@ test_wuffs_deflate_decode_midsummer() {
                             UINT64_MAX, UINT64_MAX);
 }
 
+const char*  //
+test_wuffs_deflate_decode_output_slices() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+  wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+      .data = g_want_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, g_deflate_pi_gt.src_filename));
+  src.meta.ri = g_deflate_pi_gt.src_offset0;
+  src.meta.wi = g_deflate_pi_gt.src_offset1;
+  CHECK_STRING(read_file(&want, g_deflate_pi_gt.want_filename));
+
+  for (int bad_pos = 0; bad_pos < 2; bad_pos++) {
+    wuffs_deflate__decoder dec;
+    CHECK_STATUS("initialize",
+                 wuffs_deflate__decoder__initialize(
+                     &dec, sizeof dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_deflate__decoder__set_report_output_slices(&dec, true);
+    have.meta.wi = 0;
+    have.meta.pos = 0;
+    src.meta.ri = g_deflate_pi_gt.src_offset0;
+
+    int num_slices = 0;
+    while (true) {
+      size_t old_wi = have.meta.wi;
+      wuffs_base__status status = wuffs_deflate__decoder__transform_io(
+          &dec, &have, &src, g_work_slice_u8);
+      if (bad_pos && (num_slices > 0)) {
+        if (status.repr != wuffs_base__error__bad_i_o_position) {
+          RETURN_FAIL("bad_pos: have \"%s\", want \"%s\"", status.repr,
+                      wuffs_base__error__bad_i_o_position);
+        }
+        break;
+      } else if (wuffs_base__status__is_ok(&status)) {
+        break;
+      } else if (status.repr != wuffs_deflate__suspension__output_slice) {
+        RETURN_FAIL("transform_io: have \"%s\", want \"%s\"", status.repr,
+                    wuffs_deflate__suspension__output_slice);
+      }
+      num_slices++;
+      if ((have.meta.wi - old_wi) > 0x4000) {
+        RETURN_FAIL("n=%d: slice length: have %zu, want <= 16384", num_slices,
+                    have.meta.wi - old_wi);
+      }
+      if (bad_pos) {
+        // Pretend that the caller compacted dst.
+        have.meta.pos++;
+      }
+    }
+
+    if (bad_pos) {
+      continue;
+    } else if (num_slices < 2) {
+      RETURN_FAIL("num_slices: have %d, want >= 2", num_slices);
+    }
+    CHECK_STRING(check_io_buffers_equal("", &have, &want));
+  }
+  return NULL;
+}
+
 const char*  //
 test_wuffs_deflate_decode_pi_just_one_read() {
   CHECK_FOCUS(__func__);
@@ -321,6 +531,121 @@ test_wuffs_deflate_decode_pi_many_small_writes_reads() {
   return do_test_io_buffers(wuffs_deflate_decode, &g_deflate_pi_gt, 59, 61);
 }
 
+const char*  //
+test_wuffs_deflate_decode_dst_holds_history() {
+  CHECK_FOCUS(__func__);
+  CHECK_STRING(do_test_io_buffers(wuffs_deflate_decode_dst_holds_history,
+                                  &g_deflate_deflate_distance_32768_gt, 1000,
+                                  UINT64_MAX));
+  CHECK_STRING(do_test_io_buffers(wuffs_deflate_decode_dst_holds_history,
+                                  &g_deflate_pi_gt, 4096, UINT64_MAX));
+  CHECK_STRING(do_test_io_buffers(wuffs_deflate_decode_dst_holds_history,
+                                  &g_deflate_pi_gt, 59, 61));
+
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file_fragment(&src, g_deflate_pi_gt.src_filename,
+                                  g_deflate_pi_gt.src_offset0,
+                                  g_deflate_pi_gt.src_offset1));
+
+  wuffs_deflate__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_deflate__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_deflate__decoder__set_dst_holds_history(&dec, true);
+  wuffs_base__range_ii_u64 workbuf_len =
+      wuffs_deflate__decoder__workbuf_len(&dec);
+  if (workbuf_len.max_incl != 0) {
+    RETURN_FAIL("workbuf_len.max_incl: have %" PRIu64 ", want 0",
+                workbuf_len.max_incl);
+  }
+
+  wuffs_base__io_buffer limited_have = make_limited_writer(have, 4096);
+  wuffs_base__status status = wuffs_deflate__decoder__transform_io(
+      &dec, &limited_have, &src, g_work_slice_u8);
+  if (status.repr != wuffs_base__suspension__short_write) {
+    RETURN_FAIL("transform_io #0: have \"%s\", want \"%s\"", status.repr,
+                wuffs_base__suspension__short_write);
+  }
+  uint64_t n_history = wuffs_deflate__decoder__copy_history(
+      &dec, g_want_slice_u8, g_work_slice_u8);
+  if (n_history != 0) {
+    RETURN_FAIL("copy_history: have %" PRIu64 ", want 0", n_history);
+  }
+
+  // Resuming without the 4096 bytes of history should be rejected, instead
+  // of silently producing incorrect output.
+  have.meta.wi = limited_have.meta.wi;
+  limited_have = make_limited_writer(have, 4096);
+  status = wuffs_deflate__decoder__transform_io(&dec, &limited_have, &src,
+                                                g_work_slice_u8);
+  if (status.repr != wuffs_base__error__bad_argument) {
+    RETURN_FAIL("transform_io #1: have \"%s\", want \"%s\"", status.repr,
+                wuffs_base__error__bad_argument);
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_deflate_decode_repeated_huffman_headers() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+  wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+      .data = g_want_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, "test/data/romeo.txt"));
+
+  // Encode prefixes of romeo.txt, each ending with a full flush. Encoding the
+  // same prefix twice in a row gives the same dynamic Huffman block header,
+  // so that the decoder can re-use its Huffman tables. The 10 byte prefix
+  // should be encoded as a fixed Huffman block.
+  const size_t lengths[6] = {
+      src.meta.wi, src.meta.wi, 10, src.meta.wi, src.meta.wi / 2, src.meta.wi,
+  };
+
+  wuffs_deflate__encoder enc;
+  CHECK_STATUS("initialize",
+               wuffs_deflate__encoder__initialize(
+                   &enc, sizeof enc, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_deflate__encoder__set_flush_mode(&enc,
+                                         WUFFS_DEFLATE__ENCODER_FLUSH_FULL);
+  for (int i = 0; i < 6; i++) {
+    src.meta.ri = 0;
+    src.meta.wi = lengths[i];
+    src.meta.closed = i == 5;
+    CHECK_STATUS("encode", wuffs_deflate__encoder__transform_io(
+                               &enc, &have, &src, g_work_slice_u8));
+  }
+
+  have.meta.closed = true;
+  CHECK_STRING(wuffs_deflate_decode(&want, &have, 0, UINT64_MAX, UINT64_MAX));
+  size_t offset = 0;
+  for (int i = 0; i < 6; i++) {
+    if ((want.meta.wi - offset) < lengths[i]) {
+      RETURN_FAIL("i=%d: decoded too few bytes", i);
+    } else if (memcmp(want.data.ptr + offset, src.data.ptr, lengths[i])) {
+      RETURN_FAIL("i=%d: decoded bytes differ", i);
+    }
+    offset += lengths[i];
+  }
+  if (want.meta.wi != offset) {
+    RETURN_FAIL("dst wi: have %zu, want %zu", want.meta.wi, offset);
+  }
+  return NULL;
+}
+
 const char*  //
 test_wuffs_deflate_decode_romeo() {
   CHECK_FOCUS(__func__);
@@ -394,6 +719,458 @@ test_wuffs_deflate_decode_split_src() {
   return NULL;
 }
 
+const char*  //
+wuffs_deflate_encode(wuffs_base__io_buffer* dst,
+                     wuffs_base__io_buffer* src,
+                     uint32_t wuffs_initialize_flags,
+                     uint64_t wlimit,
+                     uint64_t rlimit,
+                     int32_t level) {
+  wuffs_deflate__encoder enc;
+  CHECK_STATUS("initialize",
+               wuffs_deflate__encoder__initialize(
+                   &enc, sizeof enc, WUFFS_VERSION, wuffs_initialize_flags));
+  if (level >= 0) {
+    wuffs_deflate__encoder__set_level(&enc, (uint32_t)level);
+  }
+
+  while (true) {
+    wuffs_base__io_buffer limited_dst = make_limited_writer(*dst, wlimit);
+    wuffs_base__io_buffer limited_src = make_limited_reader(*src, rlimit);
+
+    wuffs_base__status status = wuffs_deflate__encoder__transform_io(
+        &enc, &limited_dst, &limited_src, g_work_slice_u8);
+
+    dst->meta.wi += limited_dst.meta.wi;
+    src->meta.ri += limited_src.meta.ri;
+
+    if (((wlimit < UINT64_MAX) &&
+         (status.repr == wuffs_base__suspension__short_write)) ||
+        ((rlimit < UINT64_MAX) &&
+         (status.repr == wuffs_base__suspension__short_read))) {
+      continue;
+    }
+    return status.repr;
+  }
+}
+
+const char*  //
+wuffs_deflate_encode_level_1(wuffs_base__io_buffer* dst,
+                             wuffs_base__io_buffer* src,
+                             uint32_t wuffs_initialize_flags,
+                             uint64_t wlimit,
+                             uint64_t rlimit) {
+  return wuffs_deflate_encode(dst, src, wuffs_initialize_flags, wlimit, rlimit,
+                              1);
+}
+
+const char*  //
+wuffs_deflate_encode_level_6(wuffs_base__io_buffer* dst,
+                             wuffs_base__io_buffer* src,
+                             uint32_t wuffs_initialize_flags,
+                             uint64_t wlimit,
+                             uint64_t rlimit) {
+  return wuffs_deflate_encode(dst, src, wuffs_initialize_flags, wlimit, rlimit,
+                              6);
+}
+
+const char*  //
+wuffs_deflate_encode_level_9(wuffs_base__io_buffer* dst,
+                             wuffs_base__io_buffer* src,
+                             uint32_t wuffs_initialize_flags,
+                             uint64_t wlimit,
+                             uint64_t rlimit) {
+  return wuffs_deflate_encode(dst, src, wuffs_initialize_flags, wlimit, rlimit,
+                              9);
+}
+
+// do_test_wuffs_deflate_encode_round_trip encodes src[ri .. wi] and checks
+// that decoding the result gives back the original bytes. If want_dst_len is
+// non-zero, it also checks the encoded length.
+const char*  //
+do_test_wuffs_deflate_encode_round_trip(const char* prefix,
+                                        wuffs_base__io_buffer* src,
+                                        int32_t level,
+                                        uint64_t wlimit,
+                                        uint64_t rlimit,
+                                        size_t want_dst_len) {
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+  wuffs_base__io_buffer round_trip = ((wuffs_base__io_buffer){
+      .data = g_want_slice_u8,
+  });
+
+  size_t src_ri = src->meta.ri;
+  const char* status = wuffs_deflate_encode(
+      &have, src, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wlimit, rlimit, level);
+  if (status) {
+    RETURN_FAIL("%sencode: \"%s\"", prefix, status);
+  } else if (src->meta.ri != src->meta.wi) {
+    RETURN_FAIL("%sencode: src ri: have %zu, want %zu", prefix, src->meta.ri,
+                src->meta.wi);
+  } else if ((want_dst_len > 0) && (have.meta.wi != want_dst_len)) {
+    RETURN_FAIL("%sencode: dst wi: have %zu, want %zu", prefix, have.meta.wi,
+                want_dst_len);
+  }
+  src->meta.ri = src_ri;
+
+  have.meta.closed = true;
+  status = wuffs_deflate_decode(&round_trip, &have, 0, UINT64_MAX, UINT64_MAX);
+  if (status) {
+    RETURN_FAIL("%sdecode: \"%s\"", prefix, status);
+  } else if (have.meta.ri != have.meta.wi) {
+    RETURN_FAIL("%sdecode: src ri: have %zu, want %zu", prefix, have.meta.ri,
+                have.meta.wi);
+  }
+  return check_io_buffers_equal(prefix, &round_trip, src);
+}
+
+const char*  //
+test_wuffs_deflate_encode_empty() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  src.meta.closed = true;
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+
+  // An empty input should encode as a single, final, fixed Huffman block
+  // containing only the end-of-block symbol.
+  for (int32_t level = 0; level <= 9; level++) {
+    have.meta.wi = 0;
+    src.meta.ri = 0;
+    CHECK_STRING(wuffs_deflate_encode(&have, &src, 0, UINT64_MAX, UINT64_MAX,
+                                      level));
+    if ((level > 0) &&
+        ((have.meta.wi != 2) || (have.data.ptr[0] != 0x03) ||
+         (have.data.ptr[1] != 0x00))) {
+      RETURN_FAIL("level=%" PRIi32 ": have %zu bytes, want \"\\x03\\x00\"",
+                  level, have.meta.wi);
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_deflate_encode_full_flush() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+  wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+      .data = g_want_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, "test/data/romeo.txt"));
+  size_t half = src.meta.wi / 2;
+  size_t src_wi = src.meta.wi;
+
+  wuffs_deflate__encoder enc;
+  CHECK_STATUS("initialize",
+               wuffs_deflate__encoder__initialize(
+                   &enc, sizeof enc, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_deflate__encoder__set_flush_mode(&enc,
+                                         WUFFS_DEFLATE__ENCODER_FLUSH_FULL);
+
+  // Encode the first half, ending with a full flush.
+  src.meta.wi = half;
+  src.meta.closed = false;
+  CHECK_STATUS("transform_io #0",
+               wuffs_deflate__encoder__transform_io(&enc, &have, &src,
+                                                    g_work_slice_u8));
+  size_t flush_point = have.meta.wi;
+  if ((src.meta.ri != half) || (flush_point < 4) ||
+      (memcmp(have.data.ptr + flush_point - 4, "\x00\x00\xFF\xFF", 4) !=
+       0)) {
+    RETURN_FAIL("transform_io #0: ri=%zu, wi=%zu: no sync marker", src.meta.ri,
+                flush_point);
+  }
+
+  // Encode the second half, ending the stream.
+  src.meta.wi = src_wi;
+  src.meta.closed = true;
+  CHECK_STATUS("transform_io #1",
+               wuffs_deflate__encoder__transform_io(&enc, &have, &src,
+                                                    g_work_slice_u8));
+
+  // The whole stream should decode to the whole input.
+  have.meta.closed = true;
+  CHECK_STRING(wuffs_deflate_decode(&want, &have, 0, UINT64_MAX, UINT64_MAX));
+  src.meta.ri = 0;
+  CHECK_STRING(check_io_buffers_equal("whole: ", &want, &src));
+
+  // The bytes after the flush point should decode, on their own, to the
+  // second half: no back-reference crosses the flush point.
+  have.meta.ri = flush_point;
+  want.meta.wi = 0;
+  want.meta.ri = 0;
+  CHECK_STRING(wuffs_deflate_decode(&want, &have, 0, UINT64_MAX, UINT64_MAX));
+  wuffs_base__io_buffer second_half = wuffs_base__ptr_u8__reader(
+      src.data.ptr + half, src_wi - half, true);
+  return check_io_buffers_equal("second half: ", &want, &second_half);
+}
+
+const char*  //
+test_wuffs_deflate_encode_interface() {
+  CHECK_FOCUS(__func__);
+  wuffs_deflate__encoder enc;
+  CHECK_STATUS("initialize",
+               wuffs_deflate__encoder__initialize(
+                   &enc, sizeof enc, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  return do_test__wuffs_base__io_transformer(
+      wuffs_deflate__encoder__upcast_as__wuffs_base__io_transformer(&enc),
+      "test/data/romeo.txt", 0, SIZE_MAX, 529, 0x00);
+}
+
+const char*  //
+test_wuffs_deflate_encode_levels() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+
+  // Check the encoded lengths, so that changes in compression ratio are
+  // noticed. For comparison, zlib's compression levels 1, 6 and 9 produce raw
+  // deflate streams of 49921, 48174 and 48174 bytes (pi.txt) and 51410, 42429
+  // and 41211 bytes (nobel-prizes.json).
+  const char* filenames[2] = {
+      "test/data/pi.txt",
+      "test/data/nobel-prizes.json",
+  };
+  const size_t want_dst_lens[2][10] = {
+      {100023, 49717, 49942, 48908, 48390, 48262, 48219, 48219, 48219, 48219},
+      {216705, 49219, 46478, 44084, 45167, 43223, 42514, 42021, 41337, 41320},
+  };
+
+  for (int f = 0; f < 2; f++) {
+    src.meta.wi = 0;
+    src.meta.ri = 0;
+    src.meta.closed = false;
+    CHECK_STRING(read_file(&src, filenames[f]));
+    for (int32_t level = 0; level <= 9; level++) {
+      char prefix[64];
+      snprintf(prefix, 64, "f=%d, level=%" PRIi32 ": ", f, level);
+      CHECK_STRING(do_test_wuffs_deflate_encode_round_trip(
+          prefix, &src, level, UINT64_MAX, UINT64_MAX,
+          want_dst_lens[f][level]));
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_deflate_encode_many_small_writes_reads() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, "test/data/midsummer.txt"));
+
+  for (int32_t level = 0; level <= 9; level += 3) {
+    char prefix[64];
+    snprintf(prefix, 64, "level=%" PRIi32 ": ", level);
+    CHECK_STRING(do_test_wuffs_deflate_encode_round_trip(prefix, &src, level,
+                                                         11, 13, 0));
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_deflate_encode_round_trip() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+
+  // These files exercise stored blocks (incompressible data), fixed and
+  // dynamic Huffman blocks, long runs and inputs longer than the 64 KiB
+  // window.
+  const char* filenames[6] = {
+      "test/data/256.bytes",        "test/data/archive.iso",
+      "test/data/harvesters.bmp",   "test/data/harvesters.jpeg",
+      "test/data/romeo.txt",        "test/data/hibiscus.regular.bmp",
+  };
+  const int32_t levels[3] = {1, 6, 9};
+
+  for (int f = 0; f < 6; f++) {
+    src.meta.wi = 0;
+    src.meta.ri = 0;
+    src.meta.closed = false;
+    CHECK_STRING(read_file(&src, filenames[f]));
+    for (int l = 0; l < 3; l++) {
+      char prefix[64];
+      snprintf(prefix, 64, "f=%d, level=%" PRIi32 ": ", f, levels[l]);
+      CHECK_STRING(do_test_wuffs_deflate_encode_round_trip(
+          prefix, &src, levels[l], UINT64_MAX, 65536 + 7, 0));
+    }
+  }
+
+  // Also check a long run of identical bytes and a pseudo-random sequence.
+  const size_t n = 300000;
+  if (n > src.data.len) {
+    RETURN_FAIL("src buffer is too short");
+  }
+  memset(src.data.ptr, 'z', n);
+  src.meta.wi = n;
+  src.meta.ri = 0;
+  src.meta.closed = true;
+  CHECK_STRING(do_test_wuffs_deflate_encode_round_trip(
+      "run: ", &src, -1, UINT64_MAX, UINT64_MAX, 0));
+  uint32_t x = 1;
+  for (size_t i = 0; i < n; i++) {
+    x = (x * 1103515245) + 12345;
+    src.data.ptr[i] = (uint8_t)(x >> 24);
+  }
+  CHECK_STRING(do_test_wuffs_deflate_encode_round_trip(
+      "random: ", &src, -1, UINT64_MAX, UINT64_MAX, 0));
+
+  // Also check periodic sequences: runs of back-references with short (less
+  // than 8) and long (at least 32) distances.
+  size_t i = 0;
+  for (uint32_t period = 1; (period <= 40) && (i < n); period++) {
+    size_t run_end = i + (37 * period) + 300;
+    if (run_end > n) {
+      run_end = n;
+    }
+    for (size_t j = 0; i < run_end; i++, j++) {
+      if (j < period) {
+        x = (x * 1103515245) + 12345;
+        src.data.ptr[i] = (uint8_t)(x >> 24);
+      } else {
+        src.data.ptr[i] = src.data.ptr[i - period];
+      }
+    }
+  }
+  src.meta.wi = i;
+  CHECK_STRING(do_test_wuffs_deflate_encode_round_trip(
+      "periodic: ", &src, -1, UINT64_MAX, UINT64_MAX, 0));
+  return NULL;
+}
+
+const char*  //
+test_wuffs_deflate_checkpoints() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+  wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+      .data = g_want_slice_u8,
+  });
+
+  // The test/data/*.gz files each contain a single deflate block, so encode
+  // a multi-block source instead.
+  CHECK_STRING(read_file(&want, "test/data/pi.txt"));
+  wuffs_base__io_buffer encoder_src = want;
+  CHECK_STRING(wuffs_deflate_encode(
+      &src, &encoder_src, WUFFS_INITIALIZE__DEFAULT_OPTIONS, UINT64_MAX,
+      UINT64_MAX, 6));
+
+  // The first 32 KiB of g_work_array_u8 holds each checkpoint's history. The
+  // next two regions are the original and resumed decoders' workbufs. The rest
+  // holds the output of resuming from that checkpoint.
+  const size_t history_size = 0x8000;
+  const size_t workbuf_size =
+      WUFFS_DEFLATE__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE;
+  const size_t resumed_dst_offset = history_size + (2 * workbuf_size);
+  wuffs_base__slice_u8 history =
+      wuffs_base__make_slice_u8(g_work_array_u8, history_size);
+  wuffs_base__slice_u8 workbuf = wuffs_base__make_slice_u8(
+      g_work_array_u8 + history_size, workbuf_size);
+  wuffs_base__slice_u8 resumed_workbuf = wuffs_base__make_slice_u8(
+      g_work_array_u8 + history_size + workbuf_size, workbuf_size);
+
+  wuffs_deflate__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_deflate__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_deflate__decoder__set_report_block_boundaries(&dec, true);
+
+  int num_checkpoints = 0;
+  while (true) {
+    wuffs_base__status status =
+        wuffs_deflate__decoder__transform_io(&dec, &have, &src, workbuf);
+    if (wuffs_base__status__is_ok(&status)) {
+      break;
+    } else if (status.repr != wuffs_deflate__note__block_boundary) {
+      RETURN_FAIL("transform_io: have \"%s\", want \"%s\"", status.repr,
+                  wuffs_deflate__note__block_boundary);
+    }
+    num_checkpoints++;
+
+    uint32_t n_bits = wuffs_deflate__decoder__pending_n_bits(&dec);
+    if (n_bits > 7) {
+      RETURN_FAIL("n=%d: pending_n_bits: have %" PRIu32 ", want <= 7",
+                  num_checkpoints, n_bits);
+    }
+    uint64_t n_history =
+        wuffs_deflate__decoder__copy_history(&dec, history, workbuf);
+    uint64_t want_n_history =
+        have.meta.wi < history_size ? have.meta.wi : history_size;
+    if (n_history != want_n_history) {
+      RETURN_FAIL("n=%d: copy_history: have %" PRIu64 ", want %" PRIu64,
+                  num_checkpoints, n_history, want_n_history);
+    }
+    if (memcmp(history.ptr, have.data.ptr + have.meta.wi - n_history,
+               n_history)) {
+      RETURN_FAIL("n=%d: copy_history: contents differ", num_checkpoints);
+    }
+
+    // Resume from the checkpoint with a fresh decoder.
+    wuffs_deflate__decoder resumed;
+    CHECK_STATUS("initialize",
+                 wuffs_deflate__decoder__initialize(
+                     &resumed, sizeof resumed, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_deflate__decoder__add_history(
+        &resumed, wuffs_base__make_slice_u8(history.ptr, n_history),
+        resumed_workbuf);
+    wuffs_deflate__decoder__set_pending_bits(
+        &resumed, wuffs_deflate__decoder__pending_bits(&dec), n_bits);
+
+    wuffs_base__io_buffer resumed_src = src;
+    wuffs_base__io_buffer resumed_dst = ((wuffs_base__io_buffer){
+        .data = wuffs_base__make_slice_u8(
+            g_work_array_u8 + resumed_dst_offset,
+            IO_BUFFER_ARRAY_SIZE - resumed_dst_offset),
+    });
+    CHECK_STATUS("resumed transform_io",
+                 wuffs_deflate__decoder__transform_io(
+                     &resumed, &resumed_dst, &resumed_src, resumed_workbuf));
+
+    wuffs_base__io_buffer want_tail = ((wuffs_base__io_buffer){
+        .data = wuffs_base__make_slice_u8(want.data.ptr + have.meta.wi,
+                                          want.meta.wi - have.meta.wi),
+    });
+    want_tail.meta.wi = want_tail.data.len;
+    char prefix[64];
+    snprintf(prefix, 64, "n=%d: ", num_checkpoints);
+    CHECK_STRING(check_io_buffers_equal(prefix, &resumed_dst, &want_tail));
+  }
+
+  if (num_checkpoints < 2) {
+    RETURN_FAIL("num_checkpoints: have %d, want >= 2", num_checkpoints);
+  }
+  return check_io_buffers_equal("", &have, &want);
+}
+
 const char*  //
 do_test_wuffs_deflate_history(int i,
                               golden_test* gt,
@@ -427,7 +1204,7 @@ do_test_wuffs_deflate_history(int i,
 
     wuffs_base__io_buffer head = ((wuffs_base__io_buffer){
         .data = ((wuffs_base__slice_u8){
-            .ptr = dec->private_data.f_history + 0,
+            .ptr = g_work_array_u8 + 0,
             .len = max_length_minus_1,
         }),
     });
@@ -435,7 +1212,7 @@ do_test_wuffs_deflate_history(int i,
 
     wuffs_base__io_buffer tail = ((wuffs_base__io_buffer){
         .data = ((wuffs_base__slice_u8){
-            .ptr = dec->private_data.f_history + 0x8000,
+            .ptr = g_work_array_u8 + 0x8000,
             .len = max_length_minus_1,
         }),
     });
@@ -488,7 +1265,7 @@ test_wuffs_deflate_history_full() {
 
     wuffs_base__io_buffer history_have = ((wuffs_base__io_buffer){
         .data = ((wuffs_base__slice_u8){
-            .ptr = dec.private_data.f_history,
+            .ptr = g_work_array_u8,
             .len = full_history_size,
         }),
     });
@@ -536,8 +1313,8 @@ test_wuffs_deflate_history_partial() {
     const uint32_t fragment_length = 4;
 
     wuffs_deflate__decoder dec;
-    memset(&(dec.private_data.f_history), 0,
-           sizeof(dec.private_data.f_history));
+    memset(g_work_array_u8, 0,
+           WUFFS_DEFLATE__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE);
     CHECK_STATUS("initialize",
                  wuffs_deflate__decoder__initialize(
                      &dec, sizeof dec, WUFFS_VERSION,
@@ -562,7 +1339,7 @@ test_wuffs_deflate_history_partial() {
 
     for (int j = -2; j < (int)(fragment_length) + 2; j++) {
       uint32_t index = (starting_history_index + j) & 0x7FFF;
-      uint8_t have = dec.private_data.f_history[index];
+      uint8_t have = g_work_array_u8[index];
       uint8_t want = (0 <= j && j < fragment_length) ? fragment[j] : 0;
       if (have != want) {
         RETURN_FAIL("i=%d: starting_history_index=0x%04" PRIX32
@@ -645,7 +1422,7 @@ test_wuffs_deflate_table_redirect() {
   dec.private_data.f_code_lengths[n++] = 13;
 
   CHECK_STATUS("init_huff",
-               wuffs_deflate__decoder__init_huff(&dec, 0, 0, n, 257));
+               wuffs_deflate__decoder__init_huff(&dec, 0, 0, n, 257, 0));
 
   // There is one 1st-level table (9 bits), and three 2nd-level tables (3, 3
   // and 4 bits). f_huffs[0]'s elements should be non-zero for those tables and
@@ -849,6 +1626,59 @@ bench_wuffs_deflate_decode_100k_many_big_reads() {
       &g_deflate_pi_gt, UINT64_MAX, 4096, 30);
 }
 
+const char*  //
+bench_wuffs_deflate_decode_100k_many_small_writes() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_deflate_decode,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_dst,
+      &g_deflate_pi_gt, 4096, UINT64_MAX, 30);
+}
+
+const char*  //
+bench_wuffs_deflate_decode_100k_many_small_writes_dst_holds_history() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_deflate_decode_dst_holds_history,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_dst,
+      &g_deflate_pi_gt, 4096, UINT64_MAX, 30);
+}
+
+const char*  //
+bench_wuffs_deflate_decode_160k_many_tiny_blocks() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_deflate_decode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      tcounter_src, &g_deflate_many_tiny_blocks_gt, UINT64_MAX, UINT64_MAX, 3);
+}
+
+const char*  //
+bench_wuffs_deflate_encode_100k_level_1() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_deflate_encode_level_1,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_src,
+      &g_deflate_encode_pi_gt, UINT64_MAX, UINT64_MAX, 10);
+}
+
+const char*  //
+bench_wuffs_deflate_encode_100k_level_6() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_deflate_encode_level_6,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_src,
+      &g_deflate_encode_pi_gt, UINT64_MAX, UINT64_MAX, 5);
+}
+
+const char*  //
+bench_wuffs_deflate_encode_100k_level_9() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_deflate_encode_level_9,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_src,
+      &g_deflate_encode_pi_gt, UINT64_MAX, UINT64_MAX, 2);
+}
+
 // ---------------- Mimic Benches
 
 #ifdef WUFFS_MIMIC
@@ -888,21 +1718,31 @@ bench_mimic_deflate_decode_100k_many_big_reads() {
 
 proc g_tests[] = {
 
+    test_wuffs_deflate_checkpoints,
     test_wuffs_deflate_decode_256_bytes,
     test_wuffs_deflate_decode_deflate_backref_crosses_blocks,
     test_wuffs_deflate_decode_deflate_degenerate_huffman,
     test_wuffs_deflate_decode_deflate_distance_32768,
     test_wuffs_deflate_decode_deflate_distance_code_31,
     test_wuffs_deflate_decode_deflate_huffman_primlen_9,
+    test_wuffs_deflate_decode_dst_holds_history,
     test_wuffs_deflate_decode_interface,
     test_wuffs_deflate_decode_midsummer,
+    test_wuffs_deflate_decode_output_slices,
     test_wuffs_deflate_decode_pi_just_one_read,
     test_wuffs_deflate_decode_pi_many_big_reads,
     test_wuffs_deflate_decode_pi_many_medium_reads,
     test_wuffs_deflate_decode_pi_many_small_writes_reads,
+    test_wuffs_deflate_decode_repeated_huffman_headers,
     test_wuffs_deflate_decode_romeo,
     test_wuffs_deflate_decode_romeo_fixed,
     test_wuffs_deflate_decode_split_src,
+    test_wuffs_deflate_encode_empty,
+    test_wuffs_deflate_encode_full_flush,
+    test_wuffs_deflate_encode_interface,
+    test_wuffs_deflate_encode_levels,
+    test_wuffs_deflate_encode_many_small_writes_reads,
+    test_wuffs_deflate_encode_round_trip,
     test_wuffs_deflate_history_full,
     test_wuffs_deflate_history_partial,
     test_wuffs_deflate_table_redirect,
@@ -936,6 +1776,12 @@ proc g_benches[] = {
     bench_wuffs_deflate_decode_10k_part_init,
     bench_wuffs_deflate_decode_100k_just_one_read,
     bench_wuffs_deflate_decode_100k_many_big_reads,
+    bench_wuffs_deflate_decode_100k_many_small_writes,
+    bench_wuffs_deflate_decode_100k_many_small_writes_dst_holds_history,
+    bench_wuffs_deflate_decode_160k_many_tiny_blocks,
+    bench_wuffs_deflate_encode_100k_level_1,
+    bench_wuffs_deflate_encode_100k_level_6,
+    bench_wuffs_deflate_encode_100k_level_9,
 
 #ifdef WUFFS_MIMIC
 
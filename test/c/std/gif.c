@@ -1123,6 +1123,71 @@ test_wuffs_gif_decode_pixfmt_rgba_nonpremul() {
       wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL));
 }
 
+const char*  //
+test_wuffs_gif_decode_roi() {
+  CHECK_FOCUS(__func__);
+
+  // These cover regular, interlaced and partial-frame-rect images.
+  const char* filenames[3] = {
+      "test/data/bricks-nodither.gif",
+      "test/data/hippopotamus.interlaced.gif",
+      "test/data/hippopotamus.masked-with-muybridge.gif",
+  };
+
+  int i;
+  for (i = 0; i < 3; i++) {
+    wuffs_gif__decoder full_dec;
+    CHECK_STATUS("initialize",
+                 wuffs_gif__decoder__initialize(
+                     &full_dec, sizeof full_dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_gif__decoder roi_dec;
+    CHECK_STATUS("initialize",
+                 wuffs_gif__decoder__initialize(
+                     &roi_dec, sizeof roi_dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    CHECK_STRING(do_test__wuffs_base__image_decoder_roi(
+        wuffs_gif__decoder__upcast_as__wuffs_base__image_decoder(&full_dec),
+        wuffs_gif__decoder__upcast_as__wuffs_base__image_decoder(&roi_dec),
+        filenames[i], wuffs_base__make_rect_ie_u32(7, 3, 31, 25), 29));
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_gif_decode_downscale() {
+  CHECK_FOCUS(__func__);
+
+  const char* filenames[3] = {
+      "test/data/bricks-nodither.gif",
+      "test/data/hat.gif",
+      "test/data/hippopotamus.regular.gif",
+  };
+
+  int i;
+  for (i = 0; i < 3; i++) {
+    uint32_t shift;
+    for (shift = 1; shift <= 3; shift++) {
+      wuffs_gif__decoder full_dec;
+      CHECK_STATUS("initialize",
+                   wuffs_gif__decoder__initialize(
+                       &full_dec, sizeof full_dec, WUFFS_VERSION,
+                       WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+      wuffs_gif__decoder ds_dec;
+      CHECK_STATUS("initialize",
+                   wuffs_gif__decoder__initialize(
+                       &ds_dec, sizeof ds_dec, WUFFS_VERSION,
+                       WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+      CHECK_STRING(do_test__wuffs_base__image_decoder_downscale(
+          wuffs_gif__decoder__upcast_as__wuffs_base__image_decoder(&full_dec),
+          wuffs_gif__decoder__upcast_as__wuffs_base__image_decoder(&ds_dec),
+          filenames[i], wuffs_base__make_rect_ie_u32(7, 3, 1000, 1000), shift,
+          29));
+    }
+  }
+  return NULL;
+}
+
 const char*  //
 test_wuffs_gif_decode_input_is_a_gif_just_one_read() {
   CHECK_FOCUS(__func__);
@@ -1994,6 +2059,281 @@ test_wuffs_gif_small_frame_interlaced() {
   return NULL;
 }
 
+// do_wuffs_gif_decode_first_frame decodes src's first frame to pb, as
+// INDEXED__BGRA_BINARY pixels (and palette) backed by pixels.
+const char*  //
+do_wuffs_gif_decode_first_frame(wuffs_base__pixel_buffer* pb,
+                                wuffs_base__io_buffer* src,
+                                wuffs_base__slice_u8 pixels) {
+  wuffs_gif__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_gif__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_base__image_config ic = ((wuffs_base__image_config){});
+  CHECK_STATUS("decode_image_config",
+               wuffs_gif__decoder__decode_image_config(&dec, &ic, src));
+  CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                     pb, &ic.pixcfg, pixels));
+  CHECK_STATUS("decode_frame",
+               wuffs_gif__decoder__decode_frame(&dec, pb, src,
+                                                WUFFS_BASE__PIXEL_BLEND__SRC,
+                                                g_work_slice_u8, NULL));
+  return NULL;
+}
+
+// do_wuffs_gif_encode encodes src as a single frame GIF image to dst. A
+// non-zero max_write_length limits how much the encoder can write per
+// encode_frame call, exercising its suspend and resume paths.
+const char*  //
+do_wuffs_gif_encode(wuffs_base__io_buffer* dst,
+                    wuffs_gif__encoder* enc,
+                    wuffs_base__pixel_buffer* src,
+                    size_t max_write_length) {
+  while (true) {
+    wuffs_base__io_buffer limited = *dst;
+    if ((max_write_length > 0) &&
+        (limited.data.len > (limited.meta.wi + max_write_length))) {
+      limited.data.len = limited.meta.wi + max_write_length;
+    }
+    wuffs_base__status status =
+        wuffs_gif__encoder__encode_frame(enc, &limited, src);
+    dst->meta.wi = limited.meta.wi;
+    if (wuffs_base__status__is_ok(&status)) {
+      break;
+    } else if ((status.repr != wuffs_base__suspension__short_write) ||
+               (dst->meta.wi == dst->data.len)) {
+      return wuffs_base__status__message(&status);
+    }
+  }
+  CHECK_STATUS("encode_trailer", wuffs_gif__encoder__encode_trailer(enc, dst));
+  return NULL;
+}
+
+// check_gif_pixels_equal checks that have and want's pixels (for indexed
+// pixel buffers, their palette entries) are equal.
+const char*  //
+check_gif_pixels_equal(wuffs_base__pixel_buffer* have,
+                       wuffs_base__pixel_buffer* want,
+                       const char* prefix) {
+  uint32_t w = wuffs_base__pixel_config__width(&want->pixcfg);
+  uint32_t h = wuffs_base__pixel_config__height(&want->pixcfg);
+  if ((wuffs_base__pixel_config__width(&have->pixcfg) != w) ||
+      (wuffs_base__pixel_config__height(&have->pixcfg) != h)) {
+    RETURN_FAIL("%sdimensions: have %" PRIu32 "×%" PRIu32 ", want %" PRIu32
+                "×%" PRIu32,
+                prefix, wuffs_base__pixel_config__width(&have->pixcfg),
+                wuffs_base__pixel_config__height(&have->pixcfg), w, h);
+  }
+  for (uint32_t y = 0; y < h; y++) {
+    for (uint32_t x = 0; x < w; x++) {
+      uint32_t hc = wuffs_base__pixel_buffer__color_u32_at(have, x, y);
+      uint32_t wc = wuffs_base__pixel_buffer__color_u32_at(want, x, y);
+      if (hc != wc) {
+        RETURN_FAIL("%s(%" PRIu32 ", %" PRIu32 "): have 0x%08" PRIX32
+                    ", want 0x%08" PRIX32,
+                    prefix, x, y, hc, wc);
+      }
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_gif_encode_round_trip() {
+  CHECK_FOCUS(__func__);
+
+  // These cover full and small (including transparent) palettes, and enough
+  // pixels for the LZW encoder to run out of codes.
+  const char* filenames[5] = {
+      "test/data/bricks-dither.gif",
+      "test/data/bricks-gray.gif",
+      "test/data/hippopotamus.regular.gif",
+      "test/data/hippopotamus.masked-with-muybridge.gif",
+      "test/data/pjw-thumbnail.gif",
+  };
+
+  wuffs_base__slice_u8 want_pixels = wuffs_base__make_slice_u8(
+      g_pixel_slice_u8.ptr, g_pixel_slice_u8.len / 2);
+  wuffs_base__slice_u8 have_pixels = wuffs_base__make_slice_u8(
+      g_pixel_slice_u8.ptr + (g_pixel_slice_u8.len / 2),
+      g_pixel_slice_u8.len / 2);
+
+  for (int tc = 0; tc < 5; tc++) {
+    wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+        .data = g_src_slice_u8,
+    });
+    CHECK_STRING(read_file(&src, filenames[tc]));
+    wuffs_base__pixel_buffer want_pb = ((wuffs_base__pixel_buffer){});
+    CHECK_STRING(do_wuffs_gif_decode_first_frame(&want_pb, &src, want_pixels));
+
+    for (int small = 0; small < 2; small++) {
+      wuffs_gif__encoder enc;
+      CHECK_STATUS("initialize",
+                   wuffs_gif__encoder__initialize(
+                       &enc, sizeof enc, WUFFS_VERSION,
+                       WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+      wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+          .data = g_have_slice_u8,
+      });
+      char prefix_buf[256];
+      sprintf(prefix_buf, "tc=%d, small=%d: ", tc, small);
+      const char* status =
+          do_wuffs_gif_encode(&have, &enc, &want_pb, small ? 100 : 0);
+      if (status) {
+        RETURN_FAIL("%s%s", prefix_buf, status);
+      }
+      have.meta.closed = true;
+
+      wuffs_base__pixel_buffer have_pb = ((wuffs_base__pixel_buffer){});
+      CHECK_STRING(
+          do_wuffs_gif_decode_first_frame(&have_pb, &have, have_pixels));
+      CHECK_STRING(check_gif_pixels_equal(&have_pb, &want_pb, prefix_buf));
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_gif_encode_animated() {
+  CHECK_FOCUS(__func__);
+
+  // Encode a 2-frame animation of 40×30 and 10×5 frames, filled with a
+  // low-entropy pattern that uses only the first 4 palette entries. The
+  // second frame is placed at (25, 20) and its third color is transparent.
+  wuffs_base__pixel_config pc = ((wuffs_base__pixel_config){});
+  wuffs_base__pixel_buffer pbs[2];
+  const uint32_t widths[2] = {40, 10};
+  const uint32_t heights[2] = {30, 5};
+  uint8_t* ptr = g_pixel_slice_u8.ptr;
+  for (int i = 0; i < 2; i++) {
+    wuffs_base__pixel_config__set(
+        &pc, WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_BINARY,
+        WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, widths[i], heights[i]);
+    pbs[i] = ((wuffs_base__pixel_buffer){});
+    CHECK_STATUS("set_from_slice",
+                 wuffs_base__pixel_buffer__set_from_slice(
+                     &pbs[i], &pc, wuffs_base__make_slice_u8(ptr, 4096)));
+    ptr += 4096;
+    wuffs_base__slice_u8 palette = wuffs_base__pixel_buffer__palette(&pbs[i]);
+    memset(palette.ptr, 0, palette.len);
+    for (int j = 0; j < 4; j++) {
+      palette.ptr[(4 * j) + 0] = (uint8_t)(0x10 * j);
+      palette.ptr[(4 * j) + 1] = (uint8_t)(0x20 * j);
+      palette.ptr[(4 * j) + 2] = (uint8_t)(0x30 * j);
+      palette.ptr[(4 * j) + 3] = ((i == 1) && (j == 2)) ? 0x00 : 0xFF;
+    }
+    wuffs_base__table_u8 tab = wuffs_base__pixel_buffer__plane(&pbs[i], 0);
+    for (uint32_t y = 0; y < heights[i]; y++) {
+      for (uint32_t x = 0; x < widths[i]; x++) {
+        tab.ptr[(y * tab.stride) + x] = (uint8_t)(((x / 7) + (y / 3)) & 3);
+      }
+    }
+  }
+
+  wuffs_gif__encoder enc;
+  CHECK_STATUS("initialize",
+               wuffs_gif__encoder__initialize(
+                   &enc, sizeof enc, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_gif__encoder__set_loop_count(&enc, 3);
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+  wuffs_gif__encoder__set_frame(&enc, 0, 0, 50 * 7056000,
+                                WUFFS_BASE__ANIMATION_DISPOSAL__NONE);
+  CHECK_STATUS("encode_frame #0",
+               wuffs_gif__encoder__encode_frame(&enc, &have, &pbs[0]));
+  wuffs_gif__encoder__set_frame(
+      &enc, 25, 20, 20 * 7056000,
+      WUFFS_BASE__ANIMATION_DISPOSAL__RESTORE_BACKGROUND);
+  CHECK_STATUS("encode_frame #1",
+               wuffs_gif__encoder__encode_frame(&enc, &have, &pbs[1]));
+  CHECK_STATUS("encode_trailer",
+               wuffs_gif__encoder__encode_trailer(&enc, &have));
+  have.meta.closed = true;
+
+  wuffs_gif__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_gif__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_base__image_config ic = ((wuffs_base__image_config){});
+  CHECK_STATUS("decode_image_config",
+               wuffs_gif__decoder__decode_image_config(&dec, &ic, &have));
+  if ((wuffs_base__pixel_config__width(&ic.pixcfg) != 40) ||
+      (wuffs_base__pixel_config__height(&ic.pixcfg) != 30)) {
+    RETURN_FAIL("dimensions: have %" PRIu32 "×%" PRIu32 ", want 40×30",
+                wuffs_base__pixel_config__width(&ic.pixcfg),
+                wuffs_base__pixel_config__height(&ic.pixcfg));
+  }
+  if (wuffs_gif__decoder__num_animation_loops(&dec) != 4) {
+    RETURN_FAIL("num_animation_loops: have %" PRIu32 ", want 4",
+                wuffs_gif__decoder__num_animation_loops(&dec));
+  }
+  wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("set_from_slice",
+               wuffs_base__pixel_buffer__set_from_slice(
+                   &pb, &ic.pixcfg,
+                   wuffs_base__make_slice_u8(ptr, g_pixel_slice_u8.len / 2)));
+
+  const uint64_t want_durations[2] = {50 * 7056000, 20 * 7056000};
+  const uint8_t want_disposals[2] = {
+      WUFFS_BASE__ANIMATION_DISPOSAL__NONE,
+      WUFFS_BASE__ANIMATION_DISPOSAL__RESTORE_BACKGROUND,
+  };
+  const uint32_t want_x0s[2] = {0, 25};
+  const uint32_t want_y0s[2] = {0, 20};
+  for (int i = 0; i < 2; i++) {
+    wuffs_base__frame_config fc = ((wuffs_base__frame_config){});
+    CHECK_STATUS("decode_frame_config",
+                 wuffs_gif__decoder__decode_frame_config(&dec, &fc, &have));
+    wuffs_base__rect_ie_u32 r = wuffs_base__frame_config__bounds(&fc);
+    if ((r.min_incl_x != want_x0s[i]) || (r.min_incl_y != want_y0s[i]) ||
+        (r.max_excl_x != (want_x0s[i] + widths[i])) ||
+        (r.max_excl_y != (want_y0s[i] + heights[i]))) {
+      RETURN_FAIL("i=%d: bounds: have (%" PRIu32 ", %" PRIu32 ")-(%" PRIu32
+                  ", %" PRIu32 ")",
+                  i, r.min_incl_x, r.min_incl_y, r.max_excl_x, r.max_excl_y);
+    }
+    if (wuffs_base__frame_config__duration(&fc) != want_durations[i]) {
+      RETURN_FAIL("i=%d: duration: have %" PRIu64 ", want %" PRIu64, i,
+                  wuffs_base__frame_config__duration(&fc), want_durations[i]);
+    }
+    if (wuffs_base__frame_config__disposal(&fc) != want_disposals[i]) {
+      RETURN_FAIL("i=%d: disposal: have %d, want %d", i,
+                  (int)wuffs_base__frame_config__disposal(&fc),
+                  (int)want_disposals[i]);
+    }
+    CHECK_STATUS("decode_frame",
+                 wuffs_gif__decoder__decode_frame(&dec, &pb, &have,
+                                                  WUFFS_BASE__PIXEL_BLEND__SRC,
+                                                  g_work_slice_u8, NULL));
+
+    wuffs_base__table_u8 have_tab = wuffs_base__pixel_buffer__plane(&pb, 0);
+    wuffs_base__table_u8 want_tab = wuffs_base__pixel_buffer__plane(&pbs[i], 0);
+    for (uint32_t y = 0; y < heights[i]; y++) {
+      for (uint32_t x = 0; x < widths[i]; x++) {
+        uint8_t hv = have_tab.ptr[((y + want_y0s[i]) * have_tab.stride) +
+                                  (x + want_x0s[i])];
+        uint8_t wv = want_tab.ptr[(y * want_tab.stride) + x];
+        if (hv != wv) {
+          RETURN_FAIL("i=%d: (%" PRIu32 ", %" PRIu32 "): have %d, want %d", i,
+                      x, y, (int)hv, (int)wv);
+        }
+      }
+    }
+  }
+
+  // The second frame's transparent index was taken from its palette.
+  wuffs_base__slice_u8 palette = wuffs_base__pixel_buffer__palette(&pb);
+  if ((palette.ptr[(4 * 2) + 3] != 0x00) ||
+      (palette.ptr[(4 * 3) + 3] != 0xFF)) {
+    RETURN_FAIL("palette: bad transparency");
+  }
+  return NULL;
+}
+
 // ---------------- Mimic Tests
 
 #ifdef WUFFS_MIMIC
@@ -2115,6 +2455,51 @@ test_mimic_gif_decode_pjw_thumbnail() {
 
 // ---------------- GIF Benches
 
+// gen_gif_many_tiny_frames generates a 64×64 GIF with thousands of 1×1
+// frames. It is a worst case input: the decoder spends most of its time on
+// per-frame overhead instead of on pixels.
+const char*  //
+gen_gif_many_tiny_frames(wuffs_base__io_buffer* dst) {
+  static const uint8_t header[19] = {
+      'G',  'I',  'F',  '8', '9', 'a',  // Magic.
+      0x40, 0x00, 0x40, 0x00,           // 64×64 screen.
+      0x80, 0x00, 0x00,                 // 2-entry global palette.
+      0x00, 0x00, 0x00,                 // Palette entry 0: black.
+      0xFF, 0xFF, 0xFF,                 // Palette entry 1: white.
+  };
+  const uint32_t n_frames = 4096;
+  const size_t frame_len = 15;
+
+  if ((dst->data.len - dst->meta.wi) <
+      (sizeof(header) + (n_frames * frame_len) + 1)) {
+    return "gen_gif_many_tiny_frames: dst buffer is too short";
+  }
+  uint8_t* p = dst->data.ptr + dst->meta.wi;
+  memcpy(p, header, sizeof(header));
+  p += sizeof(header);
+  for (uint32_t i = 0; i < n_frames; i++) {
+    *p++ = 0x2C;  // Image Descriptor.
+    *p++ = (uint8_t)(i % 64);
+    *p++ = 0x00;
+    *p++ = (uint8_t)((i / 64) % 64);
+    *p++ = 0x00;
+    *p++ = 0x01;  // 1×1 frame.
+    *p++ = 0x00;
+    *p++ = 0x01;
+    *p++ = 0x00;
+    *p++ = 0x00;  // No local palette.
+    // The 3-bit LZW codes are clear (4), literal (i & 1) and end (5).
+    *p++ = 0x02;  // LZW literal width.
+    *p++ = 0x02;  // Block length.
+    *p++ = (uint8_t)(0x44 | ((i & 1) << 3));
+    *p++ = 0x01;
+    *p++ = 0x00;  // Block terminator.
+  }
+  *p++ = 0x3B;  // Trailer.
+  dst->meta.wi = (size_t)(p - dst->data.ptr);
+  return NULL;
+}
+
 const char*  //
 bench_wuffs_gif_decode_1k_bw() {
   CHECK_FOCUS(__func__);
@@ -2224,6 +2609,57 @@ bench_wuffs_gif_decode_anim_screencap() {
       NULL, 0, "test/data/gifplayer-muybridge.gif", 0, SIZE_MAX, 1);
 }
 
+const char*  //
+bench_wuffs_gif_decode_60k_many_tiny_frames() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode_generated(
+      wuffs_gif_decode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(
+          WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_BINARY),
+      NULL, 0, gen_gif_many_tiny_frames, 10);
+}
+
+const char*  //
+do_bench_wuffs_gif_encode(const char* filename, uint64_t iters_unscaled) {
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, filename));
+  wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STRING(do_wuffs_gif_decode_first_frame(&pb, &src, g_pixel_slice_u8));
+
+  bench_start();
+  uint64_t n_bytes = 0;
+  uint64_t iters = iters_unscaled * g_flags.iterscale;
+  for (uint64_t i = 0; i < iters; i++) {
+    wuffs_gif__encoder enc;
+    CHECK_STATUS("initialize",
+                 wuffs_gif__encoder__initialize(
+                     &enc, sizeof enc, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+        .data = g_have_slice_u8,
+    });
+    CHECK_STATUS("encode_frame",
+                 wuffs_gif__encoder__encode_frame(&enc, &have, &pb));
+    n_bytes += wuffs_base__pixel_config__pixbuf_len(&pb.pixcfg);
+  }
+  bench_finish(iters, n_bytes);
+  return NULL;
+}
+
+const char*  //
+bench_wuffs_gif_encode_20k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_gif_encode("test/data/bricks-dither.gif", 50);
+}
+
+const char*  //
+bench_wuffs_gif_encode_1000k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_gif_encode("test/data/harvesters.gif", 1);
+}
+
 // ---------------- Mimic Benches
 
 #ifdef WUFFS_MIMIC
@@ -2356,7 +2792,11 @@ proc g_tests[] = {
     test_wuffs_gif_decode_pixfmt_bgra_nonpremul,
     test_wuffs_gif_decode_pixfmt_rgb,
     test_wuffs_gif_decode_pixfmt_rgba_nonpremul,
+    test_wuffs_gif_decode_roi,
+    test_wuffs_gif_decode_downscale,
     test_wuffs_gif_decode_zero_width_frame,
+    test_wuffs_gif_encode_animated,
+    test_wuffs_gif_encode_round_trip,
     test_wuffs_gif_frame_dirty_rect,
     test_wuffs_gif_num_decoded_frame_configs,
     test_wuffs_gif_num_decoded_frames,
@@ -2398,6 +2838,9 @@ proc g_benches[] = {
     bench_wuffs_gif_decode_1000k_full_init,
     bench_wuffs_gif_decode_1000k_part_init,
     bench_wuffs_gif_decode_anim_screencap,
+    bench_wuffs_gif_decode_60k_many_tiny_frames,
+    bench_wuffs_gif_encode_20k,
+    bench_wuffs_gif_encode_1000k,
 
 #ifdef WUFFS_MIMIC
 
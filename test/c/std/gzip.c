@@ -215,6 +215,205 @@ test_wuffs_gzip_checksum_verify_good() {
   return do_test_wuffs_gzip_checksum(false, 0);
 }
 
+// append_bgzf_member appends a BGZF (SAMv1 section 4.1) member to dst: a gzip
+// member whose "BC" extra subfield holds BSIZE, the member length minus 1. Its
+// deflate data, compressed, decompresses to decompressed.
+static const char*  //
+append_bgzf_member(wuffs_base__io_buffer* dst,
+                   wuffs_base__slice_u8 compressed,
+                   wuffs_base__slice_u8 decompressed) {
+  size_t n = 18 + compressed.len + 8;
+  if ((n > 65536) || ((dst->data.len - dst->meta.wi) < n)) {
+    return "append_bgzf_member: dst is too short";
+  }
+  static const uint8_t header[16] = {
+      0x1F, 0x8B, 0x08, 0x04, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0xFF, 0x06, 0x00, 0x42, 0x43, 0x02, 0x00,
+  };
+  wuffs_crc32__ieee_hasher hasher;
+  CHECK_STATUS("initialize",
+               wuffs_crc32__ieee_hasher__initialize(
+                   &hasher, sizeof hasher, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__DEFAULT_OPTIONS));
+  uint32_t checksum =
+      wuffs_crc32__ieee_hasher__update_u32(&hasher, decompressed);
+
+  uint8_t* p = dst->data.ptr + dst->meta.wi;
+  memcpy(p, header, 16);
+  wuffs_base__poke_u16le__no_bounds_check(p + 16, (uint16_t)(n - 1));
+  if (compressed.len > 0) {
+    memcpy(p + 18, compressed.ptr, compressed.len);
+  }
+  wuffs_base__poke_u32le__no_bounds_check(p + 18 + compressed.len, checksum);
+  wuffs_base__poke_u32le__no_bounds_check(p + 22 + compressed.len,
+                                          (uint32_t)(decompressed.len));
+  dst->meta.wi += n;
+  return NULL;
+}
+
+const char*  //
+test_wuffs_gzip_decode_bgzf() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+  wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+      .data = g_want_slice_u8,
+  });
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+
+  // Build a BGZF file out of raw deflate data: the .deflate file as is, and
+  // the .zlib file without its 2 byte header or 4 byte Adler-32 trailer. The
+  // have buffer is scratch space until the decoding starts.
+  struct {
+    const char* compressed_filename;
+    size_t prefix_len;
+    size_t suffix_len;
+    const char* decompressed_filename;
+  } members[2] = {
+      {"test/data/romeo.txt.deflate", 0, 0, "test/data/romeo.txt"},
+      {"test/data/midsummer.txt.zlib", 2, 4, "test/data/midsummer.txt"},
+  };
+  size_t member_ends[3] = {0};
+  for (int i = 0; i < 2; i++) {
+    have.meta.wi = 0;
+    have.meta.closed = false;
+    want.meta.closed = false;
+    size_t want_wi = want.meta.wi;
+    CHECK_STRING(read_file(&have, members[i].compressed_filename));
+    CHECK_STRING(read_file(&want, members[i].decompressed_filename));
+    CHECK_STRING(append_bgzf_member(
+        &src,
+        wuffs_base__make_slice_u8(
+            have.data.ptr + members[i].prefix_len,
+            have.meta.wi - members[i].prefix_len - members[i].suffix_len),
+        wuffs_base__make_slice_u8(want.data.ptr + want_wi,
+                                  want.meta.wi - want_wi)));
+    member_ends[i] = src.meta.wi;
+  }
+
+  // BGZF files end with an empty member (an empty fixed Huffman block), whose
+  // 28 bytes are given by the specification.
+  static const uint8_t empty_block[2] = {0x03, 0x00};
+  static const uint8_t eof_marker[28] = {
+      0x1F, 0x8B, 0x08, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF,
+      0x06, 0x00, 0x42, 0x43, 0x02, 0x00, 0x1B, 0x00, 0x03, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  };
+  CHECK_STRING(append_bgzf_member(
+      &src, wuffs_base__make_slice_u8((uint8_t*)empty_block, 2),
+      wuffs_base__empty_slice_u8()));
+  member_ends[2] = src.meta.wi;
+  if (memcmp(src.data.ptr + member_ends[1], eof_marker, 28)) {
+    RETURN_FAIL("EOF marker mismatch");
+  }
+  src.meta.closed = true;
+
+  have.meta.wi = 0;
+  have.meta.closed = false;
+  wuffs_gzip__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_gzip__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  for (int i = 0; i < 3; i++) {
+    CHECK_STATUS("transform_io", wuffs_gzip__decoder__transform_io(
+                                     &dec, &have, &src, g_work_slice_u8));
+    if (src.meta.ri != member_ends[i]) {
+      RETURN_FAIL("i=%d: src.meta.ri: have %zu, want %zu", i, src.meta.ri,
+                  member_ends[i]);
+    }
+  }
+  return check_io_buffers_equal("", &have, &want);
+}
+
+const char*  //
+test_wuffs_gzip_decode_block_boundaries() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+  wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+      .data = g_want_slice_u8,
+  });
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+
+  // The test/data/*.gz files each contain a single deflate block, so build a
+  // multi-block gzip file: a minimal header, the deflate encoding and the
+  // CRC-32 and length trailer.
+  CHECK_STRING(read_file(&want, g_gzip_pi_gt.want_filename));
+  static const uint8_t header[10] = {
+      0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03,
+  };
+  memcpy(src.data.ptr, header, 10);
+  src.meta.wi = 10;
+
+  wuffs_deflate__encoder enc;
+  CHECK_STATUS("initialize enc",
+               wuffs_deflate__encoder__initialize(
+                   &enc, sizeof enc, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_base__io_buffer enc_src = want;
+  CHECK_STATUS("encode", wuffs_deflate__encoder__transform_io(
+                             &enc, &src, &enc_src, g_work_slice_u8));
+
+  wuffs_crc32__ieee_hasher hasher;
+  CHECK_STATUS("initialize hasher",
+               wuffs_crc32__ieee_hasher__initialize(
+                   &hasher, sizeof hasher, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__DEFAULT_OPTIONS));
+  uint32_t checksum = wuffs_crc32__ieee_hasher__update_u32(
+      &hasher, wuffs_base__io_buffer__reader_slice(&want));
+  if ((src.data.len - src.meta.wi) < 8) {
+    RETURN_FAIL("src buffer is too short");
+  }
+  wuffs_base__poke_u32le__no_bounds_check(src.data.ptr + src.meta.wi,
+                                           checksum);
+  wuffs_base__poke_u32le__no_bounds_check(src.data.ptr + src.meta.wi + 4,
+                                           (uint32_t)(want.meta.wi));
+  src.meta.wi += 8;
+  src.meta.closed = true;
+
+  wuffs_gzip__decoder dec;
+  CHECK_STATUS("initialize dec",
+               wuffs_gzip__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_gzip__decoder__set_report_block_boundaries(&dec, true);
+
+  // Each "@block boundary" note is followed by a transform_io call that
+  // continues decoding the payload, not a new member.
+  int num_block_boundaries = 0;
+  while (true) {
+    wuffs_base__status status = wuffs_gzip__decoder__transform_io(
+        &dec, &have, &src, g_work_slice_u8);
+    if (wuffs_base__status__is_ok(&status)) {
+      break;
+    } else if (status.repr != wuffs_deflate__note__block_boundary) {
+      RETURN_FAIL("transform_io: have \"%s\", want \"%s\"", status.repr,
+                  wuffs_deflate__note__block_boundary);
+    } else if (wuffs_gzip__decoder__pending_n_bits(&dec) > 7) {
+      RETURN_FAIL("pending_n_bits: have %" PRIu32 ", want <= 7",
+                  wuffs_gzip__decoder__pending_n_bits(&dec));
+    }
+    num_block_boundaries++;
+  }
+
+  if (num_block_boundaries < 2) {
+    RETURN_FAIL("num_block_boundaries: have %d, want >= 2",
+                num_block_boundaries);
+  } else if (src.meta.ri != src.meta.wi) {
+    RETURN_FAIL("src.meta.ri: have %zu, want %zu", src.meta.ri, src.meta.wi);
+  }
+  return check_io_buffers_equal("", &have, &want);
+}
+
 const char*  //
 test_wuffs_gzip_decode_infrequent_compaction() {
   CHECK_FOCUS(__func__);
@@ -281,6 +480,53 @@ test_wuffs_gzip_decode_midsummer() {
                             UINT64_MAX);
 }
 
+const char*  //
+test_wuffs_gzip_decode_multiple_members() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+  wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+      .data = g_want_slice_u8,
+  });
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+
+  // Concatenate two gzip members, like "cat romeo.txt.gz midsummer.txt.gz".
+  const char* filenames[2][2] = {
+      {"test/data/romeo.txt.gz", "test/data/romeo.txt"},
+      {"test/data/midsummer.txt.gz", "test/data/midsummer.txt"},
+  };
+  size_t member_ends[2] = {0};
+  for (int i = 0; i < 2; i++) {
+    src.meta.closed = false;
+    want.meta.closed = false;
+    CHECK_STRING(read_file(&src, filenames[i][0]));
+    CHECK_STRING(read_file(&want, filenames[i][1]));
+    member_ends[i] = src.meta.wi;
+  }
+
+  wuffs_gzip__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_gzip__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+
+  // Each transform_io call decodes (and verifies the checksum of) exactly one
+  // member and leaves src positioned at the start of the next member.
+  for (int i = 0; i < 2; i++) {
+    CHECK_STATUS("transform_io", wuffs_gzip__decoder__transform_io(
+                                     &dec, &have, &src, g_work_slice_u8));
+    if (src.meta.ri != member_ends[i]) {
+      RETURN_FAIL("i=%d: src.meta.ri: have %zu, want %zu", i, src.meta.ri,
+                  member_ends[i]);
+    }
+  }
+  return check_io_buffers_equal("", &have, &want);
+}
+
 const char*  //
 test_wuffs_gzip_decode_pi() {
   CHECK_FOCUS(__func__);
@@ -357,9 +603,12 @@ proc g_tests[] = {
     test_wuffs_gzip_checksum_verify_bad0,
     test_wuffs_gzip_checksum_verify_bad7,
     test_wuffs_gzip_checksum_verify_good,
+    test_wuffs_gzip_decode_bgzf,
+    test_wuffs_gzip_decode_block_boundaries,
     test_wuffs_gzip_decode_infrequent_compaction,
     test_wuffs_gzip_decode_interface,
     test_wuffs_gzip_decode_midsummer,
+    test_wuffs_gzip_decode_multiple_members,
     test_wuffs_gzip_decode_pi,
 
 #ifdef WUFFS_MIMIC
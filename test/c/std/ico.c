@@ -0,0 +1,321 @@
+// Copyright 2020 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ----------------
+
+/*
+This test program is typically run indirectly, by the "wuffs test" or "wuffs
+bench" commands. These commands take an optional "-mimic" flag to check that
+Wuffs' output mimics (i.e. exactly matches) other libraries' output, such as
+giflib for GIF, libpng for PNG, etc.
+
+To manually run this test:
+
+for CC in clang gcc; do
+  $CC -std=c99 -Wall -Werror ico.c && ./a.out
+  rm -f a.out
+done
+
+Each edition should print "PASS", amongst other information, and exit(0).
+
+Add the "wuffs mimic cflags" (everything after the colon below) to the C
+compiler flags (after the .c file) to run the mimic tests.
+
+To manually run the benchmarks, replace "-Wall -Werror" with "-O3" and replace
+the first "./a.out" with "./a.out -bench". Combine these changes with the
+"wuffs mimic cflags" to run the mimic benchmarks.
+*/
+
+// ¿ wuffs mimic cflags: -DWUFFS_MIMIC
+
+// Wuffs ships as a "single file C library" or "header file library" as per
+// https://github.com/nothings/stb/blob/master/docs/stb_howto.txt
+//
+// To use that single file as a "foo.c"-like implementation, instead of a
+// "foo.h"-like header, #define WUFFS_IMPLEMENTATION before #include'ing or
+// compiling it.
+#define WUFFS_IMPLEMENTATION
+
+// Defining the WUFFS_CONFIG__MODULE* macros are optional, but it lets users of
+// release/c/etc.c choose which parts of Wuffs to build. That file contains the
+// entire Wuffs standard library, implementing a variety of codecs and file
+// formats. Without this macro definition, an optimizing compiler or linker may
+// very well discard Wuffs code for unused codecs, but listing the Wuffs
+// modules we use makes that process explicit. Preprocessing means that such
+// code simply isn't compiled.
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__ADLER32
+#define WUFFS_CONFIG__MODULE__BASE
+#define WUFFS_CONFIG__MODULE__BMP
+#define WUFFS_CONFIG__MODULE__CRC32
+#define WUFFS_CONFIG__MODULE__DEFLATE
+#define WUFFS_CONFIG__MODULE__ICO
+#define WUFFS_CONFIG__MODULE__PNG
+#define WUFFS_CONFIG__MODULE__ZLIB
+
+// If building this program in an environment that doesn't easily accommodate
+// relative includes, you can use the script/inline-c-relative-includes.go
+// program to generate a stand-alone C file.
+#include "../../../release/c/wuffs-unsupported-snapshot.c"
+#include "../testlib/testlib.c"
+#ifdef WUFFS_MIMIC
+// No mimic library.
+#endif
+
+// ---------------- ICO Tests
+
+// test/data/hippopotamus-pjw-hat-bricks.ico's entries are:
+//  - #0: 36 × 28, a 24 bits per pixel DIB with a non-trivial AND mask.
+//  - #1: 32 × 32, a 1 bit per pixel DIB.
+//  - #2: 90 × 112, a PNG.
+//  - #3: 160 × 120, an 8 bits per pixel DIB.
+
+const char*  //
+wuffs_ico_decode(uint64_t* n_bytes_out,
+                 wuffs_base__io_buffer* dst,
+                 uint32_t wuffs_initialize_flags,
+                 wuffs_base__pixel_format pixfmt,
+                 uint32_t* quirks_ptr,
+                 size_t quirks_len,
+                 wuffs_base__io_buffer* src) {
+  wuffs_ico__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_ico__decoder__initialize(&dec, sizeof dec, WUFFS_VERSION,
+                                              wuffs_initialize_flags));
+  return do_run__wuffs_base__image_decoder(
+      wuffs_ico__decoder__upcast_as__wuffs_base__image_decoder(&dec),
+      n_bytes_out, dst, pixfmt, quirks_ptr, quirks_len, src);
+}
+
+// --------
+
+const char*  //
+test_wuffs_ico_decode_bad_header() {
+  CHECK_FOCUS(__func__);
+
+  // A BMP file is not an ICO file.
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, "test/data/hippopotamus.bmp"));
+
+  wuffs_ico__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_ico__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_base__image_config ic = ((wuffs_base__image_config){});
+  wuffs_base__status status =
+      wuffs_ico__decoder__decode_image_config(&dec, &ic, &src);
+  if (status.repr != wuffs_ico__error__bad_header) {
+    RETURN_FAIL("decode_image_config: have \"%s\", want \"%s\"", status.repr,
+                wuffs_ico__error__bad_header);
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_ico_decode_interface() {
+  CHECK_FOCUS(__func__);
+  wuffs_ico__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_ico__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  return do_test__wuffs_base__image_decoder(
+      wuffs_ico__decoder__upcast_as__wuffs_base__image_decoder(&dec),
+      "test/data/hippopotamus.regular.ico", 0, SIZE_MAX, 36, 28, 0xFFF5F5F5);
+}
+
+const char*  //
+test_wuffs_ico_decode_matches_png() {
+  CHECK_FOCUS(__func__);
+
+  // Each target size should select the given entry, which should decode to
+  // the same pixels as its PNG source. For DIBs with fewer than 32 bits per
+  // pixel, that is after applying the AND mask: pixels whose alpha is less
+  // than 0x80 are transparent black and all others are opaque.
+  const uint32_t target_sizes[5] = {0, 64, 32, 24, 1};
+  const uint32_t want_entries[5] = {3, 2, 1, 0, 0};
+  const char* png_filenames[4] = {
+      "test/data/hippopotamus.masked-with-muybridge.png",
+      "test/data/pjw-thumbnail.png",
+      "test/data/hat.png",
+      "test/data/bricks-nodither.png",
+  };
+  const bool entry_is_masked_dib[4] = {true, true, false, true};
+  wuffs_base__pixel_format pixfmt =
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL);
+
+  int i;
+  for (i = 0; i < 5; i++) {
+    wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+        .data = g_src_slice_u8,
+    });
+    CHECK_STRING(read_file(&src, "test/data/hippopotamus-pjw-hat-bricks.ico"));
+    wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+        .data = g_have_slice_u8,
+    });
+    wuffs_ico__decoder dec;
+    CHECK_STATUS("initialize",
+                 wuffs_ico__decoder__initialize(
+                     &dec, sizeof dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_ico__decoder__set_target_size(&dec, target_sizes[i],
+                                        target_sizes[i]);
+    CHECK_STRING(do_run__wuffs_base__image_decoder(
+        wuffs_ico__decoder__upcast_as__wuffs_base__image_decoder(&dec), NULL,
+        &have, pixfmt, NULL, 0, &src));
+
+    uint32_t have_num_entries = wuffs_ico__decoder__num_entries(&dec);
+    if (have_num_entries != 4) {
+      RETURN_FAIL("i=%d: num_entries: have %" PRIu32 ", want 4", i,
+                  have_num_entries);
+    }
+    uint32_t e = wuffs_ico__decoder__selected_entry(&dec);
+    if (e != want_entries[i]) {
+      RETURN_FAIL("i=%d: selected_entry: have %" PRIu32 ", want %" PRIu32, i,
+                  e, want_entries[i]);
+    }
+
+    src.meta = ((wuffs_base__io_buffer_meta){});
+    CHECK_STRING(read_file(&src, png_filenames[e]));
+    wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+        .data = g_want_slice_u8,
+    });
+    wuffs_png__decoder png_dec;
+    CHECK_STATUS("initialize",
+                 wuffs_png__decoder__initialize(
+                     &png_dec, sizeof png_dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    CHECK_STRING(do_run__wuffs_base__image_decoder(
+        wuffs_png__decoder__upcast_as__wuffs_base__image_decoder(&png_dec),
+        NULL, &want, pixfmt, NULL, 0, &src));
+
+    if (entry_is_masked_dib[e]) {
+      size_t j;
+      for (j = 0; (j + 4) <= want.meta.wi; j += 4) {
+        uint32_t c = wuffs_base__peek_u32le__no_bounds_check(want.data.ptr + j);
+        c = (c < 0x80000000) ? 0 : (c | 0xFF000000);
+        wuffs_base__poke_u32le__no_bounds_check(want.data.ptr + j, c);
+      }
+    }
+    CHECK_STRING(check_io_buffers_equal(png_filenames[e], &have, &want));
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_ico_decode_src_over() {
+  CHECK_FOCUS(__func__);
+
+  // Applying the AND mask of a DIB with fewer than 32 bits per pixel
+  // overwrites pixels, so SRC_OVER is not supported for those entries.
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, "test/data/hippopotamus-pjw-hat-bricks.ico"));
+
+  wuffs_ico__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_ico__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_base__image_config ic = ((wuffs_base__image_config){});
+  CHECK_STATUS("decode_image_config",
+               wuffs_ico__decoder__decode_image_config(&dec, &ic, &src));
+  if (wuffs_ico__decoder__can_decode_row_bands(&dec)) {
+    RETURN_FAIL("can_decode_row_bands: have true, want false");
+  }
+  wuffs_base__pixel_config__set(&ic.pixcfg,
+                                WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+                                WUFFS_BASE__PIXEL_SUBSAMPLING__NONE,
+                                wuffs_base__pixel_config__width(&ic.pixcfg),
+                                wuffs_base__pixel_config__height(&ic.pixcfg));
+  wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                     &pb, &ic.pixcfg, g_pixel_slice_u8));
+  wuffs_base__status status = wuffs_ico__decoder__decode_frame(
+      &dec, &pb, &src, WUFFS_BASE__PIXEL_BLEND__SRC_OVER, g_work_slice_u8,
+      NULL);
+  if (status.repr != wuffs_base__error__unsupported_option) {
+    RETURN_FAIL("decode_frame: have \"%s\", want \"%s\"", status.repr,
+                wuffs_base__error__unsupported_option);
+  }
+  return NULL;
+}
+
+// ---------------- Mimic Tests
+
+#ifdef WUFFS_MIMIC
+
+// No mimic tests.
+
+#endif  // WUFFS_MIMIC
+
+// ---------------- ICO Benches
+
+const char*  //
+bench_wuffs_ico_decode_77k_8bpp() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &wuffs_ico_decode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      NULL, 0, "test/data/hippopotamus-pjw-hat-bricks.ico", 0, SIZE_MAX, 1000);
+}
+
+// ---------------- Mimic Benches
+
+#ifdef WUFFS_MIMIC
+
+// No mimic benches.
+
+#endif  // WUFFS_MIMIC
+
+// ---------------- Manifest
+
+proc g_tests[] = {
+
+    test_wuffs_ico_decode_bad_header,
+    test_wuffs_ico_decode_interface,
+    test_wuffs_ico_decode_matches_png,
+    test_wuffs_ico_decode_src_over,
+
+#ifdef WUFFS_MIMIC
+
+// No mimic tests.
+
+#endif  // WUFFS_MIMIC
+
+    NULL,
+};
+
+proc g_benches[] = {
+
+    bench_wuffs_ico_decode_77k_8bpp,
+
+#ifdef WUFFS_MIMIC
+
+// No mimic benches.
+
+#endif  // WUFFS_MIMIC
+
+    NULL,
+};
+
+int  //
+main(int argc, char** argv) {
+  g_proc_package_name = "std/ico";
+  return test_main(argc, argv, g_tests, g_benches);
+}
@@ -0,0 +1,420 @@
+// Copyright 2022 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ----------------
+
+/*
+This test program is typically run indirectly, by the "wuffs test" or "wuffs
+bench" commands. These commands take an optional "-mimic" flag to check that
+Wuffs' output mimics (i.e. exactly matches) other libraries' output, such as
+giflib for GIF, libpng for PNG, etc.
+
+To manually run this test:
+
+for CC in clang gcc; do
+  $CC -std=c99 -Wall -Werror jpeg.c && ./a.out
+  rm -f a.out
+done
+
+Each edition should print "PASS", amongst other information, and exit(0).
+
+Add the "wuffs mimic cflags" (everything after the colon below) to the C
+compiler flags (after the .c file) to run the mimic tests.
+
+To manually run the benchmarks, replace "-Wall -Werror" with "-O3" and replace
+the first "./a.out" with "./a.out -bench". Combine these changes with the
+"wuffs mimic cflags" to run the mimic benchmarks.
+*/
+
+// ¿ wuffs mimic cflags: -DWUFFS_MIMIC -ljpeg
+
+// Wuffs ships as a "single file C library" or "header file library" as per
+// https://github.com/nothings/stb/blob/master/docs/stb_howto.txt
+//
+// To use that single file as a "foo.c"-like implementation, instead of a
+// "foo.h"-like header, #define WUFFS_IMPLEMENTATION before #include'ing or
+// compiling it.
+#define WUFFS_IMPLEMENTATION
+
+// Defining the WUFFS_CONFIG__MODULE* macros are optional, but it lets users of
+// release/c/etc.c choose which parts of Wuffs to build. That file contains the
+// entire Wuffs standard library, implementing a variety of codecs and file
+// formats. Without this macro definition, an optimizing compiler or linker may
+// very well discard Wuffs code for unused codecs, but listing the Wuffs
+// modules we use makes that process explicit. Preprocessing means that such
+// code simply isn't compiled.
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__BASE
+#define WUFFS_CONFIG__MODULE__JPEG
+
+// If building this program in an environment that doesn't easily accommodate
+// relative includes, you can use the script/inline-c-relative-includes.go
+// program to generate a stand-alone C file.
+#include "../../../release/c/wuffs-unsupported-snapshot.c"
+#include "../testlib/testlib.c"
+#ifdef WUFFS_MIMIC
+#include "../mimiclib/jpeg.c"
+#endif
+
+// ---------------- JPEG Tests
+
+const char*  //
+wuffs_jpeg_decode(uint64_t* n_bytes_out,
+                  wuffs_base__io_buffer* dst,
+                  uint32_t wuffs_initialize_flags,
+                  wuffs_base__pixel_format pixfmt,
+                  uint32_t* quirks_ptr,
+                  size_t quirks_len,
+                  wuffs_base__io_buffer* src) {
+  wuffs_jpeg__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_jpeg__decoder__initialize(&dec, sizeof dec, WUFFS_VERSION,
+                                               wuffs_initialize_flags));
+  return do_run__wuffs_base__image_decoder(
+      wuffs_jpeg__decoder__upcast_as__wuffs_base__image_decoder(&dec),
+      n_bytes_out, dst, pixfmt, quirks_ptr, quirks_len, src);
+}
+
+const char*  //
+test_wuffs_jpeg_decode_interface() {
+  CHECK_FOCUS(__func__);
+
+  const char* filenames[3] = {
+      "test/data/bricks-color.jpeg",
+      "test/data/bricks-color.progressive.jpeg",
+      "test/data/bricks-gray.jpeg",
+  };
+  const wuffs_base__color_u32_argb_premul want_final_pixels[3] = {
+      0xFF012466,
+      0xFF00285E,
+      0xFF070707,
+  };
+
+  int i;
+  for (i = 0; i < 3; i++) {
+    wuffs_jpeg__decoder dec;
+    CHECK_STATUS("initialize",
+                 wuffs_jpeg__decoder__initialize(
+                     &dec, sizeof dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    CHECK_STRING(do_test__wuffs_base__image_decoder(
+        wuffs_jpeg__decoder__upcast_as__wuffs_base__image_decoder(&dec),
+        filenames[i], 0, SIZE_MAX, 160, 120, want_final_pixels[i]));
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_jpeg_decode_bad_header() {
+  CHECK_FOCUS(__func__);
+
+  // A PNG file is not a JPEG file.
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, "test/data/bricks-color.png"));
+
+  wuffs_jpeg__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_jpeg__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_base__image_config ic = ((wuffs_base__image_config){});
+  wuffs_base__status status =
+      wuffs_jpeg__decoder__decode_image_config(&dec, &ic, &src);
+  if (status.repr != wuffs_jpeg__error__bad_header) {
+    RETURN_FAIL("decode_image_config: have \"%s\", want \"%s\"",
+                status.repr, wuffs_jpeg__error__bad_header);
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_jpeg_decode_truncated_input() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, "test/data/bricks-color.jpeg"));
+  if (src.meta.wi < 4000) {
+    RETURN_FAIL("source file is too short");
+  }
+  src.meta.wi = 4000;
+
+  wuffs_jpeg__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_jpeg__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+  const char* have_msg = do_run__wuffs_base__image_decoder(
+      wuffs_jpeg__decoder__upcast_as__wuffs_base__image_decoder(&dec), NULL,
+      &have, wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRX),
+      NULL, 0, &src);
+  if (!have_msg ||
+      !strstr(have_msg, wuffs_jpeg__error__truncated_input + 1)) {
+    RETURN_FAIL("have \"%s\", want \"%s\"", have_msg,
+                wuffs_jpeg__error__truncated_input);
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_jpeg_decode_roi() {
+  CHECK_FOCUS(__func__);
+
+  // These cover 4:2:0 chroma subsampled, progressive and grayscale images.
+  const char* filenames[3] = {
+      "test/data/bricks-color.jpeg",
+      "test/data/bricks-color.progressive.jpeg",
+      "test/data/bricks-gray.jpeg",
+  };
+
+  int i;
+  for (i = 0; i < 3; i++) {
+    wuffs_jpeg__decoder full_dec;
+    CHECK_STATUS("initialize",
+                 wuffs_jpeg__decoder__initialize(
+                     &full_dec, sizeof full_dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_jpeg__decoder roi_dec;
+    CHECK_STATUS("initialize",
+                 wuffs_jpeg__decoder__initialize(
+                     &roi_dec, sizeof roi_dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    CHECK_STRING(do_test__wuffs_base__image_decoder_roi(
+        wuffs_jpeg__decoder__upcast_as__wuffs_base__image_decoder(&full_dec),
+        wuffs_jpeg__decoder__upcast_as__wuffs_base__image_decoder(&roi_dec),
+        filenames[i], wuffs_base__make_rect_ie_u32(37, 11, 101, 60), 41));
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_jpeg_decode_row_bands() {
+  CHECK_FOCUS(__func__);
+
+  // These cover 4:2:0 chroma subsampled, progressive and grayscale images.
+  const char* filenames[3] = {
+      "test/data/bricks-color.jpeg",
+      "test/data/bricks-color.progressive.jpeg",
+      "test/data/bricks-gray.jpeg",
+  };
+  const uint32_t band_heights[3] = {1, 7, 1000};
+
+  int i;
+  for (i = 0; i < 3; i++) {
+    int j;
+    for (j = 0; j < 3; j++) {
+      wuffs_jpeg__decoder full_dec;
+      CHECK_STATUS("initialize",
+                   wuffs_jpeg__decoder__initialize(
+                       &full_dec, sizeof full_dec, WUFFS_VERSION,
+                       WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+      wuffs_jpeg__decoder band_dec;
+      CHECK_STATUS("initialize",
+                   wuffs_jpeg__decoder__initialize(
+                       &band_dec, sizeof band_dec, WUFFS_VERSION,
+                       WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+      CHECK_STRING(do_test__wuffs_base__image_decoder_row_bands(
+          wuffs_jpeg__decoder__upcast_as__wuffs_base__image_decoder(&full_dec),
+          wuffs_jpeg__decoder__upcast_as__wuffs_base__image_decoder(&band_dec),
+          filenames[i], wuffs_base__make_rect_ie_u32(37, 11, 101, 60),
+          band_heights[j], 41));
+    }
+  }
+  return NULL;
+}
+
+// ---------------- Mimic Tests
+
+#ifdef WUFFS_MIMIC
+
+const char*  //
+do_test_mimic_jpeg_decode(const char* filename,
+                          wuffs_base__pixel_format pixfmt) {
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, filename));
+
+  src.meta.ri = 0;
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+  CHECK_STRING(wuffs_jpeg_decode(NULL, &have, WUFFS_INITIALIZE__DEFAULT_OPTIONS,
+                                 pixfmt, NULL, 0, &src));
+
+  src.meta.ri = 0;
+  wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+      .data = g_want_slice_u8,
+  });
+  CHECK_STRING(mimic_jpeg_decode(NULL, &want, WUFFS_INITIALIZE__DEFAULT_OPTIONS,
+                                 pixfmt, NULL, 0, &src));
+
+  return check_io_buffers_equal("", &have, &want);
+}
+
+const char*  //
+test_mimic_jpeg_decode_19k_8bpp() {
+  CHECK_FOCUS(__func__);
+  return do_test_mimic_jpeg_decode(
+      "test/data/bricks-gray.jpeg",
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__Y));
+}
+
+const char*  //
+test_mimic_jpeg_decode_30k_24bpp_progressive() {
+  CHECK_FOCUS(__func__);
+  return do_test_mimic_jpeg_decode(
+      "test/data/bricks-color.progressive.jpeg",
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL));
+}
+
+const char*  //
+test_mimic_jpeg_decode_30k_24bpp_sequential() {
+  CHECK_FOCUS(__func__);
+  return do_test_mimic_jpeg_decode(
+      "test/data/bricks-color.jpeg",
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL));
+}
+
+const char*  //
+test_mimic_jpeg_decode_552k_24bpp_444() {
+  CHECK_FOCUS(__func__);
+  return do_test_mimic_jpeg_decode(
+      "test/data/hibiscus.primitive.jpeg",
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL));
+}
+
+const char*  //
+test_mimic_jpeg_decode_4002k_24bpp() {
+  CHECK_FOCUS(__func__);
+  return do_test_mimic_jpeg_decode(
+      "test/data/harvesters.jpeg",
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL));
+}
+
+#endif  // WUFFS_MIMIC
+
+// ---------------- JPEG Benches
+
+const char*  //
+bench_wuffs_jpeg_decode_19k_8bpp() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &wuffs_jpeg_decode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__Y), NULL, 0,
+      "test/data/bricks-gray.jpeg", 0, SIZE_MAX, 200);
+}
+
+const char*  //
+bench_wuffs_jpeg_decode_77k_24bpp() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &wuffs_jpeg_decode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      NULL, 0, "test/data/bricks-color.jpeg", 0, SIZE_MAX, 200);
+}
+
+const char*  //
+bench_wuffs_jpeg_decode_4002k_24bpp() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &wuffs_jpeg_decode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      NULL, 0, "test/data/harvesters.jpeg", 0, SIZE_MAX, 5);
+}
+
+// ---------------- Mimic Benches
+
+#ifdef WUFFS_MIMIC
+
+const char*  //
+bench_mimic_jpeg_decode_19k_8bpp() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &mimic_jpeg_decode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__Y), NULL, 0,
+      "test/data/bricks-gray.jpeg", 0, SIZE_MAX, 200);
+}
+
+const char*  //
+bench_mimic_jpeg_decode_77k_24bpp() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &mimic_jpeg_decode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      NULL, 0, "test/data/bricks-color.jpeg", 0, SIZE_MAX, 200);
+}
+
+const char*  //
+bench_mimic_jpeg_decode_4002k_24bpp() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &mimic_jpeg_decode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      NULL, 0, "test/data/harvesters.jpeg", 0, SIZE_MAX, 5);
+}
+
+#endif  // WUFFS_MIMIC
+
+// ---------------- Manifest
+
+proc g_tests[] = {
+
+    test_wuffs_jpeg_decode_bad_header,
+    test_wuffs_jpeg_decode_interface,
+    test_wuffs_jpeg_decode_roi,
+    test_wuffs_jpeg_decode_row_bands,
+    test_wuffs_jpeg_decode_truncated_input,
+
+#ifdef WUFFS_MIMIC
+
+    test_mimic_jpeg_decode_19k_8bpp,
+    test_mimic_jpeg_decode_30k_24bpp_progressive,
+    test_mimic_jpeg_decode_30k_24bpp_sequential,
+    test_mimic_jpeg_decode_552k_24bpp_444,
+    test_mimic_jpeg_decode_4002k_24bpp,
+
+#endif  // WUFFS_MIMIC
+
+    NULL,
+};
+
+proc g_benches[] = {
+
+    bench_wuffs_jpeg_decode_19k_8bpp,
+    bench_wuffs_jpeg_decode_77k_24bpp,
+    bench_wuffs_jpeg_decode_4002k_24bpp,
+
+#ifdef WUFFS_MIMIC
+
+    bench_mimic_jpeg_decode_19k_8bpp,
+    bench_mimic_jpeg_decode_77k_24bpp,
+    bench_mimic_jpeg_decode_4002k_24bpp,
+
+#endif  // WUFFS_MIMIC
+
+    NULL,
+};
+
+int  //
+main(int argc, char** argv) {
+  g_proc_package_name = "std/jpeg";
+  return test_main(argc, argv, g_tests, g_benches);
+}
@@ -37,7 +37,7 @@ the first "./a.out" with "./a.out -bench". Combine these changes with the
 "wuffs mimic cflags" to run the mimic benchmarks.
 */
 
-// ¿ wuffs mimic cflags: -DWUFFS_MIMIC
+// ¿ wuffs mimic cflags: -DWUFFS_MIMIC -lyyjson
 
 // Wuffs ships as a "single file C library" or "header file library" as per
 // https://github.com/nothings/stb/blob/master/docs/stb_howto.txt
@@ -64,7 +64,7 @@ the first "./a.out" with "./a.out -bench". Combine these changes with the
 #include "../../../release/c/wuffs-unsupported-snapshot.c"
 #include "../testlib/testlib.c"
 #ifdef WUFFS_MIMIC
-// No mimic library.
+#include "../mimiclib/json.c"
 #endif
 
 // ---------------- Numeric Types Tests
@@ -728,6 +728,71 @@ test_wuffs_strconv_base_16() {
   return NULL;
 }
 
+const char*  //
+test_wuffs_strconv_base_16_long() {
+  CHECK_FOCUS(__func__);
+
+  // Inputs this long can take SIMD code paths. Check that transforming them
+  // all at once gives the same result as transforming them in short pieces.
+  const size_t n = 6000;
+  const size_t piece = 100;
+  uint8_t* src = g_src_array_u8;
+  uint32_t seed = 1;
+  for (size_t i = 0; i < n; i++) {
+    seed = (1103515245 * seed) + 12345;
+    src[i] = (uint8_t)(seed >> 16);
+  }
+
+  for (int four = 0; four < 2; four++) {
+    wuffs_base__transform__output (*encode)(
+        wuffs_base__slice_u8, wuffs_base__slice_u8, bool, uint32_t) =
+        four ? wuffs_base__base_16__encode4 : wuffs_base__base_16__encode2;
+    wuffs_base__transform__output (*decode)(
+        wuffs_base__slice_u8, wuffs_base__slice_u8, bool, uint32_t) =
+        four ? wuffs_base__base_16__decode4 : wuffs_base__base_16__decode2;
+    const size_t m = four ? 4 : 2;
+    const uint32_t options = WUFFS_BASE__BASE_16__DEFAULT_OPTIONS;
+
+    wuffs_base__transform__output o = encode(
+        g_have_slice_u8, wuffs_base__make_slice_u8(src, n), true, options);
+    if (o.status.repr || (o.num_src != n) || (o.num_dst != (n * m))) {
+      RETURN_FAIL("four=%d: encode: \"%s\", %zu, %zu", four, o.status.repr,
+                  o.num_src, o.num_dst);
+    }
+    for (size_t i = 0; i < n; i += piece) {
+      encode(wuffs_base__make_slice_u8(g_want_array_u8 + (i * m), piece * m),
+             wuffs_base__make_slice_u8(src + i, piece), true, options);
+    }
+    if (memcmp(g_have_array_u8, g_want_array_u8, n * m) != 0) {
+      RETURN_FAIL("four=%d: encode: all-at-once and pieces differ", four);
+    }
+
+    o = decode(g_work_slice_u8,
+               wuffs_base__make_slice_u8(g_have_array_u8, n * m), true,
+               options);
+    if (o.status.repr || (o.num_src != (n * m)) || (o.num_dst != n)) {
+      RETURN_FAIL("four=%d: decode: \"%s\", %zu, %zu", four, o.status.repr,
+                  o.num_src, o.num_dst);
+    }
+    if (memcmp(g_work_array_u8, src, n) != 0) {
+      RETURN_FAIL("four=%d: decode: round trip differs", four);
+    }
+
+    // Decoding non-hexadecimal-digits isn't an error, but it should still be
+    // consistent.
+    o = decode(g_have_slice_u8, wuffs_base__make_slice_u8(src, n), true,
+               options);
+    for (size_t i = 0; i < n; i += piece) {
+      decode(wuffs_base__make_slice_u8(g_want_array_u8 + (i / m), piece / m),
+             wuffs_base__make_slice_u8(src + i, piece), true, options);
+    }
+    if (memcmp(g_have_array_u8, g_want_array_u8, n / m) != 0) {
+      RETURN_FAIL("four=%d: decode: all-at-once and pieces differ", four);
+    }
+  }
+  return NULL;
+}
+
 const char*  //
 test_wuffs_strconv_base_64() {
   CHECK_FOCUS(__func__);
@@ -813,6 +878,89 @@ test_wuffs_strconv_base_64() {
   return NULL;
 }
 
+const char*  //
+test_wuffs_strconv_base_64_long() {
+  CHECK_FOCUS(__func__);
+
+  // Inputs this long can take SIMD code paths. Check that encoding them all
+  // at once gives the same result as encoding them in short pieces, and that
+  // decoding gives back the original.
+  const size_t n = 6001;
+  const size_t piece = 300;
+  uint8_t* src = g_src_array_u8;
+  uint32_t seed = 1;
+  for (size_t i = 0; i < n; i++) {
+    seed = (1103515245 * seed) + 12345;
+    src[i] = (uint8_t)(seed >> 16);
+  }
+
+  for (uint32_t url = 0; url < 2; url++) {
+    for (uint32_t pad = 0; pad < 2; pad++) {
+      uint32_t encode_options =
+          (url ? WUFFS_BASE__BASE_64__URL_ALPHABET : 0) |
+          (pad ? WUFFS_BASE__BASE_64__ENCODE_EMIT_PADDING : 0);
+      uint32_t decode_options =
+          (url ? WUFFS_BASE__BASE_64__URL_ALPHABET : 0) |
+          (pad ? WUFFS_BASE__BASE_64__DECODE_ALLOW_PADDING : 0);
+      size_t want_len = pad ? 8004 : 8002;
+
+      wuffs_base__transform__output o =
+          wuffs_base__base_64__encode(g_have_slice_u8,
+                                      wuffs_base__make_slice_u8(src, n),
+                                      true, encode_options);
+      if (o.status.repr || (o.num_src != n) || (o.num_dst != want_len)) {
+        RETURN_FAIL("url=%" PRIu32 ", pad=%" PRIu32
+                    ": encode: \"%s\", %zu, %zu",
+                    url, pad, o.status.repr, o.num_src, o.num_dst);
+      }
+      size_t num_dst = 0;
+      for (size_t i = 0; i < n; i += piece) {
+        size_t p = ((n - i) < piece) ? (n - i) : piece;
+        num_dst += wuffs_base__base_64__encode(
+                       wuffs_base__make_slice_u8(g_want_array_u8 + num_dst,
+                                                 want_len - num_dst),
+                       wuffs_base__make_slice_u8(src + i, p), true,
+                       encode_options)
+                       .num_dst;
+      }
+      if ((num_dst != want_len) ||
+          (memcmp(g_have_array_u8, g_want_array_u8, want_len) != 0)) {
+        RETURN_FAIL("url=%" PRIu32 ", pad=%" PRIu32
+                    ": encode: all-at-once and pieces differ",
+                    url, pad);
+      }
+
+      o = wuffs_base__base_64__decode(
+          g_work_slice_u8, wuffs_base__make_slice_u8(g_have_array_u8, want_len),
+          true, decode_options);
+      if (o.status.repr || (o.num_src != want_len) || (o.num_dst != n)) {
+        RETURN_FAIL("url=%" PRIu32 ", pad=%" PRIu32
+                    ": decode: \"%s\", %zu, %zu",
+                    url, pad, o.status.repr, o.num_src, o.num_dst);
+      }
+      if (memcmp(g_work_array_u8, src, n) != 0) {
+        RETURN_FAIL("url=%" PRIu32 ", pad=%" PRIu32
+                    ": decode: round trip differs",
+                    url, pad);
+      }
+
+      // Change one byte in the middle, to the other alphabet's code 63. That
+      // should be an error at the 4-byte group that contains it.
+      g_have_array_u8[4001] = url ? '/' : '_';
+      o = wuffs_base__base_64__decode(
+          g_work_slice_u8, wuffs_base__make_slice_u8(g_have_array_u8, want_len),
+          true, decode_options);
+      if ((o.status.repr != wuffs_base__error__bad_data) ||
+          (o.num_src != 4000) || (o.num_dst != 3000)) {
+        RETURN_FAIL("url=%" PRIu32 ", pad=%" PRIu32
+                    ": bad decode: \"%s\", %zu, %zu",
+                    url, pad, o.status.repr, o.num_src, o.num_dst);
+      }
+    }
+  }
+  return NULL;
+}
+
 // ----------------
 
 const char*  //
@@ -1166,6 +1314,11 @@ test_wuffs_strconv_parse_number_u64() {
       {.want = 0x00000000000001F5, .str = "0D___5_01__"},
       {.want = 0x00000000FFFFFFFF, .str = "4294967295"},
       {.want = 0x0000000100000000, .str = "4294967296"},
+      {.want = 0x00000000499602D2, .str = "1234567890"},
+      {.want = 0x00000000499602D2, .str = "1234567_890"},
+      {.want = 0x00000000499602D2, .str = "12345678_90"},
+      {.want = 0x000462D53C8ABAC0, .str = "1234567890123456"},
+      {.want = 0x00470DE4DF81FFFA, .str = "19999999999999994"},
       {.want = 0x0123456789ABCDEF, .str = "0x0123456789ABCDEF"},
       {.want = 0x0123456789ABCDEF, .str = "0x0123456789abcdef"},
       {.want = 0xFFFFFFFFFFFFFFF9, .str = "18446744073709551609"},
@@ -1201,6 +1354,9 @@ test_wuffs_strconv_parse_number_u64() {
       {.want = fail, .str = "123 "},
       {.want = fail, .str = "123456789012345678901234"},
       {.want = fail, .str = "12a3"},
+      {.want = fail, .str = "12345678a"},
+      {.want = fail, .str = "1234567a9"},
+      {.want = fail, .str = "99999999999999999999"},
       {.want = fail, .str = "18446744073709551616"},  // UINT64_MAX.
       {.want = fail, .str = "18446744073709551617"},
       {.want = fail, .str = "18446744073709551618"},
@@ -2350,6 +2506,94 @@ test_wuffs_strconv_render_number_u64() {
 
 // ----------------
 
+const char*  //
+test_wuffs_strconv_utf_8_longest_valid_prefix() {
+  CHECK_FOCUS(__func__);
+
+  // Fill a buffer, long enough to take any SIMD code path, mostly with valid
+  // 1-, 2-, 3- and 4-byte UTF-8 but also some invalid byte sequences. Whether
+  // the invalid ones are ever reached depends on the prefix length.
+  static const char* fragments[] = {
+      "a", "b", "c", "d", "e", "f",  // ASCII.
+      "\xC2\xA9",          // U+00A9 COPYRIGHT SIGN.
+      "\xDF\xBF",          // U+07FF.
+      "\xE2\x82\xAC",      // U+20AC EURO SIGN.
+      "\xED\x9F\xBF",      // U+D7FF, just below the surrogates.
+      "\xEF\xBF\xBD",      // U+FFFD REPLACEMENT CHARACTER.
+      "\xF0\x9F\x92\xA9",  // U+1F4A9 PILE OF POO.
+      "\xF4\x8F\xBF\xBF",  // U+10FFFF, the maximum code point.
+  };
+  static const char* invalid_fragments[] = {
+      "\x80",              // Continuation byte without a lead byte.
+      "\xC0\x80",          // Overlong 2-byte encoding.
+      "\xC2",              // Truncated 2-byte encoding.
+      "\xE0\x9F\xBF",      // Overlong 3-byte encoding.
+      "\xED\xA0\x80",      // Surrogate.
+      "\xF0\x8F\xBF\xBF",  // Overlong 4-byte encoding.
+      "\xF4\x90\x80\x80",  // Too large.
+      "\xF5\x80\x80\x80",  // Invalid lead byte.
+      "\xFF",              // Invalid lead byte.
+  };
+  uint8_t* buf = g_src_array_u8;
+  const size_t buf_len = 8192;
+
+  uint32_t seed = 1;
+  for (int round = 0; round < 16; round++) {
+    size_t n = 0;
+    while (n < buf_len) {
+      seed = (1103515245 * seed) + 12345;
+      uint32_t r = seed >> 16;
+      const char* f = NULL;
+      if ((r % 1024) == 0) {
+        f = invalid_fragments[(r / 1024) %
+                              WUFFS_TESTLIB_ARRAY_SIZE(invalid_fragments)];
+      } else if (round < 8) {
+        // Mostly ASCII, with runs of multi-byte UTF-8.
+        f = fragments[((r & 0x3F) < 48)
+                          ? (r % 6)
+                          : (r % WUFFS_TESTLIB_ARRAY_SIZE(fragments))];
+      } else {
+        f = fragments[r % WUFFS_TESTLIB_ARRAY_SIZE(fragments)];
+      }
+      size_t f_len = strlen(f);
+      if (f_len > (buf_len - n)) {
+        f = "a";
+        f_len = 1;
+      }
+      memcpy(buf + n, f, f_len);
+      n += f_len;
+    }
+
+    for (size_t len = 0; len <= buf_len; len += ((len < 64) ? 1 : 61)) {
+      size_t want = 0;
+      while (want < len) {
+        wuffs_base__utf_8__next__output o =
+            wuffs_base__utf_8__next(buf + want, len - want);
+        if ((o.code_point > 0x7F) && (o.byte_length == 1)) {
+          break;
+        }
+        want += o.byte_length;
+      }
+      size_t have = wuffs_base__utf_8__longest_valid_prefix(buf, len);
+      if (have != want) {
+        RETURN_FAIL("round=%d, len=%zu: utf_8: have %zu, want %zu", round,
+                    len, have, want);
+      }
+
+      size_t want_ascii = 0;
+      while ((want_ascii < len) && (buf[want_ascii] < 0x80)) {
+        want_ascii++;
+      }
+      size_t have_ascii = wuffs_base__ascii__longest_valid_prefix(buf, len);
+      if (have_ascii != want_ascii) {
+        RETURN_FAIL("round=%d, len=%zu: ascii: have %zu, want %zu", round,
+                    len, have_ascii, want_ascii);
+      }
+    }
+  }
+  return NULL;
+}
+
 const char*  //
 test_wuffs_strconv_utf_8_next() {
   CHECK_FOCUS(__func__);
@@ -2514,6 +2758,25 @@ golden_test g_json_nobel_prizes_gt = {
     .src_filename = "test/data/nobel-prizes.json",
 };
 
+// gen_json_deeply_nested generates "[[[...]]]", nested as deep as the decoder
+// allows. It is a worst case input: every byte changes the depth.
+const char*  //
+gen_json_deeply_nested(wuffs_base__io_buffer* dst) {
+  size_t depth = WUFFS_JSON__DECODER_DEPTH_MAX_INCL;
+  if ((dst->data.len - dst->meta.wi) < (2 * depth)) {
+    return "gen_json_deeply_nested: dst buffer is too short";
+  }
+  memset(dst->data.ptr + dst->meta.wi, '[', depth);
+  dst->meta.wi += depth;
+  memset(dst->data.ptr + dst->meta.wi, ']', depth);
+  dst->meta.wi += depth;
+  return NULL;
+}
+
+golden_test g_json_deeply_nested_gt = {
+    .src_generator = gen_json_deeply_nested,
+};
+
 // ---------------- JSON Tests
 
 const char*  //
@@ -2783,6 +3046,113 @@ test_wuffs_json_decode_long_numbers() {
 // marks, "abc\xCE\x94efg" can be a single 8-length token instead of multiple
 // (e.g. 3+2+3) tokens. On the other hand, while "abc\xFF" ends with one byte
 // of invalid UTF-8, the 3 good bytes before that should still be output.
+const char*  //
+test_wuffs_json_decode_long_runs() {
+  CHECK_FOCUS(__func__);
+
+  // The decoder skips long runs of whitespace and of plain (non-special ASCII)
+  // string bytes a chunk at a time, possibly with SIMD. Check that each run
+  // length, and what ends the run, gives the same tokens either way.
+  static const uint32_t run_lengths[] = {
+      0,  1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 12, 13, 14,    15,
+      16, 17, 23, 24, 25, 31, 32, 33, 39, 40, 41, 47, 48, 49, 63,    64,
+      65, 99, 0xFFF3, 0xFFF4, 0xFFF7, 0xFFF8, 0xFFFA, 0xFFFB, 0xFFFC, 70000,
+  };
+
+  struct {
+    const char* want_status_repr;
+    const char* tail;
+    uint64_t want_copied_extra;
+  } tails[] = {
+      {.want_status_repr = NULL, .tail = "", .want_copied_extra = 0},
+      {.want_status_repr = NULL, .tail = "\\n", .want_copied_extra = 0},
+      {.want_status_repr = NULL, .tail = "\xCE\x94", .want_copied_extra = 2},
+      {.want_status_repr = wuffs_json__error__bad_c0_control_code,
+       .tail = "\x1F",
+       .want_copied_extra = 0},
+      {.want_status_repr = wuffs_json__error__bad_utf_8,
+       .tail = "\xFF",
+       .want_copied_extra = 0},
+  };
+
+  static const uint64_t rlimits[] = {UINT64_MAX, 13};
+  static const char whitespace[4] = {' ', ' ', '\n', '\t'};
+
+  for (size_t r = 0; r < WUFFS_TESTLIB_ARRAY_SIZE(run_lengths); r++) {
+    uint32_t n = run_lengths[r];
+    for (size_t tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(tails); tc++) {
+      // Make "[ WS \" PLAIN TAIL \" WS ]", where the WS and PLAIN runs are n
+      // bytes long.
+      uint8_t* p = &g_src_array_u8[0];
+      *p++ = '[';
+      for (uint32_t i = 0; i < n; i++) {
+        *p++ = whitespace[(i / 19) & 3];
+      }
+      *p++ = '"';
+      for (uint32_t i = 0; i < n; i++) {
+        *p++ = (uint8_t)(0x20 + (i % 0x5F));
+        if ((p[-1] == '"') || (p[-1] == '\\')) {
+          p[-1] = '#';
+        }
+      }
+      size_t tail_len = strlen(tails[tc].tail);
+      memcpy(p, tails[tc].tail, tail_len);
+      p += tail_len;
+      *p++ = '"';
+      for (uint32_t i = 0; i < n; i++) {
+        *p++ = whitespace[(i / 7) & 3];
+      }
+      *p++ = ']';
+      size_t src_len = (size_t)(p - &g_src_array_u8[0]);
+
+      for (size_t rl = 0; rl < WUFFS_TESTLIB_ARRAY_SIZE(rlimits); rl++) {
+        wuffs_base__token_buffer tok =
+            wuffs_base__slice_token__writer(g_have_slice_token);
+        wuffs_base__io_buffer src = wuffs_base__ptr_u8__reader(
+            &g_src_array_u8[0], src_len, true);
+        const char* have_status_repr =
+            wuffs_json_decode(&tok, &src, WUFFS_INITIALIZE__DEFAULT_OPTIONS,
+                              UINT64_MAX, rlimits[rl]);
+        if (have_status_repr != tails[tc].want_status_repr) {
+          RETURN_FAIL("n=%" PRIu32 ", tc=%zu, rl=%zu: have \"%s\", want \"%s\"",
+                      n, tc, rl, have_status_repr,
+                      tails[tc].want_status_repr);
+        }
+
+        uint64_t total_length = 0;
+        uint64_t copied = 0;
+        for (size_t i = tok.meta.ri; i < tok.meta.wi; i++) {
+          wuffs_base__token* t = &tok.data.ptr[i];
+          uint64_t len = wuffs_base__token__length(t);
+          total_length = wuffs_base__u64__sat_add(total_length, len);
+          if ((wuffs_base__token__value_base_category(t) ==
+               WUFFS_BASE__TOKEN__VBC__STRING) &&
+              (wuffs_base__token__value_base_detail(t) &
+               WUFFS_BASE__TOKEN__VBD__STRING__CONVERT_1_DST_1_SRC_COPY)) {
+            copied = wuffs_base__u64__sat_add(copied, len);
+          }
+        }
+        if (total_length != src.meta.ri) {
+          RETURN_FAIL("n=%" PRIu32 ", tc=%zu, rl=%zu: total length: "
+                      "have %" PRIu64 ", want %zu",
+                      n, tc, rl, total_length, src.meta.ri);
+        }
+        if (have_status_repr) {
+          continue;
+        }
+        uint64_t want_copied = n + tails[tc].want_copied_extra;
+        if (copied != want_copied) {
+          RETURN_FAIL("n=%" PRIu32 ", tc=%zu, rl=%zu: copied: have %" PRIu64
+                      ", want %" PRIu64,
+                      n, tc, rl, copied, want_copied);
+        }
+      }
+    }
+  }
+
+  return NULL;
+}
+
 const char*  //
 test_wuffs_json_decode_prior_valid_utf_8() {
   CHECK_FOCUS(__func__);
@@ -4012,12 +4382,139 @@ test_wuffs_json_decode_string() {
 
 #ifdef WUFFS_MIMIC
 
-// No mimic tests.
+const char*  //
+do_test_mimic_json_decode(golden_test* gt) {
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, gt->src_filename));
+  CHECK_STRING(mimic_json_decode(&have, &src, WUFFS_INITIALIZE__DEFAULT_OPTIONS,
+                                 UINT64_MAX, UINT64_MAX));
+  if (src.meta.ri != src.meta.wi) {
+    RETURN_FAIL("src.meta.ri: have %zu, want %zu", src.meta.ri, src.meta.wi);
+  }
+  return NULL;
+}
+
+const char*  //
+test_mimic_json_decode_australian_abc() {
+  CHECK_FOCUS(__func__);
+  return do_test_mimic_json_decode(&g_json_australian_abc_gt);
+}
+
+const char*  //
+test_mimic_json_decode_file_sizes() {
+  CHECK_FOCUS(__func__);
+  return do_test_mimic_json_decode(&g_json_file_sizes_gt);
+}
+
+const char*  //
+test_mimic_json_decode_github_tags() {
+  CHECK_FOCUS(__func__);
+  return do_test_mimic_json_decode(&g_json_github_tags_gt);
+}
+
+const char*  //
+test_mimic_json_decode_nobel_prizes() {
+  CHECK_FOCUS(__func__);
+  return do_test_mimic_json_decode(&g_json_nobel_prizes_gt);
+}
 
 #endif  // WUFFS_MIMIC
 
 // ---------------- String Conversions Benches
 
+const char*  //
+do_bench_wuffs_strconv_base_16(bool decode, uint64_t iters_unscaled) {
+  const size_t n = 0x40000;
+  uint8_t* src = g_src_array_u8;
+  for (size_t i = 0; i < n; i++) {
+    src[i] = (uint8_t)(i * 0x9D);
+  }
+  wuffs_base__transform__output o = wuffs_base__base_16__encode2(
+      g_work_slice_u8, wuffs_base__make_slice_u8(src, n), true,
+      WUFFS_BASE__BASE_16__DEFAULT_OPTIONS);
+  CHECK_STATUS("encode2", o.status);
+  wuffs_base__slice_u8 encoded =
+      wuffs_base__make_slice_u8(g_work_array_u8, o.num_dst);
+
+  bench_start();
+  uint64_t iters = iters_unscaled * g_flags.iterscale;
+  for (uint64_t i = 0; i < iters; i++) {
+    if (decode) {
+      o = wuffs_base__base_16__decode2(g_have_slice_u8, encoded, true,
+                                       WUFFS_BASE__BASE_16__DEFAULT_OPTIONS);
+    } else {
+      o = wuffs_base__base_16__encode2(g_have_slice_u8,
+                                       wuffs_base__make_slice_u8(src, n), true,
+                                       WUFFS_BASE__BASE_16__DEFAULT_OPTIONS);
+    }
+    CHECK_STATUS("", o.status);
+  }
+  bench_finish(iters, iters * (decode ? encoded.len : n));
+
+  return NULL;
+}
+
+const char*  //
+bench_wuffs_strconv_base_16_decode2() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_strconv_base_16(true, 10);
+}
+
+const char*  //
+bench_wuffs_strconv_base_16_encode2() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_strconv_base_16(false, 10);
+}
+
+const char*  //
+do_bench_wuffs_strconv_base_64(bool decode, uint64_t iters_unscaled) {
+  const size_t n = 0x30000;
+  uint8_t* src = g_src_array_u8;
+  for (size_t i = 0; i < n; i++) {
+    src[i] = (uint8_t)(i * 0x9D);
+  }
+  wuffs_base__transform__output o = wuffs_base__base_64__encode(
+      g_work_slice_u8, wuffs_base__make_slice_u8(src, n), true,
+      WUFFS_BASE__BASE_64__DEFAULT_OPTIONS);
+  CHECK_STATUS("encode", o.status);
+  wuffs_base__slice_u8 encoded =
+      wuffs_base__make_slice_u8(g_work_array_u8, o.num_dst);
+
+  bench_start();
+  uint64_t iters = iters_unscaled * g_flags.iterscale;
+  for (uint64_t i = 0; i < iters; i++) {
+    if (decode) {
+      o = wuffs_base__base_64__decode(g_have_slice_u8, encoded, true,
+                                      WUFFS_BASE__BASE_64__DEFAULT_OPTIONS);
+    } else {
+      o = wuffs_base__base_64__encode(g_have_slice_u8,
+                                      wuffs_base__make_slice_u8(src, n), true,
+                                      WUFFS_BASE__BASE_64__DEFAULT_OPTIONS);
+    }
+    CHECK_STATUS("", o.status);
+  }
+  bench_finish(iters, iters * (decode ? encoded.len : n));
+
+  return NULL;
+}
+
+const char*  //
+bench_wuffs_strconv_base_64_decode() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_strconv_base_64(true, 10);
+}
+
+const char*  //
+bench_wuffs_strconv_base_64_encode() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_strconv_base_64(false, 10);
+}
+
 const char*  //
 do_bench_wuffs_strconv_parse_number_f64(const char* str,
                                         uint64_t iters_unscaled) {
@@ -4062,6 +4559,24 @@ bench_wuffs_strconv_parse_number_f64_pi_short() {
   return do_bench_wuffs_strconv_parse_number_f64("3.14159", 1000);
 }
 
+const char*  //
+bench_wuffs_strconv_parse_number_u64_uint64_max() {
+  CHECK_FOCUS(__func__);
+  const char* str = "18446744073709551615";
+  wuffs_base__slice_u8 s = wuffs_base__make_slice_u8((void*)str, strlen(str));
+
+  bench_start();
+  uint64_t iters = 1000 * g_flags.iterscale;
+  for (uint64_t i = 0; i < iters; i++) {
+    CHECK_STATUS("", wuffs_base__parse_number_u64(
+                         s, WUFFS_BASE__PARSE_NUMBER_XXX__DEFAULT_OPTIONS)
+                         .status);
+  }
+  bench_finish(iters, 0);
+
+  return NULL;
+}
+
 const char*  //
 do_bench_wuffs_strconv_render_number_f64(wuffs_base__slice_u64 test_cases,
                                          uint64_t iters_unscaled) {
@@ -4160,11 +4675,49 @@ bench_wuffs_json_decode_217k_stringy() {
       tcounter_src, &g_json_nobel_prizes_gt, UINT64_MAX, UINT64_MAX, 25);
 }
 
+const char*  //
+bench_wuffs_json_decode_2k_deeply_nested() {
+  CHECK_FOCUS(__func__);
+  return do_bench_token_decoder(
+      wuffs_json_decode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      tcounter_src, &g_json_deeply_nested_gt, UINT64_MAX, UINT64_MAX, 2000);
+}
+
 // ---------------- Mimic Benches
 
 #ifdef WUFFS_MIMIC
 
-// No mimic benches.
+const char*  //
+bench_mimic_json_decode_1k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      mimic_json_decode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      tcounter_src, &g_json_github_tags_gt, UINT64_MAX, UINT64_MAX, 10000);
+}
+
+const char*  //
+bench_mimic_json_decode_21k_formatted() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      mimic_json_decode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      tcounter_src, &g_json_file_sizes_gt, UINT64_MAX, UINT64_MAX, 300);
+}
+
+const char*  //
+bench_mimic_json_decode_26k_compact() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      mimic_json_decode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      tcounter_src, &g_json_australian_abc_gt, UINT64_MAX, UINT64_MAX, 250);
+}
+
+const char*  //
+bench_mimic_json_decode_217k_stringy() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      mimic_json_decode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      tcounter_src, &g_json_nobel_prizes_gt, UINT64_MAX, UINT64_MAX, 25);
+}
 
 #endif  // WUFFS_MIMIC
 
@@ -4178,7 +4731,9 @@ proc g_tests[] = {
     test_wuffs_core_count_leading_zeroes_u64,
     test_wuffs_core_multiply_u64,
     test_wuffs_strconv_base_16,
+    test_wuffs_strconv_base_16_long,
     test_wuffs_strconv_base_64,
+    test_wuffs_strconv_base_64_long,
     test_wuffs_strconv_hpd_rounded_integer,
     test_wuffs_strconv_hpd_shift,
     test_wuffs_strconv_ieee_754_bit_representation_from_u16,
@@ -4190,11 +4745,13 @@ proc g_tests[] = {
     test_wuffs_strconv_render_number_f64,
     test_wuffs_strconv_render_number_i64,
     test_wuffs_strconv_render_number_u64,
+    test_wuffs_strconv_utf_8_longest_valid_prefix,
     test_wuffs_strconv_utf_8_next,
 
     test_wuffs_json_decode_end_of_data,
     test_wuffs_json_decode_interface,
     test_wuffs_json_decode_long_numbers,
+    test_wuffs_json_decode_long_runs,
     test_wuffs_json_decode_prior_valid_utf_8,
     test_wuffs_json_decode_quirk_allow_backslash_etc,
     test_wuffs_json_decode_quirk_allow_backslash_x,
@@ -4211,7 +4768,10 @@ proc g_tests[] = {
 
 #ifdef WUFFS_MIMIC
 
-// No mimic tests.
+    test_mimic_json_decode_australian_abc,
+    test_mimic_json_decode_file_sizes,
+    test_mimic_json_decode_github_tags,
+    test_mimic_json_decode_nobel_prizes,
 
 #endif  // WUFFS_MIMIC
 
@@ -4220,10 +4780,15 @@ proc g_tests[] = {
 
 proc g_benches[] = {
 
+    bench_wuffs_strconv_base_16_decode2,
+    bench_wuffs_strconv_base_16_encode2,
+    bench_wuffs_strconv_base_64_decode,
+    bench_wuffs_strconv_base_64_encode,
     bench_wuffs_strconv_parse_number_f64_1_lsh53_add0,
     bench_wuffs_strconv_parse_number_f64_1_lsh53_add1,
     bench_wuffs_strconv_parse_number_f64_pi_long,
     bench_wuffs_strconv_parse_number_f64_pi_short,
+    bench_wuffs_strconv_parse_number_u64_uint64_max,
     bench_wuffs_strconv_render_number_f64_just_enough_fractions,
     bench_wuffs_strconv_render_number_f64_just_enough_small_integers,
 
@@ -4231,10 +4796,14 @@ proc g_benches[] = {
     bench_wuffs_json_decode_21k_formatted,
     bench_wuffs_json_decode_26k_compact,
     bench_wuffs_json_decode_217k_stringy,
+    bench_wuffs_json_decode_2k_deeply_nested,
 
 #ifdef WUFFS_MIMIC
 
-// No mimic benches.
+    bench_mimic_json_decode_1k,
+    bench_mimic_json_decode_21k_formatted,
+    bench_mimic_json_decode_26k_compact,
+    bench_mimic_json_decode_217k_stringy,
 
 #endif  // WUFFS_MIMIC
 
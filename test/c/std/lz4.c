@@ -0,0 +1,458 @@
+// Copyright 2018 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ----------------
+
+/*
+This test program is typically run indirectly, by the "wuffs test" or "wuffs
+bench" commands. These commands take an optional "-mimic" flag to check that
+Wuffs' output mimics (i.e. exactly matches) other libraries' output, such as
+giflib for GIF, libpng for PNG, etc.
+
+To manually run this test:
+
+for CC in clang gcc; do
+  $CC -std=c99 -Wall -Werror lz4.c && ./a.out
+  rm -f a.out
+done
+
+Each edition should print "PASS", amongst other information, and exit(0).
+
+Add the "wuffs mimic cflags" (everything after the colon below) to the C
+compiler flags (after the .c file) to run the mimic tests.
+
+To manually run the benchmarks, replace "-Wall -Werror" with "-O3" and replace
+the first "./a.out" with "./a.out -bench". Combine these changes with the
+"wuffs mimic cflags" to run the mimic benchmarks.
+*/
+
+// ¿ wuffs mimic cflags: -DWUFFS_MIMIC -llz4
+
+// Wuffs ships as a "single file C library" or "header file library" as per
+// https://github.com/nothings/stb/blob/master/docs/stb_howto.txt
+//
+// To use that single file as a "foo.c"-like implementation, instead of a
+// "foo.h"-like header, #define WUFFS_IMPLEMENTATION before #include'ing or
+// compiling it.
+#define WUFFS_IMPLEMENTATION
+
+// Defining the WUFFS_CONFIG__MODULE* macros are optional, but it lets users of
+// release/c/etc.c choose which parts of Wuffs to build. That file contains the
+// entire Wuffs standard library, implementing a variety of codecs and file
+// formats. Without this macro definition, an optimizing compiler or linker may
+// very well discard Wuffs code for unused codecs, but listing the Wuffs
+// modules we use makes that process explicit. Preprocessing means that such
+// code simply isn't compiled.
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__BASE
+#define WUFFS_CONFIG__MODULE__LZ4
+#define WUFFS_CONFIG__MODULE__XXHASH32
+
+// If building this program in an environment that doesn't easily accommodate
+// relative includes, you can use the script/inline-c-relative-includes.go
+// program to generate a stand-alone C file.
+#include "../../../release/c/wuffs-unsupported-snapshot.c"
+#include "../testlib/testlib.c"
+#ifdef WUFFS_MIMIC
+#include "../mimiclib/lz4.c"
+#endif
+
+// ---------------- Golden Tests
+
+// midsummer.txt.lz4 and romeo.txt.lz4 use the lz4 command line tool's default
+// frame options: one independent block and a content checksum. pi.txt.lz4
+// has linked 64 KiB blocks, block checksums and the content size.
+
+golden_test g_lz4_midsummer_gt = {
+    .want_filename = "test/data/midsummer.txt",
+    .src_filename = "test/data/midsummer.txt.lz4",
+};
+
+golden_test g_lz4_pi_gt = {
+    .want_filename = "test/data/pi.txt",
+    .src_filename = "test/data/pi.txt.lz4",
+};
+
+// ---------------- LZ4 Tests
+
+const char*  //
+test_wuffs_lz4_decode_interface() {
+  CHECK_FOCUS(__func__);
+  wuffs_lz4__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_lz4__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  return do_test__wuffs_base__io_transformer(
+      wuffs_lz4__decoder__upcast_as__wuffs_base__io_transformer(&dec),
+      "test/data/romeo.txt.lz4", 0, SIZE_MAX, 942, 0x0A);
+}
+
+const char*  //
+wuffs_lz4_decode(wuffs_base__io_buffer* dst,
+                 wuffs_base__io_buffer* src,
+                 uint32_t wuffs_initialize_flags,
+                 uint64_t wlimit,
+                 uint64_t rlimit) {
+  wuffs_lz4__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_lz4__decoder__initialize(&dec, sizeof dec, WUFFS_VERSION,
+                                              wuffs_initialize_flags));
+
+  while (true) {
+    wuffs_base__io_buffer limited_dst = make_limited_writer(*dst, wlimit);
+    wuffs_base__io_buffer limited_src = make_limited_reader(*src, rlimit);
+
+    wuffs_base__status status = wuffs_lz4__decoder__transform_io(
+        &dec, &limited_dst, &limited_src, g_work_slice_u8);
+
+    dst->meta.wi += limited_dst.meta.wi;
+    src->meta.ri += limited_src.meta.ri;
+
+    if (((wlimit < UINT64_MAX) &&
+         (status.repr == wuffs_base__suspension__short_write)) ||
+        ((rlimit < UINT64_MAX) &&
+         (status.repr == wuffs_base__suspension__short_read))) {
+      continue;
+    }
+    return status.repr;
+  }
+}
+
+const char*  //
+do_test_wuffs_lz4_checksum(bool ignore_checksum,
+                           const char* src_filename,
+                           size_t (*find_checksum)(wuffs_base__io_buffer*),
+                           const char* want_bad_checksum) {
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, src_filename));
+
+  for (int bad = 0; bad < 2; bad++) {
+    if (bad) {
+      size_t i = (*find_checksum)(&src);
+      if (i >= src.meta.wi) {
+        RETURN_FAIL("could not find the checksum");
+      }
+      src.data.ptr[i] ^= 1;
+    }
+
+    wuffs_lz4__decoder dec;
+    CHECK_STATUS("initialize",
+                 wuffs_lz4__decoder__initialize(
+                     &dec, sizeof dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_lz4__decoder__set_quirk_enabled(
+        &dec, WUFFS_BASE__QUIRK_IGNORE_CHECKSUM, ignore_checksum);
+    have.meta.wi = 0;
+    src.meta.ri = 0;
+
+    const char* want = (bad && !ignore_checksum) ? want_bad_checksum : NULL;
+    wuffs_base__status have_z = wuffs_lz4__decoder__transform_io(
+        &dec, &have, &src, g_work_slice_u8);
+    if (have_z.repr != want) {
+      RETURN_FAIL("bad=%d: have \"%s\", want \"%s\"", bad, have_z.repr, want);
+    }
+  }
+  return NULL;
+}
+
+size_t  //
+find_lz4_block_checksum(wuffs_base__io_buffer* src) {
+  // pi.txt.lz4's frame descriptor is 11 bytes (FLG, BD, an 8 byte Content
+  // Size and HC), after the 4 byte magic number. The first block's checksum
+  // follows its 4 byte size and its data.
+  if (src->meta.wi < 19) {
+    return SIZE_MAX;
+  }
+  uint32_t block_size =
+      0x7FFFFFFF & wuffs_base__peek_u32le__no_bounds_check(src->data.ptr + 15);
+  return 19 + ((size_t)block_size);
+}
+
+size_t  //
+find_lz4_content_checksum(wuffs_base__io_buffer* src) {
+  return (src->meta.wi < 4) ? SIZE_MAX : (src->meta.wi - 4);
+}
+
+size_t  //
+find_lz4_header_checksum(wuffs_base__io_buffer* src) {
+  // midsummer.txt.lz4's frame descriptor is 3 bytes (FLG, BD and HC).
+  return 6;
+}
+
+const char*  //
+test_wuffs_lz4_checksum_ignore() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_lz4_checksum(true, "test/data/pi.txt.lz4",
+                                    &find_lz4_block_checksum, NULL);
+}
+
+const char*  //
+test_wuffs_lz4_checksum_verify_block() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_lz4_checksum(false, "test/data/pi.txt.lz4",
+                                    &find_lz4_block_checksum,
+                                    wuffs_lz4__error__bad_block_checksum);
+}
+
+const char*  //
+test_wuffs_lz4_checksum_verify_content() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_lz4_checksum(false, "test/data/midsummer.txt.lz4",
+                                    &find_lz4_content_checksum,
+                                    wuffs_lz4__error__bad_checksum);
+}
+
+const char*  //
+test_wuffs_lz4_checksum_verify_header() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_lz4_checksum(false, "test/data/midsummer.txt.lz4",
+                                    &find_lz4_header_checksum,
+                                    wuffs_lz4__error__bad_header_checksum);
+}
+
+const char*  //
+test_wuffs_lz4_decode_bad_offset() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+
+  // A frame (with no checksums) whose only block has a zero offset.
+  static const uint8_t src_data[] = {
+      0x04, 0x22, 0x4D, 0x18, 0x60, 0x40, 0x82,  // Magic, FLG, BD, HC.
+      0x07, 0x00, 0x00, 0x00,                    // Block size.
+      0x10, 0x61, 0x00, 0x00, 0x10, 0x62, 0x00,  // Block data.
+      0x00, 0x00, 0x00, 0x00,                    // EndMark.
+  };
+  wuffs_base__io_buffer src = wuffs_base__ptr_u8__reader(
+      (uint8_t*)(src_data), sizeof src_data, true);
+
+  wuffs_lz4__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_lz4__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_base__status status =
+      wuffs_lz4__decoder__transform_io(&dec, &have, &src, g_work_slice_u8);
+  if (status.repr != wuffs_lz4__error__bad_offset) {
+    RETURN_FAIL("transform_io: have \"%s\", want \"%s\"", status.repr,
+                wuffs_lz4__error__bad_offset);
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_lz4_decode_midsummer() {
+  CHECK_FOCUS(__func__);
+  return do_test_io_buffers(wuffs_lz4_decode, &g_lz4_midsummer_gt, UINT64_MAX,
+                            UINT64_MAX);
+}
+
+const char*  //
+test_wuffs_lz4_decode_multiple_frames() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+  wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+      .data = g_want_slice_u8,
+  });
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+
+  // Concatenate a skippable frame and two LZ4 frames, like "cat skippable
+  // romeo.txt.lz4 midsummer.txt.lz4".
+  static const uint8_t skippable[12] = {
+      0x5A, 0x2A, 0x4D, 0x18, 0x04, 0x00, 0x00, 0x00, 0xDE, 0xAD, 0xBE, 0xEF,
+  };
+  memcpy(src.data.ptr, skippable, 12);
+  src.meta.wi = 12;
+  const char* filenames[2][2] = {
+      {"test/data/romeo.txt.lz4", "test/data/romeo.txt"},
+      {"test/data/midsummer.txt.lz4", "test/data/midsummer.txt"},
+  };
+  size_t frame_ends[2] = {0};
+  for (int i = 0; i < 2; i++) {
+    src.meta.closed = false;
+    want.meta.closed = false;
+    CHECK_STRING(read_file(&src, filenames[i][0]));
+    CHECK_STRING(read_file(&want, filenames[i][1]));
+    frame_ends[i] = src.meta.wi;
+  }
+
+  wuffs_lz4__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_lz4__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+
+  // Each transform_io call decodes (and verifies the checksum of) exactly one
+  // frame and leaves src positioned at the start of the next frame.
+  for (int i = 0; i < 2; i++) {
+    CHECK_STATUS("transform_io", wuffs_lz4__decoder__transform_io(
+                                     &dec, &have, &src, g_work_slice_u8));
+    if (src.meta.ri != frame_ends[i]) {
+      RETURN_FAIL("i=%d: src.meta.ri: have %zu, want %zu", i, src.meta.ri,
+                  frame_ends[i]);
+    }
+  }
+  return check_io_buffers_equal("", &have, &want);
+}
+
+const char*  //
+test_wuffs_lz4_decode_pi_just_one_read() {
+  CHECK_FOCUS(__func__);
+  return do_test_io_buffers(wuffs_lz4_decode, &g_lz4_pi_gt, UINT64_MAX,
+                            UINT64_MAX);
+}
+
+const char*  //
+test_wuffs_lz4_decode_pi_many_big_reads() {
+  CHECK_FOCUS(__func__);
+  return do_test_io_buffers(wuffs_lz4_decode, &g_lz4_pi_gt, UINT64_MAX, 4096);
+}
+
+const char*  //
+test_wuffs_lz4_decode_pi_many_medium_reads() {
+  CHECK_FOCUS(__func__);
+  return do_test_io_buffers(wuffs_lz4_decode, &g_lz4_pi_gt, UINT64_MAX, 599);
+}
+
+const char*  //
+test_wuffs_lz4_decode_pi_many_medium_writes() {
+  CHECK_FOCUS(__func__);
+  return do_test_io_buffers(wuffs_lz4_decode, &g_lz4_pi_gt, 997, UINT64_MAX);
+}
+
+const char*  //
+test_wuffs_lz4_decode_pi_many_small_writes_reads() {
+  CHECK_FOCUS(__func__);
+  return do_test_io_buffers(wuffs_lz4_decode, &g_lz4_pi_gt, 59, 61);
+}
+
+// ---------------- Mimic Tests
+
+#ifdef WUFFS_MIMIC
+
+const char*  //
+test_mimic_lz4_decode_midsummer() {
+  CHECK_FOCUS(__func__);
+  return do_test_io_buffers(mimic_lz4_decode, &g_lz4_midsummer_gt, UINT64_MAX,
+                            UINT64_MAX);
+}
+
+const char*  //
+test_mimic_lz4_decode_pi() {
+  CHECK_FOCUS(__func__);
+  return do_test_io_buffers(mimic_lz4_decode, &g_lz4_pi_gt, UINT64_MAX,
+                            UINT64_MAX);
+}
+
+#endif  // WUFFS_MIMIC
+
+// ---------------- LZ4 Benches
+
+const char*  //
+bench_wuffs_lz4_decode_10k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_lz4_decode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      tcounter_dst, &g_lz4_midsummer_gt, UINT64_MAX, UINT64_MAX, 300);
+}
+
+const char*  //
+bench_wuffs_lz4_decode_100k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_lz4_decode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      tcounter_dst, &g_lz4_pi_gt, UINT64_MAX, UINT64_MAX, 30);
+}
+
+// ---------------- Mimic Benches
+
+#ifdef WUFFS_MIMIC
+
+const char*  //
+bench_mimic_lz4_decode_10k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(mimic_lz4_decode, 0, tcounter_dst,
+                             &g_lz4_midsummer_gt, UINT64_MAX, UINT64_MAX, 300);
+}
+
+const char*  //
+bench_mimic_lz4_decode_100k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(mimic_lz4_decode, 0, tcounter_dst, &g_lz4_pi_gt,
+                             UINT64_MAX, UINT64_MAX, 30);
+}
+
+#endif  // WUFFS_MIMIC
+
+// ---------------- Manifest
+
+proc g_tests[] = {
+
+    test_wuffs_lz4_checksum_ignore,
+    test_wuffs_lz4_checksum_verify_block,
+    test_wuffs_lz4_checksum_verify_content,
+    test_wuffs_lz4_checksum_verify_header,
+    test_wuffs_lz4_decode_bad_offset,
+    test_wuffs_lz4_decode_interface,
+    test_wuffs_lz4_decode_midsummer,
+    test_wuffs_lz4_decode_multiple_frames,
+    test_wuffs_lz4_decode_pi_just_one_read,
+    test_wuffs_lz4_decode_pi_many_big_reads,
+    test_wuffs_lz4_decode_pi_many_medium_reads,
+    test_wuffs_lz4_decode_pi_many_medium_writes,
+    test_wuffs_lz4_decode_pi_many_small_writes_reads,
+
+#ifdef WUFFS_MIMIC
+
+    test_mimic_lz4_decode_midsummer,
+    test_mimic_lz4_decode_pi,
+
+#endif  // WUFFS_MIMIC
+
+    NULL,
+};
+
+proc g_benches[] = {
+
+    bench_wuffs_lz4_decode_10k,
+    bench_wuffs_lz4_decode_100k,
+
+#ifdef WUFFS_MIMIC
+
+    bench_mimic_lz4_decode_10k,
+    bench_mimic_lz4_decode_100k,
+
+#endif  // WUFFS_MIMIC
+
+    NULL,
+};
+
+int  //
+main(int argc, char** argv) {
+  g_proc_package_name = "std/lz4";
+  return test_main(argc, argv, g_tests, g_benches);
+}
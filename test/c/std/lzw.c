@@ -210,6 +210,45 @@ test_wuffs_lzw_decode_pi() {
                                   UINT64_MAX);
 }
 
+const char*  //
+test_wuffs_lzw_decode_msb_first() {
+  CHECK_FOCUS(__func__);
+
+  // This is the MSB first example from std/lzw/README.md: the 9-bit codes
+  // 0x054 (Literal "T"), 0x04F (Literal "O") and 0x101 (End code).
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  src.meta.wi = 4;
+  src.data.ptr[0] = 0x2A;
+  src.data.ptr[1] = 0x13;
+  src.data.ptr[2] = 0xE0;
+  src.data.ptr[3] = 0x20;
+
+  wuffs_lzw__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_lzw__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_lzw__decoder__set_quirk_enabled(&dec, WUFFS_LZW__QUIRK_MSB_FIRST,
+                                        true);
+  wuffs_lzw__decoder__set_literal_width(&dec, 8);
+
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+  CHECK_STATUS("transform_io", wuffs_lzw__decoder__transform_io(
+                                   &dec, &have, &src, g_work_slice_u8));
+
+  wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+      .data = g_want_slice_u8,
+  });
+  want.meta.wi = 2;
+  want.data.ptr[0] = 'T';
+  want.data.ptr[1] = 'O';
+  return check_io_buffers_equal("", &have, &want);
+}
+
 const char*  //
 test_wuffs_lzw_decode_output_bad() {
   CHECK_FOCUS(__func__);
@@ -382,8 +421,52 @@ test_wuffs_lzw_decode_width_1() {
 
 // ---------------- LZW Benches
 
+// gen_lzw_constant_resets generates LZW codes (with a leading literal width
+// byte) that alternate between a clear code and a literal. It is a worst case
+// input: every other code resets the table and no code is ever a back-ref.
 const char*  //
-do_bench_wuffs_lzw_decode(const char* filename, uint64_t iters_unscaled) {
+gen_lzw_constant_resets(wuffs_base__io_buffer* dst) {
+  const uint32_t n_literals = 32768;
+  const uint32_t clear_code = 0x100;
+  const uint32_t end_code = 0x101;
+
+  uint64_t n = 1 + ((((2 * (uint64_t)n_literals) + 1) * 9) + 7) / 8;
+  if ((dst->data.len - dst->meta.wi) < n) {
+    return "gen_lzw_constant_resets: dst buffer is too short";
+  }
+  dst->data.ptr[dst->meta.wi++] = 0x08;  // The literal width.
+
+  // Every code is 9 bits wide, packed LSB-first.
+  uint64_t bits = 0;
+  uint32_t n_bits = 0;
+  for (uint32_t i = 0; i <= n_literals; i++) {
+    uint32_t codes[2] = {clear_code, i & 0xFF};
+    if (i == n_literals) {
+      codes[0] = end_code;
+    }
+    for (int j = 0; j < ((i == n_literals) ? 1 : 2); j++) {
+      bits |= ((uint64_t)codes[j]) << n_bits;
+      n_bits += 9;
+      while (n_bits >= 8) {
+        dst->data.ptr[dst->meta.wi++] = (uint8_t)bits;
+        bits >>= 8;
+        n_bits -= 8;
+      }
+    }
+  }
+  if (n_bits > 0) {
+    dst->data.ptr[dst->meta.wi++] = (uint8_t)bits;
+  }
+  return NULL;
+}
+
+// do_bench_wuffs_lzw_decode decodes the named file or, if src_generator is
+// non-NULL, the generated input. The former counts dst bytes. The latter
+// counts src bytes and also reports ns/B.
+const char*  //
+do_bench_wuffs_lzw_decode(const char* filename,
+                          const char* (*src_generator)(wuffs_base__io_buffer*),
+                          uint64_t iters_unscaled) {
   wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
       .data = g_have_slice_u8,
   });
@@ -391,7 +474,12 @@ do_bench_wuffs_lzw_decode(const char* filename, uint64_t iters_unscaled) {
       .data = g_src_slice_u8,
   });
 
-  CHECK_STRING(read_file(&src, filename));
+  if (src_generator) {
+    CHECK_STRING((*src_generator)(&src));
+    src.meta.closed = true;
+  } else {
+    CHECK_STRING(read_file(&src, filename));
+  }
   if (src.meta.wi <= 0) {
     RETURN_FAIL("src size: have %d, want > 0", (int)(src.meta.wi));
   }
@@ -401,6 +489,7 @@ do_bench_wuffs_lzw_decode(const char* filename, uint64_t iters_unscaled) {
                 0x08);
   }
 
+  g_bench_ns_per_byte = src_generator != NULL;
   bench_start();
   uint64_t n_bytes = 0;
   uint64_t iters = iters_unscaled * g_flags.iterscale;
@@ -414,7 +503,7 @@ do_bench_wuffs_lzw_decode(const char* filename, uint64_t iters_unscaled) {
                      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
     CHECK_STATUS("transform_io", wuffs_lzw__decoder__transform_io(
                                      &dec, &have, &src, g_work_slice_u8));
-    n_bytes += have.meta.wi;
+    n_bytes += src_generator ? (src.meta.ri - 1) : have.meta.wi;
   }
   bench_finish(iters, n_bytes);
   return NULL;
@@ -423,13 +512,20 @@ do_bench_wuffs_lzw_decode(const char* filename, uint64_t iters_unscaled) {
 const char*  //
 bench_wuffs_lzw_decode_20k() {
   CHECK_FOCUS(__func__);
-  return do_bench_wuffs_lzw_decode("test/data/bricks-gray.indexes.giflzw", 50);
+  return do_bench_wuffs_lzw_decode("test/data/bricks-gray.indexes.giflzw",
+                                   NULL, 50);
 }
 
 const char*  //
 bench_wuffs_lzw_decode_100k() {
   CHECK_FOCUS(__func__);
-  return do_bench_wuffs_lzw_decode("test/data/pi.txt.giflzw", 10);
+  return do_bench_wuffs_lzw_decode("test/data/pi.txt.giflzw", NULL, 10);
+}
+
+const char*  //
+bench_wuffs_lzw_decode_70k_constant_resets() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_lzw_decode(NULL, gen_lzw_constant_resets, 10);
 }
 
 // ---------------- Manifest
@@ -441,6 +537,7 @@ proc g_tests[] = {
     test_wuffs_lzw_decode_interface,
     test_wuffs_lzw_decode_many_big_reads,
     test_wuffs_lzw_decode_many_small_writes_reads,
+    test_wuffs_lzw_decode_msb_first,
     test_wuffs_lzw_decode_output_bad,
     test_wuffs_lzw_decode_output_empty,
     test_wuffs_lzw_decode_pi,
@@ -454,6 +551,7 @@ proc g_benches[] = {
 
     bench_wuffs_lzw_decode_20k,
     bench_wuffs_lzw_decode_100k,
+    bench_wuffs_lzw_decode_70k_constant_resets,
 
     NULL,
 };
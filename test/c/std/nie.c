@@ -108,6 +108,175 @@ test_wuffs_nie_decode_frame_config() {
   return NULL;
 }
 
+const char*  //
+test_wuffs_nie_decode_roi() {
+  CHECK_FOCUS(__func__);
+  wuffs_nie__decoder full_dec;
+  CHECK_STATUS("initialize",
+               wuffs_nie__decoder__initialize(
+                   &full_dec, sizeof full_dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_nie__decoder roi_dec;
+  CHECK_STATUS("initialize",
+               wuffs_nie__decoder__initialize(
+                   &roi_dec, sizeof roi_dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  return do_test__wuffs_base__image_decoder_roi(
+      wuffs_nie__decoder__upcast_as__wuffs_base__image_decoder(&full_dec),
+      wuffs_nie__decoder__upcast_as__wuffs_base__image_decoder(&roi_dec),
+      "test/data/hippopotamus.nie", wuffs_base__make_rect_ie_u32(5, 7, 30, 20),
+      37);
+}
+
+const char*  //
+test_wuffs_nie_decode_row_bands() {
+  CHECK_FOCUS(__func__);
+  const uint32_t band_heights[3] = {1, 7, 1000};
+
+  int j;
+  for (j = 0; j < 3; j++) {
+    wuffs_nie__decoder full_dec;
+    CHECK_STATUS("initialize",
+                 wuffs_nie__decoder__initialize(
+                     &full_dec, sizeof full_dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_nie__decoder band_dec;
+    CHECK_STATUS("initialize",
+                 wuffs_nie__decoder__initialize(
+                     &band_dec, sizeof band_dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    CHECK_STRING(do_test__wuffs_base__image_decoder_row_bands(
+        wuffs_nie__decoder__upcast_as__wuffs_base__image_decoder(&full_dec),
+        wuffs_nie__decoder__upcast_as__wuffs_base__image_decoder(&band_dec),
+        "test/data/hippopotamus.nie", wuffs_base__make_rect_ie_u32(5, 7, 30, 20),
+        band_heights[j], 37));
+  }
+  return NULL;
+}
+
+// do_wuffs_nie_decode decodes the NIE image in src to the given pixel format,
+// into a pixel buffer backed by dst.
+const char*  //
+do_wuffs_nie_decode(wuffs_base__pixel_buffer* pb,
+                    wuffs_base__io_buffer* src,
+                    uint32_t pixfmt_repr,
+                    wuffs_base__slice_u8 dst) {
+  wuffs_nie__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_nie__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_base__image_config ic = ((wuffs_base__image_config){});
+  CHECK_STATUS("decode_image_config",
+               wuffs_nie__decoder__decode_image_config(&dec, &ic, src));
+  wuffs_base__pixel_config__set(&ic.pixcfg, pixfmt_repr,
+                                WUFFS_BASE__PIXEL_SUBSAMPLING__NONE,
+                                wuffs_base__pixel_config__width(&ic.pixcfg),
+                                wuffs_base__pixel_config__height(&ic.pixcfg));
+  CHECK_STATUS("set_from_slice",
+               wuffs_base__pixel_buffer__set_from_slice(pb, &ic.pixcfg, dst));
+  CHECK_STATUS("decode_frame",
+               wuffs_nie__decoder__decode_frame(
+                   &dec, pb, src, WUFFS_BASE__PIXEL_BLEND__SRC,
+                   wuffs_base__empty_slice_u8(), NULL));
+  return NULL;
+}
+
+// do_wuffs_nie_encode encodes src to dst, which must be empty. A non-zero
+// max_write_length limits how much the encoder can write per encode_image
+// call, exercising its suspend and resume paths.
+const char*  //
+do_wuffs_nie_encode(wuffs_base__io_buffer* dst,
+                    wuffs_base__pixel_buffer* src,
+                    size_t max_write_length) {
+  wuffs_nie__encoder enc;
+  CHECK_STATUS("initialize",
+               wuffs_nie__encoder__initialize(
+                   &enc, sizeof enc, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  if (max_write_length == 0) {
+    CHECK_STATUS("encode_image",
+                 wuffs_nie__encoder__encode_image(&enc, dst, src));
+    return NULL;
+  }
+  while (true) {
+    wuffs_base__io_buffer limited = *dst;
+    if (limited.data.len > (limited.meta.wi + max_write_length)) {
+      limited.data.len = limited.meta.wi + max_write_length;
+    }
+    wuffs_base__status status =
+        wuffs_nie__encoder__encode_image(&enc, &limited, src);
+    dst->meta.wi = limited.meta.wi;
+    if (wuffs_base__status__is_ok(&status)) {
+      return NULL;
+    } else if ((status.repr != wuffs_base__suspension__short_write) ||
+               (dst->meta.wi == dst->data.len)) {
+      return wuffs_base__status__message(&status);
+    }
+  }
+}
+
+const char*  //
+test_wuffs_nie_encode_round_trip() {
+  CHECK_FOCUS(__func__);
+
+  // Decoding hippopotamus.nie (an opaque "bn4" image) to each pixel format
+  // and encoding that should give back the same file. BGRA_NONPREMUL is
+  // copied verbatim, BGR and BGRA_PREMUL are converted and
+  // BGRA_NONPREMUL_4X16LE gives a "bn8" image, which is then converted back.
+  const uint32_t pixfmts[4] = {
+      WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+      WUFFS_BASE__PIXEL_FORMAT__BGR,
+      WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+      WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE,
+  };
+  const size_t max_write_lengths[3] = {0, 1, 77};
+
+  wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+      .data = g_want_slice_u8,
+  });
+  CHECK_STRING(read_file(&want, "test/data/hippopotamus.nie"));
+
+  for (int tc = 0; tc < 4; tc++) {
+    for (int j = 0; j < 3; j++) {
+      wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+          .data = g_src_slice_u8,
+      });
+      CHECK_STRING(read_file(&src, "test/data/hippopotamus.nie"));
+      wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+      CHECK_STRING(
+          do_wuffs_nie_decode(&pb, &src, pixfmts[tc], g_pixel_slice_u8));
+
+      wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+          .data = g_have_slice_u8,
+      });
+      char prefix_buf[256];
+      sprintf(prefix_buf, "tc=%d, j=%d: ", tc, j);
+      const char* status =
+          do_wuffs_nie_encode(&have, &pb, max_write_lengths[j]);
+      if (status) {
+        RETURN_FAIL("%s%s", prefix_buf, status);
+      }
+      have.meta.closed = true;
+
+      if (pixfmts[tc] == WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE) {
+        if ((have.meta.wi < 8) || (have.data.ptr[7] != '8')) {
+          RETURN_FAIL("%snot a \"bn8\" image", prefix_buf);
+        }
+        CHECK_STRING(do_wuffs_nie_decode(
+            &pb, &have, WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+            g_pixel_slice_u8));
+        have = ((wuffs_base__io_buffer){
+            .data = g_have_slice_u8,
+        });
+        CHECK_STRING(do_wuffs_nie_encode(&have, &pb, 0));
+      }
+      CHECK_STRING(check_io_buffers_equal(prefix_buf, &have, &want));
+    }
+  }
+  return NULL;
+}
+
 // ---------------- Mimic Tests
 
 #ifdef WUFFS_MIMIC
@@ -134,6 +303,9 @@ proc g_tests[] = {
 
     test_wuffs_nie_decode_frame_config,
     test_wuffs_nie_decode_interface,
+    test_wuffs_nie_decode_roi,
+    test_wuffs_nie_decode_row_bands,
+    test_wuffs_nie_encode_round_trip,
 
 #ifdef WUFFS_MIMIC
 
@@ -154,6 +154,13 @@ do_wuffs_png_swizzle(uint32_t width,
   dec.private_impl.f_frame_rect_y1 = height;
   dec.private_impl.f_width = width;
   dec.private_impl.f_height = height;
+  dec.private_impl.f_roi_x0 = 0;
+  dec.private_impl.f_roi_y0 = 0;
+  dec.private_impl.f_roi_x1 = width;
+  dec.private_impl.f_roi_y1 = height;
+  dec.private_impl.f_band_y0 = 0;
+  dec.private_impl.f_band_y1 = height;
+  dec.private_impl.f_pass_stop_y = height;
   dec.private_impl.f_pass_bytes_per_row = width;
   dec.private_impl.f_filter_distance = filter_distance;
   wuffs_png__decoder__choose_filter_implementations(&dec);
@@ -194,6 +201,51 @@ test_wuffs_png_decode_interface() {
       "test/data/bricks-gray.png", 0, SIZE_MAX, 160, 120, 0xFF060606);
 }
 
+const char*  //
+test_wuffs_png_decode_stats() {
+  CHECK_FOCUS(__func__);
+  wuffs_png__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_png__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  CHECK_STRING(do_test__wuffs_base__image_decoder(
+      wuffs_png__decoder__upcast_as__wuffs_base__image_decoder(&dec),
+      "test/data/bricks-gray.png", 0, SIZE_MAX, 160, 120, 0xFF060606));
+
+  wuffs_base__stats stats = wuffs_png__decoder__stats(&dec);
+  uint64_t n_rows = 0;
+  uint32_t i;
+  for (i = WUFFS_PNG__DECODER_STATS_FILTER_NONE;
+       i <= WUFFS_PNG__DECODER_STATS_FILTER_PAETH; i++) {
+    n_rows += stats.counters[i];
+  }
+  uint64_t n_bytes = stats.counters[WUFFS_BASE__STATS__FAST_PATH_BYTES] +
+                     stats.counters[WUFFS_BASE__STATS__SLOW_PATH_BYTES];
+
+#if defined(WUFFS_CONFIG__STATS)
+  // bricks-gray.png is 160 × 120, non-interlaced, 8 bits per pixel. Each row
+  // is preceded by a filter byte.
+  const uint64_t want_n_rows = 120;
+  const uint64_t want_n_bytes = 120 * (1 + 160);
+  if (stats.counters[WUFFS_BASE__STATS__TABLE_BUILDS] == 0) {
+    RETURN_FAIL("table builds: have 0, want > 0");
+  }
+#else
+  const uint64_t want_n_rows = 0;
+  const uint64_t want_n_bytes = 0;
+#endif
+
+  if (n_rows != want_n_rows) {
+    RETURN_FAIL("n_rows: have %" PRIu64 ", want %" PRIu64, n_rows,
+                want_n_rows);
+  } else if (n_bytes != want_n_bytes) {
+    RETURN_FAIL("n_bytes: have %" PRIu64 ", want %" PRIu64, n_bytes,
+                want_n_bytes);
+  }
+  return NULL;
+}
+
 const char*  //
 test_wuffs_png_decode_bad_crc32_checksum_critical() {
   CHECK_FOCUS(__func__);
@@ -543,6 +595,152 @@ test_wuffs_png_decode_frame_config() {
   return NULL;
 }
 
+const char*  //
+do_test_wuffs_png_decode_into(wuffs_base__slice_u8 dst,
+                              uint32_t pixfmt,
+                              const char* src_filename,
+                              uint32_t* width,
+                              uint32_t* height,
+                              wuffs_base__decode_frame_options* opts) {
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, src_filename));
+
+  wuffs_png__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_png__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_base__image_config ic = ((wuffs_base__image_config){});
+  CHECK_STATUS("decode_image_config",
+               wuffs_png__decoder__decode_image_config(&dec, &ic, &src));
+  *width = wuffs_base__pixel_config__width(&ic.pixcfg);
+  *height = wuffs_base__pixel_config__height(&ic.pixcfg);
+  if (((uint64_t)(*width) * (uint64_t)(*height) * 8) > dst.len) {
+    return "image dimensions are too large";
+  }
+  wuffs_base__pixel_config__set(&ic.pixcfg, pixfmt,
+                                WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, *width,
+                                *height);
+  wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("set_from_slice",
+               wuffs_base__pixel_buffer__set_from_slice(&pb, &ic.pixcfg, dst));
+  CHECK_STATUS("decode_frame",
+               wuffs_png__decoder__decode_frame(&dec, &pb, &src,
+                                                WUFFS_BASE__PIXEL_BLEND__SRC,
+                                                g_work_slice_u8, opts));
+  return NULL;
+}
+
+const char*  //
+test_wuffs_png_decode_interlace_passes() {
+  CHECK_FOCUS(__func__);
+
+  // Decode the image twice: once as usual (into g_want_slice_u8) and once
+  // reporting and replicating each interlace pass (into g_have_slice_u8).
+  const char* filename = "test/data/hippopotamus.interlaced.png";
+  uint32_t want_w = 0;
+  uint32_t want_h = 0;
+  CHECK_STRING(do_test_wuffs_png_decode_into(
+      g_want_slice_u8, WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL, filename,
+      &want_w, &want_h, NULL));
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, filename));
+
+  wuffs_png__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_png__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_png__decoder__set_quirk_enabled(
+      &dec, WUFFS_PNG__QUIRK_REPLICATE_INTERLACE_PASSES, true);
+  wuffs_base__image_config ic = ((wuffs_base__image_config){});
+  CHECK_STATUS("decode_image_config",
+               wuffs_png__decoder__decode_image_config(&dec, &ic, &src));
+  uint32_t width = wuffs_base__pixel_config__width(&ic.pixcfg);
+  uint32_t height = wuffs_base__pixel_config__height(&ic.pixcfg);
+  if ((width != want_w) || (height != want_h)) {
+    RETURN_FAIL("dimensions: have %" PRIu32 "x%" PRIu32 ", want %" PRIu32
+                "x%" PRIu32,
+                width, height, want_w, want_h);
+  }
+  wuffs_base__pixel_config__set(&ic.pixcfg,
+                                WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+                                WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, width,
+                                height);
+  wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                     &pb, &ic.pixcfg, g_have_slice_u8));
+
+  const uint32_t want_shifts[7][2] = {
+      {3, 3}, {2, 3}, {2, 2}, {1, 2}, {1, 1}, {0, 1}, {0, 0},
+  };
+  uint32_t num_passes = 0;
+  while (true) {
+    wuffs_base__status status = wuffs_png__decoder__decode_frame(
+        &dec, &pb, &src, WUFFS_BASE__PIXEL_BLEND__SRC, g_work_slice_u8, NULL);
+    if (wuffs_base__status__is_ok(&status)) {
+      break;
+    } else if (status.repr != wuffs_png__suspension__interlace_pass_complete) {
+      RETURN_FAIL("decode_frame: \"%s\"", status.repr);
+    } else if (num_passes >= 6) {
+      RETURN_FAIL("decode_frame: too many passes");
+    }
+    num_passes++;
+
+    uint32_t have_n = wuffs_png__decoder__num_completed_interlace_passes(&dec);
+    if (have_n != num_passes) {
+      RETURN_FAIL("num_completed_interlace_passes: have %" PRIu32
+                  ", want %" PRIu32,
+                  have_n, num_passes);
+    }
+    uint32_t xs = want_shifts[num_passes - 1][0];
+    uint32_t ys = want_shifts[num_passes - 1][1];
+    uint32_t have_pw = wuffs_png__decoder__interlace_preview_width(&dec);
+    uint32_t have_ph = wuffs_png__decoder__interlace_preview_height(&dec);
+    uint32_t want_pw = (width + ((1u << xs) - 1)) >> xs;
+    uint32_t want_ph = (height + ((1u << ys) - 1)) >> ys;
+    if ((have_pw != want_pw) || (have_ph != want_ph)) {
+      RETURN_FAIL("pass %" PRIu32 ": preview: have %" PRIu32 "x%" PRIu32
+                  ", want %" PRIu32 "x%" PRIu32,
+                  num_passes, have_pw, have_ph, want_pw, want_ph);
+    }
+
+    // Every pixel should match its block's top-left pixel, which should match
+    // the fully decoded image.
+    uint32_t y;
+    for (y = 0; y < height; y++) {
+      uint32_t x;
+      for (x = 0; x < width; x++) {
+        size_t i = 4 * (((size_t)y * width) + x);
+        size_t j = 4 * (((size_t)(y & (0xFFFFFFFFu << ys)) * width) +
+                        (x & (0xFFFFFFFFu << xs)));
+        if (memcmp(g_have_slice_u8.ptr + i, g_want_slice_u8.ptr + j, 4)) {
+          RETURN_FAIL("pass %" PRIu32 ": pixel (%" PRIu32 ", %" PRIu32
+                      ") differs",
+                      num_passes, x, y);
+        }
+      }
+    }
+  }
+
+  if (num_passes != 6) {
+    RETURN_FAIL("num_passes: have %" PRIu32 ", want 6", num_passes);
+  } else if (wuffs_png__decoder__num_completed_interlace_passes(&dec) != 7) {
+    RETURN_FAIL("num_completed_interlace_passes: have %" PRIu32 ", want 7",
+                wuffs_png__decoder__num_completed_interlace_passes(&dec));
+  }
+  if (memcmp(g_have_slice_u8.ptr, g_want_slice_u8.ptr,
+             (size_t)width * (size_t)height * 4)) {
+    RETURN_FAIL("final image differs");
+  }
+  return NULL;
+}
+
 const char*  //
 test_wuffs_png_decode_metadata_chrm_gama_srgb() {
   CHECK_FOCUS(__func__);
@@ -873,6 +1071,142 @@ test_wuffs_png_decode_metadata_kvp() {
   return NULL;
 }
 
+const char*  //
+test_wuffs_png_decode_rgba_bgra_premul() {
+  CHECK_FOCUS(__func__);
+
+  // Decoding a non-interlaced 8-bit RGBA image to BGRA_PREMUL takes the
+  // specialized filter_and_swizzle_rgba_bgra_premul path. Check it against
+  // decoding to BGRA_NONPREMUL (the default path) and then premultiplying.
+  const char* filename = "test/data/hippopotamus.masked-with-muybridge.png";
+  uint32_t have_w = 0;
+  uint32_t have_h = 0;
+  CHECK_STRING(do_test_wuffs_png_decode_into(
+      g_have_slice_u8, WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL, filename, &have_w,
+      &have_h, NULL));
+  uint32_t want_w = 0;
+  uint32_t want_h = 0;
+  CHECK_STRING(do_test_wuffs_png_decode_into(
+      g_want_slice_u8, WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL, filename,
+      &want_w, &want_h, NULL));
+  if ((have_w != want_w) || (have_h != want_h)) {
+    RETURN_FAIL("dimensions: have %" PRIu32 "x%" PRIu32 ", want %" PRIu32
+                "x%" PRIu32,
+                have_w, have_h, want_w, want_h);
+  }
+
+  size_t n = (size_t)want_w * (size_t)want_h;
+  size_t i;
+  for (i = 0; i < n; i++) {
+    uint32_t have = wuffs_base__peek_u32le__no_bounds_check(
+        g_have_slice_u8.ptr + (4 * i));
+    uint32_t want =
+        wuffs_base__color_u32_argb_nonpremul__as__color_u32_argb_premul(
+            wuffs_base__peek_u32le__no_bounds_check(g_want_slice_u8.ptr +
+                                                    (4 * i)));
+    if (have != want) {
+      RETURN_FAIL("pixel #%zu: have 0x%08" PRIX32 ", want 0x%08" PRIX32, i,
+                  have, want);
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+do_test_wuffs_png_decode_16_bit_depth() {
+  // Non-interlaced 16-bit gray-alpha, RGB and RGBA images (without a tRNS
+  // chunk) take the swizzle_interleaved_from_u16be_slice path. 16-bit gray
+  // images are swizzled from the Y_16BE pixel format instead.
+  //
+  // The want values are the CRC-32 checksums of the decoded pixels, computed
+  // independently of Wuffs: narrowing from 16 to 8 bits keeps the high byte
+  // and premultiplication is as per
+  // wuffs_base__color_u64_argb_nonpremul__as__color_u32_argb_premul.
+  struct {
+    const char* filename;
+    uint32_t pixfmt;
+    uint32_t want;
+  } test_cases[] = {
+      {"test/data/artificial-png/random.16bit.gray.png",
+       WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE, 0x7C54E070},
+      {"test/data/artificial-png/random.16bit.gray.png",
+       WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL, 0x01E069AF},
+      {"test/data/artificial-png/random.16bit.gray.png",
+       WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL, 0x01E069AF},
+      {"test/data/artificial-png/random.16bit.gray.png",
+       WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL, 0x01E069AF},
+      {"test/data/artificial-png/random.16bit.gray-alpha.png",
+       WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE, 0x798BB67F},
+      {"test/data/artificial-png/random.16bit.gray-alpha.png",
+       WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL, 0x9D820F1E},
+      {"test/data/artificial-png/random.16bit.gray-alpha.png",
+       WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL, 0x9307A3C9},
+      {"test/data/artificial-png/random.16bit.gray-alpha.png",
+       WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL, 0x9D820F1E},
+      {"test/data/artificial-png/random.16bit.rgb.png",
+       WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE, 0x1F352DE7},
+      {"test/data/artificial-png/random.16bit.rgb.png",
+       WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL, 0x7B349948},
+      {"test/data/artificial-png/random.16bit.rgb.png",
+       WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL, 0x7B349948},
+      {"test/data/artificial-png/random.16bit.rgb.png",
+       WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL, 0xA031FF73},
+      {"test/data/artificial-png/random.16bit.rgba.png",
+       WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE, 0xABCEF77A},
+      {"test/data/artificial-png/random.16bit.rgba.png",
+       WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL, 0x66925080},
+      {"test/data/artificial-png/random.16bit.rgba.png",
+       WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL, 0xC617EBE7},
+      {"test/data/artificial-png/random.16bit.rgba.png",
+       WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL, 0x6797B979},
+  };
+
+  // Decode with SIMD (if available) and without.
+  uint32_t disableds[] = {
+      0,
+      WUFFS_BASE__CPU_ARCH__FEATURE__ALL,
+  };
+  for (size_t d = 0; d < WUFFS_TESTLIB_ARRAY_SIZE(disableds); d++) {
+    wuffs_base__cpu_arch__set_disabled_features(disableds[d]);
+    for (size_t tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(test_cases); tc++) {
+      uint32_t width = 0;
+      uint32_t height = 0;
+      CHECK_STRING(do_test_wuffs_png_decode_into(
+          g_have_slice_u8, test_cases[tc].pixfmt, test_cases[tc].filename,
+          &width, &height, NULL));
+      size_t bytes_per_pixel =
+          (test_cases[tc].pixfmt ==
+           WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE)
+              ? 8
+              : 4;
+
+      wuffs_crc32__ieee_hasher hasher;
+      CHECK_STATUS("initialize",
+                   wuffs_crc32__ieee_hasher__initialize(
+                       &hasher, sizeof hasher, WUFFS_VERSION,
+                       WUFFS_INITIALIZE__DEFAULT_OPTIONS));
+      uint32_t have = wuffs_crc32__ieee_hasher__update_u32(
+          &hasher, wuffs_base__make_slice_u8(
+                       g_have_slice_u8.ptr,
+                       (size_t)width * (size_t)height * bytes_per_pixel));
+      if (have != test_cases[tc].want) {
+        RETURN_FAIL("d=%zu, tc=%zu: have 0x%08" PRIX32 ", want 0x%08" PRIX32,
+                    d, tc, have, test_cases[tc].want);
+      }
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_png_decode_16_bit_depth() {
+  CHECK_FOCUS(__func__);
+  const char* ret = do_test_wuffs_png_decode_16_bit_depth();
+  wuffs_base__cpu_arch__set_disabled_features(
+      g_flags.nosimd ? WUFFS_BASE__CPU_ARCH__FEATURE__ALL : 0);
+  return ret;
+}
+
 const char*  //
 test_wuffs_png_decode_restart_frame() {
   CHECK_FOCUS(__func__);
@@ -932,6 +1266,868 @@ test_wuffs_png_decode_restart_frame() {
   return NULL;
 }
 
+const char*  //
+test_wuffs_png_decode_animated_restart_frame() {
+  CHECK_FOCUS(__func__);
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, "test/data/animated-red-blue.apng"));
+
+  wuffs_png__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_png__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+
+  wuffs_base__image_config ic = ((wuffs_base__image_config){});
+  CHECK_STATUS("decode_image_config",
+               wuffs_png__decoder__decode_image_config(&dec, &ic, &src));
+  wuffs_base__pixel_config__set(
+      &ic.pixcfg, WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+      WUFFS_BASE__PIXEL_SUBSAMPLING__NONE,
+      wuffs_base__pixel_config__width(&ic.pixcfg),
+      wuffs_base__pixel_config__height(&ic.pixcfg));
+  wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                     &pb, &ic.pixcfg, g_pixel_slice_u8));
+  wuffs_base__table_u8 tab = wuffs_base__pixel_buffer__plane(&pb, 0);
+
+  // Decode every frame once, recording each frame's I/O position and a
+  // checksum of the pixels within its frame rectangle. Decoding again, after
+  // restart_frame, should reproduce them.
+  uint64_t io_positions[4] = {0};
+  uint32_t checksums[4] = {0};
+  for (int i = -1; i < 4; i++) {
+    if (i >= 0) {
+      CHECK_STATUS("restart_frame", wuffs_png__decoder__restart_frame(
+                                        &dec, i, io_positions[i]));
+      src.meta.ri = io_positions[i];
+    }
+
+    int j = (i >= 0) ? i : 0;
+    for (; j < 4; j++) {
+      wuffs_base__frame_config fc = ((wuffs_base__frame_config){});
+      wuffs_base__status status =
+          wuffs_png__decoder__decode_frame_config(&dec, &fc, &src);
+      if (!wuffs_base__status__is_ok(&status)) {
+        RETURN_FAIL("decode_frame_config #%d, #%d: %s", i, j, status.repr);
+      }
+      if (wuffs_base__frame_config__index(&fc) != (uint64_t)j) {
+        RETURN_FAIL("index #%d, #%d: have %" PRIu64, i, j,
+                    wuffs_base__frame_config__index(&fc));
+      }
+      if (i < 0) {
+        io_positions[j] = wuffs_base__frame_config__io_position(&fc);
+      } else if (io_positions[j] != wuffs_base__frame_config__io_position(&fc)) {
+        RETURN_FAIL("io_position #%d, #%d: have %" PRIu64 ", want %" PRIu64, i,
+                    j, wuffs_base__frame_config__io_position(&fc),
+                    io_positions[j]);
+      }
+
+      status = wuffs_png__decoder__decode_frame(&dec, &pb, &src,
+                                                WUFFS_BASE__PIXEL_BLEND__SRC,
+                                                g_work_slice_u8, NULL);
+      if (!wuffs_base__status__is_ok(&status)) {
+        RETURN_FAIL("decode_frame #%d, #%d: %s", i, j, status.repr);
+      }
+      if (wuffs_png__decoder__num_decoded_frames(&dec) != (uint64_t)(j + 1)) {
+        RETURN_FAIL("num_decoded_frames #%d, #%d: have %" PRIu64, i, j,
+                    wuffs_png__decoder__num_decoded_frames(&dec));
+      }
+
+      wuffs_base__rect_ie_u32 r = wuffs_base__frame_config__bounds(&fc);
+      uint32_t checksum = 0;
+      for (uint32_t y = r.min_incl_y; y < r.max_excl_y; y++) {
+        for (size_t x = 4 * r.min_incl_x; x < 4 * r.max_excl_x; x++) {
+          checksum = (checksum * 31) + tab.ptr[(y * tab.stride) + x];
+        }
+      }
+      if (i < 0) {
+        checksums[j] = checksum;
+      } else if (checksums[j] != checksum) {
+        RETURN_FAIL("checksum #%d, #%d: have 0x%08" PRIX32
+                    ", want 0x%08" PRIX32,
+                    i, j, checksum, checksums[j]);
+      }
+    }
+
+    wuffs_base__status status =
+        wuffs_png__decoder__decode_frame_config(&dec, NULL, &src);
+    if (status.repr != wuffs_base__note__end_of_data) {
+      RETURN_FAIL("decode_frame_config #%d: have \"%s\", want \"%s\"", i,
+                  status.repr, wuffs_base__note__end_of_data);
+    }
+  }
+
+  return NULL;
+}
+
+const char*  //
+test_wuffs_png_decode_color_conversion() {
+  CHECK_FOCUS(__func__);
+
+  // Per-channel tables, which are not the identity.
+  uint8_t table_u8[3 * 256];
+  uint16_t table_u16[3 * 4096];
+  for (uint32_t c = 0; c < 3; c++) {
+    for (uint32_t v = 0; v < 256; v++) {
+      table_u8[(256 * c) + v] = (uint8_t)((v * (c + 3)) ^ 0xA5);
+    }
+    for (uint32_t v = 0; v < 4096; v++) {
+      table_u16[(4096 * c) + v] = (uint16_t)((v * (c + 3)) ^ 0x5A5A);
+    }
+  }
+  wuffs_base__color_conversion tables =
+      wuffs_base__make_color_conversion_tables(table_u8, table_u16);
+
+  // A matrix that swaps Red and Blue, with (approximately) identity
+  // linearization.
+  uint16_t linearize_u16[256];
+  uint8_t delinearize_u8[4096];
+  for (uint32_t v = 0; v < 256; v++) {
+    linearize_u16[v] = (uint16_t)(v * 0x101);
+  }
+  for (uint32_t v = 0; v < 4096; v++) {
+    delinearize_u8[v] = (uint8_t)(((v * 255) + 2047) / 4095);
+  }
+  const int32_t swap_red_blue[9] = {
+      0x00000, 0x00000, 0x10000,  //
+      0x00000, 0x10000, 0x00000,  //
+      0x10000, 0x00000, 0x00000,  //
+  };
+  wuffs_base__color_conversion matrix =
+      wuffs_base__make_color_conversion_matrix(linearize_u16, swap_red_blue,
+                                               delinearize_u8);
+
+  // These cover the filter_and_swizzle default, BGRA_PREMUL specialization
+  // and tricky (interlaced or low bit depth) implementations.
+  const char* filenames[4] = {
+      "test/data/bricks-color.png",
+      "test/data/hippopotamus.interlaced.png",
+      "test/data/hippopotamus.masked-with-muybridge.png",
+      "test/data/pjw-thumbnail.png",
+  };
+
+  for (int i = 0; i < 4; i++) {
+    uint32_t w = 0;
+    uint32_t h = 0;
+    CHECK_STRING(do_test_wuffs_png_decode_into(
+        g_want_slice_u8, WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE,
+        filenames[i], &w, &h, NULL));
+    size_t n = (size_t)w * (size_t)h;
+
+    // Check the 16 bits per channel tables.
+    wuffs_base__decode_frame_options opts =
+        wuffs_base__null_decode_frame_options();
+    wuffs_base__decode_frame_options__set_color_conversion(&opts, &tables);
+    CHECK_STRING(do_test_wuffs_png_decode_into(
+        g_have_slice_u8, WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE,
+        filenames[i], &w, &h, &opts));
+    for (size_t j = 0; j < (4 * n); j++) {
+      uint16_t have = wuffs_base__peek_u16le__no_bounds_check(
+          g_have_slice_u8.ptr + (2 * j));
+      uint16_t want = wuffs_base__peek_u16le__no_bounds_check(
+          g_want_slice_u8.ptr + (2 * j));
+      if ((j & 3) < 3) {
+        want = table_u16[(4096 * (j & 3)) + (want >> 4)];
+      }
+      if (have != want) {
+        RETURN_FAIL("%s: 16-bit tables: channel #%zu: have 0x%04" PRIX16
+                    ", want 0x%04" PRIX16,
+                    filenames[i], j, have, want);
+      }
+    }
+
+    // Check the 8 bits per channel tables, for a premultiplied alpha
+    // destination. Partially transparent pixels are un-premultiplied,
+    // converted and re-premultiplied.
+    CHECK_STRING(do_test_wuffs_png_decode_into(
+        g_want_slice_u8, WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL, filenames[i],
+        &w, &h, NULL));
+    CHECK_STRING(do_test_wuffs_png_decode_into(
+        g_have_slice_u8, WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL, filenames[i],
+        &w, &h, &opts));
+    for (size_t j = 0; j < n; j++) {
+      uint8_t* have = g_have_slice_u8.ptr + (4 * j);
+      uint8_t* want = g_want_slice_u8.ptr + (4 * j);
+      uint32_t a = want[3];
+      for (uint32_t c = 0; c < 4; c++) {
+        uint32_t wc = want[c];
+        if ((c < 3) && (a == 0xFF)) {
+          wc = table_u8[(256 * c) + wc];
+        } else if ((c < 3) && (a > 0)) {
+          uint32_t u = ((wc * 0xFF) + (a / 2)) / a;
+          u = (u < 0xFF) ? u : 0xFF;
+          wc = ((table_u8[(256 * c) + u] * a) + 0x7F) / 0xFF;
+        }
+        if (have[c] != wc) {
+          RETURN_FAIL("%s: 8-bit tables: pixel #%zu channel #%" PRIu32
+                      ": have 0x%02" PRIX8 ", want 0x%02" PRIX32,
+                      filenames[i], j, c, have[c], wc);
+        }
+      }
+    }
+
+    // Check the matrix, for a 3 bytes per pixel destination.
+    CHECK_STRING(do_test_wuffs_png_decode_into(
+        g_want_slice_u8, WUFFS_BASE__PIXEL_FORMAT__BGR, filenames[i], &w, &h,
+        NULL));
+    wuffs_base__decode_frame_options__set_color_conversion(&opts, &matrix);
+    CHECK_STRING(do_test_wuffs_png_decode_into(
+        g_have_slice_u8, WUFFS_BASE__PIXEL_FORMAT__BGR, filenames[i], &w, &h,
+        &opts));
+    for (size_t j = 0; j < n; j++) {
+      uint8_t* have = g_have_slice_u8.ptr + (3 * j);
+      uint8_t* want = g_want_slice_u8.ptr + (3 * j);
+      for (uint32_t c = 0; c < 3; c++) {
+        uint8_t wc = delinearize_u8[linearize_u16[want[2 - c]] >> 4];
+        if (have[c] != wc) {
+          RETURN_FAIL("%s: matrix: pixel #%zu channel #%" PRIu32
+                      ": have 0x%02" PRIX8 ", want 0x%02" PRIX8,
+                      filenames[i], j, c, have[c], wc);
+        }
+      }
+    }
+  }
+
+  // The matrix does not support 16 bits per channel.
+  wuffs_base__decode_frame_options opts =
+      wuffs_base__null_decode_frame_options();
+  wuffs_base__decode_frame_options__set_color_conversion(&opts, &matrix);
+  uint32_t w = 0;
+  uint32_t h = 0;
+  const char* have = do_test_wuffs_png_decode_into(
+      g_have_slice_u8, WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE,
+      filenames[0], &w, &h, &opts);
+  if (!have ||
+      !strstr(have, wuffs_base__error__unsupported_pixel_swizzler_option)) {
+    RETURN_FAIL("16-bit matrix: have \"%s\", want \"%s\"",
+                have ? have : "(null)",
+                wuffs_base__error__unsupported_pixel_swizzler_option);
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_png_decode_roi() {
+  CHECK_FOCUS(__func__);
+
+  // These cover both the filter_and_swizzle default and tricky (interlaced or
+  // low bit depth) implementations.
+  const char* filenames[4] = {
+      "test/data/bricks-color.png",
+      "test/data/hippopotamus.interlaced.png",
+      "test/data/hippopotamus.masked-with-muybridge.png",
+      "test/data/pjw-thumbnail.png",
+  };
+
+  int i;
+  for (i = 0; i < 4; i++) {
+    wuffs_png__decoder full_dec;
+    CHECK_STATUS("initialize",
+                 wuffs_png__decoder__initialize(
+                     &full_dec, sizeof full_dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_png__decoder roi_dec;
+    CHECK_STATUS("initialize",
+                 wuffs_png__decoder__initialize(
+                     &roi_dec, sizeof roi_dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    CHECK_STRING(do_test__wuffs_base__image_decoder_roi(
+        wuffs_png__decoder__upcast_as__wuffs_base__image_decoder(&full_dec),
+        wuffs_png__decoder__upcast_as__wuffs_base__image_decoder(&roi_dec),
+        filenames[i], wuffs_base__make_rect_ie_u32(5, 3, 29, 1000), 99));
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_png_decode_downscale() {
+  CHECK_FOCUS(__func__);
+
+  // These cover both the filter_and_swizzle default and tricky (low bit depth
+  // or with an alpha channel) implementations.
+  const char* filenames[3] = {
+      "test/data/bricks-color.png",
+      "test/data/hippopotamus.masked-with-muybridge.png",
+      "test/data/pjw-thumbnail.png",
+  };
+
+  int i;
+  for (i = 0; i < 3; i++) {
+    uint32_t shift;
+    for (shift = 1; shift <= 3; shift++) {
+      wuffs_png__decoder full_dec;
+      CHECK_STATUS("initialize",
+                   wuffs_png__decoder__initialize(
+                       &full_dec, sizeof full_dec, WUFFS_VERSION,
+                       WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+      wuffs_png__decoder ds_dec;
+      CHECK_STATUS("initialize",
+                   wuffs_png__decoder__initialize(
+                       &ds_dec, sizeof ds_dec, WUFFS_VERSION,
+                       WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+      CHECK_STRING(do_test__wuffs_base__image_decoder_downscale(
+          wuffs_png__decoder__upcast_as__wuffs_base__image_decoder(&full_dec),
+          wuffs_png__decoder__upcast_as__wuffs_base__image_decoder(&ds_dec),
+          filenames[i], wuffs_base__make_rect_ie_u32(5, 3, 1000, 1000), shift,
+          99));
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_png_decode_row_bands() {
+  CHECK_FOCUS(__func__);
+
+  // These cover both the filter_and_swizzle default and tricky (low bit depth
+  // or with an alpha channel) implementations. Interlaced images do not
+  // support row bands.
+  const char* filenames[3] = {
+      "test/data/bricks-color.png",
+      "test/data/hippopotamus.masked-with-muybridge.png",
+      "test/data/pjw-thumbnail.png",
+  };
+  const uint32_t band_heights[3] = {1, 7, 1000};
+
+  int i;
+  for (i = 0; i < 3; i++) {
+    int j;
+    for (j = 0; j < 3; j++) {
+      wuffs_png__decoder full_dec;
+      CHECK_STATUS("initialize",
+                   wuffs_png__decoder__initialize(
+                       &full_dec, sizeof full_dec, WUFFS_VERSION,
+                       WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+      wuffs_png__decoder band_dec;
+      CHECK_STATUS("initialize",
+                   wuffs_png__decoder__initialize(
+                       &band_dec, sizeof band_dec, WUFFS_VERSION,
+                       WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+      CHECK_STRING(do_test__wuffs_base__image_decoder_row_bands(
+          wuffs_png__decoder__upcast_as__wuffs_base__image_decoder(&full_dec),
+          wuffs_png__decoder__upcast_as__wuffs_base__image_decoder(&band_dec),
+          filenames[i], wuffs_base__make_rect_ie_u32(5, 3, 29, 1000), band_heights[j],
+          99));
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_png_decode_workbuf_prefilled() {
+  CHECK_FOCUS(__func__);
+
+  const char* filenames[2] = {
+      "test/data/hat.png",
+      "test/data/hippopotamus.interlaced.png",
+  };
+
+  for (int tc = 0; tc < 2; tc++) {
+    wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+        .data = g_src_slice_u8,
+    });
+    CHECK_STRING(read_file(&src, filenames[tc]));
+
+    // Concatenate the IDAT chunks' payloads (a zlib stream) into have.
+    wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+        .data = g_have_slice_u8,
+    });
+    bool interlaced = false;
+    for (size_t i = 8; (i + 12) <= src.meta.wi;) {
+      uint32_t chunk_length = wuffs_base__peek_u32be__no_bounds_check(
+          src.data.ptr + i + 0);
+      uint32_t chunk_type = wuffs_base__peek_u32be__no_bounds_check(
+          src.data.ptr + i + 4);
+      if (chunk_length > (src.meta.wi - i - 12)) {
+        RETURN_FAIL("tc=%d: truncated chunk", tc);
+      } else if (chunk_type == 0x49484452) {  // "IHDR"
+        interlaced = src.data.ptr[i + 20] != 0;
+      } else if (chunk_type == 0x49444154) {  // "IDAT"
+        memcpy(have.data.ptr + have.meta.wi, src.data.ptr + i + 8,
+               chunk_length);
+        have.meta.wi += chunk_length;
+      }
+      i += 12 + chunk_length;
+    }
+    have.meta.closed = true;
+
+    for (int prefilled = 0; prefilled < 2; prefilled++) {
+      src.meta.ri = 0;
+
+      wuffs_png__decoder dec;
+      CHECK_STATUS("initialize",
+                   wuffs_png__decoder__initialize(
+                       &dec, sizeof dec, WUFFS_VERSION,
+                       WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+      wuffs_png__decoder__set_workbuf_prefilled(&dec, prefilled);
+
+      wuffs_base__image_config ic = ((wuffs_base__image_config){});
+      CHECK_STATUS("decode_image_config",
+                   wuffs_png__decoder__decode_image_config(&dec, &ic, &src));
+      uint64_t workbuf_len =
+          wuffs_png__decoder__workbuf_len(&dec).max_incl;
+      // The PNG decoder's workbuf is followed by the zlib decoder's.
+      const uint64_t zlib_workbuf_len =
+          WUFFS_ZLIB__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE;
+      if (workbuf_len > (g_work_slice_u8.len - zlib_workbuf_len)) {
+        RETURN_FAIL("tc=%d: workbuf_len is too large", tc);
+      }
+      wuffs_base__slice_u8 workbuf =
+          wuffs_base__make_slice_u8(g_work_slice_u8.ptr, workbuf_len);
+
+      if (prefilled) {
+        // Interlaced frames ignore the prefilled workbuf, so give them
+        // garbage. Non-interlaced frames get the decompressed IDAT data.
+        memset(workbuf.ptr, 0xAA, workbuf.len);
+        if (!interlaced) {
+          have.meta.ri = 0;
+          wuffs_base__io_buffer dst =
+              wuffs_base__ptr_u8__writer(workbuf.ptr, workbuf.len);
+          wuffs_zlib__decoder zdec;
+          CHECK_STATUS("initialize",
+                       wuffs_zlib__decoder__initialize(
+                           &zdec, sizeof zdec, WUFFS_VERSION,
+                           WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+          CHECK_STATUS("transform_io",
+                       wuffs_zlib__decoder__transform_io(
+                           &zdec, &dst, &have,
+                           wuffs_base__make_slice_u8(workbuf.ptr + workbuf.len,
+                                                     zlib_workbuf_len)));
+          if (dst.meta.wi != workbuf.len) {
+            RETURN_FAIL("tc=%d: inflated length: have %zu, want %zu", tc,
+                        dst.meta.wi, workbuf.len);
+          }
+        }
+      }
+
+      wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+      CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                         &pb, &ic.pixcfg, g_pixel_slice_u8));
+      wuffs_base__status status = wuffs_png__decoder__decode_frame(
+          &dec, &pb, &src, WUFFS_BASE__PIXEL_BLEND__SRC, workbuf, NULL);
+      if (!wuffs_base__status__is_ok(&status)) {
+        RETURN_FAIL("tc=%d, prefilled=%d: decode_frame: %s", tc, prefilled,
+                    status.repr);
+      }
+
+      uint64_t n = wuffs_base__pixel_config__pixbuf_len(&ic.pixcfg);
+      if (!prefilled) {
+        memcpy(g_want_slice_u8.ptr, g_pixel_slice_u8.ptr, n);
+        continue;
+      }
+      wuffs_base__io_buffer have_pixels =
+          wuffs_base__ptr_u8__reader(g_pixel_slice_u8.ptr, n, true);
+      wuffs_base__io_buffer want_pixels =
+          wuffs_base__ptr_u8__reader(g_want_slice_u8.ptr, n, true);
+      char prefix_buf[256];
+      sprintf(prefix_buf, "tc=%d ", tc);
+      CHECK_STRING(
+          check_io_buffers_equal(prefix_buf, &have_pixels, &want_pixels));
+    }
+  }
+
+  return NULL;
+}
+
+const char*  //
+test_wuffs_png_decode_workbuf_streaming() {
+  CHECK_FOCUS(__func__);
+
+  // These cover the filter_and_swizzle default, tricky and BGRA_PREMUL
+  // implementations. Interlaced images do not stream (their minimum
+  // workbuf_len is the maximum) and do not support row bands or downscaling.
+  const char* filenames[4] = {
+      "test/data/bricks-color.png",
+      "test/data/hippopotamus.interlaced.png",
+      "test/data/hippopotamus.masked-with-muybridge.png",
+      "test/data/pjw-thumbnail.png",
+  };
+
+  // Each test case decodes with the maximum workbuf_len (into g_want) and then
+  // with the minimum workbuf_len (into g_have), feeding that second decoder
+  // 99 bytes of src at a time. Test case 1 also decodes in row bands and test
+  // case 2 also downscales.
+  for (int i = 0; i < 4; i++) {
+    bool interlaced = i == 1;
+    for (int tc = 0; tc < (interlaced ? 1 : 3); tc++) {
+      wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+          .data = g_src_slice_u8,
+      });
+      CHECK_STRING(read_file(&src, filenames[i]));
+      const size_t src_wi = src.meta.wi;
+      const uint32_t band_height = (tc == 1) ? 7 : 0;
+      const uint32_t shift = (tc == 2) ? 1 : 0;
+
+      for (int streaming = 0; streaming < 2; streaming++) {
+        src.meta.ri = 0;
+        src.meta.wi = src_wi;
+        src.meta.closed = true;
+
+        wuffs_png__decoder dec;
+        CHECK_STATUS("initialize",
+                     wuffs_png__decoder__initialize(
+                         &dec, sizeof dec, WUFFS_VERSION,
+                         WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+        wuffs_base__image_config ic = ((wuffs_base__image_config){});
+        CHECK_STATUS("decode_image_config",
+                     wuffs_png__decoder__decode_image_config(&dec, &ic, &src));
+        uint32_t width = wuffs_base__pixel_config__width(&ic.pixcfg);
+        uint32_t bias = (((uint32_t)1) << shift) - 1;
+        uint32_t pb_width = (width + bias) >> shift;
+        uint32_t full_pb_height =
+            (wuffs_base__pixel_config__height(&ic.pixcfg) + bias) >> shift;
+        uint32_t pb_height = full_pb_height;
+        if (streaming && (band_height > 0) && (band_height < pb_height)) {
+          pb_height = band_height;
+        }
+        wuffs_base__pixel_config__set(
+            &ic.pixcfg, WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+            WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, pb_width, pb_height);
+        wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+        CHECK_STATUS("set_from_slice",
+                     wuffs_base__pixel_buffer__set_from_slice(
+                         &pb, &ic.pixcfg,
+                         streaming ? g_have_slice_u8 : g_want_slice_u8));
+
+        wuffs_base__decode_frame_options opts =
+            wuffs_base__null_decode_frame_options();
+        wuffs_base__decode_frame_options__set_downscale_shift(&opts, shift);
+        wuffs_base__decode_frame_options__set_row_band_height(
+            &opts, streaming ? band_height : 0);
+
+        wuffs_base__range_ii_u64 range = wuffs_png__decoder__workbuf_len(&dec);
+        if (interlaced ? (range.min_incl != range.max_incl)
+                       : (range.min_incl >= range.max_incl)) {
+          RETURN_FAIL("i=%d: workbuf_len: min %" PRIu64 ", max %" PRIu64, i,
+                      range.min_incl, range.max_incl);
+        }
+        uint64_t workbuf_len =
+            (streaming ? range.min_incl : range.max_incl) +
+            wuffs_base__decode_frame_options__downscale_workbuf_len(&opts,
+                                                                    width);
+        if (workbuf_len > g_work_slice_u8.len) {
+          RETURN_FAIL("i=%d: workbuf_len is too large", i);
+        }
+        wuffs_base__slice_u8 workbuf =
+            wuffs_base__make_slice_u8(g_work_slice_u8.ptr, workbuf_len);
+
+        if (streaming) {
+          src.meta.wi = src.meta.ri;
+          src.meta.closed = false;
+        }
+        uint32_t band_y0 = 0;
+        while (true) {
+          if (streaming) {
+            src.meta.wi = ((src_wi - src.meta.wi) > 99) ? (src.meta.wi + 99)
+                                                         : src_wi;
+            src.meta.closed = src.meta.wi == src_wi;
+          }
+          wuffs_base__status status = wuffs_png__decoder__decode_frame(
+              &dec, &pb, &src, WUFFS_BASE__PIXEL_BLEND__SRC, workbuf, &opts);
+          if ((status.repr == wuffs_base__suspension__short_read) &&
+              !src.meta.closed) {
+            continue;
+          } else if (!wuffs_base__status__is_ok(&status) &&
+                     (status.repr != wuffs_base__suspension__short_write)) {
+            RETURN_FAIL("i=%d, tc=%d, streaming=%d: decode_frame: %s", i, tc,
+                        streaming, status.repr);
+          } else if (!streaming) {
+            break;
+          }
+
+          // Compare the band (or, without row bands, the whole image).
+          uint32_t num_rows = full_pb_height - band_y0;
+          num_rows = (num_rows < pb_height) ? num_rows : pb_height;
+          size_t n = (size_t)num_rows * pb_width * 4;
+          wuffs_base__io_buffer have_pixels =
+              wuffs_base__ptr_u8__reader(g_have_slice_u8.ptr, n, true);
+          wuffs_base__io_buffer want_pixels = wuffs_base__ptr_u8__reader(
+              g_want_slice_u8.ptr + ((size_t)band_y0 * pb_width * 4), n, true);
+          char prefix_buf[256];
+          sprintf(prefix_buf, "i=%d, tc=%d, band_y0=%" PRIu32 ": ", i, tc,
+                  band_y0);
+          CHECK_STRING(
+              check_io_buffers_equal(prefix_buf, &have_pixels, &want_pixels));
+          band_y0 += num_rows;
+          if (wuffs_base__status__is_ok(&status)) {
+            break;
+          }
+        }
+        if (streaming && (band_y0 != full_pb_height)) {
+          RETURN_FAIL("i=%d, tc=%d: band_y0: have %" PRIu32 ", want %" PRIu32,
+                      i, tc, band_y0, full_pb_height);
+        }
+      }
+    }
+  }
+
+  return NULL;
+}
+
+// --------
+
+// do_wuffs_png_decode_to_pixbuf decodes the PNG image in src to pixels. A
+// zero pixfmt_repr means to use the image's own pixel format.
+const char*  //
+do_wuffs_png_decode_to_pixbuf(wuffs_base__pixel_buffer* pb,
+                              wuffs_base__io_buffer* src,
+                              uint32_t pixfmt_repr,
+                              wuffs_base__slice_u8 pixels) {
+  wuffs_png__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_png__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_base__image_config ic = ((wuffs_base__image_config){});
+  CHECK_STATUS("decode_image_config",
+               wuffs_png__decoder__decode_image_config(&dec, &ic, src));
+  if (pixfmt_repr != 0) {
+    wuffs_base__pixel_config__set(
+        &ic.pixcfg, pixfmt_repr, WUFFS_BASE__PIXEL_SUBSAMPLING__NONE,
+        wuffs_base__pixel_config__width(&ic.pixcfg),
+        wuffs_base__pixel_config__height(&ic.pixcfg));
+  }
+  CHECK_STATUS("set_from_slice",
+               wuffs_base__pixel_buffer__set_from_slice(pb, &ic.pixcfg, pixels));
+  uint64_t workbuf_len = wuffs_png__decoder__workbuf_len(&dec).max_incl;
+  if (workbuf_len > g_work_slice_u8.len) {
+    return "workbuf_len is too large";
+  }
+  CHECK_STATUS("decode_frame",
+               wuffs_png__decoder__decode_frame(
+                   &dec, pb, src, WUFFS_BASE__PIXEL_BLEND__SRC,
+                   wuffs_base__make_slice_u8(g_work_slice_u8.ptr, workbuf_len),
+                   NULL));
+  return NULL;
+}
+
+// do_wuffs_png_encode encodes src to dst, which must be empty. A non-zero
+// max_write_length limits how much the encoder can write per encode_image
+// call, exercising its suspend and resume paths.
+const char*  //
+do_wuffs_png_encode(wuffs_base__io_buffer* dst,
+                    wuffs_png__encoder* enc,
+                    wuffs_base__pixel_buffer* src,
+                    wuffs_base__slice_u8 workbuf,
+                    size_t max_write_length) {
+  if (max_write_length == 0) {
+    CHECK_STATUS("encode_image",
+                 wuffs_png__encoder__encode_image(enc, dst, src, workbuf));
+    return NULL;
+  }
+  while (true) {
+    wuffs_base__io_buffer limited = *dst;
+    if (limited.data.len > (limited.meta.wi + max_write_length)) {
+      limited.data.len = limited.meta.wi + max_write_length;
+    }
+    wuffs_base__status status =
+        wuffs_png__encoder__encode_image(enc, &limited, src, workbuf);
+    dst->meta.wi = limited.meta.wi;
+    if (wuffs_base__status__is_ok(&status)) {
+      return NULL;
+    } else if ((status.repr != wuffs_base__suspension__short_write) ||
+               (dst->meta.wi == dst->data.len)) {
+      return wuffs_base__status__message(&status);
+    }
+  }
+}
+
+// do_test_wuffs_png_encode_check compares the BGRA_NONPREMUL decodings of the
+// encoded PNG image in have and of the pixels in want.
+const char*  //
+do_test_wuffs_png_encode_check(wuffs_base__io_buffer* have,
+                               wuffs_base__slice_u8 want,
+                               const char* prefix) {
+  wuffs_base__slice_u8 pixels = wuffs_base__make_slice_u8(
+      g_pixel_slice_u8.ptr + (g_pixel_slice_u8.len / 2),
+      g_pixel_slice_u8.len / 2);
+  wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STRING(do_wuffs_png_decode_to_pixbuf(
+      &pb, have, WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL, pixels));
+  uint64_t n = wuffs_base__pixel_config__pixbuf_len(&pb.pixcfg);
+  if (n != want.len) {
+    RETURN_FAIL("%spixbuf_len: have %" PRIu64 ", want %zu", prefix, n,
+                want.len);
+  }
+  wuffs_base__io_buffer have_pixels =
+      wuffs_base__ptr_u8__reader(pixels.ptr, n, true);
+  wuffs_base__io_buffer want_pixels =
+      wuffs_base__ptr_u8__reader(want.ptr, want.len, true);
+  return check_io_buffers_equal(prefix, &have_pixels, &want_pixels);
+}
+
+const char*  //
+test_wuffs_png_encode_round_trip() {
+  CHECK_FOCUS(__func__);
+
+  // These cover the gray, RGB, paletted (with and without tRNS) and RGBA
+  // encodings.
+  const char* filenames[5] = {
+      "test/data/bricks-gray.png",
+      "test/data/bricks-color.png",
+      "test/data/bricks-dither.png",
+      "test/data/hippopotamus.masked-with-muybridge.png",
+      "test/data/pjw-thumbnail.png",
+  };
+
+  for (int tc = 0; tc < 5; tc++) {
+    wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+        .data = g_src_slice_u8,
+    });
+    CHECK_STRING(read_file(&src, filenames[tc]));
+
+    // Decode to BGRA_NONPREMUL, for comparison, and to the image's own pixel
+    // format, for encoding.
+    wuffs_base__pixel_buffer want_pb = ((wuffs_base__pixel_buffer){});
+    CHECK_STRING(do_wuffs_png_decode_to_pixbuf(
+        &want_pb, &src, WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+        g_want_slice_u8));
+    wuffs_base__slice_u8 want = wuffs_base__make_slice_u8(
+        g_want_slice_u8.ptr,
+        wuffs_base__pixel_config__pixbuf_len(&want_pb.pixcfg));
+    src.meta.ri = 0;
+    wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+    CHECK_STRING(do_wuffs_png_decode_to_pixbuf(
+        &pb, &src, 0,
+        wuffs_base__make_slice_u8(g_pixel_slice_u8.ptr,
+                                  g_pixel_slice_u8.len / 2)));
+
+    for (uint32_t filter = 0; filter <= 5; filter++) {
+      for (int small = 0; small < 2; small++) {
+        wuffs_png__encoder enc;
+        CHECK_STATUS("initialize",
+                     wuffs_png__encoder__initialize(
+                         &enc, sizeof enc, WUFFS_VERSION,
+                         WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+        wuffs_png__encoder__set_filter(&enc, filter);
+        wuffs_png__encoder__set_level(&enc, small ? 1 : 6);
+        uint64_t workbuf_len =
+            wuffs_png__encoder__workbuf_len(
+                &enc, wuffs_base__pixel_buffer__pixel_format(&pb),
+                wuffs_base__pixel_config__width(&pb.pixcfg))
+                .max_incl;
+        if ((workbuf_len == 0) || (workbuf_len > g_work_slice_u8.len)) {
+          RETURN_FAIL("tc=%d: bad workbuf_len", tc);
+        }
+
+        wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+            .data = g_have_slice_u8,
+        });
+        char prefix_buf[256];
+        sprintf(prefix_buf, "tc=%d, filter=%" PRIu32 ", small=%d: ", tc,
+                filter, small);
+        const char* status = do_wuffs_png_encode(
+            &have, &enc, &pb,
+            wuffs_base__make_slice_u8(g_work_slice_u8.ptr, workbuf_len),
+            small ? 100 : 0);
+        if (status) {
+          RETURN_FAIL("%s%s", prefix_buf, status);
+        }
+        have.meta.closed = true;
+        CHECK_STRING(do_test_wuffs_png_encode_check(&have, want, prefix_buf));
+      }
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_png_encode_row_bands() {
+  CHECK_FOCUS(__func__);
+
+  const char* filenames[2] = {
+      "test/data/bricks-color.png",
+      "test/data/pjw-thumbnail.png",
+  };
+  const uint32_t band_heights[3] = {1, 7, 1000};
+
+  for (int tc = 0; tc < 2; tc++) {
+    wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+        .data = g_src_slice_u8,
+    });
+    CHECK_STRING(read_file(&src, filenames[tc]));
+    wuffs_base__pixel_buffer want_pb = ((wuffs_base__pixel_buffer){});
+    CHECK_STRING(do_wuffs_png_decode_to_pixbuf(
+        &want_pb, &src, WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+        g_want_slice_u8));
+    wuffs_base__slice_u8 want = wuffs_base__make_slice_u8(
+        g_want_slice_u8.ptr,
+        wuffs_base__pixel_config__pixbuf_len(&want_pb.pixcfg));
+    src.meta.ri = 0;
+    wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+    CHECK_STRING(do_wuffs_png_decode_to_pixbuf(
+        &pb, &src, 0,
+        wuffs_base__make_slice_u8(g_pixel_slice_u8.ptr,
+                                  g_pixel_slice_u8.len / 2)));
+    uint32_t height = wuffs_base__pixel_config__height(&pb.pixcfg);
+
+    for (int j = 0; j < 3; j++) {
+      // Encode each row band's deflate data, appending it to a zlib stream
+      // held in the second half of g_work_slice_u8. The first half is the
+      // encoders' workbuf.
+      wuffs_base__slice_u8 workbuf = wuffs_base__make_slice_u8(
+          g_work_slice_u8.ptr, g_work_slice_u8.len / 2);
+      wuffs_base__io_buffer zlib = ((wuffs_base__io_buffer){
+          .data = wuffs_base__make_slice_u8(
+              g_work_slice_u8.ptr + (g_work_slice_u8.len / 2),
+              g_work_slice_u8.len / 2),
+      });
+      zlib.data.ptr[zlib.meta.wi++] = 0x78;
+      zlib.data.ptr[zlib.meta.wi++] = 0x9C;
+      wuffs_adler32__hasher hasher;
+      CHECK_STATUS("initialize",
+                   wuffs_adler32__hasher__initialize(
+                       &hasher, sizeof hasher, WUFFS_VERSION,
+                       WUFFS_INITIALIZE__DEFAULT_OPTIONS));
+      uint32_t checksum = 1;
+
+      for (uint32_t y0 = 0; y0 < height; y0 += band_heights[j]) {
+        uint32_t y1 = y0 + band_heights[j];
+        if (y1 > height) {
+          y1 = height;
+        }
+        wuffs_png__encoder enc;
+        CHECK_STATUS("initialize",
+                     wuffs_png__encoder__initialize(
+                         &enc, sizeof enc, WUFFS_VERSION,
+                         WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+        wuffs_png__encoder__set_row_band(&enc, y0, y1);
+        CHECK_STRING(do_wuffs_png_encode(&zlib, &enc, &pb, workbuf, 0));
+        checksum = wuffs_adler32__hasher__combine_u32(
+            &hasher, wuffs_png__encoder__row_band_checksum(&enc),
+            wuffs_png__encoder__row_band_length(&enc));
+      }
+      wuffs_base__poke_u32be__no_bounds_check(zlib.data.ptr + zlib.meta.wi,
+                                              checksum);
+      zlib.meta.wi += 4;
+
+      // Wrap the zlib stream in PNG chunks.
+      wuffs_png__encoder enc;
+      CHECK_STATUS("initialize",
+                   wuffs_png__encoder__initialize(
+                       &enc, sizeof enc, WUFFS_VERSION,
+                       WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+      wuffs_png__encoder__set_workbuf_prefilled(&enc, true);
+      wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+          .data = g_have_slice_u8,
+      });
+      CHECK_STRING(do_wuffs_png_encode(
+          &have, &enc, &pb,
+          wuffs_base__make_slice_u8(zlib.data.ptr, zlib.meta.wi), 0));
+      have.meta.closed = true;
+
+      char prefix_buf[256];
+      sprintf(prefix_buf, "tc=%d, band_height=%" PRIu32 ": ", tc,
+              band_heights[j]);
+      CHECK_STRING(do_test_wuffs_png_encode_check(&have, want, prefix_buf));
+    }
+  }
+  return NULL;
+}
+
 // ---------------- Mimic Tests
 
 #ifdef WUFFS_MIMIC
@@ -1021,6 +2217,83 @@ test_mimic_png_decode_bad_crc32_checksum_critical() {
 
 // ---------------- PNG Benches
 
+// gen_png_write_chunk writes a PNG chunk, including its length, type and
+// CRC-32 checksum.
+const char*  //
+gen_png_write_chunk(wuffs_base__io_buffer* dst,
+                    const char* chunk_type,
+                    const uint8_t* ptr,
+                    size_t len) {
+  if ((dst->data.len - dst->meta.wi) < (12 + len)) {
+    return "gen_png_write_chunk: dst buffer is too short";
+  }
+  uint8_t* p = dst->data.ptr + dst->meta.wi;
+  wuffs_base__poke_u32be__no_bounds_check(p + 0, (uint32_t)len);
+  memcpy(p + 4, chunk_type, 4);
+  if (len > 0) {
+    memcpy(p + 8, ptr, len);
+  }
+
+  wuffs_crc32__ieee_hasher crc32;
+  CHECK_STATUS("initialize", wuffs_crc32__ieee_hasher__initialize(
+                                 &crc32, sizeof crc32, WUFFS_VERSION,
+                                 WUFFS_INITIALIZE__DEFAULT_OPTIONS));
+  wuffs_base__poke_u32be__no_bounds_check(
+      p + 8 + len, wuffs_crc32__ieee_hasher__update_u32(
+                       &crc32, wuffs_base__make_slice_u8(p + 4, 4 + len)));
+  dst->meta.wi += 12 + len;
+  return NULL;
+}
+
+// gen_png_many_tiny_idats generates a 64×64 gray PNG whose zlib-compressed
+// pixel data is split into thousands of 1-byte IDAT chunks. It is a worst
+// case input: the decoder spends most of its time on per-chunk overhead.
+const char*  //
+gen_png_many_tiny_idats(wuffs_base__io_buffer* dst) {
+  static const uint8_t ihdr[13] = {
+      0x00, 0x00, 0x00, 0x40,  // Width.
+      0x00, 0x00, 0x00, 0x40,  // Height.
+      0x08, 0x00,              // 8-bit gray.
+      0x00, 0x00, 0x00,        // Compression, filter and interlace methods.
+  };
+  const uint32_t width = 64;
+  const uint32_t height = 64;
+  const uint32_t n = (1 + width) * height;
+
+  // The zlib stream holds one stored (uncompressed) deflate block.
+  uint8_t zlib[2 + 5 + ((1 + 64) * 64) + 4];
+  zlib[0] = 0x78;
+  zlib[1] = 0x01;
+  zlib[2] = 0x01;  // BFINAL and BTYPE: the final stored block.
+  wuffs_base__poke_u16le__no_bounds_check(zlib + 3, (uint16_t)n);
+  wuffs_base__poke_u16le__no_bounds_check(zlib + 5, (uint16_t)~n);
+  uint8_t* pixels = zlib + 7;
+  for (uint32_t y = 0; y < height; y++) {
+    *pixels++ = 0x00;  // Filter: none.
+    for (uint32_t x = 0; x < width; x++) {
+      *pixels++ = (uint8_t)(x ^ y);
+    }
+  }
+  wuffs_adler32__hasher adler32;
+  CHECK_STATUS("initialize", wuffs_adler32__hasher__initialize(
+                                 &adler32, sizeof adler32, WUFFS_VERSION,
+                                 WUFFS_INITIALIZE__DEFAULT_OPTIONS));
+  wuffs_base__poke_u32be__no_bounds_check(
+      pixels, wuffs_adler32__hasher__update_u32(
+                  &adler32, wuffs_base__make_slice_u8(zlib + 7, n)));
+
+  if ((dst->data.len - dst->meta.wi) < 8) {
+    return "gen_png_many_tiny_idats: dst buffer is too short";
+  }
+  memcpy(dst->data.ptr + dst->meta.wi, "\x89PNG\x0D\x0A\x1A\x0A", 8);
+  dst->meta.wi += 8;
+  CHECK_STRING(gen_png_write_chunk(dst, "IHDR", ihdr, sizeof(ihdr)));
+  for (size_t i = 0; i < sizeof(zlib); i++) {
+    CHECK_STRING(gen_png_write_chunk(dst, "IDAT", zlib + i, 1));
+  }
+  return gen_png_write_chunk(dst, "IEND", NULL, 0);
+}
+
 const char*  //
 bench_wuffs_png_decode_image_19k_8bpp() {
   CHECK_FOCUS(__func__);
@@ -1058,6 +2331,15 @@ bench_wuffs_png_decode_image_552k_32bpp_ignore_checksum() {
       &q, 1, "test/data/hibiscus.primitive.png", 0, SIZE_MAX, 4);
 }
 
+const char*  //
+bench_wuffs_png_decode_image_552k_32bpp_premul() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &wuffs_png_decode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL),
+      NULL, 0, "test/data/hibiscus.primitive.png", 0, SIZE_MAX, 4);
+}
+
 const char*  //
 bench_wuffs_png_decode_image_552k_32bpp_verify_checksum() {
   CHECK_FOCUS(__func__);
@@ -1076,6 +2358,15 @@ bench_wuffs_png_decode_image_4002k_24bpp() {
       NULL, 0, "test/data/harvesters.png", 0, SIZE_MAX, 1);
 }
 
+const char*  //
+bench_wuffs_png_decode_image_54k_many_tiny_idats() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode_generated(
+      &wuffs_png_decode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__Y), NULL, 0,
+      gen_png_many_tiny_idats, 10);
+}
+
 const char*  //
 do_bench_wuffs_png_decode_filter(uint8_t filter,
                                  uint8_t filter_distance,
@@ -1112,6 +2403,12 @@ do_bench_wuffs_png_decode_filter(uint8_t filter,
   dec.private_impl.f_frame_rect_y1 = height;
   dec.private_impl.f_width = width;
   dec.private_impl.f_height = height;
+  dec.private_impl.f_roi_x0 = 0;
+  dec.private_impl.f_roi_y0 = 0;
+  dec.private_impl.f_roi_x1 = width;
+  dec.private_impl.f_roi_y1 = height;
+  dec.private_impl.f_band_y0 = 0;
+  dec.private_impl.f_band_y1 = height;
   dec.private_impl.f_pass_bytes_per_row = bytes_per_row;
   dec.private_impl.f_filter_distance = filter_distance;
   wuffs_png__decoder__choose_filter_implementations(&dec);
@@ -1195,6 +2492,70 @@ bench_wuffs_png_decode_filt_4_dist_4() {
   return do_bench_wuffs_png_decode_filter(4, 4, 20);
 }
 
+const char*  //
+do_bench_wuffs_png_encode(const char* filename,
+                          uint32_t filter,
+                          uint64_t iters_unscaled) {
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, filename));
+  wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STRING(do_wuffs_png_decode_to_pixbuf(&pb, &src, 0, g_pixel_slice_u8));
+
+  bench_start();
+  uint64_t n_bytes = 0;
+  uint64_t iters = iters_unscaled * g_flags.iterscale;
+  for (uint64_t i = 0; i < iters; i++) {
+    wuffs_png__encoder enc;
+    CHECK_STATUS("initialize",
+                 wuffs_png__encoder__initialize(
+                     &enc, sizeof enc, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_png__encoder__set_filter(&enc, filter);
+    uint64_t workbuf_len =
+        wuffs_png__encoder__workbuf_len(
+            &enc, wuffs_base__pixel_buffer__pixel_format(&pb),
+            wuffs_base__pixel_config__width(&pb.pixcfg))
+            .max_incl;
+    if (workbuf_len > g_work_slice_u8.len) {
+      return "workbuf_len is too large";
+    }
+    wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+        .data = g_have_slice_u8,
+    });
+    CHECK_STATUS("encode_image",
+                 wuffs_png__encoder__encode_image(
+                     &enc, &have, &pb,
+                     wuffs_base__make_slice_u8(g_work_slice_u8.ptr,
+                                               workbuf_len)));
+    n_bytes += wuffs_base__pixel_config__pixbuf_len(&pb.pixcfg);
+  }
+  bench_finish(iters, n_bytes);
+  return NULL;
+}
+
+const char*  //
+bench_wuffs_png_encode_image_40k_24bpp_adaptive() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_png_encode("test/data/hat.png",
+                                   WUFFS_PNG__ENCODER_FILTER_ADAPTIVE, 10);
+}
+
+const char*  //
+bench_wuffs_png_encode_image_40k_24bpp_paeth() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_png_encode("test/data/hat.png",
+                                   WUFFS_PNG__ENCODER_FILTER_PAETH, 10);
+}
+
+const char*  //
+bench_wuffs_png_encode_image_552k_32bpp_adaptive() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_png_encode("test/data/hibiscus.primitive.png",
+                                   WUFFS_PNG__ENCODER_FILTER_ADAPTIVE, 1);
+}
+
 // ---------------- Mimic Benches
 
 #ifdef WUFFS_MIMIC
@@ -1260,16 +2621,29 @@ bench_mimic_png_decode_image_4002k_24bpp() {
 
 proc g_tests[] = {
 
+    test_wuffs_png_decode_16_bit_depth,
+    test_wuffs_png_decode_animated_restart_frame,
     test_wuffs_png_decode_bad_crc32_checksum_critical,
+    test_wuffs_png_decode_color_conversion,
+    test_wuffs_png_decode_downscale,
     test_wuffs_png_decode_filters_golden,
     test_wuffs_png_decode_filters_round_trip,
     test_wuffs_png_decode_frame_config,
     test_wuffs_png_decode_interface,
+    test_wuffs_png_decode_interlace_passes,
     test_wuffs_png_decode_metadata_chrm_gama_srgb,
     test_wuffs_png_decode_metadata_exif,
     test_wuffs_png_decode_metadata_iccp,
     test_wuffs_png_decode_metadata_kvp,
     test_wuffs_png_decode_restart_frame,
+    test_wuffs_png_decode_rgba_bgra_premul,
+    test_wuffs_png_decode_roi,
+    test_wuffs_png_decode_row_bands,
+    test_wuffs_png_decode_stats,
+    test_wuffs_png_decode_workbuf_prefilled,
+    test_wuffs_png_decode_workbuf_streaming,
+    test_wuffs_png_encode_round_trip,
+    test_wuffs_png_encode_row_bands,
 
 #ifdef WUFFS_MIMIC
 
@@ -1302,8 +2676,13 @@ proc g_benches[] = {
     bench_wuffs_png_decode_image_40k_24bpp,
     bench_wuffs_png_decode_image_77k_8bpp,
     bench_wuffs_png_decode_image_552k_32bpp_ignore_checksum,
+    bench_wuffs_png_decode_image_552k_32bpp_premul,
     bench_wuffs_png_decode_image_552k_32bpp_verify_checksum,
     bench_wuffs_png_decode_image_4002k_24bpp,
+    bench_wuffs_png_decode_image_54k_many_tiny_idats,
+    bench_wuffs_png_encode_image_40k_24bpp_adaptive,
+    bench_wuffs_png_encode_image_40k_24bpp_paeth,
+    bench_wuffs_png_encode_image_552k_32bpp_adaptive,
 
 #ifdef WUFFS_MIMIC
 
@@ -0,0 +1,351 @@
+// Copyright 2021 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ----------------
+
+/*
+This test program is typically run indirectly, by the "wuffs test" or "wuffs
+bench" commands. These commands take an optional "-mimic" flag to check that
+Wuffs' output mimics (i.e. exactly matches) other libraries' output, such as
+giflib for GIF, libpng for PNG, etc.
+
+To manually run this test:
+
+for CC in clang gcc; do
+  $CC -std=c99 -Wall -Werror rac.c && ./a.out
+  rm -f a.out
+done
+
+Each edition should print "PASS", amongst other information, and exit(0).
+
+Add the "wuffs mimic cflags" (everything after the colon below) to the C
+compiler flags (after the .c file) to run the mimic tests.
+
+To manually run the benchmarks, replace "-Wall -Werror" with "-O3" and replace
+the first "./a.out" with "./a.out -bench". Combine these changes with the
+"wuffs mimic cflags" to run the mimic benchmarks.
+*/
+
+// ¿ wuffs mimic cflags: -DWUFFS_MIMIC
+
+// Wuffs ships as a "single file C library" or "header file library" as per
+// https://github.com/nothings/stb/blob/master/docs/stb_howto.txt
+//
+// To use that single file as a "foo.c"-like implementation, instead of a
+// "foo.h"-like header, #define WUFFS_IMPLEMENTATION before #include'ing or
+// compiling it.
+#define WUFFS_IMPLEMENTATION
+
+// Defining the WUFFS_CONFIG__MODULE* macros are optional, but it lets users of
+// release/c/etc.c choose which parts of Wuffs to build. That file contains the
+// entire Wuffs standard library, implementing a variety of codecs and file
+// formats. Without this macro definition, an optimizing compiler or linker may
+// very well discard Wuffs code for unused codecs, but listing the Wuffs
+// modules we use makes that process explicit. Preprocessing means that such
+// code simply isn't compiled.
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__BASE
+#define WUFFS_CONFIG__MODULE__ADLER32
+#define WUFFS_CONFIG__MODULE__CRC32
+#define WUFFS_CONFIG__MODULE__DEFLATE
+#define WUFFS_CONFIG__MODULE__RAC
+#define WUFFS_CONFIG__MODULE__ZLIB
+
+// If building this program in an environment that doesn't easily accommodate
+// relative includes, you can use the script/inline-c-relative-includes.go
+// program to generate a stand-alone C file.
+#include "../../../release/c/wuffs-unsupported-snapshot.c"
+#include "../testlib/testlib.c"
+#ifdef WUFFS_MIMIC
+// No mimic library.
+#endif
+
+// ---------------- Golden Tests
+
+// sheep-more.rac is the "Zlib Example (Concatenation)" from the RAC spec. Its
+// root node is at the CFile end, it has CBiasing branch nodes and one of its
+// chunks uses a shared dictionary.
+const char* g_rac_sheep_more_want_ptr =
+    "One sheep.\nTwo sheep.\nThree sheep.\nMore!\n";
+const size_t g_rac_sheep_more_want_len = 41;
+
+// ---------------- RAC Tests
+
+// wuffs_rac_decode decodes the DRange [dmin .. dmax) of the RAC file held
+// (entirely) in src. It handles "$mispositioned read" by re-positioning src.
+const char*  //
+wuffs_rac_decode(wuffs_base__io_buffer* dst,
+                 wuffs_base__io_buffer* src,
+                 uint64_t dmin,
+                 uint64_t dmax,
+                 uint64_t wlimit,
+                 uint64_t rlimit) {
+  wuffs_rac__decoder dec;
+  CHECK_STATUS("initialize", wuffs_rac__decoder__initialize(
+                                 &dec, sizeof dec, WUFFS_VERSION,
+                                 WUFFS_INITIALIZE__DEFAULT_OPTIONS));
+  wuffs_rac__decoder__set_compressed_size(&dec, src->meta.wi);
+  wuffs_rac__decoder__set_drange(&dec, dmin, dmax);
+
+  int n_mispositioned_reads = 0;
+  while (true) {
+    wuffs_base__io_buffer limited_dst = make_limited_writer(*dst, wlimit);
+    wuffs_base__io_buffer limited_src = make_limited_reader(*src, rlimit);
+
+    wuffs_base__status status = wuffs_rac__decoder__transform_io(
+        &dec, &limited_dst, &limited_src, g_work_slice_u8);
+
+    dst->meta.wi += limited_dst.meta.wi;
+    src->meta.ri += limited_src.meta.ri;
+
+    if (status.repr == wuffs_base__suspension__mispositioned_read) {
+      uint64_t pos = wuffs_rac__decoder__io_seek_position(&dec);
+      if ((pos < src->meta.pos) || ((pos - src->meta.pos) > src->meta.wi)) {
+        return "io_seek_position: out of bounds";
+      } else if (++n_mispositioned_reads > 1000) {
+        return "too many mispositioned reads";
+      }
+      src->meta.ri = pos - src->meta.pos;
+    } else if (((wlimit < UINT64_MAX) &&
+                (status.repr == wuffs_base__suspension__short_write)) ||
+               ((rlimit < UINT64_MAX) &&
+                (status.repr == wuffs_base__suspension__short_read))) {
+      continue;
+    } else {
+      return status.repr;
+    }
+  }
+}
+
+const char*  //
+do_test_wuffs_rac_decode(uint64_t dmin,
+                         uint64_t dmax,
+                         uint64_t wlimit,
+                         uint64_t rlimit) {
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, "test/data/sheep-more.rac"));
+  CHECK_STRING(wuffs_rac_decode(&have, &src, dmin, dmax, wlimit, rlimit));
+
+  if (dmax > g_rac_sheep_more_want_len) {
+    dmax = g_rac_sheep_more_want_len;
+  }
+  wuffs_base__io_buffer want = make_io_buffer_from_string(
+      g_rac_sheep_more_want_ptr + dmin, (dmin < dmax) ? (dmax - dmin) : 0);
+  return check_io_buffers_equal("", &have, &want);
+}
+
+const char*  //
+test_wuffs_rac_decode_bad_compressed_size() {
+  CHECK_FOCUS(__func__);
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, "test/data/sheep-more.rac"));
+  if (src.meta.wi < 1) {
+    RETURN_FAIL("source data is too short");
+  }
+  src.meta.wi--;
+
+  const char* have_msg = wuffs_rac_decode(&have, &src, 0, UINT64_MAX,
+                                          UINT64_MAX, UINT64_MAX);
+  if (have_msg != wuffs_rac__error__missing_root_node) {
+    RETURN_FAIL("have \"%s\", want \"%s\"", have_msg,
+                wuffs_rac__error__missing_root_node);
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_rac_decode_bad_index_node() {
+  CHECK_FOCUS(__func__);
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, "test/data/sheep-more.rac"));
+
+  // Corrupt the checksum of the child branch node (whose magic bytes start at
+  // offset 0xB6) that holds the "More!\n" chunk.
+  if ((src.meta.wi < 0xBB) || (src.data.ptr[0xB6] != 0x72)) {
+    RETURN_FAIL("unexpected source data");
+  }
+  src.data.ptr[0xBA] ^= 0x01;
+
+  // The first chunks are unaffected.
+  const char* have_msg =
+      wuffs_rac_decode(&have, &src, 0, 11, UINT64_MAX, UINT64_MAX);
+  if (have_msg != NULL) {
+    RETURN_FAIL("DRange [0 .. 11): have \"%s\", want NULL", have_msg);
+  }
+
+  have.meta.wi = 0;
+  src.meta.ri = 0;
+  have_msg = wuffs_rac_decode(&have, &src, 0, UINT64_MAX, UINT64_MAX,
+                              UINT64_MAX);
+  if (have_msg != wuffs_rac__error__bad_index_node) {
+    RETURN_FAIL("DRange [0 .. max): have \"%s\", want \"%s\"", have_msg,
+                wuffs_rac__error__bad_index_node);
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_rac_decode_interface() {
+  CHECK_FOCUS(__func__);
+  wuffs_rac__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_rac__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  // RAC decoding is typically not sequential, so a single transform_io call
+  // (without handling "$mispositioned read") isn't enough. Instead, check the
+  // workbuf_len and that a missing compressed size is rejected.
+  wuffs_base__io_transformer* b =
+      wuffs_rac__decoder__upcast_as__wuffs_base__io_transformer(&dec);
+  wuffs_base__range_ii_u64 workbuf_len =
+      wuffs_base__io_transformer__workbuf_len(b);
+  if ((workbuf_len.min_incl !=
+       WUFFS_RAC__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE) ||
+      (workbuf_len.max_incl !=
+       WUFFS_RAC__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE)) {
+    RETURN_FAIL("workbuf_len: have [%" PRIu64 " ..= %" PRIu64 "]",
+                workbuf_len.min_incl, workbuf_len.max_incl);
+  }
+
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, "test/data/sheep-more.rac"));
+  wuffs_base__status status =
+      wuffs_base__io_transformer__transform_io(b, &have, &src, g_work_slice_u8);
+  if (status.repr != wuffs_rac__error__bad_compressed_size) {
+    RETURN_FAIL("transform_io: have \"%s\", want \"%s\"", status.repr,
+                wuffs_rac__error__bad_compressed_size);
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_rac_decode_sheep_more() {
+  CHECK_FOCUS(__func__);
+  CHECK_STRING(do_test_wuffs_rac_decode(0, UINT64_MAX, UINT64_MAX, UINT64_MAX));
+  return NULL;
+}
+
+const char*  //
+test_wuffs_rac_decode_sheep_more_drange() {
+  CHECK_FOCUS(__func__);
+  const uint64_t dranges[][2] = {
+      {0, 0},   {0, 11},  {3, 8},   {5, 30}, {11, 22},
+      {14, 38}, {22, 41}, {35, 41}, {40, 99},
+  };
+  for (size_t i = 0; i < WUFFS_TESTLIB_ARRAY_SIZE(dranges); i++) {
+    const char* have_msg = do_test_wuffs_rac_decode(
+        dranges[i][0], dranges[i][1], UINT64_MAX, UINT64_MAX);
+    if (have_msg) {
+      RETURN_FAIL("DRange [%" PRIu64 " .. %" PRIu64 "): %s", dranges[i][0],
+                  dranges[i][1], have_msg);
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_rac_decode_sheep_more_limits() {
+  CHECK_FOCUS(__func__);
+  const uint64_t limits[] = {1, 2, 3, 5, 7, 64};
+  for (size_t i = 0; i < WUFFS_TESTLIB_ARRAY_SIZE(limits); i++) {
+    for (size_t j = 0; j < WUFFS_TESTLIB_ARRAY_SIZE(limits); j++) {
+      const char* have_msg =
+          do_test_wuffs_rac_decode(0, UINT64_MAX, limits[i], limits[j]);
+      if (have_msg) {
+        RETURN_FAIL("wlimit=%" PRIu64 ", rlimit=%" PRIu64 ": %s", limits[i],
+                    limits[j], have_msg);
+      }
+    }
+  }
+  return NULL;
+}
+
+// ---------------- Mimic Tests
+
+#ifdef WUFFS_MIMIC
+
+// No mimic tests.
+
+#endif  // WUFFS_MIMIC
+
+// ---------------- RAC Benches
+
+// No RAC benches.
+
+// ---------------- Mimic Benches
+
+#ifdef WUFFS_MIMIC
+
+// No mimic benches.
+
+#endif  // WUFFS_MIMIC
+
+// ---------------- Manifest
+
+proc g_tests[] = {
+
+    test_wuffs_rac_decode_bad_compressed_size,
+    test_wuffs_rac_decode_bad_index_node,
+    test_wuffs_rac_decode_interface,
+    test_wuffs_rac_decode_sheep_more,
+    test_wuffs_rac_decode_sheep_more_drange,
+    test_wuffs_rac_decode_sheep_more_limits,
+
+#ifdef WUFFS_MIMIC
+
+// No mimic tests.
+
+#endif  // WUFFS_MIMIC
+
+    NULL,
+};
+
+proc g_benches[] = {
+
+// No RAC benches.
+
+#ifdef WUFFS_MIMIC
+
+// No mimic benches.
+
+#endif  // WUFFS_MIMIC
+
+    NULL,
+};
+
+int  //
+main(int argc, char** argv) {
+  g_proc_package_name = "std/rac";
+  return test_main(argc, argv, g_tests, g_benches);
+}
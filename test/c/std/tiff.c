@@ -0,0 +1,578 @@
+// Copyright 2022 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ----------------
+
+/*
+This test program is typically run indirectly, by the "wuffs test" or "wuffs
+bench" commands. These commands take an optional "-mimic" flag to check that
+Wuffs' output mimics (i.e. exactly matches) other libraries' output, such as
+giflib for GIF, libpng for PNG, etc.
+
+To manually run this test:
+
+for CC in clang gcc; do
+  $CC -std=c99 -Wall -Werror tiff.c && ./a.out
+  rm -f a.out
+done
+
+Each edition should print "PASS", amongst other information, and exit(0).
+
+To manually run the benchmarks, replace "-Wall -Werror" with "-O3" and replace
+the first "./a.out" with "./a.out -bench".
+*/
+
+// Wuffs ships as a "single file C library" or "header file library" as per
+// https://github.com/nothings/stb/blob/master/docs/stb_howto.txt
+//
+// To use that single file as a "foo.c"-like implementation, instead of a
+// "foo.h"-like header, #define WUFFS_IMPLEMENTATION before #include'ing or
+// compiling it.
+#define WUFFS_IMPLEMENTATION
+
+// Defining the WUFFS_CONFIG__MODULE* macros are optional, but it lets users of
+// release/c/etc.c choose which parts of Wuffs to build. That file contains the
+// entire Wuffs standard library, implementing a variety of codecs and file
+// formats. Without this macro definition, an optimizing compiler or linker may
+// very well discard Wuffs code for unused codecs, but listing the Wuffs
+// modules we use makes that process explicit. Preprocessing means that such
+// code simply isn't compiled.
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__ADLER32
+#define WUFFS_CONFIG__MODULE__BASE
+#define WUFFS_CONFIG__MODULE__CRC32
+#define WUFFS_CONFIG__MODULE__DEFLATE
+#define WUFFS_CONFIG__MODULE__LZW
+#define WUFFS_CONFIG__MODULE__PNG
+#define WUFFS_CONFIG__MODULE__TIFF
+#define WUFFS_CONFIG__MODULE__ZLIB
+
+// If building this program in an environment that doesn't easily accommodate
+// relative includes, you can use the script/inline-c-relative-includes.go
+// program to generate a stand-alone C file.
+#include "../../../release/c/wuffs-unsupported-snapshot.c"
+#include "../testlib/testlib.c"
+
+// ---------------- TIFF Tests
+
+// The TIFF decoder reads its src out of order, returning a "$mispositioned
+// read" when it wants to go backwards. These tests hold the entire file in
+// memory, so re-positioning means adjusting the src's read index.
+
+const char*  //
+seek_tiff_src(wuffs_tiff__decoder* dec, wuffs_base__io_buffer* src) {
+  uint64_t pos = wuffs_tiff__decoder__io_seek_position(dec);
+  if ((pos < src->meta.pos) || ((pos - src->meta.pos) > src->meta.wi)) {
+    return "seek_tiff_src: position is outside of the src buffer";
+  }
+  src->meta.ri = (size_t)(pos - src->meta.pos);
+  return NULL;
+}
+
+const char*  //
+tiff_decode_image_config(wuffs_tiff__decoder* dec,
+                         wuffs_base__image_config* ic,
+                         wuffs_base__io_buffer* src) {
+  while (true) {
+    wuffs_base__status status =
+        wuffs_tiff__decoder__decode_image_config(dec, ic, src);
+    if (status.repr != wuffs_base__suspension__mispositioned_read) {
+      return status.repr;
+    }
+    CHECK_STRING(seek_tiff_src(dec, src));
+  }
+}
+
+const char*  //
+tiff_decode_frame(wuffs_tiff__decoder* dec,
+                  wuffs_base__pixel_buffer* pb,
+                  wuffs_base__io_buffer* src,
+                  wuffs_base__decode_frame_options* opts) {
+  while (true) {
+    wuffs_base__status status = wuffs_tiff__decoder__decode_frame(
+        dec, pb, src, WUFFS_BASE__PIXEL_BLEND__SRC, g_work_slice_u8, opts);
+    if (status.repr != wuffs_base__suspension__mispositioned_read) {
+      return status.repr;
+    }
+    CHECK_STRING(seek_tiff_src(dec, src));
+  }
+}
+
+// do_tiff_decode decodes the src into the pixel buffer backed by dst_slice,
+// optionally restricted to a Region Of Interest, and returns the image
+// configuration via ic.
+const char*  //
+do_tiff_decode(wuffs_tiff__decoder* dec,
+               wuffs_base__image_config* ic,
+               wuffs_base__slice_u8 dst_slice,
+               wuffs_base__pixel_format pixfmt,
+               const wuffs_base__rect_ie_u32* roi,
+               wuffs_base__io_buffer* src) {
+  CHECK_STRING(tiff_decode_image_config(dec, ic, src));
+  uint32_t width = wuffs_base__pixel_config__width(&ic->pixcfg);
+  uint32_t height = wuffs_base__pixel_config__height(&ic->pixcfg);
+  wuffs_base__decode_frame_options opts =
+      wuffs_base__null_decode_frame_options();
+  if (roi) {
+    wuffs_base__rect_ie_u32 bounds =
+        wuffs_base__pixel_config__bounds(&ic->pixcfg);
+    wuffs_base__rect_ie_u32 clipped =
+        wuffs_base__rect_ie_u32__intersect(&bounds, *roi);
+    width = wuffs_base__rect_ie_u32__width(&clipped);
+    height = wuffs_base__rect_ie_u32__height(&clipped);
+    wuffs_base__decode_frame_options__set_roi(&opts, *roi);
+  }
+
+  wuffs_base__pixel_config pixcfg = ((wuffs_base__pixel_config){});
+  wuffs_base__pixel_config__set(&pixcfg, pixfmt.repr,
+                                WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, width,
+                                height);
+  wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                     &pb, &pixcfg, dst_slice));
+  return tiff_decode_frame(dec, &pb, src, &opts);
+}
+
+const char*  //
+wuffs_tiff_decode(uint64_t* n_bytes_out,
+                  wuffs_base__io_buffer* dst,
+                  uint32_t wuffs_initialize_flags,
+                  wuffs_base__pixel_format pixfmt,
+                  uint32_t* quirks_ptr,
+                  size_t quirks_len,
+                  wuffs_base__io_buffer* src) {
+  wuffs_tiff__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_tiff__decoder__initialize(&dec, sizeof dec, WUFFS_VERSION,
+                                               wuffs_initialize_flags));
+  for (size_t i = 0; i < quirks_len; i++) {
+    wuffs_tiff__decoder__set_quirk_enabled(&dec, quirks_ptr[i], true);
+  }
+  wuffs_base__image_config ic = ((wuffs_base__image_config){});
+  CHECK_STRING(
+      do_tiff_decode(&dec, &ic, g_pixel_slice_u8, pixfmt, NULL, src));
+
+  uint64_t n = wuffs_base__pixel_config__width(&ic.pixcfg) *
+               wuffs_base__pixel_config__height(&ic.pixcfg) *
+               (wuffs_base__pixel_format__bits_per_pixel(&pixfmt) / 8);
+  if (n_bytes_out) {
+    *n_bytes_out += n;
+  }
+  if (dst) {
+    if (n > (dst->data.len - dst->meta.wi)) {
+      return "wuffs_tiff_decode: dst buffer is too small";
+    }
+    memcpy(dst->data.ptr + dst->meta.wi, g_pixel_slice_u8.ptr, (size_t)n);
+    dst->meta.wi += (size_t)n;
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_tiff_decode_bad_header() {
+  CHECK_FOCUS(__func__);
+
+  // A PNG file is not a TIFF file.
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, "test/data/bricks-color.png"));
+
+  wuffs_tiff__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_tiff__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_base__image_config ic = ((wuffs_base__image_config){});
+  wuffs_base__status status =
+      wuffs_tiff__decoder__decode_image_config(&dec, &ic, &src);
+  if (status.repr != wuffs_tiff__error__bad_header) {
+    RETURN_FAIL("decode_image_config: have \"%s\", want \"%s\"",
+                status.repr, wuffs_tiff__error__bad_header);
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_tiff_decode_interface() {
+  CHECK_FOCUS(__func__);
+
+  const char* filenames[5] = {
+      "test/data/bricks-color.tiff",
+      "test/data/bricks-color.tiled.lzw.tiff",
+      "test/data/bricks-gray.tiff",
+      "test/data/bricks-gray.16bit.tiff",
+      "test/data/bricks-gray.packbits.be.tiff",
+  };
+  const wuffs_base__color_u32_argb_premul want_final_pixels[5] = {
+      0xFF022460, 0xFF022460, 0xFF060606, 0xFF060606, 0xFF060606,
+  };
+
+  int i;
+  for (i = 0; i < 5; i++) {
+    wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+        .data = g_src_slice_u8,
+    });
+    CHECK_STRING(read_file(&src, filenames[i]));
+
+    wuffs_tiff__decoder dec;
+    CHECK_STATUS("initialize",
+                 wuffs_tiff__decoder__initialize(
+                     &dec, sizeof dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_base__image_config ic = ((wuffs_base__image_config){});
+    CHECK_STRING(do_tiff_decode(
+        &dec, &ic, g_pixel_slice_u8,
+        wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL),
+        NULL, &src));
+
+    uint32_t width = wuffs_base__pixel_config__width(&ic.pixcfg);
+    uint32_t height = wuffs_base__pixel_config__height(&ic.pixcfg);
+    if ((width != 160) || (height != 120)) {
+      RETURN_FAIL("%s: dimensions: have %" PRIu32 "x%" PRIu32
+                  ", want 160x120",
+                  filenames[i], width, height);
+    }
+    uint32_t have = wuffs_base__peek_u32le__no_bounds_check(
+        g_pixel_slice_u8.ptr + (4 * (((size_t)width * height) - 1)));
+    if (have != want_final_pixels[i]) {
+      RETURN_FAIL("%s: final pixel: have 0x%08" PRIX32 ", want 0x%08" PRIX32,
+                  filenames[i], have, want_final_pixels[i]);
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_tiff_decode_matches_png() {
+  CHECK_FOCUS(__func__);
+
+  // These cover RGB, RGBA (unassociated alpha), gray and 1-bit palette TIFF
+  // files. Each should decode to the same pixels as its PNG counterpart.
+  const char* filenames[6][2] = {
+      {"test/data/bricks-color.tiff", "test/data/bricks-color.png"},
+      {"test/data/bricks-gray.tiff", "test/data/bricks-gray.png"},
+      {"test/data/hat.tiff", "test/data/hat.png"},
+      {"test/data/hibiscus.primitive.tiff", "test/data/hibiscus.primitive.png"},
+      {"test/data/hippopotamus.tiff", "test/data/hippopotamus.regular.png"},
+      {"test/data/pjw-thumbnail.tiff", "test/data/pjw-thumbnail.png"},
+  };
+  wuffs_base__pixel_format pixfmt =
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL);
+
+  int i;
+  for (i = 0; i < 6; i++) {
+    wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+        .data = g_src_slice_u8,
+    });
+    CHECK_STRING(read_file(&src, filenames[i][1]));
+    wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+        .data = g_want_slice_u8,
+    });
+    wuffs_png__decoder png_dec;
+    CHECK_STATUS("initialize",
+                 wuffs_png__decoder__initialize(
+                     &png_dec, sizeof png_dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    CHECK_STRING(do_run__wuffs_base__image_decoder(
+        wuffs_png__decoder__upcast_as__wuffs_base__image_decoder(&png_dec),
+        NULL, &want, pixfmt, NULL, 0, &src));
+
+    src.meta = ((wuffs_base__io_buffer_meta){});
+    CHECK_STRING(read_file(&src, filenames[i][0]));
+    wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+        .data = g_have_slice_u8,
+    });
+    CHECK_STRING(wuffs_tiff_decode(
+        NULL, &have, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+        pixfmt, NULL, 0, &src));
+
+    CHECK_STRING(check_io_buffers_equal(filenames[i][0], &have, &want));
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_tiff_decode_encodings() {
+  CHECK_FOCUS(__func__);
+
+  // Each pair should decode to the same pixels. The first of each pair uses
+  // deflate compression, one strip and little-endian byte order. The second
+  // uses LZW compression and tiles, PackBits compression, multiple strips and
+  // big-endian byte order, or 16 bits per sample.
+  const char* filenames[3][2] = {
+      {"test/data/bricks-color.tiff", "test/data/bricks-color.tiled.lzw.tiff"},
+      {"test/data/bricks-gray.tiff", "test/data/bricks-gray.packbits.be.tiff"},
+      {"test/data/bricks-gray.tiff", "test/data/bricks-gray.16bit.tiff"},
+  };
+  wuffs_base__pixel_format pixfmt =
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL);
+
+  int i;
+  for (i = 0; i < 3; i++) {
+    wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+        .data = g_src_slice_u8,
+    });
+    CHECK_STRING(read_file(&src, filenames[i][0]));
+    wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+        .data = g_want_slice_u8,
+    });
+    CHECK_STRING(wuffs_tiff_decode(
+        NULL, &want, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+        pixfmt, NULL, 0, &src));
+
+    src.meta = ((wuffs_base__io_buffer_meta){});
+    CHECK_STRING(read_file(&src, filenames[i][1]));
+    wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+        .data = g_have_slice_u8,
+    });
+    CHECK_STRING(wuffs_tiff_decode(
+        NULL, &have, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+        pixfmt, NULL, 0, &src));
+
+    CHECK_STRING(check_io_buffers_equal(filenames[i][1], &have, &want));
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_tiff_decode_strip_or_tile_rects() {
+  CHECK_FOCUS(__func__);
+
+  // Decode each tile (or strip) separately, as independent decoders (e.g. on
+  // separate threads) could, and check them against a full decode.
+  const char* filenames[2] = {
+      "test/data/bricks-color.tiled.lzw.tiff",
+      "test/data/bricks-gray.packbits.be.tiff",
+  };
+  const uint32_t want_nums[2] = {6, 8};
+  wuffs_base__pixel_format pixfmt =
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL);
+
+  int i;
+  for (i = 0; i < 2; i++) {
+    wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+        .data = g_src_slice_u8,
+    });
+    CHECK_STRING(read_file(&src, filenames[i]));
+
+    wuffs_tiff__decoder full_dec;
+    CHECK_STATUS("initialize",
+                 wuffs_tiff__decoder__initialize(
+                     &full_dec, sizeof full_dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_base__image_config ic = ((wuffs_base__image_config){});
+    CHECK_STRING(
+        do_tiff_decode(&full_dec, &ic, g_want_slice_u8, pixfmt, NULL, &src));
+    uint32_t width = wuffs_base__pixel_config__width(&ic.pixcfg);
+
+    uint32_t have_num = wuffs_tiff__decoder__num_strips_or_tiles(&full_dec);
+    if (have_num != want_nums[i]) {
+      RETURN_FAIL("%s: num_strips_or_tiles: have %" PRIu32 ", want %" PRIu32,
+                  filenames[i], have_num, want_nums[i]);
+    }
+
+    uint32_t j;
+    for (j = 0; j < have_num; j++) {
+      wuffs_base__rect_ie_u32 r =
+          wuffs_tiff__decoder__strip_or_tile_rect(&full_dec, j);
+      uint32_t rw = wuffs_base__rect_ie_u32__width(&r);
+      uint32_t rh = wuffs_base__rect_ie_u32__height(&r);
+      if ((rw == 0) || (rh == 0)) {
+        RETURN_FAIL("%s: rect #%" PRIu32 " is empty", filenames[i], j);
+      }
+
+      src.meta.ri = 0;
+      wuffs_tiff__decoder roi_dec;
+      CHECK_STATUS("initialize",
+                   wuffs_tiff__decoder__initialize(
+                       &roi_dec, sizeof roi_dec, WUFFS_VERSION,
+                       WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+      CHECK_STRING(
+          do_tiff_decode(&roi_dec, &ic, g_have_slice_u8, pixfmt, &r, &src));
+
+      uint32_t x;
+      uint32_t y;
+      for (y = 0; y < rh; y++) {
+        for (x = 0; x < rw; x++) {
+          uint32_t have = wuffs_base__peek_u32le__no_bounds_check(
+              g_have_slice_u8.ptr + (4 * (((size_t)y * rw) + x)));
+          uint32_t want = wuffs_base__peek_u32le__no_bounds_check(
+              g_want_slice_u8.ptr +
+              (4 * (((size_t)(y + r.min_incl_y) * width) +
+                    (x + r.min_incl_x))));
+          if (have != want) {
+            RETURN_FAIL("%s: rect #%" PRIu32 " (%" PRIu32 ", %" PRIu32
+                        "): have 0x%08" PRIX32 ", want 0x%08" PRIX32,
+                        filenames[i], j, x, y, have, want);
+          }
+        }
+      }
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_tiff_decode_roi() {
+  CHECK_FOCUS(__func__);
+
+  // This ROI is not aligned to the 64×64 tiles.
+  wuffs_base__rect_ie_u32 roi = wuffs_base__make_rect_ie_u32(37, 11, 101, 60);
+  wuffs_base__pixel_format pixfmt =
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL);
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, "test/data/bricks-color.tiled.lzw.tiff"));
+
+  wuffs_tiff__decoder full_dec;
+  CHECK_STATUS("initialize",
+               wuffs_tiff__decoder__initialize(
+                   &full_dec, sizeof full_dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_base__image_config ic = ((wuffs_base__image_config){});
+  CHECK_STRING(
+      do_tiff_decode(&full_dec, &ic, g_want_slice_u8, pixfmt, NULL, &src));
+  uint32_t width = wuffs_base__pixel_config__width(&ic.pixcfg);
+
+  src.meta.ri = 0;
+  wuffs_tiff__decoder roi_dec;
+  CHECK_STATUS("initialize",
+               wuffs_tiff__decoder__initialize(
+                   &roi_dec, sizeof roi_dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  CHECK_STRING(
+      do_tiff_decode(&roi_dec, &ic, g_have_slice_u8, pixfmt, &roi, &src));
+
+  uint32_t rw = wuffs_base__rect_ie_u32__width(&roi);
+  uint32_t rh = wuffs_base__rect_ie_u32__height(&roi);
+  uint32_t x;
+  uint32_t y;
+  for (y = 0; y < rh; y++) {
+    for (x = 0; x < rw; x++) {
+      uint32_t have = wuffs_base__peek_u32le__no_bounds_check(
+          g_have_slice_u8.ptr + (4 * (((size_t)y * rw) + x)));
+      uint32_t want = wuffs_base__peek_u32le__no_bounds_check(
+          g_want_slice_u8.ptr + (4 * (((size_t)(y + roi.min_incl_y) * width) +
+                                      (x + roi.min_incl_x))));
+      if (have != want) {
+        RETURN_FAIL("ROI (%" PRIu32 ", %" PRIu32 "): have 0x%08" PRIX32
+                    ", want 0x%08" PRIX32,
+                    x, y, have, want);
+      }
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_tiff_decode_truncated_input() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, "test/data/bricks-color.tiff"));
+  if (src.meta.wi < 20000) {
+    RETURN_FAIL("source file is too short");
+  }
+
+  // The IFD is at the end of the file. Decode it and then cut the file short,
+  // so that the strip's byte count extends past the end of the (closed) src.
+  wuffs_tiff__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_tiff__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_base__image_config ic = ((wuffs_base__image_config){});
+  CHECK_STRING(tiff_decode_image_config(&dec, &ic, &src));
+  wuffs_base__pixel_config__set(
+      &ic.pixcfg, WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+      WUFFS_BASE__PIXEL_SUBSAMPLING__NONE,
+      wuffs_base__pixel_config__width(&ic.pixcfg),
+      wuffs_base__pixel_config__height(&ic.pixcfg));
+  wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                     &pb, &ic.pixcfg, g_pixel_slice_u8));
+
+  src.meta.wi = 20000;
+  src.meta.closed = true;
+  const char* have_msg = tiff_decode_frame(&dec, &pb, &src, NULL);
+  if (!have_msg || !strstr(have_msg, wuffs_tiff__error__truncated_input + 1)) {
+    RETURN_FAIL("have \"%s\", want \"%s\"", have_msg,
+                wuffs_tiff__error__truncated_input);
+  }
+  return NULL;
+}
+
+// ---------------- TIFF Benches
+
+const char*  //
+bench_wuffs_tiff_decode_19k_8bpp() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &wuffs_tiff_decode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__Y), NULL, 0,
+      "test/data/bricks-gray.tiff", 0, SIZE_MAX, 1000);
+}
+
+const char*  //
+bench_wuffs_tiff_decode_77k_24bpp_lzw_tiled() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &wuffs_tiff_decode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      NULL, 0, "test/data/bricks-color.tiled.lzw.tiff", 0, SIZE_MAX, 200);
+}
+
+const char*  //
+bench_wuffs_tiff_decode_4002k_24bpp() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &wuffs_tiff_decode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      NULL, 0, "test/data/harvesters.tiff", 0, SIZE_MAX, 5);
+}
+
+// ---------------- Manifest
+
+proc g_tests[] = {
+
+    test_wuffs_tiff_decode_bad_header,
+    test_wuffs_tiff_decode_encodings,
+    test_wuffs_tiff_decode_interface,
+    test_wuffs_tiff_decode_matches_png,
+    test_wuffs_tiff_decode_roi,
+    test_wuffs_tiff_decode_strip_or_tile_rects,
+    test_wuffs_tiff_decode_truncated_input,
+
+    NULL,
+};
+
+proc g_benches[] = {
+
+    bench_wuffs_tiff_decode_19k_8bpp,
+    bench_wuffs_tiff_decode_77k_24bpp_lzw_tiled,
+    bench_wuffs_tiff_decode_4002k_24bpp,
+
+    NULL,
+};
+
+int  //
+main(int argc, char** argv) {
+  g_proc_package_name = "std/tiff";
+  return test_main(argc, argv, g_tests, g_benches);
+}
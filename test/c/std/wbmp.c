@@ -207,6 +207,485 @@ test_wuffs_pixel_buffer_fill_rect() {
   return NULL;
 }
 
+const char*  //
+test_wuffs_pixel_palette_finder() {
+  CHECK_FOCUS(__func__);
+
+  const size_t n = 4000;
+  if (g_src_slice_u8.len < (4 * n)) {
+    return "src buffer is too short";
+  }
+
+  const uint32_t pixfmt_reprs[] = {
+      WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_NONPREMUL,
+      WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_PREMUL,
+      WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_BINARY,
+  };
+  // Short palettes, including an empty one, are valid arguments.
+  const size_t palette_lens[] = {0, 4, 37 * 4, 1024};
+
+  // Fill a palette with pseudo-random values, including duplicate entries
+  // and a coarse grid of opaque entries (to exercise tie-breaking) and some
+  // opaque and transparent entries.
+  uint8_t palette[1024];
+  uint32_t rng = 0x12345678;
+  for (size_t i = 0; i < 1024; i++) {
+    rng = (rng * 1103515245) + 12345;
+    palette[i] = (uint8_t)(rng >> 16);
+    if (((i & 3) == 3) && ((rng >> 8) & 1)) {
+      palette[i] = ((rng >> 9) & 1) ? 0xFF : 0x00;
+    }
+  }
+  memcpy(palette + 400, palette + 40, 40);
+  for (size_t i = 64; i < 128; i++) {
+    palette[(4 * i) + 0] = (uint8_t)(0x40 * ((i >> 0) & 3));
+    palette[(4 * i) + 1] = (uint8_t)(0x40 * ((i >> 2) & 3));
+    palette[(4 * i) + 2] = (uint8_t)(0x40 * ((i >> 4) & 3));
+    palette[(4 * i) + 3] = 0xFF;
+  }
+
+  // The query colors are pseudo-random (often opaque, sometimes exactly
+  // between grid entries), plus runs of repeated colors and some of the
+  // palette colors themselves.
+  for (size_t i = 0; i < n; i++) {
+    rng = (rng * 1103515245) + 12345;
+    uint32_t c = (rng >> 16) | (rng << 16);
+    if ((rng >> 12) & 1) {
+      c |= 0xFF000000;
+      if ((rng >> 13) & 1) {
+        c &= 0xFFE0E0E0;
+      }
+    }
+    if ((i > 0) && ((rng >> 8) & 1)) {
+      c = wuffs_base__peek_u32le__no_bounds_check(g_src_slice_u8.ptr +
+                                                  (4 * (i - 1)));
+    } else if (i < 256) {
+      c = wuffs_base__peek_u32le__no_bounds_check(palette + (4 * i));
+    }
+    wuffs_base__poke_u32le__no_bounds_check(g_src_slice_u8.ptr + (4 * i), c);
+  }
+
+  uint8_t indexes[4000];
+  for (size_t p = 0; p < WUFFS_TESTLIB_ARRAY_SIZE(pixfmt_reprs); p++) {
+    for (size_t q = 0; q < WUFFS_TESTLIB_ARRAY_SIZE(palette_lens); q++) {
+      wuffs_base__pixel_format pixfmt =
+          wuffs_base__make_pixel_format(pixfmt_reprs[p]);
+      wuffs_base__slice_u8 palette_slice =
+          wuffs_base__make_slice_u8(palette, palette_lens[q]);
+
+      // The finder is too big to comfortably live on the stack.
+      static wuffs_base__pixel_palette_finder finder;
+      CHECK_STATUS("prepare", wuffs_base__pixel_palette_finder__prepare(
+                                  &finder, palette_slice, pixfmt));
+
+      uint64_t have_n = wuffs_base__pixel_palette_finder__closest_elements(
+          &finder, wuffs_base__make_slice_u8(indexes, n),
+          wuffs_base__make_slice_u8(g_src_slice_u8.ptr, 4 * n));
+      if (have_n != n) {
+        RETURN_FAIL("p=%zu, q=%zu: closest_elements: have %" PRIu64
+                    ", want %zu",
+                    p, q, have_n, n);
+      }
+
+      for (size_t i = 0; i < n; i++) {
+        uint32_t c = wuffs_base__peek_u32le__no_bounds_check(
+            g_src_slice_u8.ptr + (4 * i));
+        uint8_t want = wuffs_base__pixel_palette__closest_element(
+            palette_slice, pixfmt, c);
+        uint8_t have0 = indexes[i];
+        uint8_t have1 =
+            wuffs_base__pixel_palette_finder__closest_element(&finder, c);
+        if ((have0 != want) || (have1 != want)) {
+          RETURN_FAIL("p=%zu, q=%zu, c=0x%08" PRIX32
+                      ": have %d and %d, want %d",
+                      p, q, c, (int)have0, (int)have1, (int)want);
+        }
+      }
+    }
+  }
+  return NULL;
+}
+
+// do_test_wuffs_pixel_swizzler_simd swizzles n pseudo-random src pixels, with
+// a variety of row lengths, once per set of disabled CPU features, checking
+// that SIMD implementations (if any) give the same bytes as the scalar code.
+// A non-zero src_u16be_num_channels means that the src pixels are big-endian
+// 16-bit Y, YA, RGB or RGBA (as per
+// wuffs_base__pixel_swizzler__swizzle_interleaved_from_u16be_slice), not in
+// the src_pixfmt_repr format (which must then be 4X16LE).
+static const char*  //
+do_test_wuffs_pixel_swizzler_simd(uint32_t dst_pixfmt_repr,
+                                  uint32_t src_pixfmt_repr,
+                                  uint32_t src_u16be_num_channels,
+                                  size_t n) {
+  wuffs_base__pixel_format dst_pixfmt =
+      wuffs_base__make_pixel_format(dst_pixfmt_repr);
+  wuffs_base__pixel_format src_pixfmt =
+      wuffs_base__make_pixel_format(src_pixfmt_repr);
+  size_t dst_bpp = wuffs_base__pixel_format__bits_per_pixel(&dst_pixfmt) / 8;
+  size_t src_bpp = src_u16be_num_channels
+                       ? (2 * src_u16be_num_channels)
+                       : (wuffs_base__pixel_format__bits_per_pixel(&src_pixfmt) /
+                          8);
+  if ((g_have_slice_u8.len < (dst_bpp * n)) ||
+      (g_want_slice_u8.len < (dst_bpp * n)) ||
+      (g_src_slice_u8.len < (src_bpp * n))) {
+    return "buffers are too short";
+  }
+
+  uint32_t rng = 0x12345678;
+  for (size_t i = 0; i < (src_bpp * n); i++) {
+    rng = (rng * 1103515245) + 12345;
+    g_src_slice_u8.ptr[i] = (uint8_t)(rng >> 16);
+  }
+
+  // The first iteration, with every feature disabled, gives the scalar code's
+  // output, the want bytes. Disabling AVX2 (and AVX-512), but not SSE4.2,
+  // tests the SSE4.2 code on x86.
+  uint32_t disableds[] = {
+      WUFFS_BASE__CPU_ARCH__FEATURE__ALL,
+      WUFFS_BASE__CPU_ARCH__FEATURE__X86_AVX512 |
+          WUFFS_BASE__CPU_ARCH__FEATURE__X86_AVX2,
+      0,
+  };
+  for (size_t d = 0; d < WUFFS_TESTLIB_ARRAY_SIZE(disableds); d++) {
+    wuffs_base__cpu_arch__set_disabled_features(disableds[d]);
+    wuffs_base__pixel_swizzler swizzler;
+    CHECK_STATUS("prepare",
+                 wuffs_base__pixel_swizzler__prepare(
+                     &swizzler, dst_pixfmt, wuffs_base__empty_slice_u8(),
+                     src_pixfmt, wuffs_base__empty_slice_u8(),
+                     WUFFS_BASE__PIXEL_BLEND__SRC));
+
+    // Swizzle, with a variety of row lengths: some shorter than any SIMD
+    // loop's stride, some not a multiple of it and some longer than the
+    // 16-bit unpacking's (128 pixel) chunk.
+    uint8_t* dst_ptr = (d == 0) ? g_want_slice_u8.ptr : g_have_slice_u8.ptr;
+    memset(dst_ptr, 0, dst_bpp * n);
+    for (size_t i = 0, j = 0; i < n; i += j) {
+      j = 1 + ((i * 7) % 301);
+      if (j > (n - i)) {
+        j = n - i;
+      }
+      wuffs_base__slice_u8 dst =
+          wuffs_base__make_slice_u8(dst_ptr + (dst_bpp * i), dst_bpp * j);
+      wuffs_base__slice_u8 src = wuffs_base__make_slice_u8(
+          g_src_slice_u8.ptr + (src_bpp * i), src_bpp * j);
+      uint64_t m =
+          src_u16be_num_channels
+              ? wuffs_base__pixel_swizzler__swizzle_interleaved_from_u16be_slice(
+                    &swizzler, dst, wuffs_base__empty_slice_u8(), src,
+                    src_u16be_num_channels, j)
+              : wuffs_base__pixel_swizzler__swizzle_interleaved_from_slice(
+                    &swizzler, dst, wuffs_base__empty_slice_u8(), src);
+      if (m != j) {
+        RETURN_FAIL("dst=0x%08" PRIX32 ", src=0x%08" PRIX32
+                    ", d=%zu, i=%zu: num pixels: have %" PRIu64 ", want %zu",
+                    dst_pixfmt_repr, src_pixfmt_repr, d, i, m, j);
+      }
+    }
+
+    if (d == 0) {
+      continue;
+    }
+    for (size_t i = 0; i < (dst_bpp * n); i++) {
+      if (g_have_slice_u8.ptr[i] != g_want_slice_u8.ptr[i]) {
+        RETURN_FAIL("dst=0x%08" PRIX32 ", src=0x%08" PRIX32
+                    ", d=%zu: byte #%zu (pixel #%zu): have 0x%02" PRIX8
+                    ", want 0x%02" PRIX8,
+                    dst_pixfmt_repr, src_pixfmt_repr, d, i, i / dst_bpp,
+                    g_have_slice_u8.ptr[i], g_want_slice_u8.ptr[i]);
+      }
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_pixel_swizzler_simd_bit_exactness() {
+  CHECK_FOCUS(__func__);
+
+  // These conversions (to or from 16 bits per channel) have SSE4.2, AVX2 or
+  // NEON implementations. Odd lengths exercise their loop tails.
+  const size_t n = 1001;
+  const struct {
+    uint32_t dst_pixfmt_repr;
+    uint32_t src_pixfmt_repr;
+    uint32_t src_u16be_num_channels;
+  } test_cases[] = {
+      // Narrowing, with or without premultiplication.
+      {WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+       WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE, 0},
+      {WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+       WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE, 0},
+      {WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL,
+       WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE, 0},
+      {WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL,
+       WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE, 0},
+
+      // Widening.
+      {WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE,
+       WUFFS_BASE__PIXEL_FORMAT__BGR, 0},
+      {WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE,
+       WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL, 0},
+      {WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE,
+       WUFFS_BASE__PIXEL_FORMAT__BGRX, 0},
+      {WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE,
+       WUFFS_BASE__PIXEL_FORMAT__RGB, 0},
+
+      // Big-endian Y, YA, RGB and RGBA (as in 16-bit PNG images).
+      {WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+       WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE, 1},
+      {WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+       WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE, 2},
+      {WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL,
+       WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE, 3},
+      {WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+       WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE, 4},
+      {WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE,
+       WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE, 4},
+  };
+
+  const char* ret = NULL;
+  for (size_t tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(test_cases); tc++) {
+    ret = do_test_wuffs_pixel_swizzler_simd(
+        test_cases[tc].dst_pixfmt_repr, test_cases[tc].src_pixfmt_repr,
+        test_cases[tc].src_u16be_num_channels, n);
+    if (ret) {
+      break;
+    }
+  }
+  wuffs_base__cpu_arch__set_disabled_features(
+      g_flags.nosimd ? WUFFS_BASE__CPU_ARCH__FEATURE__ALL : 0);
+  return ret;
+}
+
+// src_conversion_want returns what swizzling the src_bpp-byte pixel s, from
+// src_pixfmt_repr to dst_pixfmt_repr, should give, as a BGRA or RGBA (per
+// dst_pixfmt_repr) u32le value. It only handles opaque or non-premultiplied
+// src pixels and BGR, RGB or 4-byte src or dst pixel formats.
+static uint32_t  //
+src_conversion_want(uint32_t dst_pixfmt_repr,
+                    uint32_t src_pixfmt_repr,
+                    const uint8_t* s) {
+  uint32_t argb = 0;
+  switch (src_pixfmt_repr) {
+    case WUFFS_BASE__PIXEL_FORMAT__BGR:
+      argb = 0xFF000000 | wuffs_base__peek_u24le__no_bounds_check(s);
+      break;
+    case WUFFS_BASE__PIXEL_FORMAT__RGB:
+      argb = wuffs_base__swap_u32_argb_abgr(
+          0xFF000000 | wuffs_base__peek_u24le__no_bounds_check(s));
+      break;
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
+      argb = wuffs_base__peek_u32le__no_bounds_check(s);
+      break;
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
+      argb = wuffs_base__swap_u32_argb_abgr(
+          wuffs_base__peek_u32le__no_bounds_check(s));
+      break;
+  }
+
+  bool src_nonpremul =
+      (src_pixfmt_repr == WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL) ||
+      (src_pixfmt_repr == WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL);
+  bool dst_premul =
+      (dst_pixfmt_repr == WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL) ||
+      (dst_pixfmt_repr == WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL);
+  if (src_nonpremul && dst_premul) {
+    argb = wuffs_base__color_u32_argb_nonpremul__as__color_u32_argb_premul(
+        argb);
+  }
+
+  if ((dst_pixfmt_repr == WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL) ||
+      (dst_pixfmt_repr == WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL)) {
+    return wuffs_base__swap_u32_argb_abgr(argb);
+  }
+  return argb;
+}
+
+const char*  //
+test_wuffs_pixel_swizzler_src_conversions() {
+  CHECK_FOCUS(__func__);
+
+  // These conversions have ARM NEON, WebAssembly SIMD128 or x86 SIMD
+  // implementations, some chosen at compile time. Instead of comparing them
+  // with the scalar code, check each pixel against src_conversion_want. Odd
+  // lengths exercise any SIMD implementation's loop tail.
+  //
+  // test/c/wasm_simd128/run-tests.sh runs this (and other tests) with the
+  // WebAssembly SIMD128 code.
+  const size_t n = 1001;
+  if ((g_have_slice_u8.len < (4 * n)) || (g_src_slice_u8.len < (4 * n))) {
+    return "buffers are too short";
+  }
+
+  const struct {
+    uint32_t dst_pixfmt_repr;
+    uint32_t src_pixfmt_repr;
+  } test_cases[] = {
+      {WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+       WUFFS_BASE__PIXEL_FORMAT__BGR},
+      {WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL,
+       WUFFS_BASE__PIXEL_FORMAT__BGR},
+      {WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,  //
+       WUFFS_BASE__PIXEL_FORMAT__RGB},
+      {WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL,  //
+       WUFFS_BASE__PIXEL_FORMAT__RGB},
+      {WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+       WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL},
+      {WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL,
+       WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL},
+      {WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL,
+       WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL},
+      {WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL,
+       WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL},
+      {WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+       WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL},
+      {WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+       WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL},
+      {WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL,
+       WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL},
+      {WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+       WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL},
+  };
+
+  uint32_t rng = 0x12345678;
+  for (size_t i = 0; i < (4 * n); i++) {
+    rng = (rng * 1103515245) + 12345;
+    g_src_slice_u8.ptr[i] = (uint8_t)(rng >> 16);
+  }
+
+  for (size_t tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(test_cases); tc++) {
+    wuffs_base__pixel_format dst_pixfmt =
+        wuffs_base__make_pixel_format(test_cases[tc].dst_pixfmt_repr);
+    wuffs_base__pixel_format src_pixfmt =
+        wuffs_base__make_pixel_format(test_cases[tc].src_pixfmt_repr);
+    size_t src_bpp = wuffs_base__pixel_format__bits_per_pixel(&src_pixfmt) / 8;
+
+    wuffs_base__pixel_swizzler swizzler;
+    CHECK_STATUS("prepare", wuffs_base__pixel_swizzler__prepare(
+                                &swizzler, dst_pixfmt,
+                                wuffs_base__empty_slice_u8(), src_pixfmt,
+                                wuffs_base__empty_slice_u8(),
+                                WUFFS_BASE__PIXEL_BLEND__SRC));
+
+    // Swizzle, with a variety of row lengths.
+    memset(g_have_slice_u8.ptr, 0, 4 * n);
+    for (size_t i = 0, j = 0; i < n; i += j) {
+      j = 1 + (i % 37);
+      if (j > (n - i)) {
+        j = n - i;
+      }
+      wuffs_base__pixel_swizzler__swizzle_interleaved_from_slice(
+          &swizzler,
+          wuffs_base__make_slice_u8(g_have_slice_u8.ptr + (4 * i), 4 * j),
+          wuffs_base__empty_slice_u8(),
+          wuffs_base__make_slice_u8(g_src_slice_u8.ptr + (src_bpp * i),
+                                    src_bpp * j));
+    }
+
+    for (size_t i = 0; i < n; i++) {
+      uint32_t want = src_conversion_want(test_cases[tc].dst_pixfmt_repr,
+                                          test_cases[tc].src_pixfmt_repr,
+                                          g_src_slice_u8.ptr + (src_bpp * i));
+      uint32_t have = wuffs_base__peek_u32le__no_bounds_check(
+          g_have_slice_u8.ptr + (4 * i));
+      if (have != want) {
+        RETURN_FAIL("tc=%zu, i=%zu: have 0x%08" PRIX32 ", want 0x%08" PRIX32,
+                    tc, i, have, want);
+      }
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_pixel_swizzler_src_over_premul_nonpremul() {
+  CHECK_FOCUS(__func__);
+
+  // Odd lengths exercise any SIMD implementation's loop tail.
+  const size_t n = 1001;
+  if ((g_have_slice_u8.len < (4 * n)) || (g_want_slice_u8.len < (4 * n)) ||
+      (g_src_slice_u8.len < (4 * n))) {
+    return "buffers are too short";
+  }
+
+  const uint32_t src_pixfmt_reprs[] = {
+      WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+      WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL,
+  };
+  const uint32_t dst_pixfmt_reprs[] = {
+      WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+      WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL,
+  };
+
+  // Fill the src and original dst pixels with pseudo-random values, with
+  // extra weight on the 0x00 and 0xFF alpha values. The dst pixels aren't
+  // necessarily valid premultiplied alpha.
+  uint32_t rng = 0x12345678;
+  for (size_t i = 0; i < (4 * n); i++) {
+    rng = (rng * 1103515245) + 12345;
+    g_src_slice_u8.ptr[i] = (uint8_t)(rng >> 16);
+    rng = (rng * 1103515245) + 12345;
+    g_want_slice_u8.ptr[i] = (uint8_t)(rng >> 16);
+    if (((i & 3) == 3) && ((rng >> 8) & 1)) {
+      g_src_slice_u8.ptr[i] = ((rng >> 9) & 1) ? 0xFF : 0x00;
+    }
+  }
+
+  for (size_t s = 0; s < WUFFS_TESTLIB_ARRAY_SIZE(src_pixfmt_reprs); s++) {
+    for (size_t d = 0; d < WUFFS_TESTLIB_ARRAY_SIZE(dst_pixfmt_reprs); d++) {
+      wuffs_base__pixel_swizzler swizzler;
+      CHECK_STATUS("prepare",
+                   wuffs_base__pixel_swizzler__prepare(
+                       &swizzler,
+                       wuffs_base__make_pixel_format(dst_pixfmt_reprs[d]),
+                       wuffs_base__empty_slice_u8(),
+                       wuffs_base__make_pixel_format(src_pixfmt_reprs[s]),
+                       wuffs_base__empty_slice_u8(),
+                       WUFFS_BASE__PIXEL_BLEND__SRC_OVER));
+
+      // Swizzle, with a variety of row lengths.
+      memcpy(g_have_slice_u8.ptr, g_want_slice_u8.ptr, 4 * n);
+      for (size_t i = 0, j = 0; i < n; i += j) {
+        j = 1 + (i % 37);
+        if (j > (n - i)) {
+          j = n - i;
+        }
+        wuffs_base__pixel_swizzler__swizzle_interleaved_from_slice(
+            &swizzler, wuffs_base__make_slice_u8(g_have_slice_u8.ptr + (4 * i),
+                                                 4 * j),
+            wuffs_base__empty_slice_u8(),
+            wuffs_base__make_slice_u8(g_src_slice_u8.ptr + (4 * i), 4 * j));
+      }
+
+      // Check each pixel against the scalar calculation.
+      bool swap = (s != d);
+      for (size_t i = 0; i < n; i++) {
+        uint32_t d0 = wuffs_base__peek_u32le__no_bounds_check(
+            g_want_slice_u8.ptr + (4 * i));
+        uint32_t s0 = wuffs_base__peek_u32le__no_bounds_check(
+            g_src_slice_u8.ptr + (4 * i));
+        if (swap) {
+          s0 = wuffs_base__swap_u32_argb_abgr(s0);
+        }
+        uint32_t want = wuffs_base__composite_premul_nonpremul_u32_axxx(d0, s0);
+        uint32_t have = wuffs_base__peek_u32le__no_bounds_check(
+            g_have_slice_u8.ptr + (4 * i));
+        if (have != want) {
+          RETURN_FAIL("s=%zu, d=%zu, i=%zu: have 0x%08" PRIX32
+                      ", want 0x%08" PRIX32,
+                      s, d, i, have, want);
+        }
+      }
+    }
+  }
+  return NULL;
+}
+
 const char*  //
 test_wuffs_pixel_swizzler_swizzle() {
   CHECK_FOCUS(__func__);
@@ -421,8 +900,109 @@ test_wuffs_pixel_swizzler_swizzle() {
   return NULL;
 }
 
+const char*  //
+test_wuffs_pixel_swizzler_swizzle_packed() {
+  CHECK_FOCUS(__func__);
+
+  // Odd lengths exercise any SIMD implementation's loop tail.
+  const size_t n = 1001;
+  if ((g_have_slice_u8.len < (n + 1)) || (g_want_slice_u8.len < n) ||
+      (g_src_slice_u8.len < n)) {
+    return "buffers are too short";
+  }
+  uint32_t x = 0x12345678;
+  for (size_t i = 0; i < n; i++) {
+    x = (x * 1103515245) + 12345;
+    g_src_slice_u8.ptr[i] = (uint8_t)(x >> 24);
+  }
+
+  // A Y to Y swizzler copies the unpacked bytes as is.
+  wuffs_base__pixel_swizzler swizzler;
+  CHECK_STATUS("prepare",
+               wuffs_base__pixel_swizzler__prepare(
+                   &swizzler,
+                   wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__Y),
+                   wuffs_base__empty_slice_u8(),
+                   wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__Y),
+                   wuffs_base__empty_slice_u8(), WUFFS_BASE__PIXEL_BLEND__SRC));
+
+  const uint32_t depths[3] = {1, 2, 4};
+  const uint32_t skips[4] = {0, 1, 3, 9};
+  const uint64_t num_pixels[4] = {0, 1, 37, n};
+  for (int d = 0; d < 3; d++) {
+    uint32_t depth = depths[d];
+    uint32_t mask = (1u << depth) - 1;
+    for (int scale = 0; scale < 2; scale++) {
+      for (int k = 0; k < 4; k++) {
+        for (int m = 0; m < 4; m++) {
+          // Pack no more pixels than n, so that the src slice is the limit
+          // for some of the larger num_pixels values.
+          size_t src_len = (n * depth) / 8;
+          uint64_t want_n = (src_len * 8 / depth) - skips[k];
+          if (want_n > num_pixels[m]) {
+            want_n = num_pixels[m];
+          }
+          for (size_t i = 0; i < want_n; i++) {
+            size_t bit = (skips[k] + i) * depth;
+            uint32_t v = mask & (g_src_slice_u8.ptr[bit / 8] >>
+                                 (8 - depth - (bit % 8)));
+            g_want_slice_u8.ptr[i] =
+                (uint8_t)(scale ? ((v * 0xFF) / mask) : v);
+          }
+          memset(g_have_slice_u8.ptr, 0xA5, n + 1);
+
+          uint64_t have_n =
+              wuffs_base__pixel_swizzler__swizzle_interleaved_from_packed_slice(
+                  &swizzler, wuffs_base__make_slice_u8(g_have_slice_u8.ptr, n),
+                  wuffs_base__empty_slice_u8(),
+                  wuffs_base__make_slice_u8(g_src_slice_u8.ptr, src_len),
+                  depth, skips[k], num_pixels[m], scale);
+          if (have_n != want_n) {
+            RETURN_FAIL("depth=%" PRIu32 ", scale=%d, skip=%" PRIu32
+                        ", num_pixels=%" PRIu64 ": have %" PRIu64
+                        " pixels, want %" PRIu64,
+                        depth, scale, skips[k], num_pixels[m], have_n, want_n);
+          }
+          for (size_t i = 0; i < want_n; i++) {
+            if (g_have_slice_u8.ptr[i] != g_want_slice_u8.ptr[i]) {
+              RETURN_FAIL("depth=%" PRIu32 ", scale=%d, skip=%" PRIu32
+                          ", num_pixels=%" PRIu64 ": pixel #%zu: have 0x%02X"
+                          ", want 0x%02X",
+                          depth, scale, skips[k], num_pixels[m], i,
+                          g_have_slice_u8.ptr[i], g_want_slice_u8.ptr[i]);
+            }
+          }
+          if (g_have_slice_u8.ptr[want_n] != 0xA5) {
+            RETURN_FAIL("depth=%" PRIu32 ", scale=%d, skip=%" PRIu32
+                        ", num_pixels=%" PRIu64 ": wrote past the end",
+                        depth, scale, skips[k], num_pixels[m]);
+          }
+        }
+      }
+    }
+  }
+  return NULL;
+}
+
 // ---------------- WBMP Tests
 
+const char*  //
+wuffs_wbmp_decode(uint64_t* n_bytes_out,
+                  wuffs_base__io_buffer* dst,
+                  uint32_t wuffs_initialize_flags,
+                  wuffs_base__pixel_format pixfmt,
+                  uint32_t* quirks_ptr,
+                  size_t quirks_len,
+                  wuffs_base__io_buffer* src) {
+  wuffs_wbmp__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_wbmp__decoder__initialize(&dec, sizeof dec, WUFFS_VERSION,
+                                               wuffs_initialize_flags));
+  return do_run__wuffs_base__image_decoder(
+      wuffs_wbmp__decoder__upcast_as__wuffs_base__image_decoder(&dec),
+      n_bytes_out, dst, pixfmt, quirks_ptr, quirks_len, src);
+}
+
 const char*  //
 test_wuffs_wbmp_decode_interface() {
   CHECK_FOCUS(__func__);
@@ -494,6 +1074,52 @@ test_wuffs_wbmp_decode_image_config() {
   return NULL;
 }
 
+const char*  //
+test_wuffs_wbmp_decode_roi() {
+  CHECK_FOCUS(__func__);
+  wuffs_wbmp__decoder full_dec;
+  CHECK_STATUS("initialize",
+               wuffs_wbmp__decoder__initialize(
+                   &full_dec, sizeof full_dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_wbmp__decoder roi_dec;
+  CHECK_STATUS("initialize",
+               wuffs_wbmp__decoder__initialize(
+                   &roi_dec, sizeof roi_dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  return do_test__wuffs_base__image_decoder_roi(
+      wuffs_wbmp__decoder__upcast_as__wuffs_base__image_decoder(&full_dec),
+      wuffs_wbmp__decoder__upcast_as__wuffs_base__image_decoder(&roi_dec),
+      "test/data/bricks-nodither.wbmp",
+      wuffs_base__make_rect_ie_u32(13, 7, 150, 1000), 5);
+}
+
+const char*  //
+test_wuffs_wbmp_decode_row_bands() {
+  CHECK_FOCUS(__func__);
+  const uint32_t band_heights[3] = {1, 7, 1000};
+
+  int j;
+  for (j = 0; j < 3; j++) {
+    wuffs_wbmp__decoder full_dec;
+    CHECK_STATUS("initialize",
+                 wuffs_wbmp__decoder__initialize(
+                     &full_dec, sizeof full_dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_wbmp__decoder band_dec;
+    CHECK_STATUS("initialize",
+                 wuffs_wbmp__decoder__initialize(
+                     &band_dec, sizeof band_dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    CHECK_STRING(do_test__wuffs_base__image_decoder_row_bands(
+        wuffs_wbmp__decoder__upcast_as__wuffs_base__image_decoder(&full_dec),
+        wuffs_wbmp__decoder__upcast_as__wuffs_base__image_decoder(&band_dec),
+        "test/data/bricks-nodither.wbmp", wuffs_base__make_rect_ie_u32(13, 7, 150, 1000),
+        band_heights[j], 5));
+  }
+  return NULL;
+}
+
 // ---------------- Mimic Tests
 
 #ifdef WUFFS_MIMIC
@@ -567,6 +1193,85 @@ do_bench_wuffs_pixel_swizzler(uint32_t dst_pixfmt_repr,
   return NULL;
 }
 
+const char*  //
+do_bench_wuffs_pixel_palette_closest_element(bool use_finder,
+                                             uint64_t iters_unscaled) {
+  const uint32_t width = 80;
+  const uint32_t height = 60;
+  if ((g_src_slice_u8.len < (4 * width * height)) ||
+      (g_have_slice_u8.len < (width * height))) {
+    return "buffers are too short";
+  }
+
+  // The palette is a 6x6x6 color cube plus a ramp of 40 grays, similar to
+  // many "web safe" palettes. The src pixels are a pseudo-random mixture of
+  // smooth gradients and noise.
+  uint8_t palette[1024];
+  for (uint32_t i = 0; i < 256; i++) {
+    uint32_t b = (i < 216) ? (51 * (i % 6)) : (((i - 216) * 255) / 39);
+    uint32_t g = (i < 216) ? (51 * ((i / 6) % 6)) : b;
+    uint32_t r = (i < 216) ? (51 * (i / 36)) : b;
+    palette[(4 * i) + 0] = (uint8_t)b;
+    palette[(4 * i) + 1] = (uint8_t)g;
+    palette[(4 * i) + 2] = (uint8_t)r;
+    palette[(4 * i) + 3] = 0xFF;
+  }
+  uint32_t rng = 0x12345678;
+  for (uint32_t y = 0; y < height; y++) {
+    for (uint32_t x = 0; x < width; x++) {
+      rng = (rng * 1103515245) + 12345;
+      uint32_t c = 0xFF000000 | ((4 * y) << 16) | ((3 * x) << 8) | (rng >> 24);
+      if (((rng >> 16) & 7) == 0) {
+        c = 0xFF000000 | (rng >> 8);
+      }
+      wuffs_base__poke_u32le__no_bounds_check(
+          g_src_slice_u8.ptr + (4 * ((width * y) + x)), c);
+    }
+  }
+  wuffs_base__slice_u8 palette_slice = wuffs_base__make_slice_u8(palette, 1024);
+  wuffs_base__pixel_format pixfmt = wuffs_base__make_pixel_format(
+      WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_NONPREMUL);
+
+  // The finder is too big to comfortably live on the stack.
+  static WUFFS_TESTLIB_THREAD_LOCAL wuffs_base__pixel_palette_finder finder;
+  CHECK_STATUS("prepare", wuffs_base__pixel_palette_finder__prepare(
+                              &finder, palette_slice, pixfmt));
+
+  bench_start();
+  uint64_t n_bytes = 0;
+  uint64_t iters = iters_unscaled * g_flags.iterscale;
+  for (uint64_t i = 0; i < iters; i++) {
+    if (use_finder) {
+      wuffs_base__pixel_palette_finder__closest_elements(
+          &finder,
+          wuffs_base__make_slice_u8(g_have_slice_u8.ptr, width * height),
+          wuffs_base__make_slice_u8(g_src_slice_u8.ptr, 4 * width * height));
+    } else {
+      for (size_t j = 0; j < (width * height); j++) {
+        g_have_slice_u8.ptr[j] = wuffs_base__pixel_palette__closest_element(
+            palette_slice, pixfmt,
+            wuffs_base__peek_u32le__no_bounds_check(g_src_slice_u8.ptr +
+                                                    (4 * j)));
+      }
+    }
+    n_bytes += width * height;
+  }
+  bench_finish(iters, n_bytes);
+  return NULL;
+}
+
+const char*  //
+bench_wuffs_pixel_palette_closest_element() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_pixel_palette_closest_element(false, 1);
+}
+
+const char*  //
+bench_wuffs_pixel_palette_finder_closest_elements() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_pixel_palette_closest_element(true, 10);
+}
+
 const char*  //
 bench_wuffs_pixel_swizzler_bgr_565_rgba_nonpremul_src() {
   CHECK_FOCUS(__func__);
@@ -632,6 +1337,15 @@ bench_wuffs_pixel_swizzler_bgra_premul_rgba_nonpremul_src_over() {
                                        WUFFS_BASE__PIXEL_BLEND__SRC_OVER, 300);
 }
 
+const char*  //
+bench_wuffs_wbmp_decode_2k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &wuffs_wbmp_decode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      NULL, 0, "test/data/bricks-nodither.wbmp", 0, SIZE_MAX, 1000);
+}
+
 // ---------------- Mimic Benches
 
 #ifdef WUFFS_MIMIC
@@ -648,11 +1362,18 @@ proc g_tests[] = {
     // base library. They aren't specific to the std/wbmp code, but putting
     // them here is as good as any other place.
     test_wuffs_pixel_buffer_fill_rect,
+    test_wuffs_pixel_palette_finder,
+    test_wuffs_pixel_swizzler_simd_bit_exactness,
+    test_wuffs_pixel_swizzler_src_conversions,
+    test_wuffs_pixel_swizzler_src_over_premul_nonpremul,
     test_wuffs_pixel_swizzler_swizzle,
+    test_wuffs_pixel_swizzler_swizzle_packed,
 
     test_wuffs_wbmp_decode_frame_config,
     test_wuffs_wbmp_decode_image_config,
     test_wuffs_wbmp_decode_interface,
+    test_wuffs_wbmp_decode_roi,
+    test_wuffs_wbmp_decode_row_bands,
 
 #ifdef WUFFS_MIMIC
 
@@ -665,6 +1386,8 @@ proc g_tests[] = {
 
 proc g_benches[] = {
 
+    bench_wuffs_pixel_palette_closest_element,
+    bench_wuffs_pixel_palette_finder_closest_elements,
     bench_wuffs_pixel_swizzler_bgr_565_rgba_nonpremul_src,
     bench_wuffs_pixel_swizzler_bgr_rgba_nonpremul_src,
     bench_wuffs_pixel_swizzler_bgra_nonpremul_rgba_nonpremul_src,
@@ -674,6 +1397,8 @@ proc g_benches[] = {
     bench_wuffs_pixel_swizzler_bgra_premul_rgba_nonpremul_src,
     bench_wuffs_pixel_swizzler_bgra_premul_rgba_nonpremul_src_over,
 
+    bench_wuffs_wbmp_decode_2k,
+
 #ifdef WUFFS_MIMIC
 
 // No mimic benches.
@@ -0,0 +1,440 @@
+// Copyright 2022 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ----------------
+
+/*
+This test program is typically run indirectly, by the "wuffs test" or "wuffs
+bench" commands. These commands take an optional "-mimic" flag to check that
+Wuffs' output mimics (i.e. exactly matches) other libraries' output, such as
+giflib for GIF, libpng for PNG, etc.
+
+To manually run this test:
+
+for CC in clang gcc; do
+  $CC -std=c99 -Wall -Werror webp.c && ./a.out
+  rm -f a.out
+done
+
+Each edition should print "PASS", amongst other information, and exit(0).
+
+Add the "wuffs mimic cflags" (everything after the colon below) to the C
+compiler flags (after the .c file) to run the mimic tests.
+
+To manually run the benchmarks, replace "-Wall -Werror" with "-O3" and replace
+the first "./a.out" with "./a.out -bench". Combine these changes with the
+"wuffs mimic cflags" to run the mimic benchmarks.
+*/
+
+// ¿ wuffs mimic cflags: -DWUFFS_MIMIC -lwebp
+
+// Wuffs ships as a "single file C library" or "header file library" as per
+// https://github.com/nothings/stb/blob/master/docs/stb_howto.txt
+//
+// To use that single file as a "foo.c"-like implementation, instead of a
+// "foo.h"-like header, #define WUFFS_IMPLEMENTATION before #include'ing or
+// compiling it.
+#define WUFFS_IMPLEMENTATION
+
+// Defining the WUFFS_CONFIG__MODULE* macros are optional, but it lets users of
+// release/c/etc.c choose which parts of Wuffs to build. That file contains the
+// entire Wuffs standard library, implementing a variety of codecs and file
+// formats. Without this macro definition, an optimizing compiler or linker may
+// very well discard Wuffs code for unused codecs, but listing the Wuffs
+// modules we use makes that process explicit. Preprocessing means that such
+// code simply isn't compiled.
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__BASE
+#define WUFFS_CONFIG__MODULE__WEBP
+
+// If building this program in an environment that doesn't easily accommodate
+// relative includes, you can use the script/inline-c-relative-includes.go
+// program to generate a stand-alone C file.
+#include "../../../release/c/wuffs-unsupported-snapshot.c"
+#include "../testlib/testlib.c"
+#ifdef WUFFS_MIMIC
+#include "../mimiclib/webp.c"
+#endif
+
+// ---------------- WebP Tests
+
+const char*  //
+wuffs_webp_decode(uint64_t* n_bytes_out,
+                  wuffs_base__io_buffer* dst,
+                  uint32_t wuffs_initialize_flags,
+                  wuffs_base__pixel_format pixfmt,
+                  uint32_t* quirks_ptr,
+                  size_t quirks_len,
+                  wuffs_base__io_buffer* src) {
+  wuffs_webp__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_webp__decoder__initialize(&dec, sizeof dec, WUFFS_VERSION,
+                                               wuffs_initialize_flags));
+  return do_run__wuffs_base__image_decoder(
+      wuffs_webp__decoder__upcast_as__wuffs_base__image_decoder(&dec),
+      n_bytes_out, dst, pixfmt, quirks_ptr, quirks_len, src);
+}
+
+const char*  //
+test_wuffs_webp_decode_interface() {
+  CHECK_FOCUS(__func__);
+
+  const char* filenames[3] = {
+      "test/data/bricks-color.lossless.webp",
+      "test/data/bricks-dither.lossless.webp",
+      "test/data/bricks-gray.lossless.webp",
+  };
+  const wuffs_base__color_u32_argb_premul want_final_pixels[3] = {
+      0xFF022460,
+      0xFF012463,
+      0xFF060606,
+  };
+
+  int i;
+  for (i = 0; i < 3; i++) {
+    wuffs_webp__decoder dec;
+    CHECK_STATUS("initialize",
+                 wuffs_webp__decoder__initialize(
+                     &dec, sizeof dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    CHECK_STRING(do_test__wuffs_base__image_decoder(
+        wuffs_webp__decoder__upcast_as__wuffs_base__image_decoder(&dec),
+        filenames[i], 0, SIZE_MAX, 160, 120, want_final_pixels[i]));
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_webp_decode_bad_header() {
+  CHECK_FOCUS(__func__);
+
+  // A PNG file is not a WebP file.
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, "test/data/bricks-color.png"));
+
+  wuffs_webp__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_webp__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_base__image_config ic = ((wuffs_base__image_config){});
+  wuffs_base__status status =
+      wuffs_webp__decoder__decode_image_config(&dec, &ic, &src);
+  if (status.repr != wuffs_webp__error__bad_header) {
+    RETURN_FAIL("decode_image_config: have \"%s\", want \"%s\"",
+                status.repr, wuffs_webp__error__bad_header);
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_webp_decode_lossy() {
+  CHECK_FOCUS(__func__);
+
+  // Lossy (VP8) WebP files are not supported.
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, "test/data/bricks-color.lossy.webp"));
+
+  wuffs_webp__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_webp__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_base__image_config ic = ((wuffs_base__image_config){});
+  wuffs_base__status status =
+      wuffs_webp__decoder__decode_image_config(&dec, &ic, &src);
+  if (status.repr != wuffs_webp__error__unsupported_webp_file) {
+    RETURN_FAIL("decode_image_config: have \"%s\", want \"%s\"",
+                status.repr, wuffs_webp__error__unsupported_webp_file);
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_webp_decode_truncated_input() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, "test/data/bricks-color.lossless.webp"));
+  if (src.meta.wi < 20000) {
+    RETURN_FAIL("source file is too short");
+  }
+  src.meta.wi = 20000;
+
+  wuffs_webp__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_webp__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+  const char* have_msg = do_run__wuffs_base__image_decoder(
+      wuffs_webp__decoder__upcast_as__wuffs_base__image_decoder(&dec), NULL,
+      &have, wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL),
+      NULL, 0, &src);
+  if (!have_msg ||
+      !strstr(have_msg, wuffs_webp__error__truncated_input + 1)) {
+    RETURN_FAIL("have \"%s\", want \"%s\"", have_msg,
+                wuffs_webp__error__truncated_input);
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_webp_decode_roi() {
+  CHECK_FOCUS(__func__);
+
+  // These cover the predictor, color, subtract green and color indexing
+  // transforms.
+  const char* filenames[3] = {
+      "test/data/bricks-color.lossless.webp",
+      "test/data/bricks-dither.lossless.webp",
+      "test/data/bricks-gray.lossless.webp",
+  };
+
+  int i;
+  for (i = 0; i < 3; i++) {
+    wuffs_webp__decoder full_dec;
+    CHECK_STATUS("initialize",
+                 wuffs_webp__decoder__initialize(
+                     &full_dec, sizeof full_dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_webp__decoder roi_dec;
+    CHECK_STATUS("initialize",
+                 wuffs_webp__decoder__initialize(
+                     &roi_dec, sizeof roi_dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    CHECK_STRING(do_test__wuffs_base__image_decoder_roi(
+        wuffs_webp__decoder__upcast_as__wuffs_base__image_decoder(&full_dec),
+        wuffs_webp__decoder__upcast_as__wuffs_base__image_decoder(&roi_dec),
+        filenames[i], wuffs_base__make_rect_ie_u32(37, 11, 101, 60), 41));
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_webp_decode_row_bands() {
+  CHECK_FOCUS(__func__);
+
+  // These cover the predictor, color, subtract green and color indexing
+  // transforms.
+  const char* filenames[3] = {
+      "test/data/bricks-color.lossless.webp",
+      "test/data/bricks-dither.lossless.webp",
+      "test/data/bricks-gray.lossless.webp",
+  };
+  const uint32_t band_heights[3] = {1, 7, 1000};
+
+  int i;
+  for (i = 0; i < 3; i++) {
+    int j;
+    for (j = 0; j < 3; j++) {
+      wuffs_webp__decoder full_dec;
+      CHECK_STATUS("initialize",
+                   wuffs_webp__decoder__initialize(
+                       &full_dec, sizeof full_dec, WUFFS_VERSION,
+                       WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+      wuffs_webp__decoder band_dec;
+      CHECK_STATUS("initialize",
+                   wuffs_webp__decoder__initialize(
+                       &band_dec, sizeof band_dec, WUFFS_VERSION,
+                       WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+      CHECK_STRING(do_test__wuffs_base__image_decoder_row_bands(
+          wuffs_webp__decoder__upcast_as__wuffs_base__image_decoder(&full_dec),
+          wuffs_webp__decoder__upcast_as__wuffs_base__image_decoder(&band_dec),
+          filenames[i], wuffs_base__make_rect_ie_u32(37, 11, 101, 60),
+          band_heights[j], 41));
+    }
+  }
+  return NULL;
+}
+
+// ---------------- Mimic Tests
+
+#ifdef WUFFS_MIMIC
+
+const char*  //
+do_test_mimic_webp_decode(const char* filename) {
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, filename));
+
+  wuffs_base__pixel_format pixfmt =
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL);
+
+  src.meta.ri = 0;
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+  CHECK_STRING(wuffs_webp_decode(NULL, &have, WUFFS_INITIALIZE__DEFAULT_OPTIONS,
+                                 pixfmt, NULL, 0, &src));
+
+  src.meta.ri = 0;
+  wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+      .data = g_want_slice_u8,
+  });
+  CHECK_STRING(mimic_webp_decode(NULL, &want, WUFFS_INITIALIZE__DEFAULT_OPTIONS,
+                                 pixfmt, NULL, 0, &src));
+
+  return check_io_buffers_equal("", &have, &want);
+}
+
+const char*  //
+test_mimic_webp_decode_77k_32bpp_gray() {
+  CHECK_FOCUS(__func__);
+  return do_test_mimic_webp_decode("test/data/bricks-gray.lossless.webp");
+}
+
+const char*  //
+test_mimic_webp_decode_77k_32bpp_nodither() {
+  CHECK_FOCUS(__func__);
+  return do_test_mimic_webp_decode("test/data/bricks-nodither.lossless.webp");
+}
+
+const char*  //
+test_mimic_webp_decode_77k_32bpp_color() {
+  CHECK_FOCUS(__func__);
+  return do_test_mimic_webp_decode("test/data/bricks-color.lossless.webp");
+}
+
+const char*  //
+test_mimic_webp_decode_552k_32bpp() {
+  CHECK_FOCUS(__func__);
+  return do_test_mimic_webp_decode("test/data/hibiscus.regular.lossless.webp");
+}
+
+const char*  //
+test_mimic_webp_decode_4002k_32bpp() {
+  CHECK_FOCUS(__func__);
+  return do_test_mimic_webp_decode("test/data/harvesters.lossless.webp");
+}
+
+#endif  // WUFFS_MIMIC
+
+// ---------------- WebP Benches
+
+const char*  //
+bench_wuffs_webp_decode_77k_32bpp() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &wuffs_webp_decode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      NULL, 0, "test/data/bricks-color.lossless.webp", 0, SIZE_MAX, 200);
+}
+
+const char*  //
+bench_wuffs_webp_decode_552k_32bpp() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &wuffs_webp_decode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      NULL, 0, "test/data/hibiscus.regular.lossless.webp", 0, SIZE_MAX, 30);
+}
+
+const char*  //
+bench_wuffs_webp_decode_4002k_32bpp() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &wuffs_webp_decode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      NULL, 0, "test/data/harvesters.lossless.webp", 0, SIZE_MAX, 5);
+}
+
+// ---------------- Mimic Benches
+
+#ifdef WUFFS_MIMIC
+
+const char*  //
+bench_mimic_webp_decode_77k_32bpp() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &mimic_webp_decode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      NULL, 0, "test/data/bricks-color.lossless.webp", 0, SIZE_MAX, 200);
+}
+
+const char*  //
+bench_mimic_webp_decode_552k_32bpp() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &mimic_webp_decode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      NULL, 0, "test/data/hibiscus.regular.lossless.webp", 0, SIZE_MAX, 30);
+}
+
+const char*  //
+bench_mimic_webp_decode_4002k_32bpp() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &mimic_webp_decode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      NULL, 0, "test/data/harvesters.lossless.webp", 0, SIZE_MAX, 5);
+}
+
+#endif  // WUFFS_MIMIC
+
+// ---------------- Manifest
+
+proc g_tests[] = {
+
+    test_wuffs_webp_decode_bad_header,
+    test_wuffs_webp_decode_interface,
+    test_wuffs_webp_decode_lossy,
+    test_wuffs_webp_decode_roi,
+    test_wuffs_webp_decode_row_bands,
+    test_wuffs_webp_decode_truncated_input,
+
+#ifdef WUFFS_MIMIC
+
+    test_mimic_webp_decode_552k_32bpp,
+    test_mimic_webp_decode_4002k_32bpp,
+    test_mimic_webp_decode_77k_32bpp_color,
+    test_mimic_webp_decode_77k_32bpp_gray,
+    test_mimic_webp_decode_77k_32bpp_nodither,
+
+#endif  // WUFFS_MIMIC
+
+    NULL,
+};
+
+proc g_benches[] = {
+
+    bench_wuffs_webp_decode_77k_32bpp,
+    bench_wuffs_webp_decode_552k_32bpp,
+    bench_wuffs_webp_decode_4002k_32bpp,
+
+#ifdef WUFFS_MIMIC
+
+    bench_mimic_webp_decode_77k_32bpp,
+    bench_mimic_webp_decode_552k_32bpp,
+    bench_mimic_webp_decode_4002k_32bpp,
+
+#endif  // WUFFS_MIMIC
+
+    NULL,
+};
+
+int  //
+main(int argc, char** argv) {
+  g_proc_package_name = "std/webp";
+  return test_main(argc, argv, g_tests, g_benches);
+}
@@ -0,0 +1,318 @@
+// Copyright 2026 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ----------------
+
+/*
+This test program is typically run indirectly, by the "wuffs test" or "wuffs
+bench" commands. These commands take an optional "-mimic" flag to check that
+Wuffs' output mimics (i.e. exactly matches) other libraries' output, such as
+giflib for GIF, libpng for PNG, etc.
+
+To manually run this test:
+
+for CC in clang gcc; do
+  $CC -std=c99 -Wall -Werror xxh3.c && ./a.out
+  rm -f a.out
+done
+
+Each edition should print "PASS", amongst other information, and exit(0).
+
+Add the "wuffs mimic cflags" (everything after the colon below) to the C
+compiler flags (after the .c file) to run the mimic tests.
+
+To manually run the benchmarks, replace "-Wall -Werror" with "-O3" and replace
+the first "./a.out" with "./a.out -bench". Combine these changes with the
+"wuffs mimic cflags" to run the mimic benchmarks.
+*/
+
+// ¿ wuffs mimic cflags: -DWUFFS_MIMIC
+
+// Wuffs ships as a "single file C library" or "header file library" as per
+// https://github.com/nothings/stb/blob/master/docs/stb_howto.txt
+//
+// To use that single file as a "foo.c"-like implementation, instead of a
+// "foo.h"-like header, #define WUFFS_IMPLEMENTATION before #include'ing or
+// compiling it.
+#define WUFFS_IMPLEMENTATION
+
+// Defining the WUFFS_CONFIG__MODULE* macros are optional, but it lets users of
+// release/c/etc.c choose which parts of Wuffs to build. That file contains the
+// entire Wuffs standard library, implementing a variety of codecs and file
+// formats. Without this macro definition, an optimizing compiler or linker may
+// very well discard Wuffs code for unused codecs, but listing the Wuffs
+// modules we use makes that process explicit. Preprocessing means that such
+// code simply isn't compiled.
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__BASE
+#define WUFFS_CONFIG__MODULE__XXH3
+
+// If building this program in an environment that doesn't easily accommodate
+// relative includes, you can use the script/inline-c-relative-includes.go
+// program to generate a stand-alone C file.
+#include "../../../release/c/wuffs-unsupported-snapshot.c"
+#include "../testlib/testlib.c"
+
+// ---------------- Golden Tests
+
+golden_test g_xxh3_midsummer_gt = {
+    .src_filename = "test/data/midsummer.txt",
+};
+
+golden_test g_xxh3_pi_gt = {
+    .src_filename = "test/data/pi.txt",
+};
+
+// ---------------- XXH3 Tests
+
+const char*  //
+test_wuffs_xxh3_interface() {
+  CHECK_FOCUS(__func__);
+  wuffs_xxh3__hasher h;
+  CHECK_STATUS("initialize",
+               wuffs_xxh3__hasher__initialize(
+                   &h, sizeof h, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  return do_test__wuffs_base__hasher_u64(
+      wuffs_xxh3__hasher__upcast_as__wuffs_base__hasher_u64(&h),
+      "test/data/hat.lossy.webp", 0, SIZE_MAX, 0x5F72FD58A3DE3ED8);
+}
+
+const char*  //
+test_wuffs_xxh3_golden() {
+  CHECK_FOCUS(__func__);
+
+  struct {
+    const char* filename;
+    // The want values were calculated by the XXH3_64bits function in the
+    // xxHash C library.
+    uint64_t want;
+  } test_cases[] = {
+      {
+          .filename = "test/data/hat.bmp",
+          .want = 0xC0AD03760F054D17,
+      },
+      {
+          .filename = "test/data/hat.gif",
+          .want = 0xA2604E8BB6057BAB,
+      },
+      {
+          .filename = "test/data/hat.jpeg",
+          .want = 0x1E409C8901A80D9A,
+      },
+      {
+          .filename = "test/data/hat.lossless.webp",
+          .want = 0x5029724ACBD121D1,
+      },
+      {
+          .filename = "test/data/hat.lossy.webp",
+          .want = 0x5F72FD58A3DE3ED8,
+      },
+      {
+          .filename = "test/data/hat.png",
+          .want = 0x494B75126784E2EB,
+      },
+      {
+          .filename = "test/data/hat.tiff",
+          .want = 0xE70660EA08C37E46,
+      },
+      {
+          .filename = "test/data/hat.wbmp",
+          .want = 0xA927F41D3689EEBF,
+      },
+  };
+
+  for (size_t tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(test_cases); tc++) {
+    wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+        .data = g_src_slice_u8,
+    });
+    CHECK_STRING(read_file(&src, test_cases[tc].filename));
+
+    // j == 0 hashes the whole file at once. j == 1 and j == 2 hash it in
+    // fragments, large and small, that straddle the 64 byte stripe and 256
+    // byte internal buffer boundaries.
+    for (int j = 0; j < 3; j++) {
+      wuffs_xxh3__hasher checksum;
+      CHECK_STATUS("initialize",
+                   wuffs_xxh3__hasher__initialize(
+                       &checksum, sizeof checksum, WUFFS_VERSION,
+                       WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+
+      uint64_t have = 0;
+      size_t num_fragments = 0;
+      size_t num_bytes = 0;
+      do {
+        wuffs_base__slice_u8 data = ((wuffs_base__slice_u8){
+            .ptr = src.data.ptr + num_bytes,
+            .len = src.meta.wi - num_bytes,
+        });
+        size_t limit = (j == 1) ? (101 + 103 * num_fragments)
+                                : (1 + ((7 * num_fragments) % 13));
+        if ((j > 0) && (data.len > limit)) {
+          data.len = limit;
+        }
+        have = wuffs_xxh3__hasher__update_u64(&checksum, data);
+        num_fragments++;
+        num_bytes += data.len;
+      } while (num_bytes < src.meta.wi);
+
+      if (have != test_cases[tc].want) {
+        RETURN_FAIL("tc=%zu, j=%d, filename=\"%s\": have 0x%016" PRIX64
+                    ", want 0x%016" PRIX64 "\n",
+                    tc, j, test_cases[tc].filename, have, test_cases[tc].want);
+      }
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_xxh3_pi() {
+  CHECK_FOCUS(__func__);
+
+  const char* digits =
+      "3."
+      "141592653589793238462643383279502884197169399375105820974944592307816406"
+      "2862089986280348253421170";
+  if (strlen(digits) != 99) {
+    RETURN_FAIL("strlen(digits): have %d, want 99", (int)(strlen(digits)));
+  }
+
+  // The want values were calculated by the XXH3_64bits function in the
+  // xxHash C library.
+  //
+  // wants[i] is the checksum of the first i bytes of the digits string.
+  uint64_t wants[100] = {
+      0x2D06800538D394C2, 0x7324DC1E7E9474F0, 0x8886D6BF3B0A7C7B,
+      0x4E6941FDB8BA7C63, 0xC00A0804D15B22E1, 0x7978E08B46296EFD,
+      0x4D955429C7BE62D4, 0xBE806D59F2D89101, 0xC481AD1D299251AA,
+      0xF5A7C4193960031C, 0xB8449D22E3D5D58D, 0x89226ECAEB7DCBE8,
+      0x38B71C8DF24E269E, 0x555F208142886CFC, 0xCD2F68936E77990E,
+      0x4FB335222CBD0AF8, 0x3DB27B9FCF3CFF63, 0xAEB1973A52431612,
+      0x3A255F4A0E4C06C9, 0x49CF1956A78557F1, 0x3B4112EEF36AFE7B,
+      0xF478CA314DBE1FB2, 0x18535B287BF129FA, 0x6DC473784FFD9DBC,
+      0xECED8921D04E7D4C, 0xF7D9A82CBBE97D86, 0x1A45C575FACC6384,
+      0xBDEC6283ACA393CE, 0xD9750785F2354D8B, 0x44B4F3830FC58E19,
+      0x3BD1A7CE0B46E9ED, 0x7D344AF235E8F8C2, 0x26F8C1874D0F6BFA,
+      0xD2FBA7EBB2F946EF, 0xD9A98C8C94123F01, 0x7C81528D54864762,
+      0x80090BA5A8B37297, 0xF93F896BB4DC5F58, 0x00B360D64853932E,
+      0xBF218883CE6D0C59, 0x75BEFF91D546BD10, 0xDC57AC4C92CDA3D1,
+      0x8A621DEE79F27FCA, 0x6EB003EE70C082EC, 0x91782FF595BFDC01,
+      0x13FC237044A6FC5B, 0x44063E24C0392369, 0xD1B7CD608C87A440,
+      0xA1F58B236D32A3CE, 0xB714E1D1A375E867, 0x8CCE7033AEEAA2AB,
+      0xDD5DBC36553AD1C6, 0xE2F8FFCD4933F182, 0x7A5DAED72591853A,
+      0x7DD185E81BFBD9B4, 0x774A26852CA46AC3, 0xDF32B7379F4D1E04,
+      0xDE750AE8CB764163, 0xBC9DDCCC74AA5960, 0xF950738959D64126,
+      0x74159FEB48385D76, 0xBA5931E4A6FFA7C8, 0x8B64229445A7B565,
+      0x96CDB72B9F8AC6F4, 0x80E3CA367D24257D, 0xFB48124625C03A7C,
+      0x2561158EE6A3EC4D, 0xE2846E9823DDB9F9, 0xC1006B6703C3BFDF,
+      0x0D8C0995B1837D82, 0xE10030741CE131A1, 0x47BB0E582F8030A3,
+      0xDD4E79E44C7F4A69, 0xAE3FA62E8C35A017, 0x039A1D83B997B51D,
+      0x4734273D3F9638F4, 0xB35ED5B35DB91EE3, 0x5FF85948CC0F1728,
+      0x0308636C9CF3E7F5, 0x6C0DAFF6F19069ED, 0xA7B7FFB4C06C8C9A,
+      0x21E1EB2515DA7C5E, 0x96CE3D927F7DBDED, 0xA9D0E5118C679D81,
+      0x5E974C44465066C7, 0x19A1206AF4FB51E8, 0xA30B7FDFBDF679A7,
+      0xD6B1B95FD8DFCC43, 0xC3F231E7EEC9868F, 0x0DD2F8B21B80B0ED,
+      0xAB57E0255CAFB542, 0xDBC89E08F5092DC5, 0xEFAB899977773BA5,
+      0x6537E77144FDB037, 0x88A7AB207BA0E2CE, 0xEAAB9B8AA670F62F,
+      0x724603E05394BB49, 0x3A4AD189615B6BF2, 0x95907C4C8CB85335,
+      0x6C71841BB6189E3C,
+  };
+
+  for (int i = 0; i < 100; i++) {
+    wuffs_xxh3__hasher checksum;
+    CHECK_STATUS("initialize",
+                 wuffs_xxh3__hasher__initialize(
+                     &checksum, sizeof checksum, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    uint64_t have = wuffs_xxh3__hasher__update_u64(
+        &checksum, ((wuffs_base__slice_u8){
+                       .ptr = (uint8_t*)(digits),
+                       .len = i,
+                   }));
+    if (have != wants[i]) {
+      RETURN_FAIL("i=%d: have 0x%016" PRIX64 ", want 0x%016" PRIX64, i, have,
+                  wants[i]);
+    }
+  }
+  return NULL;
+}
+
+// ---------------- XXH3 Benches
+
+uint64_t g_wuffs_xxh3_unused_u64;
+
+const char*  //
+wuffs_bench_xxh3(wuffs_base__io_buffer* dst,
+                 wuffs_base__io_buffer* src,
+                 uint32_t wuffs_initialize_flags,
+                 uint64_t wlimit,
+                 uint64_t rlimit) {
+  uint64_t len = src->meta.wi - src->meta.ri;
+  if (rlimit) {
+    len = wuffs_base__u64__min(len, rlimit);
+  }
+  wuffs_xxh3__hasher checksum;
+  CHECK_STATUS("initialize", wuffs_xxh3__hasher__initialize(
+                                 &checksum, sizeof checksum, WUFFS_VERSION,
+                                 wuffs_initialize_flags));
+  g_wuffs_xxh3_unused_u64 = wuffs_xxh3__hasher__update_u64(
+      &checksum, ((wuffs_base__slice_u8){
+                     .ptr = src->data.ptr + src->meta.ri,
+                     .len = len,
+                 }));
+  src->meta.ri += len;
+  return NULL;
+}
+
+const char*  //
+bench_wuffs_xxh3_10k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_bench_xxh3, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      tcounter_src, &g_xxh3_midsummer_gt, UINT64_MAX, UINT64_MAX, 1500);
+}
+
+const char*  //
+bench_wuffs_xxh3_100k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_bench_xxh3, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      tcounter_src, &g_xxh3_pi_gt, UINT64_MAX, UINT64_MAX, 150);
+}
+
+// ---------------- Manifest
+
+proc g_tests[] = {
+
+    test_wuffs_xxh3_golden,
+    test_wuffs_xxh3_interface,
+    test_wuffs_xxh3_pi,
+
+    NULL,
+};
+
+proc g_benches[] = {
+
+    bench_wuffs_xxh3_10k,
+    bench_wuffs_xxh3_100k,
+
+    NULL,
+};
+
+int  //
+main(int argc, char** argv) {
+  g_proc_package_name = "std/xxh3";
+  return test_main(argc, argv, g_tests, g_benches);
+}
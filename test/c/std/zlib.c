@@ -323,7 +323,8 @@ test_wuffs_zlib_decode_sheep() {
       &dec, ((wuffs_base__slice_u8){
                 .ptr = ((uint8_t*)(g_zlib_sheep_dict_ptr)),
                 .len = g_zlib_sheep_dict_len,
-            }));
+            }),
+      g_work_slice_u8);
 
   CHECK_STATUS(
       "transform_io (after dict)",
@@ -14,9 +14,11 @@
 
 #include <errno.h>
 #include <inttypes.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/resource.h>
 #include <sys/time.h>
 #include <unistd.h>
 
@@ -27,6 +29,13 @@
 
 #define WUFFS_TESTLIB_ARRAY_SIZE(a) (sizeof(a) / sizeof(a[0]))
 
+// The -threads=N flag runs each benchmark on N threads at once. Each thread
+// has its own copy of the "g_etc" variables marked WUFFS_TESTLIB_THREAD_LOCAL.
+// The main thread's slices point to the "g_etc_array_etc" arrays below. The
+// other threads' slices point to heap-allocated arrays of the same size.
+#define WUFFS_TESTLIB_THREAD_LOCAL __thread
+#define WUFFS_TESTLIB_MAX_THREADS 1024
+
 uint8_t g_have_array_u8[IO_BUFFER_ARRAY_SIZE];
 uint8_t g_want_array_u8[IO_BUFFER_ARRAY_SIZE];
 uint8_t g_work_array_u8[IO_BUFFER_ARRAY_SIZE];
@@ -38,16 +47,16 @@ uint8_t g_pixel_array_u8[PIXEL_BUFFER_ARRAY_SIZE];
 wuffs_base__token g_have_array_token[TOKEN_BUFFER_ARRAY_SIZE];
 wuffs_base__token g_want_array_token[TOKEN_BUFFER_ARRAY_SIZE];
 
-wuffs_base__slice_u8 g_have_slice_u8;
-wuffs_base__slice_u8 g_want_slice_u8;
-wuffs_base__slice_u8 g_work_slice_u8;
-wuffs_base__slice_u8 g_src_slice_u8;
+WUFFS_TESTLIB_THREAD_LOCAL wuffs_base__slice_u8 g_have_slice_u8;
+WUFFS_TESTLIB_THREAD_LOCAL wuffs_base__slice_u8 g_want_slice_u8;
+WUFFS_TESTLIB_THREAD_LOCAL wuffs_base__slice_u8 g_work_slice_u8;
+WUFFS_TESTLIB_THREAD_LOCAL wuffs_base__slice_u8 g_src_slice_u8;
 
-wuffs_base__slice_u8 g_mimiclib_scratch_slice_u8;
-wuffs_base__slice_u8 g_pixel_slice_u8;
+WUFFS_TESTLIB_THREAD_LOCAL wuffs_base__slice_u8 g_mimiclib_scratch_slice_u8;
+WUFFS_TESTLIB_THREAD_LOCAL wuffs_base__slice_u8 g_pixel_slice_u8;
 
-wuffs_base__slice_token g_have_slice_token;
-wuffs_base__slice_token g_want_slice_token;
+WUFFS_TESTLIB_THREAD_LOCAL wuffs_base__slice_token g_have_slice_token;
+WUFFS_TESTLIB_THREAD_LOCAL wuffs_base__slice_token g_want_slice_token;
 
 void  //
 wuffs_testlib__initialize_global_xxx_slices() {
@@ -100,7 +109,7 @@ unhex(uint8_t b) {
   return 0;
 }
 
-char g_fail_msg[65536] = {0};
+WUFFS_TESTLIB_THREAD_LOCAL char g_fail_msg[65536] = {0};
 
 #define RETURN_FAIL(...)                                                \
   return (snprintf(g_fail_msg, sizeof(g_fail_msg), ##__VA_ARGS__) >= 0) \
@@ -135,7 +144,12 @@ struct {
   bool bench;
   const char* focus;
   uint64_t iterscale;
+  bool nosimd;
+  bool mem;
   int reps;
+  uint64_t rfragment;
+  int threads;
+  uint64_t wfragment;
 } g_flags = {0};
 
 const char*  //
@@ -190,6 +204,21 @@ parse_flags(int argc, char** argv) {
       continue;
     }
 
+    // -mem adds memory use to the -bench output: each benchmark's heap
+    // allocations (as B/op and allocs/op) and, at the end, the process' peak
+    // resident set size. See bench_finish.
+    if (!strcmp(arg, "mem")) {
+      g_flags.mem = true;
+      continue;
+    }
+
+    // -nosimd disables Wuffs' runtime-detected CPU features (e.g. SSE4.2 and
+    // AVX2), so that the tests and benchmarks run the portable code paths.
+    if (!strcmp(arg, "nosimd")) {
+      g_flags.nosimd = true;
+      continue;
+    }
+
     if (!strncmp(arg, "reps=", 5)) {
       arg += 5;
       if (!*arg) {
@@ -207,6 +236,54 @@ parse_flags(int argc, char** argv) {
       continue;
     }
 
+    // -rfragment=N and -wfragment=N make the benchmarks feed codecs their
+    // src (and dst) at most N bytes at a time, suspending and resuming in
+    // between, like input arriving as network packets. For token decoders,
+    // -wfragment counts tokens instead of bytes. They have no effect without
+    // -bench. See do_bench_io_buffers and do_run__wuffs_base__image_decoder.
+    if (!strncmp(arg, "rfragment=", 10) || !strncmp(arg, "wfragment=", 10)) {
+      bool r = *arg == 'r';
+      arg += 10;
+      if (!*arg) {
+        return r ? "missing -rfragment=N value" : "missing -wfragment=N value";
+      }
+      char* end = NULL;
+      long int n = strtol(arg, &end, 10);
+      if (*end) {
+        return r ? "invalid -rfragment=N value" : "invalid -wfragment=N value";
+      }
+      if ((n < 0) || (0x40000000 < n)) {
+        return r ? "out-of-range -rfragment=N value"
+                 : "out-of-range -wfragment=N value";
+      }
+      if (r) {
+        g_flags.rfragment = (uint64_t)n;
+      } else {
+        g_flags.wfragment = (uint64_t)n;
+      }
+      continue;
+    }
+
+    // -threads=N runs each benchmark on N threads concurrently, each thread
+    // decoding (or encoding, hashing, etc) with its own state and buffers. It
+    // has no effect without -bench. See bench_finish_threads.
+    if (!strncmp(arg, "threads=", 8)) {
+      arg += 8;
+      if (!*arg) {
+        return "missing -threads=N value";
+      }
+      char* end = NULL;
+      long int n = strtol(arg, &end, 10);
+      if (*end) {
+        return "invalid -threads=N value";
+      }
+      if ((n < 0) || (WUFFS_TESTLIB_MAX_THREADS < n)) {
+        return "out-of-range -threads=N value";
+      }
+      g_flags.threads = n;
+      continue;
+    }
+
     return "unrecognized flag argument";
   }
 
@@ -216,8 +293,8 @@ parse_flags(int argc, char** argv) {
 }
 
 const char* g_proc_package_name = "unknown_package_name";
-const char* g_proc_func_name = "unknown_func_name";
-bool g_in_focus = false;
+WUFFS_TESTLIB_THREAD_LOCAL const char* g_proc_func_name = "unknown_func_name";
+WUFFS_TESTLIB_THREAD_LOCAL bool g_in_focus = false;
 
 #define CHECK_FOCUS(func_name)  \
   g_proc_func_name = func_name; \
@@ -320,50 +397,438 @@ typedef struct {
   const char* src_filename;
   size_t src_offset0;
   size_t src_offset1;
+  // src_generator, if non-NULL, fills src instead of reading src_filename.
+  // It typically makes pathological (worst case) inputs.
+  const char* (*src_generator)(wuffs_base__io_buffer* dst);
 } golden_test;
 
 bool g_bench_warm_up;
-struct timeval g_bench_start_tv;
+WUFFS_TESTLIB_THREAD_LOCAL struct timeval g_bench_start_tv;
+
+// g_bench_ns_per_byte is whether bench_finish also reports ns/B, the
+// nanoseconds per byte counted, to help set per-input CPU budgets. The
+// benchmarks of generated inputs set it and count src bytes.
+WUFFS_TESTLIB_THREAD_LOCAL bool g_bench_ns_per_byte;
+
+// Wuffs' own code never allocates memory, but mimic libraries (and the
+// auxiliary C++ code) can. With glibc, this program's malloc, calloc and
+// realloc definitions take precedence over (interpose) the C library's, for
+// every caller, so we can count allocations by forwarding to glibc's
+// __libc_etc equivalents. Elsewhere, -mem only reports the peak resident set
+// size.
+#if defined(__GLIBC__) && !defined(WUFFS_TESTLIB_AVOID_MALLOC_INTERPOSITION)
+#define WUFFS_TESTLIB_HAVE_MALLOC_COUNTS
+
+extern void* __libc_malloc(size_t size);
+extern void* __libc_calloc(size_t n, size_t size);
+extern void* __libc_realloc(void* ptr, size_t size);
+
+uint64_t g_malloc_count = 0;
+uint64_t g_malloc_bytes = 0;
+
+void  //
+malloc_counts_add(size_t size) {
+  __atomic_fetch_add(&g_malloc_count, 1, __ATOMIC_RELAXED);
+  __atomic_fetch_add(&g_malloc_bytes, (uint64_t)size, __ATOMIC_RELAXED);
+}
+
+void*  //
+malloc(size_t size) {
+  malloc_counts_add(size);
+  return __libc_malloc(size);
+}
+
+void*  //
+calloc(size_t n, size_t size) {
+  malloc_counts_add(n * size);
+  return __libc_calloc(n, size);
+}
+
+void*  //
+realloc(void* ptr, size_t size) {
+  malloc_counts_add(size);
+  return __libc_realloc(ptr, size);
+}
+#endif
+
+WUFFS_TESTLIB_THREAD_LOCAL uint64_t g_bench_start_malloc_count;
+WUFFS_TESTLIB_THREAD_LOCAL uint64_t g_bench_start_malloc_bytes;
+
+// g_bench_threads holds the -threads=N state, when N > 1. Thread 0 is the
+// main thread. The other threads are created once, by bench_start_threads,
+// and then wait at the barrier for the main thread to hand them each
+// benchmark proc in turn. Each thread's bench_finish call records its timings
+// in results[i] instead of printing them.
+struct {
+  int n;
+  pthread_t ids[WUFFS_TESTLIB_MAX_THREADS];
+  uint8_t* u8_arrays[WUFFS_TESTLIB_MAX_THREADS];
+  wuffs_base__token* token_arrays[WUFFS_TESTLIB_MAX_THREADS];
+
+  pthread_mutex_t mutex;
+  pthread_cond_t cond;
+  int barrier_count;
+  uint64_t barrier_generation;
+
+  const char* (*proc)();
+  struct {
+    const char* status;
+    bool finished;
+    struct timeval start_tv;
+    struct timeval finish_tv;
+    uint64_t iters;
+    uint64_t n_bytes;
+  } results[WUFFS_TESTLIB_MAX_THREADS];
+} g_bench_threads = {0};
+
+WUFFS_TESTLIB_THREAD_LOCAL int g_bench_thread_index = 0;
+
+WUFFS_TESTLIB_THREAD_LOCAL char g_bench_name[256] = {0};
+
+// bench_name returns the benchmark's name, including "/rfragN" and "/wfragN"
+// suffixes for the -rfragment=N and -wfragment=N flags.
+const char*  //
+bench_name() {
+  const char* name = g_proc_func_name;
+  if ((strlen(name) >= 6) && !strncmp(name, "bench_", 6)) {
+    name += 6;
+  }
+  if (!g_flags.rfragment && !g_flags.wfragment) {
+    return name;
+  }
+  int n = snprintf(g_bench_name, sizeof(g_bench_name), "%s", name);
+  if ((n >= 0) && g_flags.rfragment) {
+    n += snprintf(g_bench_name + n, sizeof(g_bench_name) - (size_t)n,
+                  "/rfrag%" PRIu64, g_flags.rfragment);
+  }
+  if ((n >= 0) && g_flags.wfragment) {
+    snprintf(g_bench_name + n, sizeof(g_bench_name) - (size_t)n,
+             "/wfrag%" PRIu64, g_flags.wfragment);
+  }
+  return g_bench_name;
+}
+
+int64_t  //
+bench_micros(struct timeval* start_tv, struct timeval* finish_tv) {
+  return (int64_t)(finish_tv->tv_sec - start_tv->tv_sec) * 1000000 +
+         (int64_t)(finish_tv->tv_usec - start_tv->tv_usec);
+}
 
 void  //
 bench_start() {
+#if defined(WUFFS_TESTLIB_HAVE_MALLOC_COUNTS)
+  g_bench_start_malloc_count =
+      __atomic_load_n(&g_malloc_count, __ATOMIC_RELAXED);
+  g_bench_start_malloc_bytes =
+      __atomic_load_n(&g_malloc_bytes, __ATOMIC_RELAXED);
+#endif
   gettimeofday(&g_bench_start_tv, NULL);
 }
 
+// bench_print_mem prints the -mem columns (with a leading tab) that follow a
+// single-threaded benchmark's ns/op and MB/s columns.
+void  //
+bench_print_mem(uint64_t iters) {
+#if defined(WUFFS_TESTLIB_HAVE_MALLOC_COUNTS)
+  if (!g_flags.mem || !iters) {
+    return;
+  }
+  uint64_t count = __atomic_load_n(&g_malloc_count, __ATOMIC_RELAXED) -
+                   g_bench_start_malloc_count;
+  uint64_t bytes = __atomic_load_n(&g_malloc_bytes, __ATOMIC_RELAXED) -
+                   g_bench_start_malloc_bytes;
+  printf("\t%8" PRIu64 " B/op\t%8" PRIu64 " allocs/op",  //
+         bytes / iters, count / iters);
+#endif
+}
+
+// bench_print_peak_rss prints the process' peak resident set size, as a "#"
+// comment line, after all of the -mem benchmarks.
+void  //
+bench_print_peak_rss() {
+  struct rusage ru;
+  if (getrusage(RUSAGE_SELF, &ru)) {
+    return;
+  }
+  // Linux reports ru_maxrss in kilobytes but macOS reports it in bytes.
+#if defined(__APPLE__)
+  uint64_t kib = (uint64_t)(ru.ru_maxrss) / 1024;
+#else
+  uint64_t kib = (uint64_t)(ru.ru_maxrss);
+#endif
+  printf("# peak resident set size: %" PRIu64 " KiB\n", kib);
+}
+
 void  //
 bench_finish(uint64_t iters, uint64_t n_bytes) {
   struct timeval bench_finish_tv;
   gettimeofday(&bench_finish_tv, NULL);
-  int64_t micros =
-      (int64_t)(bench_finish_tv.tv_sec - g_bench_start_tv.tv_sec) * 1000000 +
-      (int64_t)(bench_finish_tv.tv_usec - g_bench_start_tv.tv_usec);
+
+  bool ns_per_byte = g_bench_ns_per_byte;
+  g_bench_ns_per_byte = false;
+
+  if (g_bench_threads.n > 1) {
+    g_bench_threads.results[g_bench_thread_index].finished = true;
+    g_bench_threads.results[g_bench_thread_index].start_tv = g_bench_start_tv;
+    g_bench_threads.results[g_bench_thread_index].finish_tv = bench_finish_tv;
+    g_bench_threads.results[g_bench_thread_index].iters = iters;
+    g_bench_threads.results[g_bench_thread_index].n_bytes = n_bytes;
+    return;
+  }
+
+  int64_t micros = bench_micros(&g_bench_start_tv, &bench_finish_tv);
   uint64_t nanos = 1;
   if (micros > 0) {
     nanos = (uint64_t)(micros)*1000;
   }
   uint64_t kb_per_s = n_bytes * 1000000 / nanos;
 
-  const char* name = g_proc_func_name;
-  if ((strlen(name) >= 6) && !strncmp(name, "bench_", 6)) {
-    name += 6;
-  }
+  const char* name = bench_name();
   if (g_bench_warm_up) {
     printf("# (warm up) %s/%s\t%8" PRIu64 ".%06" PRIu64 " seconds\n",  //
            name, g_cc, nanos / 1000000000, (nanos % 1000000000) / 1000);
   } else if (!n_bytes) {
-    printf("Benchmark%s/%s\t%8" PRIu64 "\t%8" PRIu64 " ns/op\n",  //
+    printf("Benchmark%s/%s\t%8" PRIu64 "\t%8" PRIu64 " ns/op",  //
            name, g_cc, iters, nanos / iters);
+    bench_print_mem(iters);
+    printf("\n");
   } else {
     printf("Benchmark%s/%s\t%8" PRIu64 "\t%8" PRIu64
-           " ns/op\t%8d.%03d MB/s\n",         //
+           " ns/op\t%8d.%03d MB/s",          //
            name, g_cc, iters, nanos / iters,  //
            (int)(kb_per_s / 1000), (int)(kb_per_s % 1000));
+    if (ns_per_byte && (n_bytes > 0)) {
+      uint64_t ps_per_byte = nanos * 1000 / n_bytes;
+      printf("\t%8d.%03d ns/B",  //
+             (int)(ps_per_byte / 1000), (int)(ps_per_byte % 1000));
+    }
+    bench_print_mem(iters);
+    printf("\n");
   }
   // Flush stdout so that "wuffs bench | tee etc" still prints its numbers as
   // soon as they are available.
   fflush(stdout);
 }
 
+int  //
+bench_compare_u64(const void* x, const void* y) {
+  uint64_t xx = *((const uint64_t*)(x));
+  uint64_t yy = *((const uint64_t*)(y));
+  return (xx < yy) ? -1 : (xx > yy) ? +1 : 0;
+}
+
+// bench_finish_threads prints one line per benchmark that ran on N threads.
+// The MB/s is the aggregate throughput: the bytes processed by all N threads
+// divided by the wall time from the earliest bench_start to the latest
+// bench_finish. Perfect scaling would be N times the single-threaded MB/s.
+// The ns/op is the median (over the threads) of each thread's ns/op and the
+// max-ns/op is the slowest thread's, the tail latency under contention.
+void  //
+bench_finish_threads() {
+  int n = g_bench_threads.n;
+  uint64_t ns_per_op[WUFFS_TESTLIB_MAX_THREADS];
+  uint64_t iters = 0;
+  uint64_t n_bytes = 0;
+  struct timeval* start_tv = NULL;
+  struct timeval* finish_tv = NULL;
+  for (int i = 0; i < n; i++) {
+    if (!g_bench_threads.results[i].finished) {
+      return;
+    }
+    struct timeval* s = &g_bench_threads.results[i].start_tv;
+    struct timeval* f = &g_bench_threads.results[i].finish_tv;
+    if (!start_tv || (bench_micros(start_tv, s) < 0)) {
+      start_tv = s;
+    }
+    if (!finish_tv || (bench_micros(finish_tv, f) > 0)) {
+      finish_tv = f;
+    }
+    int64_t micros = bench_micros(s, f);
+    uint64_t i_iters = g_bench_threads.results[i].iters;
+    uint64_t nanos = (micros > 0) ? ((uint64_t)(micros)*1000) : 1;
+    ns_per_op[i] = nanos / (i_iters ? i_iters : 1);
+    iters = i_iters;
+    n_bytes += g_bench_threads.results[i].n_bytes;
+  }
+  qsort(ns_per_op, (size_t)n, sizeof(ns_per_op[0]), bench_compare_u64);
+
+  int64_t micros = bench_micros(start_tv, finish_tv);
+  uint64_t nanos = 1;
+  if (micros > 0) {
+    nanos = (uint64_t)(micros)*1000;
+  }
+  uint64_t kb_per_s = n_bytes * 1000000 / nanos;
+
+  const char* name = bench_name();
+  if (g_bench_warm_up) {
+    printf("# (warm up) %s/%s/threads%d\t%8" PRIu64 ".%06" PRIu64
+           " seconds\n",  //
+           name, g_cc, n, nanos / 1000000000, (nanos % 1000000000) / 1000);
+  } else if (!n_bytes) {
+    printf("Benchmark%s/%s/threads%d\t%8" PRIu64 "\t%8" PRIu64
+           " ns/op\t%8" PRIu64 " max-ns/op\n",  //
+           name, g_cc, n, iters, ns_per_op[n / 2], ns_per_op[n - 1]);
+  } else {
+    printf("Benchmark%s/%s/threads%d\t%8" PRIu64 "\t%8" PRIu64
+           " ns/op\t%8d.%03d MB/s\t%8" PRIu64 " max-ns/op\n",  //
+           name, g_cc, n, iters, ns_per_op[n / 2],               //
+           (int)(kb_per_s / 1000), (int)(kb_per_s % 1000), ns_per_op[n - 1]);
+  }
+  fflush(stdout);
+}
+
+void  //
+bench_threads_barrier_wait() {
+  pthread_mutex_lock(&g_bench_threads.mutex);
+  uint64_t generation = g_bench_threads.barrier_generation;
+  if (++g_bench_threads.barrier_count == g_bench_threads.n) {
+    g_bench_threads.barrier_count = 0;
+    g_bench_threads.barrier_generation++;
+    pthread_cond_broadcast(&g_bench_threads.cond);
+  } else {
+    while (generation == g_bench_threads.barrier_generation) {
+      pthread_cond_wait(&g_bench_threads.cond, &g_bench_threads.mutex);
+    }
+  }
+  pthread_mutex_unlock(&g_bench_threads.mutex);
+}
+
+// Pinning each thread to its own CPU needs the non-standard
+// pthread_setaffinity_np function, declared when compiling with
+// -D_GNU_SOURCE (which "wuffs bench -threads=N" passes). Without it, the
+// threads still run concurrently, unpinned.
+#if defined(__linux__) && defined(CPU_SET)
+cpu_set_t g_bench_threads_allowed_cpus;
+
+void  //
+bench_threads_pin(int i) {
+  // Pin thread i to the i'th CPU (wrapping around) that this process is
+  // allowed to run on.
+  int n = CPU_COUNT(&g_bench_threads_allowed_cpus);
+  if (n <= 0) {
+    return;
+  }
+  int k = i % n;
+  for (int c = 0; c < CPU_SETSIZE; c++) {
+    if (CPU_ISSET(c, &g_bench_threads_allowed_cpus) && (k-- == 0)) {
+      cpu_set_t cpus;
+      CPU_ZERO(&cpus);
+      CPU_SET(c, &cpus);
+      pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+      return;
+    }
+  }
+}
+#else
+void  //
+bench_threads_pin(int i) {}
+#endif
+
+void*  //
+bench_thread_main(void* arg) {
+  int i = (int)((intptr_t)(arg));
+  g_bench_thread_index = i;
+  bench_threads_pin(i);
+
+  uint8_t* p = g_bench_threads.u8_arrays[i];
+  g_have_slice_u8 = wuffs_base__make_slice_u8(p, IO_BUFFER_ARRAY_SIZE);
+  p += IO_BUFFER_ARRAY_SIZE;
+  g_want_slice_u8 = wuffs_base__make_slice_u8(p, IO_BUFFER_ARRAY_SIZE);
+  p += IO_BUFFER_ARRAY_SIZE;
+  g_work_slice_u8 = wuffs_base__make_slice_u8(p, IO_BUFFER_ARRAY_SIZE);
+  p += IO_BUFFER_ARRAY_SIZE;
+  g_src_slice_u8 = wuffs_base__make_slice_u8(p, IO_BUFFER_ARRAY_SIZE);
+  p += IO_BUFFER_ARRAY_SIZE;
+  g_mimiclib_scratch_slice_u8 =
+      wuffs_base__make_slice_u8(p, MIMICLIB_SCRATCH_BUFFER_ARRAY_SIZE);
+  p += MIMICLIB_SCRATCH_BUFFER_ARRAY_SIZE;
+  g_pixel_slice_u8 = wuffs_base__make_slice_u8(p, PIXEL_BUFFER_ARRAY_SIZE);
+
+  wuffs_base__token* t = g_bench_threads.token_arrays[i];
+  g_have_slice_token = wuffs_base__make_slice_token(t, TOKEN_BUFFER_ARRAY_SIZE);
+  t += TOKEN_BUFFER_ARRAY_SIZE;
+  g_want_slice_token = wuffs_base__make_slice_token(t, TOKEN_BUFFER_ARRAY_SIZE);
+
+  while (true) {
+    bench_threads_barrier_wait();
+    const char* (*proc)() = g_bench_threads.proc;
+    if (!proc) {
+      break;
+    }
+    g_proc_func_name = "unknown_func_name";
+    g_fail_msg[0] = 0;
+    g_in_focus = false;
+    g_bench_threads.results[i].status = (*proc)();
+    bench_threads_barrier_wait();
+  }
+  return NULL;
+}
+
+const char*  //
+bench_start_threads(int n) {
+  g_bench_threads.n = n;
+  pthread_mutex_init(&g_bench_threads.mutex, NULL);
+  pthread_cond_init(&g_bench_threads.cond, NULL);
+#if defined(__linux__) && defined(CPU_SET)
+  CPU_ZERO(&g_bench_threads_allowed_cpus);
+  pthread_getaffinity_np(pthread_self(), sizeof(g_bench_threads_allowed_cpus),
+                         &g_bench_threads_allowed_cpus);
+#endif
+  bench_threads_pin(0);
+
+  // The calloc'ed memory is only committed when first touched, which is by
+  // the thread that uses it.
+  for (int i = 1; i < n; i++) {
+    g_bench_threads.u8_arrays[i] =
+        calloc((4 * IO_BUFFER_ARRAY_SIZE) + MIMICLIB_SCRATCH_BUFFER_ARRAY_SIZE +
+                   PIXEL_BUFFER_ARRAY_SIZE,
+               1);
+    g_bench_threads.token_arrays[i] =
+        calloc(2 * TOKEN_BUFFER_ARRAY_SIZE, sizeof(wuffs_base__token));
+    if (!g_bench_threads.u8_arrays[i] || !g_bench_threads.token_arrays[i]) {
+      return "could not allocate -threads=N buffers";
+    }
+  }
+  for (int i = 1; i < n; i++) {
+    if (pthread_create(&g_bench_threads.ids[i], NULL, bench_thread_main,
+                       (void*)((intptr_t)(i)))) {
+      return "could not create -threads=N threads";
+    }
+  }
+  return NULL;
+}
+
+void  //
+bench_stop_threads() {
+  g_bench_threads.proc = NULL;
+  bench_threads_barrier_wait();
+  for (int i = 1; i < g_bench_threads.n; i++) {
+    pthread_join(g_bench_threads.ids[i], NULL);
+    free(g_bench_threads.u8_arrays[i]);
+    free(g_bench_threads.token_arrays[i]);
+  }
+  g_bench_threads.n = 0;
+}
+
+// bench_run_threads runs proc on all of the -threads=N threads at once,
+// returning the first non-NULL status.
+const char*  //
+bench_run_threads(const char* (*proc)()) {
+  memset(g_bench_threads.results, 0, sizeof(g_bench_threads.results));
+  g_bench_threads.proc = proc;
+  bench_threads_barrier_wait();
+  const char* status = (*proc)();
+  bench_threads_barrier_wait();
+
+  for (int i = 1; (i < g_bench_threads.n) && !status; i++) {
+    status = g_bench_threads.results[i].status;
+  }
+  if (!status && g_in_focus) {
+    bench_finish_threads();
+  }
+  return status;
+}
+
 const char*  //
 chdir_to_the_wuffs_root_directory() {
   // Chdir to the Wuffs root directory, assuming that we're starting from
@@ -409,14 +874,27 @@ test_main(int argc, char** argv, proc* tests, proc* benches) {
     fprintf(stderr, "unexpected (non-flag) argument\n");
     return 1;
   }
+  if (g_flags.nosimd) {
+    wuffs_base__cpu_arch__set_disabled_features(
+        WUFFS_BASE__CPU_ARCH__FEATURE__ALL);
+  }
+  if (g_flags.bench && (g_flags.threads > 1)) {
+    status = bench_start_threads(g_flags.threads);
+    if (status) {
+      fprintf(stderr, "%s\n", status);
+      return 1;
+    }
+  }
 
   int reps = 1;
   proc* procs = tests;
   if (g_flags.bench) {
     reps = g_flags.reps + 1;  // +1 for the warm up run.
     procs = benches;
-    printf("# %s\n# %s version %s\n#\n", g_proc_package_name, g_cc,
-           g_cc_version);
+    printf("# %s\n# %s version %s\n# cpu_arch features 0x%08" PRIX32
+           "\n#\n",
+           g_proc_package_name, g_cc, g_cc_version,
+           wuffs_base__cpu_arch__features());
     printf(
         "# The output format, including the \"Benchmark\" prefixes, is "
         "compatible with the\n"
@@ -431,7 +909,8 @@ test_main(int argc, char** argv, proc* tests, proc* benches) {
       g_proc_func_name = "unknown_func_name";
       g_fail_msg[0] = 0;
       g_in_focus = false;
-      const char* status = (*p)();
+      const char* status =
+          (g_bench_threads.n > 1) ? bench_run_threads(*p) : (*p)();
       if (!g_in_focus) {
         continue;
       }
@@ -448,13 +927,23 @@ test_main(int argc, char** argv, proc* tests, proc* benches) {
       continue;
     }
     if (g_flags.bench) {
-      printf("# %d benchmarks, 1+%d reps per benchmark, iterscale=%d\n",
+      printf("# %d benchmarks, 1+%d reps per benchmark, iterscale=%d",
              g_tests_run, g_flags.reps, (int)(g_flags.iterscale));
+      if (g_bench_threads.n > 1) {
+        printf(", threads=%d", g_bench_threads.n);
+      }
+      printf("\n");
     } else {
       printf("%-16s%-8sPASS (%d tests)\n", g_proc_package_name, g_cc,
              g_tests_run);
     }
   }
+  if (g_bench_threads.n > 1) {
+    bench_stop_threads();
+  }
+  if (g_flags.bench && g_flags.mem) {
+    bench_print_peak_rss();
+  }
   return 0;
 }
 
@@ -861,7 +1350,10 @@ proc_io_buffers(const char* (*codec_func)(wuffs_base__io_buffer*,
       .data = g_want_slice_u8,
   });
 
-  if (!gt->src_filename) {
+  if (gt->src_generator) {
+    CHECK_STRING((*gt->src_generator)(&src));
+    src.meta.closed = true;
+  } else if (!gt->src_filename) {
     src.meta.closed = true;
   } else {
     const char* status = read_file(&src, gt->src_filename);
@@ -881,6 +1373,7 @@ proc_io_buffers(const char* (*codec_func)(wuffs_base__io_buffer*,
   }
 
   if (bench) {
+    g_bench_ns_per_byte = gt->src_generator != NULL;
     bench_start();
   }
   uint64_t n_bytes = 0;
@@ -946,7 +1439,10 @@ proc_token_decoder(const char* (*codec_func)(wuffs_base__token_buffer*,
       .data = g_have_slice_token,
   });
 
-  if (!gt->src_filename) {
+  if (gt->src_generator) {
+    CHECK_STRING((*gt->src_generator)(&src));
+    src.meta.closed = true;
+  } else if (!gt->src_filename) {
     src.meta.closed = true;
   } else {
     const char* status = read_file(&src, gt->src_filename);
@@ -966,6 +1462,7 @@ proc_token_decoder(const char* (*codec_func)(wuffs_base__token_buffer*,
   }
 
   if (bench) {
+    g_bench_ns_per_byte = gt->src_generator != NULL;
     bench_start();
   }
   uint64_t n_bytes = 0;
@@ -1006,6 +1503,12 @@ do_bench_io_buffers(const char* (*codec_func)(wuffs_base__io_buffer*,
                     uint64_t wlimit,
                     uint64_t rlimit,
                     uint64_t iters_unscaled) {
+  if (g_flags.wfragment && (wlimit > g_flags.wfragment)) {
+    wlimit = g_flags.wfragment;
+  }
+  if (g_flags.rfragment && (rlimit > g_flags.rfragment)) {
+    rlimit = g_flags.rfragment;
+  }
   return proc_io_buffers(codec_func, wuffs_initialize_flags, tcounter, gt,
                          wlimit, rlimit, iters_unscaled * g_flags.iterscale,
                          true);
@@ -1023,6 +1526,12 @@ do_bench_token_decoder(const char* (*codec_func)(wuffs_base__token_buffer*,
                        uint64_t wlimit,
                        uint64_t rlimit,
                        uint64_t iters_unscaled) {
+  if (g_flags.wfragment && (wlimit > g_flags.wfragment)) {
+    wlimit = g_flags.wfragment;
+  }
+  if (g_flags.rfragment && (rlimit > g_flags.rfragment)) {
+    rlimit = g_flags.rfragment;
+  }
   return proc_token_decoder(codec_func, wuffs_initialize_flags, tcounter, gt,
                             wlimit, rlimit, iters_unscaled * g_flags.iterscale,
                             true);
@@ -1044,6 +1553,28 @@ do_test_io_buffers(const char* (*codec_func)(wuffs_base__io_buffer*,
 
 // --------
 
+// CALL_WITH_FRAGMENTED_SRC sets status to the result of call, an image
+// decoder method call that reads from &limited_src. When benchmarking with
+// -rfragment=N, limited_src holds at most N bytes of src and call is repeated
+// for as long as it suspends with a short read. Otherwise, limited_src holds
+// all of src and call is made once.
+#define CALL_WITH_FRAGMENTED_SRC(status, src, call)                            \
+  do {                                                                         \
+    uint64_t rlimit = (g_flags.bench && g_flags.rfragment)                     \
+                          ? g_flags.rfragment                                  \
+                          : UINT64_MAX;                                        \
+    while (true) {                                                             \
+      wuffs_base__io_buffer limited_src = make_limited_reader(*src,            \
+                                                              rlimit);         \
+      status = call;                                                           \
+      src->meta.ri += limited_src.meta.ri;                                     \
+      if ((rlimit == UINT64_MAX) ||                                            \
+          (status.repr != wuffs_base__suspension__short_read)) {               \
+        break;                                                                 \
+      }                                                                        \
+    }                                                                          \
+  } while (0)
+
 const char*  //
 do_run__wuffs_base__image_decoder(wuffs_base__image_decoder* b,
                                   uint64_t* n_bytes_out,
@@ -1068,8 +1599,11 @@ do_run__wuffs_base__image_decoder(wuffs_base__image_decoder* b,
   }
   uint64_t bytes_per_pixel = bits_per_pixel / 8;
 
-  CHECK_STATUS("decode_image_config",
-               wuffs_base__image_decoder__decode_image_config(b, &ic, src));
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+  CALL_WITH_FRAGMENTED_SRC(
+      status, src,
+      wuffs_base__image_decoder__decode_image_config(b, &ic, &limited_src));
+  CHECK_STATUS("decode_image_config", status);
   wuffs_base__pixel_config__set(&ic.pixcfg, pixfmt.repr,
                                 WUFFS_BASE__PIXEL_SUBSAMPLING__NONE,
                                 wuffs_base__pixel_config__width(&ic.pixcfg),
@@ -1078,8 +1612,9 @@ do_run__wuffs_base__image_decoder(wuffs_base__image_decoder* b,
                                      &pb, &ic.pixcfg, g_pixel_slice_u8));
 
   while (true) {
-    wuffs_base__status status =
-        wuffs_base__image_decoder__decode_frame_config(b, &fc, src);
+    CALL_WITH_FRAGMENTED_SRC(
+        status, src,
+        wuffs_base__image_decoder__decode_frame_config(b, &fc, &limited_src));
     if (status.repr == wuffs_base__note__end_of_data) {
       break;
     } else {
@@ -1092,9 +1627,11 @@ do_run__wuffs_base__image_decoder(wuffs_base__image_decoder* b,
             ? WUFFS_BASE__PIXEL_BLEND__SRC
             : WUFFS_BASE__PIXEL_BLEND__SRC_OVER;
 
-    CHECK_STATUS("decode_frame",
-                 wuffs_base__image_decoder__decode_frame(
-                     b, &pb, src, blend, g_work_slice_u8, NULL));
+    CALL_WITH_FRAGMENTED_SRC(
+        status, src,
+        wuffs_base__image_decoder__decode_frame(b, &pb, &limited_src, blend,
+                                                g_work_slice_u8, NULL));
+    CHECK_STATUS("decode_frame", status);
 
     if (n_bytes_out) {
       uint64_t frame_width = wuffs_base__frame_config__width(&fc);
@@ -1109,6 +1646,40 @@ do_run__wuffs_base__image_decoder(wuffs_base__image_decoder* b,
   return NULL;
 }
 
+const char*  //
+proc_bench_image_decode(
+    const char* (*decode_func)(uint64_t* n_bytes_out,
+                               wuffs_base__io_buffer* dst,
+                               uint32_t wuffs_initialize_flags,
+                               wuffs_base__pixel_format pixfmt,
+                               uint32_t* quirks_ptr,
+                               size_t quirks_len,
+                               wuffs_base__io_buffer* src),
+    uint32_t wuffs_initialize_flags,
+    wuffs_base__pixel_format pixfmt,
+    uint32_t* quirks_ptr,
+    size_t quirks_len,
+    wuffs_base__io_buffer* src,
+    bool count_src_bytes,
+    uint64_t iters_unscaled) {
+  size_t src_ri = src->meta.ri;
+  g_bench_ns_per_byte = count_src_bytes;
+  bench_start();
+  uint64_t n_bytes = 0;
+  uint64_t iters = iters_unscaled * g_flags.iterscale;
+  for (uint64_t i = 0; i < iters; i++) {
+    src->meta.ri = src_ri;
+    CHECK_STRING((*decode_func)(count_src_bytes ? NULL : &n_bytes, NULL,
+                                wuffs_initialize_flags, pixfmt, quirks_ptr,
+                                quirks_len, src));
+    if (count_src_bytes) {
+      n_bytes += src->meta.ri - src_ri;
+    }
+  }
+  bench_finish(iters, n_bytes);
+  return NULL;
+}
+
 const char*  //
 do_bench_image_decode(
     const char* (*decode_func)(uint64_t* n_bytes_out,
@@ -1130,17 +1701,37 @@ do_bench_image_decode(
       .data = g_src_slice_u8,
   });
   CHECK_STRING(read_file_fragment(&src, src_filename, src_ri, src_wi));
+  return proc_bench_image_decode(decode_func, wuffs_initialize_flags, pixfmt,
+                                 quirks_ptr, quirks_len, &src, false,
+                                 iters_unscaled);
+}
 
-  bench_start();
-  uint64_t n_bytes = 0;
-  uint64_t iters = iters_unscaled * g_flags.iterscale;
-  for (uint64_t i = 0; i < iters; i++) {
-    src.meta.ri = src_ri;
-    CHECK_STRING((*decode_func)(&n_bytes, NULL, wuffs_initialize_flags, pixfmt,
-                                quirks_ptr, quirks_len, &src));
-  }
-  bench_finish(iters, n_bytes);
-  return NULL;
+// do_bench_image_decode_generated is like do_bench_image_decode but src is
+// filled by src_generator. Its throughput counts src bytes, not pixel bytes,
+// and it also reports ns/B.
+const char*  //
+do_bench_image_decode_generated(
+    const char* (*decode_func)(uint64_t* n_bytes_out,
+                               wuffs_base__io_buffer* dst,
+                               uint32_t wuffs_initialize_flags,
+                               wuffs_base__pixel_format pixfmt,
+                               uint32_t* quirks_ptr,
+                               size_t quirks_len,
+                               wuffs_base__io_buffer* src),
+    uint32_t wuffs_initialize_flags,
+    wuffs_base__pixel_format pixfmt,
+    uint32_t* quirks_ptr,
+    size_t quirks_len,
+    const char* (*src_generator)(wuffs_base__io_buffer* dst),
+    uint64_t iters_unscaled) {
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING((*src_generator)(&src));
+  src.meta.closed = true;
+  return proc_bench_image_decode(decode_func, wuffs_initialize_flags, pixfmt,
+                                 quirks_ptr, quirks_len, &src, true,
+                                 iters_unscaled);
 }
 
 // --------
@@ -1166,6 +1757,27 @@ do_test__wuffs_base__hasher_u32(wuffs_base__hasher_u32* b,
   return NULL;
 }
 
+const char*  //
+do_test__wuffs_base__hasher_u64(wuffs_base__hasher_u64* b,
+                                const char* src_filename,
+                                size_t src_ri,
+                                size_t src_wi,
+                                uint64_t want) {
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file_fragment(&src, src_filename, src_ri, src_wi));
+  uint64_t have = wuffs_base__hasher_u64__update_u64(
+      b, ((wuffs_base__slice_u8){
+             .ptr = (uint8_t*)(src.data.ptr + src.meta.ri),
+             .len = (size_t)(src.meta.wi - src.meta.ri),
+         }));
+  if (have != want) {
+    RETURN_FAIL("have 0x%016" PRIX64 ", want 0x%016" PRIX64, have, want);
+  }
+  return NULL;
+}
+
 const char*  //
 do_test__wuffs_base__image_decoder(
     wuffs_base__image_decoder* b,
@@ -1235,6 +1847,407 @@ do_test__wuffs_base__image_decoder(
   return NULL;
 }
 
+// do_test__wuffs_base__image_decoder_roi checks that decoding the first frame
+// with a Region Of Interest produces the same pixels (inside that ROI) as a
+// full decode. Two decoders are needed, since each one decodes only once. The
+// ROI decode is fed its source data chunk_len bytes at a time, to exercise
+// suspending and resuming partway through a row.
+const char*  //
+do_test__wuffs_base__image_decoder_roi(wuffs_base__image_decoder* full_dec,
+                                       wuffs_base__image_decoder* roi_dec,
+                                       const char* src_filename,
+                                       wuffs_base__rect_ie_u32 roi,
+                                       size_t chunk_len) {
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, src_filename));
+  const size_t src_wi = src.meta.wi;
+
+  // Decode the whole image.
+  wuffs_base__image_config full_ic = ((wuffs_base__image_config){});
+  CHECK_STATUS("full decode_image_config",
+               wuffs_base__image_decoder__decode_image_config(
+                   full_dec, &full_ic, &src));
+  uint32_t width = wuffs_base__pixel_config__width(&full_ic.pixcfg);
+  uint32_t height = wuffs_base__pixel_config__height(&full_ic.pixcfg);
+  if (((uint64_t)width * (uint64_t)height * 4) > PIXEL_BUFFER_ARRAY_SIZE) {
+    return "image dimensions are too large";
+  }
+  wuffs_base__pixel_config__set(
+      &full_ic.pixcfg, WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+      WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, width, height);
+  memset(g_pixel_slice_u8.ptr, 0x5A, (size_t)width * (size_t)height * 4);
+  wuffs_base__pixel_buffer full_pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("full set_from_slice",
+               wuffs_base__pixel_buffer__set_from_slice(
+                   &full_pb, &full_ic.pixcfg, g_pixel_slice_u8));
+  CHECK_STATUS("full decode_frame",
+               wuffs_base__image_decoder__decode_frame(
+                   full_dec, &full_pb, &src, WUFFS_BASE__PIXEL_BLEND__SRC,
+                   g_work_slice_u8, NULL));
+
+  // Decode only the ROI, into a pixel buffer that's just big enough.
+  wuffs_base__rect_ie_u32 bounds =
+      wuffs_base__pixel_config__bounds(&full_ic.pixcfg);
+  wuffs_base__rect_ie_u32 clipped =
+      wuffs_base__rect_ie_u32__intersect(&bounds, roi);
+  uint32_t roi_width = wuffs_base__rect_ie_u32__width(&clipped);
+  uint32_t roi_height = wuffs_base__rect_ie_u32__height(&clipped);
+  if (((uint64_t)roi_width * (uint64_t)roi_height * 4) > g_have_slice_u8.len) {
+    return "ROI dimensions are too large";
+  }
+  memset(g_have_slice_u8.ptr, 0x5A, (size_t)roi_width * (size_t)roi_height * 4);
+  wuffs_base__pixel_config roi_pixcfg = ((wuffs_base__pixel_config){});
+  wuffs_base__pixel_config__set(
+      &roi_pixcfg, WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+      WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, roi_width, roi_height);
+  wuffs_base__pixel_buffer roi_pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("ROI set_from_slice",
+               wuffs_base__pixel_buffer__set_from_slice(
+                   &roi_pb, &roi_pixcfg,
+                   wuffs_base__make_slice_u8(
+                       g_have_slice_u8.ptr,
+                       (size_t)roi_width * (size_t)roi_height * 4)));
+  wuffs_base__decode_frame_options opts =
+      wuffs_base__null_decode_frame_options();
+  wuffs_base__decode_frame_options__set_roi(&opts, roi);
+
+  src.meta.ri = 0;
+  src.meta.wi = 0;
+  src.meta.closed = false;
+  wuffs_base__image_config roi_ic = ((wuffs_base__image_config){});
+  bool have_ic = false;
+  while (true) {
+    src.meta.wi = (chunk_len < (src_wi - src.meta.wi))
+                      ? (src.meta.wi + chunk_len)
+                      : src_wi;
+    src.meta.closed = src.meta.wi == src_wi;
+    wuffs_base__status status;
+    if (!have_ic) {
+      status = wuffs_base__image_decoder__decode_image_config(roi_dec, &roi_ic,
+                                                              &src);
+      if (wuffs_base__status__is_ok(&status)) {
+        have_ic = true;
+        continue;
+      }
+    } else {
+      status = wuffs_base__image_decoder__decode_frame(
+          roi_dec, &roi_pb, &src, WUFFS_BASE__PIXEL_BLEND__SRC,
+          g_work_slice_u8, &opts);
+      if (wuffs_base__status__is_ok(&status)) {
+        break;
+      }
+    }
+    if ((status.repr != wuffs_base__suspension__short_read) ||
+        src.meta.closed) {
+      RETURN_FAIL("ROI decode: \"%s\"", status.repr);
+    }
+  }
+
+  for (uint32_t y = 0; y < roi_height; y++) {
+    for (uint32_t x = 0; x < roi_width; x++) {
+      uint32_t have = wuffs_base__peek_u32le__no_bounds_check(
+          g_have_slice_u8.ptr + (4 * (((size_t)y * roi_width) + x)));
+      uint32_t want = wuffs_base__peek_u32le__no_bounds_check(
+          g_pixel_slice_u8.ptr +
+          (4 * (((size_t)(y + clipped.min_incl_y) * width) +
+                (x + clipped.min_incl_x))));
+      if (have != want) {
+        RETURN_FAIL("ROI (%" PRIu32 ", %" PRIu32 "): have 0x%08" PRIX32
+                    ", want 0x%08" PRIX32,
+                    x, y, have, want);
+      }
+    }
+  }
+  return NULL;
+}
+
+// do_test__wuffs_base__image_decoder_downscale checks that decoding the first
+// frame with a (Region Of Interest and a) downscale shift produces the box
+// filtered pixels of a full decode. As for
+// do_test__wuffs_base__image_decoder_roi, two decoders are needed and the
+// downscaled decode is fed its source data chunk_len bytes at a time. The
+// first frame should cover the whole image.
+const char*  //
+do_test__wuffs_base__image_decoder_downscale(
+    wuffs_base__image_decoder* full_dec,
+    wuffs_base__image_decoder* ds_dec,
+    const char* src_filename,
+    wuffs_base__rect_ie_u32 roi,
+    uint32_t shift,
+    size_t chunk_len) {
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, src_filename));
+  const size_t src_wi = src.meta.wi;
+
+  // Decode the whole image.
+  wuffs_base__image_config full_ic = ((wuffs_base__image_config){});
+  CHECK_STATUS("full decode_image_config",
+               wuffs_base__image_decoder__decode_image_config(
+                   full_dec, &full_ic, &src));
+  uint32_t width = wuffs_base__pixel_config__width(&full_ic.pixcfg);
+  uint32_t height = wuffs_base__pixel_config__height(&full_ic.pixcfg);
+  if (((uint64_t)width * (uint64_t)height * 4) > PIXEL_BUFFER_ARRAY_SIZE) {
+    return "image dimensions are too large";
+  }
+  wuffs_base__pixel_config__set(
+      &full_ic.pixcfg, WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+      WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, width, height);
+  memset(g_pixel_slice_u8.ptr, 0x5A, (size_t)width * (size_t)height * 4);
+  wuffs_base__pixel_buffer full_pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("full set_from_slice",
+               wuffs_base__pixel_buffer__set_from_slice(
+                   &full_pb, &full_ic.pixcfg, g_pixel_slice_u8));
+  CHECK_STATUS("full decode_frame",
+               wuffs_base__image_decoder__decode_frame(
+                   full_dec, &full_pb, &src, WUFFS_BASE__PIXEL_BLEND__SRC,
+                   g_work_slice_u8, NULL));
+
+  // Decode the downscaled ROI, into a pixel buffer that's just big enough.
+  wuffs_base__rect_ie_u32 bounds =
+      wuffs_base__pixel_config__bounds(&full_ic.pixcfg);
+  wuffs_base__rect_ie_u32 clipped =
+      wuffs_base__rect_ie_u32__intersect(&bounds, roi);
+  uint32_t bias = (((uint32_t)1) << shift) - 1;
+  uint32_t ds_width = (wuffs_base__rect_ie_u32__width(&clipped) + bias) >> shift;
+  uint32_t ds_height =
+      (wuffs_base__rect_ie_u32__height(&clipped) + bias) >> shift;
+  if (((uint64_t)ds_width * (uint64_t)ds_height * 4) > g_have_slice_u8.len) {
+    return "downscaled dimensions are too large";
+  }
+  memset(g_have_slice_u8.ptr, 0x5A, (size_t)ds_width * (size_t)ds_height * 4);
+  wuffs_base__pixel_config ds_pixcfg = ((wuffs_base__pixel_config){});
+  wuffs_base__pixel_config__set(
+      &ds_pixcfg, WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+      WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, ds_width, ds_height);
+  wuffs_base__pixel_buffer ds_pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("downscale set_from_slice",
+               wuffs_base__pixel_buffer__set_from_slice(
+                   &ds_pb, &ds_pixcfg,
+                   wuffs_base__make_slice_u8(
+                       g_have_slice_u8.ptr,
+                       (size_t)ds_width * (size_t)ds_height * 4)));
+  wuffs_base__decode_frame_options opts =
+      wuffs_base__null_decode_frame_options();
+  wuffs_base__decode_frame_options__set_roi(&opts, roi);
+  wuffs_base__decode_frame_options__set_downscale_shift(&opts, shift);
+
+  src.meta.ri = 0;
+  src.meta.wi = 0;
+  src.meta.closed = false;
+  wuffs_base__image_config ds_ic = ((wuffs_base__image_config){});
+  bool have_ic = false;
+  while (true) {
+    src.meta.wi = (chunk_len < (src_wi - src.meta.wi))
+                      ? (src.meta.wi + chunk_len)
+                      : src_wi;
+    src.meta.closed = src.meta.wi == src_wi;
+    wuffs_base__status status;
+    if (!have_ic) {
+      status =
+          wuffs_base__image_decoder__decode_image_config(ds_dec, &ds_ic, &src);
+      if (wuffs_base__status__is_ok(&status)) {
+        have_ic = true;
+        continue;
+      }
+    } else {
+      status = wuffs_base__image_decoder__decode_frame(
+          ds_dec, &ds_pb, &src, WUFFS_BASE__PIXEL_BLEND__SRC, g_work_slice_u8,
+          &opts);
+      if (wuffs_base__status__is_ok(&status)) {
+        break;
+      }
+    }
+    if ((status.repr != wuffs_base__suspension__short_read) ||
+        src.meta.closed) {
+      RETURN_FAIL("downscale decode: \"%s\"", status.repr);
+    }
+  }
+
+  for (uint32_t y = 0; y < ds_height; y++) {
+    uint32_t y0 = clipped.min_incl_y + (y << shift);
+    uint32_t y1 = y0 + (((uint32_t)1) << shift);
+    y1 = (y1 < clipped.max_excl_y) ? y1 : clipped.max_excl_y;
+    for (uint32_t x = 0; x < ds_width; x++) {
+      uint32_t x0 = clipped.min_incl_x + (x << shift);
+      uint32_t x1 = x0 + (((uint32_t)1) << shift);
+      x1 = (x1 < clipped.max_excl_x) ? x1 : clipped.max_excl_x;
+      uint32_t divisor = (x1 - x0) * (y1 - y0);
+      uint32_t want = 0;
+      for (int c = 0; c < 4; c++) {
+        uint32_t sum = 0;
+        for (uint32_t sy = y0; sy < y1; sy++) {
+          for (uint32_t sx = x0; sx < x1; sx++) {
+            sum += g_pixel_slice_u8.ptr[(4 * (((size_t)sy * width) + sx)) + c];
+          }
+        }
+        want |= ((sum + (divisor / 2)) / divisor) << (8 * c);
+      }
+      uint32_t have = wuffs_base__peek_u32le__no_bounds_check(
+          g_have_slice_u8.ptr + (4 * (((size_t)y * ds_width) + x)));
+      if (have != want) {
+        RETURN_FAIL("downscale (%" PRIu32 ", %" PRIu32 "): have 0x%08" PRIX32
+                    ", want 0x%08" PRIX32,
+                    x, y, have, want);
+      }
+    }
+  }
+  return NULL;
+}
+
+// do_test__wuffs_base__image_decoder_row_bands checks that decoding the first
+// frame (with a Region Of Interest) in row bands, into a pixel buffer that is
+// only band_height rows high, produces the same pixels as a full decode. As
+// for do_test__wuffs_base__image_decoder_roi, two decoders are needed and the
+// banded decode is fed its source data chunk_len bytes at a time. The first
+// frame should cover the whole image.
+const char*  //
+do_test__wuffs_base__image_decoder_row_bands(
+    wuffs_base__image_decoder* full_dec,
+    wuffs_base__image_decoder* band_dec,
+    const char* src_filename,
+    wuffs_base__rect_ie_u32 roi,
+    uint32_t band_height,
+    size_t chunk_len) {
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, src_filename));
+  const size_t src_wi = src.meta.wi;
+
+  // Decode the whole image.
+  wuffs_base__image_config full_ic = ((wuffs_base__image_config){});
+  CHECK_STATUS("full decode_image_config",
+               wuffs_base__image_decoder__decode_image_config(
+                   full_dec, &full_ic, &src));
+  uint32_t width = wuffs_base__pixel_config__width(&full_ic.pixcfg);
+  uint32_t height = wuffs_base__pixel_config__height(&full_ic.pixcfg);
+  if (((uint64_t)width * (uint64_t)height * 4) > PIXEL_BUFFER_ARRAY_SIZE) {
+    return "image dimensions are too large";
+  }
+  wuffs_base__pixel_config__set(
+      &full_ic.pixcfg, WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+      WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, width, height);
+  memset(g_pixel_slice_u8.ptr, 0x5A, (size_t)width * (size_t)height * 4);
+  wuffs_base__pixel_buffer full_pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("full set_from_slice",
+               wuffs_base__pixel_buffer__set_from_slice(
+                   &full_pb, &full_ic.pixcfg, g_pixel_slice_u8));
+  CHECK_STATUS("full decode_frame",
+               wuffs_base__image_decoder__decode_frame(
+                   full_dec, &full_pb, &src, WUFFS_BASE__PIXEL_BLEND__SRC,
+                   g_work_slice_u8, NULL));
+
+  // Decode the ROI in row bands, copying each band from the band pixel buffer
+  // (in g_want_slice_u8) to the ROI-sized g_have_slice_u8.
+  wuffs_base__rect_ie_u32 bounds =
+      wuffs_base__pixel_config__bounds(&full_ic.pixcfg);
+  wuffs_base__rect_ie_u32 clipped =
+      wuffs_base__rect_ie_u32__intersect(&bounds, roi);
+  uint32_t roi_width = wuffs_base__rect_ie_u32__width(&clipped);
+  uint32_t roi_height = wuffs_base__rect_ie_u32__height(&clipped);
+  if ((((uint64_t)roi_width * (uint64_t)roi_height * 4) >
+       g_have_slice_u8.len) ||
+      (((uint64_t)roi_width * (uint64_t)band_height * 4) >
+       g_want_slice_u8.len)) {
+    return "ROI dimensions are too large";
+  }
+  const size_t band_len = (size_t)roi_width * (size_t)band_height * 4;
+  memset(g_have_slice_u8.ptr, 0x5A, (size_t)roi_width * (size_t)roi_height * 4);
+  memset(g_want_slice_u8.ptr, 0xA5, band_len);
+  wuffs_base__pixel_config band_pixcfg = ((wuffs_base__pixel_config){});
+  wuffs_base__pixel_config__set(
+      &band_pixcfg, WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+      WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, roi_width, band_height);
+  wuffs_base__pixel_buffer band_pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("band set_from_slice",
+               wuffs_base__pixel_buffer__set_from_slice(
+                   &band_pb, &band_pixcfg,
+                   wuffs_base__make_slice_u8(g_want_slice_u8.ptr, band_len)));
+  wuffs_base__decode_frame_options opts =
+      wuffs_base__null_decode_frame_options();
+  wuffs_base__decode_frame_options__set_roi(&opts, roi);
+  wuffs_base__decode_frame_options__set_row_band_height(&opts, band_height);
+
+  src.meta.ri = 0;
+  src.meta.wi = 0;
+  src.meta.closed = false;
+  wuffs_base__image_config band_ic = ((wuffs_base__image_config){});
+  bool have_ic = false;
+  uint32_t num_band_rows = 0;
+  while (true) {
+    wuffs_base__status status;
+    if (!have_ic) {
+      status = wuffs_base__image_decoder__decode_image_config(band_dec,
+                                                              &band_ic, &src);
+      if (wuffs_base__status__is_ok(&status)) {
+        have_ic = true;
+        if (!wuffs_base__image_decoder__can_decode_row_bands(band_dec)) {
+          return "can_decode_row_bands: have false, want true";
+        }
+        continue;
+      }
+    } else {
+      status = wuffs_base__image_decoder__decode_frame(
+          band_dec, &band_pb, &src, WUFFS_BASE__PIXEL_BLEND__SRC,
+          g_work_slice_u8, &opts);
+      if (wuffs_base__status__is_ok(&status) ||
+          (status.repr == wuffs_base__suspension__short_write)) {
+        wuffs_base__rect_ie_u32 band =
+            wuffs_base__image_decoder__frame_dirty_rect(band_dec);
+        uint32_t n = wuffs_base__rect_ie_u32__height(&band);
+        if ((band.min_incl_y < clipped.min_incl_y) ||
+            (band.max_excl_y > clipped.max_excl_y) || (n > band_height)) {
+          RETURN_FAIL("band rows [%" PRIu32 ", %" PRIu32 ") out of bounds",
+                      band.min_incl_y, band.max_excl_y);
+        }
+        memcpy(g_have_slice_u8.ptr +
+                   ((size_t)(band.min_incl_y - clipped.min_incl_y) *
+                    roi_width * 4),
+               g_want_slice_u8.ptr, (size_t)n * roi_width * 4);
+        memset(g_want_slice_u8.ptr, 0xA5, band_len);
+        num_band_rows += n;
+        if (wuffs_base__status__is_ok(&status)) {
+          break;
+        }
+        continue;
+      }
+    }
+    if ((status.repr != wuffs_base__suspension__short_read) ||
+        src.meta.closed) {
+      RETURN_FAIL("band decode: \"%s\"", status.repr);
+    }
+    src.meta.wi = (chunk_len < (src_wi - src.meta.wi))
+                      ? (src.meta.wi + chunk_len)
+                      : src_wi;
+    src.meta.closed = src.meta.wi == src_wi;
+  }
+  if (num_band_rows != roi_height) {
+    RETURN_FAIL("band rows: have %" PRIu32 ", want %" PRIu32, num_band_rows,
+                roi_height);
+  }
+
+  for (uint32_t y = 0; y < roi_height; y++) {
+    for (uint32_t x = 0; x < roi_width; x++) {
+      uint32_t have = wuffs_base__peek_u32le__no_bounds_check(
+          g_have_slice_u8.ptr + (4 * (((size_t)y * roi_width) + x)));
+      uint32_t want = wuffs_base__peek_u32le__no_bounds_check(
+          g_pixel_slice_u8.ptr +
+          (4 * (((size_t)(y + clipped.min_incl_y) * width) +
+                (x + clipped.min_incl_x))));
+      if (have != want) {
+        RETURN_FAIL("band (%" PRIu32 ", %" PRIu32 "): have 0x%08" PRIX32
+                    ", want 0x%08" PRIX32,
+                    x, y, have, want);
+      }
+    }
+  }
+  return NULL;
+}
+
 const char*  //
 do_test__wuffs_base__io_transformer(wuffs_base__io_transformer* b,
                                     const char* src_filename,
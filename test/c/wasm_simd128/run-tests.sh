@@ -0,0 +1,45 @@
+#!/bin/bash -eu
+# Copyright 2022 The Wuffs Authors.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# ----------------
+
+# This script compiles and runs some of the test/c/std programs with the
+# WUFFS_BASE__CPU_ARCH__WASM_SIMD128 code paths enabled, using the plain C
+# wasm_simd128.h stand-in in this directory instead of clang's header. This
+# exercises the WebAssembly SIMD128 pixel swizzlers (e.g. via wbmp.c's
+# test_wuffs_pixel_swizzler_src_conversions) with an ordinary C compiler on an
+# ordinary (non-WebAssembly) host.
+#
+# Usage: test/c/wasm_simd128/run-tests.sh [pkg...]
+#
+# The pkgs default to "bmp gif png tga wbmp". The CC environment variable
+# defaults to "gcc". It must be run from the Wuffs root directory.
+
+if [ ! -e wuffs-root-directory.txt ]; then
+  echo "$0 should be run from the Wuffs root directory."
+  exit 1
+fi
+
+CC=${CC:-gcc}
+pkgs=${@:-bmp gif png tga wbmp}
+
+tmpdir=$(mktemp -d)
+trap "rm -rf $tmpdir" EXIT
+
+for p in $pkgs; do
+  $CC -std=c99 -Wall -Werror -D__wasm_simd128__ -Itest/c/wasm_simd128 \
+    test/c/std/$p.c -o $tmpdir/$p -lm
+  $tmpdir/$p
+done
@@ -0,0 +1,148 @@
+// Copyright 2022 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef WUFFS_TEST_C_WASM_SIMD128_WASM_SIMD128_H
+#define WUFFS_TEST_C_WASM_SIMD128_WASM_SIMD128_H
+
+// This file is a portable, plain C stand-in for clang's <wasm_simd128.h>, so
+// that the Wuffs base library's WUFFS_BASE__CPU_ARCH__WASM_SIMD128 code can be
+// compiled and tested by any C compiler, on any CPU. See run-tests.sh in this
+// directory.
+//
+// It only implements the intrinsics that Wuffs uses. Like WebAssembly (but
+// unlike real intrinsics), it does not rely on the host CPU's endianness or
+// vector registers, so it is slow. Like clang's wasm_i8x16_shuffle, the
+// shuffle lane indexes must be in the range [0 ..= 31], but unlike clang's,
+// they don't have to be compile-time constants.
+
+#include <stdint.h>
+#include <string.h>
+
+typedef struct {
+  uint8_t u8[16];
+} v128_t;
+
+static inline uint16_t  //
+wasm_simd128_stand_in__get_u16(v128_t a, int i) {
+  return (uint16_t)(((uint16_t)(a.u8[(2 * i) + 0]) << 0) |
+                    ((uint16_t)(a.u8[(2 * i) + 1]) << 8));
+}
+
+static inline void  //
+wasm_simd128_stand_in__set_u16(v128_t* a, int i, uint16_t x) {
+  a->u8[(2 * i) + 0] = (uint8_t)(x >> 0);
+  a->u8[(2 * i) + 1] = (uint8_t)(x >> 8);
+}
+
+static inline v128_t  //
+wasm_v128_load(const void* mem) {
+  v128_t ret;
+  memcpy(ret.u8, mem, 16);
+  return ret;
+}
+
+static inline void  //
+wasm_v128_store(void* mem, v128_t a) {
+  memcpy(mem, a.u8, 16);
+}
+
+static inline v128_t  //
+wasm_u8x16_splat(uint8_t x) {
+  v128_t ret;
+  memset(ret.u8, x, 16);
+  return ret;
+}
+
+static inline v128_t  //
+wasm_u16x8_splat(uint16_t x) {
+  v128_t ret;
+  for (int i = 0; i < 8; i++) {
+    wasm_simd128_stand_in__set_u16(&ret, i, x);
+  }
+  return ret;
+}
+
+static inline v128_t  //
+wasm_i16x8_add(v128_t a, v128_t b) {
+  v128_t ret;
+  for (int i = 0; i < 8; i++) {
+    wasm_simd128_stand_in__set_u16(
+        &ret, i,
+        (uint16_t)(wasm_simd128_stand_in__get_u16(a, i) +
+                   wasm_simd128_stand_in__get_u16(b, i)));
+  }
+  return ret;
+}
+
+// WebAssembly shifts by the shift amount modulo the lane width.
+static inline v128_t  //
+wasm_u16x8_shr(v128_t a, uint32_t b) {
+  v128_t ret;
+  for (int i = 0; i < 8; i++) {
+    wasm_simd128_stand_in__set_u16(
+        &ret, i, (uint16_t)(wasm_simd128_stand_in__get_u16(a, i) >> (b & 15)));
+  }
+  return ret;
+}
+
+static inline v128_t  //
+wasm_u16x8_extmul_low_u8x16(v128_t a, v128_t b) {
+  v128_t ret;
+  for (int i = 0; i < 8; i++) {
+    wasm_simd128_stand_in__set_u16(
+        &ret, i, (uint16_t)((uint16_t)(a.u8[i]) * (uint16_t)(b.u8[i])));
+  }
+  return ret;
+}
+
+static inline v128_t  //
+wasm_u16x8_extmul_high_u8x16(v128_t a, v128_t b) {
+  v128_t ret;
+  for (int i = 0; i < 8; i++) {
+    wasm_simd128_stand_in__set_u16(
+        &ret, i,
+        (uint16_t)((uint16_t)(a.u8[8 + i]) * (uint16_t)(b.u8[8 + i])));
+  }
+  return ret;
+}
+
+// wasm_u8x16_narrow_i16x8 treats its lanes as signed and saturates them.
+static inline v128_t  //
+wasm_u8x16_narrow_i16x8(v128_t a, v128_t b) {
+  v128_t ret;
+  for (int i = 0; i < 16; i++) {
+    uint16_t x = wasm_simd128_stand_in__get_u16((i < 8) ? a : b, i & 7);
+    ret.u8[i] = (x >= 0x8000) ? 0x00 : ((x > 0x00FF) ? 0xFF : (uint8_t)x);
+  }
+  return ret;
+}
+
+static inline v128_t  //
+wasm_simd128_stand_in__i8x16_shuffle(v128_t a, v128_t b, const int* lanes) {
+  v128_t ret;
+  for (int i = 0; i < 16; i++) {
+    int j = lanes[i] & 31;
+    ret.u8[i] = (j < 16) ? a.u8[j] : b.u8[j - 16];
+  }
+  return ret;
+}
+
+#define wasm_i8x16_shuffle(a, b, c0, c1, c2, c3, c4, c5, c6, c7, c8, c9, \
+                           c10, c11, c12, c13, c14, c15)                 \
+  wasm_simd128_stand_in__i8x16_shuffle(                                  \
+      (a), (b),                                                          \
+      (const int[16]){c0, c1, c2, c3, c4, c5, c6, c7,                    \
+                      c8, c9, c10, c11, c12, c13, c14, c15})
+
+#endif  // WUFFS_TEST_C_WASM_SIMD128_WASM_SIMD128_H